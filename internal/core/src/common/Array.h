@@ -437,16 +437,17 @@ class ArrayView {
  public:
     ArrayView() = default;
 
+    // the offsets of the variable length elements are viewed, not copied,
+    // they are kept by the column
     ArrayView(char* data,
               size_t size,
               DataType element_type,
-              std::vector<uint64_t>&& element_offsets)
-        : size_(size),
-          element_type_(element_type),
-          offsets_(std::move(element_offsets)) {
+              const uint64_t* element_offsets,
+              size_t num_offsets)
+        : size_(size), offsets_(element_offsets), element_type_(element_type) {
         data_ = data;
         if (datatype_is_variable(element_type_)) {
-            length_ = offsets_.size();
+            length_ = num_offsets;
         } else {
             // int8, int16, int32 are all promoted to int32
             if (element_type_ == DataType::INT8 ||
@@ -469,7 +470,7 @@ class ArrayView {
         if constexpr (std::is_same_v<T, std::string> ||
                       std::is_same_v<T, std::string_view>) {
             size_t element_length = (index == length_ - 1)
-                                        ? size_ - offsets_.back()
+                                        ? size_ - offsets_[length_ - 1]
                                         : offsets_[index + 1] - offsets_[index];
             return T(data_ + offsets_[index], element_length);
         }
@@ -649,7 +650,7 @@ class ArrayView {
     char* data_{nullptr};
     int length_ = 0;
     int size_ = 0;
-    std::vector<uint64_t> offsets_{};
+    const uint64_t* offsets_{nullptr};
     DataType element_type_ = DataType::NONE;
 };
 
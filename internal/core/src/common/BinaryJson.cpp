@@ -0,0 +1,329 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/BinaryJson.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+
+namespace milvus {
+
+namespace {
+
+template <typename T>
+void
+Append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void
+WriteAt(std::string& out, size_t pos, uint32_t value) {
+    std::memcpy(out.data() + pos, &value, sizeof(value));
+}
+
+void
+EncodeElement(simdjson::dom::element element, std::string& out) {
+    auto begin = out.size();
+    switch (element.type()) {
+        case simdjson::dom::element_type::ARRAY: {
+            auto array = element.get_array().value_unsafe();
+            // the size of a dom array saturates, count the elements
+            uint32_t count = 0;
+            for ([[maybe_unused]] auto child : array) {
+                ++count;
+            }
+            out.push_back(BinaryJson::Array);
+            Append<uint32_t>(out, count);
+            auto offsets = out.size();
+            out.resize(offsets + count * BinaryJson::OFFSET_SIZE);
+            uint32_t i = 0;
+            for (auto child : array) {
+                WriteAt(out,
+                        offsets + i++ * BinaryJson::OFFSET_SIZE,
+                        out.size() - begin);
+                EncodeElement(child, out);
+            }
+            break;
+        }
+        case simdjson::dom::element_type::OBJECT: {
+            std::vector<std::pair<std::string_view, simdjson::dom::element>>
+                fields;
+            for (auto field : element.get_object().value_unsafe()) {
+                fields.emplace_back(field.key, field.value);
+            }
+            // the first of the duplicate keys is found, as by simdjson
+            std::stable_sort(
+                fields.begin(),
+                fields.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+            out.push_back(BinaryJson::Object);
+            Append<uint32_t>(out, fields.size());
+            auto directory = out.size();
+            out.resize(directory + fields.size() * BinaryJson::FIELD_SIZE);
+            for (size_t i = 0; i < fields.size(); ++i) {
+                auto field = directory + i * BinaryJson::FIELD_SIZE;
+                WriteAt(out, field, out.size() - begin);
+                WriteAt(out, field + sizeof(uint32_t), fields[i].first.size());
+                out.append(fields[i].first);
+            }
+            for (size_t i = 0; i < fields.size(); ++i) {
+                auto field = directory + i * BinaryJson::FIELD_SIZE;
+                WriteAt(out, field + 2 * sizeof(uint32_t), out.size() - begin);
+                EncodeElement(fields[i].second, out);
+            }
+            break;
+        }
+        case simdjson::dom::element_type::INT64:
+            out.push_back(BinaryJson::Int64);
+            Append<int64_t>(out, element.get_int64().value_unsafe());
+            break;
+        case simdjson::dom::element_type::UINT64:
+            out.push_back(BinaryJson::UInt64);
+            Append<uint64_t>(out, element.get_uint64().value_unsafe());
+            break;
+        case simdjson::dom::element_type::DOUBLE:
+            out.push_back(BinaryJson::Double);
+            Append<double>(out, element.get_double().value_unsafe());
+            break;
+        case simdjson::dom::element_type::STRING: {
+            auto str = element.get_string().value_unsafe();
+            out.push_back(BinaryJson::String);
+            Append<uint32_t>(out, str.size());
+            out.append(str);
+            break;
+        }
+        case simdjson::dom::element_type::BOOL:
+            out.push_back(element.get_bool().value_unsafe()
+                              ? BinaryJson::True
+                              : BinaryJson::False);
+            break;
+        case simdjson::dom::element_type::NULL_VALUE:
+            out.push_back(BinaryJson::Null);
+            break;
+    }
+}
+
+// the field of the key of an object, nullptr if there's none
+const char*
+FindField(const char* object, std::string_view key) {
+    auto count = BinaryJson::Count(object);
+    auto directory = object + BinaryJson::HEADER_SIZE;
+    auto key_at = [&](uint32_t i) {
+        auto field = directory + i * BinaryJson::FIELD_SIZE;
+        return std::string_view(
+            object + BinaryJson::Read<uint32_t>(field),
+            BinaryJson::Read<uint32_t>(field + sizeof(uint32_t)));
+    };
+    uint32_t low = 0, high = count;
+    while (low < high) {
+        auto mid = low + (high - low) / 2;
+        if (key_at(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == count || key_at(low) != key) {
+        return nullptr;
+    }
+    auto field = directory + low * BinaryJson::FIELD_SIZE;
+    return object + BinaryJson::Read<uint32_t>(field + 2 * sizeof(uint32_t));
+}
+
+// the element of the index of an array, nullptr if the index isn't a
+// number without leading zeros or is out of the array
+const char*
+FindElement(const char* array, std::string_view index) {
+    if (index.empty() || (index.size() > 1 && index[0] == '0')) {
+        return nullptr;
+    }
+    uint64_t i = 0;
+    for (auto c : index) {
+        if (c < '0' || c > '9' || i > UINT32_MAX) {
+            return nullptr;
+        }
+        i = i * 10 + (c - '0');
+    }
+    if (i >= BinaryJson::Count(array)) {
+        return nullptr;
+    }
+    return BinaryJson::Element(array, i);
+}
+
+void
+AppendString(std::string_view str, std::string& out) {
+    out.push_back('"');
+    for (unsigned char c : str) {
+        switch (c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (c < 0x20) {
+                    out.append(fmt::format("\\u{:04x}", c));
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+void
+AppendText(const char* value, std::string& out) {
+    switch (BinaryJson::kind(value)) {
+        case BinaryJson::Null:
+            out.append("null");
+            break;
+        case BinaryJson::False:
+            out.append("false");
+            break;
+        case BinaryJson::True:
+            out.append("true");
+            break;
+        case BinaryJson::Int64:
+            out.append(std::to_string(BinaryJson::Read<int64_t>(value + 1)));
+            break;
+        case BinaryJson::UInt64:
+            out.append(std::to_string(BinaryJson::Read<uint64_t>(value + 1)));
+            break;
+        case BinaryJson::Double: {
+            // the shortest text read back as the same double, still a double
+            auto text = fmt::format("{}", BinaryJson::Read<double>(value + 1));
+            if (text.find_first_of(".e") == std::string::npos) {
+                text.append(".0");
+            }
+            out.append(text);
+            break;
+        }
+        case BinaryJson::String:
+            AppendString(BinaryJson::Get<std::string_view>(value).value(),
+                         out);
+            break;
+        case BinaryJson::Array: {
+            out.push_back('[');
+            for (uint32_t i = 0; i < BinaryJson::Count(value); ++i) {
+                if (i > 0) {
+                    out.push_back(',');
+                }
+                AppendText(BinaryJson::Element(value, i), out);
+            }
+            out.push_back(']');
+            break;
+        }
+        case BinaryJson::Object: {
+            out.push_back('{');
+            auto directory = value + BinaryJson::HEADER_SIZE;
+            for (uint32_t i = 0; i < BinaryJson::Count(value); ++i) {
+                if (i > 0) {
+                    out.push_back(',');
+                }
+                auto field = directory + i * BinaryJson::FIELD_SIZE;
+                AppendString(
+                    std::string_view(
+                        value + BinaryJson::Read<uint32_t>(field),
+                        BinaryJson::Read<uint32_t>(field + sizeof(uint32_t))),
+                    out);
+                out.push_back(':');
+                AppendText(value + BinaryJson::Read<uint32_t>(
+                                       field + 2 * sizeof(uint32_t)),
+                           out);
+            }
+            out.push_back('}');
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+bool
+BinaryJson::Encode(const char* data, size_t size, std::string& out) {
+    thread_local simdjson::dom::parser parser;
+    auto doc = parser.parse(simdjson::padded_string_view(
+        data, size, size + simdjson::SIMDJSON_PADDING));
+    if (doc.error() != simdjson::SUCCESS) {
+        return false;
+    }
+    EncodeElement(doc.value_unsafe(), out);
+    return true;
+}
+
+// the tokens of the pointer are unescaped like by simdjson, "~1" to "/" and
+// "~0" to "~"
+const char*
+BinaryJson::Find(const char* value, std::string_view pointer) {
+    if (pointer.empty()) {
+        return value;
+    }
+    if (pointer[0] != '/') {
+        return nullptr;
+    }
+    std::string unescaped;
+    while (value != nullptr && !pointer.empty()) {
+        pointer.remove_prefix(1);
+        auto end = std::min(pointer.find('/'), pointer.size());
+        auto token = pointer.substr(0, end);
+        pointer.remove_prefix(end);
+        switch (kind(value)) {
+            case Object:
+                if (token.find('~') != std::string_view::npos) {
+                    unescaped.clear();
+                    for (size_t i = 0; i < token.size(); ++i) {
+                        if (token[i] == '~' && i + 1 < token.size() &&
+                            (token[i + 1] == '0' || token[i + 1] == '1')) {
+                            unescaped.push_back(token[++i] == '0' ? '~' : '/');
+                        } else {
+                            unescaped.push_back(token[i]);
+                        }
+                    }
+                    token = unescaped;
+                }
+                value = FindField(value, token);
+                break;
+            case Array:
+                value = FindElement(value, token);
+                break;
+            default:
+                return nullptr;
+        }
+    }
+    return value;
+}
+
+std::string
+BinaryJson::ToString(const char* value) {
+    std::string out;
+    AppendText(value, out);
+    return out;
+}
+
+}  // namespace milvus
@@ -0,0 +1,139 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "simdjson.h"
+
+namespace milvus {
+
+// BinaryJson is the encoding of a JSON document whose values are sought by
+// a JSON pointer without parsing the document: the fields of an object are
+// in a directory sorted by their keys, and the elements of an array are
+// found by their offsets. An encoded value starts with its Kind:
+//
+//     Null, False, True
+//     Int64, UInt64, Double   the 8 bytes of the number
+//     String                  uint32 length, the unescaped bytes
+//     Array                   uint32 count, uint32 offset of each element,
+//                             the elements
+//     Object                  uint32 count, (uint32 key offset, uint32 key
+//                             length, uint32 value offset) of each field in
+//                             the order of the keys, the keys, the values
+//
+// The offsets are from the start of the array or the object. The encoding
+// is only kept in memory, in the byte order of the host.
+class BinaryJson {
+ public:
+    enum Kind : uint8_t {
+        Null = 0,
+        False,
+        True,
+        Int64,
+        UInt64,
+        Double,
+        String,
+        Array,
+        Object,
+    };
+
+    // append the encoding of the JSON text to out, which must be followed by
+    // simdjson::SIMDJSON_PADDING bytes, false if it isn't valid JSON
+    static bool
+    Encode(const char* data, size_t size, std::string& out);
+
+    // the value at the JSON pointer, nullptr if there's none
+    static const char*
+    Find(const char* value, std::string_view pointer);
+
+    static Kind
+    kind(const char* value) {
+        return Kind(static_cast<uint8_t>(value[0]));
+    }
+
+    // the number of the elements of an array
+    static uint32_t
+    Count(const char* array) {
+        return Read<uint32_t>(array + 1);
+    }
+
+    static const char*
+    Element(const char* array, uint32_t i) {
+        return array + Read<uint32_t>(array + HEADER_SIZE + i * OFFSET_SIZE);
+    }
+
+    // the value as a T, converted like simdjson does, the integers to
+    // double but not the other way around
+    template <typename T>
+    static simdjson::simdjson_result<T>
+    Get(const char* value) {
+        auto value_kind = kind(value);
+        if constexpr (std::is_same_v<T, bool>) {
+            if (value_kind == True || value_kind == False) {
+                return value_kind == True;
+            }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (value_kind == Int64) {
+                return Read<int64_t>(value + 1);
+            }
+            if (value_kind == UInt64) {
+                return simdjson::NUMBER_OUT_OF_RANGE;
+            }
+        } else if constexpr (std::is_same_v<T, double>) {
+            switch (value_kind) {
+                case Int64:
+                    return double(Read<int64_t>(value + 1));
+                case UInt64:
+                    return double(Read<uint64_t>(value + 1));
+                case Double:
+                    return Read<double>(value + 1);
+                default:
+                    break;
+            }
+        } else {
+            static_assert(std::is_same_v<T, std::string_view>,
+                          "unsupported type of binary json value");
+            if (value_kind == String) {
+                return std::string_view(value + HEADER_SIZE,
+                                        Read<uint32_t>(value + 1));
+            }
+        }
+        return simdjson::INCORRECT_TYPE;
+    }
+
+    // the JSON text of the value
+    static std::string
+    ToString(const char* value);
+
+    static constexpr size_t HEADER_SIZE = 1 + sizeof(uint32_t);
+    static constexpr size_t OFFSET_SIZE = sizeof(uint32_t);
+    static constexpr size_t FIELD_SIZE = 3 * sizeof(uint32_t);
+
+    template <typename T>
+    static T
+    Read(const char* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+};
+
+}  // namespace milvus
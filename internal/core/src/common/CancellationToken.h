@@ -0,0 +1,81 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+
+// The cancellation of a search or a retrieve, shared by its caller and the
+// stages running it. The stages check it at the boundaries of their batches,
+// so a query canceled, or past its deadline, stops within a batch.
+class CancellationToken {
+ public:
+    CancellationToken() = default;
+
+    explicit CancellationToken(std::chrono::steady_clock::time_point deadline)
+        : deadline_(deadline) {
+    }
+
+    void
+    Cancel() {
+        canceled_.store(true, std::memory_order_relaxed);
+    }
+
+    bool
+    IsCanceled() const {
+        return canceled_.load(std::memory_order_relaxed) || IsExpired();
+    }
+
+    // throw Canceled if the query is canceled or past its deadline
+    void
+    Check() const {
+        if (canceled_.load(std::memory_order_relaxed)) {
+            PanicInfo(Canceled, "query canceled");
+        }
+        if (IsExpired()) {
+            PanicInfo(Canceled, "query deadline exceeded");
+        }
+    }
+
+ private:
+    bool
+    IsExpired() const {
+        return deadline_.has_value() &&
+               std::chrono::steady_clock::now() >= *deadline_;
+    }
+
+    std::atomic<bool> canceled_{false};
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+};
+
+using CancellationTokenPtr = std::shared_ptr<CancellationToken>;
+
+// the queries without a token are never canceled
+inline void
+CheckCancellation(const CancellationTokenPtr& token) {
+    if (token != nullptr) {
+        token->Check();
+    }
+}
+
+}  // namespace milvus
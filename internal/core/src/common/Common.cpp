@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "common/Common.h"
+#include "common/EasyAssert.h"
 #include "log/Log.h"
 
 namespace milvus {
@@ -27,7 +28,13 @@ int64_t MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT =
 int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT =
     DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 int CPU_NUM = DEFAULT_CPU_NUM;
+int64_t CPU_CONCURRENCY = 0;
 int64_t EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
+int64_t EXEC_EVAL_EXPR_WORKING_SET_SIZE =
+    DEFAULT_EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+bool THREAD_POOL_NUMA_AWARE = false;
+bool STAGE_VECTOR_BUILD_INPUT = false;
+HugePageMode HUGE_PAGE_MODE = HugePageMode::Disabled;
 
 void
 SetIndexSliceSize(const int64_t size) {
@@ -64,9 +71,47 @@ SetDefaultExecEvalExprBatchSize(int64_t val) {
                       << EXEC_EVAL_EXPR_BATCH_SIZE;
 }
 
+void
+SetExecEvalExprWorkingSetSize(int64_t val) {
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = val;
+    LOG_SEGCORE_INFO_ << "set expr eval working set size: "
+                      << EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+}
+
 void
 SetCpuNum(const int num) {
     CPU_NUM = num;
 }
 
+void
+SetCpuConcurrency(const int64_t concurrency) {
+    CPU_CONCURRENCY = concurrency;
+    LOG_SEGCORE_INFO_ << "set cpu concurrency of the thread pools: "
+                      << CPU_CONCURRENCY;
+}
+
+void
+SetThreadPoolNumaAware(bool numa_aware) {
+    THREAD_POOL_NUMA_AWARE = numa_aware;
+    LOG_SEGCORE_INFO_ << "set thread pool numa aware: "
+                      << THREAD_POOL_NUMA_AWARE;
+}
+
+void
+SetHugePageMode(int mode) {
+    AssertInfo(mode >= static_cast<int>(HugePageMode::Disabled) &&
+                   mode <= static_cast<int>(HugePageMode::HugeTLB),
+               "invalid huge page mode {}",
+               mode);
+    HUGE_PAGE_MODE = static_cast<HugePageMode>(mode);
+    LOG_SEGCORE_INFO_ << "set huge page mode: " << mode;
+}
+
+void
+SetStageVectorBuildInput(bool stage) {
+    STAGE_VECTOR_BUILD_INPUT = stage;
+    LOG_SEGCORE_INFO_ << "set stage vector build input: "
+                      << STAGE_VECTOR_BUILD_INPUT;
+}
+
 }  // namespace milvus
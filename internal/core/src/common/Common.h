@@ -26,7 +26,29 @@ extern int64_t HIGH_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int64_t MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int CPU_NUM;
+// the workers of each segcore thread pool are bounded by it if positive,
+// must be set before the pools are first used
+extern int64_t CPU_CONCURRENCY;
 extern int64_t EXEC_EVAL_EXPR_BATCH_SIZE;
+extern int64_t EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+extern bool THREAD_POOL_NUMA_AWARE;
+// the in memory vector indexes are built from a local file of the binlogs
+// mapped read only instead of a copy of them on the heap
+extern bool STAGE_VECTOR_BUILD_INPUT;
+
+// the pages backing the large anonymous maps of the columns
+enum class HugePageMode : int {
+    // the normal pages only
+    Disabled = 0,
+    // advise the transparent huge pages
+    Transparent = 1,
+    // map the reserved huge pages of hugetlbfs, or advise the transparent
+    // ones if there are not enough of them
+    HugeTLB = 2,
+};
+// must be set before any column is loaded, the maps are unmapped by the mode
+// they are mapped with
+extern HugePageMode HUGE_PAGE_MODE;
 
 void
 SetIndexSliceSize(const int64_t size);
@@ -43,7 +65,22 @@ SetLowPriorityThreadCoreCoefficient(const int64_t coefficient);
 void
 SetCpuNum(const int core);
 
+void
+SetCpuConcurrency(const int64_t concurrency);
+
 void
 SetDefaultExecEvalExprBatchSize(int64_t val);
 
+void
+SetExecEvalExprWorkingSetSize(int64_t val);
+
+void
+SetThreadPoolNumaAware(bool numa_aware);
+
+void
+SetHugePageMode(int mode);
+
+void
+SetStageVectorBuildInput(bool stage);
+
 }  // namespace milvus
@@ -35,6 +35,8 @@ const milvus::FieldId TimestampFieldID = milvus::FieldId(1);
 // fill followed extra info to binlog file
 const char ORIGIN_SIZE_KEY[] = "original_size";
 const char INDEX_BUILD_ID_KEY[] = "indexBuildID";
+// the CRC32C of the events after the descriptor event, in 8 hex digits
+const char PAYLOAD_CRC32C_KEY[] = "payload_crc32c";
 
 const char INDEX_ROOT_PATH[] = "index_files";
 const char RAWDATA_ROOT_PATH[] = "raw_datas";
@@ -50,13 +52,56 @@ const int64_t DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT = 1;
 
 const int64_t DEFAULT_INDEX_FILE_SLICE_SIZE = 4 << 20;  // bytes
 
+// byte ranges of a file closer than this are fetched with one request
+const int64_t DEFAULT_RANGE_READ_MERGE_GAP = 1 << 20;  // bytes
+// the head of a binlog read for the headers before its raw payload values
+const int64_t RAW_BINLOG_HEAD_READ_SIZE = 64 << 10;  // bytes
+
 const int DEFAULT_CPU_NUM = 1;
 
 const int64_t DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE = 8192;
+// the batch size of the expression evaluation is chosen from the width of the
+// fields read, so that a batch of them fits in this many bytes, 0 disables it
+// and keeps the configured batch size, see exprEvalWorkingSetSize of segcore
+const int64_t DEFAULT_EXEC_EVAL_EXPR_WORKING_SET_SIZE = 0;
+const int64_t DEFAULT_EXEC_EVAL_EXPR_MIN_BATCH_SIZE = 1024;
+const int64_t DEFAULT_EXEC_EVAL_EXPR_MAX_BATCH_SIZE = 64 * 1024;
+// a sealed segment is filtered in parallel by row ranges of at least so
+// many rows
+const int64_t DEFAULT_EXEC_FILTER_SPLIT_MIN_ROWS = 1 << 20;
 
 constexpr const char* RADIUS = knowhere::meta::RADIUS;
 constexpr const char* RANGE_FILTER = knowhere::meta::RANGE_FILTER;
 
+// search param to evaluate the filter on the search candidates only
+constexpr const char* ITERATIVE_FILTER = "iterative_filter";
+// search param to collect the profile of the search on every segment, see
+// QueryProfile
+constexpr const char* SEARCH_PROFILE = "profile";
+// search param of the effort params the search may be scaled down to under
+// overload, by their lower bounds like {"ef": 32}, see AdaptiveSearch
+constexpr const char* ADAPTIVE_SEARCH = "adaptive_search";
+// at most so many candidates are searched for a query in iterative filter
+const int64_t DEFAULT_ITERATIVE_FILTER_MAX_TOPK = 16384;
+// at most so many candidates are searched for a query in group by search
+const int64_t DEFAULT_GROUP_BY_MAX_TOPK = 16384;
+// the k of the reciprocal rank fusion of hybrid search if not set
+const int64_t DEFAULT_RRF_K = 60;
+
 const int64_t DEFAULT_MAX_OUTPUT_SIZE = 67108864;  // bytes, 64MB
 
 const int64_t DEFAULT_CHUNK_MANAGER_REQUEST_TIMEOUT_MS = 10000;
+
+const int64_t DEFAULT_STORAGE_READ_PART_SIZE = 16 << 20;  // bytes
+const int64_t DEFAULT_STORAGE_READ_CONCURRENCY = 8;
+// a get that hasn't returned within this percentile of the get latencies is
+// hedged by a duplicate request, 0 disables hedging. Off by default since a
+// hedge doubles the bytes in flight for the gets it duplicates
+const double DEFAULT_STORAGE_READ_HEDGE_PERCENTILE = 0;
+// gets larger than this are never hedged, their latency is dominated by the
+// transfer rather than the tail the small-get percentile describes
+const int64_t STORAGE_READ_HEDGE_MAX_BYTES = 1 << 20;
+// the gets observed before the latencies are trusted for hedging
+const int64_t STORAGE_READ_HEDGE_MIN_SAMPLES = 100;
+// s3 requires all parts except the last one to be at least 5 MiB
+const int64_t DEFAULT_STORAGE_WRITE_PART_SIZE = 8 << 20;  // bytes
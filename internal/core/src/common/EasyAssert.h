@@ -58,6 +58,9 @@ enum ErrorCode {
     FieldNotLoaded = 2027,
     ExprInvalid = 2028,
     UnistdError = 2030,
+    Canceled = 2031,
+    MemoryBudgetExceeded = 2032,
+    SearchIteratorNotExist = 2033,
     KnowhereError = 2100,
 };
 namespace impl {
@@ -129,14 +129,8 @@ FieldDataImpl<Type, is_scalar>::FillFieldData(
         case DataType::JSON: {
             AssertInfo(array->type()->id() == arrow::Type::type::BINARY,
                        "inconsistent data type");
-            auto json_array =
-                std::dynamic_pointer_cast<arrow::BinaryArray>(array);
-            std::vector<Json> values(element_count);
-            for (size_t index = 0; index < element_count; ++index) {
-                values[index] =
-                    Json(simdjson::padded_string(json_array->GetString(index)));
-            }
-            return FillFieldData(values.data(), element_count);
+            return FillFieldData(
+                std::dynamic_pointer_cast<arrow::BinaryArray>(array));
         }
         case DataType::ARRAY: {
             auto array_array =
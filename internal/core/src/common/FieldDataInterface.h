@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <memory>
@@ -49,6 +50,15 @@ class FieldDataBase {
     virtual void
     FillFieldData(const std::shared_ptr<arrow::Array> array) = 0;
 
+    // return the address of the element_count rows following the filled rows
+    // so that a decoder can write them in place, the rows are filled after
+    // CommitFillFieldData; only valid for fixed width types
+    virtual void*
+    PrepareFillFieldData(ssize_t element_count) = 0;
+
+    virtual void
+    CommitFillFieldData(ssize_t element_count) = 0;
+
     virtual void*
     Data() = 0;
 
@@ -121,6 +131,23 @@ class FieldDataImpl : public FieldDataBase {
     void
     FillFieldData(const std::shared_ptr<arrow::Array> array) override;
 
+    void*
+    PrepareFillFieldData(ssize_t element_count) override {
+        std::lock_guard lck(tell_mutex_);
+        if (length_ + element_count > get_num_rows()) {
+            resize_field_data(length_ + element_count);
+        }
+        return field_data_.data() + length_ * dim_;
+    }
+
+    void
+    CommitFillFieldData(ssize_t element_count) override {
+        std::lock_guard lck(tell_mutex_);
+        AssertInfo(length_ + element_count <= get_num_rows(),
+                   "commit more rows than prepared");
+        length_ += element_count;
+    }
+
     virtual void
     FillFieldData(const std::shared_ptr<arrow::StringArray>& array){};
 
@@ -188,12 +215,21 @@ class FieldDataImpl : public FieldDataBase {
         return num_rows_;
     }
 
+    // the rows filled beyond the buffered ones grow the capacity by half at
+    // least, so the field data filled batch by batch without knowing its rows
+    // copies them amortized once, while Reserve and the rows given on
+    // construction keep it exact
     void
     resize_field_data(int64_t num_rows) {
         std::lock_guard lck(num_rows_mutex_);
         if (num_rows > num_rows_) {
+            auto size = static_cast<size_t>(num_rows * dim_);
+            if (size > field_data_.capacity()) {
+                field_data_.reserve(
+                    std::max(size, field_data_.capacity() * 3 / 2));
+            }
             num_rows_ = num_rows;
-            field_data_.resize(num_rows_ * dim_);
+            field_data_.resize(size);
         }
     }
 
@@ -265,6 +301,9 @@ class FieldDataStringImpl : public FieldDataImpl<std::string, true> {
     }
 };
 
+// The bytes of the json filled together are packed into a block padded only
+// at its end for simdjson, and the rows are the Json viewing them, instead of
+// owning a padded string each, which doubles the memory of small documents.
 class FieldDataJsonImpl : public FieldDataImpl<Json, true> {
  public:
     explicit FieldDataJsonImpl(DataType data_type, int64_t total_num_rows = 0)
@@ -290,26 +329,55 @@ class FieldDataJsonImpl : public FieldDataImpl<Json, true> {
         return field_data_[offset].data().size();
     }
 
+    using FieldDataImpl<Json, true>::FillFieldData;
+
+    void
+    FillFieldData(const void* source, ssize_t element_count) override {
+        auto values = static_cast<const Json*>(source);
+        fill_packed_data(element_count, [&](int64_t i) {
+            return std::string_view(values[i].data());
+        });
+    }
+
     void
     FillFieldData(const std::shared_ptr<arrow::BinaryArray>& array) override {
-        auto n = array->length();
+        fill_packed_data(array->length(), [&](int64_t i) {
+            return std::string_view(array->GetView(i));
+        });
+    }
+
+ private:
+    template <typename ViewOf>
+    void
+    fill_packed_data(int64_t n, ViewOf&& view_of) {
         if (n == 0) {
             return;
         }
+        size_t block_size = simdjson::SIMDJSON_PADDING;
+        for (int64_t i = 0; i < n; ++i) {
+            block_size += view_of(i).size();
+        }
+        auto block = std::make_unique<char[]>(block_size);
 
         std::lock_guard lck(tell_mutex_);
         if (length_ + n > get_num_rows()) {
             resize_field_data(length_ + n);
         }
-
-        auto i = 0;
-        for (const auto& json : *array) {
-            field_data_[length_ + i] =
-                Json(simdjson::padded_string(json.value()));
-            i++;
+        size_t block_offset = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            auto view = view_of(i);
+            auto data = block.get() + block_offset;
+            std::copy_n(view.data(), view.size(), data);
+            block_offset += view.size();
+            field_data_[length_ + i] = Json(data, view.size());
         }
+        std::fill_n(block.get() + block_offset, simdjson::SIMDJSON_PADDING, 0);
+        blocks_.push_back(std::move(block));
         length_ += n;
     }
+
+ private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
 };
 
 class FieldDataArrayImpl : public FieldDataImpl<Array, true> {
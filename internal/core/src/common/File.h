@@ -16,6 +16,10 @@
 #include "fmt/core.h"
 #include <fcntl.h>
 #include <unistd.h>
+#include <cstring>
+#include <string>
+
+#include "common/EasyAssert.h"
 
 namespace milvus {
 class File {
@@ -51,6 +55,24 @@ class File {
         return write(fd_, buf, size);
     }
 
+    // write the whole buffer at the offset, retrying on short writes,
+    // return the bytes written which is less than size only on error
+    size_t
+    WriteAt(const void* buf, size_t size, off_t offset) {
+        size_t written = 0;
+        while (written < size) {
+            auto n = pwrite(fd_,
+                            static_cast<const char*>(buf) + written,
+                            size - written,
+                            offset + written);
+            if (n <= 0) {
+                break;
+            }
+            written += n;
+        }
+        return written;
+    }
+
     void
     Close() {
         close(fd_);
@@ -25,6 +25,7 @@
 #include <string>
 #include <string_view>
 
+#include "common/BinaryJson.h"
 #include "common/EasyAssert.h"
 #include "simdjson.h"
 #include "fmt/core.h"
@@ -62,7 +63,7 @@ class Json {
         : data_(data, len, len + simdjson::SIMDJSON_PADDING) {
     }
 
-    Json(const Json& json) {
+    Json(const Json& json) : binary_(json.binary_) {
         if (json.own_data_.has_value()) {
             own_data_ = simdjson::padded_string(
                 json.own_data_.value().data(), json.own_data_.value().length());
@@ -71,7 +72,7 @@ class Json {
             data_ = json.data_;
         }
     };
-    Json(Json&& json) noexcept {
+    Json(Json&& json) noexcept : binary_(json.binary_) {
         if (json.own_data_.has_value()) {
             own_data_ = std::move(json.own_data_);
             data_ = own_data_.value();
@@ -89,6 +90,20 @@ class Json {
         } else {
             data_ = json.data_;
         }
+        binary_ = json.binary_;
+        return *this;
+    }
+
+    Json&
+    operator=(Json&& json) noexcept {
+        if (json.own_data_.has_value()) {
+            own_data_ = std::move(json.own_data_);
+            data_ = own_data_.value();
+        } else {
+            own_data_.reset();
+            data_ = json.data_;
+        }
+        binary_ = json.binary_;
         return *this;
     }
 
@@ -127,6 +142,9 @@ class Json {
 
     bool
     exist(std::string_view pointer) const {
+        if (binary_ != nullptr) {
+            return BinaryJson::Find(binary_, pointer) != nullptr;
+        }
         return doc().at_pointer(pointer).error() == simdjson::SUCCESS;
     }
 
@@ -145,9 +163,55 @@ class Json {
     template <typename T>
     value_result<T>
     at(std::string_view pointer) const {
+        if constexpr (IsBinaryType<T>()) {
+            if (binary_ != nullptr) {
+                auto value = BinaryJson::Find(binary_, pointer);
+                if (value == nullptr) {
+                    return simdjson::NO_SUCH_FIELD;
+                }
+                return BinaryJson::Get<T>(value);
+            }
+        }
         return doc().at_pointer(pointer).get<T>();
     }
 
+    // call func with each element of the array at the pointer which is a T,
+    // until it returns false, false if there's no array at the pointer
+    template <typename T, typename Func>
+    bool
+    for_each_element(std::string_view pointer, Func func) const {
+        if constexpr (IsBinaryType<T>()) {
+            if (binary_ != nullptr) {
+                auto array = BinaryJson::Find(binary_, pointer);
+                if (array == nullptr ||
+                    BinaryJson::kind(array) != BinaryJson::Array) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < BinaryJson::Count(array); ++i) {
+                    auto val =
+                        BinaryJson::Get<T>(BinaryJson::Element(array, i));
+                    if (!val.error() && !func(val.value_unsafe())) {
+                        break;
+                    }
+                }
+                return true;
+            }
+        }
+        // the array is iterated in the document, which must outlive it
+        auto document = doc();
+        auto array = document.at_pointer(pointer).get_array();
+        if (array.error()) {
+            return false;
+        }
+        for (auto&& it : array) {
+            auto val = it.template get<T>();
+            if (!val.error() && !func(val.value())) {
+                break;
+            }
+        }
+        return true;
+    }
+
     // get dom array by JSON pointer,
     // call `size()` to get array size,
     // call `at()` to get array element by index,
@@ -162,9 +226,29 @@ class Json {
         return data_;
     }
 
+    // the BinaryJson encoding of the document, which the paths are sought
+    // in instead of parsing the text, nullptr if it's not encoded
+    const char*
+    binary() const {
+        return binary_;
+    }
+
+    void
+    set_binary(const char* binary) {
+        binary_ = binary;
+    }
+
  private:
+    template <typename T>
+    static constexpr bool
+    IsBinaryType() {
+        return std::is_same_v<T, bool> || std::is_same_v<T, int64_t> ||
+               std::is_same_v<T, double> || std::is_same_v<T, std::string_view>;
+    }
+
     std::optional<simdjson::padded_string>
         own_data_{};  // this could be empty, then the Json will be just s view on bytes
     simdjson::padded_string_view data_{};
+    const char* binary_{nullptr};
 };
 }  // namespace milvus
@@ -0,0 +1,130 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "common/LikePattern.h"
+
+#include <utility>
+
+#include "re2/re2.h"
+
+namespace milvus {
+
+LikePattern::LikePattern(std::string_view pattern) {
+    Compile(pattern);
+}
+
+LikePattern::~LikePattern() = default;
+
+LikePattern::LikePattern(LikePattern&&) noexcept = default;
+
+LikePattern&
+LikePattern::operator=(LikePattern&&) noexcept = default;
+
+LikePattern
+LikePattern::Postfix(std::string_view postfix) {
+    LikePattern pattern;
+    pattern.suffix_ = postfix;
+    if (!postfix.empty()) {
+        pattern.literals_.emplace_back(postfix);
+    }
+    pattern.min_length_ = postfix.size();
+    return pattern;
+}
+
+void
+LikePattern::Compile(std::string_view pattern) {
+    // the literal runs split by the wildcards, and the regex of the pattern
+    std::vector<std::string> runs(1);
+    std::string regex;
+    bool any_char = false;
+    auto append_literal = [&](char c) {
+        runs.back().push_back(c);
+        ++min_length_;
+    };
+    auto end_run = [&](std::string_view wildcard) {
+        regex += RE2::QuoteMeta(runs.back());
+        regex += wildcard;
+        runs.emplace_back();
+    };
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        auto c = pattern[i];
+        if (c == '\\' && i + 1 < pattern.size()) {
+            append_literal(pattern[++i]);
+        } else if (c == '%') {
+            end_run(".*");
+        } else if (c == '_') {
+            end_run(".");
+            any_char = true;
+            ++min_length_;
+        } else {
+            append_literal(c);
+        }
+    }
+    regex += RE2::QuoteMeta(runs.back());
+
+    prefix_ = runs.front();
+    exact_ = runs.size() == 1;
+    if (!exact_) {
+        suffix_ = runs.back();
+    }
+    for (size_t i = 0; i < runs.size(); ++i) {
+        if (runs[i].empty()) {
+            continue;
+        }
+        literals_.push_back(runs[i]);
+        if (i > 0 && i + 1 < runs.size()) {
+            inner_.push_back(runs[i]);
+        }
+    }
+    if (any_char) {
+        RE2::Options options;
+        options.set_dot_nl(true);
+        options.set_log_errors(false);
+        regex_ = std::make_unique<RE2>(regex, options);
+    }
+}
+
+bool
+LikePattern::Match(std::string_view str) const {
+    if (exact_) {
+        return str == prefix_;
+    }
+    if (str.size() < min_length_ ||
+        str.compare(0, prefix_.size(), prefix_) != 0 ||
+        str.compare(str.size() - suffix_.size(), suffix_.size(), suffix_) !=
+            0) {
+        return false;
+    }
+    if (regex_ != nullptr) {
+        return RE2::FullMatch(
+            re2::StringPiece(str.data(), str.size()), *regex_);
+    }
+    // the literals between the prefix and the suffix, each searched for after
+    // the previous one
+    auto rest = str.substr(prefix_.size(),
+                           str.size() - prefix_.size() - suffix_.size());
+    for (auto& literal : inner_) {
+        auto pos = rest.find(literal);
+        if (pos == std::string_view::npos) {
+            return false;
+        }
+        rest.remove_prefix(pos + literal.size());
+    }
+    return true;
+}
+
+}  // namespace milvus
@@ -0,0 +1,95 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace re2 {
+class RE2;
+}
+
+namespace milvus {
+
+// LikePattern matches the strings against a LIKE pattern, in which '%'
+// matches any sequence of characters, '_' any single character and '\'
+// escapes the next character.
+//
+// The pattern is split into its literals, a string is checked by the literal
+// prefix and suffix first, then the literals between the '%' are searched for
+// in order with std::string_view::find, which scans for the first byte with
+// memchr. Only the patterns with '_' are compiled into RE2, which runs after
+// the prefix and suffix are checked.
+class LikePattern {
+ public:
+    explicit LikePattern(std::string_view pattern);
+
+    ~LikePattern();
+
+    LikePattern(LikePattern&&) noexcept;
+
+    LikePattern&
+    operator=(LikePattern&&) noexcept;
+
+    // the pattern matching the strings ending with the literal postfix
+    static LikePattern
+    Postfix(std::string_view postfix);
+
+    bool
+    Match(std::string_view str) const;
+
+    void
+    Match(const std::string_view* data, size_t size, bool* res) const {
+        for (size_t i = 0; i < size; ++i) {
+            res[i] = Match(data[i]);
+        }
+    }
+
+    // the literal all the matched strings start with
+    const std::string&
+    prefix() const {
+        return prefix_;
+    }
+
+    // the literals all the matched strings contain
+    const std::vector<std::string>&
+    literals() const {
+        return literals_;
+    }
+
+ private:
+    LikePattern() = default;
+
+    void
+    Compile(std::string_view pattern);
+
+ private:
+    std::string prefix_;
+    std::string suffix_;
+    // the literals between the '%', in order
+    std::vector<std::string> inner_;
+    std::vector<std::string> literals_;
+    // the pattern has no wildcard, the strings equal the prefix
+    bool exact_ = false;
+    size_t min_length_ = 0;
+    std::unique_ptr<re2::RE2> regex_;
+};
+
+}  // namespace milvus
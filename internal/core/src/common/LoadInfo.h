@@ -17,11 +17,13 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "Types.h"
 #include "common/CDataType.h"
+#include "common/Tracer.h"
 
 // NOTE: field_id can be system field
 // NOTE: Refer to common/SystemProperty.cpp for details
@@ -30,6 +32,14 @@ struct FieldBinlogInfo {
     int64_t row_count = -1;
     std::vector<int64_t> entries_nums;
     bool enable_mmap{false};
+    // the madvise advice of the mapped field, chosen by the type of the field
+    // if nullopt, also applied to the binlogs mapped by the chunk cache
+    std::optional<int> mmap_advice;
+    // lock the mapped field in memory within the MlockBudget
+    bool mlock{false};
+    // loaded at the first access by a search or a retrieve instead of by
+    // LoadFieldData, once registered by AddFieldDataInfoForSealed
+    bool lazy_load{false};
     std::vector<std::string> insert_files;
 };
 
@@ -40,6 +50,9 @@ struct LoadFieldDataInfo {
     std::string mmap_dir_path = "";
     std::string url;
     int64_t storage_version = 0;
+    // the trace of the caller, the spans of the load are the children of it
+    opentelemetry::trace::SpanContext trace_ctx =
+        opentelemetry::trace::SpanContext::GetInvalid();
 };
 
 struct LoadDeletedRecordInfo {
@@ -0,0 +1,131 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "common/Numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "log/Log.h"
+
+namespace milvus {
+
+namespace {
+
+const char* NODE_ROOT_PATH = "/sys/devices/system/node";
+
+// parse the cpu list like "0-3,8-11"
+std::vector<int>
+ParseCpuList(const std::string& cpu_list) {
+    std::vector<int> cpus;
+    std::istringstream in(cpu_list);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        auto dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                auto first = std::stoi(range.substr(0, dash));
+                auto last = std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; cpu++) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+}  // namespace
+
+const NumaTopology&
+NumaTopology::GetInstance() {
+    static NumaTopology topology;
+    return topology;
+}
+
+NumaTopology::NumaTopology() {
+    std::error_code ec;
+    for (int node = 0;; node++) {
+        auto path = std::string(NODE_ROOT_PATH) + "/node" +
+                    std::to_string(node) + "/cpulist";
+        if (!std::filesystem::exists(path, ec)) {
+            break;
+        }
+        std::ifstream in(path);
+        std::string cpu_list;
+        std::getline(in, cpu_list);
+        auto cpus = ParseCpuList(cpu_list);
+        // the memory only nodes have no cpus
+        if (!cpus.empty()) {
+            node_cpus_.push_back(std::move(cpus));
+        }
+    }
+    if (node_cpus_.size() <= 1) {
+        node_cpus_.clear();
+        node_cpus_.emplace_back();
+    }
+    for (size_t node = 0; node < node_cpus_.size(); node++) {
+        for (auto cpu : node_cpus_[node]) {
+            if (cpu >= static_cast<int>(cpu_nodes_.size())) {
+                cpu_nodes_.resize(cpu + 1, -1);
+            }
+            cpu_nodes_[cpu] = node;
+        }
+    }
+    LOG_SEGCORE_INFO_ << "Init NumaTopology with " << node_cpus_.size()
+                      << " nodes";
+}
+
+size_t
+NumaTopology::GetCurrentNode() const {
+    auto cpu = sched_getcpu();
+    if (cpu < 0 || cpu >= static_cast<int>(cpu_nodes_.size()) ||
+        cpu_nodes_[cpu] < 0) {
+        return 0;
+    }
+    return cpu_nodes_[cpu];
+}
+
+bool
+BindCurrentThreadToCpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return pthread_setaffinity_np(
+               pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+}
+
+}  // namespace milvus
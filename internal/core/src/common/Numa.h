@@ -0,0 +1,59 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace milvus {
+
+// NumaTopology is the cpus of each NUMA node, read from sysfs, a machine
+// without NUMA, or whose topology can't be read, is taken as a single node
+class NumaTopology {
+ public:
+    static const NumaTopology&
+    GetInstance();
+
+    size_t
+    GetNodeNum() const {
+        return node_cpus_.size();
+    }
+
+    const std::vector<int>&
+    GetNodeCpus(size_t node) const {
+        return node_cpus_[node];
+    }
+
+    // the node of the cpu running the calling thread
+    size_t
+    GetCurrentNode() const;
+
+ private:
+    NumaTopology();
+
+ private:
+    std::vector<std::vector<int>> node_cpus_;
+    // cpu id to node, -1 for the unknown cpus
+    std::vector<int> cpu_nodes_;
+};
+
+// pin the calling thread to the cpus, return false if it fails
+bool
+BindCurrentThreadToCpus(const std::vector<int>& cpus);
+
+}  // namespace milvus
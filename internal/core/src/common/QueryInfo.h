@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
 
+#include "common/CancellationToken.h"
 #include "common/Types.h"
 #include "knowhere/config.h"
 namespace milvus {
@@ -27,6 +31,18 @@ struct SearchInfo {
     FieldId field_id_;
     MetricType metric_type_;
     knowhere::Json search_params_;
+    // if set, only the best result of every group of the rows with the same
+    // value of the field is kept, and topk_ is the number of the groups
+    std::optional<FieldId> group_by_field_id_;
+    // whether the search is profiled, by the SEARCH_PROFILE search param
+    bool profile_ = false;
+    // the lower bounds of the effort params of search_params_ the search
+    // may be scaled down to under overload, by the ADAPTIVE_SEARCH search
+    // param, empty if the search always runs with the requested ones
+    std::map<std::string, int64_t> adaptive_bounds_;
+    // the cancellation of the search, checked by its stages, none if it's
+    // never canceled
+    CancellationTokenPtr cancellation_token_;
 };
 
 using SearchInfoPtr = std::shared_ptr<SearchInfo>;
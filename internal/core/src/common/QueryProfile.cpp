@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/QueryProfile.h"
+
+#include <nlohmann/json.hpp>
+
+namespace milvus {
+
+void
+QueryProfile::Add(const ProfileStage& stage) {
+    std::lock_guard lck(mutex_);
+    for (auto& existing : stages_) {
+        if (existing.name_ == stage.name_) {
+            if (existing.path_.empty()) {
+                existing.path_ = stage.path_;
+            }
+            existing.wall_time_us_ += stage.wall_time_us_;
+            existing.input_rows_ += stage.input_rows_;
+            existing.output_rows_ += stage.output_rows_;
+            existing.batches_ += stage.batches_;
+            existing.bytes_ += stage.bytes_;
+            return;
+        }
+    }
+    stages_.push_back(stage);
+}
+
+std::vector<ProfileStage>
+QueryProfile::Stages() const {
+    std::lock_guard lck(mutex_);
+    return stages_;
+}
+
+std::string
+QueryProfile::ToJson() const {
+    auto stages = nlohmann::json::array();
+    for (auto& stage : Stages()) {
+        stages.push_back({{"name", stage.name_},
+                          {"path", stage.path_},
+                          {"wall_time_us", stage.wall_time_us_},
+                          {"input_rows", stage.input_rows_},
+                          {"output_rows", stage.output_rows_},
+                          {"batches", stage.batches_},
+                          {"bytes", stage.bytes_}});
+    }
+    return stages.dump();
+}
+
+}  // namespace milvus
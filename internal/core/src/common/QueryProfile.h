@@ -0,0 +1,118 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+
+// the stats of a stage of a search on a segment, like the filter, an
+// operator or an expression of the filter
+struct ProfileStage {
+    std::string name_;
+    // the path the stage took, like index or brute_force, empty if the stage
+    // has a single one
+    std::string path_;
+    // the wall time of a stage includes the ones of the stages it calls, like
+    // the ones of the inputs of an expression
+    int64_t wall_time_us_ = 0;
+    int64_t input_rows_ = 0;
+    int64_t output_rows_ = 0;
+    int64_t batches_ = 0;
+    // the bytes of the fixed width data read, 0 if unknown
+    int64_t bytes_ = 0;
+};
+
+// The profile of a search on a segment, collected only if the search asks
+// for it by the SEARCH_PROFILE search param.
+//
+// The stages recorded under the same name are summed up, like the batches of
+// an expression or the row ranges of a filter evaluated in parallel, which
+// record the stages from the threads of the pool.
+class QueryProfile {
+ public:
+    void
+    Add(const ProfileStage& stage);
+
+    // in the order first recorded
+    std::vector<ProfileStage>
+    Stages() const;
+
+    // the json array of the stages
+    std::string
+    ToJson() const;
+
+ private:
+    mutable std::mutex mutex_;
+    std::vector<ProfileStage> stages_;
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+// Record the stage with the wall time from the construction to Stop or the
+// destruction, nothing is recorded if the profile is nullptr. The stats set
+// after Stop are recorded without being timed.
+class ProfileTimer {
+ public:
+    ProfileTimer(QueryProfile* profile, std::string name) : profile_(profile) {
+        if (profile_ != nullptr) {
+            stage_.name_ = std::move(name);
+            stage_.batches_ = 1;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer&
+    operator=(const ProfileTimer&) = delete;
+
+    ~ProfileTimer() {
+        if (profile_ != nullptr) {
+            Stop();
+            profile_->Add(stage_);
+        }
+    }
+
+    bool
+    enabled() const {
+        return profile_ != nullptr;
+    }
+
+    ProfileStage&
+    stage() {
+        return stage_;
+    }
+
+    void
+    Stop() {
+        if (profile_ != nullptr && !stopped_) {
+            stage_.wall_time_us_ =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_)
+                    .count();
+            stopped_ = true;
+        }
+    }
+
+ private:
+    QueryProfile* profile_;
+    ProfileStage stage_;
+    std::chrono::steady_clock::time_point start_;
+    bool stopped_ = false;
+};
+
+}  // namespace milvus
@@ -21,15 +21,26 @@
 #include <limits>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 #include <boost/align/aligned_allocator.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <NamedType/named_type.hpp>
 
 #include "common/FieldMeta.h"
+#include "common/QueryProfile.h"
 #include "pb/schema.pb.h"
 
 namespace milvus {
+// the value of the group by field of a result, monostate for no result
+using GroupByValueType = std::variant<std::monostate,
+                                      bool,
+                                      int8_t,
+                                      int16_t,
+                                      int32_t,
+                                      int64_t,
+                                      std::string>;
+
 struct SearchResult {
     SearchResult() = default;
 
@@ -52,6 +63,8 @@ struct SearchResult {
     // first fill data during search, and then update data after reducing search results
     std::vector<float> distances_;
     std::vector<int64_t> seg_offsets_;
+    // the group by values of the results, empty if the search is not grouped
+    std::vector<GroupByValueType> group_by_values_;
 
     // first fill data during fillPrimaryKey, and then update data after reducing search results
     std::vector<PkType> primary_keys_;
@@ -67,6 +80,14 @@ struct SearchResult {
 
     // used for reduce, filter invalid pk, get real topks count
     std::vector<size_t> topk_per_nq_prefix_sum_;
+
+    // the profile of the search on the segment, nullptr if the search isn't
+    // profiled
+    QueryProfilePtr profile_;
+
+    // the effort params the search on the segment ran with if scaled down
+    // by the adaptive search, empty if it ran with the requested ones
+    std::map<std::string, int64_t> adapted_search_params_;
 };
 
 using SearchResultPtr = std::shared_ptr<SearchResult>;
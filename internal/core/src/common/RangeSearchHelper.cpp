@@ -9,19 +9,15 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
-#include <queue>
+#include <algorithm>
+#include <numeric>
 #include <vector>
-#include <functional>
 
 #include "common/Utils.h"
 #include "common/RangeSearchHelper.h"
 
 namespace milvus {
 
-namespace {
-using ResultPair = std::pair<float, int64_t>;
-}
-
 /* Sort and return TOPK items as final range search result */
 DatasetPtr
 ReGenRangeSearchResult(DatasetPtr data_set,
@@ -75,33 +71,35 @@ ReGenRangeSearchResult(DatasetPtr data_set,
      *                           V
      *                          topk
      */
-    std::function<bool(const ResultPair&, const ResultPair&)> cmp =
-        std::less<>();
-    if (PositivelyRelated(metric_type)) {
-        cmp = std::greater<>();
-    }
+    // the results of a query are ordered by (distance, id), ascending or
+    // descending by the metric, only the topk first of them are selected
+    // and sorted, the others are left unordered
+    auto positively_related = PositivelyRelated(metric_type);
+    auto before = [&](int64_t a, int64_t b) {
+        if (dist[a] != dist[b]) {
+            return positively_related ? dist[a] > dist[b] : dist[a] < dist[b];
+        }
+        return positively_related ? id[a] > id[b] : id[a] < id[b];
+    };
 
     // The subscript of p_id and p_dist
+    std::vector<int64_t> offsets;
     for (int i = 0; i < nq; i++) {
-        std::priority_queue<ResultPair, std::vector<ResultPair>, decltype(cmp)>
-            pq(cmp);
-        auto capacity = std::min<int64_t>(lims[i + 1] - lims[i], topk);
-
-        for (size_t j = lims[i]; j < lims[i + 1]; j++) {
-            auto curr = ResultPair(dist[j], id[j]);
-            if (pq.size() < capacity) {
-                pq.push(curr);
-            } else if (cmp(curr, pq.top())) {
-                pq.pop();
-                pq.push(curr);
-            }
+        int64_t size = lims[i + 1] - lims[i];
+        auto capacity = std::min<int64_t>(size, topk);
+        offsets.resize(size);
+        std::iota(offsets.begin(), offsets.end(), int64_t(lims[i]));
+        if (capacity < size) {
+            std::nth_element(offsets.begin(),
+                             offsets.begin() + capacity,
+                             offsets.end(),
+                             before);
         }
+        std::sort(offsets.begin(), offsets.begin() + capacity, before);
 
-        for (int j = capacity - 1; j >= 0; j--) {
-            auto& node = pq.top();
-            p_dist[i * topk + j] = node.first;
-            p_id[i * topk + j] = node.second;
-            pq.pop();
+        for (int64_t j = 0; j < capacity; j++) {
+            p_dist[i * topk + j] = dist[offsets[j]];
+            p_id[i * topk + j] = id[offsets[j]];
         }
     }
     return GenResultDataset(nq, topk, p_id, p_dist);
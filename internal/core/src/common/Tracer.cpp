@@ -134,4 +134,57 @@ isEmptyID(const uint8_t* id, int length) {
     return true;
 }
 
+trace::SpanContext
+ToSpanContext(const TraceContext* ctx) {
+    if (ctx == nullptr || ctx->traceID == nullptr || ctx->spanID == nullptr ||
+        isEmptyID(ctx->traceID, trace::TraceId::kSize) ||
+        isEmptyID(ctx->spanID, trace::SpanId::kSize)) {
+        return trace::SpanContext::GetInvalid();
+    }
+    return trace::SpanContext(
+        trace::TraceId({ctx->traceID, trace::TraceId::kSize}),
+        trace::SpanId({ctx->spanID, trace::SpanId::kSize}),
+        trace::TraceFlags(ctx->flag),
+        true);
+}
+
+std::shared_ptr<trace::Span>
+GetRootSpan() {
+    return local_span;
+}
+
+AutoSpan::AutoSpan(const std::string& name, const trace::SpanContext& parent) {
+    if (!enable_trace) {
+        return;
+    }
+    previous_ = local_span;
+    trace::StartSpanOptions opts;
+    if (parent.IsValid()) {
+        opts.parent = parent;
+    } else if (previous_ != nullptr) {
+        opts.parent = previous_->GetContext();
+    }
+    span_ = GetTracer()->StartSpan(name, opts);
+    local_span = span_;
+}
+
+AutoSpan::~AutoSpan() {
+    if (span_ != nullptr) {
+        span_->End();
+        local_span = std::move(previous_);
+    }
+}
+
+ScopedRootSpan::ScopedRootSpan(std::shared_ptr<trace::Span> span) {
+    if (enable_trace) {
+        previous_ = std::exchange(local_span, std::move(span));
+    }
+}
+
+ScopedRootSpan::~ScopedRootSpan() {
+    if (enable_trace) {
+        local_span = std::move(previous_);
+    }
+}
+
 }  // namespace milvus::tracer
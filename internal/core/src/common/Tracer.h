@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include "opentelemetry/common/attribute_value.h"
 #include "opentelemetry/sdk/version/version.h"
 #include "opentelemetry/trace/provider.h"
 
@@ -57,4 +58,65 @@ AddEvent(std::string event_label);
 bool
 isEmptyID(const uint8_t* id, const int length);
 
+// the span context of the caller, with the ids copied so it outlives the
+// trace context, invalid if the caller is not traced
+trace::SpanContext
+ToSpanContext(const TraceContext* ctx);
+
+// the current span of the thread, set by SetRootSpan or an AutoSpan, nullptr
+// if there is none
+std::shared_ptr<trace::Span>
+GetRootSpan();
+
+// AutoSpan starts a span as the child of the parent if it's valid, or else of
+// the current span of the thread, and makes it the current span of the thread
+// until the span ends with the scope, so the spans nest as the calls do. The
+// tasks submitted to the thread pools run under the current span of the
+// submitting thread, the spans they start are the children of it.
+class AutoSpan {
+ public:
+    explicit AutoSpan(
+        const std::string& name,
+        const trace::SpanContext& parent = trace::SpanContext::GetInvalid());
+
+    AutoSpan(const AutoSpan&) = delete;
+    AutoSpan&
+    operator=(const AutoSpan&) = delete;
+
+    ~AutoSpan();
+
+    void
+    SetAttribute(opentelemetry::nostd::string_view key,
+                 const opentelemetry::common::AttributeValue& value) {
+        if (span_ != nullptr) {
+            span_->SetAttribute(key, value);
+        }
+    }
+
+    const std::shared_ptr<trace::Span>&
+    GetSpan() const {
+        return span_;
+    }
+
+ private:
+    std::shared_ptr<trace::Span> span_;
+    std::shared_ptr<trace::Span> previous_;
+};
+
+// ScopedRootSpan makes the span the current span of the thread within the
+// scope, and restores the previous one after
+class ScopedRootSpan {
+ public:
+    explicit ScopedRootSpan(std::shared_ptr<trace::Span> span);
+
+    ScopedRootSpan(const ScopedRootSpan&) = delete;
+    ScopedRootSpan&
+    operator=(const ScopedRootSpan&) = delete;
+
+    ~ScopedRootSpan();
+
+ private:
+    std::shared_ptr<trace::Span> previous_;
+};
+
 }  // namespace milvus::tracer
@@ -153,8 +153,12 @@ using FieldName = fluent::NamedType<std::string,
 using SegOffset =
     fluent::NamedType<int64_t, impl::SegOffsetTag, fluent::Arithmetic>;
 
-using BitsetType = boost::dynamic_bitset<>;
-using BitsetTypePtr = std::shared_ptr<boost::dynamic_bitset<>>;
+// the blocks are 64 bytes aligned, so that the word level operations and the
+// simd kernels working on the raw data never split a cache line
+using BitsetAllocator =
+    boost::alignment::aligned_allocator<unsigned long, 64>;
+using BitsetType = boost::dynamic_bitset<unsigned long, BitsetAllocator>;
+using BitsetTypePtr = std::shared_ptr<BitsetType>;
 using BitsetTypeOpt = std::optional<BitsetType>;
 
 template <typename Type>
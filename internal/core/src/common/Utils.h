@@ -167,6 +167,21 @@ PositivelyRelated(const knowhere::MetricType& metric_type) {
            IsMetricType(metric_type, knowhere::metric::COSINE);
 }
 
+// the bytes of the heap held by the string, none if it's short enough to be
+// kept inside the string object
+inline size_t
+StringHeapByteSize(const std::string& value) {
+    static const auto inline_capacity = std::string().capacity();
+    return value.capacity() > inline_capacity ? value.capacity() + 1 : 0;
+}
+
+// the bytes of the heap held by the pk
+inline size_t
+PkHeapByteSize(const PkType& pk) {
+    auto value = std::get_if<std::string>(&pk);
+    return value != nullptr ? StringHeapByteSize(*value) : 0;
+}
+
 inline std::string
 KnowhereStatusString(knowhere::Status status) {
     return knowhere::Status2String(status);
@@ -25,7 +25,8 @@
 #include "common/Tracer.h"
 #include "log/Log.h"
 
-std::once_flag flag1, flag2, flag3, flag4, flag5, flag6;
+std::once_flag flag1, flag2, flag3, flag4, flag5, flag6, flag7, flag8, flag9,
+    flag10;
 std::once_flag traceFlag;
 
 void
@@ -78,6 +79,36 @@ InitDefaultExprEvalBatchSize(int64_t val) {
         val);
 }
 
+void
+InitExprEvalWorkingSetSize(int64_t val) {
+    std::call_once(
+        flag9,
+        [](int64_t val) { milvus::SetExecEvalExprWorkingSetSize(val); },
+        val);
+}
+
+void
+InitThreadPoolNumaAware(bool numa_aware) {
+    std::call_once(
+        flag7,
+        [](bool numa_aware) { milvus::SetThreadPoolNumaAware(numa_aware); },
+        numa_aware);
+}
+
+void
+InitHugePageMode(int mode) {
+    std::call_once(
+        flag8, [](int mode) { milvus::SetHugePageMode(mode); }, mode);
+}
+
+void
+InitStageVectorBuildInput(bool stage) {
+    std::call_once(
+        flag10,
+        [](bool stage) { milvus::SetStageVectorBuildInput(stage); },
+        stage);
+}
+
 void
 InitTrace(CTraceConfig* config) {
     auto traceConfig = milvus::tracer::TraceConfig{config->exporter,
@@ -39,9 +39,26 @@ InitLowPriorityThreadCoreCoefficient(const int64_t);
 void
 InitDefaultExprEvalBatchSize(int64_t val);
 
+// the bytes of the fields read by a batch of the expression evaluation, the
+// batch size is chosen to fit them if positive
+void
+InitExprEvalWorkingSetSize(int64_t val);
+
 void
 InitCpuNum(const int);
 
+void
+InitThreadPoolNumaAware(bool);
+
+// 0 disables the huge pages, 1 advises the transparent huge pages, 2 maps
+// the hugetlb pages
+void
+InitHugePageMode(int);
+
+// build the in memory vector indexes from a local file of their binlogs
+void
+InitStageVectorBuildInput(bool);
+
 void
 InitTrace(CTraceConfig* config);
 
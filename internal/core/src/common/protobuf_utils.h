@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <map>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/text_format.h>
 
 #include "pb/schema.pb.h"
@@ -38,4 +40,19 @@ RepeatedKeyValToMap(
     }
     return mapping;
 }
+
+// The options of the arena to parse a message of size bytes on. The parsed
+// message takes about the bytes of its serialized form, so its submessages
+// and repeated fields are allocated in a block or two of that size instead
+// of one by one, and freed at once with the arena.
+inline google::protobuf::ArenaOptions
+ParseArenaOptions(int64_t size) {
+    constexpr int64_t kMinBlockSize = 256;
+    constexpr int64_t kMaxBlockSize = 64 << 20;
+    google::protobuf::ArenaOptions options;
+    options.start_block_size =
+        std::clamp(size + size / 4, kMinBlockSize, kMaxBlockSize);
+    options.max_block_size = options.start_block_size;
+    return options;
+}
 }  //namespace milvus
@@ -88,6 +88,9 @@ typedef struct CStorageConfig {
     bool useIAM;
     bool useVirtualHost;
     int64_t requestTimeoutMs;
+    // 0 to use the default value
+    int64_t readPartSize;
+    int64_t readConcurrency;
 } CStorageConfig;
 
 typedef struct CTraceConfig {
@@ -164,6 +164,21 @@ Driver::Next(std::shared_ptr<BlockingState>& blocking_state) {
                         e.what()));                                            \
     }
 
+// the output of the operator, the batch is recorded into the profile if the
+// query is profiled
+static RowVectorPtr
+GetOperatorOutput(Operator* op, QueryProfile* profile) {
+    ProfileTimer timer(profile, op->get_operator_type());
+    auto result = op->GetOutput();
+    timer.Stop();
+    if (result == nullptr) {
+        timer.stage().batches_ = 0;
+    } else {
+        timer.stage().output_rows_ = result->size();
+    }
+    return result;
+}
+
 StopReason
 Driver::RunInternal(std::shared_ptr<Driver>& self,
                     std::shared_ptr<BlockingState>& blocking_state,
@@ -171,8 +186,14 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
     try {
         int num_operators = operators_.size();
         ContinueFuture future;
+        auto query_context = ctx_->task_->query_context();
+        auto profile = query_context->get_profile();
+        auto& cancellation_token = query_context->get_cancellation_token();
 
         for (;;) {
+            // a canceled query stops at the boundary of the batches, failing
+            // the task with Canceled
+            CheckCancellation(cancellation_token);
             for (int32_t i = num_operators - 1; i >= 0; --i) {
                 auto op = operators_[i].get();
 
@@ -206,7 +227,9 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                         RowVectorPtr result;
                         {
                             CALL_OPERATOR(
-                                result = op->GetOutput(), op, "GetOutput");
+                                result = GetOperatorOutput(op, profile),
+                                op,
+                                "GetOutput");
                             if (result) {
                                 AssertInfo(
                                     result->size() > 0,
@@ -246,8 +269,9 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                     }
                 } else {
                     {
-                        CALL_OPERATOR(
-                            result = op->GetOutput(), op, "GetOutput");
+                        CALL_OPERATOR(result = GetOperatorOutput(op, profile),
+                                      op,
+                                      "GetOutput");
                         if (result) {
                             AssertInfo(
                                 result->size() > 0,
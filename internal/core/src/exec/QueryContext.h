@@ -17,16 +17,21 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <folly/Executor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/Optional.h>
 
+#include "common/CancellationToken.h"
 #include "common/Common.h"
 #include "common/Types.h"
 #include "common/Exception.h"
+#include "common/QueryProfile.h"
+#include "exec/VectorPool.h"
 #include "segcore/SegmentInterface.h"
 
 namespace milvus {
@@ -125,6 +130,14 @@ class QueryConfig : public MemConfig {
 
     QueryConfig() = default;
 
+    // the default config is never modified, so it is shared by all the
+    // queries instead of created for each segment evaluated
+    static std::shared_ptr<QueryConfig>
+    Default() {
+        static auto config = std::make_shared<QueryConfig>();
+        return config;
+    }
+
     bool
     get_expr_eval_simplified() const {
         return BaseConfig::Get<bool>(kExprEvalSimplified, false);
@@ -135,6 +148,11 @@ class QueryConfig : public MemConfig {
         return BaseConfig::Get<int64_t>(kExprEvalBatchSize,
                                         EXEC_EVAL_EXPR_BATCH_SIZE);
     }
+
+    bool
+    has_expr_batch_size() const {
+        return IsValueExists(kExprEvalBatchSize);
+    }
 };
 
 class Context {
@@ -176,7 +194,7 @@ class QueryContext : public Context {
                  const milvus::segcore::SegmentInternalInterface* segment,
                  milvus::Timestamp timestamp,
                  std::shared_ptr<QueryConfig> query_config =
-                     std::make_shared<QueryConfig>(),
+                     QueryConfig::Default(),
                  folly::Executor* executor = nullptr,
                  std::unordered_map<std::string, std::shared_ptr<Config>>
                      connector_configs = {})
@@ -218,6 +236,74 @@ class QueryContext : public Context {
         return query_timestamp_;
     }
 
+    // evaluate the expressions only on the given sorted segment offsets
+    // instead of all the rows, the offsets must outlive the query
+    void
+    set_offset_input(const std::vector<int64_t>* offset_input) {
+        offset_input_ = offset_input;
+    }
+
+    const std::vector<int64_t>*
+    get_offset_input() {
+        return offset_input_;
+    }
+
+    // evaluate the expressions only on the rows in [begin, end) of a sealed
+    // segment, the ranges are evaluated in parallel by different queries
+    void
+    set_row_range(int64_t begin, int64_t end) {
+        row_range_ = std::make_pair(begin, end);
+    }
+
+    const std::optional<std::pair<int64_t, int64_t>>&
+    get_row_range() {
+        return row_range_;
+    }
+
+    // the batch size chosen for the expressions compiled, the configured one
+    // if not set
+    void
+    set_expr_batch_size(int64_t batch_size) {
+        expr_batch_size_ = batch_size;
+    }
+
+    int64_t
+    get_expr_batch_size() const {
+        return expr_batch_size_.value_or(query_config_->get_expr_batch_size());
+    }
+
+    // the profile the operators and the expressions record their stages
+    // into, nullptr if the query isn't profiled
+    void
+    set_profile(QueryProfile* profile) {
+        profile_ = profile;
+    }
+
+    QueryProfile*
+    get_profile() const {
+        return profile_;
+    }
+
+    // the id of the next expression compiled, the expressions are named by
+    // the ids in the profile, so the ids of the queries of the row ranges
+    // evaluated in parallel agree
+    int64_t
+    next_profile_expr_id() {
+        return num_profiled_exprs_++;
+    }
+
+    // the cancellation of the query, checked by the drivers between the
+    // batches, nullptr if the query is never canceled
+    void
+    set_cancellation_token(CancellationTokenPtr token) {
+        cancellation_token_ = std::move(token);
+    }
+
+    const CancellationTokenPtr&
+    get_cancellation_token() const {
+        return cancellation_token_;
+    }
+
  private:
     folly::Executor* executor_;
     //folly::Executor::KeepAlive<> executor_keepalive_;
@@ -229,6 +315,12 @@ class QueryContext : public Context {
     const milvus::segcore::SegmentInternalInterface* segment_;
     // timestamp this query generate
     milvus::Timestamp query_timestamp_;
+    const std::vector<int64_t>* offset_input_ = nullptr;
+    std::optional<std::pair<int64_t, int64_t>> row_range_;
+    std::optional<int64_t> expr_batch_size_;
+    QueryProfile* profile_ = nullptr;
+    int64_t num_profiled_exprs_ = 0;
+    CancellationTokenPtr cancellation_token_;
 };
 
 // Represent the state of one thread of query execution.
@@ -249,8 +341,15 @@ class ExecContext : public Context {
         return query_context_->query_config();
     }
 
+    // the result vectors of the expressions evaluated by the thread
+    VectorPool&
+    get_vector_pool() {
+        return vector_pool_;
+    }
+
  private:
     QueryContext* query_context_;
+    VectorPool vector_pool_;
 };
 
 }  // namespace exec
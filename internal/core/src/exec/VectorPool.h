@@ -0,0 +1,69 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common/FieldMeta.h"
+#include "common/Types.h"
+#include "common/Vector.h"
+
+namespace milvus {
+namespace exec {
+
+// VectorPool recycles the fixed width result vectors of the expressions
+// across the batches. A vector is free again once the pool holds its only
+// reference, i.e. the consumer of the batch it was returned for dropped
+// it, so nothing is released explicitly. It's owned by an ExecContext and
+// used by one thread at a time.
+class VectorPool {
+ public:
+    // a zeroed vector of size rows of the type, as a new ColumnVector is
+    ColumnVectorPtr
+    Get(DataType type, int64_t size) {
+        for (auto& vec : vectors_) {
+            if (vec.use_count() == 1 && vec->type() == type &&
+                vec->size() == size) {
+                std::memset(
+                    vec->GetRawData(), 0, size * datatype_sizeof(type));
+                return vec;
+            }
+        }
+        auto vec = std::make_shared<ColumnVector>(type, size);
+        if (!datatype_is_variable(type) && vectors_.size() < MAX_VECTORS) {
+            vectors_.push_back(vec);
+        }
+        return vec;
+    }
+
+    size_t
+    size() const {
+        return vectors_.size();
+    }
+
+ private:
+    // the vectors still held by the consumers aren't reused, keep the pool
+    // bounded if they are never released
+    static constexpr size_t MAX_VECTORS = 16;
+
+    std::vector<ColumnVectorPtr> vectors_;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -21,6 +21,7 @@ namespace exec {
 
 void
 PhyAlwaysTrueExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetVectorPool(context);
     int64_t real_batch_size = current_pos_ + batch_size_ >= num_rows_
                                   ? num_rows_ - current_pos_
                                   : batch_size_;
@@ -30,8 +31,7 @@ PhyAlwaysTrueExpr::Eval(EvalCtx& context, VectorPtr& result) {
         return;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res_bool = (bool*)res_vec->GetRawData();
     for (size_t i = 0; i < real_batch_size; ++i) {
         res_bool[i] = true;
@@ -45,6 +45,17 @@ class PhyAlwaysTrueExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetOffsetInput(const std::vector<int64_t>* offset_input) override {
+        num_rows_ = offset_input->size();
+    }
+
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        current_pos_ = begin;
+        num_rows_ = end;
+    }
+
  private:
     std::shared_ptr<const milvus::expr::AlwaysTrueExpr> expr_;
     int64_t num_rows_;
@@ -21,6 +21,8 @@ namespace exec {
 
 void
 PhyBinaryArithOpEvalRangeExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     switch (expr_->column_.data_type_) {
         case DataType::BOOL: {
             result = ExecRangeVisitorImpl<bool>();
@@ -111,8 +113,7 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForJson() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
@@ -291,8 +292,7 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForArray() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     int index = -1;
@@ -466,125 +466,13 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForIndex() {
                                  HighPrecisionType value,
                                  HighPrecisionType right_operand) {
         FixedVector<bool> res;
-        switch (op_type) {
-            case proto::plan::OpType::Equal: {
-                switch (arith_type) {
-                    case proto::plan::ArithOpType::Add: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::Equal,
-                                         proto::plan::ArithOpType::Add>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Sub: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::Equal,
-                                         proto::plan::ArithOpType::Sub>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mul: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::Equal,
-                                         proto::plan::ArithOpType::Mul>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Div: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::Equal,
-                                         proto::plan::ArithOpType::Div>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mod: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::Equal,
-                                         proto::plan::ArithOpType::Mod>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    default:
-                        PanicInfo(
-                            OpTypeInvalid,
-                            fmt::format("unsupported arith type for binary "
-                                        "arithmetic eval expr: {}",
-                                        arith_type));
-                }
-                break;
-            }
-            case proto::plan::OpType::NotEqual: {
-                switch (arith_type) {
-                    case proto::plan::ArithOpType::Add: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::NotEqual,
-                                         proto::plan::ArithOpType::Add>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Sub: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::NotEqual,
-                                         proto::plan::ArithOpType::Sub>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mul: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::NotEqual,
-                                         proto::plan::ArithOpType::Mul>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Div: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::NotEqual,
-                                         proto::plan::ArithOpType::Div>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mod: {
-                        ArithOpIndexFunc<T,
-                                         proto::plan::OpType::NotEqual,
-                                         proto::plan::ArithOpType::Mod>
-                            func;
-                        res = std::move(func(
-                            index_ptr, sub_batch_size, value, right_operand));
-                        break;
-                    }
-                    default:
-                        PanicInfo(
-                            OpTypeInvalid,
-                            fmt::format("unsupported arith type for binary "
-                                        "arithmetic eval expr: {}",
-                                        arith_type));
-                }
-                break;
-            }
-            default:
-                PanicInfo(OpTypeInvalid,
-                          "unsupported operator type for binary "
-                          "arithmetic eval expr: {}",
-                          op_type);
-        }
+        DispatchArithOp(op_type, arith_type, [&](auto cmp_op, auto arith_op) {
+            ArithOpIndexFunc<T,
+                             decltype(cmp_op)::value,
+                             decltype(arith_op)::value>
+                func;
+            res = func(index_ptr, sub_batch_size, value, right_operand);
+        });
         return res;
     };
     auto res = ProcessIndexChunks<T>(execute_sub_batch, value, right_operand);
@@ -612,8 +500,7 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForData() {
     auto value = GetValueFromProto<HighPrecisionType>(expr_->value_);
     auto right_operand =
         GetValueFromProto<HighPrecisionType>(expr_->right_operand_);
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     auto op_type = expr_->op_type_;
@@ -624,115 +511,13 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForData() {
                                  bool* res,
                                  HighPrecisionType value,
                                  HighPrecisionType right_operand) {
-        switch (op_type) {
-            case proto::plan::OpType::Equal: {
-                switch (arith_type) {
-                    case proto::plan::ArithOpType::Add: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::Equal,
-                                           proto::plan::ArithOpType::Add>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Sub: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::Equal,
-                                           proto::plan::ArithOpType::Sub>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mul: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::Equal,
-                                           proto::plan::ArithOpType::Mul>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Div: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::Equal,
-                                           proto::plan::ArithOpType::Div>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mod: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::Equal,
-                                           proto::plan::ArithOpType::Mod>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    default:
-                        PanicInfo(
-                            OpTypeInvalid,
-                            fmt::format("unsupported arith type for binary "
-                                        "arithmetic eval expr: {}",
-                                        arith_type));
-                }
-                break;
-            }
-            case proto::plan::OpType::NotEqual: {
-                switch (arith_type) {
-                    case proto::plan::ArithOpType::Add: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::NotEqual,
-                                           proto::plan::ArithOpType::Add>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Sub: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::NotEqual,
-                                           proto::plan::ArithOpType::Sub>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mul: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::NotEqual,
-                                           proto::plan::ArithOpType::Mul>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Div: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::NotEqual,
-                                           proto::plan::ArithOpType::Div>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    case proto::plan::ArithOpType::Mod: {
-                        ArithOpElementFunc<T,
-                                           proto::plan::OpType::NotEqual,
-                                           proto::plan::ArithOpType::Mod>
-                            func;
-                        func(data, size, value, right_operand, res);
-                        break;
-                    }
-                    default:
-                        PanicInfo(
-                            OpTypeInvalid,
-                            fmt::format("unsupported arith type for binary "
-                                        "arithmetic eval expr: {}",
-                                        arith_type));
-                }
-                break;
-            }
-            default:
-                PanicInfo(OpTypeInvalid,
-                          "unsupported operator type for binary "
-                          "arithmetic eval expr: {}",
-                          op_type);
-        }
+        DispatchArithOp(op_type, arith_type, [&](auto cmp_op, auto arith_op) {
+            ArithOpElementFunc<T,
+                               decltype(cmp_op)::value,
+                               decltype(arith_op)::value>
+                func;
+            func(data, size, value, right_operand, res);
+        });
     };
     int64_t processed_size = ProcessDataChunks<T>(
         execute_sub_batch, std::nullptr_t{}, res, value, right_operand);
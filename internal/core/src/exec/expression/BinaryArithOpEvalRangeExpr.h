@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <type_traits>
 #include <fmt/core.h>
 
 #include "common/EasyAssert.h"
@@ -28,6 +31,62 @@
 namespace milvus {
 namespace exec {
 
+// calls func with the compare and the arith op types as integral constants,
+// so that the kernels are specialized at compile time and the op types are
+// dispatched once per batch instead of once per row
+template <typename Func>
+void
+DispatchArithOp(proto::plan::OpType op_type,
+                proto::plan::ArithOpType arith_type,
+                Func&& func) {
+    auto dispatch_arith_type = [&](auto cmp_op) {
+        using ArithOpType = proto::plan::ArithOpType;
+        switch (arith_type) {
+            case ArithOpType::Add:
+                func(cmp_op,
+                     std::integral_constant<ArithOpType, ArithOpType::Add>{});
+                break;
+            case ArithOpType::Sub:
+                func(cmp_op,
+                     std::integral_constant<ArithOpType, ArithOpType::Sub>{});
+                break;
+            case ArithOpType::Mul:
+                func(cmp_op,
+                     std::integral_constant<ArithOpType, ArithOpType::Mul>{});
+                break;
+            case ArithOpType::Div:
+                func(cmp_op,
+                     std::integral_constant<ArithOpType, ArithOpType::Div>{});
+                break;
+            case ArithOpType::Mod:
+                func(cmp_op,
+                     std::integral_constant<ArithOpType, ArithOpType::Mod>{});
+                break;
+            default:
+                PanicInfo(OpTypeInvalid,
+                          fmt::format("unsupported arith type for binary "
+                                      "arithmetic eval expr: {}",
+                                      arith_type));
+        }
+    };
+    using OpType = proto::plan::OpType;
+    switch (op_type) {
+        case OpType::Equal:
+            dispatch_arith_type(
+                std::integral_constant<OpType, OpType::Equal>{});
+            break;
+        case OpType::NotEqual:
+            dispatch_arith_type(
+                std::integral_constant<OpType, OpType::NotEqual>{});
+            break;
+        default:
+            PanicInfo(OpTypeInvalid,
+                      "unsupported operator type for binary "
+                      "arithmetic eval expr: {}",
+                      op_type);
+    }
+}
+
 template <typename T,
           proto::plan::OpType cmp_op,
           proto::plan::ArithOpType arith_op>
@@ -43,52 +102,137 @@ struct ArithOpElementFunc {
                HighPrecisonType val,
                HighPrecisonType right_operand,
                bool* res) {
-        for (int i = 0; i < size; ++i) {
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<bool, T>) {
+            ExecInteger(src, size, val, right_operand, res);
+        } else {
+            ExecGeneric(src, size, val, right_operand, res);
+        }
+    }
+
+ private:
+    template <typename L>
+    static bool
+    Compare(L left, HighPrecisonType right) {
+        if constexpr (cmp_op == proto::plan::OpType::Equal) {
+            return left == right;
+        } else {
+            return left != right;
+        }
+    }
+
+    static void
+    Fill(bool* res, size_t size, bool matched) {
+        std::fill(
+            res, res + size, matched == (cmp_op == proto::plan::OpType::Equal));
+    }
+
+    // compare the rows with target, which matches no row if it's out of the
+    // range of T
+    static void
+    CompareWithTarget(const T* src,
+                      size_t size,
+                      bool matchable,
+                      int64_t target,
+                      bool* res) {
+        if (!matchable || target < std::numeric_limits<T>::min() ||
+            target > std::numeric_limits<T>::max()) {
+            Fill(res, size, false);
+            return;
+        }
+        // a plain compare with a constant of T, vectorized by the compiler
+        auto value = static_cast<T>(target);
+        for (size_t i = 0; i < size; ++i) {
             if constexpr (cmp_op == proto::plan::OpType::Equal) {
-                if constexpr (arith_op == proto::plan::ArithOpType::Add) {
-                    res[i] = (src[i] + right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Sub) {
-                    res[i] = (src[i] - right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mul) {
-                    res[i] = (src[i] * right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Div) {
-                    res[i] = (src[i] / right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mod) {
-                    res[i] = (fmod(src[i], right_operand)) == val;
-                } else {
-                    PanicInfo(
-                        OpTypeInvalid,
-                        fmt::format(
-                            "unsupported arith type:{} for ArithOpElementFunc",
-                            arith_op));
+                res[i] = src[i] == value;
+            } else {
+                res[i] = src[i] != value;
+            }
+        }
+    }
+
+    // the ops are rewritten once per call into a compare of the rows with a
+    // constant, x + a == b as x == b - a, x * a == b as x == b / a and so on,
+    // so that the overflows are checked here instead of per row. A zero
+    // divisor matches no row, the same as the NaN of fmod.
+    static void
+    ExecInteger(const T* src,
+                size_t size,
+                int64_t val,
+                int64_t right_operand,
+                bool* res) {
+        int64_t target = 0;
+        if constexpr (arith_op == proto::plan::ArithOpType::Add) {
+            auto overflow = __builtin_sub_overflow(val, right_operand, &target);
+            CompareWithTarget(src, size, !overflow, target, res);
+        } else if constexpr (arith_op == proto::plan::ArithOpType::Sub) {
+            auto overflow = __builtin_add_overflow(val, right_operand, &target);
+            CompareWithTarget(src, size, !overflow, target, res);
+        } else if constexpr (arith_op == proto::plan::ArithOpType::Mul) {
+            if (right_operand == 0) {
+                Fill(res, size, val == 0);
+            } else if (right_operand == -1) {
+                auto overflow = __builtin_sub_overflow(0, val, &target);
+                CompareWithTarget(src, size, !overflow, target, res);
+            } else {
+                CompareWithTarget(src,
+                                  size,
+                                  val % right_operand == 0,
+                                  val / right_operand,
+                                  res);
+            }
+        } else if constexpr (arith_op == proto::plan::ArithOpType::Div) {
+            if (right_operand == 0) {
+                Fill(res, size, false);
+            } else if (right_operand == -1) {
+                auto overflow = __builtin_sub_overflow(0, val, &target);
+                CompareWithTarget(src, size, !overflow, target, res);
+            } else {
+                for (size_t i = 0; i < size; ++i) {
+                    res[i] = Compare(src[i] / right_operand, val);
                 }
-            } else if constexpr (cmp_op == proto::plan::OpType::NotEqual) {
-                if constexpr (arith_op == proto::plan::ArithOpType::Add) {
-                    res[i] = (src[i] + right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Sub) {
-                    res[i] = (src[i] - right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mul) {
-                    res[i] = (src[i] * right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Div) {
-                    res[i] = (src[i] / right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mod) {
-                    res[i] = (fmod(src[i], right_operand)) != val;
-                } else {
-                    PanicInfo(
-                        OpTypeInvalid,
-                        fmt::format(
-                            "unsupported arith type:{} for ArithOpElementFunc",
-                            arith_op));
+            }
+        } else if constexpr (arith_op == proto::plan::ArithOpType::Mod) {
+            if (right_operand == 0) {
+                Fill(res, size, false);
+            } else if (right_operand == 1 || right_operand == -1) {
+                Fill(res, size, val == 0);
+            } else {
+                for (size_t i = 0; i < size; ++i) {
+                    res[i] = Compare(src[i] % right_operand, val);
                 }
             }
+        } else {
+            PanicInfo(
+                OpTypeInvalid,
+                fmt::format("unsupported arith type:{} for ArithOpElementFunc",
+                            arith_op));
+        }
+    }
+
+    static void
+    ExecGeneric(const T* src,
+                size_t size,
+                HighPrecisonType val,
+                HighPrecisonType right_operand,
+                bool* res) {
+        for (size_t i = 0; i < size; ++i) {
+            if constexpr (arith_op == proto::plan::ArithOpType::Add) {
+                res[i] = Compare(src[i] + right_operand, val);
+            } else if constexpr (arith_op == proto::plan::ArithOpType::Sub) {
+                res[i] = Compare(src[i] - right_operand, val);
+            } else if constexpr (arith_op == proto::plan::ArithOpType::Mul) {
+                res[i] = Compare(src[i] * right_operand, val);
+            } else if constexpr (arith_op == proto::plan::ArithOpType::Div) {
+                res[i] = Compare(src[i] / right_operand, val);
+            } else if constexpr (arith_op == proto::plan::ArithOpType::Mod) {
+                res[i] = Compare(fmod(src[i], right_operand), val);
+            } else {
+                PanicInfo(
+                    OpTypeInvalid,
+                    fmt::format(
+                        "unsupported arith type:{} for ArithOpElementFunc",
+                        arith_op));
+            }
         }
     }
 };
@@ -108,57 +252,14 @@ struct ArithOpIndexFunc {
                size_t size,
                HighPrecisonType val,
                HighPrecisonType right_operand) {
-        FixedVector<bool> res_vec(size);
-        bool* res = res_vec.data();
+        // gather the raw values to run the same kernel as the raw data
+        FixedVector<T> values(size);
         for (size_t i = 0; i < size; ++i) {
-            if constexpr (cmp_op == proto::plan::OpType::Equal) {
-                if constexpr (arith_op == proto::plan::ArithOpType::Add) {
-                    res[i] = (index->Reverse_Lookup(i) + right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Sub) {
-                    res[i] = (index->Reverse_Lookup(i) - right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mul) {
-                    res[i] = (index->Reverse_Lookup(i) * right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Div) {
-                    res[i] = (index->Reverse_Lookup(i) / right_operand) == val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mod) {
-                    res[i] =
-                        (fmod(index->Reverse_Lookup(i), right_operand)) == val;
-                } else {
-                    PanicInfo(
-                        OpTypeInvalid,
-                        fmt::format(
-                            "unsupported arith type:{} for ArithOpElementFunc",
-                            arith_op));
-                }
-            } else if constexpr (cmp_op == proto::plan::OpType::NotEqual) {
-                if constexpr (arith_op == proto::plan::ArithOpType::Add) {
-                    res[i] = (index->Reverse_Lookup(i) + right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Sub) {
-                    res[i] = (index->Reverse_Lookup(i) - right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mul) {
-                    res[i] = (index->Reverse_Lookup(i) * right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Div) {
-                    res[i] = (index->Reverse_Lookup(i) / right_operand) != val;
-                } else if constexpr (arith_op ==
-                                     proto::plan::ArithOpType::Mod) {
-                    res[i] =
-                        (fmod(index->Reverse_Lookup(i), right_operand)) != val;
-                } else {
-                    PanicInfo(
-                        OpTypeInvalid,
-                        fmt::format(
-                            "unsupported arith type:{} for ArithOpElementFunc",
-                            arith_op));
-                }
-            }
+            values[i] = index->Reverse_Lookup(i);
         }
+        FixedVector<bool> res_vec(size);
+        ArithOpElementFunc<T, cmp_op, arith_op> func;
+        func(values.data(), size, val, right_operand, res_vec.data());
         return res_vec;
     }
 };
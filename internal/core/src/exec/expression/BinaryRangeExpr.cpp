@@ -23,6 +23,8 @@ namespace exec {
 
 void
 PhyBinaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     switch (expr_->column_.data_type_) {
         case DataType::BOOL: {
             result = ExecRangeVisitorImpl<bool>();
@@ -53,11 +55,7 @@ PhyBinaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_->type() == SegmentType::Growing) {
-                result = ExecRangeVisitorImpl<std::string>();
-            } else {
-                result = ExecRangeVisitorImpl<std::string_view>();
-            }
+            result = ExecRangeVisitorImpl<std::string_view>();
             break;
         }
         case DataType::JSON: {
@@ -234,8 +232,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData() {
             PreCheckOverflow<T>(val1, val2, lower_inclusive, upper_inclusive)) {
         return res;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto execute_sub_batch = [lower_inclusive, upper_inclusive](
                                  const T* data,
@@ -274,8 +271,25 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData() {
                     field_id, chunk_id, val1, val2, false, false);
             }
         };
-    int64_t processed_size = ProcessDataChunks<T>(
-        execute_sub_batch, skip_index_func, res, val1, val2);
+    auto block_match_func = [val1, val2, lower_inclusive, upper_inclusive](
+                                const SkipIndex& skip_index,
+                                FieldId field_id,
+                                int64_t chunk_id,
+                                int64_t block_id) {
+        return skip_index.BinaryRangeBlockMatch<T>(field_id,
+                                                   chunk_id,
+                                                   block_id,
+                                                   val1,
+                                                   val2,
+                                                   lower_inclusive,
+                                                   upper_inclusive);
+    };
+    int64_t processed_size = ProcessDataChunks<T>(execute_sub_batch,
+                                                  skip_index_func,
+                                                  block_match_func,
+                                                  res,
+                                                  val1,
+                                                  val2);
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -294,8 +308,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     bool lower_inclusive = expr_->lower_inclusive_;
@@ -344,8 +357,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForArray() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     bool lower_inclusive = expr_->lower_inclusive_;
@@ -23,6 +23,7 @@
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
+#include "simd/hook.h"
 
 namespace milvus {
 namespace exec {
@@ -36,15 +37,24 @@ struct BinaryRangeElementFunc {
         HighPrecisionType;
     void
     operator()(T val1, T val2, const T* src, size_t n, bool* res) {
+#if defined(USE_DYNAMIC_SIMD)
+        if constexpr (simd::has_compare_kernel<T>) {
+            simd::compare_range_func<T>()(
+                src, n, val1, val2, lower_inclusive, upper_inclusive, res);
+            return;
+        }
+#endif
+        // evaluate both bounds without short circuit, a branch in the loop
+        // body keeps the compiler from vectorizing the floating point ones
         for (size_t i = 0; i < n; ++i) {
             if constexpr (lower_inclusive && upper_inclusive) {
-                res[i] = val1 <= src[i] && src[i] <= val2;
+                res[i] = (val1 <= src[i]) & (src[i] <= val2);
             } else if constexpr (lower_inclusive && !upper_inclusive) {
-                res[i] = val1 <= src[i] && src[i] < val2;
+                res[i] = (val1 <= src[i]) & (src[i] < val2);
             } else if constexpr (!lower_inclusive && upper_inclusive) {
-                res[i] = val1 < src[i] && src[i] <= val2;
+                res[i] = (val1 < src[i]) & (src[i] <= val2);
             } else {
-                res[i] = val1 < src[i] && src[i] < val2;
+                res[i] = (val1 < src[i]) & (src[i] < val2);
             }
         }
     }
@@ -183,6 +193,12 @@ class PhyBinaryRangeFilterExpr : public SegmentExpr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        SegmentExpr::SetRowRange(begin, end);
+        overflow_check_pos_ = begin;
+    }
+
  private:
     // Check overflow and cache result for performace
     template <
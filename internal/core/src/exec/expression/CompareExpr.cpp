@@ -26,6 +26,12 @@ PhyCompareFilterExpr::IsStringExpr() {
            expr_->right_data_type_ == DataType::VARCHAR;
 }
 
+bool
+PhyCompareFilterExpr::HasChunkData(FieldId field_id, bool is_indexed) const {
+    return !is_indexed || (segment_->type() == SegmentType::Sealed &&
+                           segment_->HasFieldData(field_id));
+}
+
 int64_t
 PhyCompareFilterExpr::GetNextBatchSize() {
     auto current_rows =
@@ -49,6 +55,14 @@ PhyCompareFilterExpr::GetChunkData(FieldId field_id,
             };
         }
     }
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        // the rows are read in order, a block of them decoded at a time
+        auto packed = segment_->GetPackedColumn(field_id);
+        if (packed != nullptr) {
+            auto reader = std::make_shared<PackedColumnReader<T>>(*packed);
+            return [reader](int i) -> const number { return (*reader)[i]; };
+        }
+    }
     auto chunk_data = segment_->chunk_data<T>(field_id, chunk_id).data();
     return [chunk_data](int i) -> const number { return chunk_data[i]; };
 }
@@ -67,17 +81,11 @@ PhyCompareFilterExpr::GetChunkData<std::string>(FieldId field_id,
             };
         }
     }
-    if (segment_->type() == SegmentType::Growing) {
-        auto chunk_data =
-            segment_->chunk_data<std::string>(field_id, chunk_id).data();
-        return [chunk_data](int i) -> const number { return chunk_data[i]; };
-    } else {
-        auto chunk_data =
-            segment_->chunk_data<std::string_view>(field_id, chunk_id).data();
-        return [chunk_data](int i) -> const number {
-            return std::string(chunk_data[i]);
-        };
-    }
+    auto chunk_data =
+        segment_->chunk_data<std::string_view>(field_id, chunk_id).data();
+    return [chunk_data](int i) -> const number {
+        return std::string(chunk_data[i]);
+    };
 }
 
 ChunkDataAccessor
@@ -116,8 +124,7 @@ PhyCompareFilterExpr::ExecCompareExprDispatcher(OpType op) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     auto left_data_barrier = segment_->num_chunk_data(expr_->left_field_id_);
@@ -156,9 +163,12 @@ PhyCompareFilterExpr::ExecCompareExprDispatcher(OpType op) {
 
 void
 PhyCompareFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    // For segment both fields has no index, can use SIMD to speed up.
-    // Avoiding too much call stack that blocks SIMD.
-    if (!is_left_indexed_ && !is_right_indexed_ && !IsStringExpr()) {
+    SetVectorPool(context);
+    // If the rows of both fields are in their chunks, they are compared a
+    // chunk at a time by the simd kernels rather than per row through the
+    // accessors.
+    if (HasChunkData(left_field_, is_left_indexed_) &&
+        HasChunkData(right_field_, is_right_indexed_) && !IsStringExpr()) {
         result = ExecCompareExprDispatcherForBothDataSegment();
         return;
     }
@@ -256,8 +266,7 @@ PhyCompareFilterExpr::ExecCompareRightType() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto expr_type = expr_->op_type_;
     auto execute_sub_batch = [expr_type](const T* left,
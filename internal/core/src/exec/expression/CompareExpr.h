@@ -18,12 +18,15 @@
 
 #include <fmt/core.h>
 #include <boost/variant.hpp>
+#include <type_traits>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
+#include "simd/hook.h"
 
 namespace milvus {
 namespace exec {
@@ -42,6 +45,14 @@ template <typename T, typename U, proto::plan::OpType op>
 struct CompareElementFunc {
     void
     operator()(const T* left, const U* right, size_t size, bool* res) {
+#if defined(USE_DYNAMIC_SIMD)
+        if constexpr (std::is_same_v<T, U> && simd::has_compare_kernel<T> &&
+                      ToSimdCompareOp(op).has_value()) {
+            simd::compare_column_func<T>()(
+                left, right, size, ToSimdCompareOp(op).value(), res);
+            return;
+        }
+#endif
         for (int i = 0; i < size; ++i) {
             if constexpr (op == proto::plan::OpType::Equal) {
                 res[i] = left[i] == right[i];
@@ -97,6 +108,18 @@ class PhyCompareFilterExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetOffsetInput(const std::vector<int64_t>* offset_input) override {
+        PanicInfo(ExprInvalid,
+                  "compare expr can't be evaluated on the given offsets");
+    }
+
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        PanicInfo(ExprInvalid,
+                  "compare expr can't be evaluated on the given row range");
+    }
+
  private:
     int64_t
     GetNextBatchSize();
@@ -104,18 +127,43 @@ class PhyCompareFilterExpr : public Expr {
     bool
     IsStringExpr();
 
+    // whether the rows of the field can be read from its chunks, an indexed
+    // field of a sealed segment keeps them if its raw data is loaded too
+    bool
+    HasChunkData(FieldId field_id, bool is_indexed) const;
+
     template <typename T>
     ChunkDataAccessor
     GetChunkData(FieldId field_id, int chunk_id, int data_barrier);
 
+    // the rows [data_pos, data_pos + size) of the chunk, the rows of a
+    // packed column are decoded into the buffer, rather than the whole
+    // column by chunk_data
+    template <typename T>
+    const T*
+    ChunkRows(FieldId field_id,
+              int64_t chunk_id,
+              int64_t data_pos,
+              int64_t size,
+              std::vector<T>& buffer) const {
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            auto packed = segment_->GetPackedColumn(field_id);
+            if (packed != nullptr) {
+                return packed->Decode(data_pos, size, buffer);
+            }
+        }
+        return segment_->chunk_data<T>(field_id, chunk_id).data() + data_pos;
+    }
+
     template <typename T, typename U, typename FUNC, typename... ValTypes>
     int64_t
     ProcessBothDataChunks(FUNC func, bool* res, ValTypes... values) {
         int64_t processed_size = 0;
+        auto& skip_index = segment_->GetSkipIndex();
+        std::vector<T> left_buffer;
+        std::vector<U> right_buffer;
 
         for (size_t i = current_chunk_id_; i < num_chunk_; i++) {
-            auto left_chunk = segment_->chunk_data<T>(left_field_, i);
-            auto right_chunk = segment_->chunk_data<U>(right_field_, i);
             auto data_pos = (i == current_chunk_id_) ? current_chunk_pos_ : 0;
             auto size = (i == (num_chunk_ - 1))
                             ? (segment_->type() == SegmentType::Growing
@@ -127,9 +175,19 @@ class PhyCompareFilterExpr : public Expr {
                 size = batch_size_ - processed_size;
             }
 
-            const T* left_data = left_chunk.data() + data_pos;
-            const U* right_data = right_chunk.data() + data_pos;
-            func(left_data, right_data, size, res + processed_size, values...);
+            // the rows of a skipped chunk are left false
+            if (!skip_index.CanSkipCompare<T, U>(
+                    left_field_, right_field_, i, expr_->op_type_)) {
+                const T* left_data =
+                    ChunkRows(left_field_, i, data_pos, size, left_buffer);
+                const U* right_data =
+                    ChunkRows(right_field_, i, data_pos, size, right_buffer);
+                func(left_data,
+                     right_data,
+                     size,
+                     res + processed_size,
+                     values...);
+            }
             processed_size += size;
 
             if (processed_size >= batch_size_) {
@@ -15,6 +15,10 @@
 // limitations under the License.
 
 #include "ConjunctExpr.h"
+
+#include <algorithm>
+#include <chrono>
+
 #include "simd/hook.h"
 
 namespace milvus {
@@ -104,27 +108,127 @@ PhyConjunctFilterExpr::CanSkipNextExprs(ColumnVectorPtr& vec) {
     return false;
 }
 
+void
+PhyConjunctFilterExpr::UpdateSelection(
+    ColumnVectorPtr& result,
+    const std::vector<int64_t>* input_selection,
+    bool first,
+    std::vector<int64_t>& selection) {
+    // the undecided rows are true for and, false for or
+    bool* data = static_cast<bool*>(result->GetRawData());
+    if (!first) {
+        selection.erase(std::remove_if(selection.begin(),
+                                       selection.end(),
+                                       [&](int64_t i) {
+                                           return data[i] != is_and_;
+                                       }),
+                        selection.end());
+        return;
+    }
+    selection.clear();
+    if (CanSkipNextExprs(result)) {
+        return;
+    }
+    if (input_selection != nullptr) {
+        for (auto i : *input_selection) {
+            if (data[i] == is_and_) {
+                selection.push_back(i);
+            }
+        }
+        return;
+    }
+    for (int64_t i = 0; i < result->size(); ++i) {
+        if (data[i] == is_and_) {
+            selection.push_back(i);
+        }
+    }
+}
+
+void
+PhyConjunctFilterExpr::UpdateInputStats(int32_t input,
+                                        ColumnVectorPtr& input_result,
+                                        const std::vector<int64_t>* selection,
+                                        int64_t cost_ns) {
+    bool* data = static_cast<bool*>(input_result->GetRawData());
+    int64_t rows = 0;
+    int64_t decided_rows = 0;
+    if (selection != nullptr) {
+        rows = selection->size();
+        for (auto i : *selection) {
+            decided_rows += data[i] != is_and_;
+        }
+    } else {
+        rows = input_result->size();
+        for (int64_t i = 0; i < rows; ++i) {
+            decided_rows += data[i] != is_and_;
+        }
+    }
+    if (rows == 0) {
+        return;
+    }
+    auto& stats = input_stats_[input];
+    stats.rows += rows;
+    stats.decided_rows += decided_rows;
+    stats.cost_ns += cost_ns;
+}
+
+void
+PhyConjunctFilterExpr::ReorderInputs() {
+    // wait until every input has been measured
+    for (auto& stats : input_stats_) {
+        if (stats.rows == 0) {
+            return;
+        }
+    }
+    // an input is better evaluated earlier the cheaper it is per row and
+    // the more rows it decides
+    auto score = [this](int32_t input) {
+        auto& stats = input_stats_[input];
+        auto cost_per_row = static_cast<double>(stats.cost_ns) / stats.rows;
+        auto decided_ratio =
+            static_cast<double>(stats.decided_rows) / stats.rows;
+        return cost_per_row / std::max(decided_ratio, MIN_DECIDED_RATIO);
+    };
+    std::stable_sort(
+        input_order_.begin(),
+        input_order_.end(),
+        [&](int32_t a, int32_t b) { return score(a) < score(b); });
+}
+
 void
 PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    for (int i = 0; i < inputs_.size(); ++i) {
+    // the later children only evaluate the rows left undecided by the former
+    // ones, all of them must still be evaluated even if no row is left, to
+    // keep them moving forward batch by batch
+    auto input_selection = context.get_selection();
+    for (int i = 0; i < input_order_.size(); ++i) {
+        auto input = input_order_[i];
+        auto start = std::chrono::steady_clock::now();
         VectorPtr input_result;
-        inputs_[i]->Eval(context, input_result);
+        inputs_[input]->Eval(context, input_result);
+        auto cost_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        auto input_flat_result = GetColumnVector(input_result);
+        UpdateInputStats(input,
+                         input_flat_result,
+                         i == 0 ? input_selection : &selection_,
+                         cost_ns);
         if (i == 0) {
             result = input_result;
+        } else {
             auto all_flat_result = GetColumnVector(result);
-            if (CanSkipNextExprs(all_flat_result)) {
-                return;
-            }
-            continue;
-        }
-        auto input_flat_result = GetColumnVector(input_result);
-        auto all_flat_result = GetColumnVector(result);
-        auto active_rows =
             UpdateResult(input_flat_result, context, all_flat_result);
-        if (active_rows == 0) {
-            return;
+        }
+        if (i + 1 < input_order_.size()) {
+            auto all_flat_result = GetColumnVector(result);
+            UpdateSelection(
+                all_flat_result, input_selection, i == 0, selection_);
+            context.set_selection(&selection_);
         }
     }
+    context.set_selection(input_selection);
+    ReorderInputs();
 }
 
 }  //namespace exec
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <numeric>
+
 #include <fmt/core.h>
 
 #include "common/EasyAssert.h"
@@ -65,6 +67,10 @@ class PhyConjunctFilterExpr : public Expr {
                        [](const ExprPtr& expr) { return expr->type(); });
 
         ResolveType(input_types);
+
+        input_order_.resize(inputs_.size());
+        std::iota(input_order_.begin(), input_order_.end(), 0);
+        input_stats_.resize(inputs_.size());
     }
 
     void
@@ -81,9 +87,42 @@ class PhyConjunctFilterExpr : public Expr {
 
     bool
     CanSkipNextExprs(ColumnVectorPtr& vec);
+
+    // narrow the selection to the rows whose results are still undecided
+    void
+    UpdateSelection(ColumnVectorPtr& result,
+                    const std::vector<int64_t>* input_selection,
+                    bool first,
+                    std::vector<int64_t>& selection);
+
+    void
+    UpdateInputStats(int32_t input,
+                     ColumnVectorPtr& input_result,
+                     const std::vector<int64_t>* selection,
+                     int64_t cost_ns);
+
+    // reorder the inputs for the next batches by the measured cost and
+    // selectivity, the results don't depend on the order
+    void
+    ReorderInputs();
+
     // true if conjunction (and), false if disjunction (or).
     bool is_and_;
+    // the order to evaluate the inputs
     std::vector<int32_t> input_order_;
+
+    // accumulated over the batches, the rows are the evaluated ones and the
+    // decided rows are the false ones for and, the true ones for or
+    struct InputStats {
+        int64_t rows = 0;
+        int64_t decided_rows = 0;
+        int64_t cost_ns = 0;
+    };
+    std::vector<InputStats> input_stats_;
+    // the undecided rows of the current batch, kept across the batches to
+    // reuse its buffer
+    std::vector<int64_t> selection_;
+    static constexpr double MIN_DECIDED_RATIO = 0.001;
 };
 }  //namespace exec
 }  // namespace milvus
@@ -51,11 +51,25 @@ class EvalCtx {
         return exec_ctx_->get_query_config();
     }
 
+    // the sorted positions in the next batch whose results are needed, the
+    // results of the other rows are left undefined, all rows are needed if
+    // it's null
+    void
+    set_selection(const std::vector<int64_t>* selection) {
+        selection_ = selection;
+    }
+
+    const std::vector<int64_t>*
+    get_selection() const {
+        return selection_;
+    }
+
  private:
     ExecContext* exec_ctx_;
     ExprSet* expr_set_;
     RowVector* row_;
     bool input_no_nulls_;
+    const std::vector<int64_t>* selection_ = nullptr;
 };
 
 }  // namespace exec
@@ -22,6 +22,8 @@ namespace exec {
 
 void
 PhyExistsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     switch (expr_->column_.data_type_) {
         case DataType::JSON: {
             if (is_index_mode_) {
@@ -44,11 +46,33 @@ PhyExistsFilterExpr::EvalJsonExistsForDataSegment() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
+    if (auto key_column = segment_->GetJsonKeyColumn(field_id_, pointer)) {
+        // the json views of a sealed segment are in a single chunk, the
+        // offset of a view is the row offset in the extracted column
+        const milvus::Json* base =
+            segment_->chunk_data<milvus::Json>(field_id_, 0).data();
+        auto execute_sub_batch = [key_column, base](const milvus::Json* data,
+                                                    const int size,
+                                                    bool* res) {
+            auto offset = data - base;
+            for (int i = 0; i < size; ++i) {
+                res[i] = key_column->Exist(offset + i);
+            }
+        };
+        int64_t processed_size = ProcessDataChunks<Json>(
+            execute_sub_batch, std::nullptr_t{}, res);
+        AssertInfo(processed_size == real_batch_size,
+                   "internal error: expr processed rows {} not equal "
+                   "expect batch size {}",
+                   processed_size,
+                   real_batch_size);
+        return res_vec;
+    }
+
     auto execute_sub_batch = [](const milvus::Json* data,
                                 const int size,
                                 bool* res,
@@ -16,15 +16,20 @@
 
 #include "Expr.h"
 
+#include <algorithm>
+
+#include "common/Common.h"
 #include "exec/expression/AlwaysTrueExpr.h"
 #include "exec/expression/BinaryArithOpEvalRangeExpr.h"
 #include "exec/expression/BinaryRangeExpr.h"
 #include "exec/expression/CompareExpr.h"
 #include "exec/expression/ConjunctExpr.h"
 #include "exec/expression/ExistsExpr.h"
+#include "exec/expression/ExprRewriter.h"
 #include "exec/expression/JsonContainsExpr.h"
 #include "exec/expression/LogicalBinaryExpr.h"
 #include "exec/expression/LogicalUnaryExpr.h"
+#include "exec/expression/ProfiledExpr.h"
 #include "exec/expression/TermExpr.h"
 #include "exec/expression/UnaryExpr.h"
 namespace milvus {
@@ -43,6 +48,67 @@ ExprSet::Eval(int32_t begin,
     }
 }
 
+// the largest divisor of size_per_chunk in (batch_size / 2, batch_size], so
+// that the batches never straddle the chunks, or batch_size if there is none
+static int64_t
+AlignBatchSizeToChunk(int64_t batch_size, int64_t size_per_chunk) {
+    if (size_per_chunk <= 0) {
+        return batch_size;
+    }
+    if (batch_size >= size_per_chunk) {
+        return size_per_chunk;
+    }
+    // try the chunk split into num_batch batches, from the fewest
+    for (auto num_batch = (size_per_chunk + batch_size - 1) / batch_size;
+         size_per_chunk / num_batch > batch_size / 2;
+         ++num_batch) {
+        if (size_per_chunk % num_batch == 0) {
+            return size_per_chunk / num_batch;
+        }
+    }
+    return batch_size;
+}
+
+// choose the batch size so that the columns read by a batch, together with the
+// result of it, fit in the working set, all the exprs have to share the batch
+// size since their results are combined row by row
+static int64_t
+GetExprBatchSize(const std::vector<expr::TypedExprPtr>& sources,
+                 QueryContext* context) {
+    auto config = context->query_config();
+    if (EXEC_EVAL_EXPR_WORKING_SET_SIZE <= 0 || config->has_expr_batch_size()) {
+        return config->get_expr_batch_size();
+    }
+
+    // the fields of an expr are collected once for all the segments
+    std::vector<FieldId> field_ids;
+    for (auto& source : sources) {
+        auto& source_field_ids =
+            *source->GetPrepared<std::vector<FieldId>>([&source]() {
+                std::vector<FieldId> collected;
+                expr::CollectFieldIds(source, collected);
+                return collected;
+            });
+        field_ids.insert(
+            field_ids.end(), source_field_ids.begin(), source_field_ids.end());
+    }
+    std::sort(field_ids.begin(), field_ids.end());
+    field_ids.erase(std::unique(field_ids.begin(), field_ids.end()),
+                    field_ids.end());
+
+    auto segment = context->get_segment();
+    auto& schema = segment->get_schema();
+    // one byte for the result of each row
+    int64_t row_width = 1;
+    for (auto field_id : field_ids) {
+        row_width += schema[field_id].get_sizeof();
+    }
+    auto batch_size = std::clamp(EXEC_EVAL_EXPR_WORKING_SET_SIZE / row_width,
+                                 DEFAULT_EXEC_EVAL_EXPR_MIN_BATCH_SIZE,
+                                 DEFAULT_EXEC_EVAL_EXPR_MAX_BATCH_SIZE);
+    return AlignBatchSizeToChunk(batch_size, segment->size_per_chunk());
+}
+
 std::vector<ExprPtr>
 CompileExpressions(const std::vector<expr::TypedExprPtr>& sources,
                    ExecContext* context,
@@ -51,8 +117,13 @@ CompileExpressions(const std::vector<expr::TypedExprPtr>& sources,
     std::vector<std::shared_ptr<Expr>> exprs;
     exprs.reserve(sources.size());
 
+    auto query_context = context->get_query_context();
+    query_context->set_expr_batch_size(
+        GetExprBatchSize(sources, query_context));
+
+    auto& schema = query_context->get_segment()->get_schema();
     for (auto& source : sources) {
-        exprs.emplace_back(CompileExpression(source,
+        exprs.emplace_back(CompileExpression(GetRewrittenExpr(source, schema),
                                              context->get_query_context(),
                                              flatten_candidate,
                                              enable_constant_folding));
@@ -163,7 +234,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyUnaryRangeFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr = std::dynamic_pointer_cast<
                    const milvus::expr::LogicalUnaryExpr>(expr)) {
         result = std::make_shared<PhyLogicalUnaryExpr>(
@@ -176,7 +247,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyTermFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr = std::dynamic_pointer_cast<
                    const milvus::expr::LogicalBinaryExpr>(expr)) {
         if (casted_expr->op_type_ ==
@@ -199,7 +270,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyBinaryRangeFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr = std::dynamic_pointer_cast<
                    const milvus::expr::AlwaysTrueExpr>(expr)) {
         result = std::make_shared<PhyAlwaysTrueExpr>(
@@ -208,7 +279,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyAlwaysTrueExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr = std::dynamic_pointer_cast<
                    const milvus::expr::BinaryArithOpEvalRangeExpr>(expr)) {
         result = std::make_shared<PhyBinaryArithOpEvalRangeExpr>(
@@ -217,7 +288,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyBinaryArithOpEvalRangeExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr =
                    std::dynamic_pointer_cast<const milvus::expr::CompareExpr>(
                        expr)) {
@@ -227,7 +298,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyCompareFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr =
                    std::dynamic_pointer_cast<const milvus::expr::ExistsExpr>(
                        expr)) {
@@ -237,7 +308,7 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyExistsFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
     } else if (auto casted_expr = std::dynamic_pointer_cast<
                    const milvus::expr::JsonContainsExpr>(expr)) {
         result = std::make_shared<PhyJsonContainsFilterExpr>(
@@ -246,10 +317,39 @@ CompileExpression(const expr::TypedExprPtr& expr,
             "PhyJsonContainsFilterExpr",
             context->get_segment(),
             context->get_query_timestamp(),
-            context->query_config()->get_expr_batch_size());
+            context->get_expr_batch_size());
+    }
+    if (result != nullptr && context->get_offset_input() != nullptr) {
+        result->SetOffsetInput(context->get_offset_input());
+    }
+    if (result != nullptr && context->get_row_range().has_value()) {
+        auto [begin, end] = context->get_row_range().value();
+        result->SetRowRange(begin, end);
+    }
+    if (result != nullptr && context->get_profile() != nullptr) {
+        auto name = fmt::format(
+            "{}#{}", result->get_name(), context->next_profile_expr_id());
+        result = std::make_shared<PhyProfiledExpr>(
+            std::move(result), name, context->get_profile());
     }
     return result;
 }
 
+bool
+IsOffsetInputSupported(const expr::TypedExprPtr& expr) {
+    // the compare expr walks the two fields chunk by chunk
+    if (std::dynamic_pointer_cast<const milvus::expr::CompareExpr>(expr) ||
+        dynamic_cast<const expr::CallTypeExpr*>(expr.get())) {
+        return false;
+    }
+    for (auto& input : expr->inputs()) {
+        if (!dynamic_cast<const expr::InputTypeExpr*>(input.get()) &&
+            !IsOffsetInputSupported(input)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace exec
 }  // namespace milvus
\ No newline at end of file
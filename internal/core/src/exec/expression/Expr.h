@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "common/Array.h"
+#include "common/Json.h"
 #include "common/Types.h"
 #include "exec/expression/EvalCtx.h"
 #include "exec/expression/VectorFunction.h"
@@ -66,17 +70,66 @@ class Expr {
     Eval(EvalCtx& context, VectorPtr& result) {
     }
 
+    // evaluate only on the given sorted segment offsets, every batch then
+    // has one result per offset instead of per row, see
+    // QueryContext::set_offset_input
+    virtual void
+    SetOffsetInput(const std::vector<int64_t>* offset_input) {
+    }
+
+    // evaluate only the rows in [begin, end) of a sealed segment, see
+    // QueryContext::set_row_range
+    virtual void
+    SetRowRange(int64_t begin, int64_t end) {
+    }
+
+    // the path the expr is evaluated by, and the bytes of the fixed width
+    // data it reads per row, for the query profile
+    virtual std::string
+    GetEvalPath() const {
+        return "";
+    }
+
+    virtual int64_t
+    GetRowBytes() const {
+        return 0;
+    }
+
+ protected:
+    // the results of the batches are taken from the vector pool of the
+    // context the expr is evaluated in, instead of allocated per batch
+    void
+    SetVectorPool(EvalCtx& context) {
+        auto exec_ctx = context.get_exec_context();
+        vector_pool_ =
+            exec_ctx != nullptr ? &exec_ctx->get_vector_pool() : nullptr;
+    }
+
+    ColumnVectorPtr
+    NewResultVector(DataType type, int64_t size) {
+        if (vector_pool_ != nullptr) {
+            return vector_pool_->Get(type, size);
+        }
+        return std::make_shared<ColumnVector>(type, size);
+    }
+
  protected:
     DataType type_;
     const std::vector<std::shared_ptr<Expr>> inputs_;
     std::string name_;
     std::shared_ptr<VectorFunction> vector_func_;
+    VectorPool* vector_pool_ = nullptr;
 };
 
 using ExprPtr = std::shared_ptr<milvus::exec::Expr>;
 
 using SkipFunc = bool (*)(const milvus::SkipIndex&, FieldId, int);
 
+// how many rows of a block of a chunk satisfy the expr, by the zone maps of
+// the skip index
+using BlockMatchFunc = std::function<milvus::BlockMatch(
+    const milvus::SkipIndex&, FieldId, int64_t chunk_id, int64_t block_id)>;
+
 class SegmentExpr : public Expr {
  public:
     SegmentExpr(const std::vector<ExprPtr>&& input,
@@ -119,8 +172,52 @@ class SegmentExpr : public Expr {
         }
     }
 
+    void
+    SetOffsetInput(const std::vector<int64_t>* offset_input) override {
+        offset_input_ = offset_input;
+        num_rows_ = offset_input_->size();
+    }
+
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "only the sealed segment can be evaluated by row range");
+        num_rows_ = end;
+        current_data_chunk_ = begin / size_per_chunk_;
+        current_data_chunk_pos_ = begin % size_per_chunk_;
+        current_index_chunk_ = current_data_chunk_;
+        current_index_chunk_pos_ = current_data_chunk_pos_;
+    }
+
+    std::string
+    GetEvalPath() const override {
+        if (offset_input_ != nullptr) {
+            return "offsets";
+        }
+        return is_index_mode_ ? "index" : "raw_data";
+    }
+
+    int64_t
+    GetRowBytes() const override {
+        auto data_type = segment_->get_schema()[field_id_].get_data_type();
+        if (is_index_mode_ || datatype_is_variable(data_type)) {
+            return 0;
+        }
+        return datatype_sizeof(data_type);
+    }
+
+    // only the selected rows of the next batch are evaluated by
+    // ProcessDataChunks, see EvalCtx::set_selection
+    void
+    SetSelection(const EvalCtx& context) {
+        selection_ = context.get_selection();
+    }
+
     int64_t
     GetNextBatchSize() {
+        if (offset_input_ != nullptr) {
+            return std::min(batch_size_, num_rows_ - current_offset_pos_);
+        }
         auto current_chunk =
             is_index_mode_ ? current_index_chunk_ : current_data_chunk_;
         auto current_chunk_pos =
@@ -138,7 +235,32 @@ class SegmentExpr : public Expr {
         std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
         bool* res,
         ValTypes... values) {
+        return ProcessDataChunks<T>(
+            func, skip_func, BlockMatchFunc(), res, values...);
+    }
+
+    // the blocks of a chunk none of whose rows satisfy the expr are set
+    // false, the ones all of whose rows do are set true, without reading
+    // their rows
+    template <typename T, typename FUNC, typename... ValTypes>
+    int64_t
+    ProcessDataChunks(
+        FUNC func,
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
+        BlockMatchFunc block_func,
+        bool* res,
+        ValTypes... values) {
+        if (offset_input_ != nullptr) {
+            return ProcessDataByOffsets<T>(func, skip_func, res, values...);
+        }
         int64_t processed_size = 0;
+        auto use_selection = UseSelection<T>();
+        // the packed rows are decoded into the buffer a batch at a time
+        const PackedColumn* packed = nullptr;
+        std::vector<T> buffer;
+        if constexpr (IsPackable<T>()) {
+            packed = segment_->GetPackedColumn(field_id_);
+        }
 
         for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
             auto data_pos =
@@ -152,10 +274,47 @@ class SegmentExpr : public Expr {
             size = std::min(size, batch_size_ - processed_size);
 
             auto& skip_index = segment_->GetSkipIndex();
-            if (!skip_func || !skip_func(skip_index, field_id_, i)) {
-                auto chunk = segment_->chunk_data<T>(field_id_, i);
-                const T* data = chunk.data() + data_pos;
-                func(data, size, res + processed_size, values...);
+            if (!use_selection && block_func &&
+                AllBlocksMatch(block_func, i, data_pos, size)) {
+                // the rows are neither read nor decoded
+                std::fill(res + processed_size,
+                          res + processed_size + size,
+                          true);
+            } else if (!skip_func || !skip_func(skip_index, field_id_, i)) {
+                const T* data = nullptr;
+                if constexpr (IsPackable<T>()) {
+                    if (packed != nullptr) {
+                        data = packed->Decode(data_pos, size, buffer);
+                    }
+                }
+                if (data == nullptr) {
+                    auto chunk = segment_->chunk_data<T>(field_id_, i);
+                    data = chunk.data() + data_pos;
+                }
+                if (use_selection) {
+                    auto iter = std::lower_bound(
+                        selection_->begin(), selection_->end(), processed_size);
+                    for (; iter != selection_->end() &&
+                           *iter < processed_size + size;
+                         ++iter) {
+                        func(data + (*iter - processed_size),
+                             1,
+                             res + *iter,
+                             values...);
+                    }
+                } else if (block_func &&
+                           skip_index.NumBlocks(field_id_, i) > 0) {
+                    ProcessDataBlocks(func,
+                                      block_func,
+                                      i,
+                                      data_pos,
+                                      size,
+                                      data,
+                                      res + processed_size,
+                                      values...);
+                } else {
+                    func(data, size, res + processed_size, values...);
+                }
             }
 
             processed_size += size;
@@ -169,6 +328,146 @@ class SegmentExpr : public Expr {
         return processed_size;
     }
 
+    // whether all the rows [data_pos, data_pos + size) of the chunk satisfy
+    // the expr by the zone maps of their blocks, or the distinct values of
+    // the chunk
+    bool
+    AllBlocksMatch(const BlockMatchFunc& block_func,
+                   int64_t chunk_id,
+                   int64_t data_pos,
+                   int64_t size) const {
+        constexpr auto block_rows = milvus::SkipIndex::BLOCK_ROWS;
+        auto& skip_index = segment_->GetSkipIndex();
+        if (size == 0) {
+            return false;
+        }
+        if (skip_index.NumBlocks(field_id_, chunk_id) == 0) {
+            // a chunk without zone maps is matched as a whole, by its
+            // distinct values
+            return block_func(skip_index, field_id_, chunk_id, 0) ==
+                   milvus::BlockMatch::All;
+        }
+        auto end = data_pos + size;
+        for (auto block_id = data_pos / block_rows; block_id * block_rows < end;
+             ++block_id) {
+            if (block_func(skip_index, field_id_, chunk_id, block_id) !=
+                milvus::BlockMatch::All) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // evaluate the rows [data_pos, data_pos + size) of the chunk block by
+    // block, data and res start at data_pos
+    template <typename T, typename FUNC, typename... ValTypes>
+    void
+    ProcessDataBlocks(FUNC func,
+                      const BlockMatchFunc& block_func,
+                      int64_t chunk_id,
+                      int64_t data_pos,
+                      int64_t size,
+                      const T* data,
+                      bool* res,
+                      ValTypes... values) {
+        constexpr auto block_rows = milvus::SkipIndex::BLOCK_ROWS;
+        auto& skip_index = segment_->GetSkipIndex();
+        auto end = data_pos + size;
+        for (auto begin = data_pos; begin < end;) {
+            auto block_id = begin / block_rows;
+            auto block_end = std::min(end, (block_id + 1) * block_rows);
+            auto offset = begin - data_pos;
+            auto block_size = block_end - begin;
+            switch (block_func(skip_index, field_id_, chunk_id, block_id)) {
+                case milvus::BlockMatch::None:
+                    std::fill(res + offset, res + offset + block_size, false);
+                    break;
+                case milvus::BlockMatch::All:
+                    std::fill(res + offset, res + offset + block_size, true);
+                    break;
+                default:
+                    func(data + offset, block_size, res + offset, values...);
+            }
+            begin = block_end;
+        }
+    }
+
+    // the offsets are sorted, so each chunk is fetched once per batch
+    template <typename T, typename FUNC, typename... ValTypes>
+    int64_t
+    ProcessDataByOffsets(
+        FUNC func,
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
+        bool* res,
+        ValTypes... values) {
+        auto size = GetNextBatchSize();
+        auto& skip_index = segment_->GetSkipIndex();
+        int64_t chunk_id = -1;
+        bool skipped = false;
+        const T* data = nullptr;
+        const PackedColumn* packed = nullptr;
+        if constexpr (IsPackable<T>()) {
+            packed = segment_->GetPackedColumn(field_id_);
+        }
+        auto process_row = [&](int64_t i) {
+            auto offset = (*offset_input_)[current_offset_pos_ + i];
+            if (offset / size_per_chunk_ != chunk_id) {
+                chunk_id = offset / size_per_chunk_;
+                skipped =
+                    skip_func && skip_func(skip_index, field_id_, chunk_id);
+                if (!skipped && packed == nullptr) {
+                    data = segment_->chunk_data<T>(field_id_, chunk_id).data();
+                }
+            }
+            if (skipped) {
+                return;
+            }
+            if constexpr (IsPackable<T>()) {
+                if (packed != nullptr) {
+                    auto value = packed->At<T>(offset);
+                    func(&value, 1, res + i, values...);
+                    return;
+                }
+            }
+            func(data + offset % size_per_chunk_, 1, res + i, values...);
+        };
+        if (selection_ != nullptr) {
+            for (auto i : *selection_) {
+                process_row(i);
+            }
+        } else {
+            for (int64_t i = 0; i < size; ++i) {
+                process_row(i);
+            }
+        }
+        current_offset_pos_ += size;
+        return size;
+    }
+
+    // the integers may be held packed by the sealed segments
+    template <typename T>
+    static constexpr bool
+    IsPackable() {
+        return std::is_integral_v<T> && !std::is_same_v<T, bool>;
+    }
+
+    // evaluating row by row defeats the vectorized kernels of the plain
+    // types, so only a sparse selection of them is worth it
+    template <typename T>
+    bool
+    UseSelection() const {
+        if (selection_ == nullptr) {
+            return false;
+        }
+        if constexpr (std::is_same_v<T, milvus::Json> ||
+                      std::is_same_v<T, milvus::ArrayView> ||
+                      std::is_same_v<T, std::string_view> ||
+                      std::is_same_v<T, std::string>) {
+            return true;
+        }
+        return selection_->size() * SPARSE_SELECTION_RATIO < batch_size_;
+    }
+
     int
     ProcessIndexOneChunk(FixedVector<bool>& result,
                          size_t chunk_id,
@@ -179,6 +478,10 @@ class SegmentExpr : public Expr {
         auto size = std::min(
             std::min(size_per_chunk_ - data_pos, batch_size_ - processed_rows),
             int64_t(chunk_res.size()));
+        // the rows may end before the chunk if evaluated by row range
+        size = std::min(size,
+                        num_rows_ - int64_t(chunk_id) * size_per_chunk_ -
+                            data_pos);
 
         result.insert(result.end(),
                       chunk_res.begin() + data_pos,
@@ -194,6 +497,27 @@ class SegmentExpr : public Expr {
                 IndexInnerType;
         using Index = index::ScalarIndex<IndexInnerType>;
         FixedVector<bool> result;
+        if (offset_input_ != nullptr) {
+            auto size = GetNextBatchSize();
+            result.reserve(size);
+            for (int64_t i = 0; i < size; ++i) {
+                auto offset = (*offset_input_)[current_offset_pos_ + i];
+                auto chunk_id = offset / size_per_chunk_;
+                if (cached_index_chunk_id_ != chunk_id) {
+                    const Index& index =
+                        segment_->chunk_scalar_index<IndexInnerType>(field_id_,
+                                                                     chunk_id);
+                    auto* index_ptr = const_cast<Index*>(&index);
+                    cached_index_chunk_res_ =
+                        std::move(func(index_ptr, values...));
+                    cached_index_chunk_id_ = chunk_id;
+                }
+                result.push_back(
+                    cached_index_chunk_res_[offset % size_per_chunk_]);
+            }
+            current_offset_pos_ += size;
+            return result;
+        }
         int processed_rows = 0;
 
         for (size_t i = current_index_chunk_; i < num_index_chunk_; i++) {
@@ -224,6 +548,39 @@ class SegmentExpr : public Expr {
         return result;
     }
 
+    // evaluates the next batch of size rows by the results of all the rows
+    // looked up in the json or array index of the field, the lookup runs
+    // once per expr and gives std::nullopt if there is no such index or the
+    // index can't tell, then returns false
+    template <typename FUNC>
+    bool
+    ProcessInvertedIndex(FUNC lookup, bool* res, int64_t size) {
+        if (!inverted_index_looked_up_) {
+            inverted_index_looked_up_ = true;
+            inverted_index_res_ = lookup();
+        }
+        if (!inverted_index_res_.has_value()) {
+            return false;
+        }
+        auto& segment_res = inverted_index_res_.value();
+        if (offset_input_ != nullptr) {
+            for (int64_t i = 0; i < size; ++i) {
+                res[i] = segment_res[(*offset_input_)[current_offset_pos_ + i]];
+            }
+            current_offset_pos_ += size;
+            return true;
+        }
+        // the inverted indexes are only loaded into sealed segments, which
+        // have a single chunk
+        auto begin = current_data_chunk_ * size_per_chunk_ +
+                     current_data_chunk_pos_;
+        std::copy_n(segment_res.begin() + begin, size, res);
+        if (size >= batch_size_) {
+            current_data_chunk_pos_ += size;
+        }
+        return true;
+    }
+
  protected:
     const segcore::SegmentInternalInterface* segment_;
     const FieldId field_id_;
@@ -249,6 +606,19 @@ class SegmentExpr : public Expr {
     // Cache for index scan to avoid search index every batch
     int64_t cached_index_chunk_id_{-1};
     FixedVector<bool> cached_index_chunk_res_{};
+
+    // the results of all the rows looked up in the json or array index
+    bool inverted_index_looked_up_{false};
+    std::optional<TargetBitmap> inverted_index_res_{};
+
+    // set if only the given offsets are evaluated, num_rows_ is the number
+    // of the offsets then
+    const std::vector<int64_t>* offset_input_{nullptr};
+    int64_t current_offset_pos_{0};
+
+    // the rows of the current batch to evaluate, all rows if null
+    const std::vector<int64_t>* selection_{nullptr};
+    static constexpr int64_t SPARSE_SELECTION_RATIO = 8;
 };
 
 std::vector<ExprPtr>
@@ -269,6 +639,12 @@ CompileExpression(const expr::TypedExprPtr& expr,
                   const std::unordered_set<std::string>& flatten_cadidates,
                   bool enable_constant_folding);
 
+// whether the expression can be evaluated only on the offsets given by
+// QueryContext::set_offset_input, or the rows given by
+// QueryContext::set_row_range
+bool
+IsOffsetInputSupported(const expr::TypedExprPtr& expr);
+
 class ExprSet {
  public:
     explicit ExprSet(const std::vector<expr::TypedExprPtr>& logical_exprs,
@@ -0,0 +1,484 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExprRewriter.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+using LogicalOp = expr::LogicalBinaryExpr::OpType;
+using proto::plan::GenericValue;
+using proto::plan::OpType;
+
+// the exprs of the same string are the same
+static std::string
+ExprKey(const expr::TypedExprPtr& expr) {
+    return expr->ToString();
+}
+
+static bool
+IsLogical(const expr::TypedExprPtr& expr, LogicalOp op) {
+    auto logical =
+        std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(expr);
+    return logical != nullptr && logical->op_type_ == op;
+}
+
+static bool
+IsNot(const expr::TypedExprPtr& expr) {
+    auto logical =
+        std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(expr);
+    return logical != nullptr &&
+           logical->op_type_ == expr::LogicalUnaryExpr::OpType::LogicalNot;
+}
+
+static bool
+IsAlwaysTrue(const expr::TypedExprPtr& expr) {
+    return std::dynamic_pointer_cast<const expr::AlwaysTrueExpr>(expr) !=
+           nullptr;
+}
+
+static LogicalOp
+OppositeOp(LogicalOp op) {
+    return op == LogicalOp::And ? LogicalOp::Or : LogicalOp::And;
+}
+
+static void
+FlattenLogical(const expr::TypedExprPtr& expr,
+               LogicalOp op,
+               std::vector<expr::TypedExprPtr>& flat) {
+    if (IsLogical(expr, op)) {
+        for (auto& input : expr->inputs()) {
+            FlattenLogical(input, op, flat);
+        }
+    } else {
+        flat.push_back(expr);
+    }
+}
+
+static expr::TypedExprPtr
+MakeLogical(LogicalOp op, const std::vector<expr::TypedExprPtr>& inputs) {
+    auto result = inputs[0];
+    for (size_t i = 1; i < inputs.size(); ++i) {
+        result =
+            std::make_shared<expr::LogicalBinaryExpr>(op, result, inputs[i]);
+    }
+    return result;
+}
+
+// a column of scalars, neither a json nor an array one
+static bool
+IsPlainColumn(const expr::ColumnInfo& column) {
+    if (!column.nested_path_.empty()) {
+        return false;
+    }
+    switch (column.data_type_) {
+        case DataType::BOOL:
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+        case DataType::VARCHAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// the op of not (column op value), the float columns are left alone as the
+// comparisons with nan are false both ways
+static std::optional<OpType>
+NegatedOp(const expr::UnaryRangeFilterExpr& unary) {
+    auto data_type = unary.column_.data_type_;
+    if (!IsPlainColumn(unary.column_) || data_type == DataType::FLOAT ||
+        data_type == DataType::DOUBLE) {
+        return std::nullopt;
+    }
+    switch (unary.op_type_) {
+        case OpType::GreaterThan:
+            return OpType::LessEqual;
+        case OpType::GreaterEqual:
+            return OpType::LessThan;
+        case OpType::LessThan:
+            return OpType::GreaterEqual;
+        case OpType::LessEqual:
+            return OpType::GreaterThan;
+        case OpType::Equal:
+            return OpType::NotEqual;
+        case OpType::NotEqual:
+            return OpType::Equal;
+        default:
+            return std::nullopt;
+    }
+}
+
+// whether not expr can be rewritten without a not left above the ranges
+static bool
+CanNegate(const expr::TypedExprPtr& expr) {
+    if (IsNot(expr)) {
+        return true;
+    }
+    if (auto unary =
+            std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                expr)) {
+        return NegatedOp(*unary).has_value();
+    }
+    for (auto op : {LogicalOp::And, LogicalOp::Or}) {
+        if (IsLogical(expr, op)) {
+            std::vector<expr::TypedExprPtr> flat;
+            FlattenLogical(expr, op, flat);
+            return std::all_of(flat.begin(), flat.end(), CanNegate);
+        }
+    }
+    return false;
+}
+
+// compare the values of the same case, negative if a < b
+static int
+CompareValue(const GenericValue& a, const GenericValue& b) {
+    switch (a.val_case()) {
+        case GenericValue::kInt64Val:
+            return a.int64_val() < b.int64_val()
+                       ? -1
+                       : (a.int64_val() > b.int64_val() ? 1 : 0);
+        case GenericValue::kFloatVal:
+            return a.float_val() < b.float_val()
+                       ? -1
+                       : (a.float_val() > b.float_val() ? 1 : 0);
+        case GenericValue::kStringVal:
+            return a.string_val().compare(b.string_val());
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unsupported range value: {}",
+                      a.DebugString());
+    }
+}
+
+static bool
+IsRangeValue(const GenericValue& value) {
+    return value.val_case() == GenericValue::kInt64Val ||
+           value.val_case() == GenericValue::kFloatVal ||
+           value.val_case() == GenericValue::kStringVal;
+}
+
+// the overflowed values are left to the unary ranges, which handle them
+template <typename T>
+static bool
+InRange(int64_t value) {
+    return value >= std::numeric_limits<T>::min() &&
+           value <= std::numeric_limits<T>::max();
+}
+
+static bool
+InColumnRange(const GenericValue& value, DataType data_type) {
+    switch (data_type) {
+        case DataType::INT8:
+            return InRange<int8_t>(value.int64_val());
+        case DataType::INT16:
+            return InRange<int16_t>(value.int64_val());
+        case DataType::INT32:
+            return InRange<int32_t>(value.int64_val());
+        default:
+            return true;
+    }
+}
+
+// the lower and upper bounds of the unary ranges on a column under an and,
+// the looser bounds are dropped, and the remaining two merged into a
+// binary range
+static void
+MergeRanges(std::vector<expr::TypedExprPtr>& inputs) {
+    struct Bounds {
+        std::optional<size_t> lower;
+        std::optional<size_t> upper;
+    };
+    std::map<int64_t, Bounds> column_bounds;
+    std::vector<bool> dropped(inputs.size(), false);
+    auto unary_of = [&](size_t i) {
+        return std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+            inputs[i]);
+    };
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto unary = unary_of(i);
+        if (unary == nullptr || !IsPlainColumn(unary->column_) ||
+            unary->column_.data_type_ == DataType::BOOL ||
+            !IsRangeValue(unary->val_)) {
+            continue;
+        }
+        auto op = unary->op_type_;
+        bool is_lower =
+            op == OpType::GreaterThan || op == OpType::GreaterEqual;
+        bool is_upper = op == OpType::LessThan || op == OpType::LessEqual;
+        if (!is_lower && !is_upper) {
+            continue;
+        }
+        auto& bounds = column_bounds[unary->column_.field_id_.get()];
+        auto& bound = is_lower ? bounds.lower : bounds.upper;
+        if (!bound.has_value()) {
+            bound = i;
+            continue;
+        }
+        auto current = unary_of(bound.value());
+        if (current->val_.val_case() != unary->val_.val_case()) {
+            continue;
+        }
+        // the greater lower bound and the less upper bound are tighter, the
+        // exclusive one if the same value
+        auto cmp = CompareValue(unary->val_, current->val_);
+        if (is_upper) {
+            cmp = -cmp;
+        }
+        bool exclusive =
+            op == OpType::GreaterThan || op == OpType::LessThan;
+        if (cmp > 0 || (cmp == 0 && exclusive)) {
+            dropped[bound.value()] = true;
+            bound = i;
+        } else {
+            dropped[i] = true;
+        }
+    }
+
+    std::vector<expr::TypedExprPtr> merged;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (dropped[i]) {
+            continue;
+        }
+        auto unary = unary_of(i);
+        if (unary == nullptr) {
+            merged.push_back(inputs[i]);
+            continue;
+        }
+        auto iter = column_bounds.find(unary->column_.field_id_.get());
+        if (iter == column_bounds.end() ||
+            !iter->second.lower.has_value() ||
+            !iter->second.upper.has_value()) {
+            merged.push_back(inputs[i]);
+            continue;
+        }
+        auto lower_pos = iter->second.lower.value();
+        auto upper_pos = iter->second.upper.value();
+        auto lower = unary_of(lower_pos);
+        auto upper = unary_of(upper_pos);
+        auto data_type = unary->column_.data_type_;
+        if ((i != lower_pos && i != upper_pos) ||
+            lower->val_.val_case() != upper->val_.val_case() ||
+            !InColumnRange(lower->val_, data_type) ||
+            !InColumnRange(upper->val_, data_type)) {
+            merged.push_back(inputs[i]);
+            continue;
+        }
+        // the binary range takes the place of the first of the bounds
+        if (i == std::min(lower_pos, upper_pos)) {
+            merged.push_back(std::make_shared<expr::BinaryRangeFilterExpr>(
+                unary->column_,
+                lower->val_,
+                upper->val_,
+                lower->op_type_ == OpType::GreaterEqual,
+                upper->op_type_ == OpType::LessEqual));
+        }
+    }
+    inputs = std::move(merged);
+}
+
+static expr::TypedExprPtr
+RewriteLogical(LogicalOp op,
+               const std::vector<expr::TypedExprPtr>& inputs,
+               const Schema& schema);
+
+// factor out the inputs shared by all the branches of the and/or, as
+// (a and b) or (a and c) is a and (b or c), and a or (a and b) is a
+static expr::TypedExprPtr
+FactorCommonInputs(LogicalOp op,
+                   const std::vector<expr::TypedExprPtr>& inputs,
+                   const Schema& schema) {
+    auto inner_op = OppositeOp(op);
+    std::vector<std::vector<expr::TypedExprPtr>> branches(inputs.size());
+    std::vector<std::unordered_set<std::string>> branch_keys(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        FlattenLogical(inputs[i], inner_op, branches[i]);
+        for (auto& input : branches[i]) {
+            branch_keys[i].insert(ExprKey(input));
+        }
+    }
+
+    std::vector<expr::TypedExprPtr> common;
+    std::unordered_set<std::string> common_keys;
+    for (auto& input : branches[0]) {
+        auto key = ExprKey(input);
+        if (common_keys.count(key) > 0) {
+            continue;
+        }
+        bool shared = std::all_of(
+            branch_keys.begin() + 1,
+            branch_keys.end(),
+            [&](const auto& keys) { return keys.count(key) > 0; });
+        if (shared) {
+            common.push_back(input);
+            common_keys.insert(key);
+        }
+    }
+    if (common.empty()) {
+        return nullptr;
+    }
+
+    std::vector<expr::TypedExprPtr> rests;
+    for (auto& branch : branches) {
+        std::vector<expr::TypedExprPtr> rest;
+        for (auto& input : branch) {
+            if (common_keys.count(ExprKey(input)) == 0) {
+                rest.push_back(input);
+            }
+        }
+        if (rest.empty()) {
+            // the branch is implied by, or implies, all the others
+            return RewriteLogical(inner_op, common, schema);
+        }
+        rests.push_back(MakeLogical(inner_op, rest));
+    }
+    common.push_back(RewriteLogical(op, rests, schema));
+    return RewriteLogical(inner_op, common, schema);
+}
+
+// the inputs are rewritten already
+static expr::TypedExprPtr
+RewriteLogical(LogicalOp op,
+               const std::vector<expr::TypedExprPtr>& inputs,
+               const Schema& schema) {
+    std::vector<expr::TypedExprPtr> flat;
+    for (auto& input : inputs) {
+        FlattenLogical(input, op, flat);
+    }
+
+    // an always true input decides an or, and is no-op to an and
+    auto always_true = std::find_if(flat.begin(), flat.end(), IsAlwaysTrue);
+    if (always_true != flat.end()) {
+        auto always_true_expr = *always_true;
+        if (op == LogicalOp::Or) {
+            return always_true_expr;
+        }
+        flat.erase(std::remove_if(flat.begin(), flat.end(), IsAlwaysTrue),
+                   flat.end());
+        if (flat.empty()) {
+            return always_true_expr;
+        }
+    }
+
+    std::unordered_set<std::string> keys;
+    flat.erase(std::remove_if(flat.begin(),
+                              flat.end(),
+                              [&](const expr::TypedExprPtr& input) {
+                                  return !keys.insert(ExprKey(input)).second;
+                              }),
+               flat.end());
+
+    if (op == LogicalOp::And) {
+        MergeRanges(flat);
+    }
+    if (flat.size() == 1) {
+        return flat[0];
+    }
+    if (auto factored = FactorCommonInputs(op, flat, schema)) {
+        return factored;
+    }
+    return MakeLogical(op, flat);
+}
+
+// the expr is rewritten already
+static expr::TypedExprPtr
+Negate(const expr::TypedExprPtr& expr, const Schema& schema) {
+    if (IsNot(expr)) {
+        return expr->inputs()[0];
+    }
+    if (auto unary =
+            std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                expr)) {
+        if (auto op = NegatedOp(*unary)) {
+            return std::make_shared<expr::UnaryRangeFilterExpr>(
+                unary->column_, op.value(), unary->val_);
+        }
+    }
+    for (auto op : {LogicalOp::And, LogicalOp::Or}) {
+        if (IsLogical(expr, op) && CanNegate(expr)) {
+            // not (a and b) is (not a) or (not b), and vice versa
+            std::vector<expr::TypedExprPtr> flat;
+            FlattenLogical(expr, op, flat);
+            for (auto& input : flat) {
+                input = Negate(input, schema);
+            }
+            return RewriteLogical(OppositeOp(op), flat, schema);
+        }
+    }
+    return std::make_shared<expr::LogicalUnaryExpr>(
+        expr::LogicalUnaryExpr::OpType::LogicalNot, expr);
+}
+
+expr::TypedExprPtr
+RewriteExpr(const expr::TypedExprPtr& expr, const Schema& schema) {
+    if (IsNot(expr)) {
+        return Negate(RewriteExpr(expr->inputs()[0], schema), schema);
+    }
+    for (auto op : {LogicalOp::And, LogicalOp::Or}) {
+        if (IsLogical(expr, op)) {
+            std::vector<expr::TypedExprPtr> inputs;
+            for (auto& input : expr->inputs()) {
+                inputs.push_back(RewriteExpr(input, schema));
+            }
+            return RewriteLogical(op, inputs, schema);
+        }
+    }
+    if (auto term =
+            std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr)) {
+        auto pk_field_id = schema.get_primary_field_id();
+        bool is_pk = pk_field_id.has_value() &&
+                     pk_field_id.value() == term->column_.field_id_;
+        if (term->vals_.size() == 1 && !term->is_in_field_ && !is_pk &&
+            IsPlainColumn(term->column_)) {
+            return std::make_shared<expr::UnaryRangeFilterExpr>(
+                term->column_, OpType::Equal, term->vals_[0]);
+        }
+    }
+    return expr;
+}
+
+namespace {
+struct RewrittenExpr {
+    expr::TypedExprPtr expr;
+};
+}  // namespace
+
+expr::TypedExprPtr
+GetRewrittenExpr(const expr::TypedExprPtr& expr, const Schema& schema) {
+    return expr
+        ->GetPrepared<RewrittenExpr>([&]() {
+            return RewrittenExpr{RewriteExpr(expr, schema)};
+        })
+        ->expr;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,47 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "common/Schema.h"
+#include "expr/ITypeExpr.h"
+
+namespace milvus {
+namespace exec {
+
+// rewrite the expr into an equivalent one evaluated by fewer passes over the
+// columns before it's compiled:
+//  - the duplicated inputs of and/or are dropped, and the inputs shared by
+//    all the branches are factored out, (a and b) or (a and c) is
+//    a and (b or c)
+//  - the always true inputs of and are dropped, an or of them is always
+//    true
+//  - the lower and upper bounds of a column under an and are merged into a
+//    binary range, the looser bounds dropped
+//  - an in of a single value is an equality, but on the pk, which is
+//    looked up by the pk index
+//  - not is pushed down to the ranges and the other nots it cancels
+// the results are the same as the ones of the expr on every row
+expr::TypedExprPtr
+RewriteExpr(const expr::TypedExprPtr& expr, const Schema& schema);
+
+// the expr rewritten once for all the segments, so the state prepared for
+// the rewritten exprs is shared by them too
+expr::TypedExprPtr
+GetRewrittenExpr(const expr::TypedExprPtr& expr, const Schema& schema);
+
+}  // namespace exec
+}  // namespace milvus
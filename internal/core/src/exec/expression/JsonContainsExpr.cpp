@@ -21,6 +21,8 @@ namespace exec {
 
 void
 PhyJsonContainsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     switch (expr_->column_.data_type_) {
         case DataType::ARRAY:
         case DataType::JSON: {
@@ -167,13 +169,26 @@ PhyJsonContainsFilterExpr::ExecArrayContains() {
     AssertInfo(expr_->column_.nested_path_.size() == 0,
                "[ExecArrayContains]nested path must be null");
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     std::unordered_set<GetType> elements;
     for (auto const& element : expr_->vals_) {
         elements.insert(GetValueFromProto<GetType>(element));
     }
+    auto lookup = [&]() -> std::optional<TargetBitmap> {
+        auto index = segment_->GetArrayIndex(field_id_);
+        if (index == nullptr) {
+            return std::nullopt;
+        }
+        std::vector<ExprValueType> values;
+        for (auto const& element : expr_->vals_) {
+            values.push_back(GetValueFromProto<ExprValueType>(element));
+        }
+        return index->ContainsAny(values);
+    };
+    if (ProcessInvertedIndex(lookup, res, real_batch_size)) {
+        return res_vec;
+    }
     auto execute_sub_batch = [](const milvus::ArrayView* data,
                                 const int size,
                                 bool* res,
@@ -214,35 +229,40 @@ PhyJsonContainsFilterExpr::ExecJsonContains() {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     std::unordered_set<GetType> elements;
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
     for (auto const& element : expr_->vals_) {
         elements.insert(GetValueFromProto<GetType>(element));
     }
+    auto lookup = [&]() -> std::optional<TargetBitmap> {
+        auto index = segment_->GetJsonIndex(field_id_);
+        if (index == nullptr) {
+            return std::nullopt;
+        }
+        std::vector<ExprValueType> values;
+        for (auto const& element : expr_->vals_) {
+            values.push_back(GetValueFromProto<ExprValueType>(element));
+        }
+        return index->ArrayContainsAny(pointer, values);
+    };
+    if (ProcessInvertedIndex(lookup, res, real_batch_size)) {
+        return res_vec;
+    }
     auto execute_sub_batch = [](const milvus::Json* data,
                                 const int size,
                                 bool* res,
                                 const std::string& pointer,
                                 const std::unordered_set<GetType>& elements) {
         auto executor = [&](size_t i) {
-            auto doc = data[i].doc();
-            auto array = doc.at_pointer(pointer).get_array();
-            if (array.error()) {
-                return false;
-            }
-            for (auto&& it : array) {
-                auto val = it.template get<GetType>();
-                if (val.error()) {
-                    continue;
-                }
-                if (elements.count(val.value()) > 0) {
-                    return true;
-                }
-            }
-            return false;
+            bool contains = false;
+            data[i].template for_each_element<GetType>(
+                pointer, [&](const GetType& val) {
+                    contains = elements.count(val) > 0;
+                    return !contains;
+                });
+            return contains;
         };
         for (size_t i = 0; i < size; ++i) {
             res[i] = executor(i);
@@ -265,8 +285,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsArray() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
     std::vector<proto::plan::Array> elements;
@@ -333,14 +352,27 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     std::unordered_set<GetType> elements;
     for (auto const& element : expr_->vals_) {
         elements.insert(GetValueFromProto<GetType>(element));
     }
+    auto lookup = [&]() -> std::optional<TargetBitmap> {
+        auto index = segment_->GetArrayIndex(field_id_);
+        if (index == nullptr) {
+            return std::nullopt;
+        }
+        std::vector<ExprValueType> values;
+        for (auto const& element : expr_->vals_) {
+            values.push_back(GetValueFromProto<ExprValueType>(element));
+        }
+        return index->ContainsAll(values);
+    };
+    if (ProcessInvertedIndex(lookup, res, real_batch_size)) {
+        return res_vec;
+    }
 
     auto execute_sub_batch = [](const milvus::ArrayView* data,
                                 const int size,
@@ -383,14 +415,27 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAll() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
     std::unordered_set<GetType> elements;
     for (auto const& element : expr_->vals_) {
         elements.insert(GetValueFromProto<GetType>(element));
     }
+    auto lookup = [&]() -> std::optional<TargetBitmap> {
+        auto index = segment_->GetJsonIndex(field_id_);
+        if (index == nullptr) {
+            return std::nullopt;
+        }
+        std::vector<ExprValueType> values;
+        for (auto const& element : expr_->vals_) {
+            values.push_back(GetValueFromProto<ExprValueType>(element));
+        }
+        return index->ArrayContainsAll(pointer, values);
+    };
+    if (ProcessInvertedIndex(lookup, res, real_batch_size)) {
+        return res_vec;
+    }
 
     auto execute_sub_batch = [](const milvus::Json* data,
                                 const int size,
@@ -398,24 +443,13 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAll() {
                                 const std::string& pointer,
                                 const std::unordered_set<GetType>& elements) {
         auto executor = [&](const size_t i) -> bool {
-            auto doc = data[i].doc();
-            auto array = doc.at_pointer(pointer).get_array();
-            if (array.error()) {
-                return false;
-            }
             std::unordered_set<GetType> tmp_elements(elements);
-            // Note: array can only be iterated once
-            for (auto&& it : array) {
-                auto val = it.template get<GetType>();
-                if (val.error()) {
-                    continue;
-                }
-                tmp_elements.erase(val.value());
-                if (tmp_elements.size() == 0) {
-                    return true;
-                }
-            }
-            return tmp_elements.size() == 0;
+            auto is_array = data[i].template for_each_element<GetType>(
+                pointer, [&](const GetType& val) {
+                    tmp_elements.erase(val);
+                    return !tmp_elements.empty();
+                });
+            return is_array && tmp_elements.empty();
         };
         for (size_t i = 0; i < size; ++i) {
             res[i] = executor(i);
@@ -438,8 +472,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAllWithDiffType() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
 
@@ -563,8 +596,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAllArray() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
 
@@ -629,8 +661,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsWithDiffType() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
 
@@ -0,0 +1,46 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ProfiledExpr.h"
+
+#include <algorithm>
+
+#include "exec/expression/Utils.h"
+
+namespace milvus {
+namespace exec {
+
+void
+PhyProfiledExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    ProfileTimer timer(profile_, name_);
+    input_->Eval(context, result);
+    timer.Stop();
+
+    auto& stage = timer.stage();
+    stage.path_ = input_->GetEvalPath();
+    if (result == nullptr) {
+        stage.batches_ = 0;
+        return;
+    }
+    auto vec = GetColumnVector(result);
+    auto data = static_cast<const bool*>(vec->GetRawData());
+    stage.input_rows_ = vec->size();
+    stage.output_rows_ = std::count(data, data + vec->size(), true);
+    stage.bytes_ = vec->size() * input_->GetRowBytes();
+}
+
+}  //namespace exec
+}  // namespace milvus
@@ -0,0 +1,70 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/QueryProfile.h"
+#include "exec/expression/Expr.h"
+
+namespace milvus {
+namespace exec {
+
+// PhyProfiledExpr records the batches evaluated by the expression it wraps
+// into the query profile, the expressions are wrapped only if the query is
+// profiled.
+class PhyProfiledExpr : public Expr {
+ public:
+    PhyProfiledExpr(ExprPtr input,
+                    const std::string& name,
+                    QueryProfile* profile)
+        : Expr(input->type(), {}, name),
+          input_(std::move(input)),
+          profile_(profile) {
+    }
+
+    void
+    Eval(EvalCtx& context, VectorPtr& result) override;
+
+    void
+    SetOffsetInput(const std::vector<int64_t>* offset_input) override {
+        input_->SetOffsetInput(offset_input);
+    }
+
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        input_->SetRowRange(begin, end);
+    }
+
+    std::string
+    GetEvalPath() const override {
+        return input_->GetEvalPath();
+    }
+
+    int64_t
+    GetRowBytes() const override {
+        return input_->GetRowBytes();
+    }
+
+ private:
+    ExprPtr input_;
+    QueryProfile* profile_;
+};
+
+}  //namespace exec
+}  // namespace milvus
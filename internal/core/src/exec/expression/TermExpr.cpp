@@ -21,6 +21,8 @@ namespace exec {
 
 void
 PhyTermFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     if (is_pk_field_) {
         result = ExecPkTermImpl();
         return;
@@ -55,11 +57,7 @@ PhyTermFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_->type() == SegmentType::Growing) {
-                result = ExecVisitorImpl<std::string>();
-            } else {
-                result = ExecVisitorImpl<std::string_view>();
-            }
+            result = ExecVisitorImpl<std::string_view>();
             break;
         }
         case DataType::JSON: {
@@ -142,7 +140,7 @@ PhyTermFilterExpr::InitPkCacheOffset() {
 
     auto [uids, seg_offsets] =
         segment_->search_ids(*id_array, query_timestamp_);
-    cached_bits_.resize(num_rows_);
+    cached_bits_.resize(segment_->get_active_count(query_timestamp_));
     cached_offsets_ =
         std::make_shared<ColumnVector>(DataType::INT64, seg_offsets.size());
     int64_t* cached_offsets_ptr = (int64_t*)cached_offsets_->GetRawData();
@@ -161,27 +159,64 @@ PhyTermFilterExpr::ExecPkTermImpl() {
         InitPkCacheOffset();
     }
 
+    if (offset_input_ != nullptr) {
+        auto real_batch_size = GetNextBatchSize();
+        if (real_batch_size == 0) {
+            return nullptr;
+        }
+        auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+        bool* res = (bool*)res_vec->GetRawData();
+        for (size_t i = 0; i < real_batch_size; ++i) {
+            res[i] = cached_bits_[(*offset_input_)[current_offset_pos_ + i]];
+        }
+        current_offset_pos_ += real_batch_size;
+        // the cached offsets are of the whole segment, not of the input
+        return res_vec;
+    }
+
     auto real_batch_size = current_data_chunk_pos_ + batch_size_ >= num_rows_
                                ? num_rows_ - current_data_chunk_pos_
                                : batch_size_;
+    auto batch_begin = current_data_chunk_pos_;
     current_data_chunk_pos_ += real_batch_size;
 
     if (real_batch_size == 0) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     for (size_t i = 0; i < real_batch_size; ++i) {
-        res[i] = cached_bits_[i];
+        res[i] = cached_bits_[batch_begin + i];
     }
 
     std::vector<VectorPtr> vecs{res_vec, cached_offsets_};
     return std::make_shared<RowVector>(vecs);
 }
 
+template <typename T>
+const TermSet<T>&
+PhyTermFilterExpr::GetTermSet() {
+    using TermSetPtr = std::shared_ptr<const TermSet<T>>;
+    if (!term_set_.has_value()) {
+        term_set_ = expr_->GetPrepared<TermSet<T>>([this]() {
+            std::vector<typename TermSet<T>::ValueType> vals;
+            for (auto& val : expr_->vals_) {
+                // Integral overflow process
+                bool overflowed = false;
+                auto converted_val = GetValueFromProtoWithOverflow<
+                    typename TermSet<T>::ValueType>(val, overflowed);
+                if (!overflowed) {
+                    vals.emplace_back(std::move(converted_val));
+                }
+            }
+            return TermSet<T>(std::move(vals));
+        });
+    }
+    return **std::any_cast<TermSetPtr>(&term_set_);
+}
+
 template <typename ValueType>
 VectorPtr
 PhyTermFilterExpr::ExecVisitorImplTemplateJson() {
@@ -212,8 +247,7 @@ PhyTermFilterExpr::ExecTermArrayVariableInField() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     AssertInfo(expr_->vals_.size() == 1,
@@ -259,20 +293,15 @@ PhyTermFilterExpr::ExecTermArrayFieldInVariable() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     int index = -1;
     if (expr_->column_.nested_path_.size() > 0) {
         index = std::stoi(expr_->column_.nested_path_[0]);
     }
-    std::unordered_set<ValueType> term_set;
-    for (const auto& element : expr_->vals_) {
-        term_set.insert(GetValueFromProto<ValueType>(element));
-    }
-
-    if (term_set.empty()) {
+    auto& term_set = GetTermSet<ValueType>();
+    if (term_set.Empty()) {
         for (size_t i = 0; i < real_batch_size; ++i) {
             res[i] = false;
         }
@@ -283,19 +312,14 @@ PhyTermFilterExpr::ExecTermArrayFieldInVariable() {
                                 const int size,
                                 bool* res,
                                 int index,
-                                const std::unordered_set<ValueType>& term_set) {
-        if (term_set.empty()) {
-            for (int i = 0; i < size; ++i) {
-                res[i] = false;
-            }
-        }
+                                const TermSet<ValueType>& term_set) {
         for (int i = 0; i < size; ++i) {
             if (index >= data[i].length()) {
                 res[i] = false;
                 continue;
             }
             auto value = data[i].get_data<GetType>(index);
-            res[i] = term_set.find(ValueType(value)) != term_set.end();
+            res[i] = term_set.Contains(value);
         }
     };
 
@@ -319,8 +343,7 @@ PhyTermFilterExpr::ExecTermJsonVariableInField() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     AssertInfo(expr_->vals_.size() == 1,
                "element length in json array must be one");
@@ -372,27 +395,38 @@ PhyTermFilterExpr::ExecTermJsonFieldInVariable() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
-    std::unordered_set<ValueType> term_set;
-    for (const auto& element : expr_->vals_) {
-        term_set.insert(GetValueFromProto<ValueType>(element));
-    }
-
-    if (term_set.empty()) {
+    auto& term_set = GetTermSet<ValueType>();
+    if (term_set.Empty()) {
         for (size_t i = 0; i < real_batch_size; ++i) {
             res[i] = false;
         }
         return res_vec;
     }
 
+    auto lookup = [&]() -> std::optional<TargetBitmap> {
+        auto index = segment_->GetJsonIndex(field_id_);
+        if (index == nullptr) {
+            return std::nullopt;
+        }
+        std::vector<ValueType> values;
+        values.reserve(expr_->vals_.size());
+        for (auto& val : expr_->vals_) {
+            values.push_back(GetValueFromProto<ValueType>(val));
+        }
+        return index->In(pointer, values);
+    };
+    if (ProcessInvertedIndex(lookup, res, real_batch_size)) {
+        return res_vec;
+    }
+
     auto execute_sub_batch = [](const Json* data,
                                 const int size,
                                 bool* res,
                                 const std::string pointer,
-                                const std::unordered_set<ValueType>& terms) {
+                                const TermSet<ValueType>& terms) {
         auto executor = [&](size_t i) {
             auto x = data[i].template at<GetType>(pointer);
             if (x.error()) {
@@ -405,11 +439,11 @@ PhyTermFilterExpr::ExecTermJsonFieldInVariable() {
                     auto value = x.value();
                     // if the term set is {1}, and the value is 1.1, we should not return true.
                     return std::floor(value) == value &&
-                           terms.find(ValueType(value)) != terms.end();
+                           terms.Contains(ValueType(value));
                 }
                 return false;
             }
-            return terms.find(ValueType(x.value())) != terms.end();
+            return terms.Contains(x.value());
         };
         for (size_t i = 0; i < size; ++i) {
             res[i] = executor(i);
@@ -447,17 +481,21 @@ PhyTermFilterExpr::ExecVisitorImplForIndex() {
         return nullptr;
     }
 
-    std::vector<IndexInnerType> vals;
-    for (auto& val : expr_->vals_) {
-        auto converted_val = GetValueFromProto<T>(val);
-        // Integral overflow process
-        if constexpr (std::is_integral_v<T>) {
-            if (milvus::query::out_of_range<T>(converted_val)) {
-                continue;
+    // the values are converted once for all the batches and segments
+    auto& vals = *expr_->GetPrepared<std::vector<IndexInnerType>>([this]() {
+        std::vector<IndexInnerType> converted;
+        for (auto& val : expr_->vals_) {
+            auto converted_val = GetValueFromProto<T>(val);
+            // Integral overflow process
+            if constexpr (std::is_integral_v<T>) {
+                if (milvus::query::out_of_range<T>(converted_val)) {
+                    continue;
+                }
             }
+            converted.emplace_back(converted_val);
         }
-        vals.emplace_back(converted_val);
-    }
+        return converted;
+    });
     auto execute_sub_batch = [](Index* index_ptr,
                                 const std::vector<IndexInnerType>& vals) {
         TermIndexFunc<T> func;
@@ -501,30 +539,79 @@ PhyTermFilterExpr::ExecVisitorImplForData() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
-    std::vector<T> vals;
-    for (auto& val : expr_->vals_) {
-        // Integral overflow process
-        bool overflowed = false;
-        auto converted_val = GetValueFromProtoWithOverflow<T>(val, overflowed);
-        if (!overflowed) {
-            vals.emplace_back(converted_val);
+    auto& term_set = GetTermSet<T>();
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (auto dict = segment_->GetStringDictionary(field_id_)) {
+            return ExecVisitorImplForDictionary(
+                *dict, term_set, res_vec, real_batch_size);
         }
     }
-    std::unordered_set<T> vals_set(vals.begin(), vals.end());
     auto execute_sub_batch = [](const T* data,
                                 const int size,
                                 bool* res,
-                                const std::unordered_set<T>& vals) {
-        TermElementFuncSet<T> func;
-        for (size_t i = 0; i < size; ++i) {
-            res[i] = func(vals, data[i]);
-        }
+                                const TermSet<T>& term_set) {
+        term_set.Contains(data, size, res);
+    };
+    auto skip_index_func = [&term_set](const SkipIndex& skip_index,
+                                       FieldId field_id,
+                                       int64_t chunk_id) {
+        return skip_index.CanSkipTerm<T>(
+            field_id, chunk_id, term_set.values());
+    };
+    // a chunk all of whose distinct values are in the set, like a segment of
+    // the partition keys filtered on, is set true without reading it
+    auto block_match_func = [&term_set](const SkipIndex& skip_index,
+                                        FieldId field_id,
+                                        int64_t chunk_id,
+                                        int64_t block_id) {
+        return skip_index.TermBlockMatch<T>(
+            field_id, chunk_id, block_id, term_set.values());
     };
     int64_t processed_size = ProcessDataChunks<T>(
-        execute_sub_batch, std::nullptr_t{}, res, vals_set);
+        execute_sub_batch, skip_index_func, block_match_func, res, term_set);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
+VectorPtr
+PhyTermFilterExpr::ExecVisitorImplForDictionary(
+    const StringDictionary& dict,
+    const TermSet<std::string_view>& term_set,
+    const ColumnVectorPtr& res_vec,
+    int64_t real_batch_size) {
+    bool* res = (bool*)res_vec->GetRawData();
+    // the codes of the values are looked up once, then the rows by codes
+    std::vector<uint8_t> matched(dict.values.size(), 0);
+    for (const auto& value : term_set.values()) {
+        auto code = dict.LowerBound(value);
+        if (static_cast<size_t>(code) < matched.size() &&
+            dict.values[code] == value) {
+            matched[code] = 1;
+        }
+    }
+
+    // the views of a sealed segment are in a single chunk, the offset of a
+    // view is the row offset of its code
+    const std::string_view* base =
+        segment_->chunk_data<std::string_view>(field_id_, 0).data();
+    const int32_t* codes = dict.codes.data();
+    auto execute_sub_batch = [base, codes, &matched](
+                                 const std::string_view* data,
+                                 const int size,
+                                 bool* res) {
+        const int32_t* row_codes = codes + (data - base);
+        for (int i = 0; i < size; ++i) {
+            res[i] = matched[row_codes[i]];
+        }
+    };
+    int64_t processed_size = ProcessDataChunks<std::string_view>(
+        execute_sub_batch, std::nullptr_t{}, res);
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -16,6 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <any>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 #include <fmt/core.h>
 
 #include "common/EasyAssert.h"
@@ -27,24 +36,152 @@
 namespace milvus {
 namespace exec {
 
+// TermSet is the membership test of the values of a term expr, built once per
+// expr. The structure is chosen by the number of the values: a flat array
+// compared with every value for a few of them, a sorted array searched without
+// branches for more, and an open addressing hash table for the most.
 template <typename T>
-struct TermElementFuncFlat {
-    bool
-    operator()(const T* src, size_t n, T val) {
-        for (size_t i = 0; i < n; ++i) {
-            if (src[i] == val) {
-                return true;
+class TermSet {
+ public:
+    // the strings are stored as std::string and probed by std::string_view
+    static constexpr bool IS_STRING = std::is_same_v<T, std::string> ||
+                                      std::is_same_v<T, std::string_view>;
+    using ValueType = std::conditional_t<IS_STRING, std::string, T>;
+    using ProbeType = std::conditional_t<IS_STRING, std::string_view, T>;
+
+    explicit TermSet(std::vector<ValueType> values)
+        : values_(std::move(values)) {
+        if constexpr (std::is_floating_point_v<T>) {
+            // NaN equals nothing, and -0.0 is stored as 0.0 to hash the same
+            values_.erase(std::remove_if(values_.begin(),
+                                         values_.end(),
+                                         [](T v) { return std::isnan(v); }),
+                          values_.end());
+            for (auto& v : values_) {
+                v = v == 0 ? 0 : v;
+            }
+        }
+        std::sort(values_.begin(), values_.end());
+        values_.erase(std::unique(values_.begin(), values_.end()),
+                      values_.end());
+
+        if (values_.size() <= FLAT_MAX_SIZE) {
+            kind_ = Kind::Flat;
+        } else if (values_.size() <= SORTED_MAX_SIZE) {
+            kind_ = Kind::Sorted;
+        } else {
+            kind_ = Kind::Hash;
+            size_t capacity = 1;
+            while (capacity < values_.size() * 2) {
+                capacity <<= 1;
+            }
+            mask_ = capacity - 1;
+            slots_.assign(capacity, 0);
+            for (size_t i = 0; i < values_.size(); ++i) {
+                auto pos = Hash(values_[i]) & mask_;
+                while (slots_[pos] != 0) {
+                    pos = (pos + 1) & mask_;
+                }
+                slots_[pos] = i + 1;
             }
         }
     }
-};
 
-template <typename T>
-struct TermElementFuncSet {
     bool
-    operator()(const std::unordered_set<T>& srcs, T val) {
-        return srcs.find(val) != srcs.end();
+    Empty() const {
+        return values_.empty();
+    }
+
+    // the distinct values, in ascending order
+    const std::vector<ValueType>&
+    values() const {
+        return values_;
+    }
+
+    bool
+    Contains(ProbeType val) const {
+        switch (kind_) {
+            case Kind::Flat: {
+                bool found = false;
+                for (const auto& v : values_) {
+                    found |= v == val;
+                }
+                return found;
+            }
+            case Kind::Sorted: {
+                // find the last value not greater than val
+                const ValueType* base = values_.data();
+                auto n = values_.size();
+                while (n > 1) {
+                    auto half = n / 2;
+                    base = base[half] <= val ? base + half : base;
+                    n -= half;
+                }
+                return *base == val;
+            }
+            default: {
+                auto pos = Hash(val) & mask_;
+                while (slots_[pos] != 0) {
+                    if (values_[slots_[pos] - 1] == val) {
+                        return true;
+                    }
+                    pos = (pos + 1) & mask_;
+                }
+                return false;
+            }
+        }
+    }
+
+    // res[i] is whether src[i] is one of the values
+    template <typename SrcType>
+    void
+    Contains(const SrcType* src, size_t size, bool* res) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (kind_ == Kind::Flat) {
+                // compare the rows with one value at a time, which the
+                // compiler vectorizes as a broadcast compare
+                std::fill(res, res + size, false);
+                for (auto v : values_) {
+                    for (size_t i = 0; i < size; ++i) {
+                        res[i] |= src[i] == v;
+                    }
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i < size; ++i) {
+            res[i] = Contains(src[i]);
+        }
+    }
+
+ private:
+    static uint64_t
+    Hash(ProbeType val) {
+        uint64_t x;
+        if constexpr (IS_STRING) {
+            x = std::hash<std::string_view>{}(val);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            double d = val == 0 ? 0 : val;
+            std::memcpy(&x, &d, sizeof(x));
+        } else {
+            x = static_cast<uint64_t>(val);
+        }
+        // the finalizer of splitmix64
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
     }
+
+ private:
+    static constexpr size_t FLAT_MAX_SIZE = 16;
+    static constexpr size_t SORTED_MAX_SIZE = 256;
+
+    enum class Kind { Flat, Sorted, Hash };
+    Kind kind_;
+    std::vector<ValueType> values_;
+    // index + 1 of the value in values_, 0 for an empty slot
+    std::vector<uint32_t> slots_;
+    size_t mask_ = 0;
 };
 
 template <typename T>
@@ -123,12 +260,26 @@ class PhyTermFilterExpr : public SegmentExpr {
     VectorPtr
     ExecTermArrayFieldInVariable();
 
+    template <typename T>
+    const TermSet<T>&
+    GetTermSet();
+
+    // evaluate on the codes of a dictionary encoded string field
+    VectorPtr
+    ExecVisitorImplForDictionary(const StringDictionary& dict,
+                                 const TermSet<std::string_view>& term_set,
+                                 const ColumnVectorPtr& res_vec,
+                                 int64_t real_batch_size);
+
  private:
     std::shared_ptr<const milvus::expr::TermFilterExpr> expr_;
     // If expr is like "pk in (..)", can use pk index to optimize
     bool cached_offsets_inited_{false};
     ColumnVectorPtr cached_offsets_;
     FixedVector<bool> cached_bits_;
+    // the TermSet of the values, of the type the expr is evaluated with,
+    // shared with the other segments by GetPrepared of the expr
+    std::any term_set_;
 };
 }  //namespace exec
 }  // namespace milvus
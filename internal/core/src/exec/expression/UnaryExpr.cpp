@@ -22,6 +22,8 @@ namespace exec {
 
 void
 PhyUnaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetSelection(context);
+    SetVectorPool(context);
     switch (expr_->column_.data_type_) {
         case DataType::BOOL: {
             result = ExecRangeVisitorImpl<bool>();
@@ -52,11 +54,7 @@ PhyUnaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_->type() == SegmentType::Growing) {
-                result = ExecRangeVisitorImpl<std::string>();
-            } else {
-                result = ExecRangeVisitorImpl<std::string_view>();
-            }
+            result = ExecRangeVisitorImpl<std::string_view>();
             break;
         }
         case DataType::JSON: {
@@ -124,8 +122,7 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplArray() {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
 
     ValueType val = GetValueFromProto<ValueType>(expr_->val_);
@@ -208,12 +205,44 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
         return nullptr;
     }
 
-    ExprValueType val = GetValueFromProto<ExprValueType>(expr_->val_);
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
-    bool* res = (bool*)res_vec->GetRawData();
     auto op_type = expr_->op_type_;
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
+    if constexpr (!std::is_same_v<ExprValueType, proto::plan::Array>) {
+        if (op_type == proto::plan::Equal || op_type == proto::plan::NotEqual) {
+            auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+            std::vector<ExprValueType> values{
+                GetValueFromProto<ExprValueType>(expr_->val_)};
+            // NotEqual also matches the rows missing the value
+            auto lookup = [&]() -> std::optional<TargetBitmap> {
+                auto index = segment_->GetJsonIndex(field_id_);
+                if (index == nullptr) {
+                    return std::nullopt;
+                }
+                auto res = index->In(pointer, values);
+                if (res.has_value() && op_type == proto::plan::NotEqual) {
+                    for (size_t i = 0; i < res->size(); ++i) {
+                        (*res)[i] = !(*res)[i];
+                    }
+                }
+                return res;
+            };
+            if (ProcessInvertedIndex(
+                    lookup, (bool*)res_vec->GetRawData(), real_batch_size)) {
+                return res_vec;
+            }
+        }
+        auto key_column = segment_->GetJsonKeyColumn(field_id_, pointer);
+        if (key_column != nullptr && key_column->Serves<ExprValueType>() &&
+            (op_type != proto::plan::PrefixMatch ||
+             std::is_same_v<ExprValueType, std::string>)) {
+            return ExecRangeVisitorImplJsonKeyColumn<ExprValueType>(
+                *key_column, real_batch_size);
+        }
+    }
+
+    ExprValueType val = GetValueFromProto<ExprValueType>(expr_->val_);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+    bool* res = (bool*)res_vec->GetRawData();
 
 #define UnaryRangeJSONCompare(cmp)                             \
     do {                                                       \
@@ -350,6 +379,88 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
     return res_vec;
 }
 
+template <typename ExprValueType>
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonKeyColumn(
+    const segcore::JsonKeyColumn& column, int64_t real_batch_size) {
+    ExprValueType val = GetValueFromProto<ExprValueType>(expr_->val_);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+    bool* res = (bool*)res_vec->GetRawData();
+    auto op_type = expr_->op_type_;
+
+    // the json views of a sealed segment are in a single chunk, the offset
+    // of a view is the row offset in the extracted column
+    const milvus::Json* base =
+        segment_->chunk_data<milvus::Json>(field_id_, 0).data();
+    auto execute_sub_batch = [op_type, &column, base](const milvus::Json* data,
+                                                      const int size,
+                                                      bool* res,
+                                                      ExprValueType val) {
+        auto offset = data - base;
+        switch (op_type) {
+            case proto::plan::GreaterThan: {
+                UnaryElementFuncForJsonKey<ExprValueType,
+                                           proto::plan::GreaterThan>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::GreaterEqual: {
+                UnaryElementFuncForJsonKey<ExprValueType,
+                                           proto::plan::GreaterEqual>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::LessThan: {
+                UnaryElementFuncForJsonKey<ExprValueType, proto::plan::LessThan>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::LessEqual: {
+                UnaryElementFuncForJsonKey<ExprValueType,
+                                           proto::plan::LessEqual>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::Equal: {
+                UnaryElementFuncForJsonKey<ExprValueType, proto::plan::Equal>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::NotEqual: {
+                UnaryElementFuncForJsonKey<ExprValueType, proto::plan::NotEqual>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            case proto::plan::PrefixMatch: {
+                UnaryElementFuncForJsonKey<ExprValueType,
+                                           proto::plan::PrefixMatch>
+                    func;
+                func(column, offset, size, val, res);
+                break;
+            }
+            default:
+                PanicInfo(
+                    OpTypeInvalid,
+                    fmt::format("unsupported operator type for unary expr: {}",
+                                op_type));
+        }
+    };
+    int64_t processed_size = ProcessDataChunks<milvus::Json>(
+        execute_sub_batch, std::nullptr_t{}, res, val);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
 template <typename T>
 VectorPtr
 PhyUnaryRangeFilterExpr::ExecRangeVisitorImpl() {
@@ -414,6 +525,16 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForIndex() {
                 res = std::move(func(index_ptr, val));
                 break;
             }
+            case proto::plan::PostfixMatch: {
+                UnaryIndexFunc<T, proto::plan::PostfixMatch> func;
+                res = std::move(func(index_ptr, val));
+                break;
+            }
+            case proto::plan::Match: {
+                UnaryIndexFunc<T, proto::plan::Match> func;
+                res = std::move(func(index_ptr, val));
+                break;
+            }
             default:
                 PanicInfo(
                     OpTypeInvalid,
@@ -521,15 +642,26 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData() {
     if (real_batch_size == 0) {
         return nullptr;
     }
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (auto dict = segment_->GetStringDictionary(field_id_)) {
+            return ExecRangeVisitorImplForDictionary(*dict, real_batch_size);
+        }
+    }
     IndexInnerType val = GetValueFromProto<IndexInnerType>(expr_->val_);
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
     bool* res = (bool*)res_vec->GetRawData();
     auto expr_type = expr_->op_type_;
-    auto execute_sub_batch = [expr_type](const T* data,
-                                         const int size,
-                                         bool* res,
-                                         IndexInnerType val) {
+    // the LIKE pattern is compiled once for all the batches
+    std::shared_ptr<LikePattern> pattern;
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (expr_type == proto::plan::Match) {
+            pattern = std::make_shared<LikePattern>(val);
+        }
+    }
+    auto execute_sub_batch = [expr_type, pattern](const T* data,
+                                                  const int size,
+                                                  bool* res,
+                                                  IndexInnerType val) {
         switch (expr_type) {
             case proto::plan::GreaterThan: {
                 UnaryElementFunc<T, proto::plan::GreaterThan> func;
@@ -566,6 +698,20 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData() {
                 func(data, size, val, res);
                 break;
             }
+            case proto::plan::PostfixMatch: {
+                UnaryElementFunc<T, proto::plan::PostfixMatch> func;
+                func(data, size, val, res);
+                break;
+            }
+            case proto::plan::Match: {
+                if constexpr (std::is_same_v<T, std::string_view>) {
+                    pattern->Match(data, size, res);
+                } else {
+                    PanicInfo(OpTypeInvalid,
+                              "like is only supported on the strings");
+                }
+                break;
+            }
             default:
                 PanicInfo(
                     OpTypeInvalid,
@@ -573,14 +719,141 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData() {
                                 expr_type));
         }
     };
-    auto skip_index_func = [expr_type, val](const SkipIndex& skip_index,
-                                            FieldId field_id,
-                                            int64_t chunk_id) {
+    auto skip_index_func = [expr_type, val, pattern](
+                               const SkipIndex& skip_index,
+                               FieldId field_id,
+                               int64_t chunk_id) {
+        if (pattern != nullptr) {
+            return skip_index.CanSkipLike<T>(field_id, chunk_id, *pattern);
+        }
         return skip_index.CanSkipUnaryRange<T>(
             field_id, chunk_id, expr_type, val);
     };
-    int64_t processed_size =
-        ProcessDataChunks<T>(execute_sub_batch, skip_index_func, res, val);
+    auto block_match_func = [expr_type, val](const SkipIndex& skip_index,
+                                             FieldId field_id,
+                                             int64_t chunk_id,
+                                             int64_t block_id) {
+        return skip_index.UnaryRangeBlockMatch<T>(
+            field_id, chunk_id, block_id, expr_type, val);
+    };
+    int64_t processed_size = ProcessDataChunks<T>(
+        execute_sub_batch, skip_index_func, block_match_func, res, val);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForDictionary(
+    const StringDictionary& dict, int64_t real_batch_size) {
+    auto val = GetValueFromProto<std::string>(expr_->val_);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+    bool* res = (bool*)res_vec->GetRawData();
+
+    // the rows match if their codes are in [lower, upper), or out of it if
+    // negated
+    int32_t lower = 0;
+    int32_t upper = dict.values.size();
+    bool negated = false;
+    switch (expr_->op_type_) {
+        case proto::plan::GreaterThan:
+            lower = dict.UpperBound(val);
+            break;
+        case proto::plan::GreaterEqual:
+            lower = dict.LowerBound(val);
+            break;
+        case proto::plan::LessThan:
+            upper = dict.LowerBound(val);
+            break;
+        case proto::plan::LessEqual:
+            upper = dict.UpperBound(val);
+            break;
+        case proto::plan::NotEqual:
+            negated = true;
+            [[fallthrough]];
+        case proto::plan::Equal:
+            lower = dict.LowerBound(val);
+            upper = dict.UpperBound(val);
+            break;
+        case proto::plan::PrefixMatch:
+            lower = dict.LowerBound(val);
+            upper = dict.PrefixEnd(val);
+            break;
+        case proto::plan::PostfixMatch:
+        case proto::plan::Match:
+            return ExecRangeVisitorImplForDictionaryMatch(dict,
+                                                          real_batch_size);
+        default:
+            PanicInfo(
+                OpTypeInvalid,
+                fmt::format("unsupported operator type for unary expr: {}",
+                            expr_->op_type_));
+    }
+    upper = std::max(lower, upper);
+
+    // the views of a sealed segment are in a single chunk, the offset of a
+    // view is the row offset of its code
+    const std::string_view* base =
+        segment_->chunk_data<std::string_view>(field_id_, 0).data();
+    const int32_t* codes = dict.codes.data();
+    auto execute_sub_batch = [base, codes, lower, upper, negated](
+                                 const std::string_view* data,
+                                 const int size,
+                                 bool* res) {
+        // compared as unsigned without branches, so it's vectorized
+        auto width = static_cast<uint32_t>(upper - lower);
+        const int32_t* row_codes = codes + (data - base);
+        for (int i = 0; i < size; ++i) {
+            auto offset = static_cast<uint32_t>(row_codes[i] - lower);
+            res[i] = (offset < width) != negated;
+        }
+    };
+    int64_t processed_size = ProcessDataChunks<std::string_view>(
+        execute_sub_batch, std::nullptr_t{}, res);
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForDictionaryMatch(
+    const StringDictionary& dict, int64_t real_batch_size) {
+    auto val = GetValueFromProto<std::string>(expr_->val_);
+    auto pattern = expr_->op_type_ == proto::plan::PostfixMatch
+                       ? LikePattern::Postfix(val)
+                       : LikePattern(val);
+    auto res_vec = NewResultVector(DataType::BOOL, real_batch_size);
+    bool* res = (bool*)res_vec->GetRawData();
+
+    // the pattern is matched against each distinct value once, only the
+    // values starting with the literal prefix of the pattern can match
+    auto& prefix = pattern.prefix();
+    std::vector<uint8_t> matched(dict.values.size(), 0);
+    auto end = dict.PrefixEnd(prefix);
+    for (auto code = dict.LowerBound(prefix); code < end; ++code) {
+        matched[code] = pattern.Match(dict.values[code]);
+    }
+
+    const std::string_view* base =
+        segment_->chunk_data<std::string_view>(field_id_, 0).data();
+    const int32_t* codes = dict.codes.data();
+    const uint8_t* table = matched.data();
+    auto execute_sub_batch = [base, codes, table](const std::string_view* data,
+                                                  const int size,
+                                                  bool* res) {
+        const int32_t* row_codes = codes + (data - base);
+        for (int i = 0; i < size; ++i) {
+            res[i] = table[row_codes[i]];
+        }
+    };
+    int64_t processed_size = ProcessDataChunks<std::string_view>(
+        execute_sub_batch, std::nullptr_t{}, res);
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
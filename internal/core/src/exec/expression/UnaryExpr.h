@@ -19,12 +19,14 @@
 #include <fmt/core.h>
 
 #include "common/EasyAssert.h"
+#include "common/LikePattern.h"
 #include "common/Types.h"
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "index/Meta.h"
 #include "segcore/SegmentInterface.h"
 #include "query/Utils.h"
+#include "simd/hook.h"
 
 namespace milvus {
 namespace exec {
@@ -36,7 +38,15 @@ struct UnaryElementFunc {
             IndexInnerType;
     void
     operator()(const T* src, size_t size, IndexInnerType val, bool* res) {
-        for (int i = 0; i < size; ++i) {
+#if defined(USE_DYNAMIC_SIMD)
+        if constexpr (simd::has_compare_kernel<T> &&
+                      ToSimdCompareOp(op).has_value()) {
+            simd::compare_val_func<T>()(
+                src, size, val, ToSimdCompareOp(op).value(), res);
+            return;
+        }
+#endif
+        for (size_t i = 0; i < size; ++i) {
             if constexpr (op == proto::plan::OpType::Equal) {
                 res[i] = src[i] == val;
             } else if constexpr (op == proto::plan::OpType::NotEqual) {
@@ -52,6 +62,9 @@ struct UnaryElementFunc {
             } else if constexpr (op == proto::plan::OpType::PrefixMatch) {
                 res[i] = milvus::query::Match(
                     src[i], val, proto::plan::OpType::PrefixMatch);
+            } else if constexpr (op == proto::plan::OpType::PostfixMatch) {
+                res[i] = milvus::query::Match(
+                    src[i], val, proto::plan::OpType::PostfixMatch);
             } else {
                 PanicInfo(
                     OpTypeInvalid,
@@ -130,6 +143,90 @@ struct UnaryElementFuncForArray {
     }
 };
 
+// evaluates the rows [offset, offset + size) of a json path extracted into
+// a JsonKeyColumn, with the same results as parsing the rows, the blocks
+// ruled out by the zone maps aren't read
+template <typename ValueType, proto::plan::OpType op>
+struct UnaryElementFuncForJsonKey {
+    void
+    operator()(const segcore::JsonKeyColumn& column,
+               int64_t offset,
+               size_t size,
+               const ValueType& val,
+               bool* res) {
+        constexpr auto block_rows = segcore::JsonKeyColumn::BLOCK_ROWS;
+        auto end = offset + int64_t(size);
+        for (auto begin = offset; begin < end;) {
+            auto block_id = begin / block_rows;
+            auto block_end = std::min(end, (block_id + 1) * block_rows);
+            if (column.CanSkipBlock(block_id, op, val)) {
+                std::fill(
+                    res + (begin - offset), res + (block_end - offset), false);
+            } else {
+                for (auto i = begin; i < block_end; ++i) {
+                    res[i - offset] = Eval(column, i, val);
+                }
+            }
+            begin = block_end;
+        }
+    }
+
+ private:
+    template <typename T>
+    static bool
+    Compare(const T& x, const ValueType& val) {
+        if constexpr (op == proto::plan::OpType::Equal) {
+            return x == val;
+        } else if constexpr (op == proto::plan::OpType::NotEqual) {
+            return x != val;
+        } else if constexpr (op == proto::plan::OpType::GreaterThan) {
+            return x > val;
+        } else if constexpr (op == proto::plan::OpType::LessThan) {
+            return x < val;
+        } else if constexpr (op == proto::plan::OpType::GreaterEqual) {
+            return x >= val;
+        } else if constexpr (op == proto::plan::OpType::LessEqual) {
+            return x <= val;
+        } else if constexpr (op == proto::plan::OpType::PrefixMatch) {
+            return milvus::query::Match(x, val, op);
+        } else {
+            PanicInfo(OpTypeInvalid,
+                      "unsupported op_type:{} for "
+                      "UnaryElementFuncForJsonKey",
+                      op);
+        }
+    }
+
+    // a missing value only matches NotEqual
+    static bool
+    Eval(const segcore::JsonKeyColumn& column,
+         int64_t i,
+         const ValueType& val) {
+        if constexpr (std::is_same_v<ValueType, int64_t>) {
+            if (column.Valid(i)) {
+                return Compare(column.Int64At(i), val);
+            }
+            if (column.DoubleFallbackValid(i)) {
+                return Compare(column.DoubleAt(i), val);
+            }
+        } else if constexpr (std::is_same_v<ValueType, double>) {
+            double x;
+            if (column.AsDouble(i, x)) {
+                return Compare(x, val);
+            }
+        } else if constexpr (std::is_same_v<ValueType, bool>) {
+            if (column.Valid(i)) {
+                return Compare(column.BoolAt(i), val);
+            }
+        } else {
+            if (column.Valid(i)) {
+                return Compare(column.StringAt(i), val);
+            }
+        }
+        return op == proto::plan::OpType::NotEqual;
+    }
+};
+
 template <typename T, proto::plan::OpType op>
 struct UnaryIndexFunc {
     typedef std::
@@ -156,6 +253,12 @@ struct UnaryIndexFunc {
                          proto::plan::OpType::PrefixMatch);
             dataset->Set(milvus::index::PREFIX_VALUE, val);
             return index->Query(std::move(dataset));
+        } else if constexpr (op == proto::plan::OpType::PostfixMatch ||
+                             op == proto::plan::OpType::Match) {
+            auto dataset = std::make_unique<Dataset>();
+            dataset->Set(milvus::index::OPERATOR_TYPE, op);
+            dataset->Set(milvus::index::MATCH_VALUE, val);
+            return index->Query(std::move(dataset));
         } else {
             PanicInfo(
                 OpTypeInvalid,
@@ -185,6 +288,12 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        SegmentExpr::SetRowRange(begin, end);
+        overflow_check_pos_ = begin;
+    }
+
  private:
     template <typename T>
     VectorPtr
@@ -202,10 +311,27 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplJson();
 
+    template <typename ExprValueType>
+    VectorPtr
+    ExecRangeVisitorImplJsonKeyColumn(const segcore::JsonKeyColumn& column,
+                                      int64_t real_batch_size);
+
     template <typename ExprValueType>
     VectorPtr
     ExecRangeVisitorImplArray();
 
+    // evaluate on the codes of a dictionary encoded string field, the
+    // matched strings are a range of codes as the dictionary is sorted
+    VectorPtr
+    ExecRangeVisitorImplForDictionary(const StringDictionary& dict,
+                                      int64_t real_batch_size);
+
+    // evaluate the postfix and like patterns on the distinct strings of a
+    // dictionary encoded field, then on the codes of the rows
+    VectorPtr
+    ExecRangeVisitorImplForDictionaryMatch(const StringDictionary& dict,
+                                           int64_t real_batch_size);
+
     // Check overflow and cache result for performace
     template <typename T>
     ColumnVectorPtr
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <fmt/core.h>
+#include <optional>
 
 #include "common/EasyAssert.h"
 #include "common/Types.h"
@@ -24,6 +25,7 @@
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
 #include "query/Utils.h"
+#include "simd/common.h"
 
 namespace milvus {
 namespace exec {
@@ -50,6 +52,29 @@ GetColumnVector(const VectorPtr& result) {
     return res;
 }
 
+#if defined(USE_DYNAMIC_SIMD)
+// the simd compare op of op, if any
+constexpr std::optional<simd::CompareOp>
+ToSimdCompareOp(proto::plan::OpType op) {
+    switch (op) {
+        case proto::plan::OpType::Equal:
+            return simd::CompareOp::EQ;
+        case proto::plan::OpType::NotEqual:
+            return simd::CompareOp::NE;
+        case proto::plan::OpType::GreaterThan:
+            return simd::CompareOp::GT;
+        case proto::plan::OpType::GreaterEqual:
+            return simd::CompareOp::GE;
+        case proto::plan::OpType::LessThan:
+            return simd::CompareOp::LT;
+        case proto::plan::OpType::LessEqual:
+            return simd::CompareOp::LE;
+        default:
+            return std::nullopt;
+    }
+}
+#endif
+
 template <typename T>
 bool
 CompareTwoJsonArray(T arr1, const proto::plan::Array& arr2) {
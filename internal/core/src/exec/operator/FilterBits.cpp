@@ -32,8 +32,15 @@ FilterBits::FilterBits(
     std::vector<expr::TypedExprPtr> filters;
     filters.emplace_back(filter->filter());
     exprs_ = std::make_unique<ExprSet>(filters, exec_context);
-    need_process_rows_ = query_context->get_segment()->get_active_count(
-        query_context->get_query_timestamp());
+    if (query_context->get_offset_input() != nullptr) {
+        need_process_rows_ = query_context->get_offset_input()->size();
+    } else if (query_context->get_row_range().has_value()) {
+        auto [begin, end] = query_context->get_row_range().value();
+        need_process_rows_ = end - begin;
+    } else {
+        need_process_rows_ = query_context->get_segment()->get_active_count(
+            query_context->get_query_timestamp());
+    }
     num_processed_rows_ = 0;
 }
 
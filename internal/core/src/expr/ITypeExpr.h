@@ -17,7 +17,10 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 #include <fmt/core.h>
@@ -111,9 +114,28 @@ class ITypeExpr {
         return inputs_;
     }
 
+    // the state derived from the expr alone, like the set of the values of
+    // a term expr, is built by the first segment evaluating the expr and
+    // shared by all the others, one state of each type
+    template <typename T, typename Build>
+    std::shared_ptr<const T>
+    GetPrepared(Build build) const {
+        std::lock_guard<std::mutex> lock(prepared_mutex_);
+        auto& prepared = prepared_[std::type_index(typeid(T))];
+        if (prepared == nullptr) {
+            prepared = std::make_shared<const T>(build());
+        }
+        return std::static_pointer_cast<const T>(prepared);
+    }
+
  protected:
     DataType type_;
     std::vector<std::shared_ptr<const ITypeExpr>> inputs_;
+
+ private:
+    mutable std::mutex prepared_mutex_;
+    mutable std::unordered_map<std::type_index, std::shared_ptr<const void>>
+        prepared_;
 };
 
 using TypedExprPtr = std::shared_ptr<const ITypeExpr>;
@@ -513,6 +535,39 @@ class JsonContainsExpr : public ITypeFilterExpr {
     bool same_type_;
     const std::vector<proto::plan::GenericValue> vals_;
 };
+
+template <typename ExprType>
+inline bool
+CollectColumnFieldId(const TypedExprPtr& expr,
+                     std::vector<FieldId>& field_ids) {
+    if (auto casted = std::dynamic_pointer_cast<const ExprType>(expr)) {
+        field_ids.push_back(casted->column_.field_id_);
+        return true;
+    }
+    return false;
+}
+
+// collect the ids of the fields read by the expr and its inputs, a field may
+// appear more than once
+inline void
+CollectFieldIds(const TypedExprPtr& expr, std::vector<FieldId>& field_ids) {
+    if (auto compare = std::dynamic_pointer_cast<const CompareExpr>(expr)) {
+        field_ids.push_back(compare->left_field_id_);
+        field_ids.push_back(compare->right_field_id_);
+    } else {
+        // the always true expr reads no field
+        CollectColumnFieldId<UnaryRangeFilterExpr>(expr, field_ids) ||
+            CollectColumnFieldId<BinaryRangeFilterExpr>(expr, field_ids) ||
+            CollectColumnFieldId<TermFilterExpr>(expr, field_ids) ||
+            CollectColumnFieldId<BinaryArithOpEvalRangeExpr>(expr,
+                                                             field_ids) ||
+            CollectColumnFieldId<ExistsExpr>(expr, field_ids) ||
+            CollectColumnFieldId<JsonContainsExpr>(expr, field_ids);
+    }
+    for (auto& input : expr->inputs()) {
+        CollectFieldIds(input, field_ids);
+    }
+}
 }  // namespace expr
 }  // namespace milvus
 
@@ -0,0 +1,418 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/ArrayInvertedIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <pb/schema.pb.h>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/Utils.h"
+#include "storage/Util.h"
+
+namespace milvus::index {
+
+namespace {
+
+template <typename T>
+std::string
+ElementKey(const T& value) {
+    if constexpr (std::is_same_v<T, std::string> ||
+                  std::is_same_v<T, std::string_view>) {
+        return std::string(value);
+    } else if constexpr (std::is_same_v<T, double>) {
+        // -0.0 equals to 0.0
+        double x = value == 0 ? 0 : value;
+        return std::string(reinterpret_cast<const char*>(&x), sizeof(x));
+    } else {
+        return std::string(reinterpret_cast<const char*>(&value),
+                           sizeof(value));
+    }
+}
+
+}  // namespace
+
+ArrayInvertedIndex::ArrayInvertedIndex(
+    const storage::FileManagerContext& file_manager_context) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+ArrayInvertedIndex::ArrayInvertedIndex(
+    const storage::FileManagerContext& file_manager_context,
+    std::shared_ptr<milvus_storage::Space> space)
+    : space_(std::move(space)) {
+    if (file_manager_context.Valid()) {
+        file_manager_ = std::make_shared<storage::MemFileManagerImpl>(
+            file_manager_context, space_);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+void
+ArrayInvertedIndex::AddRow(const Array& row,
+                           uint32_t offset,
+                           InvertedPostings::Builder& builder) {
+    auto element_type = row.get_element_type();
+    if (element_type != DataType::NONE) {
+        if (element_type_ == DataType::NONE) {
+            element_type_ = element_type;
+        }
+        AssertInfo(element_type_ == element_type,
+                   "array elements of different types {} and {}",
+                   element_type_,
+                   element_type);
+    }
+
+    std::vector<std::string> keys;
+    keys.reserve(row.length());
+    for (int i = 0; i < row.length(); ++i) {
+        switch (element_type) {
+            case DataType::BOOL:
+                keys.push_back(ElementKey(row.get_data<bool>(i)));
+                break;
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+                keys.push_back(ElementKey(row.get_data<int64_t>(i)));
+                break;
+            case DataType::FLOAT:
+            case DataType::DOUBLE: {
+                auto x = row.get_data<double>(i);
+                // NaN is never equal to any value
+                if (!std::isnan(x)) {
+                    keys.push_back(ElementKey(x));
+                }
+                break;
+            }
+            case DataType::STRING:
+            case DataType::VARCHAR:
+                keys.push_back(ElementKey(row.get_data<std::string_view>(i)));
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported array element type {}",
+                          element_type);
+        }
+    }
+    InvertedPostings::AddRow(builder, keys, offset);
+}
+
+void
+ArrayInvertedIndex::Build(size_t n, const Array* values) {
+    if (is_built_) {
+        return;
+    }
+    if (n == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "ArrayInvertedIndex cannot build null values!");
+    }
+    InvertedPostings::Builder builder;
+    for (size_t i = 0; i < n; ++i) {
+        AddRow(values[i], i, builder);
+    }
+    postings_.Build(n, builder);
+    is_built_ = true;
+}
+
+void
+ArrayInvertedIndex::BuildWithRawData(size_t n,
+                                     const void* values,
+                                     const Config& config) {
+    proto::schema::ArrayArray arr;
+    auto ok = arr.ParseFromArray(values, n);
+    Assert(ok);
+
+    std::vector<Array> arrays;
+    arrays.reserve(arr.data_size());
+    for (auto& data : arr.data()) {
+        arrays.emplace_back(data);
+    }
+    Build(arrays.size(), arrays.data());
+}
+
+void
+ArrayInvertedIndex::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+
+    int64_t total_num_rows = 0;
+    InvertedPostings::Builder builder;
+    for (auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        for (int64_t i = 0; i < slice_num; ++i) {
+            auto value = reinterpret_cast<const Array*>(data->RawValue(i));
+            AddRow(*value, total_num_rows++, builder);
+        }
+    }
+    if (total_num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "ArrayInvertedIndex cannot build null values!");
+    }
+    postings_.Build(total_num_rows, builder);
+    is_built_ = true;
+}
+
+void
+ArrayInvertedIndex::BuildV2(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto field_name = file_manager_->GetIndexMeta().field_name;
+    auto res = space_->ScanData();
+    if (!res.ok()) {
+        PanicInfo(S3Error, "failed to create scan iterator");
+    }
+    auto reader = res.value();
+    int64_t total_num_rows = 0;
+    InvertedPostings::Builder builder;
+    for (auto rec = reader->Next(); rec != nullptr; rec = reader->Next()) {
+        if (!rec.ok()) {
+            PanicInfo(DataFormatBroken, "failed to read data");
+        }
+        auto data = rec.ValueUnsafe();
+        auto num_rows = data->num_rows();
+        auto col_data = data->GetColumnByName(field_name);
+        auto field_data =
+            storage::CreateFieldData(DataType::ARRAY, 0, num_rows);
+        field_data->FillFieldData(col_data);
+        for (int64_t i = 0; i < field_data->get_num_rows(); ++i) {
+            auto value =
+                reinterpret_cast<const Array*>(field_data->RawValue(i));
+            AddRow(*value, total_num_rows++, builder);
+        }
+    }
+    if (total_num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "ArrayInvertedIndex cannot build null values!");
+    }
+    postings_.Build(total_num_rows, builder);
+    is_built_ = true;
+}
+
+BinarySet
+ArrayInvertedIndex::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    BinarySet res_set;
+    std::shared_ptr<uint8_t[]> element_type(new uint8_t[sizeof(DataType)]);
+    memcpy(element_type.get(), &element_type_, sizeof(DataType));
+    res_set.Append("array_index_element_type", element_type, sizeof(DataType));
+    postings_.Serialize(res_set, "array_index");
+
+    milvus::Disassemble(res_set);
+
+    return res_set;
+}
+
+BinarySet
+ArrayInvertedIndex::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+BinarySet
+ArrayInvertedIndex::UploadV2(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFileV2(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+void
+ArrayInvertedIndex::LoadWithoutAssemble(const BinarySet& binary_set,
+                                        const Config& config) {
+    auto element_type = binary_set.GetByName("array_index_element_type");
+    AssertInfo(
+        element_type != nullptr && element_type->size == sizeof(DataType),
+        "invalid array index binary");
+    memcpy(&element_type_, element_type->data.get(), sizeof(DataType));
+    postings_.Load(binary_set, "array_index");
+    is_built_ = true;
+}
+
+void
+ArrayInvertedIndex::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+void
+ArrayInvertedIndex::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load array index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+void
+ArrayInvertedIndex::LoadV2(const Config& config) {
+    auto blobs = space_->StatisticsBlobs();
+    std::vector<std::string> index_files;
+    auto prefix = file_manager_->GetRemoteIndexObjectPrefixV2();
+    for (auto& b : blobs) {
+        if (b.name.rfind(prefix, 0) == 0) {
+            index_files.push_back(b.name);
+        }
+    }
+    std::map<std::string, FieldDataPtr> index_datas{};
+    for (auto& file_name : index_files) {
+        auto res = space_->GetBlobByteSize(file_name);
+        if (!res.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto index_blob_data =
+            std::shared_ptr<uint8_t[]>(new uint8_t[res.value()]);
+        auto status = space_->ReadBlob(file_name, index_blob_data.get());
+        if (!status.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto raw_index_blob =
+            storage::DeserializeFileData(index_blob_data, res.value());
+        auto key = file_name.substr(file_name.find_last_of('/') + 1);
+        index_datas[key] = raw_index_blob->GetFieldData();
+    }
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+template <typename T>
+bool
+ArrayInvertedIndex::Serves() const {
+    switch (element_type_) {
+        case DataType::NONE:
+            // no element at all
+            return true;
+        case DataType::BOOL:
+            return std::is_same_v<T, bool>;
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+        case DataType::INT64:
+            return std::is_same_v<T, int64_t>;
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+            return std::is_same_v<T, double>;
+        case DataType::STRING:
+        case DataType::VARCHAR:
+            return std::is_same_v<T, std::string>;
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+std::optional<TargetBitmap>
+ArrayInvertedIndex::ContainsAny(const std::vector<T>& values) const {
+    AssertInfo(is_built_, "index has not been built");
+    if (!Serves<T>()) {
+        return std::nullopt;
+    }
+    TargetBitmap res(postings_.num_rows());
+    for (auto& value : values) {
+        postings_.Match(ElementKey(value), res);
+    }
+    return res;
+}
+
+template <typename T>
+std::optional<TargetBitmap>
+ArrayInvertedIndex::ContainsAll(const std::vector<T>& values) const {
+    AssertInfo(is_built_, "index has not been built");
+    if (!Serves<T>()) {
+        return std::nullopt;
+    }
+    auto num_rows = postings_.num_rows();
+    TargetBitmap res(num_rows, true);
+    TargetBitmap matched(num_rows);
+    for (auto& value : values) {
+        std::fill(matched.begin(), matched.end(), false);
+        postings_.Match(ElementKey(value), matched);
+        for (int64_t i = 0; i < num_rows; ++i) {
+            res[i] = res[i] && matched[i];
+        }
+    }
+    return res;
+}
+
+#define INSTANTIATE_ARRAY_INDEX_LOOKUPS(T)                               \
+    template std::optional<TargetBitmap>                                 \
+    ArrayInvertedIndex::ContainsAny<T>(const std::vector<T>&) const;     \
+    template std::optional<TargetBitmap>                                 \
+    ArrayInvertedIndex::ContainsAll<T>(const std::vector<T>&) const;
+
+INSTANTIATE_ARRAY_INDEX_LOOKUPS(bool)
+INSTANTIATE_ARRAY_INDEX_LOOKUPS(int64_t)
+INSTANTIATE_ARRAY_INDEX_LOOKUPS(double)
+INSTANTIATE_ARRAY_INDEX_LOOKUPS(std::string)
+
+#undef INSTANTIATE_ARRAY_INDEX_LOOKUPS
+
+}  // namespace milvus::index
@@ -0,0 +1,144 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/Array.h"
+#include "common/Types.h"
+#include "index/Index.h"
+#include "index/InvertedPostings.h"
+#include "storage/MemFileManagerImpl.h"
+#include "storage/space.h"
+
+namespace milvus::index {
+
+// ArrayInvertedIndex maps every element value of the rows of an ARRAY field
+// to the sorted offsets of the rows holding it, so that array_contains_any
+// and array_contains_all are the union and the intersection of the postings.
+//
+// The lookups give the same results as evaluating the filters on the rows,
+// std::nullopt means the index can't tell and the rows must be scanned.
+class ArrayInvertedIndex : public IndexBase {
+ public:
+    explicit ArrayInvertedIndex(
+        const storage::FileManagerContext& file_manager_context =
+            storage::FileManagerContext());
+
+    explicit ArrayInvertedIndex(
+        const storage::FileManagerContext& file_manager_context,
+        std::shared_ptr<milvus_storage::Space> space);
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override;
+
+    void
+    BuildWithRawData(size_t n,
+                     const void* values,
+                     const Config& config = {}) override;
+
+    void
+    BuildWithDataset(const DatasetPtr& dataset,
+                     const Config& config = {}) override {
+        PanicInfo(Unsupported,
+                  "array index don't support build index with dataset");
+    };
+
+    void
+    Build(size_t n, const Array* values);
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override;
+
+    int64_t
+    Count() override {
+        return postings_.num_rows();
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override;
+
+    const bool
+    HasRawData() const override {
+        return false;
+    }
+
+ public:
+    // the rows whose array contains any of the values
+    template <typename T>
+    std::optional<TargetBitmap>
+    ContainsAny(const std::vector<T>& values) const;
+
+    // the rows whose array contains all of the values
+    template <typename T>
+    std::optional<TargetBitmap>
+    ContainsAll(const std::vector<T>& values) const;
+
+    int64_t
+    ByteSize() const override {
+        return postings_.ByteSize();
+    }
+
+ private:
+    void
+    AddRow(const Array& row,
+           uint32_t offset,
+           InvertedPostings::Builder& builder);
+
+    void
+    LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
+
+    // whether the elements compare the same with a value of type T as the
+    // values of their own type
+    template <typename T>
+    bool
+    Serves() const;
+
+ private:
+    bool is_built_ = false;
+    // the type of the elements of the arrays, NONE if all arrays are empty
+    DataType element_type_ = DataType::NONE;
+    // the keys are the bytes of the element values, the integers are widened
+    // to int64 and the floats to double
+    InvertedPostings postings_;
+
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+    std::shared_ptr<milvus_storage::Space> space_;
+};
+
+using ArrayInvertedIndexPtr = std::unique_ptr<ArrayInvertedIndex>;
+
+}  // namespace milvus::index
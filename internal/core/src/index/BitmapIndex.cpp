@@ -0,0 +1,670 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/BitmapIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/Utils.h"
+#include "storage/Util.h"
+
+namespace milvus::index {
+
+namespace {
+
+// the value id of the rows held by no value
+constexpr uint32_t NO_VALUE_ID = std::numeric_limits<uint32_t>::max();
+
+void
+AppendBinary(BinarySet& binary_set,
+             const std::string& name,
+             const void* data,
+             size_t byte_size) {
+    std::shared_ptr<uint8_t[]> buf(new uint8_t[byte_size]);
+    if (byte_size > 0) {
+        memcpy(buf.get(), data, byte_size);
+    }
+    binary_set.Append(name, buf, byte_size);
+}
+
+BinaryPtr
+GetBinary(const BinarySet& binary_set, const std::string& name) {
+    auto binary = binary_set.GetByName(name);
+    AssertInfo(binary != nullptr, "index binary {} not found", name);
+    return binary;
+}
+
+template <typename T>
+void
+ReadBinary(const BinarySet& binary_set,
+           const std::string& name,
+           std::vector<T>& data) {
+    auto binary = GetBinary(binary_set, name);
+    AssertInfo(binary->size % sizeof(T) == 0,
+               "invalid size {} of index binary {}",
+               binary->size,
+               name);
+    data.resize(binary->size / sizeof(T));
+    if (binary->size > 0) {
+        memcpy(data.data(), binary->data.get(), binary->size);
+    }
+}
+
+template <typename T>
+bool
+IsNaN(const T& value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::isnan(value);
+    } else {
+        return false;
+    }
+}
+
+}  // namespace
+
+template <typename T>
+BitmapIndex<T>::BitmapIndex(
+    const storage::FileManagerContext& file_manager_context) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+template <typename T>
+BitmapIndex<T>::BitmapIndex(
+    const storage::FileManagerContext& file_manager_context,
+    std::shared_ptr<milvus_storage::Space> space)
+    : space_(std::move(space)) {
+    if (file_manager_context.Valid()) {
+        file_manager_ = std::make_shared<storage::MemFileManagerImpl>(
+            file_manager_context, space_);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildValueIds() {
+    value_ids_.assign(num_rows_, NO_VALUE_ID);
+    for (size_t i = 0; i < postings_.size(); ++i) {
+        auto& posting = postings_[i];
+        if (posting.dense_) {
+            for (auto offset = posting.bitmap_.find_first();
+                 offset != BitsetType::npos;
+                 offset = posting.bitmap_.find_next(offset)) {
+                value_ids_[offset] = i;
+            }
+        } else {
+            for (auto offset : posting.offsets_) {
+                value_ids_[offset] = i;
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildPostings(int64_t num_rows,
+                              const std::map<T, std::vector<uint32_t>>& rows) {
+    if (num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "BitmapIndex cannot build null values!");
+    }
+    num_rows_ = num_rows;
+    values_.clear();
+    values_.reserve(rows.size());
+    postings_.clear();
+    postings_.reserve(rows.size());
+    for (auto& [value, offsets] : rows) {
+        values_.push_back(value);
+        auto& posting = postings_.emplace_back();
+        // a bitmap takes num_rows / 8 bytes and the offsets 4 bytes per row
+        posting.dense_ = offsets.size() * 32 > num_rows;
+        if (posting.dense_) {
+            posting.bitmap_.resize(num_rows);
+            for (auto offset : offsets) {
+                posting.bitmap_.set(offset);
+            }
+        } else {
+            posting.offsets_ = offsets;
+        }
+    }
+    BuildValueIds();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Build(size_t n, const T* values) {
+    if (is_built_) {
+        return;
+    }
+    std::map<T, std::vector<uint32_t>> rows;
+    for (size_t i = 0; i < n; ++i) {
+        if (!IsNaN(values[i])) {
+            rows[values[i]].push_back(i);
+        }
+    }
+    BuildPostings(n, rows);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildWithFieldDatas(
+    const std::vector<FieldDataPtr>& field_datas) {
+    std::map<T, std::vector<uint32_t>> rows;
+    int64_t offset = 0;
+    for (auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        for (int64_t i = 0; i < slice_num; ++i, ++offset) {
+            auto value = reinterpret_cast<const T*>(data->RawValue(i));
+            if (!IsNaN(*value)) {
+                rows[*value].push_back(offset);
+            }
+        }
+    }
+    BuildPostings(offset, rows);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+    BuildWithFieldDatas(field_datas);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildV2(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto field_name = file_manager_->GetIndexMeta().field_name;
+    auto res = space_->ScanData();
+    if (!res.ok()) {
+        PanicInfo(S3Error, "failed to create scan iterator");
+    }
+    auto reader = res.value();
+    std::vector<FieldDataPtr> field_datas;
+    for (auto rec = reader->Next(); rec != nullptr; rec = reader->Next()) {
+        if (!rec.ok()) {
+            PanicInfo(DataFormatBroken, "failed to read data");
+        }
+        auto data = rec.ValueUnsafe();
+        auto total_num_rows = data->num_rows();
+        auto col_data = data->GetColumnByName(field_name);
+        auto field_data = storage::CreateFieldData(
+            DataType(GetDType<T>()), 0, total_num_rows);
+        field_data->FillFieldData(col_data);
+        field_datas.push_back(field_data);
+    }
+    BuildWithFieldDatas(field_datas);
+}
+
+template <typename T>
+BinarySet
+BitmapIndex<T>::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    BinarySet res_set;
+    AppendBinary(
+        res_set, "bitmap_index_num_rows", &num_rows_, sizeof(num_rows_));
+
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::string values;
+        std::vector<uint64_t> value_offsets{0};
+        for (auto& value : values_) {
+            values.append(value);
+            value_offsets.push_back(values.size());
+        }
+        AppendBinary(
+            res_set, "bitmap_index_values", values.data(), values.size());
+        AppendBinary(res_set,
+                     "bitmap_index_value_offsets",
+                     value_offsets.data(),
+                     value_offsets.size() * sizeof(uint64_t));
+    } else {
+        // std::vector<bool> has no data()
+        std::vector<uint8_t> values(values_.size() * sizeof(T));
+        for (size_t i = 0; i < values_.size(); ++i) {
+            T value = values_[i];
+            memcpy(values.data() + i * sizeof(T), &value, sizeof(T));
+        }
+        AppendBinary(
+            res_set, "bitmap_index_values", values.data(), values.size());
+    }
+
+    // the dense postings are the words of the bitmaps, the others the offsets
+    std::vector<uint8_t> dense;
+    std::vector<uint64_t> posting_offsets{0};
+    std::vector<uint8_t> postings;
+    for (auto& posting : postings_) {
+        dense.push_back(posting.dense_);
+        auto size = postings.size();
+        if (posting.dense_) {
+            // the postings are not aligned to the blocks
+            std::vector<BitsetType::block_type> blocks(
+                posting.bitmap_.num_blocks());
+            boost::to_block_range(posting.bitmap_, blocks.begin());
+            auto byte_size = blocks.size() * sizeof(BitsetType::block_type);
+            postings.resize(size + byte_size);
+            memcpy(postings.data() + size, blocks.data(), byte_size);
+        } else {
+            auto byte_size = posting.offsets_.size() * sizeof(uint32_t);
+            postings.resize(size + byte_size);
+            memcpy(postings.data() + size, posting.offsets_.data(), byte_size);
+        }
+        posting_offsets.push_back(postings.size());
+    }
+    AppendBinary(res_set, "bitmap_index_dense", dense.data(), dense.size());
+    AppendBinary(res_set,
+                 "bitmap_index_posting_offsets",
+                 posting_offsets.data(),
+                 posting_offsets.size() * sizeof(uint64_t));
+    AppendBinary(
+        res_set, "bitmap_index_postings", postings.data(), postings.size());
+
+    milvus::Disassemble(res_set);
+
+    return res_set;
+}
+
+template <typename T>
+BinarySet
+BitmapIndex<T>::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+template <typename T>
+BinarySet
+BitmapIndex<T>::UploadV2(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFileV2(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::LoadWithoutAssemble(const BinarySet& binary_set,
+                                    const Config& config) {
+    std::vector<int64_t> num_rows;
+    ReadBinary(binary_set, "bitmap_index_num_rows", num_rows);
+    AssertInfo(num_rows.size() == 1, "invalid bitmap index binary");
+    num_rows_ = num_rows[0];
+
+    auto values = GetBinary(binary_set, "bitmap_index_values");
+    auto values_data = reinterpret_cast<const char*>(values->data.get());
+    values_.clear();
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::vector<uint64_t> value_offsets;
+        ReadBinary(binary_set, "bitmap_index_value_offsets", value_offsets);
+        AssertInfo(!value_offsets.empty() &&
+                       value_offsets.back() == values->size,
+                   "invalid bitmap index binary");
+        for (size_t i = 0; i + 1 < value_offsets.size(); ++i) {
+            values_.emplace_back(values_data + value_offsets[i],
+                                 value_offsets[i + 1] - value_offsets[i]);
+        }
+    } else {
+        AssertInfo(values->size % sizeof(T) == 0,
+                   "invalid bitmap index binary");
+        for (size_t i = 0; i < values->size / sizeof(T); ++i) {
+            T value;
+            memcpy(&value, values_data + i * sizeof(T), sizeof(T));
+            values_.push_back(value);
+        }
+    }
+
+    std::vector<uint8_t> dense;
+    std::vector<uint64_t> posting_offsets;
+    ReadBinary(binary_set, "bitmap_index_dense", dense);
+    ReadBinary(binary_set, "bitmap_index_posting_offsets", posting_offsets);
+    auto postings = GetBinary(binary_set, "bitmap_index_postings");
+    AssertInfo(dense.size() == values_.size() &&
+                   posting_offsets.size() == values_.size() + 1 &&
+                   posting_offsets.back() == postings->size,
+               "invalid bitmap index binary");
+
+    postings_.clear();
+    postings_.resize(values_.size());
+    for (size_t i = 0; i < values_.size(); ++i) {
+        auto& posting = postings_[i];
+        auto data = postings->data.get() + posting_offsets[i];
+        auto byte_size = posting_offsets[i + 1] - posting_offsets[i];
+        posting.dense_ = dense[i];
+        if (posting.dense_) {
+            posting.bitmap_.resize(num_rows_);
+            std::vector<BitsetType::block_type> blocks(
+                posting.bitmap_.num_blocks());
+            AssertInfo(
+                byte_size == blocks.size() * sizeof(BitsetType::block_type),
+                "invalid bitmap index binary");
+            memcpy(blocks.data(), data, byte_size);
+            boost::from_block_range(
+                blocks.begin(), blocks.end(), posting.bitmap_);
+        } else {
+            AssertInfo(byte_size % sizeof(uint32_t) == 0,
+                       "invalid bitmap index binary");
+            posting.offsets_.resize(byte_size / sizeof(uint32_t));
+            memcpy(posting.offsets_.data(), data, byte_size);
+        }
+    }
+    BuildValueIds();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load bitmap index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::LoadV2(const Config& config) {
+    auto blobs = space_->StatisticsBlobs();
+    std::vector<std::string> index_files;
+    auto prefix = file_manager_->GetRemoteIndexObjectPrefixV2();
+    for (auto& b : blobs) {
+        if (b.name.rfind(prefix, 0) == 0) {
+            index_files.push_back(b.name);
+        }
+    }
+    std::map<std::string, FieldDataPtr> index_datas{};
+    for (auto& file_name : index_files) {
+        auto res = space_->GetBlobByteSize(file_name);
+        if (!res.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto index_blob_data =
+            std::shared_ptr<uint8_t[]>(new uint8_t[res.value()]);
+        auto status = space_->ReadBlob(file_name, index_blob_data.get());
+        if (!status.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto raw_index_blob =
+            storage::DeserializeFileData(index_blob_data, res.value());
+        auto key = file_name.substr(file_name.find_last_of('/') + 1);
+        index_datas[key] = raw_index_blob->GetFieldData();
+    }
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Or(const Posting& posting, BitsetType& rows) {
+    if (posting.dense_) {
+        rows |= posting.bitmap_;
+    } else {
+        for (auto offset : posting.offsets_) {
+            rows.set(offset);
+        }
+    }
+}
+
+template <typename T>
+TargetBitmap
+BitmapIndex<T>::ToTargetBitmap(const BitsetType& rows) {
+    TargetBitmap bitset(rows.size());
+    std::vector<BitsetType::block_type> blocks(rows.num_blocks());
+    boost::to_block_range(rows, blocks.begin());
+    // unpack a block at a time and skip the empty ones
+    auto out = bitset.data();
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        auto block = blocks[b];
+        if (block == 0) {
+            continue;
+        }
+        auto begin = b * BitsetType::bits_per_block;
+        auto end = std::min(begin + BitsetType::bits_per_block, rows.size());
+        for (auto i = begin; i < end; ++i) {
+            out[i] = (block >> (i - begin)) & 1;
+        }
+    }
+    return bitset;
+}
+
+template <typename T>
+BitsetType
+BitmapIndex<T>::InRows(size_t n, const T* values) const {
+    AssertInfo(is_built_, "index has not been built");
+    BitsetType rows(num_rows_);
+    for (size_t i = 0; i < n; ++i) {
+        if (IsNaN(values[i])) {
+            continue;
+        }
+        auto it = std::lower_bound(values_.begin(), values_.end(), values[i]);
+        if (it != values_.end() && *it == values[i]) {
+            Or(postings_[it - values_.begin()], rows);
+        }
+    }
+    return rows;
+}
+
+template <typename T>
+TargetBitmap
+BitmapIndex<T>::RangeRows(size_t begin, size_t end) const {
+    BitsetType rows(num_rows_);
+    for (auto i = begin; i < end; ++i) {
+        Or(postings_[i], rows);
+    }
+    return ToTargetBitmap(rows);
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::In(size_t n, const T* values) {
+    return ToTargetBitmap(InRows(n, values));
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::NotIn(size_t n, const T* values) {
+    auto rows = InRows(n, values);
+    rows.flip();
+    return ToTargetBitmap(rows);
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::Range(T value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    if (IsNaN(value)) {
+        return TargetBitmap(num_rows_);
+    }
+    auto lb = values_.begin();
+    auto ub = values_.end();
+    switch (op) {
+        case OpType::LessThan:
+            ub = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::LessEqual:
+            ub = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::GreaterThan:
+            lb = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::GreaterEqual:
+            lb = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        default:
+            throw SegcoreError(OpTypeInvalid,
+                               fmt::format("Invalid OperatorType: {}", op));
+    }
+    return RangeRows(lb - values_.begin(), ub - values_.begin());
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::Range(T lower_bound_value,
+                      bool lb_inclusive,
+                      T upper_bound_value,
+                      bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    if (IsNaN(lower_bound_value) || IsNaN(upper_bound_value) ||
+        lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value &&
+         !(lb_inclusive && ub_inclusive))) {
+        return TargetBitmap(num_rows_);
+    }
+    auto lb = lb_inclusive ? std::lower_bound(values_.begin(),
+                                              values_.end(),
+                                              lower_bound_value)
+                           : std::upper_bound(values_.begin(),
+                                              values_.end(),
+                                              lower_bound_value);
+    auto ub = ub_inclusive ? std::upper_bound(values_.begin(),
+                                              values_.end(),
+                                              upper_bound_value)
+                           : std::lower_bound(values_.begin(),
+                                              values_.end(),
+                                              upper_bound_value);
+    return RangeRows(lb - values_.begin(), ub - values_.begin());
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::PrefixMatch(const std::string_view prefix) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        AssertInfo(is_built_, "index has not been built");
+        auto begin = std::lower_bound(
+            values_.begin(), values_.end(), std::string(prefix));
+        auto end = begin;
+        while (end != values_.end() &&
+               end->compare(0, prefix.size(), prefix) == 0) {
+            ++end;
+        }
+        return RangeRows(begin - values_.begin(), end - values_.begin());
+    } else {
+        PanicInfo(OpTypeInvalid,
+                  "prefix match is only supported on string bitmap index");
+    }
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::PatternMatch(const LikePattern& pattern) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        AssertInfo(is_built_, "index has not been built");
+        auto& prefix = pattern.prefix();
+        BitsetType rows(num_rows_);
+        for (auto it = std::lower_bound(values_.begin(), values_.end(), prefix);
+             it != values_.end() && it->compare(0, prefix.size(), prefix) == 0;
+             ++it) {
+            if (pattern.Match(*it)) {
+                Or(postings_[it - values_.begin()], rows);
+            }
+        }
+        return ToTargetBitmap(rows);
+    } else {
+        PanicInfo(OpTypeInvalid,
+                  "pattern match is only supported on string bitmap index");
+    }
+}
+
+template <typename T>
+T
+BitmapIndex<T>::Reverse_Lookup(size_t offset) const {
+    AssertInfo(is_built_, "index has not been built");
+    AssertInfo(offset < num_rows_, "out of range of total count");
+    auto value_id = value_ids_[offset];
+    if (value_id != NO_VALUE_ID) {
+        return values_[value_id];
+    }
+    // the rows of NaN are held by no value
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::numeric_limits<T>::quiet_NaN();
+    } else {
+        PanicInfo(UnexpectedError, "row {} is held by no value", offset);
+    }
+}
+
+template class BitmapIndex<bool>;
+template class BitmapIndex<int8_t>;
+template class BitmapIndex<int16_t>;
+template class BitmapIndex<int32_t>;
+template class BitmapIndex<int64_t>;
+template class BitmapIndex<float>;
+template class BitmapIndex<double>;
+template class BitmapIndex<std::string>;
+
+}  // namespace milvus::index
@@ -0,0 +1,221 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "index/ScalarIndex.h"
+#include "index/StringIndex.h"
+#include "storage/MemFileManagerImpl.h"
+#include "storage/space.h"
+
+namespace milvus::index {
+
+template <typename T>
+using BitmapIndexBase = std::conditional_t<std::is_same_v<T, std::string>,
+                                           StringIndex,
+                                           ScalarIndex<T>>;
+
+// BitmapIndex maps every distinct value of a scalar field to the rows holding
+// it, so `in`, `not in` and `==` are the unions of the rows of the values
+// instead of scattering the offsets of every matched row like
+// ScalarIndexSort, which pays off on low cardinality fields.
+//
+// The rows of a value are kept as a bitmap if they take more space as sorted
+// offsets, NaN is held by no value.
+template <typename T>
+class BitmapIndex : public BitmapIndexBase<T> {
+ public:
+    explicit BitmapIndex(
+        const storage::FileManagerContext& file_manager_context =
+            storage::FileManagerContext());
+
+    explicit BitmapIndex(
+        const storage::FileManagerContext& file_manager_context,
+        std::shared_ptr<milvus_storage::Space> space);
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override;
+
+    int64_t
+    Count() override {
+        return num_rows_;
+    }
+
+    void
+    Build(size_t n, const T* values) override;
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override;
+
+    const TargetBitmap
+    In(size_t n, const T* values) override;
+
+    const TargetBitmap
+    NotIn(size_t n, const T* values) override;
+
+    const TargetBitmap
+    Range(T value, OpType op) override;
+
+    const TargetBitmap
+    Range(T lower_bound_value,
+          bool lb_inclusive,
+          T upper_bound_value,
+          bool ub_inclusive) override;
+
+    // only supported by the string values, overrides StringIndex::PrefixMatch
+    const TargetBitmap
+    PrefixMatch(const std::string_view prefix);
+
+    // only supported by the string values, overrides
+    // StringIndex::PatternMatch
+    const TargetBitmap
+    PatternMatch(const LikePattern& pattern);
+
+    T
+    Reverse_Lookup(size_t offset) const override;
+
+    int64_t
+    Size() override {
+        return num_rows_;
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override;
+
+    const bool
+    HasRawData() const override {
+        return true;
+    }
+
+    int64_t
+    ByteSize() const override {
+        int64_t size = values_.capacity() * sizeof(T) +
+                       postings_.capacity() * sizeof(Posting) +
+                       value_ids_.capacity() * sizeof(uint32_t);
+        for (auto& posting : postings_) {
+            size += posting.bitmap_.num_blocks() *
+                        sizeof(BitsetType::block_type) +
+                    posting.offsets_.capacity() * sizeof(uint32_t);
+        }
+        if constexpr (std::is_same_v<T, std::string>) {
+            for (auto& value : values_) {
+                size += StringHeapByteSize(value);
+            }
+        }
+        return size;
+    }
+
+ public:
+    // the number of distinct values
+    int64_t
+    Cardinality() const {
+        return values_.size();
+    }
+
+ private:
+    // the rows of a value
+    struct Posting {
+        // the rows are in bitmap_ if dense_, else in offsets_
+        bool dense_ = false;
+        BitsetType bitmap_;
+        std::vector<uint32_t> offsets_;
+    };
+
+    void
+    BuildWithFieldDatas(const std::vector<FieldDataPtr>& field_datas);
+
+    // the rows of every value, NaN excluded
+    void
+    BuildPostings(int64_t num_rows,
+                  const std::map<T, std::vector<uint32_t>>& rows);
+
+    // the value of every row, from the postings
+    void
+    BuildValueIds();
+
+    void
+    LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
+
+    // the rows holding any of the values
+    BitsetType
+    InRows(size_t n, const T* values) const;
+
+    // the rows holding the values in [begin, end) of values_
+    TargetBitmap
+    RangeRows(size_t begin, size_t end) const;
+
+    static void
+    Or(const Posting& posting, BitsetType& rows);
+
+    static TargetBitmap
+    ToTargetBitmap(const BitsetType& rows);
+
+ private:
+    bool is_built_ = false;
+    int64_t num_rows_ = 0;
+    // the values in ascending order and their rows
+    std::vector<T> values_;
+    std::vector<Posting> postings_;
+    // the index into values_ of every row, NO_VALUE_ID for NaN
+    std::vector<uint32_t> value_ids_;
+
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+    std::shared_ptr<milvus_storage::Space> space_;
+};
+
+template <typename T>
+using BitmapIndexPtr = std::unique_ptr<BitmapIndex<T>>;
+
+template <typename T>
+inline BitmapIndexPtr<T>
+CreateBitmapIndex(const storage::FileManagerContext& file_manager_context =
+                      storage::FileManagerContext()) {
+    return std::make_unique<BitmapIndex<T>>(file_manager_context);
+}
+
+template <typename T>
+inline BitmapIndexPtr<T>
+CreateBitmapIndex(const storage::FileManagerContext& file_manager_context,
+                  std::shared_ptr<milvus_storage::Space> space) {
+    return std::make_unique<BitmapIndex<T>>(file_manager_context, space);
+}
+
+}  // namespace milvus::index
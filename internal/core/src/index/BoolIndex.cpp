@@ -0,0 +1,407 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/BoolIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/IndexStructure.h"
+#include "index/Utils.h"
+#include "simd/hook.h"
+#include "storage/Util.h"
+
+namespace milvus::index {
+
+BoolIndex::BoolIndex(const storage::FileManagerContext& file_manager_context) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+BoolIndex::BoolIndex(const storage::FileManagerContext& file_manager_context,
+                     std::shared_ptr<milvus_storage::Space> space)
+    : space_(std::move(space)) {
+    if (file_manager_context.Valid()) {
+        file_manager_ = std::make_shared<storage::MemFileManagerImpl>(
+            file_manager_context, space_);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+void
+BoolIndex::BuildWithValues(int64_t num_rows, const bool* values) {
+    if (num_rows == 0) {
+        throw SegcoreError(DataIsEmpty, "BoolIndex cannot build null values!");
+    }
+    num_rows_ = num_rows;
+    true_blocks_.assign((num_rows + BLOCK_BITS - 1) / BLOCK_BITS, 0);
+    int64_t i = 0;
+#if defined(USE_DYNAMIC_SIMD)
+    for (; i + BLOCK_BITS <= num_rows; i += BLOCK_BITS) {
+        true_blocks_[i / BLOCK_BITS] =
+            milvus::simd::get_bitset_block(values + i);
+    }
+#endif
+    for (; i < num_rows; ++i) {
+        true_blocks_[i / BLOCK_BITS] |= BlockType(values[i])
+                                        << (i % BLOCK_BITS);
+    }
+    is_built_ = true;
+}
+
+void
+BoolIndex::Build(size_t n, const bool* values) {
+    if (is_built_) {
+        return;
+    }
+    BuildWithValues(n, values);
+}
+
+void
+BoolIndex::BuildWithFieldDatas(const std::vector<FieldDataPtr>& field_datas) {
+    int64_t num_rows = 0;
+    for (auto& data : field_datas) {
+        num_rows += data->get_num_rows();
+    }
+    // the field datas are not contiguous
+    std::vector<uint8_t> values(num_rows);
+    int64_t offset = 0;
+    for (auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        if (slice_num > 0) {
+            memcpy(values.data() + offset, data->Data(), slice_num);
+        }
+        offset += slice_num;
+    }
+    BuildWithValues(num_rows, reinterpret_cast<const bool*>(values.data()));
+}
+
+void
+BoolIndex::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+    BuildWithFieldDatas(field_datas);
+}
+
+void
+BoolIndex::BuildV2(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto field_name = file_manager_->GetIndexMeta().field_name;
+    auto res = space_->ScanData();
+    if (!res.ok()) {
+        PanicInfo(S3Error, "failed to create scan iterator");
+    }
+    auto reader = res.value();
+    std::vector<FieldDataPtr> field_datas;
+    for (auto rec = reader->Next(); rec != nullptr; rec = reader->Next()) {
+        if (!rec.ok()) {
+            PanicInfo(DataFormatBroken, "failed to read data");
+        }
+        auto data = rec.ValueUnsafe();
+        auto total_num_rows = data->num_rows();
+        auto col_data = data->GetColumnByName(field_name);
+        auto field_data =
+            storage::CreateFieldData(DataType::BOOL, 0, total_num_rows);
+        field_data->FillFieldData(col_data);
+        field_datas.push_back(field_data);
+    }
+    BuildWithFieldDatas(field_datas);
+}
+
+BinarySet
+BoolIndex::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    BinarySet res_set;
+    auto append = [&](const std::string& name, const void* data, size_t size) {
+        std::shared_ptr<uint8_t[]> buf(new uint8_t[size]);
+        if (size > 0) {
+            memcpy(buf.get(), data, size);
+        }
+        res_set.Append(name, buf, size);
+    };
+    // the same length as the sort index
+    size_t index_size = num_rows_;
+    append("index_length", &index_size, sizeof(size_t));
+    append("bool_index_true_blocks",
+           true_blocks_.data(),
+           true_blocks_.size() * sizeof(BlockType));
+
+    milvus::Disassemble(res_set);
+
+    return res_set;
+}
+
+BinarySet
+BoolIndex::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+BinarySet
+BoolIndex::UploadV2(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFileV2(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+void
+BoolIndex::LoadWithoutAssemble(const BinarySet& index_binary,
+                               const Config& config) {
+    size_t index_size;
+    auto index_length = index_binary.GetByName("index_length");
+    AssertInfo(index_length != nullptr &&
+                   index_length->size == sizeof(size_t),
+               "invalid bool index binary");
+    memcpy(&index_size, index_length->data.get(), sizeof(size_t));
+
+    auto get_binary = [&](const std::string& name, size_t size) {
+        auto binary = index_binary.GetByName(name);
+        AssertInfo(binary != nullptr && binary->size == size,
+                   "invalid bool index binary {}",
+                   name);
+        return binary->data.get();
+    };
+    auto num_blocks = (index_size + BLOCK_BITS - 1) / BLOCK_BITS;
+    if (index_binary.GetByName("bool_index_true_blocks") != nullptr) {
+        num_rows_ = index_size;
+        true_blocks_.resize(num_blocks);
+        memcpy(true_blocks_.data(),
+               get_binary("bool_index_true_blocks",
+                          num_blocks * sizeof(BlockType)),
+               num_blocks * sizeof(BlockType));
+        is_built_ = true;
+        return;
+    }
+
+    // the sort index, the values of the rows at the offsets
+    std::vector<uint8_t> values(index_size);
+    if (index_binary.GetByName("index_data") != nullptr) {
+        auto size = index_size * sizeof(IndexStructure<bool>);
+        auto structures = reinterpret_cast<const IndexStructure<bool>*>(
+            get_binary("index_data", size));
+        for (size_t i = 0; i < index_size; ++i) {
+            IndexStructure<bool> structure;
+            memcpy(&structure, structures + i, sizeof(structure));
+            AssertInfo(structure.idx_ >= 0 &&
+                           static_cast<size_t>(structure.idx_) < index_size,
+                       "invalid offset {} of bool index",
+                       structure.idx_);
+            values[structure.idx_] = structure.a_;
+        }
+    } else {
+        auto sorted = get_binary("index_values", index_size);
+        auto offsets = reinterpret_cast<const int32_t*>(
+            get_binary("index_offsets", index_size * sizeof(int32_t)));
+        for (size_t i = 0; i < index_size; ++i) {
+            int32_t offset;
+            memcpy(&offset, offsets + i, sizeof(offset));
+            AssertInfo(offset >= 0 && static_cast<size_t>(offset) < index_size,
+                       "invalid offset {} of bool index",
+                       offset);
+            values[offset] = sorted[i] != 0;
+        }
+    }
+    BuildWithValues(index_size, reinterpret_cast<const bool*>(values.data()));
+}
+
+void
+BoolIndex::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+void
+BoolIndex::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load bool index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+void
+BoolIndex::LoadV2(const Config& config) {
+    auto blobs = space_->StatisticsBlobs();
+    std::vector<std::string> index_files;
+    auto prefix = file_manager_->GetRemoteIndexObjectPrefixV2();
+    for (auto& b : blobs) {
+        if (b.name.rfind(prefix, 0) == 0) {
+            index_files.push_back(b.name);
+        }
+    }
+    std::map<std::string, FieldDataPtr> index_datas{};
+    for (auto& file_name : index_files) {
+        auto res = space_->GetBlobByteSize(file_name);
+        if (!res.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto index_blob_data =
+            std::shared_ptr<uint8_t[]>(new uint8_t[res.value()]);
+        auto status = space_->ReadBlob(file_name, index_blob_data.get());
+        if (!status.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto raw_index_blob =
+            storage::DeserializeFileData(index_blob_data, res.value());
+        auto key = file_name.substr(file_name.find_last_of('/') + 1);
+        index_datas[key] = raw_index_blob->GetFieldData();
+    }
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+TargetBitmap
+BoolIndex::Rows(bool has_false, bool has_true) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap bitset(num_rows_, has_false && has_true);
+    if (has_false == has_true) {
+        return bitset;
+    }
+    // unpack a block at a time, no branch on the bits
+    for (size_t i = 0; i < true_blocks_.size(); ++i) {
+        auto block = true_blocks_[i];
+        auto begin = static_cast<int64_t>(i) * BLOCK_BITS;
+        auto end = std::min(begin + BLOCK_BITS, num_rows_);
+        for (auto j = begin; j < end; ++j) {
+            bitset[j] = (block >> (j - begin)) & 1;
+        }
+    }
+    if (has_false) {
+#if defined(USE_DYNAMIC_SIMD)
+        milvus::simd::invert_bool(bitset.data(), bitset.size());
+#else
+        for (auto& bit : bitset) {
+            bit = !bit;
+        }
+#endif
+    }
+    return bitset;
+}
+
+const TargetBitmap
+BoolIndex::In(size_t n, const bool* values) {
+    bool has_false = false;
+    bool has_true = false;
+    for (size_t i = 0; i < n; ++i) {
+        (values[i] ? has_true : has_false) = true;
+    }
+    return Rows(has_false, has_true);
+}
+
+const TargetBitmap
+BoolIndex::NotIn(size_t n, const bool* values) {
+    bool has_false = false;
+    bool has_true = false;
+    for (size_t i = 0; i < n; ++i) {
+        (values[i] ? has_true : has_false) = true;
+    }
+    return Rows(!has_false, !has_true);
+}
+
+const TargetBitmap
+BoolIndex::Range(bool value, OpType op) {
+    // false < true
+    switch (op) {
+        case OpType::LessThan:
+            return Rows(value, false);
+        case OpType::LessEqual:
+            return Rows(true, value);
+        case OpType::GreaterThan:
+            return Rows(false, !value);
+        case OpType::GreaterEqual:
+            return Rows(!value, true);
+        default:
+            throw SegcoreError(OpTypeInvalid,
+                               fmt::format("Invalid OperatorType: {}", op));
+    }
+}
+
+const TargetBitmap
+BoolIndex::Range(bool lower_bound_value,
+                 bool lb_inclusive,
+                 bool upper_bound_value,
+                 bool ub_inclusive) {
+    auto in_range = [&](bool value) {
+        return (lb_inclusive ? lower_bound_value <= value
+                             : lower_bound_value < value) &&
+               (ub_inclusive ? value <= upper_bound_value
+                             : value < upper_bound_value);
+    };
+    return Rows(in_range(false), in_range(true));
+}
+
+bool
+BoolIndex::Reverse_Lookup(size_t offset) const {
+    AssertInfo(offset < static_cast<size_t>(num_rows_),
+               "out of range of total count");
+    AssertInfo(is_built_, "index has not been built");
+    return (true_blocks_[offset / BLOCK_BITS] >> (offset % BLOCK_BITS)) & 1;
+}
+
+}  // namespace milvus::index
@@ -16,17 +16,136 @@
 
 #pragma once
 
-#include <vector>
 #include <memory>
-#include "index/ScalarIndexSort.h"
+#include <vector>
+
+#include "common/Types.h"
+#include "index/ScalarIndex.h"
+#include "storage/MemFileManagerImpl.h"
+#include "storage/space.h"
 
 namespace milvus::index {
 
-using BoolIndexPtr = std::shared_ptr<ScalarIndexSort<bool>>;
+// BoolIndex keeps the rows holding true as a bitmap of one bit per row, the
+// rows holding false are the others, so `in` and `not in` are the bitmap or
+// its inversion unpacked a block at a time instead of scattering the sorted
+// offsets of every row like ScalarIndexSort.
+//
+// It loads the binaries of the sort index the bool fields were indexed by
+// before as well.
+class BoolIndex : public ScalarIndex<bool> {
+ public:
+    explicit BoolIndex(const storage::FileManagerContext& file_manager_context =
+                           storage::FileManagerContext());
+
+    explicit BoolIndex(const storage::FileManagerContext& file_manager_context,
+                       std::shared_ptr<milvus_storage::Space> space);
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override;
+
+    int64_t
+    Count() override {
+        return num_rows_;
+    }
+
+    void
+    Build(size_t n, const bool* values) override;
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override;
+
+    const TargetBitmap
+    In(size_t n, const bool* values) override;
+
+    const TargetBitmap
+    NotIn(size_t n, const bool* values) override;
+
+    const TargetBitmap
+    Range(bool value, OpType op) override;
+
+    const TargetBitmap
+    Range(bool lower_bound_value,
+          bool lb_inclusive,
+          bool upper_bound_value,
+          bool ub_inclusive) override;
+
+    bool
+    Reverse_Lookup(size_t offset) const override;
+
+    int64_t
+    Size() override {
+        return num_rows_;
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override;
+
+    const bool
+    HasRawData() const override {
+        return true;
+    }
+
+    int64_t
+    ByteSize() const override {
+        return true_blocks_.capacity() * sizeof(BlockType);
+    }
+
+ private:
+    void
+    BuildWithFieldDatas(const std::vector<FieldDataPtr>& field_datas);
+
+    void
+    LoadWithoutAssemble(const BinarySet& index_binary, const Config& config);
+
+    // pack the bools of the rows into true_blocks_
+    void
+    BuildWithValues(int64_t num_rows, const bool* values);
+
+    // the rows holding false if has_false, plus the ones holding true if
+    // has_true
+    TargetBitmap
+    Rows(bool has_false, bool has_true) const;
+
+ private:
+    using BlockType = BitsetType::block_type;
+    static constexpr int64_t BLOCK_BITS = sizeof(BlockType) * 8;
+
+    bool is_built_ = false;
+    int64_t num_rows_ = 0;
+    // the ith bit is of the row i, the bits past num_rows_ are 0
+    std::vector<BlockType> true_blocks_;
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+    std::shared_ptr<milvus_storage::Space> space_;
+};
+
+using BoolIndexPtr = std::unique_ptr<BoolIndex>;
 
 inline BoolIndexPtr
 CreateBoolIndex(const storage::FileManagerContext& file_manager_context =
                     storage::FileManagerContext()) {
-    return std::make_unique<ScalarIndexSort<bool>>(file_manager_context);
+    return std::make_unique<BoolIndex>(file_manager_context);
 }
+
+inline BoolIndexPtr
+CreateBoolIndex(const storage::FileManagerContext& file_manager_context,
+                std::shared_ptr<milvus_storage::Space> space) {
+    return std::make_unique<BoolIndex>(file_manager_context, space);
+}
+
 }  // namespace milvus::index
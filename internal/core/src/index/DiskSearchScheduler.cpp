@@ -0,0 +1,141 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/DiskSearchScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "storage/prometheus_client.h"
+
+namespace milvus::index {
+
+void
+DiskSearchScheduler::SetCapacity(int64_t capacity, int64_t query_budget) {
+    AssertInfo(capacity >= 0 && query_budget >= 0,
+               "invalid disk search capacity {} or query budget {}",
+               capacity,
+               query_budget);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        query_budget_ = query_budget;
+        AdmitLocked();
+    }
+    cond_.notify_all();
+    LOG_SEGCORE_INFO_ << "set disk search capacity: " << capacity
+                      << ", query budget: " << query_budget;
+}
+
+int64_t
+DiskSearchScheduler::Capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+int64_t
+DiskSearchScheduler::BatchSize(int64_t num_queries) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto batch = num_queries;
+    if (query_budget_ > 0) {
+        batch = std::min(batch, query_budget_);
+    }
+    if (capacity_ > 0) {
+        batch = std::min(batch, capacity_);
+    }
+    return std::max<int64_t>(batch, 1);
+}
+
+DiskSearchScheduler::Permit
+DiskSearchScheduler::Acquire(int64_t segment_id, int64_t num_queries) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    Waiter waiter{std::max<int64_t>(num_queries, 1)};
+    if (capacity_ == 0 ||
+        (turns_.empty() && in_flight_ + waiter.units <= capacity_)) {
+        in_flight_ += waiter.units;
+        return Permit(this, waiter.units);
+    }
+
+    auto& queue = waiters_[segment_id];
+    if (queue.empty()) {
+        turns_.push_back(segment_id);
+    }
+    queue.push_back(&waiter);
+    ++queue_depth_;
+    storage::internal_disk_search_queue_depth_queued.Increment();
+    cond_.wait(lock, [&] { return waiter.admitted; });
+    storage::internal_disk_search_latency_wait.Observe(
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    return Permit(this, waiter.units);
+}
+
+void
+DiskSearchScheduler::Release(int64_t units) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_ -= units;
+        AdmitLocked();
+    }
+    cond_.notify_all();
+}
+
+void
+DiskSearchScheduler::AdmitLocked() {
+    while (!turns_.empty()) {
+        auto segment_id = turns_.front();
+        auto iter = waiters_.find(segment_id);
+        auto& queue = iter->second;
+        auto waiter = queue.front();
+        // the capacity may have shrunk below the units of the waiter
+        if (capacity_ > 0) {
+            waiter->units = std::min(waiter->units, capacity_);
+            if (in_flight_ + waiter->units > capacity_) {
+                return;
+            }
+        }
+        waiter->admitted = true;
+        in_flight_ += waiter->units;
+        --queue_depth_;
+        storage::internal_disk_search_queue_depth_queued.Decrement();
+
+        queue.pop_front();
+        turns_.pop_front();
+        if (queue.empty()) {
+            waiters_.erase(iter);
+        } else {
+            turns_.push_back(segment_id);
+        }
+    }
+}
+
+int64_t
+DiskSearchScheduler::QueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_depth_;
+}
+
+int64_t
+DiskSearchScheduler::InFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+}  // namespace milvus::index
@@ -0,0 +1,125 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace milvus::index {
+
+// Admits the searches on the disk indexes of the node, which share the AIO
+// contexts of knowhere, so the reads in flight are bounded node-wide.
+//
+// A search of nq queries holds min(nq, query budget) of the capacity while
+// it runs, the queries beyond the budget are searched in the next batches, so
+// a large search can't take all the contexts. The searches waiting for the
+// capacity are queued by segment and admitted segment by segment in turn,
+// first come first served in a segment, so the segments of a hot collection
+// don't starve the others.
+class DiskSearchScheduler {
+ public:
+    static DiskSearchScheduler&
+    GetInstance() {
+        static DiskSearchScheduler instance;
+        return instance;
+    }
+
+    // capacity is the queries searched at once by the node, 0 admits every
+    // search at once; query_budget is the queries a search holds at most,
+    // 0 for the capacity
+    void
+    SetCapacity(int64_t capacity, int64_t query_budget);
+
+    int64_t
+    Capacity() const;
+
+    // the queries a search of num_queries queries is split into batches of
+    int64_t
+    BatchSize(int64_t num_queries) const;
+
+    // the capacity held by an admitted batch, released once destroyed
+    class Permit {
+     public:
+        Permit(DiskSearchScheduler* scheduler, int64_t units)
+            : scheduler_(scheduler), units_(units) {
+        }
+
+        Permit(Permit&& other) noexcept
+            : scheduler_(other.scheduler_), units_(other.units_) {
+            other.scheduler_ = nullptr;
+        }
+
+        Permit(const Permit&) = delete;
+        Permit&
+        operator=(const Permit&) = delete;
+        Permit&
+        operator=(Permit&&) = delete;
+
+        ~Permit() {
+            if (scheduler_ != nullptr) {
+                scheduler_->Release(units_);
+            }
+        }
+
+     private:
+        DiskSearchScheduler* scheduler_;
+        int64_t units_;
+    };
+
+    // wait until a batch of num_queries queries on the segment is admitted
+    Permit
+    Acquire(int64_t segment_id, int64_t num_queries);
+
+    // the batches waiting to be admitted
+    int64_t
+    QueueDepth() const;
+
+    int64_t
+    InFlight() const;
+
+ private:
+    DiskSearchScheduler() = default;
+
+    struct Waiter {
+        int64_t units;
+        bool admitted = false;
+    };
+
+    void
+    Release(int64_t units);
+
+    // admit the waiters at the heads of the segments in turn, as long as
+    // the capacity is enough for the next one
+    void
+    AdmitLocked();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    int64_t capacity_ = 0;
+    int64_t query_budget_ = 0;
+    int64_t in_flight_ = 0;
+    int64_t queue_depth_ = 0;
+    std::map<int64_t, std::deque<Waiter*>> waiters_;
+    // the segments with waiters, in the order of their turns
+    std::list<int64_t> turns_;
+};
+
+}  // namespace milvus::index
@@ -0,0 +1,293 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "index/FieldStats.h"
+
+namespace milvus {
+
+namespace {
+
+constexpr uint32_t FIELD_STATS_FORMAT_VERSION = 1;
+
+double
+AsDouble(const FieldStats::Value& value) {
+    if (std::holds_alternative<int64_t>(value)) {
+        return static_cast<double>(std::get<int64_t>(value));
+    }
+    return std::get<double>(value);
+}
+
+// nullopt if one is a string and the other a number
+std::optional<bool>
+Less(const FieldStats::Value& a, const FieldStats::Value& b) {
+    auto a_is_string = std::holds_alternative<std::string>(a);
+    if (a_is_string != std::holds_alternative<std::string>(b)) {
+        return std::nullopt;
+    }
+    if (a_is_string) {
+        return std::get<std::string>(a) < std::get<std::string>(b);
+    }
+    if (std::holds_alternative<int64_t>(a) &&
+        std::holds_alternative<int64_t>(b)) {
+        return std::get<int64_t>(a) < std::get<int64_t>(b);
+    }
+    return AsDouble(a) < AsDouble(b);
+}
+
+// the position of the value between the bounds, halfway for the strings
+double
+Interpolate(const FieldStats::Value& lower,
+            const FieldStats::Value& upper,
+            const FieldStats::Value& value) {
+    if (std::holds_alternative<std::string>(value)) {
+        return 0.5;
+    }
+    auto lo = AsDouble(lower);
+    auto hi = AsDouble(upper);
+    if (!(hi > lo)) {
+        return 0.5;
+    }
+    return std::clamp((AsDouble(value) - lo) / (hi - lo), 0.0, 1.0);
+}
+
+template <typename T>
+void
+Append(std::vector<uint8_t>& out, const T& value) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+class Reader {
+ public:
+    Reader(const uint8_t* data, size_t size) : pos_(data), end_(data + size) {
+    }
+
+    template <typename T>
+    bool
+    Read(T* value) {
+        if (end_ - pos_ < static_cast<int64_t>(sizeof(T))) {
+            return false;
+        }
+        std::memcpy(value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool
+    ReadBytes(void* dst, size_t size) {
+        if (static_cast<size_t>(end_ - pos_) < size) {
+            return false;
+        }
+        std::memcpy(dst, pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool
+    AtEnd() const {
+        return pos_ == end_;
+    }
+
+ private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+}  // namespace
+
+void
+HyperLogLog::Merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < NUM_REGISTERS; ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+double
+HyperLogLog::Estimate() const {
+    double sum = 0;
+    int64_t zeros = 0;
+    for (auto rank : registers_) {
+        sum += std::ldexp(1.0, -rank);
+        zeros += rank == 0;
+    }
+    double m = NUM_REGISTERS;
+    auto alpha = 0.7213 / (1 + 1.079 / m);
+    auto estimate = alpha * m * m / sum;
+    // few values, counted by the empty registers instead
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / zeros);
+    }
+    return estimate;
+}
+
+double
+FieldStats::ValueRatio() const {
+    if (num_rows == 0) {
+        return 0;
+    }
+    return static_cast<double>(num_rows - null_count) / num_rows;
+}
+
+double
+FieldStats::DistinctCount() const {
+    if (bounds.empty()) {
+        return 0;
+    }
+    return std::clamp(
+        distinct.Estimate(), 1.0, static_cast<double>(num_rows - null_count));
+}
+
+std::optional<double>
+FieldStats::Below(const Value& value, bool inclusive) const {
+    if (bounds.empty()) {
+        return 0.0;
+    }
+    if (!Less(value, bounds.front()).has_value()) {
+        return std::nullopt;
+    }
+    auto below = [&](const Value& bound) {
+        return inclusive ? !*Less(value, bound) : *Less(bound, value);
+    };
+    if (!below(bounds.front())) {
+        return 0.0;
+    }
+    if (below(bounds.back())) {
+        return 1.0;
+    }
+    // the first bucket whose upper bound isn't below the value
+    auto bucket =
+        std::partition_point(bounds.begin() + 1, bounds.end(), below) -
+        bounds.begin();
+    auto num_buckets = bounds.size() - 1;
+    return (bucket - 1 +
+            Interpolate(bounds[bucket - 1], bounds[bucket], value)) /
+           num_buckets;
+}
+
+double
+FieldStats::EqualSelectivity(const Value& value) const {
+    if (bounds.empty()) {
+        return 0;
+    }
+    auto lower = Below(value, false);
+    if (!lower.has_value()) {
+        return ValueRatio();
+    }
+    if (*Less(value, bounds.front()) || *Less(bounds.back(), value)) {
+        return 0;
+    }
+    // a frequent value spans the buckets, the others are taken as uniform
+    auto fraction = *Below(value, true) - *lower;
+    fraction = std::max(fraction, 1.0 / DistinctCount());
+    return std::min(fraction, 1.0) * ValueRatio();
+}
+
+double
+FieldStats::RangeSelectivity(const std::optional<Value>& lower,
+                             bool lower_inclusive,
+                             const std::optional<Value>& upper,
+                             bool upper_inclusive) const {
+    double upper_fraction = 1;
+    double lower_fraction = 0;
+    if (upper.has_value()) {
+        auto fraction = Below(*upper, upper_inclusive);
+        if (!fraction.has_value()) {
+            return ValueRatio();
+        }
+        upper_fraction = *fraction;
+    }
+    if (lower.has_value()) {
+        auto fraction = Below(*lower, !lower_inclusive);
+        if (!fraction.has_value()) {
+            return ValueRatio();
+        }
+        lower_fraction = *fraction;
+    }
+    return std::max(0.0, upper_fraction - lower_fraction) * ValueRatio();
+}
+
+std::vector<uint8_t>
+FieldStats::Serialize() const {
+    // (version, num rows, null count, bounds, registers), a bound as its
+    // type index and its value, a string as its size and bytes
+    std::vector<uint8_t> out;
+    Append(out, FIELD_STATS_FORMAT_VERSION);
+    Append(out, num_rows);
+    Append(out, null_count);
+    Append(out, static_cast<uint64_t>(bounds.size()));
+    for (auto& bound : bounds) {
+        Append(out, static_cast<uint8_t>(bound.index()));
+        if (std::holds_alternative<int64_t>(bound)) {
+            Append(out, std::get<int64_t>(bound));
+        } else if (std::holds_alternative<double>(bound)) {
+            Append(out, std::get<double>(bound));
+        } else {
+            auto& str = std::get<std::string>(bound);
+            Append(out, static_cast<uint64_t>(str.size()));
+            out.insert(out.end(), str.begin(), str.end());
+        }
+    }
+    auto& registers = distinct.registers();
+    out.insert(out.end(), registers.begin(), registers.end());
+    return out;
+}
+
+std::optional<FieldStats>
+FieldStats::Deserialize(const uint8_t* data, size_t size) {
+    Reader reader(data, size);
+    FieldStats stats;
+    uint32_t version;
+    uint64_t num_bounds;
+    if (!reader.Read(&version) || version != FIELD_STATS_FORMAT_VERSION ||
+        !reader.Read(&stats.num_rows) || !reader.Read(&stats.null_count) ||
+        !reader.Read(&num_bounds) || num_bounds > size) {
+        return std::nullopt;
+    }
+    for (uint64_t i = 0; i < num_bounds; ++i) {
+        uint8_t type;
+        if (!reader.Read(&type)) {
+            return std::nullopt;
+        }
+        if (type == 0) {
+            int64_t value;
+            if (!reader.Read(&value)) {
+                return std::nullopt;
+            }
+            stats.bounds.emplace_back(value);
+        } else if (type == 1) {
+            double value;
+            if (!reader.Read(&value)) {
+                return std::nullopt;
+            }
+            stats.bounds.emplace_back(value);
+        } else if (type == 2) {
+            uint64_t str_size;
+            if (!reader.Read(&str_size) || str_size > size) {
+                return std::nullopt;
+            }
+            std::string value(str_size, '\0');
+            if (!reader.ReadBytes(value.data(), str_size)) {
+                return std::nullopt;
+            }
+            stats.bounds.emplace_back(std::move(value));
+        } else {
+            return std::nullopt;
+        }
+    }
+    auto& registers = stats.distinct.registers();
+    if (!reader.ReadBytes(registers.data(), registers.size()) ||
+        !reader.AtEnd()) {
+        return std::nullopt;
+    }
+    return stats;
+}
+
+}  // namespace milvus
@@ -0,0 +1,196 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "segcore/BloomFilter.h"
+
+namespace milvus {
+
+// A HyperLogLog sketch of the distinct values, of 2^PRECISION registers of
+// a byte, about 1.6% of standard error
+class HyperLogLog {
+ public:
+    static constexpr int PRECISION = 12;
+    static constexpr size_t NUM_REGISTERS = size_t(1) << PRECISION;
+
+    HyperLogLog() : registers_(NUM_REGISTERS) {
+    }
+
+    void
+    Add(uint64_t hash) {
+        auto index = hash >> (64 - PRECISION);
+        // the bit set bounds the rank by 64 - PRECISION + 1
+        auto rest = (hash << PRECISION) | (uint64_t(1) << (PRECISION - 1));
+        auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+        registers_[index] = std::max(registers_[index], rank);
+    }
+
+    void
+    Merge(const HyperLogLog& other);
+
+    double
+    Estimate() const;
+
+    std::vector<uint8_t>&
+    registers() {
+        return registers_;
+    }
+
+    const std::vector<uint8_t>&
+    registers() const {
+        return registers_;
+    }
+
+ private:
+    std::vector<uint8_t> registers_;
+};
+
+// The statistics of the values of a scalar field of a sealed segment, built
+// once the field is loaded, to estimate the selectivity of the filters on it
+// before evaluating them. The integers are kept as int64 and the floats as
+// double, NaN is counted in neither the distinct values nor the histogram.
+struct FieldStats {
+    using Value = std::variant<int64_t, double, std::string>;
+
+    int64_t num_rows = 0;
+    int64_t null_count = 0;
+    HyperLogLog distinct;
+    // the equi-depth histogram of the sampled values, the min followed by
+    // the upper bounds of the buckets, each holding the same number of the
+    // samples, empty if there is no value
+    std::vector<Value> bounds;
+
+    double
+    DistinctCount() const;
+
+    // the estimated fraction of the rows equal to the value
+    double
+    EqualSelectivity(const Value& value) const;
+
+    // the estimated fraction of the rows in the range, unbounded on the side
+    // of nullopt
+    double
+    RangeSelectivity(const std::optional<Value>& lower,
+                     bool lower_inclusive,
+                     const std::optional<Value>& upper,
+                     bool upper_inclusive) const;
+
+    std::vector<uint8_t>
+    Serialize() const;
+
+    // nullopt if the bytes aren't of the stats of this format
+    static std::optional<FieldStats>
+    Deserialize(const uint8_t* data, size_t size);
+
+    // the stats of count values read by raw_at(i), T is the type of the
+    // field, std::string_view for the strings
+    template <typename T, typename FUNC>
+    static FieldStats
+    Build(int64_t count, int64_t null_count, FUNC raw_at) {
+        FieldStats stats;
+        stats.num_rows = count;
+        stats.null_count = null_count;
+        // the histogram is of every stride-th value, the sketch of all
+        auto stride = std::max<int64_t>(1, count / MAX_SAMPLES);
+        std::vector<T> samples;
+        samples.reserve(count / stride + 1);
+        for (int64_t i = 0; i < count; ++i) {
+            T value = raw_at(i);
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(value)) {
+                    continue;
+                }
+            }
+            stats.distinct.Add(Hash(ToValue(value)));
+            if (i % stride == 0) {
+                samples.push_back(value);
+            }
+        }
+        if (samples.empty()) {
+            return stats;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto num_buckets = std::min<size_t>(HISTOGRAM_BUCKETS, samples.size());
+        stats.bounds.push_back(ToBound(samples.front()));
+        for (size_t i = 1; i <= num_buckets; ++i) {
+            stats.bounds.push_back(
+                ToBound(samples[i * samples.size() / num_buckets - 1]));
+        }
+        return stats;
+    }
+
+    static constexpr int64_t MAX_SAMPLES = 1 << 16;
+    static constexpr size_t HISTOGRAM_BUCKETS = 64;
+
+ private:
+    template <typename T>
+    static auto
+    ToValue(const T& value) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // -0.0 equals 0.0
+            return value == 0 ? 0.0 : static_cast<double>(value);
+        } else {
+            return static_cast<int64_t>(value);
+        }
+    }
+
+    template <typename T>
+    static Value
+    ToBound(const T& value) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return std::string(value);
+        } else {
+            return ToValue(value);
+        }
+    }
+
+    static uint64_t
+    Hash(int64_t value) {
+        return segcore::MixHash(static_cast<uint64_t>(value));
+    }
+
+    static uint64_t
+    Hash(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return segcore::MixHash(bits);
+    }
+
+    static uint64_t
+    Hash(std::string_view value) {
+        return segcore::HashPk(value);
+    }
+
+    // the estimated fraction of the values less than the value, or not
+    // greater than it if inclusive, nullopt if not comparable to them
+    std::optional<double>
+    Below(const Value& value, bool inclusive) const;
+
+    // the fraction of the values not null
+    double
+    ValueRatio() const;
+};
+
+}  // namespace milvus
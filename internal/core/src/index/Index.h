@@ -25,6 +25,12 @@
 
 const std::string kMmapFilepath = "mmap_filepath";
 const std::string kEnableMmap = "enable_mmap";
+// the local file an index is staged into while loading it in memory
+const std::string kLoadFilepath = "load_filepath";
+// the read ahead policy of the mapped index, e.g. random, and whether to
+// lock it within the MlockBudget, "true" or "false"
+const std::string kMmapAdvice = "mmap_advice";
+const std::string kMlock = "mlock";
 
 namespace milvus::index {
 
@@ -71,7 +77,14 @@ class IndexBase {
     virtual const bool
     HasRawData() const = 0;
 
-    bool
+    // the bytes of the memory held by the index, the mmapped or on disk parts
+    // are excluded
+    virtual int64_t
+    ByteSize() const {
+        return 0;
+    }
+
+    virtual bool
     IsMmapSupported() const {
         return index_type_ == knowhere::IndexEnum::INDEX_HNSW ||
                index_type_ == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT ||
@@ -25,6 +25,9 @@
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexMarisa.h"
 #include "index/BoolIndex.h"
+#include "index/BitmapIndex.h"
+#include "index/JsonInvertedIndex.h"
+#include "index/ArrayInvertedIndex.h"
 
 namespace milvus::index {
 
@@ -33,21 +36,31 @@ ScalarIndexPtr<T>
 IndexFactory::CreateScalarIndex(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<T>(file_manager_context);
+    }
     return CreateScalarIndexSort<T>(file_manager_context);
 }
 
-// template <>
-// inline ScalarIndexPtr<bool>
-// IndexFactory::CreateScalarIndex(const IndexType& index_type) {
-//    return CreateBoolIndex();
-//}
-//
+template <>
+ScalarIndexPtr<bool>
+IndexFactory::CreateScalarIndex<bool>(
+    const IndexType& index_type,
+    const storage::FileManagerContext& file_manager_context) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<bool>(file_manager_context);
+    }
+    return CreateBoolIndex(file_manager_context);
+}
 
 template <>
 ScalarIndexPtr<std::string>
 IndexFactory::CreateScalarIndex<std::string>(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<std::string>(file_manager_context);
+    }
 #if defined(__linux__) || defined(__APPLE__)
     return CreateStringIndexMarisa(file_manager_context);
 #else
@@ -61,15 +74,33 @@ IndexFactory::CreateScalarIndex(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context,
     std::shared_ptr<milvus_storage::Space> space) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<T>(file_manager_context, space);
+    }
     return CreateScalarIndexSort<T>(file_manager_context, space);
 }
 
+template <>
+ScalarIndexPtr<bool>
+IndexFactory::CreateScalarIndex(
+    const IndexType& index_type,
+    const storage::FileManagerContext& file_manager_context,
+    std::shared_ptr<milvus_storage::Space> space) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<bool>(file_manager_context, space);
+    }
+    return CreateBoolIndex(file_manager_context, space);
+}
+
 template <>
 ScalarIndexPtr<std::string>
 IndexFactory::CreateScalarIndex(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context,
     std::shared_ptr<milvus_storage::Space> space) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<std::string>(file_manager_context, space);
+    }
 #if defined(__linux__) || defined(__APPLE__)
     return CreateStringIndexMarisa(file_manager_context, space);
 #else
@@ -130,6 +161,14 @@ IndexFactory::CreateScalarIndex(
         case DataType::VARCHAR:
             return CreateScalarIndex<std::string>(index_type,
                                                   file_manager_context);
+
+            // create json index
+        case DataType::JSON:
+            return std::make_unique<JsonInvertedIndex>(file_manager_context);
+
+            // create array index
+        case DataType::ARRAY:
+            return std::make_unique<ArrayInvertedIndex>(file_manager_context);
         default:
             throw SegcoreError(
                 DataTypeInvalid,
@@ -206,6 +245,14 @@ IndexFactory::CreateScalarIndex(const CreateIndexInfo& create_index_info,
         case DataType::VARCHAR:
             return CreateScalarIndex<std::string>(
                 index_type, file_manager, space);
+
+            // create json index
+        case DataType::JSON:
+            return std::make_unique<JsonInvertedIndex>(file_manager, space);
+
+            // create array index
+        case DataType::ARRAY:
+            return std::make_unique<ArrayInvertedIndex>(file_manager, space);
         default:
             throw SegcoreError(
                 DataTypeInvalid,
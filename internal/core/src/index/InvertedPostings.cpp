@@ -0,0 +1,181 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/InvertedPostings.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "common/EasyAssert.h"
+
+namespace milvus::index {
+
+namespace {
+
+template <typename T>
+void
+AppendBinary(BinarySet& binary_set,
+             const std::string& name,
+             const T* data,
+             size_t size) {
+    auto byte_size = size * sizeof(T);
+    std::shared_ptr<uint8_t[]> buf(new uint8_t[byte_size]);
+    if (byte_size > 0) {
+        memcpy(buf.get(), data, byte_size);
+    }
+    binary_set.Append(name, buf, byte_size);
+}
+
+BinaryPtr
+GetBinary(const BinarySet& binary_set, const std::string& name) {
+    auto binary = binary_set.GetByName(name);
+    AssertInfo(binary != nullptr, "index binary {} not found", name);
+    return binary;
+}
+
+template <typename T>
+void
+ReadBinary(const BinarySet& binary_set,
+           const std::string& name,
+           std::vector<T>& data) {
+    auto binary = GetBinary(binary_set, name);
+    AssertInfo(binary->size % sizeof(T) == 0,
+               "invalid size {} of index binary {}",
+               binary->size,
+               name);
+    data.resize(binary->size / sizeof(T));
+    if (binary->size > 0) {
+        memcpy(data.data(), binary->data.get(), binary->size);
+    }
+}
+
+}  // namespace
+
+void
+InvertedPostings::AddRow(Builder& builder,
+                         std::vector<std::string>& keys,
+                         uint32_t offset) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (auto& key : keys) {
+        builder[std::move(key)].push_back(offset);
+    }
+    keys.clear();
+}
+
+void
+InvertedPostings::Build(int64_t num_rows, Builder& builder) {
+    std::vector<Builder::iterator> entries;
+    entries.reserve(builder.size());
+    size_t keys_size = 0;
+    size_t postings_size = 0;
+    for (auto it = builder.begin(); it != builder.end(); ++it) {
+        entries.push_back(it);
+        keys_size += it->first.size();
+        postings_size += it->second.size();
+    }
+    std::sort(entries.begin(), entries.end(), [](auto& lhs, auto& rhs) {
+        return lhs->first < rhs->first;
+    });
+
+    num_rows_ = num_rows;
+    keys_.clear();
+    keys_.reserve(keys_size);
+    key_offsets_.clear();
+    key_offsets_.reserve(entries.size() + 1);
+    posting_offsets_.clear();
+    posting_offsets_.reserve(entries.size() + 1);
+    postings_.clear();
+    postings_.reserve(postings_size);
+    key_offsets_.push_back(0);
+    posting_offsets_.push_back(0);
+    for (auto& entry : entries) {
+        keys_.append(entry->first);
+        key_offsets_.push_back(keys_.size());
+        postings_.insert(
+            postings_.end(), entry->second.begin(), entry->second.end());
+        posting_offsets_.push_back(postings_.size());
+    }
+}
+
+void
+InvertedPostings::Match(std::string_view key, TargetBitmap& res) const {
+    auto num_keys = key_offsets_.size() - 1;
+    auto key_at = [&](size_t i) {
+        return std::string_view(keys_.data() + key_offsets_[i],
+                                key_offsets_[i + 1] - key_offsets_[i]);
+    };
+    size_t lo = 0;
+    size_t hi = num_keys;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (key_at(mid) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == num_keys || key_at(lo) != key) {
+        return;
+    }
+    for (auto i = posting_offsets_[lo]; i < posting_offsets_[lo + 1]; ++i) {
+        res[postings_[i]] = true;
+    }
+}
+
+void
+InvertedPostings::Serialize(BinarySet& binary_set,
+                            const std::string& prefix) const {
+    AppendBinary(binary_set, prefix + "_num_rows", &num_rows_, 1);
+    AppendBinary(binary_set, prefix + "_keys", keys_.data(), keys_.size());
+    AppendBinary(binary_set,
+                 prefix + "_key_offsets",
+                 key_offsets_.data(),
+                 key_offsets_.size());
+    AppendBinary(binary_set,
+                 prefix + "_posting_offsets",
+                 posting_offsets_.data(),
+                 posting_offsets_.size());
+    AppendBinary(binary_set,
+                 prefix + "_postings",
+                 postings_.data(),
+                 postings_.size());
+}
+
+void
+InvertedPostings::Load(const BinarySet& binary_set,
+                       const std::string& prefix) {
+    std::vector<int64_t> num_rows;
+    ReadBinary(binary_set, prefix + "_num_rows", num_rows);
+    AssertInfo(num_rows.size() == 1, "invalid {} binary", prefix);
+    num_rows_ = num_rows[0];
+
+    auto keys = GetBinary(binary_set, prefix + "_keys");
+    keys_.assign(reinterpret_cast<const char*>(keys->data.get()), keys->size);
+    ReadBinary(binary_set, prefix + "_key_offsets", key_offsets_);
+    ReadBinary(binary_set, prefix + "_posting_offsets", posting_offsets_);
+    ReadBinary(binary_set, prefix + "_postings", postings_);
+    AssertInfo(!key_offsets_.empty() &&
+                   key_offsets_.size() == posting_offsets_.size() &&
+                   key_offsets_.back() == keys_.size() &&
+                   posting_offsets_.back() == postings_.size(),
+               "invalid {} binary",
+               prefix);
+}
+
+}  // namespace milvus::index
@@ -0,0 +1,75 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::index {
+
+// InvertedPostings maps the byte string keys of the rows to the sorted offsets
+// of the rows holding them, the keys are kept in ascending order.
+class InvertedPostings {
+ public:
+    using Builder = std::unordered_map<std::string, std::vector<uint32_t>>;
+
+    // add the keys of the row, the rows must be added in order
+    static void
+    AddRow(Builder& builder, std::vector<std::string>& keys, uint32_t offset);
+
+    void
+    Build(int64_t num_rows, Builder& builder);
+
+    int64_t
+    num_rows() const {
+        return num_rows_;
+    }
+
+    // set the rows holding the key
+    void
+    Match(std::string_view key, TargetBitmap& res) const;
+
+    // the binaries are named with the prefix
+    void
+    Serialize(BinarySet& binary_set, const std::string& prefix) const;
+
+    void
+    Load(const BinarySet& binary_set, const std::string& prefix);
+
+    int64_t
+    ByteSize() const {
+        return keys_.size() + key_offsets_.size() * sizeof(uint64_t) +
+               posting_offsets_.size() * sizeof(uint64_t) +
+               postings_.size() * sizeof(uint32_t);
+    }
+
+ private:
+    int64_t num_rows_ = 0;
+    // the rows of the ith key are
+    // postings_[posting_offsets_[i], posting_offsets_[i + 1])
+    std::string keys_;
+    std::vector<uint64_t> key_offsets_;
+    std::vector<uint64_t> posting_offsets_;
+    std::vector<uint32_t> postings_;
+};
+
+}  // namespace milvus::index
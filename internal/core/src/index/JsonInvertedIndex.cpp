@@ -0,0 +1,647 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/JsonInvertedIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+#include <pb/schema.pb.h>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/Utils.h"
+#include "storage/Util.h"
+
+namespace milvus::index {
+
+namespace {
+
+using simdjson::ondemand::json_type;
+
+// a key is the json pointer, a '\0', the kind and the bytes of the value
+enum class ValueKind : char {
+    INT64 = 1,
+    DOUBLE,
+    BOOL,
+    STRING,
+    // the direct elements of the array at the pointer
+    ELEMENT_INT64,
+    ELEMENT_DOUBLE,
+    ELEMENT_BOOL,
+    ELEMENT_STRING,
+};
+
+constexpr char ELEMENT_KIND_DIFF =
+    static_cast<char>(ValueKind::ELEMENT_INT64) -
+    static_cast<char>(ValueKind::INT64);
+
+// the integers beyond it may not keep the same after converted to double,
+// where the filters treat int64 and double differently
+constexpr int64_t MAX_EXACT_INTEGER = int64_t(1) << 53;
+
+std::string
+EncodeKey(std::string_view pointer,
+          ValueKind kind,
+          const void* data,
+          size_t size) {
+    std::string key;
+    key.reserve(pointer.size() + 2 + size);
+    key.append(pointer);
+    key.push_back('\0');
+    key.push_back(static_cast<char>(kind));
+    key.append(static_cast<const char*>(data), size);
+    return key;
+}
+
+ValueKind
+ElementKind(ValueKind kind) {
+    return static_cast<ValueKind>(static_cast<char>(kind) + ELEMENT_KIND_DIFF);
+}
+
+// the same as Json::pointer
+void
+AppendEscapedKey(std::string& path, std::string_view key) {
+    path.push_back('/');
+    for (auto c : key) {
+        if (c == '~') {
+            path.append("~0");
+        } else if (c == '/') {
+            path.append("~1");
+        } else {
+            path.push_back(c);
+        }
+    }
+}
+
+// the keys of a scalar at the path, array_path_size is the size of the path
+// of its array if it's a direct element of an array, or std::string::npos
+void
+AddScalarKeys(std::vector<std::string>& keys,
+              std::string_view path,
+              size_t array_path_size,
+              ValueKind kind,
+              const void* data,
+              size_t size) {
+    keys.push_back(EncodeKey(path, kind, data, size));
+    if (array_path_size != std::string::npos) {
+        keys.push_back(EncodeKey(path.substr(0, array_path_size),
+                                 ElementKind(kind),
+                                 data,
+                                 size));
+    }
+}
+
+simdjson::error_code
+WalkValue(simdjson::ondemand::value value,
+          std::string& path,
+          size_t array_path_size,
+          std::vector<std::string>& keys);
+
+simdjson::error_code
+WalkObject(simdjson::ondemand::object object,
+           std::string& path,
+           std::vector<std::string>& keys) {
+    // only the first one of the duplicate keys is reachable by json pointers
+    std::unordered_set<std::string_view> visited;
+    auto path_size = path.size();
+    for (auto field : object) {
+        // json pointers match the keys without unescaping
+        std::string_view key;
+        auto error = field.escaped_key().get(key);
+        if (error) {
+            return error;
+        }
+        if (!visited.insert(key).second) {
+            continue;
+        }
+        simdjson::ondemand::value value;
+        error = field.value().get(value);
+        if (error) {
+            return error;
+        }
+        AppendEscapedKey(path, key);
+        error = WalkValue(value, path, std::string::npos, keys);
+        path.resize(path_size);
+        if (error) {
+            return error;
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code
+WalkArray(simdjson::ondemand::array array,
+          std::string& path,
+          std::vector<std::string>& keys) {
+    auto path_size = path.size();
+    size_t index = 0;
+    for (auto element : array) {
+        simdjson::ondemand::value value;
+        auto error = element.get(value);
+        if (error) {
+            return error;
+        }
+        path.push_back('/');
+        path.append(std::to_string(index++));
+        error = WalkValue(value, path, path_size, keys);
+        path.resize(path_size);
+        if (error) {
+            return error;
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code
+WalkValue(simdjson::ondemand::value value,
+          std::string& path,
+          size_t array_path_size,
+          std::vector<std::string>& keys) {
+    json_type type;
+    auto error = value.type().get(type);
+    if (error) {
+        return error;
+    }
+    switch (type) {
+        case json_type::object: {
+            simdjson::ondemand::object object;
+            error = value.get_object().get(object);
+            if (error) {
+                return error;
+            }
+            return WalkObject(object, path, keys);
+        }
+        case json_type::array: {
+            simdjson::ondemand::array array;
+            error = value.get_array().get(array);
+            if (error) {
+                return error;
+            }
+            return WalkArray(array, path, keys);
+        }
+        case json_type::number: {
+            simdjson::ondemand::number_type number_type;
+            error = value.get_number_type().get(number_type);
+            if (error) {
+                return error;
+            }
+            if (number_type ==
+                simdjson::ondemand::number_type::signed_integer) {
+                int64_t x;
+                error = value.get_int64().get(x);
+                if (error) {
+                    return error;
+                }
+                AddScalarKeys(keys,
+                              path,
+                              array_path_size,
+                              ValueKind::INT64,
+                              &x,
+                              sizeof(x));
+                break;
+            }
+            // the unsigned and big integers are only readable as double
+            double x;
+            if (value.get_double().get(x) == simdjson::SUCCESS) {
+                if (x == 0) {
+                    // -0.0 equals to 0.0
+                    x = 0;
+                }
+                AddScalarKeys(keys,
+                              path,
+                              array_path_size,
+                              ValueKind::DOUBLE,
+                              &x,
+                              sizeof(x));
+            }
+            break;
+        }
+        case json_type::string: {
+            std::string_view x;
+            error = value.get_string().get(x);
+            if (error) {
+                return error;
+            }
+            AddScalarKeys(keys,
+                          path,
+                          array_path_size,
+                          ValueKind::STRING,
+                          x.data(),
+                          x.size());
+            break;
+        }
+        case json_type::boolean: {
+            bool x;
+            error = value.get_bool().get(x);
+            if (error) {
+                return error;
+            }
+            AddScalarKeys(keys,
+                          path,
+                          array_path_size,
+                          ValueKind::BOOL,
+                          &x,
+                          sizeof(x));
+            break;
+        }
+        default:
+            // null is never equal to any value
+            break;
+    }
+    return simdjson::SUCCESS;
+}
+
+}  // namespace
+
+JsonInvertedIndex::JsonInvertedIndex(
+    const storage::FileManagerContext& file_manager_context) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+JsonInvertedIndex::JsonInvertedIndex(
+    const storage::FileManagerContext& file_manager_context,
+    std::shared_ptr<milvus_storage::Space> space)
+    : space_(std::move(space)) {
+    if (file_manager_context.Valid()) {
+        file_manager_ = std::make_shared<storage::MemFileManagerImpl>(
+            file_manager_context, space_);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+void
+JsonInvertedIndex::AddRow(const Json& row,
+                          uint32_t offset,
+                          InvertedPostings::Builder& builder) {
+    std::vector<std::string> keys;
+    std::string path;
+    auto doc = row.doc();
+    json_type type;
+    if (doc.type().get(type) == simdjson::SUCCESS) {
+        if (type == json_type::object) {
+            simdjson::ondemand::object object;
+            if (doc.get_object().get(object) == simdjson::SUCCESS) {
+                WalkObject(object, path, keys);
+            }
+        } else if (type == json_type::array) {
+            simdjson::ondemand::array array;
+            if (doc.get_array().get(array) == simdjson::SUCCESS) {
+                WalkArray(array, path, keys);
+            }
+        }
+    }
+    InvertedPostings::AddRow(builder, keys, offset);
+}
+
+void
+JsonInvertedIndex::Build(size_t n, const Json* values) {
+    if (is_built_) {
+        return;
+    }
+    if (n == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "JsonInvertedIndex cannot build null values!");
+    }
+    InvertedPostings::Builder builder;
+    for (size_t i = 0; i < n; ++i) {
+        AddRow(values[i], i, builder);
+    }
+    postings_.Build(n, builder);
+    is_built_ = true;
+}
+
+void
+JsonInvertedIndex::BuildWithRawData(size_t n,
+                                    const void* values,
+                                    const Config& config) {
+    proto::schema::JSONArray arr;
+    auto ok = arr.ParseFromArray(values, n);
+    Assert(ok);
+
+    std::vector<Json> jsons;
+    jsons.reserve(arr.data_size());
+    for (auto& data : arr.data()) {
+        jsons.emplace_back(simdjson::padded_string(data));
+    }
+    Build(jsons.size(), jsons.data());
+}
+
+void
+JsonInvertedIndex::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+
+    int64_t total_num_rows = 0;
+    InvertedPostings::Builder builder;
+    for (auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        for (int64_t i = 0; i < slice_num; ++i) {
+            auto value = reinterpret_cast<const Json*>(data->RawValue(i));
+            AddRow(*value, total_num_rows++, builder);
+        }
+    }
+    if (total_num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "JsonInvertedIndex cannot build null values!");
+    }
+    postings_.Build(total_num_rows, builder);
+    is_built_ = true;
+}
+
+void
+JsonInvertedIndex::BuildV2(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto field_name = file_manager_->GetIndexMeta().field_name;
+    auto res = space_->ScanData();
+    if (!res.ok()) {
+        PanicInfo(S3Error, "failed to create scan iterator");
+    }
+    auto reader = res.value();
+    int64_t total_num_rows = 0;
+    InvertedPostings::Builder builder;
+    for (auto rec = reader->Next(); rec != nullptr; rec = reader->Next()) {
+        if (!rec.ok()) {
+            PanicInfo(DataFormatBroken, "failed to read data");
+        }
+        auto data = rec.ValueUnsafe();
+        auto num_rows = data->num_rows();
+        auto col_data = data->GetColumnByName(field_name);
+        auto field_data =
+            storage::CreateFieldData(DataType::JSON, 0, num_rows);
+        field_data->FillFieldData(col_data);
+        for (int64_t i = 0; i < field_data->get_num_rows(); ++i) {
+            auto value =
+                reinterpret_cast<const Json*>(field_data->RawValue(i));
+            AddRow(*value, total_num_rows++, builder);
+        }
+    }
+    if (total_num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "JsonInvertedIndex cannot build null values!");
+    }
+    postings_.Build(total_num_rows, builder);
+    is_built_ = true;
+}
+
+BinarySet
+JsonInvertedIndex::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    BinarySet res_set;
+    postings_.Serialize(res_set, "json_index");
+
+    milvus::Disassemble(res_set);
+
+    return res_set;
+}
+
+BinarySet
+JsonInvertedIndex::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+BinarySet
+JsonInvertedIndex::UploadV2(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFileV2(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+void
+JsonInvertedIndex::LoadWithoutAssemble(const BinarySet& binary_set,
+                                       const Config& config) {
+    postings_.Load(binary_set, "json_index");
+    is_built_ = true;
+}
+
+void
+JsonInvertedIndex::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+void
+JsonInvertedIndex::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load json index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+void
+JsonInvertedIndex::LoadV2(const Config& config) {
+    auto blobs = space_->StatisticsBlobs();
+    std::vector<std::string> index_files;
+    auto prefix = file_manager_->GetRemoteIndexObjectPrefixV2();
+    for (auto& b : blobs) {
+        if (b.name.rfind(prefix, 0) == 0) {
+            index_files.push_back(b.name);
+        }
+    }
+    std::map<std::string, FieldDataPtr> index_datas{};
+    for (auto& file_name : index_files) {
+        auto res = space_->GetBlobByteSize(file_name);
+        if (!res.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto index_blob_data =
+            std::shared_ptr<uint8_t[]>(new uint8_t[res.value()]);
+        auto status = space_->ReadBlob(file_name, index_blob_data.get());
+        if (!status.ok()) {
+            PanicInfo(S3Error, "unable to read index blob");
+        }
+        auto raw_index_blob =
+            storage::DeserializeFileData(index_blob_data, res.value());
+        auto key = file_name.substr(file_name.find_last_of('/') + 1);
+        index_datas[key] = raw_index_blob->GetFieldData();
+    }
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+template <typename T>
+bool
+JsonInvertedIndex::MatchValue(const std::string& pointer,
+                              const T& value,
+                              bool element,
+                              TargetBitmap& res) const {
+    auto match = [&](ValueKind kind, const void* data, size_t size) {
+        if (element) {
+            kind = ElementKind(kind);
+        }
+        postings_.Match(EncodeKey(pointer, kind, data, size), res);
+    };
+    if constexpr (std::is_same_v<T, int64_t>) {
+        // the filters read the elements of an array strictly by the type,
+        // but the values by int64 falling back to double
+        match(ValueKind::INT64, &value, sizeof(value));
+        if (element) {
+            return true;
+        }
+        if (value <= -MAX_EXACT_INTEGER || value >= MAX_EXACT_INTEGER) {
+            return false;
+        }
+        auto x = static_cast<double>(value);
+        match(ValueKind::DOUBLE, &x, sizeof(x));
+        return true;
+    } else if constexpr (std::is_same_v<T, double>) {
+        // also rejects NaN
+        if (!(std::abs(value) < MAX_EXACT_INTEGER)) {
+            return false;
+        }
+        double x = value == 0 ? 0 : value;
+        match(ValueKind::DOUBLE, &x, sizeof(x));
+        if (std::floor(x) == x) {
+            auto y = static_cast<int64_t>(x);
+            match(ValueKind::INT64, &y, sizeof(y));
+        }
+        return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        match(ValueKind::BOOL, &value, sizeof(value));
+        return true;
+    } else {
+        static_assert(std::is_same_v<T, std::string>,
+                      "unsupported value type of json index");
+        match(ValueKind::STRING, value.data(), value.size());
+        return true;
+    }
+}
+
+template <typename T>
+std::optional<TargetBitmap>
+JsonInvertedIndex::In(const std::string& pointer,
+                      const std::vector<T>& values) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(postings_.num_rows());
+    for (auto& value : values) {
+        if (!MatchValue(pointer, value, false, res)) {
+            return std::nullopt;
+        }
+    }
+    return res;
+}
+
+template <typename T>
+std::optional<TargetBitmap>
+JsonInvertedIndex::ArrayContainsAny(const std::string& pointer,
+                                    const std::vector<T>& values) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(postings_.num_rows());
+    for (auto& value : values) {
+        if (!MatchValue(pointer, value, true, res)) {
+            return std::nullopt;
+        }
+    }
+    return res;
+}
+
+template <typename T>
+std::optional<TargetBitmap>
+JsonInvertedIndex::ArrayContainsAll(const std::string& pointer,
+                                    const std::vector<T>& values) const {
+    AssertInfo(is_built_, "index has not been built");
+    if (values.empty()) {
+        return std::nullopt;
+    }
+    auto num_rows = postings_.num_rows();
+    TargetBitmap res(num_rows, true);
+    TargetBitmap matched(num_rows);
+    for (auto& value : values) {
+        std::fill(matched.begin(), matched.end(), false);
+        if (!MatchValue(pointer, value, true, matched)) {
+            return std::nullopt;
+        }
+        for (int64_t i = 0; i < num_rows; ++i) {
+            res[i] = res[i] && matched[i];
+        }
+    }
+    return res;
+}
+
+#define INSTANTIATE_JSON_INDEX_LOOKUPS(T)                                     \
+    template std::optional<TargetBitmap> JsonInvertedIndex::In<T>(            \
+        const std::string&, const std::vector<T>&) const;                     \
+    template std::optional<TargetBitmap>                                      \
+    JsonInvertedIndex::ArrayContainsAny<T>(const std::string&,                \
+                                           const std::vector<T>&) const;      \
+    template std::optional<TargetBitmap>                                      \
+    JsonInvertedIndex::ArrayContainsAll<T>(const std::string&,                \
+                                           const std::vector<T>&) const;
+
+INSTANTIATE_JSON_INDEX_LOOKUPS(bool)
+INSTANTIATE_JSON_INDEX_LOOKUPS(int64_t)
+INSTANTIATE_JSON_INDEX_LOOKUPS(double)
+INSTANTIATE_JSON_INDEX_LOOKUPS(std::string)
+
+#undef INSTANTIATE_JSON_INDEX_LOOKUPS
+
+}  // namespace milvus::index
@@ -0,0 +1,156 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/Types.h"
+#include "index/Index.h"
+#include "index/InvertedPostings.h"
+#include "storage/MemFileManagerImpl.h"
+#include "storage/space.h"
+
+namespace milvus::index {
+
+// JsonInvertedIndex maps every (JSON pointer, scalar value) pair found in the
+// rows of a JSON field to the sorted offsets of the rows holding it. The
+// elements of an array are indexed by their positions, e.g. "/arr/0", and the
+// scalar ones are also indexed as elements of the array itself, which answers
+// json_contains.
+//
+// The lookups give the same results as evaluating the filters on the rows,
+// std::nullopt means the index can't tell and the rows must be scanned.
+class JsonInvertedIndex : public IndexBase {
+ public:
+    explicit JsonInvertedIndex(
+        const storage::FileManagerContext& file_manager_context =
+            storage::FileManagerContext());
+
+    explicit JsonInvertedIndex(
+        const storage::FileManagerContext& file_manager_context,
+        std::shared_ptr<milvus_storage::Space> space);
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override;
+
+    void
+    BuildWithRawData(size_t n,
+                     const void* values,
+                     const Config& config = {}) override;
+
+    void
+    BuildWithDataset(const DatasetPtr& dataset,
+                     const Config& config = {}) override {
+        PanicInfo(Unsupported,
+                  "json index don't support build index with dataset");
+    };
+
+    void
+    Build(size_t n, const Json* values);
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override;
+
+    int64_t
+    Count() override {
+        return postings_.num_rows();
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override;
+
+    const bool
+    HasRawData() const override {
+        return false;
+    }
+
+ public:
+    // the rows whose value at the pointer equals any of the values, the same
+    // as `in` and `==` filters on the json field
+    template <typename T>
+    std::optional<TargetBitmap>
+    In(const std::string& pointer, const std::vector<T>& values) const;
+
+    // the rows whose array at the pointer contains any of the values
+    template <typename T>
+    std::optional<TargetBitmap>
+    ArrayContainsAny(const std::string& pointer,
+                     const std::vector<T>& values) const;
+
+    // the rows whose array at the pointer contains all of the values
+    template <typename T>
+    std::optional<TargetBitmap>
+    ArrayContainsAll(const std::string& pointer,
+                     const std::vector<T>& values) const;
+
+    int64_t
+    ByteSize() const override {
+        return postings_.ByteSize();
+    }
+
+ private:
+    void
+    AddRow(const Json& row,
+           uint32_t offset,
+           InvertedPostings::Builder& builder);
+
+    void
+    LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
+
+    // set the rows holding the value at the pointer, directly or as an element
+    // of the array, return false if the index can't tell
+    template <typename T>
+    bool
+    MatchValue(const std::string& pointer,
+               const T& value,
+               bool element,
+               TargetBitmap& res) const;
+
+ private:
+    bool is_built_ = false;
+    // the keys are the encoded (pointer, value) pairs
+    InvertedPostings postings_;
+
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+    std::shared_ptr<milvus_storage::Space> space_;
+};
+
+using JsonInvertedIndexPtr = std::unique_ptr<JsonInvertedIndex>;
+
+}  // namespace milvus::index
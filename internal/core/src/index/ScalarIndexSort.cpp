@@ -14,7 +14,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/mman.h>
+
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <pb/schema.pb.h>
@@ -29,6 +32,7 @@
 #include "common/Types.h"
 #include "index/Utils.h"
 #include "index/ScalarIndexSort.h"
+#include "mmap/Utils.h"
 #include "storage/Util.h"
 
 namespace milvus::index {
@@ -36,7 +40,7 @@ namespace milvus::index {
 template <typename T>
 ScalarIndexSort<T>::ScalarIndexSort(
     const storage::FileManagerContext& file_manager_context)
-    : is_built_(false), data_() {
+    : is_built_(false) {
     if (file_manager_context.Valid()) {
         file_manager_ =
             std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
@@ -48,7 +52,7 @@ template <typename T>
 inline ScalarIndexSort<T>::ScalarIndexSort(
     const storage::FileManagerContext& file_manager_context,
     std::shared_ptr<milvus_storage::Space> space)
-    : is_built_(false), data_(), space_(space) {
+    : is_built_(false), space_(space) {
     if (file_manager_context.Valid()) {
         file_manager_ = std::make_shared<storage::MemFileManagerImpl>(
             file_manager_context, space);
@@ -56,6 +60,77 @@ inline ScalarIndexSort<T>::ScalarIndexSort(
     }
 }
 
+template <typename T>
+ScalarIndexSort<T>::~ScalarIndexSort() {
+    if (mmap_locked_) {
+        MlockBudget::GetInstance().Unlock(mmap_data_, mmap_size_);
+    }
+    if (mmap_data_ != nullptr) {
+        munmap(mmap_data_, mmap_size_);
+    }
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::BuildWithStructures(std::vector<IndexStructure<T>>& data) {
+    std::sort(data.begin(), data.end());
+    size_ = data.size();
+    values_buf_.resize(size_);
+    offsets_buf_.resize(size_);
+    for (int64_t i = 0; i < size_; ++i) {
+        values_buf_[i] = data[i].a_;
+        offsets_buf_[i] = data[i].idx_;
+    }
+    ResetArrays();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::ResetArrays() {
+    size_ = values_buf_.size();
+    row_values_buf_.resize(size_);
+    for (int64_t i = 0; i < size_; ++i) {
+        AssertInfo(offsets_buf_[i] >= 0 && offsets_buf_[i] < size_,
+                   "invalid offset {} of sort index",
+                   offsets_buf_[i]);
+        row_values_buf_[offsets_buf_[i]] = values_buf_[i];
+    }
+    values_ = values_buf_.data();
+    offsets_ = offsets_buf_.data();
+    row_values_ = row_values_buf_.data();
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::MmapArrays(const std::string& filepath) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (size_ == 0) {
+            return;
+        }
+        auto values_size = size_ * sizeof(ValueType);
+        std::vector<size_t> positions;
+        mmap_data_ =
+            MmapBuffers(filepath,
+                        {{values_buf_.data(), values_size},
+                         {offsets_buf_.data(), size_ * sizeof(int32_t)},
+                         {row_values_buf_.data(), values_size}},
+                        positions,
+                        mmap_size_);
+        values_ = reinterpret_cast<const ValueType*>(mmap_data_ + positions[0]);
+        offsets_ = reinterpret_cast<const int32_t*>(mmap_data_ + positions[1]);
+        row_values_ =
+            reinterpret_cast<const ValueType*>(mmap_data_ + positions[2]);
+        std::vector<ValueType>().swap(values_buf_);
+        std::vector<int32_t>().swap(offsets_buf_);
+        std::vector<ValueType>().swap(row_values_buf_);
+    } else {
+        PanicInfo(Unsupported,
+                  "mmap is not supported by sort index of {}",
+                  GetDType<T>());
+    }
+}
+
 template <typename T>
 inline void
 ScalarIndexSort<T>::BuildV2(const Config& config) {
@@ -90,23 +165,18 @@ ScalarIndexSort<T>::BuildV2(const Config& config) {
                            "ScalarIndexSort cannot build null values!");
     }
 
-    data_.reserve(total_num_rows);
+    std::vector<IndexStructure<T>> structures;
+    structures.reserve(total_num_rows);
     int64_t offset = 0;
     for (auto data : field_datas) {
         auto slice_num = data->get_num_rows();
         for (size_t i = 0; i < slice_num; ++i) {
             auto value = reinterpret_cast<const T*>(data->RawValue(i));
-            data_.emplace_back(IndexStructure(*value, offset));
+            structures.emplace_back(IndexStructure(*value, offset));
             offset++;
         }
     }
-
-    std::sort(data_.begin(), data_.end());
-    idx_to_offsets_.resize(total_num_rows);
-    for (size_t i = 0; i < total_num_rows; ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
-    is_built_ = true;
+    BuildWithStructures(structures);
 }
 
 template <typename T>
@@ -130,23 +200,18 @@ ScalarIndexSort<T>::Build(const Config& config) {
                            "ScalarIndexSort cannot build null values!");
     }
 
-    data_.reserve(total_num_rows);
+    std::vector<IndexStructure<T>> structures;
+    structures.reserve(total_num_rows);
     int64_t offset = 0;
     for (auto data : field_datas) {
         auto slice_num = data->get_num_rows();
         for (size_t i = 0; i < slice_num; ++i) {
             auto value = reinterpret_cast<const T*>(data->RawValue(i));
-            data_.emplace_back(IndexStructure(*value, offset));
+            structures.emplace_back(IndexStructure(*value, offset));
             offset++;
         }
     }
-
-    std::sort(data_.begin(), data_.end());
-    idx_to_offsets_.resize(total_num_rows);
-    for (size_t i = 0; i < total_num_rows; ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
-    is_built_ = true;
+    BuildWithStructures(structures);
 }
 
 template <typename T>
@@ -158,17 +223,12 @@ ScalarIndexSort<T>::Build(size_t n, const T* values) {
         throw SegcoreError(DataIsEmpty,
                            "ScalarIndexSort cannot build null values!");
     }
-    data_.reserve(n);
-    idx_to_offsets_.resize(n);
-    T* p = const_cast<T*>(values);
+    std::vector<IndexStructure<T>> structures;
+    structures.reserve(n);
     for (size_t i = 0; i < n; ++i) {
-        data_.emplace_back(IndexStructure(*p++, i));
+        structures.emplace_back(IndexStructure(values[i], i));
     }
-    std::sort(data_.begin(), data_.end());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
-    is_built_ = true;
+    BuildWithStructures(structures);
 }
 
 template <typename T>
@@ -176,17 +236,32 @@ BinarySet
 ScalarIndexSort<T>::Serialize(const Config& config) {
     AssertInfo(is_built_, "index has not been built");
 
-    auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
-    std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
-    memcpy(index_data.get(), data_.data(), index_data_size);
-
-    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
-    auto index_size = data_.size();
-    memcpy(index_length.get(), &index_size, sizeof(size_t));
-
     BinarySet res_set;
-    res_set.Append("index_data", index_data, index_data_size);
-    res_set.Append("index_length", index_length, sizeof(size_t));
+    auto append = [&](const std::string& name, const void* data, size_t size) {
+        std::shared_ptr<uint8_t[]> buf(new uint8_t[size]);
+        if (size > 0) {
+            memcpy(buf.get(), data, size);
+        }
+        res_set.Append(name, buf, size);
+    };
+
+    size_t index_size = size_;
+    append("index_length", &index_size, sizeof(size_t));
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::string values;
+        std::vector<uint64_t> value_offsets{0};
+        for (int64_t i = 0; i < size_; ++i) {
+            values.append(values_[i]);
+            value_offsets.push_back(values.size());
+        }
+        append("index_values", values.data(), values.size());
+        append("index_value_offsets",
+               value_offsets.data(),
+               value_offsets.size() * sizeof(uint64_t));
+    } else {
+        append("index_values", values_, size_ * sizeof(ValueType));
+    }
+    append("index_offsets", offsets_, size_ * sizeof(int32_t));
 
     milvus::Disassemble(res_set);
 
@@ -229,14 +304,67 @@ ScalarIndexSort<T>::LoadWithoutAssemble(const BinarySet& index_binary,
                                         const Config& config) {
     size_t index_size;
     auto index_length = index_binary.GetByName("index_length");
-    memcpy(&index_size, index_length->data.get(), (size_t)index_length->size);
+    AssertInfo(index_length != nullptr &&
+                   index_length->size == sizeof(size_t),
+               "invalid sort index binary");
+    memcpy(&index_size, index_length->data.get(), sizeof(size_t));
+
+    auto get_binary = [&](const std::string& name, size_t size) {
+        auto binary = index_binary.GetByName(name);
+        AssertInfo(binary != nullptr && binary->size == size,
+                   "invalid sort index binary {}",
+                   name);
+        return binary->data.get();
+    };
+    values_buf_.resize(index_size);
+    offsets_buf_.resize(index_size);
+    if (index_binary.GetByName("index_data") != nullptr) {
+        // the index serialized as the structures of the values and offsets
+        if constexpr (std::is_arithmetic_v<T>) {
+            std::vector<IndexStructure<T>> structures(index_size);
+            memcpy(structures.data(),
+                   get_binary("index_data",
+                              index_size * sizeof(IndexStructure<T>)),
+                   index_size * sizeof(IndexStructure<T>));
+            for (size_t i = 0; i < index_size; ++i) {
+                values_buf_[i] = structures[i].a_;
+                offsets_buf_[i] = structures[i].idx_;
+            }
+        } else {
+            PanicInfo(DataFormatBroken,
+                      "unsupported sort index binary of {}",
+                      GetDType<T>());
+        }
+    } else {
+        if constexpr (std::is_same_v<T, std::string>) {
+            std::vector<uint64_t> value_offsets(index_size + 1);
+            memcpy(value_offsets.data(),
+                   get_binary("index_value_offsets",
+                              value_offsets.size() * sizeof(uint64_t)),
+                   value_offsets.size() * sizeof(uint64_t));
+            auto values = reinterpret_cast<const char*>(
+                get_binary("index_values", value_offsets.back()));
+            for (size_t i = 0; i < index_size; ++i) {
+                values_buf_[i].assign(values + value_offsets[i],
+                                      value_offsets[i + 1] - value_offsets[i]);
+            }
+        } else {
+            memcpy(values_buf_.data(),
+                   get_binary("index_values", index_size * sizeof(ValueType)),
+                   index_size * sizeof(ValueType));
+        }
+        memcpy(offsets_buf_.data(),
+               get_binary("index_offsets", index_size * sizeof(int32_t)),
+               index_size * sizeof(int32_t));
+    }
+    ResetArrays();
 
-    auto index_data = index_binary.GetByName("index_data");
-    data_.resize(index_size);
-    idx_to_offsets_.resize(index_size);
-    memcpy(data_.data(), index_data->data.get(), (size_t)index_data->size);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
+    auto filepath = GetValueFromConfig<std::string>(config, kMmapFilepath);
+    if (filepath.has_value()) {
+        MmapArrays(filepath.value());
+        if (mmap_data_ != nullptr) {
+            mmap_locked_ = AdviseMappedIndex(mmap_data_, mmap_size_, config);
+        }
     }
     is_built_ = true;
 }
@@ -314,19 +442,12 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
+    TargetBitmap bitset(size_);
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::In, "
-                             "experted value is: "
-                          << *(values + i) << ", but real value is: " << lb->a_;
-            }
-            bitset[lb->idx_] = true;
+        auto lb = LowerBound(values[i]);
+        auto ub = UpperBound(values[i]);
+        for (auto it = lb; it < ub; ++it) {
+            bitset[offsets_[it - values_]] = true;
         }
     }
     return bitset;
@@ -336,19 +457,12 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size(), true);
+    TargetBitmap bitset(size_, true);
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        for (; lb < ub; ++lb) {
-            if (lb->a_ != *(values + i)) {
-                std::cout << "error happens in ScalarIndexSort<T>::NotIn, "
-                             "experted value is: "
-                          << *(values + i) << ", but real value is: " << lb->a_;
-            }
-            bitset[lb->idx_] = false;
+        auto lb = LowerBound(values[i]);
+        auto ub = UpperBound(values[i]);
+        for (auto it = lb; it < ub; ++it) {
+            bitset[offsets_[it - values_]] = false;
         }
     }
     return bitset;
@@ -358,35 +472,31 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::Range(const T value, const OpType op) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    TargetBitmap bitset(size_);
+    auto lb = values_;
+    auto ub = values_ + size_;
     if (ShouldSkip(value, value, op)) {
         return bitset;
     }
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = LowerBound(value);
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = UpperBound(value);
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = UpperBound(value);
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = LowerBound(value);
             break;
         default:
             throw SegcoreError(OpTypeInvalid,
                                fmt::format("Invalid OperatorType: {}", op));
     }
-    for (; lb < ub; ++lb) {
-        bitset[lb->idx_] = true;
+    for (auto i = lb - values_; i < ub - values_; ++i) {
+        bitset[offsets_[i]] = true;
     }
     return bitset;
 }
@@ -398,7 +508,7 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
                           T upper_bound_value,
                           bool ub_inclusive) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
+    TargetBitmap bitset(size_);
     if (lower_bound_value > upper_bound_value ||
         (lower_bound_value == upper_bound_value &&
          !(lb_inclusive && ub_inclusive))) {
@@ -407,24 +517,12 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
     if (ShouldSkip(lower_bound_value, upper_bound_value, OpType::Range)) {
         return bitset;
     }
-    auto lb = data_.begin();
-    auto ub = data_.end();
-    if (lb_inclusive) {
-        lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    } else {
-        lb = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
-    }
-    if (ub_inclusive) {
-        ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
-    } else {
-        ub = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
-    }
-    for (; lb < ub; ++lb) {
-        bitset[lb->idx_] = true;
+    auto lb = lb_inclusive ? LowerBound(lower_bound_value)
+                           : UpperBound(lower_bound_value);
+    auto ub = ub_inclusive ? UpperBound(upper_bound_value)
+                           : LowerBound(upper_bound_value);
+    for (auto i = lb - values_; i < ub - values_; ++i) {
+        bitset[offsets_[i]] = true;
     }
     return bitset;
 }
@@ -432,11 +530,10 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
 template <typename T>
 T
 ScalarIndexSort<T>::Reverse_Lookup(size_t idx) const {
-    AssertInfo(idx < idx_to_offsets_.size(), "out of range of total count");
+    AssertInfo(idx < static_cast<size_t>(size_), "out of range of total count");
     AssertInfo(is_built_, "index has not been built");
 
-    auto offset = idx_to_offsets_[idx];
-    return data_[offset].a_;
+    return row_values_[idx];
 }
 
 template <typename T>
@@ -444,30 +541,30 @@ bool
 ScalarIndexSort<T>::ShouldSkip(const T lower_value,
                                const T upper_value,
                                const milvus::OpType op) {
-    if (!data_.empty()) {
-        auto lower_bound = data_.begin();
-        auto upper_bound = data_.rbegin();
+    if (size_ > 0) {
+        const T& lower_bound = values_[0];
+        const T& upper_bound = values_[size_ - 1];
         bool shouldSkip = false;
         switch (op) {
             case OpType::LessThan: {
-                shouldSkip = upper_value <= lower_bound->a_;
+                shouldSkip = upper_value <= lower_bound;
                 break;
             }
             case OpType::LessEqual: {
-                shouldSkip = upper_value < lower_bound->a_;
+                shouldSkip = upper_value < lower_bound;
                 break;
             }
             case OpType::GreaterThan: {
-                shouldSkip = lower_value >= upper_bound->a_;
+                shouldSkip = lower_value >= upper_bound;
                 break;
             }
             case OpType::GreaterEqual: {
-                shouldSkip = lower_value > upper_bound->a_;
+                shouldSkip = lower_value > upper_bound;
                 break;
             }
             case OpType::Range: {
-                shouldSkip = (lower_value > upper_bound->a_) ||
-                             (upper_value < lower_bound->a_);
+                shouldSkip = (lower_value > upper_bound) ||
+                             (upper_value < lower_bound);
                 break;
             }
             default:
@@ -22,7 +22,9 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <type_traits>
 
+#include "common/Utils.h"
 #include "index/IndexStructure.h"
 #include "index/ScalarIndex.h"
 #include "storage/MemFileManagerImpl.h"
@@ -30,9 +32,16 @@
 
 namespace milvus::index {
 
+// ScalarIndexSort keeps the values in ascending order and the rows holding
+// them in separate arrays, so the binary searches only touch the values, the
+// values of the rows answer Reverse_Lookup. The arrays of the arithmetic
+// types could be mmap-ed instead of being kept in the heap.
 template <typename T>
 class ScalarIndexSort : public ScalarIndex<T> {
  public:
+    // the bools are kept as bytes as std::vector<bool> is not contiguous
+    using ValueType = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
     explicit ScalarIndexSort(
         const storage::FileManagerContext& file_manager_context =
             storage::FileManagerContext());
@@ -41,6 +50,8 @@ class ScalarIndexSort : public ScalarIndex<T> {
         const storage::FileManagerContext& file_manager_context,
         std::shared_ptr<milvus_storage::Space> space);
 
+    ~ScalarIndexSort() override;
+
     BinarySet
     Serialize(const Config& config) override;
 
@@ -55,7 +66,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Count() override {
-        return data_.size();
+        return size_;
     }
 
     void
@@ -87,7 +98,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Size() override {
-        return (int64_t)data_.size();
+        return size_;
     }
 
     BinarySet
@@ -100,14 +111,43 @@ class ScalarIndexSort : public ScalarIndex<T> {
         return true;
     }
 
+    bool
+    IsMmapSupported() const override {
+        return std::is_arithmetic_v<T>;
+    }
+
+    // the mmap-ed arrays are excluded
+    int64_t
+    ByteSize() const override {
+        int64_t size = (values_buf_.capacity() + row_values_buf_.capacity()) *
+                           sizeof(ValueType) +
+                       offsets_buf_.capacity() * sizeof(int32_t);
+        if constexpr (std::is_same_v<ValueType, std::string>) {
+            for (auto& value : values_buf_) {
+                size += StringHeapByteSize(value);
+            }
+            for (auto& value : row_values_buf_) {
+                size += StringHeapByteSize(value);
+            }
+        }
+        return size;
+    }
+
  private:
     bool
     ShouldSkip(const T lower_value, const T upper_value, const OpType op);
 
  public:
-    const std::vector<IndexStructure<T>>&
-    GetData() {
-        return data_;
+    // the values in ascending order, the ith one is held by the row
+    // GetOffsets()[i]
+    const ValueType*
+    GetValues() const {
+        return values_;
+    }
+
+    const int32_t*
+    GetOffsets() const {
+        return offsets_;
     }
 
     bool
@@ -115,14 +155,52 @@ class ScalarIndexSort : public ScalarIndex<T> {
         return is_built_;
     }
 
+    bool
+    IsMmap() const {
+        return mmap_data_ != nullptr;
+    }
+
     void
     LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
 
+ private:
+    // sort the values and fill the arrays
+    void
+    BuildWithStructures(std::vector<IndexStructure<T>>& data);
+
+    // fill the values of the rows and point the arrays to the buffers
+    void
+    ResetArrays();
+
+    // move the arrays from the heap to the file mmap-ed
+    void
+    MmapArrays(const std::string& filepath);
+
+    const ValueType*
+    LowerBound(const T& value) const {
+        return std::lower_bound(values_, values_ + size_, value);
+    }
+
+    const ValueType*
+    UpperBound(const T& value) const {
+        return std::upper_bound(values_, values_ + size_, value);
+    }
+
  private:
     bool is_built_;
     Config config_;
-    std::vector<int32_t> idx_to_offsets_;  // used to retrieve.
-    std::vector<IndexStructure<T>> data_;
+    int64_t size_ = 0;
+    // point to the buffers below or the mmap-ed file
+    const ValueType* values_ = nullptr;
+    const int32_t* offsets_ = nullptr;
+    const ValueType* row_values_ = nullptr;
+    std::vector<ValueType> values_buf_;
+    std::vector<int32_t> offsets_buf_;
+    std::vector<ValueType> row_values_buf_;
+    char* mmap_data_ = nullptr;
+    size_t mmap_size_ = 0;
+    // locked within the MlockBudget, released before unmapped
+    bool mmap_locked_ = false;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     std::shared_ptr<milvus_storage::Space> space_;
 };
@@ -33,65 +33,37 @@ SkipIndex::LoadPrimitive(milvus::FieldId field_id,
                          int64_t chunk_id,
                          milvus::DataType data_type,
                          const void* chunk_data,
-                         int64_t count) {
+                         int64_t count,
+                         const storage::PayloadStatistics* statistics) {
     auto chunkMetrics = std::make_unique<FieldChunkMetrics>();
 
     if (count > 0) {
         chunkMetrics->hasValue_ = true;
         switch (data_type) {
-            case DataType::INT8: {
-                const int8_t* typedData =
-                    static_cast<const int8_t*>(chunk_data);
-                std::pair<int8_t, int8_t> minMax =
-                    ProcessFieldMetrics<int8_t>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::INT8:
+                LoadPrimitiveMetrics<int8_t>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
-            case DataType::INT16: {
-                const int16_t* typedData =
-                    static_cast<const int16_t*>(chunk_data);
-                std::pair<int16_t, int16_t> minMax =
-                    ProcessFieldMetrics<int16_t>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::INT16:
+                LoadPrimitiveMetrics<int16_t>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
-            case DataType::INT32: {
-                const int32_t* typedData =
-                    static_cast<const int32_t*>(chunk_data);
-                std::pair<int32_t, int32_t> minMax =
-                    ProcessFieldMetrics<int32_t>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::INT32:
+                LoadPrimitiveMetrics<int32_t>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
-            case DataType::INT64: {
-                const int64_t* typedData =
-                    static_cast<const int64_t*>(chunk_data);
-                std::pair<int64_t, int64_t> minMax =
-                    ProcessFieldMetrics<int64_t>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::INT64:
+                LoadPrimitiveMetrics<int64_t>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
-            case DataType::FLOAT: {
-                const float* typedData = static_cast<const float*>(chunk_data);
-                std::pair<float, float> minMax =
-                    ProcessFieldMetrics<float>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::FLOAT:
+                LoadPrimitiveMetrics<float>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
-            case DataType::DOUBLE: {
-                const double* typedData =
-                    static_cast<const double*>(chunk_data);
-                std::pair<double, double> minMax =
-                    ProcessFieldMetrics<double>(typedData, count);
-                chunkMetrics->min_ = Metrics(minMax.first);
-                chunkMetrics->max_ = Metrics(minMax.second);
+            case DataType::DOUBLE:
+                LoadPrimitiveMetrics<double>(
+                    *chunkMetrics, chunk_data, count, statistics);
                 break;
-            }
         }
     }
     std::unique_lock lck(mutex_);
@@ -104,27 +76,61 @@ SkipIndex::LoadPrimitive(milvus::FieldId field_id,
     fieldChunkMetrics_[field_id].emplace(chunk_id, std::move(chunkMetrics));
 }
 
+template <typename FUNC>
 void
-SkipIndex::LoadString(milvus::FieldId field_id,
-                      int64_t chunk_id,
-                      const milvus::VariableColumn<std::string>& var_column) {
-    int num_rows = var_column.NumRows();
+SkipIndex::LoadStringMetrics(milvus::FieldId field_id,
+                             int64_t chunk_id,
+                             int64_t num_rows,
+                             FUNC raw_at) {
     auto chunkMetrics = std::make_unique<FieldChunkMetrics>();
     if (num_rows > 0) {
         chunkMetrics->hasValue_ = true;
-        std::string_view min_string = var_column.RawAt(0);
-        std::string_view max_string = var_column.RawAt(0);
-        for (size_t i = 1; i < num_rows; i++) {
-            const auto& val = var_column.RawAt(i);
+        std::string_view min_string = raw_at(0);
+        std::string_view max_string = raw_at(0);
+        std::vector<uint64_t> hashes;
+        hashes.reserve(num_rows);
+        std::unordered_set<uint64_t> ngrams;
+        std::vector<std::string_view> distinct;
+        bool too_many_distinct = false;
+        for (int64_t i = 0; i < num_rows; i++) {
+            std::string_view val = raw_at(i);
+            if (!too_many_distinct &&
+                std::find(distinct.begin(), distinct.end(), val) ==
+                    distinct.end()) {
+                if (distinct.size() == MAX_DISTINCT_NUM) {
+                    too_many_distinct = true;
+                } else {
+                    distinct.push_back(val);
+                }
+            }
             if (val < min_string) {
                 min_string = val;
             }
             if (val > max_string) {
                 max_string = val;
             }
+            hashes.push_back(HashValue(val));
+            if (ngrams.size() <= MAX_NGRAM_NUM) {
+                ForEachNgram(val, [&](uint64_t ngram) {
+                    ngrams.insert(ngram);
+                });
+            }
         }
         chunkMetrics->min_ = Metrics(min_string);
         chunkMetrics->max_ = Metrics(max_string);
+        chunkMetrics->bloom_filter_ = BuildBloomFilter(hashes);
+        if (ngrams.size() <= MAX_NGRAM_NUM) {
+            std::vector<uint64_t> ngram_hashes;
+            ngram_hashes.reserve(ngrams.size());
+            for (auto ngram : ngrams) {
+                ngram_hashes.push_back(segcore::MixHash(ngram));
+            }
+            chunkMetrics->ngram_filter_ = BuildBloomFilter(ngram_hashes);
+        }
+        if (!too_many_distinct) {
+            std::sort(distinct.begin(), distinct.end());
+            chunkMetrics->distinct_.assign(distinct.begin(), distinct.end());
+        }
     }
     std::unique_lock lck(mutex_);
     if (fieldChunkMetrics_.count(field_id) == 0) {
@@ -135,4 +141,38 @@ SkipIndex::LoadString(milvus::FieldId field_id,
     fieldChunkMetrics_[field_id].emplace(chunk_id, std::move(chunkMetrics));
 }
 
+void
+SkipIndex::LoadString(milvus::FieldId field_id,
+                      int64_t chunk_id,
+                      const milvus::VariableColumn<std::string>& var_column) {
+    LoadStringMetrics(
+        field_id, chunk_id, var_column.NumRows(), [&](int64_t i) {
+            return var_column.RawAt(i);
+        });
+}
+
+void
+SkipIndex::LoadString(milvus::FieldId field_id,
+                      int64_t chunk_id,
+                      const std::string_view* chunk_data,
+                      int64_t count) {
+    LoadStringMetrics(field_id, chunk_id, count, [&](int64_t i) {
+        return chunk_data[i];
+    });
+}
+
+void
+SkipIndex::LoadFieldStats(milvus::FieldId field_id,
+                          std::shared_ptr<const FieldStats> stats) {
+    std::unique_lock lck(mutex_);
+    fieldStats_[field_id] = std::move(stats);
+}
+
+std::shared_ptr<const FieldStats>
+SkipIndex::GetFieldStats(milvus::FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto iter = fieldStats_.find(field_id);
+    return iter != fieldStats_.end() ? iter->second : nullptr;
+}
+
 }  // namespace milvus
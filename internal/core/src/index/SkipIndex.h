@@ -10,11 +10,22 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "common/LikePattern.h"
 #include "common/Types.h"
+#include "index/FieldStats.h"
 #include "log/Log.h"
 #include "mmap/Column.h"
+#include "segcore/BloomFilter.h"
+#include "storage/PayloadStatistics.h"
 
 namespace milvus {
 
@@ -25,10 +36,34 @@ template <typename T>
 using MetricsDataType =
     std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
 
+// how many rows of a block satisfy a filter, by the zone map of the block
+enum class BlockMatch { Some, None, All };
+
+// the zone map of a block of the rows of a chunk, NaN isn't counted in the
+// range of the floats
+struct BlockMetrics {
+    Metrics min_;
+    Metrics max_;
+    bool hasValue_ = false;
+    bool hasNaN_ = false;
+};
+
 struct FieldChunkMetrics {
     Metrics min_;
     Metrics max_;
     bool hasValue_;
+    // the hashes of the values, rules out equality and term filters on the
+    // high cardinality fields min and max can't
+    segcore::SplitBlockBloomFilter bloom_filter_;
+    // the hashes of the trigrams of the strings, rules out prefix and postfix
+    // matches, empty if the chunk has too many distinct trigrams
+    segcore::SplitBlockBloomFilter ngram_filter_;
+    // the zone maps of the blocks of SkipIndex::BLOCK_ROWS rows of the chunk
+    // of a numeric field, empty if the chunk is a single block
+    std::vector<BlockMetrics> blocks_;
+    // the sorted distinct values of the chunk of an integer or string field,
+    // like a partition key, empty if the chunk holds too many of them
+    std::vector<Metrics> distinct_;
 
     FieldChunkMetrics() : hasValue_(false){};
 };
@@ -45,10 +80,268 @@ class SkipIndex {
         if (MinMaxUnaryFilter<T>(field_chunk_metrics, op_type, val)) {
             return true;
         }
-        //further more filters for skip, like ngram filter, bf and so on
+        if constexpr (IsAllowedType<T>::value) {
+            if (!HasMetrics<T>(field_chunk_metrics)) {
+                return false;
+            }
+            if (op_type == OpType::Equal) {
+                if (!field_chunk_metrics.distinct_.empty()) {
+                    return DistinctMatch<T>(field_chunk_metrics,
+                                            std::vector<T>{val}) ==
+                           BlockMatch::None;
+                }
+                return !field_chunk_metrics.bloom_filter_.MayContain(
+                    HashValue(val));
+            }
+            if constexpr (std::is_same_v<T, std::string> ||
+                          std::is_same_v<T, std::string_view>) {
+                if (op_type == OpType::PrefixMatch ||
+                    op_type == OpType::PostfixMatch) {
+                    return NgramFilter(field_chunk_metrics, val);
+                }
+            }
+        }
         return false;
     }
 
+    // whether none of the rows of the chunk matches the LIKE pattern, by the
+    // trigrams of the literals of the pattern
+    template <typename T>
+    bool
+    CanSkipLike(FieldId field_id,
+                int64_t chunk_id,
+                const LikePattern& pattern) const {
+        if constexpr (std::is_same_v<T, std::string> ||
+                      std::is_same_v<T, std::string_view>) {
+            auto& field_chunk_metrics =
+                GetFieldChunkMetrics(field_id, chunk_id);
+            if (!HasMetrics<T>(field_chunk_metrics)) {
+                return false;
+            }
+            for (auto& literal : pattern.literals()) {
+                if (NgramFilter(field_chunk_metrics, literal)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // whether none of the rows of the chunk is one of the values, by the range
+    // and the bloom filter of the chunk
+    template <typename T, typename ValueType>
+    bool
+    CanSkipTerm(FieldId field_id,
+                int64_t chunk_id,
+                const std::vector<ValueType>& values) const {
+        if constexpr (IsAllowedType<T>::value) {
+            auto& field_chunk_metrics =
+                GetFieldChunkMetrics(field_id, chunk_id);
+            if (!HasMetrics<T>(field_chunk_metrics)) {
+                return false;
+            }
+            if (!field_chunk_metrics.distinct_.empty()) {
+                return DistinctMatch<T>(field_chunk_metrics, values) ==
+                       BlockMatch::None;
+            }
+            auto [lower_bound, upper_bound] = GetMinMax<T>(field_chunk_metrics);
+            for (const auto& val : values) {
+                if (lower_bound <= val && val <= upper_bound &&
+                    field_chunk_metrics.bloom_filter_.MayContain(
+                        HashValue(val))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // whether no row of the chunk satisfies `left op right`, by the ranges of
+    // the two fields
+    template <typename T, typename U>
+    bool
+    CanSkipCompare(FieldId left_field_id,
+                   FieldId right_field_id,
+                   int64_t chunk_id,
+                   OpType op_type) const {
+        if constexpr (IsAllowedType<T>::value && IsAllowedType<U>::value) {
+            auto& left_metrics = GetFieldChunkMetrics(left_field_id, chunk_id);
+            auto& right_metrics =
+                GetFieldChunkMetrics(right_field_id, chunk_id);
+            if (!HasMetrics<T>(left_metrics) || !HasMetrics<U>(right_metrics)) {
+                return false;
+            }
+            auto [left_min, left_max] = GetMinMax<T>(left_metrics);
+            auto [right_min, right_max] = GetMinMax<U>(right_metrics);
+            switch (op_type) {
+                case OpType::Equal:
+                    return left_max < right_min || right_max < left_min;
+                case OpType::LessThan:
+                    return left_min >= right_max;
+                case OpType::LessEqual:
+                    return left_min > right_max;
+                case OpType::GreaterThan:
+                    return left_max <= right_min;
+                case OpType::GreaterEqual:
+                    return left_max < right_min;
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    // the number of the blocks of the chunk with a zone map, 0 if none
+    int64_t
+    NumBlocks(FieldId field_id, int64_t chunk_id) const {
+        return GetFieldChunkMetrics(field_id, chunk_id).blocks_.size();
+    }
+
+    // how many rows of the block satisfy `x op val`
+    template <typename T>
+    BlockMatch
+    UnaryRangeBlockMatch(FieldId field_id,
+                         int64_t chunk_id,
+                         int64_t block_id,
+                         OpType op_type,
+                         const T& val) const {
+        if constexpr (IsAllowedType<T>::value) {
+            // the answer of a chunk of few distinct values holds for each
+            // block of it
+            auto& field_chunk_metrics =
+                GetFieldChunkMetrics(field_id, chunk_id);
+            if ((op_type == OpType::Equal || op_type == OpType::NotEqual) &&
+                HasMetrics<T>(field_chunk_metrics) &&
+                !field_chunk_metrics.distinct_.empty()) {
+                auto match =
+                    DistinctMatch<T>(field_chunk_metrics, std::vector<T>{val});
+                if (op_type == OpType::NotEqual && match != BlockMatch::Some) {
+                    match = match == BlockMatch::All ? BlockMatch::None
+                                                     : BlockMatch::All;
+                }
+                return match;
+            }
+        }
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            auto& blocks = GetFieldChunkMetrics(field_id, chunk_id).blocks_;
+            if (block_id >= int64_t(blocks.size()) ||
+                !HasBlockMetrics<T>(blocks[block_id])) {
+                return BlockMatch::Some;
+            }
+            auto& block = blocks[block_id];
+            auto lower_bound = std::get<T>(block.min_);
+            auto upper_bound = std::get<T>(block.max_);
+            // NaN satisfies none of the filters but NotEqual
+            auto all = !block.hasNaN_;
+            bool none = false;
+            switch (op_type) {
+                case OpType::GreaterThan:
+                    none = upper_bound <= val;
+                    all = all && lower_bound > val;
+                    break;
+                case OpType::GreaterEqual:
+                    none = upper_bound < val;
+                    all = all && lower_bound >= val;
+                    break;
+                case OpType::LessThan:
+                    none = lower_bound >= val;
+                    all = all && upper_bound < val;
+                    break;
+                case OpType::LessEqual:
+                    none = lower_bound > val;
+                    all = all && upper_bound <= val;
+                    break;
+                case OpType::Equal:
+                    none = val < lower_bound || val > upper_bound;
+                    all = all && lower_bound == val && upper_bound == val;
+                    break;
+                case OpType::NotEqual:
+                    none = !block.hasNaN_ && lower_bound == val &&
+                           upper_bound == val;
+                    all = val < lower_bound || val > upper_bound;
+                    break;
+                default:
+                    return BlockMatch::Some;
+            }
+            return none ? BlockMatch::None
+                        : (all ? BlockMatch::All : BlockMatch::Some);
+        }
+        return BlockMatch::Some;
+    }
+
+    // how many rows of the block satisfy `x in values`, by the distinct values
+    // of the chunk, the values are sorted and unique
+    template <typename T, typename ValueType>
+    BlockMatch
+    TermBlockMatch(FieldId field_id,
+                   int64_t chunk_id,
+                   int64_t block_id,
+                   const std::vector<ValueType>& values) const {
+        if constexpr (IsAllowedType<T>::value) {
+            auto& field_chunk_metrics =
+                GetFieldChunkMetrics(field_id, chunk_id);
+            if (HasMetrics<T>(field_chunk_metrics) &&
+                !field_chunk_metrics.distinct_.empty()) {
+                return DistinctMatch<T>(field_chunk_metrics, values);
+            }
+        }
+        return BlockMatch::Some;
+    }
+
+    // how many rows of the block satisfy `lower_val op x op upper_val`
+    template <typename T, typename ValueType>
+    BlockMatch
+    BinaryRangeBlockMatch(FieldId field_id,
+                          int64_t chunk_id,
+                          int64_t block_id,
+                          const ValueType& lower_val,
+                          const ValueType& upper_val,
+                          bool lower_inclusive,
+                          bool upper_inclusive) const {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            auto& blocks = GetFieldChunkMetrics(field_id, chunk_id).blocks_;
+            if (block_id >= int64_t(blocks.size()) ||
+                !HasBlockMetrics<T>(blocks[block_id])) {
+                return BlockMatch::Some;
+            }
+            auto& block = blocks[block_id];
+            auto lower_bound = std::get<T>(block.min_);
+            auto upper_bound = std::get<T>(block.max_);
+            auto above_lower = [&](auto x) {
+                return lower_inclusive ? lower_val <= x : lower_val < x;
+            };
+            auto below_upper = [&](auto x) {
+                return upper_inclusive ? x <= upper_val : x < upper_val;
+            };
+            if (!above_lower(upper_bound) || !below_upper(lower_bound)) {
+                return BlockMatch::None;
+            }
+            if (!block.hasNaN_ && above_lower(lower_bound) &&
+                below_upper(upper_bound)) {
+                return BlockMatch::All;
+            }
+        }
+        return BlockMatch::Some;
+    }
+
+    // the min and max of the block by the zone map, without NaN, nullopt if
+    // the block has no zone map
+    template <typename T>
+    std::optional<std::pair<T, T>>
+    BlockMinMax(FieldId field_id, int64_t chunk_id, int64_t block_id) const {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            auto& blocks = GetFieldChunkMetrics(field_id, chunk_id).blocks_;
+            if (block_id < int64_t(blocks.size()) &&
+                HasBlockMetrics<T>(blocks[block_id])) {
+                auto& block = blocks[block_id];
+                return std::make_pair(std::get<T>(block.min_),
+                                      std::get<T>(block.max_));
+            }
+        }
+        return std::nullopt;
+    }
+
     template <typename T>
     bool
     CanSkipBinaryRange(FieldId field_id,
@@ -68,19 +361,45 @@ class SkipIndex {
         return false;
     }
 
+    // the range of the chunk is taken from the statistics of the binlogs of
+    // it if they're given and cover all the rows, instead of being scanned
     void
     LoadPrimitive(milvus::FieldId field_id,
                   int64_t chunk_id,
                   milvus::DataType data_type,
                   const void* chunk_data,
-                  int64_t count);
+                  int64_t count,
+                  const storage::PayloadStatistics* statistics = nullptr);
 
     void
     LoadString(milvus::FieldId field_id,
                int64_t chunk_id,
                const milvus::VariableColumn<std::string>& var_column);
 
+    // the strings of a chunk of a growing segment
+    void
+    LoadString(milvus::FieldId field_id,
+               int64_t chunk_id,
+               const std::string_view* chunk_data,
+               int64_t count);
+
+    // the statistics of all the values of a field of a sealed segment
+    void
+    LoadFieldStats(milvus::FieldId field_id,
+                   std::shared_ptr<const FieldStats> stats);
+
+    // nullptr if the field has none
+    std::shared_ptr<const FieldStats>
+    GetFieldStats(milvus::FieldId field_id) const;
+
  private:
+    template <typename FUNC>
+    void
+    LoadStringMetrics(milvus::FieldId field_id,
+                      int64_t chunk_id,
+                      int64_t num_rows,
+                      FUNC raw_at);
+
     const FieldChunkMetrics&
     GetFieldChunkMetrics(FieldId field_id, int chunk_id) const;
 
@@ -96,6 +415,86 @@ class SkipIndex {
         static constexpr bool value = isAllowedType && !isDisabledType;
     };
 
+    // the metrics are only compared with the values of the type of the field
+    template <typename T>
+    bool
+    HasMetrics(const FieldChunkMetrics& field_chunk_metrics) const {
+        return field_chunk_metrics.hasValue_ &&
+               std::holds_alternative<MetricsDataType<T>>(
+                   field_chunk_metrics.min_);
+    }
+
+    template <typename T>
+    static bool
+    HasBlockMetrics(const BlockMetrics& block) {
+        return block.hasValue_ && std::holds_alternative<T>(block.min_);
+    }
+
+    // the integers are hashed as int64 and the floats as double
+    template <typename T>
+    static uint64_t
+    HashValue(const T& val) {
+        if constexpr (std::is_same_v<T, std::string> ||
+                      std::is_same_v<T, std::string_view>) {
+            return segcore::HashPk(std::string_view(val));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // -0.0 equals 0.0
+            double d = val == 0 ? 0 : static_cast<double>(val);
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return segcore::MixHash(bits);
+        } else {
+            return segcore::MixHash(
+                static_cast<uint64_t>(static_cast<int64_t>(val)));
+        }
+    }
+
+    static constexpr size_t NGRAM_SIZE = 3;
+
+    // the bytes of every trigram packed into the lower 24 bits
+    template <typename FUNC>
+    static void
+    ForEachNgram(std::string_view str, FUNC func) {
+        for (size_t i = 0; i + NGRAM_SIZE <= str.size(); ++i) {
+            func(uint64_t(uint8_t(str[i])) |
+                 uint64_t(uint8_t(str[i + 1])) << 8 |
+                 uint64_t(uint8_t(str[i + 2])) << 16);
+        }
+    }
+
+    // a string matching the pattern holds every trigram of it
+    bool
+    NgramFilter(const FieldChunkMetrics& field_chunk_metrics,
+                std::string_view pattern) const {
+        bool skip = false;
+        ForEachNgram(pattern, [&](uint64_t ngram) {
+            skip = skip || !field_chunk_metrics.ngram_filter_.MayContain(
+                               segcore::MixHash(ngram));
+        });
+        return skip;
+    }
+
+    // how many rows of the chunk are one of the sorted values, the chunk has
+    // distinct values
+    template <typename T, typename ValueType>
+    static BlockMatch
+    DistinctMatch(const FieldChunkMetrics& field_chunk_metrics,
+                  const std::vector<ValueType>& values) {
+        size_t matched = 0;
+        for (const auto& metrics : field_chunk_metrics.distinct_) {
+            auto value = std::get<MetricsDataType<T>>(metrics);
+            if (std::binary_search(values.begin(), values.end(), value)) {
+                ++matched;
+            }
+        }
+        if (matched == 0) {
+            return BlockMatch::None;
+        }
+        return matched == field_chunk_metrics.distinct_.size()
+                   ? BlockMatch::All
+                   : BlockMatch::Some;
+    }
+
     template <typename T>
     std::pair<MetricsDataType<T>, MetricsDataType<T>>
     GetMinMax(const FieldChunkMetrics& field_chunk_metrics) const {
@@ -217,6 +616,56 @@ class SkipIndex {
         return should_skip;
     }
 
+    template <typename T>
+    void
+    LoadPrimitiveMetrics(FieldChunkMetrics& chunk_metrics,
+                         const void* chunk_data,
+                         int64_t count,
+                         const storage::PayloadStatistics* statistics) {
+        auto data = static_cast<const T*>(chunk_data);
+        if (statistics != nullptr && statistics->num_rows == count &&
+            statistics->null_count == 0 && statistics->min.has_value()) {
+            auto narrow = [](const storage::PayloadStatistics::Value& value) {
+                return std::visit([](auto v) { return static_cast<T>(v); },
+                                  value);
+            };
+            chunk_metrics.min_ = Metrics(narrow(*statistics->min));
+            chunk_metrics.max_ = Metrics(narrow(*statistics->max));
+        } else {
+            auto [min, max] = ProcessFieldMetrics<T>(data, count);
+            chunk_metrics.min_ = Metrics(min);
+            chunk_metrics.max_ = Metrics(max);
+        }
+        chunk_metrics.bloom_filter_ = ProcessBloomFilter<T>(data, count);
+        chunk_metrics.blocks_ = ProcessBlockMetrics<T>(data, count);
+        if constexpr (std::is_integral_v<T>) {
+            chunk_metrics.distinct_ = ProcessDistinct<T>(data, count);
+        }
+    }
+
+    // the sorted distinct values, none if there are more than
+    // MAX_DISTINCT_NUM, a high cardinality chunk is given up after a few rows
+    template <typename T>
+    std::vector<Metrics>
+    ProcessDistinct(const T* data, int64_t count) {
+        std::vector<T> values;
+        if (data == nullptr) {
+            return {};
+        }
+        for (int64_t i = 0; i < count; i++) {
+            if (std::find(values.begin(), values.end(), data[i]) !=
+                values.end()) {
+                continue;
+            }
+            if (values.size() == MAX_DISTINCT_NUM) {
+                return {};
+            }
+            values.push_back(data[i]);
+        }
+        std::sort(values.begin(), values.end());
+        return std::vector<Metrics>(values.begin(), values.end());
+    }
+
     template <typename T>
     std::pair<T, T>
     ProcessFieldMetrics(const T* data, int64_t count) {
@@ -238,11 +687,91 @@ class SkipIndex {
         return {minValue, maxValue};
     }
 
+    // the zone maps of the blocks, none if the chunk is a single block
+    template <typename T>
+    std::vector<BlockMetrics>
+    ProcessBlockMetrics(const T* data, int64_t count) {
+        std::vector<BlockMetrics> blocks;
+        if (count <= BLOCK_ROWS) {
+            return blocks;
+        }
+        blocks.resize((count + BLOCK_ROWS - 1) / BLOCK_ROWS);
+        for (int64_t block_id = 0; block_id < blocks.size(); ++block_id) {
+            auto& block = blocks[block_id];
+            auto begin = block_id * BLOCK_ROWS;
+            auto end = std::min(count, begin + BLOCK_ROWS);
+            T minValue{};
+            T maxValue{};
+            for (auto i = begin; i < end; i++) {
+                T value = data[i];
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (std::isnan(value)) {
+                        block.hasNaN_ = true;
+                        continue;
+                    }
+                }
+                if (!block.hasValue_ || value < minValue) {
+                    minValue = value;
+                }
+                if (!block.hasValue_ || value > maxValue) {
+                    maxValue = value;
+                }
+                block.hasValue_ = true;
+            }
+            block.min_ = Metrics(minValue);
+            block.max_ = Metrics(maxValue);
+        }
+        return blocks;
+    }
+
+    template <typename T>
+    segcore::SplitBlockBloomFilter
+    ProcessBloomFilter(const T* data, int64_t count) {
+        std::vector<uint64_t> hashes;
+        hashes.reserve(count);
+        for (int64_t i = 0; i < count; i++) {
+            if constexpr (std::is_floating_point_v<T>) {
+                // NaN equals nothing
+                if (std::isnan(data[i])) {
+                    continue;
+                }
+            }
+            hashes.push_back(HashValue(data[i]));
+        }
+        return BuildBloomFilter(hashes);
+    }
+
+    // the filter is sized by the number of the distinct hashes
+    static segcore::SplitBlockBloomFilter
+    BuildBloomFilter(std::vector<uint64_t>& hashes) {
+        std::sort(hashes.begin(), hashes.end());
+        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+        segcore::SplitBlockBloomFilter filter(hashes.size());
+        for (auto hash : hashes) {
+            filter.Add(hash);
+        }
+        return filter;
+    }
+
+    // a chunk holding more distinct trigrams than this gets no ngram filter,
+    // it would take a lot of memory and rule out few patterns
+    static constexpr size_t MAX_NGRAM_NUM = 1 << 20;
+
+    // a chunk holding more distinct values than this keeps none of them, the
+    // filters on it can only be decided row by row
+    static constexpr size_t MAX_DISTINCT_NUM = 16;
+
+ public:
+    // the rows of a block of a chunk share a zone map
+    static constexpr int64_t BLOCK_ROWS = 4096;
+
  private:
     std::unordered_map<
         FieldId,
         std::unordered_map<int64_t, std::unique_ptr<FieldChunkMetrics>>>
         fieldChunkMetrics_;
+    std::unordered_map<FieldId, std::shared_ptr<const FieldStats>>
+        fieldStats_;
     mutable std::shared_mutex mutex_;
 };
 }  // namespace milvus
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/LikePattern.h"
 #include "index/Meta.h"
 #include "index/ScalarIndex.h"
 
@@ -36,11 +37,22 @@ class StringIndex : public ScalarIndex<std::string> {
             auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
             return PrefixMatch(prefix);
         }
+        if (op == OpType::PostfixMatch || op == OpType::Match) {
+            auto value = dataset->Get<std::string>(MATCH_VALUE);
+            return PatternMatch(op == OpType::PostfixMatch
+                                    ? LikePattern::Postfix(value)
+                                    : LikePattern(value));
+        }
         return ScalarIndex<std::string>::Query(dataset);
     }
 
     virtual const TargetBitmap
     PrefixMatch(const std::string_view prefix) = 0;
+
+    // the rows matching the LIKE pattern, the strings within the range of the
+    // literal prefix of the pattern are matched one by one
+    virtual const TargetBitmap
+    PatternMatch(const LikePattern& pattern) = 0;
 };
 using StringIndexPtr = std::unique_ptr<StringIndex>;
 }  // namespace milvus::index
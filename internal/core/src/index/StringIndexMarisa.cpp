@@ -17,10 +17,16 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <limits>
 #include <memory>
 #include <stdlib.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <numeric>
 
 #include "common/Types.h"
 #include "common/EasyAssert.h"
@@ -30,6 +36,7 @@
 #include "index/StringIndexMarisa.h"
 #include "index/Utils.h"
 #include "index/Index.h"
+#include "mmap/Utils.h"
 #include "storage/Util.h"
 #include "storage/space.h"
 
@@ -53,6 +60,15 @@ StringIndexMarisa::StringIndexMarisa(
     }
 }
 
+StringIndexMarisa::~StringIndexMarisa() {
+    if (mmap_locked_) {
+        MlockBudget::GetInstance().Unlock(mmap_data_, mmap_size_);
+    }
+    if (mmap_data_ != nullptr) {
+        munmap(mmap_data_, mmap_size_);
+    }
+}
+
 int64_t
 StringIndexMarisa::Size() {
     return trie_.size();
@@ -102,7 +118,7 @@ StringIndexMarisa::BuildV2(const Config& config) {
     trie_.build(keyset);
 
     // fill str_ids_
-    str_ids_.resize(total_num_rows);
+    str_ids_buf_.resize(total_num_rows);
     int64_t offset = 0;
     for (auto data : field_datas) {
         auto slice_num = data->get_num_rows();
@@ -110,11 +126,11 @@ StringIndexMarisa::BuildV2(const Config& config) {
             auto str_id =
                 lookup(*static_cast<const std::string*>(data->RawValue(i)));
             AssertInfo(valid_str_id(str_id), "invalid marisa key");
-            str_ids_[offset++] = str_id;
+            str_ids_buf_[offset++] = str_id;
         }
     }
 
-    // fill str_ids_to_offsets_
+    // fill the offsets of every str id
     fill_offsets();
 
     built_ = true;
@@ -146,7 +162,7 @@ StringIndexMarisa::Build(const Config& config) {
     trie_.build(keyset);
 
     // fill str_ids_
-    str_ids_.resize(total_num_rows);
+    str_ids_buf_.resize(total_num_rows);
     int64_t offset = 0;
     for (const auto& data : field_datas) {
         auto slice_num = data->get_num_rows();
@@ -154,11 +170,11 @@ StringIndexMarisa::Build(const Config& config) {
             auto str_id =
                 lookup(*static_cast<const std::string*>(data->RawValue(i)));
             AssertInfo(valid_str_id(str_id), "invalid marisa key");
-            str_ids_[offset++] = str_id;
+            str_ids_buf_[offset++] = str_id;
         }
     }
 
-    // fill str_ids_to_offsets_
+    // fill the offsets of every str id
     fill_offsets();
 
     built_ = true;
@@ -203,9 +219,9 @@ StringIndexMarisa::Serialize(const Config& config) {
     close(fd);
     remove(file.c_str());
 
-    auto str_ids_len = str_ids_.size() * sizeof(size_t);
+    auto str_ids_len = num_rows_ * sizeof(size_t);
     std::shared_ptr<uint8_t[]> str_ids(new uint8_t[str_ids_len]);
-    memcpy(str_ids.get(), str_ids_.data(), str_ids_len);
+    memcpy(str_ids.get(), str_ids_, str_ids_len);
 
     BinarySet res_set;
     res_set.Append(MARISA_TRIE_INDEX, index_data, size);
@@ -274,10 +290,65 @@ StringIndexMarisa::LoadWithoutAssemble(const BinarySet& set,
 
     auto str_ids = set.GetByName(MARISA_STR_IDS);
     auto str_ids_len = str_ids->size;
-    str_ids_.resize(str_ids_len / sizeof(size_t));
-    memcpy(str_ids_.data(), str_ids->data.get(), str_ids_len);
+    str_ids_buf_.resize(str_ids_len / sizeof(size_t));
+    memcpy(str_ids_buf_.data(), str_ids->data.get(), str_ids_len);
 
     fill_offsets();
+
+    if (config.contains(kMmapFilepath)) {
+        auto filepath = GetValueFromConfig<std::string>(config, kMmapFilepath);
+        Mmap(filepath.value(), index);
+        mmap_locked_ = AdviseMappedIndex(mmap_data_, mmap_size_, config);
+    }
+}
+
+void
+StringIndexMarisa::Mmap(const std::string& filepath, const BinaryPtr& trie) {
+    // the trie maps the file itself, which must outlive the trie, so it is
+    // unlinked only after being mapped like the file of the arrays
+    auto trie_path = filepath + ".trie";
+    std::filesystem::create_directories(
+        std::filesystem::path(filepath).parent_path());
+    {
+        auto file = File::Open(trie_path, O_CREAT | O_TRUNC | O_RDWR);
+        auto written = file.Write(trie->data.get(), trie->size);
+        AssertInfo(written == static_cast<ssize_t>(trie->size),
+                   "failed to write marisa trie to {}, written {} of {}",
+                   trie_path,
+                   written,
+                   trie->size);
+        file.Close();
+    }
+    marisa::Trie mapped;
+    mapped.mmap(trie_path.c_str());
+    unlink(trie_path.c_str());
+    trie_.swap(mapped);
+
+    auto num_keys = trie_.size();
+    std::vector<size_t> positions;
+    mmap_data_ = MmapBuffers(
+        filepath,
+        {{str_ids_, num_rows_ * sizeof(size_t)},
+         {ranked_ids_, num_keys * sizeof(uint32_t)},
+         {id_ranks_, num_keys * sizeof(uint32_t)},
+         {rank_begins_, (num_keys + 1) * sizeof(uint64_t)},
+         {rank_offsets_, num_rows_ * sizeof(uint32_t)}},
+        positions,
+        mmap_size_);
+    str_ids_ = reinterpret_cast<const size_t*>(mmap_data_ + positions[0]);
+    ranked_ids_ =
+        reinterpret_cast<const uint32_t*>(mmap_data_ + positions[1]);
+    id_ranks_ = reinterpret_cast<const uint32_t*>(mmap_data_ + positions[2]);
+    rank_begins_ =
+        reinterpret_cast<const uint64_t*>(mmap_data_ + positions[3]);
+    rank_offsets_ =
+        reinterpret_cast<const uint32_t*>(mmap_data_ + positions[4]);
+
+    std::vector<size_t>().swap(str_ids_buf_);
+    std::vector<uint32_t>().swap(ranked_ids_buf_);
+    std::vector<uint32_t>().swap(id_ranks_buf_);
+    std::vector<uint64_t>().swap(rank_begins_buf_);
+    std::vector<uint32_t>().swap(rank_offsets_buf_);
 }
 
 void
@@ -348,15 +419,13 @@ StringIndexMarisa::LoadV2(const Config& config) {
 
 const TargetBitmap
 StringIndexMarisa::In(size_t n, const std::string* values) {
-    TargetBitmap bitset(str_ids_.size());
+    TargetBitmap bitset(num_rows_);
     for (size_t i = 0; i < n; i++) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = true;
-            }
+            auto rank = id_ranks_[str_id];
+            set_offsets(rank, rank + 1, bitset, true);
         }
     }
     return bitset;
@@ -364,15 +433,13 @@ StringIndexMarisa::In(size_t n, const std::string* values) {
 
 const TargetBitmap
 StringIndexMarisa::NotIn(size_t n, const std::string* values) {
-    TargetBitmap bitset(str_ids_.size(), true);
+    TargetBitmap bitset(num_rows_, true);
     for (size_t i = 0; i < n; i++) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = false;
-            }
+            auto rank = id_ranks_[str_id];
+            set_offsets(rank, rank + 1, bitset, false);
         }
     }
     return bitset;
@@ -382,34 +449,28 @@ const TargetBitmap
 StringIndexMarisa::Range(std::string value, OpType op) {
     auto count = Count();
     TargetBitmap bitset(count);
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = false;
-        switch (op) {
-            case OpType::LessThan:
-                set = raw_data.compare(value) < 0;
-                break;
-            case OpType::LessEqual:
-                set = raw_data.compare(value) <= 0;
-                break;
-            case OpType::GreaterThan:
-                set = raw_data.compare(value) > 0;
-                break;
-            case OpType::GreaterEqual:
-                set = raw_data.compare(value) >= 0;
-                break;
-            default:
-                throw SegcoreError(OpTypeInvalid,
-                                   fmt::format("Invalid OperatorType: {}",
-                                               static_cast<int>(op)));
-        }
-        if (set) {
-            bitset[offset] = true;
-        }
+    // the matched strings are a range of ranks
+    size_t begin = 0;
+    size_t end = trie_.size();
+    switch (op) {
+        case OpType::LessThan:
+            end = rank_bound(value, false);
+            break;
+        case OpType::LessEqual:
+            end = rank_bound(value, true);
+            break;
+        case OpType::GreaterThan:
+            begin = rank_bound(value, true);
+            break;
+        case OpType::GreaterEqual:
+            begin = rank_bound(value, false);
+            break;
+        default:
+            throw SegcoreError(
+                OpTypeInvalid,
+                fmt::format("Invalid OperatorType: {}", static_cast<int>(op)));
     }
+    set_offsets(begin, end, bitset, true);
     return bitset;
 }
 
@@ -425,37 +486,29 @@ StringIndexMarisa::Range(std::string lower_bound_value,
          !(lb_inclusive && ub_inclusive))) {
         return bitset;
     }
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = true;
-        if (lb_inclusive) {
-            set &= raw_data.compare(lower_bound_value) >= 0;
-        } else {
-            set &= raw_data.compare(lower_bound_value) > 0;
-        }
-        if (ub_inclusive) {
-            set &= raw_data.compare(upper_bound_value) <= 0;
-        } else {
-            set &= raw_data.compare(upper_bound_value) < 0;
-        }
-        if (set) {
-            bitset[offset] = true;
-        }
-    }
+    auto begin = rank_bound(lower_bound_value, !lb_inclusive);
+    auto end = rank_bound(upper_bound_value, ub_inclusive);
+    set_offsets(begin, end, bitset, true);
     return bitset;
 }
 
 const TargetBitmap
 StringIndexMarisa::PrefixMatch(std::string_view prefix) {
-    TargetBitmap bitset(str_ids_.size());
-    auto matched = prefix_match(prefix);
-    for (const auto str_id : matched) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset[offset] = true;
+    TargetBitmap bitset(num_rows_);
+    auto [begin, end] = prefix_ranks(prefix);
+    set_offsets(begin, end, bitset, true);
+    return bitset;
+}
+
+const TargetBitmap
+StringIndexMarisa::PatternMatch(const LikePattern& pattern) {
+    TargetBitmap bitset(num_rows_);
+    // each distinct string starting with the prefix is matched once
+    auto [begin, end] = prefix_ranks(pattern.prefix());
+    marisa::Agent agent;
+    for (auto rank = begin; rank < end; ++rank) {
+        if (pattern.Match(key_of(ranked_ids_[rank], agent))) {
+            set_offsets(rank, rank + 1, bitset, true);
         }
     }
     return bitset;
@@ -463,24 +516,124 @@ StringIndexMarisa::PrefixMatch(std::string_view prefix) {
 
 void
 StringIndexMarisa::fill_str_ids(size_t n, const std::string* values) {
-    str_ids_.resize(n);
+    str_ids_buf_.resize(n);
     for (size_t i = 0; i < n; i++) {
         auto str = values[i];
         auto str_id = lookup(str);
         AssertInfo(valid_str_id(str_id), "invalid marisa key");
-        str_ids_[i] = str_id;
+        str_ids_buf_[i] = str_id;
     }
 }
 
 void
 StringIndexMarisa::fill_offsets() {
-    for (size_t offset = 0; offset < str_ids_.size(); offset++) {
-        auto str_id = str_ids_[offset];
-        if (str_ids_to_offsets_.find(str_id) == str_ids_to_offsets_.end()) {
-            str_ids_to_offsets_[str_id] = std::vector<size_t>{};
+    num_rows_ = str_ids_buf_.size();
+    auto num_keys = trie_.size();
+    AssertInfo(num_rows_ <= std::numeric_limits<uint32_t>::max(),
+               "too many rows for marisa index: {}",
+               num_rows_);
+
+    // rank the str ids in the order of their strings
+    std::vector<std::string> keys(num_keys);
+    {
+        marisa::Agent agent;
+        agent.set_query("");
+        while (trie_.predictive_search(agent)) {
+            keys[agent.key().id()].assign(agent.key().ptr(),
+                                          agent.key().length());
+        }
+    }
+    ranked_ids_buf_.resize(num_keys);
+    std::iota(ranked_ids_buf_.begin(), ranked_ids_buf_.end(), 0);
+    std::sort(ranked_ids_buf_.begin(),
+              ranked_ids_buf_.end(),
+              [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    id_ranks_buf_.resize(num_keys);
+    for (size_t rank = 0; rank < num_keys; rank++) {
+        id_ranks_buf_[ranked_ids_buf_[rank]] = rank;
+    }
+
+    // count the rows of every rank, then place the rows in order
+    rank_begins_buf_.assign(num_keys + 1, 0);
+    for (auto str_id : str_ids_buf_) {
+        AssertInfo(str_id < num_keys, "invalid marisa key");
+        ++rank_begins_buf_[id_ranks_buf_[str_id] + 1];
+    }
+    std::partial_sum(rank_begins_buf_.begin(),
+                     rank_begins_buf_.end(),
+                     rank_begins_buf_.begin());
+    std::vector<uint64_t> next(rank_begins_buf_.begin(),
+                               rank_begins_buf_.end() - 1);
+    rank_offsets_buf_.resize(num_rows_);
+    for (size_t offset = 0; offset < str_ids_buf_.size(); offset++) {
+        auto rank = id_ranks_buf_[str_ids_buf_[offset]];
+        rank_offsets_buf_[next[rank]++] = offset;
+    }
+
+    str_ids_ = str_ids_buf_.data();
+    ranked_ids_ = ranked_ids_buf_.data();
+    id_ranks_ = id_ranks_buf_.data();
+    rank_begins_ = rank_begins_buf_.data();
+    rank_offsets_ = rank_offsets_buf_.data();
+}
+
+void
+StringIndexMarisa::set_offsets(size_t begin,
+                               size_t end,
+                               TargetBitmap& bitset,
+                               bool value) const {
+    if (begin >= end) {
+        return;
+    }
+    for (auto i = rank_begins_[begin]; i < rank_begins_[end]; i++) {
+        bitset[rank_offsets_[i]] = value;
+    }
+}
+
+size_t
+StringIndexMarisa::rank_bound(std::string_view value, bool upper) const {
+    size_t first = 0;
+    size_t count = trie_.size();
+    marisa::Agent agent;
+    while (count > 0) {
+        auto step = count / 2;
+        auto key = key_of(ranked_ids_[first + step], agent);
+        if (upper ? key <= value : key < value) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
         }
-        str_ids_to_offsets_[str_id].push_back(offset);
     }
+    return first;
+}
+
+std::pair<size_t, size_t>
+StringIndexMarisa::prefix_ranks(std::string_view prefix) const {
+    // the strings starting with the prefix are the ranks from the first one
+    // not less than the prefix
+    auto begin = rank_bound(prefix, false);
+    auto end = begin;
+    auto count = trie_.size() - begin;
+    marisa::Agent agent;
+    while (count > 0) {
+        auto step = count / 2;
+        auto key = key_of(ranked_ids_[end + step], agent);
+        if (key.substr(0, prefix.size()) == prefix) {
+            end += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return {begin, end};
+}
+
+std::string_view
+StringIndexMarisa::key_of(size_t str_id, marisa::Agent& agent) const {
+    agent.set_query(str_id);
+    trie_.reverse_lookup(agent);
+    return std::string_view(agent.key().ptr(), agent.key().length());
 }
 
 size_t
@@ -495,20 +648,10 @@ StringIndexMarisa::lookup(const std::string_view str) {
     return MARISA_INVALID_KEY_ID;
 }
 
-std::vector<size_t>
-StringIndexMarisa::prefix_match(const std::string_view prefix) {
-    std::vector<size_t> ret;
-    marisa::Agent agent;
-    agent.set_query(prefix.data());
-    while (trie_.predictive_search(agent)) {
-        ret.push_back(agent.key().id());
-    }
-    return ret;
-}
-
 std::string
 StringIndexMarisa::Reverse_Lookup(size_t offset) const {
-    AssertInfo(offset < str_ids_.size(), "out of range of total count");
+    AssertInfo(offset < static_cast<size_t>(num_rows_),
+               "out of range of total count");
     marisa::Agent agent;
     agent.set_query(str_ids_[offset]);
     trie_.reverse_lookup(agent);
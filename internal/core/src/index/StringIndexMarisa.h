@@ -37,6 +37,8 @@ class StringIndexMarisa : public StringIndex {
         const storage::FileManagerContext& file_manager_context,
         std::shared_ptr<milvus_storage::Space> space);
 
+    ~StringIndexMarisa() override;
+
     int64_t
     Size() override;
 
@@ -54,7 +56,7 @@ class StringIndexMarisa : public StringIndex {
 
     int64_t
     Count() override {
-        return str_ids_.size();
+        return num_rows_;
     }
 
     void
@@ -84,6 +86,9 @@ class StringIndexMarisa : public StringIndex {
     const TargetBitmap
     PrefixMatch(const std::string_view prefix) override;
 
+    const TargetBitmap
+    PatternMatch(const LikePattern& pattern) override;
+
     std::string
     Reverse_Lookup(size_t offset) const override;
 
@@ -98,28 +103,93 @@ class StringIndexMarisa : public StringIndex {
         return true;
     }
 
+    bool
+    IsMmapSupported() const override {
+        return true;
+    }
+
+    bool
+    IsMmap() const {
+        return mmap_data_ != nullptr;
+    }
+
+    // the mmap-ed trie and arrays are excluded
+    int64_t
+    ByteSize() const override {
+        // the arrays point to the buffers once the trie is built or loaded
+        if (str_ids_ == nullptr || IsMmap()) {
+            return 0;
+        }
+        return trie_.io_size() + str_ids_buf_.capacity() * sizeof(size_t) +
+               (ranked_ids_buf_.capacity() + id_ranks_buf_.capacity() +
+                rank_offsets_buf_.capacity()) *
+                   sizeof(uint32_t) +
+               rank_begins_buf_.capacity() * sizeof(uint64_t);
+    }
+
  private:
     void
     fill_str_ids(size_t n, const std::string* values);
 
+    // rank the str ids by their strings, fill the rows of every rank and
+    // point the arrays to the buffers
     void
     fill_offsets();
 
+    // set the rows holding the str ids of the ranks in [begin, end)
+    void
+    set_offsets(size_t begin,
+                size_t end,
+                TargetBitmap& bitset,
+                bool value) const;
+
+    // the first rank whose string is not less than the value, or greater
+    // than the value if upper
+    size_t
+    rank_bound(std::string_view value, bool upper) const;
+
+    // the ranks [begin, end) of the strings starting with the prefix
+    std::pair<size_t, size_t>
+    prefix_ranks(std::string_view prefix) const;
+
+    // the string of the str id
+    std::string_view
+    key_of(size_t str_id, marisa::Agent& agent) const;
+
+    // move the trie and the arrays from the heap to the files mmap-ed
+    void
+    Mmap(const std::string& filepath, const BinaryPtr& trie);
+
     // get str_id by str, if str not found, -1 was returned.
     size_t
     lookup(const std::string_view str);
 
-    std::vector<size_t>
-    prefix_match(const std::string_view prefix);
-
     void
     LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
 
  private:
     Config config_;
     marisa::Trie trie_;
-    std::vector<size_t> str_ids_;  // used to retrieve.
-    std::map<size_t, std::vector<size_t>> str_ids_to_offsets_;
+    int64_t num_rows_ = 0;
+    // the str id of every row, used to retrieve. The str ids are ranked in
+    // the order of their strings, the rows holding the str id of rank r are
+    // rank_offsets_[rank_begins_[r], rank_begins_[r + 1]), so the rows of a
+    // range or a prefix of strings are one span of rank_offsets_. They point
+    // to the buffers below or the mmap-ed file
+    const size_t* str_ids_ = nullptr;
+    const uint32_t* ranked_ids_ = nullptr;
+    const uint32_t* id_ranks_ = nullptr;
+    const uint64_t* rank_begins_ = nullptr;
+    const uint32_t* rank_offsets_ = nullptr;
+    std::vector<size_t> str_ids_buf_;
+    std::vector<uint32_t> ranked_ids_buf_;
+    std::vector<uint32_t> id_ranks_buf_;
+    std::vector<uint64_t> rank_begins_buf_;
+    std::vector<uint32_t> rank_offsets_buf_;
+    char* mmap_data_ = nullptr;
+    size_t mmap_size_ = 0;
+    // locked within the MlockBudget, released before unmapped
+    bool mmap_locked_ = false;
     bool built_ = false;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     std::shared_ptr<milvus_storage::Space> space_;
@@ -19,6 +19,7 @@
 #include <string>
 #include <string_view>
 
+#include "common/LikePattern.h"
 #include "common/Utils.h"
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndex.h"
@@ -34,24 +35,54 @@ class StringIndexSort : public ScalarIndexSort<std::string> {
             auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
             return PrefixMatch(prefix);
         }
+        if (op == OpType::PostfixMatch || op == OpType::Match) {
+            auto value = dataset->Get<std::string>(MATCH_VALUE);
+            return PatternMatch(op == OpType::PostfixMatch
+                                    ? LikePattern::Postfix(value)
+                                    : LikePattern(value));
+        }
         return ScalarIndex<std::string>::Query(dataset);
     }
 
     const TargetBitmap
     PrefixMatch(std::string_view prefix) {
-        auto data = GetData();
-        TargetBitmap bitset(data.size());
+        auto values = GetValues();
+        auto offsets = GetOffsets();
+        TargetBitmap bitset(Count());
+        auto end = values + Count();
         auto it = std::lower_bound(
-            data.begin(),
-            data.end(),
-            prefix,
-            [](const IndexStructure<std::string>& value,
-               std::string_view prefix) { return value.a_ < prefix; });
-        for (; it != data.end(); ++it) {
-            if (!milvus::PrefixMatch(it->a_, prefix)) {
+            values, end, prefix, [](const std::string& value, auto prefix) {
+                return value < prefix;
+            });
+        for (; it != end; ++it) {
+            if (!milvus::PrefixMatch(*it, prefix)) {
                 break;
             }
-            bitset[it->idx_] = true;
+            bitset[offsets[it - values]] = true;
+        }
+        return bitset;
+    }
+
+    const TargetBitmap
+    PatternMatch(const LikePattern& pattern) {
+        auto values = GetValues();
+        auto offsets = GetOffsets();
+        auto& prefix = pattern.prefix();
+        TargetBitmap bitset(Count());
+        auto end = values + Count();
+        auto it = std::lower_bound(
+            values, end, prefix, [](const std::string& value, auto& prefix) {
+                return value < prefix;
+            });
+        // the values are sorted, a string is matched once for all its rows
+        const std::string* last = nullptr;
+        bool matched = false;
+        for (; it != end && milvus::PrefixMatch(*it, prefix); ++it) {
+            if (last == nullptr || *last != *it) {
+                last = it;
+                matched = pattern.Match(*it);
+            }
+            bitset[offsets[it - values]] = matched;
         }
         return bitset;
     }
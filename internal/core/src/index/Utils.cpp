@@ -34,6 +34,8 @@
 #include "common/Slice.h"
 #include "index/Utils.h"
 #include "index/Meta.h"
+#include "index/Index.h"
+#include "mmap/Utils.h"
 #include "storage/Util.h"
 #include "knowhere/comp/index_param.h"
 
@@ -264,10 +266,12 @@ AssembleIndexDatas(std::map<std::string, FieldDataChannelPtr>& index_datas,
                 auto it = index_datas.find(file_name);
                 AssertInfo(it != index_datas.end(), "lost index slice data");
                 auto& channel = it->second;
-                auto data_array = storage::CollectFieldDataChannel(channel);
-                auto data = storage::MergeFieldData(data_array);
-                auto len = data->Size();
-                new_field_data->FillFieldData(data->Data(), len);
+                // filled by the field datas of the slice as they are, not
+                // merged first
+                FieldDataPtr data;
+                while (channel->pop(data)) {
+                    new_field_data->FillFieldData(data->Data(), data->Size());
+                }
                 index_datas.erase(file_name);
             }
             AssertInfo(
@@ -305,4 +309,26 @@ ReadDataFromFD(int fd, void* buf, size_t size, size_t chunk_size) {
     }
 }
 
+bool
+AdviseMappedIndex(char* data, size_t size, const Config& config) {
+    auto advice = GetValueFromConfig<std::string>(config, kMmapAdvice);
+    auto ok = madvise(data,
+                      size,
+                      advice.has_value() ? MmapAdviceFromName(advice.value())
+                                         : MADV_RANDOM);
+    AssertInfo(ok == 0,
+               "failed to madvise the mapped index, err: {}",
+               strerror(errno));
+    auto mlock = GetValueFromConfig<std::string>(config, kMlock);
+    if (!mlock.has_value() || mlock.value() != "true") {
+        return false;
+    }
+    auto locked = MlockBudget::GetInstance().Lock(data, size);
+    if (!locked) {
+        LOG_SEGCORE_WARNING_ << "the mapped index of " << size
+                             << " bytes is not locked, over the mlock budget";
+    }
+    return locked;
+}
+
 }  // namespace milvus::index
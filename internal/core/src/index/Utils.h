@@ -124,4 +124,10 @@ AssembleIndexDatas(std::map<std::string, FieldDataChannelPtr>& index_datas,
 void
 ReadDataFromFD(int fd, void* buf, size_t size, size_t chunk_size = 0x7ffff000);
 
+// advise the buffers of an index mapped by MmapBuffers by the kMmapAdvice of
+// the load config, random if unset as they are searched, and lock them
+// within the MlockBudget if kMlock is "true", return whether they're locked
+bool
+AdviseMappedIndex(char* data, size_t size, const Config& config);
+
 }  // namespace milvus::index
@@ -16,12 +16,17 @@
 
 #include "index/VectorDiskIndex.h"
 
+#include <chrono>
+
 #include "common/Utils.h"
 #include "config/ConfigKnowhere.h"
+#include "index/DiskSearchScheduler.h"
 #include "index/Meta.h"
 #include "index/Utils.h"
+#include "log/Log.h"
 #include "storage/LocalChunkManagerSingleton.h"
 #include "storage/Util.h"
+#include "storage/prometheus_client.h"
 #include "common/Consts.h"
 #include "common/RangeSearchHelper.h"
 
@@ -107,10 +112,19 @@ VectorDiskAnnIndex<T>::Load(const Config& config) {
                "index file paths is empty when load disk ann index data");
     file_manager_->CacheIndexToDisk(index_files.value());
 
+    // the warm up runs in Deserialize, the index is served once it returns
+    auto start = std::chrono::steady_clock::now();
     auto stat = index_.Deserialize(knowhere::BinarySet(), load_config);
     if (stat != knowhere::Status::success)
         PanicInfo(ErrorCode::UnexpectedError,
                   "failed to Deserialize index, " + KnowhereStatusString(stat));
+    LOG_SEGCORE_INFO_ << "load disk ann index done, warm up: "
+                      << load_config.value(DISK_ANN_PREPARE_WARM_UP, false)
+                      << ", cost: "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count()
+                      << "ms";
 
     SetDim(index_.Dim());
 }
@@ -308,7 +322,10 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
     auto local_index_path_prefix = file_manager_->GetLocalIndexObjectPrefix();
     search_config[DISK_ANN_PREFIX_PATH] = local_index_path_prefix;
 
-    auto final = [&] {
+    // search a batch of the queries, the ids and the distances of its
+    // topk results
+    auto search_batch = [&](const DatasetPtr& batch) {
+        auto batch_queries = batch->GetRows();
         auto radius =
             GetValueFromConfig<float>(search_info.search_params_, RADIUS);
         if (radius.has_value()) {
@@ -321,7 +338,7 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
                                       search_config[RANGE_FILTER],
                                       GetMetricType());
             }
-            auto res = index_.RangeSearch(*dataset, search_config, bitset);
+            auto res = index_.RangeSearch(*batch, search_config, bitset);
 
             if (!res.has_value()) {
                 PanicInfo(ErrorCode::UnexpectedError,
@@ -330,9 +347,9 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
                                       res.what()));
             }
             return ReGenRangeSearchResult(
-                res.value(), topk, num_queries, GetMetricType());
+                res.value(), topk, batch_queries, GetMetricType());
         } else {
-            auto res = index_.Search(*dataset, search_config, bitset);
+            auto res = index_.Search(*batch, search_config, bitset);
             if (!res.has_value()) {
                 PanicInfo(ErrorCode::UnexpectedError,
                           fmt::format("failed to search: {}: {}",
@@ -341,29 +358,54 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
             }
             return res.value();
         }
-    }();
-
-    auto ids = final->GetIds();
-    float* distances = const_cast<float*>(final->GetDistance());
-    final->SetIsOwner(true);
+    };
 
-    auto round_decimal = search_info.round_decimal_;
     auto total_num = num_queries * topk;
-
-    if (round_decimal != -1) {
-        const float multiplier = pow(10.0, round_decimal);
-        for (int i = 0; i < total_num; i++) {
-            distances[i] = std::round(distances[i] * multiplier) / multiplier;
-        }
-    }
     auto result = std::make_unique<SearchResult>();
     result->seg_offsets_.resize(total_num);
     result->distances_.resize(total_num);
     result->total_nq_ = num_queries;
     result->unity_topK_ = topk;
 
-    std::copy_n(ids, total_num, result->seg_offsets_.data());
-    std::copy_n(distances, total_num, result->distances_.data());
+    // the queries are searched in batches admitted by the scheduler, which
+    // bounds the reads in flight on the shared AIO contexts
+    auto& scheduler = DiskSearchScheduler::GetInstance();
+    auto segment_id = file_manager_->GetFieldDataMeta().segment_id;
+    auto batch_size = scheduler.BatchSize(num_queries);
+    auto dim = dataset->GetDim();
+    auto queries = static_cast<const T*>(dataset->GetTensor());
+    for (int64_t begin = 0; begin < num_queries; begin += batch_size) {
+        auto batch_queries = std::min(batch_size, num_queries - begin);
+        auto batch = dataset;
+        if (batch_queries != num_queries) {
+            batch = knowhere::GenDataSet(
+                batch_queries, dim, queries + begin * dim);
+        }
+        auto permit = scheduler.Acquire(segment_id, batch_queries);
+        auto start = std::chrono::steady_clock::now();
+        auto final = search_batch(batch);
+        final->SetIsOwner(true);
+        storage::internal_disk_search_latency_read.Observe(
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+
+        auto batch_num = batch_queries * topk;
+        std::copy_n(final->GetIds(),
+                    batch_num,
+                    result->seg_offsets_.data() + begin * topk);
+        std::copy_n(final->GetDistance(),
+                    batch_num,
+                    result->distances_.data() + begin * topk);
+    }
+
+    auto round_decimal = search_info.round_decimal_;
+    if (round_decimal != -1) {
+        const float multiplier = pow(10.0, round_decimal);
+        for (auto& distance : result->distances_) {
+            distance = std::round(distance * multiplier) / multiplier;
+        }
+    }
 
     return result;
 }
@@ -421,9 +463,16 @@ VectorDiskAnnIndex<T>::update_load_json(const Config& config) {
     load_config[DISK_ANN_PREFIX_PATH] = local_index_path_prefix;
 
     if (GetIndexType() == knowhere::IndexEnum::INDEX_DISKANN) {
-        // set base info
-        load_config[DISK_ANN_PREPARE_WARM_UP] = false;
-        load_config[DISK_ANN_PREPARE_USE_BFS_CACHE] = false;
+        // set base info, the warm up and the cached nodes are within the
+        // search cache budget, both are off unless set by the query node
+        auto get_bool = [&](const char* key) {
+            auto value = GetValueFromConfig<std::string>(load_config, key);
+            return value.has_value() && value.value() == "true";
+        };
+        load_config[DISK_ANN_PREPARE_WARM_UP] =
+            get_bool(DISK_ANN_PREPARE_WARM_UP);
+        load_config[DISK_ANN_PREPARE_USE_BFS_CACHE] =
+            get_bool(DISK_ANN_PREPARE_USE_BFS_CACHE);
 
         // set threads number
         auto num_threads = GetValueFromConfig<std::string>(
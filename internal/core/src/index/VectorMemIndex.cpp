@@ -16,6 +16,7 @@
 
 #include "index/VectorMemIndex.h"
 
+#include <sys/mman.h>
 #include <unistd.h>
 #include <cmath>
 #include <cstdint>
@@ -38,6 +39,7 @@
 #include "knowhere/factory.h"
 #include "knowhere/comp/time_recorder.h"
 #include "common/BitsetView.h"
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/FieldData.h"
 #include "common/File.h"
@@ -48,6 +50,7 @@
 #include "log/Log.h"
 #include "mmap/Types.h"
 #include "storage/DataCodec.h"
+#include "storage/LocalChunkManagerSingleton.h"
 #include "storage/MemFileManagerImpl.h"
 #include "storage/ThreadPools.h"
 #include "storage/space.h"
@@ -55,6 +58,51 @@
 
 namespace milvus::index {
 
+namespace {
+
+// unlinks the staged file once out of scope, unless unlinked already
+class StagedFileGuard {
+ public:
+    explicit StagedFileGuard(std::string path) : path_(std::move(path)) {
+    }
+
+    StagedFileGuard(const StagedFileGuard&) = delete;
+    StagedFileGuard&
+    operator=(const StagedFileGuard&) = delete;
+
+    ~StagedFileGuard() {
+        if (!path_.empty()) {
+            unlink(path_.c_str());
+        }
+    }
+
+    // unlink the file now, returns the result of unlink
+    int
+    Unlink() {
+        auto ok = unlink(path_.c_str());
+        path_.clear();
+        return ok;
+    }
+
+ private:
+    std::string path_;
+};
+
+}  // namespace
+
+// the remote files of the slices of an index binary
+static std::vector<std::string>
+SliceFiles(const std::string& index_file_prefix,
+           const std::string& prefix,
+           int slice_num) {
+    std::vector<std::string> files;
+    files.reserve(slice_num);
+    for (auto i = 0; i < slice_num; ++i) {
+        files.push_back(index_file_prefix + GenSlicedFileName(prefix, i));
+    }
+    return files;
+}
+
 template <typename T>
 VectorMemIndex<T>::VectorMemIndex(
     const IndexType& index_type,
@@ -275,7 +323,7 @@ VectorMemIndex<T>::LoadV2(const Config& config) {
 template <typename T>
 void
 VectorMemIndex<T>::Load(const Config& config) {
-    if (config.contains(kMmapFilepath)) {
+    if (config.contains(kMmapFilepath) || config.contains(kLoadFilepath)) {
         return LoadFromFile(config);
     }
 
@@ -289,8 +337,6 @@ VectorMemIndex<T>::Load(const Config& config) {
 
     LOG_SEGCORE_INFO_ << "load index files: " << index_files.value().size();
 
-    auto parallel_degree =
-        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
     std::map<std::string, FieldDataPtr> index_datas{};
 
     // try to read slice meta first
@@ -311,8 +357,6 @@ VectorMemIndex<T>::Load(const Config& config) {
              .empty()) {  // load with the slice meta info, then we can load batch by batch
         std::string index_file_prefix = slice_meta_filepath.substr(
             0, slice_meta_filepath.find_last_of('/') + 1);
-        std::vector<std::string> batch{};
-        batch.reserve(parallel_degree);
 
         auto result = file_manager_->LoadIndexToMemory({slice_meta_filepath});
         auto raw_slice_meta = result[INDEX_FILE_SLICE_META];
@@ -327,30 +371,14 @@ VectorMemIndex<T>::Load(const Config& config) {
 
             auto new_field_data =
                 milvus::storage::CreateFieldData(DataType::INT8, 1, total_len);
-            auto HandleBatch = [&](int index) {
-                auto batch_data = file_manager_->LoadIndexToMemory(batch);
-                for (int j = index - batch.size() + 1; j <= index; j++) {
-                    std::string file_name = GenSlicedFileName(prefix, j);
-                    AssertInfo(batch_data.find(file_name) != batch_data.end(),
-                               "lost index slice data");
-                    auto data = batch_data[file_name];
+            // the slices are appended in order as they arrive
+            auto slices = SliceFiles(index_file_prefix, prefix, slice_num);
+            file_manager_->LoadIndexToMemory(
+                slices, [&](const std::string&, FieldDataPtr data) {
                     new_field_data->FillFieldData(data->Data(), data->Size());
-                }
-                for (auto& file : batch) {
-                    pending_index_files.erase(file);
-                }
-                batch.clear();
-            };
-
-            for (auto i = 0; i < slice_num; ++i) {
-                std::string file_name = GenSlicedFileName(prefix, i);
-                batch.push_back(index_file_prefix + file_name);
-                if (batch.size() >= parallel_degree) {
-                    HandleBatch(i);
-                }
-            }
-            if (batch.size() > 0) {
-                HandleBatch(slice_num - 1);
+                });
+            for (auto& file : slices) {
+                pending_index_files.erase(file);
             }
 
             AssertInfo(
@@ -467,35 +495,110 @@ VectorMemIndex<T>::Build(const Config& config) {
         GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
     AssertInfo(insert_files.has_value(),
                "insert file paths is empty when build disk ann index");
-    auto field_datas =
-        file_manager_->CacheRawDataToMemory(insert_files.value());
+
+    if (!STAGE_VECTOR_BUILD_INPUT) {
+        auto field_datas =
+            file_manager_->CacheRawDataToMemory(insert_files.value());
+        int64_t total_size = 0;
+        int64_t total_num_rows = 0;
+        int64_t dim = 0;
+        for (auto data : field_datas) {
+            total_size += data->Size();
+            total_num_rows += data->get_num_rows();
+            AssertInfo(dim == 0 || dim == data->get_dim(),
+                       "inconsistent dim value between field datas!");
+            dim = data->get_dim();
+        }
+
+        auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[total_size]);
+        int64_t offset = 0;
+        for (auto data : field_datas) {
+            std::memcpy(buf.get() + offset, data->Data(), data->Size());
+            offset += data->Size();
+            data.reset();
+        }
+        field_datas.clear();
+
+        Config build_config;
+        build_config.update(config);
+        build_config.erase("insert_files");
+
+        auto dataset = GenDataset(total_num_rows, dim, buf.get());
+        BuildWithDataset(dataset, build_config);
+        return;
+    }
+
+    // the vectors are appended to a local file as they are downloaded and
+    // the index is built from its mapping, so the build input is backed by
+    // the page cache instead of the whole field data plus a copy on the heap
+    auto local_chunk_manager =
+        storage::LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    auto field_meta = file_manager_->GetFieldDataMeta();
+    auto local_data_path =
+        storage::GenFieldRawDataPathPrefix(local_chunk_manager,
+                                           field_meta.segment_id,
+                                           field_meta.field_id) +
+        "raw_data_" + std::to_string(file_manager_->GetIndexMeta().build_id);
+    std::filesystem::create_directories(
+        std::filesystem::path(local_data_path).parent_path());
+    auto file = File::Open(local_data_path, O_CREAT | O_TRUNC | O_RDWR);
+    // the file is removed whether the download fails or not
+    StagedFileGuard staged_file(local_data_path);
 
     int64_t total_size = 0;
     int64_t total_num_rows = 0;
     int64_t dim = 0;
-    for (auto data : field_datas) {
-        total_size += data->Size();
-        total_num_rows += data->get_num_rows();
-        AssertInfo(dim == 0 || dim == data->get_dim(),
-                   "inconsistent dim value between field datas!");
-        dim = data->get_dim();
+    file_manager_->CacheRawDataToMemory(
+        insert_files.value(), [&](FieldDataPtr data) {
+            AssertInfo(dim == 0 || dim == data->get_dim(),
+                       "inconsistent dim value between field datas!");
+            dim = data->get_dim();
+            auto written = file.Write(data->Data(), data->Size());
+            AssertInfo(written == data->Size(),
+                       fmt::format("failed to write raw data to disk {}: {}",
+                                   local_data_path,
+                                   strerror(errno)));
+            total_size += data->Size();
+            total_num_rows += data->get_num_rows();
+        });
+
+    void* buf = nullptr;
+    if (total_size > 0) {
+        buf = mmap(nullptr,
+                   total_size,
+                   PROT_READ,
+                   MAP_SHARED,
+                   file.Descriptor(),
+                   0);
     }
-
-    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[total_size]);
-    int64_t offset = 0;
-    for (auto data : field_datas) {
-        std::memcpy(buf.get() + offset, data->Data(), data->Size());
-        offset += data->Size();
-        data.reset();
-    }
-    field_datas.clear();
+    file.Close();
+    // the name goes away now, the mapping keeps the data until unmapped
+    auto ok = staged_file.Unlink();
+    AssertInfo(ok == 0,
+               "failed to unlink raw data file {}: {}",
+               local_data_path,
+               strerror(errno));
+    AssertInfo(buf != MAP_FAILED,
+               "failed to map raw data file {}: {}",
+               local_data_path,
+               strerror(errno));
 
     Config build_config;
     build_config.update(config);
     build_config.erase("insert_files");
 
-    auto dataset = GenDataset(total_num_rows, dim, buf.get());
-    BuildWithDataset(dataset, build_config);
+    auto dataset = GenDataset(total_num_rows, dim, buf);
+    try {
+        BuildWithDataset(dataset, build_config);
+    } catch (...) {
+        if (buf != nullptr) {
+            munmap(buf, total_size);
+        }
+        throw;
+    }
+    if (buf != nullptr) {
+        munmap(buf, total_size);
+    }
 }
 
 template <typename T>
@@ -619,26 +722,72 @@ VectorMemIndex<T>::GetVector(const DatasetPtr dataset) const {
 template <typename T>
 void
 VectorMemIndex<T>::LoadFromFile(const Config& config) {
-    auto filepath = GetValueFromConfig<std::string>(config, kMmapFilepath);
-    AssertInfo(filepath.has_value(), "mmap filepath is empty when load index");
-
-    std::filesystem::create_directories(
-        std::filesystem::path(filepath.value()).parent_path());
-
-    auto file = File::Open(filepath.value(), O_CREAT | O_TRUNC | O_RDWR);
+    // the slices are written to the file as they are downloaded and the index
+    // is deserialized from it, mapped or read into memory, so they are never
+    // assembled in memory
+    auto enable_mmap = config.contains(kMmapFilepath);
+    auto filepath = GetValueFromConfig<std::string>(
+        config, enable_mmap ? kMmapFilepath : kLoadFilepath);
+    AssertInfo(filepath.has_value(), "index filepath is empty when load index");
 
     auto index_files =
         GetValueFromConfig<std::vector<std::string>>(config, "index_files");
     AssertInfo(index_files.has_value(),
                "index file paths is empty when load index");
 
-    std::unordered_set<std::string> pending_index_files(index_files->begin(),
-                                                        index_files->end());
+    // the replicas of the index on the host map the same file of the shared
+    // mmap store, written once
+    auto store = enable_mmap ? storage::SharedMmapStore::Get() : nullptr;
+    std::string load_path;
+    if (store != nullptr) {
+        shared_file_ = store->Acquire(
+            storage::SharedMmapStore::Key("index", index_files.value()),
+            [&](const std::string& path) {
+                WriteIndexFile(index_files.value(), path);
+            });
+        load_path = shared_file_->Path().string();
+    } else {
+        std::filesystem::create_directories(
+            std::filesystem::path(filepath.value()).parent_path());
+        WriteIndexFile(index_files.value(), filepath.value());
+        load_path = filepath.value();
+    }
 
-    LOG_SEGCORE_INFO_ << "load index files: " << index_files.value().size();
+    LOG_SEGCORE_INFO_ << "load index into Knowhere...";
+    auto conf = config;
+    conf.erase(kMmapFilepath);
+    conf.erase(kLoadFilepath);
+    conf[kEnableMmap] = enable_mmap;
+    auto stat = index_.DeserializeFromFile(load_path, conf);
+    if (stat != knowhere::Status::success) {
+        PanicInfo(ErrorCode::UnexpectedError,
+                  "failed to Deserialize index: {}",
+                  KnowhereStatusString(stat));
+    }
+
+    auto dim = index_.Dim();
+    this->SetDim(index_.Dim());
+
+    if (store == nullptr) {
+        auto ok = unlink(filepath->data());
+        AssertInfo(ok == 0,
+                   "failed to unlink index file {}: {}",
+                   filepath.value(),
+                   strerror(errno));
+    }
+    LOG_SEGCORE_INFO_ << "load vector index done";
+}
+
+template <typename T>
+void
+VectorMemIndex<T>::WriteIndexFile(const std::vector<std::string>& index_files,
+                                  const std::string& path) {
+    auto file = File::Open(path, O_CREAT | O_TRUNC | O_RDWR);
 
-    auto parallel_degree =
-        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    std::unordered_set<std::string> pending_index_files(index_files.begin(),
+                                                        index_files.end());
+
+    LOG_SEGCORE_INFO_ << "load index files: " << index_files.size();
 
     // try to read slice meta first
     std::string slice_meta_filepath;
@@ -658,8 +807,6 @@ VectorMemIndex<T>::LoadFromFile(const Config& config) {
              .empty()) {  // load with the slice meta info, then we can load batch by batch
         std::string index_file_prefix = slice_meta_filepath.substr(
             0, slice_meta_filepath.find_last_of('/') + 1);
-        std::vector<std::string> batch{};
-        batch.reserve(parallel_degree);
 
         auto result = file_manager_->LoadIndexToMemory({slice_meta_filepath});
         auto raw_slice_meta = result[INDEX_FILE_SLICE_META];
@@ -672,35 +819,19 @@ VectorMemIndex<T>::LoadFromFile(const Config& config) {
             int slice_num = item[SLICE_NUM];
             auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
 
-            auto HandleBatch = [&](int index) {
-                auto batch_data = file_manager_->LoadIndexToMemory(batch);
-                for (int j = index - batch.size() + 1; j <= index; j++) {
-                    std::string file_name = GenSlicedFileName(prefix, j);
-                    AssertInfo(batch_data.find(file_name) != batch_data.end(),
-                               "lost index slice data");
-                    auto data = batch_data[file_name];
+            // the slices are written in order as they arrive
+            auto slices = SliceFiles(index_file_prefix, prefix, slice_num);
+            file_manager_->LoadIndexToMemory(
+                slices, [&](const std::string&, FieldDataPtr data) {
                     auto written = file.Write(data->Data(), data->Size());
                     AssertInfo(
                         written == data->Size(),
                         fmt::format("failed to write index data to disk {}: {}",
-                                    filepath->data(),
+                                    path,
                                     strerror(errno)));
-                }
-                for (auto& file : batch) {
-                    pending_index_files.erase(file);
-                }
-                batch.clear();
-            };
-
-            for (auto i = 0; i < slice_num; ++i) {
-                std::string file_name = GenSlicedFileName(prefix, i);
-                batch.push_back(index_file_prefix + file_name);
-                if (batch.size() >= parallel_degree) {
-                    HandleBatch(i);
-                }
-            }
-            if (batch.size() > 0) {
-                HandleBatch(slice_num - 1);
+                });
+            for (auto& file : slices) {
+                pending_index_files.erase(file);
             }
         }
     } else {
@@ -711,27 +842,6 @@ VectorMemIndex<T>::LoadFromFile(const Config& config) {
         }
     }
     file.Close();
-
-    LOG_SEGCORE_INFO_ << "load index into Knowhere...";
-    auto conf = config;
-    conf.erase(kMmapFilepath);
-    conf[kEnableMmap] = true;
-    auto stat = index_.DeserializeFromFile(filepath.value(), conf);
-    if (stat != knowhere::Status::success) {
-        PanicInfo(ErrorCode::UnexpectedError,
-                  "failed to Deserialize index: {}",
-                  KnowhereStatusString(stat));
-    }
-
-    auto dim = index_.Dim();
-    this->SetDim(index_.Dim());
-
-    auto ok = unlink(filepath->data());
-    AssertInfo(ok == 0,
-               "failed to unlink mmap index file {}: {}",
-               filepath.value(),
-               strerror(errno));
-    LOG_SEGCORE_INFO_ << "load vector index done";
 }
 
 template <typename T>
@@ -25,6 +25,7 @@
 #include "knowhere/factory.h"
 #include "index/VectorIndex.h"
 #include "storage/MemFileManagerImpl.h"
+#include "storage/SharedMmapStore.h"
 #include "storage/space.h"
 #include "index/IndexInfo.h"
 
@@ -81,6 +82,11 @@ class VectorMemIndex : public VectorIndex {
     const bool
     HasRawData() const override;
 
+    int64_t
+    ByteSize() const override {
+        return index_.Size();
+    }
+
     std::vector<uint8_t>
     GetVector(const DatasetPtr dataset) const override;
 
@@ -98,11 +104,19 @@ class VectorMemIndex : public VectorIndex {
     void
     LoadFromFile(const Config& config);
 
+    // write the index files to the file at path as they are downloaded
+    void
+    WriteIndexFile(const std::vector<std::string>& index_files,
+                   const std::string& path);
+
     void
     LoadFromFileV2(const Config& config);
 
  protected:
     Config config_;
+    // the file of the shared mmap store the index is mapped from, released
+    // after the index
+    storage::SharedMmapStore::LeasePtr shared_file_;
     knowhere::Index<knowhere::IndexNode> index_;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     std::shared_ptr<milvus_storage::Space> space_;
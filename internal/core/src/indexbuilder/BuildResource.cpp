@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "indexbuilder/BuildResource.h"
+
+#include <string>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "index/Meta.h"
+#include "index/Utils.h"
+#include "knowhere/comp/index_param.h"
+
+namespace milvus::indexbuilder {
+
+// the params come as strings from the index params
+static int64_t
+GetIntParam(const Config& config, const std::string& key, int64_t dft) {
+    auto value = index::GetValueFromConfig<std::string>(config, key);
+    return value.has_value() ? std::stoll(value.value()) : dft;
+}
+
+static double
+GetFloatParam(const Config& config, const std::string& key, double dft) {
+    auto value = index::GetValueFromConfig<std::string>(config, key);
+    return value.has_value() ? std::stod(value.value()) : dft;
+}
+
+static int64_t
+RowSize(DataType field_type, int64_t dim) {
+    switch (field_type) {
+        case DataType::VECTOR_FLOAT:
+            return dim * sizeof(float);
+        case DataType::VECTOR_FLOAT16:
+            return dim * sizeof(float16);
+        case DataType::VECTOR_BINARY:
+            return (dim + 7) / 8;
+        case DataType::BOOL:
+        case DataType::INT8:
+            return sizeof(int8_t);
+        case DataType::INT16:
+            return sizeof(int16_t);
+        case DataType::INT32:
+        case DataType::FLOAT:
+            return sizeof(int32_t);
+        case DataType::INT64:
+        case DataType::DOUBLE:
+            return sizeof(int64_t);
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "can't estimate the build of variable length type {}",
+                      field_type);
+    }
+}
+
+// the size of the in memory vector index of num_rows rows
+static int64_t
+VectorIndexSize(const std::string& index_type,
+                const Config& config,
+                int64_t num_rows,
+                int64_t dim,
+                int64_t row_size) {
+    auto raw_size = num_rows * row_size;
+    auto ids_size = num_rows * int64_t(sizeof(int64_t));
+    auto centroids_size =
+        GetIntParam(config, knowhere::indexparam::NLIST, 128) * row_size;
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IDMAP ||
+        index_type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP) {
+        return raw_size;
+    }
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT ||
+        index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT_CC ||
+        index_type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT) {
+        return raw_size + ids_size + centroids_size;
+    }
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFSQ8) {
+        // a byte per dimension and the trained ranges of the dimensions
+        return num_rows * dim + ids_size + centroids_size +
+               2 * dim * int64_t(sizeof(float));
+    }
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFPQ) {
+        auto m = GetIntParam(config, knowhere::indexparam::M, dim);
+        auto nbits = GetIntParam(config, knowhere::indexparam::NBITS, 8);
+        // the codes and the codebooks of the m sub quantizers
+        return (num_rows * m * nbits + 7) / 8 + ids_size + centroids_size +
+               (int64_t(1) << nbits) * dim * int64_t(sizeof(float));
+    }
+    if (index_type == knowhere::IndexEnum::INDEX_HNSW) {
+        // the level 0 links are twice M, the upper levels hold a fraction
+        // of the rows and are taken as a link per row
+        auto m = GetIntParam(config, knowhere::indexparam::HNSW_M, 16);
+        return raw_size + ids_size +
+               num_rows * (2 * m + 1) * int64_t(sizeof(uint32_t));
+    }
+    // the other indexes are taken as holding a copy of the rows aside
+    return 2 * raw_size;
+}
+
+BuildResource
+EstimateBuildResource(DataType field_type,
+                      const Config& config,
+                      int64_t num_rows,
+                      int64_t dim) {
+    AssertInfo(num_rows >= 0, "invalid num rows {}", num_rows);
+    auto index_type = index::GetIndexTypeFromConfig(config);
+    auto row_size = RowSize(field_type, dim);
+    auto raw_size = num_rows * row_size;
+    BuildResource resource;
+
+    if (!datatype_is_vector(field_type)) {
+        // the field data is held while the sorted values and their offsets
+        // are built, then serialized into a copy
+        auto index_size = num_rows * (row_size + int64_t(sizeof(int32_t)));
+        resource.memory_size = raw_size + 2 * index_size;
+        return resource;
+    }
+
+    if (index_type == knowhere::IndexEnum::INDEX_DISKANN) {
+        auto max_degree = GetIntParam(config, index::DISK_ANN_MAX_DEGREE, 56);
+        auto pq_code_size = static_cast<int64_t>(
+            GetFloatParam(config, index::DISK_ANN_PQ_CODE_BUDGET, 0) *
+            (1 << 30));
+        // the graph is built in memory with the slack of knowhere on the
+        // degree, over the rows and their pq codes
+        auto graph_size = static_cast<int64_t>(
+            num_rows * max_degree * sizeof(uint32_t) * 1.3);
+        resource.memory_size =
+            DEFAULT_FIELD_MAX_MEMORY_LIMIT + raw_size + graph_size +
+            pq_code_size;
+        // the staged raw data, the index holding the rows beside their
+        // neighbors and the pq codes
+        resource.disk_size =
+            raw_size + raw_size +
+            num_rows * (max_degree + 1) * int64_t(sizeof(uint32_t)) +
+            pq_code_size;
+        return resource;
+    }
+
+    // the rows are staged to a mapped local file as they are downloaded, at
+    // most a memory limit of binlogs at a time, the built index is
+    // serialized into a copy before it is uploaded
+    auto index_size =
+        VectorIndexSize(index_type, config, num_rows, dim, row_size);
+    resource.memory_size = DEFAULT_FIELD_MAX_MEMORY_LIMIT + 2 * index_size;
+    resource.disk_size = raw_size;
+    return resource;
+}
+
+}  // namespace milvus::indexbuilder
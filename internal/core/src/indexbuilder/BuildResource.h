@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/Types.h"
+
+namespace milvus::indexbuilder {
+
+// the peak resources of building an index from its insert files
+struct BuildResource {
+    // the bytes held in memory, the page cache of the staged files aside
+    int64_t memory_size = 0;
+    // the bytes of the local files staged and written by the build
+    int64_t disk_size = 0;
+};
+
+// estimate the peak resources of building the index of config on num_rows
+// rows of field_type, from the layouts of the knowhere indexes and how the
+// file managers stage the raw data and the index files, the estimates are
+// meant as upper bounds to pack builds by, not as exact sizes
+BuildResource
+EstimateBuildResource(DataType field_type,
+                      const Config& config,
+                      int64_t num_rows,
+                      int64_t dim);
+
+}  // namespace milvus::indexbuilder
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include "common/Tracer.h"
 #include "common/Types.h"
 #include "storage/FileManager.h"
 
@@ -41,6 +42,21 @@ class IndexCreatorBase {
 
     virtual BinarySet
     UploadV2() = 0;
+
+    // the trace of the build, which the upload of the index continues
+    void
+    set_trace_context(const opentelemetry::trace::SpanContext& trace_ctx) {
+        trace_ctx_ = trace_ctx;
+    }
+
+    const opentelemetry::trace::SpanContext&
+    get_trace_context() const {
+        return trace_ctx_;
+    }
+
+ private:
+    opentelemetry::trace::SpanContext trace_ctx_ =
+        opentelemetry::trace::SpanContext::GetInvalid();
 };
 
 using IndexCreatorBasePtr = std::unique_ptr<IndexCreatorBase>;
@@ -60,6 +60,8 @@ class IndexFactory {
             case DataType::DOUBLE:
             case DataType::VARCHAR:
             case DataType::STRING:
+            case DataType::JSON:
+            case DataType::ARRAY:
                 return CreateScalarIndex(type, config, context);
 
             case DataType::VECTOR_FLOAT:
@@ -91,6 +93,8 @@ class IndexFactory {
             case DataType::DOUBLE:
             case DataType::VARCHAR:
             case DataType::STRING:
+            case DataType::JSON:
+            case DataType::ARRAY:
                 return CreateScalarIndex(
                     type, config, file_manager_context, space);
 
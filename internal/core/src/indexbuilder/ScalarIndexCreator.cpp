@@ -74,8 +74,9 @@ ScalarIndexCreator::Load(const milvus::BinarySet& binary_set) {
 
 std::string
 ScalarIndexCreator::index_type() {
-    // TODO
-    return "sort";
+    auto index_type =
+        index::GetValueFromConfig<std::string>(config_, index::INDEX_TYPE);
+    return index_type.value_or("sort");
 }
 
 BinarySet
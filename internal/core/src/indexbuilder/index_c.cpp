@@ -10,8 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <glog/logging.h>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 #include "fmt/core.h"
 #include "indexbuilder/type_c.h"
 #include "log/Log.h"
@@ -22,6 +24,8 @@
 #endif
 
 #include "common/EasyAssert.h"
+#include "common/Tracer.h"
+#include "indexbuilder/BuildResource.h"
 #include "indexbuilder/VecIndexCreator.h"
 #include "indexbuilder/index_c.h"
 #include "indexbuilder/IndexFactory.h"
@@ -30,6 +34,7 @@
 #include "indexbuilder/types.h"
 #include "index/Utils.h"
 #include "pb/index_cgo_msg.pb.h"
+#include "storage/ThreadPools.h"
 #include "storage/Util.h"
 #include "storage/space.h"
 #include "index/Meta.h"
@@ -79,60 +84,151 @@ CreateIndexV0(enum CDataType dtype,
     return status;
 }
 
-CStatus
-CreateIndex(CIndex* res_index, CBuildIndexInfo c_build_index_info) {
-    try {
-        auto build_index_info = (BuildIndexInfo*)c_build_index_info;
-        auto field_type = build_index_info->field_type;
+// create the index of the build info and build it from its insert files
+static milvus::indexbuilder::IndexCreatorBasePtr
+BuildIndexFromInsertFiles(BuildIndexInfo* build_index_info) {
+    auto field_type = build_index_info->field_type;
 
-        milvus::index::CreateIndexInfo index_info;
-        index_info.field_type = build_index_info->field_type;
+    milvus::index::CreateIndexInfo index_info;
+    index_info.field_type = build_index_info->field_type;
 
-        auto& config = build_index_info->config;
-        config["insert_files"] = build_index_info->insert_files;
+    auto& config = build_index_info->config;
+    config["insert_files"] = build_index_info->insert_files;
 
-        // get index type
-        auto index_type = milvus::index::GetValueFromConfig<std::string>(
-            config, "index_type");
-        AssertInfo(index_type.has_value(), "index type is empty");
-        index_info.index_type = index_type.value();
+    // get index type
+    auto index_type =
+        milvus::index::GetValueFromConfig<std::string>(config, "index_type");
+    AssertInfo(index_type.has_value(), "index type is empty");
+    index_info.index_type = index_type.value();
 
-        auto engine_version = build_index_info->index_engine_version;
+    auto engine_version = build_index_info->index_engine_version;
 
-        index_info.index_engine_version = engine_version;
-        config[milvus::index::INDEX_ENGINE_VERSION] =
-            std::to_string(engine_version);
+    index_info.index_engine_version = engine_version;
+    config[milvus::index::INDEX_ENGINE_VERSION] =
+        std::to_string(engine_version);
 
-        // get metric type
-        if (milvus::datatype_is_vector(field_type)) {
-            auto metric_type = milvus::index::GetValueFromConfig<std::string>(
-                config, "metric_type");
-            AssertInfo(metric_type.has_value(), "metric type is empty");
-            index_info.metric_type = metric_type.value();
-        }
+    // get metric type
+    if (milvus::datatype_is_vector(field_type)) {
+        auto metric_type = milvus::index::GetValueFromConfig<std::string>(
+            config, "metric_type");
+        AssertInfo(metric_type.has_value(), "metric type is empty");
+        index_info.metric_type = metric_type.value();
+    }
 
-        // init file manager
-        milvus::storage::FieldDataMeta field_meta{
-            build_index_info->collection_id,
-            build_index_info->partition_id,
-            build_index_info->segment_id,
-            build_index_info->field_id};
+    // init file manager
+    milvus::storage::FieldDataMeta field_meta{build_index_info->collection_id,
+                                              build_index_info->partition_id,
+                                              build_index_info->segment_id,
+                                              build_index_info->field_id};
+
+    milvus::storage::IndexMeta index_meta{build_index_info->segment_id,
+                                          build_index_info->field_id,
+                                          build_index_info->index_build_id,
+                                          build_index_info->index_version};
+    auto chunk_manager =
+        milvus::storage::CreateChunkManager(build_index_info->storage_config);
+
+    milvus::storage::FileManagerContext fileManagerContext(
+        field_meta, index_meta, chunk_manager);
+
+    milvus::tracer::AutoSpan span("SegCoreCreateIndex",
+                                  build_index_info->trace_ctx);
+    span.SetAttribute("build_id", build_index_info->index_build_id);
+    span.SetAttribute("index_type", index_info.index_type.c_str());
+    span.SetAttribute(
+        "files", static_cast<int64_t>(build_index_info->insert_files.size()));
+    auto index = milvus::indexbuilder::IndexFactory::GetInstance().CreateIndex(
+        build_index_info->field_type, config, fileManagerContext);
+    index->Build();
+    // the upload is the sibling of the build under the trace of the caller
+    index->set_trace_context(build_index_info->trace_ctx);
+    return index;
+}
 
-        milvus::storage::IndexMeta index_meta{build_index_info->segment_id,
-                                              build_index_info->field_id,
-                                              build_index_info->index_build_id,
-                                              build_index_info->index_version};
-        auto chunk_manager = milvus::storage::CreateChunkManager(
-            build_index_info->storage_config);
+CStatus
+CreateIndex(CIndex* res_index, CBuildIndexInfo c_build_index_info) {
+    try {
+        auto build_index_info = (BuildIndexInfo*)c_build_index_info;
+        auto index = BuildIndexFromInsertFiles(build_index_info);
+        *res_index = index.release();
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
 
-        milvus::storage::FileManagerContext fileManagerContext(
-            field_meta, index_meta, chunk_manager);
+CStatus
+CreateIndexes(CIndex* res_indexes,
+              CBuildIndexInfo* c_build_index_infos,
+              int64_t num_indexes) {
+    try {
+        AssertInfo(num_indexes > 0, "no index to create");
+        // the first index is built by the calling thread, the others on the
+        // middle pool, the downloads of all of them go to the high pool
+        auto& pool = milvus::ThreadPools::GetThreadPool(
+            milvus::ThreadPoolPriority::MIDDLE);
+        std::vector<milvus::indexbuilder::IndexCreatorBasePtr> indexes(
+            num_indexes);
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_indexes - 1);
+        try {
+            for (int64_t i = 1; i < num_indexes; ++i) {
+                futures.emplace_back(pool.Submit([&, i]() {
+                    indexes[i] = BuildIndexFromInsertFiles(
+                        (BuildIndexInfo*)c_build_index_infos[i]);
+                }));
+            }
+            indexes[0] = BuildIndexFromInsertFiles(
+                (BuildIndexInfo*)c_build_index_infos[0]);
+            for (auto& future : futures) {
+                future.get();
+            }
+        } catch (...) {
+            // the tasks reference the indexes, wait for them before unwinding
+            for (auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
+        }
+        for (int64_t i = 0; i < num_indexes; ++i) {
+            res_indexes[i] = indexes[i].release();
+        }
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
 
-        auto index =
-            milvus::indexbuilder::IndexFactory::GetInstance().CreateIndex(
-                build_index_info->field_type, config, fileManagerContext);
-        index->Build();
-        *res_index = index.release();
+CStatus
+EstimateIndexBuildResource(CBuildIndexInfo c_build_index_info,
+                           int64_t num_rows,
+                           CIndexBuildResource* res) {
+    try {
+        auto build_index_info = (BuildIndexInfo*)c_build_index_info;
+        auto& config = build_index_info->config;
+        auto dim = build_index_info->dim;
+        if (milvus::datatype_is_vector(build_index_info->field_type) &&
+            config.contains(knowhere::meta::DIM)) {
+            dim = milvus::index::GetDimFromConfig(config);
+        }
+        auto resource = milvus::indexbuilder::EstimateBuildResource(
+            build_index_info->field_type, config, num_rows, dim);
+        res->memory_size = resource.memory_size;
+        res->disk_size = resource.disk_size;
         auto status = CStatus();
         status.error_code = Success;
         status.error_msg = "";
@@ -408,6 +504,12 @@ NewBuildIndexInfo(CBuildIndexInfo* c_build_index_info,
         storage_config.region = c_storage_config.region;
         storage_config.useVirtualHost = c_storage_config.useVirtualHost;
         storage_config.requestTimeoutMs = c_storage_config.requestTimeoutMs;
+        if (c_storage_config.readPartSize > 0) {
+            storage_config.read_part_size = c_storage_config.readPartSize;
+        }
+        if (c_storage_config.readConcurrency > 0) {
+            storage_config.read_concurrency = c_storage_config.readConcurrency;
+        }
 
         *c_build_index_info = build_index_info.release();
         auto status = CStatus();
@@ -575,6 +677,15 @@ AppendInsertFilePath(CBuildIndexInfo c_build_index_info,
     }
 }
 
+void
+AppendTraceContextToBuildInfo(CBuildIndexInfo c_build_index_info,
+                              CTraceContext c_trace) {
+    auto build_index_info = (BuildIndexInfo*)c_build_index_info;
+    auto ctx = milvus::tracer::TraceContext{
+        c_trace.traceID, c_trace.spanID, c_trace.flag};
+    build_index_info->trace_ctx = milvus::tracer::ToSpanContext(&ctx);
+}
+
 CStatus
 AppendIndexEngineVersionToBuildInfo(CBuildIndexInfo c_load_index_info,
                                     int32_t index_engine_version) {
@@ -625,8 +736,12 @@ SerializeIndexAndUpLoad(CIndex index, CBinarySet* c_binary_set) {
             "failed to serialize index to binary set, passed index was null");
         auto real_index =
             reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        milvus::tracer::AutoSpan span("SegCoreSerializeIndexAndUpload",
+                                      real_index->get_trace_context());
         auto binary =
             std::make_unique<knowhere::BinarySet>(real_index->Upload());
+        span.SetAttribute("files",
+                          static_cast<int64_t>(binary->binary_map_.size()));
         *c_binary_set = binary.release();
         status.error_code = Success;
         status.error_msg = "";
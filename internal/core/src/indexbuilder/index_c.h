@@ -29,6 +29,20 @@ CreateIndexV0(enum CDataType dtype,
 CStatus
 CreateIndex(CIndex* res_index, CBuildIndexInfo c_build_index_info);
 
+// build the indexes of several build infos at the same time, res_indexes
+// receives them in the order of the infos, all of them or none
+CStatus
+CreateIndexes(CIndex* res_indexes,
+              CBuildIndexInfo* c_build_index_infos,
+              int64_t num_indexes);
+
+// estimate the peak memory and local disk of building the index of the
+// build info on num_rows rows, before creating it
+CStatus
+EstimateIndexBuildResource(CBuildIndexInfo c_build_index_info,
+                           int64_t num_rows,
+                           CIndexBuildResource* res);
+
 CStatus
 DeleteIndex(CIndex index);
 
@@ -103,6 +117,12 @@ CStatus
 AppendIndexEngineVersionToBuildInfo(CBuildIndexInfo c_load_index_info,
                                     int32_t c_index_engine_version);
 
+// the spans of the build and of the upload of the index are the children of
+// the trace of the caller
+void
+AppendTraceContextToBuildInfo(CBuildIndexInfo c_build_index_info,
+                              CTraceContext c_trace);
+
 CStatus
 SerializeIndexAndUpLoad(CIndex index, CBinarySet* c_binary_set);
 
@@ -16,3 +16,8 @@
 typedef void* CIndex;
 typedef void* CIndexQueryResult;
 typedef void* CBuildIndexInfo;
+
+typedef struct CIndexBuildResource {
+    int64_t memory_size;
+    int64_t disk_size;
+} CIndexBuildResource;
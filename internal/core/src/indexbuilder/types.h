@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include "common/Tracer.h"
 #include "common/Types.h"
 #include "index/Index.h"
 #include "storage/Types.h"
@@ -39,4 +40,7 @@ struct BuildIndexInfo {
     std::string index_store_path;
     int64_t dim;
     int32_t index_engine_version;
+    // the trace of the caller, the spans of the build are the children of it
+    opentelemetry::trace::SpanContext trace_ctx =
+        opentelemetry::trace::SpanContext::GetInvalid();
 };
@@ -16,10 +16,18 @@
 #pragma once
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "common/Array.h"
 #include "common/EasyAssert.h"
@@ -30,9 +38,18 @@
 #include "fmt/format.h"
 #include "log/Log.h"
 #include "mmap/Utils.h"
+#include "simd/hook.h"
 
 namespace milvus {
 
+// the advice of a column mapped from a file by the access pattern of its
+// field: the vectors are gathered by offsets, the scalars are scanned by the
+// filters and are read ahead at once, as they are smaller
+inline int
+DefaultMmapAdvice(const FieldMeta& field_meta) {
+    return field_meta.is_vector() ? MADV_RANDOM : MADV_WILLNEED;
+}
+
 class ColumnBase {
  public:
     // memory mode ctor
@@ -51,15 +68,12 @@ class ColumnBase {
         auto data_type = field_meta.get_data_type();
 
         // use anon mapping so we are able to free these memory with munmap only
-        data_ = static_cast<char*>(mmap(nullptr,
-                                        cap_size_ + padding_,
-                                        PROT_READ | PROT_WRITE,
-                                        MAP_PRIVATE | MAP_ANON,
-                                        -1,
-                                        0));
-        AssertInfo(data_ != MAP_FAILED,
-                   "failed to create anon map, err: {}",
-                   strerror(errno));
+        data_ = MapAnon(cap_size_ + padding_);
+    }
+
+    // a column holding no data of its own, like the packed ones
+    ColumnBase(size_t type_size, size_t num_rows)
+        : type_size_(type_size), num_rows_(num_rows) {
     }
 
     // mmap mode ctor
@@ -72,6 +86,7 @@ class ColumnBase {
 
         size_ = size;
         cap_size_ = size;
+        mapped_ = true;
         data_ = static_cast<char*>(mmap(nullptr,
                                         cap_size_ + padding_,
                                         PROT_READ,
@@ -81,7 +96,6 @@ class ColumnBase {
         AssertInfo(data_ != MAP_FAILED,
                    "failed to create file-backed map, err: {}",
                    strerror(errno));
-        madvise(data_, cap_size_ + padding_, MADV_WILLNEED);
     }
 
     // mmap mode ctor
@@ -94,6 +108,7 @@ class ColumnBase {
           size_(size),
           cap_size_(size) {
         padding_ = data_type == DataType::JSON ? simdjson::SIMDJSON_PADDING : 0;
+        mapped_ = true;
 
         data_ = static_cast<char*>(mmap(nullptr,
                                         cap_size_ + padding_,
@@ -107,8 +122,13 @@ class ColumnBase {
     }
 
     virtual ~ColumnBase() {
+        if (locked_) {
+            MlockBudget::GetInstance().Unlock(data_, cap_size_ + padding_);
+        }
         if (data_ != nullptr) {
-            if (munmap(data_, cap_size_ + padding_)) {
+            auto ret = mapped_ ? munmap(data_, cap_size_ + padding_)
+                               : UnmapAnon(data_, cap_size_ + padding_);
+            if (ret) {
                 AssertInfo(true,
                            "failed to unmap variable field, err={}",
                            strerror(errno));
@@ -122,8 +142,12 @@ class ColumnBase {
           padding_(column.padding_),
           type_size_(column.type_size_),
           num_rows_(column.num_rows_),
-          size_(column.size_) {
+          size_(column.size_),
+          mapped_(column.mapped_),
+          locked_(column.locked_),
+          file_ref_(std::move(column.file_ref_)) {
         column.data_ = nullptr;
+        column.locked_ = false;
         column.cap_size_ = 0;
         column.padding_ = 0;
         column.num_rows_ = 0;
@@ -145,6 +169,56 @@ class ColumnBase {
         return cap_size_ + padding_;
     }
 
+    // whether the data is mapped from a file, so held by the page cache
+    // instead of the memory of the process
+    bool
+    IsMapped() const {
+        return mapped_;
+    }
+
+    // advise the kernel of the access pattern of the data mapped from a
+    // file, one of the MADV_* advices
+    void
+    Advise(int advice) {
+        if (!mapped_ || data_ == nullptr) {
+            return;
+        }
+        auto ok = madvise(data_, cap_size_ + padding_, advice);
+        AssertInfo(ok == 0,
+                   "failed to madvise the mapped column, err: {}",
+                   strerror(errno));
+    }
+
+    // lock the data mapped from a file in memory within the MlockBudget,
+    // return whether it's locked
+    bool
+    Lock() {
+        if (mapped_ && data_ != nullptr && !locked_) {
+            locked_ =
+                MlockBudget::GetInstance().Lock(data_, cap_size_ + padding_);
+        }
+        return locked_;
+    }
+
+    bool
+    IsLocked() const {
+        return locked_;
+    }
+
+    // keep a reference to the file mapped, like the lease of a shared file,
+    // released once the data is unmapped
+    void
+    HoldFile(std::shared_ptr<const void> file_ref) {
+        file_ref_ = std::move(file_ref);
+    }
+
+    // the bytes of the memory of the process held by the column, the data
+    // mapped from a file is excluded
+    virtual size_t
+    MemoryByteSize() const {
+        return mapped_ ? 0 : ByteSize();
+    }
+
     // The capacity of the column,
     // DO NOT call this for variable length column.
     size_t
@@ -186,19 +260,10 @@ class ColumnBase {
     // only for memory mode, not mmap
     void
     Expand(size_t new_size) {
-        auto data = static_cast<char*>(mmap(nullptr,
-                                            new_size + padding_,
-                                            PROT_READ | PROT_WRITE,
-                                            MAP_PRIVATE | MAP_ANON,
-                                            -1,
-                                            0));
-
-        AssertInfo(
-            data != MAP_FAILED, "failed to create map: {}", strerror(errno));
-
+        auto data = MapAnon(new_size + padding_);
         if (data_ != nullptr) {
             std::memcpy(data, data_, size_);
-            if (munmap(data_, cap_size_ + padding_)) {
+            if (UnmapAnon(data_, cap_size_ + padding_)) {
                 AssertInfo(false,
                            "failed to unmap while expanding, err={}",
                            strerror(errno));
@@ -218,6 +283,10 @@ class ColumnBase {
 
     // length in bytes
     size_t size_{0};
+    bool mapped_{false};
+    // locked within the MlockBudget, released before unmapped
+    bool locked_{false};
+    std::shared_ptr<const void> file_ref_;
 };
 
 class Column : public ColumnBase {
@@ -246,6 +315,312 @@ class Column : public ColumnBase {
     Span() const override {
         return SpanBase(data_, num_rows_, cap_size_ / num_rows_);
     }
+
+    // the inverse L2 norms of the rows of the float vector column of dim
+    // elements, computed at the first call as the rows are immutable once
+    // loaded
+    const float*
+    InvNorms(int64_t dim) const {
+        std::call_once(inv_norms_once_, [&] {
+            inv_norms_.resize(num_rows_);
+            simd::inv_norms_float(reinterpret_cast<const float*>(data_),
+                                  num_rows_,
+                                  dim,
+                                  inv_norms_.data());
+        });
+        return inv_norms_.data();
+    }
+
+ private:
+    mutable std::once_flag inv_norms_once_;
+    mutable std::vector<float> inv_norms_;
+};
+
+// PackedColumn holds the rows of a sealed integer column in blocks of
+// BLOCK_ROWS, each packed as the offsets of its values from the block minimum
+// in the fewest bits, so a block of a single value such as a run or a sorted
+// stretch of the same value takes no bits. The rows are decoded into the
+// buffer of the reader a batch at a time, Span() decodes the whole column
+// once for the readers of the raw rows
+class PackedColumn : public ColumnBase {
+ public:
+    static constexpr int64_t BLOCK_ROWS = 1024;
+
+    // pack the integer column, nullptr if the packed rows take more than
+    // max_ratio of the raw rows
+    static std::shared_ptr<PackedColumn>
+    Pack(const Column& column, DataType data_type, double max_ratio) {
+        switch (data_type) {
+            case DataType::INT8:
+                return PackRows<int8_t>(column, data_type, max_ratio);
+            case DataType::INT16:
+                return PackRows<int16_t>(column, data_type, max_ratio);
+            case DataType::INT32:
+                return PackRows<int32_t>(column, data_type, max_ratio);
+            case DataType::INT64:
+                return PackRows<int64_t>(column, data_type, max_ratio);
+            default:
+                return nullptr;
+        }
+    }
+
+    PackedColumn(DataType data_type, size_t num_rows)
+        : ColumnBase(datatype_sizeof(data_type), num_rows),
+          data_type_(data_type) {
+    }
+
+    ~PackedColumn() override = default;
+
+    DataType
+    GetDataType() const {
+        return data_type_;
+    }
+
+    // the bytes of the packed rows
+    size_t
+    PackedByteSize() const {
+        return words_.size() * sizeof(uint64_t) +
+               mins_.size() * (sizeof(int64_t) + sizeof(uint64_t) + 1);
+    }
+
+    size_t
+    MemoryByteSize() const override {
+        std::lock_guard lck(decoded_mutex_);
+        return PackedByteSize() + decoded_.capacity();
+    }
+
+    SpanBase
+    Span() const override {
+        if (!decoded_ready_.load(std::memory_order_acquire)) {
+            std::lock_guard lck(decoded_mutex_);
+            if (!decoded_ready_.load(std::memory_order_relaxed)) {
+                decoded_.resize(num_rows_ * type_size_);
+                DecodeAll();
+                decoded_ready_.store(true, std::memory_order_release);
+            }
+        }
+        return SpanBase(decoded_.data(), num_rows_, type_size_);
+    }
+
+    // decode the rows [begin, begin + n) into the buffer
+    template <typename T>
+    const T*
+    Decode(int64_t begin, int64_t n, std::vector<T>& buffer) const {
+        buffer.resize(n);
+        Decode(begin, n, buffer.data());
+        return buffer.data();
+    }
+
+    template <typename T>
+    void
+    Decode(int64_t begin, int64_t n, T* out) const {
+        auto end = begin + n;
+        while (begin < end) {
+            auto block = begin / BLOCK_ROWS;
+            auto block_end = std::min(end, (block + 1) * BLOCK_ROWS);
+            Unpack(block, begin - block * BLOCK_ROWS, block_end - begin, out);
+            out += block_end - begin;
+            begin = block_end;
+        }
+    }
+
+    template <typename T>
+    T
+    At(int64_t offset) const {
+        T value;
+        Unpack(offset / BLOCK_ROWS, offset % BLOCK_ROWS, 1, &value);
+        return value;
+    }
+
+    // decode the rows of type S at the offsets into dst
+    template <typename S, typename T = S>
+    void
+    Gather(const int64_t* offsets, int64_t count, T* dst) const {
+        for (int64_t i = 0; i < count; ++i) {
+            dst[i] = At<S>(offsets[i]);
+        }
+    }
+
+ private:
+    template <typename T>
+    static std::shared_ptr<PackedColumn>
+    PackRows(const Column& column, DataType data_type, double max_ratio) {
+        auto num_rows = static_cast<int64_t>(column.NumRows());
+        auto rows = reinterpret_cast<const T*>(column.Data());
+        auto packed = std::make_shared<PackedColumn>(data_type, num_rows);
+        auto num_blocks = (num_rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+        packed->mins_.resize(num_blocks);
+        packed->widths_.resize(num_blocks);
+        packed->starts_.resize(num_blocks);
+        uint64_t num_words = 0;
+        for (int64_t block = 0; block < num_blocks; ++block) {
+            auto begin = rows + block * BLOCK_ROWS;
+            auto end = rows + std::min(num_rows, (block + 1) * BLOCK_ROWS);
+            auto [min, max] = std::minmax_element(begin, end);
+            auto range = static_cast<uint64_t>(int64_t(*max)) -
+                         static_cast<uint64_t>(int64_t(*min));
+            uint8_t width = range == 0 ? 0 : 64 - __builtin_clzll(range);
+            packed->mins_[block] = *min;
+            packed->widths_[block] = width;
+            packed->starts_[block] = num_words;
+            num_words += ((end - begin) * width + 63) / 64;
+        }
+        // one more word, so a value is always read from two words
+        packed->words_.assign(num_words + 1, 0);
+        auto raw_size = num_rows * sizeof(T);
+        if (packed->PackedByteSize() > max_ratio * raw_size) {
+            return nullptr;
+        }
+
+        for (int64_t block = 0; block < num_blocks; ++block) {
+            auto width = packed->widths_[block];
+            if (width == 0) {
+                continue;
+            }
+            auto min = static_cast<uint64_t>(packed->mins_[block]);
+            auto words = packed->words_.data() + packed->starts_[block];
+            auto begin = block * BLOCK_ROWS;
+            auto end = std::min(num_rows, begin + BLOCK_ROWS);
+            for (int64_t i = 0; i < end - begin; ++i) {
+                auto value =
+                    static_cast<uint64_t>(int64_t(rows[begin + i])) - min;
+                uint64_t bit = i * width;
+                auto word = bit / 64;
+                auto shift = bit % 64;
+                words[word] |= value << shift;
+                if (shift + width > 64) {
+                    words[word + 1] |= value >> (64 - shift);
+                }
+            }
+        }
+        return packed;
+    }
+
+    // decode n rows from the ith row of the block, without branches so the
+    // loop is vectorized
+    template <typename T>
+    void
+    Unpack(int64_t block, int64_t i, int64_t n, T* out) const {
+        auto width = widths_[block];
+        auto min = static_cast<uint64_t>(mins_[block]);
+        if (width == 0) {
+            std::fill_n(out, n, static_cast<T>(mins_[block]));
+            return;
+        }
+        auto words = words_.data() + starts_[block];
+        uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        for (int64_t j = 0; j < n; ++j) {
+            uint64_t bit = (i + j) * width;
+            auto word = bit / 64;
+            auto shift = bit % 64;
+            // the high word is shifted in two steps, as a shift by 64 bits
+            // is undefined
+            auto value = (words[word] >> shift) |
+                         ((words[word + 1] << 1) << (63 - shift));
+            out[j] = static_cast<T>(min + (value & mask));
+        }
+    }
+
+    void
+    DecodeAll() const {
+        switch (data_type_) {
+            case DataType::INT8:
+                Decode(
+                    0, num_rows_, reinterpret_cast<int8_t*>(decoded_.data()));
+                break;
+            case DataType::INT16:
+                Decode(
+                    0, num_rows_, reinterpret_cast<int16_t*>(decoded_.data()));
+                break;
+            case DataType::INT32:
+                Decode(
+                    0, num_rows_, reinterpret_cast<int32_t*>(decoded_.data()));
+                break;
+            case DataType::INT64:
+                Decode(
+                    0, num_rows_, reinterpret_cast<int64_t*>(decoded_.data()));
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported packed data type {}",
+                          data_type_);
+        }
+    }
+
+ private:
+    DataType data_type_;
+    // the minimum, the bits of a value and the first word of every block
+    std::vector<int64_t> mins_;
+    std::vector<uint8_t> widths_;
+    std::vector<uint64_t> starts_;
+    std::vector<uint64_t> words_;
+
+    // the whole column decoded by Span()
+    mutable std::vector<char> decoded_;
+    mutable std::mutex decoded_mutex_;
+    mutable std::atomic<bool> decoded_ready_{false};
+};
+
+// reads the rows of a packed column through a buffer of one block, so the
+// readers of the rows in about the order of their offsets decode each block
+// once, and never the whole column as Span() does
+template <typename T>
+class PackedColumnReader {
+ public:
+    explicit PackedColumnReader(const PackedColumn& column)
+        : column_(column), num_rows_(column.NumRows()) {
+    }
+
+    T
+    operator[](int64_t offset) {
+        constexpr auto block_rows = PackedColumn::BLOCK_ROWS;
+        if (offset < begin_ || offset >= begin_ + int64_t(buffer_.size())) {
+            begin_ = offset / block_rows * block_rows;
+            column_.Decode(
+                begin_, std::min(block_rows, num_rows_ - begin_), buffer_);
+        }
+        return buffer_[offset - begin_];
+    }
+
+ private:
+    const PackedColumn& column_;
+    const int64_t num_rows_;
+    int64_t begin_ = 0;
+    std::vector<T> buffer_;
+};
+
+// the distinct strings of a dictionary encoded string column in ascending
+// order, and the code of every row, which is the position of its string, so
+// the filters on the rows are evaluated on the codes
+struct StringDictionary {
+    std::vector<std::string_view> values;
+    std::vector<int32_t> codes;
+
+    // the code of the first string not less than the value
+    int32_t
+    LowerBound(std::string_view value) const {
+        return std::lower_bound(values.begin(), values.end(), value) -
+               values.begin();
+    }
+
+    // the code of the first string greater than the value
+    int32_t
+    UpperBound(std::string_view value) const {
+        return std::upper_bound(values.begin(), values.end(), value) -
+               values.begin();
+    }
+
+    // the code after the last string starting with the prefix
+    int32_t
+    PrefixEnd(std::string_view prefix) const {
+        return std::partition_point(
+                   values.begin() + LowerBound(prefix),
+                   values.end(),
+                   [&](std::string_view value) {
+                       return value.substr(0, prefix.size()) == prefix;
+                   }) -
+               values.begin();
+    }
 };
 
 template <typename T>
@@ -267,31 +642,86 @@ class VariableColumn : public ColumnBase {
     VariableColumn(VariableColumn&& column) noexcept
         : ColumnBase(std::move(column)),
           indices_(std::move(column.indices_)),
-          views_(std::move(column.views_)) {
+          offsets32_(column.offsets32_),
+          offsets64_(column.offsets64_),
+          offsets32_buf_(std::move(column.offsets32_buf_)),
+          offsets64_buf_(std::move(column.offsets64_buf_)),
+          offsets_map_(column.offsets_map_),
+          offsets_map_size_(column.offsets_map_size_),
+          views_(std::move(column.views_)),
+          views_built_(column.views_built_.load()),
+          dict_(std::move(column.dict_)),
+          binary_(std::move(column.binary_)),
+          binary_offsets_(std::move(column.binary_offsets_)) {
+        column.offsets32_ = nullptr;
+        column.offsets64_ = nullptr;
+        column.offsets_map_ = nullptr;
+        column.offsets_map_size_ = 0;
     }
 
-    ~VariableColumn() override = default;
+    ~VariableColumn() override {
+        if (offsets_map_ != nullptr) {
+            if (munmap(offsets_map_, offsets_map_size_)) {
+                AssertInfo(true,
+                           "failed to unmap variable field offsets, err={}",
+                           strerror(errno));
+            }
+        }
+    }
 
     SpanBase
     Span() const override {
-        return SpanBase(views_.data(), views_.size(), sizeof(ViewType));
+        auto& views = Views();
+        return SpanBase(views.data(), views.size(), sizeof(ViewType));
     }
 
+    // the views of the rows are built on the first call, the columns only
+    // read by RawAt never keep them
     [[nodiscard]] const std::vector<ViewType>&
     Views() const {
+        if (!views_built_.load(std::memory_order_acquire)) {
+            std::lock_guard lck(views_mutex_);
+            if (!views_built_.load(std::memory_order_relaxed)) {
+                ConstructViews();
+                views_built_.store(true, std::memory_order_release);
+            }
+        }
         return views_;
     }
 
+    size_t
+    MemoryByteSize() const override {
+        auto size = ColumnBase::MemoryByteSize() +
+                    indices_.capacity() * sizeof(uint64_t) +
+                    offsets32_buf_.capacity() * sizeof(uint32_t) +
+                    offsets64_buf_.capacity() * sizeof(uint64_t);
+        if (views_built_.load(std::memory_order_acquire)) {
+            size += views_.capacity() * sizeof(ViewType);
+        }
+        if (dict_ != nullptr) {
+            size += dict_->values.capacity() * sizeof(std::string_view) +
+                    dict_->codes.capacity() * sizeof(int32_t);
+        }
+        size += binary_.capacity() +
+                binary_offsets_.capacity() * sizeof(uint64_t);
+        return size;
+    }
+
     ViewType
     operator[](const int i) const {
-        return views_[i];
+        auto raw = RawAt(i);
+        return ViewType(raw.data(), raw.size());
     }
 
     std::string_view
     RawAt(const int i) const {
-        size_t len = (i == indices_.size() - 1) ? size_ - indices_.back()
-                                                : indices_[i + 1] - indices_[i];
-        return std::string_view(data_ + indices_[i], len);
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (dict_ != nullptr) {
+                return dict_->values[dict_->codes[i]];
+            }
+        }
+        auto offset = Offset(i);
+        return std::string_view(data_ + offset, Offset(i + 1) - offset);
     }
 
     void
@@ -306,27 +736,221 @@ class VariableColumn : public ColumnBase {
             indices_ = std::move(indices);
         }
         num_rows_ = indices_.size();
-        ConstructViews();
+        if (size_ <= std::numeric_limits<uint32_t>::max()) {
+            offsets32_buf_.reserve(num_rows_ + 1);
+            offsets32_buf_.assign(indices_.begin(), indices_.end());
+            offsets32_buf_.push_back(size_);
+            offsets32_ = offsets32_buf_.data();
+        } else {
+            offsets64_buf_ = std::move(indices_);
+            offsets64_buf_.push_back(size_);
+            offsets64_ = offsets64_buf_.data();
+        }
+        std::vector<uint64_t>().swap(indices_);
+    }
+
+    // mmap mode, the offsets are written into the file after the data and
+    // mapped from there
+    void
+    Seal(std::vector<uint64_t> indices, File& file) {
+        Seal(std::move(indices));
+        auto data = offsets32_ != nullptr
+                        ? static_cast<const void*>(offsets32_)
+                        : static_cast<const void*>(offsets64_);
+        auto size = (num_rows_ + 1) * (offsets32_ != nullptr
+                                           ? sizeof(uint32_t)
+                                           : sizeof(uint64_t));
+        // the mapping of a file starts at a page boundary
+        auto page_size = static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+        auto pos = (cap_size_ + padding_ + page_size - 1) / page_size *
+                   page_size;
+        auto written = file.WriteAt(data, size, pos);
+        AssertInfo(written == size,
+                   "failed to write variable field offsets, err={}",
+                   strerror(errno));
+        auto map = static_cast<char*>(mmap(
+            nullptr, size, PROT_READ, MAP_SHARED, file.Descriptor(), pos));
+        AssertInfo(map != MAP_FAILED,
+                   "failed to map variable field offsets, err={}",
+                   strerror(errno));
+        offsets_map_ = map;
+        offsets_map_size_ = size;
+        if (offsets32_ != nullptr) {
+            offsets32_ = reinterpret_cast<const uint32_t*>(map);
+            std::vector<uint32_t>().swap(offsets32_buf_);
+        } else {
+            offsets64_ = reinterpret_cast<const uint64_t*>(map);
+            std::vector<uint64_t>().swap(offsets64_buf_);
+        }
+    }
+
+    // keep every distinct string once and the code of every row, if there
+    // are at most max_ratio distinct strings per row, the views of the rows
+    // point to the distinct strings then. Must be called after Seal
+    bool
+    EncodeDictionary(double max_ratio) {
+        static_assert(std::is_same_v<T, std::string>,
+                      "only the string columns are dictionary encoded");
+        if (num_rows_ == 0 || mapped_ || dict_ != nullptr ||
+            offsets_map_ != nullptr) {
+            return false;
+        }
+        auto max_distinct = static_cast<size_t>(max_ratio * num_rows_);
+        std::unordered_map<std::string_view, int32_t> codes;
+        for (size_t i = 0; i < num_rows_; ++i) {
+            if (codes.emplace(RawAt(i), 0).second &&
+                codes.size() > max_distinct) {
+                return false;
+            }
+        }
+
+        auto dict = std::make_unique<StringDictionary>();
+        dict->values.reserve(codes.size());
+        size_t size = 0;
+        for (auto& [value, _] : codes) {
+            dict->values.push_back(value);
+            size += value.size();
+        }
+        std::sort(dict->values.begin(), dict->values.end());
+
+        // use anon mapping like the column data, so it's freed with munmap
+        auto cap_size = std::max<size_t>(size, 1);
+        auto data = MapAnon(cap_size);
+        size_t pos = 0;
+        for (size_t code = 0; code < dict->values.size(); ++code) {
+            auto& value = dict->values[code];
+            codes[value] = code;
+            std::copy_n(value.data(), value.size(), data + pos);
+            value = std::string_view(data + pos, value.size());
+            pos += value.size();
+        }
+        dict->codes.resize(num_rows_);
+        for (size_t i = 0; i < num_rows_; ++i) {
+            dict->codes[i] = codes[RawAt(i)];
+        }
+
+        std::lock_guard lck(views_mutex_);
+        if (views_built_.load()) {
+            for (size_t i = 0; i < num_rows_; ++i) {
+                views_[i] = dict->values[dict->codes[i]];
+            }
+        }
+        if (data_ != nullptr && UnmapAnon(data_, cap_size_ + padding_)) {
+            AssertInfo(false,
+                       "failed to unmap while encoding, err={}",
+                       strerror(errno));
+        }
+        data_ = data;
+        cap_size_ = cap_size;
+        padding_ = 0;
+        size_ = size;
+        offsets32_ = nullptr;
+        offsets64_ = nullptr;
+        std::vector<uint32_t>().swap(offsets32_buf_);
+        std::vector<uint64_t>().swap(offsets64_buf_);
+        dict_ = std::move(dict);
+        return true;
+    }
+
+    // the dictionary of the string column, nullptr if it's not encoded
+    const StringDictionary*
+    Dictionary() const {
+        return dict_.get();
+    }
+
+    // keep the BinaryJson encoding of every row besides its text, the views
+    // of the rows seek the paths in it then, the text is still read by
+    // RawAt. The rows which aren't valid JSON are left to be parsed. Must be
+    // called after Seal
+    void
+    EncodeBinaryJson() {
+        static_assert(std::is_same_v<T, milvus::Json>,
+                      "only the json columns are binary encoded");
+        if (num_rows_ == 0 || !binary_offsets_.empty()) {
+            return;
+        }
+        std::string binary;
+        std::vector<uint64_t> binary_offsets(num_rows_, NOT_ENCODED);
+        for (size_t i = 0; i < num_rows_; ++i) {
+            auto raw = RawAt(i);
+            auto offset = binary.size();
+            if (BinaryJson::Encode(raw.data(), raw.size(), binary)) {
+                binary_offsets[i] = offset;
+            }
+        }
+        binary.shrink_to_fit();
+
+        std::lock_guard lck(views_mutex_);
+        binary_ = std::move(binary);
+        binary_offsets_ = std::move(binary_offsets);
+        if (views_built_.load()) {
+            for (size_t i = 0; i < num_rows_; ++i) {
+                views_[i].set_binary(BinaryAt(i));
+            }
+        }
     }
 
  protected:
+    // where the ith row starts in the data, the end of the data for the
+    // num_rows_ th
+    size_t
+    Offset(size_t i) const {
+        return offsets32_ != nullptr ? offsets32_[i] : offsets64_[i];
+    }
+
     void
-    ConstructViews() {
-        views_.reserve(indices_.size());
-        for (size_t i = 0; i < indices_.size() - 1; i++) {
-            views_.emplace_back(data_ + indices_[i],
-                                indices_[i + 1] - indices_[i]);
+    ConstructViews() const {
+        views_.reserve(num_rows_);
+        for (size_t i = 0; i < num_rows_; i++) {
+            views_.emplace_back((*this)[i]);
+            if constexpr (std::is_same_v<T, milvus::Json>) {
+                views_.back().set_binary(BinaryAt(i));
+            }
+        }
+    }
+
+    // the BinaryJson encoding of the ith row, nullptr if it's not encoded
+    const char*
+    BinaryAt(size_t i) const {
+        if (binary_offsets_.empty() || binary_offsets_[i] == NOT_ENCODED) {
+            return nullptr;
         }
-        views_.emplace_back(data_ + indices_.back(), size_ - indices_.back());
+        return binary_.data() + binary_offsets_[i];
     }
 
  private:
+    // the offsets of the rows while appending, compacted by Seal
     std::vector<uint64_t> indices_{};
 
+    // offsets of the num_rows_ rows and the end, in 32 bits if the data is
+    // under 4 GiB. They point to the buffers, or the mapped offsets of the
+    // file in mmap mode
+    const uint32_t* offsets32_{nullptr};
+    const uint64_t* offsets64_{nullptr};
+    std::vector<uint32_t> offsets32_buf_{};
+    std::vector<uint64_t> offsets64_buf_{};
+    char* offsets_map_{nullptr};
+    size_t offsets_map_size_{0};
+
     // Compatible with current Span type
-    std::vector<ViewType> views_{};
+    mutable std::vector<ViewType> views_{};
+    mutable std::mutex views_mutex_;
+    mutable std::atomic<bool> views_built_{false};
+
+    std::unique_ptr<StringDictionary> dict_{};
+
+    static constexpr uint64_t NOT_ENCODED =
+        std::numeric_limits<uint64_t>::max();
+    // the BinaryJson encodings of the rows of a json column, and where each
+    // row starts in them
+    std::string binary_{};
+    std::vector<uint64_t> binary_offsets_{};
 };
 
+// The offsets of the elements of all the rows are kept in a single CSR
+// layout, ArrayElementOffsets, instead of a vector per row, and the views of
+// the rows point into it. In mmap mode the offsets are written into the file
+// after the data and mapped from there
 class ArrayColumn : public ColumnBase {
  public:
     // memory mode ctor
@@ -344,17 +968,44 @@ class ArrayColumn : public ColumnBase {
     ArrayColumn(ArrayColumn&& column) noexcept
         : ColumnBase(std::move(column)),
           indices_(std::move(column.indices_)),
+          element_offsets_buf_(std::move(column.element_offsets_buf_)),
+          row_begins_(column.row_begins_),
+          element_offsets_(column.element_offsets_),
+          offsets_map_(column.offsets_map_),
+          offsets_map_size_(column.offsets_map_size_),
           views_(std::move(column.views_)),
           element_type_(column.element_type_) {
+        column.row_begins_ = nullptr;
+        column.element_offsets_ = nullptr;
+        column.offsets_map_ = nullptr;
+        column.offsets_map_size_ = 0;
     }
 
-    ~ArrayColumn() override = default;
+    ~ArrayColumn() override {
+        if (offsets_map_ != nullptr) {
+            if (munmap(offsets_map_, offsets_map_size_)) {
+                AssertInfo(true,
+                           "failed to unmap array field offsets, err={}",
+                           strerror(errno));
+            }
+        }
+    }
 
     SpanBase
     Span() const override {
         return SpanBase(views_.data(), views_.size(), sizeof(ArrayView));
     }
 
+    size_t
+    MemoryByteSize() const override {
+        return ColumnBase::MemoryByteSize() +
+               indices_.capacity() * sizeof(uint64_t) +
+               (element_offsets_buf_.row_begins.capacity() +
+                element_offsets_buf_.element_offsets.capacity()) *
+                   sizeof(uint64_t) +
+               views_.capacity() * sizeof(ArrayView);
+    }
+
     [[nodiscard]] const std::vector<ArrayView>&
     Views() const {
         return views_;
@@ -373,41 +1024,88 @@ class ArrayColumn : public ColumnBase {
     void
     Append(const Array& array) {
         indices_.emplace_back(size_);
-        element_indices_.emplace_back(array.get_offsets());
+        element_offsets_buf_.Append(array);
         ColumnBase::Append(static_cast<const char*>(array.data()),
                            array.byte_size());
     }
 
     void
     Seal(std::vector<uint64_t>&& indices = {},
-         std::vector<std::vector<uint64_t>>&& element_indices = {}) {
+         ArrayElementOffsets&& element_offsets = {}) {
         if (!indices.empty()) {
             indices_ = std::move(indices);
-            element_indices_ = std::move(element_indices);
+            element_offsets_buf_ = std::move(element_offsets);
         }
+        row_begins_ = element_offsets_buf_.row_begins.data();
+        element_offsets_ = element_offsets_buf_.element_offsets.data();
+        ConstructViews();
+    }
+
+    // mmap mode, the offsets of the elements are written into the file after
+    // the data and mapped from there
+    void
+    Seal(std::vector<uint64_t>&& indices,
+         ArrayElementOffsets&& element_offsets,
+         File& file) {
+        indices_ = std::move(indices);
+        element_offsets_buf_ = std::move(element_offsets);
+        auto& row_begins = element_offsets_buf_.row_begins;
+        auto& offsets = element_offsets_buf_.element_offsets;
+        auto row_begins_size = row_begins.size() * sizeof(uint64_t);
+        auto offsets_size = offsets.size() * sizeof(uint64_t);
+        auto size = row_begins_size + offsets_size;
+        // the mapping of a file starts at a page boundary
+        auto page_size = static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+        auto pos = (cap_size_ + padding_ + page_size - 1) / page_size *
+                   page_size;
+        auto written = file.WriteAt(row_begins.data(), row_begins_size, pos);
+        if (offsets_size > 0) {
+            written += file.WriteAt(
+                offsets.data(), offsets_size, pos + row_begins_size);
+        }
+        AssertInfo(written == size,
+                   "failed to write array field offsets, err={}",
+                   strerror(errno));
+        auto map = static_cast<char*>(mmap(
+            nullptr, size, PROT_READ, MAP_SHARED, file.Descriptor(), pos));
+        AssertInfo(map != MAP_FAILED,
+                   "failed to map array field offsets, err={}",
+                   strerror(errno));
+        offsets_map_ = map;
+        offsets_map_size_ = size;
+        row_begins_ = reinterpret_cast<const uint64_t*>(map);
+        element_offsets_ =
+            reinterpret_cast<const uint64_t*>(map + row_begins_size);
+        std::vector<uint64_t>().swap(row_begins);
+        std::vector<uint64_t>().swap(offsets);
         ConstructViews();
     }
 
  protected:
     void
     ConstructViews() {
-        views_.reserve(indices_.size());
-        for (size_t i = 0; i < indices_.size() - 1; i++) {
+        auto num_rows = indices_.size();
+        views_.reserve(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            auto end = i + 1 < num_rows ? indices_[i + 1] : size_;
             views_.emplace_back(data_ + indices_[i],
-                                indices_[i + 1] - indices_[i],
+                                end - indices_[i],
                                 element_type_,
-                                std::move(element_indices_[i]));
+                                element_offsets_ + row_begins_[i],
+                                row_begins_[i + 1] - row_begins_[i]);
         }
-        views_.emplace_back(data_ + indices_.back(),
-                            size_ - indices_.back(),
-                            element_type_,
-                            std::move(element_indices_[indices_.size() - 1]));
-        element_indices_.clear();
     }
 
  private:
     std::vector<uint64_t> indices_{};
-    std::vector<std::vector<uint64_t>> element_indices_{};
+    // the offsets of the elements while appending, and of the memory mode
+    ArrayElementOffsets element_offsets_buf_{};
+    // the row begins and the offsets of the elements, point to the buffers,
+    // or the mapped offsets of the file in mmap mode
+    const uint64_t* row_begins_{nullptr};
+    const uint64_t* element_offsets_{nullptr};
+    char* offsets_map_{nullptr};
+    size_t offsets_map_size_{0};
     // Compatible with current Span type
     std::vector<ArrayView> views_{};
     DataType element_type_;
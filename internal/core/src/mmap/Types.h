@@ -17,9 +17,11 @@
 
 #include <unistd.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include "common/FieldData.h"
+#include "storage/PayloadStatistics.h"
 
 namespace milvus {
 
@@ -84,5 +86,31 @@ struct FieldDataInfo {
     size_t row_count;
     std::string mmap_dir_path;
     FieldDataChannelPtr channel;
+    // the fingerprint of the binlogs for the segment snapshot, 0 if none
+    uint64_t snapshot_fingerprint = 0;
+    // the madvise advice of the mapped column, DefaultMmapAdvice if nullopt
+    std::optional<int> mmap_advice;
+    // lock the mapped column in memory within the MlockBudget
+    bool mlock = false;
+    // the statistics of the binlogs, set by the loading before the channel
+    // is closed, nullopt if any binlog has none
+    std::optional<storage::PayloadStatistics> statistics;
+};
+
+// the offsets of the elements of the rows of an array field in a single CSR
+// layout, the offsets of the elements of the ith row are
+// [row_begins[i], row_begins[i + 1]) of element_offsets. Only the arrays of
+// variable length elements have them
+struct ArrayElementOffsets {
+    std::vector<uint64_t> row_begins{0};
+    std::vector<uint64_t> element_offsets{};
+
+    void
+    Append(const Array& array) {
+        auto& offsets = array.get_offsets();
+        element_offsets.insert(
+            element_offsets.end(), offsets.begin(), offsets.end());
+        row_begins.push_back(element_offsets.size());
+    }
 };
 }  // namespace milvus
@@ -21,12 +21,17 @@
 #include <cstring>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "common/Common.h"
+#include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
+#include "log/Log.h"
 #include "mmap/Types.h"
 #include "storage/Util.h"
+#include "storage/prometheus_client.h"
 #include "common/File.h"
 
 namespace milvus {
@@ -81,7 +86,7 @@ inline size_t
 WriteFieldData(File& file,
                DataType data_type,
                const FieldDataPtr& data,
-               std::vector<std::vector<uint64_t>>& element_indices) {
+               ArrayElementOffsets& element_offsets) {
     size_t total_written{0};
     if (datatype_is_variable(data_type)) {
         switch (data_type) {
@@ -119,7 +124,7 @@ WriteFieldData(File& file,
                     if (written < array->byte_size()) {
                         break;
                     }
-                    element_indices.emplace_back(array->get_offsets());
+                    element_offsets.Append(*array);
                     total_written += written;
                 }
                 break;
@@ -135,4 +140,214 @@ WriteFieldData(File& file,
 
     return total_written;
 }
+
+// write the buffers one after another into the file at the path, every one
+// starting at a multiple of 8 bytes, and map the file read only. The file is
+// unlinked, its pages go away with the mapping. The ith buffer is at
+// positions[i] of the returned mapping of mmap_size bytes
+inline char*
+MmapBuffers(const std::string& filepath,
+            const std::vector<std::pair<const void*, size_t>>& buffers,
+            std::vector<size_t>& positions,
+            size_t& mmap_size) {
+    positions.clear();
+    mmap_size = 0;
+    for (auto& [_, size] : buffers) {
+        mmap_size = (mmap_size + 7) / 8 * 8;
+        positions.push_back(mmap_size);
+        mmap_size += size;
+    }
+    AssertInfo(mmap_size > 0, "mmap empty buffers to {}", filepath);
+
+    std::filesystem::create_directories(
+        std::filesystem::path(filepath).parent_path());
+    auto file = File::Open(filepath, O_CREAT | O_TRUNC | O_RDWR);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        auto [data, size] = buffers[i];
+        auto written = file.WriteAt(data, size, positions[i]);
+        AssertInfo(written == size,
+                   "failed to write {} bytes to {}: {}",
+                   size,
+                   filepath,
+                   strerror(errno));
+    }
+    // the last buffer may be empty
+    auto ok = ftruncate(file.Descriptor(), mmap_size);
+    AssertInfo(ok == 0,
+               "failed to truncate {} to {} bytes: {}",
+               filepath,
+               mmap_size,
+               strerror(errno));
+
+    auto data = mmap(
+        nullptr, mmap_size, PROT_READ, MAP_SHARED, file.Descriptor(), 0);
+    AssertInfo(data != MAP_FAILED,
+               "failed to mmap {}: {}",
+               filepath,
+               strerror(errno));
+    file.Close();
+    ok = unlink(filepath.c_str());
+    AssertInfo(ok == 0,
+               "failed to unlink mmap file {}: {}",
+               filepath,
+               strerror(errno));
+    return static_cast<char*>(data);
+}
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// the maps of at least a huge page are rounded up to the whole huge pages by
+// HUGE_PAGE_MODE, so they are unmapped by the same size
+inline size_t
+AnonMapSize(size_t size) {
+    if (HUGE_PAGE_MODE == HugePageMode::Disabled || size < HUGE_PAGE_SIZE) {
+        return size;
+    }
+    return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+// map an anonymous memory of size bytes, the ones of at least a huge page are
+// backed by the huge pages by HUGE_PAGE_MODE, the others by the normal pages
+inline char*
+MapAnon(size_t size) {
+    auto map_size = AnonMapSize(size);
+    if (map_size == size) {
+        auto data = mmap(nullptr,
+                         size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANON,
+                         -1,
+                         0);
+        AssertInfo(data != MAP_FAILED,
+                   "failed to create anon map, err: {}",
+                   strerror(errno));
+        storage::internal_anon_map_size_normal.Increment(size);
+        return static_cast<char*>(data);
+    }
+
+    if (HUGE_PAGE_MODE == HugePageMode::HugeTLB) {
+        auto flags = MAP_PRIVATE | MAP_ANON | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+        flags |= MAP_HUGE_2MB;
+#endif
+        auto data =
+            mmap(nullptr, map_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (data != MAP_FAILED) {
+            storage::internal_anon_map_size_huge.Increment(map_size);
+            return static_cast<char*>(data);
+        }
+        storage::internal_anon_map_huge_page_fallback.Increment();
+    }
+
+    // map a huge page more to align the map to the huge pages, so all of it
+    // could be backed by the transparent huge pages, and trim the rest
+    auto data = mmap(nullptr,
+                     map_size + HUGE_PAGE_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON,
+                     -1,
+                     0);
+    AssertInfo(data != MAP_FAILED,
+               "failed to create anon map, err: {}",
+               strerror(errno));
+    auto begin = reinterpret_cast<uintptr_t>(data);
+    auto aligned =
+        (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (aligned > begin) {
+        munmap(data, aligned - begin);
+    }
+    munmap(reinterpret_cast<void*>(aligned + map_size),
+           begin + HUGE_PAGE_SIZE - aligned);
+    // best effort, the map is backed by the normal pages if the transparent
+    // huge pages are disabled
+    madvise(reinterpret_cast<void*>(aligned), map_size, MADV_HUGEPAGE);
+    storage::internal_anon_map_size_huge.Increment(map_size);
+    return reinterpret_cast<char*>(aligned);
+}
+
+// unmap the anonymous memory mapped by MapAnon of size bytes, returns the
+// result of munmap
+inline int
+UnmapAnon(char* data, size_t size) {
+    auto map_size = AnonMapSize(size);
+    auto ret = munmap(data, map_size);
+    if (ret != 0) {
+        return ret;
+    }
+    if (map_size == size) {
+        storage::internal_anon_map_size_normal.Decrement(size);
+    } else {
+        storage::internal_anon_map_size_huge.Decrement(map_size);
+    }
+    return ret;
+}
+
+// the MADV_* advice of the read ahead policy of the name
+inline int
+MmapAdviceFromName(const std::string& name) {
+    auto iter = storage::ReadAheadPolicy_Map.find(name);
+    AssertInfo(iter != storage::ReadAheadPolicy_Map.end(),
+               "unrecognized mmap advice: {}, should be one of `normal, "
+               "random, sequential, willneed, dontneed`",
+               name);
+    return iter->second;
+}
+
+// MlockBudget bounds the bytes of the mapped regions locked in memory, so the
+// hot structures, e.g. the columns read by every search, never fault on a
+// page evicted by the page cache, while the rest of the mappings still can
+// be reclaimed. The budget is 0 by default, which locks nothing.
+class MlockBudget {
+ public:
+    static MlockBudget&
+    GetInstance() {
+        static MlockBudget instance;
+        return instance;
+    }
+
+    void
+    SetCapacity(size_t capacity_bytes) {
+        std::lock_guard lck(mutex_);
+        capacity_bytes_ = capacity_bytes;
+    }
+
+    // lock the region if it fits into the budget left, the region stays
+    // unlocked if mlock fails, e.g. over RLIMIT_MEMLOCK
+    bool
+    Lock(const void* data, size_t size) {
+        std::lock_guard lck(mutex_);
+        if (size == 0 || locked_bytes_ + size > capacity_bytes_) {
+            return false;
+        }
+        if (mlock(data, size) != 0) {
+            LOG_SEGCORE_WARNING_ << "failed to mlock " << size
+                                 << " bytes, err: " << strerror(errno);
+            return false;
+        }
+        locked_bytes_ += size;
+        return true;
+    }
+
+    // release the region locked by Lock, must be called before it's unmapped
+    void
+    Unlock(const void* data, size_t size) {
+        std::lock_guard lck(mutex_);
+        munlock(data, size);
+        locked_bytes_ -= size;
+    }
+
+    size_t
+    LockedBytes() const {
+        std::lock_guard lck(mutex_);
+        return locked_bytes_;
+    }
+
+ private:
+    MlockBudget() = default;
+
+    mutable std::mutex mutex_;
+    size_t capacity_bytes_ = 0;
+    size_t locked_bytes_ = 0;
+};
+
 }  // namespace milvus
@@ -0,0 +1,344 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "query/Aggregate.h"
+
+#include <algorithm>
+#include <boost_ext/dynamic_bitset_ext.hpp>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "index/SkipIndex.h"
+
+namespace milvus::query {
+
+namespace {
+
+// the rows are reduced in the lanes independent of each other, so that the
+// loops are vectorized
+constexpr int64_t LANES = 8;
+
+template <typename T>
+using SumType = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+template <typename T>
+struct PartialAggregate {
+    static constexpr T
+    Highest() {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::max();
+        }
+    }
+
+    static constexpr T
+    Lowest() {
+        if constexpr (std::numeric_limits<T>::has_infinity) {
+            return -std::numeric_limits<T>::infinity();
+        } else {
+            return std::numeric_limits<T>::lowest();
+        }
+    }
+
+    // NaN is never taken by the comparisons
+    void
+    Add(bool min_max, T value) {
+        if (min_max) {
+            min_ = value < min_ ? value : min_;
+            max_ = value > max_ ? value : max_;
+        } else {
+            sum_ += value;
+        }
+    }
+
+    void
+    Reduce(bool min_max, const T* data, int64_t size) {
+        int64_t i = 0;
+        if (min_max) {
+            T mins[LANES];
+            T maxs[LANES];
+            std::fill_n(mins, LANES, min_);
+            std::fill_n(maxs, LANES, max_);
+            for (; i + LANES <= size; i += LANES) {
+                for (int64_t j = 0; j < LANES; ++j) {
+                    auto value = data[i + j];
+                    mins[j] = value < mins[j] ? value : mins[j];
+                    maxs[j] = value > maxs[j] ? value : maxs[j];
+                }
+            }
+            for (int64_t j = 0; j < LANES; ++j) {
+                min_ = std::min(min_, mins[j]);
+                max_ = std::max(max_, maxs[j]);
+            }
+        } else {
+            SumType<T> sums[LANES] = {};
+            for (; i + LANES <= size; i += LANES) {
+                for (int64_t j = 0; j < LANES; ++j) {
+                    sums[j] += data[i + j];
+                }
+            }
+            for (int64_t j = 0; j < LANES; ++j) {
+                sum_ += sums[j];
+            }
+        }
+        for (; i < size; ++i) {
+            Add(min_max, data[i]);
+        }
+    }
+
+    T min_ = Highest();
+    T max_ = Lowest();
+    SumType<T> sum_ = 0;
+};
+
+// call func with the ranges of the rows in [begin, end) not set in the
+// bitset, the rows of the blocks of the bitset with some bits set are passed
+// one by one
+template <typename Func>
+void
+ForEachRun(const BitsetBlockType* blocks,
+           int64_t begin,
+           int64_t end,
+           Func func) {
+    constexpr int64_t BITS = BITSET_BLOCK_BIT_SIZE;
+    auto run_begin = begin;
+    for (auto i = begin; i < end;) {
+        auto n = std::min(BITS - i % BITS, end - i);
+        auto mask = n == BITS ? ~BitsetBlockType(0)
+                              : (BitsetBlockType(1) << n) - 1;
+        auto word = (blocks[i / BITS] >> (i % BITS)) & mask;
+        if (word == 0) {
+            i += n;
+            continue;
+        }
+        if (run_begin < i) {
+            func(run_begin, i);
+        }
+        for (auto kept = ~word & mask; kept != 0; kept &= kept - 1) {
+            auto row = i + __builtin_ctzl(kept);
+            func(row, row + 1);
+        }
+        i += n;
+        run_begin = i;
+    }
+    if (run_begin < end) {
+        func(run_begin, end);
+    }
+}
+
+bool
+NoneSet(const BitsetType& bitset, int64_t begin, int64_t end) {
+    auto blocks =
+        reinterpret_cast<const BitsetBlockType*>(boost_ext::get_data(bitset));
+    bool none = false;
+    ForEachRun(blocks, begin, end, [&](int64_t first, int64_t last) {
+        none = first == begin && last == end;
+    });
+    return none;
+}
+
+template <typename T>
+DataArray
+ToDataArray(const AggregateInfo& aggregate,
+            const PartialAggregate<T>& state,
+            int64_t num_rows) {
+    DataArray data;
+    data.set_field_id(aggregate.field_id_.get());
+    auto scalars = data.mutable_scalars();
+    if (aggregate.op_ == AggregateOp::Sum ||
+        aggregate.op_ == AggregateOp::Avg) {
+        if constexpr (std::is_integral_v<T>) {
+            data.set_type(proto::schema::DataType::Int64);
+            scalars->mutable_long_data()->add_data(state.sum_);
+        } else {
+            data.set_type(proto::schema::DataType::Double);
+            scalars->mutable_double_data()->add_data(state.sum_);
+        }
+        return data;
+    }
+
+    data.set_type(
+        static_cast<proto::schema::DataType>(aggregate.data_type_));
+    auto value = aggregate.op_ == AggregateOp::Min ? state.min_ : state.max_;
+    if constexpr (std::is_same_v<T, int64_t>) {
+        auto values = scalars->mutable_long_data();
+        if (num_rows > 0) {
+            values->add_data(value);
+        }
+    } else if constexpr (std::is_integral_v<T>) {
+        auto values = scalars->mutable_int_data();
+        if (num_rows > 0) {
+            values->add_data(value);
+        }
+    } else if constexpr (std::is_same_v<T, float>) {
+        auto values = scalars->mutable_float_data();
+        if (num_rows > 0) {
+            values->add_data(value);
+        }
+    } else {
+        auto values = scalars->mutable_double_data();
+        if (num_rows > 0) {
+            values->add_data(value);
+        }
+    }
+    return data;
+}
+
+template <typename T>
+DataArray
+Aggregate(const segcore::SegmentInternalInterface& segment,
+          const AggregateInfo& aggregate,
+          const BitsetType& bitset,
+          int64_t num_rows) {
+    PartialAggregate<T> state;
+    auto min_max = aggregate.op_ == AggregateOp::Min ||
+                   aggregate.op_ == AggregateOp::Max;
+    auto field_id = aggregate.field_id_;
+    auto active_count = static_cast<int64_t>(bitset.size());
+    auto blocks =
+        reinterpret_cast<const BitsetBlockType*>(boost_ext::get_data(bitset));
+    if (num_rows == 0) {
+        return ToDataArray(aggregate, state, num_rows);
+    }
+
+    if (segment.num_chunk_data(field_id) == 0) {
+        // only the scalar index holds the values
+        auto& index = segment.chunk_scalar_index<T>(field_id, 0);
+        ForEachRun(blocks, 0, active_count, [&](int64_t begin, int64_t end) {
+            for (auto row = begin; row < end; ++row) {
+                state.Add(min_max, index.Reverse_Lookup(row));
+            }
+        });
+        return ToDataArray(aggregate, state, num_rows);
+    }
+
+    // the packed rows are decoded a block at a time rather than through
+    // chunk_data, which decodes the whole column and keeps it
+    const PackedColumn* packed = nullptr;
+    std::vector<T> buffer;
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        packed = segment.GetPackedColumn(field_id);
+    }
+
+    auto& skip_index = segment.GetSkipIndex();
+    auto size_per_chunk = segment.size_per_chunk();
+    auto num_chunk = segment.num_chunk_data(field_id);
+    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        auto chunk_begin = chunk_id * size_per_chunk;
+        if (chunk_begin >= active_count) {
+            break;
+        }
+        const T* data = nullptr;
+        int64_t chunk_rows = 0;
+        if (packed != nullptr) {
+            chunk_rows = static_cast<int64_t>(packed->NumRows());
+        } else {
+            auto span = segment.chunk_data<T>(field_id, chunk_id);
+            data = span.data();
+            chunk_rows = span.row_count();
+        }
+        auto chunk_end = std::min(chunk_begin + chunk_rows, active_count);
+        auto reduce = [&](int64_t begin, int64_t end) {
+            if (data != nullptr) {
+                state.Reduce(min_max, data + begin - chunk_begin, end - begin);
+                return;
+            }
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                // a packed column is the single chunk of a sealed segment
+                for (auto row = begin; row < end;
+                     row += PackedColumn::BLOCK_ROWS) {
+                    auto n = std::min(PackedColumn::BLOCK_ROWS, end - row);
+                    state.Reduce(min_max, packed->Decode(row, n, buffer), n);
+                }
+            }
+        };
+        if (!min_max) {
+            ForEachRun(blocks, chunk_begin, chunk_end, reduce);
+            continue;
+        }
+
+        for (auto begin = chunk_begin; begin < chunk_end;
+             begin += SkipIndex::BLOCK_ROWS) {
+            auto block_id = (begin - chunk_begin) / SkipIndex::BLOCK_ROWS;
+            auto block_rows = std::min(SkipIndex::BLOCK_ROWS,
+                                       chunk_begin + chunk_rows - begin);
+            auto end = std::min(begin + block_rows, chunk_end);
+            std::optional<std::pair<T, T>> zone_map;
+            if (end - begin == block_rows && NoneSet(bitset, begin, end)) {
+                zone_map =
+                    skip_index.BlockMinMax<T>(field_id, chunk_id, block_id);
+            }
+            if (zone_map.has_value()) {
+                state.min_ = std::min(state.min_, zone_map->first);
+                state.max_ = std::max(state.max_, zone_map->second);
+            } else {
+                ForEachRun(blocks, begin, end, reduce);
+            }
+        }
+    }
+    return ToDataArray(aggregate, state, num_rows);
+}
+
+}  // namespace
+
+std::vector<DataArray>
+AggregateRows(const segcore::SegmentInternalInterface& segment,
+              const std::vector<AggregateInfo>& aggregates,
+              const BitsetType& bitset) {
+    auto num_rows = static_cast<int64_t>(bitset.size() - bitset.count());
+    std::vector<DataArray> results;
+    for (auto& aggregate : aggregates) {
+        switch (aggregate.data_type_) {
+            case DataType::INT8:
+                results.push_back(
+                    Aggregate<int8_t>(segment, aggregate, bitset, num_rows));
+                break;
+            case DataType::INT16:
+                results.push_back(
+                    Aggregate<int16_t>(segment, aggregate, bitset, num_rows));
+                break;
+            case DataType::INT32:
+                results.push_back(
+                    Aggregate<int32_t>(segment, aggregate, bitset, num_rows));
+                break;
+            case DataType::INT64:
+                results.push_back(
+                    Aggregate<int64_t>(segment, aggregate, bitset, num_rows));
+                break;
+            case DataType::FLOAT:
+                results.push_back(
+                    Aggregate<float>(segment, aggregate, bitset, num_rows));
+                break;
+            case DataType::DOUBLE:
+                results.push_back(
+                    Aggregate<double>(segment, aggregate, bitset, num_rows));
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported data type {} of the aggregated field",
+                          aggregate.data_type_);
+        }
+    }
+
+    DataArray count;
+    count.set_type(proto::schema::DataType::Int64);
+    count.mutable_scalars()->mutable_long_data()->add_data(num_rows);
+    results.push_back(std::move(count));
+    return results;
+}
+
+}  // namespace milvus::query
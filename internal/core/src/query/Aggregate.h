@@ -0,0 +1,38 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+
+#include <vector>
+
+#include "common/Types.h"
+#include "query/PlanNode.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+// The partial states of the aggregates over the rows of the segment not set
+// in the bitset, one column for every aggregate, followed by the number of
+// the aggregated rows:
+// - Min and Max are of the type of the field, empty if no row is aggregated,
+//   NaN isn't counted in them
+// - Sum is the int64 sum of an integer field or the double sum of a float
+//   field, so is Avg, which is the merged sum divided by the merged number
+//   of the rows
+// The min and max of the blocks of which all the rows are aggregated are
+// taken from the zone maps of the skip index instead of the rows.
+std::vector<DataArray>
+AggregateRows(const segcore::SegmentInternalInterface& segment,
+              const std::vector<AggregateInfo>& aggregates,
+              const BitsetType& bitset);
+
+}  // namespace milvus::query
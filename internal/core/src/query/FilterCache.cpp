@@ -0,0 +1,181 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "query/FilterCache.h"
+
+#include <boost_ext/dynamic_bitset_ext.hpp>
+
+namespace milvus::query {
+
+namespace {
+
+enum RunKind : uint64_t { Empty = 0, Full = 1, Literal = 2 };
+
+constexpr int KIND_SHIFT = 62;
+constexpr uint64_t LENGTH_MASK = (uint64_t(1) << KIND_SHIFT) - 1;
+
+uint64_t
+RunHeader(RunKind kind, uint64_t length) {
+    return uint64_t(kind) << KIND_SHIFT | length;
+}
+
+}  // namespace
+
+std::vector<uint64_t>
+FilterCache::Compress(const BitsetType& bitset) {
+    static_assert(sizeof(BitsetBlockType) == sizeof(uint64_t));
+    auto blocks =
+        reinterpret_cast<const BitsetBlockType*>(boost_ext::get_data(bitset));
+    auto num_blocks = static_cast<int64_t>(bitset.num_blocks());
+    // the unused bits of the last block are 0, it's full if the used are 1
+    auto full_block = [&](int64_t i) {
+        if (i + 1 < num_blocks || bitset.size() % BITSET_BLOCK_BIT_SIZE == 0) {
+            return blocks[i] == ~BitsetBlockType(0);
+        }
+        auto used = bitset.size() % BITSET_BLOCK_BIT_SIZE;
+        return blocks[i] == (BitsetBlockType(1) << used) - 1;
+    };
+    auto kind_of = [&](int64_t i) {
+        return blocks[i] == 0 ? Empty : full_block(i) ? Full : Literal;
+    };
+
+    std::vector<uint64_t> words;
+    for (int64_t i = 0; i < num_blocks;) {
+        auto kind = kind_of(i);
+        auto end = i + 1;
+        while (end < num_blocks && kind_of(end) == kind) {
+            ++end;
+        }
+        words.push_back(RunHeader(kind, end - i));
+        if (kind == Literal) {
+            words.insert(words.end(), blocks + i, blocks + end);
+        }
+        i = end;
+    }
+    words.shrink_to_fit();
+    return words;
+}
+
+void
+FilterCache::Decompress(const std::vector<uint64_t>& words,
+                        int64_t num_bits,
+                        BitsetType& bitset) {
+    std::vector<BitsetBlockType> blocks;
+    blocks.reserve((num_bits + BITSET_BLOCK_BIT_SIZE - 1) /
+                   BITSET_BLOCK_BIT_SIZE);
+    for (size_t i = 0; i < words.size();) {
+        auto kind = RunKind(words[i] >> KIND_SHIFT);
+        auto length = words[i] & LENGTH_MASK;
+        ++i;
+        if (kind == Literal) {
+            blocks.insert(blocks.end(), &words[i], &words[i] + length);
+            i += length;
+        } else {
+            blocks.resize(blocks.size() + length,
+                          kind == Full ? ~BitsetBlockType(0) : 0);
+        }
+    }
+    bitset.clear();
+    bitset.append(blocks.begin(), blocks.end());
+    bitset.resize(num_bits);
+}
+
+void
+FilterCache::SetCapacity(int64_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity_bytes;
+    EvictLocked();
+}
+
+bool
+FilterCache::Get(const void* segment,
+                 const std::string& expr,
+                 int64_t num_rows,
+                 BitsetType& bitset) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto segment_entries = index_.find(segment);
+    if (segment_entries == index_.end()) {
+        return false;
+    }
+    auto iter = segment_entries->second.find(expr);
+    if (iter == segment_entries->second.end() ||
+        iter->second->num_bits != num_rows) {
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    Decompress(iter->second->words, num_rows, bitset);
+    hit_count_++;
+    return true;
+}
+
+void
+FilterCache::Put(const void* segment,
+                 const std::string& expr,
+                 const BitsetType& bitset) {
+    // compress without the lock
+    auto words = Compress(bitset);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ <= 0) {
+        return;
+    }
+    auto& segment_entries = index_[segment];
+    auto iter = segment_entries.find(expr);
+    if (iter != segment_entries.end()) {
+        EraseLocked(iter->second);
+    }
+    entries_.push_front(Entry{segment,
+                              expr,
+                              static_cast<int64_t>(bitset.size()),
+                              std::move(words)});
+    index_[segment].emplace(expr, entries_.begin());
+    size_bytes_ += entries_.front().bytes();
+    EvictLocked();
+}
+
+void
+FilterCache::Erase(const void* segment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto segment_entries = index_.find(segment);
+    if (segment_entries == index_.end()) {
+        return;
+    }
+    for (auto& [expr, entry] : segment_entries->second) {
+        size_bytes_ -= entry->bytes();
+        entries_.erase(entry);
+    }
+    index_.erase(segment_entries);
+}
+
+void
+FilterCache::EraseLocked(Entries::iterator entry) {
+    size_bytes_ -= entry->bytes();
+    auto segment_entries = index_.find(entry->segment);
+    segment_entries->second.erase(entry->expr);
+    if (segment_entries->second.empty()) {
+        index_.erase(segment_entries);
+    }
+    entries_.erase(entry);
+}
+
+// a bitset larger than the budget is evicted at once
+void
+FilterCache::EvictLocked() {
+    while (!entries_.empty() && size_bytes_ > capacity_) {
+        EraseLocked(std::prev(entries_.end()));
+    }
+}
+
+}  // namespace milvus::query
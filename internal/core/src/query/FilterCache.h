@@ -0,0 +1,133 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::query {
+
+// FilterCache keeps the bitsets of the filters evaluated on the sealed
+// segments, so a filter repeated on a segment, like the ones of the
+// dashboards, is copied from the cache instead of evaluated again. The
+// bitsets are the ones before the invisible and the deleted rows are masked,
+// and the rows of a sealed segment never change, so an entry stays valid
+// across the deletes until the data of the segment is loaded, dropped or
+// released. The entries are keyed by the segment and the string of the
+// filter expr.
+//
+// The bitsets are kept compressed, the runs of the empty and of the full
+// blocks as their lengths, in a budget of bytes, the least recently used
+// ones are evicted first. The budget is 0 by default, which disables the
+// caching.
+class FilterCache {
+ public:
+    static FilterCache&
+    GetInstance() {
+        static FilterCache cache;
+        return cache;
+    }
+
+    void
+    SetCapacity(int64_t capacity_bytes);
+
+    bool
+    enabled() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_ > 0;
+    }
+
+    // whether the bitset of the filter of num_rows rows on the segment is
+    // cached, it's decompressed into bitset if so
+    bool
+    Get(const void* segment,
+        const std::string& expr,
+        int64_t num_rows,
+        BitsetType& bitset);
+
+    void
+    Put(const void* segment, const std::string& expr, const BitsetType& bitset);
+
+    // drop the entries of the segment
+    void
+    Erase(const void* segment);
+
+    int64_t
+    hit_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hit_count_;
+    }
+
+    int64_t
+    size_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_bytes_;
+    }
+
+    // the bitset as the words of the runs of the empty and the full blocks
+    // and of the blocks between them, each run or literal run headed by a
+    // word of its kind and length
+    static std::vector<uint64_t>
+    Compress(const BitsetType& bitset);
+
+    static void
+    Decompress(const std::vector<uint64_t>& words,
+               int64_t num_bits,
+               BitsetType& bitset);
+
+ private:
+    FilterCache() = default;
+
+    struct Entry {
+        const void* segment;
+        std::string expr;
+        int64_t num_bits;
+        std::vector<uint64_t> words;
+
+        int64_t
+        bytes() const {
+            return sizeof(Entry) + expr.size() +
+                   words.size() * sizeof(uint64_t);
+        }
+    };
+    // the least recently used entries are the last ones
+    using Entries = std::list<Entry>;
+
+    void
+    EraseLocked(Entries::iterator entry);
+
+    void
+    EvictLocked();
+
+ private:
+    mutable std::mutex mutex_;
+    int64_t capacity_ = 0;
+    int64_t size_bytes_ = 0;
+    int64_t hit_count_ = 0;
+    Entries entries_;
+    std::unordered_map<const void*,
+                       std::unordered_map<std::string, Entries::iterator>>
+        index_;
+};
+
+}  // namespace milvus::query
@@ -0,0 +1,168 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/GroupBy.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "query/SubSearchResult.h"
+
+namespace milvus::query {
+
+// the values of the rows at the offsets in the data subscripted from them
+static std::vector<GroupByValueType>
+GetGroupByValues(const DataArray& data, DataType data_type) {
+    std::vector<GroupByValueType> values;
+    auto& scalars = data.scalars();
+    switch (data_type) {
+        case DataType::BOOL: {
+            for (auto value : scalars.bool_data().data()) {
+                values.emplace_back(value);
+            }
+            break;
+        }
+        case DataType::INT8: {
+            for (auto value : scalars.int_data().data()) {
+                values.emplace_back(static_cast<int8_t>(value));
+            }
+            break;
+        }
+        case DataType::INT16: {
+            for (auto value : scalars.int_data().data()) {
+                values.emplace_back(static_cast<int16_t>(value));
+            }
+            break;
+        }
+        case DataType::INT32: {
+            for (auto value : scalars.int_data().data()) {
+                values.emplace_back(static_cast<int32_t>(value));
+            }
+            break;
+        }
+        case DataType::INT64: {
+            for (auto value : scalars.long_data().data()) {
+                values.emplace_back(static_cast<int64_t>(value));
+            }
+            break;
+        }
+        case DataType::VARCHAR: {
+            for (auto& value : scalars.string_data().data()) {
+                values.emplace_back(std::string(value));
+            }
+            break;
+        }
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unsupported data type {} of the group by field",
+                      data_type);
+    }
+    return values;
+}
+
+void
+GroupBySearch(const segcore::SegmentInternalInterface& segment,
+              const SearchInfo& info,
+              const void* query_data,
+              int64_t num_queries,
+              Timestamp timestamp,
+              const BitsetView& bitset,
+              SearchResult& results) {
+    AssertInfo(info.group_by_field_id_.has_value(),
+               "group by search without the group by field");
+    auto group_by_field_id = info.group_by_field_id_.value();
+    auto data_type = segment.get_schema()[group_by_field_id].get_data_type();
+    auto topk = info.topk_;
+    auto active_count = segment.get_active_count(timestamp);
+    auto max_topk = std::min(active_count, DEFAULT_GROUP_BY_MAX_TOPK);
+    auto search_info = info;
+    search_info.group_by_field_id_.reset();
+
+    std::vector<int64_t> offsets;
+    std::vector<GroupByValueType> values;
+    std::unordered_set<GroupByValueType> groups;
+    auto candidate_topk = std::min(topk * 4, max_topk);
+    for (;;) {
+        search_info.topk_ = candidate_topk;
+        SearchResult candidates;
+        segment.vector_search(search_info,
+                              query_data,
+                              num_queries,
+                              timestamp,
+                              bitset,
+                              candidates);
+
+        // the values of the valid candidates, in the order of the candidates
+        offsets.clear();
+        for (auto offset : candidates.seg_offsets_) {
+            if (offset != INVALID_SEG_OFFSET) {
+                offsets.push_back(offset);
+            }
+        }
+        auto data = segment.bulk_subscript(
+            group_by_field_id, offsets.data(), offsets.size());
+        values = GetGroupByValues(*data, data_type);
+        AssertInfo(values.size() == offsets.size(),
+                   "got {} group by values of {} rows",
+                   values.size(),
+                   offsets.size());
+
+        // a query is done if it has topk groups, or there are no more
+        // candidates for it
+        SubSearchResult grouped(
+            num_queries, topk, info.metric_type_, info.round_decimal_);
+        results.group_by_values_.assign(num_queries * topk,
+                                        GroupByValueType());
+        bool done = true;
+        size_t value_index = 0;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            groups.clear();
+            int64_t num_groups = 0;
+            bool exhausted = candidate_topk >= active_count;
+            for (int64_t i = 0; i < candidate_topk; ++i) {
+                auto pos = q * candidate_topk + i;
+                auto offset = candidates.seg_offsets_[pos];
+                if (offset == INVALID_SEG_OFFSET) {
+                    exhausted = true;
+                    continue;
+                }
+                auto& value = values[value_index++];
+                if (num_groups == topk || !groups.insert(value).second) {
+                    continue;
+                }
+                // the candidates are in order, the first of a group is the
+                // best of it
+                auto dst = q * topk + num_groups;
+                grouped.mutable_seg_offsets()[dst] = offset;
+                grouped.mutable_distances()[dst] = candidates.distances_[pos];
+                results.group_by_values_[dst] = value;
+                ++num_groups;
+            }
+            done = done && (num_groups == topk || exhausted);
+        }
+
+        if (done || candidate_topk >= max_topk) {
+            results.total_nq_ = num_queries;
+            results.unity_topK_ = topk;
+            results.seg_offsets_ = std::move(grouped.mutable_seg_offsets());
+            results.distances_ = std::move(grouped.mutable_distances());
+            return;
+        }
+        candidate_topk = std::min(candidate_topk * 4, max_topk);
+    }
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,37 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include "common/BitsetView.h"
+#include "common/QueryInfo.h"
+#include "common/QueryResult.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+// Search the best result of every group of the rows with the same value of
+// the group by field, the topk groups with the best results are kept in
+// order. The candidates are searched without grouping and widened until every
+// query gets topk groups of them, or there are no more candidates, the groups
+// met only beyond DEFAULT_GROUP_BY_MAX_TOPK candidates are missed.
+//
+// The group by values of the results are set in results.group_by_values_.
+void
+GroupBySearch(const segcore::SegmentInternalInterface& segment,
+              const SearchInfo& info,
+              const void* query_data,
+              int64_t num_queries,
+              Timestamp timestamp,
+              const BitsetView& bitset,
+              SearchResult& results);
+
+}  // namespace milvus::query
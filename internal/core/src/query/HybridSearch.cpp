@@ -0,0 +1,134 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/HybridSearch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "common/Utils.h"
+
+namespace milvus::query {
+
+static const Placeholder&
+FindPlaceholder(const PlaceholderGroup& placeholder_group,
+                const std::string& tag) {
+    for (auto& placeholder : placeholder_group) {
+        if (placeholder.tag_ == tag) {
+            return placeholder;
+        }
+    }
+    PanicInfo(UnexpectedError, "no placeholder of tag {}", tag);
+}
+
+// maps the distance into [0, 1], the larger the better
+static float
+NormalizeScore(const MetricType& metric_type, float distance) {
+    if (PositivelyRelated(metric_type)) {
+        return 0.5f + std::atan(distance) / static_cast<float>(M_PI);
+    }
+    return 1.0f - 2.0f * std::atan(distance) / static_cast<float>(M_PI);
+}
+
+void
+HybridSearch(const segcore::SegmentInternalInterface& segment,
+             const VectorPlanNode& node,
+             const PlaceholderGroup& placeholder_group,
+             Timestamp timestamp,
+             const BitsetView& bitset,
+             SearchResult& results) {
+    std::vector<SearchInfo> search_infos{node.search_info_};
+    std::vector<const Placeholder*> placeholders{
+        &FindPlaceholder(placeholder_group, node.placeholder_tag_)};
+    for (auto& sub_search : node.sub_searches_) {
+        search_infos.push_back(sub_search.search_info_);
+        placeholders.push_back(
+            &FindPlaceholder(placeholder_group, sub_search.placeholder_tag_));
+    }
+    auto num_queries = placeholders[0]->num_of_queries_;
+
+    // the bitset is shared by all the searches
+    std::vector<SearchResult> search_results(search_infos.size());
+    for (size_t i = 0; i < search_infos.size(); ++i) {
+        AssertInfo(placeholders[i]->num_of_queries_ == num_queries,
+                   "{} queries of placeholder {}, expected {}",
+                   placeholders[i]->num_of_queries_,
+                   placeholders[i]->tag_,
+                   num_queries);
+        segment.vector_search(search_infos[i],
+                              placeholders[i]->blob_.data(),
+                              num_queries,
+                              timestamp,
+                              bitset,
+                              search_results[i]);
+    }
+
+    auto& fusion_info = node.fusion_info_;
+    auto topk = node.search_info_.topk_;
+    results.total_nq_ = num_queries;
+    results.unity_topK_ = topk;
+    results.seg_offsets_.assign(num_queries * topk, INVALID_SEG_OFFSET);
+    results.distances_.assign(num_queries * topk,
+                              std::numeric_limits<float>::lowest());
+    std::unordered_map<int64_t, float> scores;
+    std::vector<std::pair<float, int64_t>> fused;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        scores.clear();
+        for (size_t i = 0; i < search_results.size(); ++i) {
+            auto& search_result = search_results[i];
+            auto search_topk = search_infos[i].topk_;
+            for (int64_t rank = 0; rank < search_topk; ++rank) {
+                auto pos = q * search_topk + rank;
+                auto offset = search_result.seg_offsets_[pos];
+                if (offset == INVALID_SEG_OFFSET) {
+                    break;
+                }
+                float score = 0;
+                if (fusion_info.fusion_type_ == FusionType::RRF) {
+                    score = 1.0f / (fusion_info.rrf_k_ + rank + 1);
+                } else {
+                    score = fusion_info.weights_[i] *
+                            NormalizeScore(search_infos[i].metric_type_,
+                                           search_result.distances_[pos]);
+                }
+                scores[offset] += score;
+            }
+        }
+
+        fused.clear();
+        for (auto& [offset, score] : scores) {
+            fused.emplace_back(score, offset);
+        }
+        auto num_fused = std::min<int64_t>(topk, fused.size());
+        std::partial_sort(fused.begin(),
+                          fused.begin() + num_fused,
+                          fused.end(),
+                          [](const auto& lhs, const auto& rhs) {
+                              if (lhs.first != rhs.first) {
+                                  return lhs.first > rhs.first;
+                              }
+                              return lhs.second < rhs.second;
+                          });
+        for (int64_t i = 0; i < num_fused; ++i) {
+            results.distances_[q * topk + i] = fused[i].first;
+            results.seg_offsets_[q * topk + i] = fused[i].second;
+        }
+    }
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,37 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include "common/BitsetView.h"
+#include "common/QueryResult.h"
+#include "query/PlanImpl.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+// Search the field of the node and the fields of its sub searches with the
+// same filtered bitset, and fuse the results into the topk ones of the node
+// by the fused scores of the rows, the larger the better.
+//
+// RRF scores a row sum(1 / (k + rank)) of its ranks in the results of the
+// searches, WeightedSum scores it sum(weight * score) of the distances
+// normalized into [0, 1] as the scores. A search gives nothing to the rows
+// not in its results.
+void
+HybridSearch(const segcore::SegmentInternalInterface& segment,
+             const VectorPlanNode& node,
+             const PlaceholderGroup& placeholder_group,
+             Timestamp timestamp,
+             const BitsetView& bitset,
+             SearchResult& results);
+
+}  // namespace milvus::query
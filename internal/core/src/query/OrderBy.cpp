@@ -0,0 +1,227 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "query/OrderBy.h"
+
+#include <cmath>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "index/ScalarIndexSort.h"
+#include "segcore/InsertRecord.h"
+
+namespace milvus::query {
+
+namespace {
+
+// NaN comes after all the other values
+template <typename V>
+bool
+Less(const V& a, const V& b) {
+    if constexpr (std::is_floating_point_v<V>) {
+        return !std::isnan(a) && (std::isnan(b) || a < b);
+    } else {
+        return a < b;
+    }
+}
+
+// the first limit rows kept in the order of their values, value_at(offset) is
+// the value of the row
+template <typename V, typename ValueAt>
+std::vector<int64_t>
+TopN(const BitsetType& kept, int64_t limit, bool descending, ValueAt value_at) {
+    using Entry = std::pair<V, int64_t>;
+    auto before = [descending](const Entry& x, const Entry& y) {
+        if (Less(x.first, y.first)) {
+            return !descending;
+        }
+        if (Less(y.first, x.first)) {
+            return descending;
+        }
+        return x.second < y.second;
+    };
+    // the last one of the first rows met so far is on the top
+    std::priority_queue<Entry, std::vector<Entry>, decltype(before)> heap(
+        before);
+    for (auto offset = kept.find_first(); offset != BitsetType::npos;
+         offset = kept.find_next(offset)) {
+        Entry entry{value_at(offset), offset};
+        if (static_cast<int64_t>(heap.size()) < limit) {
+            heap.push(std::move(entry));
+        } else if (before(entry, heap.top())) {
+            heap.pop();
+            heap.push(std::move(entry));
+        }
+    }
+
+    std::vector<int64_t> offsets(heap.size());
+    for (auto i = static_cast<int64_t>(offsets.size()) - 1; i >= 0; --i) {
+        offsets[i] = heap.top().second;
+        heap.pop();
+    }
+    return offsets;
+}
+
+// the first limit rows kept met by walking the sorted index in its order
+template <typename T>
+std::vector<int64_t>
+WalkIndex(const index::ScalarIndexSort<T>& index,
+          int64_t size,
+          int64_t limit,
+          bool descending,
+          const BitsetType& kept) {
+    auto offsets = index.GetOffsets();
+    std::vector<int64_t> seg_offsets;
+    seg_offsets.reserve(limit);
+    for (int64_t i = 0;
+         i < size && static_cast<int64_t>(seg_offsets.size()) < limit;
+         ++i) {
+        auto offset = offsets[descending ? size - 1 - i : i];
+        if (static_cast<size_t>(offset) < kept.size() && kept[offset]) {
+            seg_offsets.push_back(offset);
+        }
+    }
+    return seg_offsets;
+}
+
+template <typename T>
+std::vector<int64_t>
+FindFirst(const segcore::SegmentInternalInterface& segment,
+          const OrderByInfo& order_by,
+          int64_t limit,
+          const BitsetType& kept,
+          int64_t num_kept) {
+    auto field_id = order_by.field_id_;
+    auto descending = order_by.descending_;
+    // the sorted index may hold NaN out of the order of Less, so only the
+    // integers are walked in it
+    if constexpr (std::is_integral_v<T>) {
+        if (segment.type() == SegmentType::Sealed &&
+            segment.num_chunk_index(field_id) > 0) {
+            auto index = dynamic_cast<const index::ScalarIndexSort<T>*>(
+                &segment.chunk_scalar_index<T>(field_id, 0));
+            auto size = segment.get_row_count();
+            // walking the index meets about limit * size / num_kept rows to
+            // find limit rows kept
+            if (index != nullptr && limit * size / num_kept < num_kept) {
+                return WalkIndex(*index, size, limit, descending, kept);
+            }
+        }
+    }
+
+    if (segment.num_chunk_data(field_id) == 0) {
+        // only the scalar index holds the values
+        auto& index = segment.chunk_scalar_index<T>(field_id, 0);
+        return TopN<T>(kept, limit, descending, [&](int64_t offset) {
+            return index.Reverse_Lookup(offset);
+        });
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        // the kept rows are met in the order of their offsets, so the packed
+        // blocks are decoded once each rather than the whole column by
+        // chunk_data
+        auto packed = segment.GetPackedColumn(field_id);
+        if (packed != nullptr) {
+            PackedColumnReader<T> reader(*packed);
+            return TopN<T>(kept, limit, descending, [&](int64_t offset) {
+                return reader[offset];
+            });
+        }
+    }
+
+    // the strings of the growing segments are std::string, while the sealed
+    // are viewed in the column
+    using ChunkType = std::conditional_t<std::is_same_v<T, std::string>,
+                                         std::string_view,
+                                         T>;
+    auto size_per_chunk = segment.size_per_chunk();
+    auto num_chunk = segment.num_chunk_data(field_id);
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (segment.type() == SegmentType::Growing) {
+            std::vector<Span<std::string>> spans;
+            for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+                spans.push_back(
+                    segment.chunk_data<std::string>(field_id, chunk_id));
+            }
+            return TopN<std::string_view>(
+                kept, limit, descending, [&](int64_t offset) {
+                    auto& span = spans[offset / size_per_chunk];
+                    return std::string_view(
+                        span.data()[offset % size_per_chunk]);
+                });
+        }
+    }
+    std::vector<Span<ChunkType>> spans;
+    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        spans.push_back(segment.chunk_data<ChunkType>(field_id, chunk_id));
+    }
+    return TopN<ChunkType>(kept, limit, descending, [&](int64_t offset) {
+        return spans[offset / size_per_chunk].data()[offset % size_per_chunk];
+    });
+}
+
+}  // namespace
+
+std::vector<int64_t>
+FindFirstOrderBy(const segcore::SegmentInternalInterface& segment,
+                 const OrderByInfo& order_by,
+                 int64_t limit,
+                 const BitsetType& bitset,
+                 bool false_filtered_out) {
+    // the rows kept are the set bits if false_filtered_out
+    BitsetType flipped;
+    if (!false_filtered_out) {
+        flipped = ~bitset;
+    }
+    auto& kept = false_filtered_out ? bitset : flipped;
+    auto num_kept = static_cast<int64_t>(kept.count());
+    if (limit == segcore::Unlimited || limit == segcore::NoLimit ||
+        limit > num_kept) {
+        limit = num_kept;
+    }
+    if (limit <= 0) {
+        return {};
+    }
+
+    switch (order_by.data_type_) {
+        case DataType::INT8:
+            return FindFirst<int8_t>(segment, order_by, limit, kept, num_kept);
+        case DataType::INT16:
+            return FindFirst<int16_t>(
+                segment, order_by, limit, kept, num_kept);
+        case DataType::INT32:
+            return FindFirst<int32_t>(
+                segment, order_by, limit, kept, num_kept);
+        case DataType::INT64:
+            return FindFirst<int64_t>(
+                segment, order_by, limit, kept, num_kept);
+        case DataType::FLOAT:
+            return FindFirst<float>(segment, order_by, limit, kept, num_kept);
+        case DataType::DOUBLE:
+            return FindFirst<double>(segment, order_by, limit, kept, num_kept);
+        case DataType::VARCHAR:
+            return FindFirst<std::string>(
+                segment, order_by, limit, kept, num_kept);
+        default:
+            PanicInfo(DataTypeInvalid,
+                      "unsupported data type {} of the order by field",
+                      order_by.data_type_);
+    }
+}
+
+}  // namespace milvus::query
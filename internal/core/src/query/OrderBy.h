@@ -0,0 +1,37 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+
+#include <vector>
+
+#include "common/Types.h"
+#include "query/PlanNode.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+// The offsets of the first limit rows kept in the bitset in the order of the
+// field, all of them if there's no limit, the rows kept are the set bits if
+// false_filtered_out. The rows of the same value come in no particular order.
+//
+// The candidates are kept in a heap of limit rows, unless the field has a
+// sorted index and so many rows are kept that walking the index in its order
+// meets the limit rows sooner than the rows are scanned.
+std::vector<int64_t>
+FindFirstOrderBy(const segcore::SegmentInternalInterface& segment,
+                 const OrderByInfo& order_by,
+                 int64_t limit,
+                 const BitsetType& bitset,
+                 bool false_filtered_out);
+
+}  // namespace milvus::query
@@ -17,6 +17,8 @@
 #include "Plan.h"
 #include "PlanProto.h"
 #include "generated/ShowPlanNodeVisitor.h"
+#include "common/Utils.h"
+#include "common/protobuf_utils.h"
 
 namespace milvus::query {
 
@@ -36,10 +38,12 @@ ParsePlaceholderGroup(const Plan* plan,
                       const int64_t blob_len) {
     namespace set = milvus::proto::common;
     auto result = std::make_unique<PlaceholderGroup>();
-    set::PlaceholderGroup ph_group;
-    auto ok = ph_group.ParseFromArray(blob, blob_len);
+    google::protobuf::Arena arena(ParseArenaOptions(blob_len));
+    auto ph_group =
+        google::protobuf::Arena::CreateMessage<set::PlaceholderGroup>(&arena);
+    auto ok = ph_group->ParseFromArray(blob, blob_len);
     Assert(ok);
-    for (auto& info : ph_group.placeholders()) {
+    for (auto& info : ph_group->placeholders()) {
         Placeholder element;
         element.tag_ = info.tag();
         Assert(plan->tag2field_.count(element.tag_));
@@ -67,18 +71,25 @@ CreateSearchPlanByExpr(const Schema& schema,
                        const void* serialized_expr_plan,
                        const int64_t size) {
     // Note: serialized_expr_plan is of binary format
-    proto::plan::PlanNode plan_node;
-    plan_node.ParseFromArray(serialized_expr_plan, size);
-    return ProtoParser(schema).CreatePlan(plan_node);
+    google::protobuf::Arena arena(ParseArenaOptions(size));
+    auto plan_node =
+        google::protobuf::Arena::CreateMessage<proto::plan::PlanNode>(&arena);
+    plan_node->ParseFromArray(serialized_expr_plan, size);
+    auto plan = ProtoParser(schema).CreatePlan(*plan_node);
+    plan->serialized_.assign(static_cast<const char*>(serialized_expr_plan),
+                             size);
+    return plan;
 }
 
 std::unique_ptr<RetrievePlan>
 CreateRetrievePlanByExpr(const Schema& schema,
                          const void* serialized_expr_plan,
                          const int64_t size) {
-    proto::plan::PlanNode plan_node;
-    plan_node.ParseFromArray(serialized_expr_plan, size);
-    return ProtoParser(schema).CreateRetrievePlan(plan_node);
+    google::protobuf::Arena arena(ParseArenaOptions(size));
+    auto plan_node =
+        google::protobuf::Arena::CreateMessage<proto::plan::PlanNode>(&arena);
+    plan_node->ParseFromArray(serialized_expr_plan, size);
+    return ProtoParser(schema).CreateRetrievePlan(*plan_node);
 }
 
 int64_t
@@ -91,6 +102,12 @@ GetFieldID(const Plan* plan) {
     return plan->plan_node_->search_info_.field_id_.get();
 }
 
+bool
+IsPositivelyRelated(const Plan* plan) {
+    return !plan->plan_node_->sub_searches_.empty() ||
+           PositivelyRelated(plan->plan_node_->search_info_.metric_type_);
+}
+
 int64_t
 GetNumOfQueries(const PlaceholderGroup* group) {
     return group->at(0).num_of_queries_;
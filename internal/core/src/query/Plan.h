@@ -58,4 +58,9 @@ GetTopK(const Plan*);
 int64_t
 GetFieldID(const Plan* plan);
 
+// whether the larger distances of the search results of the plan are the
+// better ones, the fused scores of a hybrid search always are
+bool
+IsPositivelyRelated(const Plan* plan);
+
 }  // namespace milvus::query
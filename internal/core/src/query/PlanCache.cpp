@@ -0,0 +1,125 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "query/PlanCache.h"
+
+#include <string_view>
+
+#include "query/Plan.h"
+
+namespace milvus::query {
+
+template <typename T>
+std::unique_ptr<VectorPlanNode>
+CopyVectorPlanNodeAs(const VectorPlanNode& node) {
+    auto copy = std::make_unique<T>();
+    copy->filter_plannode_ = node.filter_plannode_;
+    copy->search_info_ = node.search_info_;
+    copy->placeholder_tag_ = node.placeholder_tag_;
+    return copy;
+}
+
+// the parsed plans never hold the legacy predicate_, only filter_plannode_
+std::unique_ptr<VectorPlanNode>
+CopyVectorPlanNode(const VectorPlanNode& node) {
+    if (dynamic_cast<const BinaryVectorANNS*>(&node)) {
+        return CopyVectorPlanNodeAs<BinaryVectorANNS>(node);
+    }
+    if (dynamic_cast<const Float16VectorANNS*>(&node)) {
+        return CopyVectorPlanNodeAs<Float16VectorANNS>(node);
+    }
+    return CopyVectorPlanNodeAs<FloatVectorANNS>(node);
+}
+
+std::unique_ptr<Plan>
+CopyPlan(const Plan& plan) {
+    auto copy = std::make_unique<Plan>(plan.schema_);
+    copy->plan_node_ = CopyVectorPlanNode(*plan.plan_node_);
+    copy->tag2field_ = plan.tag2field_;
+    copy->target_entries_ = plan.target_entries_;
+    copy->extra_info_opt_ = plan.extra_info_opt_;
+    copy->serialized_ = plan.serialized_;
+    return copy;
+}
+
+std::unique_ptr<RetrievePlan>
+CopyRetrievePlan(const RetrievePlan& plan) {
+    auto copy = std::make_unique<RetrievePlan>(plan.schema_);
+    copy->plan_node_ = std::make_unique<RetrievePlanNode>();
+    copy->plan_node_->filter_plannode_ = plan.plan_node_->filter_plannode_;
+    copy->plan_node_->is_count_ = plan.plan_node_->is_count_;
+    copy->plan_node_->limit_ = plan.plan_node_->limit_;
+    copy->plan_node_->aggregates_ = plan.plan_node_->aggregates_;
+    copy->plan_node_->order_by_ = plan.plan_node_->order_by_;
+    copy->field_ids_ = plan.field_ids_;
+    return copy;
+}
+
+template <typename T, typename Parse>
+std::shared_ptr<const T>
+PlanCache::Get(Entries<T>& entries,
+               const void* serialized_expr_plan,
+               int64_t size,
+               Parse parse) {
+    std::string_view key(static_cast<const char*>(serialized_expr_plan), size);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries.index.find(key);
+        if (iter != entries.index.end()) {
+            entries.plans.splice(
+                entries.plans.begin(), entries.plans, iter->second);
+            hit_count_++;
+            return iter->second->second;
+        }
+    }
+
+    // parse without the lock, the plans failed to parse are not cached
+    std::shared_ptr<const T> plan = parse(schema_, serialized_expr_plan, size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries.index.count(key) == 0) {
+        entries.plans.emplace_front(std::string(key), plan);
+        entries.index.emplace(entries.plans.front().first,
+                              entries.plans.begin());
+        if (static_cast<int64_t>(entries.plans.size()) > capacity_) {
+            entries.index.erase(entries.plans.back().first);
+            entries.plans.pop_back();
+        }
+    }
+    return plan;
+}
+
+std::unique_ptr<Plan>
+PlanCache::CreateSearchPlan(const void* serialized_expr_plan, int64_t size) {
+    if (capacity_ <= 0) {
+        return CreateSearchPlanByExpr(schema_, serialized_expr_plan, size);
+    }
+    auto plan = Get(
+        search_plans_, serialized_expr_plan, size, CreateSearchPlanByExpr);
+    return CopyPlan(*plan);
+}
+
+std::unique_ptr<RetrievePlan>
+PlanCache::CreateRetrievePlan(const void* serialized_expr_plan,
+                              int64_t size) {
+    if (capacity_ <= 0) {
+        return CreateRetrievePlanByExpr(schema_, serialized_expr_plan, size);
+    }
+    auto plan = Get(
+        retrieve_plans_, serialized_expr_plan, size, CreateRetrievePlanByExpr);
+    return CopyRetrievePlan(*plan);
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,90 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "common/Schema.h"
+#include "query/PlanImpl.h"
+
+namespace milvus::query {
+
+// PlanCache keeps the plans parsed from the latest serialized plans of a
+// schema. A plan serialized the same as a cached one is copied from it
+// instead of parsed again, the copies share the filter expressions, which
+// are never modified.
+//
+// The capacity is the number of search plans and of retrieve plans kept, 0
+// disables the caching.
+class PlanCache {
+ public:
+    PlanCache(const Schema& schema, int64_t capacity)
+        : schema_(schema), capacity_(capacity) {
+    }
+
+    std::unique_ptr<Plan>
+    CreateSearchPlan(const void* serialized_expr_plan, int64_t size);
+
+    std::unique_ptr<RetrievePlan>
+    CreateRetrievePlan(const void* serialized_expr_plan, int64_t size);
+
+    int64_t
+    hit_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hit_count_;
+    }
+
+ private:
+    // the least recently used plans are the last ones
+    template <typename T>
+    struct Entries {
+        std::list<std::pair<std::string, std::shared_ptr<const T>>> plans;
+        std::unordered_map<std::string_view, typename decltype(plans)::iterator>
+            index;
+    };
+
+    template <typename T, typename Parse>
+    std::shared_ptr<const T>
+    Get(Entries<T>& entries,
+        const void* serialized_expr_plan,
+        int64_t size,
+        Parse parse);
+
+ private:
+    const Schema& schema_;
+    const int64_t capacity_;
+
+    mutable std::mutex mutex_;
+    Entries<Plan> search_plans_;
+    Entries<RetrievePlan> retrieve_plans_;
+    int64_t hit_count_ = 0;
+};
+
+using PlanCachePtr = std::unique_ptr<PlanCache>;
+
+// a copy of the plan sharing its filter expressions
+std::unique_ptr<Plan>
+CopyPlan(const Plan& plan);
+
+}  // namespace milvus::query
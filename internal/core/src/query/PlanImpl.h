@@ -19,6 +19,7 @@
 
 #include "Plan.h"
 #include "PlanNode.h"
+#include "common/CancellationToken.h"
 #include "common/EasyAssert.h"
 #include "common/Json.h"
 #include "common/Consts.h"
@@ -59,6 +60,9 @@ struct Plan {
  public:
     std::optional<ExtractedPlanInfo> extra_info_opt_;
     // TODO: add move extra info
+    // the serialized plan it's parsed from, the searches of the plans
+    // serialized the same may be coalesced
+    std::string serialized_;
 };
 
 struct Placeholder {
@@ -89,6 +93,9 @@ struct RetrievePlan {
     const Schema& schema_;
     std::unique_ptr<RetrievePlanNode> plan_node_;
     std::vector<FieldId> field_ids_;
+    // the cancellation of the retrieve, none if it's never canceled. The
+    // searches keep theirs in the SearchInfo
+    CancellationTokenPtr cancellation_token_;
 };
 
 using PlanPtr = std::unique_ptr<Plan>;
@@ -36,11 +36,33 @@ struct PlanNode {
 
 using PlanNodePtr = std::unique_ptr<PlanNode>;
 
+// a search on another vector field in a hybrid search
+struct SubVectorSearch {
+    SearchInfo search_info_;
+    std::string placeholder_tag_;
+};
+
+enum class FusionType {
+    RRF,
+    WeightedSum,
+};
+
+struct FusionInfo {
+    FusionType fusion_type_ = FusionType::RRF;
+    // the weights of the search of the node and the sub searches in order
+    std::vector<float> weights_;
+    int64_t rrf_k_ = 0;
+};
+
 struct VectorPlanNode : PlanNode {
     std::optional<ExprPtr> predicate_;
     std::optional<std::shared_ptr<milvus::plan::PlanNode>> filter_plannode_;
     SearchInfo search_info_;
     std::string placeholder_tag_;
+    // if any, the results of the sub searches are fused with the result of
+    // the node on every segment, the larger fused scores are the better
+    std::vector<SubVectorSearch> sub_searches_;
+    FusionInfo fusion_info_;
 };
 
 struct FloatVectorANNS : VectorPlanNode {
@@ -61,6 +83,25 @@ struct Float16VectorANNS : VectorPlanNode {
     accept(PlanNodeVisitor&) override;
 };
 
+enum class AggregateOp {
+    Min,
+    Max,
+    Sum,
+    Avg,
+};
+
+struct AggregateInfo {
+    AggregateOp op_;
+    FieldId field_id_;
+    DataType data_type_;
+};
+
+struct OrderByInfo {
+    FieldId field_id_;
+    DataType data_type_;
+    bool descending_ = false;
+};
+
 struct RetrievePlanNode : PlanNode {
  public:
     void
@@ -68,8 +109,13 @@ struct RetrievePlanNode : PlanNode {
 
     std::optional<ExprPtr> predicate_;
     std::optional<std::shared_ptr<milvus::plan::PlanNode>> filter_plannode_;
-    bool is_count_;
-    int64_t limit_;
+    bool is_count_ = false;
+    int64_t limit_ = 0;
+    // if any, the partial states of them are retrieved instead of the rows
+    std::vector<AggregateInfo> aggregates_;
+    // if any, the first limit rows are of the order of the field instead of
+    // the pk order
+    std::optional<OrderByInfo> order_by_;
 };
 
 }  // namespace milvus::query
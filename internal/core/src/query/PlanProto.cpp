@@ -177,13 +177,6 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
     // TODO: add more buffs
     Assert(plan_node_proto.has_vector_anns());
     auto& anns_proto = plan_node_proto.vector_anns();
-    auto expr_opt = [&]() -> std::optional<ExprPtr> {
-        if (!anns_proto.has_predicates()) {
-            return std::nullopt;
-        } else {
-            return ParseExpr(anns_proto.predicates());
-        }
-    }();
 
     auto expr_parser = [&]() -> plan::PlanNodePtr {
         auto expr = ParseExprs(anns_proto.predicates());
@@ -202,6 +195,48 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
     search_info.round_decimal_ = query_info_proto.round_decimal();
     search_info.search_params_ =
         nlohmann::json::parse(query_info_proto.search_params());
+    // the param is of segcore, the index never sees it
+    if (auto it = search_info.search_params_.find(SEARCH_PROFILE);
+        it != search_info.search_params_.end()) {
+        search_info.profile_ = it->is_boolean() && it->get<bool>();
+        search_info.search_params_.erase(it);
+    }
+    if (auto it = search_info.search_params_.find(ADAPTIVE_SEARCH);
+        it != search_info.search_params_.end()) {
+        AssertInfo(it->is_object(),
+                   "{} should be an object of the lower bounds of the effort "
+                   "params, but got {}",
+                   ADAPTIVE_SEARCH,
+                   it->dump());
+        for (auto& [key, bound] : it->items()) {
+            AssertInfo(bound.is_number_integer() && bound.get<int64_t>() > 0,
+                       "the bound of {} of {} should be a positive integer, "
+                       "but got {}",
+                       key,
+                       ADAPTIVE_SEARCH,
+                       bound.dump());
+            search_info.adaptive_bounds_.emplace(key, bound.get<int64_t>());
+        }
+        search_info.search_params_.erase(it);
+    }
+    if (query_info_proto.group_by_field_id() > 0) {
+        auto group_by_field_id = FieldId(query_info_proto.group_by_field_id());
+        auto data_type = schema[group_by_field_id].get_data_type();
+        switch (data_type) {
+            case DataType::BOOL:
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+            case DataType::VARCHAR:
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported data type {} of the group by field",
+                          data_type);
+        }
+        search_info.group_by_field_id_ = group_by_field_id;
+    }
 
     auto plan_node = [&]() -> std::unique_ptr<VectorPlanNode> {
         if (anns_proto.vector_type() ==
@@ -215,11 +250,48 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
         }
     }();
     plan_node->placeholder_tag_ = anns_proto.placeholder_tag();
-    plan_node->predicate_ = std::move(expr_opt);
     if (anns_proto.has_predicates()) {
         plan_node->filter_plannode_ = std::move(expr_parser());
     }
     plan_node->search_info_ = std::move(search_info);
+
+    for (auto& sub_anns_proto : anns_proto.sub_anns()) {
+        auto& sub_query_info = sub_anns_proto.query_info();
+        AssertInfo(sub_query_info.group_by_field_id() <= 0 &&
+                       !plan_node->search_info_.group_by_field_id_,
+                   "hybrid search can't be grouped");
+        SubVectorSearch sub_search;
+        auto& sub_info = sub_search.search_info_;
+        sub_info.field_id_ = FieldId(sub_anns_proto.field_id());
+        AssertInfo(schema[sub_info.field_id_].is_vector(),
+                   "the sub search of field {} is not on a vector field",
+                   sub_info.field_id_.get());
+        sub_info.metric_type_ = sub_query_info.metric_type();
+        sub_info.topk_ = sub_query_info.topk();
+        sub_info.round_decimal_ = sub_query_info.round_decimal();
+        sub_info.search_params_ =
+            nlohmann::json::parse(sub_query_info.search_params());
+        sub_search.placeholder_tag_ = sub_anns_proto.placeholder_tag();
+        plan_node->sub_searches_.push_back(std::move(sub_search));
+    }
+    if (!plan_node->sub_searches_.empty()) {
+        auto& fusion_proto = anns_proto.fusion_info();
+        auto& fusion_info = plan_node->fusion_info_;
+        auto num_searches = plan_node->sub_searches_.size() + 1;
+        if (fusion_proto.fusion_type() == planpb::FusionType::WeightedSum) {
+            fusion_info.fusion_type_ = FusionType::WeightedSum;
+            fusion_info.weights_.assign(fusion_proto.weights().begin(),
+                                        fusion_proto.weights().end());
+            AssertInfo(fusion_info.weights_.size() == num_searches,
+                       "{} weights of {} searches",
+                       fusion_info.weights_.size(),
+                       num_searches);
+        } else {
+            fusion_info.fusion_type_ = FusionType::RRF;
+            fusion_info.rrf_k_ = fusion_proto.rrf_k() > 0 ? fusion_proto.rrf_k()
+                                                          : DEFAULT_RRF_K;
+        }
+    }
     return plan_node;
 }
 
@@ -233,33 +305,71 @@ ProtoParser::RetrievePlanNodeFromProto(
         if (plan_node_proto.has_predicates()) {  // version before 2023.03.30.
             node->is_count_ = false;
             auto& predicate_proto = plan_node_proto.predicates();
-            auto expr_opt = [&]() -> ExprPtr {
-                return ParseExpr(predicate_proto);
-            }();
             auto expr_parser = [&]() -> plan::PlanNodePtr {
                 auto expr = ParseExprs(predicate_proto);
                 return std::make_shared<plan::FilterBitsNode>(
                     DEFAULT_PLANNODE_ID, expr);
             }();
-            node->predicate_ = std::move(expr_opt);
             node->filter_plannode_ = std::move(expr_parser);
         } else {
             auto& query = plan_node_proto.query();
             if (query.has_predicates()) {
                 auto& predicate_proto = query.predicates();
-                auto expr_opt = [&]() -> ExprPtr {
-                    return ParseExpr(predicate_proto);
-                }();
                 auto expr_parser = [&]() -> plan::PlanNodePtr {
                     auto expr = ParseExprs(predicate_proto);
                     return std::make_shared<plan::FilterBitsNode>(
                         DEFAULT_PLANNODE_ID, expr);
                 }();
-                node->predicate_ = std::move(expr_opt);
                 node->filter_plannode_ = std::move(expr_parser);
             }
             node->is_count_ = query.is_count();
             node->limit_ = query.limit();
+            for (auto& aggregate_proto : query.aggregates()) {
+                auto field_id = FieldId(aggregate_proto.field_id());
+                auto data_type = schema[field_id].get_data_type();
+                switch (data_type) {
+                    case DataType::INT8:
+                    case DataType::INT16:
+                    case DataType::INT32:
+                    case DataType::INT64:
+                    case DataType::FLOAT:
+                    case DataType::DOUBLE:
+                        break;
+                    default:
+                        PanicInfo(DataTypeInvalid,
+                                  "unsupported data type {} of the "
+                                  "aggregated field",
+                                  data_type);
+                }
+                node->aggregates_.push_back(
+                    {static_cast<AggregateOp>(aggregate_proto.op()),
+                     field_id,
+                     data_type});
+            }
+            AssertInfo(!node->is_count_ || node->aggregates_.empty(),
+                       "count can't be retrieved with aggregates");
+            if (query.has_order_by()) {
+                auto& order_by_proto = query.order_by();
+                auto field_id = FieldId(order_by_proto.field_id());
+                auto data_type = schema[field_id].get_data_type();
+                switch (data_type) {
+                    case DataType::INT8:
+                    case DataType::INT16:
+                    case DataType::INT32:
+                    case DataType::INT64:
+                    case DataType::FLOAT:
+                    case DataType::DOUBLE:
+                    case DataType::VARCHAR:
+                        break;
+                    default:
+                        PanicInfo(DataTypeInvalid,
+                                  "unsupported data type {} of the order by "
+                                  "field",
+                                  data_type);
+                }
+                node->order_by_ = OrderByInfo{
+                    field_id, data_type, order_by_proto.descending()};
+            }
         }
         return node;
     }();
@@ -277,6 +387,14 @@ ProtoParser::CreatePlan(const proto::plan::PlanNode& plan_node_proto) {
     plan_node->accept(extractor);
 
     plan->tag2field_["$0"] = plan_node->search_info_.field_id_;
+    for (auto& sub_search : plan_node->sub_searches_) {
+        AssertInfo(plan->tag2field_
+                       .emplace(sub_search.placeholder_tag_,
+                                sub_search.search_info_.field_id_)
+                       .second,
+                   "duplicated placeholder tag {}",
+                   sub_search.placeholder_tag_);
+    }
     plan->plan_node_ = std::move(plan_node);
     plan->extra_info_opt_ = std::move(plan_info);
 
@@ -9,7 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/Consts.h"
@@ -17,12 +20,299 @@
 #include "common/RangeSearchHelper.h"
 #include "common/Utils.h"
 #include "common/Tracer.h"
+#include "simd/hook.h"
 #include "SearchBruteForce.h"
 #include "SubSearchResult.h"
 #include "knowhere/comp/brute_force.h"
 #include "knowhere/comp/index_param.h"
 namespace milvus::query {
 
+namespace {
+
+// the rows of the chunk searched by all queries at a time, so that the
+// queries but the first read them from the cache
+constexpr int64_t BLOCK_ROWS = 256;
+
+// the rows of the chunk range searched at a time, a multiple of 8 so that
+// the blocks start at a byte of the bitset
+constexpr int64_t RANGE_SEARCH_BLOCK_ROWS = 8192;
+
+void
+SearchWithBuf(const knowhere::DataSetPtr& base_dataset,
+              const knowhere::DataSetPtr& query_dataset,
+              const knowhere::Json& config,
+              const BitsetView& bitset,
+              SubSearchResult& result) {
+    auto stat = knowhere::BruteForce::SearchWithBuf(
+        base_dataset,
+        query_dataset,
+        result.mutable_seg_offsets().data(),
+        result.mutable_distances().data(),
+        config,
+        bitset);
+    milvus::tracer::AddEvent("knowhere_finish_BruteForce_SearchWithBuf");
+    if (stat != knowhere::Status::success) {
+        throw SegcoreError(KnowhereError,
+                           "invalid metric type, " + KnowhereStatusString(stat));
+    }
+}
+
+// the top-K of every query over the rows of the chunk by distance_of(q, i)
+// into result, a block of BLOCK_ROWS rows at a time searched by all queries
+// so that the queries but the first read them from the cache, prepare(begin,
+// end) is called before the rows of [begin, end) are searched
+template <typename DistanceOf, typename Prepare>
+void
+SearchByHeaps(const dataset::SearchDataset& dataset,
+              int64_t chunk_rows,
+              const BitsetView& bitset,
+              DistanceOf distance_of,
+              Prepare prepare,
+              SubSearchResult& result) {
+    auto nq = dataset.num_queries;
+    auto topk = dataset.topk;
+
+    // the top-K of every query as a heap whose top is the worst one, ties
+    // resolve to the smaller offsets like knowhere
+    auto positive = PositivelyRelated(dataset.metric_type);
+    auto better = [positive](const std::pair<float, int64_t>& lhs,
+                             const std::pair<float, int64_t>& rhs) {
+        if (lhs.first != rhs.first) {
+            return positive ? lhs.first > rhs.first : lhs.first < rhs.first;
+        }
+        return lhs.second < rhs.second;
+    };
+    std::vector<std::vector<std::pair<float, int64_t>>> heaps(nq);
+    for (auto& heap : heaps) {
+        heap.reserve(topk);
+    }
+
+    for (int64_t begin = 0; begin < chunk_rows; begin += BLOCK_ROWS) {
+        auto end = std::min(chunk_rows, begin + BLOCK_ROWS);
+        prepare(begin, end);
+        for (int64_t q = 0; q < nq; ++q) {
+            auto& heap = heaps[q];
+            for (auto i = begin; i < end; ++i) {
+                if (!bitset.empty() && bitset.test(i)) {
+                    continue;
+                }
+                std::pair<float, int64_t> res(distance_of(q, i), i);
+                if (static_cast<int64_t>(heap.size()) < topk) {
+                    heap.push_back(res);
+                    std::push_heap(heap.begin(), heap.end(), better);
+                } else if (better(res, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), better);
+                    heap.back() = res;
+                    std::push_heap(heap.begin(), heap.end(), better);
+                }
+            }
+        }
+    }
+
+    for (int64_t q = 0; q < nq; ++q) {
+        auto& heap = heaps[q];
+        std::sort_heap(heap.begin(), heap.end(), better);
+        for (size_t i = 0; i < heap.size(); ++i) {
+            result.get_distances()[q * topk + i] = heap[i].first;
+            result.get_seg_offsets()[q * topk + i] = heap[i].second;
+        }
+    }
+}
+
+// search the float16 chunk by the float16 distance kernels, which convert the
+// elements in registers instead of copying the chunk as float32
+void
+SearchFloat16(const dataset::SearchDataset& dataset,
+              const float16* chunk_data,
+              int64_t chunk_rows,
+              const BitsetView& bitset,
+              SubSearchResult& result) {
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto& metric_type = dataset.metric_type;
+    auto is_l2 = IsMetricType(metric_type, knowhere::metric::L2);
+    auto is_cosine = IsMetricType(metric_type, knowhere::metric::COSINE);
+    if (!is_l2 && !is_cosine &&
+        !IsMetricType(metric_type, knowhere::metric::IP)) {
+        PanicInfo(MetricTypeInvalid,
+                  "invalid metric type {} for float16 vectors",
+                  metric_type);
+    }
+    auto xq = reinterpret_cast<const uint16_t*>(dataset.query_data);
+    auto xb = reinterpret_cast<const uint16_t*>(chunk_data);
+    auto norm_of = [dim](const uint16_t* vec) {
+        return std::sqrt(simd::inner_product_float16(vec, vec, dim));
+    };
+
+    std::vector<float> query_norms(nq);
+    if (is_cosine) {
+        for (int64_t q = 0; q < nq; ++q) {
+            query_norms[q] = norm_of(xq + q * dim);
+        }
+    }
+    int64_t block_begin = 0;
+    std::vector<float> base_norms(BLOCK_ROWS);
+
+    SearchByHeaps(
+        dataset,
+        chunk_rows,
+        bitset,
+        [&](int64_t q, int64_t i) {
+            auto query = xq + q * dim;
+            auto base = xb + i * dim;
+            if (is_l2) {
+                return simd::l2_sqr_float16(query, base, dim);
+            }
+            auto ip = simd::inner_product_float16(query, base, dim);
+            if (is_cosine) {
+                auto norm = query_norms[q] * base_norms[i - block_begin];
+                return norm > 0 ? ip / norm : 0;
+            }
+            return ip;
+        },
+        [&](int64_t begin, int64_t end) {
+            block_begin = begin;
+            if (is_cosine) {
+                for (auto i = begin; i < end; ++i) {
+                    base_norms[i - begin] = norm_of(xb + i * dim);
+                }
+            }
+        },
+        result);
+}
+
+// search the float chunk by the cosine as the inner product scaled by the
+// inverse norms of the rows precomputed when the chunk is sealed, so the
+// norms of the rows aren't computed by every search
+void
+SearchCosineByInvNorms(const dataset::SearchDataset& dataset,
+                       const float* chunk_data,
+                       int64_t chunk_rows,
+                       const float* inv_norms,
+                       const BitsetView& bitset,
+                       SubSearchResult& result) {
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto xq = static_cast<const float*>(dataset.query_data);
+    std::vector<float> query_inv_norms(nq);
+    simd::inv_norms_float(xq, nq, dim, query_inv_norms.data());
+    auto inner_product = simd::inner_product_float_of(dim);
+
+    SearchByHeaps(
+        dataset,
+        chunk_rows,
+        bitset,
+        [&](int64_t q, int64_t i) {
+            auto ip = inner_product(xq + q * dim, chunk_data + i * dim, dim);
+            return ip * query_inv_norms[q] * inv_norms[i];
+        },
+        [](int64_t, int64_t) {},
+        result);
+}
+
+// search the binary chunk by the popcount kernels of the hamming and the
+// jaccard distances, specialized for the dim of the hashes if it's common
+void
+SearchBinary(const dataset::SearchDataset& dataset,
+             const uint8_t* chunk_data,
+             int64_t chunk_rows,
+             const BitsetView& bitset,
+             SubSearchResult& result) {
+    auto dim = dataset.dim;
+    auto bytes = dim / 8;
+    auto distance = IsMetricType(dataset.metric_type, knowhere::metric::HAMMING)
+                        ? simd::hamming_binary_of(dim)
+                        : simd::jaccard_binary_of(dim);
+    auto xq = static_cast<const uint8_t*>(dataset.query_data);
+
+    SearchByHeaps(
+        dataset,
+        chunk_rows,
+        bitset,
+        [&](int64_t q, int64_t i) {
+            return distance(xq + q * bytes, chunk_data + i * bytes, bytes);
+        },
+        [](int64_t, int64_t) {},
+        result);
+}
+
+// range search the chunk a block of rows at a time, the hits of a block are
+// cut to the top-K of every query and merged into result, so the hits held
+// at a time are bounded by the block however wide the radius is
+void
+RangeSearchByBlocks(const dataset::SearchDataset& dataset,
+                    const void* chunk_data_raw,
+                    int64_t chunk_rows,
+                    const knowhere::Json& config,
+                    const BitsetView& bitset,
+                    DataType data_type,
+                    SubSearchResult& result) {
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto topk = dataset.topk;
+    auto is_float16 = data_type == DataType::VECTOR_FLOAT16;
+    int64_t row_size = data_type == DataType::VECTOR_BINARY ? dim / 8
+                       : is_float16 ? dim * int64_t(sizeof(float16))
+                                    : dim * int64_t(sizeof(float));
+
+    // knowhere range searches the float16 vectors as float32, converted a
+    // block at a time
+    auto to_float = [dim](const void* data, int64_t rows, auto& out) {
+        auto fp16 = static_cast<const float16*>(data);
+        out.resize(rows * dim);
+        for (int64_t i = 0; i < rows * dim; ++i) {
+            out[i] = float(fp16[i]);
+        }
+        return static_cast<const void*>(out.data());
+    };
+    std::vector<float> float_xq;
+    std::vector<float> float_xb;
+    auto xq = is_float16 ? to_float(dataset.query_data, nq, float_xq)
+                         : dataset.query_data;
+    auto query_dataset = knowhere::GenDataSet(nq, dim, xq);
+
+    // the ties within a block are ordered by id, descending for the metrics
+    // where larger is closer, and the merge keeps the ties already merged,
+    // so the blocks are merged in the same order of ids, for the ties to be
+    // ordered the same whatever the block boundaries are
+    auto num_blocks =
+        (chunk_rows + RANGE_SEARCH_BLOCK_ROWS - 1) / RANGE_SEARCH_BLOCK_ROWS;
+    auto higher_ids_first = PositivelyRelated(dataset.metric_type);
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        auto begin = (higher_ids_first ? num_blocks - 1 - i : i) *
+                     RANGE_SEARCH_BLOCK_ROWS;
+        auto rows = std::min(RANGE_SEARCH_BLOCK_ROWS, chunk_rows - begin);
+        auto xb = static_cast<const char*>(chunk_data_raw) + begin * row_size;
+        auto base_dataset = knowhere::GenDataSet(
+            rows, dim, is_float16 ? to_float(xb, rows, float_xb) : xb);
+        auto res = knowhere::BruteForce::RangeSearch(
+            base_dataset, query_dataset, config, bitset.subview(begin, rows));
+        if (!res.has_value()) {
+            PanicInfo(KnowhereError,
+                      "failed to range search: {}: {}",
+                      KnowhereStatusString(res.error()),
+                      res.what());
+        }
+        auto block =
+            ReGenRangeSearchResult(res.value(), topk, nq, dataset.metric_type);
+
+        SubSearchResult block_result(
+            nq, topk, dataset.metric_type, dataset.round_decimal);
+        auto ids = GetDatasetIDs(block);
+        auto distances = GetDatasetDistance(block);
+        for (int64_t i = 0; i < nq * topk; ++i) {
+            if (ids[i] != INVALID_SEG_OFFSET) {
+                block_result.get_seg_offsets()[i] = ids[i] + begin;
+                block_result.get_distances()[i] = distances[i];
+            }
+        }
+        result.merge(block_result);
+    }
+    milvus::tracer::AddEvent("knowhere_finish_BruteForce_RangeSearch");
+}
+
+}  // namespace
+
 void
 CheckBruteForceSearchParam(const FieldMeta& field,
                            const SearchInfo& search_info) {
@@ -44,7 +334,8 @@ BruteForceSearch(const dataset::SearchDataset& dataset,
                  int64_t chunk_rows,
                  const knowhere::Json& conf,
                  const BitsetView& bitset,
-                 DataType data_type) {
+                 DataType data_type,
+                 const float* inv_norms) {
     SubSearchResult sub_result(dataset.num_queries,
                                dataset.topk,
                                dataset.metric_type,
@@ -53,38 +344,6 @@ BruteForceSearch(const dataset::SearchDataset& dataset,
     auto dim = dataset.dim;
     auto topk = dataset.topk;
 
-    auto base_dataset = knowhere::GenDataSet(chunk_rows, dim, chunk_data_raw);
-    auto query_dataset = knowhere::GenDataSet(nq, dim, dataset.query_data);
-
-    if (data_type == DataType::VECTOR_FLOAT16) {
-        // Todo: Temporarily use cast to float32 to achieve, need to optimize
-        // first, First, transfer the cast to knowhere part
-        // second, knowhere partially supports float16 and removes the forced conversion to float32
-        auto xb = base_dataset->GetTensor();
-        std::vector<float> float_xb(base_dataset->GetRows() *
-                                    base_dataset->GetDim());
-
-        auto xq = query_dataset->GetTensor();
-        std::vector<float> float_xq(query_dataset->GetRows() *
-                                    query_dataset->GetDim());
-
-        auto fp16_xb = static_cast<const float16*>(xb);
-        for (int i = 0; i < base_dataset->GetRows() * base_dataset->GetDim();
-             i++) {
-            float_xb[i] = (float)fp16_xb[i];
-        }
-
-        auto fp16_xq = static_cast<const float16*>(xq);
-        for (int i = 0; i < query_dataset->GetRows() * query_dataset->GetDim();
-             i++) {
-            float_xq[i] = (float)fp16_xq[i];
-        }
-        void* void_ptr_xb = static_cast<void*>(float_xb.data());
-        void* void_ptr_xq = static_cast<void*>(float_xq.data());
-        base_dataset = knowhere::GenDataSet(chunk_rows, dim, void_ptr_xb);
-        query_dataset = knowhere::GenDataSet(nq, dim, void_ptr_xq);
-    }
-
     auto config = knowhere::Json{
         {knowhere::meta::METRIC_TYPE, dataset.metric_type},
         {knowhere::meta::DIM, dim},
@@ -101,37 +360,55 @@ BruteForceSearch(const dataset::SearchDataset& dataset,
             CheckRangeSearchParam(
                 config[RADIUS], config[RANGE_FILTER], dataset.metric_type);
         }
-        auto res = knowhere::BruteForce::RangeSearch(
-            base_dataset, query_dataset, config, bitset);
-        milvus::tracer::AddEvent("knowhere_finish_BruteForce_RangeSearch");
-        if (!res.has_value()) {
-            PanicInfo(KnowhereError,
-                      "failed to range search: {}: {}",
-                      KnowhereStatusString(res.error()),
-                      res.what());
-        }
-        auto result =
-            ReGenRangeSearchResult(res.value(), topk, nq, dataset.metric_type);
-        milvus::tracer::AddEvent("ReGenRangeSearchResult");
-        std::copy_n(
-            GetDatasetIDs(result), nq * topk, sub_result.get_seg_offsets());
-        std::copy_n(
-            GetDatasetDistance(result), nq * topk, sub_result.get_distances());
-    } else {
-        auto stat = knowhere::BruteForce::SearchWithBuf(
-            base_dataset,
-            query_dataset,
-            sub_result.mutable_seg_offsets().data(),
-            sub_result.mutable_distances().data(),
-            config,
-            bitset);
-        milvus::tracer::AddEvent("knowhere_finish_BruteForce_SearchWithBuf");
-        if (stat != knowhere::Status::success) {
-            throw SegcoreError(
-                KnowhereError,
-                "invalid metric type, " + KnowhereStatusString(stat));
-        }
+        RangeSearchByBlocks(dataset,
+                            chunk_data_raw,
+                            chunk_rows,
+                            config,
+                            bitset,
+                            data_type,
+                            sub_result);
+        sub_result.round_values();
+        return sub_result;
+    }
+
+    if (data_type == DataType::VECTOR_FLOAT16) {
+        SearchFloat16(dataset,
+                      static_cast<const float16*>(chunk_data_raw),
+                      chunk_rows,
+                      bitset,
+                      sub_result);
+        sub_result.round_values();
+        return sub_result;
+    }
+
+    // the substructure and the superstructure are left to knowhere
+    if (data_type == DataType::VECTOR_BINARY &&
+        (IsMetricType(dataset.metric_type, knowhere::metric::HAMMING) ||
+         IsMetricType(dataset.metric_type, knowhere::metric::JACCARD))) {
+        SearchBinary(dataset,
+                     static_cast<const uint8_t*>(chunk_data_raw),
+                     chunk_rows,
+                     bitset,
+                     sub_result);
+        sub_result.round_values();
+        return sub_result;
     }
+
+    if (inv_norms != nullptr &&
+        IsMetricType(dataset.metric_type, knowhere::metric::COSINE)) {
+        SearchCosineByInvNorms(dataset,
+                               static_cast<const float*>(chunk_data_raw),
+                               chunk_rows,
+                               inv_norms,
+                               bitset,
+                               sub_result);
+        sub_result.round_values();
+        return sub_result;
+    }
+
+    auto base_dataset = knowhere::GenDataSet(chunk_rows, dim, chunk_data_raw);
+    auto query_dataset = knowhere::GenDataSet(nq, dim, dataset.query_data);
+    SearchWithBuf(base_dataset, query_dataset, config, bitset, sub_result);
     sub_result.round_values();
     return sub_result;
 }
@@ -23,12 +23,15 @@ void
 CheckBruteForceSearchParam(const FieldMeta& field,
                            const SearchInfo& search_info);
 
+// inv_norms are the inverse L2 norms of the rows of a float chunk, which the
+// cosine is computed by, nullptr to compute the norms by the search
 SubSearchResult
 BruteForceSearch(const dataset::SearchDataset& dataset,
                  const void* chunk_data_raw,
                  int64_t chunk_rows,
                  const knowhere::Json& conf,
                  const BitsetView& bitset,
-                 DataType data_type = DataType::VECTOR_FLOAT);
+                 DataType data_type = DataType::VECTOR_FLOAT,
+                 const float* inv_norms = nullptr);
 
 }  // namespace milvus::query
@@ -9,16 +9,107 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <future>
+#include <utility>
+#include <vector>
+
 #include "common/BitsetView.h"
+#include "common/Common.h"
+#include "common/Consts.h"
 #include "common/QueryInfo.h"
 #include "common/Tracer.h"
+#include "common/Utils.h"
 #include "SearchOnGrowing.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
+#include "simd/hook.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::query {
 
+namespace {
+
+// rerank the candidates searched by the quantized interim index with the raw
+// vectors kept in the chunks, the caller must hold the chunk mutex
+void
+RefineWithRawData(const segcore::SegmentGrowingImpl& segment,
+                  const SearchInfo& info,
+                  const float* query_data,
+                  int64_t num_queries,
+                  const SubSearchResult& candidates,
+                  SubSearchResult& results) {
+    auto& field = segment.get_schema()[info.field_id_];
+    auto dim = field.get_dim();
+    auto vec_ptr =
+        segment.get_insert_record().get_field_data<FloatVector>(info.field_id_);
+    auto positive = PositivelyRelated(info.metric_type_);
+    auto is_l2 = IsMetricType(info.metric_type_, knowhere::metric::L2);
+    auto is_cosine = IsMetricType(info.metric_type_, knowhere::metric::COSINE);
+
+    auto candidate_k = candidates.get_topk();
+    auto topk = results.get_topk();
+    // ties resolve to the smaller offsets like the brute force search
+    auto better = [positive](const std::pair<float, int64_t>& lhs,
+                             const std::pair<float, int64_t>& rhs) {
+        if (lhs.first != rhs.first) {
+            return positive ? lhs.first > rhs.first : lhs.first < rhs.first;
+        }
+        return lhs.second < rhs.second;
+    };
+    std::vector<std::pair<float, int64_t>> refined;
+    refined.reserve(candidate_k);
+    // the candidates are the rows of the indexed chunks, which are full, so
+    // the norms of them are computed once
+    auto size_per_chunk = vec_ptr->get_size_per_chunk();
+    auto inner_product = simd::inner_product_float_of(dim);
+    std::vector<float> query_inv_norms(num_queries);
+    if (is_cosine) {
+        simd::inv_norms_float(
+            query_data, num_queries, dim, query_inv_norms.data());
+    }
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query = query_data + q * dim;
+        refined.clear();
+        for (int64_t i = 0; i < candidate_k; ++i) {
+            auto offset = candidates.get_ids()[q * candidate_k + i];
+            if (offset == INVALID_SEG_OFFSET) {
+                continue;
+            }
+            auto vec = vec_ptr->get_element(offset);
+            float distance = 0;
+            if (is_l2) {
+                for (int64_t d = 0; d < dim; ++d) {
+                    auto diff = query[d] - vec[d];
+                    distance += diff * diff;
+                }
+            } else {
+                distance = inner_product(query, vec, dim);
+            }
+            if (is_cosine) {
+                auto inv_norms =
+                    vec_ptr->get_chunk_inv_norms(offset / size_per_chunk);
+                distance *= query_inv_norms[q] * inv_norms[offset %
+                                                           size_per_chunk];
+            }
+            refined.emplace_back(distance, offset);
+        }
+
+        auto k = std::min<int64_t>(topk, refined.size());
+        std::partial_sort(
+            refined.begin(), refined.begin() + k, refined.end(), better);
+        for (int64_t i = 0; i < k; ++i) {
+            results.get_distances()[q * topk + i] = refined[i].first;
+            results.get_seg_offsets()[q * topk + i] = refined[i].second;
+        }
+    }
+    results.round_values();
+}
+
+}  // namespace
+
 void
 FloatSegmentIndexSearch(const segcore::SegmentGrowingImpl& segment,
                         const SearchInfo& info,
@@ -88,7 +179,17 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     dataset::SearchDataset search_dataset{
         metric_type, num_queries, topk, round_decimal, dim, query_data};
 
-    if (segment.get_indexing_record().SyncDataWithIndex(field.get_id())) {
+    // the rows of [0, indexed_rows) are searched by the interim index, and
+    // the rest are brute forced
+    int64_t indexed_rows = 0;
+    auto& indexing_record = segment.get_indexing_record();
+    std::shared_lock<std::shared_mutex> read_chunk_mutex(
+        segment.get_chunk_mutex(), std::defer_lock);
+    if (indexing_record.RawDataHeldByIndex(field.get_id())) {
+        // the chunks are dropped once the data is synced with the index, and
+        // the index is the only copy of the rows, thus the rows not appended
+        // to it yet can't be brute forced
+        indexed_rows = active_count;
         FloatSegmentIndexSearch(segment,
                                 info,
                                 query_data,
@@ -96,49 +197,156 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                                 active_count,
                                 bitset,
                                 final_qr);
-        results.distances_ = std::move(final_qr.mutable_distances());
-        results.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
-        results.unity_topK_ = topk;
-        results.total_nq_ = num_queries;
-    } else {
-        std::shared_lock<std::shared_mutex> read_chunk_mutex(
-            segment.get_chunk_mutex());
-        int32_t current_chunk_id = 0;
+        final_qr.drop_offsets_from(indexed_rows);
+    } else if (indexing_record.SyncDataWithIndex(field.get_id())) {
+        // the quantized index, the chunks keep the raw data to rerank the
+        // candidates and to brute force the rows not appended to the index
+        const auto& field_indexing =
+            indexing_record.get_vec_field_indexing(field.get_id());
+        // the bitset subview requires the brute force begins at a multiple
+        // of 8, the rows of the index past it are brute forced instead
+        indexed_rows =
+            std::min<int64_t>(field_indexing.get_index_cursor(), active_count) /
+            8 * 8;
+        read_chunk_mutex.lock();
+        auto refine_ratio = field_indexing.get_refine_ratio();
+        if (refine_ratio <= 1 || info.search_params_.contains(RADIUS)) {
+            // the range search keeps the distances of the index, which have
+            // been filtered by the radius
+            FloatSegmentIndexSearch(segment,
+                                    info,
+                                    query_data,
+                                    num_queries,
+                                    active_count,
+                                    bitset,
+                                    final_qr);
+            final_qr.drop_offsets_from(indexed_rows);
+        } else {
+            auto candidate_info = info;
+            candidate_info.topk_ =
+                static_cast<int64_t>(std::ceil(topk * refine_ratio));
+            SubSearchResult candidates(num_queries,
+                                       candidate_info.topk_,
+                                       metric_type,
+                                       round_decimal);
+            FloatSegmentIndexSearch(segment,
+                                    candidate_info,
+                                    query_data,
+                                    num_queries,
+                                    active_count,
+                                    bitset,
+                                    candidates);
+            candidates.drop_offsets_from(indexed_rows);
+            RefineWithRawData(segment,
+                              info,
+                              static_cast<const float*>(query_data),
+                              num_queries,
+                              candidates,
+                              final_qr);
+        }
+    }
+
+    if (indexed_rows < active_count) {
+        if (!read_chunk_mutex.owns_lock()) {
+            read_chunk_mutex.lock();
+        }
         // step 3: brute force search where small indexing is unavailable
         auto vec_ptr = record.get_field_data_base(vecfield_id);
         auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
+        auto element_sizeof = field.get_sizeof();
+        auto min_chunk = indexed_rows / vec_size_per_chunk;
         auto max_chunk = upper_div(active_count, vec_size_per_chunk);
+        auto float_cosine =
+            data_type == DataType::VECTOR_FLOAT &&
+            IsMetricType(metric_type, knowhere::metric::COSINE);
+        auto float_vec_ptr =
+            float_cosine ? record.get_field_data<FloatVector>(vecfield_id)
+                         : nullptr;
+
+        // search the chunks of [chunk_begin, chunk_end) into one result
+        auto search_chunks = [&](int64_t chunk_begin, int64_t chunk_end) {
+            SubSearchResult qr(num_queries, topk, metric_type, round_decimal);
+            for (auto chunk_id = chunk_begin; chunk_id < chunk_end;
+                 ++chunk_id) {
+                CheckCancellation(info.cancellation_token_);
+                auto element_begin =
+                    std::max(indexed_rows, chunk_id * vec_size_per_chunk);
+                auto element_end = std::min(
+                    active_count, (chunk_id + 1) * vec_size_per_chunk);
+                auto size_per_chunk = element_end - element_begin;
+                auto chunk_data =
+                    static_cast<const char*>(vec_ptr->get_chunk_data(chunk_id)) +
+                    (element_begin - chunk_id * vec_size_per_chunk) *
+                        element_sizeof;
 
-        for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
-             ++chunk_id) {
-            auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
-
-            auto element_begin = chunk_id * vec_size_per_chunk;
-            auto element_end =
-                std::min(active_count, (chunk_id + 1) * vec_size_per_chunk);
-            auto size_per_chunk = element_end - element_begin;
-
-            auto sub_view = bitset.subview(element_begin, size_per_chunk);
-            auto sub_qr = BruteForceSearch(search_dataset,
-                                           chunk_data,
-                                           size_per_chunk,
-                                           info.search_params_,
-                                           sub_view,
-                                           data_type);
-
-            // convert chunk uid to segment uid
-            for (auto& x : sub_qr.mutable_seg_offsets()) {
-                if (x != -1) {
-                    x += chunk_id * vec_size_per_chunk;
+                // the norms of the rows of a full chunk are computed once,
+                // the rows of the last one are still appended
+                const float* inv_norms = nullptr;
+                if (float_cosine &&
+                    (chunk_id + 1) * vec_size_per_chunk <= active_count) {
+                    inv_norms =
+                        float_vec_ptr->get_chunk_inv_norms(chunk_id) +
+                        (element_begin - chunk_id * vec_size_per_chunk);
+                }
+
+                auto sub_view = bitset.subview(element_begin, size_per_chunk);
+                auto sub_qr = BruteForceSearch(search_dataset,
+                                               chunk_data,
+                                               size_per_chunk,
+                                               info.search_params_,
+                                               sub_view,
+                                               data_type,
+                                               inv_norms);
+
+                // convert chunk uid to segment uid
+                for (auto& x : sub_qr.mutable_seg_offsets()) {
+                    if (x != -1) {
+                        x += element_begin;
+                    }
+                }
+                qr.merge(sub_qr);
+            }
+            return qr;
+        };
+
+        // split the chunks into contiguous ranges searched in parallel, the
+        // partial results are merged in order so that ties keep resolving to
+        // the smaller offsets
+        auto chunk_num = max_chunk - min_chunk;
+        auto task_num = std::min<int64_t>(chunk_num, CPU_NUM);
+        if (task_num <= 1) {
+            final_qr.merge(search_chunks(min_chunk, max_chunk));
+        } else {
+            auto& pool =
+                ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+            std::vector<std::future<SubSearchResult>> futures;
+            futures.reserve(task_num);
+            try {
+                for (int64_t i = 0; i < task_num; ++i) {
+                    futures.emplace_back(pool.Submit(
+                        search_chunks,
+                        min_chunk + chunk_num * i / task_num,
+                        min_chunk + chunk_num * (i + 1) / task_num));
+                }
+                for (auto& future : futures) {
+                    final_qr.merge(future.get());
+                }
+            } catch (...) {
+                // the tasks reference the locals, wait for them before
+                // unwinding
+                for (auto& future : futures) {
+                    if (future.valid()) {
+                        future.wait();
+                    }
                 }
+                throw;
             }
-            final_qr.merge(sub_qr);
         }
-        results.distances_ = std::move(final_qr.mutable_distances());
-        results.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
-        results.unity_topK_ = topk;
-        results.total_nq_ = num_queries;
     }
+    results.distances_ = std::move(final_qr.mutable_distances());
+    results.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
+    results.unity_topK_ = topk;
+    results.total_nq_ = num_queries;
 }
 
 }  // namespace milvus::query
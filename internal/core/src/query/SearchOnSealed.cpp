@@ -73,7 +73,8 @@ SearchOnSealed(const Schema& schema,
                int64_t num_queries,
                int64_t row_count,
                const BitsetView& bitset,
-               SearchResult& result) {
+               SearchResult& result,
+               const float* inv_norms) {
     auto field_id = search_info.field_id_;
     auto& field = schema[field_id];
 
@@ -91,7 +92,8 @@ SearchOnSealed(const Schema& schema,
                                    row_count,
                                    search_info.search_params_,
                                    bitset,
-                                   data_type);
+                                   data_type,
+                                   inv_norms);
 
     result.distances_ = std::move(sub_qr.mutable_distances());
     result.seg_offsets_ = std::move(sub_qr.mutable_seg_offsets());
@@ -27,6 +27,8 @@ SearchOnSealedIndex(const Schema& schema,
                     const BitsetView& view,
                     SearchResult& result);
 
+// inv_norms are the inverse L2 norms of the rows of a float vector column,
+// nullptr if they're not computed
 void
 SearchOnSealed(const Schema& schema,
                const void* vec_data,
@@ -35,6 +37,7 @@ SearchOnSealed(const Schema& schema,
                int64_t num_queries,
                int64_t row_count,
                const BitsetView& bitset,
-               SearchResult& result);
+               SearchResult& result,
+               const float* inv_norms = nullptr);
 
 }  // namespace milvus::query
@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <cmath>
 
 #include "common/EasyAssert.h"
@@ -16,6 +17,66 @@
 
 namespace milvus::query {
 
+namespace {
+
+// a thread keeps at most so many buffers of each type, taking at most so
+// many bytes in all, so the memory retained by the threads stays small
+constexpr size_t BUFFER_POOL_SIZE = 4;
+constexpr size_t BUFFER_POOL_MAX_BYTES = 1 << 20;
+
+template <typename T>
+struct BufferPool {
+    std::vector<std::vector<T>> buffers;
+    // the bytes of the capacities of the buffers
+    size_t bytes = 0;
+};
+
+template <typename T>
+BufferPool<T>&
+ThreadBufferPool() {
+    thread_local BufferPool<T> pool;
+    return pool;
+}
+
+}  // namespace
+
+template <typename T>
+std::vector<T>
+SubSearchResult::AcquireBuffer(int64_t size, T value) {
+    auto& pool = ThreadBufferPool<T>();
+    if (pool.buffers.empty()) {
+        return std::vector<T>(size, value);
+    }
+    auto buffer = std::move(pool.buffers.back());
+    pool.buffers.pop_back();
+    pool.bytes -= buffer.capacity() * sizeof(T);
+    buffer.assign(size, value);
+    return buffer;
+}
+
+template <typename T>
+void
+SubSearchResult::ReleaseBuffer(std::vector<T>&& buffer) {
+    auto& pool = ThreadBufferPool<T>();
+    auto bytes = buffer.capacity() * sizeof(T);
+    if (bytes == 0 || pool.bytes + bytes > BUFFER_POOL_MAX_BYTES ||
+        pool.buffers.size() >= BUFFER_POOL_SIZE) {
+        return;
+    }
+    buffer.clear();
+    pool.bytes += bytes;
+    pool.buffers.push_back(std::move(buffer));
+}
+
+template std::vector<int64_t>
+SubSearchResult::AcquireBuffer<int64_t>(int64_t size, int64_t value);
+template std::vector<float>
+SubSearchResult::AcquireBuffer<float>(int64_t size, float value);
+template void
+SubSearchResult::ReleaseBuffer<int64_t>(std::vector<int64_t>&& buffer);
+template void
+SubSearchResult::ReleaseBuffer<float>(std::vector<float>&& buffer);
+
 template <bool is_desc>
 void
 SubSearchResult::merge_impl(const SubSearchResult& right) {
@@ -27,6 +88,21 @@ SubSearchResult::merge_impl(const SubSearchResult& right) {
     AssertInfo(is_desc == PositivelyRelated(metric_type_),
                "[SubSearchResult]Metric type isn't desc");
 
+    // the left wins the ties, and the invalid results go after the valid
+    // ones of the other side
+    auto left_first = [](int64_t left_id,
+                         float left_v,
+                         int64_t right_id,
+                         float right_v) {
+        if (left_id == INVALID_SEG_OFFSET) {
+            return false;
+        }
+        if (right_id == INVALID_SEG_OFFSET) {
+            return true;
+        }
+        return is_desc ? (left_v >= right_v) : (left_v <= right_v);
+    };
+
     for (int64_t qn = 0; qn < num_queries_; ++qn) {
         auto offset = qn * topk_;
 
@@ -36,40 +112,36 @@ SubSearchResult::merge_impl(const SubSearchResult& right) {
         auto right_ids = right.get_ids() + offset;
         auto right_distances = right.get_distances() + offset;
 
-        std::vector<float> buf_distances(topk_);
-        std::vector<int64_t> buf_ids(topk_);
-
-        auto lit = 0;  // left iter
-        auto rit = 0;  // right iter
-
-        for (auto buf_iter = 0; buf_iter < topk_; ++buf_iter) {
-            auto left_id = left_ids[lit];
-            auto left_v = left_distances[lit];
-            auto right_id = right_ids[rit];
-            auto right_v = right_distances[rit];
-            // optimize out at compiling
-            if (left_id == INVALID_SEG_OFFSET) {
-                buf_distances[buf_iter] = right_distances[rit];
-                buf_ids[buf_iter] = right_ids[rit];
-                ++rit;
-            } else if (right_id == INVALID_SEG_OFFSET) {
-                buf_distances[buf_iter] = left_distances[lit];
-                buf_ids[buf_iter] = left_ids[lit];
+        // count how many of the topk come from each side
+        int64_t lit = 0;  // left iter
+        int64_t rit = 0;  // right iter
+        while (lit + rit < topk_) {
+            if (left_first(left_ids[lit],
+                           left_distances[lit],
+                           right_ids[rit],
+                           right_distances[rit])) {
                 ++lit;
             } else {
-                if (is_desc ? (left_v >= right_v) : (left_v <= right_v)) {
-                    buf_distances[buf_iter] = left_distances[lit];
-                    buf_ids[buf_iter] = left_ids[lit];
-                    ++lit;
-                } else {
-                    buf_distances[buf_iter] = right_distances[rit];
-                    buf_ids[buf_iter] = right_ids[rit];
-                    ++rit;
-                }
+                ++rit;
+            }
+        }
+
+        // merge them from the back into the left, where every write lands
+        // at or after the left result it reads, so no buffer is needed
+        for (auto out = topk_ - 1; rit > 0; --out) {
+            if (lit > 0 && !left_first(left_ids[lit - 1],
+                                       left_distances[lit - 1],
+                                       right_ids[rit - 1],
+                                       right_distances[rit - 1])) {
+                --lit;
+                left_ids[out] = left_ids[lit];
+                left_distances[out] = left_distances[lit];
+            } else {
+                --rit;
+                left_ids[out] = right_ids[rit];
+                left_distances[out] = right_distances[rit];
             }
         }
-        std::copy_n(buf_distances.data(), topk_, left_distances);
-        std::copy_n(buf_ids.data(), topk_, left_ids);
     }
 }
 
@@ -84,6 +156,25 @@ SubSearchResult::merge(const SubSearchResult& sub_result) {
     }
 }
 
+void
+SubSearchResult::drop_offsets_from(int64_t end_offset) {
+    auto invalid_distance = init_value(metric_type_);
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto ids = seg_offsets_.data() + qn * topk_;
+        auto distances = distances_.data() + qn * topk_;
+        int64_t kept = 0;
+        for (int64_t i = 0; i < topk_; ++i) {
+            if (ids[i] != INVALID_SEG_OFFSET && ids[i] < end_offset) {
+                ids[kept] = ids[i];
+                distances[kept] = distances[i];
+                ++kept;
+            }
+        }
+        std::fill(ids + kept, ids + topk_, INVALID_SEG_OFFSET);
+        std::fill(distances + kept, distances + topk_, invalid_distance);
+    }
+}
+
 void
 SubSearchResult::round_values() {
     if (round_decimal_ == -1)
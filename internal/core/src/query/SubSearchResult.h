@@ -30,8 +30,10 @@ class SubSearchResult {
           topk_(topk),
           round_decimal_(round_decimal),
           metric_type_(metric_type),
-          seg_offsets_(num_queries * topk, INVALID_SEG_OFFSET),
-          distances_(num_queries * topk, init_value(metric_type)) {
+          seg_offsets_(AcquireBuffer<int64_t>(num_queries * topk,
+                                              INVALID_SEG_OFFSET)),
+          distances_(AcquireBuffer<float>(num_queries * topk,
+                                          init_value(metric_type))) {
     }
 
     SubSearchResult(SubSearchResult&& other) noexcept
@@ -43,6 +45,11 @@ class SubSearchResult {
           distances_(std::move(other.distances_)) {
     }
 
+    ~SubSearchResult() {
+        ReleaseBuffer(std::move(seg_offsets_));
+        ReleaseBuffer(std::move(distances_));
+    }
+
  public:
     static float
     init_value(const MetricType& metric_type) {
@@ -97,11 +104,27 @@ class SubSearchResult {
     void
     merge(const SubSearchResult& sub_result);
 
+    // drop the results whose offsets are not less than end_offset, the rest
+    // of each query keep their order
+    void
+    drop_offsets_from(int64_t end_offset);
+
  private:
     template <bool is_desc>
     void
     merge_impl(const SubSearchResult& sub_result);
 
+    // the buffers of the destroyed results are kept per thread and reused by
+    // the next ones, as the brute force search makes a result per chunk, the
+    // buffers moved into a SearchResult are not returned
+    template <typename T>
+    static std::vector<T>
+    AcquireBuffer(int64_t size, T value);
+
+    template <typename T>
+    static void
+    ReleaseBuffer(std::vector<T>&& buffer);
+
  private:
     int64_t num_queries_;
     int64_t topk_;
@@ -72,6 +72,8 @@ out_of_range(int64_t t) {
     return gt_ub<T>(t) || lt_lb<T>(t);
 }
 
+// reserve the result for all the chunks in advance, then appending the blocks
+// never reallocates
 inline void
 AppendOneChunk(BitsetType& result, const bool* chunk_ptr, size_t chunk_len) {
     // Append a value once instead of BITSET_BLOCK_BIT_SIZE times.
@@ -57,6 +57,7 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
         auto ret = std::move(search_result_opt_).value();
         search_result_opt_.reset();
         search_result_opt_ = std::nullopt;
+        ret.profile_ = std::move(profile_);
         return ret;
     }
 
@@ -97,13 +98,28 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
         return expr_use_pk_index_;
     }
 
+    // profile the search even if it doesn't ask for it, like the searches
+    // which may be recorded as slow calls
+    void
+    SetForceProfile(bool force_profile) {
+        force_profile_ = force_profile;
+    }
+
+    // the cancellation of the query, checked between its stages and by the
+    // filters evaluated
+    void
+    SetCancellationToken(CancellationTokenPtr token) {
+        cancellation_token_ = std::move(token);
+    }
+
     void
     ExecuteExprNodeInternal(
         const std::shared_ptr<milvus::plan::PlanNode>& plannode,
         const milvus::segcore::SegmentInternalInterface* segment,
         BitsetType& result,
         bool& cache_offset_getted,
-        std::vector<int64_t>& cache_offset);
+        std::vector<int64_t>& cache_offset,
+        const std::vector<int64_t>* offset_input = nullptr);
 
     void
     ExecuteExprNode(const std::shared_ptr<milvus::plan::PlanNode>& plannode,
@@ -115,11 +131,37 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
             plannode, segment, result, get_cache_offset, cache_offsets);
     }
 
+    // evaluate the expr only on the sorted offsets, the i-th bit of the
+    // result is of offsets[i]
+    void
+    ExecuteExprNodeOnOffsets(
+        const std::shared_ptr<milvus::plan::PlanNode>& plannode,
+        const milvus::segcore::SegmentInternalInterface* segment,
+        const std::vector<int64_t>& offsets,
+        BitsetType& result) {
+        bool get_cache_offset = false;
+        std::vector<int64_t> cache_offsets;
+        ExecuteExprNodeInternal(plannode,
+                                segment,
+                                result,
+                                get_cache_offset,
+                                cache_offsets,
+                                &offsets);
+    }
+
  private:
     template <typename VectorType>
     void
     VectorVisitorImpl(VectorPlanNode& node);
 
+    bool
+    IterativeFilterSearch(VectorPlanNode& node,
+                          const segcore::SegmentInternalInterface* segment,
+                          const void* src_data,
+                          int64_t num_queries,
+                          const BitsetType& bitset,
+                          SearchResult& search_result);
+
  private:
     const segcore::SegmentInterface& segment_;
     Timestamp timestamp_;
@@ -129,5 +171,11 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     RetrieveResultOpt retrieve_result_opt_;
     bool expr_use_pk_index_ = false;
     std::vector<int64_t> expr_cached_pk_id_offsets_;
+    // the profile of the search, nullptr if it isn't profiled
+    QueryProfilePtr profile_;
+    bool force_profile_ = false;
+    // the label of the index type of the search, none if not a search
+    std::optional<std::string> search_index_type_;
+    CancellationTokenPtr cancellation_token_;
 };
 }  // namespace milvus::query
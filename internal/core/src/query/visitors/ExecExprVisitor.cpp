@@ -23,6 +23,7 @@
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "arrow/type_fwd.h"
 #include "common/Json.h"
@@ -264,6 +265,11 @@ AppendOneChunk(BitsetType& result, const FixedVector<bool>& chunk_res) {
 BitsetType
 AssembleChunk(const std::vector<FixedVector<bool>>& results) {
     BitsetType assemble_result;
+    size_t total_len = 0;
+    for (auto& result : results) {
+        total_len += result.size();
+    }
+    assemble_result.reserve(total_len);
     for (auto& result : results) {
         AppendOneChunk(assemble_result, result);
     }
@@ -1807,11 +1813,7 @@ ExecExprVisitor::visit(UnaryRangeExpr& expr) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_.type() == SegmentType::Growing) {
-                res = ExecUnaryRangeVisitorDispatcher<std::string>(expr);
-            } else {
-                res = ExecUnaryRangeVisitorDispatcher<std::string_view>(expr);
-            }
+            res = ExecUnaryRangeVisitorDispatcher<std::string_view>(expr);
             break;
         }
         case DataType::JSON: {
@@ -2002,11 +2004,7 @@ ExecExprVisitor::visit(BinaryRangeExpr& expr) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_.type() == SegmentType::Growing) {
-                res = ExecBinaryRangeVisitorDispatcher<std::string>(expr);
-            } else {
-                res = ExecBinaryRangeVisitorDispatcher<std::string_view>(expr);
-            }
+            res = ExecBinaryRangeVisitorDispatcher<std::string_view>(expr);
             break;
         }
         case DataType::JSON: {
@@ -2081,6 +2079,23 @@ struct relational {
     }
 };
 
+// the rows of the chunk, those of a packed column are decoded into the
+// buffer for the call, rather than decoded and kept whole by chunk_data
+template <typename T>
+static const T*
+ChunkRawData(const segcore::SegmentInternalInterface& segment,
+             FieldId field_id,
+             int64_t chunk_id,
+             std::vector<T>& buffer) {
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        auto packed = segment.GetPackedColumn(field_id);
+        if (packed != nullptr) {
+            return packed->Decode(0, packed->NumRows(), buffer);
+        }
+    }
+    return segment.chunk_data<T>(field_id, chunk_id).data();
+}
+
 template <typename T, typename U, typename CmpFunc>
 TargetBitmap
 ExecExprVisitor::ExecCompareRightType(const T* left_raw_data,
@@ -2094,8 +2109,9 @@ ExecExprVisitor::ExecCompareRightType(const T* left_raw_data,
                     : size_per_chunk;
 
     TargetBitmap result(size);
-    const U* right_raw_data =
-        segment_.chunk_data<U>(right_field_id, current_chunk_id).data();
+    std::vector<U> right_buffer;
+    const U* right_raw_data = ChunkRawData(
+        segment_, right_field_id, current_chunk_id, right_buffer);
 
     for (int i = 0; i < size; ++i) {
         result[i] = cmp_func(left_raw_data[i], right_raw_data[i]);
@@ -2117,8 +2133,9 @@ ExecExprVisitor::ExecCompareLeftType(const FieldId& left_field_id,
 
     for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
         FixedVector<bool> result;
+        std::vector<T> left_buffer;
         const T* left_raw_data =
-            segment_.chunk_data<T>(left_field_id, chunk_id).data();
+            ChunkRawData(segment_, left_field_id, chunk_id, left_buffer);
 
         switch (right_field_type) {
             case DataType::BOOL:
@@ -2254,6 +2271,29 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op)
         return ExecCompareExprDispatcherForNonIndexedSegment<Op>(expr, op);
     }
 
+    auto packedAccessor = [](const PackedColumn& packed, DataType type)
+        -> std::function<const number(int)> {
+        auto accessor = [&packed](auto value) {
+            using T = decltype(value);
+            auto reader = std::make_shared<PackedColumnReader<T>>(packed);
+            return [reader](int i) -> const number { return (*reader)[i]; };
+        };
+        switch (type) {
+            case DataType::INT8:
+                return accessor(int8_t());
+            case DataType::INT16:
+                return accessor(int16_t());
+            case DataType::INT32:
+                return accessor(int32_t());
+            case DataType::INT64:
+                return accessor(int64_t());
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported packed data type {}",
+                          type);
+        }
+    };
+
     // TODO: refactoring the code that contains too much call stack.
     for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
         auto size = chunk_id == num_chunk - 1
@@ -2262,6 +2302,13 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op)
         auto getChunkData =
             [&, chunk_id](DataType type, FieldId field_id, int64_t data_barrier)
             -> std::function<const number(int)> {
+            // the rows of a packed column are read a block at a time
+            auto packed = chunk_id < data_barrier
+                              ? segment_.GetPackedColumn(field_id)
+                              : nullptr;
+            if (packed != nullptr) {
+                return packedAccessor(*packed, type);
+            }
             switch (type) {
                 case DataType::BOOL: {
                     if (chunk_id < data_barrier) {
@@ -2440,23 +2487,14 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op)
                 }
                 case DataType::VARCHAR: {
                     if (chunk_id < data_barrier) {
-                        if (segment_.type() == SegmentType::Growing) {
-                            auto chunk_data =
-                                segment_
-                                    .chunk_data<std::string>(field_id, chunk_id)
-                                    .data();
-                            return [chunk_data](int i) -> const number {
-                                return chunk_data[i];
-                            };
-                        } else {
-                            auto chunk_data = segment_
-                                                  .chunk_data<std::string_view>(
-                                                      field_id, chunk_id)
-                                                  .data();
-                            return [chunk_data](int i) -> const number {
-                                return std::string(chunk_data[i]);
-                            };
-                        }
+                        auto chunk_data =
+                            segment_
+                                .chunk_data<std::string_view>(field_id,
+                                                              chunk_id)
+                                .data();
+                        return [chunk_data](int i) -> const number {
+                            return std::string(chunk_data[i]);
+                        };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
                         auto& indexing =
@@ -2926,11 +2964,7 @@ ExecExprVisitor::visit(TermExpr& expr) {
             break;
         }
         case DataType::VARCHAR: {
-            if (segment_.type() == SegmentType::Growing) {
-                res = ExecTermVisitorImpl<std::string>(expr);
-            } else {
-                res = ExecTermVisitorImpl<std::string_view>(expr);
-            }
+            res = ExecTermVisitorImpl<std::string_view>(expr);
             break;
         }
         case DataType::JSON: {
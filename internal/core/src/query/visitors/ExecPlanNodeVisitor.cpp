@@ -11,17 +11,27 @@
 
 #include "query/generated/ExecPlanNodeVisitor.h"
 
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
 
+#include "query/Aggregate.h"
+#include "query/FilterCache.h"
+#include "query/GroupBy.h"
+#include "query/HybridSearch.h"
+#include "query/OrderBy.h"
 #include "query/PlanImpl.h"
 #include "query/SubSearchResult.h"
-#include "query/generated/ExecExprVisitor.h"
 #include "query/Utils.h"
+#include "segcore/AdaptiveSearch.h"
 #include "segcore/SegmentGrowing.h"
 #include "common/Json.h"
 #include "log/Log.h"
 #include "plan/PlanNode.h"
 #include "exec/Task.h"
+#include "exec/expression/Expr.h"
+#include "storage/SearchMetrics.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::query {
 
@@ -76,20 +86,13 @@ empty_search_result(int64_t num_queries, SearchInfo& search_info) {
     return final_result;
 }
 
-void
-ExecPlanNodeVisitor::ExecuteExprNodeInternal(
-    const std::shared_ptr<milvus::plan::PlanNode>& plannode,
-    const milvus::segcore::SegmentInternalInterface* segment,
-    BitsetType& bitset_holder,
-    bool& cache_offset_getted,
-    std::vector<int64_t>& cache_offset) {
-    bitset_holder.clear();
-    LOG_SEGCORE_INFO_ << "plannode:" << plannode->ToString();
+static void
+ExecuteFilterTask(const std::shared_ptr<milvus::plan::PlanNode>& plannode,
+                  std::shared_ptr<milvus::exec::QueryContext> query_context,
+                  BitsetType& bitset_holder,
+                  bool& cache_offset_getted,
+                  std::vector<int64_t>& cache_offset) {
     auto plan = plan::PlanFragment(plannode);
-    // TODO: get query id from proxy
-    auto query_context = std::make_shared<milvus::exec::QueryContext>(
-        DEAFULT_QUERY_ID, segment, timestamp_);
-
     auto task =
         milvus::exec::Task::Create(DEFAULT_TASK_ID, plan, 0, query_context);
     for (;;) {
@@ -128,9 +131,302 @@ ExecPlanNodeVisitor::ExecuteExprNodeInternal(
             PanicInfo(UnexpectedError, "expr return type not matched");
         }
     }
-    //    std::string s;
-    //    boost::to_string(*bitset_holder, s);
-    //    std::cout << bitset_holder->size() << " .  " << s << std::endl;
+}
+
+// the number of row ranges to evaluate the filter in parallel, 1 if it should
+// be evaluated by the calling thread
+static int64_t
+FilterSplitNum(const std::shared_ptr<milvus::plan::PlanNode>& plannode,
+               const milvus::segcore::SegmentInternalInterface* segment,
+               int64_t active_count) {
+    auto split_num = std::min<int64_t>(
+        CPU_NUM, active_count / DEFAULT_EXEC_FILTER_SPLIT_MIN_ROWS);
+    if (split_num <= 1 || segment->type() != SegmentType::Sealed) {
+        return 1;
+    }
+    auto filter_node =
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(plannode);
+    if (filter_node == nullptr ||
+        !exec::IsOffsetInputSupported(filter_node->filter())) {
+        return 1;
+    }
+    return split_num;
+}
+
+void
+ExecPlanNodeVisitor::ExecuteExprNodeInternal(
+    const std::shared_ptr<milvus::plan::PlanNode>& plannode,
+    const milvus::segcore::SegmentInternalInterface* segment,
+    BitsetType& bitset_holder,
+    bool& cache_offset_getted,
+    std::vector<int64_t>& cache_offset,
+    const std::vector<int64_t>* offset_input) {
+    bitset_holder.clear();
+    auto active_count = segment->get_active_count(timestamp_);
+    // the chunk results are appended to the holder, reserve for all of them
+    bitset_holder.reserve(offset_input != nullptr ? offset_input->size()
+                                                  : active_count);
+    LOG_SEGCORE_INFO_ << "plannode:" << plannode->ToString();
+
+    auto split_num = offset_input != nullptr
+                         ? 1
+                         : FilterSplitNum(plannode, segment, active_count);
+    // the filters of the retrieves are not observed
+    std::optional<storage::SearchStageTimer> stage_timer;
+    if (search_index_type_.has_value()) {
+        stage_timer.emplace(storage::SearchStage::Filter,
+                            storage::SegmentTypeLabel(segment->type()),
+                            *search_index_type_);
+    }
+    ProfileTimer timer(
+        profile_.get(),
+        offset_input != nullptr ? "filter_on_offsets" : "filter");
+    auto record_filter = [&](std::string path) {
+        if (timer.enabled()) {
+            timer.Stop();
+            auto& stage = timer.stage();
+            stage.path_ = std::move(path);
+            stage.input_rows_ = bitset_holder.size();
+            stage.output_rows_ = bitset_holder.count();
+        }
+    };
+
+    // the filters evaluated on the sealed segments are cached by their
+    // exprs, see FilterCache
+    auto& filter_cache = FilterCache::GetInstance();
+    std::string cache_key;
+    if (offset_input == nullptr && segment->type() == SegmentType::Sealed &&
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(plannode) != nullptr &&
+        filter_cache.enabled()) {
+        cache_key = plannode->ToString();
+        if (filter_cache.Get(segment, cache_key, active_count, bitset_holder)) {
+            record_filter("cached");
+            return;
+        }
+    }
+    auto finish_filter = [&]() {
+        if (!cache_key.empty()) {
+            filter_cache.Put(segment, cache_key, bitset_holder);
+        }
+        record_filter(split_num <= 1 ? "serial"
+                                     : fmt::format("parallel_{}", split_num));
+    };
+    if (split_num <= 1) {
+        // TODO: get query id from proxy
+        auto query_context = std::make_shared<milvus::exec::QueryContext>(
+            DEAFULT_QUERY_ID, segment, timestamp_);
+        query_context->set_offset_input(offset_input);
+        query_context->set_profile(profile_.get());
+        query_context->set_cancellation_token(cancellation_token_);
+        ExecuteFilterTask(plannode,
+                          query_context,
+                          bitset_holder,
+                          cache_offset_getted,
+                          cache_offset);
+        finish_filter();
+        return;
+    }
+
+    // evaluate the row ranges of a large sealed segment in parallel, the
+    // ranges are aligned to the bitset blocks, so that the partial results
+    // are stitched block by block
+    auto split_rows = (active_count + split_num - 1) / split_num;
+    split_rows = (split_rows + BITSET_BLOCK_BIT_SIZE - 1) /
+                 BITSET_BLOCK_BIT_SIZE * BITSET_BLOCK_BIT_SIZE;
+    split_num = (active_count + split_rows - 1) / split_rows;
+    std::vector<BitsetType> parts(split_num);
+    std::vector<uint8_t> parts_cache_offset_getted(split_num, false);
+    std::vector<std::vector<int64_t>> parts_cache_offset(split_num);
+    auto evaluate_split = [&](int64_t i) {
+        auto query_context = std::make_shared<milvus::exec::QueryContext>(
+            DEAFULT_QUERY_ID, segment, timestamp_);
+        auto begin = i * split_rows;
+        query_context->set_row_range(
+            begin, std::min(begin + split_rows, active_count));
+        query_context->set_profile(profile_.get());
+        query_context->set_cancellation_token(cancellation_token_);
+        bool getted = false;
+        ExecuteFilterTask(
+            plannode, query_context, parts[i], getted, parts_cache_offset[i]);
+        parts_cache_offset_getted[i] = getted;
+    };
+
+    // the splits claimed by the caller and by the helpers on the pool, the
+    // split bodies submit to the pool and wait as well, e.g. the pk probes
+    // and the chunk cache reads, so the caller mustn't wait for a helper to
+    // be scheduled
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+    pool.RunClaimed(split_num, split_num, evaluate_split);
+
+    for (auto& part : parts) {
+        auto blocks =
+            reinterpret_cast<const BitsetBlockType*>(boost_ext::get_data(part));
+        bitset_holder.append(blocks, blocks + part.num_blocks());
+    }
+    bitset_holder.resize(active_count);
+    // the cached offsets are of the whole segment, the same for every range
+    if (!cache_offset_getted && parts_cache_offset_getted[0]) {
+        cache_offset = std::move(parts_cache_offset[0]);
+        cache_offset_getted = true;
+    }
+    finish_filter();
+}
+
+// set the bits of the rows invisible at the timestamp and of the deleted ones
+static void
+MaskInvisibleRows(const segcore::SegmentInternalInterface* segment,
+                  BitsetType& bitset,
+                  int64_t active_count,
+                  Timestamp timestamp,
+                  const std::string& index_type,
+                  QueryProfile* profile) {
+    auto segment_type = storage::SegmentTypeLabel(segment->type());
+    {
+        storage::SearchStageTimer stage_timer(
+            storage::SearchStage::TimestampFilter, segment_type, index_type);
+        ProfileTimer timer(profile, "mask_timestamps");
+        segment->mask_with_timestamps(bitset, timestamp);
+        timer.stage().input_rows_ = active_count;
+        timer.stage().bytes_ = active_count * sizeof(Timestamp);
+    }
+    storage::SearchStageTimer stage_timer(
+        storage::SearchStage::MaskWithDelete, segment_type, index_type);
+    ProfileTimer timer(profile, "mask_delete");
+    segment->mask_with_delete(bitset, active_count, timestamp);
+    if (timer.enabled()) {
+        timer.Stop();
+        timer.stage().input_rows_ = segment->get_deleted_count();
+        timer.stage().output_rows_ = active_count - bitset.count();
+    }
+}
+
+// the number of the valid results of the queries
+static int64_t
+NumValidResults(const SearchResult& search_result) {
+    return std::count_if(search_result.seg_offsets_.begin(),
+                         search_result.seg_offsets_.end(),
+                         [](int64_t offset) {
+                             return offset != INVALID_SEG_OFFSET;
+                         });
+}
+
+static bool
+UseIterativeFilter(const VectorPlanNode& node) {
+    if (!node.filter_plannode_.has_value() ||
+        node.search_info_.group_by_field_id_.has_value() ||
+        !node.sub_searches_.empty()) {
+        return false;
+    }
+    auto& params = node.search_info_.search_params_;
+    if (!params.contains(ITERATIVE_FILTER) ||
+        !params[ITERATIVE_FILTER].is_boolean() ||
+        !params[ITERATIVE_FILTER].get<bool>() || params.contains(RADIUS)) {
+        return false;
+    }
+    auto filter_node = std::dynamic_pointer_cast<plan::FilterBitsNode>(
+        node.filter_plannode_.value());
+    return filter_node != nullptr &&
+           exec::IsOffsetInputSupported(filter_node->filter());
+}
+
+// Search without the filter for more candidates than topk, and evaluate the
+// filter on the candidates only, the candidates are widened until every query
+// gets topk of them passing the filter. This saves evaluating an expensive
+// filter on every row if it drops just a few of them. Returns false if too
+// many candidates are needed, the filter should be evaluated on all the rows
+// then.
+bool
+ExecPlanNodeVisitor::IterativeFilterSearch(
+    VectorPlanNode& node,
+    const segcore::SegmentInternalInterface* segment,
+    const void* src_data,
+    int64_t num_queries,
+    const BitsetType& bitset,
+    SearchResult& search_result) {
+    auto topk = node.search_info_.topk_;
+    auto active_count = segment->get_active_count(timestamp_);
+    auto max_topk = std::min(active_count, DEFAULT_ITERATIVE_FILTER_MAX_TOPK);
+    auto search_info = node.search_info_;
+    search_info.search_params_.erase(ITERATIVE_FILTER);
+    BitsetView view = bitset;
+
+    // the filter results of the evaluated candidates
+    std::unordered_map<int64_t, bool> passed;
+    std::vector<int64_t> offsets;
+    BitsetType filter_res;
+    auto candidate_topk = std::min(topk * 2, max_topk);
+    for (;;) {
+        search_info.topk_ = candidate_topk;
+        SearchResult candidates;
+        segment->vector_search(search_info,
+                               src_data,
+                               num_queries,
+                               timestamp_,
+                               view,
+                               candidates);
+
+        offsets.clear();
+        for (auto offset : candidates.seg_offsets_) {
+            if (offset != INVALID_SEG_OFFSET &&
+                passed.find(offset) == passed.end()) {
+                offsets.push_back(offset);
+            }
+        }
+        std::sort(offsets.begin(), offsets.end());
+        offsets.erase(std::unique(offsets.begin(), offsets.end()),
+                      offsets.end());
+        if (!offsets.empty()) {
+            ExecuteExprNodeOnOffsets(
+                node.filter_plannode_.value(), segment, offsets, filter_res);
+            for (size_t i = 0; i < offsets.size(); ++i) {
+                passed.emplace(offsets[i], filter_res[i]);
+            }
+        }
+
+        // a query is done if it has topk passed candidates, or there are no
+        // more candidates for it
+        bool done = true;
+        for (int64_t q = 0; q < num_queries && done; ++q) {
+            int64_t num_passed = 0;
+            bool exhausted = candidate_topk >= active_count;
+            for (int64_t i = 0; i < candidate_topk && num_passed < topk; ++i) {
+                auto offset = candidates.seg_offsets_[q * candidate_topk + i];
+                if (offset == INVALID_SEG_OFFSET) {
+                    exhausted = true;
+                    break;
+                }
+                num_passed += passed[offset];
+            }
+            done = num_passed == topk || exhausted;
+        }
+
+        if (done) {
+            search_result = empty_search_result(num_queries, node.search_info_);
+            for (int64_t q = 0; q < num_queries; ++q) {
+                int64_t num_passed = 0;
+                for (int64_t i = 0; i < candidate_topk && num_passed < topk;
+                     ++i) {
+                    auto pos = q * candidate_topk + i;
+                    auto offset = candidates.seg_offsets_[pos];
+                    if (offset == INVALID_SEG_OFFSET) {
+                        break;
+                    }
+                    if (passed[offset]) {
+                        search_result.seg_offsets_[q * topk + num_passed] =
+                            offset;
+                        search_result.distances_[q * topk + num_passed] =
+                            candidates.distances_[pos];
+                        ++num_passed;
+                    }
+                }
+            }
+            return true;
+        }
+        if (candidate_topk >= max_topk) {
+            return false;
+        }
+        candidate_topk = std::min(candidate_topk * 4, max_topk);
+    }
 }
 
 template <typename VectorType>
@@ -142,6 +438,12 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         dynamic_cast<const segcore::SegmentInternalInterface*>(&segment_);
     AssertInfo(segment, "support SegmentSmallIndex Only");
     SearchResult search_result;
+    if (node.search_info_.profile_ || force_profile_) {
+        profile_ = std::make_shared<QueryProfile>();
+    }
+    search_index_type_ = storage::IndexTypeLabel(
+        segment->vector_index_type(node.search_info_.field_id_));
+    auto segment_type = storage::SegmentTypeLabel(segment->type());
     auto& ph = placeholder_group_->at(0);
     auto src_data = ph.get_blob<EmbeddedType<VectorType>>();
     auto num_queries = ph.num_of_queries_;
@@ -157,6 +459,43 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         return;
     }
 
+    if (UseIterativeFilter(node)) {
+        BitsetType bitset(active_count, false);
+        MaskInvisibleRows(segment,
+                          bitset,
+                          active_count,
+                          timestamp_,
+                          *search_index_type_,
+                          profile_.get());
+        if (bitset.all()) {
+            search_result_opt_ =
+                empty_search_result(num_queries, node.search_info_);
+            return;
+        }
+        storage::SearchStageTimer stage_timer(
+            storage::SearchStage::VectorSearch,
+            segment_type,
+            *search_index_type_);
+        ProfileTimer timer(profile_.get(), "search");
+        if (IterativeFilterSearch(node,
+                                  segment,
+                                  src_data,
+                                  num_queries,
+                                  bitset,
+                                  search_result)) {
+            if (timer.enabled()) {
+                timer.Stop();
+                timer.stage().path_ = "iterative_filter";
+                timer.stage().input_rows_ = active_count - bitset.count();
+                timer.stage().output_rows_ = NumValidResults(search_result);
+            }
+            search_result_opt_ = std::move(search_result);
+            return;
+        }
+        // the filter is evaluated on all the rows instead
+        timer.stage().name_ = "iterative_filter_fallback";
+    }
+
     std::unique_ptr<BitsetType> bitset_holder;
     if (node.filter_plannode_.has_value()) {
         BitsetType expr_res;
@@ -166,9 +505,12 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
     } else {
         bitset_holder = std::make_unique<BitsetType>(active_count, false);
     }
-    segment->mask_with_timestamps(*bitset_holder, timestamp_);
-
-    segment->mask_with_delete(*bitset_holder, active_count, timestamp_);
+    MaskInvisibleRows(segment,
+                      *bitset_holder,
+                      active_count,
+                      timestamp_,
+                      *search_index_type_,
+                      profile_.get());
 
     // if bitset_holder is all 1's, we got empty result
     if (bitset_holder->all()) {
@@ -177,12 +519,63 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         return;
     }
     BitsetView final_view = *bitset_holder;
-    segment->vector_search(node.search_info_,
+    CheckCancellation(cancellation_token_);
+    storage::SearchStageTimer stage_timer(
+        storage::SearchStage::VectorSearch, segment_type, *search_index_type_);
+    ProfileTimer timer(profile_.get(), "search");
+    if (timer.enabled()) {
+        auto& field_meta = segment->get_schema()[node.search_info_.field_id_];
+        auto& stage = timer.stage();
+        stage.input_rows_ = active_count - bitset_holder->count();
+        if (!node.sub_searches_.empty()) {
+            stage.path_ = "hybrid";
+        } else if (node.search_info_.group_by_field_id_.has_value()) {
+            stage.path_ = "group_by";
+        } else if (segment->HasIndex(node.search_info_.field_id_)) {
+            stage.path_ = "index";
+        } else {
+            stage.path_ = "brute_force";
+            stage.bytes_ = stage.input_rows_ * field_meta.get_sizeof();
+        }
+    }
+    auto record_search = [&]() {
+        if (timer.enabled()) {
+            timer.Stop();
+            timer.stage().output_rows_ = NumValidResults(search_result);
+        }
+    };
+    if (!node.sub_searches_.empty()) {
+        HybridSearch(*segment,
+                     node,
+                     *placeholder_group_,
+                     timestamp_,
+                     final_view,
+                     search_result);
+        record_search();
+        search_result_opt_ = std::move(search_result);
+        return;
+    }
+    if (node.search_info_.group_by_field_id_.has_value()) {
+        GroupBySearch(*segment,
+                      node.search_info_,
+                      src_data,
+                      num_queries,
+                      timestamp_,
+                      final_view,
+                      search_result);
+        record_search();
+        search_result_opt_ = std::move(search_result);
+        return;
+    }
+    segcore::AdaptiveSearchScope adaptive(*segment, node.search_info_);
+    segment->vector_search(adaptive.search_info(),
                            src_data,
                            num_queries,
                            timestamp_,
                            final_view,
                            search_result);
+    adaptive.Finish(search_result);
+    record_search();
 
     search_result_opt_ = std::move(search_result);
 }
@@ -208,6 +601,14 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
 
     auto active_count = segment->get_active_count(timestamp_);
 
+    auto aggregated = !node.aggregates_.empty();
+    if (active_count == 0 && aggregated) {
+        retrieve_result.field_data_ =
+            AggregateRows(*segment, node.aggregates_, BitsetType());
+        retrieve_result_opt_ = std::move(retrieve_result);
+        return;
+    }
+
     if (active_count == 0 && !node.is_count_) {
         retrieve_result_opt_ = std::move(retrieve_result);
         return;
@@ -220,8 +621,28 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
     }
 
     BitsetType bitset_holder;
+    // the count of a segment with no deleted and no invisible row is the
+    // popcount of the filter, without flipping or masking the rows
+    if (node.is_count_ && segment->get_deleted_count() == 0 &&
+        segment->all_visible(timestamp_)) {
+        auto cnt = active_count;
+        if (node.filter_plannode_.has_value()) {
+            bool get_cache_offset = false;
+            std::vector<int64_t> cache_offsets;
+            ExecuteExprNodeInternal(node.filter_plannode_.value(),
+                                    segment,
+                                    bitset_holder,
+                                    get_cache_offset,
+                                    cache_offsets);
+            cnt = bitset_holder.count();
+        }
+        retrieve_result = *(wrap_num_entities(cnt));
+        retrieve_result_opt_ = std::move(retrieve_result);
+        return;
+    }
+
     // For case that retrieve by expression, bitset will be allocated when expression is being executed.
-    if (node.is_count_) {
+    if (node.is_count_ || aggregated) {
         bitset_holder.resize(active_count);
     }
 
@@ -238,11 +659,19 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
         bitset_holder.flip();
     }
 
+    CheckCancellation(cancellation_token_);
     segment->mask_with_timestamps(bitset_holder, timestamp_);
 
     segment->mask_with_delete(bitset_holder, active_count, timestamp_);
     // if bitset_holder is all 1's, we got empty result
-    if (bitset_holder.all() && !node.is_count_) {
+    if (bitset_holder.all() && !node.is_count_ && !aggregated) {
+        retrieve_result_opt_ = std::move(retrieve_result);
+        return;
+    }
+
+    if (aggregated) {
+        retrieve_result.field_data_ =
+            AggregateRows(*segment, node.aggregates_, bitset_holder);
         retrieve_result_opt_ = std::move(retrieve_result);
         return;
     }
@@ -262,8 +691,17 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
         false_filtered_out = true;
         segment->timestamp_filter(bitset_holder, timestamp_);
     }
-    retrieve_result.result_offsets_ =
-        segment->find_first(node.limit_, bitset_holder, false_filtered_out);
+    if (node.order_by_.has_value()) {
+        retrieve_result.result_offsets_ =
+            FindFirstOrderBy(*segment,
+                             node.order_by_.value(),
+                             node.limit_,
+                             bitset_holder,
+                             false_filtered_out);
+    } else {
+        retrieve_result.result_offsets_ = segment->find_first(
+            node.limit_, bitset_holder, false_filtered_out);
+    }
     retrieve_result_opt_ = std::move(retrieve_result);
 }
 
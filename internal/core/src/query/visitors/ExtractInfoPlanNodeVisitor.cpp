@@ -11,7 +11,8 @@
 
 #include "query/Plan.h"
 #include "query/generated/ExtractInfoPlanNodeVisitor.h"
-#include "query/generated/ExtractInfoExprVisitor.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
 
 namespace milvus::query {
 
@@ -29,39 +30,62 @@ class ExtractInfoPlanNodeVisitor : PlanNodeVisitor {
 };
 }  // namespace impl
 
+static void
+ExtractInvolvedFields(
+    const std::optional<std::shared_ptr<milvus::plan::PlanNode>>& plannode,
+    ExtractedPlanInfo& plan_info) {
+    if (!plannode.has_value()) {
+        return;
+    }
+    auto filter_node =
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(plannode.value());
+    AssertInfo(filter_node != nullptr, "plan node must be filter bits node");
+    std::vector<FieldId> field_ids;
+    expr::CollectFieldIds(filter_node->filter(), field_ids);
+    for (auto field_id : field_ids) {
+        plan_info.add_involved_field(field_id);
+    }
+}
+
+// the fields searched by the node and its sub searches, and grouped by
+static void
+ExtractSearchFields(const VectorPlanNode& node, ExtractedPlanInfo& plan_info) {
+    plan_info.add_involved_field(node.search_info_.field_id_);
+    auto& group_by_field_id = node.search_info_.group_by_field_id_;
+    if (group_by_field_id.has_value()) {
+        plan_info.add_involved_field(group_by_field_id.value());
+    }
+    for (auto& sub_search : node.sub_searches_) {
+        plan_info.add_involved_field(sub_search.search_info_.field_id_);
+    }
+}
+
 void
 ExtractInfoPlanNodeVisitor::visit(FloatVectorANNS& node) {
-    plan_info_.add_involved_field(node.search_info_.field_id_);
-    if (node.predicate_.has_value()) {
-        ExtractInfoExprVisitor expr_visitor(plan_info_);
-        node.predicate_.value()->accept(expr_visitor);
-    }
+    ExtractSearchFields(node, plan_info_);
+    ExtractInvolvedFields(node.filter_plannode_, plan_info_);
 }
 
 void
 ExtractInfoPlanNodeVisitor::visit(BinaryVectorANNS& node) {
-    plan_info_.add_involved_field(node.search_info_.field_id_);
-    if (node.predicate_.has_value()) {
-        ExtractInfoExprVisitor expr_visitor(plan_info_);
-        node.predicate_.value()->accept(expr_visitor);
-    }
+    ExtractSearchFields(node, plan_info_);
+    ExtractInvolvedFields(node.filter_plannode_, plan_info_);
 }
 
 void
 ExtractInfoPlanNodeVisitor::visit(Float16VectorANNS& node) {
-    plan_info_.add_involved_field(node.search_info_.field_id_);
-    if (node.predicate_.has_value()) {
-        ExtractInfoExprVisitor expr_visitor(plan_info_);
-        node.predicate_.value()->accept(expr_visitor);
-    }
+    ExtractSearchFields(node, plan_info_);
+    ExtractInvolvedFields(node.filter_plannode_, plan_info_);
 }
 
 void
 ExtractInfoPlanNodeVisitor::visit(RetrievePlanNode& node) {
-    // Assert(node.predicate_.has_value());
-    ExtractInfoExprVisitor expr_visitor(plan_info_);
-    if (node.predicate_.has_value()) {
-        node.predicate_.value()->accept(expr_visitor);
+    ExtractInvolvedFields(node.filter_plannode_, plan_info_);
+    for (auto& aggregate : node.aggregates_) {
+        plan_info_.add_involved_field(aggregate.field_id_);
+    }
+    if (node.order_by_.has_value()) {
+        plan_info_.add_involved_field(node.order_by_->field_id_);
     }
 }
 
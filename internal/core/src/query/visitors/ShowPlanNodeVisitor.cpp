@@ -13,6 +13,7 @@
 
 #include "common/EasyAssert.h"
 #include "common/Json.h"
+#include "plan/PlanNode.h"
 #include "query/generated/ShowExprVisitor.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
 
@@ -66,6 +67,8 @@ ShowPlanNodeVisitor::visit(FloatVectorANNS& node) {
                    "[ShowPlanNodeVisitor]Can't get value from node predict");
         json_body["predicate"] =
             expr_show.call_child(node.predicate_->operator*());
+    } else if (node.filter_plannode_.has_value()) {
+        json_body["predicate"] = node.filter_plannode_.value()->ToString();
     } else {
         json_body["predicate"] = "None";
     }
@@ -90,6 +93,8 @@ ShowPlanNodeVisitor::visit(BinaryVectorANNS& node) {
                    "[ShowPlanNodeVisitor]Can't get value from node predict");
         json_body["predicate"] =
             expr_show.call_child(node.predicate_->operator*());
+    } else if (node.filter_plannode_.has_value()) {
+        json_body["predicate"] = node.filter_plannode_.value()->ToString();
     } else {
         json_body["predicate"] = "None";
     }
@@ -114,6 +119,8 @@ ShowPlanNodeVisitor::visit(Float16VectorANNS& node) {
                    "[ShowPlanNodeVisitor]Can't get value from node predict");
         json_body["predicate"] =
             expr_show.call_child(node.predicate_->operator*());
+    } else if (node.filter_plannode_.has_value()) {
+        json_body["predicate"] = node.filter_plannode_.value()->ToString();
     } else {
         json_body["predicate"] = "None";
     }
@@ -122,6 +129,24 @@ ShowPlanNodeVisitor::visit(Float16VectorANNS& node) {
 
 void
 ShowPlanNodeVisitor::visit(RetrievePlanNode& node) {
+    assert(!ret_);
+    Json json_body{
+        {"node_type", "RetrievePlanNode"},  //
+        {"is_count", node.is_count_},       //
+        {"limit", node.limit_},             //
+    };
+    if (node.predicate_.has_value()) {
+        ShowExprVisitor expr_show;
+        AssertInfo(node.predicate_.value(),
+                   "[ShowPlanNodeVisitor]Can't get value from node predict");
+        json_body["predicate"] =
+            expr_show.call_child(node.predicate_->operator*());
+    } else if (node.filter_plannode_.has_value()) {
+        json_body["predicate"] = node.filter_plannode_.value()->ToString();
+    } else {
+        json_body["predicate"] = "None";
+    }
+    ret_ = json_body;
 }
 
 }  // namespace milvus::query
@@ -11,10 +11,10 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <mutex>
-#include <set>
-#include <shared_mutex>
+#include <cstdint>
+#include <thread>
 
 namespace milvus::segcore {
 
@@ -40,17 +40,34 @@ example() {
 }
 #endif
 
+// The segments processed out of order wait in the slots until the ack reaches
+// them, the segment beginning at the ack advances it and then takes over the
+// segments waiting right after, so no lock is taken. Only the segment
+// beginning at the ack advances it, as the segments don't overlap.
 class AckResponder {
  public:
     // specify that segment [seg_begin, seg_end) has been processed
     // WARN: segments shouldn't Overlap
     void
     AddSegment(int64_t seg_begin, int64_t seg_end) {
-        std::lock_guard lck(mutex_);
-        fetch_and_flip(seg_end);
-        auto old_begin = fetch_and_flip(seg_begin);
-        if (old_begin) {
-            minimum_ = *acks_.begin();
+        for (;;) {
+            if (minimum_.load() == seg_begin) {
+                // nobody else advances the ack from seg_begin
+                minimum_.store(seg_end);
+                Advance(seg_end);
+                return;
+            }
+            if (auto slot = Publish(seg_begin, seg_end); slot != nullptr) {
+                // the ack may have reached seg_begin before the segment
+                // is published, in which case nobody else takes it
+                if (minimum_.load() == seg_begin) {
+                    Advance(seg_begin);
+                }
+                return;
+            }
+            // all the slots are taken by the segments after the ack, which
+            // wait for the segments before them
+            std::this_thread::yield();
         }
     }
 
@@ -61,20 +78,51 @@ class AckResponder {
     }
 
  private:
-    bool
-    fetch_and_flip(int64_t endpoint) {
-        if (acks_.count(endpoint)) {
-            acks_.erase(endpoint);
-            return true;
-        } else {
-            acks_.insert(endpoint);
-            return false;
+    static constexpr int64_t EMPTY = -1;
+    static constexpr int64_t BUSY = -2;
+    static constexpr int NUM_SLOTS = 64;
+
+    struct Slot {
+        std::atomic<int64_t> begin = EMPTY;
+        int64_t end = 0;
+    };
+
+    Slot*
+    Publish(int64_t seg_begin, int64_t seg_end) {
+        for (auto& slot : slots_) {
+            auto expected = EMPTY;
+            if (slot.begin.compare_exchange_strong(expected, BUSY)) {
+                slot.end = seg_end;
+                slot.begin.store(seg_begin);
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    // take the segments waiting right after the ack, one after another
+    void
+    Advance(int64_t ack) {
+        for (;;) {
+            auto taken = false;
+            for (auto& slot : slots_) {
+                auto expected = ack;
+                if (slot.begin.compare_exchange_strong(expected, BUSY)) {
+                    ack = slot.end;
+                    slot.begin.store(EMPTY);
+                    minimum_.store(ack);
+                    taken = true;
+                    break;
+                }
+            }
+            if (!taken) {
+                return;
+            }
         }
     }
 
  private:
-    std::shared_mutex mutex_;
-    std::set<int64_t> acks_ = {0};
+    std::array<Slot, NUM_SLOTS> slots_;
     std::atomic<int64_t> minimum_ = 0;
 };
 }  // namespace milvus::segcore
@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/AdaptiveSearch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/QueryResult.h"
+#include "index/Meta.h"
+#include "knowhere/comp/index_param.h"
+#include "segcore/SegcoreConfig.h"
+#include "segcore/SegmentInterface.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::segcore {
+
+double
+EffortShare(int64_t target_us, int64_t wait_us, int64_t full_latency_us) {
+    if (target_us <= 0) {
+        return 1;
+    }
+    auto budget_us = target_us - wait_us;
+    if (budget_us <= 0) {
+        return 0;
+    }
+    if (full_latency_us <= budget_us) {
+        return 1;
+    }
+    return static_cast<double>(budget_us) / full_latency_us;
+}
+
+double
+ScaleSearchEffort(SearchInfo& info,
+                  double share,
+                  std::map<std::string, int64_t>& adapted) {
+    // the param dominating the latency is taken as the least scaled one
+    std::optional<double> effort;
+    for (auto& [key, bound] : info.adaptive_bounds_) {
+        auto it = info.search_params_.find(key);
+        if (it == info.search_params_.end() || !it->is_number_integer()) {
+            continue;
+        }
+        auto requested = it->get<int64_t>();
+        auto lower = bound;
+        // the candidate lists hold the topk results
+        if (key == knowhere::indexparam::EF || key == DISK_ANN_QUERY_LIST) {
+            lower = std::max(lower, info.topk_);
+        }
+        auto scaled = std::max(
+            lower, static_cast<int64_t>(std::ceil(requested * share)));
+        if (scaled < requested) {
+            *it = scaled;
+            adapted[key] = scaled;
+        }
+        auto ratio = requested > 0
+                         ? static_cast<double>(std::min(scaled, requested)) /
+                               requested
+                         : 1.0;
+        effort = std::max(effort.value_or(0), ratio);
+    }
+    return effort.value_or(1);
+}
+
+AdaptiveSearchScope::AdaptiveSearchScope(
+    const SegmentInternalInterface& segment, SearchInfo& info)
+    : segment_(segment),
+      info_(info),
+      start_(std::chrono::steady_clock::now()) {
+    auto target_ms =
+        SegcoreConfig::default_config().get_adaptive_search_latency_target_ms();
+    enabled_ = target_ms > 0;
+    if (!enabled_ || info.adaptive_bounds_.empty()) {
+        return;
+    }
+    auto wait = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH)
+                    .RecentWaitTime();
+    auto share = EffortShare(target_ms * 1000,
+                             wait.count(),
+                             segment.full_effort_search_latency().Get());
+    if (share >= 1) {
+        return;
+    }
+    auto adapted_info = info;
+    auto effort = ScaleSearchEffort(adapted_info, share, adapted_params_);
+    if (!adapted_params_.empty()) {
+        adapted_info_ = std::move(adapted_info);
+        effort_ = effort;
+    }
+}
+
+void
+AdaptiveSearchScope::Finish(SearchResult& result) {
+    if (!enabled_) {
+        return;
+    }
+    auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start_)
+                          .count();
+    segment_.full_effort_search_latency().Observe(
+        static_cast<int64_t>(latency_us / effort_));
+    result.adapted_search_params_ = adapted_params_;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,108 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+#include "common/QueryInfo.h"
+
+namespace milvus {
+struct SearchResult;
+}  // namespace milvus
+
+namespace milvus::segcore {
+
+class SegmentInternalInterface;
+
+// the moving average of the recent latencies, racy but only an estimate
+class LatencyEwma {
+ public:
+    void
+    Observe(int64_t latency_us) {
+        auto recent = value_us_.load(std::memory_order_relaxed);
+        // the weight of a latency is 1/8, the first one taken as it is
+        value_us_.store(recent == 0 ? latency_us
+                                    : recent + (latency_us - recent) / 8,
+                        std::memory_order_relaxed);
+    }
+
+    // 0 if none observed
+    int64_t
+    Get() const {
+        return value_us_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    std::atomic<int64_t> value_us_{0};
+};
+
+// The adaptive search scales down the effort params of the searches opted in
+// by the ADAPTIVE_SEARCH search param while the node is overloaded, so they
+// get less accurate within the bounds of their own instead of timing out.
+//
+// The search on a segment takes the share of its requested effort which fits
+// into the latency target of the segcore config, after the recent wait of
+// the tasks of the high priority pool, given the recent latency of the
+// searches on the segment at the full effort. The latency is taken as
+// proportional to the effort, so the searches scaled down are observed at
+// their latency divided by their share.
+
+// the share of the requested effort a search can take to finish within
+// target_us after waiting wait_us, if the search at the full effort takes
+// full_latency_us, 0 for none observed yet; 1 if it's in time at the full
+// effort, 0 if the wait alone is over the target
+double
+EffortShare(int64_t target_us, int64_t wait_us, int64_t full_latency_us);
+
+// scale the effort params of info.adaptive_bounds_ in info.search_params_
+// by the share, not below their bounds, nor below topk for the candidate
+// lists like ef, the params not of integers are kept; the scaled ones are
+// put into adapted, return the share of the effort they take
+double
+ScaleSearchEffort(SearchInfo& info,
+                  double share,
+                  std::map<std::string, int64_t>& adapted);
+
+// The vector search on a segment, with the effort scaled down if adaptive,
+// its latency is observed once finished
+class AdaptiveSearchScope {
+ public:
+    AdaptiveSearchScope(const SegmentInternalInterface& segment,
+                        SearchInfo& info);
+
+    // the info to search with, vector_search may update it
+    SearchInfo&
+    search_info() {
+        return adapted_info_.has_value() ? *adapted_info_ : info_;
+    }
+
+    // observe the latency of the search and report the effort params it
+    // ran with into the result
+    void
+    Finish(SearchResult& result);
+
+ private:
+    const SegmentInternalInterface& segment_;
+    SearchInfo& info_;
+    bool enabled_ = false;
+    std::optional<SearchInfo> adapted_info_;
+    std::map<std::string, int64_t> adapted_params_;
+    double effort_ = 1;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace milvus::segcore {
+
+inline uint64_t
+MixHash(uint64_t x) {
+    // the finalizer of splitmix64
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t
+HashPk(int64_t pk) {
+    return MixHash(static_cast<uint64_t>(pk));
+}
+
+inline uint64_t
+HashPk(std::string_view pk) {
+    return MixHash(std::hash<std::string_view>{}(pk));
+}
+
+// SplitBlockBloomFilter is the split block bloom filter of parquet, every key
+// sets one bit in each of the 8 words of a 32 bytes block, so that a probe
+// touches a single cache line. With 10 bits per key the false positive rate
+// is about 1%.
+class SplitBlockBloomFilter {
+ public:
+    SplitBlockBloomFilter() = default;
+
+    explicit SplitBlockBloomFilter(int64_t num_keys) {
+        auto block_num =
+            (num_keys * BITS_PER_KEY + BLOCK_BITS - 1) / BLOCK_BITS;
+        blocks_.resize(std::max<int64_t>(block_num, 1));
+    }
+
+    void
+    Add(uint64_t hash) {
+        auto& block = blocks_[BlockIndex(hash)];
+        auto key = static_cast<uint32_t>(hash);
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+            block.words[i] |= 1U << ((key * SALT[i]) >> 27);
+        }
+    }
+
+    // always true if the filter is empty
+    bool
+    MayContain(uint64_t hash) const {
+        if (blocks_.empty()) {
+            return true;
+        }
+        auto& block = blocks_[BlockIndex(hash)];
+        auto key = static_cast<uint32_t>(hash);
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+            if ((block.words[i] & (1U << ((key * SALT[i]) >> 27))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int64_t
+    ByteSize() const {
+        return blocks_.size() * sizeof(Block);
+    }
+
+ private:
+    size_t
+    BlockIndex(uint64_t hash) const {
+        // map the upper 32 bits to [0, block_num) without division
+        return ((hash >> 32) * blocks_.size()) >> 32;
+    }
+
+ private:
+    static constexpr int WORDS_PER_BLOCK = 8;
+    static constexpr int64_t BLOCK_BITS = WORDS_PER_BLOCK * 32;
+    static constexpr int64_t BITS_PER_KEY = 10;
+    static constexpr uint32_t SALT[WORDS_PER_BLOCK] = {0x47b6137bU,
+                                                       0x44974d91U,
+                                                       0x8824ad5bU,
+                                                       0xa2b7289dU,
+                                                       0x705495c7U,
+                                                       0x2df1424bU,
+                                                       0x9efc4947U,
+                                                       0x5c6bfb31U};
+
+    struct alignas(32) Block {
+        uint32_t words[WORDS_PER_BLOCK] = {};
+    };
+    std::vector<Block> blocks_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,614 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/BulkImport.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <numeric>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+#include "common/Array.h"
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "common/FieldMeta.h"
+#include "parquet/arrow/reader.h"
+#include "storage/InsertData.h"
+#include "storage/ThreadPools.h"
+#include "storage/Util.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the source file read by ranges from the chunk manager, so only the column
+// chunks being decoded are in memory
+class ChunkManagerInputFile : public arrow::io::RandomAccessFile {
+ public:
+    ChunkManagerInputFile(storage::ChunkManager* chunk_manager,
+                          std::string filepath)
+        : chunk_manager_(chunk_manager),
+          filepath_(std::move(filepath)),
+          size_(chunk_manager_->Size(filepath_)) {
+    }
+
+    arrow::Status
+    Close() override {
+        closed_ = true;
+        return arrow::Status::OK();
+    }
+
+    bool
+    closed() const override {
+        return closed_;
+    }
+
+    arrow::Result<int64_t>
+    Tell() const override {
+        return position_;
+    }
+
+    arrow::Status
+    Seek(int64_t position) override {
+        position_ = position;
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<int64_t>
+    GetSize() override {
+        return size_;
+    }
+
+    arrow::Result<int64_t>
+    Read(int64_t nbytes, void* out) override {
+        ARROW_ASSIGN_OR_RAISE(auto read, ReadAt(position_, nbytes, out));
+        position_ += read;
+        return read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>>
+    Read(int64_t nbytes) override {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+        position_ += buffer->size();
+        return buffer;
+    }
+
+    // the ranges are read with no state of the file, so the row groups may
+    // be read at the same time
+    arrow::Result<int64_t>
+    ReadAt(int64_t position, int64_t nbytes, void* out) override {
+        nbytes = std::max<int64_t>(0, std::min(nbytes, size_ - position));
+        if (nbytes == 0) {
+            return 0;
+        }
+        try {
+            return static_cast<int64_t>(
+                chunk_manager_->Read(filepath_, position, out, nbytes));
+        } catch (std::exception& e) {
+            return arrow::Status::IOError(e.what());
+        }
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>>
+    ReadAt(int64_t position, int64_t nbytes) override {
+        nbytes = std::max<int64_t>(0, std::min(nbytes, size_ - position));
+        ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateBuffer(nbytes));
+        ARROW_ASSIGN_OR_RAISE(
+            auto read, ReadAt(position, nbytes, buffer->mutable_data()));
+        AssertInfo(read == nbytes,
+                   "read {} bytes from {}, expected {}",
+                   read,
+                   filepath_,
+                   nbytes);
+        return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+    }
+
+ private:
+    storage::ChunkManager* chunk_manager_;
+    const std::string filepath_;
+    const int64_t size_;
+    int64_t position_ = 0;
+    bool closed_ = false;
+};
+
+// the arrow type of the scalars, nullptr if the type isn't a scalar
+std::shared_ptr<arrow::DataType>
+ScalarArrowType(DataType data_type) {
+    switch (data_type) {
+        case DataType::BOOL:
+            return arrow::boolean();
+        case DataType::INT8:
+            return arrow::int8();
+        case DataType::INT16:
+            return arrow::int16();
+        case DataType::INT32:
+            return arrow::int32();
+        case DataType::INT64:
+            return arrow::int64();
+        case DataType::FLOAT:
+            return arrow::float32();
+        case DataType::DOUBLE:
+            return arrow::float64();
+        case DataType::STRING:
+        case DataType::VARCHAR:
+            return arrow::utf8();
+        default:
+            return nullptr;
+    }
+}
+
+// the arrow type of the elements of the vectors given as lists
+std::shared_ptr<arrow::DataType>
+VectorElementArrowType(DataType data_type) {
+    switch (data_type) {
+        case DataType::VECTOR_FLOAT:
+            return arrow::float32();
+        case DataType::VECTOR_FLOAT16:
+            return arrow::float16();
+        case DataType::VECTOR_BINARY:
+            return arrow::uint8();
+        default:
+            return nullptr;
+    }
+}
+
+// the elements of a vector given as a list, the bits of a binary vector
+// are packed into bytes
+int64_t
+VectorElements(DataType data_type, int64_t dim) {
+    return data_type == DataType::VECTOR_BINARY ? dim / 8 : dim;
+}
+
+void
+ValidateColumn(const FieldMeta& field_meta,
+               const std::shared_ptr<arrow::DataType>& type) {
+    auto data_type = field_meta.get_data_type();
+    bool valid = false;
+    switch (data_type) {
+        case DataType::JSON: {
+            valid = type->id() == arrow::Type::STRING ||
+                    type->id() == arrow::Type::BINARY;
+            break;
+        }
+        case DataType::ARRAY: {
+            auto element = ScalarArrowType(field_meta.get_element_type());
+            valid = type->id() == arrow::Type::LIST && element != nullptr &&
+                    static_cast<const arrow::ListType&>(*type)
+                        .value_type()
+                        ->Equals(element);
+            break;
+        }
+        case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_FLOAT16:
+        case DataType::VECTOR_BINARY: {
+            auto dim = field_meta.get_dim();
+            auto element = VectorElementArrowType(data_type);
+            if (type->id() == arrow::Type::FIXED_SIZE_BINARY) {
+                valid = static_cast<const arrow::FixedSizeBinaryType&>(*type)
+                            .byte_width() == datatype_sizeof(data_type, dim);
+            } else if (type->id() == arrow::Type::LIST) {
+                valid = static_cast<const arrow::ListType&>(*type)
+                            .value_type()
+                            ->Equals(element);
+            } else if (type->id() == arrow::Type::FIXED_SIZE_LIST) {
+                auto& list_type =
+                    static_cast<const arrow::FixedSizeListType&>(*type);
+                valid = list_type.value_type()->Equals(element) &&
+                        list_type.list_size() ==
+                            VectorElements(data_type, dim);
+            }
+            break;
+        }
+        default: {
+            auto expected = ScalarArrowType(data_type);
+            valid = expected != nullptr && type->Equals(expected);
+            break;
+        }
+    }
+    if (!valid) {
+        PanicInfo(DataTypeInvalid,
+                  "the column {} of type {} mismatches the field of type {}",
+                  field_meta.get_name().get(),
+                  type->ToString(),
+                  data_type);
+    }
+}
+
+// the lists of the elements are copied at once, the lengths of the lists
+// are checked only if they may vary
+void
+FillVectors(const FieldMeta& field_meta,
+            const std::shared_ptr<arrow::Array>& array,
+            const FieldDataPtr& field_data) {
+    if (array->type_id() == arrow::Type::FIXED_SIZE_BINARY) {
+        field_data->FillFieldData(array);
+        return;
+    }
+    auto data_type = field_meta.get_data_type();
+    auto dim = field_meta.get_dim();
+    auto elements = VectorElements(data_type, dim);
+    std::shared_ptr<arrow::Array> values;
+    int64_t begin;
+    if (array->type_id() == arrow::Type::LIST) {
+        auto list = std::static_pointer_cast<arrow::ListArray>(array);
+        for (int64_t i = 0; i < list->length(); ++i) {
+            AssertInfo(list->value_length(i) == elements,
+                       "the vector of field {} has {} elements, expected {}",
+                       field_meta.get_name().get(),
+                       list->value_length(i),
+                       elements);
+        }
+        values = list->values();
+        begin = list->value_offset(0);
+    } else {
+        auto list = std::static_pointer_cast<arrow::FixedSizeListArray>(array);
+        values = list->values();
+        begin = list->value_offset(0);
+    }
+    AssertInfo(values->null_count() == 0,
+               "null elements of the vectors of field {} are not supported",
+               field_meta.get_name().get());
+    auto element_bytes = datatype_sizeof(data_type, dim) / elements;
+    auto src = values->data()->buffers[1]->data() +
+               (values->offset() + begin) * element_bytes;
+    field_data->FillFieldData(src, array->length());
+}
+
+template <typename ArrowArray, typename Add>
+void
+AddElements(const arrow::Array& values,
+            int64_t begin,
+            int64_t end,
+            Add&& add) {
+    auto& typed = static_cast<const ArrowArray&>(values);
+    for (int64_t i = begin; i < end; ++i) {
+        add(typed.Value(i));
+    }
+}
+
+void
+FillArrays(const FieldMeta& field_meta,
+           const std::shared_ptr<arrow::Array>& array,
+           const FieldDataPtr& field_data) {
+    auto list = std::static_pointer_cast<arrow::ListArray>(array);
+    auto& values = *list->values();
+    AssertInfo(values.null_count() == 0,
+               "null elements of the arrays of field {} are not supported",
+               field_meta.get_name().get());
+    std::vector<Array> rows(list->length());
+    for (int64_t i = 0; i < list->length(); ++i) {
+        auto begin = list->value_offset(i);
+        auto end = begin + list->value_length(i);
+        ScalarArray row;
+        switch (field_meta.get_element_type()) {
+            case DataType::BOOL: {
+                AddElements<arrow::BooleanArray>(
+                    values, begin, end, [&](bool value) {
+                        row.mutable_bool_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::INT8: {
+                AddElements<arrow::Int8Array>(
+                    values, begin, end, [&](int8_t value) {
+                        row.mutable_int_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::INT16: {
+                AddElements<arrow::Int16Array>(
+                    values, begin, end, [&](int16_t value) {
+                        row.mutable_int_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::INT32: {
+                AddElements<arrow::Int32Array>(
+                    values, begin, end, [&](int32_t value) {
+                        row.mutable_int_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::INT64: {
+                AddElements<arrow::Int64Array>(
+                    values, begin, end, [&](int64_t value) {
+                        row.mutable_long_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::FLOAT: {
+                AddElements<arrow::FloatArray>(
+                    values, begin, end, [&](float value) {
+                        row.mutable_float_data()->add_data(value);
+                    });
+                break;
+            }
+            case DataType::DOUBLE: {
+                AddElements<arrow::DoubleArray>(
+                    values, begin, end, [&](double value) {
+                        row.mutable_double_data()->add_data(value);
+                    });
+                break;
+            }
+            default: {
+                auto& strings = static_cast<const arrow::StringArray&>(values);
+                for (auto j = begin; j < end; ++j) {
+                    row.mutable_string_data()->add_data(strings.GetString(j));
+                }
+                break;
+            }
+        }
+        rows[i] = Array(row);
+    }
+    field_data->FillFieldData(rows.data(), rows.size());
+}
+
+// the field data of the slices of a column, validated by ValidateColumn
+FieldDataPtr
+ToFieldData(const FieldMeta& field_meta,
+            const std::vector<std::shared_ptr<arrow::Array>>& arrays,
+            int64_t num_rows) {
+    auto data_type = field_meta.get_data_type();
+    auto dim = field_meta.is_vector() ? field_meta.get_dim() : 1;
+    auto field_data = storage::CreateFieldData(data_type, dim, num_rows);
+    for (auto& array : arrays) {
+        AssertInfo(array->null_count() == 0,
+                   "null values of field {} are not supported",
+                   field_meta.get_name().get());
+        switch (data_type) {
+            case DataType::STRING:
+            case DataType::VARCHAR: {
+                auto& strings = static_cast<const arrow::StringArray&>(*array);
+                auto max_len = field_meta.get_max_len();
+                for (int64_t i = 0; i < strings.length(); ++i) {
+                    AssertInfo(strings.value_length(i) <= max_len,
+                               "the string of field {} is longer than {}",
+                               field_meta.get_name().get(),
+                               max_len);
+                }
+                field_data->FillFieldData(array);
+                break;
+            }
+            case DataType::JSON: {
+                auto binary = array;
+                if (array->type_id() == arrow::Type::STRING) {
+                    binary = array->View(arrow::binary()).ValueOrDie();
+                }
+                field_data->FillFieldData(binary);
+                break;
+            }
+            case DataType::ARRAY: {
+                FillArrays(field_meta, array, field_data);
+                break;
+            }
+            case DataType::VECTOR_FLOAT:
+            case DataType::VECTOR_FLOAT16:
+            case DataType::VECTOR_BINARY: {
+                FillVectors(field_meta, array, field_data);
+                break;
+            }
+            default: {
+                field_data->FillFieldData(array);
+                break;
+            }
+        }
+    }
+    AssertInfo(field_data->IsFull(), "field data hasn't been filled done");
+    return field_data;
+}
+
+std::string
+WriteBinlog(storage::ChunkManager* chunk_manager,
+            storage::FieldDataMeta field_data_meta,
+            FieldId field_id,
+            const std::string& key,
+            const FieldDataPtr& field_data) {
+    storage::InsertData insert_data(field_data);
+    field_data_meta.field_id = field_id.get();
+    insert_data.SetFieldDataMeta(field_data_meta);
+    auto serialized = insert_data.serialize_to_remote_file();
+    chunk_manager->Write(key, serialized.data(), serialized.size());
+    return key;
+}
+
+}  // namespace
+
+std::vector<ImportedSegment>
+ImportParquet(storage::ChunkManager* chunk_manager,
+              const std::string& source_file,
+              const Schema& schema,
+              const ImportInfo& info) {
+    AssertInfo(info.max_rows_per_segment > 0,
+               "max rows per segment should be positive, but {}",
+               info.max_rows_per_segment);
+
+    auto pool = arrow::default_memory_pool();
+    auto reader_properties = parquet::ReaderProperties(pool);
+    auto arrow_reader_props = parquet::ArrowReaderProperties();
+    arrow_reader_props.set_batch_size(64 * 1024);
+    // the column chunks of a row group are fetched by coalesced ranges
+    arrow_reader_props.set_pre_buffer(true);
+
+    parquet::arrow::FileReaderBuilder reader_builder;
+    auto st = reader_builder.Open(
+        std::make_shared<ChunkManagerInputFile>(chunk_manager, source_file),
+        reader_properties);
+    AssertInfo(st.ok(),
+               "failed to open parquet file {}: {}",
+               source_file,
+               st.ToString());
+    reader_builder.memory_pool(pool);
+    reader_builder.properties(arrow_reader_props);
+    std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+    st = reader_builder.Build(&arrow_reader);
+    AssertInfo(st.ok(), "build file reader: {}", st.ToString());
+
+    // the fields of the schema and the columns of them, the row ids and the
+    // timestamps are generated
+    std::shared_ptr<arrow::Schema> arrow_schema;
+    st = arrow_reader->GetSchema(&arrow_schema);
+    AssertInfo(st.ok(), "get the schema of {}", source_file);
+    std::vector<std::pair<FieldMeta, int>> columns;
+    for (auto field_id : schema.get_field_ids()) {
+        if (field_id.get() < START_USER_FIELDID) {
+            continue;
+        }
+        auto& field_meta = schema.get_fields().at(field_id);
+        auto& name = field_meta.get_name().get();
+        auto index = arrow_schema->GetFieldIndex(name);
+        AssertInfo(index >= 0,
+                   "field {} not found in {}, or found more than once",
+                   name,
+                   source_file);
+        ValidateColumn(field_meta, arrow_schema->field(index)->type());
+        columns.emplace_back(field_meta, index);
+    }
+    AssertInfo(columns.size() == size_t(arrow_schema->num_fields()),
+               "{} has {} columns, but the schema has {} fields",
+               source_file,
+               arrow_schema->num_fields(),
+               columns.size());
+
+    std::shared_ptr<arrow::RecordBatchReader> batches;
+    st = arrow_reader->GetRecordBatchReader(&batches);
+    AssertInfo(st.ok(), "get record batch reader: {}", st.ToString());
+
+    std::vector<ImportedSegment> segments;
+    std::vector<std::vector<std::shared_ptr<arrow::Array>>> buffered(
+        columns.size());
+    int64_t buffered_rows = 0;
+    int64_t imported_rows = 0;
+    std::vector<std::pair<FieldId, std::future<std::string>>> writes;
+    auto& thread_pool =
+        ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+
+    // wait for all the binlogs of the last segment, then rethrow the first
+    // error of them
+    auto wait_writes = [&]() {
+        std::exception_ptr error;
+        for (auto& [field_id, future] : writes) {
+            try {
+                segments.back().field_binlogs[field_id].push_back(
+                    future.get());
+            } catch (...) {
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        writes.clear();
+        storage::ReleaseArrowUnused();
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    };
+
+    // the buffered rows are converted and written on the thread pool, while
+    // the rows of the next segment are read
+    auto write_segment = [&]() {
+        wait_writes();
+        auto& segment = segments.emplace_back();
+        segment.segment_id =
+            info.field_data_meta.segment_id + int64_t(segments.size()) - 1;
+        segment.num_rows = buffered_rows;
+        auto field_data_meta = info.field_data_meta;
+        field_data_meta.segment_id = segment.segment_id;
+        auto prefix = info.output_prefix + "/" +
+                      std::to_string(segment.segment_id) + "/";
+        auto num_rows = buffered_rows;
+        auto row_id_begin = info.row_id_begin + imported_rows;
+        auto timestamp = static_cast<int64_t>(info.timestamp);
+        auto submit = [&](FieldId field_id, auto&& get_field_data) {
+            auto key = prefix + std::to_string(field_id.get());
+            writes.emplace_back(
+                field_id,
+                thread_pool.Submit(
+                    [=, get_field_data = std::move(get_field_data)]() {
+                        return WriteBinlog(chunk_manager,
+                                           field_data_meta,
+                                           field_id,
+                                           key,
+                                           get_field_data());
+                    }));
+        };
+        submit(RowFieldID, [=]() {
+            std::vector<int64_t> row_ids(num_rows);
+            std::iota(row_ids.begin(), row_ids.end(), row_id_begin);
+            auto field_data =
+                storage::CreateFieldData(DataType::INT64, 1, num_rows);
+            field_data->FillFieldData(row_ids.data(), num_rows);
+            return field_data;
+        });
+        submit(TimestampFieldID, [=]() {
+            std::vector<int64_t> timestamps(num_rows, timestamp);
+            auto field_data =
+                storage::CreateFieldData(DataType::INT64, 1, num_rows);
+            field_data->FillFieldData(timestamps.data(), num_rows);
+            return field_data;
+        });
+        for (size_t i = 0; i < columns.size(); ++i) {
+            auto& field_meta = columns[i].first;
+            submit(field_meta.get_id(),
+                   [=, arrays = std::move(buffered[i])]() {
+                       return ToFieldData(field_meta, arrays, num_rows);
+                   });
+            buffered[i].clear();
+        }
+        imported_rows += buffered_rows;
+        buffered_rows = 0;
+    };
+
+    try {
+        for (arrow::Result<std::shared_ptr<arrow::RecordBatch>> maybe_batch :
+             *batches) {
+            AssertInfo(maybe_batch.ok(),
+                       "read the batch of {}: {}",
+                       source_file,
+                       maybe_batch.status().ToString());
+            auto batch = maybe_batch.ValueOrDie();
+            int64_t offset = 0;
+            while (offset < batch->num_rows()) {
+                auto rows = std::min(batch->num_rows() - offset,
+                                     info.max_rows_per_segment - buffered_rows);
+                for (size_t i = 0; i < columns.size(); ++i) {
+                    buffered[i].push_back(
+                        batch->column(columns[i].second)->Slice(offset, rows));
+                }
+                offset += rows;
+                buffered_rows += rows;
+                if (buffered_rows == info.max_rows_per_segment) {
+                    write_segment();
+                }
+            }
+        }
+        if (buffered_rows > 0) {
+            write_segment();
+        }
+        if (!segments.empty()) {
+            wait_writes();
+        }
+    } catch (...) {
+        // the writes reference the chunk manager, wait for them before
+        // unwinding
+        for (auto& write : writes) {
+            if (write.second.valid()) {
+                write.second.wait();
+            }
+        }
+        throw;
+    }
+    return segments;
+}
+
+}  // namespace milvus::segcore
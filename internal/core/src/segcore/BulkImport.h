@@ -0,0 +1,60 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/Schema.h"
+#include "common/Types.h"
+#include "storage/ChunkManager.h"
+#include "storage/Types.h"
+
+namespace milvus::segcore {
+
+struct ImportInfo {
+    // the ids of the first output segment, the next segments have the
+    // consecutive segment ids, as they are allocated together
+    storage::FieldDataMeta field_data_meta;
+    // the binlogs are written to {output_prefix}/{segment_id}/{field_id}
+    std::string output_prefix;
+    int64_t max_rows_per_segment;
+    // the row ids of the imported rows are consecutive from it
+    int64_t row_id_begin = 0;
+    Timestamp timestamp = 0;
+};
+
+struct ImportedSegment {
+    int64_t segment_id;
+    int64_t num_rows = 0;
+    // the binlogs of every field, including the row id and the timestamp
+    // fields
+    std::map<FieldId, std::vector<std::string>> field_binlogs;
+};
+
+// Import the rows of a parquet file into the binlogs of sealed segments,
+// column by column without converting them to rows. The columns are
+// matched to the fields of the schema by name and their types validated
+// against them before anything is written, the values as they are
+// converted. The vectors may be lists of their elements or fixed size
+// binaries. The record batches are read in the order of the
+// file and split into segments of max_rows_per_segment rows, the binlogs of
+// a segment are encoded and written on the thread pool, one task per
+// column, while the batches of the next segment are read.
+std::vector<ImportedSegment>
+ImportParquet(storage::ChunkManager* chunk_manager,
+              const std::string& source_file,
+              const Schema& schema,
+              const ImportInfo& info);
+
+}  // namespace milvus::segcore
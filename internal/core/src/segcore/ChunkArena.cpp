@@ -0,0 +1,156 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/ChunkArena.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "common/EasyAssert.h"
+#include "common/File.h"
+
+namespace milvus::segcore {
+
+ChunkArena::ChunkArena(bool huge_page) : huge_page_(huge_page) {
+}
+
+ChunkArena::~ChunkArena() {
+    for (auto slab : slabs_) {
+        munmap(slab, SLAB_SIZE);
+    }
+    for (auto& [ptr, chunk] : large_chunks_) {
+        munmap(ptr, chunk.map_size);
+    }
+    total_resident_byte_size_ -= byte_size_ - spilled_byte_size_;
+}
+
+void*
+ChunkArena::Allocate(size_t size) {
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    std::lock_guard lck(mutex_);
+    if (size > MAX_SLAB_CHUNK_SIZE) {
+        auto map_size = MapSize(size);
+        auto ptr = Map(map_size);
+        large_chunks_.emplace(ptr, LargeChunk{map_size, false});
+        return ptr;
+    }
+    // the rest of the last slab is wasted if the chunk doesn't fit into it,
+    // which is at most MAX_SLAB_CHUNK_SIZE
+    if (slab_offset_ + size > SLAB_SIZE) {
+        slabs_.push_back(static_cast<char*>(Map(SLAB_SIZE)));
+        slab_offset_ = 0;
+    }
+    auto ptr = slabs_.back() + slab_offset_;
+    slab_offset_ += size;
+    return ptr;
+}
+
+void
+ChunkArena::Deallocate(void* ptr, size_t size) {
+    std::lock_guard lck(mutex_);
+    auto iter = large_chunks_.find(ptr);
+    // the chunks in the slabs are freed with the arena
+    if (iter == large_chunks_.end()) {
+        return;
+    }
+    auto& chunk = iter->second;
+    munmap(iter->first, chunk.map_size);
+    byte_size_ -= chunk.map_size;
+    if (chunk.spilled) {
+        spilled_byte_size_ -= chunk.map_size;
+    } else {
+        total_resident_byte_size_ -= chunk.map_size;
+    }
+    large_chunks_.erase(iter);
+}
+
+int64_t
+ChunkArena::Spill(const void* ptr, const std::string& filepath) {
+    std::lock_guard lck(mutex_);
+    auto iter = large_chunks_.find(const_cast<void*>(ptr));
+    if (iter == large_chunks_.end() || iter->second.spilled) {
+        return 0;
+    }
+    auto& chunk = iter->second;
+    auto file = File::Open(filepath, O_CREAT | O_TRUNC | O_RDWR);
+    auto written = file.WriteAt(iter->first, chunk.map_size, 0);
+    AssertInfo(written == chunk.map_size,
+               "failed to spill chunk to {}, written {} of {} bytes, err: {}",
+               filepath,
+               written,
+               chunk.map_size,
+               strerror(errno));
+    // the file replaces the anon map in place, the chunk is not written
+    // anymore so the readers see the same data through either map
+    auto mapped = mmap(iter->first,
+                       chunk.map_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED,
+                       file.Descriptor(),
+                       0);
+    AssertInfo(mapped == iter->first,
+               "failed to map spilled chunk file {}, err: {}",
+               filepath,
+               strerror(errno));
+    // the map holds the file until the chunk is freed
+    unlink(filepath.c_str());
+    chunk.spilled = true;
+    spilled_byte_size_ += chunk.map_size;
+    total_resident_byte_size_ -= chunk.map_size;
+    return chunk.map_size;
+}
+
+int64_t
+ChunkArena::ByteSize() const {
+    std::lock_guard lck(mutex_);
+    return byte_size_;
+}
+
+int64_t
+ChunkArena::ResidentByteSize() const {
+    std::lock_guard lck(mutex_);
+    return byte_size_ - spilled_byte_size_;
+}
+
+void*
+ChunkArena::Map(size_t size) {
+    auto ptr = mmap(nullptr,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANON,
+                    -1,
+                    0);
+    AssertInfo(ptr != MAP_FAILED,
+               "failed to create anon map of {} bytes for chunks, err: {}",
+               size,
+               strerror(errno));
+    if (huge_page_) {
+        // best effort, the map falls back to the normal pages
+        madvise(ptr, size, MADV_HUGEPAGE);
+    }
+    byte_size_ += size;
+    total_resident_byte_size_ += size;
+    return ptr;
+}
+
+size_t
+ChunkArena::MapSize(size_t size) const {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    // the huge pages only back the whole huge pages of the map
+    auto unit = huge_page_ && size >= SLAB_SIZE ? SLAB_SIZE : page_size;
+    return (size + unit - 1) / unit * unit;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,169 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus::segcore {
+
+// ChunkArena holds the chunks of the columns of a growing segment in anon
+// maps of its own instead of the global heap, so the chunks allocated at the
+// varying rates of thousands of growing segments don't fragment the arenas of
+// the allocator, and the memory is returned to the system in bulk once the
+// segment is dropped.
+//
+// The small chunks are carved from the slabs one after another and freed only
+// with the arena, the large ones get maps of their own, which are unmapped once
+// the chunks are freed, like the vectors removed after the interim index is
+// built. The maps are backed by transparent huge pages if huge_page.
+//
+// A large chunk no longer written can be spilled to a file, the file is mapped
+// over the chunk at the same address, so the pointers to the chunk stay valid
+// and the pages of the chunk are written back and evicted by the page cache
+// under memory pressure.
+class ChunkArena {
+ public:
+    explicit ChunkArena(bool huge_page = false);
+
+    ChunkArena(const ChunkArena&) = delete;
+    ChunkArena&
+    operator=(const ChunkArena&) = delete;
+
+    ~ChunkArena();
+
+    // the memory is aligned to ALIGNMENT
+    void*
+    Allocate(size_t size);
+
+    void
+    Deallocate(void* ptr, size_t size);
+
+    // spill the large chunk to the file, which is unlinked once mapped, and
+    // return the bytes spilled. The chunks in the slabs and the spilled
+    // chunks are not spilled, 0 is returned for them
+    int64_t
+    Spill(const void* ptr, const std::string& filepath);
+
+    // the bytes mapped by the arena
+    int64_t
+    ByteSize() const;
+
+    // the bytes mapped by the arena and not spilled
+    int64_t
+    ResidentByteSize() const;
+
+    // the bytes mapped and not spilled by all the arenas
+    static int64_t
+    TotalResidentByteSize() {
+        return total_resident_byte_size_.load(std::memory_order_relaxed);
+    }
+
+ public:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t SLAB_SIZE = 2 * 1024 * 1024;
+    // the chunks larger than this get maps of their own
+    static constexpr size_t MAX_SLAB_CHUNK_SIZE = SLAB_SIZE / 4;
+
+ private:
+    void*
+    Map(size_t size);
+
+    size_t
+    MapSize(size_t size) const;
+
+ private:
+    const bool huge_page_;
+    mutable std::mutex mutex_;
+    std::vector<char*> slabs_;
+    // the free bytes of the last slab begin here
+    size_t slab_offset_ = SLAB_SIZE;
+    struct LargeChunk {
+        size_t map_size;
+        bool spilled;
+    };
+    std::unordered_map<void*, LargeChunk> large_chunks_;
+    int64_t byte_size_ = 0;
+    int64_t spilled_byte_size_ = 0;
+
+    inline static std::atomic<int64_t> total_resident_byte_size_ = 0;
+};
+
+using ChunkArenaPtr = std::shared_ptr<ChunkArena>;
+
+// ChunkAllocator allocates from the arena, or from the heap if there is no
+// arena like the chunks of the sealed segments. The allocator holds the arena,
+// which so outlives all the chunks allocated from it.
+template <typename T>
+class ChunkAllocator {
+ public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ChunkAllocator() = default;
+
+    explicit ChunkAllocator(ChunkArenaPtr arena) : arena_(std::move(arena)) {
+    }
+
+    template <typename U>
+    ChunkAllocator(const ChunkAllocator<U>& other)  // NOLINT
+        : arena_(other.arena()) {
+    }
+
+    T*
+    allocate(size_t n) {
+        if (arena_ == nullptr) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T* ptr, size_t n) {
+        if (arena_ == nullptr) {
+            std::allocator<T>().deallocate(ptr, n);
+            return;
+        }
+        arena_->Deallocate(ptr, n * sizeof(T));
+    }
+
+    const ChunkArenaPtr&
+    arena() const {
+        return arena_;
+    }
+
+    template <typename U>
+    bool
+    operator==(const ChunkAllocator<U>& other) const {
+        return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool
+    operator!=(const ChunkAllocator<U>& other) const {
+        return arena_ != other.arena();
+    }
+
+ private:
+    ChunkArenaPtr arena_;
+};
+
+}  // namespace milvus::segcore
@@ -15,6 +15,7 @@
 
 #include "pb/schema.pb.h"
 #include "segcore/Collection.h"
+#include "segcore/SegcoreConfig.h"
 #include "log/Log.h"
 
 namespace milvus::segcore {
@@ -23,6 +24,7 @@ Collection::Collection(const milvus::proto::schema::CollectionSchema* schema) {
     Assert(schema != nullptr);
     collection_name_ = schema->name();
     schema_ = Schema::ParseFrom(*schema);
+    CreatePlanCache();
 }
 
 Collection::Collection(const std::string_view schema_proto) {
@@ -34,6 +36,7 @@ Collection::Collection(const std::string_view schema_proto) {
     }
     collection_name_ = collection_schema.name();
     schema_ = Schema::ParseFrom(collection_schema);
+    CreatePlanCache();
 }
 
 Collection::Collection(const void* schema_proto, const int64_t length) {
@@ -46,6 +49,13 @@ Collection::Collection(const void* schema_proto, const int64_t length) {
 
     collection_name_ = collection_schema.name();
     schema_ = Schema::ParseFrom(collection_schema);
+    CreatePlanCache();
+}
+
+void
+Collection::CreatePlanCache() {
+    plan_cache_ = std::make_unique<query::PlanCache>(
+        *schema_, SegcoreConfig::default_config().get_plan_cache_size());
 }
 
 void
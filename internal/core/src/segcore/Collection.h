@@ -16,6 +16,7 @@
 
 #include "common/Schema.h"
 #include "common/IndexMeta.h"
+#include "query/PlanCache.h"
 
 namespace milvus::segcore {
 
@@ -44,10 +45,21 @@ class Collection {
         return collection_name_;
     }
 
+    // the plans are created through the cache of the collection
+    query::PlanCache&
+    GetPlanCache() {
+        return *plan_cache_;
+    }
+
+ private:
+    void
+    CreatePlanCache();
+
  private:
     std::string collection_name_;
     SchemaPtr schema_;
     IndexMetaPtr index_meta_;
+    query::PlanCachePtr plan_cache_;
 };
 
 using CollectionPtr = std::unique_ptr<Collection>;
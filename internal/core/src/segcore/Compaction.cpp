@@ -0,0 +1,330 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/Compaction.h"
+
+#include <algorithm>
+#include <future>
+#include <queue>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "common/FieldMeta.h"
+#include "storage/InsertData.h"
+#include "storage/ThreadPools.h"
+#include "storage/Util.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// a row of an input segment
+struct RowRef {
+    int32_t segment;
+    int64_t offset;
+};
+
+// the decoded binlogs of a field of a segment, addressed by the offsets in
+// the segment
+class SegmentFieldData {
+ public:
+    explicit SegmentFieldData(std::vector<FieldDataPtr> chunks)
+        : chunks_(std::move(chunks)) {
+        starts_.push_back(0);
+        for (auto& chunk : chunks_) {
+            starts_.push_back(starts_.back() + chunk->Length());
+        }
+    }
+
+    int64_t
+    num_rows() const {
+        return starts_.back();
+    }
+
+    const std::vector<FieldDataPtr>&
+    chunks() const {
+        return chunks_;
+    }
+
+    // the chunk of the offset, the offset in it and the end of the chunk
+    std::tuple<size_t, int64_t, int64_t>
+    locate(int64_t offset) const {
+        size_t chunk =
+            std::upper_bound(starts_.begin(), starts_.end(), offset) -
+            starts_.begin() - 1;
+        return {chunk, offset - starts_[chunk], starts_[chunk + 1]};
+    }
+
+ private:
+    std::vector<FieldDataPtr> chunks_;
+    std::vector<int64_t> starts_;
+};
+
+std::vector<SegmentFieldData>
+LoadField(storage::ChunkManager* chunk_manager,
+          const std::vector<CompactionSegment>& segments,
+          FieldId field_id) {
+    std::vector<SegmentFieldData> datas;
+    datas.reserve(segments.size());
+    for (auto& segment : segments) {
+        auto iter = segment.field_binlogs.find(field_id);
+        AssertInfo(iter != segment.field_binlogs.end(),
+                   "no binlog of field {} in the compacted segment",
+                   field_id.get());
+        datas.emplace_back(
+            storage::GetObjectData(chunk_manager, iter->second));
+    }
+    return datas;
+}
+
+// the live rows of the segments sorted by pk, the pks of a segment are
+// sorted only if they aren't already
+template <typename Pk>
+std::vector<RowRef>
+MergeByPk(const std::vector<std::vector<Pk>>& pks,
+          std::vector<std::vector<int64_t>>& live_offsets) {
+    size_t num_rows = 0;
+    for (size_t i = 0; i < pks.size(); ++i) {
+        auto& offsets = live_offsets[i];
+        auto& segment_pks = pks[i];
+        auto less = [&](int64_t a, int64_t b) {
+            return segment_pks[a] < segment_pks[b];
+        };
+        if (!std::is_sorted(offsets.begin(), offsets.end(), less)) {
+            std::stable_sort(offsets.begin(), offsets.end(), less);
+        }
+        num_rows += offsets.size();
+    }
+
+    // the heads of the segments, the ties are broken by the segment order
+    using Head = std::pair<int32_t, size_t>;
+    auto greater = [&](const Head& a, const Head& b) {
+        auto& pk_a = pks[a.first][live_offsets[a.first][a.second]];
+        auto& pk_b = pks[b.first][live_offsets[b.first][b.second]];
+        if (pk_a != pk_b) {
+            return pk_b < pk_a;
+        }
+        return a.first > b.first;
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(greater)> heads(
+        greater);
+    for (size_t i = 0; i < live_offsets.size(); ++i) {
+        if (!live_offsets[i].empty()) {
+            heads.emplace(i, 0);
+        }
+    }
+
+    std::vector<RowRef> order;
+    order.reserve(num_rows);
+    while (!heads.empty()) {
+        auto [segment, pos] = heads.top();
+        heads.pop();
+        order.push_back({segment, live_offsets[segment][pos]});
+        if (pos + 1 < live_offsets[segment].size()) {
+            heads.emplace(segment, pos + 1);
+        }
+    }
+    return order;
+}
+
+// the order of the output rows, decided by the pk field of the segments
+std::vector<RowRef>
+OrderRows(const std::vector<SegmentFieldData>& pk_datas,
+          const std::vector<CompactionSegment>& segments,
+          bool sort_by_pk) {
+    std::vector<std::vector<int64_t>> live_offsets(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        auto num_rows = pk_datas[i].num_rows();
+        auto& deleted = segments[i].deleted;
+        AssertInfo(deleted.empty() || deleted.size() == size_t(num_rows),
+                   "the deleted rows of size {} mismatch the {} rows",
+                   deleted.size(),
+                   num_rows);
+        for (int64_t offset = 0; offset < num_rows; ++offset) {
+            if (deleted.empty() || !deleted[offset]) {
+                live_offsets[i].push_back(offset);
+            }
+        }
+    }
+
+    if (!sort_by_pk) {
+        std::vector<RowRef> order;
+        for (size_t i = 0; i < live_offsets.size(); ++i) {
+            for (auto offset : live_offsets[i]) {
+                order.push_back({static_cast<int32_t>(i), offset});
+            }
+        }
+        return order;
+    }
+
+    DataType pk_type = DataType::NONE;
+    for (auto& data : pk_datas) {
+        if (!data.chunks().empty()) {
+            pk_type = data.chunks()[0]->get_data_type();
+        }
+    }
+    if (pk_type == DataType::VARCHAR) {
+        // the views of the pks, alive as long as the pk datas
+        std::vector<std::vector<std::string_view>> pks(pk_datas.size());
+        for (size_t i = 0; i < pk_datas.size(); ++i) {
+            pks[i].reserve(pk_datas[i].num_rows());
+            for (auto& chunk : pk_datas[i].chunks()) {
+                for (size_t j = 0; j < chunk->Length(); ++j) {
+                    pks[i].emplace_back(*static_cast<const std::string*>(
+                        chunk->RawValue(j)));
+                }
+            }
+        }
+        return MergeByPk(pks, live_offsets);
+    }
+    AssertInfo(pk_type == DataType::INT64 || pk_type == DataType::NONE,
+               "unsupported pk type {}",
+               pk_type);
+    std::vector<std::vector<int64_t>> pks(pk_datas.size());
+    for (size_t i = 0; i < pk_datas.size(); ++i) {
+        pks[i].reserve(pk_datas[i].num_rows());
+        for (auto& chunk : pk_datas[i].chunks()) {
+            auto data = static_cast<const int64_t*>(chunk->Data());
+            pks[i].insert(pks[i].end(), data, data + chunk->Length());
+        }
+    }
+    return MergeByPk(pks, live_offsets);
+}
+
+// copy the rows [begin, end) of the order into one field data, a run of
+// consecutive rows of a chunk is copied at once
+FieldDataPtr
+GatherRows(const std::vector<SegmentFieldData>& datas,
+           const std::vector<RowRef>& order,
+           size_t begin,
+           size_t end,
+           DataType data_type,
+           int64_t dim) {
+    auto result = storage::CreateFieldData(data_type, dim, end - begin);
+    auto is_variable = datatype_is_variable(data_type);
+    auto row_bytes = is_variable ? 0 : datatype_sizeof(data_type, dim);
+    for (size_t i = begin; i < end;) {
+        auto [segment, offset] = order[i];
+        auto [chunk_id, chunk_offset, chunk_end] =
+            datas[segment].locate(offset);
+        int64_t run = 1;
+        while (i + run < end && order[i + run].segment == segment &&
+               order[i + run].offset == offset + run &&
+               offset + run < chunk_end) {
+            ++run;
+        }
+        auto& chunk = datas[segment].chunks()[chunk_id];
+        if (is_variable) {
+            result->FillFieldData(chunk->RawValue(chunk_offset), run);
+        } else {
+            result->FillFieldData(static_cast<const char*>(chunk->Data()) +
+                                      chunk_offset * row_bytes,
+                                  run);
+        }
+        i += run;
+    }
+    return result;
+}
+
+}  // namespace
+
+CompactionResult
+CompactSegments(storage::ChunkManager* chunk_manager,
+                const std::vector<CompactionSegment>& segments,
+                const CompactionInfo& info) {
+    AssertInfo(!segments.empty(), "no segment to compact");
+    AssertInfo(info.max_rows_per_binlog > 0,
+               "max rows per binlog should be positive, but {}",
+               info.max_rows_per_binlog);
+
+    std::vector<RowRef> order;
+    std::vector<int64_t> segment_rows;
+    {
+        auto pk_datas = LoadField(chunk_manager, segments, info.pk_field_id);
+        for (auto& data : pk_datas) {
+            segment_rows.push_back(data.num_rows());
+        }
+        order = OrderRows(pk_datas, segments, info.sort_by_pk);
+    }
+
+    CompactionResult result;
+    result.num_rows = order.size();
+    for (size_t begin = 0; begin < order.size();
+         begin += info.max_rows_per_binlog) {
+        result.binlog_rows.push_back(std::min<int64_t>(
+            info.max_rows_per_binlog, order.size() - begin));
+    }
+    if (order.empty()) {
+        return result;
+    }
+
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+    for (auto& field_binlogs : segments[0].field_binlogs) {
+        auto field_id = field_binlogs.first;
+        auto datas = LoadField(chunk_manager, segments, field_id);
+        DataType data_type = DataType::NONE;
+        int64_t dim = 1;
+        for (size_t i = 0; i < datas.size(); ++i) {
+            AssertInfo(datas[i].num_rows() == segment_rows[i],
+                       "field {} has {} rows, but the pk has {}",
+                       field_id.get(),
+                       datas[i].num_rows(),
+                       segment_rows[i]);
+            if (!datas[i].chunks().empty()) {
+                data_type = datas[i].chunks()[0]->get_data_type();
+                dim = datas[i].chunks()[0]->get_dim();
+            }
+        }
+
+        auto write_binlog = [&, field_id](size_t index) {
+            auto begin = index * info.max_rows_per_binlog;
+            auto end =
+                std::min(order.size(), begin + info.max_rows_per_binlog);
+            auto field_data =
+                GatherRows(datas, order, begin, end, data_type, dim);
+            storage::InsertData insert_data(field_data);
+            auto field_data_meta = info.field_data_meta;
+            field_data_meta.field_id = field_id.get();
+            insert_data.SetFieldDataMeta(field_data_meta);
+            auto serialized = insert_data.serialize_to_remote_file();
+            auto key = info.output_prefix + "/" +
+                       std::to_string(field_id.get()) + "/" +
+                       std::to_string(index);
+            chunk_manager->Write(key, serialized.data(), serialized.size());
+            return key;
+        };
+        std::vector<std::future<std::string>> futures;
+        auto& binlogs = result.field_binlogs[field_id];
+        try {
+            for (size_t i = 0; i < result.binlog_rows.size(); ++i) {
+                futures.push_back(pool.Submit(write_binlog, i));
+            }
+            for (auto& future : futures) {
+                binlogs.push_back(future.get());
+            }
+        } catch (...) {
+            // the tasks reference the field datas, wait for them before
+            // unwinding
+            for (auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
+        }
+        storage::ReleaseArrowUnused();
+    }
+    return result;
+}
+
+}  // namespace milvus::segcore
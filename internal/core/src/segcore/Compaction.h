@@ -0,0 +1,62 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/Types.h"
+#include "storage/ChunkManager.h"
+#include "storage/Types.h"
+
+namespace milvus::segcore {
+
+struct CompactionSegment {
+    // the binlogs of every field, including the row id and the timestamp
+    // fields, each field's hold the rows of the segment in the same order
+    std::map<FieldId, std::vector<std::string>> field_binlogs;
+    // the deleted rows by their offsets in the segment, empty if none
+    BitsetType deleted;
+};
+
+struct CompactionInfo {
+    // the ids of the output segment, the field id is set per field
+    storage::FieldDataMeta field_data_meta;
+    // the binlogs are written to {output_prefix}/{field_id}/{binlog index}
+    std::string output_prefix;
+    int64_t max_rows_per_binlog;
+    FieldId pk_field_id;
+    // sort the rows by pk, in the order of the input segments otherwise
+    bool sort_by_pk = true;
+};
+
+struct CompactionResult {
+    int64_t num_rows = 0;
+    // the rows of each output binlog, the same for every field
+    std::vector<int64_t> binlog_rows;
+    std::map<FieldId, std::vector<std::string>> field_binlogs;
+};
+
+// Merge the live rows of the sealed segments into the binlogs of one
+// segment without decoding the rows one by one. The order of the rows is
+// decided by the pk field alone, merging the rows of the segments sorted by
+// pk, as the ones compacted before already are. The other fields are then
+// copied field by field, by runs of consecutive rows of a segment, each
+// output binlog encoded and written on the thread pool, so only one field
+// of the segments is in memory at a time.
+CompactionResult
+CompactSegments(storage::ChunkManager* chunk_manager,
+                const std::vector<CompactionSegment>& segments,
+                const CompactionInfo& info);
+
+}  // namespace milvus::segcore
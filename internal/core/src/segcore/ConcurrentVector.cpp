@@ -17,6 +17,26 @@
 
 namespace milvus::segcore {
 
+template <typename ArrowArrayType>
+static const ArrowArrayType&
+CastArrowArray(const arrow::Array& array,
+               arrow::Type::type type_id,
+               const FieldMeta& field_meta) {
+    AssertInfo(array.type_id() == type_id,
+               "inconsistent arrow type {} of field {}",
+               array.type()->ToString(),
+               field_meta.get_id().get());
+    return static_cast<const ArrowArrayType&>(array);
+}
+
+template <typename Type>
+static ConcurrentVector<Type>&
+CastConcurrentVector(VectorBase* vec) {
+    auto typed_vec = dynamic_cast<ConcurrentVector<Type>*>(vec);
+    AssertInfo(typed_vec != nullptr, "inconsistent type of concurrent vector");
+    return *typed_vec;
+}
+
 void
 VectorBase::set_data_raw(ssize_t element_offset,
                          ssize_t element_count,
@@ -73,19 +93,17 @@ VectorBase::set_data_raw(ssize_t element_offset,
         }
         case DataType::VARCHAR: {
             auto& field_data = FIELD_DATA(data, string);
-            std::vector<std::string> data_raw(field_data.begin(),
-                                              field_data.end());
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            return CastConcurrentVector<std::string>(this).set_packed_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    return std::string_view(field_data[i]);
+                });
         }
         case DataType::JSON: {
             auto& json_data = FIELD_DATA(data, json);
-            std::vector<Json> data_raw{};
-            data_raw.reserve(json_data.size());
-            for (auto& json_bytes : json_data) {
-                data_raw.emplace_back(simdjson::padded_string(json_bytes));
-            }
-
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            return CastConcurrentVector<Json>(this).set_packed_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    return std::string_view(json_data[i]);
+                });
         }
         case DataType::ARRAY: {
             auto& array_data = FIELD_DATA(data, array);
@@ -105,4 +123,116 @@ VectorBase::set_data_raw(ssize_t element_offset,
     }
 }
 
+void
+VectorBase::set_data_raw(ssize_t element_offset,
+                         const arrow::Array& array,
+                         const FieldMeta& field_meta) {
+    AssertInfo(array.null_count() == 0,
+               "null values of field {} are not supported",
+               field_meta.get_id().get());
+    auto element_count = array.length();
+    switch (field_meta.get_data_type()) {
+        case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_BINARY:
+        case DataType::VECTOR_FLOAT16: {
+            auto& vector_array = CastArrowArray<arrow::FixedSizeBinaryArray>(
+                array, arrow::Type::FIXED_SIZE_BINARY, field_meta);
+            AssertInfo(static_cast<size_t>(vector_array.byte_width()) ==
+                           field_meta.get_sizeof(),
+                       "inconsistent byte width {} of vector field {}",
+                       vector_array.byte_width(),
+                       field_meta.get_id().get());
+            return set_data_raw(
+                element_offset, vector_array.raw_values(), element_count);
+        }
+        case DataType::BOOL: {
+            auto& bool_array = CastArrowArray<arrow::BooleanArray>(
+                array, arrow::Type::BOOL, field_meta);
+            // the arrow booleans are bit packed
+            return CastConcurrentVector<bool>(this).set_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    return bool_array.Value(i);
+                });
+        }
+        case DataType::INT8: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::Int8Array>(
+                                    array, arrow::Type::INT8, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::INT16: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::Int16Array>(
+                                    array, arrow::Type::INT16, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::INT32: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::Int32Array>(
+                                    array, arrow::Type::INT32, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::INT64: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::Int64Array>(
+                                    array, arrow::Type::INT64, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::FLOAT: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::FloatArray>(
+                                    array, arrow::Type::FLOAT, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::DOUBLE: {
+            return set_data_raw(element_offset,
+                                CastArrowArray<arrow::DoubleArray>(
+                                    array, arrow::Type::DOUBLE, field_meta)
+                                    .raw_values(),
+                                element_count);
+        }
+        case DataType::VARCHAR: {
+            auto& string_array = CastArrowArray<arrow::StringArray>(
+                array, arrow::Type::STRING, field_meta);
+            return CastConcurrentVector<std::string>(this).set_packed_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    return string_array.GetView(i);
+                });
+        }
+        case DataType::JSON: {
+            auto& json_array = CastArrowArray<arrow::BinaryArray>(
+                array, arrow::Type::BINARY, field_meta);
+            return CastConcurrentVector<Json>(this).set_packed_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    return json_array.GetView(i);
+                });
+        }
+        case DataType::ARRAY: {
+            // the arrays are the serialized ScalarArrays
+            auto& array_array = CastArrowArray<arrow::BinaryArray>(
+                array, arrow::Type::BINARY, field_meta);
+            ScalarArray scalar_array;
+            return CastConcurrentVector<Array>(this).set_data_by(
+                element_offset, element_count, [&](int64_t i) {
+                    auto view = array_array.GetView(i);
+                    AssertInfo(
+                        scalar_array.ParseFromArray(view.data(), view.size()),
+                        "failed to parse array of field {}",
+                        field_meta.get_id().get());
+                    return Array(scalar_array);
+                });
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported datatype {}",
+                                  field_meta.get_data_type()));
+        }
+    }
+}
+
 }  // namespace milvus::segcore
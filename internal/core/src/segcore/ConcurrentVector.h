@@ -14,9 +14,11 @@
 #include <fmt/core.h>
 #include <tbb/concurrent_vector.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
-#include <deque>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -32,12 +34,28 @@
 #include "common/Span.h"
 #include "common/Types.h"
 #include "common/Utils.h"
+#include "segcore/ChunkArena.h"
+#include "simd/hook.h"
 
 namespace milvus::segcore {
 
+// ThreadSafeVector appends elements under a mutex and reads them without
+// locking. The elements live in buckets of doubling sizes which are never
+// moved, bucket k holds the elements [2^k - 1, 2^(k+1) - 1), so the reference
+// of an element keeps valid until clear().
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() = default;
+
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        clear();
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
@@ -45,27 +63,28 @@ class ThreadSafeVector {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        auto current = size_.load(std::memory_order_relaxed);
+        while (current < size) {
+            auto [bucket, offset] = locate(current);
+            auto elements = buckets_[bucket].load(std::memory_order_relaxed);
+            if (elements == nullptr) {
+                elements = std::allocator<Type>().allocate(bucket_size(bucket));
+                buckets_[bucket].store(elements, std::memory_order_release);
+            }
+            new (elements + offset) Type(args...);
+            // publish the element after it's constructed
+            size_.store(++current, std::memory_order_release);
         }
     }
+
     const Type&
     operator[](int64_t index) const {
-        AssertInfo(index < size_,
-                   fmt::format(
-                       "index out of range, index={}, size_={}", index, size_));
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        return at(index);
     }
 
     Type&
     operator[](int64_t index) {
-        AssertInfo(index < size_,
-                   fmt::format(
-                       "index out of range, index={}, size_={}", index, size_));
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        return at(index);
     }
 
     int64_t
@@ -73,17 +92,54 @@ class ThreadSafeVector {
         return size_;
     }
 
+    // must not run concurrently with the readers
     void
     clear() {
         std::lock_guard lck(mutex_);
+        auto size = size_.load(std::memory_order_relaxed);
         size_ = 0;
-        vec_.clear();
+        for (int64_t index = 0; index < size; index++) {
+            auto [bucket, offset] = locate(index);
+            buckets_[bucket].load(std::memory_order_relaxed)[offset].~Type();
+        }
+        for (size_t bucket = 0; bucket < MAX_BUCKET_NUM; bucket++) {
+            auto elements = buckets_[bucket].load(std::memory_order_relaxed);
+            if (elements != nullptr) {
+                std::allocator<Type>().deallocate(elements,
+                                                  bucket_size(bucket));
+                buckets_[bucket].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    }
+
+ private:
+    static constexpr size_t MAX_BUCKET_NUM = 48;
+
+    static constexpr int64_t
+    bucket_size(size_t bucket) {
+        return int64_t(1) << bucket;
+    }
+
+    static std::pair<size_t, int64_t>
+    locate(int64_t index) {
+        auto bucket = 63 - __builtin_clzll(uint64_t(index) + 1);
+        return {bucket, index + 1 - bucket_size(bucket)};
+    }
+
+    Type&
+    at(int64_t index) const {
+        auto size = size_.load(std::memory_order_acquire);
+        AssertInfo(index < size,
+                   fmt::format(
+                       "index out of range, index={}, size_={}", index, size));
+        auto [bucket, offset] = locate(index);
+        return buckets_[bucket].load(std::memory_order_acquire)[offset];
     }
 
  private:
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::array<std::atomic<Type*>, MAX_BUCKET_NUM> buckets_{};
+    std::mutex mutex_;
 };
 
 class VectorBase {
@@ -111,6 +167,14 @@ class VectorBase {
                  const DataArray* data,
                  const FieldMeta& field_meta);
 
+    // set the rows of the arrow array, the fixed width values are copied from
+    // the buffers of the array in blocks and the bytes of the variable length
+    // values are packed from the views of the array
+    void
+    set_data_raw(ssize_t element_offset,
+                 const arrow::Array& array,
+                 const FieldMeta& field_meta);
+
     virtual void
     fill_chunk_data(const std::vector<FieldDataPtr>& data) = 0;
 
@@ -131,6 +195,17 @@ class VectorBase {
     virtual bool
     empty() = 0;
 
+    // the bytes of the memory held by the chunks
+    virtual int64_t
+    byte_size() const = 0;
+
+    // spill the chunk no longer written to the file, see ChunkArena::Spill,
+    // return the bytes spilled
+    virtual int64_t
+    spill_chunk(ssize_t chunk_id, const std::string& filepath) {
+        return 0;
+    }
+
  protected:
     const int64_t size_per_chunk_;
 };
@@ -139,7 +214,7 @@ template <typename Type, bool is_scalar = false>
 class ConcurrentVectorImpl : public VectorBase {
  public:
     // constants
-    using Chunk = FixedVector<Type>;
+    using Chunk = folly::fbvector<Type, ChunkAllocator<Type>>;
     ConcurrentVectorImpl(ConcurrentVectorImpl&&) = delete;
     ConcurrentVectorImpl(const ConcurrentVectorImpl&) = delete;
 
@@ -158,21 +233,28 @@ class ConcurrentVectorImpl : public VectorBase {
                                               BinaryVector>>>;
 
  public:
-    explicit ConcurrentVectorImpl(ssize_t dim, int64_t size_per_chunk)
-        : VectorBase(size_per_chunk), Dim(is_scalar ? 1 : dim) {
+    // the chunks are allocated from the arena if any
+    explicit ConcurrentVectorImpl(ssize_t dim,
+                                  int64_t size_per_chunk,
+                                  ChunkArenaPtr arena = nullptr)
+        : VectorBase(size_per_chunk),
+          Dim(is_scalar ? 1 : dim),
+          allocator_(std::move(arena)) {
         // Assert(is_scalar ? dim == 1 : dim != 1);
     }
 
     void
     grow_to_at_least(int64_t element_count) override {
         auto chunk_count = upper_div(element_count, size_per_chunk_);
-        chunks_.emplace_to_at_least(chunk_count, Dim * size_per_chunk_);
+        chunks_.emplace_to_at_least(
+            chunk_count, Dim * size_per_chunk_, allocator_);
     }
 
     void
     grow_on_demand(int64_t element_count) {
         auto chunk_count = upper_div(element_count, size_per_chunk_);
-        chunks_.emplace_to_at_least(chunk_count, Dim * element_count);
+        chunks_.emplace_to_at_least(
+            chunk_count, Dim * element_count, allocator_);
     }
 
     Span<TraitType>
@@ -205,7 +287,7 @@ class ConcurrentVectorImpl : public VectorBase {
         for (auto& field_data : datas) {
             element_count += field_data->get_num_rows();
         }
-        chunks_.emplace_to_at_least(1, Dim * element_count);
+        chunks_.emplace_to_at_least(1, Dim * element_count, allocator_);
         int64_t offset = 0;
         for (auto& field_data : datas) {
             auto num_rows = field_data->get_num_rows();
@@ -237,6 +319,32 @@ class ConcurrentVectorImpl : public VectorBase {
             element_offset, static_cast<const Type*>(source), element_count);
     }
 
+    // set the elements to value_of(i) for i in [0, element_count) in place of
+    // the chunks, without staging the values in a buffer
+    template <typename ValueOf>
+    void
+    set_data_by(ssize_t element_offset,
+                ssize_t element_count,
+                ValueOf&& value_of) {
+        static_assert(is_scalar);
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        ssize_t source_offset = 0;
+        while (source_offset < element_count) {
+            auto offset = element_offset + source_offset;
+            auto chunk_offset = offset % size_per_chunk_;
+            auto count = std::min<ssize_t>(size_per_chunk_ - chunk_offset,
+                                           element_count - source_offset);
+            auto ptr = chunks_[offset / size_per_chunk_].data() + chunk_offset;
+            for (ssize_t i = 0; i < count; ++i) {
+                ptr[i] = value_of(source_offset + i);
+            }
+            source_offset += count;
+        }
+    }
+
     void
     set_data(ssize_t element_offset,
              const Type* source,
@@ -321,6 +429,40 @@ class ConcurrentVectorImpl : public VectorBase {
         return true;
     }
 
+    int64_t
+    byte_size() const override {
+        int64_t size = 0;
+        for (ssize_t i = 0; i < num_chunk(); ++i) {
+            auto& chunk = get_chunk(i);
+            size += chunk.capacity() * sizeof(Type);
+            // the heap of the variable length values
+            if constexpr (std::is_same_v<Type, PkType>) {
+                for (auto& value : chunk) {
+                    size += PkHeapByteSize(value);
+                }
+            } else if constexpr (std::is_same_v<Type, Array>) {
+                for (auto& value : chunk) {
+                    size += value.byte_size();
+                }
+            }
+        }
+        return size;
+    }
+
+    int64_t
+    spill_chunk(ssize_t chunk_id, const std::string& filepath) override {
+        // the values with heaps of their own can't be spilled
+        if constexpr (!std::is_trivially_copyable_v<Type>) {
+            return 0;
+        } else {
+            if (allocator_.arena() == nullptr || chunk_id >= num_chunk()) {
+                return 0;
+            }
+            return allocator_.arena()->Spill(get_chunk(chunk_id).data(),
+                                             filepath);
+        }
+    }
+
     void
     clear() {
         chunks_.clear();
@@ -353,16 +495,148 @@ class ConcurrentVectorImpl : public VectorBase {
     const ssize_t Dim;
 
  private:
+    ChunkAllocator<Type> allocator_;
     ThreadSafeVector<Chunk> chunks_;
 };
 
+// VariableLengthConcurrentVector holds the variable length values, the
+// strings and the json, like the VariableColumn of the sealed segments. The
+// bytes of the values set together are packed into a block, and the chunks
+// hold the views of them, so the values are scanned sequentially without a
+// heap object per row. The blocks are never moved once allocated, they are
+// allocated from the arena if any, and freed with the vector.
+template <typename ViewType>
+class VariableLengthConcurrentVector
+    : public ConcurrentVectorImpl<ViewType, true> {
+ public:
+    explicit VariableLengthConcurrentVector(int64_t size_per_chunk,
+                                            ChunkArenaPtr arena = nullptr)
+        : ConcurrentVectorImpl<ViewType, true>::ConcurrentVectorImpl(
+              1, size_per_chunk, arena),
+          block_allocator_(std::move(arena)) {
+    }
+
+    ~VariableLengthConcurrentVector() override {
+        for (auto& [block, size] : blocks_) {
+            block_allocator_.deallocate(block, size);
+        }
+    }
+
+    using ConcurrentVectorImpl<ViewType, true>::set_data_raw;
+
+    // the source is the std::string or Json values
+    void
+    set_data_raw(ssize_t element_offset,
+                 const void* source,
+                 ssize_t element_count) override {
+        if constexpr (std::is_same_v<ViewType, Json>) {
+            auto values = static_cast<const Json*>(source);
+            set_packed_data_by(element_offset, element_count, [&](int64_t i) {
+                return std::string_view(values[i].data());
+            });
+        } else {
+            auto values = static_cast<const std::string*>(source);
+            set_packed_data_by(element_offset, element_count, [&](int64_t i) {
+                return std::string_view(values[i]);
+            });
+        }
+    }
+
+    void
+    fill_chunk_data(const std::vector<FieldDataPtr>& datas) override {
+        AssertInfo(this->num_chunk() == 0, "no empty concurrent vector");
+        set_data_raw(0, datas);
+    }
+
+    // pack the bytes viewed by view_of(i) for i in [0, element_count) into a
+    // block, and set the views of them
+    template <typename ViewOf>
+    void
+    set_packed_data_by(ssize_t element_offset,
+                       ssize_t element_count,
+                       ViewOf&& view_of) {
+        if (element_count == 0) {
+            return;
+        }
+        size_t block_size = 0;
+        for (ssize_t i = 0; i < element_count; ++i) {
+            block_size += view_of(i).size();
+        }
+        // the json is parsed by simdjson, which reads beyond the last value
+        if constexpr (std::is_same_v<ViewType, Json>) {
+            block_size += simdjson::SIMDJSON_PADDING;
+        }
+        auto block = allocate_block(block_size);
+        size_t block_offset = 0;
+        this->set_data_by(element_offset, element_count, [&](int64_t i) {
+            auto view = view_of(i);
+            auto data = block + block_offset;
+            std::copy_n(view.data(), view.size(), data);
+            block_offset += view.size();
+            if constexpr (std::is_same_v<ViewType, Json>) {
+                return Json(data, view.size());
+            } else {
+                return std::string_view(data, view.size());
+            }
+        });
+    }
+
+    int64_t
+    byte_size() const override {
+        int64_t size = 0;
+        for (ssize_t i = 0; i < this->num_chunk(); ++i) {
+            size += this->get_chunk(i).capacity() * sizeof(ViewType);
+        }
+        std::lock_guard lck(mutex_);
+        return size + block_byte_size_;
+    }
+
+ private:
+    char*
+    allocate_block(size_t size) {
+        auto block = block_allocator_.allocate(size);
+        std::lock_guard lck(mutex_);
+        blocks_.emplace_back(block, size);
+        block_byte_size_ += size;
+        return block;
+    }
+
+ private:
+    ChunkAllocator<char> block_allocator_;
+    mutable std::mutex mutex_;
+    std::vector<std::pair<char*, size_t>> blocks_;
+    int64_t block_byte_size_ = 0;
+};
+
 template <typename Type>
 class ConcurrentVector : public ConcurrentVectorImpl<Type, true> {
  public:
     static_assert(IsScalar<Type> || std::is_same_v<Type, PkType>);
-    explicit ConcurrentVector(int64_t size_per_chunk)
+    explicit ConcurrentVector(int64_t size_per_chunk,
+                              ChunkArenaPtr arena = nullptr)
         : ConcurrentVectorImpl<Type, true>::ConcurrentVectorImpl(
-              1, size_per_chunk) {
+              1, size_per_chunk, std::move(arena)) {
+    }
+};
+
+// the chunks of the strings hold the views of them
+template <>
+class ConcurrentVector<std::string>
+    : public VariableLengthConcurrentVector<std::string_view> {
+ public:
+    explicit ConcurrentVector(int64_t size_per_chunk,
+                              ChunkArenaPtr arena = nullptr)
+        : VariableLengthConcurrentVector(size_per_chunk, std::move(arena)) {
+    }
+};
+
+// the chunks of the json hold the json viewing them
+template <>
+class ConcurrentVector<Json> : public VariableLengthConcurrentVector<Json> {
+ public:
+    explicit ConcurrentVector(int64_t size_per_chunk,
+                              ChunkArenaPtr arena = nullptr)
+        : VariableLengthConcurrentVector(size_per_chunk, std::move(arena)) {
     }
 };
 
@@ -370,18 +644,61 @@ template <>
 class ConcurrentVector<FloatVector>
     : public ConcurrentVectorImpl<float, false> {
  public:
-    ConcurrentVector(int64_t dim, int64_t size_per_chunk)
+    ConcurrentVector(int64_t dim,
+                     int64_t size_per_chunk,
+                     ChunkArenaPtr arena = nullptr)
         : ConcurrentVectorImpl<float, false>::ConcurrentVectorImpl(
-              dim, size_per_chunk) {
+              dim, size_per_chunk, std::move(arena)),
+          dim_(dim) {
     }
+
+    // the inverse L2 norms of the rows of the chunk, which must be full so
+    // that its rows don't change anymore, computed at the first call
+    const float*
+    get_chunk_inv_norms(ssize_t chunk_index) const {
+        std::lock_guard lck(inv_norms_mutex_);
+        if (chunk_index >= static_cast<ssize_t>(inv_norms_.size())) {
+            inv_norms_.resize(chunk_index + 1);
+        }
+        auto& inv_norms = inv_norms_[chunk_index];
+        if (inv_norms == nullptr) {
+            auto rows = get_size_per_chunk();
+            inv_norms = std::make_unique<float[]>(rows);
+            simd::inv_norms_float(
+                static_cast<const float*>(get_chunk_data(chunk_index)),
+                rows,
+                dim_,
+                inv_norms.get());
+        }
+        return inv_norms.get();
+    }
+
+    int64_t
+    byte_size() const override {
+        auto size = ConcurrentVectorImpl<float, false>::byte_size();
+        std::lock_guard lck(inv_norms_mutex_);
+        for (auto& inv_norms : inv_norms_) {
+            if (inv_norms != nullptr) {
+                size += get_size_per_chunk() * sizeof(float);
+            }
+        }
+        return size;
+    }
+
+ private:
+    int64_t dim_;
+    mutable std::mutex inv_norms_mutex_;
+    mutable std::vector<std::unique_ptr<float[]>> inv_norms_;
 };
 
 template <>
 class ConcurrentVector<BinaryVector>
     : public ConcurrentVectorImpl<uint8_t, false> {
  public:
-    explicit ConcurrentVector(int64_t dim, int64_t size_per_chunk)
-        : ConcurrentVectorImpl(dim / 8, size_per_chunk) {
+    explicit ConcurrentVector(int64_t dim,
+                              int64_t size_per_chunk,
+                              ChunkArenaPtr arena = nullptr)
+        : ConcurrentVectorImpl(dim / 8, size_per_chunk, std::move(arena)) {
         AssertInfo(dim % 8 == 0,
                    fmt::format("dim is not a multiple of 8, dim={}", dim));
     }
@@ -391,9 +708,11 @@ template <>
 class ConcurrentVector<Float16Vector>
     : public ConcurrentVectorImpl<float16, false> {
  public:
-    ConcurrentVector(int64_t dim, int64_t size_per_chunk)
+    ConcurrentVector(int64_t dim,
+                     int64_t size_per_chunk,
+                     ChunkArenaPtr arena = nullptr)
         : ConcurrentVectorImpl<float16, false>::ConcurrentVectorImpl(
-              dim, size_per_chunk) {
+              dim, size_per_chunk, std::move(arena)) {
     }
 };
 
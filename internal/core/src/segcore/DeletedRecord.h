@@ -11,8 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <shared_mutex>
 #include <tuple>
 #include <utility>
@@ -36,53 +39,147 @@ struct DeletedRecord {
         clone(int64_t capacity);
     };
     static constexpr int64_t deprecated_size_per_chunk = 32 * 1024;
+    // the number of the bitmap snapshots kept for the queries at different
+    // timestamps
+    static constexpr size_t max_bitmap_snapshots = 4;
     DeletedRecord()
-        : lru_(std::make_shared<TmpBitmap>()),
-          timestamps_(deprecated_size_per_chunk),
+        : timestamps_(deprecated_size_per_chunk),
           pks_(deprecated_size_per_chunk) {
-        lru_->bitmap_ptr = std::make_shared<BitsetType>();
     }
 
-    auto
+    // the snapshot of the latest del_barrier, or an empty one
+    std::shared_ptr<TmpBitmap>
     get_lru_entry() {
         std::shared_lock lck(shared_mutex_);
-        return lru_;
+        std::shared_ptr<TmpBitmap> res;
+        for (auto& snapshot : snapshots_) {
+            if (res == nullptr || snapshot->del_barrier > res->del_barrier) {
+                res = snapshot;
+            }
+        }
+        return res != nullptr ? res : empty_bitmap();
     }
 
+    // return the snapshot itself if it matches both the barriers, otherwise
+    // a copy of the snapshot of the largest del_barrier not greater than the
+    // given one, resized to insert_barrier, whose del_barrier is set to the
+    // given one while old_del_barrier is the one of the snapshot, the deletes
+    // of [old_del_barrier, del_barrier) are to be applied by the caller
     std::shared_ptr<TmpBitmap>
     clone_lru_entry(int64_t insert_barrier,
                     int64_t del_barrier,
                     int64_t& old_del_barrier,
                     bool& hit_cache) {
-        std::shared_lock lck(shared_mutex_);
-        auto res = lru_->clone(insert_barrier);
-        old_del_barrier = lru_->del_barrier;
+        std::shared_ptr<TmpBitmap> base;
+        {
+            std::shared_lock lck(shared_mutex_);
+            for (auto& snapshot : snapshots_) {
+                if (snapshot->del_barrier <= del_barrier &&
+                    (base == nullptr ||
+                     snapshot->del_barrier > base->del_barrier)) {
+                    base = snapshot;
+                }
+            }
+        }
+        if (base == nullptr) {
+            base = empty_bitmap();
+        }
 
-        if (lru_->bitmap_ptr->size() == insert_barrier &&
-            lru_->del_barrier == del_barrier) {
+        // the snapshots are never modified once inserted, so copy it without
+        // holding the lock
+        old_del_barrier = base->del_barrier;
+        if (base->bitmap_ptr->size() == insert_barrier &&
+            base->del_barrier == del_barrier) {
             hit_cache = true;
-        } else {
-            res->del_barrier = del_barrier;
+            return base;
         }
-
+        auto res = base->clone(insert_barrier);
+        res->del_barrier = del_barrier;
         return res;
     }
 
+    // the new snapshot replaces the one of the same del_barrier, and evicts
+    // the earliest inserted one if the snapshots are full
     void
-    insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry, bool force = false) {
+    insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry) {
         std::lock_guard lck(shared_mutex_);
-        if (new_entry->del_barrier <= lru_->del_barrier) {
-            if (!force ||
-                new_entry->bitmap_ptr->size() <= lru_->bitmap_ptr->size()) {
-                // DO NOTHING
+        for (auto& snapshot : snapshots_) {
+            if (snapshot->del_barrier == new_entry->del_barrier) {
+                if (new_entry->bitmap_ptr->size() >
+                    snapshot->bitmap_ptr->size()) {
+                    snapshot = std::move(new_entry);
+                }
                 return;
             }
         }
-        lru_ = std::move(new_entry);
+        if (snapshots_.size() >= max_bitmap_snapshots) {
+            snapshots_.pop_front();
+        }
+        snapshots_.push_back(std::move(new_entry));
+    }
+
+    static std::shared_ptr<TmpBitmap>
+    empty_bitmap() {
+        auto res = std::make_shared<TmpBitmap>();
+        res->bitmap_ptr = std::make_shared<BitsetType>();
+        return res;
     }
 
     void
     push(const std::vector<PkType>& pks, const Timestamp* timestamps) {
+        auto size = pks.size();
+        if (std::is_sorted(timestamps, timestamps + size)) {
+            push_sorted(pks, timestamps);
+            return;
+        }
+
+        // the loaded delta logs may be out of order, while get_barrier and
+        // the truncation of the applied records need the log sorted by
+        // timestamp
+        std::vector<size_t> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(
+            order.begin(), order.end(), [timestamps](size_t lhs, size_t rhs) {
+                return timestamps[lhs] < timestamps[rhs];
+            });
+        std::vector<PkType> sorted_pks(size);
+        std::vector<Timestamp> sorted_timestamps(size);
+        for (size_t i = 0; i < size; ++i) {
+            sorted_pks[i] = pks[order[i]];
+            sorted_timestamps[i] = timestamps[order[i]];
+        }
+        push_sorted(sorted_pks, sorted_timestamps.data());
+    }
+
+    const ConcurrentVector<Timestamp>&
+    timestamps() const {
+        return timestamps_;
+    }
+
+    const ConcurrentVector<PkType>&
+    pks() const {
+        return pks_;
+    }
+
+    int64_t
+    size() const {
+        return n_.load();
+    }
+
+    // the bytes of the memory held by the deletes and the bitmap snapshots
+    int64_t
+    byte_size() const {
+        int64_t size = pks_.byte_size() + timestamps_.byte_size();
+        std::shared_lock lck(shared_mutex_);
+        for (auto& snapshot : snapshots_) {
+            size += snapshot->bitmap_ptr->size() / 8;
+        }
+        return size;
+    }
+
+ private:
+    void
+    push_sorted(const std::vector<PkType>& pks, const Timestamp* timestamps) {
         std::lock_guard lck(buffer_mutex_);
 
         auto size = pks.size();
@@ -107,24 +204,10 @@ struct DeletedRecord {
         n_ += size;
     }
 
-    const ConcurrentVector<Timestamp>&
-    timestamps() const {
-        return timestamps_;
-    }
-
-    const ConcurrentVector<PkType>&
-    pks() const {
-        return pks_;
-    }
-
-    int64_t
-    size() const {
-        return n_.load();
-    }
-
- private:
-    std::shared_ptr<TmpBitmap> lru_;
-    std::shared_mutex shared_mutex_;
+    // the bitmap snapshots in the order of insertion, guarded by
+    // shared_mutex_
+    std::deque<std::shared_ptr<TmpBitmap>> snapshots_;
+    mutable std::shared_mutex shared_mutex_;
 
     std::shared_mutex buffer_mutex_;
     std::atomic<int64_t> n_ = 0;
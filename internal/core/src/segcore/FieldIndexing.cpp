@@ -13,6 +13,7 @@
 #include <thread>
 #include "common/EasyAssert.h"
 #include "fmt/format.h"
+#include "index/BoolIndex.h"
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexSort.h"
 
@@ -31,6 +32,7 @@ VectorFieldIndexing::VectorFieldIndexing(const FieldMeta& field_meta,
     : FieldIndexing(field_meta, segcore_config),
       build(false),
       sync_with_index(false),
+      drop_raw_chunks_(segcore_config.get_drop_interim_indexed_chunks()),
       config_(std::make_unique<VecIndexConfig>(segment_max_row_count,
                                                field_index_meta,
                                                segcore_config,
@@ -196,7 +198,7 @@ VectorFieldIndexing::get_search_params(const SearchInfo& searchInfo) const {
 }
 
 idx_t
-VectorFieldIndexing::get_index_cursor() {
+VectorFieldIndexing::get_index_cursor() const {
     return index_cur_.load();
 }
 bool
@@ -224,7 +226,13 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg,
         // build index for chunk
         // TODO
         if constexpr (std::is_same_v<T, std::string>) {
+            // the chunks of the strings hold the views of them
+            std::vector<std::string> values(chunk.begin(), chunk.end());
             auto indexing = index::CreateStringIndexSort();
+            indexing->Build(values.size(), values.data());
+            data_[chunk_id] = std::move(indexing);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            auto indexing = index::CreateBoolIndex();
             indexing->Build(vec_base->get_size_per_chunk(), chunk.data());
             data_[chunk_id] = std::move(indexing);
         } else {
@@ -73,13 +73,19 @@ class FieldIndexing {
         return true;
     }
 
+    // whether the raw data is dropped from the chunks once held by the index
+    virtual bool
+    drop_raw_chunks() const {
+        return false;
+    }
+
     const FieldMeta&
     get_field_meta() {
         return field_meta_;
     }
 
     virtual idx_t
-    get_index_cursor() = 0;
+    get_index_cursor() const = 0;
 
     int64_t
     get_size_per_chunk() const {
@@ -92,6 +98,11 @@ class FieldIndexing {
     virtual index::IndexBase*
     get_segment_indexing() const = 0;
 
+    // the bytes of the memory held by the indexes of the chunks and the
+    // segment
+    virtual int64_t
+    byte_size() const = 0;
+
  protected:
     // additional info
     const FieldMeta& field_meta_;
@@ -126,7 +137,7 @@ class ScalarFieldIndexing : public FieldIndexing {
                   "scalar index don't support get data from index");
     }
     idx_t
-    get_index_cursor() override {
+    get_index_cursor() const override {
         return 0;
     }
 
@@ -152,6 +163,17 @@ class ScalarFieldIndexing : public FieldIndexing {
         return nullptr;
     }
 
+    int64_t
+    byte_size() const override {
+        int64_t size = 0;
+        for (auto& chunk_indexing : data_) {
+            if (chunk_indexing != nullptr) {
+                size += chunk_indexing->ByteSize();
+            }
+        }
+        return size;
+    }
+
  private:
     tbb::concurrent_vector<index::ScalarIndexPtr<T>> data_;
 };
@@ -198,14 +220,31 @@ class VectorFieldIndexing : public FieldIndexing {
         return index_.get();
     }
 
+    int64_t
+    byte_size() const override {
+        // the index of the segment is created empty, and built lazily
+        int64_t size = build ? index_->ByteSize() : 0;
+        for (auto& chunk_indexing : data_) {
+            if (chunk_indexing != nullptr) {
+                size += chunk_indexing->ByteSize();
+            }
+        }
+        return size;
+    }
+
     bool
     sync_data_with_index() const override;
 
     bool
     has_raw_data() const override;
 
+    bool
+    drop_raw_chunks() const override {
+        return drop_raw_chunks_;
+    }
+
     idx_t
-    get_index_cursor() override;
+    get_index_cursor() const override;
 
     knowhere::Json
     get_build_params() const;
@@ -213,10 +252,23 @@ class VectorFieldIndexing : public FieldIndexing {
     SearchInfo
     get_search_params(const SearchInfo& searchInfo) const;
 
+    float
+    get_refine_ratio() const {
+        return config_->GetRefineRatio();
+    }
+
+    // of the interim index
+    knowhere::IndexType
+    get_index_type() const {
+        return config_->GetIndexType();
+    }
+
  private:
     std::atomic<idx_t> index_cur_ = 0;
     std::atomic<bool> build;
     std::atomic<bool> sync_with_index;
+    // latched at the creation, the chunks can't be dropped halfway
+    const bool drop_raw_chunks_;
     std::unique_ptr<VecIndexConfig> config_;
     std::unique_ptr<index::VectorIndex> index_;
     tbb::concurrent_vector<std::unique_ptr<index::VectorIndex>> data_;
@@ -321,6 +373,27 @@ class IndexingRecord {
         }
     }
 
+    // concurrent, reentrant
+    template <bool is_sealed>
+    void
+    AppendingIndex(int64_t reserved_offset,
+                   int64_t size,
+                   FieldId fieldId,
+                   const arrow::FixedSizeBinaryArray& data,
+                   const InsertRecord<is_sealed>& record) {
+        if (is_in(fieldId)) {
+            auto& indexing = field_indexings_.at(fieldId);
+            if (indexing->get_field_meta().is_vector() &&
+                indexing->get_field_meta().get_data_type() ==
+                    DataType::VECTOR_FLOAT &&
+                reserved_offset + size >= indexing->get_build_threshold()) {
+                auto vec_base = record.get_field_data_base(fieldId);
+                indexing->AppendSegmentIndex(
+                    reserved_offset, size, vec_base, data.raw_values());
+            }
+        }
+    }
+
     void
     GetDataFromIndex(FieldId fieldId,
                      const int64_t* seg_offsets,
@@ -357,6 +430,15 @@ class IndexingRecord {
         return true;
     }
 
+    // the index has synchronized with all inserted data and holds the raw
+    // data, then the raw data is dropped from the chunks unless configured
+    // not to, or else the chunks keep the raw data even if synchronized
+    bool
+    RawDataHeldByIndex(FieldId fieldId) const {
+        return SyncDataWithIndex(fieldId) && HasRawData(fieldId) &&
+               get_field_indexing(fieldId).drop_raw_chunks();
+    }
+
     // concurrent
     int64_t
     get_finished_ack() const {
@@ -382,6 +464,16 @@ class IndexingRecord {
         return field_indexings_.count(field_id);
     }
 
+    // the bytes of the memory held by the indexes of all the fields
+    int64_t
+    byte_size() const {
+        int64_t size = 0;
+        for (auto& [field_id, indexing] : field_indexings_) {
+            size += indexing->byte_size();
+        }
+        return size;
+    }
+
     template <typename T>
     auto
     get_scalar_field_indexing(FieldId field_id) const
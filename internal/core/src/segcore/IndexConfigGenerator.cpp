@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+
 #include "IndexConfigGenerator.h"
 #include "log/Log.h"
 
@@ -29,6 +31,20 @@ VecIndexConfig::VecIndexConfig(const int64_t max_index_row_cout,
         std::max((int)(config_.get_chunk_rows() / config_.get_nlist()), 48));
     search_params_[knowhere::indexparam::NPROBE] =
         std::to_string(config_.get_nprobe());
+
+    auto& quantization = config_.get_interim_index_quantization();
+    if (segment_type == SegmentType::Growing && !quantization.empty()) {
+        auto iter = quantization_code_size.find(quantization);
+        if (iter == quantization_code_size.end()) {
+            LOG_SEGCORE_WARNING_ << "unsupported interim index quantization: "
+                                 << quantization
+                                 << ", fallback to the float32 interim index";
+        } else {
+            index_type_ = ivf_sq_cc_index_type;
+            build_params_["code_size"] = std::to_string(iter->second);
+            refine_ratio_ = std::max(config_.get_refine_ratio(), 1.0f);
+        }
+    }
     LOG_SEGCORE_INFO_ << " VecIndexConfig: "
                       << " origin_index_type_:" << origin_index_type_
                       << " index_type_: " << index_type_
@@ -54,6 +70,11 @@ VecIndexConfig::GetMetricType() noexcept {
     return metric_type_;
 }
 
+float
+VecIndexConfig::GetRefineRatio() const noexcept {
+    return refine_ratio_;
+}
+
 knowhere::Json
 VecIndexConfig::GetBuildBaseParams() {
     return build_params_;
@@ -32,8 +32,15 @@ class VecIndexConfig {
         {{SegmentType::Growing, knowhere::IndexEnum::INDEX_FAISS_IVFFLAT_CC},
          {SegmentType::Sealed, knowhere::IndexEnum::INDEX_FAISS_IVFFLAT_CC}};
 
+    // the quantized interim index for growing segments
+    inline static const std::string ivf_sq_cc_index_type = "IVF_SQ_CC";
+
+    inline static const std::map<std::string, int> quantization_code_size = {
+        {"SQ8", 8}, {"FP16", 16}};
+
     inline static const std::map<std::string, double> index_build_ratio = {
-        {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT_CC, 0.1}};
+        {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT_CC, 0.1},
+        {ivf_sq_cc_index_type, 0.1}};
 
     inline static const std::unordered_set<std::string> maintain_params = {
         "radius", "range_filter"};
@@ -59,6 +66,10 @@ class VecIndexConfig {
     SearchInfo
     GetSearchConf(const SearchInfo& searchInfo);
 
+    // 1 if the index isn't quantized
+    float
+    GetRefineRatio() const noexcept;
+
  private:
     const SegcoreConfig& config_;
 
@@ -70,6 +81,8 @@ class VecIndexConfig {
 
     knowhere::MetricType metric_type_;
 
+    float refine_ratio_ = 1.0;
+
     knowhere::Json build_params_;
 
     knowhere::Json search_params_;
@@ -12,23 +12,35 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 #include <queue>
+#include <type_traits>
 
 #include "TimestampIndex.h"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/Schema.h"
 #include "common/Types.h"
+#include "common/Utils.h"
 #include "fmt/format.h"
 #include "mmap/Column.h"
 #include "segcore/AckResponder.h"
+#include "segcore/BloomFilter.h"
 #include "segcore/ConcurrentVector.h"
 #include "segcore/Record.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
@@ -48,15 +60,50 @@ class OffsetMap {
     virtual std::vector<int64_t>
     find(const PkType& pk) const = 0;
 
+    // the (index of pk, offset) pairs of all the pks, ordered by the index of
+    // pk and then the offset like calling find() one by one
+    virtual std::vector<std::pair<int64_t, int64_t>>
+    find_batch(const std::vector<PkType>& pks) const {
+        std::vector<std::pair<int64_t, int64_t>> res;
+        for (int64_t i = 0; i < pks.size(); ++i) {
+            for (auto offset : find(pks[i])) {
+                res.emplace_back(i, offset);
+            }
+        }
+        return res;
+    }
+
+    // whether each of the pks is contained, like calling contain() one by
+    // one
+    virtual std::vector<bool>
+    contain_batch(const std::vector<PkType>& pks) const {
+        std::vector<bool> res(pks.size());
+        for (int64_t i = 0; i < pks.size(); ++i) {
+            res[i] = contain(pks[i]);
+        }
+        return res;
+    }
+
     virtual void
     insert(const PkType& pk, int64_t offset) = 0;
 
     virtual void
     seal() = 0;
 
+    // the offsets in the order of their pks once sealed, empty if the map
+    // keeps no order
+    virtual std::vector<int64_t>
+    sorted_offsets() const {
+        return {};
+    }
+
     virtual bool
     empty() const = 0;
 
+    // the bytes of the memory held by the pks and their offsets
+    virtual int64_t
+    byte_size() const = 0;
+
     using OffsetType = int64_t;
     // TODO: in fact, we can retrieve the pk here. Not sure which way is more efficient.
     virtual std::vector<OffsetType>
@@ -65,82 +112,200 @@ class OffsetMap {
                bool false_filtered_out) const = 0;
 };
 
+// OffsetShardedMap is the pk index of the growing segments. The pks are
+// sharded by their hashes into hash maps locked one by one, so the concurrent
+// inserts and lookups rarely wait for each other. The pks ordered for
+// find_first are kept apart, the pks inserted since the last find_first are
+// sorted and merged into them on the next one.
 template <typename T>
-class OffsetOrderedMap : public OffsetMap {
+class OffsetShardedMap : public OffsetMap {
  public:
     bool
     contain(const PkType& pk) const override {
-        return map_.find(std::get<T>(pk)) != map_.end();
+        auto& target = std::get<T>(pk);
+        auto& shard = get_shard(target);
+        std::shared_lock lck(shard.mutex);
+        return shard.map.find(target) != shard.map.end();
     }
 
     std::vector<int64_t>
     find(const PkType& pk) const override {
-        auto offset_vector = map_.find(std::get<T>(pk));
-        return offset_vector != map_.end() ? offset_vector->second
-                                           : std::vector<int64_t>();
+        auto& target = std::get<T>(pk);
+        auto& shard = get_shard(target);
+        std::shared_lock lck(shard.mutex);
+        auto offset_vector = shard.map.find(target);
+        return offset_vector != shard.map.end() ? offset_vector->second
+                                                : std::vector<int64_t>();
     }
 
     void
     insert(const PkType& pk, int64_t offset) override {
-        map_[std::get<T>(pk)].emplace_back(offset);
+        auto& target = std::get<T>(pk);
+        auto& shard = get_shard(target);
+        std::lock_guard lck(shard.mutex);
+        shard.map[target].emplace_back(offset);
+        shard.unordered.emplace_back(target, offset);
+        num_offsets_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // insert the (pk, offset) pairs sorted by the pk and then the offset at
+    // once, like calling insert() one by one, but locking each shard once
+    // and merging the pairs into the ordered ones directly
+    void
+    insert_sorted(std::vector<std::pair<T, int64_t>> entries) {
+        std::array<std::vector<const Entry*>, 1 << SHARD_BITS> sharded;
+        for (auto& entry : entries) {
+            sharded[HashPk(entry.first) >> (64 - SHARD_BITS)].push_back(
+                &entry);
+        }
+        for (size_t i = 0; i < sharded.size(); ++i) {
+            auto& shard = shards_[i];
+            std::lock_guard lck(shard.mutex);
+            shard.map.reserve(shard.map.size() + sharded[i].size());
+            for (auto entry : sharded[i]) {
+                shard.map[entry->first].emplace_back(entry->second);
+            }
+        }
+        num_offsets_.fetch_add(entries.size(), std::memory_order_relaxed);
+
+        std::lock_guard lck(ordered_mutex_);
+        auto num_ordered = ordered_.size();
+        ordered_.insert(ordered_.end(),
+                        std::make_move_iterator(entries.begin()),
+                        std::make_move_iterator(entries.end()));
+        std::inplace_merge(ordered_.begin(),
+                           ordered_.begin() + num_ordered,
+                           ordered_.end());
     }
 
     void
     seal() override {
         PanicInfo(
             NotImplemented,
-            "OffsetOrderedMap used for growing segment could not be sealed.");
+            "OffsetShardedMap used for growing segment could not be sealed.");
     }
 
     bool
     empty() const override {
-        return map_.empty();
+        return num_offsets_.load(std::memory_order_relaxed) == 0;
+    }
+
+    int64_t
+    byte_size() const override {
+        int64_t size = 0;
+        for (auto& shard : shards_) {
+            std::shared_lock lck(shard.mutex);
+            size += shard.map.bucket_count() * sizeof(void*);
+            for (auto& [pk, offsets] : shard.map) {
+                size += sizeof(typename ShardMap::value_type) +
+                        HASH_NODE_OVERHEAD +
+                        offsets.capacity() * sizeof(int64_t) +
+                        pk_heap_byte_size(pk);
+            }
+            size += entries_byte_size(shard.unordered);
+        }
+        std::lock_guard lck(ordered_mutex_);
+        return size + entries_byte_size(ordered_);
     }
 
     std::vector<OffsetType>
     find_first(int64_t limit,
                const BitsetType& bitset,
                bool false_filtered_out) const override {
+        std::lock_guard lck(ordered_mutex_);
+        merge_unordered();
         if (limit == Unlimited || limit == NoLimit) {
-            limit = map_.size();
+            limit = ordered_.size();
         }
 
-        // TODO: we can't retrieve pk by offset very conveniently.
-        //      Selectivity should be done outside.
-        return find_first_by_index(limit, bitset, false_filtered_out);
-    }
-
- private:
-    std::vector<OffsetType>
-    find_first_by_index(int64_t limit,
-                        const BitsetType& bitset,
-                        bool false_filtered_out) const {
-        int64_t hit_num = 0;  // avoid counting the number everytime.
         int64_t cnt = bitset.count();
         if (!false_filtered_out) {
             cnt = bitset.size() - bitset.count();
         }
         limit = std::min(limit, cnt);
+        int64_t hit_num = 0;
         std::vector<int64_t> seg_offsets;
         seg_offsets.reserve(limit);
-        for (auto it = map_.begin(); hit_num < limit && it != map_.end();
-             it++) {
-            for (auto seg_offset : it->second) {
-                if (!(bitset[seg_offset] ^ false_filtered_out)) {
-                    seg_offsets.push_back(seg_offset);
-                    hit_num++;
-                    if (hit_num >= limit) {
-                        break;
-                    }
-                }
+        for (auto it = ordered_.begin();
+             hit_num < limit && it != ordered_.end();
+             ++it) {
+            auto seg_offset = it->second;
+            if (!(bitset[seg_offset] ^ false_filtered_out)) {
+                seg_offsets.push_back(seg_offset);
+                hit_num++;
             }
         }
         return seg_offsets;
     }
 
  private:
-    using OrderedMap = std::map<T, std::vector<int64_t>, std::less<>>;
-    OrderedMap map_;
+    using ShardMap = std::unordered_map<T, std::vector<int64_t>>;
+    using Entry = std::pair<T, int64_t>;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        ShardMap map;
+        // the pks inserted since the last find_first
+        std::vector<Entry> unordered;
+    };
+
+    Shard&
+    get_shard(const T& pk) const {
+        return shards_[HashPk(pk) >> (64 - SHARD_BITS)];
+    }
+
+    // called with ordered_mutex_ held
+    void
+    merge_unordered() const {
+        std::vector<Entry> entries;
+        for (auto& shard : shards_) {
+            std::lock_guard lck(shard.mutex);
+            std::move(shard.unordered.begin(),
+                      shard.unordered.end(),
+                      std::back_inserter(entries));
+            shard.unordered.clear();
+        }
+        if (entries.empty()) {
+            return;
+        }
+        std::sort(entries.begin(), entries.end());
+        auto num_ordered = ordered_.size();
+        ordered_.insert(ordered_.end(),
+                        std::make_move_iterator(entries.begin()),
+                        std::make_move_iterator(entries.end()));
+        std::inplace_merge(ordered_.begin(),
+                           ordered_.begin() + num_ordered,
+                           ordered_.end());
+    }
+
+    static int64_t
+    pk_heap_byte_size(const T& pk) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return StringHeapByteSize(pk);
+        } else {
+            return 0;
+        }
+    }
+
+    static int64_t
+    entries_byte_size(const std::vector<Entry>& entries) {
+        int64_t size = entries.capacity() * sizeof(Entry);
+        for (auto& [pk, offset] : entries) {
+            size += pk_heap_byte_size(pk);
+        }
+        return size;
+    }
+
+ private:
+    static constexpr int SHARD_BITS = 4;
+    // the next pointer and the cached hash of a node of the hash map
+    static constexpr int64_t HASH_NODE_OVERHEAD = 16;
+    mutable std::array<Shard, 1 << SHARD_BITS> shards_;
+    std::atomic<int64_t> num_offsets_ = 0;
+
+    mutable std::mutex ordered_mutex_;
+    // the (pk, offset) pairs ordered by the pk and then the offset
+    mutable std::vector<Entry> ordered_;
 };
 
 template <typename T>
@@ -149,14 +314,11 @@ class OffsetOrderedArray : public OffsetMap {
     bool
     contain(const PkType& pk) const override {
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
-
-        return it != array_.end();
+        if (!bloom_filter_.MayContain(HashPk(target))) {
+            return false;
+        }
+        auto pos = lower_bound(target);
+        return pos < array_.size() && array_[pos].first == target;
     }
 
     std::vector<int64_t>
@@ -164,21 +326,47 @@ class OffsetOrderedArray : public OffsetMap {
         check_search();
 
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
-
         std::vector<int64_t> offset_vector;
-        for (; it != array_.end() && it->first == target; ++it) {
-            offset_vector.push_back(it->second);
+        if (!bloom_filter_.MayContain(HashPk(target))) {
+            return offset_vector;
+        }
+        for (auto pos = lower_bound(target);
+             pos < array_.size() && array_[pos].first == target;
+             ++pos) {
+            offset_vector.push_back(array_[pos].second);
         }
 
         return offset_vector;
     }
 
+    std::vector<std::pair<int64_t, int64_t>>
+    find_batch(const std::vector<PkType>& pks) const override {
+        check_search();
+
+        auto ranges = probe_batch(pks);
+        std::vector<std::pair<int64_t, int64_t>> res;
+        for (int64_t i = 0; i < pks.size(); ++i) {
+            for (auto pos = ranges[i].first; pos < ranges[i].second; ++pos) {
+                res.emplace_back(i, array_[pos].second);
+            }
+        }
+        return res;
+    }
+
+    std::vector<bool>
+    contain_batch(const std::vector<PkType>& pks) const override {
+        if (!is_sealed) {
+            return OffsetMap::contain_batch(pks);
+        }
+
+        auto ranges = probe_batch(pks);
+        std::vector<bool> res(pks.size());
+        for (int64_t i = 0; i < pks.size(); ++i) {
+            res[i] = ranges[i].first < ranges[i].second;
+        }
+        return res;
+    }
+
     void
     insert(const PkType& pk, int64_t offset) override {
         if (is_sealed) {
@@ -188,17 +376,55 @@ class OffsetOrderedArray : public OffsetMap {
         array_.push_back(std::make_pair(std::get<T>(pk), offset));
     }
 
+    // the pks inserted in their order, as restored from a segment snapshot,
+    // are not sorted again
     void
     seal() override {
-        sort(array_.begin(), array_.end());
+        if (!std::is_sorted(array_.begin(), array_.end())) {
+            sort(array_.begin(), array_.end());
+        }
+        if constexpr (std::is_arithmetic_v<T>) {
+            build_layout();
+        }
+        bloom_filter_ = SplitBlockBloomFilter(array_.size());
+        for (auto& [pk, offset] : array_) {
+            bloom_filter_.Add(HashPk(pk));
+        }
+        build_ranks();
         is_sealed = true;
     }
 
+    std::vector<int64_t>
+    sorted_offsets() const override {
+        check_search();
+        std::vector<int64_t> offsets;
+        offsets.reserve(array_.size());
+        for (auto& [pk, offset] : array_) {
+            offsets.push_back(offset);
+        }
+        return offsets;
+    }
+
     bool
     empty() const override {
         return array_.empty();
     }
 
+    int64_t
+    byte_size() const override {
+        int64_t size = array_.capacity() * sizeof(std::pair<T, int64_t>) +
+                       layout_keys_.capacity() * sizeof(T) +
+                       layout_blocks_.capacity() * sizeof(int64_t) +
+                       ranks_.capacity() * sizeof(uint32_t) +
+                       bloom_filter_.ByteSize();
+        if constexpr (std::is_same_v<T, std::string>) {
+            for (auto& [pk, offset] : array_) {
+                size += StringHeapByteSize(pk);
+            }
+        }
+        return size;
+    }
+
     std::vector<OffsetType>
     find_first(int64_t limit,
                const BitsetType& bitset,
@@ -225,6 +451,18 @@ class OffsetOrderedArray : public OffsetMap {
             cnt = bitset.size() - bitset.count();
         }
         limit = std::min(limit, cnt);
+        if (limit <= 0) {
+            return {};
+        }
+        // walking the pks in order meets about limit * size / cnt of them to
+        // hit limit rows, while the rows kept are found by the words of the
+        // bitset and then ordered by their ranks
+        auto walk_cost = limit * int64_t(array_.size()) / cnt;
+        auto scan_cost = cnt + int64_t(bitset.size()) / BITSET_BLOCK_BITS;
+        if (!ranks_.empty() && scan_cost < walk_cost) {
+            return find_first_by_bitset(limit, bitset, false_filtered_out);
+        }
+
         std::vector<int64_t> seg_offsets;
         seg_offsets.reserve(limit);
         for (auto it = array_.begin(); hit_num < limit && it != array_.end();
@@ -237,15 +475,430 @@ class OffsetOrderedArray : public OffsetMap {
         return seg_offsets;
     }
 
+    // the first limit rows kept in the pk order, by the ranks of the rows
+    // kept in the bitset, only the rows kept are touched
+    std::vector<OffsetType>
+    find_first_by_bitset(int64_t limit,
+                         const BitsetType& bitset,
+                         bool false_filtered_out) const {
+        // the rows kept are the set bits if false_filtered_out
+        BitsetType flipped;
+        if (!false_filtered_out) {
+            flipped = ~bitset;
+        }
+        auto& kept = false_filtered_out ? bitset : flipped;
+        std::vector<uint32_t> ranks;
+        for (auto offset = kept.find_first(); offset != BitsetType::npos;
+             offset = kept.find_next(offset)) {
+            if (offset < ranks_.size()) {
+                ranks.push_back(ranks_[offset]);
+            }
+        }
+        if (int64_t(ranks.size()) > limit) {
+            std::nth_element(
+                ranks.begin(), ranks.begin() + limit, ranks.end());
+            ranks.resize(limit);
+        }
+        std::sort(ranks.begin(), ranks.end());
+
+        std::vector<int64_t> seg_offsets;
+        seg_offsets.reserve(ranks.size());
+        for (auto rank : ranks) {
+            seg_offsets.push_back(array_[rank].second);
+        }
+        return seg_offsets;
+    }
+
+    // the rank of a row is the position of its pk in array_
+    void
+    build_ranks() {
+        ranks_.clear();
+        if (array_.empty() ||
+            array_.size() > std::numeric_limits<uint32_t>::max()) {
+            return;
+        }
+        int64_t max_offset = 0;
+        for (auto& [pk, offset] : array_) {
+            max_offset = std::max(max_offset, offset);
+        }
+        ranks_.resize(max_offset + 1);
+        for (size_t i = 0; i < array_.size(); ++i) {
+            ranks_[array_[i].second] = i;
+        }
+    }
+
     void
     check_search() const {
         AssertInfo(is_sealed,
                    "OffsetOrderedArray could not search before seal");
     }
 
+    // the position of the first element not less than the target
+    size_t
+    lower_bound(const T& target) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (layout_keys_.empty()) {
+                return std::lower_bound(array_.begin(),
+                                        array_.end(),
+                                        target,
+                                        less_than_key) -
+                       array_.begin();
+            }
+            // locate the block by the layout, then search inside the block
+            auto block = search_layout(target);
+            if (block == 0) {
+                return 0;
+            }
+            auto begin = array_.begin() + (block - 1) * BLOCK_SIZE;
+            auto end = array_.begin() +
+                       std::min(block * BLOCK_SIZE, int64_t(array_.size()));
+            return std::lower_bound(begin, end, target, less_than_key) -
+                   array_.begin();
+        } else {
+            return std::lower_bound(
+                       array_.begin(), array_.end(), target, less_than_key) -
+                   array_.begin();
+        }
+    }
+
+    static bool
+    less_than_key(const std::pair<T, int64_t>& elem, const T& value) {
+        return elem.first < value;
+    }
+
+    // the position of the first element not less than the target, which is
+    // not before pos, by doubling the steps from pos, so the successive
+    // targets of a sorted batch cost O(log(distance)) instead of O(log m)
+    int64_t
+    gallop(int64_t pos, const T& target) const {
+        int64_t size = array_.size();
+        int64_t step = 1;
+        int64_t hi = pos;
+        while (hi < size && array_[hi].first < target) {
+            pos = hi + 1;
+            hi = pos + step;
+            step *= 2;
+        }
+        return std::lower_bound(array_.begin() + pos,
+                                array_.begin() + std::min(hi, size),
+                                target,
+                                less_than_key) -
+               array_.begin();
+    }
+
+    // [begin, end) of array_ equal to each pk. The pks passing the bloom
+    // filter are sorted and merge joined with the array, the large batches
+    // in parallel ranges of the sorted pks
+    std::vector<std::pair<int64_t, int64_t>>
+    probe_batch(const std::vector<PkType>& pks) const {
+        std::vector<int64_t> order;
+        order.reserve(pks.size());
+        for (int64_t i = 0; i < pks.size(); ++i) {
+            if (bloom_filter_.MayContain(HashPk(std::get<T>(pks[i])))) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&pks](int64_t lhs, int64_t rhs) {
+            return std::get<T>(pks[lhs]) < std::get<T>(pks[rhs]);
+        });
+
+        std::vector<std::pair<int64_t, int64_t>> ranges(pks.size());
+        // each range of the sorted pks starts by a search of the layout,
+        // then gallops from the end of the previous pk
+        auto probe_range = [&](int64_t first, int64_t last) {
+            int64_t pos = 0;
+            for (int64_t i = first; i < last; ++i) {
+                const T& target = std::get<T>(pks[order[i]]);
+                if (i > first && std::get<T>(pks[order[i - 1]]) == target) {
+                    ranges[order[i]] = ranges[order[i - 1]];
+                    continue;
+                }
+                auto begin = i == first ? int64_t(lower_bound(target))
+                                        : gallop(pos, target);
+                auto end = begin;
+                while (end < array_.size() && array_[end].first == target) {
+                    ++end;
+                }
+                ranges[order[i]] = {begin, end};
+                pos = end;
+            }
+        };
+
+        int64_t num_pks = order.size();
+        auto task_num =
+            std::min<int64_t>(num_pks / PARALLEL_PROBE_BATCH, CPU_NUM);
+        if (task_num <= 1) {
+            probe_range(0, num_pks);
+            return ranges;
+        }
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        std::vector<std::future<void>> futures;
+        futures.reserve(task_num);
+        try {
+            for (int64_t i = 0; i < task_num; ++i) {
+                futures.emplace_back(pool.Submit(probe_range,
+                                                 num_pks * i / task_num,
+                                                 num_pks * (i + 1) / task_num));
+            }
+            for (auto& future : futures) {
+                future.get();
+            }
+        } catch (...) {
+            // the tasks reference the locals, wait for them before unwinding
+            for (auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
+        }
+        return ranges;
+    }
+
+    // the first key of every BLOCK_SIZE elements of array_ stored in the
+    // eytzinger (BFS) order, where the children of the node k are 2k and
+    // 2k + 1, so that a search walks down the cache lines prefetched ahead
+    // instead of jumping around the whole array
+    void
+    build_layout() {
+        auto block_num = upper_div(int64_t(array_.size()), BLOCK_SIZE);
+        layout_keys_.resize(block_num + 1);
+        layout_blocks_.resize(block_num + 1);
+        build_layout(0, 1);
+    }
+
+    int64_t
+    build_layout(int64_t block, int64_t node) {
+        if (node < layout_keys_.size()) {
+            block = build_layout(block, 2 * node);
+            layout_keys_[node] = array_[block * BLOCK_SIZE].first;
+            layout_blocks_[node] = block++;
+            block = build_layout(block, 2 * node + 1);
+        }
+        return block;
+    }
+
+    // the index of the first block whose first key is not less than the
+    // target, or the number of blocks if there isn't one
+    int64_t
+    search_layout(const T& target) const {
+        int64_t block_num = layout_keys_.size() - 1;
+        int64_t node = 1;
+        while (node <= block_num) {
+            // the 16 descendants 4 levels down share a cache line or two
+            if (16 * node <= block_num) {
+                __builtin_prefetch(layout_keys_.data() + 16 * node);
+            }
+            node = 2 * node + (layout_keys_[node] < target);
+        }
+        // cancel the right turns after the last left turn
+        node >>= __builtin_ffsll(~node);
+        return node == 0 ? block_num : layout_blocks_[node];
+    }
+
  private:
+    static constexpr int64_t BLOCK_SIZE = 16;
+    // the least pks probed by each of the parallel tasks of a batch
+    static constexpr int64_t PARALLEL_PROBE_BATCH = 16 * 1024;
+
     bool is_sealed = false;
     std::vector<std::pair<T, int64_t>> array_;
+    // 1-based, only for the arithmetic pks
+    std::vector<T> layout_keys_;
+    std::vector<int64_t> layout_blocks_;
+    // built on seal, to reject the pks not in the segment without a search
+    SplitBlockBloomFilter bloom_filter_;
+    // the ranks of the rows subscripted by the offsets, built on seal
+    std::vector<uint32_t> ranks_;
+    static constexpr int64_t BITSET_BLOCK_BITS = BitsetType::bits_per_block;
+};
+
+// OffsetOrderedColumn is the pk index of the sealed segments with string
+// pks. Instead of copying the pks, it keeps the offsets of the rows sorted
+// by the pks they reference in the pk column, so a row costs 4 bytes besides
+// its rank, and the pks are compared in the column where they are.
+class OffsetOrderedColumn : public OffsetMap {
+ public:
+    // the rows are expected in the order of the offsets if given, which are
+    // sorted again on seal only if they aren't
+    OffsetOrderedColumn(std::shared_ptr<VariableColumn<std::string>> column,
+                        const int64_t* order = nullptr)
+        : column_(std::move(column)) {
+        auto num_rows = column_->NumRows();
+        AssertInfo(num_rows <= std::numeric_limits<uint32_t>::max(),
+                   "too many rows {} for the pk column index",
+                   num_rows);
+        offsets_.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            offsets_[i] = order != nullptr ? order[i] : i;
+        }
+    }
+
+    bool
+    contain(const PkType& pk) const override {
+        std::string_view target = std::get<std::string>(pk);
+        if (!bloom_filter_.MayContain(HashPk(target))) {
+            return false;
+        }
+        auto pos = lower_bound(target);
+        return pos < offsets_.size() && pk_at(pos) == target;
+    }
+
+    std::vector<int64_t>
+    find(const PkType& pk) const override {
+        check_search();
+
+        std::string_view target = std::get<std::string>(pk);
+        std::vector<int64_t> offset_vector;
+        if (!bloom_filter_.MayContain(HashPk(target))) {
+            return offset_vector;
+        }
+        for (auto pos = lower_bound(target);
+             pos < offsets_.size() && pk_at(pos) == target;
+             ++pos) {
+            offset_vector.push_back(offsets_[pos]);
+        }
+        return offset_vector;
+    }
+
+    void
+    insert(const PkType& pk, int64_t offset) override {
+        PanicInfo(Unsupported,
+                  "OffsetOrderedColumn takes the pks from the column only");
+    }
+
+    void
+    seal() override {
+        auto less = [this](uint32_t lhs, uint32_t rhs) {
+            auto lhs_pk = column_->RawAt(lhs);
+            auto rhs_pk = column_->RawAt(rhs);
+            return lhs_pk < rhs_pk || (lhs_pk == rhs_pk && lhs < rhs);
+        };
+        if (!std::is_sorted(offsets_.begin(), offsets_.end(), less)) {
+            std::sort(offsets_.begin(), offsets_.end(), less);
+        }
+        bloom_filter_ = SplitBlockBloomFilter(offsets_.size());
+        for (size_t i = 0; i < offsets_.size(); ++i) {
+            bloom_filter_.Add(HashPk(pk_at(i)));
+        }
+        ranks_.assign(offsets_.size(), 0);
+        for (size_t i = 0; i < offsets_.size(); ++i) {
+            ranks_[offsets_[i]] = i;
+        }
+        is_sealed = true;
+    }
+
+    std::vector<int64_t>
+    sorted_offsets() const override {
+        check_search();
+        return std::vector<int64_t>(offsets_.begin(), offsets_.end());
+    }
+
+    bool
+    empty() const override {
+        return offsets_.empty();
+    }
+
+    // the pks are held by the column, not counted here
+    int64_t
+    byte_size() const override {
+        return offsets_.capacity() * sizeof(uint32_t) +
+               ranks_.capacity() * sizeof(uint32_t) +
+               bloom_filter_.ByteSize();
+    }
+
+    std::vector<OffsetType>
+    find_first(int64_t limit,
+               const BitsetType& bitset,
+               bool false_filtered_out) const override {
+        check_search();
+
+        if (limit == Unlimited || limit == NoLimit) {
+            limit = offsets_.size();
+        }
+        int64_t cnt = bitset.count();
+        if (!false_filtered_out) {
+            cnt = bitset.size() - bitset.count();
+        }
+        limit = std::min(limit, cnt);
+        if (limit <= 0) {
+            return {};
+        }
+        // like OffsetOrderedArray, the rows kept are ordered by their ranks
+        // if it's cheaper than walking the pks in order
+        auto walk_cost = limit * int64_t(offsets_.size()) / cnt;
+        auto scan_cost = cnt + int64_t(bitset.size()) / BITSET_BLOCK_BITS;
+        std::vector<int64_t> seg_offsets;
+        seg_offsets.reserve(limit);
+        if (scan_cost >= walk_cost) {
+            for (auto it = offsets_.begin();
+                 int64_t(seg_offsets.size()) < limit && it != offsets_.end();
+                 ++it) {
+                if (!(bitset[*it] ^ false_filtered_out)) {
+                    seg_offsets.push_back(*it);
+                }
+            }
+            return seg_offsets;
+        }
+
+        BitsetType flipped;
+        if (!false_filtered_out) {
+            flipped = ~bitset;
+        }
+        auto& kept = false_filtered_out ? bitset : flipped;
+        std::vector<uint32_t> ranks;
+        for (auto offset = kept.find_first(); offset != BitsetType::npos;
+             offset = kept.find_next(offset)) {
+            if (offset < ranks_.size()) {
+                ranks.push_back(ranks_[offset]);
+            }
+        }
+        if (int64_t(ranks.size()) > limit) {
+            std::nth_element(
+                ranks.begin(), ranks.begin() + limit, ranks.end());
+            ranks.resize(limit);
+        }
+        std::sort(ranks.begin(), ranks.end());
+        for (auto rank : ranks) {
+            seg_offsets.push_back(offsets_[rank]);
+        }
+        return seg_offsets;
+    }
+
+ private:
+    std::string_view
+    pk_at(size_t pos) const {
+        return column_->RawAt(offsets_[pos]);
+    }
+
+    // the position of the first pk not less than the target
+    size_t
+    lower_bound(std::string_view target) const {
+        return std::lower_bound(offsets_.begin(),
+                                offsets_.end(),
+                                target,
+                                [this](uint32_t offset, std::string_view pk) {
+                                    return column_->RawAt(offset) < pk;
+                                }) -
+               offsets_.begin();
+    }
+
+    void
+    check_search() const {
+        AssertInfo(is_sealed,
+                   "OffsetOrderedColumn could not search before seal");
+    }
+
+ private:
+    bool is_sealed = false;
+    std::shared_ptr<VariableColumn<std::string>> column_;
+    // the offsets of the rows ordered by their pks and then the offsets
+    std::vector<uint32_t> offsets_;
+    SplitBlockBloomFilter bloom_filter_;
+    // the ranks of the rows subscripted by the offsets, built on seal
+    std::vector<uint32_t> ranks_;
+    static constexpr int64_t BITSET_BLOCK_BITS = BitsetType::bits_per_block;
 };
 
 template <bool is_sealed = false>
@@ -263,8 +916,13 @@ struct InsertRecord {
     // pks to row offset
     std::unique_ptr<OffsetMap> pk2offset_;
 
-    InsertRecord(const Schema& schema, int64_t size_per_chunk)
-        : row_ids_(size_per_chunk), timestamps_(size_per_chunk) {
+    // the chunks of the columns are allocated from the arena if any
+    InsertRecord(const Schema& schema,
+                 int64_t size_per_chunk,
+                 ChunkArenaPtr arena = nullptr)
+        : timestamps_(size_per_chunk, arena),
+          row_ids_(size_per_chunk, arena),
+          arena_(std::move(arena)) {
         std::optional<FieldId> pk_field_id = schema.get_primary_field_id();
 
         for (auto& field : schema) {
@@ -279,7 +937,7 @@ struct InsertRecord {
                                 std::make_unique<OffsetOrderedArray<int64_t>>();
                         } else {
                             pk2offset_ =
-                                std::make_unique<OffsetOrderedMap<int64_t>>();
+                                std::make_unique<OffsetShardedMap<int64_t>>();
                         }
                         break;
                     }
@@ -289,7 +947,7 @@ struct InsertRecord {
                                 OffsetOrderedArray<std::string>>();
                         } else {
                             pk2offset_ = std::make_unique<
-                                OffsetOrderedMap<std::string>>();
+                                OffsetShardedMap<std::string>>();
                         }
                         break;
                     }
@@ -377,6 +1035,11 @@ struct InsertRecord {
         return pk2offset_->contain(pk);
     }
 
+    std::vector<bool>
+    contain_batch(const std::vector<PkType>& pks) const {
+        return pk2offset_->contain_batch(pks);
+    }
+
     std::vector<SegOffset>
     search_pk(const PkType& pk, Timestamp timestamp) const {
         std::shared_lock lck(shared_mutex_);
@@ -390,17 +1053,35 @@ struct InsertRecord {
         return res_offsets;
     }
 
+    std::vector<std::pair<int64_t, SegOffset>>
+    search_pks(const std::vector<PkType>& pks, Timestamp timestamp) const {
+        std::shared_lock lck(shared_mutex_);
+        std::vector<std::pair<int64_t, SegOffset>> res_offsets;
+        for (auto [i, offset] : pk2offset_->find_batch(pks)) {
+            if (timestamps_[offset] <= timestamp) {
+                res_offsets.emplace_back(i, offset);
+            }
+        }
+        return res_offsets;
+    }
+
+    // the rows are inserted in the order of the offsets if given, a
+    // permutation of the rows
     void
     insert_pks(milvus::DataType data_type,
-               const std::shared_ptr<ColumnBase>& data) {
+               const std::shared_ptr<ColumnBase>& data,
+               const int64_t* order = nullptr) {
         std::lock_guard lck(shared_mutex_);
-        int64_t offset = 0;
+        auto offset_at = [order](int64_t i) {
+            return order != nullptr ? order[i] : i;
+        };
         switch (data_type) {
             case DataType::INT64: {
                 auto column = std::dynamic_pointer_cast<Column>(data);
                 auto pks = reinterpret_cast<const int64_t*>(column->Data());
-                for (int i = 0; i < column->NumRows(); ++i) {
-                    pk2offset_->insert(pks[i], offset++);
+                for (int64_t i = 0; i < column->NumRows(); ++i) {
+                    auto offset = offset_at(i);
+                    pk2offset_->insert(pks[offset], offset);
                 }
                 break;
             }
@@ -408,10 +1089,21 @@ struct InsertRecord {
                 auto column =
                     std::dynamic_pointer_cast<VariableColumn<std::string>>(
                         data);
-                auto pks = column->Views();
-
-                for (int i = 0; i < column->NumRows(); ++i) {
-                    pk2offset_->insert(std::string(pks[i]), offset++);
+                // the sealed pk index references the pks in the column
+                // instead of copying them
+                if constexpr (is_sealed) {
+                    if (pk2offset_->empty() &&
+                        column->NumRows() <=
+                            std::numeric_limits<uint32_t>::max()) {
+                        pk2offset_ = std::make_unique<OffsetOrderedColumn>(
+                            column, order);
+                        break;
+                    }
+                }
+                for (int64_t i = 0; i < column->NumRows(); ++i) {
+                    auto offset = offset_at(i);
+                    pk2offset_->insert(std::string(column->RawAt(offset)),
+                                       offset);
                 }
                 break;
             }
@@ -426,6 +1118,21 @@ struct InsertRecord {
     void
     insert_pks(const std::vector<FieldDataPtr>& field_datas) {
         std::lock_guard lck(shared_mutex_);
+        // the pks loaded into the growing segments are sorted and inserted
+        // at once
+        if constexpr (!is_sealed) {
+            if (!field_datas.empty()) {
+                auto data_type = field_datas[0]->get_data_type();
+                if (data_type == DataType::INT64) {
+                    insert_sorted_pks<int64_t>(field_datas);
+                    return;
+                }
+                if (data_type == DataType::VARCHAR) {
+                    insert_sorted_pks<std::string>(field_datas);
+                    return;
+                }
+            }
+        }
         int64_t offset = 0;
         for (auto& data : field_datas) {
             int64_t row_count = data->get_num_rows();
@@ -456,6 +1163,41 @@ struct InsertRecord {
         }
     }
 
+    template <typename T>
+    void
+    insert_sorted_pks(const std::vector<FieldDataPtr>& field_datas) {
+        int64_t num_rows = 0;
+        for (auto& data : field_datas) {
+            num_rows += data->get_num_rows();
+        }
+        std::vector<std::pair<T, int64_t>> entries;
+        entries.reserve(num_rows);
+        int64_t offset = 0;
+        for (auto& data : field_datas) {
+            for (int64_t i = 0; i < data->get_num_rows(); ++i) {
+                entries.emplace_back(*static_cast<const T*>(data->RawValue(i)),
+                                     offset++);
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        dynamic_cast<OffsetShardedMap<T>&>(*pk2offset_)
+            .insert_sorted(std::move(entries));
+    }
+
+    // batch version of search_pk, the (index of pk, offset) pairs ordered by
+    // the index of pk
+    std::vector<std::pair<int64_t, SegOffset>>
+    search_pks(const std::vector<PkType>& pks, int64_t insert_barrier) const {
+        std::shared_lock lck(shared_mutex_);
+        std::vector<std::pair<int64_t, SegOffset>> res_offsets;
+        for (auto [i, offset] : pk2offset_->find_batch(pks)) {
+            if (offset < insert_barrier) {
+                res_offsets.emplace_back(i, offset);
+            }
+        }
+        return res_offsets;
+    }
+
     std::vector<SegOffset>
     search_pk(const PkType& pk, int64_t insert_barrier) const {
         std::shared_lock lck(shared_mutex_);
@@ -471,8 +1213,13 @@ struct InsertRecord {
 
     void
     insert_pk(const PkType& pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
-        pk2offset_->insert(pk, offset);
+        // the pk index of the growing segments locks its shards itself
+        if constexpr (is_sealed) {
+            std::lock_guard lck(shared_mutex_);
+            pk2offset_->insert(pk, offset);
+        } else {
+            pk2offset_->insert(pk, offset);
+        }
     }
 
     bool
@@ -487,6 +1234,18 @@ struct InsertRecord {
         pk2offset_->seal();
     }
 
+    std::vector<int64_t>
+    pk_sorted_offsets() const {
+        std::shared_lock lck(shared_mutex_);
+        return pk2offset_->sorted_offsets();
+    }
+
+    int64_t
+    pks_byte_size() const {
+        std::shared_lock lck(shared_mutex_);
+        return pk2offset_ != nullptr ? pk2offset_->byte_size() : 0;
+    }
+
     // get field data without knowing the type
     VectorBase*
     get_field_data_base(FieldId field_id) const {
@@ -522,8 +1281,9 @@ struct InsertRecord {
     void
     append_field_data(FieldId field_id, int64_t size_per_chunk) {
         static_assert(IsScalar<Type>);
-        fields_data_.emplace(
-            field_id, std::make_unique<ConcurrentVector<Type>>(size_per_chunk));
+        fields_data_.emplace(field_id,
+                             std::make_unique<ConcurrentVector<Type>>(
+                                 size_per_chunk, arena_));
     }
 
     // append a column of vector type
@@ -533,7 +1293,7 @@ struct InsertRecord {
         static_assert(std::is_base_of_v<VectorTrait, VectorType>);
         fields_data_.emplace(field_id,
                              std::make_unique<ConcurrentVector<VectorType>>(
-                                 dim, size_per_chunk));
+                                 dim, size_per_chunk, arena_));
     }
 
     void
@@ -541,6 +1301,30 @@ struct InsertRecord {
         fields_data_.erase(field_id);
     }
 
+    // the bytes of the memory held by the data of the fields
+    int64_t
+    fields_byte_size() const {
+        int64_t size = 0;
+        for (auto& [field_id, field_data] : fields_data_) {
+            size += field_data->byte_size();
+        }
+        return size;
+    }
+
+    // spill the chunk of the fields to the files named after the prefix, the
+    // chunks too small for maps of their own stay in memory, return the bytes
+    // spilled
+    int64_t
+    spill_chunk(ssize_t chunk_id, const std::string& prefix) {
+        int64_t size = 0;
+        for (auto& [field_id, field_data] : fields_data_) {
+            size += field_data->spill_chunk(
+                chunk_id,
+                fmt::format("{}_{}_{}", prefix, field_id.get(), chunk_id));
+        }
+        return size;
+    }
+
     const ConcurrentVector<Timestamp>&
     timestamps() const {
         return timestamps_;
@@ -552,6 +1336,7 @@ struct InsertRecord {
     }
 
  private:
+    ChunkArenaPtr arena_;
     //    std::vector<std::unique_ptr<VectorBase>> fields_data_;
     std::unordered_map<FieldId, std::unique_ptr<VectorBase>> fields_data_{};
     mutable std::shared_mutex shared_mutex_{};
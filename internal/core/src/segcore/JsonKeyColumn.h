@@ -0,0 +1,352 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "common/Json.h"
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// JsonKeyColumn holds the values of a JSON path extracted from all rows of a
+// sealed JSON field, so that the filters on a hot path read typed arrays
+// instead of parsing every row.
+//
+// The value of a row is valid iff Json::at<T>(pointer) of the row succeeds,
+// T is the type of the column. An INT64 column also keeps the rows that only
+// parse as double, the fallback of the filters comparing with an int64.
+class JsonKeyColumn {
+ public:
+    // the rows of a block share a zone map
+    static constexpr int64_t BLOCK_ROWS = 4096;
+
+    JsonKeyColumn(std::string pointer,
+                  DataType data_type,
+                  const Json* rows,
+                  int64_t num_rows)
+        : pointer_(std::move(pointer)),
+          data_type_(data_type),
+          num_rows_(num_rows),
+          exist_(num_rows),
+          valid_(num_rows) {
+        switch (data_type_) {
+            case DataType::INT64:
+                int64_values_.resize(num_rows);
+                double_valid_.resize(num_rows);
+                double_values_.resize(num_rows);
+                break;
+            case DataType::DOUBLE:
+                double_valid_.resize(num_rows);
+                double_values_.resize(num_rows);
+                break;
+            case DataType::BOOL:
+                bool_values_.resize(num_rows);
+                break;
+            case DataType::VARCHAR:
+                string_offsets_.reserve(num_rows + 1);
+                string_offsets_.push_back(0);
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported json key column type: {}",
+                          data_type_);
+        }
+        for (int64_t i = 0; i < num_rows; ++i) {
+            Extract(rows[i], i);
+        }
+        BuildZoneMaps();
+    }
+
+    const std::string&
+    pointer() const {
+        return pointer_;
+    }
+
+    DataType
+    data_type() const {
+        return data_type_;
+    }
+
+    int64_t
+    num_rows() const {
+        return num_rows_;
+    }
+
+    // whether the column gives the same results as parsing the rows for
+    // the filters comparing with a value of type T
+    template <typename T>
+    bool
+    Serves() const {
+        if constexpr (std::is_same_v<T, int64_t>) {
+            return data_type_ == DataType::INT64;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return data_type_ == DataType::INT64 ||
+                   data_type_ == DataType::DOUBLE;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return data_type_ == DataType::BOOL;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return data_type_ == DataType::VARCHAR;
+        } else {
+            return false;
+        }
+    }
+
+    // Json::exist(pointer) of the row
+    bool
+    Exist(int64_t offset) const {
+        return exist_[offset];
+    }
+
+    bool
+    Valid(int64_t offset) const {
+        return valid_[offset];
+    }
+
+    // only valid for the INT64 columns, the rows failed to parse as int64
+    // but succeeded as double
+    bool
+    DoubleFallbackValid(int64_t offset) const {
+        return data_type_ == DataType::INT64 && double_valid_[offset];
+    }
+
+    int64_t
+    Int64At(int64_t offset) const {
+        return int64_values_[offset];
+    }
+
+    // Json::at<double>(pointer) of the row, for the INT64 and DOUBLE columns
+    bool
+    AsDouble(int64_t offset, double& value) const {
+        if (data_type_ == DataType::INT64 && valid_[offset]) {
+            value = static_cast<double>(int64_values_[offset]);
+            return true;
+        }
+        if (double_valid_[offset]) {
+            value = double_values_[offset];
+            return true;
+        }
+        return false;
+    }
+
+    double
+    DoubleAt(int64_t offset) const {
+        return double_values_[offset];
+    }
+
+    bool
+    BoolAt(int64_t offset) const {
+        return bool_values_[offset];
+    }
+
+    std::string_view
+    StringAt(int64_t offset) const {
+        return std::string_view(
+            string_data_.data() + string_offsets_[offset],
+            string_offsets_[offset + 1] - string_offsets_[offset]);
+    }
+
+    // whether no row of the block matches `x op val`, for the value types
+    // served by the column, see Serves. A missing value or one of another
+    // type matches NotEqual, so NotEqual is never ruled out, and the other
+    // ops only when the zones cover every row of the block
+    template <typename T>
+    bool
+    CanSkipBlock(int64_t block_id, OpType op_type, const T& val) const {
+        if constexpr (std::is_same_v<T, int64_t> ||
+                      std::is_same_v<T, double>) {
+            if (op_type == OpType::NotEqual || zones_.empty()) {
+                return false;
+            }
+            auto& zone = zones_[block_id];
+            auto block_rows =
+                std::min(BLOCK_ROWS, num_rows_ - block_id * BLOCK_ROWS);
+            if (zone.num_values < block_rows) {
+                return false;
+            }
+            bool skip_int64 = true;
+            if (zone.has_int64) {
+                if constexpr (std::is_same_v<T, int64_t>) {
+                    skip_int64 = RangeShouldSkip(
+                        val, zone.int64_min, zone.int64_max, op_type);
+                } else {
+                    skip_int64 =
+                        RangeShouldSkip(val,
+                                        static_cast<double>(zone.int64_min),
+                                        static_cast<double>(zone.int64_max),
+                                        op_type);
+                }
+            }
+            bool skip_double = true;
+            if (zone.has_double) {
+                skip_double = RangeShouldSkip(static_cast<double>(val),
+                                              zone.double_min,
+                                              zone.double_max,
+                                              op_type);
+            }
+            return skip_int64 && skip_double;
+        } else {
+            return false;
+        }
+    }
+
+    int64_t
+    ByteSize() const {
+        return exist_.size() + valid_.size() +
+               int64_values_.size() * sizeof(int64_t) + double_valid_.size() +
+               double_values_.size() * sizeof(double) + bool_values_.size() +
+               string_data_.size() +
+               string_offsets_.size() * sizeof(uint64_t) +
+               zones_.size() * sizeof(Zone);
+    }
+
+ private:
+    void
+    Extract(const Json& row, int64_t i) {
+        exist_[i] = row.exist(pointer_);
+        if (!exist_[i]) {
+            if (data_type_ == DataType::VARCHAR) {
+                string_offsets_.push_back(string_data_.size());
+            }
+            return;
+        }
+        switch (data_type_) {
+            case DataType::INT64: {
+                auto x = row.at<int64_t>(pointer_);
+                if (!x.error()) {
+                    valid_[i] = true;
+                    int64_values_[i] = x.value();
+                    break;
+                }
+                auto y = row.at<double>(pointer_);
+                if (!y.error()) {
+                    double_valid_[i] = true;
+                    double_values_[i] = y.value();
+                }
+                break;
+            }
+            case DataType::DOUBLE: {
+                auto x = row.at<double>(pointer_);
+                if (!x.error()) {
+                    valid_[i] = double_valid_[i] = true;
+                    double_values_[i] = x.value();
+                }
+                break;
+            }
+            case DataType::BOOL: {
+                auto x = row.at<bool>(pointer_);
+                if (!x.error()) {
+                    valid_[i] = true;
+                    bool_values_[i] = x.value();
+                }
+                break;
+            }
+            case DataType::VARCHAR: {
+                auto x = row.at<std::string_view>(pointer_);
+                if (!x.error()) {
+                    valid_[i] = true;
+                    string_data_.append(x.value());
+                }
+                string_offsets_.push_back(string_data_.size());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void
+    BuildZoneMaps() {
+        if (data_type_ != DataType::INT64 && data_type_ != DataType::DOUBLE) {
+            return;
+        }
+        auto num_blocks = (num_rows_ + BLOCK_ROWS - 1) / BLOCK_ROWS;
+        zones_.resize(num_blocks);
+        for (int64_t i = 0; i < num_rows_; ++i) {
+            auto& zone = zones_[i / BLOCK_ROWS];
+            if (data_type_ == DataType::INT64 && valid_[i]) {
+                auto x = int64_values_[i];
+                zone.int64_min =
+                    zone.has_int64 ? std::min(zone.int64_min, x) : x;
+                zone.int64_max =
+                    zone.has_int64 ? std::max(zone.int64_max, x) : x;
+                zone.has_int64 = true;
+                ++zone.num_values;
+            } else if (double_valid_[i]) {
+                auto x = double_values_[i];
+                zone.double_min =
+                    zone.has_double ? std::min(zone.double_min, x) : x;
+                zone.double_max =
+                    zone.has_double ? std::max(zone.double_max, x) : x;
+                zone.has_double = true;
+                ++zone.num_values;
+            }
+        }
+    }
+
+    template <typename T>
+    static bool
+    RangeShouldSkip(const T& value, T lower_bound, T upper_bound, OpType op) {
+        switch (op) {
+            case OpType::Equal:
+                return value > upper_bound || value < lower_bound;
+            case OpType::LessThan:
+                return value <= lower_bound;
+            case OpType::LessEqual:
+                return value < lower_bound;
+            case OpType::GreaterThan:
+                return value >= upper_bound;
+            case OpType::GreaterEqual:
+                return value > upper_bound;
+            default:
+                return false;
+        }
+    }
+
+ private:
+    struct Zone {
+        int64_t int64_min = 0;
+        int64_t int64_max = 0;
+        double double_min = 0;
+        double double_max = 0;
+        bool has_int64 = false;
+        bool has_double = false;
+        // the rows of the block in the int64 or the double zone
+        int64_t num_values = 0;
+    };
+
+    const std::string pointer_;
+    const DataType data_type_;
+    const int64_t num_rows_;
+
+    FixedVector<bool> exist_;
+    FixedVector<bool> valid_;
+    std::vector<int64_t> int64_values_;
+    FixedVector<bool> double_valid_;
+    std::vector<double> double_values_;
+    FixedVector<bool> bool_values_;
+    std::string string_data_;
+    std::vector<uint64_t> string_offsets_;
+    std::vector<Zone> zones_;
+};
+
+using JsonKeyColumnPtr = std::shared_ptr<const JsonKeyColumn>;
+
+}  // namespace milvus::segcore
@@ -0,0 +1,156 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/LoadMemoryManager.h"
+
+#include <algorithm>
+
+#include "common/EasyAssert.h"
+#include "common/LoadInfo.h"
+#include "common/SystemProperty.h"
+#include "knowhere/comp/index_param.h"
+#include "segcore/SegmentInterface.h"
+#include "segcore/Types.h"
+#include "storage/RemoteChunkManagerSingleton.h"
+#include "storage/Util.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the row size of the variable length fields whose average size is unknown
+// before they are loaded, if less than the max length of the strings
+constexpr int64_t ESTIMATED_VARIABLE_ROW_SIZE = 64;
+
+}  // namespace
+
+void
+LoadMemoryManager::SetLimit(int64_t limit_bytes,
+                            std::chrono::milliseconds wait_timeout) {
+    {
+        std::lock_guard lck(mutex_);
+        limit_ = std::max<int64_t>(limit_bytes, 0);
+        wait_timeout_ = std::max(wait_timeout, std::chrono::milliseconds(0));
+    }
+    released_.notify_all();
+}
+
+LoadMemoryManager::Reservation
+LoadMemoryManager::Reserve(int64_t bytes) {
+    std::unique_lock lck(mutex_);
+    auto fits = [&] {
+        return limit_ == 0 || reserved_ + used_ + bytes <= limit_;
+    };
+    if (limit_ > 0 && bytes > limit_) {
+        PanicInfo(MemoryBudgetExceeded,
+                  "load of {} bytes exceeds the memory budget of {} bytes",
+                  bytes,
+                  limit_);
+    }
+    if (!released_.wait_for(lck, wait_timeout_, fits)) {
+        PanicInfo(MemoryBudgetExceeded,
+                  "load of {} bytes exceeds the memory budget, {} bytes of "
+                  "{} reserved and {} bytes used",
+                  bytes,
+                  reserved_,
+                  limit_,
+                  used_);
+    }
+    reserved_ += bytes;
+    return Reservation(this, bytes);
+}
+
+void
+LoadMemoryManager::Unreserve(int64_t bytes) {
+    {
+        std::lock_guard lck(mutex_);
+        reserved_ -= bytes;
+    }
+    released_.notify_all();
+}
+
+void
+LoadMemoryManager::SetUsage(const void* owner, int64_t bytes) {
+    {
+        std::lock_guard lck(mutex_);
+        auto& usage = usages_[owner];
+        used_ += bytes - usage;
+        usage = bytes;
+    }
+    released_.notify_all();
+}
+
+void
+LoadMemoryManager::ReleaseUsage(const void* owner) {
+    {
+        std::lock_guard lck(mutex_);
+        auto it = usages_.find(owner);
+        if (it == usages_.end()) {
+            return;
+        }
+        used_ -= it->second;
+        usages_.erase(it);
+    }
+    released_.notify_all();
+}
+
+int64_t
+LoadMemoryManager::ReservedBytes() const {
+    std::lock_guard lck(mutex_);
+    return reserved_;
+}
+
+int64_t
+LoadMemoryManager::UsedBytes() const {
+    std::lock_guard lck(mutex_);
+    return used_;
+}
+
+int64_t
+EstimateLoadFieldDataBytes(const SegmentInterface& segment,
+                           const LoadFieldDataInfo& load_info) {
+    auto num_rows = static_cast<int64_t>(
+        storage::GetNumRowsForLoadInfo(load_info));
+    int64_t bytes = 0;
+    for (auto& [id, info] : load_info.field_infos) {
+        auto field_id = FieldId(id);
+        auto is_system = SystemProperty::Instance().IsSystem(field_id);
+        if (info.lazy_load || (info.enable_mmap && !is_system)) {
+            continue;
+        }
+        auto row_size = segment.get_field_avg_size(field_id);
+        if (row_size == 0) {
+            row_size = std::min<int64_t>(
+                segment.get_schema()[field_id].get_sizeof(),
+                ESTIMATED_VARIABLE_ROW_SIZE);
+        }
+        bytes += num_rows * row_size;
+    }
+    return bytes;
+}
+
+int64_t
+EstimateLoadIndexBytes(const LoadIndexInfo& load_index_info, bool mmapped) {
+    auto index_type = load_index_info.index_params.find("index_type");
+    if (mmapped || (index_type != load_index_info.index_params.end() &&
+                    index_type->second == knowhere::IndexEnum::INDEX_DISKANN)) {
+        return 0;
+    }
+    auto rcm = storage::RemoteChunkManagerSingleton::GetInstance()
+                   .GetRemoteChunkManager();
+    int64_t bytes = 0;
+    for (auto& file : load_index_info.index_files) {
+        bytes += rcm->Size(file);
+    }
+    return bytes;
+}
+
+}  // namespace milvus::segcore
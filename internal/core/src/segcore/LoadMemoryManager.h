@@ -0,0 +1,108 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+struct LoadFieldDataInfo;
+
+namespace milvus::segcore {
+
+class SegmentInterface;
+struct LoadIndexInfo;
+
+// The memory budget of the loaded data of the process. A load reserves the
+// bytes it's estimated to allocate before allocating them, and the
+// reservation is replaced by the bytes its owner, a segment or an index
+// loaded but not yet added to a segment, actually holds once it's done. The
+// loads wait for the budget up to the wait timeout, and fail with
+// MemoryBudgetExceeded after it, or at once if they'd never fit.
+class LoadMemoryManager {
+ public:
+    static LoadMemoryManager&
+    GetInstance() {
+        static LoadMemoryManager manager;
+        return manager;
+    }
+
+    // 0 is unlimited, and the loads fail at once if wait_timeout is 0
+    void
+    SetLimit(int64_t limit_bytes, std::chrono::milliseconds wait_timeout);
+
+    // the budget reserved in the scope of a load
+    class Reservation {
+     public:
+        Reservation(LoadMemoryManager* manager, int64_t bytes)
+            : manager_(manager), bytes_(bytes) {
+        }
+
+        ~Reservation() {
+            manager_->Unreserve(bytes_);
+        }
+
+        Reservation(const Reservation&) = delete;
+        Reservation&
+        operator=(const Reservation&) = delete;
+
+     private:
+        LoadMemoryManager* manager_;
+        int64_t bytes_;
+    };
+
+    Reservation
+    Reserve(int64_t bytes);
+
+    // set the bytes the owner actually holds, which count against the
+    // budget until released
+    void
+    SetUsage(const void* owner, int64_t bytes);
+
+    void
+    ReleaseUsage(const void* owner);
+
+    int64_t
+    ReservedBytes() const;
+
+    int64_t
+    UsedBytes() const;
+
+ private:
+    LoadMemoryManager() = default;
+
+    void
+    Unreserve(int64_t bytes);
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    int64_t limit_ = 0;
+    std::chrono::milliseconds wait_timeout_{0};
+    int64_t reserved_ = 0;
+    int64_t used_ = 0;
+    std::unordered_map<const void*, int64_t> usages_;
+};
+
+// the bytes the fields of the info are estimated to take in memory once
+// loaded into the segment, the mmapped and the lazily loaded ones excluded
+int64_t
+EstimateLoadFieldDataBytes(const SegmentInterface& segment,
+                           const LoadFieldDataInfo& load_info);
+
+// the bytes the index is estimated to take in memory, the size of its files,
+// 0 if it's mmapped or on disk
+int64_t
+EstimateLoadIndexBytes(const LoadIndexInfo& load_index_info, bool mmapped);
+
+}  // namespace milvus::segcore
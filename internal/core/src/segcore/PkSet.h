@@ -0,0 +1,135 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common/Types.h"
+#include "segcore/BloomFilter.h"
+
+namespace milvus::segcore {
+
+// PkSet is the set of the distinct pks of the results merged for a nq. The
+// int64 pks, chosen once by the pk type of the collection, are kept in an
+// open addressing table of them instead of a hash set of the variants. The
+// slots are stamped by the generation of the set, so clear() doesn't touch
+// them and a set reused for every nq allocates only while growing.
+class PkSet {
+ public:
+    explicit PkSet(DataType pk_type) : int64_pks_(pk_type == DataType::INT64) {
+    }
+
+    void
+    clear() {
+        size_ = 0;
+        if (++generation_ == 0) {
+            std::fill(generations_.begin(), generations_.end(), 0);
+            generation_ = 1;
+        }
+        pk_set_.clear();
+    }
+
+    bool
+    contains(const PkType& pk) const {
+        if (auto int64_pk = std::get_if<int64_t>(&pk); int64_pks_ && int64_pk) {
+            return find_slot(*int64_pk).second;
+        }
+        return pk_set_.count(pk) > 0;
+    }
+
+    // insert the pk, false if it's in the set already
+    bool
+    insert(const PkType& pk) {
+        if (auto int64_pk = std::get_if<int64_t>(&pk); int64_pks_ && int64_pk) {
+            return insert_int64(*int64_pk);
+        }
+        return pk_set_.insert(pk).second;
+    }
+
+ private:
+    bool
+    insert_int64(int64_t pk) {
+        // the load factor is kept at most a half
+        if ((size_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        auto [pos, found] = find_slot(pk);
+        if (found) {
+            return false;
+        }
+        slots_[pos] = pk;
+        generations_[pos] = generation_;
+        ++size_;
+        return true;
+    }
+
+    // the slot of the pk, or the empty one it would be inserted into
+    std::pair<size_t, bool>
+    find_slot(int64_t pk) const {
+        if (slots_.empty()) {
+            return {0, false};
+        }
+        auto pos = HashPk(pk) & mask_;
+        while (generations_[pos] == generation_) {
+            if (slots_[pos] == pk) {
+                return {pos, true};
+            }
+            pos = (pos + 1) & mask_;
+        }
+        return {pos, false};
+    }
+
+    void
+    grow() {
+        std::vector<int64_t> pks;
+        pks.reserve(size_);
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (generations_[i] == generation_) {
+                pks.push_back(slots_[i]);
+            }
+        }
+        auto capacity = std::max<size_t>(MIN_CAPACITY, slots_.size() * 2);
+        slots_.assign(capacity, 0);
+        generations_.assign(capacity, 0);
+        mask_ = capacity - 1;
+        generation_ = 1;
+        size_ = 0;
+        for (auto pk : pks) {
+            auto pos = find_slot(pk).first;
+            slots_[pos] = pk;
+            generations_[pos] = generation_;
+            ++size_;
+        }
+    }
+
+ private:
+    static constexpr size_t MIN_CAPACITY = 64;
+
+    bool int64_pks_;
+    std::vector<int64_t> slots_;
+    // the generation of the set when the slot was filled, the slots of the
+    // other generations are empty
+    std::vector<uint32_t> generations_;
+    uint32_t generation_ = 1;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+
+    // the pks of the other types
+    std::unordered_set<PkType> pk_set_;
+};
+
+}  // namespace milvus::segcore
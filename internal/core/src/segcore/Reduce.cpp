@@ -11,28 +11,40 @@
 
 #include "Reduce.h"
 
+#include <google/protobuf/arena.h>
 #include <log/Log.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <optional>
 #include <vector>
 
 #include "SegmentInterface.h"
 #include "Utils.h"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "pkVisitor.h"
+#include "storage/SearchMetrics.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
+// the nqs merged by a reducing task at least, fewer nqs are merged serially
+constexpr int64_t MIN_NQ_PER_REDUCE_TASK = 64;
+
 void
-ReduceHelper::Initialize() {
-    AssertInfo(search_results_.size() > 0, "empty search result");
+ReduceHelper::Initialize(int64_t total_nq) {
     AssertInfo(slice_nqs_.size() > 0, "empty slice_nqs");
     AssertInfo(slice_nqs_.size() == slice_topKs_.size(),
                "unaligned slice_nqs and slice_topKs");
 
-    total_nq_ = search_results_[0]->total_nq_;
+    total_nq_ = total_nq;
     num_segments_ = search_results_.size();
+    auto pk_field_id = plan_->schema_.get_primary_field_id();
+    AssertInfo(pk_field_id.has_value(), "Primary key is -1");
+    pk_type_ = plan_->schema_[pk_field_id.value()].get_data_type();
     num_slices_ = slice_nqs_.size();
 
     // prefix sum, get slices offsets
@@ -46,6 +58,13 @@ ReduceHelper::Initialize() {
                    std::to_string(slice_nqs_prefix_sum_[num_slices_]) +
                    ", total_nq = " + std::to_string(total_nq_));
 
+    nq_topks_.resize(total_nq_);
+    for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
+        std::fill(nq_topks_.begin() + slice_nqs_prefix_sum_[slice_index],
+                  nq_topks_.begin() + slice_nqs_prefix_sum_[slice_index + 1],
+                  slice_topKs_[slice_index]);
+    }
+
     // init final_search_records and final_read_topKs
     final_search_records_.resize(num_segments_);
     for (auto& search_record : final_search_records_) {
@@ -56,8 +75,132 @@ ReduceHelper::Initialize() {
 void
 ReduceHelper::Reduce() {
     FillPrimaryKey();
+    auto start = std::chrono::steady_clock::now();
     ReduceResultData();
     RefreshSearchResult();
+    auto wall_time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    // the results of all the segment types are reduced together
+    storage::ObserveSearchStage(
+        storage::SearchStage::Reduce, "all", "all", wall_time_us);
+    // the reduce is shared by the results, each of them records it in full
+    for (auto search_result : search_results_) {
+        if (search_result->profile_ != nullptr) {
+            ProfileStage stage;
+            stage.name_ = "reduce";
+            stage.wall_time_us_ = wall_time_us;
+            stage.batches_ = 1;
+            stage.output_rows_ = search_result->get_total_result_count();
+            search_result->profile_->Add(stage);
+        }
+    }
+    FillEntryData();
+}
+
+void
+ReduceHelper::AddSearchResult(SearchResult* search_result) {
+    AssertInfo(search_result != nullptr,
+               "search result must not equal to nullptr");
+    AssertInfo(search_result->total_nq_ == total_nq_,
+               "unaligned nq of search result, nq = {}, expected nq = {}",
+               search_result->total_nq_,
+               total_nq_);
+    CheckCanceled();
+    // the segments filter and fill their own results concurrently
+    FilterInvalidSearchResult(search_result);
+    if (search_result->get_total_result_count() == 0) {
+        return;
+    }
+    auto segment = static_cast<SegmentInterface*>(search_result->segment_);
+    segment->FillPrimaryKeys(plan_, *search_result);
+
+    std::lock_guard<std::mutex> lock(add_mutex_);
+    int64_t segment_index = search_results_.size();
+    search_results_.push_back(search_result);
+    MergeBuffers buffers(pk_type_);
+    for (int64_t qi = 0; qi < total_nq_; qi++) {
+        MergeIntoTopK(qi, segment_index, search_result, buffers);
+    }
+}
+
+void
+ReduceHelper::MergeIntoTopK(int64_t qi,
+                            int64_t segment_index,
+                            SearchResult* search_result,
+                            MergeBuffers& buffers) {
+    auto offset = search_result->topk_per_nq_prefix_sum_[qi];
+    auto offset_end = search_result->topk_per_nq_prefix_sum_[qi + 1];
+    if (offset == offset_end) {
+        return;
+    }
+
+    // both are in order, the results of the segment go first only if they
+    // are better, like popped from the heap of Reduce
+    auto& topk_pairs = topk_pairs_[qi];
+    auto& merged = buffers.pairs;
+    auto& pk_set = buffers.pk_set;
+    merged.clear();
+    pk_set.clear();
+    buffers.group_set.clear();
+    auto topk = nq_topks_[qi];
+    size_t i = 0;
+    while (static_cast<int64_t>(merged.size()) < topk &&
+           (i < topk_pairs.size() || offset < offset_end)) {
+        std::optional<SearchResultPair> pair;
+        if (offset < offset_end) {
+            pair.emplace(search_result->primary_keys_[offset],
+                         search_result->distances_[offset],
+                         search_result,
+                         segment_index,
+                         offset,
+                         offset_end);
+        }
+        if (!pair.has_value() ||
+            (i < topk_pairs.size() && !(*pair > topk_pairs[i]))) {
+            pair.emplace(topk_pairs[i++]);
+        } else {
+            offset++;
+        }
+        // the duplicated pks keep the better result, so do the groups
+        if (!pk_set.contains(pair->primary_key_) &&
+            !IsGroupMerged(*pair, buffers)) {
+            pk_set.insert(pair->primary_key_);
+            merged.push_back(std::move(*pair));
+        }
+    }
+    topk_pairs.swap(merged);
+}
+
+bool
+ReduceHelper::IsGroupMerged(const SearchResultPair& pair,
+                            MergeBuffers& buffers) {
+    auto& group_by_values = pair.search_result_->group_by_values_;
+    if (group_by_values.empty()) {
+        return false;
+    }
+    return !buffers.group_set.insert(group_by_values[pair.offset_]).second;
+}
+
+void
+ReduceHelper::ReduceAddedResults() {
+    std::lock_guard<std::mutex> lock(add_mutex_);
+    num_segments_ = search_results_.size();
+    final_search_records_.resize(num_segments_);
+    for (auto& search_record : final_search_records_) {
+        search_record.resize(total_nq_);
+    }
+
+    std::vector<std::vector<int64_t>> picked(total_nq_);
+    for (int64_t qi = 0; qi < total_nq_; qi++) {
+        for (auto& pair : topk_pairs_[qi]) {
+            picked[qi].push_back(pair.segment_index_);
+            final_search_records_[pair.segment_index_][qi].push_back(
+                pair.offset_);
+        }
+    }
+    LocateResults(picked);
+    RefreshSearchResult();
     FillEntryData();
 }
 
@@ -68,6 +211,7 @@ ReduceHelper::Marshal() {
         std::make_unique<milvus::segcore::SearchResultDataBlobs>();
     search_result_data_blobs_->blobs.resize(num_slices_);
     for (int i = 0; i < num_slices_; i++) {
+        CheckCanceled();
         auto proto = GetSearchResultDataSlice(i);
         search_result_data_blobs_->blobs[i] = proto;
     }
@@ -90,6 +234,8 @@ ReduceHelper::FilterInvalidSearchResult(SearchResult* search_result) {
     auto segment = static_cast<SegmentInterface*>(search_result->segment_);
     auto& offsets = search_result->seg_offsets_;
     auto& distances = search_result->distances_;
+    auto& group_by_values = search_result->group_by_values_;
+    auto grouped = !group_by_values.empty();
     for (auto i = 0; i < nq; ++i) {
         for (auto j = 0; j < topK; ++j) {
             auto index = i * topK + j;
@@ -104,12 +250,19 @@ ReduceHelper::FilterInvalidSearchResult(SearchResult* search_result) {
                 real_topks[i]++;
                 offsets[valid_index] = offsets[index];
                 distances[valid_index] = distances[index];
+                if (grouped) {
+                    group_by_values[valid_index] =
+                        std::move(group_by_values[index]);
+                }
                 valid_index++;
             }
         }
     }
     offsets.resize(valid_index);
     distances.resize(valid_index);
+    if (grouped) {
+        group_by_values.resize(valid_index);
+    }
 
     search_result->topk_per_nq_prefix_sum_.resize(nq + 1);
     std::partial_sum(real_topks.begin(),
@@ -123,6 +276,7 @@ ReduceHelper::FillPrimaryKey() {
     // get primary keys for duplicates removal
     uint32_t valid_index = 0;
     for (auto& search_result : search_results_) {
+        CheckCanceled();
         FilterInvalidSearchResult(search_result);
         LOG_SEGCORE_DEBUG_ << "the size of search result"
                            << search_result->seg_offsets_.size();
@@ -139,32 +293,39 @@ ReduceHelper::FillPrimaryKey() {
 
 void
 ReduceHelper::RefreshSearchResult() {
+    // keep only the picked results, the segments without any of them are
+    // emptied too so that none of their candidates is filled later
     for (int i = 0; i < num_segments_; i++) {
         std::vector<int64_t> real_topks(total_nq_, 0);
         auto search_result = search_results_[i];
-        if (search_result->result_offsets_.size() != 0) {
-            uint32_t size = 0;
-            for (int j = 0; j < total_nq_; j++) {
-                size += final_search_records_[i][j].size();
-            }
-            std::vector<milvus::PkType> primary_keys(size);
-            std::vector<float> distances(size);
-            std::vector<int64_t> seg_offsets(size);
-
-            uint32_t index = 0;
-            for (int j = 0; j < total_nq_; j++) {
-                for (auto offset : final_search_records_[i][j]) {
-                    primary_keys[index] = search_result->primary_keys_[offset];
-                    distances[index] = search_result->distances_[offset];
-                    seg_offsets[index] = search_result->seg_offsets_[offset];
-                    index++;
-                    real_topks[j]++;
+        uint32_t size = 0;
+        for (int j = 0; j < total_nq_; j++) {
+            size += final_search_records_[i][j].size();
+        }
+        std::vector<milvus::PkType> primary_keys(size);
+        std::vector<float> distances(size);
+        std::vector<int64_t> seg_offsets(size);
+        auto grouped = !search_result->group_by_values_.empty();
+        std::vector<GroupByValueType> group_by_values(grouped ? size : 0);
+
+        uint32_t index = 0;
+        for (int j = 0; j < total_nq_; j++) {
+            for (auto offset : final_search_records_[i][j]) {
+                primary_keys[index] = search_result->primary_keys_[offset];
+                distances[index] = search_result->distances_[offset];
+                seg_offsets[index] = search_result->seg_offsets_[offset];
+                if (grouped) {
+                    group_by_values[index] =
+                        search_result->group_by_values_[offset];
                 }
+                index++;
+                real_topks[j]++;
             }
-            search_result->primary_keys_.swap(primary_keys);
-            search_result->distances_.swap(distances);
-            search_result->seg_offsets_.swap(seg_offsets);
         }
+        search_result->primary_keys_.swap(primary_keys);
+        search_result->distances_.swap(distances);
+        search_result->seg_offsets_.swap(seg_offsets);
+        search_result->group_by_values_.swap(group_by_values);
         std::partial_sum(real_topks.begin(),
                          real_topks.end(),
                          search_result->topk_per_nq_prefix_sum_.begin() + 1);
@@ -173,24 +334,41 @@ ReduceHelper::RefreshSearchResult() {
 
 void
 ReduceHelper::FillEntryData() {
+    // the output fields are only fetched for the picked results
     for (auto search_result : search_results_) {
+        if (search_result->seg_offsets_.empty()) {
+            continue;
+        }
+        CheckCanceled();
         auto segment = static_cast<milvus::segcore::SegmentInterface*>(
             search_result->segment_);
         segment->FillTargetEntry(plan_, *search_result);
     }
 }
 
+void
+ReduceHelper::CheckCanceled() const {
+    if (plan_->plan_node_ != nullptr) {
+        CheckCancellation(plan_->plan_node_->search_info_.cancellation_token_);
+    }
+}
+
 int64_t
 ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
                                          int64_t topk,
-                                         int64_t& offset) {
-    while (!heap_.empty()) {
-        heap_.pop();
+                                         MergeBuffers& buffers,
+                                         std::vector<int64_t>& picked) {
+    auto& heap = buffers.heap;
+    auto& pk_set = buffers.pk_set;
+    auto& pairs = buffers.pairs;
+    while (!heap.empty()) {
+        heap.pop();
     }
-    pk_set_.clear();
-    pairs_.clear();
+    pk_set.clear();
+    buffers.group_set.clear();
+    pairs.clear();
 
-    pairs_.reserve(num_segments_);
+    pairs.reserve(num_segments_);
     for (int i = 0; i < num_segments_; i++) {
         auto search_result = search_results_[i];
         auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
@@ -201,40 +379,39 @@ ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
         auto primary_key = search_result->primary_keys_[offset_beg];
         auto distance = search_result->distances_[offset_beg];
 
-        pairs_.emplace_back(
+        pairs.emplace_back(
             primary_key, distance, search_result, i, offset_beg, offset_end);
-        heap_.push(&pairs_.back());
+        heap.push(&pairs.back());
     }
 
     // nq has no results for all segments
-    if (heap_.size() == 0) {
+    if (heap.size() == 0) {
         return 0;
     }
 
     int64_t dup_cnt = 0;
-    auto start = offset;
-    while (offset - start < topk && !heap_.empty()) {
-        auto pilot = heap_.top();
-        heap_.pop();
+    while (static_cast<int64_t>(picked.size()) < topk && !heap.empty()) {
+        auto pilot = heap.top();
+        heap.pop();
 
         auto index = pilot->segment_index_;
-        auto pk = pilot->primary_key_;
+        const auto& pk = pilot->primary_key_;
         // no valid search result for this nq, break to next
         if (pk == INVALID_PK) {
             break;
         }
-        // remove duplicates
-        if (pk_set_.count(pk) == 0) {
-            pilot->search_result_->result_offsets_.push_back(offset++);
+        // remove duplicates, and the results of the groups picked already
+        if (!pk_set.contains(pk) && !IsGroupMerged(*pilot, buffers)) {
+            picked.push_back(index);
             final_search_records_[index][qi].push_back(pilot->offset_);
-            pk_set_.insert(pk);
+            pk_set.insert(pk);
         } else {
-            // skip entity with same primary key
+            // skip entity with same primary key or of a picked group
             dup_cnt++;
         }
         pilot->advance();
         if (pilot->primary_key_ != INVALID_PK) {
-            heap_.push(pilot);
+            heap.push(pilot);
         }
     }
     return dup_cnt;
@@ -255,24 +432,73 @@ ReduceHelper::ReduceResultData() {
                    "incorrect search result primary key size");
     }
 
-    int64_t skip_dup_cnt = 0;
-    for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
-        auto nq_begin = slice_nqs_prefix_sum_[slice_index];
-        auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
-
-        // reduce search results
-        int64_t offset = 0;
+    // the nqs are merged independently, each task merges a contiguous range
+    // of them with its own buffers
+    std::vector<std::vector<int64_t>> picked(total_nq_);
+    auto reduce_nqs = [&](int64_t nq_begin, int64_t nq_end) {
+        MergeBuffers buffers(pk_type_);
+        int64_t dup_cnt = 0;
         for (int64_t qi = nq_begin; qi < nq_end; qi++) {
-            skip_dup_cnt += ReduceSearchResultForOneNQ(
-                qi, slice_topKs_[slice_index], offset);
+            CheckCanceled();
+            dup_cnt += ReduceSearchResultForOneNQ(
+                qi, nq_topks_[qi], buffers, picked[qi]);
+        }
+        return dup_cnt;
+    };
+
+    int64_t skip_dup_cnt = 0;
+    auto task_num =
+        std::min<int64_t>(total_nq_ / MIN_NQ_PER_REDUCE_TASK, CPU_NUM);
+    if (task_num <= 1) {
+        skip_dup_cnt = reduce_nqs(0, total_nq_);
+    } else {
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        std::vector<std::future<int64_t>> futures;
+        futures.reserve(task_num);
+        try {
+            for (int64_t i = 0; i < task_num; ++i) {
+                futures.emplace_back(
+                    pool.Submit(reduce_nqs,
+                                total_nq_ * i / task_num,
+                                total_nq_ * (i + 1) / task_num));
+            }
+            for (auto& future : futures) {
+                skip_dup_cnt += future.get();
+            }
+        } catch (...) {
+            // the tasks reference the locals, wait for them before unwinding
+            for (auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
         }
     }
+
+    LocateResults(picked);
     if (skip_dup_cnt > 0) {
         LOG_SEGCORE_DEBUG_ << "skip duplicated search result, count = "
                            << skip_dup_cnt;
     }
 }
 
+void
+ReduceHelper::LocateResults(const std::vector<std::vector<int64_t>>& picked) {
+    // the results of a slice are located in the order of their nqs
+    for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
+        int64_t offset = 0;
+        for (int64_t qi = slice_nqs_prefix_sum_[slice_index];
+             qi < slice_nqs_prefix_sum_[slice_index + 1];
+             qi++) {
+            for (auto index : picked[qi]) {
+                search_results_[index]->result_offsets_.push_back(offset++);
+            }
+        }
+    }
+}
+
 std::vector<char>
 ReduceHelper::GetSearchResultDataSlice(int slice_index) {
     auto nq_begin = slice_nqs_prefix_sum_[slice_index];
@@ -287,8 +513,32 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
                         search_result->topk_per_nq_prefix_sum_[nq_begin];
     }
 
-    auto search_result_data =
-        std::make_unique<milvus::proto::schema::SearchResultData>();
+    // the message and its repeated fields are allocated in an arena, whose
+    // first block is sized for the ids, the scores and the output fields of
+    // the results
+    auto primary_field_id =
+        plan_->schema_.get_primary_field_id().value_or(milvus::FieldId(-1));
+    AssertInfo(primary_field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    auto pk_type = plan_->schema_[primary_field_id].get_data_type();
+    auto row_bytes_of = [](const FieldMeta& field_meta) {
+        if (datatype_is_variable(field_meta.get_data_type())) {
+            return sizeof(std::string) + sizeof(void*);
+        }
+        return field_meta.get_sizeof();
+    };
+    auto row_bytes =
+        sizeof(float) + row_bytes_of(plan_->schema_[primary_field_id]);
+    for (auto field_id : plan_->target_entries_) {
+        row_bytes += row_bytes_of(plan_->schema_[field_id]);
+    }
+    google::protobuf::ArenaOptions arena_options;
+    arena_options.start_block_size = std::max(
+        arena_options.start_block_size, size_t(result_count) * row_bytes);
+    arena_options.max_block_size =
+        std::max(arena_options.max_block_size, arena_options.start_block_size);
+    google::protobuf::Arena arena(arena_options);
+    auto search_result_data = google::protobuf::Arena::CreateMessage<
+        milvus::proto::schema::SearchResultData>(&arena);
     // set unify_topK and total_nq
     search_result_data->set_top_k(slice_topKs_[slice_index]);
     search_result_data->set_num_queries(nq_end - nq_begin);
@@ -298,25 +548,24 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
     std::vector<std::pair<SearchResult*, int64_t>> result_pairs(result_count);
 
     // reserve space for pks
-    auto primary_field_id =
-        plan_->schema_.get_primary_field_id().value_or(milvus::FieldId(-1));
-    AssertInfo(primary_field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
-    auto pk_type = plan_->schema_[primary_field_id].get_data_type();
+    google::protobuf::RepeatedField<int64_t>* int_ids = nullptr;
+    google::protobuf::RepeatedPtrField<std::string>* str_ids = nullptr;
     switch (pk_type) {
         case milvus::DataType::INT64: {
-            auto ids = std::make_unique<milvus::proto::schema::LongArray>();
-            ids->mutable_data()->Resize(result_count, 0);
-            search_result_data->mutable_ids()->set_allocated_int_id(
-                ids.release());
+            int_ids = search_result_data->mutable_ids()
+                          ->mutable_int_id()
+                          ->mutable_data();
+            int_ids->Resize(result_count, 0);
             break;
         }
         case milvus::DataType::VARCHAR: {
-            auto ids = std::make_unique<milvus::proto::schema::StringArray>();
-            std::vector<std::string> string_pks(result_count);
-            // TODO: prevent mem copy
-            *ids->mutable_data() = {string_pks.begin(), string_pks.end()};
-            search_result_data->mutable_ids()->set_allocated_str_id(
-                ids.release());
+            str_ids = search_result_data->mutable_ids()
+                          ->mutable_str_id()
+                          ->mutable_data();
+            str_ids->Reserve(result_count);
+            for (int64_t i = 0; i < result_count; i++) {
+                str_ids->Add();
+            }
             break;
         }
         default: {
@@ -327,6 +576,7 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
 
     // reserve space for distances
     search_result_data->mutable_scores()->Resize(result_count, 0);
+    auto scores = search_result_data->mutable_scores()->mutable_data();
 
     // fill pks and distances
     for (auto qi = nq_begin; qi < nq_end; qi++) {
@@ -349,34 +599,17 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
                                std::to_string(loc) + ", result_count = " +
                                std::to_string(result_count));
                 // set result pks
-                switch (pk_type) {
-                    case milvus::DataType::INT64: {
-                        search_result_data->mutable_ids()
-                            ->mutable_int_id()
-                            ->mutable_data()
-                            ->Set(loc,
-                                  std::visit(Int64PKVisitor{},
-                                             search_result->primary_keys_[ki]));
-                        break;
-                    }
-                    case milvus::DataType::VARCHAR: {
-                        *search_result_data->mutable_ids()
-                             ->mutable_str_id()
-                             ->mutable_data()
-                             ->Mutable(loc) = std::visit(
-                            StrPKVisitor{}, search_result->primary_keys_[ki]);
-                        break;
-                    }
-                    default: {
-                        PanicInfo(DataTypeInvalid,
-                                  fmt::format("unsupported primary key type {}",
-                                              pk_type));
-                    }
+                if (int_ids != nullptr) {
+                    int_ids->Set(loc,
+                                 std::visit(Int64PKVisitor{},
+                                            search_result->primary_keys_[ki]));
+                } else {
+                    *str_ids->Mutable(loc) = std::visit(
+                        StrPKVisitor{}, search_result->primary_keys_[ki]);
                 }
 
                 // set result distances
-                search_result_data->mutable_scores()->Set(
-                    loc, search_result->distances_[ki]);
+                scores[loc] = search_result->distances_[ki];
                 // set result offset to fill output fields data
                 result_pairs[loc] = std::make_pair(search_result, ki);
             }
@@ -394,16 +627,14 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
     // set output fields
     for (auto field_id : plan_->target_entries_) {
         auto& field_meta = plan_->schema_[field_id];
-        auto field_data =
-            milvus::segcore::MergeDataArray(result_pairs, field_meta);
+        auto field_data = search_result_data->add_fields_data();
+        milvus::segcore::MergeDataArray(result_pairs, field_meta, field_data);
         if (field_meta.get_data_type() == DataType::ARRAY) {
             field_data->mutable_scalars()
                 ->mutable_array_data()
                 ->set_element_type(
                     proto::schema::DataType(field_meta.get_element_type()));
         }
-        search_result_data->mutable_fields_data()->AddAllocated(
-            field_data.release());
     }
 
     // SearchResultData to blob
@@ -14,14 +14,18 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <vector>
 #include <queue>
 #include <unordered_set>
 
 #include "common/type_c.h"
+#include "common/EasyAssert.h"
 #include "common/QueryResult.h"
 #include "query/PlanImpl.h"
 #include "ReduceStructure.h"
+#include "segcore/PkSet.h"
 
 namespace milvus::segcore {
 
@@ -41,12 +45,37 @@ class ReduceHelper {
           plan_(plan),
           slice_nqs_(slice_nqs, slice_nqs + slice_num),
           slice_topKs_(slice_topKs, slice_topKs + slice_num) {
-        Initialize();
+        AssertInfo(search_results_.size() > 0, "empty search result");
+        Initialize(search_results_[0]->total_nq_);
+    }
+
+    // the helper reducing the search results added one by one by
+    // AddSearchResult, and then by ReduceAddedResults
+    explicit ReduceHelper(milvus::query::Plan* plan,
+                          int64_t* slice_nqs,
+                          int64_t* slice_topKs,
+                          int64_t slice_num)
+        : plan_(plan),
+          slice_nqs_(slice_nqs, slice_nqs + slice_num),
+          slice_topKs_(slice_topKs, slice_topKs + slice_num) {
+        AssertInfo(slice_num > 0, "empty slice_nqs is not allowed");
+        Initialize(std::accumulate(
+            slice_nqs_.begin(), slice_nqs_.end(), int64_t(0)));
+        topk_pairs_.resize(total_nq_);
     }
 
     void
     Reduce();
 
+    // merge the search result of a segment into the top-K of every nq, the
+    // results can be added concurrently, and must outlive the helper
+    void
+    AddSearchResult(SearchResult* search_result);
+
+    // reduce the added search results as Reduce does
+    void
+    ReduceAddedResults();
+
     void
     Marshal();
 
@@ -57,7 +86,7 @@ class ReduceHelper {
 
  private:
     void
-    Initialize();
+    Initialize(int64_t total_nq);
 
     void
     FilterInvalidSearchResult(SearchResult* search_result);
@@ -71,20 +100,65 @@ class ReduceHelper {
     void
     FillEntryData();
 
+    // the buffers of merging the results of the segments for a nq, every
+    // reducing task has its own
+    struct MergeBuffers {
+        explicit MergeBuffers(DataType pk_type) : pk_set(pk_type) {
+        }
+
+        std::vector<SearchResultPair> pairs;
+        std::priority_queue<SearchResultPair*,
+                            std::vector<SearchResultPair*>,
+                            SearchResultPairComparator>
+            heap;
+        PkSet pk_set;
+        // the groups of the merged results of a grouped search
+        std::unordered_set<milvus::GroupByValueType> group_set;
+    };
+
+    // whether the result is of a group merged already, and if not, take the
+    // group as merged, the results of a search without grouping are of no
+    // groups
+    static bool
+    IsGroupMerged(const SearchResultPair& pair, MergeBuffers& buffers);
+
+    // merge the results of the nq into final_search_records_, the segment
+    // indexes of the merged results are appended to picked in order, return
+    // the count of the duplicated results
     int64_t
     ReduceSearchResultForOneNQ(int64_t qi,
                                int64_t topk,
-                               int64_t& result_offset);
+                               MergeBuffers& buffers,
+                               std::vector<int64_t>& picked);
 
     void
     ReduceResultData();
 
+    // locate the picked results of every nq in the results of the slices,
+    // picked holds the segment indexes of the results of the nqs in order
+    void
+    LocateResults(const std::vector<std::vector<int64_t>>& picked);
+
+    // merge the results of the nq of the segment into topk_pairs_[qi]
+    void
+    MergeIntoTopK(int64_t qi,
+                  int64_t segment_index,
+                  SearchResult* search_result,
+                  MergeBuffers& buffers);
+
     std::vector<char>
     GetSearchResultDataSlice(int slice_index_);
 
+    // throw Canceled if the search is canceled, checked between the segments
+    // and the nqs
+    void
+    CheckCanceled() const;
+
  private:
-    std::vector<SearchResult*>& search_results_;
+    std::vector<SearchResult*> search_results_;
     milvus::query::Plan* plan_;
+    // the data type of the pks, which the pk sets of merging are chosen by
+    DataType pk_type_;
 
     std::vector<int64_t> slice_nqs_;
     std::vector<int64_t> slice_topKs_;
@@ -93,21 +167,19 @@ class ReduceHelper {
     int64_t num_slices_;
 
     std::vector<int64_t> slice_nqs_prefix_sum_;
+    // the topK of the slice of every nq
+    std::vector<int64_t> nq_topks_;
+
+    // the results added by AddSearchResult, the best ones of every nq with
+    // distinct pks in order
+    std::mutex add_mutex_;
+    std::vector<std::vector<SearchResultPair>> topk_pairs_;
 
     // dim0: num_segments_; dim1: total_nq_; dim2: offset
     std::vector<std::vector<std::vector<int64_t>>> final_search_records_;
 
     // output
     std::unique_ptr<SearchResultDataBlobs> search_result_data_blobs_;
-
-    // Used for merge results,
-    // define these here to avoid allocating them for each query
-    std::vector<SearchResultPair> pairs_;
-    std::priority_queue<SearchResultPair*,
-                        std::vector<SearchResultPair*>,
-                        SearchResultPairComparator>
-        heap_;
-    std::unordered_set<milvus::PkType> pk_set_;
 };
 
 }  // namespace milvus::segcore
@@ -62,6 +62,16 @@ struct SealedIndexingRecord {
         return field_indexings_.count(field_id);
     }
 
+    int64_t
+    byte_size() const {
+        std::shared_lock lck(mutex_);
+        int64_t size = 0;
+        for (auto& [field_id, entry] : field_indexings_) {
+            size += entry->indexing_->ByteSize();
+        }
+        return size;
+    }
+
  private:
     // field_offset -> SealedIndexingEntry
     std::unordered_map<FieldId, SealedIndexingEntryPtr> field_indexings_;
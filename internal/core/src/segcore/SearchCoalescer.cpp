@@ -0,0 +1,198 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "segcore/SearchCoalescer.h"
+
+#include <algorithm>
+
+#include "common/CancellationToken.h"
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "query/PlanCache.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::segcore {
+
+void
+SearchCoalescer::SetWindow(std::chrono::microseconds window,
+                           int64_t max_queries) {
+    AssertInfo(window.count() >= 0 && max_queries >= 0,
+               "invalid search coalesce window {}us or max queries {}",
+               window.count(),
+               max_queries);
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_ = window;
+    max_queries_ = max_queries;
+    LOG_SEGCORE_INFO_ << "set search coalesce window: " << window.count()
+                      << "us, max queries: " << max_queries;
+}
+
+bool
+SearchCoalescer::Coalescable(const query::Plan* plan,
+                             const query::PlaceholderGroup* placeholder_group) {
+    auto& node = *plan->plan_node_;
+    return !plan->serialized_.empty() && node.sub_searches_.empty() &&
+           !node.search_info_.group_by_field_id_.has_value() &&
+           !node.search_info_.profile_ && placeholder_group->size() == 1;
+}
+
+std::unique_ptr<SearchResult>
+SearchCoalescer::Search(const SegmentInterface& segment,
+                        const query::Plan* plan,
+                        const query::PlaceholderGroup* placeholder_group) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (window_.count() == 0 || !Coalescable(plan, placeholder_group)) {
+        lock.unlock();
+        return segment.Search(plan, placeholder_group);
+    }
+    auto num_queries = placeholder_group->at(0).num_of_queries_;
+    if (max_queries_ > 0 && num_queries >= max_queries_) {
+        lock.unlock();
+        return segment.Search(plan, placeholder_group);
+    }
+
+    Request request{plan, placeholder_group};
+    auto finish = [&request] {
+        if (request.error != nullptr) {
+            std::rethrow_exception(request.error);
+        }
+        return std::move(request.result);
+    };
+    Key key(&segment, plan->serialized_);
+    auto iter = open_batches_.find(key);
+    if (iter != open_batches_.end() &&
+        (max_queries_ == 0 ||
+         iter->second->num_queries + num_queries <= max_queries_)) {
+        // join the batch, which is closed once it's full
+        auto& batch = *iter->second;
+        batch.requests.push_back(&request);
+        batch.num_queries += num_queries;
+        if (max_queries_ > 0 && batch.num_queries >= max_queries_) {
+            open_batches_.erase(iter);
+        }
+        ++coalesced_count_;
+        cond_.notify_all();
+        cond_.wait(lock, [&request] { return request.done; });
+        return finish();
+    }
+
+    // lead a new batch, the full one is left to its leader
+    auto batch = std::make_shared<Batch>();
+    batch->requests.push_back(&request);
+    batch->num_queries = num_queries;
+    open_batches_[key] = batch;
+    auto max_queries = max_queries_;
+    cond_.wait_for(lock, window_, [&] {
+        return max_queries > 0 && batch->num_queries >= max_queries;
+    });
+    iter = open_batches_.find(key);
+    if (iter != open_batches_.end() && iter->second == batch) {
+        open_batches_.erase(iter);
+    }
+    lock.unlock();
+
+    // no search joins the batch once it's closed
+    SearchBatch(segment, *batch);
+
+    lock.lock();
+    for (auto joined : batch->requests) {
+        joined->done = true;
+    }
+    lock.unlock();
+    cond_.notify_all();
+    return finish();
+}
+
+void
+SearchCoalescer::SearchBatch(const SegmentInterface& segment, Batch& batch) {
+    // the canceled searches fail apart, so they don't fail the others
+    std::vector<Request*> requests;
+    for (auto request : batch.requests) {
+        try {
+            CheckCancellation(
+                request->plan->plan_node_->search_info_.cancellation_token_);
+            requests.push_back(request);
+        } catch (...) {
+            request->error = std::current_exception();
+        }
+    }
+    if (requests.size() == 1) {
+        auto request = requests[0];
+        try {
+            request->result =
+                segment.Search(request->plan, request->placeholder_group);
+        } catch (...) {
+            request->error = std::current_exception();
+        }
+        return;
+    }
+    if (requests.empty()) {
+        return;
+    }
+
+    try {
+        // the merged search is canceled by none of the searches
+        auto plan = query::CopyPlan(*requests[0]->plan);
+        plan->plan_node_->search_info_.cancellation_token_ = nullptr;
+        auto& first = requests[0]->placeholder_group->at(0);
+        query::Placeholder merged;
+        merged.tag_ = first.tag_;
+        merged.line_sizeof_ = first.line_sizeof_;
+        merged.num_of_queries_ = 0;
+        for (auto request : requests) {
+            auto& placeholder = request->placeholder_group->at(0);
+            merged.num_of_queries_ += placeholder.num_of_queries_;
+            merged.blob_.insert(merged.blob_.end(),
+                                placeholder.blob_.begin(),
+                                placeholder.blob_.end());
+        }
+        query::PlaceholderGroup placeholder_group;
+        placeholder_group.emplace_back(std::move(merged));
+        // the adaptive search observes the latency of the merged search once
+        // for the batch, and the effort it adapted applies to all the parts
+        auto result = segment.Search(plan.get(), &placeholder_group);
+
+        auto topk = result->unity_topK_;
+        AssertInfo(result->total_nq_ ==
+                           placeholder_group[0].num_of_queries_ &&
+                       result->seg_offsets_.size() ==
+                           size_t(result->total_nq_ * topk),
+                   "unexpected coalesced search result of {} queries",
+                   result->total_nq_);
+        int64_t begin = 0;
+        for (auto request : requests) {
+            auto num_queries =
+                request->placeholder_group->at(0).num_of_queries_;
+            auto part = std::make_unique<SearchResult>();
+            part->total_nq_ = num_queries;
+            part->unity_topK_ = topk;
+            part->segment_ = result->segment_;
+            part->profile_ = result->profile_;
+            part->adapted_search_params_ = result->adapted_search_params_;
+            part->seg_offsets_.assign(
+                result->seg_offsets_.begin() + begin * topk,
+                result->seg_offsets_.begin() + (begin + num_queries) * topk);
+            part->distances_.assign(
+                result->distances_.begin() + begin * topk,
+                result->distances_.begin() + (begin + num_queries) * topk);
+            request->result = std::move(part);
+            begin += num_queries;
+        }
+    } catch (...) {
+        for (auto request : requests) {
+            request->result = nullptr;
+            request->error = std::current_exception();
+        }
+    }
+}
+
+}  // namespace milvus::segcore
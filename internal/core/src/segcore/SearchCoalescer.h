@@ -0,0 +1,102 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/QueryResult.h"
+#include "query/PlanImpl.h"
+
+namespace milvus::segcore {
+
+class SegmentInterface;
+
+// SearchCoalescer merges the concurrent searches on a segment whose plans
+// are serialized the same, which share the vector field, the metric, the
+// topk, the search params and the filter, into one search of all their
+// queries, so the filter, the bitset and the index call are paid once
+// instead of once per search. The results are split back per search.
+//
+// The first search of a batch waits for the window for the others to join,
+// or until the batch has max_queries queries, then searches for all of them.
+// The hybrid, grouped and profiled searches are never coalesced.
+class SearchCoalescer {
+ public:
+    static SearchCoalescer&
+    GetInstance() {
+        static SearchCoalescer instance;
+        return instance;
+    }
+
+    // a window of 0 disables the coalescing
+    void
+    SetWindow(std::chrono::microseconds window, int64_t max_queries);
+
+    std::unique_ptr<SearchResult>
+    Search(const SegmentInterface& segment,
+           const query::Plan* plan,
+           const query::PlaceholderGroup* placeholder_group);
+
+    // the searches coalesced into the batches of others so far
+    int64_t
+    coalesced_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return coalesced_count_;
+    }
+
+ private:
+    SearchCoalescer() = default;
+
+    struct Request {
+        const query::Plan* plan;
+        const query::PlaceholderGroup* placeholder_group;
+        std::unique_ptr<SearchResult> result;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    struct Batch {
+        std::vector<Request*> requests;
+        int64_t num_queries = 0;
+    };
+
+    using Key = std::pair<const SegmentInterface*, std::string>;
+
+    static bool
+    Coalescable(const query::Plan* plan,
+                const query::PlaceholderGroup* placeholder_group);
+
+    // search for all the requests of the batch, set their results or errors
+    static void
+    SearchBatch(const SegmentInterface& segment, Batch& batch);
+
+ private:
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::chrono::microseconds window_{0};
+    int64_t max_queries_ = 0;
+    // the batches the searches may still join
+    std::map<Key, std::shared_ptr<Batch>> open_batches_;
+    int64_t coalesced_count_ = 0;
+};
+
+}  // namespace milvus::segcore
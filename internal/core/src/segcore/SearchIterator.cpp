@@ -0,0 +1,98 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "segcore/SearchIterator.h"
+
+#include <utility>
+
+#include "common/EasyAssert.h"
+
+namespace milvus::segcore {
+
+SearchIterator::SearchIterator(const SegmentInternalInterface& segment,
+                               const query::Plan& plan,
+                               const query::PlaceholderGroup& placeholder_group)
+    : segment_(segment), search_info_(plan.plan_node_->search_info_) {
+    AssertInfo(placeholder_group.size() == 1 &&
+                   placeholder_group[0].num_of_queries_ == 1,
+               "search iterator searches a single query");
+    AssertInfo(plan.plan_node_->sub_searches_.empty() &&
+                   !search_info_.group_by_field_id_.has_value(),
+               "search iterator can't be of a grouped or hybrid search");
+    query_ = placeholder_group[0].blob_;
+    filtered_ = segment.SearchFilter(&plan, MAX_TIMESTAMP);
+    remaining_ = filtered_.size() - filtered_.count();
+}
+
+std::unique_ptr<SearchResult>
+SearchIterator::Next(int64_t batch_size) {
+    AssertInfo(batch_size > 0, "invalid batch size {}", batch_size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto search_info = search_info_;
+    search_info.topk_ = batch_size;
+    auto results = segment_.SearchFiltered(
+        search_info, query_.data(), 1, MAX_TIMESTAMP, filtered_);
+    for (auto offset : results->seg_offsets_) {
+        if (offset != INVALID_SEG_OFFSET && !filtered_[offset]) {
+            filtered_.set(offset);
+            --remaining_;
+        }
+    }
+    return results;
+}
+
+int64_t
+SearchIteratorManager::Add(std::unique_ptr<SearchIterator> iterator,
+                           int64_t ttl_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    RemoveExpired(now);
+    auto id = next_id_++;
+    iterators_.emplace(id,
+                       Entry{std::move(iterator),
+                             std::chrono::milliseconds(ttl_ms),
+                             now});
+    return id;
+}
+
+std::shared_ptr<SearchIterator>
+SearchIteratorManager::Get(int64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    RemoveExpired(now);
+    auto it = iterators_.find(id);
+    if (it == iterators_.end()) {
+        return nullptr;
+    }
+    it->second.last_used_ = now;
+    return it->second.iterator_;
+}
+
+void
+SearchIteratorManager::Remove(int64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    iterators_.erase(id);
+}
+
+void
+SearchIteratorManager::RemoveExpired(Clock::time_point now) {
+    for (auto it = iterators_.begin(); it != iterators_.end();) {
+        auto& entry = it->second;
+        if (entry.ttl_.count() > 0 && now - entry.last_used_ > entry.ttl_) {
+            it = iterators_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace milvus::segcore
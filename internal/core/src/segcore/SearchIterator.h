@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/QueryInfo.h"
+#include "common/QueryResult.h"
+#include "common/Types.h"
+#include "query/PlanImpl.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::segcore {
+
+// SearchIterator returns the results of a search on a segment a batch at a
+// time. The filter of the search is evaluated once as it's created, then the
+// rows returned are added to the filter, so a batch costs a search of its
+// own size however many batches are returned before it, instead of the
+// offset + limit results of a page.
+//
+// The rows are of the segment as it's created, the rows inserted or deleted
+// later aren't seen. It searches a single query, the segment must outlive it.
+class SearchIterator {
+ public:
+    SearchIterator(const SegmentInternalInterface& segment,
+                   const query::Plan& plan,
+                   const query::PlaceholderGroup& placeholder_group);
+
+    // the next batch_size results in the order of the search, fewer once the
+    // rows are exhausted
+    std::unique_ptr<SearchResult>
+    Next(int64_t batch_size);
+
+    const MetricType&
+    metric_type() const {
+        return search_info_.metric_type_;
+    }
+
+    // the number of the rows not returned yet
+    int64_t
+    remaining() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return remaining_;
+    }
+
+ private:
+    const SegmentInternalInterface& segment_;
+    SearchInfo search_info_;
+    aligned_vector<char> query_;
+    mutable std::mutex mutex_;
+    // the rows filtered out by the search and the rows returned
+    BitsetType filtered_;
+    int64_t remaining_ = 0;
+};
+
+// SearchIteratorManager names the search iterators by ids for the C API. An
+// iterator not used for its ttl is deleted, the expired ones are swept when
+// an iterator is added or got, the ones being used are deleted once they're
+// done.
+class SearchIteratorManager {
+ public:
+    static SearchIteratorManager&
+    GetInstance() {
+        static SearchIteratorManager manager;
+        return manager;
+    }
+
+    // never expires if ttl_ms is 0
+    int64_t
+    Add(std::unique_ptr<SearchIterator> iterator, int64_t ttl_ms);
+
+    // the iterator of the id, nullptr if it's removed or expired
+    std::shared_ptr<SearchIterator>
+    Get(int64_t id);
+
+    void
+    Remove(int64_t id);
+
+    int64_t
+    size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return iterators_.size();
+    }
+
+ private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::shared_ptr<SearchIterator> iterator_;
+        std::chrono::milliseconds ttl_;
+        Clock::time_point last_used_;
+    };
+
+    void
+    RemoveExpired(Clock::time_point now);
+
+ private:
+    mutable std::mutex mutex_;
+    int64_t next_id_ = 1;
+    std::unordered_map<int64_t, Entry> iterators_;
+};
+
+}  // namespace milvus::segcore
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -73,11 +74,254 @@ class SegcoreConfig {
         return enable_interim_segment_index_;
     }
 
+    // the interim index of a sealed segment is built in the low priority
+    // pool while the raw vectors are searched by brute force, instead of
+    // delaying the load
+    void
+    set_async_interim_index_build(bool async) {
+        async_interim_index_build_ = async;
+    }
+
+    bool
+    get_async_interim_index_build() const {
+        return async_interim_index_build_;
+    }
+
+    // the threads training and adding to the interim index of a sealed
+    // segment
+    void
+    set_interim_index_build_threads(int64_t threads) {
+        interim_index_build_threads_ = std::max<int64_t>(threads, 1);
+    }
+
+    int64_t
+    get_interim_index_build_threads() const {
+        return interim_index_build_threads_;
+    }
+
+    // the codes of the interim index of growing segments, empty for the
+    // float32 vectors, "SQ8" or "FP16" for the quantized ones
+    void
+    set_interim_index_quantization(const std::string& quantization) {
+        interim_index_quantization_ = quantization;
+    }
+
+    const std::string&
+    get_interim_index_quantization() const {
+        return interim_index_quantization_;
+    }
+
+    // the raw vector chunks of a growing segment are dropped once its
+    // interim index holds all the rows and returns their vectors, so the
+    // index is the only copy of them, or else the chunks are kept to serve
+    // the vectors exactly and without the index, at twice the memory; read
+    // once the interim index of a segment is created
+    void
+    set_drop_interim_indexed_chunks(bool drop) {
+        drop_interim_indexed_chunks_ = drop;
+    }
+
+    bool
+    get_drop_interim_indexed_chunks() const {
+        return drop_interim_indexed_chunks_;
+    }
+
+    // the quantized interim index returns topk * refine_ratio candidates,
+    // which are reranked by the raw vectors
+    void
+    set_refine_ratio(float refine_ratio) {
+        refine_ratio_ = refine_ratio;
+    }
+
+    float
+    get_refine_ratio() const {
+        return refine_ratio_;
+    }
+
+    // a sealed segment with both the index and the raw vectors loaded is
+    // searched by brute force, if the ratio of the rows passing the filter
+    // is not greater than this
+    void
+    set_brute_force_selectivity(float selectivity) {
+        brute_force_selectivity_ = selectivity;
+    }
+
+    float
+    get_brute_force_selectivity() const {
+        return brute_force_selectivity_;
+    }
+
+    // a string field of a sealed segment loaded in memory is dictionary
+    // encoded, if there are at most this ratio of distinct strings per row,
+    // 0 disables the encoding
+    void
+    set_dict_encode_ratio(float ratio) {
+        dict_encode_ratio_ = ratio;
+    }
+
+    float
+    get_dict_encode_ratio() const {
+        return dict_encode_ratio_;
+    }
+
+    // an integer field of a sealed segment loaded in memory is bit packed,
+    // if the packed rows take at most this ratio of the raw rows, 0 disables
+    // the packing
+    void
+    set_pack_ratio(float ratio) {
+        pack_ratio_ = ratio;
+    }
+
+    float
+    get_pack_ratio() const {
+        return pack_ratio_;
+    }
+
+    // a json field of a sealed segment loaded in memory also keeps the
+    // BinaryJson encoding of the rows, the filters seek the paths in it
+    // instead of parsing the rows
+    void
+    set_json_binary_encoding(bool enable) {
+        json_binary_encoding_ = enable;
+    }
+
+    bool
+    get_json_binary_encoding() const {
+        return json_binary_encoding_;
+    }
+
+    // the number of search plans and of retrieve plans parsed from the same
+    // serialized plans kept by each collection, 0 disables the caching
+    void
+    set_plan_cache_size(int64_t size) {
+        plan_cache_size_ = size;
+    }
+
+    int64_t
+    get_plan_cache_size() const {
+        return plan_cache_size_;
+    }
+
+    // an in memory vector index is loaded through a file staged in the mmap
+    // directory instead of assembling its slices in memory, which lowers the
+    // peak memory of the load to about a batch of slices above the index
+    void
+    set_stage_index_load(bool value) {
+        stage_index_load_ = value;
+    }
+
+    bool
+    get_stage_index_load() const {
+        return stage_index_load_;
+    }
+
+    // the chunks of the columns of a growing segment are allocated from an
+    // arena of the segment, which is released in bulk once it's dropped
+    void
+    set_enable_chunk_arena(bool value) {
+        enable_chunk_arena_ = value;
+    }
+
+    bool
+    get_enable_chunk_arena() const {
+        return enable_chunk_arena_;
+    }
+
+    // the arenas of the chunks are backed by transparent huge pages
+    void
+    set_chunk_arena_huge_page(bool value) {
+        chunk_arena_huge_page_ = value;
+    }
+
+    bool
+    get_chunk_arena_huge_page() const {
+        return chunk_arena_huge_page_;
+    }
+
+    // the full chunks of the growing segments are spilled to the files in
+    // the directory once the arenas of the chunks hold more bytes than the
+    // watermark, 0 disables the spilling
+    void
+    set_growing_mmap_dir(const std::string& dir) {
+        growing_mmap_dir_ = dir;
+    }
+
+    const std::string&
+    get_growing_mmap_dir() const {
+        return growing_mmap_dir_;
+    }
+
+    void
+    set_growing_mmap_watermark(int64_t bytes) {
+        growing_mmap_watermark_ = bytes;
+    }
+
+    int64_t
+    get_growing_mmap_watermark() const {
+        return growing_mmap_watermark_;
+    }
+
+    // the structures the sealed segments derive from their binlogs are
+    // persisted under the directory to restore them after a restart, see
+    // SegmentSnapshot, empty disables the snapshots
+    void
+    set_snapshot_dir(const std::string& dir) {
+        snapshot_dir_ = dir;
+    }
+
+    const std::string&
+    get_snapshot_dir() const {
+        return snapshot_dir_;
+    }
+
+    // the searches, retrieves and loads of the segments taking longer than
+    // this are recorded by the slow call recorder, 0 disables the recording
+    void
+    set_slow_call_threshold_ms(int64_t threshold_ms) {
+        slow_call_threshold_ms_ = threshold_ms;
+    }
+
+    int64_t
+    get_slow_call_threshold_ms() const {
+        return slow_call_threshold_ms_;
+    }
+
+    // the searches opted in by the ADAPTIVE_SEARCH search param are scaled
+    // down to finish a segment within the target once the node is
+    // overloaded, see AdaptiveSearch, 0 disables the scaling
+    void
+    set_adaptive_search_latency_target_ms(int64_t target_ms) {
+        adaptive_search_latency_target_ms_ = target_ms;
+    }
+
+    int64_t
+    get_adaptive_search_latency_target_ms() const {
+        return adaptive_search_latency_target_ms_;
+    }
+
  private:
     inline static bool enable_interim_segment_index_ = false;
+    inline static bool async_interim_index_build_ = false;
+    inline static int64_t interim_index_build_threads_ = 4;
     inline static int64_t chunk_rows_ = 32 * 1024;
     inline static int64_t nlist_ = 100;
     inline static int64_t nprobe_ = 4;
+    inline static std::string interim_index_quantization_ = "";
+    inline static bool drop_interim_indexed_chunks_ = true;
+    inline static float refine_ratio_ = 2.0;
+    inline static float brute_force_selectivity_ = 0.01;
+    inline static float dict_encode_ratio_ = 0;
+    inline static float pack_ratio_ = 0;
+    inline static bool json_binary_encoding_ = false;
+    inline static int64_t plan_cache_size_ = 128;
+    inline static bool stage_index_load_ = false;
+    inline static bool enable_chunk_arena_ = false;
+    inline static bool chunk_arena_huge_page_ = false;
+    inline static std::string growing_mmap_dir_ = "";
+    inline static int64_t growing_mmap_watermark_ = 0;
+    inline static int64_t slow_call_threshold_ms_ = 0;
+    inline static int64_t adaptive_search_latency_target_ms_ = 0;
+    inline static std::string snapshot_dir_ = "";
 };
 
 }  // namespace milvus::segcore
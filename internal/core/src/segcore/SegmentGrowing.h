@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "arrow/record_batch.h"
 #include "common/LoadInfo.h"
 #include "common/Schema.h"
 #include "common/Types.h"
@@ -34,6 +35,16 @@ class SegmentGrowing : public SegmentInternalInterface {
            const Timestamp* timestamps,
            const InsertData* insert_data) = 0;
 
+    // insert the rows of the record batch whose columns are named by the
+    // field ids, the data is copied from the arrow buffers into the chunks
+    // straight
+    virtual void
+    Insert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           const arrow::RecordBatch& batch) = 0;
+
     SegmentType
     type() const override {
         return SegmentType::Growing;
@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <future>
 #include <memory>
 #include <numeric>
 #include <queue>
@@ -70,14 +72,82 @@ SegmentGrowingImpl::mask_with_delete(BitsetType& bitset,
 void
 SegmentGrowingImpl::try_remove_chunks(FieldId fieldId) {
     //remove the chunk data to reduce memory consumption
-    if (indexing_record_.SyncDataWithIndex(fieldId)) {
+    if (indexing_record_.RawDataHeldByIndex(fieldId)) {
         auto vec_data_base =
             dynamic_cast<segcore::ConcurrentVector<FloatVector>*>(
                 insert_record_.get_field_data_base(fieldId));
-        if (vec_data_base && vec_data_base->num_chunk() > 0 &&
-            chunk_mutex_.try_lock()) {
+        // waits for the searches reading the chunks rather than skipping,
+        // or the chunks are kept if no more rows are inserted
+        if (vec_data_base && vec_data_base->num_chunk() > 0) {
+            std::unique_lock lck(chunk_mutex_);
             vec_data_base->clear();
-            chunk_mutex_.unlock();
+        }
+    }
+}
+
+void
+SegmentGrowingImpl::TrySpillFullChunks() {
+    auto watermark = segcore_config_.get_growing_mmap_watermark();
+    auto& dir = segcore_config_.get_growing_mmap_dir();
+    if (watermark <= 0 || dir.empty() ||
+        ChunkArena::TotalResidentByteSize() <= watermark) {
+        return;
+    }
+
+    auto size_per_chunk = segcore_config_.get_chunk_rows();
+    auto num_full_chunks =
+        insert_record_.ack_responder_.GetAck() / size_per_chunk;
+    std::unique_lock spill_lck(spill_mutex_, std::try_to_lock);
+    if (!spill_lck.owns_lock() || spilled_chunks_ >= num_full_chunks) {
+        return;
+    }
+    // the chunks removed meanwhile would be spilled after freed
+    std::shared_lock chunk_lck(chunk_mutex_);
+    std::filesystem::create_directories(dir);
+    auto prefix = fmt::format("{}/{}", dir, id_);
+    int64_t spilled = 0;
+    for (; spilled_chunks_ < num_full_chunks &&
+           ChunkArena::TotalResidentByteSize() > watermark;
+         ++spilled_chunks_) {
+        spilled += insert_record_.spill_chunk(spilled_chunks_, prefix);
+    }
+    if (spilled > 0) {
+        LOG_SEGCORE_INFO_ << "spilled " << spilled
+                          << " bytes of the chunks of growing segment " << id_;
+    }
+}
+
+void
+SegmentGrowingImpl::LoadFullChunksSkipIndex() {
+    auto size_per_chunk = segcore_config_.get_chunk_rows();
+    auto num_full_chunks =
+        insert_record_.ack_responder_.GetAck() / size_per_chunk;
+    std::lock_guard lck(skip_index_mutex_);
+    for (; skip_index_chunks_ < num_full_chunks; ++skip_index_chunks_) {
+        auto chunk_id = skip_index_chunks_;
+        for (auto& [field_id, field_meta] : schema_->get_fields()) {
+            if (field_id.get() < START_USER_FIELDID ||
+                indexing_record_.RawDataHeldByIndex(field_id)) {
+                continue;
+            }
+            auto data_type = field_meta.get_data_type();
+            if (datatype_is_string(data_type)) {
+                auto chunk = insert_record_.get_field_data_base(field_id)
+                                 ->get_chunk_data(chunk_id);
+                LoadStringSkipIndex(field_id,
+                                    chunk_id,
+                                    static_cast<const std::string_view*>(chunk),
+                                    size_per_chunk);
+            } else if (datatype_is_integer(data_type) ||
+                       datatype_is_floating(data_type)) {
+                LoadPrimitiveSkipIndex(
+                    field_id,
+                    chunk_id,
+                    data_type,
+                    insert_record_.get_field_data_base(field_id)
+                        ->get_chunk_data(chunk_id),
+                    size_per_chunk);
+            }
         }
     }
 }
@@ -115,7 +185,7 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
         AssertInfo(field_id_to_offset.count(field_id),
                    fmt::format("can't find field {}", field_id.get()));
         auto data_offset = field_id_to_offset[field_id];
-        if (!indexing_record_.SyncDataWithIndex(field_id)) {
+        if (!indexing_record_.RawDataHeldByIndex(field_id)) {
             insert_record_.get_field_data_base(field_id)->set_data_raw(
                 reserved_offset,
                 num_rows,
@@ -156,6 +226,127 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    LoadFullChunksSkipIndex();
+    TrySpillFullChunks();
+}
+
+void
+SegmentGrowingImpl::Insert(int64_t reserved_offset,
+                           int64_t num_rows,
+                           const int64_t* row_ids,
+                           const Timestamp* timestamps_raw,
+                           const arrow::RecordBatch& batch) {
+    AssertInfo(batch.num_rows() == num_rows,
+               "{} rows of record batch not equal to insert size {}",
+               batch.num_rows(),
+               num_rows);
+    std::unordered_map<FieldId, std::shared_ptr<arrow::Array>> columns;
+    for (int i = 0; i < batch.num_columns(); ++i) {
+        auto field_id = FieldId(std::stoll(batch.column_name(i)));
+        AssertInfo(!columns.count(field_id), "duplicate field data");
+        columns.emplace(field_id, batch.column(i));
+    }
+
+    insert_record_.timestamps_.set_data_raw(
+        reserved_offset, timestamps_raw, num_rows);
+    insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, num_rows);
+    for (auto [field_id, field_meta] : schema_->get_fields()) {
+        if (field_id.get() < START_USER_FIELDID) {
+            continue;
+        }
+        AssertInfo(columns.count(field_id),
+                   fmt::format("can't find field {}", field_id.get()));
+        auto& column = *columns.at(field_id);
+        if (!indexing_record_.RawDataHeldByIndex(field_id)) {
+            insert_record_.get_field_data_base(field_id)->set_data_raw(
+                reserved_offset, column, field_meta);
+        }
+        if (segcore_config_.get_enable_interim_segment_index() &&
+            field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+            AssertInfo(column.type_id() == arrow::Type::FIXED_SIZE_BINARY,
+                       "inconsistent arrow type {} of field {}",
+                       column.type()->ToString(),
+                       field_id.get());
+            indexing_record_.AppendingIndex(
+                reserved_offset,
+                num_rows,
+                field_id,
+                static_cast<const arrow::FixedSizeBinaryArray&>(column),
+                insert_record_);
+        }
+
+        // update average row data size, the variable length values are in
+        // binary arrays whose value bytes are close to the raw data size
+        if (datatype_is_variable(field_meta.get_data_type())) {
+            auto& binary_array = static_cast<const arrow::BinaryArray&>(column);
+            SegmentInternalInterface::set_field_avg_size(
+                field_id, num_rows, binary_array.total_values_length());
+        }
+
+        try_remove_chunks(field_id);
+    }
+
+    auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
+    AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    std::vector<PkType> pks(num_rows);
+    ParsePksFromArrowArray(
+        schema_->operator[](field_id).get_data_type(), pks, *columns[field_id]);
+    for (int i = 0; i < num_rows; ++i) {
+        insert_record_.insert_pk(pks[i], reserved_offset + i);
+    }
+
+    insert_record_.ack_responder_.AddSegment(reserved_offset,
+                                             reserved_offset + num_rows);
+    LoadFullChunksSkipIndex();
+    TrySpillFullChunks();
+}
+
+void
+SegmentGrowingImpl::FillFieldData(FieldId field_id,
+                                  int64_t reserved_offset,
+                                  size_t num_rows,
+                                  const std::vector<FieldDataPtr>& field_data) {
+    if (field_id == TimestampFieldID) {
+        // step 2: sort timestamp
+        // query node already guarantees that the timestamp is ordered, avoid field data copy in c++
+
+        // step 3: fill into Segment.ConcurrentVector
+        insert_record_.timestamps_.set_data_raw(reserved_offset, field_data);
+        return;
+    }
+
+    if (field_id == RowFieldID) {
+        insert_record_.row_ids_.set_data_raw(reserved_offset, field_data);
+        return;
+    }
+
+    if (!indexing_record_.RawDataHeldByIndex(field_id)) {
+        insert_record_.get_field_data_base(field_id)->set_data_raw(
+            reserved_offset, field_data);
+    }
+    if (segcore_config_.get_enable_interim_segment_index()) {
+        auto offset = reserved_offset;
+        for (auto& data : field_data) {
+            auto row_count = data->get_num_rows();
+            indexing_record_.AppendingIndex(
+                offset, row_count, field_id, data, insert_record_);
+            offset += row_count;
+        }
+    }
+    try_remove_chunks(field_id);
+
+    if (field_id == schema_->get_primary_field_id()) {
+        insert_record_.insert_pks(field_data);
+    }
+
+    // update average row data size
+    auto field_meta = (*schema_)[field_id];
+    if (datatype_is_variable(field_meta.get_data_type())) {
+        SegmentInternalInterface::set_field_avg_size(
+            field_id,
+            num_rows,
+            storage::GetByteSizeOfFieldDatas(field_data));
+    }
 }
 
 void
@@ -178,62 +369,48 @@ SegmentGrowingImpl::LoadFieldData(const LoadFieldDataInfo& infos) {
 
     size_t num_rows = storage::GetNumRowsForLoadInfo(infos);
     auto reserved_offset = PreInsert(num_rows);
-    for (auto& [id, info] : infos.field_infos) {
-        auto field_id = FieldId(id);
-        auto insert_files = info.insert_files;
-        auto channel = std::make_shared<FieldDataChannel>();
-        auto& pool =
-            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-        auto load_future =
-            pool.Submit(LoadFieldDatasFromRemote, insert_files, channel);
-        auto field_data = storage::CollectFieldDataChannel(channel);
-        if (field_id == TimestampFieldID) {
-            // step 2: sort timestamp
-            // query node already guarantees that the timestamp is ordered, avoid field data copy in c++
-
-            // step 3: fill into Segment.ConcurrentVector
-            insert_record_.timestamps_.set_data_raw(reserved_offset,
-                                                    field_data);
-            continue;
-        }
-
-        if (field_id == RowFieldID) {
-            insert_record_.row_ids_.set_data_raw(reserved_offset, field_data);
-            continue;
-        }
-
-        if (!indexing_record_.SyncDataWithIndex(field_id)) {
-            insert_record_.get_field_data_base(field_id)->set_data_raw(
-                reserved_offset, field_data);
-        }
-        if (segcore_config_.get_enable_interim_segment_index()) {
-            auto offset = reserved_offset;
-            for (auto& data : field_data) {
-                auto row_count = data->get_num_rows();
-                indexing_record_.AppendingIndex(
-                    offset, row_count, field_id, data, insert_record_);
-                offset += row_count;
+    // the fields are downloaded, decoded and filled concurrently, the
+    // downloads of all of them are submitted before the fills waiting for
+    // them, so the fills never wait for the downloads queued behind them
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+    std::vector<std::pair<FieldId, FieldDataChannelPtr>> channels;
+    std::vector<std::future<void>> futures;
+    try {
+        for (auto& [id, info] : infos.field_infos) {
+            auto channel = std::make_shared<FieldDataChannel>();
+            futures.push_back(pool.Submit(LoadFieldDatasFromRemote,
+                                          info.insert_files,
+                                          channel,
+                                          id,
+                                          nullptr));
+            channels.emplace_back(FieldId(id), channel);
+        }
+        for (auto& [field_id, channel] : channels) {
+            futures.push_back(pool.Submit(
+                [=, field_id = field_id, channel = channel]() mutable {
+                    auto field_data = storage::CollectFieldDataChannel(channel);
+                    FillFieldData(
+                        field_id, reserved_offset, num_rows, field_data);
+                }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    } catch (...) {
+        // the tasks reference the segment, wait for them before unwinding
+        for (auto& future : futures) {
+            if (future.valid()) {
+                future.wait();
             }
         }
-        try_remove_chunks(field_id);
-
-        if (field_id == primary_field_id) {
-            insert_record_.insert_pks(field_data);
-        }
-
-        // update average row data size
-        auto field_meta = (*schema_)[field_id];
-        if (datatype_is_variable(field_meta.get_data_type())) {
-            SegmentInternalInterface::set_field_avg_size(
-                field_id,
-                num_rows,
-                storage::GetByteSizeOfFieldDatas(field_data));
-        }
+        throw;
     }
 
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    LoadFullChunksSkipIndex();
+    TrySpillFullChunks();
 }
 
 void
@@ -269,53 +446,14 @@ SegmentGrowingImpl::LoadFieldDataV2(const LoadFieldDataInfo& infos) {
             LoadFieldDatasFromRemote2, space, schema_, field_data_info);
         auto field_data =
             milvus::storage::CollectFieldDataChannel(field_data_info.channel);
-        if (field_id == TimestampFieldID) {
-            // step 2: sort timestamp
-            // query node already guarantees that the timestamp is ordered, avoid field data copy in c++
-
-            // step 3: fill into Segment.ConcurrentVector
-            insert_record_.timestamps_.set_data_raw(reserved_offset,
-                                                    field_data);
-            continue;
-        }
-
-        if (field_id == RowFieldID) {
-            insert_record_.row_ids_.set_data_raw(reserved_offset, field_data);
-            continue;
-        }
-
-        if (!indexing_record_.SyncDataWithIndex(field_id)) {
-            insert_record_.get_field_data_base(field_id)->set_data_raw(
-                reserved_offset, field_data);
-        }
-        if (segcore_config_.get_enable_interim_segment_index()) {
-            auto offset = reserved_offset;
-            for (auto& data : field_data) {
-                auto row_count = data->get_num_rows();
-                indexing_record_.AppendingIndex(
-                    offset, row_count, field_id, data, insert_record_);
-                offset += row_count;
-            }
-        }
-        try_remove_chunks(field_id);
-
-        if (field_id == primary_field_id) {
-            insert_record_.insert_pks(field_data);
-        }
-
-        // update average row data size
-        auto field_meta = (*schema_)[field_id];
-        if (datatype_is_variable(field_meta.get_data_type())) {
-            SegmentInternalInterface::set_field_avg_size(
-                field_id,
-                num_rows,
-                storage::GetByteSizeOfFieldDatas(field_data));
-        }
+        FillFieldData(field_id, reserved_offset, num_rows, field_data);
     }
 
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    LoadFullChunksSkipIndex();
+    TrySpillFullChunks();
 }
 SegcoreError
 SegmentGrowingImpl::Delete(int64_t reserved_begin,
@@ -362,15 +500,16 @@ SegmentGrowingImpl::Delete(int64_t reserved_begin,
     return SegcoreError::success();
 }
 
-int64_t
-SegmentGrowingImpl::GetMemoryUsageInBytes() const {
-    int64_t total_bytes = 0;
-    auto chunk_rows = segcore_config_.get_chunk_rows();
-    int64_t ins_n = upper_align(insert_record_.reserved, chunk_rows);
-    total_bytes += ins_n * (schema_->get_total_sizeof() + 16 + 1);
-    int64_t del_n = upper_align(deleted_record_.size(), chunk_rows);
-    total_bytes += del_n * (16 * 2);
-    return total_bytes;
+SegmentMemoryUsage
+SegmentGrowingImpl::GetMemoryUsage() const {
+    SegmentMemoryUsage usage;
+    usage.field_data = insert_record_.fields_byte_size();
+    usage.index = indexing_record_.byte_size();
+    usage.pk_index = insert_record_.pks_byte_size();
+    usage.timestamps = insert_record_.timestamps_.byte_size() +
+                       insert_record_.row_ids_.byte_size();
+    usage.deleted_record = deleted_record_.byte_size();
+    return usage;
 }
 
 void
@@ -613,6 +752,12 @@ SegmentGrowingImpl::bulk_subscript_impl(FieldId field_id,
     auto copy_from_chunk = [&]() {
         auto output_base = reinterpret_cast<char*>(output_raw);
         for (int i = 0; i < count; ++i) {
+            if (i + GATHER_PREFETCH_DISTANCE < count) {
+                auto ahead = seg_offsets[i + GATHER_PREFETCH_DISTANCE];
+                if (ahead != INVALID_SEG_OFFSET) {
+                    PrefetchRow(vec.get_element(ahead), element_sizeof);
+                }
+            }
             auto dst = output_base + i * element_sizeof;
             auto offset = seg_offsets[i];
             if (offset == INVALID_SEG_OFFSET) {
@@ -626,12 +771,12 @@ SegmentGrowingImpl::bulk_subscript_impl(FieldId field_id,
     //HasRawData interface guarantees that data can be fetched from growing segment
     if (HasRawData(field_id.get())) {
         //When data sync with index
-        if (indexing_record_.SyncDataWithIndex(field_id)) {
+        if (indexing_record_.RawDataHeldByIndex(field_id)) {
             indexing_record_.GetDataFromIndex(
                 field_id, seg_offsets, count, element_sizeof, output_raw);
         } else {
-            //Else copy from chunk
-            std::lock_guard<std::shared_mutex> guard(chunk_mutex_);
+            //Else copy from chunk, which isn't dropped meanwhile
+            std::shared_lock guard(chunk_mutex_);
             copy_from_chunk();
         }
     }
@@ -649,6 +794,9 @@ SegmentGrowingImpl::bulk_subscript_impl(const VectorBase* vec_raw,
     AssertInfo(vec_ptr, "Pointer of vec_raw is nullptr");
     auto& vec = *vec_ptr;
     for (int64_t i = 0; i < count; ++i) {
+        if (i + GATHER_PREFETCH_DISTANCE < count) {
+            __builtin_prefetch(&vec[seg_offsets[i + GATHER_PREFETCH_DISTANCE]]);
+        }
         auto offset = seg_offsets[i];
         output[i] = vec[offset];
     }
@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <tbb/concurrent_priority_queue.h>
@@ -47,6 +48,13 @@ class SegmentGrowingImpl : public SegmentGrowing {
            const Timestamp* timestamps,
            const InsertData* insert_data) override;
 
+    void
+    Insert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           const arrow::RecordBatch& batch) override;
+
     bool
     Contain(const PkType& pk) const override {
         return insert_record_.contain(pk);
@@ -59,8 +67,8 @@ class SegmentGrowingImpl : public SegmentGrowing {
            const IdArray* pks,
            const Timestamp* timestamps) override;
 
-    int64_t
-    GetMemoryUsageInBytes() const override;
+    SegmentMemoryUsage
+    GetMemoryUsage() const override;
 
     void
     LoadDeletedRecord(const LoadDeletedRecordInfo& info) override;
@@ -137,6 +145,24 @@ class SegmentGrowingImpl : public SegmentGrowing {
     void
     try_remove_chunks(FieldId fieldId);
 
+    // fill the loaded rows of a field from the reserved offset, the fields
+    // filled concurrently with each other
+    void
+    FillFieldData(FieldId field_id,
+                  int64_t reserved_offset,
+                  size_t num_rows,
+                  const std::vector<FieldDataPtr>& field_data);
+
+    // load the skip index of the chunks whose rows are all inserted, the
+    // chunks filling are never skipped
+    void
+    LoadFullChunksSkipIndex();
+
+    // spill the full chunks to the growing mmap directory, the oldest first,
+    // while the arenas of the chunks hold more bytes than the watermark
+    void
+    TrySpillFullChunks();
+
  public:
     int64_t
     get_row_count() const override {
@@ -207,7 +233,13 @@ class SegmentGrowingImpl : public SegmentGrowing {
         : segcore_config_(segcore_config),
           schema_(std::move(schema)),
           index_meta_(indexMeta),
-          insert_record_(*schema_, segcore_config.get_chunk_rows()),
+          insert_record_(
+              *schema_,
+              segcore_config.get_chunk_rows(),
+              segcore_config.get_enable_chunk_arena()
+                  ? std::make_shared<ChunkArena>(
+                        segcore_config.get_chunk_arena_huge_page())
+                  : ChunkArenaPtr()),
           indexing_record_(*schema_, index_meta_, segcore_config_),
           id_(segment_id) {
     }
@@ -216,6 +248,13 @@ class SegmentGrowingImpl : public SegmentGrowing {
     mask_with_timestamps(BitsetType& bitset_chunk,
                          Timestamp timestamp) const override;
 
+    // the active count already excludes the rows inserted after the
+    // timestamp
+    bool
+    all_visible(Timestamp timestamp) const override {
+        return true;
+    }
+
     void
     vector_search(SearchInfo& search_info,
                   const void* query_data,
@@ -244,6 +283,15 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return false;
     }
 
+    std::string
+    vector_index_type(FieldId field_id) const override {
+        if (!HasIndex(field_id)) {
+            return "";
+        }
+        return indexing_record_.get_vec_field_indexing(field_id)
+            .get_index_type();
+    }
+
     bool
     HasFieldData(FieldId field_id) const override {
         return true;
@@ -251,12 +299,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
 
     bool
     HasRawData(int64_t field_id) const override {
-        //growing index hold raw data when
-        // 1. growing index enabled and it holds raw data
-        // 2. growing index disabled then raw data held by chunk
-        if (indexing_record_.is_in(FieldId(field_id))) {
-            return indexing_record_.HasRawData(FieldId(field_id));
-        }
+        //growing segment holds raw data in
+        // 1. the growing index if it's synchronized and holds raw data
+        // 2. the chunks otherwise, e.g. the growing index is quantized
         return true;
     }
 
@@ -299,6 +344,14 @@ class SegmentGrowingImpl : public SegmentGrowing {
 
     mutable std::shared_mutex chunk_mutex_;
 
+    // the skip index of the chunks [0, skip_index_chunks_) is loaded
+    std::mutex skip_index_mutex_;
+    int64_t skip_index_chunks_ = 0;
+
+    // the chunks [0, spilled_chunks_) are spilled
+    std::mutex spill_mutex_;
+    int64_t spilled_chunks_ = 0;
+
     // deleted pks
     mutable DeletedRecord deleted_record_;
 
@@ -0,0 +1,143 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include "segcore/SegmentHandoff.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Array.h"
+#include "common/EasyAssert.h"
+#include "common/Json.h"
+#include "common/LoadInfo.h"
+#include "common/SystemProperty.h"
+#include "log/Log.h"
+#include "mmap/Types.h"
+#include "segcore/SegmentSealedImpl.h"
+#include "storage/Util.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the rows [0, num_rows) of the vector, a field data per chunk
+std::vector<FieldDataPtr>
+CopyChunks(const VectorBase& vec,
+           DataType data_type,
+           int64_t dim,
+           int64_t num_rows) {
+    std::vector<FieldDataPtr> datas;
+    auto size_per_chunk = vec.get_size_per_chunk();
+    for (int64_t chunk_id = 0; chunk_id * size_per_chunk < num_rows;
+         ++chunk_id) {
+        auto rows =
+            std::min(size_per_chunk, num_rows - chunk_id * size_per_chunk);
+        auto chunk = vec.get_chunk_data(chunk_id);
+        auto field_data = storage::CreateFieldData(data_type, dim, rows);
+        switch (data_type) {
+            case DataType::STRING:
+            case DataType::VARCHAR: {
+                // the chunks hold the views of the packed strings
+                auto views = static_cast<const std::string_view*>(chunk);
+                std::vector<std::string> strings(views, views + rows);
+                field_data->FillFieldData(strings.data(), rows);
+                break;
+            }
+            default:
+                // the json views are copied by the sealed column, the rest
+                // are copied as they are
+                field_data->FillFieldData(chunk, rows);
+                break;
+        }
+        datas.push_back(std::move(field_data));
+    }
+    return datas;
+}
+
+template <typename Pk>
+void
+FillIds(const ConcurrentVector<PkType>& pks, int64_t size, Pk* ids) {
+    for (int64_t i = 0; i < size; ++i) {
+        *ids->Add() = std::get<typename Pk::value_type>(pks[i]);
+    }
+}
+
+}  // namespace
+
+SegmentSealedUPtr
+HandoffGrowingSegment(const SegmentGrowingImpl& growing,
+                      SchemaPtr schema,
+                      IndexMetaPtr index_meta) {
+    AssertInfo(schema != nullptr && schema.get() == &growing.get_schema(),
+               "handoff of segment {} with another schema",
+               growing.get_segment_id());
+    auto segment_id = growing.get_segment_id();
+    auto num_rows = growing.get_row_count();
+    AssertInfo(num_rows > 0, "no rows to hand off in segment {}", segment_id);
+    auto segment = CreateSealedSegment(schema, index_meta, segment_id);
+
+    auto& insert_record = growing.get_insert_record();
+    auto load = [&](FieldId field_id,
+                    const VectorBase& vec,
+                    DataType data_type,
+                    int64_t dim) {
+        auto info = FieldDataInfo(
+            field_id.get(),
+            num_rows,
+            CopyChunks(vec, data_type, dim, num_rows));
+        segment->LoadFieldData(field_id, info);
+    };
+    load(RowFieldID, insert_record.row_ids_, DataType::INT64, 1);
+    load(TimestampFieldID, insert_record.timestamps_, DataType::INT64, 1);
+    for (auto& [field_id, field_meta] : schema->get_fields()) {
+        if (SystemProperty::Instance().IsSystem(field_id)) {
+            continue;
+        }
+        auto dim = field_meta.is_vector() ? field_meta.get_dim() : 1;
+        load(field_id,
+             *insert_record.get_field_data_base(field_id),
+             field_meta.get_data_type(),
+             dim);
+    }
+
+    // the deletes applied to the growing segment, the pks not in the sealed
+    // segment are filtered out by Delete
+    auto& deleted_record = growing.get_deleted_record();
+    auto num_deletes = deleted_record.size();
+    if (num_deletes > 0) {
+        IdArray ids;
+        auto pk_type =
+            schema->operator[](schema->get_primary_field_id().value())
+                .get_data_type();
+        if (pk_type == DataType::INT64) {
+            FillIds(deleted_record.pks(),
+                    num_deletes,
+                    ids.mutable_int_id()->mutable_data());
+        } else {
+            FillIds(deleted_record.pks(),
+                    num_deletes,
+                    ids.mutable_str_id()->mutable_data());
+        }
+        std::vector<Timestamp> timestamps(num_deletes);
+        for (int64_t i = 0; i < num_deletes; ++i) {
+            timestamps[i] = deleted_record.timestamps()[i];
+        }
+        segment->Delete(0, num_deletes, &ids, timestamps.data());
+    }
+    LOG_SEGCORE_INFO_ << "handed off growing segment " << segment_id
+                      << " of " << num_rows << " rows and " << num_deletes
+                      << " deletes";
+    return segment;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,34 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#pragma once
+
+#include "common/Schema.h"
+#include "common/IndexMeta.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/SegmentSealed.h"
+
+namespace milvus::segcore {
+
+// Build the sealed segment of a flushed growing segment from the rows and the
+// deletes the growing segment holds in memory, instead of loading the binlogs
+// which hold the same rows. The chunks are copied into the sealed columns
+// field by field, and the sealed segment builds the pk index, the timestamp
+// index and the skip index as a load does. The growing segment is unchanged
+// and keeps serving the queries until it's released. The index meta decides
+// the interim indexes of the sealed segment, nullptr for none.
+SegmentSealedUPtr
+HandoffGrowingSegment(const SegmentGrowingImpl& growing,
+                      SchemaPtr schema,
+                      IndexMetaPtr index_meta);
+
+}  // namespace milvus::segcore
@@ -18,73 +18,230 @@
 #include "common/SystemProperty.h"
 #include "common/Tracer.h"
 #include "common/Types.h"
+#include "plan/PlanNode.h"
+#include "query/SubSearchResult.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
+#include "segcore/SlowCallRecorder.h"
+#include "storage/SearchMetrics.h"
+#include "storage/prometheus_client.h"
 
 namespace milvus::segcore {
 
+// apply the change of the memory usage to the metrics
+static void
+ApplyMemoryUsageMetrics(const SegmentMemoryUsage& from,
+                        const SegmentMemoryUsage& to) {
+    storage::internal_segment_memory_usage_field_data.Increment(
+        to.field_data - from.field_data);
+    storage::internal_segment_memory_usage_index.Increment(
+        to.index - from.index);
+    storage::internal_segment_memory_usage_pk_index.Increment(
+        to.pk_index - from.pk_index);
+    storage::internal_segment_memory_usage_timestamps.Increment(
+        to.timestamps - from.timestamps);
+    storage::internal_segment_memory_usage_deleted_record.Increment(
+        to.deleted_record - from.deleted_record);
+}
+
+// the fields read by the filter of the plan node, if any
+static void
+CollectFilterFieldIds(
+    const std::optional<std::shared_ptr<milvus::plan::PlanNode>>& plannode,
+    std::vector<FieldId>& field_ids) {
+    if (!plannode.has_value()) {
+        return;
+    }
+    auto filter_node =
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(plannode.value());
+    if (filter_node != nullptr) {
+        expr::CollectFieldIds(filter_node->filter(), field_ids);
+    }
+}
+
+SegmentInternalInterface::~SegmentInternalInterface() {
+    std::lock_guard lck(reported_memory_usage_mutex_);
+    ApplyMemoryUsageMetrics(reported_memory_usage_, SegmentMemoryUsage());
+}
+
+SegmentMemoryUsage
+SegmentInternalInterface::ReportMemoryUsage() const {
+    auto usage = GetMemoryUsage();
+    std::lock_guard lck(reported_memory_usage_mutex_);
+    ApplyMemoryUsageMetrics(reported_memory_usage_, usage);
+    reported_memory_usage_ = usage;
+    return usage;
+}
+
 void
 SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan,
                                           SearchResult& results) const {
-    std::shared_lock lck(mutex_);
     AssertInfo(plan, "empty plan");
+    auto pk_field_id_opt = get_schema().get_primary_field_id();
+    AssertInfo(pk_field_id_opt.has_value(),
+               "Cannot get primary key offset from schema");
+    LoadLazyFields({pk_field_id_opt.value()});
+    std::shared_lock lck(mutex_);
     auto size = results.distances_.size();
     AssertInfo(results.seg_offsets_.size() == size,
                "Size of result distances is not equal to size of ids");
     Assert(results.primary_keys_.size() == 0);
     results.primary_keys_.resize(size);
 
-    auto pk_field_id_opt = get_schema().get_primary_field_id();
-    AssertInfo(pk_field_id_opt.has_value(),
-               "Cannot get primary key offset from schema");
     auto pk_field_id = pk_field_id_opt.value();
     AssertInfo(IsPrimaryKeyDataType(get_schema()[pk_field_id].get_data_type()),
                "Primary key field is not INT64 or VARCHAR type");
 
+    storage::SearchStageTimer stage_timer(
+        storage::SearchStage::BulkSubscript,
+        storage::SegmentTypeLabel(type()),
+        storage::IndexTypeLabel(
+            vector_index_type(plan->plan_node_->search_info_.field_id_)));
+    ProfileTimer timer(results.profile_.get(), "fill_primary_keys");
     auto field_data =
         bulk_subscript(pk_field_id, results.seg_offsets_.data(), size);
     results.pk_type_ = DataType(field_data->type());
 
     ParsePksFromFieldData(results.primary_keys_, *field_data.get());
+    timer.stage().input_rows_ = size;
+    timer.stage().output_rows_ = size;
 }
 
 void
 SegmentInternalInterface::FillTargetEntry(const query::Plan* plan,
                                           SearchResult& results) const {
-    std::shared_lock lck(mutex_);
     AssertInfo(plan, "empty plan");
+    LoadLazyFields(plan->target_entries_);
+    std::shared_lock lck(mutex_);
     auto size = results.distances_.size();
     AssertInfo(results.seg_offsets_.size() == size,
                "Size of result distances is not equal to size of ids");
 
     // fill other entries except primary key by result_offset
+    storage::SearchStageTimer stage_timer(
+        storage::SearchStage::BulkSubscript,
+        storage::SegmentTypeLabel(type()),
+        storage::IndexTypeLabel(
+            vector_index_type(plan->plan_node_->search_info_.field_id_)));
+    ProfileTimer timer(results.profile_.get(), "fill_output_fields");
     for (auto field_id : plan->target_entries_) {
         auto field_data =
             bulk_subscript(field_id, results.seg_offsets_.data(), size);
+        if (timer.enabled()) {
+            timer.stage().bytes_ += field_data->ByteSizeLong();
+        }
         results.output_fields_data_[field_id] = std::move(field_data);
     }
+    timer.stage().input_rows_ = size;
+    timer.stage().output_rows_ = size;
 }
 
 std::unique_ptr<SearchResult>
 SegmentInternalInterface::Search(
     const query::Plan* plan,
     const query::PlaceholderGroup* placeholder_group) const {
+    if (plan->extra_info_opt_.has_value()) {
+        std::vector<FieldId> field_ids;
+        auto& involved_fields = plan->extra_info_opt_->involved_fields_;
+        for (size_t pos = 0; pos < involved_fields.size(); ++pos) {
+            if (involved_fields[pos]) {
+                field_ids.emplace_back(pos + START_USER_FIELDID);
+            }
+        }
+        LoadLazyFields(field_ids);
+    }
     std::shared_lock lck(mutex_);
     milvus::tracer::AddEvent("obtained_segment_lock_mutex");
+    // the search may have been canceled while waiting for the lock
+    CheckCancellation(plan->plan_node_->search_info_.cancellation_token_);
     check_search(plan);
+    // the faults of the mmapped columns and indexes read by the search
+    storage::PageFaultCounter page_fault_counter(type());
     query::ExecPlanNodeVisitor visitor(*this, 1L << 63, placeholder_group);
+    // the stages of the slow searches are recorded with them
+    visitor.SetForceProfile(SlowCallRecorder::Enabled());
+    visitor.SetCancellationToken(
+        plan->plan_node_->search_info_.cancellation_token_);
     auto results = std::make_unique<SearchResult>();
     *results = visitor.get_moved_result(*plan->plan_node_);
     results->segment_ = (void*)this;
     return results;
 }
 
+BitsetType
+SegmentInternalInterface::SearchFilter(const query::Plan* plan,
+                                       Timestamp timestamp) const {
+    if (plan->extra_info_opt_.has_value()) {
+        std::vector<FieldId> field_ids;
+        auto& involved_fields = plan->extra_info_opt_->involved_fields_;
+        for (size_t pos = 0; pos < involved_fields.size(); ++pos) {
+            if (involved_fields[pos]) {
+                field_ids.emplace_back(pos + START_USER_FIELDID);
+            }
+        }
+        LoadLazyFields(field_ids);
+    }
+    std::shared_lock lck(mutex_);
+    check_search(plan);
+    auto active_count = get_active_count(timestamp);
+    BitsetType bitset(active_count, false);
+    if (active_count == 0) {
+        return bitset;
+    }
+    if (plan->plan_node_->filter_plannode_.has_value()) {
+        query::ExecPlanNodeVisitor visitor(*this, timestamp);
+        visitor.ExecuteExprNode(
+            plan->plan_node_->filter_plannode_.value(), this, bitset);
+        bitset.flip();
+    }
+    mask_with_timestamps(bitset, timestamp);
+    mask_with_delete(bitset, active_count, timestamp);
+    return bitset;
+}
+
+std::unique_ptr<SearchResult>
+SegmentInternalInterface::SearchFiltered(SearchInfo& search_info,
+                                         const void* query_data,
+                                         int64_t num_queries,
+                                         Timestamp timestamp,
+                                         const BitsetType& bitset) const {
+    std::shared_lock lck(mutex_);
+    auto results = std::make_unique<SearchResult>();
+    if (bitset.all()) {
+        query::SubSearchResult empty(num_queries,
+                                     search_info.topk_,
+                                     search_info.metric_type_,
+                                     search_info.round_decimal_);
+        results->total_nq_ = num_queries;
+        results->unity_topK_ = search_info.topk_;
+        results->seg_offsets_ = std::move(empty.mutable_seg_offsets());
+        results->distances_ = std::move(empty.mutable_distances());
+    } else {
+        BitsetView view = bitset;
+        vector_search(
+            search_info, query_data, num_queries, timestamp, view, *results);
+    }
+    results->segment_ = (void*)this;
+    return results;
+}
+
 std::unique_ptr<proto::segcore::RetrieveResults>
 SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
                                    Timestamp timestamp,
                                    int64_t limit_size) const {
+    std::vector<FieldId> field_ids = plan->field_ids_;
+    CollectFilterFieldIds(plan->plan_node_->filter_plannode_, field_ids);
+    for (auto& aggregate : plan->plan_node_->aggregates_) {
+        field_ids.push_back(aggregate.field_id_);
+    }
+    if (plan->plan_node_->order_by_.has_value()) {
+        field_ids.push_back(plan->plan_node_->order_by_->field_id_);
+    }
+    LoadLazyFields(field_ids);
     std::shared_lock lck(mutex_);
+    CheckCancellation(plan->cancellation_token_);
     auto results = std::make_unique<proto::segcore::RetrieveResults>();
     query::ExecPlanNodeVisitor visitor(*this, timestamp);
+    visitor.SetCancellationToken(plan->cancellation_token_);
     auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
     retrieve_results.segment_ = (void*)this;
 
@@ -106,6 +263,13 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
         return results;
     }
 
+    if (!plan->plan_node_->aggregates_.empty()) {
+        for (auto& partial_state : retrieve_results.field_data_) {
+            *results->add_fields_data() = std::move(partial_state);
+        }
+        return results;
+    }
+
     results->mutable_offset()->Add(retrieve_results.result_offsets_.begin(),
                                    retrieve_results.result_offsets_.end());
 
@@ -113,6 +277,7 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
     auto ids = results->mutable_ids();
     auto pk_field_id = plan->schema_.get_primary_field_id();
     for (auto field_id : plan->field_ids_) {
+        CheckCancellation(plan->cancellation_token_);
         if (SystemProperty::Instance().IsSystem(field_id)) {
             auto system_type =
                 SystemProperty::Instance().GetSystemFieldType(field_id);
@@ -266,12 +431,7 @@ SegmentInternalInterface::timestamp_filter(BitsetType& bitset,
 
     auto pilot = upper_bound(timestamps, 0, cnt, timestamp);
     // offset bigger than pilot should be filtered out.
-    for (int offset = pilot; offset < cnt; offset = bitset.find_next(offset)) {
-        if (offset == BitsetType::npos) {
-            return;
-        }
-        bitset[offset] = false;
-    }
+    bitset.reset(pilot, cnt - pilot);
 }
 
 void
@@ -299,12 +459,15 @@ SegmentInternalInterface::GetSkipIndex() const {
 }
 
 void
-SegmentInternalInterface::LoadPrimitiveSkipIndex(milvus::FieldId field_id,
-                                                 int64_t chunk_id,
-                                                 milvus::DataType data_type,
-                                                 const void* chunk_data,
-                                                 int64_t count) {
-    skipIndex_.LoadPrimitive(field_id, chunk_id, data_type, chunk_data, count);
+SegmentInternalInterface::LoadPrimitiveSkipIndex(
+    milvus::FieldId field_id,
+    int64_t chunk_id,
+    milvus::DataType data_type,
+    const void* chunk_data,
+    int64_t count,
+    const storage::PayloadStatistics* statistics) {
+    skipIndex_.LoadPrimitive(
+        field_id, chunk_id, data_type, chunk_data, count, statistics);
 }
 
 void
@@ -315,4 +478,19 @@ SegmentInternalInterface::LoadStringSkipIndex(
     skipIndex_.LoadString(field_id, chunk_id, var_column);
 }
 
+void
+SegmentInternalInterface::LoadStringSkipIndex(
+    milvus::FieldId field_id,
+    int64_t chunk_id,
+    const std::string_view* chunk_data,
+    int64_t count) {
+    skipIndex_.LoadString(field_id, chunk_id, chunk_data, count);
+}
+
+void
+SegmentInternalInterface::LoadFieldStats(
+    FieldId field_id, std::shared_ptr<const FieldStats> stats) {
+    skipIndex_.LoadFieldStats(field_id, std::move(stats));
+}
+
 }  // namespace milvus::segcore
@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,6 +21,7 @@
 
 #include "DeletedRecord.h"
 #include "FieldIndexing.h"
+#include "JsonKeyColumn.h"
 #include "common/Schema.h"
 #include "common/Span.h"
 #include "common/SystemProperty.h"
@@ -33,11 +35,30 @@
 #include "pb/schema.pb.h"
 #include "pb/segcore.pb.h"
 #include "index/IndexInfo.h"
+#include "index/ArrayInvertedIndex.h"
+#include "index/JsonInvertedIndex.h"
 #include "index/SkipIndex.h"
 #include "mmap/Column.h"
+#include "segcore/AdaptiveSearch.h"
 
 namespace milvus::segcore {
 
+// the bytes of the memory held by a segment, by component, the mmapped data
+// excluded
+struct SegmentMemoryUsage {
+    int64_t field_data = 0;
+    int64_t index = 0;
+    int64_t pk_index = 0;
+    // of the timestamps and the row ids
+    int64_t timestamps = 0;
+    int64_t deleted_record = 0;
+
+    int64_t
+    Total() const {
+        return field_data + index + pk_index + timestamps + deleted_record;
+    }
+};
+
 // common interface of SegmentSealed and SegmentGrowing used by C API
 class SegmentInterface {
  public:
@@ -61,10 +82,17 @@ class SegmentInterface {
              Timestamp timestamp,
              int64_t limit_size) const = 0;
 
-    // TODO: memory use is not correct when load string or load string index
     virtual int64_t
     GetMemoryUsageInBytes() const = 0;
 
+    virtual SegmentMemoryUsage
+    GetMemoryUsage() const = 0;
+
+    // get the memory usage and apply its change since the last report to the
+    // segment memory usage metrics
+    virtual SegmentMemoryUsage
+    ReportMemoryUsage() const = 0;
+
     virtual int64_t
     get_row_count() const = 0;
 
@@ -117,6 +145,9 @@ class SegmentInterface {
 // only for implementation
 class SegmentInternalInterface : public SegmentInterface {
  public:
+    // withdraw the reported memory usage from the metrics
+    ~SegmentInternalInterface() override;
+
     template <typename T>
     Span<T>
     chunk_data(FieldId field_id, int64_t chunk_id) const {
@@ -138,6 +169,20 @@ class SegmentInternalInterface : public SegmentInterface {
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_group) const override;
 
+    // the bitset of the active rows the search of the plan filters out at
+    // the timestamp, by its filter, the visibility and the deletes
+    BitsetType
+    SearchFilter(const query::Plan* plan, Timestamp timestamp) const;
+
+    // search the rows not set in the bitset of the active rows, which is the
+    // whole filter of the search
+    std::unique_ptr<SearchResult>
+    SearchFiltered(SearchInfo& search_info,
+                   const void* query_data,
+                   int64_t num_queries,
+                   Timestamp timestamp,
+                   const BitsetType& bitset) const;
+
     void
     FillPrimaryKeys(const query::Plan* plan,
                     SearchResult& results) const override;
@@ -151,9 +196,22 @@ class SegmentInternalInterface : public SegmentInterface {
              Timestamp timestamp,
              int64_t limit_size) const override;
 
+    int64_t
+    GetMemoryUsageInBytes() const override {
+        return GetMemoryUsage().Total();
+    }
+
+    SegmentMemoryUsage
+    ReportMemoryUsage() const override;
+
     virtual bool
     HasIndex(FieldId field_id) const = 0;
 
+    // the type of the index searched on the vector field, empty if the field
+    // is searched by brute force
+    virtual std::string
+    vector_index_type(FieldId field_id) const = 0;
+
     virtual bool
     HasFieldData(FieldId field_id) const = 0;
 
@@ -174,18 +232,64 @@ class SegmentInternalInterface : public SegmentInterface {
     const SkipIndex&
     GetSkipIndex() const;
 
+    // the values of the json path extracted from the json field at load
+    // time, nullptr if the path isn't extracted
+    virtual const JsonKeyColumn*
+    GetJsonKeyColumn(FieldId field_id, const std::string& pointer) const {
+        return nullptr;
+    }
+
+    // the inverted index over the keys and values of the json field, kept
+    // aside the raw data, nullptr if no json index is loaded
+    virtual const index::JsonInvertedIndex*
+    GetJsonIndex(FieldId field_id) const {
+        return nullptr;
+    }
+
+    // the inverted index over the elements of the array field, kept aside
+    // the raw data, nullptr if no array index is loaded
+    virtual const index::ArrayInvertedIndex*
+    GetArrayIndex(FieldId field_id) const {
+        return nullptr;
+    }
+
+    // the dictionary of the string field loaded dictionary encoded, nullptr
+    // if the field isn't
+    virtual const StringDictionary*
+    GetStringDictionary(FieldId field_id) const {
+        return nullptr;
+    }
+
+    // the column of the integer field loaded bit packed, nullptr if the
+    // field isn't
+    virtual const PackedColumn*
+    GetPackedColumn(FieldId field_id) const {
+        return nullptr;
+    }
+
     void
-    LoadPrimitiveSkipIndex(FieldId field_id,
-                           int64_t chunk_id,
-                           DataType data_type,
-                           const void* chunk_data,
-                           int64_t count);
+    LoadPrimitiveSkipIndex(
+        FieldId field_id,
+        int64_t chunk_id,
+        DataType data_type,
+        const void* chunk_data,
+        int64_t count,
+        const storage::PayloadStatistics* statistics = nullptr);
 
     void
     LoadStringSkipIndex(FieldId field_id,
                         int64_t chunk_id,
                         const milvus::VariableColumn<std::string>& var_column);
 
+    void
+    LoadStringSkipIndex(FieldId field_id,
+                        int64_t chunk_id,
+                        const std::string_view* chunk_data,
+                        int64_t count);
+
+    void
+    LoadFieldStats(FieldId field_id, std::shared_ptr<const FieldStats> stats);
+
  public:
     virtual void
     vector_search(SearchInfo& search_info,
@@ -212,6 +316,11 @@ class SegmentInternalInterface : public SegmentInterface {
     mask_with_timestamps(BitsetType& bitset_chunk,
                          Timestamp timestamp) const = 0;
 
+    // whether all the active rows are visible at the timestamp, then
+    // mask_with_timestamps sets no bit
+    virtual bool
+    all_visible(Timestamp timestamp) const = 0;
+
     // count of chunks
     virtual int64_t
     num_chunk() const = 0;
@@ -293,15 +402,34 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual void
     check_search(const query::Plan* plan) const = 0;
 
+    // materialize the fields read by a search or a retrieve if they are
+    // loaded lazily, must be called without holding mutex_ as the loads
+    // publish the fields under it
+    virtual void
+    LoadLazyFields(const std::vector<FieldId>& field_ids) const {
+    }
+
     virtual const ConcurrentVector<Timestamp>&
     get_timestamps() const = 0;
 
+    // the recent latency of the vector searches at their full effort
+    LatencyEwma&
+    full_effort_search_latency() const {
+        return full_effort_search_latency_;
+    }
+
  protected:
     mutable std::shared_mutex mutex_;
     // fieldID -> std::pair<num_rows, avg_size>
     std::unordered_map<FieldId, std::pair<int64_t, int64_t>>
         variable_fields_avg_size_;  // bytes;
     SkipIndex skipIndex_;
+
+ private:
+    // the memory usage last applied to the metrics
+    mutable std::mutex reported_memory_usage_mutex_;
+    mutable SegmentMemoryUsage reported_memory_usage_;
+    mutable LatencyEwma full_effort_search_latency_;
 };
 
 }  // namespace milvus::segcore
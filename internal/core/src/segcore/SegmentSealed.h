@@ -40,6 +40,16 @@ class SegmentSealed : public SegmentInternalInterface {
     MapFieldData(const FieldId field_id, FieldDataInfo& data) = 0;
     virtual void
     AddFieldDataInfoForSealed(const LoadFieldDataInfo& field_data_info) = 0;
+    // warm up the chunk cache with the binlogs of a vector field whose index
+    // has no raw data, so that the first get_vector doesn't wait for download
+    virtual void
+    PrefetchChunkCache(FieldId field_id) const = 0;
+    // extract the json path of the json field into a typed column of
+    // data_type when the field is loaded, or immediately if already loaded
+    virtual void
+    AddJsonKeyColumn(FieldId field_id,
+                     const std::string& pointer,
+                     DataType data_type) = 0;
 
     SegmentType
     type() const override {
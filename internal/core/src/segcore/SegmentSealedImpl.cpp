@@ -38,12 +38,15 @@
 #include "log/Log.h"
 #include "pb/schema.pb.h"
 #include "mmap/Types.h"
+#include "query/FilterCache.h"
 #include "query/ScalarIndex.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnSealed.h"
 #include "storage/Util.h"
 #include "storage/ThreadPools.h"
 #include "storage/ChunkCacheSingleton.h"
+#include "storage/SharedMmapStore.h"
+#include "storage/prometheus_client.h"
 #include "common/File.h"
 #include "common/Tracer.h"
 #include "index/VectorMemIndex.h"
@@ -65,15 +68,34 @@ get_bit(const BitsetType& bitset, FieldId field_id) {
     return bitset[pos];
 }
 
+// the mapped data is kept until unmapped
+static inline void
+UnlinkMappedFile(const std::filesystem::path& filepath) {
+    auto ok = unlink(filepath.c_str());
+    AssertInfo(ok == 0,
+               fmt::format("failed to unlink mmap data file {}, err: {}",
+                           filepath.c_str(),
+                           strerror(errno)));
+}
+
 void
 SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
     // print(info);
     // NOTE: lock only when data is ready to avoid starvation
     auto field_id = FieldId(info.field_id);
     auto& field_meta = schema_->operator[](field_id);
+    tracer::AutoSpan span("LoadIndex", info.trace_ctx);
+    span.SetAttribute("segment_id", id_);
+    span.SetAttribute("field_id", info.field_id);
+    if (info.index != nullptr) {
+        span.SetAttribute("memory_bytes", info.index->ByteSize());
+    }
 
     if (field_meta.is_vector()) {
         LoadVecIndex(info);
+    } else if (field_meta.get_data_type() == DataType::JSON ||
+               field_meta.get_data_type() == DataType::ARRAY) {
+        LoadInvertedIndex(info);
     } else {
         LoadScalarIndex(info);
     }
@@ -104,8 +126,13 @@ SegmentSealedImpl::LoadVecIndex(const LoadIndexInfo& info) {
                        std::to_string(num_rows_.value()) + ")");
     }
     if (get_bit(field_data_ready_bitset_, field_id)) {
-        fields_.erase(field_id);
-        set_bit(field_data_ready_bitset_, field_id, false);
+        // the raw vectors mapped from the disk are kept for an index without
+        // them, so the index stays in memory and the vectors are read from
+        // the mapped column instead of the chunk cache
+        if (!fields_.at(field_id)->IsMapped() || info.index->HasRawData()) {
+            fields_.erase(field_id);
+            set_bit(field_data_ready_bitset_, field_id, false);
+        }
     } else if (get_bit(binlog_index_bitset_, field_id)) {
         set_bit(binlog_index_bitset_, field_id, false);
         vector_indexings_.drop_field_indexing(field_id);
@@ -184,29 +211,100 @@ SegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
     lck.unlock();
 }
 
+void
+SegmentSealedImpl::LoadInvertedIndex(const LoadIndexInfo& info) {
+    auto field_id = FieldId(info.field_id);
+    auto& field_meta = schema_->operator[](field_id);
+    auto row_count = info.index->Count();
+    AssertInfo(row_count > 0, "Index count is 0");
+    if (field_meta.get_data_type() == DataType::JSON) {
+        AssertInfo(
+            dynamic_cast<index::JsonInvertedIndex*>(info.index.get()) !=
+                nullptr,
+            "index of json field {} isn't a json index",
+            field_id.get());
+    } else {
+        AssertInfo(
+            dynamic_cast<index::ArrayInvertedIndex*>(info.index.get()) !=
+                nullptr,
+            "index of array field {} isn't an array index",
+            field_id.get());
+    }
+
+    std::unique_lock lck(mutex_);
+    AssertInfo(inverted_indexings_.find(field_id) == inverted_indexings_.end(),
+               "inverted index has been exist at {}",
+               field_id.get());
+    if (num_rows_.has_value()) {
+        AssertInfo(num_rows_.value() == row_count,
+                   "field (" + std::to_string(field_id.get()) +
+                       ") data has different row count (" +
+                       std::to_string(row_count) +
+                       ") than other column's row count (" +
+                       std::to_string(num_rows_.value()) + ")");
+    }
+
+    inverted_indexings_[field_id] =
+        std::move(const_cast<LoadIndexInfo&>(info).index);
+    update_row_count(row_count);
+}
+
 void
 SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& load_info) {
     // NOTE: lock only when data is ready to avoid starvation
     // only one field for now, parallel load field data in golang
     size_t num_rows = storage::GetNumRowsForLoadInfo(load_info);
+    tracer::AutoSpan span("LoadFieldData", load_info.trace_ctx);
+    span.SetAttribute("segment_id", id_);
+    span.SetAttribute("num_rows", static_cast<int64_t>(num_rows));
 
     for (auto& [id, info] : load_info.field_infos) {
         AssertInfo(info.row_count > 0, "The row count of field data is 0");
+        // loaded at the first access, see LoadLazyFields
+        if (info.lazy_load) {
+            continue;
+        }
 
         auto field_id = FieldId(id);
         auto insert_files = info.insert_files;
         auto field_data_info =
             FieldDataInfo(field_id.get(), num_rows, load_info.mmap_dir_path);
-
+        if (snapshot_.enabled()) {
+            field_data_info.snapshot_fingerprint =
+                SegmentSnapshot::Fingerprint(insert_files, num_rows);
+        }
+        field_data_info.mmap_advice = info.mmap_advice;
+        field_data_info.mlock = info.mlock;
+
+        tracer::AutoSpan field_span("LoadField");
+        field_span.SetAttribute("field_id", id);
+        field_span.SetAttribute("files",
+                                static_cast<int64_t>(insert_files.size()));
+        field_span.SetAttribute("mmap", info.enable_mmap);
         LOG_SEGCORE_INFO_ << "start to load field data " << id << " of segment "
                           << this->id_;
+        auto data_type = (*schema_)[field_id].get_data_type();
+        if (info.enable_mmap &&
+            !SystemProperty::Instance().IsSystem(field_id) &&
+            !datatype_is_variable(data_type) &&
+            info.entries_nums.size() == insert_files.size()) {
+            MapFixedWidthFieldData(field_id, info, num_rows, field_data_info);
+            LOG_SEGCORE_INFO_ << "finish loading segment field, "
+                              << "segmentID:" << this->id_
+                              << ", fieldID:" << info.field_id;
+            continue;
+        }
+
         auto parallel_degree = static_cast<uint64_t>(
             DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
         field_data_info.channel->set_capacity(parallel_degree * 2);
         auto& pool =
             ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-        auto load_future = pool.Submit(
-            LoadFieldDatasFromRemote, insert_files, field_data_info.channel);
+        auto load_future = pool.Submit(LoadFieldDatasFromRemote,
+                                       insert_files,
+                                       field_data_info.channel,
+                                       info.field_id,
+                                       &field_data_info.statistics);
         LOG_SEGCORE_INFO_ << "finish submitting LoadFieldDatasFromRemote task "
                              "to thread pool, "
                           << "segmentID:" << this->id_
@@ -272,34 +370,29 @@ SegmentSealedImpl::LoadFieldDataV2(const LoadFieldDataInfo& load_info) {
 }
 void
 SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
+    invalidate_filter_cache();
     auto num_rows = data.row_count;
     if (SystemProperty::Instance().IsSystem(field_id)) {
         auto system_field_type =
             SystemProperty::Instance().GetSystemFieldType(field_id);
         if (system_field_type == SystemFieldType::Timestamp) {
-            std::vector<Timestamp> timestamps(num_rows);
-            int64_t offset = 0;
-            auto field_data = storage::CollectFieldDataChannel(data.channel);
-            for (auto& data : field_data) {
-                int64_t row_count = data->get_num_rows();
-                std::copy_n(static_cast<const Timestamp*>(data->Data()),
-                            row_count,
-                            timestamps.data() + offset);
-                offset += row_count;
-            }
+            // merge the batches as they arrive rather than holding all of
+            // them and a copy of the timestamps at the same time
+            auto field_data = storage::MergeFieldDataChannel(
+                data.channel, DataType::INT64, num_rows);
+            auto timestamps = static_cast<const Timestamp*>(field_data->Data());
 
             TimestampIndex index;
             auto min_slice_length = num_rows < 4096 ? 1 : 4096;
-            auto meta = GenerateFakeSlices(
-                timestamps.data(), num_rows, min_slice_length);
+            auto meta =
+                GenerateFakeSlices(timestamps, num_rows, min_slice_length);
             index.set_length_meta(std::move(meta));
-            // todo ::opt to avoid copy timestamps from field data
-            index.build_with(timestamps.data(), num_rows);
+            index.build_with(timestamps, num_rows);
 
             // use special index
             std::unique_lock lck(mutex_);
             AssertInfo(insert_record_.timestamps_.empty(), "already exists");
-            insert_record_.timestamps_.fill_chunk_data(field_data);
+            insert_record_.timestamps_.fill_chunk_data({field_data});
             insert_record_.timestamp_index_ = std::move(index);
             AssertInfo(insert_record_.timestamps_.num_chunk() == 1,
                        "num chunk not equal to 1 for sealed segment");
@@ -307,12 +400,13 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
             AssertInfo(system_field_type == SystemFieldType::RowId,
                        "System field type of id column is not RowId");
 
-            auto field_data = storage::CollectFieldDataChannel(data.channel);
+            auto field_data = storage::MergeFieldDataChannel(
+                data.channel, DataType::INT64, num_rows);
 
             // write data under lock
             std::unique_lock lck(mutex_);
             AssertInfo(insert_record_.row_ids_.empty(), "already exists");
-            insert_record_.row_ids_.fill_chunk_data(field_data);
+            insert_record_.row_ids_.fill_chunk_data({field_data});
             AssertInfo(insert_record_.row_ids_.num_chunk() == 1,
                        "num chunk not equal to 1 for sealed segment");
         }
@@ -347,6 +441,11 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
                     }
                     var_column->Seal();
                     LoadStringSkipIndex(field_id, 0, *var_column);
+                    BuildFieldStats(field_id, data_type, var_column, data);
+                    auto dict_ratio = segcore_config_.get_dict_encode_ratio();
+                    if (dict_ratio > 0) {
+                        var_column->EncodeDictionary(dict_ratio);
+                    }
                     column = std::move(var_column);
                     break;
                 }
@@ -368,6 +467,10 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
                         }
                     }
                     var_column->Seal();
+                    if (segcore_config_.get_json_binary_encoding()) {
+                        var_column->EncodeBinaryJson();
+                    }
+                    LoadJsonKeyColumns(field_id, *var_column);
                     column = std::move(var_column);
                     break;
                 }
@@ -397,13 +500,32 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
             SegmentInternalInterface::set_field_avg_size(
                 field_id, num_rows, field_data_size);
         } else {
-            column = std::make_shared<Column>(num_rows, field_meta);
+            auto raw_column = std::make_shared<Column>(num_rows, field_meta);
             FieldDataPtr field_data;
             while (data.channel->pop(field_data)) {
-                column->AppendBatch(field_data);
+                raw_column->AppendBatch(field_data);
             }
+            // the range of the column is known from the statistics of the
+            // binlogs, if all of them have the statistics
             LoadPrimitiveSkipIndex(
-                field_id, 0, data_type, column->Span().data(), num_rows);
+                field_id,
+                0,
+                data_type,
+                raw_column->Span().data(),
+                num_rows,
+                data.statistics.has_value() ? &*data.statistics : nullptr);
+            BuildFieldStats(field_id, data_type, raw_column, data);
+            column = raw_column;
+
+            // the pks are indexed from the raw rows
+            auto pack_ratio = segcore_config_.get_pack_ratio();
+            if (pack_ratio > 0 &&
+                schema_->get_primary_field_id() != field_id) {
+                if (auto packed = PackedColumn::Pack(
+                        *raw_column, data_type, pack_ratio)) {
+                    column = std::move(packed);
+                }
+            }
         }
 
         AssertInfo(column->NumRows() == num_rows,
@@ -422,28 +544,17 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         if (schema_->get_primary_field_id() == field_id) {
             AssertInfo(field_id.get() != -1, "Primary key is -1");
             AssertInfo(insert_record_.empty_pks(), "already exists");
-            insert_record_.insert_pks(data_type, column);
-            insert_record_.seal_pks();
+            LoadPkIndex(data_type, column, data.snapshot_fingerprint);
         }
 
-        bool use_temp_index = false;
         {
             // update num_rows to build temperate binlog index
             std::unique_lock lck(mutex_);
             update_row_count(num_rows);
-        }
-
-        if (generate_binlog_index(field_id)) {
-            std::unique_lock lck(mutex_);
-            fields_.erase(field_id);
-            set_bit(field_data_ready_bitset_, field_id, false);
-            use_temp_index = true;
-        }
-
-        if (!use_temp_index) {
-            std::unique_lock lck(mutex_);
+            // the interim index replaces the raw data once built
             set_bit(field_data_ready_bitset_, field_id, true);
         }
+        generate_binlog_index(field_id, data.snapshot_fingerprint);
     }
     {
         std::unique_lock lck(mutex_);
@@ -453,6 +564,7 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
 
 void
 SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
+    invalidate_filter_cache();
     auto filepath = std::filesystem::path(data.mmap_dir_path) /
                     std::to_string(get_segment_id()) /
                     std::to_string(field_id.get());
@@ -468,12 +580,12 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
     size_t total_written{0};
     auto data_size = 0;
     std::vector<uint64_t> indices{};
-    std::vector<std::vector<uint64_t>> element_indices{};
+    ArrayElementOffsets element_offsets{};
     FieldDataPtr field_data;
     while (data.channel->pop(field_data)) {
         data_size += field_data->Size();
         auto written =
-            WriteFieldData(file, data_type, field_data, element_indices);
+            WriteFieldData(file, data_type, field_data, element_offsets);
         if (written != field_data->Size()) {
             break;
         }
@@ -501,7 +613,7 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
             case milvus::DataType::VARCHAR: {
                 auto var_column = std::make_shared<VariableColumn<std::string>>(
                     file, total_written, field_meta);
-                var_column->Seal(std::move(indices));
+                var_column->Seal(std::move(indices), file);
                 column = std::move(var_column);
                 break;
             }
@@ -509,15 +621,16 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
                 auto var_column =
                     std::make_shared<VariableColumn<milvus::Json>>(
                         file, total_written, field_meta);
-                var_column->Seal(std::move(indices));
+                var_column->Seal(std::move(indices), file);
+                LoadJsonKeyColumns(field_id, *var_column);
                 column = std::move(var_column);
                 break;
             }
             case milvus::DataType::ARRAY: {
                 auto arr_column = std::make_shared<ArrayColumn>(
                     file, total_written, field_meta);
-                arr_column->Seal(std::move(indices),
-                                 std::move(element_indices));
+                arr_column->Seal(
+                    std::move(indices), std::move(element_offsets), file);
                 column = std::move(arr_column);
                 break;
             }
@@ -530,27 +643,313 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
         column = std::make_shared<Column>(file, total_written, field_meta);
     }
 
+    UnlinkMappedFile(filepath);
+    LoadMappedColumn(field_id, std::move(column), data);
+}
+
+void
+SegmentSealedImpl::MapFixedWidthFieldData(const FieldId field_id,
+                                          const FieldBinlogInfo& info,
+                                          size_t num_rows,
+                                          const FieldDataInfo& data) {
+    auto& field_meta = (*schema_)[field_id];
+    auto row_size = field_meta.get_sizeof();
+    auto data_size = row_size * num_rows;
+    auto write = [&](const std::string& filepath) {
+        auto file = File::Open(filepath, O_CREAT | O_TRUNC | O_RDWR);
+        auto total_written = WriteFieldDatasFromRemote(
+            info.insert_files, info.entries_nums, row_size, file);
+        AssertInfo(total_written == data_size,
+                   fmt::format("failed to write data file {}, written {} but "
+                               "total {}, err: {}",
+                               filepath,
+                               total_written,
+                               data_size,
+                               strerror(errno)));
+        return file;
+    };
+
+    // the replicas of the segment on the host map the same file
+    if (auto store = storage::SharedMmapStore::Get(); store != nullptr) {
+        auto lease = store->Acquire(
+            storage::SharedMmapStore::Key(
+                "field", info.insert_files, std::to_string(row_size)),
+            write);
+        AssertInfo(lease->Size() == data_size,
+                   fmt::format("shared mmap file {} of field {} has {} bytes "
+                               "but expected {}",
+                               lease->Path().c_str(),
+                               field_id.get(),
+                               lease->Size(),
+                               data_size));
+        auto column =
+            std::make_shared<Column>(lease->Open(), data_size, field_meta);
+        column->HoldFile(std::move(lease));
+        LoadMappedColumn(field_id, std::move(column), data);
+        return;
+    }
+
+    auto filepath = std::filesystem::path(data.mmap_dir_path) /
+                    std::to_string(get_segment_id()) /
+                    std::to_string(field_id.get());
+    std::filesystem::create_directories(filepath.parent_path());
+    auto column = std::make_shared<Column>(
+        write(filepath.string()), data_size, field_meta);
+    UnlinkMappedFile(filepath);
+    LoadMappedColumn(field_id, std::move(column), data);
+}
+
+void
+SegmentSealedImpl::LoadMappedColumn(const FieldId field_id,
+                                    std::shared_ptr<ColumnBase> column,
+                                    const FieldDataInfo& data) {
+    auto& field_meta = (*schema_)[field_id];
+    auto data_type = field_meta.get_data_type();
+    column->Advise(data.mmap_advice.value_or(DefaultMmapAdvice(field_meta)));
+    if (data.mlock && !column->Lock()) {
+        LOG_SEGCORE_WARNING_ << "field " << field_id.get() << " of segment "
+                             << id_ << " is not locked, over the mlock budget";
+    }
     {
         std::unique_lock lck(mutex_);
         fields_.emplace(field_id, column);
     }
 
-    auto ok = unlink(filepath.c_str());
-    AssertInfo(ok == 0,
-               fmt::format("failed to unlink mmap data file {}, err: {}",
-                           filepath.c_str(),
-                           strerror(errno)));
-
     // set pks to offset
     if (schema_->get_primary_field_id() == field_id) {
         AssertInfo(field_id.get() != -1, "Primary key is -1");
         AssertInfo(insert_record_.empty_pks(), "already exists");
+        LoadPkIndex(data_type, column, data.snapshot_fingerprint);
+    }
+
+    std::unique_lock lck(mutex_);
+    set_bit(field_data_ready_bitset_, field_id, true);
+}
+
+void
+SegmentSealedImpl::LoadPkIndex(DataType data_type,
+                               const std::shared_ptr<ColumnBase>& column,
+                               uint64_t snapshot_fingerprint) {
+    if (snapshot_fingerprint == 0) {
         insert_record_.insert_pks(data_type, column);
         insert_record_.seal_pks();
+        return;
     }
 
+    // the order is used only if it's a permutation of the rows
+    auto num_rows = column->NumRows();
+    auto order_file = snapshot_.LoadPkOrder(snapshot_fingerprint);
+    const int64_t* order = nullptr;
+    if (order_file != nullptr &&
+        order_file->size() == num_rows * sizeof(int64_t)) {
+        order = reinterpret_cast<const int64_t*>(order_file->data());
+        std::vector<bool> seen(num_rows);
+        for (int64_t i = 0; i < num_rows && order != nullptr; ++i) {
+            if (order[i] < 0 || order[i] >= num_rows || seen[order[i]]) {
+                order = nullptr;
+            } else {
+                seen[order[i]] = true;
+            }
+        }
+    }
+    insert_record_.insert_pks(data_type, column, order);
+    insert_record_.seal_pks();
+    if (order == nullptr) {
+        auto sorted_offsets = insert_record_.pk_sorted_offsets();
+        if (!sorted_offsets.empty()) {
+            snapshot_.SavePkOrder(snapshot_fingerprint, sorted_offsets);
+        }
+    }
+}
+
+void
+SegmentSealedImpl::BuildFieldStats(FieldId field_id,
+                                   DataType data_type,
+                                   const std::shared_ptr<ColumnBase>& column,
+                                   const FieldDataInfo& data) {
+    auto num_rows = static_cast<int64_t>(column->NumRows());
+    auto null_count =
+        data.statistics.has_value() ? data.statistics->null_count : 0;
+    auto build = [&]() -> std::optional<FieldStats> {
+        auto values = [&](auto type_tag) {
+            using T = decltype(type_tag);
+            auto raw = reinterpret_cast<const T*>(column->Data());
+            return FieldStats::Build<T>(
+                num_rows, null_count, [raw](int64_t i) { return raw[i]; });
+        };
+        switch (data_type) {
+            case DataType::INT8:
+                return values(int8_t());
+            case DataType::INT16:
+                return values(int16_t());
+            case DataType::INT32:
+                return values(int32_t());
+            case DataType::INT64:
+                return values(int64_t());
+            case DataType::FLOAT:
+                return values(float());
+            case DataType::DOUBLE:
+                return values(double());
+            case DataType::VARCHAR: {
+                auto var_column =
+                    std::dynamic_pointer_cast<VariableColumn<std::string>>(
+                        column);
+                if (var_column == nullptr) {
+                    return std::nullopt;
+                }
+                return FieldStats::Build<std::string_view>(
+                    num_rows, null_count, [&](int64_t i) {
+                        return var_column->RawAt(i);
+                    });
+            }
+            default:
+                return std::nullopt;
+        }
+    };
+
+    auto fingerprint =
+        data.snapshot_fingerprint == 0
+            ? 0
+            : SegmentSnapshot::WithParams(data.snapshot_fingerprint,
+                                          "field_stats");
+    if (fingerprint != 0) {
+        if (auto file = snapshot_.LoadFieldStats(field_id, fingerprint)) {
+            auto stats = FieldStats::Deserialize(file->data(), file->size());
+            if (stats.has_value() && stats->num_rows == num_rows) {
+                LoadFieldStats(field_id,
+                               std::make_shared<FieldStats>(std::move(*stats)));
+                return;
+            }
+        }
+    }
+    auto stats = build();
+    if (!stats.has_value()) {
+        return;
+    }
+    if (fingerprint != 0) {
+        snapshot_.SaveFieldStats(field_id, fingerprint, stats->Serialize());
+    }
+    LoadFieldStats(field_id, std::make_shared<FieldStats>(std::move(*stats)));
+}
+
+void
+SegmentSealedImpl::LoadJsonKeyColumns(
+    FieldId field_id, const VariableColumn<milvus::Json>& column) {
+    std::map<std::string, DataType> key_types;
+    {
+        std::shared_lock lck(mutex_);
+        auto it = json_key_types_.find(field_id);
+        if (it == json_key_types_.end()) {
+            return;
+        }
+        key_types = it->second;
+    }
+
+    std::map<std::string, std::unique_ptr<JsonKeyColumn>> key_columns;
+    for (const auto& [pointer, data_type] : key_types) {
+        key_columns.emplace(
+            pointer,
+            std::make_unique<JsonKeyColumn>(
+                pointer, data_type, column.Views().data(), column.NumRows()));
+    }
     std::unique_lock lck(mutex_);
-    set_bit(field_data_ready_bitset_, field_id, true);
+    auto& columns = json_key_columns_[field_id];
+    for (auto& [pointer, key_column] : key_columns) {
+        columns[pointer] = std::move(key_column);
+    }
+}
+
+void
+SegmentSealedImpl::AddJsonKeyColumn(FieldId field_id,
+                                    const std::string& pointer,
+                                    DataType data_type) {
+    auto& field_meta = (*schema_)[field_id];
+    AssertInfo(field_meta.get_data_type() == DataType::JSON,
+               "json key column of non json field {}",
+               field_id.get());
+    AssertInfo(data_type == DataType::INT64 || data_type == DataType::DOUBLE ||
+                   data_type == DataType::BOOL ||
+                   data_type == DataType::VARCHAR,
+               "unsupported json key column type: {}",
+               data_type);
+
+    std::shared_ptr<ColumnBase> column;
+    {
+        std::unique_lock lck(mutex_);
+        json_key_types_[field_id][pointer] = data_type;
+        if (auto it = fields_.find(field_id); it != fields_.end()) {
+            column = it->second;
+        }
+    }
+    if (column == nullptr) {
+        return;
+    }
+
+    auto json_column =
+        std::dynamic_pointer_cast<VariableColumn<milvus::Json>>(column);
+    AssertInfo(json_column != nullptr,
+               "json field {} isn't loaded as a json column",
+               field_id.get());
+    auto key_column =
+        std::make_unique<JsonKeyColumn>(pointer,
+                                        data_type,
+                                        json_column->Views().data(),
+                                        json_column->NumRows());
+    std::unique_lock lck(mutex_);
+    json_key_columns_[field_id][pointer] = std::move(key_column);
+}
+
+const JsonKeyColumn*
+SegmentSealedImpl::GetJsonKeyColumn(FieldId field_id,
+                                    const std::string& pointer) const {
+    std::shared_lock lck(mutex_);
+    auto it = json_key_columns_.find(field_id);
+    if (it == json_key_columns_.end()) {
+        return nullptr;
+    }
+    auto iter = it->second.find(pointer);
+    return iter == it->second.end() ? nullptr : iter->second.get();
+}
+
+const index::JsonInvertedIndex*
+SegmentSealedImpl::GetJsonIndex(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto it = inverted_indexings_.find(field_id);
+    return it == inverted_indexings_.end()
+               ? nullptr
+               : dynamic_cast<const index::JsonInvertedIndex*>(
+                     it->second.get());
+}
+
+const index::ArrayInvertedIndex*
+SegmentSealedImpl::GetArrayIndex(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto it = inverted_indexings_.find(field_id);
+    return it == inverted_indexings_.end()
+               ? nullptr
+               : dynamic_cast<const index::ArrayInvertedIndex*>(
+                     it->second.get());
+}
+
+const StringDictionary*
+SegmentSealedImpl::GetStringDictionary(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto it = fields_.find(field_id);
+    if (it == fields_.end()) {
+        return nullptr;
+    }
+    auto column =
+        dynamic_cast<const VariableColumn<std::string>*>(it->second.get());
+    return column == nullptr ? nullptr : column->Dictionary();
+}
+
+const PackedColumn*
+SegmentSealedImpl::GetPackedColumn(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto it = fields_.find(field_id);
+    return it == fields_.end()
+               ? nullptr
+               : dynamic_cast<const PackedColumn*>(it->second.get());
 }
 
 void
@@ -574,10 +973,45 @@ SegmentSealedImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
 void
 SegmentSealedImpl::AddFieldDataInfoForSealed(
     const LoadFieldDataInfo& field_data_info) {
+    std::unique_lock lck(mutex_);
     // copy assignment
     field_data_info_ = field_data_info;
 }
 
+void
+SegmentSealedImpl::PrefetchChunkCache(FieldId field_id) const {
+    auto& field_meta = schema_->operator[](field_id);
+    AssertInfo(field_meta.is_vector(), "prefetch field is not vector type");
+    // HasRawData takes the lock itself, it is true of the vectors without
+    // an index as well
+    if (HasRawData(field_id.get())) {
+        return;
+    }
+    auto cc = storage::ChunkCacheSingleton::GetInstance().GetChunkCache();
+    if (cc == nullptr) {
+        return;
+    }
+    std::vector<std::string> binlogs;
+    std::optional<int> advice;
+    {
+        std::shared_lock lck(mutex_);
+        if (!get_bit(index_ready_bitset_, field_id) &&
+            !get_bit(binlog_index_bitset_, field_id)) {
+            return;
+        }
+        auto it = field_data_info_.field_infos.find(field_id.get());
+        if (it == field_data_info_.field_infos.end()) {
+            return;
+        }
+        binlogs = it->second.insert_files;
+        advice = it->second.mmap_advice;
+    }
+    // the binlogs are fetched without the lock held
+    for (const auto& binlog : binlogs) {
+        cc->PrefetchAsync(binlog, advice);
+    }
+}
+
 // internal API: support scalar index only
 int64_t
 SegmentSealedImpl::num_chunk_index(FieldId field_id) const {
@@ -629,12 +1063,30 @@ SegmentSealedImpl::chunk_index_impl(FieldId field_id, int64_t chunk_id) const {
     return ptr;
 }
 
-int64_t
-SegmentSealedImpl::GetMemoryUsageInBytes() const {
-    // TODO: add estimate for index
+SegmentMemoryUsage
+SegmentSealedImpl::GetMemoryUsage() const {
     std::shared_lock lck(mutex_);
-    auto row_count = num_rows_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    SegmentMemoryUsage usage;
+    for (auto& [field_id, column] : fields_) {
+        usage.field_data += column->MemoryByteSize();
+    }
+    for (auto& [field_id, columns] : json_key_columns_) {
+        for (auto& [pointer, column] : columns) {
+            usage.field_data += column->ByteSize();
+        }
+    }
+    usage.index = vector_indexings_.byte_size();
+    for (auto& [field_id, index] : scalar_indexings_) {
+        usage.index += index->ByteSize();
+    }
+    for (auto& [field_id, index] : inverted_indexings_) {
+        usage.index += index->ByteSize();
+    }
+    usage.pk_index = insert_record_.pks_byte_size();
+    usage.timestamps = insert_record_.timestamps_.byte_size() +
+                       insert_record_.row_ids_.byte_size();
+    usage.deleted_record = deleted_record_.byte_size();
+    return usage;
 }
 
 int64_t
@@ -691,7 +1143,15 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
 
     AssertInfo(field_meta.is_vector(),
                "The meta type of vector field is not vector type");
-    if (get_bit(binlog_index_bitset_, field_id)) {
+    auto indexed = get_bit(binlog_index_bitset_, field_id) ||
+                   get_bit(index_ready_bitset_, field_id);
+    auto brute_force = indexed && UseBruteForce(field_id, bitset);
+    if (brute_force) {
+        // under a selective filter the index visits many filtered out rows,
+        // scanning the few surviving ones is cheaper
+        internal_sealed_vector_search_count_brute_force.Increment();
+    } else if (get_bit(binlog_index_bitset_, field_id)) {
+        internal_sealed_vector_search_count_index.Increment();
         AssertInfo(
             vec_binlog_config_.find(field_id) != vec_binlog_config_.end(),
             "The binlog params is not generate.");
@@ -710,7 +1170,9 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    output);
         milvus::tracer::AddEvent(
             "finish_searching_vector_temperate_binlog_index");
+        return;
     } else if (get_bit(index_ready_bitset_, field_id)) {
+        internal_sealed_vector_search_count_index.Increment();
         AssertInfo(vector_indexings_.is_ready(field_id),
                    "vector indexes isn't ready for field " +
                        std::to_string(field_id.get()));
@@ -722,23 +1184,46 @@ SegmentSealedImpl::vector_search(SearchInfo& search_info,
                                    bitset,
                                    output);
         milvus::tracer::AddEvent("finish_searching_vector_index");
-    } else {
-        AssertInfo(
-            get_bit(field_data_ready_bitset_, field_id),
-            "Field Data is not loaded: " + std::to_string(field_id.get()));
-        AssertInfo(num_rows_.has_value(), "Can't get row count value");
-        auto row_count = num_rows_.value();
-        auto vec_data = fields_.at(field_id);
-        query::SearchOnSealed(*schema_,
-                              vec_data->Data(),
-                              search_info,
-                              query_data,
-                              query_count,
-                              row_count,
-                              bitset,
-                              output);
-        milvus::tracer::AddEvent("finish_searching_vector_data");
+        return;
+    }
+
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Field Data is not loaded: " + std::to_string(field_id.get()));
+    AssertInfo(num_rows_.has_value(), "Can't get row count value");
+    auto row_count = num_rows_.value();
+    auto vec_data = fields_.at(field_id);
+    // the cosine is the inner product scaled by the norms of the rows, which
+    // are computed once for the column instead of by every search
+    const float* inv_norms = nullptr;
+    if (field_meta.get_data_type() == DataType::VECTOR_FLOAT &&
+        IsMetricType(search_info.metric_type_, knowhere::metric::COSINE)) {
+        if (auto column = std::dynamic_pointer_cast<Column>(vec_data)) {
+            inv_norms = column->InvNorms(field_meta.get_dim());
+        }
     }
+    query::SearchOnSealed(*schema_,
+                          vec_data->Data(),
+                          search_info,
+                          query_data,
+                          query_count,
+                          row_count,
+                          bitset,
+                          output,
+                          inv_norms);
+    milvus::tracer::AddEvent("finish_searching_vector_data");
+}
+
+bool
+SegmentSealedImpl::UseBruteForce(FieldId field_id,
+                                 const BitsetView& bitset) const {
+    if (!get_bit(field_data_ready_bitset_, field_id) || bitset.empty()) {
+        return false;
+    }
+    // the set bits are the filtered out rows
+    auto num_rows = bitset.size();
+    auto num_valid = num_rows - bitset.count();
+    return num_valid <=
+           num_rows * segcore_config_.get_brute_force_selectivity();
 }
 
 std::tuple<std::string, int64_t>
@@ -764,9 +1249,11 @@ SegmentSealedImpl::GetFieldDataPath(FieldId field_id, int64_t offset) const {
 }
 
 std::tuple<std::string, std::shared_ptr<ColumnBase>> static ReadFromChunkCache(
-    const storage::ChunkCachePtr& cc, const std::string& data_path) {
-    auto column = cc->Read(data_path);
-    cc->Prefetch(data_path);
+    const storage::ChunkCachePtr& cc,
+    const std::string& data_path,
+    std::optional<int> advice) {
+    auto column = cc->Read(data_path, advice);
+    cc->Prefetch(data_path, advice);
     return {data_path, column};
 }
 
@@ -782,6 +1269,11 @@ SegmentSealedImpl::get_vector(FieldId field_id,
         return fill_with_empty(field_id, count);
     }
 
+    // the raw vectors kept besides the index, see LoadVecIndex
+    if (get_bit(field_data_ready_bitset_, field_id)) {
+        return get_raw_data(field_id, field_meta, ids, count);
+    }
+
     AssertInfo(vector_indexings_.is_ready(field_id),
                "vector index is not ready");
     auto field_indexing = vector_indexings_.get_field_indexing(field_id);
@@ -803,52 +1295,65 @@ SegmentSealedImpl::get_vector(FieldId field_id,
         // If index doesn't have raw data, get vector from chunk cache.
         auto cc = storage::ChunkCacheSingleton::GetInstance().GetChunkCache();
 
-        // group by data_path
-        auto id_to_data_path =
-            std::unordered_map<std::int64_t,
-                               std::tuple<std::string, int64_t>>{};
-        auto path_to_column =
-            std::unordered_map<std::string, std::shared_ptr<ColumnBase>>{};
+        // group the rows by data_path
+        struct BinlogRows {
+            // of the rows in the result
+            std::vector<int64_t> indices;
+            // of the rows in the binlog
+            std::vector<int64_t> offsets;
+        };
+        std::unordered_map<std::string, BinlogRows> path_to_rows;
         for (auto i = 0; i < count; i++) {
-            const auto& tuple = GetFieldDataPath(field_id, ids[i]);
-            id_to_data_path.emplace(ids[i], tuple);
-            path_to_column.emplace(std::get<0>(tuple), nullptr);
-        }
-
-        // read and prefetch
-        auto& pool =
-            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
-        std::vector<
-            std::future<std::tuple<std::string, std::shared_ptr<ColumnBase>>>>
-            futures;
-        futures.reserve(path_to_column.size());
-        for (const auto& iter : path_to_column) {
-            const auto& data_path = iter.first;
-            futures.emplace_back(
-                pool.Submit(ReadFromChunkCache, cc, data_path));
+            const auto& [data_path, offset_in_binlog] =
+                GetFieldDataPath(field_id, ids[i]);
+            auto& rows = path_to_rows[data_path];
+            rows.indices.push_back(i);
+            rows.offsets.push_back(offset_in_binlog);
         }
 
-        for (int i = 0; i < futures.size(); ++i) {
-            const auto& [data_path, column] = futures[i].get();
-            path_to_column[data_path] = column;
+        // read and prefetch by the advice of the field
+        std::optional<int> advice;
+        auto info_iter = field_data_info_.field_infos.find(field_id.get());
+        if (info_iter != field_data_info_.field_infos.end()) {
+            advice = info_iter->second.mmap_advice;
         }
-
-        // assign to data array
         auto row_bytes = field_meta.get_sizeof();
         auto buf = std::vector<char>(count * row_bytes);
-        for (auto i = 0; i < count; i++) {
-            AssertInfo(id_to_data_path.count(ids[i]) != 0, "id not found");
-            const auto& [data_path, offset_in_binlog] =
-                id_to_data_path.at(ids[i]);
-            AssertInfo(path_to_column.count(data_path) != 0,
-                       "column not found");
-            const auto& column = path_to_column.at(data_path);
-            AssertInfo(offset_in_binlog * row_bytes < column->ByteSize(),
-                       fmt::format("column idx out of range, idx: {}, size: {}",
-                                   offset_in_binlog * row_bytes,
-                                   column->ByteSize()));
-            auto vector = &column->Data()[offset_in_binlog * row_bytes];
-            std::memcpy(buf.data() + i * row_bytes, vector, row_bytes);
+        // only the byte ranges of the rows are read from the binlogs in the
+        // raw layout, the other ones are read whole into the chunk cache
+        auto read_rows = [&cc, &advice, &buf, row_bytes](
+                             const std::string& data_path,
+                             const BinlogRows& rows) {
+            std::vector<uint8_t> rows_buf(rows.offsets.size() * row_bytes);
+            if (!cc->ReadRows(
+                    data_path, rows.offsets, row_bytes, rows_buf.data())) {
+                auto [path, column] = ReadFromChunkCache(cc, data_path, advice);
+                for (size_t k = 0; k < rows.offsets.size(); k++) {
+                    auto offset = rows.offsets[k] * row_bytes;
+                    AssertInfo(offset < column->ByteSize(),
+                               "column idx out of range, idx: {}, size: {}",
+                               offset,
+                               column->ByteSize());
+                    std::memcpy(rows_buf.data() + k * row_bytes,
+                                column->Data() + offset,
+                                row_bytes);
+                }
+            }
+            for (size_t k = 0; k < rows.indices.size(); k++) {
+                std::memcpy(buf.data() + rows.indices[k] * row_bytes,
+                            rows_buf.data() + k * row_bytes,
+                            row_bytes);
+            }
+        };
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        std::vector<std::future<void>> futures;
+        futures.reserve(path_to_rows.size());
+        for (const auto& [data_path, rows] : path_to_rows) {
+            futures.emplace_back(pool.Submit(read_rows, data_path, rows));
+        }
+        for (auto& future : futures) {
+            future.get();
         }
         return segcore::CreateVectorDataArrayFrom(
             buf.data(), count, field_meta);
@@ -857,6 +1362,7 @@ SegmentSealedImpl::get_vector(FieldId field_id,
 
 void
 SegmentSealedImpl::DropFieldData(const FieldId field_id) {
+    invalidate_filter_cache();
     if (SystemProperty::Instance().IsSystem(field_id)) {
         auto system_field_type =
             SystemProperty::Instance().GetSystemFieldType(field_id);
@@ -876,6 +1382,7 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
             set_bit(field_data_ready_bitset_, field_id, false);
             insert_record_.drop_field_data(field_id);
         }
+        json_key_columns_.erase(field_id);
         if (get_bit(binlog_index_bitset_, field_id)) {
             set_bit(binlog_index_bitset_, field_id, false);
             vector_indexings_.drop_field_indexing(field_id);
@@ -884,12 +1391,25 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
     }
 }
 
+void
+SegmentSealedImpl::invalidate_filter_cache() const {
+    // the filters are cached by the segment interface they're evaluated on
+    query::FilterCache::GetInstance().Erase(
+        static_cast<const SegmentInternalInterface*>(this));
+}
+
 void
 SegmentSealedImpl::DropIndex(const FieldId field_id) {
     AssertInfo(!SystemProperty::Instance().IsSystem(field_id),
                "Field id:" + std::to_string(field_id.get()) +
                    " isn't one of system type when drop index");
     auto& field_meta = schema_->operator[](field_id);
+    if (field_meta.get_data_type() == DataType::JSON ||
+        field_meta.get_data_type() == DataType::ARRAY) {
+        std::unique_lock lck(mutex_);
+        inverted_indexings_.erase(field_id);
+        return;
+    }
     AssertInfo(field_meta.is_vector(),
                "Field meta of offset:" + std::to_string(field_id.get()) +
                    " is not vector type");
@@ -931,6 +1451,63 @@ SegmentSealedImpl::check_search(const query::Plan* plan) const {
     }
 }
 
+void
+SegmentSealedImpl::LoadLazyFields(const std::vector<FieldId>& field_ids) const {
+    for (auto field_id : field_ids) {
+        if (SystemProperty::Instance().IsSystem(field_id) ||
+            HasFieldData(field_id)) {
+            continue;
+        }
+        auto it = field_data_info_.field_infos.find(field_id.get());
+        if (it == field_data_info_.field_infos.end() ||
+            !it->second.lazy_load) {
+            continue;
+        }
+        // the vectors without raw data in the index are read from the chunk
+        // cache instead, see get_vector
+        if (HasIndex(field_id) &&
+            (schema_->operator[](field_id).is_vector() ||
+             HasRawData(field_id.get()))) {
+            continue;
+        }
+
+        std::promise<void> promise;
+        std::shared_future<void> load;
+        bool loading = false;
+        {
+            std::lock_guard lck(lazy_loads_mutex_);
+            auto [iter, inserted] = lazy_loads_.try_emplace(field_id);
+            if (inserted) {
+                iter->second = promise.get_future().share();
+                loading = true;
+            }
+            load = iter->second;
+        }
+        if (loading) {
+            LOG_SEGCORE_INFO_ << "lazily loading field " << field_id.get()
+                              << " of segment " << id_;
+            try {
+                LoadFieldDataInfo load_info;
+                auto info = it->second;
+                info.lazy_load = false;
+                load_info.field_infos.emplace(field_id.get(), std::move(info));
+                load_info.mmap_dir_path = field_data_info_.mmap_dir_path;
+                // the load publishes the field under mutex_ like the loads
+                // before the segment serves
+                const_cast<SegmentSealedImpl*>(this)->LoadFieldData(load_info);
+                promise.set_value();
+            } catch (...) {
+                {
+                    std::lock_guard lck(lazy_loads_mutex_);
+                    lazy_loads_.erase(field_id);
+                }
+                promise.set_exception(std::current_exception());
+            }
+        }
+        load.get();
+    }
+}
+
 SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema,
                                      IndexMetaPtr index_meta,
                                      const SegcoreConfig& segcore_config,
@@ -943,10 +1520,20 @@ SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema,
       insert_record_(*schema, MAX_ROW_COUNT),
       schema_(schema),
       id_(segment_id),
-      col_index_meta_(index_meta) {
+      col_index_meta_(index_meta),
+      snapshot_(segcore_config.get_snapshot_dir(), segment_id) {
 }
 
 SegmentSealedImpl::~SegmentSealedImpl() {
+    // the builds still queued are canceled rather than waited for until the
+    // pool reaches them, only the running ones are waited for
+    {
+        auto& state = *binlog_index_build_state_;
+        std::unique_lock lck(state.mutex);
+        state.canceled = true;
+        state.cv.wait(lck, [&state] { return state.running == 0; });
+    }
+    invalidate_filter_cache();
     auto cc = storage::ChunkCacheSingleton::GetInstance().GetChunkCache();
     if (cc == nullptr) {
         return;
@@ -1001,6 +1588,9 @@ SegmentSealedImpl::bulk_subscript_impl(const void* src_raw,
     static_assert(IsScalar<T>);
     auto src = static_cast<const S*>(src_raw);
     for (int64_t i = 0; i < count; ++i) {
+        if (i + GATHER_PREFETCH_DISTANCE < count) {
+            __builtin_prefetch(src + seg_offsets[i + GATHER_PREFETCH_DISTANCE]);
+        }
         auto offset = seg_offsets[i];
         dst[i] = src[offset];
     }
@@ -1058,6 +1648,12 @@ SegmentSealedImpl::bulk_subscript_impl(int64_t element_sizeof,
     auto column = reinterpret_cast<const char*>(src_raw);
     auto dst_vec = reinterpret_cast<char*>(dst_raw);
     for (int64_t i = 0; i < count; ++i) {
+        if (i + GATHER_PREFETCH_DISTANCE < count) {
+            PrefetchRow(
+                column +
+                    element_sizeof * seg_offsets[i + GATHER_PREFETCH_DISTANCE],
+                element_sizeof);
+        }
         auto offset = seg_offsets[i];
         auto src = column + element_sizeof * offset;
         auto dst = dst_vec + i * element_sizeof;
@@ -1084,6 +1680,44 @@ SegmentSealedImpl::get_raw_data(FieldId field_id,
     // to make sure it won't get released if segment released
     auto column = fields_.at(field_id);
     auto ret = fill_with_empty(field_id, count);
+    if (auto packed = dynamic_cast<const PackedColumn*>(column.get())) {
+        auto scalars = ret->mutable_scalars();
+        switch (field_meta.get_data_type()) {
+            case DataType::INT8:
+                packed->Gather<int8_t>(seg_offsets,
+                                       count,
+                                       scalars->mutable_int_data()
+                                           ->mutable_data()
+                                           ->mutable_data());
+                break;
+            case DataType::INT16:
+                packed->Gather<int16_t>(seg_offsets,
+                                        count,
+                                        scalars->mutable_int_data()
+                                            ->mutable_data()
+                                            ->mutable_data());
+                break;
+            case DataType::INT32:
+                packed->Gather<int32_t>(seg_offsets,
+                                        count,
+                                        scalars->mutable_int_data()
+                                            ->mutable_data()
+                                            ->mutable_data());
+                break;
+            case DataType::INT64:
+                packed->Gather<int64_t>(seg_offsets,
+                                        count,
+                                        scalars->mutable_long_data()
+                                            ->mutable_data()
+                                            ->mutable_data());
+                break;
+            default:
+                PanicInfo(DataTypeInvalid,
+                          "unsupported packed data type {}",
+                          field_meta.get_data_type());
+        }
+        return ret;
+    }
     switch (field_meta.get_data_type()) {
         case DataType::VARCHAR:
         case DataType::STRING: {
@@ -1260,6 +1894,17 @@ SegmentSealedImpl::HasIndex(FieldId field_id) const {
            get_bit(binlog_index_bitset_, field_id);
 }
 
+std::string
+SegmentSealedImpl::vector_index_type(FieldId field_id) const {
+    // of the index loaded, or else of the interim one built from the binlogs
+    if (!vector_indexings_.is_ready(field_id)) {
+        return "";
+    }
+    auto vec_index = dynamic_cast<const index::VectorIndex*>(
+        vector_indexings_.get_field_indexing(field_id)->indexing_.get());
+    return vec_index != nullptr ? vec_index->GetIndexType() : "";
+}
+
 bool
 SegmentSealedImpl::HasFieldData(FieldId field_id) const {
     std::shared_lock lck(mutex_);
@@ -1283,7 +1928,8 @@ SegmentSealedImpl::HasRawData(int64_t field_id) const {
             auto field_indexing = vector_indexings_.get_field_indexing(fieldID);
             auto vec_index = dynamic_cast<index::VectorIndex*>(
                 field_indexing->indexing_.get());
-            return vec_index->HasRawData();
+            return vec_index->HasRawData() ||
+                   get_bit(field_data_ready_bitset_, fieldID);
         }
     } else {
         auto scalar_index = scalar_indexings_.find(fieldID);
@@ -1308,27 +1954,24 @@ SegmentSealedImpl::search_ids(const IdArray& id_array,
     auto res_id_arr = std::make_unique<IdArray>();
     std::vector<SegOffset> res_offsets;
     res_offsets.reserve(pks.size());
-    for (auto& pk : pks) {
-        auto segOffsets = insert_record_.search_pk(pk, timestamp);
-        for (auto offset : segOffsets) {
-            switch (data_type) {
-                case DataType::INT64: {
-                    res_id_arr->mutable_int_id()->add_data(
-                        std::get<int64_t>(pk));
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    res_id_arr->mutable_str_id()->add_data(
-                        std::get<std::string>(std::move(pk)));
-                    break;
-                }
-                default: {
-                    PanicInfo(DataTypeInvalid,
-                              fmt::format("unsupported type {}", data_type));
-                }
+    for (auto& [i, offset] : insert_record_.search_pks(pks, timestamp)) {
+        switch (data_type) {
+            case DataType::INT64: {
+                res_id_arr->mutable_int_id()->add_data(
+                    std::get<int64_t>(pks[i]));
+                break;
+            }
+            case DataType::VARCHAR: {
+                res_id_arr->mutable_str_id()->add_data(
+                    std::get<std::string>(pks[i]));
+                break;
+            }
+            default: {
+                PanicInfo(DataTypeInvalid,
+                          fmt::format("unsupported type {}", data_type));
             }
-            res_offsets.push_back(offset);
         }
+        res_offsets.push_back(offset);
     }
     return {std::move(res_id_arr), std::move(res_offsets)};
 }
@@ -1344,19 +1987,17 @@ SegmentSealedImpl::Delete(int64_t reserved_offset,  // deprecated
     std::vector<PkType> pks(size);
     ParsePksFromIDs(pks, field_meta.get_data_type(), *ids);
 
-    // filter out the deletions that the primary key not exists
-    std::vector<std::tuple<Timestamp, PkType>> ordering(size);
+    // filter out the deletions that the primary key not exists, probed as
+    // a batch merge joined with the sorted pks
+    auto contained = insert_record_.contain_batch(pks);
+    std::vector<std::tuple<Timestamp, PkType>> ordering;
+    ordering.reserve(size);
     for (int i = 0; i < size; i++) {
-        ordering[i] = std::make_tuple(timestamps_raw[i], pks[i]);
-    }
-    auto end =
-        std::remove_if(ordering.begin(),
-                       ordering.end(),
-                       [&](const std::tuple<Timestamp, PkType>& record) {
-                           return !insert_record_.contain(std::get<1>(record));
-                       });
-    size = end - ordering.begin();
-    ordering.resize(size);
+        if (contained[i]) {
+            ordering.emplace_back(timestamps_raw[i], pks[i]);
+        }
+    }
+    size = ordering.size();
     if (size == 0) {
         return SegcoreError::success();
     }
@@ -1428,13 +2069,20 @@ SegmentSealedImpl::mask_with_timestamps(BitsetType& bitset_chunk,
         bitset_chunk.set();
         return;
     }
-    auto mask = TimestampIndex::GenerateBitset(
+    auto mask = insert_record_.timestamp_index_.GenerateBitset(
         timestamp, range, timestamps_data.data(), timestamps_data.size());
     bitset_chunk |= mask;
 }
 
 bool
-SegmentSealedImpl::generate_binlog_index(const FieldId field_id) {
+SegmentSealedImpl::all_visible(Timestamp timestamp) const {
+    auto range = insert_record_.timestamp_index_.get_active_range(timestamp);
+    return range.first == range.second && range.first == get_row_count();
+}
+
+bool
+SegmentSealedImpl::generate_binlog_index(const FieldId field_id,
+                                         uint64_t snapshot_fingerprint) {
     if (col_index_meta_ == nullptr)
         return false;
     auto& field_meta = schema_->operator[](field_id);
@@ -1455,33 +2103,106 @@ SegmentSealedImpl::generate_binlog_index(const FieldId field_id) {
             // get binlog data and meta
             auto row_count = num_rows_.value();
             auto dim = field_meta.get_dim();
-            auto vec_data = fields_.at(field_id);
-            auto dataset =
-                knowhere::GenDataSet(row_count, dim, (void*)vec_data->Data());
-            dataset->SetIsOwner(false);
+            std::shared_ptr<ColumnBase> vec_data;
+            {
+                std::shared_lock lck(mutex_);
+                vec_data = fields_.at(field_id);
+            }
             // generate index params
-            auto field_binlog_config = std::unique_ptr<VecIndexConfig>(
+            auto field_binlog_config = std::shared_ptr<VecIndexConfig>(
                 new VecIndexConfig(row_count,
                                    field_index_meta,
                                    segcore_config_,
                                    SegmentType::Sealed));
             auto build_config = field_binlog_config->GetBuildBaseParams();
             build_config[knowhere::meta::DIM] = std::to_string(dim);
-            build_config[knowhere::meta::NUM_BUILD_THREAD] = std::to_string(1);
+            build_config[knowhere::meta::NUM_BUILD_THREAD] = std::to_string(
+                segcore_config_.get_interim_index_build_threads());
             auto index_metric = field_binlog_config->GetMetricType();
 
-            index::IndexBasePtr vec_index =
-                std::make_unique<index::VectorMemIndex<float>>(
+            auto index_version =
+                knowhere::Version::GetCurrentVersion().VersionNumber();
+            auto new_index = [field_binlog_config,
+                              index_metric,
+                              index_version]() -> index::IndexBasePtr {
+                return std::make_unique<index::VectorMemIndex<float>>(
                     field_binlog_config->GetIndexType(),
                     index_metric,
-                    knowhere::Version::GetCurrentVersion().VersionNumber());
-            vec_index->BuildWithDataset(dataset, build_config);
-            vector_indexings_.append_field_indexing(
-                field_id, index_metric, std::move(vec_index));
+                    index_version);
+            };
+
+            // the snapshot is of the same binlogs, built by the same params
+            // and the same knowhere, the thread count doesn't change the
+            // index
+            auto snapshot_config = build_config;
+            snapshot_config.erase(knowhere::meta::NUM_BUILD_THREAD);
+            auto index_fingerprint = SegmentSnapshot::WithParams(
+                snapshot_fingerprint,
+                snapshot_config.dump() + std::to_string(index_version));
+            if (snapshot_fingerprint != 0) {
+                if (auto binary_set = snapshot_.LoadInterimIndex(
+                        field_id, index_fingerprint)) {
+                    try {
+                        auto vec_index = new_index();
+                        vec_index->Load(*binary_set);
+                        return install_binlog_index(field_id,
+                                                    vec_data,
+                                                    std::move(vec_index),
+                                                    field_binlog_config);
+                    } catch (std::exception& e) {
+                        LOG_SEGCORE_WARNING_
+                            << "failed to restore the interim index of field "
+                            << field_id.get() << ": " << e.what();
+                    }
+                }
+            }
 
-            vec_binlog_config_[field_id] = std::move(field_binlog_config);
-            set_bit(binlog_index_bitset_, field_id, true);
+            auto build = [=]() {
+                auto dataset = knowhere::GenDataSet(
+                    row_count, dim, (void*)vec_data->Data());
+                dataset->SetIsOwner(false);
+                auto vec_index = new_index();
+                vec_index->BuildWithDataset(dataset, build_config);
+                if (snapshot_fingerprint != 0) {
+                    snapshot_.SaveInterimIndex(field_id,
+                                               index_fingerprint,
+                                               vec_index->Serialize({}));
+                }
+                return install_binlog_index(field_id,
+                                            vec_data,
+                                            std::move(vec_index),
+                                            field_binlog_config);
+            };
+            if (!segcore_config_.get_async_interim_index_build()) {
+                return build();
+            }
 
+            // the raw vectors serve the searches by brute force until the
+            // index is built in the background
+            auto& pool =
+                ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::LOW);
+            std::lock_guard lck(binlog_index_builds_mutex_);
+            binlog_index_builds_.push_back(pool.Submit(
+                [this, field_id, build, state = binlog_index_build_state_]() {
+                    {
+                        std::lock_guard state_lck(state->mutex);
+                        if (state->canceled) {
+                            return;
+                        }
+                        ++state->running;
+                    }
+                    try {
+                        build();
+                    } catch (std::exception& e) {
+                        LOG_SEGCORE_WARNING_
+                            << "failed to build the interim index of field "
+                            << field_id.get() << " of segment " << id_
+                            << ": " << e.what();
+                    }
+                    std::lock_guard state_lck(state->mutex);
+                    --state->running;
+                    state->cv.notify_all();
+                }));
             return true;
         } catch (std::exception& e) {
             return false;
@@ -1491,4 +2212,42 @@ SegmentSealedImpl::generate_binlog_index(const FieldId field_id) {
     }
 }
 
+bool
+SegmentSealedImpl::install_binlog_index(
+    const FieldId field_id,
+    const std::shared_ptr<ColumnBase>& column,
+    index::IndexBasePtr vec_index,
+    std::shared_ptr<VecIndexConfig> config) {
+    std::unique_lock lck(mutex_);
+    // the index is stale if the field has been dropped, reloaded or indexed
+    // while it was built
+    auto iter = fields_.find(field_id);
+    if (iter == fields_.end() || iter->second != column ||
+        !get_bit(field_data_ready_bitset_, field_id) ||
+        get_bit(index_ready_bitset_, field_id) ||
+        get_bit(binlog_index_bitset_, field_id)) {
+        return false;
+    }
+    vector_indexings_.append_field_indexing(
+        field_id, config->GetMetricType(), std::move(vec_index));
+    vec_binlog_config_[field_id] = std::move(config);
+    set_bit(binlog_index_bitset_, field_id, true);
+    // the index keeps the raw vectors
+    fields_.erase(iter);
+    set_bit(field_data_ready_bitset_, field_id, false);
+    return true;
+}
+
+void
+SegmentSealedImpl::WaitBinlogIndexBuilds() {
+    std::vector<std::future<void>> builds;
+    {
+        std::lock_guard lck(binlog_index_builds_mutex_);
+        builds.swap(binlog_index_builds_);
+    }
+    for (auto& build : builds) {
+        build.wait();
+    }
+}
+
 }  // namespace milvus::segcore
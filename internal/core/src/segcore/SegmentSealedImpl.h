@@ -14,9 +14,12 @@
 #include <tbb/concurrent_priority_queue.h>
 #include <tbb/concurrent_vector.h>
 
+#include <condition_variable>
 #include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -27,6 +30,7 @@
 #include "ScalarIndex.h"
 #include "SealedIndexingRecord.h"
 #include "SegmentSealed.h"
+#include "SegmentSnapshot.h"
 #include "TimestampIndex.h"
 #include "common/EasyAssert.h"
 #include "google/protobuf/message_lite.h"
@@ -45,6 +49,11 @@ class SegmentSealedImpl : public SegmentSealed {
                                const SegcoreConfig& segcore_config,
                                int64_t segment_id);
     ~SegmentSealedImpl() override;
+
+    // wait for the interim indexes building in the background
+    void
+    WaitBinlogIndexBuilds();
+
     void
     LoadIndex(const LoadIndexInfo& info) override;
     void
@@ -62,6 +71,8 @@ class SegmentSealedImpl : public SegmentSealed {
     DropFieldData(const FieldId field_id) override;
     bool
     HasIndex(FieldId field_id) const override;
+    std::string
+    vector_index_type(FieldId field_id) const override;
     bool
     HasFieldData(FieldId field_id) const override;
 
@@ -77,6 +88,28 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     AddFieldDataInfoForSealed(
         const LoadFieldDataInfo& field_data_info) override;
+    void
+    PrefetchChunkCache(FieldId field_id) const override;
+    void
+    AddJsonKeyColumn(FieldId field_id,
+                     const std::string& pointer,
+                     DataType data_type) override;
+
+    const JsonKeyColumn*
+    GetJsonKeyColumn(FieldId field_id,
+                     const std::string& pointer) const override;
+
+    const index::JsonInvertedIndex*
+    GetJsonIndex(FieldId field_id) const override;
+
+    const index::ArrayInvertedIndex*
+    GetArrayIndex(FieldId field_id) const override;
+
+    const StringDictionary*
+    GetStringDictionary(FieldId field_id) const override;
+
+    const PackedColumn*
+    GetPackedColumn(FieldId field_id) const override;
 
     int64_t
     get_segment_id() const override {
@@ -87,8 +120,8 @@ class SegmentSealedImpl : public SegmentSealed {
     HasRawData(int64_t field_id) const override;
 
  public:
-    int64_t
-    GetMemoryUsageInBytes() const override;
+    SegmentMemoryUsage
+    GetMemoryUsage() const override;
 
     int64_t
     get_row_count() const override;
@@ -160,6 +193,12 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     check_search(const query::Plan* plan) const override;
 
+    // load the fields registered with lazy_load by AddFieldDataInfoForSealed
+    // at their first access, the concurrent first accesses of a field wait
+    // on a single load of it
+    void
+    LoadLazyFields(const std::vector<FieldId>& field_ids) const override;
+
     int64_t
     get_active_count(Timestamp ts) const override;
 
@@ -226,6 +265,9 @@ class SegmentSealedImpl : public SegmentSealed {
     mask_with_timestamps(BitsetType& bitset_chunk,
                          Timestamp timestamp) const override;
 
+    bool
+    all_visible(Timestamp timestamp) const override;
+
     void
     vector_search(SearchInfo& search_info,
                   const void* query_data,
@@ -261,8 +303,71 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     LoadScalarIndex(const LoadIndexInfo& info);
 
+    // the json and array indexes serve the filters aside the raw data, which
+    // is still needed for the filters the indexes can't answer
+    void
+    LoadInvertedIndex(const LoadIndexInfo& info);
+
+    // build the interim index of the vector field, or restore it from the
+    // snapshot of the binlogs of the fingerprint. The index is built in the
+    // background if async_interim_index_build is set, returns whether the
+    // index has been or is being built
     bool
-    generate_binlog_index(const FieldId field_id);
+    generate_binlog_index(const FieldId field_id,
+                          uint64_t snapshot_fingerprint = 0);
+
+    // replace the raw vectors of the column by the interim index, unless the
+    // column has been dropped or indexed since
+    bool
+    install_binlog_index(const FieldId field_id,
+                         const std::shared_ptr<ColumnBase>& column,
+                         index::IndexBasePtr vec_index,
+                         std::shared_ptr<VecIndexConfig> config);
+
+    // drop the cached filters of the segment once its data changes
+    void
+    invalidate_filter_cache() const;
+
+    // index the pks of the column, in the order restored from the snapshot
+    // of the binlogs of the fingerprint if any
+    void
+    LoadPkIndex(DataType data_type,
+                const std::shared_ptr<ColumnBase>& column,
+                uint64_t snapshot_fingerprint);
+
+    // the statistics of a loaded scalar field, restored from the snapshot of
+    // the binlogs of the fingerprint if any
+    void
+    BuildFieldStats(FieldId field_id,
+                    DataType data_type,
+                    const std::shared_ptr<ColumnBase>& column,
+                    const FieldDataInfo& data);
+
+    // whether the indexed vector field is searched over its raw data, which
+    // is cheaper when few rows pass the filter
+    bool
+    UseBruteForce(FieldId field_id, const BitsetView& bitset) const;
+
+    // the row offset of each binlog is known from entries_nums, so fixed
+    // width binlogs are written into the mmap file in parallel right after
+    // each one is decoded, instead of being passed through the channel. The
+    // file is of the shared mmap store if enabled, written once for the
+    // replicas of the host
+    void
+    MapFixedWidthFieldData(const FieldId field_id,
+                           const FieldBinlogInfo& info,
+                           size_t num_rows,
+                           const FieldDataInfo& data);
+
+    void
+    LoadMappedColumn(const FieldId field_id,
+                     std::shared_ptr<ColumnBase> column,
+                     const FieldDataInfo& data);
+
+    // extract the configured json paths from the loaded json column
+    void
+    LoadJsonKeyColumns(FieldId field_id,
+                       const VariableColumn<milvus::Json>& column);
 
  private:
     // segment loading state
@@ -287,16 +392,43 @@ class SegmentSealedImpl : public SegmentSealed {
     mutable DeletedRecord deleted_record_;
 
     LoadFieldDataInfo field_data_info_;
+    // the loads of the lazily loaded fields, a failed load is removed to be
+    // retried at the next access
+    mutable std::mutex lazy_loads_mutex_;
+    mutable std::unordered_map<FieldId, std::shared_future<void>> lazy_loads_;
 
     SchemaPtr schema_;
     int64_t id_;
     std::unordered_map<FieldId, std::shared_ptr<ColumnBase>> fields_;
 
+    // json paths to extract for each json field, and the extracted columns
+    std::unordered_map<FieldId, std::map<std::string, DataType>>
+        json_key_types_;
+    std::unordered_map<FieldId,
+                       std::map<std::string, std::unique_ptr<JsonKeyColumn>>>
+        json_key_columns_;
+    // json and array field index
+    std::unordered_map<FieldId, index::IndexBasePtr> inverted_indexings_;
+
     // only useful in binlog
     IndexMetaPtr col_index_meta_;
     SegcoreConfig segcore_config_;
-    std::unordered_map<FieldId, std::unique_ptr<VecIndexConfig>>
+    std::unordered_map<FieldId, std::shared_ptr<VecIndexConfig>>
         vec_binlog_config_;
+    // the interim indexes building in the background
+    std::mutex binlog_index_builds_mutex_;
+    std::vector<std::future<void>> binlog_index_builds_;
+    // shared with the queued builds, which may outlive the segment: the
+    // builds not started once it is canceled don't touch the segment
+    struct BinlogIndexBuildState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool canceled = false;
+        int64_t running = 0;
+    };
+    std::shared_ptr<BinlogIndexBuildState> binlog_index_build_state_ =
+        std::make_shared<BinlogIndexBuildState>();
+    SegmentSnapshot snapshot_;
 };
 
 inline SegmentSealedUPtr
@@ -0,0 +1,281 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SegmentSnapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <boost/crc.hpp>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+constexpr uint64_t SNAPSHOT_MAGIC = 0x5053534d4c564d00;
+constexpr uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+constexpr char PK_ORDER_FILE[] = "pk_order";
+
+struct SnapshotHeader {
+    uint64_t magic;
+    uint32_t version;
+    // of the payload
+    uint32_t crc;
+    uint64_t fingerprint;
+    uint64_t payload_size;
+};
+
+uint32_t
+Crc32(const void* data, size_t size, uint32_t crc = 0) {
+    boost::crc_32_type result;
+    result.reset(crc);
+    result.process_bytes(data, size);
+    return result.checksum();
+}
+
+// FNV-1a, stable across the builds unlike std::hash
+uint64_t
+Fnv1a(const void* data, size_t size, uint64_t hash) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+    return hash;
+}
+
+std::string
+InterimIndexFile(FieldId field_id) {
+    return "interim_index_" + std::to_string(field_id.get());
+}
+
+std::string
+FieldStatsFile(FieldId field_id) {
+    return "field_stats_" + std::to_string(field_id.get());
+}
+
+}  // namespace
+
+SnapshotFile::~SnapshotFile() {
+    munmap(map_, map_size_);
+}
+
+SegmentSnapshot::SegmentSnapshot(const std::string& dir, int64_t segment_id) {
+    if (!dir.empty()) {
+        dir_ = std::filesystem::path(dir) / std::to_string(segment_id);
+    }
+}
+
+uint64_t
+SegmentSnapshot::Fingerprint(std::vector<std::string> files,
+                             int64_t num_rows) {
+    std::sort(files.begin(), files.end());
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto& file : files) {
+        hash = Fnv1a(file.data(), file.size(), hash);
+        // a separator so that the files can't be split differently
+        hash = Fnv1a("", 1, hash);
+    }
+    return Fnv1a(&num_rows, sizeof(num_rows), hash);
+}
+
+uint64_t
+SegmentSnapshot::WithParams(uint64_t fingerprint, std::string_view params) {
+    return Fnv1a(params.data(), params.size(), fingerprint);
+}
+
+std::unique_ptr<SnapshotFile>
+SegmentSnapshot::Open(const std::string& name, uint64_t fingerprint) const {
+    if (!enabled()) {
+        return nullptr;
+    }
+    auto path = dir_ / name;
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = st.st_size;
+    auto map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return nullptr;
+    }
+    auto file =
+        std::make_unique<SnapshotFile>(map, size, sizeof(SnapshotHeader));
+    SnapshotHeader header;
+    std::memcpy(&header, map, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC ||
+        header.version != SNAPSHOT_FORMAT_VERSION ||
+        header.fingerprint != fingerprint ||
+        header.payload_size != file->size()) {
+        LOG_SEGCORE_INFO_ << "ignore the stale segment snapshot " << path;
+        return nullptr;
+    }
+    if (Crc32(file->data(), file->size()) != header.crc) {
+        LOG_SEGCORE_WARNING_ << "ignore the broken segment snapshot " << path;
+        return nullptr;
+    }
+    return file;
+}
+
+void
+SegmentSnapshot::Write(
+    const std::string& name,
+    uint64_t fingerprint,
+    const std::vector<std::pair<const void*, size_t>>& parts) const {
+    if (!enabled()) {
+        return;
+    }
+    SnapshotHeader header{SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, 0,
+                          fingerprint, 0};
+    for (auto& [data, size] : parts) {
+        header.crc = Crc32(data, size, header.crc);
+        header.payload_size += size;
+    }
+
+    // written aside and renamed, so a crash never leaves a partial file
+    auto path = dir_ / name;
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    try {
+        std::filesystem::create_directories(dir_);
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (auto& [data, size] : parts) {
+                out.write(static_cast<const char*>(data), size);
+            }
+            out.close();
+            AssertInfo(out.good(), "failed to write {}", tmp_path.string());
+        }
+        std::filesystem::rename(tmp_path, path);
+    } catch (std::exception& e) {
+        LOG_SEGCORE_WARNING_ << "failed to write the segment snapshot " << path
+                             << ": " << e.what();
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+std::unique_ptr<SnapshotFile>
+SegmentSnapshot::LoadPkOrder(uint64_t fingerprint) const {
+    auto file = Open(PK_ORDER_FILE, fingerprint);
+    if (file != nullptr && file->size() % sizeof(int64_t) != 0) {
+        return nullptr;
+    }
+    return file;
+}
+
+void
+SegmentSnapshot::SavePkOrder(uint64_t fingerprint,
+                             const std::vector<int64_t>& order) const {
+    Write(PK_ORDER_FILE,
+          fingerprint,
+          {{order.data(), order.size() * sizeof(int64_t)}});
+}
+
+std::unique_ptr<knowhere::BinarySet>
+SegmentSnapshot::LoadInterimIndex(FieldId field_id,
+                                  uint64_t fingerprint) const {
+    auto file = Open(InterimIndexFile(field_id), fingerprint);
+    if (file == nullptr) {
+        return nullptr;
+    }
+    // the binaries as (name size, name, data size, data)
+    auto binary_set = std::make_unique<knowhere::BinarySet>();
+    auto pos = file->data();
+    auto end = file->data() + file->size();
+    auto read_size = [&](uint64_t* size) {
+        if (end - pos < static_cast<int64_t>(sizeof(*size))) {
+            return false;
+        }
+        std::memcpy(size, pos, sizeof(*size));
+        pos += sizeof(*size);
+        return *size <= static_cast<uint64_t>(end - pos);
+    };
+    while (pos < end) {
+        uint64_t name_size, data_size;
+        if (!read_size(&name_size)) {
+            return nullptr;
+        }
+        std::string name(reinterpret_cast<const char*>(pos), name_size);
+        pos += name_size;
+        if (!read_size(&data_size)) {
+            return nullptr;
+        }
+        std::shared_ptr<uint8_t[]> data(new uint8_t[data_size]);
+        std::memcpy(data.get(), pos, data_size);
+        pos += data_size;
+        binary_set->Append(name, data, data_size);
+    }
+    return binary_set;
+}
+
+void
+SegmentSnapshot::SaveInterimIndex(
+    FieldId field_id,
+    uint64_t fingerprint,
+    const knowhere::BinarySet& binary_set) const {
+    std::vector<uint64_t> sizes;
+    sizes.reserve(binary_set.binary_map_.size() * 2);
+    std::vector<std::pair<const void*, size_t>> parts;
+    for (auto& [name, binary] : binary_set.binary_map_) {
+        sizes.push_back(name.size());
+        sizes.push_back(binary->size);
+    }
+    size_t i = 0;
+    for (auto& [name, binary] : binary_set.binary_map_) {
+        parts.emplace_back(&sizes[i++], sizeof(uint64_t));
+        parts.emplace_back(name.data(), name.size());
+        parts.emplace_back(&sizes[i++], sizeof(uint64_t));
+        parts.emplace_back(binary->data.get(), binary->size);
+    }
+    Write(InterimIndexFile(field_id), fingerprint, parts);
+}
+
+std::unique_ptr<SnapshotFile>
+SegmentSnapshot::LoadFieldStats(FieldId field_id, uint64_t fingerprint) const {
+    return Open(FieldStatsFile(field_id), fingerprint);
+}
+
+void
+SegmentSnapshot::SaveFieldStats(FieldId field_id,
+                                uint64_t fingerprint,
+                                const std::vector<uint8_t>& stats) const {
+    Write(FieldStatsFile(field_id),
+          fingerprint,
+          {{stats.data(), stats.size()}});
+}
+
+void
+SegmentSnapshot::Remove() const {
+    if (!enabled()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(dir_, ec);
+}
+
+}  // namespace milvus::segcore
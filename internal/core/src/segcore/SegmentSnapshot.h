@@ -0,0 +1,122 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Types.h"
+#include "knowhere/binaryset.h"
+
+namespace milvus::segcore {
+
+// A snapshot file mmapped read-only, validated against its header
+class SnapshotFile {
+ public:
+    SnapshotFile(void* map, size_t map_size, size_t payload_offset)
+        : map_(map), map_size_(map_size), payload_offset_(payload_offset) {
+    }
+
+    ~SnapshotFile();
+
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile&
+    operator=(const SnapshotFile&) = delete;
+
+    const uint8_t*
+    data() const {
+        return static_cast<const uint8_t*>(map_) + payload_offset_;
+    }
+
+    size_t
+    size() const {
+        return map_size_ - payload_offset_;
+    }
+
+ private:
+    void* map_;
+    size_t map_size_;
+    size_t payload_offset_;
+};
+
+// The structures a sealed segment derives from its binlogs, persisted to
+// {dir}/{segment id}/ so that a restarted process restores them instead of
+// rebuilding them. Each file is stamped with the fingerprint of the data it
+// is derived from and a checksum, a file of another fingerprint, format
+// version or checksum is ignored and rebuilt. The snapshots are optional,
+// the failures to write them are logged and the segment loads on.
+class SegmentSnapshot {
+ public:
+    // disabled if dir is empty
+    SegmentSnapshot(const std::string& dir, int64_t segment_id);
+
+    bool
+    enabled() const {
+        return !dir_.empty();
+    }
+
+    // the fingerprint of the binlogs of a field of num_rows rows, in any
+    // order of the files
+    static uint64_t
+    Fingerprint(std::vector<std::string> files, int64_t num_rows);
+
+    // the fingerprint of a structure built with the params from the data of
+    // the fingerprint
+    static uint64_t
+    WithParams(uint64_t fingerprint, std::string_view params);
+
+    // the offsets of the rows in the order of their pks, nullptr if there is
+    // no valid snapshot of it
+    std::unique_ptr<SnapshotFile>
+    LoadPkOrder(uint64_t fingerprint) const;
+
+    void
+    SavePkOrder(uint64_t fingerprint, const std::vector<int64_t>& order) const;
+
+    std::unique_ptr<knowhere::BinarySet>
+    LoadInterimIndex(FieldId field_id, uint64_t fingerprint) const;
+
+    // the serialized FieldStats of a scalar field
+    std::unique_ptr<SnapshotFile>
+    LoadFieldStats(FieldId field_id, uint64_t fingerprint) const;
+
+    void
+    SaveFieldStats(FieldId field_id,
+                   uint64_t fingerprint,
+                   const std::vector<uint8_t>& stats) const;
+
+    void
+    SaveInterimIndex(FieldId field_id,
+                     uint64_t fingerprint,
+                     const knowhere::BinarySet& binary_set) const;
+
+    // remove all the snapshots of the segment
+    void
+    Remove() const;
+
+ private:
+    std::unique_ptr<SnapshotFile>
+    Open(const std::string& name, uint64_t fingerprint) const;
+
+    void
+    Write(const std::string& name,
+          uint64_t fingerprint,
+          const std::vector<std::pair<const void*, size_t>>& parts) const;
+
+    std::filesystem::path dir_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,226 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SlowCallRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/LoadInfo.h"
+#include "common/QueryResult.h"
+#include "log/Log.h"
+#include "query/PlanImpl.h"
+#include "query/generated/ShowPlanNodeVisitor.h"
+#include "segcore/SegcoreConfig.h"
+#include "segcore/SegmentInterface.h"
+#include "storage/SearchMetrics.h"
+
+namespace milvus::segcore {
+
+SlowCallRecorder::SlowCallRecorder()
+    : slots_(std::make_unique<Slot[]>(CAPACITY)) {
+}
+
+bool
+SlowCallRecorder::Enabled() {
+    return SegcoreConfig::default_config().get_slow_call_threshold_ms() > 0;
+}
+
+void
+SlowCallRecorder::RecordIfSlow(const char* call,
+                               int64_t segment_id,
+                               std::chrono::steady_clock::time_point start,
+                               const std::function<nlohmann::json()>& detail) {
+    auto threshold_ms =
+        SegcoreConfig::default_config().get_slow_call_threshold_ms();
+    if (threshold_ms <= 0) {
+        return;
+    }
+    auto latency = std::chrono::steady_clock::now() - start;
+    if (latency < std::chrono::milliseconds(threshold_ms)) {
+        return;
+    }
+    auto latency_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    std::string detail_str;
+    try {
+        detail_str = detail().dump(
+            -1, ' ', false, nlohmann::json::error_handler_t::replace);
+    } catch (std::exception& e) {
+        // the call is still recorded, without the detail
+        LOG_SEGCORE_WARNING_ << "failed to build the detail of slow call "
+                             << call << ": " << e.what();
+    }
+    Record(call, segment_id, latency_us, detail_str);
+}
+
+void
+SlowCallRecorder::Record(const std::string& call,
+                         int64_t segment_id,
+                         int64_t latency_us,
+                         const std::string& detail) {
+    auto data = std::make_unique<SlotData>();
+    data->seq = next_seq_.fetch_add(1, std::memory_order_relaxed);
+    data->segment_id = segment_id;
+    data->latency_us = latency_us;
+    data->finish_time_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    data->call_size = std::min(call.size(), CALL_SIZE);
+    std::memcpy(data->call, call.data(), data->call_size);
+    data->detail_size = std::min(detail.size(), DETAIL_SIZE);
+    std::memcpy(data->detail, detail.data(), data->detail_size);
+    Write(slots_[(data->seq - 1) % CAPACITY], *data);
+}
+
+bool
+SlowCallRecorder::Write(Slot& slot, const SlotData& data) {
+    auto version = slot.version.load(std::memory_order_relaxed);
+    if ((version & 1) != 0 ||
+        !slot.version.compare_exchange_strong(
+            version, version + 1, std::memory_order_relaxed)) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.data, &data, sizeof(SlotData));
+    slot.version.store(version + 2, std::memory_order_release);
+    return true;
+}
+
+std::vector<SlowCall>
+SlowCallRecorder::Snapshot() const {
+    std::vector<SlowCall> calls;
+    auto data = std::make_unique<SlotData>();
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        auto& slot = slots_[i];
+        auto version = slot.version.load(std::memory_order_acquire);
+        if ((version & 1) != 0) {
+            continue;
+        }
+        std::memcpy(data.get(), &slot.data, sizeof(SlotData));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != version ||
+            data->seq == 0) {
+            continue;
+        }
+        SlowCall call;
+        call.seq_ = data->seq;
+        call.call_.assign(data->call, data->call_size);
+        call.segment_id_ = data->segment_id;
+        call.latency_us_ = data->latency_us;
+        call.finish_time_ms_ = data->finish_time_ms;
+        call.detail_.assign(data->detail, data->detail_size);
+        calls.push_back(std::move(call));
+    }
+    std::sort(calls.begin(), calls.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.seq_ < rhs.seq_;
+    });
+    return calls;
+}
+
+std::string
+SlowCallRecorder::ToJson() const {
+    auto calls = nlohmann::json::array();
+    for (auto& call : Snapshot()) {
+        // the truncated details are kept as strings
+        auto detail = nlohmann::json::parse(call.detail_, nullptr, false);
+        if (detail.is_discarded()) {
+            detail = call.detail_;
+        }
+        calls.push_back({{"seq", call.seq_},
+                         {"call", call.call_},
+                         {"segment_id", call.segment_id_},
+                         {"latency_us", call.latency_us_},
+                         {"finish_time_ms", call.finish_time_ms_},
+                         {"detail", std::move(detail)}});
+    }
+    return calls.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+void
+SlowCallRecorder::Clear() {
+    auto empty = std::make_unique<SlotData>();
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        Write(slots_[i], *empty);
+    }
+}
+
+nlohmann::json
+SlowCallSegmentStats(const SegmentInterface& segment) {
+    return {{"segment_id", segment.get_segment_id()},
+            {"segment_type", storage::SegmentTypeLabel(segment.type())},
+            {"row_count", segment.get_row_count()},
+            {"deleted_count", segment.get_deleted_count()},
+            {"memory_bytes", segment.GetMemoryUsageInBytes()}};
+}
+
+void
+RecordIfSlowSearch(const SegmentInterface& segment,
+                   const query::Plan& plan,
+                   SearchResult& result,
+                   std::chrono::steady_clock::time_point start) {
+    SlowCallRecorder::GetInstance().RecordIfSlow(
+        "Search", segment.get_segment_id(), start, [&] {
+            auto stages = nlohmann::json::array();
+            if (result.profile_ != nullptr) {
+                stages = nlohmann::json::parse(result.profile_->ToJson());
+            }
+            return nlohmann::json{
+                {"plan",
+                 query::ShowPlanNodeVisitor().call_child(*plan.plan_node_)},
+                {"nq", result.total_nq_},
+                {"topk", result.unity_topK_},
+                {"segment", SlowCallSegmentStats(segment)},
+                {"stages", std::move(stages)}};
+        });
+    if (!plan.plan_node_->search_info_.profile_) {
+        result.profile_.reset();
+    }
+}
+
+void
+RecordIfSlowRetrieve(const SegmentInterface& segment,
+                     const query::RetrievePlan& plan,
+                     int64_t result_rows,
+                     std::chrono::steady_clock::time_point start) {
+    SlowCallRecorder::GetInstance().RecordIfSlow(
+        "Retrieve", segment.get_segment_id(), start, [&] {
+            return nlohmann::json{
+                {"plan",
+                 query::ShowPlanNodeVisitor().call_child(*plan.plan_node_)},
+                {"output_fields", plan.field_ids_.size()},
+                {"result_rows", result_rows},
+                {"segment", SlowCallSegmentStats(segment)}};
+        });
+}
+
+void
+RecordIfSlowLoad(const SegmentInterface& segment,
+                 const LoadFieldDataInfo& load_info,
+                 std::chrono::steady_clock::time_point start) {
+    SlowCallRecorder::GetInstance().RecordIfSlow(
+        "LoadFieldData", segment.get_segment_id(), start, [&] {
+            auto fields = nlohmann::json::array();
+            for (auto& [field_id, info] : load_info.field_infos) {
+                fields.push_back({{"field_id", field_id},
+                                  {"row_count", info.row_count},
+                                  {"files", info.insert_files.size()},
+                                  {"mmap", info.enable_mmap}});
+            }
+            return nlohmann::json{
+                {"fields", std::move(fields)},
+                {"storage_version", load_info.storage_version},
+                {"segment", SlowCallSegmentStats(segment)}};
+        });
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,159 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Json.h"
+
+struct LoadFieldDataInfo;
+
+namespace milvus {
+struct SearchResult;
+}  // namespace milvus
+
+namespace milvus::query {
+struct Plan;
+struct RetrievePlan;
+}  // namespace milvus::query
+
+namespace milvus::segcore {
+
+class SegmentInterface;
+
+// a call of segcore which took longer than the slow call threshold
+struct SlowCall {
+    // the number of the call, in the order the calls are recorded
+    uint64_t seq_ = 0;
+    // Search, Retrieve, LoadFieldData or AppendIndex
+    std::string call_;
+    int64_t segment_id_ = 0;
+    int64_t latency_us_ = 0;
+    // the unix time the call finished at
+    int64_t finish_time_ms_ = 0;
+    // the json of the plan summary, the stats of the segment and the stages
+    // of the call, truncated to DETAIL_SIZE bytes
+    std::string detail_;
+};
+
+// SlowCallRecorder keeps the latest slow calls of segcore in a ring of fixed
+// slots, so the latency spikes can be diagnosed after the fact.
+//
+// A call claims the next slot by a counter and writes it under the version of
+// the slot, which is odd while the slot is written, so neither the calls nor
+// the readers take a lock. A call finding the slot being written by a call of
+// a round before is dropped, a reader skips the slots written while read.
+class SlowCallRecorder {
+ public:
+    static SlowCallRecorder&
+    GetInstance() {
+        static SlowCallRecorder recorder;
+        return recorder;
+    }
+
+    SlowCallRecorder();
+
+    SlowCallRecorder(const SlowCallRecorder&) = delete;
+    SlowCallRecorder&
+    operator=(const SlowCallRecorder&) = delete;
+
+    // record the call if it took longer than the slow call threshold of the
+    // segcore config, the detail is built only then. Nothing is recorded if
+    // the threshold is 0
+    void
+    RecordIfSlow(const char* call,
+                 int64_t segment_id,
+                 std::chrono::steady_clock::time_point start,
+                 const std::function<nlohmann::json()>& detail);
+
+    static bool
+    Enabled();
+
+    void
+    Record(const std::string& call,
+           int64_t segment_id,
+           int64_t latency_us,
+           const std::string& detail);
+
+    // the slow calls in the ring, the oldest first
+    std::vector<SlowCall>
+    Snapshot() const;
+
+    // the json array of the slow calls, the oldest first
+    std::string
+    ToJson() const;
+
+    void
+    Clear();
+
+ public:
+    static constexpr size_t CAPACITY = 256;
+    static constexpr size_t CALL_SIZE = 32;
+    static constexpr size_t DETAIL_SIZE = 4096;
+
+ private:
+    struct SlotData {
+        // 0 if the slot is empty
+        uint64_t seq;
+        int64_t segment_id;
+        int64_t latency_us;
+        int64_t finish_time_ms;
+        uint32_t call_size;
+        uint32_t detail_size;
+        char call[CALL_SIZE];
+        char detail[DETAIL_SIZE];
+    };
+
+    struct Slot {
+        std::atomic<uint64_t> version{0};
+        SlotData data{};
+    };
+
+    // write the slot under its version, false if it's being written
+    static bool
+    Write(Slot& slot, const SlotData& data);
+
+ private:
+    std::atomic<uint64_t> next_seq_{1};
+    std::unique_ptr<Slot[]> slots_;
+};
+
+// the stats of the segment recorded with its slow calls
+nlohmann::json
+SlowCallSegmentStats(const SegmentInterface& segment);
+
+// record the search on the segment if it's slow, with the stages profiled for
+// it, and drop the profile of the result unless the search asks for it
+void
+RecordIfSlowSearch(const SegmentInterface& segment,
+                   const query::Plan& plan,
+                   SearchResult& result,
+                   std::chrono::steady_clock::time_point start);
+
+void
+RecordIfSlowRetrieve(const SegmentInterface& segment,
+                     const query::RetrievePlan& plan,
+                     int64_t result_rows,
+                     std::chrono::steady_clock::time_point start);
+
+void
+RecordIfSlowLoad(const SegmentInterface& segment,
+                 const LoadFieldDataInfo& load_info,
+                 std::chrono::steady_clock::time_point start);
+
+}  // namespace milvus::segcore
@@ -11,8 +11,39 @@
 
 #include "TimestampIndex.h"
 
+#include <algorithm>
+
+#include "common/Utils.h"
+#if defined(USE_DYNAMIC_SIMD)
+#include "simd/hook.h"
+#endif
+
 namespace milvus::segcore {
 
+namespace {
+
+// set the bit i of dst if src[i] > val, the bits beyond size are cleared
+void
+GreaterThanTimestamp(const Timestamp* src,
+                     int64_t size,
+                     Timestamp val,
+                     BitsetBlockType* dst) {
+#if defined(USE_DYNAMIC_SIMD)
+    milvus::simd::greater_than_timestamp(src, size, val, dst);
+#else
+    for (int64_t i = 0; i < size; i += BITSET_BLOCK_BIT_SIZE) {
+        auto n = std::min<int64_t>(BITSET_BLOCK_BIT_SIZE, size - i);
+        BitsetBlockType block = 0;
+        for (int64_t j = 0; j < n; ++j) {
+            block |= BitsetBlockType(src[i + j] > val) << j;
+        }
+        dst[i / BITSET_BLOCK_BIT_SIZE] = block;
+    }
+#endif
+}
+
+}  // namespace
+
 void
 TimestampIndex::set_length_meta(std::vector<int64_t> lengths) {
     lengths_ = std::move(lengths);
@@ -43,11 +74,25 @@ TimestampIndex::build_with(const Timestamp* timestamps, int64_t size) {
     Assert(offset == size);
     auto min_ts = timestamp_barriers[0];
 
+    auto num_zones = upper_div(size, ZONE_SIZE);
+    std::vector<Timestamp> zone_min_timestamps(num_zones);
+    std::vector<Timestamp> zone_max_timestamps(num_zones);
+    for (int64_t zone = 0; zone < num_zones; ++zone) {
+        auto zone_beg = timestamps + zone * ZONE_SIZE;
+        auto zone_end =
+            timestamps + std::min<int64_t>(size, (zone + 1) * ZONE_SIZE);
+        auto [min_v, max_v] = std::minmax_element(zone_beg, zone_end);
+        zone_min_timestamps[zone] = *min_v;
+        zone_max_timestamps[zone] = *max_v;
+    }
+
     this->size_ = size;
     this->start_locs_ = std::move(prefix_sums);
     this->min_timestamp_ = min_ts;
     this->max_timestamp_ = last_max_v;
     this->timestamp_barriers_ = std::move(timestamp_barriers);
+    this->zone_min_timestamps_ = std::move(zone_min_timestamps);
+    this->zone_max_timestamps_ = std::move(zone_max_timestamps);
 }
 
 std::pair<int64_t, int64_t>
@@ -71,16 +116,47 @@ BitsetType
 TimestampIndex::GenerateBitset(Timestamp query_timestamp,
                                std::pair<int64_t, int64_t> active_range,
                                const Timestamp* timestamps,
-                               int64_t size) {
+                               int64_t size) const {
     auto [beg, end] = active_range;
     Assert(beg < end);
-    BitsetType bitset;
-    bitset.reserve(size);
-    bitset.resize(beg, false);
-    bitset.resize(size, true);
-    for (int64_t i = beg; i < end; ++i) {
-        bitset[i] = timestamps[i] > query_timestamp;
+    // fill the blocks directly, instead of assigning the bits one by one
+    std::vector<BitsetBlockType> blocks(upper_div(size, BITSET_BLOCK_BIT_SIZE));
+    auto block_beg = beg / BITSET_BLOCK_BIT_SIZE;
+    auto aligned_beg = block_beg * BITSET_BLOCK_BIT_SIZE;
+    // the zones begin at the blocks, so only the zones with the timestamps
+    // on both sides of the query timestamp are compared row by row
+    for (int64_t zone_beg = aligned_beg; zone_beg < end;) {
+        auto zone = zone_beg / ZONE_SIZE;
+        auto zone_end = std::min<int64_t>(end, (zone + 1) * ZONE_SIZE);
+        auto block = blocks.data() + zone_beg / BITSET_BLOCK_BIT_SIZE;
+        if (zone_max_timestamps_[zone] <= query_timestamp) {
+            // all visible, the blocks are cleared already
+        } else if (zone_min_timestamps_[zone] > query_timestamp) {
+            std::fill(block,
+                      block + upper_div(zone_end - zone_beg,
+                                        BITSET_BLOCK_BIT_SIZE),
+                      ~BitsetBlockType(0));
+        } else {
+            GreaterThanTimestamp(timestamps + zone_beg,
+                                 zone_end - zone_beg,
+                                 query_timestamp,
+                                 block);
+        }
+        zone_beg = zone_end;
+    }
+    // [0, beg) is visible
+    blocks[block_beg] &= ~((BitsetBlockType(1) << (beg - aligned_beg)) - 1);
+    // [end, size) is filtered out
+    if (end < size) {
+        auto block_end = end / BITSET_BLOCK_BIT_SIZE;
+        blocks[block_end] |=
+            ~((BitsetBlockType(1) << (end % BITSET_BLOCK_BIT_SIZE)) - 1);
+        std::fill(blocks.begin() + block_end + 1,
+                  blocks.end(),
+                  ~BitsetBlockType(0));
     }
+    BitsetType bitset(blocks.begin(), blocks.end());
+    bitset.resize(size);
     return bitset;
 }
 
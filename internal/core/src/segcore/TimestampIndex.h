@@ -34,11 +34,17 @@ class TimestampIndex {
     std::pair<int64_t, int64_t>
     get_active_range(Timestamp query_timestamp) const;
 
-    static BitsetType
+    // the zones in the active range with all the timestamps visible, or
+    // all of them not, are filled without comparing the timestamps
+    BitsetType
     GenerateBitset(Timestamp query_timestamp,
                    std::pair<int64_t, int64_t> active_range,
                    const Timestamp* timestamps,
-                   int64_t size);
+                   int64_t size) const;
+
+ public:
+    // the rows in a zone of the zone map
+    static constexpr int64_t ZONE_SIZE = 16 * BITSET_BLOCK_BIT_SIZE;
 
  private:
     // numSlice
@@ -50,6 +56,9 @@ class TimestampIndex {
     Timestamp max_timestamp_;
     // numSlice + 1
     std::vector<Timestamp> timestamp_barriers_;
+    // the min and max timestamps of every ZONE_SIZE rows
+    std::vector<Timestamp> zone_min_timestamps_;
+    std::vector<Timestamp> zone_max_timestamps_;
 };
 
 std::vector<int64_t>
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "common/Tracer.h"
 #include "common/Types.h"
 #include "common/type_c.h"
 #include "index/Index.h"
@@ -46,6 +47,9 @@ struct LoadIndexInfo {
     std::string uri;
     int64_t index_store_version;
     IndexVersion index_engine_version;
+    // the trace of the caller, the spans of the load are the children of it
+    opentelemetry::trace::SpanContext trace_ctx =
+        opentelemetry::trace::SpanContext::GetInvalid();
 };
 
 }  // namespace milvus::segcore
@@ -11,15 +11,21 @@
 
 #include "segcore/Utils.h"
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 
+#include "arrow/api.h"
 #include "common/Common.h"
 #include "common/FieldData.h"
+#include "common/Tracer.h"
 #include "index/ScalarIndex.h"
 #include "log/Log.h"
 #include "mmap/Utils.h"
 #include "storage/ThreadPool.h"
+#include "storage/ThreadPools.h"
+#include "storage/LoadMetrics.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "storage/Util.h"
 
@@ -79,6 +85,36 @@ ParsePksFromFieldData(DataType data_type,
     }
 }
 
+void
+ParsePksFromArrowArray(DataType data_type,
+                       std::vector<PkType>& pks,
+                       const arrow::Array& array) {
+    switch (data_type) {
+        case DataType::INT64: {
+            AssertInfo(array.type_id() == arrow::Type::INT64,
+                       "inconsistent arrow type {} of pk",
+                       array.type()->ToString());
+            auto& int64_array = static_cast<const arrow::Int64Array&>(array);
+            std::copy_n(int64_array.raw_values(), pks.size(), pks.data());
+            break;
+        }
+        case DataType::VARCHAR: {
+            AssertInfo(array.type_id() == arrow::Type::STRING,
+                       "inconsistent arrow type {} of pk",
+                       array.type()->ToString());
+            auto& string_array = static_cast<const arrow::StringArray&>(array);
+            for (size_t i = 0; i < pks.size(); ++i) {
+                pks[i] = string_array.GetString(i);
+            }
+            break;
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported PK {}", data_type));
+        }
+    }
+}
+
 void
 ParsePksFromIDs(std::vector<PkType>& pks,
                 DataType data_type,
@@ -485,108 +521,134 @@ CreateDataArrayFrom(const void* data_raw,
 }
 
 // TODO remove merge dataArray, instead fill target entity when get data slice
-std::unique_ptr<DataArray>
+void
 MergeDataArray(
     std::vector<std::pair<milvus::SearchResult*, int64_t>>& result_offsets,
-    const FieldMeta& field_meta) {
+    const FieldMeta& field_meta,
+    DataArray* data_array) {
     auto data_type = field_meta.get_data_type();
-    auto data_array = std::make_unique<DataArray>();
     data_array->set_field_id(field_meta.get_id().get());
     data_array->set_type(static_cast<milvus::proto::schema::DataType>(
         field_meta.get_data_type()));
+    if (result_offsets.empty()) {
+        return;
+    }
 
-    for (auto& result_pair : result_offsets) {
-        auto src_field_data =
-            result_pair.first->output_fields_data_[field_meta.get_id()].get();
-        auto src_offset = result_pair.second;
-        AssertInfo(data_type == DataType(src_field_data->type()),
-                   "merge field data type not consistent");
-        if (field_meta.is_vector()) {
-            auto vector_array = data_array->mutable_vectors();
-            auto dim = field_meta.get_dim();
-            vector_array->set_dim(dim);
-            if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-                auto data = VEC_FIELD_DATA(src_field_data, float).data();
-                auto obj = vector_array->mutable_float_vector();
-                obj->mutable_data()->Add(data + src_offset * dim,
-                                         data + (src_offset + 1) * dim);
-            } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
-                AssertInfo(
-                    dim % 8 == 0,
-                    "Binary vector field dimension is not a multiple of 8");
-                auto num_bytes = dim / 8;
-                auto data = VEC_FIELD_DATA(src_field_data, binary);
-                auto obj = vector_array->mutable_binary_vector();
-                obj->assign(data + src_offset * num_bytes, num_bytes);
-            } else {
-                PanicInfo(DataTypeInvalid,
-                          fmt::format("unsupported datatype {}", data_type));
-            }
-            continue;
+    // the repeated fields are reserved for all the results at once
+    auto count = static_cast<int>(result_offsets.size());
+    auto for_each_result = [&](auto&& fill) {
+        for (auto& [search_result, src_offset] : result_offsets) {
+            auto src_field_data =
+                search_result->output_fields_data_[field_meta.get_id()].get();
+            AssertInfo(data_type == DataType(src_field_data->type()),
+                       "merge field data type not consistent");
+            fill(src_field_data, src_offset);
         }
-
-        auto scalar_array = data_array->mutable_scalars();
-        switch (data_type) {
-            case DataType::BOOL: {
-                auto data = FIELD_DATA(src_field_data, bool).data();
-                auto obj = scalar_array->mutable_bool_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::INT8:
-            case DataType::INT16:
-            case DataType::INT32: {
-                auto data = FIELD_DATA(src_field_data, int).data();
-                auto obj = scalar_array->mutable_int_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::INT64: {
-                auto data = FIELD_DATA(src_field_data, long).data();
-                auto obj = scalar_array->mutable_long_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::FLOAT: {
-                auto data = FIELD_DATA(src_field_data, float).data();
-                auto obj = scalar_array->mutable_float_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::DOUBLE: {
-                auto data = FIELD_DATA(src_field_data, double).data();
-                auto obj = scalar_array->mutable_double_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::VARCHAR: {
-                auto& data = FIELD_DATA(src_field_data, string);
-                auto obj = scalar_array->mutable_string_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::JSON: {
-                auto& data = FIELD_DATA(src_field_data, json);
-                auto obj = scalar_array->mutable_json_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            case DataType::ARRAY: {
-                auto& data = FIELD_DATA(src_field_data, array);
-                auto obj = scalar_array->mutable_array_data();
-                obj->set_element_type(
-                    proto::schema::DataType(field_meta.get_element_type()));
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                break;
-            }
-            default: {
-                PanicInfo(DataTypeInvalid,
-                          fmt::format("unsupported datatype {}", data_type));
-            }
+    };
+    if (field_meta.is_vector()) {
+        auto vector_array = data_array->mutable_vectors();
+        auto dim = field_meta.get_dim();
+        vector_array->set_dim(dim);
+        if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+            auto obj = vector_array->mutable_float_vector()->mutable_data();
+            obj->Reserve(count * dim);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                auto data = VEC_FIELD_DATA(src, float).data();
+                obj->Add(data + offset * dim, data + (offset + 1) * dim);
+            });
+        } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
+            AssertInfo(dim % 8 == 0,
+                       "Binary vector field dimension is not a multiple of 8");
+            auto num_bytes = dim / 8;
+            auto obj = vector_array->mutable_binary_vector();
+            obj->reserve(count * num_bytes);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                auto data = VEC_FIELD_DATA(src, binary);
+                obj->append(data + offset * num_bytes, num_bytes);
+            });
+        } else {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported datatype {}", data_type));
         }
+        return;
     }
 
-    return data_array;
+    auto scalar_array = data_array->mutable_scalars();
+    switch (data_type) {
+        case DataType::BOOL: {
+            auto obj = scalar_array->mutable_bool_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                obj->Add(FIELD_DATA(src, bool)[offset]);
+            });
+            break;
+        }
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32: {
+            auto obj = scalar_array->mutable_int_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                obj->Add(FIELD_DATA(src, int)[offset]);
+            });
+            break;
+        }
+        case DataType::INT64: {
+            auto obj = scalar_array->mutable_long_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                obj->Add(FIELD_DATA(src, long)[offset]);
+            });
+            break;
+        }
+        case DataType::FLOAT: {
+            auto obj = scalar_array->mutable_float_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                obj->Add(FIELD_DATA(src, float)[offset]);
+            });
+            break;
+        }
+        case DataType::DOUBLE: {
+            auto obj = scalar_array->mutable_double_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                obj->Add(FIELD_DATA(src, double)[offset]);
+            });
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto obj = scalar_array->mutable_string_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                *obj->Add() = FIELD_DATA(src, string)[offset];
+            });
+            break;
+        }
+        case DataType::JSON: {
+            auto obj = scalar_array->mutable_json_data()->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                *obj->Add() = FIELD_DATA(src, json)[offset];
+            });
+            break;
+        }
+        case DataType::ARRAY: {
+            auto array_data = scalar_array->mutable_array_data();
+            array_data->set_element_type(
+                proto::schema::DataType(field_meta.get_element_type()));
+            auto obj = array_data->mutable_data();
+            obj->Reserve(count);
+            for_each_result([&](const DataArray* src, int64_t offset) {
+                *obj->Add() = FIELD_DATA(src, array)[offset];
+            });
+            break;
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported datatype {}", data_type));
+        }
+    }
 }
 
 // TODO: split scalar IndexBase with knowhere::Index
@@ -703,41 +765,51 @@ void
 LoadFieldDatasFromRemote2(std::shared_ptr<milvus_storage::Space> space,
                           SchemaPtr schema,
                           FieldDataInfo& field_data_info) {
-    // log all schema ids
-    for (auto& field : schema->get_fields()) {
-    }
-    auto res = space->ScanData();
-    if (!res.ok()) {
-        PanicInfo(S3Error, "failed to create scan iterator");
-    }
-    auto reader = res.value();
-    for (auto rec = reader->Next(); rec != nullptr; rec = reader->Next()) {
+    auto& field_meta = (*schema)[FieldId(field_data_info.field_id)];
+    auto field_name = field_meta.get_name().get();
+    // only the column of the field is read from the fragments
+    auto reader = storage::ReadSpaceColumns(*space, {field_name});
+    for (auto rec : *reader) {
         if (!rec.ok()) {
-            PanicInfo(DataFormatBroken, "failed to read data");
+            PanicInfo(DataFormatBroken,
+                      fmt::format("failed to read data: {}",
+                                  rec.status().ToString()));
         }
         auto data = rec.ValueUnsafe();
-        auto total_num_rows = data->num_rows();
-        for (auto& field : schema->get_fields()) {
-            if (field.second.get_id().get() != field_data_info.field_id) {
-                continue;
-            }
-            auto col_data =
-                data->GetColumnByName(field.second.get_name().get());
-            auto field_data = storage::CreateFieldData(
-                field.second.get_data_type(),
-                field.second.is_vector() ? field.second.get_dim() : 0,
-                total_num_rows);
-            field_data->FillFieldData(col_data);
-            field_data_info.channel->push(field_data);
+        if (data == nullptr) {
+            break;
         }
+        auto total_num_rows = data->num_rows();
+        auto col_data = data->GetColumnByName(field_name);
+        AssertInfo(col_data != nullptr,
+                   "column {} not found in space",
+                   field_name);
+        auto field_data = storage::CreateFieldData(
+            field_meta.get_data_type(),
+            field_meta.is_vector() ? field_meta.get_dim() : 0,
+            total_num_rows);
+        field_data->FillFieldData(col_data);
+        field_data_info.channel->push(field_data);
     }
     field_data_info.channel->close();
 }
 // init segcore storage config first, and create default remote chunk manager
 // segcore use default remote chunk manager to load data from minio/s3
 void
-LoadFieldDatasFromRemote(std::vector<std::string>& remote_files,
-                         FieldDataChannelPtr channel) {
+LoadFieldDatasFromRemote(
+    std::vector<std::string>& remote_files,
+    FieldDataChannelPtr channel,
+    int64_t field_id,
+    std::optional<storage::PayloadStatistics>* statistics) {
+    // run on a pool, under the span of the load of the field
+    tracer::AutoSpan span("LoadFieldDatasFromRemote");
+    span.SetAttribute(
+        "thread_pool_wait_us",
+        static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                ThreadPool::CurrentTaskWaitTime())
+                .count()));
+    span.SetAttribute("files", static_cast<int64_t>(remote_files.size()));
     try {
         auto parallel_degree = static_cast<uint64_t>(
             DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
@@ -751,28 +823,79 @@ LoadFieldDatasFromRemote(std::vector<std::string>& remote_files,
                              std::stol(b.substr(b.find_last_of('/') + 1));
                   });
 
-        std::vector<std::string> batch_files;
-
-        auto FetchRawData = [&]() {
-            auto result = storage::GetObjectData(rcm.get(), batch_files);
-            for (auto& data : result) {
-                channel->push(data);
+        // keep at most parallel_degree files downloading and push them in
+        // order as soon as the oldest one is decoded, so that the consumer
+        // fills the column while the following files are downloaded, the
+        // bounded channel blocks the downloads if the consumer falls behind
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        // the stats of a file are filled by its download, read once its
+        // future is ready
+        std::deque<std::pair<std::future<std::unique_ptr<storage::DataCodec>>,
+                             std::unique_ptr<storage::RemoteFileStats>>>
+            futures;
+        int64_t bytes = 0;
+        storage::RemoteFileStats total_stats;
+        std::chrono::microseconds push_wait_time{0};
+        // none once a binlog has no statistics
+        std::optional<storage::PayloadStatistics> merged_statistics =
+            storage::PayloadStatistics{};
+        auto PushOldest = [&]() {
+            auto codec = futures.front().first.get();
+            auto stats = std::move(futures.front().second);
+            futures.pop_front();
+            storage::ObserveRemoteFile(field_id, *stats);
+            total_stats.bytes += stats->bytes;
+            total_stats.download_time += stats->download_time;
+            total_stats.decode_time += stats->decode_time;
+            if (!codec->GetStatistics().has_value()) {
+                merged_statistics = std::nullopt;
+            } else if (merged_statistics.has_value()) {
+                merged_statistics->Merge(*codec->GetStatistics());
             }
+
+            auto field_data = codec->GetFieldData();
+            bytes += field_data->Size();
+            auto start = std::chrono::steady_clock::now();
+            channel->push(std::move(field_data));
+            auto wait_time =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start);
+            storage::ObserveLoadStage(
+                storage::LoadStage::PushWait, field_id, wait_time.count());
+            push_wait_time += wait_time;
         };
 
         for (auto& file : remote_files) {
-            if (batch_files.size() >= parallel_degree) {
-                FetchRawData();
-                batch_files.clear();
+            if (futures.size() >= parallel_degree) {
+                PushOldest();
             }
-
-            batch_files.emplace_back(file);
+            auto stats = std::make_unique<storage::RemoteFileStats>();
+            auto future =
+                pool.Submit(storage::DownloadAndDecodeRemoteFileWithStats,
+                            rcm.get(),
+                            file,
+                            stats.get());
+            futures.emplace_back(std::move(future), std::move(stats));
         }
 
-        if (batch_files.size() > 0) {
-            FetchRawData();
+        while (!futures.empty()) {
+            PushOldest();
         }
+        span.SetAttribute("bytes", bytes);
+        span.SetAttribute("download_bytes", total_stats.bytes);
+        span.SetAttribute(
+            "download_us",
+            static_cast<int64_t>(total_stats.download_time.count()));
+        span.SetAttribute(
+            "decode_us", static_cast<int64_t>(total_stats.decode_time.count()));
+        span.SetAttribute("push_wait_us",
+                          static_cast<int64_t>(push_wait_time.count()));
+        storage::ReleaseArrowUnused();
 
+        if (statistics != nullptr) {
+            *statistics = std::move(merged_statistics);
+        }
         channel->close();
     } catch (std::exception e) {
         LOG_SEGCORE_INFO_ << "failed to load data from remote: " << e.what();
@@ -780,6 +903,255 @@ LoadFieldDatasFromRemote(std::vector<std::string>& remote_files,
     }
 }
 
+size_t
+WriteFieldDatasFromRemote(const std::vector<std::string>& remote_files,
+                          const std::vector<int64_t>& entries_nums,
+                          size_t row_size,
+                          File& file) {
+    AssertInfo(remote_files.size() == entries_nums.size(),
+               "inconsistent size of binlogs with entries nums");
+    auto parallel_degree =
+        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    auto rcm = storage::RemoteChunkManagerSingleton::GetInstance()
+                   .GetRemoteChunkManager();
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+
+    auto WriteRemoteFile = [&](const std::string& remote_file,
+                               int64_t num_rows,
+                               int64_t row_offset) -> size_t {
+        auto size = rcm->Size(remote_file);
+        auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[size]);
+        rcm->Read(remote_file, buf.get(), size);
+        // the values of the raw layout are written as they are downloaded
+        if (auto raw = storage::FindRawInsertPayload(buf, size)) {
+            AssertInfo(raw->num_rows == num_rows &&
+                           raw->data_size == num_rows * row_size,
+                       "binlog {} has {} rows of {} bytes, expected {} rows",
+                       remote_file,
+                       raw->num_rows,
+                       raw->data_size,
+                       num_rows);
+            return file.WriteAt(
+                raw->data, raw->data_size, row_offset * row_size);
+        }
+
+        auto field_data =
+            storage::DeserializeFileData(buf, size)->GetFieldData();
+        AssertInfo(field_data->get_num_rows() == num_rows,
+                   "binlog {} has {} rows, expected {}",
+                   remote_file,
+                   field_data->get_num_rows(),
+                   num_rows);
+        AssertInfo(field_data->Size() == num_rows * row_size,
+                   "binlog {} has {} bytes, expected {}",
+                   remote_file,
+                   field_data->Size(),
+                   num_rows * row_size);
+        return file.WriteAt(
+            field_data->Data(), field_data->Size(), row_offset * row_size);
+    };
+
+    // bound the decoded binlogs held in memory by parallel_degree
+    std::deque<std::future<size_t>> futures;
+    size_t total_written = 0;
+    int64_t row_offset = 0;
+    try {
+        for (size_t i = 0; i < remote_files.size(); i++) {
+            if (futures.size() >= parallel_degree) {
+                total_written += futures.front().get();
+                futures.pop_front();
+            }
+            futures.emplace_back(pool.Submit(
+                WriteRemoteFile, remote_files[i], entries_nums[i], row_offset));
+            row_offset += entries_nums[i];
+        }
+        while (!futures.empty()) {
+            total_written += futures.front().get();
+            futures.pop_front();
+        }
+    } catch (...) {
+        // the tasks reference the locals, wait for them before unwinding
+        for (auto& future : futures) {
+            if (future.valid()) {
+                future.wait();
+            }
+        }
+        throw;
+    }
+    storage::ReleaseArrowUnused();
+    return total_written;
+}
+
+template <typename BT>
+std::shared_ptr<arrow::Array>
+FinishArrowArray(BT& builder) {
+    std::shared_ptr<arrow::Array> array;
+    auto ast = builder.Finish(&array);
+    AssertInfo(ast.ok(), "finish arrow builder failed: {}", ast.ToString());
+    return array;
+}
+
+template <typename BT, typename T>
+std::shared_ptr<arrow::Array>
+BuildArrowArray(BT& builder, const google::protobuf::RepeatedField<T>& src) {
+    using ValueType = typename BT::value_type;
+    if constexpr (std::is_same_v<ValueType, T> && !std::is_same_v<T, bool>) {
+        auto ast = builder.AppendValues(src.data(), src.size());
+        AssertInfo(ast.ok(),
+                   "append values to arrow builder failed: {}",
+                   ast.ToString());
+    } else {
+        // the int8 and int16 values are held as int32 by the proto
+        auto ast = builder.Reserve(src.size());
+        AssertInfo(
+            ast.ok(), "reserve arrow builder failed: {}", ast.ToString());
+        for (auto value : src) {
+            builder.UnsafeAppend(static_cast<ValueType>(value));
+        }
+    }
+    return FinishArrowArray(builder);
+}
+
+template <typename BT>
+std::shared_ptr<arrow::Array>
+BuildArrowArray(BT& builder,
+                const google::protobuf::RepeatedPtrField<std::string>& src) {
+    auto ast = builder.Reserve(src.size());
+    AssertInfo(ast.ok(), "reserve arrow builder failed: {}", ast.ToString());
+    for (auto& value : src) {
+        ast = builder.Append(value);
+        AssertInfo(ast.ok(),
+                   "append value to arrow builder failed: {}",
+                   ast.ToString());
+    }
+    return FinishArrowArray(builder);
+}
+
+std::shared_ptr<arrow::Array>
+BuildArrowVectorArray(const char* data, int64_t data_size, int32_t row_size) {
+    AssertInfo(row_size > 0 && data_size % row_size == 0,
+               "invalid vector data size {}, row size {}",
+               data_size,
+               row_size);
+    arrow::FixedSizeBinaryBuilder builder(arrow::fixed_size_binary(row_size));
+    auto ast = builder.AppendValues(reinterpret_cast<const uint8_t*>(data),
+                                    data_size / row_size);
+    AssertInfo(ast.ok(),
+               "append values to arrow builder failed: {}",
+               ast.ToString());
+    return FinishArrowArray(builder);
+}
+
+std::shared_ptr<arrow::Array>
+CreateArrowArrayFrom(const DataArray& data) {
+    auto data_type = static_cast<DataType>(data.type());
+    auto& scalars = data.scalars();
+    auto& vectors = data.vectors();
+    switch (data_type) {
+        case DataType::BOOL: {
+            arrow::BooleanBuilder builder;
+            return BuildArrowArray(builder, scalars.bool_data().data());
+        }
+        case DataType::INT8: {
+            arrow::Int8Builder builder;
+            return BuildArrowArray(builder, scalars.int_data().data());
+        }
+        case DataType::INT16: {
+            arrow::Int16Builder builder;
+            return BuildArrowArray(builder, scalars.int_data().data());
+        }
+        case DataType::INT32: {
+            arrow::Int32Builder builder;
+            return BuildArrowArray(builder, scalars.int_data().data());
+        }
+        case DataType::INT64: {
+            arrow::Int64Builder builder;
+            return BuildArrowArray(builder, scalars.long_data().data());
+        }
+        case DataType::FLOAT: {
+            arrow::FloatBuilder builder;
+            return BuildArrowArray(builder, scalars.float_data().data());
+        }
+        case DataType::DOUBLE: {
+            arrow::DoubleBuilder builder;
+            return BuildArrowArray(builder, scalars.double_data().data());
+        }
+        case DataType::VARCHAR:
+        case DataType::STRING: {
+            arrow::StringBuilder builder;
+            return BuildArrowArray(builder, scalars.string_data().data());
+        }
+        case DataType::JSON: {
+            arrow::BinaryBuilder builder;
+            return BuildArrowArray(builder, scalars.json_data().data());
+        }
+        case DataType::ARRAY: {
+            // the arrays are the serialized ScalarField of their elements
+            arrow::BinaryBuilder builder;
+            auto& src = scalars.array_data().data();
+            auto ast = builder.Reserve(src.size());
+            AssertInfo(
+                ast.ok(), "reserve arrow builder failed: {}", ast.ToString());
+            for (auto& value : src) {
+                ast = builder.Append(value.SerializeAsString());
+                AssertInfo(ast.ok(),
+                           "append value to arrow builder failed: {}",
+                           ast.ToString());
+            }
+            return FinishArrowArray(builder);
+        }
+        case DataType::VECTOR_FLOAT: {
+            auto& src = vectors.float_vector().data();
+            return BuildArrowVectorArray(
+                reinterpret_cast<const char*>(src.data()),
+                src.size() * sizeof(float),
+                vectors.dim() * sizeof(float));
+        }
+        case DataType::VECTOR_FLOAT16: {
+            auto& src = vectors.float16_vector();
+            return BuildArrowVectorArray(
+                src.data(), src.size(), vectors.dim() * sizeof(float16));
+        }
+        case DataType::VECTOR_BINARY: {
+            auto& src = vectors.binary_vector();
+            return BuildArrowVectorArray(
+                src.data(), src.size(), vectors.dim() / 8);
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported data type {}", data_type));
+        }
+    }
+}
+
+std::shared_ptr<arrow::RecordBatch>
+RetrieveResultsToRecordBatch(const proto::segcore::RetrieveResults& results) {
+    arrow::FieldVector fields;
+    arrow::ArrayVector columns;
+    for (auto& data : results.fields_data()) {
+        auto column = CreateArrowArrayFrom(data);
+        fields.push_back(
+            arrow::field(std::to_string(data.field_id()), column->type()));
+        columns.push_back(std::move(column));
+    }
+    if (results.offset_size() > 0) {
+        arrow::Int64Builder builder;
+        columns.push_back(BuildArrowArray(builder, results.offset()));
+        fields.push_back(arrow::field("offset", arrow::int64()));
+    }
+
+    int64_t num_rows = columns.empty() ? 0 : columns[0]->length();
+    for (auto& column : columns) {
+        AssertInfo(column->length() == num_rows,
+                   "unaligned columns of retrieve results, rows = {}, "
+                   "expected rows = {}",
+                   column->length(),
+                   num_rows);
+    }
+    return arrow::RecordBatch::Make(
+        arrow::schema(fields), num_rows, std::move(columns));
+}
+
 int64_t
 upper_bound(const ConcurrentVector<Timestamp>& timestamps,
             int64_t first,
@@ -15,18 +15,22 @@
 #include <exception>
 #include <memory>
 #include <stdexcept>
+#include <optional>
 #include <cstdlib>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "arrow/record_batch.h"
 #include "common/FieldData.h"
+#include "common/File.h"
 #include "common/QueryResult.h"
 // #include "common/Schema.h"
 #include "common/Types.h"
 #include "index/Index.h"
 #include "segcore/DeletedRecord.h"
 #include "segcore/InsertRecord.h"
+#include "storage/PayloadStatistics.h"
 #include "storage/space.h"
 
 namespace milvus::segcore {
@@ -39,6 +43,11 @@ ParsePksFromFieldData(DataType data_type,
                       std::vector<PkType>& pks,
                       const std::vector<FieldDataPtr>& datas);
 
+void
+ParsePksFromArrowArray(DataType data_type,
+                       std::vector<PkType>& pks,
+                       const arrow::Array& array);
+
 void
 ParsePksFromIDs(std::vector<PkType>& pks,
                 DataType data_type,
@@ -52,6 +61,19 @@ GetRawDataSizeOfDataArray(const DataArray* data,
                           const FieldMeta& field_meta,
                           int64_t num_rows);
 
+// the rows gathered by bulk_subscript are at random offsets, the row this
+// many rows ahead is prefetched so that the cache misses overlap
+constexpr int64_t GATHER_PREFETCH_DISTANCE = 16;
+constexpr int64_t GATHER_CACHE_LINE_SIZE = 64;
+
+inline void
+PrefetchRow(const void* row, int64_t size) {
+    auto begin = static_cast<const char*>(row);
+    for (int64_t i = 0; i < size; i += GATHER_CACHE_LINE_SIZE) {
+        __builtin_prefetch(begin + i);
+    }
+}
+
 // Note: this is temporary solution.
 // modify bulk script implement to make process more clear
 std::unique_ptr<DataArray>
@@ -76,10 +98,18 @@ CreateDataArrayFrom(const void* data_raw,
                     const FieldMeta& field_meta);
 
 // TODO remove merge dataArray, instead fill target entity when get data slice
-std::unique_ptr<DataArray>
+// fill data_array with the rows of the field at the result offsets
+void
 MergeDataArray(
     std::vector<std::pair<milvus::SearchResult*, int64_t>>& result_offsets,
-    const FieldMeta& field_meta);
+    const FieldMeta& field_meta,
+    DataArray* data_array);
+
+// the columns of the retrieve results as an arrow record batch, the fields
+// are named by their field ids and come in the order of the results, the
+// offsets of the rows are the trailing "offset" column if there are any
+std::shared_ptr<arrow::RecordBatch>
+RetrieveResultsToRecordBatch(const proto::segcore::RetrieveResults& results);
 
 template <bool is_sealed>
 std::shared_ptr<DeletedRecord::TmpBitmap>
@@ -99,20 +129,11 @@ get_deleted_bitmap(int64_t del_barrier,
 
     auto bitmap = current->bitmap_ptr;
 
-    int64_t start, end;
-    if (del_barrier < old_del_barrier) {
-        // in this case, ts of delete record[current_del_barrier : old_del_barrier] > query_timestamp
-        // so these deletion records do not take effect in query/search
-        // so bitmap corresponding to those pks in delete record[current_del_barrier:old_del_barrier] will be reset to 0
-        // for example, current_del_barrier = 2, query_time = 120, the bitmap will be reset to [0, 1, 1, 0, 0, 0, 0, 0]
-        start = del_barrier;
-        end = old_del_barrier;
-    } else {
-        // the cache is not enough, so update bitmap using new pks in delete record[old_del_barrier:current_del_barrier]
-        // for example, current_del_barrier = 4, query_time = 300, bitmap will be updated to [0, 1, 1, 0, 1, 1, 0, 0]
-        start = old_del_barrier;
-        end = del_barrier;
-    }
+    // the snapshot is never ahead of del_barrier, only the new deletes of
+    // delete record[old_del_barrier:del_barrier] are applied
+    // for example, old_del_barrier = 2, del_barrier = 4, query_time = 300, bitmap will be updated from [0, 1, 1, 0, 0, 0, 0, 0] to [0, 1, 1, 0, 1, 1, 0, 0]
+    auto start = old_del_barrier;
+    auto end = del_barrier;
 
     // Avoid invalid calculations when there are a lot of repeated delete pks
     std::unordered_map<PkType, Timestamp> delete_timestamps;
@@ -125,26 +146,34 @@ get_deleted_bitmap(int64_t del_barrier,
                                     : delete_timestamps[pk];
     }
 
+    std::vector<PkType> delete_pks;
+    std::vector<Timestamp> delete_pk_timestamps;
+    delete_pks.reserve(delete_timestamps.size());
+    delete_pk_timestamps.reserve(delete_timestamps.size());
     for (auto& [pk, timestamp] : delete_timestamps) {
-        auto segOffsets = insert_record.search_pk(pk, insert_barrier);
-        for (auto offset : segOffsets) {
-            int64_t insert_row_offset = offset.get();
-
-            // The deletion record do not take effect in search/query,
-            // and reset bitmap to 0
-            if (timestamp > query_timestamp) {
-                bitmap->reset(insert_row_offset);
-                continue;
-            }
-            // Insert after delete with same pk, delete will not task effect on this insert record,
-            // and reset bitmap to 0
-            if (insert_record.timestamps_[insert_row_offset] >= timestamp) {
-                bitmap->reset(insert_row_offset);
-                continue;
-            }
-            // insert data corresponding to the insert_row_offset will be ignored in search/query
-            bitmap->set(insert_row_offset);
+        delete_pks.push_back(pk);
+        delete_pk_timestamps.push_back(timestamp);
+    }
+
+    for (auto& [i, offset] :
+         insert_record.search_pks(delete_pks, insert_barrier)) {
+        auto timestamp = delete_pk_timestamps[i];
+        int64_t insert_row_offset = offset.get();
+
+        // The deletion record do not take effect in search/query,
+        // and reset bitmap to 0
+        if (timestamp > query_timestamp) {
+            bitmap->reset(insert_row_offset);
+            continue;
+        }
+        // Insert after delete with same pk, delete will not task effect on this insert record,
+        // and reset bitmap to 0
+        if (insert_record.timestamps_[insert_row_offset] >= timestamp) {
+            bitmap->reset(insert_row_offset);
+            continue;
         }
+        // insert data corresponding to the insert_row_offset will be ignored in search/query
+        bitmap->set(insert_row_offset);
     }
 
     delete_record.insert_lru_entry(current);
@@ -157,14 +186,30 @@ ReverseDataFromIndex(const index::IndexBase* index,
                      int64_t count,
                      const FieldMeta& field_meta);
 
+// push the field data of the binlogs of the field into the channel in the
+// order of the log ids, and observe the bytes and the time taken by the
+// download, the decode and the wait on the channel by the field, see
+// LoadMetrics.h. The statistics of the binlogs are merged into statistics
+// before the channel is closed if it's not null, see PayloadStatistics.h
 void
 LoadFieldDatasFromRemote(std::vector<std::string>& remote_files,
-                         FieldDataChannelPtr channel);
+                         FieldDataChannelPtr channel,
+                         int64_t field_id,
+                         std::optional<storage::PayloadStatistics>* statistics);
+
+// download the fixed width binlogs in parallel and write each one to its row
+// offset in file as soon as it's decoded, return the bytes written
+size_t
+WriteFieldDatasFromRemote(const std::vector<std::string>& remote_files,
+                          const std::vector<int64_t>& entries_nums,
+                          size_t row_size,
+                          File& file);
 
 void
 LoadFieldDatasFromRemote2(std::shared_ptr<milvus_storage::Space> space,
                           SchemaPtr schema,
                           FieldDataInfo& field_data_info);
+
 /**
  * Returns an index pointing to the first element in the range [first, last) such that `value < element` is true
  * (i.e. that is strictly greater than value), or last if no such element is found.
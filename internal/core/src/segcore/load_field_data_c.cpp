@@ -16,6 +16,7 @@
 
 #include "common/EasyAssert.h"
 #include "common/LoadInfo.h"
+#include "mmap/Utils.h"
 #include "segcore/load_field_data_c.h"
 
 CStatus
@@ -102,6 +103,15 @@ SetStorageVersion(CLoadFieldDataInfo c_load_field_data_info,
     load_field_data_info->storage_version = storage_version;
 }
 
+void
+SetLoadFieldDataTraceContext(CLoadFieldDataInfo c_load_field_data_info,
+                             CTraceContext c_trace) {
+    auto load_field_data_info = (LoadFieldDataInfo*)c_load_field_data_info;
+    auto ctx = milvus::tracer::TraceContext{
+        c_trace.traceID, c_trace.spanID, c_trace.flag};
+    load_field_data_info->trace_ctx = milvus::tracer::ToSpanContext(&ctx);
+}
+
 void
 EnableMmap(CLoadFieldDataInfo c_load_field_data_info,
            int64_t field_id,
@@ -109,3 +119,33 @@ EnableMmap(CLoadFieldDataInfo c_load_field_data_info,
     auto info = static_cast<LoadFieldDataInfo*>(c_load_field_data_info);
     info->field_infos[field_id].enable_mmap = enabled;
 }
+
+void
+EnableLazyLoad(CLoadFieldDataInfo c_load_field_data_info,
+               int64_t field_id,
+               bool enabled) {
+    auto info = static_cast<LoadFieldDataInfo*>(c_load_field_data_info);
+    info->field_infos[field_id].lazy_load = enabled;
+}
+
+CStatus
+SetMmapAdvice(CLoadFieldDataInfo c_load_field_data_info,
+              int64_t field_id,
+              const char* advice) {
+    try {
+        auto info = static_cast<LoadFieldDataInfo*>(c_load_field_data_info);
+        info->field_infos[field_id].mmap_advice =
+            milvus::MmapAdviceFromName(advice);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+EnableMlock(CLoadFieldDataInfo c_load_field_data_info,
+            int64_t field_id,
+            bool enabled) {
+    auto info = static_cast<LoadFieldDataInfo*>(c_load_field_data_info);
+    info->field_infos[field_id].mlock = enabled;
+}
@@ -58,6 +58,30 @@ EnableMmap(CLoadFieldDataInfo c_load_field_data_info,
            int64_t field_id,
            bool enabled);
 
+// load the field at its first access, see FieldBinlogInfo::lazy_load
+void
+EnableLazyLoad(CLoadFieldDataInfo c_load_field_data_info,
+               int64_t field_id,
+               bool enabled);
+
+// the read ahead policy of the field mapped, e.g. random, see
+// FieldBinlogInfo::mmap_advice
+CStatus
+SetMmapAdvice(CLoadFieldDataInfo c_load_field_data_info,
+              int64_t field_id,
+              const char* advice);
+
+// lock the field mapped in memory within the mlock budget
+void
+EnableMlock(CLoadFieldDataInfo c_load_field_data_info,
+            int64_t field_id,
+            bool enabled);
+
+// the spans of the load are the children of the trace of the caller
+void
+SetLoadFieldDataTraceContext(CLoadFieldDataInfo c_load_field_data_info,
+                             CTraceContext c_trace);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,14 +11,21 @@
 
 #include "segcore/load_index_c.h"
 
+#include <chrono>
+
 #include "common/FieldMeta.h"
 #include "common/EasyAssert.h"
+#include "common/QueryProfile.h"
+#include "common/Tracer.h"
 #include "index/Index.h"
 #include "index/IndexFactory.h"
 #include "index/Meta.h"
 #include "index/Utils.h"
 #include "log/Log.h"
 #include "storage/FileManager.h"
+#include "segcore/SegcoreConfig.h"
+#include "segcore/SlowCallRecorder.h"
+#include "segcore/LoadMemoryManager.h"
 #include "segcore/Types.h"
 #include "storage/Util.h"
 #include "storage/RemoteChunkManagerSingleton.h"
@@ -46,6 +53,7 @@ NewLoadIndexInfo(CLoadIndexInfo* c_load_index_info) {
 void
 DeleteLoadIndexInfo(CLoadIndexInfo c_load_index_info) {
     auto info = (milvus::segcore::LoadIndexInfo*)c_load_index_info;
+    milvus::segcore::LoadMemoryManager::GetInstance().ReleaseUsage(info);
     delete info;
 }
 
@@ -208,6 +216,7 @@ AppendIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set) {
 CStatus
 AppendIndexV2(CLoadIndexInfo c_load_index_info) {
     try {
+        auto start = std::chrono::steady_clock::now();
         auto load_index_info =
             (milvus::segcore::LoadIndexInfo*)c_load_index_info;
         auto& index_params = load_index_info->index_params;
@@ -224,6 +233,16 @@ AppendIndexV2(CLoadIndexInfo c_load_index_info) {
                    "index type is empty");
         index_info.index_type = index_params.at("index_type");
 
+        milvus::tracer::AutoSpan span("SegCoreAppendIndex",
+                                      load_index_info->trace_ctx);
+        span.SetAttribute("segment_id", load_index_info->segment_id);
+        span.SetAttribute("field_id", load_index_info->field_id);
+        span.SetAttribute("index_type", index_info.index_type.c_str());
+        span.SetAttribute(
+            "files",
+            static_cast<int64_t>(load_index_info->index_files.size()));
+        span.SetAttribute("mmap", load_index_info->enable_mmap);
+
         // get metric type
         if (milvus::datatype_is_vector(field_type)) {
             AssertInfo(index_params.find("metric_type") != index_params.end(),
@@ -251,33 +270,65 @@ AppendIndexV2(CLoadIndexInfo c_load_index_info) {
 
         milvus::storage::FileManagerContext fileManagerContext(
             field_meta, index_meta, remote_chunk_manager);
-        load_index_info->index =
-            milvus::index::IndexFactory::GetInstance().CreateIndex(
-                index_info, fileManagerContext);
+        // the stages recorded if the append is slow
+        milvus::QueryProfile profile;
+        {
+            milvus::ProfileTimer timer(&profile, "create_index");
+            load_index_info->index =
+                milvus::index::IndexFactory::GetInstance().CreateIndex(
+                    index_info, fileManagerContext);
+        }
 
+        auto filepath = std::filesystem::path(load_index_info->mmap_dir_path) /
+                        std::to_string(load_index_info->segment_id) /
+                        std::to_string(load_index_info->field_id) /
+                        std::to_string(load_index_info->index_id);
         if (load_index_info->enable_mmap &&
             load_index_info->index->IsMmapSupported()) {
             AssertInfo(!load_index_info->mmap_dir_path.empty(),
                        "mmap directory path is empty");
-            auto filepath =
-                std::filesystem::path(load_index_info->mmap_dir_path) /
-                std::to_string(load_index_info->segment_id) /
-                std::to_string(load_index_info->field_id) /
-                std::to_string(load_index_info->index_id);
-
             config[kMmapFilepath] = filepath.string();
+        } else if (milvus::segcore::SegcoreConfig::default_config()
+                       .get_stage_index_load() &&
+                   milvus::datatype_is_vector(field_type) &&
+                   !load_index_info->mmap_dir_path.empty() &&
+                   load_index_info->index->IsMmapSupported()) {
+            config[kLoadFilepath] = filepath.string();
         }
 
-        load_index_info->index->Load(config);
+        auto mmapped = config.contains(kMmapFilepath);
+        auto& memory_manager =
+            milvus::segcore::LoadMemoryManager::GetInstance();
+        auto reservation = [&] {
+            milvus::ProfileTimer timer(&profile, "reserve_memory");
+            return memory_manager.Reserve(
+                milvus::segcore::EstimateLoadIndexBytes(*load_index_info,
+                                                        mmapped));
+        }();
+        {
+            milvus::ProfileTimer timer(&profile, "load_index");
+            load_index_info->index->Load(config);
+        }
+        // counted until it's added to the segment or the info is deleted
+        memory_manager.SetUsage(
+            load_index_info, mmapped ? 0 : load_index_info->index->ByteSize());
+        milvus::segcore::SlowCallRecorder::GetInstance().RecordIfSlow(
+            "AppendIndex", load_index_info->segment_id, start, [&] {
+                return nlohmann::json{
+                    {"field_id", load_index_info->field_id},
+                    {"index_type", index_info.index_type},
+                    {"files", load_index_info->index_files.size()},
+                    {"mmap", mmapped},
+                    {"staged", config.contains(kLoadFilepath)},
+                    {"memory_bytes", load_index_info->index->ByteSize()},
+                    {"stages", nlohmann::json::parse(profile.ToJson())}};
+            });
         auto status = CStatus();
         status.error_code = milvus::Success;
         status.error_msg = "";
         return status;
     } catch (std::exception& e) {
-        auto status = CStatus();
-        status.error_code = milvus::UnexpectedError;
-        status.error_msg = strdup(e.what());
-        return status;
+        return milvus::FailureCStatus(&e);
     }
 }
 
@@ -449,3 +500,12 @@ AppendStorageInfo(CLoadIndexInfo c_load_index_info,
     load_index_info->uri = uri;
     load_index_info->index_store_version = version;
 }
+
+void
+AppendTraceContextToLoadInfo(CLoadIndexInfo c_load_index_info,
+                             CTraceContext c_trace) {
+    auto load_index_info = (milvus::segcore::LoadIndexInfo*)c_load_index_info;
+    auto ctx = milvus::tracer::TraceContext{
+        c_trace.traceID, c_trace.spanID, c_trace.flag};
+    load_index_info->trace_ctx = milvus::tracer::ToSpanContext(&ctx);
+}
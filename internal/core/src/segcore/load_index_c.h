@@ -73,6 +73,11 @@ void
 AppendStorageInfo(CLoadIndexInfo c_load_index_info,
                   const char* uri,
                   int64_t version);
+
+// the spans of the load are the children of the trace of the caller
+void
+AppendTraceContextToLoadInfo(CLoadIndexInfo c_load_index_info,
+                             CTraceContext c_trace);
 #ifdef __cplusplus
 }
 #endif
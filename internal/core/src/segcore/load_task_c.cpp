@@ -0,0 +1,254 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/load_task_c.h"
+
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "common/LoadInfo.h"
+#include "segcore/SegmentInterface.h"
+#include "segcore/load_index_c.h"
+#include "segcore/Types.h"
+#include "storage/LoadContext.h"
+#include "storage/ThreadPool.h"
+
+namespace {
+
+struct LoadTask {
+    std::shared_ptr<milvus::storage::LoadContext> context =
+        std::make_shared<milvus::storage::LoadContext>();
+    CStatus status = milvus::SuccessCStatus();
+};
+
+// the async loads run on their own pool rather than the ones their downloads
+// are submitted to and waited for, so that they never wait for the loads
+// queued behind them, the memory of their downloads is bounded by the budget
+milvus::ThreadPool&
+LoadTaskPool() {
+    static auto pool = new milvus::ThreadPool(
+        milvus::MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT, "async_load_pool");
+    return *pool;
+}
+
+template <typename Call>
+CStatus
+StartLoadTask(CAsyncTaskCallback callback,
+              void* callback_arg,
+              CLoadTask* c_task,
+              Call call) {
+    try {
+        auto task = std::make_unique<LoadTask>();
+        LoadTaskPool().Submit([task = task.get(),
+                               call = std::move(call),
+                               callback,
+                               callback_arg] {
+            if (task->context->IsCanceled()) {
+                task->status = milvus::FailureCStatus(
+                    milvus::Canceled, "canceled before started");
+            } else {
+                milvus::storage::ScopedLoadContext scoped(task->context);
+                task->status = call();
+                // the calls report the failures of the loads as
+                // UnexpectedError or by the codes of their errors
+                if (task->status.error_code != milvus::Success &&
+                    task->context->IsCanceled()) {
+                    task->status.error_code = milvus::Canceled;
+                }
+            }
+            // the task may be deleted once the callback is called
+            callback(callback_arg);
+        });
+        *c_task = task.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+// run the loads on the pool, the first failure of them once all are done
+CStatus
+RunLoads(const std::vector<std::function<CStatus()>>& loads) {
+    std::vector<std::future<CStatus>> futures;
+    CStatus status = milvus::SuccessCStatus();
+    try {
+        for (auto& load : loads) {
+            futures.push_back(LoadTaskPool().Submit(load));
+        }
+    } catch (std::exception& e) {
+        status = milvus::FailureCStatus(&e);
+    }
+    for (auto& future : futures) {
+        auto load_status = future.get();
+        if (load_status.error_code == milvus::Success) {
+            continue;
+        }
+        if (status.error_code == milvus::Success) {
+            status = load_status;
+        } else {
+            std::free(const_cast<char*>(load_status.error_msg));
+        }
+    }
+    return status;
+}
+
+CStatus
+AppendAndReleaseIndex(CLoadIndexInfo c_load_index_info) {
+    auto status = AppendIndexV2(c_load_index_info);
+    if (status.error_code != milvus::Success) {
+        // free the index partially loaded
+        static_cast<milvus::segcore::LoadIndexInfo*>(c_load_index_info)
+            ->index.reset();
+    }
+    return status;
+}
+
+}  // namespace
+
+CStatus
+LoadSegment(CSegmentInterface c_segment,
+            CLoadFieldDataInfo* c_load_field_data_infos,
+            int64_t num_field_data_infos,
+            CLoadIndexInfo* c_load_index_infos,
+            int64_t num_index_infos) {
+    std::optional<milvus::FieldId> pk_field_id;
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        pk_field_id = segment->get_schema().get_primary_field_id();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+    auto is_pk = [&](int64_t field_id) {
+        return pk_field_id.has_value() && pk_field_id->get() == field_id;
+    };
+
+    // the indexes are all downloaded first, the pk index added to the
+    // segment once downloaded, together with the pk field
+    std::vector<std::function<CStatus()>> loads;
+    std::vector<CLoadIndexInfo> indexes;
+    for (int64_t i = 0; i < num_index_infos; ++i) {
+        auto c_load_index_info = c_load_index_infos[i];
+        auto field_id = static_cast<milvus::segcore::LoadIndexInfo*>(
+                            c_load_index_info)
+                            ->field_id;
+        if (!is_pk(field_id)) {
+            indexes.push_back(c_load_index_info);
+            loads.emplace_back([=] {
+                return AppendAndReleaseIndex(c_load_index_info);
+            });
+            continue;
+        }
+        loads.emplace_back([=] {
+            auto status = AppendAndReleaseIndex(c_load_index_info);
+            if (status.error_code != milvus::Success) {
+                return status;
+            }
+            return UpdateSealedSegmentIndex(c_segment, c_load_index_info);
+        });
+    }
+    std::vector<CLoadFieldDataInfo> fields;
+    for (int64_t i = 0; i < num_field_data_infos; ++i) {
+        auto c_load_field_data_info = c_load_field_data_infos[i];
+        auto& field_infos = static_cast<LoadFieldDataInfo*>(
+                                c_load_field_data_info)
+                                ->field_infos;
+        if (pk_field_id.has_value() &&
+            field_infos.count(pk_field_id->get()) > 0) {
+            loads.emplace_back([=] {
+                return LoadFieldData(c_segment, c_load_field_data_info);
+            });
+        } else {
+            fields.push_back(c_load_field_data_info);
+        }
+    }
+    auto status = RunLoads(loads);
+    if (status.error_code != milvus::Success) {
+        return status;
+    }
+
+    // the indexes are added to the segment one by one while the other
+    // fields are loaded
+    loads.clear();
+    loads.emplace_back([&indexes, c_segment] {
+        for (auto c_load_index_info : indexes) {
+            auto status =
+                UpdateSealedSegmentIndex(c_segment, c_load_index_info);
+            if (status.error_code != milvus::Success) {
+                return status;
+            }
+        }
+        return milvus::SuccessCStatus();
+    });
+    for (auto c_load_field_data_info : fields) {
+        loads.emplace_back([=] {
+            return LoadFieldData(c_segment, c_load_field_data_info);
+        });
+    }
+    return RunLoads(loads);
+}
+
+CStatus
+AsyncLoadFieldData(CSegmentInterface c_segment,
+                   CLoadFieldDataInfo c_load_field_data_info,
+                   CAsyncTaskCallback callback,
+                   void* callback_arg,
+                   CLoadTask* task) {
+    return StartLoadTask(callback, callback_arg, task, [=] {
+        return LoadFieldData(c_segment, c_load_field_data_info);
+    });
+}
+
+CStatus
+AsyncAppendIndexV2(CLoadIndexInfo c_load_index_info,
+                   CAsyncTaskCallback callback,
+                   void* callback_arg,
+                   CLoadTask* task) {
+    return StartLoadTask(callback, callback_arg, task, [=] {
+        return AppendAndReleaseIndex(c_load_index_info);
+    });
+}
+
+void
+GetLoadTaskProgress(CLoadTask c_task,
+                    int64_t* downloaded_bytes,
+                    int64_t* decoded_bytes) {
+    auto& context = static_cast<LoadTask*>(c_task)->context;
+    *downloaded_bytes = context->DownloadedBytes();
+    *decoded_bytes = context->DecodedBytes();
+}
+
+void
+CancelLoadTask(CLoadTask c_task) {
+    static_cast<LoadTask*>(c_task)->context->Cancel();
+}
+
+CStatus
+GetLoadTaskStatus(CLoadTask c_task) {
+    auto task = static_cast<LoadTask*>(c_task);
+    return std::exchange(task->status, milvus::SuccessCStatus());
+}
+
+void
+DeleteLoadTask(CLoadTask c_task) {
+    auto task = static_cast<LoadTask*>(c_task);
+    if (task->status.error_code != milvus::Success) {
+        std::free(const_cast<char*>(task->status.error_msg));
+    }
+    delete task;
+}
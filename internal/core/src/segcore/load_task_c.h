@@ -0,0 +1,78 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common/type_c.h"
+#include "segcore/segment_c.h"
+
+typedef void* CLoadTask;
+
+// The async variants of LoadFieldData and AppendIndexV2, which return a task
+// once the load is scheduled, and call the callback with the arg once it's
+// done. The loads run on a pool shared by all of them, and their downloads
+// within the budget set by SegcoreSetLoadBudget. The infos must be kept
+// until the callback is called.
+CStatus
+AsyncLoadFieldData(CSegmentInterface c_segment,
+                   CLoadFieldDataInfo c_load_field_data_info,
+                   CAsyncTaskCallback callback,
+                   void* callback_arg,
+                   CLoadTask* task);
+
+CStatus
+AsyncAppendIndexV2(CLoadIndexInfo c_load_index_info,
+                   CAsyncTaskCallback callback,
+                   void* callback_arg,
+                   CLoadTask* task);
+
+// Load the fields and the indexes of a sealed segment in one call, instead
+// of one LoadFieldData or AppendIndexV2 at a time. The loads run
+// concurrently on the pool of the async loads within the memory budget, the
+// pk field and the index of it first, as the pk index is built from them,
+// then the others. Returns once all of them are in the segment, or the first
+// failure once the others are done.
+CStatus
+LoadSegment(CSegmentInterface c_segment,
+            CLoadFieldDataInfo* c_load_field_data_infos,
+            int64_t num_field_data_infos,
+            CLoadIndexInfo* c_load_index_infos,
+            int64_t num_index_infos);
+
+// the bytes of the remote files downloaded and decoded so far
+void
+GetLoadTaskProgress(CLoadTask c_task,
+                    int64_t* downloaded_bytes,
+                    int64_t* decoded_bytes);
+
+// The load stops at the next file and fails with Canceled, the data loaded
+// so far is freed. The callback is still called.
+void
+CancelLoadTask(CLoadTask c_task);
+
+// the status of the load once the callback is called, the caller owns the
+// error message
+CStatus
+GetLoadTaskStatus(CLoadTask c_task);
+
+// delete the task once the callback is called
+void
+DeleteLoadTask(CLoadTask c_task);
+
+#ifdef __cplusplus
+}
+#endif
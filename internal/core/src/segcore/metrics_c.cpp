@@ -12,6 +12,7 @@
 #include <string>
 
 #include "knowhere/prometheus_client.h"
+#include "segcore/SlowCallRecorder.h"
 #include "segcore/metrics_c.h"
 
 char*
@@ -23,3 +24,13 @@ GetKnowhereMetrics() {
     res[len] = '\0';
     return res;
 }
+
+char*
+GetSegcoreSlowCalls() {
+    auto str = milvus::segcore::SlowCallRecorder::GetInstance().ToJson();
+    auto len = str.length();
+    char* res = (char*)malloc(len + 1);
+    memcpy(res, str.data(), len);
+    res[len] = '\0';
+    return res;
+}
@@ -18,6 +18,11 @@ extern "C" {
 char*
 GetKnowhereMetrics();
 
+// the json array of the latest slow calls of segcore, the oldest first, see
+// SegcoreSetSlowCallThresholdMs. The caller frees it
+char*
+GetSegcoreSlowCalls();
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <chrono>
+
+#include "common/CancellationToken.h"
 #include "pb/segcore.pb.h"
 #include "query/Plan.h"
 #include "segcore/Collection.h"
@@ -23,8 +26,8 @@ CreateSearchPlanByExpr(CCollection c_col,
     auto col = (milvus::segcore::Collection*)c_col;
 
     try {
-        auto res = milvus::query::CreateSearchPlanByExpr(
-            *col->get_schema(), serialized_expr_plan, size);
+        auto res = col->GetPlanCache().CreateSearchPlan(serialized_expr_plan,
+                                                        size);
 
         auto status = CStatus();
         status.error_code = milvus::Success;
@@ -134,8 +137,8 @@ CreateRetrievePlanByExpr(CCollection c_col,
     auto col = static_cast<milvus::segcore::Collection*>(c_col);
 
     try {
-        auto res = milvus::query::CreateRetrievePlanByExpr(
-            *col->get_schema(), serialized_expr_plan, size);
+        auto res = col->GetPlanCache().CreateRetrievePlan(
+            serialized_expr_plan, size);
 
         auto status = CStatus();
         status.error_code = milvus::Success;
@@ -163,3 +166,39 @@ DeleteRetrievePlan(CRetrievePlan c_plan) {
     auto plan = static_cast<milvus::query::RetrievePlan*>(c_plan);
     delete plan;
 }
+
+CCancellationToken
+NewCancellationToken(int64_t timeout_ms) {
+    if (timeout_ms <= 0) {
+        return new milvus::CancellationTokenPtr(
+            std::make_shared<milvus::CancellationToken>());
+    }
+    return new milvus::CancellationTokenPtr(
+        std::make_shared<milvus::CancellationToken>(
+            std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(timeout_ms)));
+}
+
+void
+CancelQuery(CCancellationToken token) {
+    (*static_cast<milvus::CancellationTokenPtr*>(token))->Cancel();
+}
+
+void
+DeleteCancellationToken(CCancellationToken token) {
+    delete static_cast<milvus::CancellationTokenPtr*>(token);
+}
+
+void
+SetSearchPlanCancellationToken(CSearchPlan plan, CCancellationToken token) {
+    auto search_plan = static_cast<milvus::query::Plan*>(plan);
+    search_plan->plan_node_->search_info_.cancellation_token_ =
+        *static_cast<milvus::CancellationTokenPtr*>(token);
+}
+
+void
+SetRetrievePlanCancellationToken(CRetrievePlan plan, CCancellationToken token) {
+    auto retrieve_plan = static_cast<milvus::query::RetrievePlan*>(plan);
+    retrieve_plan->cancellation_token_ =
+        *static_cast<milvus::CancellationTokenPtr*>(token);
+}
@@ -22,6 +22,7 @@ extern "C" {
 typedef void* CSearchPlan;
 typedef void* CPlaceholderGroup;
 typedef void* CRetrievePlan;
+typedef void* CCancellationToken;
 
 // Note: serialized_expr_plan is of binary format
 CStatus
@@ -66,6 +67,25 @@ CreateRetrievePlanByExpr(CCollection c_col,
 void
 DeleteRetrievePlan(CRetrievePlan plan);
 
+// New a token canceling the searches and the retrieves of the plans it's set
+// to, once CancelQuery is called or timeout_ms passes, no timeout if it's 0.
+// The canceled ones fail with Canceled at the boundary of their batches
+CCancellationToken
+NewCancellationToken(int64_t timeout_ms);
+
+void
+CancelQuery(CCancellationToken token);
+
+// the plans the token is set to keep it, it may be deleted before them
+void
+DeleteCancellationToken(CCancellationToken token);
+
+void
+SetSearchPlanCancellationToken(CSearchPlan plan, CCancellationToken token);
+
+void
+SetRetrievePlanCancellationToken(CRetrievePlan plan, CCancellationToken token);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,13 +9,22 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <chrono>
+#include <future>
+#include <memory>
 #include <vector>
 #include "Reduce.h"
 #include "common/QueryResult.h"
 #include "common/EasyAssert.h"
+#include "common/Tracer.h"
+#include "common/Utils.h"
 #include "query/Plan.h"
+#include "segcore/SegmentInterface.h"
+#include "segcore/SlowCallRecorder.h"
 #include "segcore/reduce_c.h"
+#include "segcore/SearchCoalescer.h"
 #include "segcore/Utils.h"
+#include "storage/ThreadPools.h"
 
 using SearchResult = milvus::SearchResult;
 
@@ -49,6 +58,144 @@ ReduceSearchResultsAndFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
     }
 }
 
+CStatus
+SearchSegmentsAndReduce(CSearchResultDataBlobs* cSearchResultDataBlobs,
+                        CSegmentInterface* c_segments,
+                        int64_t num_segments,
+                        CSearchPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        CTraceContext c_trace,
+                        int64_t* slice_nqs,
+                        int64_t* slice_topKs,
+                        int64_t num_slices) {
+    try {
+        auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(
+            c_placeholder_group);
+        AssertInfo(num_segments > 0, "num_segments must be greater than 0");
+        auto ctx = milvus::tracer::TraceContext{
+            c_trace.traceID, c_trace.spanID, c_trace.flag};
+        auto span = milvus::tracer::StartSpan("SegCoreSearchSegments", &ctx);
+        milvus::tracer::SetRootSpan(span);
+
+        auto positively_related = milvus::query::IsPositivelyRelated(plan);
+        std::vector<std::unique_ptr<SearchResult>> results(num_segments);
+        auto search_segment = [&](int64_t i) {
+            milvus::tracer::SetRootSpan(span);
+            auto segment =
+                static_cast<milvus::segcore::SegmentInterface*>(c_segments[i]);
+            auto start = std::chrono::steady_clock::now();
+            // the same entry as the search of a single segment, see Search
+            auto result =
+                milvus::segcore::SearchCoalescer::GetInstance().Search(
+                    *segment, plan, phg_ptr);
+            milvus::segcore::RecordIfSlowSearch(
+                *segment, *plan, *result, start);
+            if (!positively_related) {
+                for (auto& dis : result->distances_) {
+                    dis *= -1;
+                }
+            }
+            results[i] = std::move(result);
+            milvus::tracer::CloseRootSpan();
+        };
+
+        // the searches of the segments submit their own tasks to the high
+        // priority pool and wait for them, so are run on the middle one to
+        // not hold the workers of the pool they wait on
+        auto& pool = milvus::ThreadPools::GetThreadPool(
+            milvus::ThreadPoolPriority::MIDDLE);
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_segments - 1);
+        try {
+            for (int64_t i = 1; i < num_segments; ++i) {
+                futures.emplace_back(pool.Submit(search_segment, i));
+            }
+            search_segment(0);
+            milvus::tracer::SetRootSpan(span);
+            for (auto& future : futures) {
+                future.get();
+            }
+        } catch (...) {
+            // the tasks reference the locals, wait for them before unwinding
+            for (auto& future : futures) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
+        }
+
+        std::vector<SearchResult*> search_results(num_segments);
+        for (int64_t i = 0; i < num_segments; ++i) {
+            search_results[i] = results[i].get();
+        }
+        auto reduce_helper = milvus::segcore::ReduceHelper(
+            search_results, plan, slice_nqs, slice_topKs, num_slices);
+        reduce_helper.Reduce();
+        reduce_helper.Marshal();
+
+        *cSearchResultDataBlobs = reduce_helper.GetSearchResultDataBlobs();
+        span->End();
+        milvus::tracer::CloseRootSpan();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        milvus::tracer::CloseRootSpan();
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+NewSearchResultReducer(CSearchResultReducer* c_reducer,
+                       CSearchPlan c_plan,
+                       int64_t* slice_nqs,
+                       int64_t* slice_topKs,
+                       int64_t num_slices) {
+    try {
+        auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        auto reducer = std::make_unique<milvus::segcore::ReduceHelper>(
+            plan, slice_nqs, slice_topKs, num_slices);
+        *c_reducer = reducer.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        *c_reducer = nullptr;
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+ReducerAddSearchResult(CSearchResultReducer c_reducer,
+                       CSearchResult c_search_result) {
+    try {
+        auto reducer = static_cast<milvus::segcore::ReduceHelper*>(c_reducer);
+        reducer->AddSearchResult(static_cast<SearchResult*>(c_search_result));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+ReducerFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
+                CSearchResultReducer c_reducer) {
+    try {
+        auto reducer = static_cast<milvus::segcore::ReduceHelper*>(c_reducer);
+        reducer->ReduceAddedResults();
+        reducer->Marshal();
+
+        // set final result ptr
+        *cSearchResultDataBlobs = reducer->GetSearchResultDataBlobs();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+DeleteSearchResultReducer(CSearchResultReducer c_reducer) {
+    delete static_cast<milvus::segcore::ReduceHelper*>(c_reducer);
+}
+
 CStatus
 GetSearchResultDataBlob(CProto* searchResultDataBlob,
                         CSearchResultDataBlobs cSearchResultDataBlobs,
@@ -18,6 +18,7 @@ extern "C" {
 #include "segcore/segment_c.h"
 
 typedef void* CSearchResultDataBlobs;
+typedef void* CSearchResultReducer;
 
 CStatus
 ReduceSearchResultsAndFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
@@ -28,6 +29,43 @@ ReduceSearchResultsAndFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
                                int64_t* slice_topKs,
                                int64_t num_slices);
 
+// search the segments with the same plan in parallel and reduce the results
+// as ReduceSearchResultsAndFillData does, in one call instead of one per
+// segment and one for the reduce
+CStatus
+SearchSegmentsAndReduce(CSearchResultDataBlobs* cSearchResultDataBlobs,
+                        CSegmentInterface* c_segments,
+                        int64_t num_segments,
+                        CSearchPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        CTraceContext c_trace,
+                        int64_t* slice_nqs,
+                        int64_t* slice_topKs,
+                        int64_t num_slices);
+
+// the reducer merges the search results of the segments as they arrive,
+// they must outlive the reducer
+CStatus
+NewSearchResultReducer(CSearchResultReducer* c_reducer,
+                       CSearchPlan c_plan,
+                       int64_t* slice_nqs,
+                       int64_t* slice_topKs,
+                       int64_t num_slices);
+
+// merge the search result of a segment, may be called concurrently
+CStatus
+ReducerAddSearchResult(CSearchResultReducer c_reducer,
+                       CSearchResult c_search_result);
+
+// reduce the added search results and fill data as
+// ReduceSearchResultsAndFillData does
+CStatus
+ReducerFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
+                CSearchResultReducer c_reducer);
+
+void
+DeleteSearchResultReducer(CSearchResultReducer c_reducer);
+
 CStatus
 GetSearchResultDataBlob(CProto* searchResultDataBlob,
                         CSearchResultDataBlobs cSearchResultDataBlobs,
@@ -9,10 +9,19 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include "arrow/util/thread_pool.h"
+#include "common/Common.h"
+#include "common/EasyAssert.h"
 #include "config/ConfigKnowhere.h"
+#include "index/DiskSearchScheduler.h"
 #include "log/Log.h"
+#include "mmap/Utils.h"
+#include "query/FilterCache.h"
+#include "segcore/LoadMemoryManager.h"
+#include "segcore/SearchCoalescer.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/segcore_init_c.h"
+#include "storage/LoadContext.h"
 
 namespace milvus::segcore {
 
@@ -38,6 +47,20 @@ SegcoreSetEnableTempSegmentIndex(const bool value) {
     config.set_enable_interim_segment_index(value);
 }
 
+extern "C" void
+SegcoreSetAsyncInterimIndexBuild(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_async_interim_index_build(value);
+}
+
+extern "C" void
+SegcoreSetInterimIndexBuildThreads(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_interim_index_build_threads(value);
+}
+
 extern "C" void
 SegcoreSetNlist(const int64_t value) {
     milvus::segcore::SegcoreConfig& config =
@@ -52,6 +75,159 @@ SegcoreSetNprobe(const int64_t value) {
     config.set_nprobe(value);
 }
 
+extern "C" void
+SegcoreSetInterimIndexQuantization(const char* value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_interim_index_quantization(value);
+}
+
+extern "C" void
+SegcoreSetDropInterimIndexedChunks(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_drop_interim_indexed_chunks(value);
+}
+
+extern "C" void
+SegcoreSetRefineRatio(const float value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_refine_ratio(value);
+}
+
+extern "C" void
+SegcoreSetBruteForceSelectivity(const float value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_brute_force_selectivity(value);
+}
+
+extern "C" void
+SegcoreSetDictEncodeRatio(const float value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_dict_encode_ratio(value);
+}
+
+extern "C" void
+SegcoreSetPackRatio(const float value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_pack_ratio(value);
+}
+
+extern "C" void
+SegcoreSetJsonBinaryEncoding(const bool enable) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_json_binary_encoding(enable);
+}
+
+extern "C" void
+SegcoreSetPlanCacheSize(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_plan_cache_size(value);
+}
+
+extern "C" void
+SegcoreSetStageIndexLoad(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_stage_index_load(value);
+}
+
+extern "C" void
+SegcoreSetEnableChunkArena(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_chunk_arena(value);
+}
+
+extern "C" void
+SegcoreSetChunkArenaHugePage(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_chunk_arena_huge_page(value);
+}
+
+extern "C" void
+SegcoreSetGrowingMmapDir(const char* dir) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_growing_mmap_dir(dir);
+}
+
+extern "C" void
+SegcoreSetGrowingMmapWatermark(const int64_t bytes) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_growing_mmap_watermark(bytes);
+}
+
+extern "C" void
+SegcoreSetSlowCallThresholdMs(const int64_t threshold_ms) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_slow_call_threshold_ms(threshold_ms);
+}
+
+extern "C" void
+SegcoreSetAdaptiveSearchLatencyTargetMs(const int64_t target_ms) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_adaptive_search_latency_target_ms(target_ms);
+}
+
+extern "C" void
+SegcoreSetLoadBudget(const int64_t memory_bytes,
+                     const int64_t bandwidth_bytes_per_second) {
+    milvus::storage::LoadBudget::GetInstance().SetLimits(
+        memory_bytes, bandwidth_bytes_per_second);
+}
+
+extern "C" void
+SegcoreSetLoadMemoryLimit(const int64_t limit_bytes,
+                          const int64_t wait_timeout_ms) {
+    milvus::segcore::LoadMemoryManager::GetInstance().SetLimit(
+        limit_bytes, std::chrono::milliseconds(wait_timeout_ms));
+}
+
+extern "C" void
+SegcoreSetFilterCacheSize(const int64_t capacity_bytes) {
+    milvus::query::FilterCache::GetInstance().SetCapacity(capacity_bytes);
+}
+
+extern "C" void
+SegcoreSetMlockBudget(const int64_t capacity_bytes) {
+    AssertInfo(capacity_bytes >= 0,
+               "invalid mlock budget: {}",
+               capacity_bytes);
+    milvus::MlockBudget::GetInstance().SetCapacity(capacity_bytes);
+}
+
+extern "C" void
+SegcoreSetDiskSearchCapacity(const int64_t capacity,
+                             const int64_t query_budget) {
+    milvus::index::DiskSearchScheduler::GetInstance().SetCapacity(
+        capacity, query_budget);
+}
+
+extern "C" void
+SegcoreSetSearchCoalesceWindow(const int64_t window_us,
+                               const int64_t max_queries) {
+    milvus::segcore::SearchCoalescer::GetInstance().SetWindow(
+        std::chrono::microseconds(window_us), max_queries);
+}
+
+extern "C" void
+SegcoreSetSnapshotDir(const char* dir) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_snapshot_dir(dir);
+}
+
 extern "C" void
 SegcoreSetKnowhereBuildThreadPoolNum(const uint32_t num_threads) {
     milvus::config::KnowhereInitBuildThreadPool(num_threads);
@@ -62,6 +238,23 @@ SegcoreSetKnowhereSearchThreadPoolNum(const uint32_t num_threads) {
     milvus::config::KnowhereInitSearchThreadPool(num_threads);
 }
 
+extern "C" void
+SegcoreSetCpuConcurrency(const uint32_t concurrency) {
+    AssertInfo(concurrency > 0, "cpu concurrency should be positive");
+    // CPU_NUM splits the parallel tasks of segcore, CPU_CONCURRENCY bounds
+    // the workers of its pools once they are created
+    milvus::SetCpuNum(concurrency);
+    milvus::SetCpuConcurrency(concurrency);
+    milvus::config::KnowhereInitBuildThreadPool(concurrency);
+    milvus::config::KnowhereInitSearchThreadPool(concurrency);
+    auto status = arrow::SetCpuThreadPoolCapacity(concurrency);
+    if (!status.ok()) {
+        LOG_SEGCORE_WARNING_ << "set arrow cpu thread pool capacity failed: "
+                             << status.ToString();
+    }
+    LOG_SEGCORE_INFO_ << "set cpu concurrency: " << concurrency;
+}
+
 // return value must be freed by the caller
 extern "C" char*
 SegcoreSetSimdType(const char* value) {
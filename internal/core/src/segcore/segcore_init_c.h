@@ -24,12 +24,110 @@ SegcoreSetChunkRows(const int64_t);
 void
 SegcoreSetEnableTempSegmentIndex(const bool);
 
+void
+SegcoreSetAsyncInterimIndexBuild(const bool);
+
+void
+SegcoreSetInterimIndexBuildThreads(const int64_t);
+
 void
 SegcoreSetNlist(const int64_t);
 
 void
 SegcoreSetNprobe(const int64_t);
 
+void
+SegcoreSetInterimIndexQuantization(const char*);
+
+// drop the raw vector chunks of the growing segments once their interim
+// indexes hold the vectors, see SegcoreConfig
+void
+SegcoreSetDropInterimIndexedChunks(const bool);
+
+void
+SegcoreSetRefineRatio(const float);
+
+void
+SegcoreSetBruteForceSelectivity(const float);
+
+void
+SegcoreSetDictEncodeRatio(const float);
+
+void
+SegcoreSetPackRatio(const float);
+
+void
+SegcoreSetJsonBinaryEncoding(const bool);
+
+void
+SegcoreSetPlanCacheSize(const int64_t);
+
+void
+SegcoreSetStageIndexLoad(const bool);
+
+void
+SegcoreSetEnableChunkArena(const bool);
+
+void
+SegcoreSetChunkArenaHugePage(const bool);
+
+void
+SegcoreSetGrowingMmapDir(const char*);
+
+void
+SegcoreSetGrowingMmapWatermark(const int64_t);
+
+void
+SegcoreSetSlowCallThresholdMs(const int64_t);
+
+// the latency target of the adaptive searches on a segment, 0 disables
+// scaling them down, see SegcoreConfig
+void
+SegcoreSetAdaptiveSearchLatencyTargetMs(const int64_t);
+
+// the budget of the memory of the files in flight and the bandwidth shared
+// by all the loads, 0 is unlimited
+void
+SegcoreSetLoadBudget(const int64_t memory_bytes,
+                     const int64_t bandwidth_bytes_per_second);
+
+// the budget of the memory of the loaded segments and indexes, 0 is
+// unlimited, a load waits up to wait_timeout_ms for the budget before it
+// fails with MemoryBudgetExceeded
+void
+SegcoreSetLoadMemoryLimit(const int64_t limit_bytes,
+                          const int64_t wait_timeout_ms);
+
+// the budget of the bytes of the filter bitsets of the sealed segments
+// cached across the requests, 0 disables the caching
+void
+SegcoreSetFilterCacheSize(const int64_t capacity_bytes);
+
+// the bytes of the mapped columns and indexes locked in memory at most, 0
+// locks nothing
+void
+SegcoreSetMlockBudget(const int64_t capacity_bytes);
+
+// the queries searched at once on the disk indexes of the node, which share
+// the AIO contexts of knowhere, and the queries a search holds at most, the
+// rest of them are searched in the next batches; 0 admits every search
+void
+SegcoreSetDiskSearchCapacity(const int64_t capacity,
+                             const int64_t query_budget);
+
+// the concurrent searches on a segment with the plans serialized the same
+// are coalesced into one search of at most max_queries queries, 0 for no
+// limit, if they arrive within the window of the first one, 0 disables it
+void
+SegcoreSetSearchCoalesceWindow(const int64_t window_us,
+                               const int64_t max_queries);
+
+// the local directory of the snapshots of the sealed segments, which restore
+// the pk index and the interim index of a segment reloaded from the same
+// binlogs, empty disables them
+void
+SegcoreSetSnapshotDir(const char* dir);
+
 // return value must be freed by the caller
 char*
 SegcoreSetSimdType(const char*);
@@ -40,6 +138,13 @@ SegcoreSetKnowhereBuildThreadPoolNum(const uint32_t num_threads);
 void
 SegcoreSetKnowhereSearchThreadPoolNum(const uint32_t num_threads);
 
+// the cpu concurrency of the whole process, the knowhere build and search
+// pools, the arrow cpu pool, the workers of each segcore thread pool and the
+// parallel tasks of segcore are all bounded by it rather than each sized by
+// the cores, must be set at init before the segcore pools are first used
+void
+SegcoreSetCpuConcurrency(const uint32_t concurrency);
+
 void
 SegcoreCloseGlog();
 
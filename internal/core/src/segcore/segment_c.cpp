@@ -11,23 +11,49 @@
 
 #include "segcore/segment_c.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <utility>
 
+#include "arrow/c/bridge.h"
 #include "common/FieldData.h"
 #include "common/LoadInfo.h"
 #include "common/Types.h"
+#include "common/Utils.h"
+#include "common/protobuf_utils.h"
 #include "common/Tracer.h"
 #include "common/type_c.h"
 #include "google/protobuf/text_format.h"
 #include "log/Log.h"
 #include "mmap/Types.h"
+#include "nlohmann/json.hpp"
 #include "segcore/Collection.h"
+#include "segcore/LoadMemoryManager.h"
+#include "segcore/SearchCoalescer.h"
+#include "segcore/SearchIterator.h"
 #include "segcore/SegmentGrowingImpl.h"
+#include "segcore/SegmentHandoff.h"
 #include "segcore/SegmentSealedImpl.h"
+#include "segcore/SlowCallRecorder.h"
 #include "segcore/Utils.h"
+#include "storage/ThreadPool.h"
 #include "storage/Util.h"
 #include "storage/space.h"
 
+namespace {
+
+// count the memory the segment holds against the load memory budget
+void
+UpdateLoadMemoryUsage(const milvus::segcore::SegmentInterface* segment) {
+    milvus::segcore::LoadMemoryManager::GetInstance().SetUsage(
+        segment, segment->GetMemoryUsage().Total());
+}
+
+}  // namespace
+
 //////////////////////////////    common interfaces    //////////////////////////////
 CStatus
 NewSegment(CCollection collection,
@@ -66,9 +92,40 @@ NewSegment(CCollection collection,
 void
 DeleteSegment(CSegmentInterface c_segment) {
     auto s = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+    milvus::segcore::LoadMemoryManager::GetInstance().ReleaseUsage(s);
     delete s;
 }
 
+CStatus
+HandoffGrowingSegment(CCollection collection,
+                      CSegmentInterface growing_segment,
+                      CSegmentInterface* sealed_segment) {
+    try {
+        auto col = static_cast<milvus::segcore::Collection*>(collection);
+        auto growing = dynamic_cast<milvus::segcore::SegmentGrowingImpl*>(
+            static_cast<milvus::segcore::SegmentInterface*>(growing_segment));
+        AssertInfo(growing != nullptr, "segment is not a growing segment");
+        // the sealed segment takes about the memory of the growing one
+        auto reservation =
+            milvus::segcore::LoadMemoryManager::GetInstance().Reserve(
+                growing->GetMemoryUsage().Total());
+        auto segment = milvus::segcore::HandoffGrowingSegment(
+            *growing, col->get_schema(), col->GetIndexMeta());
+        UpdateLoadMemoryUsage(segment.get());
+        *sealed_segment = segment.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+RemoveSegmentSnapshot(int64_t segment_id) {
+    auto& config = milvus::segcore::SegcoreConfig::default_config();
+    milvus::segcore::SegmentSnapshot(config.get_snapshot_dir(), segment_id)
+        .Remove();
+}
+
 void
 DeleteSearchResult(CSearchResult search_result) {
     auto res = static_cast<milvus::SearchResult*>(search_result);
@@ -90,9 +147,13 @@ Search(CSegmentInterface c_segment,
             c_trace.traceID, c_trace.spanID, c_trace.flag};
         auto span = milvus::tracer::StartSpan("SegCoreSearch", &ctx);
         milvus::tracer::SetRootSpan(span);
-        auto search_result = segment->Search(plan, phg_ptr);
-        if (!milvus::PositivelyRelated(
-                plan->plan_node_->search_info_.metric_type_)) {
+        auto start = std::chrono::steady_clock::now();
+        auto search_result =
+            milvus::segcore::SearchCoalescer::GetInstance().Search(
+                *segment, plan, phg_ptr);
+        milvus::segcore::RecordIfSlowSearch(
+            *segment, *plan, *search_result, start);
+        if (!milvus::query::IsPositivelyRelated(plan)) {
             for (auto& dis : search_result->distances_) {
                 dis *= -1;
             }
@@ -106,6 +167,54 @@ Search(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+GetSearchResultProfile(CSearchResult c_search_result, CProto* profile) {
+    try {
+        auto search_result =
+            static_cast<milvus::SearchResult*>(c_search_result);
+        profile->proto_blob = nullptr;
+        profile->proto_size = 0;
+        if (search_result->profile_ == nullptr) {
+            return milvus::SuccessCStatus();
+        }
+        auto json = search_result->profile_->ToJson();
+        void* buffer = malloc(json.size());
+        std::memcpy(buffer, json.data(), json.size());
+        profile->proto_blob = buffer;
+        profile->proto_size = json.size();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+DeleteSearchResultProfile(CProto* profile) {
+    std::free(const_cast<void*>(profile->proto_blob));
+}
+
+CStatus
+GetSearchResultAdaptedParams(CSearchResult c_search_result, CProto* params) {
+    try {
+        auto search_result =
+            static_cast<milvus::SearchResult*>(c_search_result);
+        params->proto_blob = nullptr;
+        params->proto_size = 0;
+        if (search_result->adapted_search_params_.empty()) {
+            return milvus::SuccessCStatus();
+        }
+        auto json =
+            nlohmann::json(search_result->adapted_search_params_).dump();
+        void* buffer = malloc(json.size());
+        std::memcpy(buffer, json.data(), json.size());
+        params->proto_blob = buffer;
+        params->proto_size = json.size();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result) {
     std::free(const_cast<void*>(retrieve_result->proto_blob));
@@ -127,7 +236,10 @@ Retrieve(CSegmentInterface c_segment,
             c_trace.traceID, c_trace.spanID, c_trace.flag};
         auto span = milvus::tracer::StartSpan("SegCoreRetrieve", &ctx);
 
+        auto start = std::chrono::steady_clock::now();
         auto retrieve_result = segment->Retrieve(plan, timestamp, limit_size);
+        milvus::segcore::RecordIfSlowRetrieve(
+            *segment, *plan, retrieve_result->offset_size(), start);
 
         auto size = retrieve_result->ByteSizeLong();
         void* buffer = malloc(size);
@@ -143,13 +255,256 @@ Retrieve(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+RetrieveArrow(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              CTraceContext c_trace,
+              uint64_t timestamp,
+              struct ArrowArray* array,
+              struct ArrowSchema* schema,
+              int64_t limit_size) {
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
+
+        auto ctx = milvus::tracer::TraceContext{
+            c_trace.traceID, c_trace.spanID, c_trace.flag};
+        auto span = milvus::tracer::StartSpan("SegCoreRetrieveArrow", &ctx);
+
+        auto start = std::chrono::steady_clock::now();
+        auto retrieve_result = segment->Retrieve(plan, timestamp, limit_size);
+        milvus::segcore::RecordIfSlowRetrieve(
+            *segment, *plan, retrieve_result->offset_size(), start);
+        auto batch =
+            milvus::segcore::RetrieveResultsToRecordBatch(*retrieve_result);
+        auto status = arrow::ExportRecordBatch(*batch, array, schema);
+        AssertInfo(status.ok(),
+                   "export retrieve results failed: {}",
+                   status.ToString());
+
+        span->End();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+namespace {
+
+struct AsyncTask {
+    std::atomic<bool> canceled{false};
+    // the ids of the trace context copied, as the caller's are released once
+    // the task is started
+    std::array<uint8_t, 16> trace_id{};
+    std::array<uint8_t, 8> span_id{};
+    CTraceContext trace{};
+
+    CStatus status = milvus::SuccessCStatus();
+    CSearchResult search_result = nullptr;
+    CRetrieveResult retrieve_result{nullptr, 0};
+
+    explicit AsyncTask(CTraceContext c_trace) {
+        trace.flag = c_trace.flag;
+        if (c_trace.traceID != nullptr && c_trace.spanID != nullptr) {
+            std::memcpy(trace_id.data(), c_trace.traceID, trace_id.size());
+            std::memcpy(span_id.data(), c_trace.spanID, span_id.size());
+            trace.traceID = trace_id.data();
+            trace.spanID = span_id.data();
+        }
+    }
+};
+
+// the async searches and retrieves run on their own pool rather than the high
+// priority one, which their parallel parts are submitted to and waited for,
+// so that they never wait for the tasks queued behind them
+milvus::ThreadPool&
+AsyncTaskPool() {
+    static auto pool = new milvus::ThreadPool(
+        milvus::HIGH_PRIORITY_THREAD_CORE_COEFFICIENT, "async_search_pool");
+    return *pool;
+}
+
+template <typename Call>
+CStatus
+StartAsyncTask(CTraceContext c_trace,
+               CAsyncTaskCallback callback,
+               void* callback_arg,
+               CAsyncTask* c_task,
+               Call call) {
+    AsyncTask* raw_task = nullptr;
+    try {
+        // the handle is published before the task may run, the callback may
+        // look it up, and the task may be deleted once the callback is called
+        raw_task = new AsyncTask(c_trace);
+        *c_task = raw_task;
+        AsyncTaskPool().Submit([task = raw_task,
+                                call = std::move(call),
+                                callback,
+                                callback_arg] {
+            if (task->canceled.load()) {
+                task->status = milvus::FailureCStatus(
+                    milvus::Canceled, "canceled before started");
+            } else {
+                task->status = call(task);
+            }
+            callback(callback_arg);
+        });
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        // never submitted, the handle is reclaimed
+        *c_task = nullptr;
+        delete raw_task;
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+}  // namespace
+
+CStatus
+AsyncSearch(CSegmentInterface c_segment,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            CTraceContext c_trace,
+            CAsyncTaskCallback callback,
+            void* callback_arg,
+            CAsyncTask* task) {
+    return StartAsyncTask(
+        c_trace, callback, callback_arg, task, [=](AsyncTask* async_task) {
+            return Search(c_segment,
+                          c_plan,
+                          c_placeholder_group,
+                          async_task->trace,
+                          &async_task->search_result);
+        });
+}
+
+CStatus
+AsyncRetrieve(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              CTraceContext c_trace,
+              uint64_t timestamp,
+              int64_t limit_size,
+              CAsyncTaskCallback callback,
+              void* callback_arg,
+              CAsyncTask* task) {
+    return StartAsyncTask(
+        c_trace, callback, callback_arg, task, [=](AsyncTask* async_task) {
+            return Retrieve(c_segment,
+                            c_plan,
+                            async_task->trace,
+                            timestamp,
+                            &async_task->retrieve_result,
+                            limit_size);
+        });
+}
+
+void
+CancelAsyncTask(CAsyncTask c_task) {
+    static_cast<AsyncTask*>(c_task)->canceled.store(true);
+}
+
+CStatus
+GetAsyncSearchResult(CAsyncTask c_task, CSearchResult* result) {
+    auto task = static_cast<AsyncTask*>(c_task);
+    auto status = std::exchange(task->status, milvus::SuccessCStatus());
+    *result = std::exchange(task->search_result, nullptr);
+    return status;
+}
+
+CStatus
+GetAsyncRetrieveResult(CAsyncTask c_task, CRetrieveResult* result) {
+    auto task = static_cast<AsyncTask*>(c_task);
+    auto status = std::exchange(task->status, milvus::SuccessCStatus());
+    *result = std::exchange(task->retrieve_result, CRetrieveResult{nullptr, 0});
+    return status;
+}
+
+void
+DeleteAsyncTask(CAsyncTask c_task) {
+    auto task = static_cast<AsyncTask*>(c_task);
+    if (task->status.error_code != milvus::Success) {
+        std::free(const_cast<char*>(task->status.error_msg));
+    }
+    DeleteSearchResult(task->search_result);
+    DeleteRetrieveResult(&task->retrieve_result);
+    delete task;
+}
+
+CStatus
+CreateSearchIterator(CSegmentInterface c_segment,
+                     CSearchPlan c_plan,
+                     CPlaceholderGroup c_placeholder_group,
+                     int64_t ttl_ms,
+                     int64_t* iterator_id) {
+    try {
+        auto segment =
+            dynamic_cast<milvus::segcore::SegmentInternalInterface*>(
+                static_cast<milvus::segcore::SegmentInterface*>(c_segment));
+        AssertInfo(segment != nullptr, "invalid segment");
+        auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        auto phg_ptr = static_cast<milvus::query::PlaceholderGroup*>(
+            c_placeholder_group);
+        auto iterator = std::make_unique<milvus::segcore::SearchIterator>(
+            *segment, *plan, *phg_ptr);
+        *iterator_id =
+            milvus::segcore::SearchIteratorManager::GetInstance().Add(
+                std::move(iterator), ttl_ms);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+SearchIteratorNext(int64_t iterator_id,
+                   int64_t batch_size,
+                   CSearchResult* result) {
+    try {
+        auto iterator =
+            milvus::segcore::SearchIteratorManager::GetInstance().Get(
+                iterator_id);
+        if (iterator == nullptr) {
+            PanicInfo(milvus::SearchIteratorNotExist,
+                      "search iterator {} is deleted or expired",
+                      iterator_id);
+        }
+        auto search_result = iterator->Next(batch_size);
+        if (!milvus::PositivelyRelated(iterator->metric_type())) {
+            for (auto& dis : search_result->distances_) {
+                dis *= -1;
+            }
+        }
+        *result = search_result.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+DeleteSearchIterator(int64_t iterator_id) {
+    milvus::segcore::SearchIteratorManager::GetInstance().Remove(iterator_id);
+}
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
-    auto mem_size = segment->GetMemoryUsageInBytes();
+    auto mem_size = segment->ReportMemoryUsage().Total();
     return mem_size;
 }
 
+CSegmentMemoryUsage
+GetSegmentMemoryUsage(CSegmentInterface c_segment) {
+    auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+    auto usage = segment->ReportMemoryUsage();
+    return CSegmentMemoryUsage{usage.field_data,
+                               usage.index,
+                               usage.pk_index,
+                               usage.timestamps,
+                               usage.deleted_record};
+}
+
 int64_t
 GetRowCount(CSegmentInterface c_segment) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
@@ -193,12 +548,38 @@ Insert(CSegmentInterface c_segment,
        const uint64_t data_info_len) {
     try {
         auto segment = static_cast<milvus::segcore::SegmentGrowing*>(c_segment);
-        auto insert_data = std::make_unique<milvus::InsertData>();
+        google::protobuf::Arena arena(
+            milvus::ParseArenaOptions(data_info_len));
+        auto insert_data =
+            google::protobuf::Arena::CreateMessage<milvus::InsertData>(&arena);
         auto suc = insert_data->ParseFromArray(data_info, data_info_len);
         AssertInfo(suc, "failed to parse insert data from records");
 
         segment->Insert(
-            reserved_offset, size, row_ids, timestamps, insert_data.get());
+            reserved_offset, size, row_ids, timestamps, insert_data);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InsertArrow(CSegmentInterface c_segment,
+            int64_t reserved_offset,
+            int64_t size,
+            const int64_t* row_ids,
+            const uint64_t* timestamps,
+            struct ArrowArray* array,
+            struct ArrowSchema* schema) {
+    try {
+        auto segment = static_cast<milvus::segcore::SegmentGrowing*>(c_segment);
+        auto batch = arrow::ImportRecordBatch(array, schema);
+        AssertInfo(batch.ok(),
+                   "import insert record batch failed: {}",
+                   batch.status().ToString());
+
+        segment->Insert(
+            reserved_offset, size, row_ids, timestamps, *batch.ValueOrDie());
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -216,6 +597,36 @@ PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset) {
     }
 }
 
+CStatus
+ExistPk(CSegmentInterface c_segment,
+        const uint8_t* raw_ids,
+        const uint64_t size,
+        bool* results) {
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto ids = std::make_unique<milvus::proto::schema::IDs>();
+        auto suc = ids->ParseFromArray(raw_ids, size);
+        AssertInfo(suc, "failed to parse pks from ids");
+
+        auto& schema = segment->get_schema();
+        auto pk_field_id = schema.get_primary_field_id();
+        AssertInfo(pk_field_id.has_value(), "primary key field not found");
+        auto data_type = schema[pk_field_id.value()].get_data_type();
+        std::vector<milvus::PkType> pks(
+            milvus::segcore::GetSizeOfIdArray(*ids));
+        milvus::segcore::ParsePksFromIDs(pks, data_type, *ids);
+        // the sealed segments reject most of the absent pks by the bloom
+        // filter of the pk index
+        for (size_t i = 0; i < pks.size(); ++i) {
+            results[i] = segment->Contain(pks[i]);
+        }
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 Delete(CSegmentInterface c_segment,
        int64_t reserved_offset,  // deprecated
@@ -245,7 +656,14 @@ LoadFieldData(CSegmentInterface c_segment,
             reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
         AssertInfo(segment != nullptr, "segment conversion failed");
         auto load_info = (LoadFieldDataInfo*)c_load_field_data_info;
+        auto start = std::chrono::steady_clock::now();
+        auto reservation =
+            milvus::segcore::LoadMemoryManager::GetInstance().Reserve(
+                milvus::segcore::EstimateLoadFieldDataBytes(*segment,
+                                                            *load_info));
         segment->LoadFieldData(*load_info);
+        UpdateLoadMemoryUsage(segment);
+        milvus::segcore::RecordIfSlowLoad(*segment, *load_info, start);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -260,7 +678,14 @@ LoadFieldDataV2(CSegmentInterface c_segment,
             reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
         AssertInfo(segment != nullptr, "segment conversion failed");
         auto load_info = (LoadFieldDataInfo*)c_load_field_data_info;
+        auto start = std::chrono::steady_clock::now();
+        auto reservation =
+            milvus::segcore::LoadMemoryManager::GetInstance().Reserve(
+                milvus::segcore::EstimateLoadFieldDataBytes(*segment,
+                                                            *load_info));
         segment->LoadFieldDataV2(*load_info);
+        UpdateLoadMemoryUsage(segment);
+        milvus::segcore::RecordIfSlowLoad(*segment, *load_info, start);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -321,6 +746,7 @@ LoadDeletedRecord(CSegmentInterface c_segment,
                                                pks.get(),
                                                deleted_record_info.row_count};
         segment_interface->LoadDeletedRecord(load_info);
+        UpdateLoadMemoryUsage(segment_interface);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -339,6 +765,10 @@ UpdateSealedSegmentIndex(CSegmentInterface c_segment,
         auto load_index_info =
             static_cast<milvus::segcore::LoadIndexInfo*>(c_load_index_info);
         segment->LoadIndex(*load_index_info);
+        // the index is counted by the segment from now on
+        milvus::segcore::LoadMemoryManager::GetInstance().ReleaseUsage(
+            load_index_info);
+        UpdateLoadMemoryUsage(segment_interface);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -371,6 +801,7 @@ DropFieldData(CSegmentInterface c_segment, int64_t field_id) {
             dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
         AssertInfo(segment != nullptr, "segment conversion failed");
         segment->DropFieldData(milvus::FieldId(field_id));
+        UpdateLoadMemoryUsage(segment_interface);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -386,6 +817,7 @@ DropSealedSegmentIndex(CSegmentInterface c_segment, int64_t field_id) {
             dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
         AssertInfo(segment != nullptr, "segment conversion failed");
         segment->DropIndex(milvus::FieldId(field_id));
+        UpdateLoadMemoryUsage(segment_interface);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -409,3 +841,38 @@ AddFieldDataInfoForSealed(CSegmentInterface c_segment,
         return milvus::FailureCStatus(milvus::UnexpectedError, e.what());
     }
 }
+
+CStatus
+PrefetchChunkCache(CSegmentInterface c_segment, int64_t field_id) {
+    try {
+        auto segment_interface =
+            reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment =
+            dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        segment->PrefetchChunkCache(milvus::FieldId(field_id));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(milvus::UnexpectedError, e.what());
+    }
+}
+
+CStatus
+AddJsonKeyColumn(CSegmentInterface c_segment,
+                 int64_t field_id,
+                 const char* json_pointer,
+                 CDataType data_type) {
+    try {
+        auto segment_interface =
+            reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment =
+            dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        segment->AddJsonKeyColumn(milvus::FieldId(field_id),
+                                  json_pointer,
+                                  milvus::DataType(data_type));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
@@ -26,6 +26,22 @@ extern "C" {
 
 typedef void* CSearchResult;
 typedef CProto CRetrieveResult;
+// a search or a retrieve run asynchronously, see AsyncSearch
+typedef void* CAsyncTask;
+// called once the async task is done, on a thread of segcore
+typedef void (*CAsyncTaskCallback)(void* arg);
+
+typedef struct CSegmentMemoryUsage {
+    int64_t field_data;
+    int64_t index;
+    int64_t pk_index;
+    int64_t timestamps;
+    int64_t deleted_record;
+} CSegmentMemoryUsage;
+
+// the structs of the Arrow C data interface
+struct ArrowArray;
+struct ArrowSchema;
 
 //////////////////////////////    common interfaces    //////////////////////////////
 CStatus
@@ -37,6 +53,19 @@ NewSegment(CCollection collection,
 void
 DeleteSegment(CSegmentInterface c_segment);
 
+// build the sealed segment of the flushed growing segment from the rows and
+// the deletes in memory, instead of loading its binlogs, the growing segment
+// is unchanged and released by the caller
+CStatus
+HandoffGrowingSegment(CCollection collection,
+                      CSegmentInterface growing_segment,
+                      CSegmentInterface* sealed_segment);
+
+// remove the snapshot of the sealed segment, once the segment is released
+// for good, e.g. compacted or dropped
+void
+RemoveSegmentSnapshot(int64_t segment_id);
+
 void
 DeleteSearchResult(CSearchResult search_result);
 
@@ -47,6 +76,24 @@ Search(CSegmentInterface c_segment,
        CTraceContext c_trace,
        CSearchResult* result);
 
+// Get the profile of the search as a json array of the stages, for the slow
+// query log. The profile is empty if the search didn't ask for it by the
+// "profile" search param. The caller frees it by DeleteSearchResultProfile,
+// and may get it before or after the result is reduced, the later has the
+// stages of the reduce
+CStatus
+GetSearchResultProfile(CSearchResult c_search_result, CProto* profile);
+
+void
+DeleteSearchResultProfile(CProto* profile);
+
+// Get the effort params the search on a segment was scaled down to by the
+// "adaptive_search" search param, as a json object of the params, empty if
+// it ran at the requested effort. Got before the result is reduced, the
+// caller frees it by DeleteSearchResultProfile
+CStatus
+GetSearchResultAdaptedParams(CSearchResult c_search_result, CProto* params);
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result);
 
@@ -58,9 +105,92 @@ Retrieve(CSegmentInterface c_segment,
          CRetrieveResult* result,
          int64_t limit_size);
 
+// Retrieve the rows as an arrow record batch instead of a serialized
+// RetrieveResults, the columns are named by the field ids and the offsets
+// of the rows are the trailing "offset" column. The caller releases the
+// array and the schema by their release callbacks.
+CStatus
+RetrieveArrow(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              CTraceContext c_trace,
+              uint64_t timestamp,
+              struct ArrowArray* array,
+              struct ArrowSchema* schema,
+              int64_t limit_size);
+
+// Start the search of Search on the pool of segcore instead of the calling
+// thread, the callback is called with the arg once it's done, then its result
+// is got by GetAsyncSearchResult. The segment, the plan and the placeholder
+// group are kept until the callback is called, the task is deleted by
+// DeleteAsyncTask after it
+CStatus
+AsyncSearch(CSegmentInterface c_segment,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            CTraceContext c_trace,
+            CAsyncTaskCallback callback,
+            void* callback_arg,
+            CAsyncTask* task);
+
+// the retrieve of Retrieve run as AsyncSearch, its result is got by
+// GetAsyncRetrieveResult
+CStatus
+AsyncRetrieve(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              CTraceContext c_trace,
+              uint64_t timestamp,
+              int64_t limit_size,
+              CAsyncTaskCallback callback,
+              void* callback_arg,
+              CAsyncTask* task);
+
+// Cancel the async task, it fails with Canceled if it hasn't started yet, or
+// runs to the end otherwise. The callback is called either way
+void
+CancelAsyncTask(CAsyncTask c_task);
+
+// Get the status and the result of the async search once its callback is
+// called. The result is owned by the caller if the status is a success
+CStatus
+GetAsyncSearchResult(CAsyncTask c_task, CSearchResult* result);
+
+CStatus
+GetAsyncRetrieveResult(CAsyncTask c_task, CRetrieveResult* result);
+
+// Delete the async task after its callback is called, with the result not got
+void
+DeleteAsyncTask(CAsyncTask c_task);
+
+// Start an iterator over the results of the search of a single query on the
+// segment, which are then returned a batch at a time by SearchIteratorNext
+// without searching the batches before again. The filter is evaluated here.
+// The iterator is named by the id, it's deleted by DeleteSearchIterator or
+// once it's not used for ttl_ms, never if ttl_ms is 0. The segment must
+// outlive it
+CStatus
+CreateSearchIterator(CSegmentInterface c_segment,
+                     CSearchPlan c_plan,
+                     CPlaceholderGroup c_placeholder_group,
+                     int64_t ttl_ms,
+                     int64_t* iterator_id);
+
+// the next batch_size results of the iterator, fewer once the rows are
+// exhausted, the result is deleted by DeleteSearchResult
+CStatus
+SearchIteratorNext(int64_t iterator_id,
+                   int64_t batch_size,
+                   CSearchResult* result);
+
+void
+DeleteSearchIterator(int64_t iterator_id);
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment);
 
+// the bytes of the memory held by the segment by component
+CSegmentMemoryUsage
+GetSegmentMemoryUsage(CSegmentInterface c_segment);
+
 int64_t
 GetRowCount(CSegmentInterface c_segment);
 
@@ -83,6 +213,19 @@ Insert(CSegmentInterface c_segment,
        const uint8_t* data_info,
        const uint64_t data_info_len);
 
+// Insert the rows of an arrow record batch instead of a serialized
+// InsertData, the columns are named by the field ids. The vectors are fixed
+// size binaries, the json and the serialized arrays are binaries. The batch
+// is imported from the array and the schema, which are released once done.
+CStatus
+InsertArrow(CSegmentInterface c_segment,
+            int64_t reserved_offset,
+            int64_t size,
+            const int64_t* row_ids,
+            const uint64_t* timestamps,
+            struct ArrowArray* array,
+            struct ArrowSchema* schema);
+
 CStatus
 PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset);
 
@@ -125,6 +268,15 @@ CStatus
 AddFieldDataInfoForSealed(CSegmentInterface c_segment,
                           CLoadFieldDataInfo c_load_field_data_info);
 
+CStatus
+PrefetchChunkCache(CSegmentInterface c_segment, int64_t field_id);
+
+CStatus
+AddJsonKeyColumn(CSegmentInterface c_segment,
+                 int64_t field_id,
+                 const char* json_pointer,
+                 CDataType data_type);
+
 //////////////////////////////    interfaces for SegmentInterface    //////////////////////////////
 CStatus
 ExistPk(CSegmentInterface c_segment,
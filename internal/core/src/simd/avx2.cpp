@@ -12,13 +12,18 @@
 #if defined(__x86_64__)
 
 #include "avx2.h"
+#include "compare.h"
 #include "sse2.h"
 #include "sse4.h"
+#include "ref.h"
 
 #include <immintrin.h>
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 
 namespace milvus {
 namespace simd {
@@ -305,6 +310,588 @@ OrBoolAVX2(bool* left, bool* right, int64_t size) {
     }
 }
 
+void
+GreaterThanTimestampAVX2(const uint64_t* src,
+                         int64_t size,
+                         uint64_t val,
+                         BitsetBlockType* dst) {
+    constexpr int64_t block_bits = BITSET_BLOCK_SIZE * 8;
+    // avx2 only compares the signed integers, flipping the sign bits keeps
+    // the order of the unsigned ones
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i target = _mm256_xor_si256(_mm256_set1_epi64x(val), sign);
+    int64_t num_blocks = size / block_bits;
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        BitsetBlockType block = 0;
+        for (int64_t j = 0; j < block_bits; j += 4) {
+            __m256i data = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(src + i * block_bits + j));
+            __m256i cmp =
+                _mm256_cmpgt_epi64(_mm256_xor_si256(data, sign), target);
+            auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+            block |= BitsetBlockType(mask) << j;
+        }
+        dst[i] = block;
+    }
+    GreaterThanTimestampRef(src + num_blocks * block_bits,
+                            size - num_blocks * block_bits,
+                            val,
+                            dst + num_blocks);
+}
+
+namespace {
+
+float
+ReduceAddAVX2(__m256 v) {
+    __m128 sum =
+        _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum);
+}
+
+__m256
+LoadFloat16AVX2(const uint16_t* src) {
+    return _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+}  // namespace
+
+float
+L2SqrFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        __m256 diff0 =
+            _mm256_sub_ps(LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i));
+        __m256 diff1 = _mm256_sub_ps(LoadFloat16AVX2(x + i + 8),
+                                     LoadFloat16AVX2(y + i + 8));
+        acc0 = _mm256_fmadd_ps(diff0, diff0, acc0);
+        acc1 = _mm256_fmadd_ps(diff1, diff1, acc1);
+    }
+    if (i + 8 <= dim) {
+        __m256 diff =
+            _mm256_sub_ps(LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i));
+        acc0 = _mm256_fmadd_ps(diff, diff, acc0);
+        i += 8;
+    }
+    return ReduceAddAVX2(_mm256_add_ps(acc0, acc1)) +
+           L2SqrFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        acc0 = _mm256_fmadd_ps(
+            LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i), acc0);
+        acc1 = _mm256_fmadd_ps(
+            LoadFloat16AVX2(x + i + 8), LoadFloat16AVX2(y + i + 8), acc1);
+    }
+    if (i + 8 <= dim) {
+        acc0 = _mm256_fmadd_ps(
+            LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i), acc0);
+        i += 8;
+    }
+    return ReduceAddAVX2(_mm256_add_ps(acc0, acc1)) +
+           InnerProductFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloatAVX2(const float* x, const float* y, size_t dim) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= dim; i += 16) {
+        acc0 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+        acc1 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), acc1);
+    }
+    if (i + 8 <= dim) {
+        acc0 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+        i += 8;
+    }
+    return ReduceAddAVX2(_mm256_add_ps(acc0, acc1)) +
+           InnerProductFloatRef(x + i, y + i, dim - i);
+}
+
+namespace {
+
+template <size_t Dim>
+float
+InnerProductFloatDimAVX2(const float* x, const float* y, size_t) {
+    static_assert(Dim % 32 == 0);
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    for (size_t i = 0; i < Dim; i += 32) {
+        acc0 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+        acc1 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(
+            _mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), acc3);
+    }
+    return ReduceAddAVX2(
+        _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+}
+
+}  // namespace
+
+FloatDistancePtr
+InnerProductFloatOfDimAVX2(size_t dim) {
+    return KernelOfDim(dim, [](auto dim_constant) -> FloatDistancePtr {
+        return InnerProductFloatDimAVX2<decltype(dim_constant)::value>;
+    });
+}
+
+namespace {
+
+// the popcounts of the bytes of v summed into its 4 64-bit lanes
+__m256i
+PopcountAVX2(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3,
+                                            1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i count = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                    _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(count, _mm256_setzero_si256());
+}
+
+uint64_t
+ReduceAddEpi64AVX2(__m256i v) {
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v),
+                                _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+__m256i
+LoadBinaryAVX2(const uint8_t* src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+
+// the kernels of Bytes bytes known at compile time, or of bytes for 0
+template <size_t Bytes>
+float
+HammingBinaryBytesAVX2(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i diff =
+            _mm256_xor_si256(LoadBinaryAVX2(x + i), LoadBinaryAVX2(y + i));
+        acc = _mm256_add_epi64(acc, PopcountAVX2(diff));
+    }
+    auto count = ReduceAddEpi64AVX2(acc);
+    if constexpr (Bytes % 32 != 0 || Bytes == 0) {
+        count += XorPopcountRef(x + i, y + i, n - i);
+    }
+    return count;
+}
+
+template <size_t Bytes>
+float
+JaccardBinaryBytesAVX2(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    __m256i and_acc = _mm256_setzero_si256();
+    __m256i or_acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i vx = LoadBinaryAVX2(x + i);
+        __m256i vy = LoadBinaryAVX2(y + i);
+        and_acc =
+            _mm256_add_epi64(and_acc, PopcountAVX2(_mm256_and_si256(vx, vy)));
+        or_acc =
+            _mm256_add_epi64(or_acc, PopcountAVX2(_mm256_or_si256(vx, vy)));
+    }
+    auto and_count = ReduceAddEpi64AVX2(and_acc);
+    auto or_count = ReduceAddEpi64AVX2(or_acc);
+    if constexpr (Bytes % 32 != 0 || Bytes == 0) {
+        AndOrPopcountRef(x + i, y + i, n - i, and_count, or_count);
+    }
+    return JaccardDistance(and_count, or_count);
+}
+
+}  // namespace
+
+float
+HammingBinaryAVX2(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return HammingBinaryBytesAVX2<0>(x, y, bytes);
+}
+
+float
+JaccardBinaryAVX2(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return JaccardBinaryBytesAVX2<0>(x, y, bytes);
+}
+
+BinaryDistancePtr
+HammingBinaryOfDimAVX2(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return HammingBinaryBytesAVX2<decltype(dim_constant)::value / 8>;
+        });
+}
+
+BinaryDistancePtr
+JaccardBinaryOfDimAVX2(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return JaccardBinaryBytesAVX2<decltype(dim_constant)::value / 8>;
+        });
+}
+
+namespace {
+
+// res[i] = bit i of mask for the 32 bools at res
+inline void
+StoreMaskAVX2(uint32_t mask, bool* res) {
+    // the byte j of the result takes the byte j / 8 of the mask, and then
+    // the bit j % 8 of it
+    const __m256i shuffle = _mm256_setr_epi64x(0x0000000000000000,
+                                               0x0101010101010101,
+                                               0x0202020202020202,
+                                               0x0303030303030303);
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201);
+    __m256i bytes =
+        _mm256_shuffle_epi8(_mm256_set1_epi32(int32_t(mask)), shuffle);
+    bytes = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, select), select);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(res),
+                        _mm256_and_si256(bytes, _mm256_set1_epi8(1)));
+}
+
+template <typename T>
+inline __m256i
+Set1AVX2(T val) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8(val);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(val);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_set1_epi32(val);
+    } else {
+        return _mm256_set1_epi64x(val);
+    }
+}
+
+template <typename T>
+inline __m256i
+CmpEqAVX2(__m256i x, __m256i y) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpeq_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpeq_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpeq_epi32(x, y);
+    } else {
+        return _mm256_cmpeq_epi64(x, y);
+    }
+}
+
+template <typename T>
+inline __m256i
+CmpGtAVX2(__m256i x, __m256i y) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpgt_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpgt_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpgt_epi32(x, y);
+    } else {
+        return _mm256_cmpgt_epi64(x, y);
+    }
+}
+
+// the lanes of x op y, all ones if true, of the signed integers T
+template <typename T, CompareOp op>
+inline __m256i
+CompareIntAVX2(__m256i x, __m256i y) {
+    const __m256i ones = _mm256_set1_epi8(-1);
+    if constexpr (op == CompareOp::EQ) {
+        return CmpEqAVX2<T>(x, y);
+    } else if constexpr (op == CompareOp::NE) {
+        return _mm256_xor_si256(CmpEqAVX2<T>(x, y), ones);
+    } else if constexpr (op == CompareOp::GT) {
+        return CmpGtAVX2<T>(x, y);
+    } else if constexpr (op == CompareOp::LE) {
+        return _mm256_xor_si256(CmpGtAVX2<T>(x, y), ones);
+    } else if constexpr (op == CompareOp::LT) {
+        return CmpGtAVX2<T>(y, x);
+    } else {
+        return _mm256_xor_si256(CmpGtAVX2<T>(y, x), ones);
+    }
+}
+
+// the predicate of _mm256_cmp_ps of op, ordered but NE, so the NaNs compare
+// like the scalar operators
+template <CompareOp op>
+constexpr int
+FloatPredicateAVX2() {
+    switch (op) {
+        case CompareOp::EQ:
+            return _CMP_EQ_OQ;
+        case CompareOp::NE:
+            return _CMP_NEQ_UQ;
+        case CompareOp::GT:
+            return _CMP_GT_OQ;
+        case CompareOp::GE:
+            return _CMP_GE_OQ;
+        case CompareOp::LT:
+            return _CMP_LT_OQ;
+        default:
+            return _CMP_LE_OQ;
+    }
+}
+
+// the vector j of the 32 values at src
+template <typename T>
+inline auto
+LoadAVX2(const T* src, int j) {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm256_loadu_ps(src + j * 8);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm256_loadu_pd(src + j * 4);
+    } else {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + j);
+    }
+}
+
+// the bits of the 32 values of T, lanes maps the index j to the lanes of the
+// vector j of the values, all ones if true
+template <typename T, typename Lanes>
+inline uint32_t
+LanesMaskAVX2(Lanes lanes) {
+    uint32_t mask = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        for (int j = 0; j < 4; ++j) {
+            mask |= uint32_t(_mm256_movemask_ps(lanes(j))) << (j * 8);
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        for (int j = 0; j < 8; ++j) {
+            mask |= uint32_t(_mm256_movemask_pd(lanes(j))) << (j * 4);
+        }
+    } else if constexpr (sizeof(T) == 1) {
+        mask = uint32_t(_mm256_movemask_epi8(lanes(0)));
+    } else if constexpr (sizeof(T) == 2) {
+        // packs interleaves the 128 bits lanes of the operands
+        __m256i packed = _mm256_permute4x64_epi64(
+            _mm256_packs_epi16(lanes(0), lanes(1)), 0xd8);
+        mask = uint32_t(_mm256_movemask_epi8(packed));
+    } else if constexpr (sizeof(T) == 4) {
+        for (int j = 0; j < 4; ++j) {
+            auto cmp = _mm256_castsi256_ps(lanes(j));
+            mask |= uint32_t(_mm256_movemask_ps(cmp)) << (j * 8);
+        }
+    } else {
+        for (int j = 0; j < 8; ++j) {
+            auto cmp = _mm256_castsi256_pd(lanes(j));
+            mask |= uint32_t(_mm256_movemask_pd(cmp)) << (j * 4);
+        }
+    }
+    return mask;
+}
+
+// the bits of pred of the 32 values at src, pred maps the vectors of the
+// values to their lanes, all ones if true
+template <typename T, typename Pred>
+inline uint32_t
+MaskAVX2(const T* src, Pred pred) {
+    return LanesMaskAVX2<T>([&](int j) { return pred(LoadAVX2(src, j)); });
+}
+
+// the lanes of x op y, all ones if true
+template <typename T, CompareOp op, typename V>
+inline V
+CompareVecAVX2(V x, V y) {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm256_cmp_ps(x, y, FloatPredicateAVX2<op>());
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm256_cmp_pd(x, y, FloatPredicateAVX2<op>());
+    } else {
+        return CompareIntAVX2<T, op>(x, y);
+    }
+}
+
+// the bits of src[i] op val of the 32 values at src
+template <typename T, CompareOp op>
+inline uint32_t
+CompareMaskAVX2(const T* src, T val) {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 v = _mm256_set1_ps(val);
+        return MaskAVX2(src, [&](__m256 x) {
+            return CompareVecAVX2<T, op>(x, v);
+        });
+    } else if constexpr (std::is_same_v<T, double>) {
+        const __m256d v = _mm256_set1_pd(val);
+        return MaskAVX2(src, [&](__m256d x) {
+            return CompareVecAVX2<T, op>(x, v);
+        });
+    } else {
+        const __m256i v = Set1AVX2(val);
+        return MaskAVX2(
+            src, [&](__m256i x) { return CompareVecAVX2<T, op>(x, v); });
+    }
+}
+
+// the bits of left[i] op right[i] of the 32 values at left and right
+template <typename T, CompareOp op>
+inline uint32_t
+CompareColumnMaskAVX2(const T* left, const T* right) {
+    return LanesMaskAVX2<T>([&](int j) {
+        return CompareVecAVX2<T, op>(LoadAVX2(left, j), LoadAVX2(right, j));
+    });
+}
+
+// the bits of x - lower <= span as unsigned of the 32 integers at src, AVX2
+// compares only the signed integers, the sign bits of both sides are so
+// flipped
+template <typename T>
+inline uint32_t
+RangeMaskAVX2(const T* src, T lower, T span) {
+    const __m256i ones = _mm256_set1_epi8(-1);
+    const __m256i sign =
+        Set1AVX2(static_cast<T>(std::numeric_limits<T>::min()));
+    const __m256i base = Set1AVX2(lower);
+    const __m256i limit = _mm256_xor_si256(Set1AVX2(span), sign);
+    return MaskAVX2(src, [&](__m256i x) {
+        __m256i diff;
+        if constexpr (sizeof(T) == 1) {
+            diff = _mm256_sub_epi8(x, base);
+        } else if constexpr (sizeof(T) == 2) {
+            diff = _mm256_sub_epi16(x, base);
+        } else if constexpr (sizeof(T) == 4) {
+            diff = _mm256_sub_epi32(x, base);
+        } else {
+            diff = _mm256_sub_epi64(x, base);
+        }
+        auto above = CmpGtAVX2<T>(_mm256_xor_si256(diff, sign), limit);
+        return _mm256_xor_si256(above, ones);
+    });
+}
+
+// the bits of lower op x op upper of the 32 floats at src, both compares are
+// evaluated in a pass
+template <typename T, CompareOp lower_op, CompareOp upper_op>
+inline uint32_t
+FloatRangeMaskAVX2(const T* src, T lower, T upper) {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 lo = _mm256_set1_ps(lower);
+        const __m256 hi = _mm256_set1_ps(upper);
+        return MaskAVX2(src, [&](__m256 x) {
+            return _mm256_and_ps(
+                _mm256_cmp_ps(x, lo, FloatPredicateAVX2<lower_op>()),
+                _mm256_cmp_ps(x, hi, FloatPredicateAVX2<upper_op>()));
+        });
+    } else {
+        const __m256d lo = _mm256_set1_pd(lower);
+        const __m256d hi = _mm256_set1_pd(upper);
+        return MaskAVX2(src, [&](__m256d x) {
+            return _mm256_and_pd(
+                _mm256_cmp_pd(x, lo, FloatPredicateAVX2<lower_op>()),
+                _mm256_cmp_pd(x, hi, FloatPredicateAVX2<upper_op>()));
+        });
+    }
+}
+
+}  // namespace
+
+template <typename T>
+void
+CompareValAVX2(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    size_t i = 0;
+    DispatchCompareOp(op, [&](auto op_constant) {
+        constexpr CompareOp cmp_op = decltype(op_constant)::value;
+        for (; i + 32 <= size; i += 32) {
+            StoreMaskAVX2(CompareMaskAVX2<T, cmp_op>(src + i, val), res + i);
+        }
+    });
+    CompareValLoop(src + i, size - i, val, op, res + i);
+}
+
+template <typename T>
+void
+CompareRangeAVX2(const T* src,
+                 size_t size,
+                 T lower,
+                 T upper,
+                 bool lower_inclusive,
+                 bool upper_inclusive,
+                 bool* res) {
+    size_t i = 0;
+    if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        if (!InclusiveRange(lower, upper, lower_inclusive, upper_inclusive)) {
+            std::memset(res, 0, size * sizeof(bool));
+            return;
+        }
+        auto span = static_cast<T>(static_cast<U>(upper) - U(lower));
+        for (; i + 32 <= size; i += 32) {
+            StoreMaskAVX2(RangeMaskAVX2(src + i, lower, span), res + i);
+        }
+        // the bounds are inclusive now
+        lower_inclusive = upper_inclusive = true;
+    } else {
+        auto range = [&](auto lower_op, auto upper_op) {
+            constexpr CompareOp lo_op = decltype(lower_op)::value;
+            constexpr CompareOp hi_op = decltype(upper_op)::value;
+            for (; i + 32 <= size; i += 32) {
+                StoreMaskAVX2(
+                    FloatRangeMaskAVX2<T, lo_op, hi_op>(src + i, lower, upper),
+                    res + i);
+            }
+        };
+        using GE = std::integral_constant<CompareOp, CompareOp::GE>;
+        using GT = std::integral_constant<CompareOp, CompareOp::GT>;
+        using LE = std::integral_constant<CompareOp, CompareOp::LE>;
+        using LT = std::integral_constant<CompareOp, CompareOp::LT>;
+        if (lower_inclusive && upper_inclusive) {
+            range(GE(), LE());
+        } else if (lower_inclusive) {
+            range(GE(), LT());
+        } else if (upper_inclusive) {
+            range(GT(), LE());
+        } else {
+            range(GT(), LT());
+        }
+    }
+    CompareRangeLoop(src + i,
+                     size - i,
+                     lower,
+                     upper,
+                     lower_inclusive,
+                     upper_inclusive,
+                     res + i);
+}
+
+template <typename T>
+void
+CompareColumnAVX2(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    size_t i = 0;
+    DispatchCompareOp(op, [&](auto op_constant) {
+        constexpr CompareOp cmp_op = decltype(op_constant)::value;
+        for (; i + 32 <= size; i += 32) {
+            StoreMaskAVX2(CompareColumnMaskAVX2<T, cmp_op>(left + i, right + i),
+                          res + i);
+        }
+    });
+    CompareColumnLoop(left + i, right + i, size - i, op, res + i);
+}
+
+INSTANTIATE_COMPARE_KERNELS(AVX2)
+
 }  // namespace simd
 }  // namespace milvus
 
@@ -10,7 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "avx512.h"
+#include "compare.h"
+#include "ref.h"
 #include <cassert>
+#include <cstring>
+#include <type_traits>
 
 #if defined(__x86_64__)
 #include <immintrin.h>
@@ -216,6 +220,496 @@ OrBoolAVX512(bool* left, bool* right, int64_t size) {
     }
 }
 
+void
+GreaterThanTimestampAVX512(const uint64_t* src,
+                           int64_t size,
+                           uint64_t val,
+                           BitsetBlockType* dst) {
+    constexpr int64_t block_bits = BITSET_BLOCK_SIZE * 8;
+    const __m512i target = _mm512_set1_epi64(val);
+    int64_t num_blocks = size / block_bits;
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        BitsetBlockType block = 0;
+        for (int64_t j = 0; j < block_bits; j += 8) {
+            __m512i data = _mm512_loadu_si512(
+                reinterpret_cast<const __m512i*>(src + i * block_bits + j));
+            __mmask8 mask = _mm512_cmpgt_epu64_mask(data, target);
+            block |= BitsetBlockType(mask) << j;
+        }
+        dst[i] = block;
+    }
+    GreaterThanTimestampRef(src + num_blocks * block_bits,
+                            size - num_blocks * block_bits,
+                            val,
+                            dst + num_blocks);
+}
+
+namespace {
+
+__m512
+LoadFloat16AVX512(const uint16_t* src) {
+    return _mm512_cvtph_ps(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+}
+
+}  // namespace
+
+float
+L2SqrFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= dim; i += 32) {
+        __m512 diff0 = _mm512_sub_ps(LoadFloat16AVX512(x + i),
+                                     LoadFloat16AVX512(y + i));
+        __m512 diff1 = _mm512_sub_ps(LoadFloat16AVX512(x + i + 16),
+                                     LoadFloat16AVX512(y + i + 16));
+        acc0 = _mm512_fmadd_ps(diff0, diff0, acc0);
+        acc1 = _mm512_fmadd_ps(diff1, diff1, acc1);
+    }
+    if (i + 16 <= dim) {
+        __m512 diff = _mm512_sub_ps(LoadFloat16AVX512(x + i),
+                                    LoadFloat16AVX512(y + i));
+        acc0 = _mm512_fmadd_ps(diff, diff, acc0);
+        i += 16;
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1)) +
+           L2SqrFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= dim; i += 32) {
+        acc0 = _mm512_fmadd_ps(
+            LoadFloat16AVX512(x + i), LoadFloat16AVX512(y + i), acc0);
+        acc1 = _mm512_fmadd_ps(LoadFloat16AVX512(x + i + 16),
+                               LoadFloat16AVX512(y + i + 16),
+                               acc1);
+    }
+    if (i + 16 <= dim) {
+        acc0 = _mm512_fmadd_ps(
+            LoadFloat16AVX512(x + i), LoadFloat16AVX512(y + i), acc0);
+        i += 16;
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1)) +
+           InnerProductFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloatAVX512(const float* x, const float* y, size_t dim) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= dim; i += 32) {
+        acc0 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+        acc1 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), acc1);
+    }
+    if (i + 16 <= dim) {
+        acc0 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+        i += 16;
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1)) +
+           InnerProductFloatRef(x + i, y + i, dim - i);
+}
+
+namespace {
+
+template <size_t Dim>
+float
+InnerProductFloatDimAVX512(const float* x, const float* y, size_t) {
+    static_assert(Dim % 64 == 0);
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+    for (size_t i = 0; i < Dim; i += 64) {
+        acc0 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+        acc1 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), acc1);
+        acc2 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i + 32), _mm512_loadu_ps(y + i + 32), acc2);
+        acc3 = _mm512_fmadd_ps(
+            _mm512_loadu_ps(x + i + 48), _mm512_loadu_ps(y + i + 48), acc3);
+    }
+    return _mm512_reduce_add_ps(
+        _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+}
+
+}  // namespace
+
+FloatDistancePtr
+InnerProductFloatOfDimAVX512(size_t dim) {
+    return KernelOfDim(dim, [](auto dim_constant) -> FloatDistancePtr {
+        return InnerProductFloatDimAVX512<decltype(dim_constant)::value>;
+    });
+}
+
+namespace {
+
+__m512i
+LoadBinaryAVX512(const uint8_t* src) {
+    return _mm512_loadu_si512(src);
+}
+
+// the first size bytes of src, size < 64, the rest are zeros
+__m512i
+LoadBinaryTailAVX512(const uint8_t* src, size_t size) {
+    return _mm512_maskz_loadu_epi8((__mmask64(1) << size) - 1, src);
+}
+
+// the kernels of Bytes bytes known at compile time, or of bytes for 0,
+// compiled for VPOPCNTDQ only here, the cpus without it never call them
+template <size_t Bytes>
+__attribute__((target("avx512vpopcntdq"))) float
+HammingBinaryBytesAVX512(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    // the tail is loaded by a mask as a last block of zero padding
+    for (; i < n; i += 64) {
+        __m512i vx = i + 64 <= n ? LoadBinaryAVX512(x + i)
+                                 : LoadBinaryTailAVX512(x + i, n - i);
+        __m512i vy = i + 64 <= n ? LoadBinaryAVX512(y + i)
+                                 : LoadBinaryTailAVX512(y + i, n - i);
+        acc = _mm512_add_epi64(acc,
+                               _mm512_popcnt_epi64(_mm512_xor_si512(vx, vy)));
+    }
+    return _mm512_reduce_add_epi64(acc);
+}
+
+template <size_t Bytes>
+__attribute__((target("avx512vpopcntdq"))) float
+JaccardBinaryBytesAVX512(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    __m512i and_acc = _mm512_setzero_si512();
+    __m512i or_acc = _mm512_setzero_si512();
+    size_t i = 0;
+    // the tail is loaded by a mask as a last block of zero padding
+    for (; i < n; i += 64) {
+        __m512i vx = i + 64 <= n ? LoadBinaryAVX512(x + i)
+                                 : LoadBinaryTailAVX512(x + i, n - i);
+        __m512i vy = i + 64 <= n ? LoadBinaryAVX512(y + i)
+                                 : LoadBinaryTailAVX512(y + i, n - i);
+        and_acc = _mm512_add_epi64(
+            and_acc, _mm512_popcnt_epi64(_mm512_and_si512(vx, vy)));
+        or_acc = _mm512_add_epi64(
+            or_acc, _mm512_popcnt_epi64(_mm512_or_si512(vx, vy)));
+    }
+    return JaccardDistance(_mm512_reduce_add_epi64(and_acc),
+                           _mm512_reduce_add_epi64(or_acc));
+}
+
+}  // namespace
+
+float
+HammingBinaryAVX512(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return HammingBinaryBytesAVX512<0>(x, y, bytes);
+}
+
+float
+JaccardBinaryAVX512(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return JaccardBinaryBytesAVX512<0>(x, y, bytes);
+}
+
+BinaryDistancePtr
+HammingBinaryOfDimAVX512(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return HammingBinaryBytesAVX512<decltype(dim_constant)::value / 8>;
+        });
+}
+
+BinaryDistancePtr
+JaccardBinaryOfDimAVX512(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return JaccardBinaryBytesAVX512<decltype(dim_constant)::value / 8>;
+        });
+}
+
+namespace {
+
+// the predicate of the integer compares of op
+template <CompareOp op>
+constexpr int
+IntPredicateAVX512() {
+    switch (op) {
+        case CompareOp::EQ:
+            return _MM_CMPINT_EQ;
+        case CompareOp::NE:
+            return _MM_CMPINT_NE;
+        case CompareOp::GT:
+            return _MM_CMPINT_NLE;
+        case CompareOp::GE:
+            return _MM_CMPINT_NLT;
+        case CompareOp::LT:
+            return _MM_CMPINT_LT;
+        default:
+            return _MM_CMPINT_LE;
+    }
+}
+
+// the predicate of the float compares of op, ordered but NE, so the NaNs
+// compare like the scalar operators
+template <CompareOp op>
+constexpr int
+FloatPredicateAVX512() {
+    switch (op) {
+        case CompareOp::EQ:
+            return _CMP_EQ_OQ;
+        case CompareOp::NE:
+            return _CMP_NEQ_UQ;
+        case CompareOp::GT:
+            return _CMP_GT_OQ;
+        case CompareOp::GE:
+            return _CMP_GE_OQ;
+        case CompareOp::LT:
+            return _CMP_LT_OQ;
+        default:
+            return _CMP_LE_OQ;
+    }
+}
+
+// the vector j of the 64 values at src
+template <typename T>
+inline auto
+LoadAVX512(const T* src, int j) {
+    constexpr int lanes = 64 / sizeof(T);
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm512_loadu_ps(src + j * lanes);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm512_loadu_pd(src + j * lanes);
+    } else {
+        return _mm512_loadu_si512(src + j * lanes);
+    }
+}
+
+// the bits of the 64 values of T, bits maps the index j to the mask of the
+// vector j of the values
+template <typename T, typename Bits>
+inline uint64_t
+LanesMaskAVX512(Bits bits) {
+    constexpr int lanes = 64 / sizeof(T);
+    uint64_t mask = 0;
+    for (int j = 0; j < int(sizeof(T)); ++j) {
+        mask |= uint64_t(bits(j)) << (j * lanes);
+    }
+    return mask;
+}
+
+// the bits of pred of the 64 values at src, pred maps the vectors of the
+// values to the masks of their lanes
+template <typename T, typename Pred>
+inline uint64_t
+MaskAVX512(const T* src, Pred pred) {
+    return LanesMaskAVX512<T>([&](int j) { return pred(LoadAVX512(src, j)); });
+}
+
+template <typename T>
+inline __m512i
+Set1AVX512(T val) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm512_set1_epi8(val);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm512_set1_epi16(val);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm512_set1_epi32(val);
+    } else {
+        return _mm512_set1_epi64(val);
+    }
+}
+
+// the mask of x op y
+template <typename T, CompareOp op, typename V>
+inline uint64_t
+CompareVecAVX512(V x, V y) {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm512_cmp_ps_mask(x, y, FloatPredicateAVX512<op>());
+    } else if constexpr (std::is_same_v<T, double>) {
+        return _mm512_cmp_pd_mask(x, y, FloatPredicateAVX512<op>());
+    } else {
+        constexpr auto pred = IntPredicateAVX512<op>();
+        if constexpr (sizeof(T) == 1) {
+            return _mm512_cmp_epi8_mask(x, y, pred);
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm512_cmp_epi16_mask(x, y, pred);
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm512_cmp_epi32_mask(x, y, pred);
+        } else {
+            return _mm512_cmp_epi64_mask(x, y, pred);
+        }
+    }
+}
+
+// the bits of src[i] op val of the 64 values at src
+template <typename T, CompareOp op>
+inline uint64_t
+CompareMaskAVX512(const T* src, T val) {
+    if constexpr (std::is_same_v<T, float>) {
+        const __m512 v = _mm512_set1_ps(val);
+        return MaskAVX512(
+            src, [&](__m512 x) { return CompareVecAVX512<T, op>(x, v); });
+    } else if constexpr (std::is_same_v<T, double>) {
+        const __m512d v = _mm512_set1_pd(val);
+        return MaskAVX512(
+            src, [&](__m512d x) { return CompareVecAVX512<T, op>(x, v); });
+    } else {
+        const __m512i v = Set1AVX512(val);
+        return MaskAVX512(
+            src, [&](__m512i x) { return CompareVecAVX512<T, op>(x, v); });
+    }
+}
+
+// the bits of left[i] op right[i] of the 64 values at left and right
+template <typename T, CompareOp op>
+inline uint64_t
+CompareColumnMaskAVX512(const T* left, const T* right) {
+    return LanesMaskAVX512<T>([&](int j) {
+        return CompareVecAVX512<T, op>(LoadAVX512(left, j),
+                                       LoadAVX512(right, j));
+    });
+}
+
+// the bits of x - lower <= span as unsigned of the 64 integers at src
+template <typename T>
+inline uint64_t
+RangeMaskAVX512(const T* src, T lower, T span) {
+    const __m512i base = Set1AVX512(lower);
+    const __m512i limit = Set1AVX512(span);
+    return MaskAVX512(src, [&](__m512i x) -> uint64_t {
+        if constexpr (sizeof(T) == 1) {
+            return _mm512_cmple_epu8_mask(_mm512_sub_epi8(x, base), limit);
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm512_cmple_epu16_mask(_mm512_sub_epi16(x, base), limit);
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm512_cmple_epu32_mask(_mm512_sub_epi32(x, base), limit);
+        } else {
+            return _mm512_cmple_epu64_mask(_mm512_sub_epi64(x, base), limit);
+        }
+    });
+}
+
+// the bits of lower op x op upper of the 64 floats at src, the upper bound is
+// compared only in the lanes above the lower one
+template <typename T, CompareOp lower_op, CompareOp upper_op>
+inline uint64_t
+FloatRangeMaskAVX512(const T* src, T lower, T upper) {
+    constexpr auto lo_pred = FloatPredicateAVX512<lower_op>();
+    constexpr auto hi_pred = FloatPredicateAVX512<upper_op>();
+    if constexpr (std::is_same_v<T, float>) {
+        const __m512 lo = _mm512_set1_ps(lower);
+        const __m512 hi = _mm512_set1_ps(upper);
+        return MaskAVX512(src, [&](__m512 x) {
+            return _mm512_mask_cmp_ps_mask(
+                _mm512_cmp_ps_mask(x, lo, lo_pred), x, hi, hi_pred);
+        });
+    } else {
+        const __m512d lo = _mm512_set1_pd(lower);
+        const __m512d hi = _mm512_set1_pd(upper);
+        return MaskAVX512(src, [&](__m512d x) {
+            return _mm512_mask_cmp_pd_mask(
+                _mm512_cmp_pd_mask(x, lo, lo_pred), x, hi, hi_pred);
+        });
+    }
+}
+
+}  // namespace
+
+template <typename T>
+void
+CompareValAVX512(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    size_t i = 0;
+    DispatchCompareOp(op, [&](auto op_constant) {
+        constexpr CompareOp cmp_op = decltype(op_constant)::value;
+        for (; i + 64 <= size; i += 64) {
+            auto mask = CompareMaskAVX512<T, cmp_op>(src + i, val);
+            _mm512_storeu_si512(res + i, _mm512_maskz_set1_epi8(mask, 1));
+        }
+    });
+    CompareValLoop(src + i, size - i, val, op, res + i);
+}
+
+template <typename T>
+void
+CompareRangeAVX512(const T* src,
+                   size_t size,
+                   T lower,
+                   T upper,
+                   bool lower_inclusive,
+                   bool upper_inclusive,
+                   bool* res) {
+    size_t i = 0;
+    auto store = [&](uint64_t mask) {
+        _mm512_storeu_si512(res + i, _mm512_maskz_set1_epi8(mask, 1));
+    };
+    if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        if (!InclusiveRange(lower, upper, lower_inclusive, upper_inclusive)) {
+            std::memset(res, 0, size * sizeof(bool));
+            return;
+        }
+        auto span = static_cast<T>(static_cast<U>(upper) - U(lower));
+        for (; i + 64 <= size; i += 64) {
+            store(RangeMaskAVX512(src + i, lower, span));
+        }
+        // the bounds are inclusive now
+        lower_inclusive = upper_inclusive = true;
+    } else {
+        auto range = [&](auto lower_op, auto upper_op) {
+            constexpr CompareOp lo_op = decltype(lower_op)::value;
+            constexpr CompareOp hi_op = decltype(upper_op)::value;
+            for (; i + 64 <= size; i += 64) {
+                store(FloatRangeMaskAVX512<T, lo_op, hi_op>(
+                    src + i, lower, upper));
+            }
+        };
+        using GE = std::integral_constant<CompareOp, CompareOp::GE>;
+        using GT = std::integral_constant<CompareOp, CompareOp::GT>;
+        using LE = std::integral_constant<CompareOp, CompareOp::LE>;
+        using LT = std::integral_constant<CompareOp, CompareOp::LT>;
+        if (lower_inclusive && upper_inclusive) {
+            range(GE(), LE());
+        } else if (lower_inclusive) {
+            range(GE(), LT());
+        } else if (upper_inclusive) {
+            range(GT(), LE());
+        } else {
+            range(GT(), LT());
+        }
+    }
+    CompareRangeLoop(src + i,
+                     size - i,
+                     lower,
+                     upper,
+                     lower_inclusive,
+                     upper_inclusive,
+                     res + i);
+}
+
+template <typename T>
+void
+CompareColumnAVX512(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    size_t i = 0;
+    DispatchCompareOp(op, [&](auto op_constant) {
+        constexpr CompareOp cmp_op = decltype(op_constant)::value;
+        for (; i + 64 <= size; i += 64) {
+            auto mask = CompareColumnMaskAVX512<T, cmp_op>(left + i, right + i);
+            _mm512_storeu_si512(res + i, _mm512_maskz_set1_epi8(mask, 1));
+        }
+    });
+    CompareColumnLoop(left + i, right + i, size - i, op, res + i);
+}
+
+INSTANTIATE_COMPARE_KERNELS(AVX512)
+
 }  // namespace simd
 }  // namespace milvus
 #endif
@@ -61,5 +61,66 @@ AndBoolAVX512(bool* left, bool* right, int64_t size);
 void
 OrBoolAVX512(bool* left, bool* right, int64_t size);
 
+// set the bit i of dst if src[i] > val, dst holds (size + 63) / 64 blocks and
+// the bits beyond size are cleared
+void
+GreaterThanTimestampAVX512(const uint64_t* src,
+                           int64_t size,
+                           uint64_t val,
+                           BitsetBlockType* dst);
+
+// the squared L2 distance of two float16 vectors, converted and accumulated
+// as float
+float
+L2SqrFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+InnerProductFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim);
+
+// the inner product of two float vectors
+float
+InnerProductFloatAVX512(const float* x, const float* y, size_t dim);
+
+// the inner product kernel unrolled for the dim of SPECIALIZED_DIMS, nullptr
+// for the other dims
+FloatDistancePtr
+InnerProductFloatOfDimAVX512(size_t dim);
+
+// the hamming and the jaccard distances of two binary vectors, popcounted by
+// AVX512 VPOPCNTDQ, which the cpu must support besides the AVX512 ones
+float
+HammingBinaryAVX512(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+float
+JaccardBinaryAVX512(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+// the binary kernels unrolled for the dim in bits of SPECIALIZED_BINARY_DIMS,
+// nullptr for the other dims
+BinaryDistancePtr
+HammingBinaryOfDimAVX512(size_t dim);
+
+BinaryDistancePtr
+JaccardBinaryOfDimAVX512(size_t dim);
+
+template <typename T>
+void
+CompareValAVX512(const T* src, size_t size, T val, CompareOp op, bool* res);
+
+template <typename T>
+void
+CompareRangeAVX512(const T* src,
+                   size_t size,
+                   T lower,
+                   T upper,
+                   bool lower_inclusive,
+                   bool upper_inclusive,
+                   bool* res);
+
+// res[i] = left[i] op right[i]
+template <typename T>
+void
+CompareColumnAVX512(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res);
+
 }  // namespace simd
 }  // namespace milvus
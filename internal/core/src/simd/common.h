@@ -11,9 +11,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
 
 namespace milvus {
 namespace simd {
@@ -31,6 +33,52 @@ constexpr size_t BITSET_BLOCK_SIZE = sizeof(unsigned long);
 */
 const int TERM_EXPR_IN_SIZE_THREAD = 50;
 
+// the ops of the compare kernels, the column value is the left operand
+enum class CompareOp { EQ, NE, GT, GE, LT, LE };
+
+// the distances of two float vectors of dim elements
+using FloatDistancePtr = float (*)(const float* x, const float* y, size_t dim);
+
+// the common embedding sizes, which the distance kernels are specialized for
+// with the loops of a known trip count and no tail
+constexpr std::array<size_t, 7> SPECIALIZED_DIMS = {
+    128, 256, 384, 512, 768, 1024, 1536};
+
+// the distances of two binary vectors of bytes bytes
+using BinaryDistancePtr = float (*)(const uint8_t* x,
+                                    const uint8_t* y,
+                                    size_t bytes);
+
+// the common dims in bits of the binary hashes, which the binary distance
+// kernels are specialized for
+constexpr std::array<size_t, 3> SPECIALIZED_BINARY_DIMS = {256, 512, 1024};
+
+// the jaccard distance of the popcounts of the and and the or of two binary
+// vectors, 0 for two empty ones
+inline float
+JaccardDistance(uint64_t and_count, uint64_t or_count) {
+    return or_count == 0 ? 0 : 1 - float(and_count) / float(or_count);
+}
+
+template <const auto& Dims, typename Func, size_t... I>
+auto
+KernelOfDimImpl(size_t dim, Func func, std::index_sequence<I...>) {
+    decltype(func(std::integral_constant<size_t, Dims[0]>())) kernel = nullptr;
+    ((dim == Dims[I] ? kernel = func(std::integral_constant<size_t, Dims[I]>())
+                     : kernel),
+     ...);
+    return kernel;
+}
+
+// the kernel func(std::integral_constant<size_t, Dim>) returns for the
+// specialized dim of Dims equal to dim, nullptr if dim isn't specialized
+template <const auto& Dims = SPECIALIZED_DIMS, typename Func>
+auto
+KernelOfDim(size_t dim, Func func) {
+    return KernelOfDimImpl<Dims>(
+        dim, func, std::make_index_sequence<Dims.size()>());
+}
+
 #define CHECK_SUPPORTED_TYPE(T, Message)                                     \
     static_assert(                                                           \
         std::is_same<T, bool>::value || std::is_same<T, int8_t>::value ||    \
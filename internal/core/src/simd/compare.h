@@ -0,0 +1,223 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "common.h"
+
+namespace milvus {
+namespace simd {
+
+// The compare loops are branch free, so they are vectorized by the compiler
+// with the instruction set every source including them is compiled for. They
+// live in an unnamed namespace, the instantiations of the sources for the
+// different instruction sets are so never merged by the linker, for the same
+// reason they call no inline templates of the standard library.
+namespace {
+
+template <typename T, typename Cmp>
+inline void
+CompareLoop(const T* src, size_t size, bool* res, Cmp cmp) {
+    for (size_t i = 0; i < size; ++i) {
+        res[i] = cmp(src[i]);
+    }
+}
+
+template <typename T>
+void
+CompareValLoop(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    switch (op) {
+        case CompareOp::EQ:
+            CompareLoop(src, size, res, [val](T x) { return x == val; });
+            break;
+        case CompareOp::NE:
+            CompareLoop(src, size, res, [val](T x) { return x != val; });
+            break;
+        case CompareOp::GT:
+            CompareLoop(src, size, res, [val](T x) { return x > val; });
+            break;
+        case CompareOp::GE:
+            CompareLoop(src, size, res, [val](T x) { return x >= val; });
+            break;
+        case CompareOp::LT:
+            CompareLoop(src, size, res, [val](T x) { return x < val; });
+            break;
+        case CompareOp::LE:
+            CompareLoop(src, size, res, [val](T x) { return x <= val; });
+            break;
+    }
+}
+
+template <typename T>
+void
+CompareColumnLoop(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    switch (op) {
+        case CompareOp::EQ:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] == right[i];
+            }
+            break;
+        case CompareOp::NE:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] != right[i];
+            }
+            break;
+        case CompareOp::GT:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] > right[i];
+            }
+            break;
+        case CompareOp::GE:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] >= right[i];
+            }
+            break;
+        case CompareOp::LT:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] < right[i];
+            }
+            break;
+        case CompareOp::LE:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = left[i] <= right[i];
+            }
+            break;
+    }
+}
+
+// call func with op as a std::integral_constant, so the kernels can take the
+// op as a template argument
+template <typename Func>
+inline void
+DispatchCompareOp(CompareOp op, Func&& func) {
+    using std::integral_constant;
+    switch (op) {
+        case CompareOp::EQ:
+            func(integral_constant<CompareOp, CompareOp::EQ>());
+            break;
+        case CompareOp::NE:
+            func(integral_constant<CompareOp, CompareOp::NE>());
+            break;
+        case CompareOp::GT:
+            func(integral_constant<CompareOp, CompareOp::GT>());
+            break;
+        case CompareOp::GE:
+            func(integral_constant<CompareOp, CompareOp::GE>());
+            break;
+        case CompareOp::LT:
+            func(integral_constant<CompareOp, CompareOp::LT>());
+            break;
+        case CompareOp::LE:
+            func(integral_constant<CompareOp, CompareOp::LE>());
+            break;
+    }
+}
+
+// narrow the bounds of the integers to inclusive ones, false if no value is
+// in the range
+template <typename T>
+inline bool
+InclusiveRange(T& lower, T& upper, bool lower_inclusive, bool upper_inclusive) {
+    if (!lower_inclusive) {
+        if (lower == std::numeric_limits<T>::max()) {
+            return false;
+        }
+        ++lower;
+    }
+    if (!upper_inclusive) {
+        if (upper == std::numeric_limits<T>::min()) {
+            return false;
+        }
+        --upper;
+    }
+    return lower <= upper;
+}
+
+// the integers within [lower, upper] are the ones with x - lower no more than
+// upper - lower as unsigned, so the range takes a single compare
+template <typename T>
+void
+CompareRangeLoop(const T* src,
+                 size_t size,
+                 T lower,
+                 T upper,
+                 bool lower_inclusive,
+                 bool upper_inclusive,
+                 bool* res) {
+    if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        if (!InclusiveRange(lower, upper, lower_inclusive, upper_inclusive)) {
+            std::memset(res, 0, size * sizeof(bool));
+            return;
+        }
+        auto base = static_cast<U>(lower);
+        auto span = static_cast<U>(static_cast<U>(upper) - base);
+        CompareLoop(src, size, res, [=](T x) {
+            return static_cast<U>(static_cast<U>(x) - base) <= span;
+        });
+    } else {
+        // both bounds are evaluated without short circuit, a branch in the
+        // loop body keeps the compiler from vectorizing the floats
+        if (lower_inclusive && upper_inclusive) {
+            CompareLoop(src, size, res, [=](T x) {
+                return (lower <= x) & (x <= upper);
+            });
+        } else if (lower_inclusive) {
+            CompareLoop(src, size, res, [=](T x) {
+                return (lower <= x) & (x < upper);
+            });
+        } else if (upper_inclusive) {
+            CompareLoop(src, size, res, [=](T x) {
+                return (lower < x) & (x <= upper);
+            });
+        } else {
+            CompareLoop(src, size, res, [=](T x) {
+                return (lower < x) & (x < upper);
+            });
+        }
+    }
+}
+
+}  // namespace
+
+// instantiate the compare kernels of the suffix for all the numeric types
+#define INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, T)                       \
+    template void CompareVal##SUFFIX<T>(                                \
+        const T* src, size_t size, T val, CompareOp op, bool* res);     \
+    template void CompareRange##SUFFIX<T>(const T* src,                 \
+                                          size_t size,                  \
+                                          T lower,                      \
+                                          T upper,                      \
+                                          bool lower_inclusive,         \
+                                          bool upper_inclusive,         \
+                                          bool* res);                   \
+    template void CompareColumn##SUFFIX<T>(const T* left,               \
+                                           const T* right,              \
+                                           size_t size,                 \
+                                           CompareOp op,                \
+                                           bool* res);
+
+#define INSTANTIATE_COMPARE_KERNELS(SUFFIX)             \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, int8_t)      \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, int16_t)     \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, int32_t)     \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, int64_t)     \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, float)       \
+    INSTANTIATE_COMPARE_KERNELS_OF(SUFFIX, double)
+
+}  // namespace simd
+}  // namespace milvus
@@ -26,7 +26,10 @@
 #include "sse4.h"
 #include "instruction_set.h"
 #elif defined(__ARM_NEON)
+#include <sys/auxv.h>
+
 #include "neon.h"
+#include "sve.h"
 #endif
 
 namespace milvus {
@@ -51,6 +54,8 @@ decltype(all_true) all_true = AllTrueRef;
 decltype(invert_bool) invert_bool = InvertBoolRef;
 decltype(and_bool) and_bool = AndBoolRef;
 decltype(or_bool) or_bool = OrBoolRef;
+decltype(greater_than_timestamp) greater_than_timestamp =
+    GreaterThanTimestampRef;
 
 FindTermPtr<bool> find_term_bool = FindTermRef<bool>;
 FindTermPtr<int8_t> find_term_int8 = FindTermRef<int8_t>;
@@ -60,6 +65,68 @@ FindTermPtr<int64_t> find_term_int64 = FindTermRef<int64_t>;
 FindTermPtr<float> find_term_float = FindTermRef<float>;
 FindTermPtr<double> find_term_double = FindTermRef<double>;
 
+CompareValPtr<int8_t> compare_val_int8 = CompareValRef<int8_t>;
+CompareValPtr<int16_t> compare_val_int16 = CompareValRef<int16_t>;
+CompareValPtr<int32_t> compare_val_int32 = CompareValRef<int32_t>;
+CompareValPtr<int64_t> compare_val_int64 = CompareValRef<int64_t>;
+CompareValPtr<float> compare_val_float = CompareValRef<float>;
+CompareValPtr<double> compare_val_double = CompareValRef<double>;
+
+CompareRangePtr<int8_t> compare_range_int8 = CompareRangeRef<int8_t>;
+CompareRangePtr<int16_t> compare_range_int16 = CompareRangeRef<int16_t>;
+CompareRangePtr<int32_t> compare_range_int32 = CompareRangeRef<int32_t>;
+CompareRangePtr<int64_t> compare_range_int64 = CompareRangeRef<int64_t>;
+CompareRangePtr<float> compare_range_float = CompareRangeRef<float>;
+CompareRangePtr<double> compare_range_double = CompareRangeRef<double>;
+
+CompareColumnPtr<int8_t> compare_column_int8 = CompareColumnRef<int8_t>;
+CompareColumnPtr<int16_t> compare_column_int16 = CompareColumnRef<int16_t>;
+CompareColumnPtr<int32_t> compare_column_int32 = CompareColumnRef<int32_t>;
+CompareColumnPtr<int64_t> compare_column_int64 = CompareColumnRef<int64_t>;
+CompareColumnPtr<float> compare_column_float = CompareColumnRef<float>;
+CompareColumnPtr<double> compare_column_double = CompareColumnRef<double>;
+
+Float16DistancePtr l2_sqr_float16 = L2SqrFloat16Ref;
+Float16DistancePtr inner_product_float16 = InnerProductFloat16Ref;
+
+FloatDistancePtr inner_product_float = InnerProductFloatRef;
+
+// the kernels of SPECIALIZED_DIMS, nullptr for the generic one
+std::array<FloatDistancePtr, SPECIALIZED_DIMS.size()>
+    inner_product_float_dims{};
+
+BinaryDistancePtr hamming_binary = HammingBinaryRef;
+BinaryDistancePtr jaccard_binary = JaccardBinaryRef;
+
+// the binary kernels of SPECIALIZED_BINARY_DIMS, nullptr for the generic ones
+std::array<BinaryDistancePtr, SPECIALIZED_BINARY_DIMS.size()>
+    hamming_binary_dims{};
+std::array<BinaryDistancePtr, SPECIALIZED_BINARY_DIMS.size()>
+    jaccard_binary_dims{};
+
+Crc32cPtr crc32c = Crc32cRef;
+
+#if defined(__ARM_NEON)
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+
+bool use_sve = true;
+
+bool
+cpu_support_sve() {
+    return (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+}
+
+bool
+cpu_support_crc32() {
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+#endif
+
 #if defined(__x86_64__)
 bool
 cpu_support_avx512() {
@@ -85,6 +152,18 @@ cpu_support_sse2() {
     InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
     return (instruction_set_inst.SSE2());
 }
+
+bool
+cpu_support_f16c() {
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.F16C() && instruction_set_inst.FMA());
+}
+
+bool
+cpu_support_avx512_vpopcntdq() {
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return cpu_support_avx512() && instruction_set_inst.AVX512VPOPCNTDQ();
+}
 #endif
 
 void
@@ -112,8 +191,12 @@ bitset_hook() {
         get_bitset_block = GetBitsetBlockSSE2;
         use_bitset_sse2 = true;
     }
+#elif defined(__ARM_NEON)
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        get_bitset_block = GetBitsetBlockSVE;
+    }
 #endif
-    // TODO: support arm cpu
     LOG_SEGCORE_INFO_ << "bitset hook simd type: " << simd_type;
 }
 
@@ -164,8 +247,18 @@ find_term_hook() {
         find_term_double = FindTermSSE2<double>;
         use_find_term_sse2 = true;
     }
+#elif defined(__ARM_NEON)
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        find_term_bool = FindTermSVE<bool>;
+        find_term_int8 = FindTermSVE<int8_t>;
+        find_term_int16 = FindTermSVE<int16_t>;
+        find_term_int32 = FindTermSVE<int32_t>;
+        find_term_int64 = FindTermSVE<int64_t>;
+        find_term_float = FindTermSVE<float>;
+        find_term_double = FindTermSVE<double>;
+    }
 #endif
-    // TODO: support arm cpu
     LOG_SEGCORE_INFO_ << "find term hook simd type: " << simd_type;
 }
 
@@ -181,11 +274,16 @@ all_boolean_hook() {
         all_true = AllTrueSSE2;
     }
 #elif defined(__ARM_NEON)
-    simd_type = "NEON";
-    all_false = AllFalseNEON;
-    all_true = AllTrueNEON;
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        all_false = AllFalseSVE;
+        all_true = AllTrueSVE;
+    } else {
+        simd_type = "NEON";
+        all_false = AllFalseNEON;
+        all_true = AllTrueNEON;
+    }
 #endif
-    // TODO: support arm cpu
     LOG_SEGCORE_INFO_ << "AllFalse/AllTrue hook simd type: " << simd_type;
 }
 
@@ -200,10 +298,14 @@ invert_boolean_hook() {
         invert_bool = InvertBoolSSE2;
     }
 #elif defined(__ARM_NEON)
-    simd_type = "NEON";
-    invert_bool = InvertBoolNEON;
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        invert_bool = InvertBoolSVE;
+    } else {
+        simd_type = "NEON";
+        invert_bool = InvertBoolNEON;
+    }
 #endif
-    // TODO: support arm cpu
     LOG_SEGCORE_INFO_ << "InvertBoolean hook simd type: " << simd_type;
 }
 
@@ -227,13 +329,204 @@ logical_boolean_hook() {
         or_bool = OrBoolSSE2;
     }
 #elif defined(__ARM_NEON)
-    simd_type = "NEON";
-    and_bool = AndBoolNEON;
-    or_bool = OrBoolNEON;
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        and_bool = AndBoolSVE;
+        or_bool = OrBoolSVE;
+    } else {
+        simd_type = "NEON";
+        and_bool = AndBoolNEON;
+        or_bool = OrBoolNEON;
+    }
 #endif
-    // TODO: support arm cpu
     LOG_SEGCORE_INFO_ << "InvertBoolean hook simd type: " << simd_type;
 }
+
+void
+timestamp_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+#if defined(__x86_64__)
+    if (use_avx512 && cpu_support_avx512()) {
+        simd_type = "AVX512";
+        greater_than_timestamp = GreaterThanTimestampAVX512;
+    } else if (use_avx2 && cpu_support_avx2()) {
+        simd_type = "AVX2";
+        greater_than_timestamp = GreaterThanTimestampAVX2;
+    }
+#elif defined(__ARM_NEON)
+    simd_type = "NEON";
+    greater_than_timestamp = GreaterThanTimestampNEON;
+#endif
+    LOG_SEGCORE_INFO_ << "GreaterThanTimestamp hook simd type: " << simd_type;
+}
+
+// set the compare kernels of the suffix
+#define SET_COMPARE_KERNELS(SUFFIX)                        \
+    compare_val_int8 = CompareVal##SUFFIX<int8_t>;         \
+    compare_val_int16 = CompareVal##SUFFIX<int16_t>;       \
+    compare_val_int32 = CompareVal##SUFFIX<int32_t>;       \
+    compare_val_int64 = CompareVal##SUFFIX<int64_t>;       \
+    compare_val_float = CompareVal##SUFFIX<float>;         \
+    compare_val_double = CompareVal##SUFFIX<double>;       \
+    compare_range_int8 = CompareRange##SUFFIX<int8_t>;     \
+    compare_range_int16 = CompareRange##SUFFIX<int16_t>;   \
+    compare_range_int32 = CompareRange##SUFFIX<int32_t>;   \
+    compare_range_int64 = CompareRange##SUFFIX<int64_t>;   \
+    compare_range_float = CompareRange##SUFFIX<float>;     \
+    compare_range_double = CompareRange##SUFFIX<double>;   \
+    compare_column_int8 = CompareColumn##SUFFIX<int8_t>;   \
+    compare_column_int16 = CompareColumn##SUFFIX<int16_t>; \
+    compare_column_int32 = CompareColumn##SUFFIX<int32_t>; \
+    compare_column_int64 = CompareColumn##SUFFIX<int64_t>; \
+    compare_column_float = CompareColumn##SUFFIX<float>;   \
+    compare_column_double = CompareColumn##SUFFIX<double>
+
+void
+compare_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+#if defined(__x86_64__)
+    if (use_avx512 && cpu_support_avx512()) {
+        simd_type = "AVX512";
+        SET_COMPARE_KERNELS(AVX512);
+    } else if (use_avx2 && cpu_support_avx2()) {
+        simd_type = "AVX2";
+        SET_COMPARE_KERNELS(AVX2);
+    }
+#elif defined(__ARM_NEON)
+    if (use_sve && cpu_support_sve()) {
+        simd_type = "SVE";
+        SET_COMPARE_KERNELS(SVE);
+    } else {
+        simd_type = "NEON";
+        SET_COMPARE_KERNELS(NEON);
+    }
+#endif
+    LOG_SEGCORE_INFO_ << "Compare hook simd type: " << simd_type;
+}
+
+void
+vector_distance_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+    FloatDistancePtr (*kernel_of_dim)(size_t dim) = nullptr;
+#if defined(__x86_64__)
+    if (use_avx512 && cpu_support_avx512()) {
+        simd_type = "AVX512";
+        l2_sqr_float16 = L2SqrFloat16AVX512;
+        inner_product_float16 = InnerProductFloat16AVX512;
+        inner_product_float = InnerProductFloatAVX512;
+        kernel_of_dim = InnerProductFloatOfDimAVX512;
+    } else if (use_avx2 && cpu_support_avx2() && cpu_support_f16c()) {
+        simd_type = "AVX2";
+        l2_sqr_float16 = L2SqrFloat16AVX2;
+        inner_product_float16 = InnerProductFloat16AVX2;
+        inner_product_float = InnerProductFloatAVX2;
+        kernel_of_dim = InnerProductFloatOfDimAVX2;
+    }
+#elif defined(__ARM_NEON)
+    simd_type = "NEON";
+    l2_sqr_float16 = L2SqrFloat16NEON;
+    inner_product_float16 = InnerProductFloat16NEON;
+    inner_product_float = InnerProductFloatNEON;
+    kernel_of_dim = InnerProductFloatOfDimNEON;
+#endif
+    for (size_t i = 0; i < SPECIALIZED_DIMS.size(); ++i) {
+        inner_product_float_dims[i] =
+            kernel_of_dim ? kernel_of_dim(SPECIALIZED_DIMS[i]) : nullptr;
+    }
+    LOG_SEGCORE_INFO_ << "Vector distance hook simd type: " << simd_type;
+}
+
+FloatDistancePtr
+inner_product_float_of(size_t dim) {
+    for (size_t i = 0; i < SPECIALIZED_DIMS.size(); ++i) {
+        if (SPECIALIZED_DIMS[i] == dim && inner_product_float_dims[i]) {
+            return inner_product_float_dims[i];
+        }
+    }
+    return inner_product_float;
+}
+
+void
+binary_distance_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+    BinaryDistancePtr (*hamming_of_dim)(size_t dim) = nullptr;
+    BinaryDistancePtr (*jaccard_of_dim)(size_t dim) = nullptr;
+#if defined(__x86_64__)
+    if (use_avx512 && cpu_support_avx512_vpopcntdq()) {
+        simd_type = "AVX512";
+        hamming_binary = HammingBinaryAVX512;
+        jaccard_binary = JaccardBinaryAVX512;
+        hamming_of_dim = HammingBinaryOfDimAVX512;
+        jaccard_of_dim = JaccardBinaryOfDimAVX512;
+    } else if (use_avx2 && cpu_support_avx2()) {
+        simd_type = "AVX2";
+        hamming_binary = HammingBinaryAVX2;
+        jaccard_binary = JaccardBinaryAVX2;
+        hamming_of_dim = HammingBinaryOfDimAVX2;
+        jaccard_of_dim = JaccardBinaryOfDimAVX2;
+    }
+#elif defined(__ARM_NEON)
+    simd_type = "NEON";
+    hamming_binary = HammingBinaryNEON;
+    jaccard_binary = JaccardBinaryNEON;
+    hamming_of_dim = HammingBinaryOfDimNEON;
+    jaccard_of_dim = JaccardBinaryOfDimNEON;
+#endif
+    for (size_t i = 0; i < SPECIALIZED_BINARY_DIMS.size(); ++i) {
+        auto dim = SPECIALIZED_BINARY_DIMS[i];
+        hamming_binary_dims[i] = hamming_of_dim ? hamming_of_dim(dim) : nullptr;
+        jaccard_binary_dims[i] = jaccard_of_dim ? jaccard_of_dim(dim) : nullptr;
+    }
+    LOG_SEGCORE_INFO_ << "Binary distance hook simd type: " << simd_type;
+}
+
+BinaryDistancePtr
+hamming_binary_of(size_t dim) {
+    for (size_t i = 0; i < SPECIALIZED_BINARY_DIMS.size(); ++i) {
+        if (SPECIALIZED_BINARY_DIMS[i] == dim && hamming_binary_dims[i]) {
+            return hamming_binary_dims[i];
+        }
+    }
+    return hamming_binary;
+}
+
+BinaryDistancePtr
+jaccard_binary_of(size_t dim) {
+    for (size_t i = 0; i < SPECIALIZED_BINARY_DIMS.size(); ++i) {
+        if (SPECIALIZED_BINARY_DIMS[i] == dim && jaccard_binary_dims[i]) {
+            return jaccard_binary_dims[i];
+        }
+    }
+    return jaccard_binary;
+}
+
+void
+crc32c_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+#if defined(__x86_64__)
+    if (use_sse4_2 && cpu_support_sse4_2()) {
+        simd_type = "SSE4";
+        crc32c = Crc32cSSE4;
+    }
+#elif defined(__ARM_NEON)
+    if (cpu_support_crc32()) {
+        simd_type = "NEON";
+        crc32c = Crc32cNEON;
+    }
+#endif
+    LOG_SEGCORE_INFO_ << "Crc32c hook simd type: " << simd_type;
+}
+
 void
 boolean_hook() {
     all_boolean_hook();
@@ -245,6 +538,11 @@ static int init_hook_ = []() {
     bitset_hook();
     find_term_hook();
     boolean_hook();
+    timestamp_hook();
+    compare_hook();
+    vector_distance_hook();
+    binary_distance_hook();
+    crc32c_hook();
     return 0;
 }();
 
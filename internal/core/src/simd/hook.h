@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <string>
 #include <string_view>
 
@@ -24,6 +25,10 @@ extern bool (*all_true)(const bool* src, int64_t size);
 extern void (*invert_bool)(bool* src, int64_t size);
 extern void (*and_bool)(bool* left, bool* right, int64_t size);
 extern void (*or_bool)(bool* left, bool* right, int64_t size);
+extern void (*greater_than_timestamp)(const uint64_t* src,
+                                      int64_t size,
+                                      uint64_t val,
+                                      BitsetBlockType* dst);
 
 template <typename T>
 using FindTermPtr = bool (*)(const T* src, size_t size, T val);
@@ -36,6 +41,102 @@ extern FindTermPtr<int64_t> find_term_int64;
 extern FindTermPtr<float> find_term_float;
 extern FindTermPtr<double> find_term_double;
 
+// the types of the compare kernels
+template <typename T>
+constexpr bool has_compare_kernel =
+    std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> ||
+    std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// res[i] = src[i] op val
+template <typename T>
+using CompareValPtr =
+    void (*)(const T* src, size_t size, T val, CompareOp op, bool* res);
+
+extern CompareValPtr<int8_t> compare_val_int8;
+extern CompareValPtr<int16_t> compare_val_int16;
+extern CompareValPtr<int32_t> compare_val_int32;
+extern CompareValPtr<int64_t> compare_val_int64;
+extern CompareValPtr<float> compare_val_float;
+extern CompareValPtr<double> compare_val_double;
+
+// res[i] = lower < src[i] < upper, the bounds are inclusive if
+// lower_inclusive and upper_inclusive
+template <typename T>
+using CompareRangePtr = void (*)(const T* src,
+                                 size_t size,
+                                 T lower,
+                                 T upper,
+                                 bool lower_inclusive,
+                                 bool upper_inclusive,
+                                 bool* res);
+
+extern CompareRangePtr<int8_t> compare_range_int8;
+extern CompareRangePtr<int16_t> compare_range_int16;
+extern CompareRangePtr<int32_t> compare_range_int32;
+extern CompareRangePtr<int64_t> compare_range_int64;
+extern CompareRangePtr<float> compare_range_float;
+extern CompareRangePtr<double> compare_range_double;
+
+// res[i] = left[i] op right[i]
+template <typename T>
+using CompareColumnPtr = void (*)(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res);
+
+extern CompareColumnPtr<int8_t> compare_column_int8;
+extern CompareColumnPtr<int16_t> compare_column_int16;
+extern CompareColumnPtr<int32_t> compare_column_int32;
+extern CompareColumnPtr<int64_t> compare_column_int64;
+extern CompareColumnPtr<float> compare_column_float;
+extern CompareColumnPtr<double> compare_column_double;
+
+// the distances of two float16 vectors of dim elements, the elements are the
+// IEEE 754 half precision bits
+using Float16DistancePtr = float (*)(const uint16_t* x,
+                                     const uint16_t* y,
+                                     size_t dim);
+
+extern Float16DistancePtr l2_sqr_float16;
+extern Float16DistancePtr inner_product_float16;
+
+extern FloatDistancePtr inner_product_float;
+
+// the inner product kernel of the vectors of dim elements, the one
+// specialized for the dim if it's one of SPECIALIZED_DIMS, resolve it once
+// per search by the dim of the field
+FloatDistancePtr
+inner_product_float_of(size_t dim);
+
+// the inverse L2 norms of the rows of dim elements of data, 0 for the zero
+// rows, the cosine of two rows is their inner product scaled by both
+inline void
+inv_norms_float(const float* data, size_t rows, size_t dim, float* inv_norms) {
+    auto inner_product = inner_product_float_of(dim);
+    for (size_t i = 0; i < rows; ++i) {
+        auto row = data + i * dim;
+        auto norm = std::sqrt(inner_product(row, row, dim));
+        inv_norms[i] = norm > 0 ? 1 / norm : 0;
+    }
+}
+
+extern BinaryDistancePtr hamming_binary;
+extern BinaryDistancePtr jaccard_binary;
+
+// the binary kernels of the vectors of dim bits, the ones specialized for
+// the dim if it's one of SPECIALIZED_BINARY_DIMS
+BinaryDistancePtr
+hamming_binary_of(size_t dim);
+
+BinaryDistancePtr
+jaccard_binary_of(size_t dim);
+
+// the CRC32C (Castagnoli) of the size bytes of data, continued from crc, the
+// checksum of the bytes before them. The checksum of a buffer starts from 0,
+// as zlib's crc32
+using Crc32cPtr = uint32_t (*)(uint32_t crc, const void* data, size_t size);
+
+extern Crc32cPtr crc32c;
+
 #if defined(__x86_64__)
 // Flags that indicate whether runtime can choose
 // these simd type or not when hook starts.
@@ -53,6 +154,16 @@ extern bool use_find_term_avx2;
 extern bool use_find_term_avx512;
 #endif
 
+#if defined(__ARM_NEON)
+// whether runtime can choose sve when hook starts
+extern bool use_sve;
+
+bool
+cpu_support_sve();
+bool
+cpu_support_crc32();
+#endif
+
 #if defined(__x86_64__)
 bool
 cpu_support_avx512();
@@ -60,6 +171,10 @@ bool
 cpu_support_avx2();
 bool
 cpu_support_sse4_2();
+bool
+cpu_support_f16c();
+bool
+cpu_support_avx512_vpopcntdq();
 #endif
 
 void
@@ -80,6 +195,21 @@ invert_boolean_hook();
 void
 logical_boolean_hook();
 
+void
+timestamp_hook();
+
+void
+compare_hook();
+
+void
+vector_distance_hook();
+
+void
+binary_distance_hook();
+
+void
+crc32c_hook();
+
 template <typename T>
 bool
 find_term_func(const T* data, size_t size, T val) {
@@ -110,5 +240,66 @@ find_term_func(const T* data, size_t size, T val) {
     }
 }
 
+// the compare kernels of T, which has_compare_kernel
+template <typename T>
+CompareValPtr<T>
+compare_val_func() {
+    if constexpr (std::is_same_v<T, int8_t>) {
+        return compare_val_int8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return compare_val_int16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return compare_val_int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return compare_val_int64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return compare_val_float;
+    } else {
+        static_assert(std::is_same_v<T, double>,
+                      "T must be int8_t to int64_t, float or double");
+        return compare_val_double;
+    }
+}
+
+template <typename T>
+CompareRangePtr<T>
+compare_range_func() {
+    if constexpr (std::is_same_v<T, int8_t>) {
+        return compare_range_int8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return compare_range_int16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return compare_range_int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return compare_range_int64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return compare_range_float;
+    } else {
+        static_assert(std::is_same_v<T, double>,
+                      "T must be int8_t to int64_t, float or double");
+        return compare_range_double;
+    }
+}
+
+template <typename T>
+CompareColumnPtr<T>
+compare_column_func() {
+    if constexpr (std::is_same_v<T, int8_t>) {
+        return compare_column_int8;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return compare_column_int16;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return compare_column_int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return compare_column_int64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return compare_column_float;
+    } else {
+        static_assert(std::is_same_v<T, double>,
+                      "T must be int8_t to int64_t, float or double");
+        return compare_column_double;
+    }
+}
+
 }  // namespace simd
 }  // namespace milvus
@@ -300,6 +300,10 @@ class InstructionSet {
     PREFETCHWT1() {
         return f_7_ECX_[0];
     }
+    bool
+    AVX512VPOPCNTDQ() {
+        return f_7_ECX_[14];
+    }
 
     bool
     LAHF() {
@@ -12,8 +12,12 @@
 #if defined(__ARM_NEON)
 
 #include "neon.h"
+#include "compare.h"
+#include "ref.h"
 
 #include <cstddef>
+#include <cstring>
+#include <arm_acle.h>
 #include <arm_neon.h>
 
 namespace milvus {
@@ -117,6 +121,226 @@ OrBoolNEON(bool* left, bool* right, int64_t size) {
     }
 }
 
+void
+GreaterThanTimestampNEON(const uint64_t* src,
+                         int64_t size,
+                         uint64_t val,
+                         BitsetBlockType* dst) {
+    constexpr int64_t block_bits = BITSET_BLOCK_SIZE * 8;
+    const uint64x2_t target = vdupq_n_u64(val);
+    int64_t num_blocks = size / block_bits;
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        BitsetBlockType block = 0;
+        for (int64_t j = 0; j < block_bits; j += 2) {
+            uint64x2_t cmp =
+                vcgtq_u64(vld1q_u64(src + i * block_bits + j), target);
+            block |= BitsetBlockType(vgetq_lane_u64(cmp, 0) & 1) << j;
+            block |= BitsetBlockType(vgetq_lane_u64(cmp, 1) & 1) << (j + 1);
+        }
+        dst[i] = block;
+    }
+    GreaterThanTimestampRef(src + num_blocks * block_bits,
+                            size - num_blocks * block_bits,
+                            val,
+                            dst + num_blocks);
+}
+
+float
+L2SqrFloat16NEON(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+    size_t i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        float16x8_t vx = vreinterpretq_f16_u16(vld1q_u16(x + i));
+        float16x8_t vy = vreinterpretq_f16_u16(vld1q_u16(y + i));
+        float32x4_t diff0 = vsubq_f32(vcvt_f32_f16(vget_low_f16(vx)),
+                                      vcvt_f32_f16(vget_low_f16(vy)));
+        float32x4_t diff1 =
+            vsubq_f32(vcvt_high_f32_f16(vx), vcvt_high_f32_f16(vy));
+        acc0 = vfmaq_f32(acc0, diff0, diff0);
+        acc1 = vfmaq_f32(acc1, diff1, diff1);
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1)) +
+           L2SqrFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloat16NEON(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+    size_t i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        float16x8_t vx = vreinterpretq_f16_u16(vld1q_u16(x + i));
+        float16x8_t vy = vreinterpretq_f16_u16(vld1q_u16(y + i));
+        acc0 = vfmaq_f32(acc0,
+                         vcvt_f32_f16(vget_low_f16(vx)),
+                         vcvt_f32_f16(vget_low_f16(vy)));
+        acc1 =
+            vfmaq_f32(acc1, vcvt_high_f32_f16(vx), vcvt_high_f32_f16(vy));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1)) +
+           InnerProductFloat16Ref(x + i, y + i, dim - i);
+}
+
+float
+InnerProductFloatNEON(const float* x, const float* y, size_t dim) {
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+    size_t i = 0;
+    for (; i + 8 <= dim; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(x + i), vld1q_f32(y + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(x + i + 4), vld1q_f32(y + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1)) +
+           InnerProductFloatRef(x + i, y + i, dim - i);
+}
+
+namespace {
+
+template <size_t Dim>
+float
+InnerProductFloatDimNEON(const float* x, const float* y, size_t) {
+    static_assert(Dim % 16 == 0);
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+    float32x4_t acc2 = vdupq_n_f32(0);
+    float32x4_t acc3 = vdupq_n_f32(0);
+    for (size_t i = 0; i < Dim; i += 16) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(x + i), vld1q_f32(y + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(x + i + 4), vld1q_f32(y + i + 4));
+        acc2 = vfmaq_f32(acc2, vld1q_f32(x + i + 8), vld1q_f32(y + i + 8));
+        acc3 = vfmaq_f32(acc3, vld1q_f32(x + i + 12), vld1q_f32(y + i + 12));
+    }
+    return vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+}
+
+}  // namespace
+
+FloatDistancePtr
+InnerProductFloatOfDimNEON(size_t dim) {
+    return KernelOfDim(dim, [](auto dim_constant) -> FloatDistancePtr {
+        return InnerProductFloatDimNEON<decltype(dim_constant)::value>;
+    });
+}
+
+namespace {
+
+// the popcounts of the bytes of v accumulated into the 32-bit lanes of acc
+uint32x4_t
+PopcountAccNEON(uint32x4_t acc, uint8x16_t v) {
+    return vpadalq_u16(acc, vpaddlq_u8(vcntq_u8(v)));
+}
+
+// the kernels of Bytes bytes known at compile time, or of bytes for 0
+template <size_t Bytes>
+float
+HammingBinaryBytesNEON(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc = PopcountAccNEON(acc, veorq_u8(vld1q_u8(x + i), vld1q_u8(y + i)));
+    }
+    uint64_t count = vaddvq_u32(acc);
+    if constexpr (Bytes % 16 != 0 || Bytes == 0) {
+        count += XorPopcountRef(x + i, y + i, n - i);
+    }
+    return count;
+}
+
+template <size_t Bytes>
+float
+JaccardBinaryBytesNEON(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    auto n = Bytes != 0 ? Bytes : bytes;
+    uint32x4_t and_acc = vdupq_n_u32(0);
+    uint32x4_t or_acc = vdupq_n_u32(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t vx = vld1q_u8(x + i);
+        uint8x16_t vy = vld1q_u8(y + i);
+        and_acc = PopcountAccNEON(and_acc, vandq_u8(vx, vy));
+        or_acc = PopcountAccNEON(or_acc, vorrq_u8(vx, vy));
+    }
+    uint64_t and_count = vaddvq_u32(and_acc);
+    uint64_t or_count = vaddvq_u32(or_acc);
+    if constexpr (Bytes % 16 != 0 || Bytes == 0) {
+        AndOrPopcountRef(x + i, y + i, n - i, and_count, or_count);
+    }
+    return JaccardDistance(and_count, or_count);
+}
+
+}  // namespace
+
+float
+HammingBinaryNEON(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return HammingBinaryBytesNEON<0>(x, y, bytes);
+}
+
+float
+JaccardBinaryNEON(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return JaccardBinaryBytesNEON<0>(x, y, bytes);
+}
+
+BinaryDistancePtr
+HammingBinaryOfDimNEON(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return HammingBinaryBytesNEON<decltype(dim_constant)::value / 8>;
+        });
+}
+
+BinaryDistancePtr
+JaccardBinaryOfDimNEON(size_t dim) {
+    return KernelOfDim<SPECIALIZED_BINARY_DIMS>(
+        dim, [](auto dim_constant) -> BinaryDistancePtr {
+            return JaccardBinaryBytesNEON<decltype(dim_constant)::value / 8>;
+        });
+}
+
+// compiled for the crc extension only here, the cpus without it never call
+__attribute__((target("+crc"))) uint32_t
+Crc32cNEON(uint32_t crc, const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        crc = __crc32cd(crc, word);
+    }
+    for (; size > 0; --size, ++bytes) {
+        crc = __crc32cb(crc, *bytes);
+    }
+    return ~crc;
+}
+
+template <typename T>
+void
+CompareValNEON(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    CompareValLoop(src, size, val, op, res);
+}
+
+template <typename T>
+void
+CompareRangeNEON(const T* src,
+                 size_t size,
+                 T lower,
+                 T upper,
+                 bool lower_inclusive,
+                 bool upper_inclusive,
+                 bool* res) {
+    CompareRangeLoop(
+        src, size, lower, upper, lower_inclusive, upper_inclusive, res);
+}
+
+template <typename T>
+void
+CompareColumnNEON(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    CompareColumnLoop(left, right, size, op, res);
+}
+
+INSTANTIATE_COMPARE_KERNELS(NEON)
+
 }  // namespace simd
 }  // namespace milvus
 
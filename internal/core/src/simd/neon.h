@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include "common.h"
 namespace milvus {
@@ -33,5 +34,70 @@ AndBoolNEON(bool* left, bool* right, int64_t size);
 void
 OrBoolNEON(bool* left, bool* right, int64_t size);
 
+// set the bit i of dst if src[i] > val, dst holds (size + 63) / 64 blocks and
+// the bits beyond size are cleared
+void
+GreaterThanTimestampNEON(const uint64_t* src,
+                         int64_t size,
+                         uint64_t val,
+                         BitsetBlockType* dst);
+
+// the squared L2 distance of two float16 vectors, converted and accumulated
+// as float
+float
+L2SqrFloat16NEON(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+InnerProductFloat16NEON(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+InnerProductFloatNEON(const float* x, const float* y, size_t dim);
+
+// the inner product kernel unrolled for the dim of SPECIALIZED_DIMS, nullptr
+// for the other dims
+FloatDistancePtr
+InnerProductFloatOfDimNEON(size_t dim);
+
+// the hamming and the jaccard distances of two binary vectors, popcounted by
+// vcnt
+float
+HammingBinaryNEON(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+float
+JaccardBinaryNEON(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+// the binary kernels unrolled for the dim in bits of SPECIALIZED_BINARY_DIMS,
+// nullptr for the other dims
+BinaryDistancePtr
+HammingBinaryOfDimNEON(size_t dim);
+
+BinaryDistancePtr
+JaccardBinaryOfDimNEON(size_t dim);
+
+// the CRC32C of data continued from crc, 8 bytes a time by the ARMv8 crc32c,
+// selected only if the cpu has the crc extension
+uint32_t
+Crc32cNEON(uint32_t crc, const void* data, size_t size);
+
+template <typename T>
+void
+CompareValNEON(const T* src, size_t size, T val, CompareOp op, bool* res);
+
+template <typename T>
+void
+CompareRangeNEON(const T* src,
+                 size_t size,
+                 T lower,
+                 T upper,
+                 bool lower_inclusive,
+                 bool upper_inclusive,
+                 bool* res);
+
+// res[i] = left[i] op right[i]
+template <typename T>
+void
+CompareColumnNEON(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res);
+
 }  // namespace simd
 }  // namespace milvus
\ No newline at end of file
@@ -10,6 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "ref.h"
+#include "compare.h"
+
+#include <algorithm>
+#include <array>
 
 namespace milvus {
 namespace simd {
@@ -70,5 +74,148 @@ OrBoolRef(bool* left, bool* right, int64_t size) {
     }
 }
 
+void
+GreaterThanTimestampRef(const uint64_t* src,
+                        int64_t size,
+                        uint64_t val,
+                        BitsetBlockType* dst) {
+    constexpr int64_t block_bits = BITSET_BLOCK_SIZE * 8;
+    for (int64_t i = 0; i < size; i += block_bits) {
+        auto n = std::min(block_bits, size - i);
+        BitsetBlockType block = 0;
+        for (int64_t j = 0; j < n; ++j) {
+            block |= BitsetBlockType(src[i + j] > val) << j;
+        }
+        dst[i / block_bits] = block;
+    }
+}
+
+float
+L2SqrFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        auto diff = Float16ToFloatRef(x[i]) - Float16ToFloatRef(y[i]);
+        res += diff * diff;
+    }
+    return res;
+}
+
+float
+InnerProductFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        res += Float16ToFloatRef(x[i]) * Float16ToFloatRef(y[i]);
+    }
+    return res;
+}
+
+float
+InnerProductFloatRef(const float* x, const float* y, size_t dim) {
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        res += x[i] * y[i];
+    }
+    return res;
+}
+
+uint64_t
+XorPopcountRef(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    uint64_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t wx, wy;
+        std::memcpy(&wx, x + i, sizeof(wx));
+        std::memcpy(&wy, y + i, sizeof(wy));
+        count += __builtin_popcountll(wx ^ wy);
+    }
+    for (; i < bytes; ++i) {
+        count += __builtin_popcount(x[i] ^ y[i]);
+    }
+    return count;
+}
+
+void
+AndOrPopcountRef(const uint8_t* x,
+                 const uint8_t* y,
+                 size_t bytes,
+                 uint64_t& and_count,
+                 uint64_t& or_count) {
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t wx, wy;
+        std::memcpy(&wx, x + i, sizeof(wx));
+        std::memcpy(&wy, y + i, sizeof(wy));
+        and_count += __builtin_popcountll(wx & wy);
+        or_count += __builtin_popcountll(wx | wy);
+    }
+    for (; i < bytes; ++i) {
+        and_count += __builtin_popcount(x[i] & y[i]);
+        or_count += __builtin_popcount(x[i] | y[i]);
+    }
+}
+
+float
+HammingBinaryRef(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    return XorPopcountRef(x, y, bytes);
+}
+
+float
+JaccardBinaryRef(const uint8_t* x, const uint8_t* y, size_t bytes) {
+    uint64_t and_count = 0;
+    uint64_t or_count = 0;
+    AndOrPopcountRef(x, y, bytes, and_count, or_count);
+    return JaccardDistance(and_count, or_count);
+}
+
+uint32_t
+Crc32cRef(uint32_t crc, const void* data, size_t size) {
+    // the table of the reflected Castagnoli polynomial
+    static const auto table = [] {
+        std::array<uint32_t, 256> table;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t entry = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                entry = (entry >> 1) ^ ((entry & 1) ? 0x82f63b78 : 0);
+            }
+            table[i] = entry;
+        }
+        return table;
+    }();
+    auto bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+template <typename T>
+void
+CompareValRef(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    CompareValLoop(src, size, val, op, res);
+}
+
+template <typename T>
+void
+CompareRangeRef(const T* src,
+                size_t size,
+                T lower,
+                T upper,
+                bool lower_inclusive,
+                bool upper_inclusive,
+                bool* res) {
+    CompareRangeLoop(
+        src, size, lower, upper, lower_inclusive, upper_inclusive, res);
+}
+
+template <typename T>
+void
+CompareColumnRef(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    CompareColumnLoop(left, right, size, op, res);
+}
+
+INSTANTIATE_COMPARE_KERNELS(Ref)
+
 }  // namespace simd
 }  // namespace milvus
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstring>
+
 #include "common.h"
 
 namespace milvus {
@@ -34,6 +36,76 @@ AndBoolRef(bool* left, bool* right, int64_t size);
 void
 OrBoolRef(bool* left, bool* right, int64_t size);
 
+// set the bit i of dst if src[i] > val, dst holds (size + 63) / 64 blocks and
+// the bits beyond size are cleared
+void
+GreaterThanTimestampRef(const uint64_t* src,
+                        int64_t size,
+                        uint64_t val,
+                        BitsetBlockType* dst);
+
+// the float value of the IEEE 754 half precision bits
+inline float
+Float16ToFloatRef(uint16_t bits) {
+    uint32_t sign = uint32_t(bits & 0x8000) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1f;
+    uint32_t mantissa = bits & 0x3ff;
+    uint32_t f;
+    if (exponent == 0x1f) {
+        // inf and nan
+        f = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        f = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        f = sign;
+    } else {
+        // subnormal, normalized as a float
+        exponent = 113;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        f = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+    float res;
+    std::memcpy(&res, &f, sizeof(res));
+    return res;
+}
+
+// the squared L2 distance of two float16 vectors, accumulated as float
+float
+L2SqrFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim);
+
+// the inner product of two float16 vectors, accumulated as float
+float
+InnerProductFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim);
+
+// the inner product of two float vectors
+float
+InnerProductFloatRef(const float* x, const float* y, size_t dim);
+
+// the popcount of the xor of the bytes of two binary vectors
+uint64_t
+XorPopcountRef(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+// the popcounts of the and and the or of the bytes of two binary vectors
+void
+AndOrPopcountRef(const uint8_t* x,
+                 const uint8_t* y,
+                 size_t bytes,
+                 uint64_t& and_count,
+                 uint64_t& or_count);
+
+float
+HammingBinaryRef(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+float
+JaccardBinaryRef(const uint8_t* x, const uint8_t* y, size_t bytes);
+
+// the CRC32C of data continued from crc, a byte a time by a table
+uint32_t
+Crc32cRef(uint32_t crc, const void* data, size_t size);
+
 template <typename T>
 bool
 FindTermRef(const T* src, size_t size, T val) {
@@ -45,5 +117,28 @@ FindTermRef(const T* src, size_t size, T val) {
     return false;
 }
 
+// res[i] = src[i] op val for the numeric types
+template <typename T>
+void
+CompareValRef(const T* src, size_t size, T val, CompareOp op, bool* res);
+
+// res[i] = lower < src[i] < upper, the bounds are inclusive if
+// lower_inclusive and upper_inclusive
+template <typename T>
+void
+CompareRangeRef(const T* src,
+                size_t size,
+                T lower,
+                T upper,
+                bool lower_inclusive,
+                bool upper_inclusive,
+                bool* res);
+
+// res[i] = left[i] op right[i]
+template <typename T>
+void
+CompareColumnRef(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res);
+
 }  // namespace simd
 }  // namespace milvus
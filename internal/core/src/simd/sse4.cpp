@@ -15,7 +15,9 @@
 #include "sse2.h"
 
 #include <emmintrin.h>
+#include <nmmintrin.h>
 #include <smmintrin.h>
+#include <cstring>
 #include <iostream>
 
 extern "C" {
@@ -104,6 +106,22 @@ StrCmpSSE4(const char* s1, const char* s2) {
     return 0;
 }
 
+uint32_t
+Crc32cSSE4(uint32_t crc, const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t crc64 = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    auto crc32 = static_cast<uint32_t>(crc64);
+    for (; size > 0; --size, ++bytes) {
+        crc32 = _mm_crc32_u8(crc32, *bytes);
+    }
+    return ~crc32;
+}
+
 }  // namespace simd
 }  // namespace milvus
 
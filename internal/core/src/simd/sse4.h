@@ -37,5 +37,9 @@ FindTermSSE4(const int64_t* src, size_t vec_size, int64_t val);
 int
 StrCmpSSE4(const char* s1, const char* s2);
 
+// the CRC32C of data continued from crc, 8 bytes a time by the SSE4.2 crc32
+uint32_t
+Crc32cSSE4(uint32_t crc, const void* data, size_t size);
+
 }  // namespace simd
 }  // namespace milvus
@@ -0,0 +1,193 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "sve.h"
+#include "compare.h"
+
+#include <arm_sve.h>
+#include <type_traits>
+
+namespace milvus {
+namespace simd {
+
+namespace {
+
+// the lanes of E in a vector
+template <typename E>
+inline int64_t
+NumLanes() {
+    if constexpr (sizeof(E) == 1) {
+        return svcntb();
+    } else if constexpr (sizeof(E) == 2) {
+        return svcnth();
+    } else if constexpr (sizeof(E) == 4) {
+        return svcntw();
+    } else {
+        return svcntd();
+    }
+}
+
+// the lanes of E in [i, size)
+template <typename E>
+inline svbool_t
+WhileLt(int64_t i, int64_t size) {
+    if constexpr (sizeof(E) == 1) {
+        return svwhilelt_b8(i, size);
+    } else if constexpr (sizeof(E) == 2) {
+        return svwhilelt_b16(i, size);
+    } else if constexpr (sizeof(E) == 4) {
+        return svwhilelt_b32(i, size);
+    } else {
+        return svwhilelt_b64(i, size);
+    }
+}
+
+}  // namespace
+
+BitsetBlockType
+GetBitsetBlockSVE(const bool* src) {
+    // the 64 bools as 8 words, the multiplication gathers the 8 bytes of a
+    // word, which are 0 or 1, into the top byte
+    auto words = reinterpret_cast<const uint64_t*>(src);
+    BitsetBlockType block = 0;
+    for (int64_t i = 0; i < 8; i += NumLanes<uint64_t>()) {
+        auto pg = WhileLt<uint64_t>(i, 8);
+        auto bits = svlsr_x(
+            pg,
+            svmul_x(pg, svld1(pg, words + i), uint64_t(0x0102040810204080)),
+            uint64_t(56));
+        bits = svlsl_x(pg, bits, svindex_u64(i * 8, 8));
+        block |= svorv(pg, bits);
+    }
+    return block;
+}
+
+template <typename T>
+bool
+FindTermSVE(const T* src, size_t vec_size, T val) {
+    CHECK_SUPPORTED_TYPE(T, "unsupported type for FindTermSVE");
+    using E = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+    auto ptr = reinterpret_cast<const E*>(src);
+    auto size = static_cast<int64_t>(vec_size);
+    for (int64_t i = 0; i < size; i += NumLanes<E>()) {
+        auto pg = WhileLt<E>(i, size);
+        if (svptest_any(pg, svcmpeq(pg, svld1(pg, ptr + i), E(val)))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template bool
+FindTermSVE<bool>(const bool* src, size_t vec_size, bool val);
+template bool
+FindTermSVE<int8_t>(const int8_t* src, size_t vec_size, int8_t val);
+template bool
+FindTermSVE<int16_t>(const int16_t* src, size_t vec_size, int16_t val);
+template bool
+FindTermSVE<int32_t>(const int32_t* src, size_t vec_size, int32_t val);
+template bool
+FindTermSVE<int64_t>(const int64_t* src, size_t vec_size, int64_t val);
+template bool
+FindTermSVE<float>(const float* src, size_t vec_size, float val);
+template bool
+FindTermSVE<double>(const double* src, size_t vec_size, double val);
+
+bool
+AllFalseSVE(const bool* src, int64_t size) {
+    auto ptr = reinterpret_cast<const uint8_t*>(src);
+    for (int64_t i = 0; i < size; i += NumLanes<uint8_t>()) {
+        auto pg = WhileLt<uint8_t>(i, size);
+        if (svptest_any(pg, svcmpne(pg, svld1(pg, ptr + i), uint8_t(0)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+AllTrueSVE(const bool* src, int64_t size) {
+    auto ptr = reinterpret_cast<const uint8_t*>(src);
+    for (int64_t i = 0; i < size; i += NumLanes<uint8_t>()) {
+        auto pg = WhileLt<uint8_t>(i, size);
+        if (svptest_any(pg, svcmpeq(pg, svld1(pg, ptr + i), uint8_t(0)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+InvertBoolSVE(bool* src, int64_t size) {
+    auto ptr = reinterpret_cast<uint8_t*>(src);
+    for (int64_t i = 0; i < size; i += NumLanes<uint8_t>()) {
+        auto pg = WhileLt<uint8_t>(i, size);
+        svst1(pg, ptr + i, sveor_x(pg, svld1(pg, ptr + i), uint8_t(1)));
+    }
+}
+
+void
+AndBoolSVE(bool* left, bool* right, int64_t size) {
+    auto lptr = reinterpret_cast<uint8_t*>(left);
+    auto rptr = reinterpret_cast<const uint8_t*>(right);
+    for (int64_t i = 0; i < size; i += NumLanes<uint8_t>()) {
+        auto pg = WhileLt<uint8_t>(i, size);
+        svst1(pg,
+              lptr + i,
+              svand_x(pg, svld1(pg, lptr + i), svld1(pg, rptr + i)));
+    }
+}
+
+void
+OrBoolSVE(bool* left, bool* right, int64_t size) {
+    auto lptr = reinterpret_cast<uint8_t*>(left);
+    auto rptr = reinterpret_cast<const uint8_t*>(right);
+    for (int64_t i = 0; i < size; i += NumLanes<uint8_t>()) {
+        auto pg = WhileLt<uint8_t>(i, size);
+        svst1(pg,
+              lptr + i,
+              svorr_x(pg, svld1(pg, lptr + i), svld1(pg, rptr + i)));
+    }
+}
+
+// the compilers vectorize the compare loops by SVE with the predicated loops
+// too
+template <typename T>
+void
+CompareValSVE(const T* src, size_t size, T val, CompareOp op, bool* res) {
+    CompareValLoop(src, size, val, op, res);
+}
+
+template <typename T>
+void
+CompareRangeSVE(const T* src,
+                size_t size,
+                T lower,
+                T upper,
+                bool lower_inclusive,
+                bool upper_inclusive,
+                bool* res) {
+    CompareRangeLoop(
+        src, size, lower, upper, lower_inclusive, upper_inclusive, res);
+}
+
+template <typename T>
+void
+CompareColumnSVE(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res) {
+    CompareColumnLoop(left, right, size, op, res);
+}
+
+INSTANTIATE_COMPARE_KERNELS(SVE)
+
+}  // namespace simd
+}  // namespace milvus
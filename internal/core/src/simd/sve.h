@@ -0,0 +1,70 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common.h"
+
+namespace milvus {
+namespace simd {
+
+// The SVE kernels are length agnostic, the loops are predicated by whilelt
+// instead of handling the tails apart, so the same code runs at any vector
+// length, like the 256 bits of Graviton3.
+
+BitsetBlockType
+GetBitsetBlockSVE(const bool* src);
+
+template <typename T>
+bool
+FindTermSVE(const T* src, size_t vec_size, T val);
+
+bool
+AllFalseSVE(const bool* src, int64_t size);
+
+bool
+AllTrueSVE(const bool* src, int64_t size);
+
+void
+InvertBoolSVE(bool* src, int64_t size);
+
+void
+AndBoolSVE(bool* left, bool* right, int64_t size);
+
+void
+OrBoolSVE(bool* left, bool* right, int64_t size);
+
+template <typename T>
+void
+CompareValSVE(const T* src, size_t size, T val, CompareOp op, bool* res);
+
+template <typename T>
+void
+CompareRangeSVE(const T* src,
+                size_t size,
+                T lower,
+                T upper,
+                bool lower_inclusive,
+                bool upper_inclusive,
+                bool* res);
+
+// res[i] = left[i] op right[i]
+template <typename T>
+void
+CompareColumnSVE(
+    const T* left, const T* right, size_t size, CompareOp op, bool* res);
+
+}  // namespace simd
+}  // namespace milvus
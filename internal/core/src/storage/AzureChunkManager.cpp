@@ -79,7 +79,10 @@ AzureChunkManager::AzureChunkManager(const StorageConfig& storage_config)
             storage_config.requestTimeoutMs == 0
                 ? DEFAULT_CHUNK_MANAGER_REQUEST_TIMEOUT_MS
                 : storage_config.requestTimeoutMs,
-            storage_config.useIAM);
+            storage_config.useIAM,
+            storage_config.read_part_size,
+            DEFAULT_STORAGE_WRITE_PART_SIZE,
+            storage_config.read_concurrency);
     } catch (std::exception& err) {
         ThrowAzureError(
             "PreCheck",
@@ -118,6 +121,14 @@ AzureChunkManager::Read(const std::string& filepath, void* buf, uint64_t size) {
     return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+uint64_t
+AzureChunkManager::Read(const std::string& filepath,
+                        uint64_t offset,
+                        void* buf,
+                        uint64_t size) {
+    return GetObjectBuffer(default_bucket_name_, filepath, offset, buf, size);
+}
+
 void
 AzureChunkManager::Write(const std::string& filepath,
                          void* buf,
@@ -290,6 +301,36 @@ AzureChunkManager::GetObjectBuffer(const std::string& bucket_name,
     return res;
 }
 
+uint64_t
+AzureChunkManager::GetObjectBuffer(const std::string& bucket_name,
+                                   const std::string& object_name,
+                                   uint64_t offset,
+                                   void* buf,
+                                   uint64_t size) {
+    uint64_t res;
+    try {
+        auto start = std::chrono::system_clock::now();
+        res = client_->GetObjectBuffer(
+            bucket_name, object_name, offset, buf, size);
+        internal_storage_request_latency_get.Observe(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now() - start)
+                .count());
+        internal_storage_op_count_get_suc.Increment();
+        internal_storage_kv_size_get.Observe(size);
+    } catch (std::exception& err) {
+        internal_storage_op_count_get_fail.Increment();
+        ThrowAzureError("GetObjectBuffer",
+                        err,
+                        "params, bucket={}, object={}, offset={}, size={}",
+                        bucket_name,
+                        object_name,
+                        offset,
+                        size);
+    }
+    return res;
+}
+
 std::vector<std::string>
 AzureChunkManager::ListObjects(const std::string& bucket_name,
                                const std::string& prefix) {
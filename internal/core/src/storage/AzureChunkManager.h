@@ -69,10 +69,7 @@ class AzureChunkManager : public ChunkManager {
     Read(const std::string& filepath,
          uint64_t offset,
          void* buf,
-         uint64_t len) {
-        throw SegcoreError(NotImplemented,
-                           GetName() + "Read with offset not implement");
-    }
+         uint64_t len);
 
     virtual void
     Write(const std::string& filepath,
@@ -147,6 +144,12 @@ class AzureChunkManager : public ChunkManager {
                     const std::string& object_name,
                     void* buf,
                     uint64_t size);
+    uint64_t
+    GetObjectBuffer(const std::string& bucket_name,
+                    const std::string& object_name,
+                    uint64_t offset,
+                    void* buf,
+                    uint64_t size);
     std::vector<std::string>
     ListObjects(const std::string& bucket_name,
                 const std::string& prefix = nullptr);
@@ -41,6 +41,12 @@ class BinlogReader {
         return tell_;
     }
 
+    // the bytes from the current position to the end
+    std::pair<const uint8_t*, int64_t>
+    Remaining() const {
+        return {data_.get() + tell_, size_ - tell_};
+    }
+
  private:
     std::shared_ptr<uint8_t[]> data_;
     int64_t size_;
@@ -15,62 +15,256 @@
 // limitations under the License.
 
 #include "ChunkCache.h"
+#include "storage/DataCodec.h"
+#include "storage/ThreadPools.h"
+#include "storage/Util.h"
+#include "storage/prometheus_client.h"
 
 namespace milvus::storage {
 
+namespace {
+
+// the files of the chunks in the shared mmap store end with the layout of
+// their data, not mapped
+struct SharedChunkTrailer {
+    static constexpr uint32_t MAGIC = 0x4b4e4843;
+    uint32_t magic;
+    int32_t data_type;
+    int64_t dim;
+    uint64_t data_size;
+};
+
+}  // namespace
+
 std::shared_ptr<ColumnBase>
-ChunkCache::Read(const std::string& filepath) {
+ChunkCache::Read(const std::string& filepath, std::optional<int> advice) {
+    auto path = std::filesystem::path(path_prefix_) / filepath;
+
+    std::promise<std::shared_ptr<ColumnBase>> promise;
+    uint64_t load_id;
+    {
+        std::unique_lock lck(mutex_);
+        auto iter = columns_.find(path);
+        if (iter != columns_.end()) {
+            lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+            internal_chunk_cache_op_count_hit.Increment();
+            auto column = iter->second.column;
+            lck.unlock();
+            return column.get();
+        }
+        internal_chunk_cache_op_count_miss.Increment();
+        load_id = next_load_id_++;
+        lru_.push_front(path);
+        columns_.emplace(
+            path,
+            Entry{promise.get_future().share(), lru_.begin(), load_id});
+    }
+
+    std::shared_ptr<ColumnBase> column;
+    try {
+        column = Load(path, filepath, advice.value_or(read_ahead_policy_));
+    } catch (...) {
+        {
+            std::lock_guard lck(mutex_);
+            auto iter = columns_.find(path);
+            if (iter != columns_.end() && iter->second.load_id == load_id) {
+                lru_.erase(iter->second.lru_iter);
+                columns_.erase(iter);
+            }
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    // publish the column under the lock, so that the waiters observe the
+    // resident bytes accounted once they get the column
+    std::lock_guard lck(mutex_);
+    promise.set_value(column);
+    auto iter = columns_.find(path);
+    // the entry may have been removed while loading
+    if (iter != columns_.end() && iter->second.load_id == load_id) {
+        iter->second.ready = true;
+        resident_bytes_ += column->ByteSize();
+        EvictIfNeeded();
+        internal_chunk_cache_size_resident.Set(resident_bytes_);
+    }
+    return column;
+}
+
+bool
+ChunkCache::ReadRows(const std::string& filepath,
+                     const std::vector<int64_t>& offsets,
+                     int64_t row_size,
+                     uint8_t* buf) {
     auto path = std::filesystem::path(path_prefix_) / filepath;
+    std::shared_ptr<ColumnBase> column;
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = columns_.find(path);
+        if (iter != columns_.end()) {
+            // the file being downloaded is waited for by Read
+            if (!iter->second.ready) {
+                return false;
+            }
+            lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+            internal_chunk_cache_op_count_hit.Increment();
+            column = iter->second.column.get();
+        }
+    }
+    if (column != nullptr) {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            AssertInfo(offsets[i] >= 0 &&
+                           static_cast<size_t>((offsets[i] + 1) * row_size) <=
+                               column->ByteSize(),
+                       "row {} out of the {} bytes of file {}",
+                       offsets[i],
+                       column->ByteSize(),
+                       filepath);
+            std::memcpy(buf + i * row_size,
+                        column->Data() + offsets[i] * row_size,
+                        row_size);
+        }
+        return true;
+    }
+
+    std::shared_ptr<uint8_t[]> head(new uint8_t[RAW_BINLOG_HEAD_READ_SIZE]);
+    auto head_size =
+        cm_->Read(filepath, 0, head.get(), RAW_BINLOG_HEAD_READ_SIZE);
+    auto layout = FindRawInsertPayloadLayout(head, head_size);
+    if (!layout.has_value()) {
+        return false;
+    }
+    AssertInfo(datatype_sizeof(layout->data_type, layout->dim) == row_size,
+               "rows of {} bytes in file {}, expected {}",
+               datatype_sizeof(layout->data_type, layout->dim),
+               filepath,
+               row_size);
+    std::vector<ByteRange> ranges;
+    ranges.reserve(offsets.size());
+    for (auto offset : offsets) {
+        AssertInfo(offset >= 0 && offset < layout->num_rows,
+                   "row {} out of the {} rows of file {}",
+                   offset,
+                   layout->num_rows,
+                   filepath);
+        ranges.push_back({layout->data_offset + offset * row_size,
+                          static_cast<uint64_t>(row_size)});
+    }
+    ReadByteRanges(cm_.get(), filepath, ranges, buf);
+    return true;
+}
 
-    ColumnTable::const_accessor ca;
-    if (columns_.find(ca, path)) {
-        return ca->second;
+void
+ChunkCache::Remove(const std::string& filepath) {
+    auto path = std::filesystem::path(path_prefix_) / filepath;
+    std::lock_guard lck(mutex_);
+    auto iter = columns_.find(path);
+    if (iter == columns_.end()) {
+        return;
+    }
+    if (iter->second.ready) {
+        resident_bytes_ -= iter->second.column.get()->ByteSize();
     }
-    ca.release();
+    lru_.erase(iter->second.lru_iter);
+    columns_.erase(iter);
+    internal_chunk_cache_size_resident.Set(resident_bytes_);
+}
 
-    auto field_data = DownloadAndDecodeRemoteFile(cm_.get(), filepath);
-    auto column = Mmap(path, field_data->GetFieldData());
+void
+ChunkCache::Prefetch(const std::string& filepath, std::optional<int> advice) {
+    auto path = std::filesystem::path(path_prefix_) / filepath;
+    std::shared_ptr<ColumnBase> column;
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = columns_.find(path);
+        if (iter == columns_.end() || !iter->second.ready) {
+            return;
+        }
+        column = iter->second.column.get();
+    }
     auto ok =
         madvise(reinterpret_cast<void*>(const_cast<char*>(column->Data())),
                 column->ByteSize(),
-                read_ahead_policy_);
+                advice.value_or(read_ahead_policy_));
     AssertInfo(ok == 0,
                fmt::format("failed to madvise to the data file {}, err: {}",
                            path.c_str(),
                            strerror(errno)));
-
-    columns_.emplace(path, column);
-    return column;
 }
 
 void
-ChunkCache::Remove(const std::string& filepath) {
+ChunkCache::PrefetchAsync(const std::string& filepath,
+                          std::optional<int> advice) {
     auto path = std::filesystem::path(path_prefix_) / filepath;
-    columns_.erase(path);
+    {
+        std::lock_guard lck(mutex_);
+        if (columns_.find(path) != columns_.end()) {
+            return;
+        }
+    }
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::LOW);
+    pool.Submit([this, filepath, advice]() {
+        try {
+            Read(filepath, advice);
+        } catch (std::exception& e) {
+            LOG_SEGCORE_WARNING_ << "failed to prefetch " << filepath
+                                 << " into chunk cache, err: " << e.what();
+        }
+    });
 }
 
-void
-ChunkCache::Prefetch(const std::string& filepath) {
-    auto path = std::filesystem::path(path_prefix_) / filepath;
-    ColumnTable::const_accessor ca;
-    if (!columns_.find(ca, path)) {
-        return;
+std::shared_ptr<ColumnBase>
+ChunkCache::Load(const std::filesystem::path& path,
+                 const std::string& filepath,
+                 int advice) {
+    std::shared_ptr<ColumnBase> column;
+    auto store = SharedMmapStore::Get();
+    if (store != nullptr) {
+        column = MmapShared(*store, filepath);
+    } else {
+        auto field_data = DownloadAndDecodeRemoteFile(cm_.get(), filepath);
+        column = Mmap(path, field_data->GetFieldData());
     }
-    auto column = ca->second;
     auto ok =
         madvise(reinterpret_cast<void*>(const_cast<char*>(column->Data())),
                 column->ByteSize(),
-                read_ahead_policy_);
+                advice);
     AssertInfo(ok == 0,
                fmt::format("failed to madvise to the data file {}, err: {}",
                            path.c_str(),
                            strerror(errno)));
+    return column;
+}
+
+void
+ChunkCache::EvictIfNeeded() {
+    if (capacity_bytes_ == 0) {
+        return;
+    }
+    // the backing files have been unlinked right after mmap, so dropping the
+    // last reference to a column unmaps it and releases the disk space
+    auto iter = lru_.end();
+    while (resident_bytes_ > capacity_bytes_ && iter != lru_.begin()) {
+        --iter;
+        auto& entry = columns_.at(*iter);
+        if (!entry.ready) {
+            continue;
+        }
+        // the cache holds one reference, any other one pins the column
+        const auto& column = entry.column.get();
+        if (column.use_count() > 1) {
+            continue;
+        }
+        resident_bytes_ -= column->ByteSize();
+        columns_.erase(*iter);
+        iter = lru_.erase(iter);
+        internal_chunk_cache_op_count_evict.Increment();
+    }
 }
 
 std::shared_ptr<ColumnBase>
 ChunkCache::Mmap(const std::filesystem::path& path,
                  const FieldDataPtr& field_data) {
-    std::unique_lock lck(mutex_);
+    std::unique_lock lck(mmap_mutex_);
 
     auto dir = path.parent_path();
     std::filesystem::create_directories(dir);
@@ -83,8 +277,8 @@ ChunkCache::Mmap(const std::filesystem::path& path,
     // write the field data to disk
     auto data_size = field_data->Size();
     // unused
-    std::vector<std::vector<uint64_t>> element_indices{};
-    auto written = WriteFieldData(file, data_type, field_data, element_indices);
+    ArrayElementOffsets element_offsets{};
+    auto written = WriteFieldData(file, data_type, field_data, element_offsets);
     AssertInfo(written == data_size,
                fmt::format("failed to write data file {}, written "
                            "{} but total {}, err: {}",
@@ -111,4 +305,62 @@ ChunkCache::Mmap(const std::filesystem::path& path,
     return column;
 }
 
+std::shared_ptr<ColumnBase>
+ChunkCache::MmapShared(SharedMmapStore& store, const std::string& filepath) {
+    auto lease = store.Acquire(
+        SharedMmapStore::Key("chunk", {filepath}),
+        [&](const std::string& path) {
+            auto field_data =
+                DownloadAndDecodeRemoteFile(cm_.get(), filepath)
+                    ->GetFieldData();
+            auto data_type = field_data->get_data_type();
+            AssertInfo(!datatype_is_variable(data_type),
+                       "TODO: unimplemented for variable data type");
+            auto file = File::Open(path, O_CREAT | O_TRUNC | O_RDWR);
+            // unused
+            ArrayElementOffsets element_offsets{};
+            auto data_size = field_data->Size();
+            auto written =
+                WriteFieldData(file, data_type, field_data, element_offsets);
+            SharedChunkTrailer trailer{SharedChunkTrailer::MAGIC,
+                                       static_cast<int32_t>(data_type),
+                                       field_data->get_dim(),
+                                       data_size};
+            if (written == data_size &&
+                file.Write(&trailer, sizeof(trailer)) == sizeof(trailer)) {
+                written += sizeof(trailer);
+            }
+            AssertInfo(written == data_size + sizeof(trailer),
+                       fmt::format("failed to write data file {}, written "
+                                   "{} but total {}, err: {}",
+                                   path,
+                                   written,
+                                   data_size + sizeof(trailer),
+                                   strerror(errno)));
+        });
+
+    auto file = lease->Open();
+    auto file_size = lease->Size();
+    SharedChunkTrailer trailer{};
+    auto read = file_size >= sizeof(trailer)
+                    ? pread(file.Descriptor(),
+                            &trailer,
+                            sizeof(trailer),
+                            file_size - sizeof(trailer))
+                    : 0;
+    AssertInfo(read == static_cast<ssize_t>(sizeof(trailer)) &&
+                   trailer.magic == SharedChunkTrailer::MAGIC &&
+                   trailer.data_size == file_size - sizeof(trailer),
+               fmt::format("invalid shared chunk file {} of {}",
+                           lease->Path().c_str(),
+                           filepath));
+    auto column =
+        std::make_shared<Column>(file,
+                                 trailer.data_size,
+                                 trailer.dim,
+                                 static_cast<DataType>(trailer.data_type));
+    column->HoldFile(std::move(lease));
+    return column;
+}
+
 }  // namespace milvus::storage
@@ -16,19 +16,29 @@
 
 #pragma once
 
-#include <oneapi/tbb/concurrent_hash_map.h>
+#include <future>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "mmap/Column.h"
+#include "storage/SharedMmapStore.h"
 
 namespace milvus::storage {
 
-extern std::map<std::string, int> ReadAheadPolicy_Map;
-
 class ChunkCache {
  public:
+    // capacity_bytes bounds the total size of the mmapped columns kept in
+    // the cache, 0 means unlimited. Columns that are still referenced by a
+    // caller (i.e. pinned) are never evicted.
     explicit ChunkCache(std::string path,
                         const std::string& read_ahead_policy,
-                        ChunkManagerPtr cm)
-        : path_prefix_(std::move(path)), cm_(cm) {
+                        ChunkManagerPtr cm,
+                        int64_t capacity_bytes = 0)
+        : path_prefix_(std::move(path)),
+          cm_(cm),
+          capacity_bytes_(capacity_bytes) {
         auto iter = ReadAheadPolicy_Map.find(read_ahead_policy);
         AssertInfo(iter != ReadAheadPolicy_Map.end(),
                    fmt::format("unrecognized read ahead policy: {}, "
@@ -36,37 +46,103 @@ class ChunkCache {
                                "willneed, dontneed`",
                                read_ahead_policy));
         read_ahead_policy_ = iter->second;
+        AssertInfo(capacity_bytes_ >= 0,
+                   fmt::format("invalid chunk cache capacity: {}",
+                               capacity_bytes_));
         LOG_SEGCORE_INFO_ << "Init ChunkCache with prefix: " << path_prefix_
-                          << ", read_ahead_policy: " << read_ahead_policy;
+                          << ", read_ahead_policy: " << read_ahead_policy
+                          << ", capacity_bytes: " << capacity_bytes_;
     }
 
     ~ChunkCache() = default;
 
  public:
+    // concurrent reads of the same uncached file wait on a single download,
+    // the advice of the field of the file overrides the read ahead policy
     std::shared_ptr<ColumnBase>
-    Read(const std::string& filepath);
+    Read(const std::string& filepath,
+         std::optional<int> advice = std::nullopt);
+
+    // copy the rows at offsets of the vector binlog into buf, row_size bytes
+    // each, from the cached column if there is one, or by reading only the
+    // byte ranges of the rows if the payload of the binlog is in the raw
+    // layout, see RawPayload.h, which leaves the file uncached. Returns false
+    // if neither applies, then the whole file has to be Read
+    bool
+    ReadRows(const std::string& filepath,
+             const std::vector<int64_t>& offsets,
+             int64_t row_size,
+             uint8_t* buf);
 
     void
     Remove(const std::string& filepath);
 
+    // madvise the cached column with the read ahead policy, or the advice
+    void
+    Prefetch(const std::string& filepath,
+             std::optional<int> advice = std::nullopt);
+
+    // download and mmap the file in background if it's not cached yet
     void
-    Prefetch(const std::string& filepath);
+    PrefetchAsync(const std::string& filepath,
+                  std::optional<int> advice = std::nullopt);
+
+    int64_t
+    ResidentBytes() const {
+        std::lock_guard lck(mutex_);
+        return resident_bytes_;
+    }
+
+    int64_t
+    CapacityBytes() const {
+        return capacity_bytes_;
+    }
 
  private:
+    std::shared_ptr<ColumnBase>
+    Load(const std::filesystem::path& path,
+         const std::string& filepath,
+         int advice);
+
     std::shared_ptr<ColumnBase>
     Mmap(const std::filesystem::path& path, const FieldDataPtr& field_data);
 
+    // map the file of the shared mmap store, written from the remote file by
+    // the first process of the host to read it
+    std::shared_ptr<ColumnBase>
+    MmapShared(SharedMmapStore& store, const std::string& filepath);
+
+    // evict the least recently used unpinned columns until the resident bytes
+    // fit into the capacity, must be called with mutex_ held
+    void
+    EvictIfNeeded();
+
  private:
-    using ColumnTable =
-        oneapi::tbb::concurrent_hash_map<std::string,
-                                         std::shared_ptr<ColumnBase>>;
+    using LRUList = std::list<std::string>;
+    struct Entry {
+        // in flight until ready, loading failures are rethrown to all waiters
+        std::shared_future<std::shared_ptr<ColumnBase>> column;
+        LRUList::iterator lru_iter;
+        // distinguishes the entries of the same file removed and read again
+        uint64_t load_id;
+        bool ready = false;
+    };
+    using ColumnTable = std::unordered_map<std::string, Entry>;
 
  private:
     mutable std::mutex mutex_;
+    // serializes writing the mmap files
+    std::mutex mmap_mutex_;
     int read_ahead_policy_;
     std::string path_prefix_;
     ChunkManagerPtr cm_;
+    const int64_t capacity_bytes_;
+
+    // guarded by mutex_, the front of lru_ is the most recently used
     ColumnTable columns_;
+    LRUList lru_;
+    int64_t resident_bytes_ = 0;
+    uint64_t next_load_id_ = 0;
 };
 
 using ChunkCachePtr = std::shared_ptr<milvus::storage::ChunkCache>;
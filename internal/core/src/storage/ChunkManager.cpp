@@ -67,35 +67,31 @@ generateConfig(const StorageConfig& storage_config) {
                                   ? DEFAULT_CHUNK_MANAGER_REQUEST_TIMEOUT_MS
                                   : storage_config.requestTimeoutMs;
 
+    // every ranged request of a parallel read holds a connection, keep the
+    // pool large enough that they don't wait for each other
+    config.maxConnections =
+        std::max<unsigned>(config.maxConnections,
+                           storage_config.read_concurrency);
+
     return config;
 }
 
 AwsChunkManager::AwsChunkManager(const StorageConfig& storage_config) {
     default_bucket_name_ = storage_config.bucket_name;
     remote_root_path_ = storage_config.root_path;
+    read_part_size_ = storage_config.read_part_size;
+    read_concurrency_ = storage_config.read_concurrency;
+    read_hedge_percentile_ = storage_config.read_hedge_percentile;
 
     InitSDKAPIDefault(storage_config.log_level);
 
     Aws::Client::ClientConfiguration config = generateConfig(storage_config);
-    if (storage_config.useIAM) {
-        auto provider =
-            std::make_shared<Aws::Auth::DefaultAWSCredentialsProviderChain>();
-        auto aws_credentials = provider->GetAWSCredentials();
-        AssertInfo(!aws_credentials.GetAWSAccessKeyId().empty(),
-                   "if use iam, access key id should not be empty");
-        AssertInfo(!aws_credentials.GetAWSSecretKey().empty(),
-                   "if use iam, secret key should not be empty");
-        AssertInfo(!aws_credentials.GetSessionToken().empty(),
-                   "if use iam, token should not be empty");
-
-        client_ = std::make_shared<Aws::S3::S3Client>(
-            provider,
-            config,
-            Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
-            storage_config.useVirtualHost);
-    } else {
-        BuildAccessKeyClient(storage_config, config);
-    }
+    read_limit_ = AdaptiveConcurrencyLimit::ForEndpoint(
+        storage_config.address, config.maxConnections);
+    client_ = GetSharedClient("aws", storage_config, [&]() {
+        BuildS3Client(storage_config, config);
+        return client_;
+    });
 
     PreCheck(storage_config);
 
@@ -109,6 +105,9 @@ AwsChunkManager::AwsChunkManager(const StorageConfig& storage_config) {
 GcpChunkManager::GcpChunkManager(const StorageConfig& storage_config) {
     default_bucket_name_ = storage_config.bucket_name;
     remote_root_path_ = storage_config.root_path;
+    read_part_size_ = storage_config.read_part_size;
+    read_concurrency_ = storage_config.read_concurrency;
+    read_hedge_percentile_ = storage_config.read_hedge_percentile;
 
     if (storage_config.useIAM) {
         sdk_options_.httpOptions.httpClientFactory_create_fn = []() {
@@ -123,15 +122,12 @@ GcpChunkManager::GcpChunkManager(const StorageConfig& storage_config) {
     InitSDKAPIDefault(storage_config.log_level);
 
     Aws::Client::ClientConfiguration config = generateConfig(storage_config);
-    if (storage_config.useIAM) {
-        // Using S3 client instead of google client because of compatible protocol
-        client_ = std::make_shared<Aws::S3::S3Client>(
-            config,
-            Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
-            storage_config.useVirtualHost);
-    } else {
-        BuildAccessKeyClient(storage_config, config);
-    }
+    read_limit_ = AdaptiveConcurrencyLimit::ForEndpoint(
+        storage_config.address, config.maxConnections);
+    client_ = GetSharedClient("gcp", storage_config, [&]() {
+        BuildGoogleCloudClient(storage_config, config);
+        return client_;
+    });
 
     PreCheck(storage_config);
 
@@ -145,33 +141,20 @@ GcpChunkManager::GcpChunkManager(const StorageConfig& storage_config) {
 AliyunChunkManager::AliyunChunkManager(const StorageConfig& storage_config) {
     default_bucket_name_ = storage_config.bucket_name;
     remote_root_path_ = storage_config.root_path;
+    read_part_size_ = storage_config.read_part_size;
+    read_concurrency_ = storage_config.read_concurrency;
+    read_hedge_percentile_ = storage_config.read_hedge_percentile;
 
     InitSDKAPIDefault(storage_config.log_level);
 
     Aws::Client::ClientConfiguration config = generateConfig(storage_config);
+    read_limit_ = AdaptiveConcurrencyLimit::ForEndpoint(
+        storage_config.address, config.maxConnections);
 
-    // For aliyun oss, support use virtual host mode
-    StorageConfig mutable_config = storage_config;
-    mutable_config.useVirtualHost = true;
-    if (storage_config.useIAM) {
-        auto aliyun_provider = Aws::MakeShared<
-            Aws::Auth::AliyunSTSAssumeRoleWebIdentityCredentialsProvider>(
-            "AliyunSTSAssumeRoleWebIdentityCredentialsProvider");
-        auto aliyun_credentials = aliyun_provider->GetAWSCredentials();
-        AssertInfo(!aliyun_credentials.GetAWSAccessKeyId().empty(),
-                   "if use iam, access key id should not be empty");
-        AssertInfo(!aliyun_credentials.GetAWSSecretKey().empty(),
-                   "if use iam, secret key should not be empty");
-        AssertInfo(!aliyun_credentials.GetSessionToken().empty(),
-                   "if use iam, token should not be empty");
-        client_ = std::make_shared<Aws::S3::S3Client>(
-            aliyun_provider,
-            config,
-            Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
-            mutable_config.useVirtualHost);
-    } else {
-        BuildAccessKeyClient(mutable_config, config);
-    }
+    client_ = GetSharedClient("aliyun", storage_config, [&]() {
+        BuildAliyunCloudClient(storage_config, config);
+        return client_;
+    });
 
     PreCheck(storage_config);
 
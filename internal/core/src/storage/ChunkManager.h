@@ -24,12 +24,39 @@
 
 namespace milvus::storage {
 
+/**
+ * @brief ChunkWriter streams the content of one file to the storage,
+ * the file is complete only after Close returns
+ */
+class ChunkWriter {
+ public:
+    virtual ~ChunkWriter() = default;
+
+    /**
+     * @brief Append buffer to the file
+     * @param buf
+     * @param len
+     */
+    virtual void
+    Write(const void* buf, uint64_t len) = 0;
+
+    /**
+     * @brief Flush the remaining data and finish the file
+     */
+    virtual void
+    Close() = 0;
+};
+
+using ChunkWriterPtr = std::unique_ptr<ChunkWriter>;
+
 /**
  * @brief This ChunkManager is abstract interface for milvus that
  * used to manager operation and interaction with storage
  */
 class ChunkManager {
  public:
+    virtual ~ChunkManager() = default;
+
     /**
      * @brief Whether file exists or not
      * @param filepath
@@ -91,6 +118,15 @@ class ChunkManager {
           void* buf,
           uint64_t len) = 0;
 
+    /**
+     * @brief Open a writer to stream a file, the default writer buffers
+     * the whole file and writes it on Close
+     * @param filepath
+     * @return ChunkWriterPtr
+     */
+    virtual ChunkWriterPtr
+    OpenWriter(const std::string& filepath);
+
     /**
      * @brief List files with same prefix
      * @param filepath
@@ -124,6 +160,36 @@ class ChunkManager {
 
 using ChunkManagerPtr = std::shared_ptr<ChunkManager>;
 
+class BufferedChunkWriter : public ChunkWriter {
+ public:
+    BufferedChunkWriter(ChunkManager* chunk_manager, std::string filepath)
+        : chunk_manager_(chunk_manager), filepath_(std::move(filepath)) {
+    }
+
+    void
+    Write(const void* buf, uint64_t len) override {
+        auto data = static_cast<const uint8_t*>(buf);
+        buffer_.insert(buffer_.end(), data, data + len);
+    }
+
+    void
+    Close() override {
+        chunk_manager_->Write(filepath_, buffer_.data(), buffer_.size());
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+    }
+
+ private:
+    ChunkManager* chunk_manager_;
+    std::string filepath_;
+    std::vector<uint8_t> buffer_;
+};
+
+inline ChunkWriterPtr
+ChunkManager::OpenWriter(const std::string& filepath) {
+    return std::make_unique<BufferedChunkWriter>(this, filepath);
+}
+
 enum class ChunkManagerType : int8_t {
     None = 0,
     Local = 1,
@@ -15,6 +15,9 @@
 // limitations under the License.
 
 #include "storage/DataCodec.h"
+
+#include <cstring>
+
 #include "storage/Event.h"
 #include "storage/Util.h"
 #include "storage/InsertData.h"
@@ -29,6 +32,8 @@ namespace milvus::storage {
 std::unique_ptr<DataCodec>
 DeserializeRemoteFileData(BinlogReaderPtr reader) {
     DescriptorEvent descriptor_event(reader);
+    auto [event_bytes, event_size] = reader->Remaining();
+    VerifyPayloadChecksum(descriptor_event.event_data, event_bytes, event_size);
     DataType data_type =
         DataType(descriptor_event.event_data.fix_part.data_type);
     auto descriptor_fix_part = descriptor_event.event_data.fix_part;
@@ -48,6 +53,7 @@ DeserializeRemoteFileData(BinlogReaderPtr reader) {
             insert_data->SetFieldDataMeta(data_meta);
             insert_data->SetTimestamps(insert_event_data.start_timestamp,
                                        insert_event_data.end_timestamp);
+            insert_data->SetStatistics(insert_event_data.statistics);
             return insert_data;
         }
         case EventType::IndexFileEvent: {
@@ -116,4 +122,78 @@ DeserializeFileData(const std::shared_ptr<uint8_t[]> input_data,
     }
 }
 
+std::optional<RawPayloadView>
+FindRawInsertPayload(const std::shared_ptr<uint8_t[]> input, int64_t length) {
+    auto reader = std::make_shared<BinlogReader>(input, length);
+    if (ReadMediumType(reader) != StorageType::Remote) {
+        return std::nullopt;
+    }
+    DescriptorEvent descriptor_event(reader);
+    auto [event_bytes, event_size] = reader->Remaining();
+    VerifyPayloadChecksum(descriptor_event.event_data, event_bytes, event_size);
+    EventHeader header(reader);
+    if (header.event_type_ != EventType::InsertEvent) {
+        return std::nullopt;
+    }
+    // the payload follows the timestamps of the event
+    InsertEventData event_data;
+    auto payload_offset = reader->Tell() + GetFixPartSize(event_data);
+    if (!IsRawPayload(input.get() + payload_offset, length - payload_offset)) {
+        return std::nullopt;
+    }
+    return ParseRawPayload(input.get() + payload_offset,
+                           length - payload_offset);
+}
+
+std::optional<RawInsertPayloadLayout>
+FindRawInsertPayloadLayout(const std::shared_ptr<uint8_t[]> head,
+                           int64_t length) {
+    // the descriptor event is of a variable length, make sure the head holds
+    // it and the headers after it before parsing them
+    EventHeader header;
+    InsertEventData event_data;
+    auto header_size = GetEventHeaderSize(header);
+    if (length < static_cast<int64_t>(sizeof(MAGIC_NUM)) + header_size) {
+        return std::nullopt;
+    }
+    auto reader = std::make_shared<BinlogReader>(head, length);
+    if (ReadMediumType(reader) != StorageType::Remote) {
+        return std::nullopt;
+    }
+    EventHeader descriptor_header(reader);
+    auto payload_offset = static_cast<int64_t>(sizeof(MAGIC_NUM)) +
+                          descriptor_header.event_length_ + header_size +
+                          GetFixPartSize(event_data);
+    if (descriptor_header.event_type_ != EventType::DescriptorEvent ||
+        length < payload_offset +
+                     static_cast<int64_t>(sizeof(RawPayloadHeader))) {
+        return std::nullopt;
+    }
+
+    reader = std::make_shared<BinlogReader>(head, length);
+    ReadMediumType(reader);
+    DescriptorEvent descriptor_event(reader);
+    header = EventHeader(reader);
+    if (header.event_type_ != EventType::InsertEvent ||
+        !IsRawPayload(head.get() + payload_offset, length - payload_offset)) {
+        return std::nullopt;
+    }
+    RawPayloadHeader payload_header;
+    std::memcpy(
+        &payload_header, head.get() + payload_offset, sizeof(payload_header));
+    auto data_type = static_cast<DataType>(payload_header.data_type);
+    if (payload_header.version != RAW_PAYLOAD_VERSION ||
+        !datatype_is_vector(data_type) ||
+        payload_header.data_size !=
+            payload_header.num_rows *
+                datatype_sizeof(data_type, payload_header.dim)) {
+        return std::nullopt;
+    }
+    return RawInsertPayloadLayout{data_type,
+                                  payload_header.num_rows,
+                                  payload_header.dim,
+                                  payload_offset + payload_header.data_offset,
+                                  payload_header.data_size};
+}
+
 }  // namespace milvus::storage
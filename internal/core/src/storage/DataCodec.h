@@ -18,12 +18,15 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "common/FieldData.h"
 #include "storage/Types.h"
 #include "storage/PayloadStream.h"
 #include "storage/BinlogReader.h"
+#include "storage/PayloadStatistics.h"
+#include "storage/RawPayload.h"
 
 namespace milvus::storage {
 
@@ -69,10 +72,22 @@ class DataCodec {
         return field_data_;
     }
 
+    // the statistics of the payload deserialized, nullopt if it has none
+    const std::optional<PayloadStatistics>&
+    GetStatistics() const {
+        return statistics_;
+    }
+
+    void
+    SetStatistics(std::optional<PayloadStatistics> statistics) {
+        statistics_ = std::move(statistics);
+    }
+
  protected:
     CodecType codec_type_;
     std::pair<Timestamp, Timestamp> time_range_;
     FieldDataPtr field_data_;
+    std::optional<PayloadStatistics> statistics_;
 };
 
 // Deserialize the data stream of the file obtained from remote or local
@@ -85,4 +100,27 @@ DeserializeRemoteFileData(BinlogReaderPtr reader);
 std::unique_ptr<DataCodec>
 DeserializeLocalFileData(BinlogReaderPtr reader);
 
+// the values of the remote insert binlog if its payload is in the raw layout,
+// pointing into input, or nullopt if the payload has to be decoded
+std::optional<RawPayloadView>
+FindRawInsertPayload(const std::shared_ptr<uint8_t[]> input, int64_t length);
+
+// where the values of a remote insert binlog in the raw layout are
+struct RawInsertPayloadLayout {
+    DataType data_type;
+    int64_t num_rows;
+    int64_t dim;
+    // from the start of the binlog
+    uint64_t data_offset;
+    uint64_t data_size;
+};
+
+// the layout of the values of the remote insert binlog from the first length
+// bytes of it, or nullopt if its payload is not in the raw layout or the
+// headers don't fit into them. The values are not checked, they may be read
+// by the ranges of the rows, see ChunkCache::ReadRows
+std::optional<RawInsertPayloadLayout>
+FindRawInsertPayloadLayout(const std::shared_ptr<uint8_t[]> head,
+                           int64_t length);
+
 }  // namespace milvus::storage
@@ -0,0 +1,382 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/DiskCacheChunkManager.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+
+#include "common/EasyAssert.h"
+#include "fmt/core.h"
+#include "log/Log.h"
+#include "storage/prometheus_client.h"
+
+namespace milvus::storage {
+
+namespace {
+
+const char* MANIFEST_FILE_NAME = "MANIFEST";
+const char* TMP_FILE_SUFFIX = ".tmp";
+
+// read [offset, offset + len) of the local file, return false if the file
+// has been removed
+bool
+ReadLocalFile(const std::string& path,
+              uint64_t offset,
+              void* buf,
+              uint64_t len,
+              uint64_t* read_len) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    uint64_t total = 0;
+    while (total < len) {
+        auto n = pread(
+            fd, static_cast<char*>(buf) + total, len - total, offset + total);
+        if (n < 0) {
+            close(fd);
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    close(fd);
+    *read_len = total;
+    return true;
+}
+
+}  // namespace
+
+DiskCacheChunkManager::DiskCacheChunkManager(ChunkManagerPtr remote,
+                                             std::string cache_path,
+                                             int64_t capacity_bytes)
+    : remote_(std::move(remote)),
+      cache_path_(std::move(cache_path)),
+      capacity_bytes_(capacity_bytes) {
+    AssertInfo(remote_ != nullptr, "remote chunk manager is null");
+    AssertInfo(capacity_bytes_ > 0,
+               fmt::format("invalid disk cache capacity: {}", capacity_bytes_));
+    std::filesystem::create_directories(cache_path_);
+    Recover();
+    LOG_SEGCORE_INFO_ << "Init DiskCacheChunkManager with path: " << cache_path_
+                      << ", capacity_bytes: " << capacity_bytes_
+                      << ", recovered files: " << entries_.size()
+                      << ", recovered bytes: " << cached_bytes_;
+}
+
+bool
+DiskCacheChunkManager::Exist(const std::string& filepath) {
+    uint64_t size;
+    if (!Lookup(filepath, &size).empty()) {
+        return true;
+    }
+    return remote_->Exist(filepath);
+}
+
+uint64_t
+DiskCacheChunkManager::Size(const std::string& filepath) {
+    uint64_t size;
+    if (!Lookup(filepath, &size).empty()) {
+        return size;
+    }
+    return remote_->Size(filepath);
+}
+
+uint64_t
+DiskCacheChunkManager::Read(const std::string& filepath,
+                            void* buf,
+                            uint64_t len) {
+    uint64_t size;
+    auto local_path = Lookup(filepath, &size);
+    uint64_t read_len;
+    if (!local_path.empty() &&
+        ReadLocalFile(local_path, 0, buf, std::min(len, size), &read_len)) {
+        internal_disk_cache_op_count_hit.Increment();
+        return read_len;
+    }
+
+    internal_disk_cache_op_count_miss.Increment();
+    read_len = remote_->Read(filepath, buf, len);
+    // only the whole file can be cached
+    if (read_len < len || read_len == remote_->Size(filepath)) {
+        Insert(filepath, buf, read_len);
+    }
+    return read_len;
+}
+
+uint64_t
+DiskCacheChunkManager::Read(const std::string& filepath,
+                            uint64_t offset,
+                            void* buf,
+                            uint64_t len) {
+    uint64_t size;
+    auto local_path = Lookup(filepath, &size);
+    uint64_t read_len;
+    if (!local_path.empty() && offset <= size &&
+        ReadLocalFile(
+            local_path, offset, buf, std::min(len, size - offset), &read_len)) {
+        internal_disk_cache_op_count_hit.Increment();
+        return read_len;
+    }
+    internal_disk_cache_op_count_miss.Increment();
+    return remote_->Read(filepath, offset, buf, len);
+}
+
+void
+DiskCacheChunkManager::Write(const std::string& filepath,
+                             void* buf,
+                             uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, buf, len);
+}
+
+void
+DiskCacheChunkManager::Write(const std::string& filepath,
+                             uint64_t offset,
+                             void* buf,
+                             uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, offset, buf, len);
+}
+
+ChunkWriterPtr
+DiskCacheChunkManager::OpenWriter(const std::string& filepath) {
+    Invalidate(filepath);
+    return remote_->OpenWriter(filepath);
+}
+
+std::vector<std::string>
+DiskCacheChunkManager::ListWithPrefix(const std::string& filepath) {
+    return remote_->ListWithPrefix(filepath);
+}
+
+void
+DiskCacheChunkManager::Remove(const std::string& filepath) {
+    Invalidate(filepath);
+    remote_->Remove(filepath);
+}
+
+std::string
+DiskCacheChunkManager::Lookup(const std::string& filepath, uint64_t* size) {
+    std::lock_guard lck(mutex_);
+    auto iter = entries_.find(filepath);
+    if (iter == entries_.end()) {
+        return "";
+    }
+    lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+    *size = iter->second.size;
+    return cache_path_ + "/" + LocalName(filepath);
+}
+
+void
+DiskCacheChunkManager::Insert(const std::string& filepath,
+                              const void* buf,
+                              uint64_t size) {
+    if (static_cast<int64_t>(size) > capacity_bytes_) {
+        return;
+    }
+    auto local_name = LocalName(filepath);
+    uint64_t tmp_id;
+    {
+        std::lock_guard lck(mutex_);
+        if (entries_.find(filepath) != entries_.end() ||
+            owners_.find(local_name) != owners_.end()) {
+            return;
+        }
+        tmp_id = next_tmp_id_++;
+    }
+
+    // write to a temporary file first, so that a crash never leaves a
+    // partially written file under the final name
+    auto local_path = cache_path_ + "/" + local_name;
+    auto tmp_path = local_path + "." + std::to_string(tmp_id) + TMP_FILE_SUFFIX;
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        out.write(static_cast<const char*>(buf), size);
+        out.close();
+        if (!out.good()) {
+            LOG_SEGCORE_WARNING_ << "failed to write disk cache file "
+                                 << tmp_path << " for " << filepath;
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+
+    std::lock_guard lck(mutex_);
+    if (entries_.find(filepath) != entries_.end() ||
+        owners_.find(local_name) != owners_.end()) {
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, local_path, ec);
+    if (ec) {
+        LOG_SEGCORE_WARNING_ << "failed to rename disk cache file " << tmp_path
+                             << ", err: " << ec.message();
+        std::filesystem::remove(tmp_path, ec);
+        return;
+    }
+    lru_.push_front(filepath);
+    entries_.emplace(filepath, Entry{size, lru_.begin()});
+    owners_.emplace(local_name, filepath);
+    cached_bytes_ += size;
+    internal_disk_cache_size_cached.Set(cached_bytes_);
+    manifest_ << "+ " << size << " " << filepath << "\n";
+    manifest_.flush();
+    EvictIfNeeded();
+}
+
+void
+DiskCacheChunkManager::Invalidate(const std::string& filepath) {
+    std::lock_guard lck(mutex_);
+    if (entries_.find(filepath) != entries_.end()) {
+        EraseEntry(filepath);
+        internal_disk_cache_size_cached.Set(cached_bytes_);
+    }
+}
+
+void
+DiskCacheChunkManager::EvictIfNeeded() {
+    while (cached_bytes_ > capacity_bytes_ && !lru_.empty()) {
+        // copy the path since erasing the entry pops it from lru_
+        auto filepath = lru_.back();
+        EraseEntry(filepath);
+        internal_disk_cache_op_count_evict.Increment();
+    }
+    internal_disk_cache_size_cached.Set(cached_bytes_);
+}
+
+void
+DiskCacheChunkManager::EraseEntry(const std::string& filepath) {
+    auto iter = entries_.find(filepath);
+    auto local_name = LocalName(filepath);
+    cached_bytes_ -= iter->second.size;
+    lru_.erase(iter->second.lru_iter);
+    entries_.erase(iter);
+    owners_.erase(local_name);
+    // the readers holding the file opened are not affected by the removal
+    std::error_code ec;
+    std::filesystem::remove(cache_path_ + "/" + local_name, ec);
+    manifest_ << "- " << filepath << "\n";
+    manifest_.flush();
+}
+
+void
+DiskCacheChunkManager::Recover() {
+    auto manifest_path = cache_path_ + "/" + MANIFEST_FILE_NAME;
+
+    // replay the journal, a later record of a file overrides the former ones,
+    // and the order of the records is the order of use
+    std::unordered_map<std::string, uint64_t> sizes;
+    LRUList order;
+    std::unordered_map<std::string, LRUList::iterator> positions;
+    {
+        std::ifstream in(manifest_path);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.size() < 2) {
+                continue;
+            }
+            std::istringstream record(line.substr(2));
+            std::string filepath;
+            if (line[0] == '+') {
+                uint64_t size;
+                if (!(record >> size) || record.get() != ' ' ||
+                    !std::getline(record, filepath)) {
+                    continue;
+                }
+                if (positions.count(filepath) > 0) {
+                    order.erase(positions[filepath]);
+                }
+                order.push_front(filepath);
+                positions[filepath] = order.begin();
+                sizes[filepath] = size;
+            } else if (line[0] == '-') {
+                filepath = line.substr(2);
+                if (positions.count(filepath) > 0) {
+                    order.erase(positions[filepath]);
+                    positions.erase(filepath);
+                    sizes.erase(filepath);
+                }
+            }
+        }
+    }
+
+    // keep the entries whose files are intact, from the least recently used
+    // so that push_front restores the order
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter) {
+        const auto& filepath = *iter;
+        auto size = sizes[filepath];
+        auto local_name = LocalName(filepath);
+        auto local_path = cache_path_ + "/" + local_name;
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(local_path, ec);
+        if (ec || file_size != size || owners_.count(local_name) > 0) {
+            continue;
+        }
+        lru_.push_front(filepath);
+        entries_.emplace(filepath, Entry{size, lru_.begin()});
+        owners_.emplace(local_name, filepath);
+        cached_bytes_ += size;
+    }
+
+    // remove the files not in the manifest, e.g. the temporary files
+    for (const auto& dir_entry :
+         std::filesystem::directory_iterator(cache_path_)) {
+        auto name = dir_entry.path().filename().string();
+        if (name != MANIFEST_FILE_NAME && owners_.count(name) == 0) {
+            std::error_code ec;
+            std::filesystem::remove_all(dir_entry.path(), ec);
+        }
+    }
+
+    // compact the journal
+    auto tmp_manifest_path = manifest_path + TMP_FILE_SUFFIX;
+    {
+        std::ofstream out(tmp_manifest_path, std::ios::trunc);
+        for (auto iter = lru_.rbegin(); iter != lru_.rend(); ++iter) {
+            out << "+ " << entries_[*iter].size << " " << *iter << "\n";
+        }
+        out.close();
+        AssertInfo(out.good(),
+                   fmt::format("failed to write disk cache manifest {}",
+                               tmp_manifest_path));
+    }
+    std::filesystem::rename(tmp_manifest_path, manifest_path);
+    manifest_.open(manifest_path, std::ios::app);
+    AssertInfo(
+        manifest_.is_open(),
+        fmt::format("failed to open disk cache manifest {}", manifest_path));
+
+    EvictIfNeeded();
+}
+
+std::string
+DiskCacheChunkManager::LocalName(const std::string& filepath) const {
+    return fmt::format("{:016x}", std::hash<std::string>{}(filepath));
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,156 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief DiskCacheChunkManager is a read-through cache of the whole files
+ * read from a remote ChunkManager, kept under a local directory so that they
+ * survive restarts. The objects written by milvus are never modified once
+ * uploaded, so the remote path identifies the content of a cached file.
+ *
+ * The cached files are recorded in a manifest journal, which is replayed and
+ * compacted on startup, entries whose files are missing or have a different
+ * size are dropped. The least recently read files are evicted once the total
+ * size exceeds the capacity.
+ */
+class DiskCacheChunkManager : public ChunkManager {
+ public:
+    DiskCacheChunkManager(ChunkManagerPtr remote,
+                          std::string cache_path,
+                          int64_t capacity_bytes);
+
+    virtual ~DiskCacheChunkManager() = default;
+
+ public:
+    virtual bool
+    Exist(const std::string& filepath);
+
+    virtual uint64_t
+    Size(const std::string& filepath);
+
+    // a file read as a whole from the remote is put into the cache
+    virtual uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath, void* buf, uint64_t len);
+
+    virtual uint64_t
+    Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len);
+
+    virtual ChunkWriterPtr
+    OpenWriter(const std::string& filepath);
+
+    virtual std::vector<std::string>
+    ListWithPrefix(const std::string& filepath);
+
+    virtual void
+    Remove(const std::string& filepath);
+
+    virtual std::string
+    GetName() const {
+        return "DiskCacheChunkManager";
+    }
+
+    virtual std::string
+    GetRootPath() const {
+        return remote_->GetRootPath();
+    }
+
+    int64_t
+    CachedBytes() const {
+        std::lock_guard lck(mutex_);
+        return cached_bytes_;
+    }
+
+    int64_t
+    CapacityBytes() const {
+        return capacity_bytes_;
+    }
+
+    ChunkManagerPtr
+    GetRemoteChunkManager() const {
+        return remote_;
+    }
+
+ private:
+    // return the local path of the cached file and mark it as recently used,
+    // or an empty string if the file isn't cached
+    std::string
+    Lookup(const std::string& filepath, uint64_t* size);
+
+    void
+    Insert(const std::string& filepath, const void* buf, uint64_t size);
+
+    void
+    Invalidate(const std::string& filepath);
+
+    // replay the manifest journal and rewrite it with the live entries
+    void
+    Recover();
+
+    // must be called with mutex_ held
+    void
+    EvictIfNeeded();
+
+    // must be called with mutex_ held
+    void
+    EraseEntry(const std::string& filepath);
+
+    std::string
+    LocalName(const std::string& filepath) const;
+
+ private:
+    using LRUList = std::list<std::string>;
+    struct Entry {
+        uint64_t size;
+        LRUList::iterator lru_iter;
+    };
+
+    ChunkManagerPtr remote_;
+    const std::string cache_path_;
+    const int64_t capacity_bytes_;
+
+    mutable std::mutex mutex_;
+    // guarded by mutex_, the front of lru_ is the most recently used
+    std::unordered_map<std::string, Entry> entries_;
+    // local file name to the remote path, to detect name hash collisions
+    std::unordered_map<std::string, std::string> owners_;
+    LRUList lru_;
+    int64_t cached_bytes_ = 0;
+    uint64_t next_tmp_id_ = 0;
+    std::ofstream manifest_;
+};
+
+}  // namespace milvus::storage
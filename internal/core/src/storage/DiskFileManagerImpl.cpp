@@ -22,6 +22,7 @@
 
 #include "common/Common.h"
 #include "common/Slice.h"
+#include "common/Tracer.h"
 #include "log/Log.h"
 
 #include "storage/DiskFileManagerImpl.h"
@@ -163,6 +164,43 @@ DiskFileManagerImpl::AddBatchIndexFiles(
     auto local_chunk_manager =
         LocalChunkManagerSingleton::GetInstance().GetChunkManager();
     auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+    AssertInfo(local_file_offsets.size() == remote_files.size(),
+               "inconsistent size of offset slices with file slices");
+    AssertInfo(remote_files.size() == remote_file_sizes.size(),
+               "inconsistent size of file slices with size slices");
+
+    if (space_ == nullptr) {
+        // read, encode and upload each slice in one task, so a slice buffer
+        // is released as soon as it's uploaded rather than after the batch
+        auto UploadIndexSlice = [&](const std::string& file,
+                                    const int64_t offset,
+                                    const int64_t data_size,
+                                    const std::string& remote_file) {
+            auto buf = std::unique_ptr<uint8_t[]>(new uint8_t[data_size]);
+            local_chunk_manager->Read(file, offset, buf.get(), data_size);
+            return EncodeAndUploadIndexSlice(rcm_.get(),
+                                             buf.get(),
+                                             data_size,
+                                             index_meta_,
+                                             field_meta_,
+                                             remote_file);
+        };
+
+        std::vector<std::future<std::pair<std::string, size_t>>> futures;
+        for (int64_t i = 0; i < remote_files.size(); ++i) {
+            futures.push_back(pool.Submit(UploadIndexSlice,
+                                          local_file_name,
+                                          local_file_offsets[i],
+                                          remote_file_sizes[i],
+                                          remote_files[i]));
+        }
+        for (auto& future : futures) {
+            auto res = future.get();
+            remote_paths_to_size_[res.first] = res.second;
+        }
+        ReleaseArrowUnused();
+        return;
+    }
 
     auto LoadIndexFromDisk = [&](
         const std::string& file,
@@ -174,10 +212,6 @@ DiskFileManagerImpl::AddBatchIndexFiles(
     };
 
     std::vector<std::future<std::shared_ptr<uint8_t[]>>> futures;
-    AssertInfo(local_file_offsets.size() == remote_files.size(),
-               "inconsistent size of offset slices with file slices");
-    AssertInfo(remote_files.size() == remote_file_sizes.size(),
-               "inconsistent size of file slices with size slices");
 
     for (int64_t i = 0; i < remote_files.size(); ++i) {
         futures.push_back(pool.Submit(LoadIndexFromDisk,
@@ -195,22 +229,12 @@ DiskFileManagerImpl::AddBatchIndexFiles(
         data_slices.emplace_back(res.get());
     }
 
-    std::map<std::string, int64_t> res;
-    if (space_ != nullptr) {
-        res = PutIndexData(space_,
-                           data_slices,
-                           remote_file_sizes,
-                           remote_files,
-                           field_meta_,
-                           index_meta_);
-    } else {
-        res = PutIndexData(rcm_.get(),
-                           data_slices,
-                           remote_file_sizes,
-                           remote_files,
-                           field_meta_,
-                           index_meta_);
-    }
+    auto res = PutIndexData(space_,
+                            data_slices,
+                            remote_file_sizes,
+                            remote_files,
+                            field_meta_,
+                            index_meta_);
     for (auto iter = res.begin(); iter != res.end(); ++iter) {
         remote_paths_to_size_[iter->first] = iter->second;
     }
@@ -278,6 +302,8 @@ DiskFileManagerImpl::CacheIndexToDisk() {
 void
 DiskFileManagerImpl::CacheIndexToDisk(
     const std::vector<std::string>& remote_files) {
+    tracer::AutoSpan span("CacheIndexToDisk");
+    span.SetAttribute("files", static_cast<int64_t>(remote_files.size()));
     auto local_chunk_manager =
         LocalChunkManagerSingleton::GetInstance().GetChunkManager();
 
@@ -292,67 +318,51 @@ DiskFileManagerImpl::CacheIndexToDisk(
         std::sort(slices.second.begin(), slices.second.end());
     }
 
-    auto EstimateParallelDegree = [&](const std::string& file) -> uint64_t {
-        auto fileSize = rcm_->Size(file);
-        return uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / fileSize);
-    };
-
+    // the slices of all the files go through one pipeline, so the small files
+    // don't each wait for a batch of downloads to finish, slice_files[i] is
+    // the local file of the i-th slice
+    std::vector<std::string> batch_remote_files;
+    std::vector<size_t> slice_files;
+    std::vector<std::string> local_files;
     for (auto& slices : index_slices) {
         auto prefix = slices.first;
         auto local_index_file_name =
             GetLocalIndexObjectPrefix() +
             prefix.substr(prefix.find_last_of('/') + 1);
         local_chunk_manager->CreateFile(local_index_file_name);
-        int64_t offset = 0;
-        std::vector<std::string> batch_remote_files;
-        uint64_t max_parallel_degree = INT_MAX;
         for (int& iter : slices.second) {
-            if (batch_remote_files.size() == max_parallel_degree) {
-                auto next_offset = CacheBatchIndexFilesToDisk(
-                    batch_remote_files, local_index_file_name, offset);
-                offset = next_offset;
-                batch_remote_files.clear();
-            }
-            auto origin_file = prefix + "_" + std::to_string(iter);
-            if (batch_remote_files.size() == 0) {
-                // Use first file size as average size to estimate
-                max_parallel_degree = EstimateParallelDegree(origin_file);
-            }
-            batch_remote_files.push_back(origin_file);
-        }
-        if (batch_remote_files.size() > 0) {
-            auto next_offset = CacheBatchIndexFilesToDisk(
-                batch_remote_files, local_index_file_name, offset);
-            offset = next_offset;
-            batch_remote_files.clear();
+            batch_remote_files.push_back(prefix + "_" + std::to_string(iter));
+            slice_files.push_back(local_files.size());
         }
-        local_paths_.emplace_back(local_index_file_name);
+        local_files.emplace_back(std::move(local_index_file_name));
     }
-}
-
-uint64_t
-DiskFileManagerImpl::CacheBatchIndexFilesToDisk(
-    const std::vector<std::string>& remote_files,
-    const std::string& local_file_name,
-    uint64_t local_file_init_offfset) {
-    auto local_chunk_manager =
-        LocalChunkManagerSingleton::GetInstance().GetChunkManager();
-    auto index_datas = GetObjectData(rcm_.get(), remote_files);
-    int batch_size = remote_files.size();
-    AssertInfo(index_datas.size() == batch_size,
-               "inconsistent file num and index data num!");
 
-    uint64_t offset = local_file_init_offfset;
-    for (int i = 0; i < batch_size; ++i) {
-        auto index_data = index_datas[i];
-        auto index_size = index_data->Size();
-        auto uint8_data =
-            reinterpret_cast<uint8_t*>(const_cast<void*>(index_data->Data()));
-        local_chunk_manager->Write(
-            local_file_name, offset, uint8_data, index_size);
-        offset += index_size;
+    // a slice is written as soon as it arrives, while the next ones are still
+    // downloading, at the end of the slices before it in the same file
+    auto window =
+        static_cast<int64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    std::vector<uint64_t> offsets(local_files.size(), 0);
+    int64_t bytes = 0;
+    GetObjectData(rcm_.get(),
+                  batch_remote_files,
+                  window,
+                  [&](size_t i, FieldDataPtr index_data) {
+                      auto file = slice_files[i];
+                      auto index_size = index_data->Size();
+                      auto uint8_data = reinterpret_cast<uint8_t*>(
+                          const_cast<void*>(index_data->Data()));
+                      local_chunk_manager->Write(local_files[file],
+                                                 offsets[file],
+                                                 uint8_data,
+                                                 index_size);
+                      offsets[file] += index_size;
+                      bytes += index_size;
+                  });
+    span.SetAttribute("bytes", bytes);
+
+    for (auto& local_file : local_files) {
+        local_paths_.emplace_back(std::move(local_file));
     }
-    return offset;
 }
 
 uint64_t
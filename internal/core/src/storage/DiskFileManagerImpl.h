@@ -80,11 +80,6 @@ class DiskFileManagerImpl : public FileManagerImpl {
     void
     CacheIndexToDisk();
 
-    uint64_t
-    CacheBatchIndexFilesToDisk(const std::vector<std::string>& remote_files,
-                               const std::string& local_file_name,
-                               uint64_t local_file_init_offfset);
-
     uint64_t
     CacheBatchIndexFilesToDiskV2(const std::vector<std::string>& remote_files,
                                  const std::string& local_file_name,
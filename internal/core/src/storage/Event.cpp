@@ -24,6 +24,11 @@
 #include "common/Consts.h"
 #include "common/FieldMeta.h"
 #include "common/Array.h"
+#if defined(USE_DYNAMIC_SIMD)
+#include "simd/hook.h"
+#else
+#include <boost/crc.hpp>
+#endif
 
 namespace milvus::storage {
 
@@ -164,6 +169,9 @@ DescriptorEventData::DescriptorEventData(BinlogReaderPtr reader) {
     if (json.contains(INDEX_BUILD_ID_KEY)) {
         extras[INDEX_BUILD_ID_KEY] = json[INDEX_BUILD_ID_KEY];
     }
+    if (json.contains(PAYLOAD_CRC32C_KEY)) {
+        extras[PAYLOAD_CRC32C_KEY] = json[PAYLOAD_CRC32C_KEY];
+    }
 }
 
 std::vector<uint8_t>
@@ -209,10 +217,11 @@ BaseEventData::BaseEventData(BinlogReaderPtr reader,
     auto payload_reader = std::make_shared<PayloadReader>(
         res.second.get(), payload_length, data_type);
     field_data = payload_reader->get_field_data();
+    statistics = payload_reader->get_statistics();
 }
 
-std::vector<uint8_t>
-BaseEventData::Serialize() {
+std::shared_ptr<PayloadWriter>
+BaseEventData::SerializePayload(int64_t payload_offset) {
     auto data_type = field_data->get_data_type();
     std::shared_ptr<PayloadWriter> payload_writer;
     if (milvus::datatype_is_vector(data_type)) {
@@ -269,8 +278,14 @@ BaseEventData::Serialize() {
         }
     }
 
-    payload_writer->finish();
-    auto payload_buffer = payload_writer->get_payload_buffer();
+    payload_writer->finish(payload_offset);
+    return payload_writer;
+}
+
+std::vector<uint8_t>
+BaseEventData::Serialize(int64_t payload_offset) {
+    auto payload_writer = SerializePayload(payload_offset);
+    auto& payload_buffer = payload_writer->get_payload_buffer();
     auto len =
         sizeof(start_timestamp) + sizeof(end_timestamp) + payload_buffer.size();
     std::vector<uint8_t> res(len);
@@ -293,7 +308,10 @@ BaseEvent::BaseEvent(BinlogReaderPtr reader, DataType data_type) {
 
 std::vector<uint8_t>
 BaseEvent::Serialize() {
-    auto data = event_data.Serialize();
+    // the payload follows the header and the timestamps of the event
+    auto data = event_data.Serialize(event_offset +
+                                     GetEventHeaderSize(event_header) +
+                                     GetFixPartSize(event_data));
     int data_size = data.size();
 
     event_header.event_length_ = GetEventHeaderSize(event_header) + data_size;
@@ -340,6 +358,116 @@ DescriptorEvent::Serialize() {
     return res;
 }
 
+namespace {
+
+// the CRC32C of the bytes of an event, updated part by part
+class PayloadCrc32c {
+ public:
+    void
+    Update(const uint8_t* data, size_t size) {
+#if defined(USE_DYNAMIC_SIMD)
+        crc_ = simd::crc32c(crc_, data, size);
+#else
+        crc32c_.process_bytes(data, size);
+#endif
+    }
+
+    std::string
+    Hex() const {
+#if defined(USE_DYNAMIC_SIMD)
+        return fmt::format("{:08x}", crc_);
+#else
+        return fmt::format("{:08x}", crc32c_.checksum());
+#endif
+    }
+
+ private:
+#if defined(USE_DYNAMIC_SIMD)
+    uint32_t crc_ = 0;
+#else
+    boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true>
+        crc32c_;
+#endif
+};
+
+}  // namespace
+
+std::vector<uint8_t>
+SerializeWithChecksum(DescriptorEvent& descriptor_event, BaseEvent& event) {
+    std::vector<uint8_t> res;
+    SerializeWithChecksum(
+        descriptor_event, event, [&](const uint8_t* data, size_t size) {
+            res.insert(res.end(), data, data + size);
+        });
+    return res;
+}
+
+size_t
+SerializeWithChecksum(DescriptorEvent& descriptor_event,
+                      BaseEvent& event,
+                      const SerializedPartWriter& write) {
+    auto& extras = descriptor_event.event_data.extras;
+    // the checksum is of a fixed length, the offset of the event is known
+    // before it
+    extras[PAYLOAD_CRC32C_KEY] = std::string(8, '0');
+    event.event_offset = descriptor_event.Serialize().size();
+
+    // the header, the timestamps and the payload of the event, as
+    // BaseEvent::Serialize lays them out
+    auto& event_header = event.event_header;
+    auto& event_data = event.event_data;
+    auto payload_writer = event_data.SerializePayload(
+        event.event_offset + GetEventHeaderSize(event_header) +
+        GetFixPartSize(event_data));
+    auto& payload = payload_writer->get_payload_buffer();
+    std::vector<uint8_t> timestamps(GetFixPartSize(event_data));
+    memcpy(timestamps.data(),
+           &event_data.start_timestamp,
+           sizeof(event_data.start_timestamp));
+    memcpy(timestamps.data() + sizeof(event_data.start_timestamp),
+           &event_data.end_timestamp,
+           sizeof(event_data.end_timestamp));
+    event_header.event_length_ = GetEventHeaderSize(event_header) +
+                                 timestamps.size() + payload.size();
+    event_header.next_position_ =
+        event_header.event_length_ + event.event_offset;
+    auto header = event_header.Serialize();
+
+    PayloadCrc32c crc;
+    crc.Update(header.data(), header.size());
+    crc.Update(timestamps.data(), timestamps.size());
+    crc.Update(payload.data(), payload.size());
+    extras[PAYLOAD_CRC32C_KEY] = crc.Hex();
+    auto des_event_bytes = descriptor_event.Serialize();
+    AssertInfo(des_event_bytes.size() == event.event_offset,
+               "descriptor event size changed by the checksum");
+
+    write(des_event_bytes.data(), des_event_bytes.size());
+    write(header.data(), header.size());
+    write(timestamps.data(), timestamps.size());
+    write(payload.data(), payload.size());
+    return event_header.next_position_;
+}
+
+void
+VerifyPayloadChecksum(const DescriptorEventData& descriptor_data,
+                      const uint8_t* data,
+                      int64_t size) {
+    auto it = descriptor_data.extras.find(PAYLOAD_CRC32C_KEY);
+    if (it == descriptor_data.extras.end()) {
+        return;
+    }
+    PayloadCrc32c checksum;
+    checksum.Update(data, size);
+    auto crc = checksum.Hex();
+    if (crc != it->second) {
+        PanicInfo(DataFormatBroken,
+                  "binlog checksum mismatch, expected {}, got {}",
+                  it->second,
+                  crc);
+    }
+}
+
 std::vector<uint8_t>
 LocalInsertEvent::Serialize() {
     int row_num = field_data->get_num_rows();
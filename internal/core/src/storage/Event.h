@@ -16,18 +16,26 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
+#include <optional>
 #include <unordered_map>
 
 #include "common/FieldData.h"
 #include "common/Types.h"
 #include "storage/Types.h"
 #include "storage/BinlogReader.h"
+#include "storage/PayloadStatistics.h"
 
 namespace milvus::storage {
 
+class PayloadWriter;
+
+// receives the bytes of a file serialized in parts, in order
+using SerializedPartWriter = std::function<void(const uint8_t*, size_t)>;
+
 struct EventHeader {
     milvus::Timestamp timestamp_;
     EventType event_type_;
@@ -75,14 +83,21 @@ struct BaseEventData {
     Timestamp start_timestamp;
     Timestamp end_timestamp;
     FieldDataPtr field_data;
+    // the statistics of the payload read, see PayloadReader
+    std::optional<PayloadStatistics> statistics;
 
     BaseEventData() = default;
     explicit BaseEventData(BinlogReaderPtr reader,
                            int event_length,
                            DataType data_type);
 
+    // payload_offset is the offset of the payload in the binlog
     std::vector<uint8_t>
-    Serialize();
+    Serialize(int64_t payload_offset = 0);
+
+    // the finished writer of the payload, which follows the timestamps
+    std::shared_ptr<PayloadWriter>
+    SerializePayload(int64_t payload_offset = 0);
 };
 
 struct DescriptorEvent {
@@ -99,7 +114,7 @@ struct DescriptorEvent {
 struct BaseEvent {
     EventHeader event_header;
     BaseEventData event_data;
-    int64_t event_offset;
+    int64_t event_offset = 0;
 
     BaseEvent() = default;
     explicit BaseEvent(BinlogReaderPtr reader, DataType data_type);
@@ -123,6 +138,27 @@ using DropCollectionEventData = BaseEventData;
 using DropPartitionEvent = BaseEvent;
 using DropPartitionEventData = BaseEventData;
 
+// serialize the descriptor event followed by the event, with the CRC32C of
+// the bytes of the event recorded in the extras of the descriptor event
+std::vector<uint8_t>
+SerializeWithChecksum(DescriptorEvent& descriptor_event, BaseEvent& event);
+
+// the same bytes passed to write in parts, the payload straight from the
+// buffer of its writer, so no copy of the whole file is assembled. Returns
+// the size of the file
+size_t
+SerializeWithChecksum(DescriptorEvent& descriptor_event,
+                      BaseEvent& event,
+                      const SerializedPartWriter& write);
+
+// check the size bytes after the descriptor event against the checksum
+// recorded by SerializeWithChecksum, throws DataFormatBroken if they differ.
+// The files written without the checksum are not checked
+void
+VerifyPayloadChecksum(const DescriptorEventData& descriptor_data,
+                      const uint8_t* data,
+                      int64_t size);
+
 int
 GetFixPartSize(DescriptorEventData& data);
 int
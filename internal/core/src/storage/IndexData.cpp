@@ -48,6 +48,15 @@ IndexData::Serialize(StorageType medium) {
 
 std::vector<uint8_t>
 IndexData::serialize_to_remote_file() {
+    std::vector<uint8_t> res;
+    serialize_to_remote_file([&](const uint8_t* data, size_t size) {
+        res.insert(res.end(), data, data + size);
+    });
+    return res;
+}
+
+size_t
+IndexData::serialize_to_remote_file(const SerializedPartWriter& write) {
     AssertInfo(field_data_meta_.has_value(), "field data not exist");
     AssertInfo(index_meta_.has_value(), "index meta not exist");
     AssertInfo(field_data_ != nullptr, "empty field data");
@@ -80,12 +89,8 @@ IndexData::serialize_to_remote_file() {
     // TODO :: set timestamp
     des_event_header.timestamp_ = 0;
 
-    // serialize descriptor event data
-    auto des_event_bytes = descriptor_event.Serialize();
-
     // create index event
     IndexEvent index_event;
-    index_event.event_offset = des_event_bytes.size();
     auto& index_event_data = index_event.event_data;
     index_event_data.start_timestamp = time_range_.first;
     index_event_data.end_timestamp = time_range_.second;
@@ -96,14 +101,8 @@ IndexData::serialize_to_remote_file() {
     // TODO :: set timestamps
     index_event_header.timestamp_ = 0;
 
-    // serialize insert event
-    auto index_event_bytes = index_event.Serialize();
-
-    des_event_bytes.insert(des_event_bytes.end(),
-                           index_event_bytes.begin(),
-                           index_event_bytes.end());
-
-    return des_event_bytes;
+    // serialize the events, checksummed for the loads
+    return SerializeWithChecksum(descriptor_event, index_event, write);
 }
 
 // Just for test
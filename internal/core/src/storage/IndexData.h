@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "storage/DataCodec.h"
+#include "storage/Event.h"
 
 namespace milvus::storage {
 
@@ -44,6 +45,11 @@ class IndexData : public DataCodec {
     std::vector<uint8_t>
     serialize_to_remote_file();
 
+    // pass the bytes of the remote file to write in parts instead, returns
+    // the size of the file
+    size_t
+    serialize_to_remote_file(const SerializedPartWriter& write);
+
     std::vector<uint8_t>
     serialize_to_local_file();
 
@@ -45,6 +45,15 @@ InsertData::Serialize(StorageType medium) {
 // TODO :: handle string and bool type
 std::vector<uint8_t>
 InsertData::serialize_to_remote_file() {
+    std::vector<uint8_t> res;
+    serialize_to_remote_file([&](const uint8_t* data, size_t size) {
+        res.insert(res.end(), data, data + size);
+    });
+    return res;
+}
+
+size_t
+InsertData::serialize_to_remote_file(const SerializedPartWriter& write) {
     AssertInfo(field_data_meta_.has_value(), "field data not exist");
     AssertInfo(field_data_ != nullptr, "empty field data");
 
@@ -74,12 +83,8 @@ InsertData::serialize_to_remote_file() {
     // TODO :: set timestamp
     des_event_header.timestamp_ = 0;
 
-    // serialize descriptor event data
-    auto des_event_bytes = descriptor_event.Serialize();
-
     // create insert event
     InsertEvent insert_event;
-    insert_event.event_offset = des_event_bytes.size();
     auto& insert_event_data = insert_event.event_data;
     insert_event_data.start_timestamp = time_range_.first;
     insert_event_data.end_timestamp = time_range_.second;
@@ -90,14 +95,8 @@ InsertData::serialize_to_remote_file() {
     insert_event_header.timestamp_ = 0;
     insert_event_header.event_type_ = EventType::InsertEvent;
 
-    // serialize insert event
-    auto insert_event_bytes = insert_event.Serialize();
-
-    des_event_bytes.insert(des_event_bytes.end(),
-                           insert_event_bytes.begin(),
-                           insert_event_bytes.end());
-
-    return des_event_bytes;
+    // serialize the events, checksummed for the loads
+    return SerializeWithChecksum(descriptor_event, insert_event, write);
 }
 
 // local insert file format
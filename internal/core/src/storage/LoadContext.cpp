@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/LoadContext.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "common/EasyAssert.h"
+
+namespace milvus::storage {
+
+namespace {
+
+thread_local LoadContextPtr current_load_context;
+
+// how often the waiters of the budget check the cancellation of their loads
+constexpr auto CANCEL_CHECK_INTERVAL = std::chrono::milliseconds(10);
+
+}  // namespace
+
+void
+LoadContext::CheckCanceled() const {
+    if (IsCanceled()) {
+        PanicInfo(Canceled, "load canceled");
+    }
+}
+
+LoadContextPtr
+GetLoadContext() {
+    return current_load_context;
+}
+
+ScopedLoadContext::ScopedLoadContext(LoadContextPtr context)
+    : previous_(std::exchange(current_load_context, std::move(context))) {
+}
+
+ScopedLoadContext::~ScopedLoadContext() {
+    current_load_context = std::move(previous_);
+}
+
+void
+LoadBudget::SetLimits(int64_t memory_bytes,
+                      int64_t bandwidth_bytes_per_second) {
+    {
+        std::lock_guard lck(mutex_);
+        memory_limit_ = std::max<int64_t>(memory_bytes, 0);
+        bandwidth_limit_ = std::max<int64_t>(bandwidth_bytes_per_second, 0);
+    }
+    released_.notify_all();
+}
+
+void
+LoadBudget::Acquire(int64_t bytes, const LoadContext* context) {
+    std::unique_lock lck(mutex_);
+    while (memory_limit_ > 0 && inflight_bytes_ > 0 &&
+           inflight_bytes_ + bytes > memory_limit_) {
+        if (context != nullptr) {
+            context->CheckCanceled();
+        }
+        released_.wait_for(lck, CANCEL_CHECK_INTERVAL);
+    }
+    inflight_bytes_ += bytes;
+    if (bandwidth_limit_ == 0) {
+        return;
+    }
+
+    // reserve the time the bytes take at the bandwidth, after the bytes
+    // reserved before
+    auto now = std::chrono::steady_clock::now();
+    auto start = std::max(paced_until_, now);
+    paced_until_ =
+        start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(
+                        static_cast<double>(bytes) / bandwidth_limit_));
+    lck.unlock();
+    while (std::chrono::steady_clock::now() < start) {
+        if (context != nullptr && context->IsCanceled()) {
+            Release(bytes);
+            context->CheckCanceled();
+        }
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(
+                start - std::chrono::steady_clock::now(),
+                CANCEL_CHECK_INTERVAL));
+    }
+}
+
+void
+LoadBudget::Release(int64_t bytes) {
+    {
+        std::lock_guard lck(mutex_);
+        inflight_bytes_ -= bytes;
+    }
+    released_.notify_all();
+}
+
+int64_t
+LoadBudget::InflightBytes() const {
+    std::lock_guard lck(mutex_);
+    return inflight_bytes_;
+}
+
+}  // namespace milvus::storage
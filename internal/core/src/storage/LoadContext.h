@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace milvus::storage {
+
+// The progress and the cancellation of a load of field data or an index. It
+// is the context of the thread running the load, and of the tasks the thread
+// submits to the thread pools, so the downloads of the remote files report
+// to it without passing it through every call.
+class LoadContext {
+ public:
+    void
+    Cancel() {
+        canceled_.store(true, std::memory_order_relaxed);
+    }
+
+    bool
+    IsCanceled() const {
+        return canceled_.load(std::memory_order_relaxed);
+    }
+
+    // throw Canceled if the load is canceled
+    void
+    CheckCanceled() const;
+
+    void
+    AddDownloadedBytes(int64_t bytes) {
+        downloaded_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void
+    AddDecodedBytes(int64_t bytes) {
+        decoded_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    int64_t
+    DownloadedBytes() const {
+        return downloaded_bytes_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    DecodedBytes() const {
+        return decoded_bytes_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    std::atomic<bool> canceled_{false};
+    std::atomic<int64_t> downloaded_bytes_{0};
+    std::atomic<int64_t> decoded_bytes_{0};
+};
+
+using LoadContextPtr = std::shared_ptr<LoadContext>;
+
+// the context of the load the calling thread runs, nullptr if none
+LoadContextPtr
+GetLoadContext();
+
+// set the context of the calling thread in the scope
+class ScopedLoadContext {
+ public:
+    explicit ScopedLoadContext(LoadContextPtr context);
+
+    ~ScopedLoadContext();
+
+    ScopedLoadContext(const ScopedLoadContext&) = delete;
+    ScopedLoadContext&
+    operator=(const ScopedLoadContext&) = delete;
+
+ private:
+    LoadContextPtr previous_;
+};
+
+// The budget of the memory and the bandwidth shared by all the loads of the
+// process. A download acquires the size of its file before reading it and
+// releases it once the file is decoded, so the raw buffers in flight stay
+// within the memory budget however many loads run at once, and the reads
+// are paced to the bandwidth budget. 0 is unlimited for both.
+class LoadBudget {
+ public:
+    static LoadBudget&
+    GetInstance() {
+        static LoadBudget instance;
+        return instance;
+    }
+
+    void
+    SetLimits(int64_t memory_bytes, int64_t bandwidth_bytes_per_second);
+
+    // block until the bytes fit in the budget, a file larger than the memory
+    // budget is let through once nothing else is in flight. Throw Canceled
+    // if the load of the context is canceled while waiting
+    void
+    Acquire(int64_t bytes, const LoadContext* context);
+
+    void
+    Release(int64_t bytes);
+
+    int64_t
+    InflightBytes() const;
+
+ private:
+    LoadBudget() = default;
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    int64_t memory_limit_ = 0;
+    int64_t bandwidth_limit_ = 0;
+    int64_t inflight_bytes_ = 0;
+    // the time the bandwidth budget has been handed out until
+    std::chrono::steady_clock::time_point paced_until_{};
+};
+
+// the bytes acquired from the budget in the scope
+class LoadBudgetGuard {
+ public:
+    LoadBudgetGuard(int64_t bytes, const LoadContext* context) : bytes_(bytes) {
+        LoadBudget::GetInstance().Acquire(bytes_, context);
+    }
+
+    ~LoadBudgetGuard() {
+        LoadBudget::GetInstance().Release(bytes_);
+    }
+
+    LoadBudgetGuard(const LoadBudgetGuard&) = delete;
+    LoadBudgetGuard&
+    operator=(const LoadBudgetGuard&) = delete;
+
+ private:
+    int64_t bytes_;
+};
+
+}  // namespace milvus::storage
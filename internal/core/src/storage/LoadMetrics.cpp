@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/LoadMetrics.h"
+
+#include <string>
+
+#include "storage/prometheus_client.h"
+
+namespace milvus::storage {
+
+namespace {
+
+const char*
+LoadStageLabel(LoadStage stage) {
+    switch (stage) {
+        case LoadStage::Download:
+            return "download";
+        case LoadStage::Decode:
+            return "decode";
+        case LoadStage::PushWait:
+            return "push_wait";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+// the families lock to find the metrics of the labels, which is cheap beside
+// the load of a binlog of megabytes, so they are not cached like the search
+// stages
+void
+ObserveLoadStage(LoadStage stage, int64_t field_id, int64_t latency_us) {
+    internal_core_load_latency_family
+        .Add({{"load_stage", LoadStageLabel(stage)},
+              {"field_id", std::to_string(field_id)}},
+             searchLatencyBuckets)
+        .Observe(latency_us);
+}
+
+void
+AddLoadedBytes(int64_t field_id, int64_t bytes) {
+    internal_core_load_bytes_family
+        .Add({{"field_id", std::to_string(field_id)}})
+        .Increment(bytes);
+}
+
+void
+ObserveRemoteFile(int64_t field_id, const RemoteFileStats& stats) {
+    AddLoadedBytes(field_id, stats.bytes);
+    ObserveLoadStage(
+        LoadStage::Download, field_id, stats.download_time.count());
+    ObserveLoadStage(LoadStage::Decode, field_id, stats.decode_time.count());
+}
+
+}  // namespace milvus::storage
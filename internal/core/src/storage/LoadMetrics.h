@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace milvus::storage {
+
+enum class LoadStage {
+    // waiting on the object storage for the bytes of a binlog
+    Download = 0,
+    // deserializing the downloaded binlog into the field data
+    Decode,
+    // waiting for the consumer to pop from the bounded channel
+    PushWait,
+};
+
+// the bytes downloaded and the time taken to download and to decode a remote
+// file
+struct RemoteFileStats {
+    int64_t bytes = 0;
+    std::chrono::microseconds download_time{0};
+    std::chrono::microseconds decode_time{0};
+};
+
+// Observe the latency(us) of the stage of the load of a binlog of the field
+// into the internal_core_load_latency histogram labelled by the stage and the
+// field id. The field ids are the ones of the schemas, which are reused by
+// the collections, so the labels are bounded.
+void
+ObserveLoadStage(LoadStage stage, int64_t field_id, int64_t latency_us);
+
+// count the bytes of the binlogs of the field downloaded into
+// internal_core_load_bytes
+void
+AddLoadedBytes(int64_t field_id, int64_t bytes);
+
+// observe the stats of a remote file of the field
+void
+ObserveRemoteFile(int64_t field_id, const RemoteFileStats& stats);
+
+}  // namespace milvus::storage
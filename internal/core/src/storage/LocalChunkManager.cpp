@@ -16,6 +16,9 @@
 
 #include "LocalChunkManager.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <boost/filesystem.hpp>
 #include <boost/system/error_code.hpp>
 #include <fstream>
@@ -33,6 +36,51 @@
 
 namespace milvus::storage {
 
+namespace {
+
+// the positional reads and writes go straight to the page cache without the
+// extra copy and seek of fstream, and never change a shared file offset
+int
+OpenLocalFile(const std::string& filepath, int flags) {
+    int fd = open(filepath.c_str(), flags, 0666);
+    if (fd == -1) {
+        std::stringstream err_msg;
+        err_msg << "Error: open local file '" << filepath << " failed, "
+                << strerror(errno);
+        throw SegcoreError(FileOpenFailed, err_msg.str());
+    }
+    return fd;
+}
+
+void
+WriteLocalFile(int fd,
+               const std::string& filepath,
+               uint64_t offset,
+               const void* buf,
+               uint64_t size) {
+    uint64_t written = 0;
+    while (written < size) {
+        auto n = pwrite(fd,
+                        static_cast<const char*>(buf) + written,
+                        size - written,
+                        offset + written);
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            std::stringstream err_msg;
+            err_msg << "Error: write local file '" << filepath << " failed, "
+                    << strerror(errno);
+            close(fd);
+            throw SegcoreError(FileWriteFailed, err_msg.str());
+        }
+        written += n;
+    }
+    close(fd);
+}
+
+}  // namespace
+
 bool
 LocalChunkManager::Exist(const std::string& filepath) {
     boost::filesystem::path absPath(filepath);
@@ -80,25 +128,31 @@ LocalChunkManager::Read(const std::string& filepath,
                         uint64_t offset,
                         void* buf,
                         uint64_t size) {
-    std::ifstream infile;
-    infile.open(filepath.data(), std::ios_base::binary);
-    if (infile.fail()) {
-        std::stringstream err_msg;
-        err_msg << "Error: open local file '" << filepath << " failed, "
-                << strerror(errno);
-        throw SegcoreError(FileOpenFailed, err_msg.str());
-    }
-
-    infile.seekg(offset, std::ios::beg);
-    if (!infile.read(reinterpret_cast<char*>(buf), size)) {
-        if (!infile.eof()) {
+    int fd = OpenLocalFile(filepath, O_RDONLY);
+    uint64_t total = 0;
+    while (total < size) {
+        auto n = pread(fd,
+                       static_cast<char*>(buf) + total,
+                       size - total,
+                       offset + total);
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n == -1) {
             std::stringstream err_msg;
             err_msg << "Error: read local file '" << filepath << " failed, "
                     << strerror(errno);
+            close(fd);
             throw SegcoreError(FileReadFailed, err_msg.str());
         }
+        if (n == 0) {
+            // reach the end of file
+            break;
+        }
+        total += n;
     }
-    return infile.gcount();
+    close(fd);
+    return total;
 }
 
 void
@@ -110,20 +164,8 @@ LocalChunkManager::Write(const std::string& absPathStr,
     // ensure upper directory exist firstly
     boost::filesystem::create_directories(absPath.parent_path());
 
-    std::ofstream outfile;
-    outfile.open(absPathStr.data(), std::ios_base::binary);
-    if (outfile.fail()) {
-        std::stringstream err_msg;
-        err_msg << "Error: open local file '" << absPathStr << " failed, "
-                << strerror(errno);
-        throw SegcoreError(FileOpenFailed, err_msg.str());
-    }
-    if (!outfile.write(reinterpret_cast<char*>(buf), size)) {
-        std::stringstream err_msg;
-        err_msg << "Error: write local file '" << absPathStr << " failed, "
-                << strerror(errno);
-        throw SegcoreError(FileWriteFailed, err_msg.str());
-    }
+    int fd = OpenLocalFile(absPathStr, O_WRONLY | O_CREAT | O_TRUNC);
+    WriteLocalFile(fd, absPathStr, 0, buf, size);
 }
 
 void
@@ -136,24 +178,9 @@ LocalChunkManager::Write(const std::string& absPathStr,
     // ensure upper directory exist firstly
     boost::filesystem::create_directories(absPath.parent_path());
 
-    std::ofstream outfile;
-    outfile.open(
-        absPathStr.data(),
-        std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    if (outfile.fail()) {
-        std::stringstream err_msg;
-        err_msg << "Error: open local file '" << absPathStr << " failed, "
-                << strerror(errno);
-        throw SegcoreError(FileOpenFailed, err_msg.str());
-    }
-
-    outfile.seekp(offset, std::ios::beg);
-    if (!outfile.write(reinterpret_cast<char*>(buf), size)) {
-        std::stringstream err_msg;
-        err_msg << "Error: write local file '" << absPathStr << " failed, "
-                << strerror(errno);
-        throw SegcoreError(FileWriteFailed, err_msg.str());
-    }
+    // the file must exist, same as opening it with in | out
+    int fd = OpenLocalFile(absPathStr, O_WRONLY);
+    WriteLocalFile(fd, absPathStr, offset, buf, size);
 }
 
 std::vector<std::string>
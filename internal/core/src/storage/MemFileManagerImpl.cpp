@@ -20,6 +20,7 @@
 
 #include "common/Common.h"
 #include "common/FieldData.h"
+#include "common/Tracer.h"
 #include "log/Log.h"
 #include "storage/Util.h"
 #include "storage/FileManager.h"
@@ -144,39 +145,54 @@ std::map<std::string, FieldDataPtr>
 MemFileManagerImpl::LoadIndexToMemory(
     const std::vector<std::string>& remote_files) {
     std::map<std::string, FieldDataPtr> file_to_index_data;
-    auto parallel_degree =
-        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
-    std::vector<std::string> batch_files;
-
-    auto LoadBatchIndexFiles = [&]() {
-        auto index_datas = GetObjectData(rcm_.get(), batch_files);
-        for (size_t idx = 0; idx < batch_files.size(); ++idx) {
-            auto file_name =
-                batch_files[idx].substr(batch_files[idx].find_last_of('/') + 1);
-            file_to_index_data[file_name] = index_datas[idx];
-        }
-    };
-
-    for (auto& file : remote_files) {
-        if (batch_files.size() >= parallel_degree) {
-            LoadBatchIndexFiles();
-            batch_files.clear();
-        }
-        batch_files.emplace_back(file);
-    }
-
-    if (batch_files.size() > 0) {
-        LoadBatchIndexFiles();
-    }
+    LoadIndexToMemory(remote_files,
+                      [&](const std::string& file_name, FieldDataPtr data) {
+                          file_to_index_data[file_name] = std::move(data);
+                      });
 
     AssertInfo(file_to_index_data.size() == remote_files.size(),
                "inconsistent file num and index data num!");
     return file_to_index_data;
 }
 
+void
+MemFileManagerImpl::LoadIndexToMemory(
+    const std::vector<std::string>& remote_files,
+    const std::function<void(const std::string&, FieldDataPtr)>& consume) {
+    tracer::AutoSpan span("LoadIndexToMemory");
+    span.SetAttribute("files", static_cast<int64_t>(remote_files.size()));
+    // the slices are at most FILE_SLICE_SIZE each, so that many of them keep
+    // the bytes in flight within the memory limit
+    auto window =
+        static_cast<int64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    int64_t bytes = 0;
+    GetObjectData(rcm_.get(),
+                  remote_files,
+                  window,
+                  [&](size_t i, FieldDataPtr data) {
+                      auto& file = remote_files[i];
+                      bytes += data->Size();
+                      consume(file.substr(file.find_last_of('/') + 1),
+                              std::move(data));
+                  });
+    span.SetAttribute("bytes", bytes);
+}
+
 std::vector<FieldDataPtr>
 MemFileManagerImpl::CacheRawDataToMemory(
     std::vector<std::string> remote_files) {
+    std::vector<FieldDataPtr> field_datas;
+    field_datas.reserve(remote_files.size());
+    CacheRawDataToMemory(std::move(remote_files), [&](FieldDataPtr data) {
+        field_datas.emplace_back(std::move(data));
+    });
+    return field_datas;
+}
+
+void
+MemFileManagerImpl::CacheRawDataToMemory(
+    std::vector<std::string> remote_files,
+    const std::function<void(FieldDataPtr)>& consume) {
     std::sort(remote_files.begin(),
               remote_files.end(),
               [](const std::string& a, const std::string& b) {
@@ -184,32 +200,19 @@ MemFileManagerImpl::CacheRawDataToMemory(
                          std::stol(b.substr(b.find_last_of("/") + 1));
               });
 
-    auto parallel_degree =
-        uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
-    std::vector<std::string> batch_files;
-    std::vector<FieldDataPtr> field_datas;
-
-    auto FetchRawData = [&]() {
-        auto raw_datas = GetObjectData(rcm_.get(), batch_files);
-        for (auto& data : raw_datas) {
-            field_datas.emplace_back(data);
-        }
-    };
-
-    for (auto& file : remote_files) {
-        if (batch_files.size() >= parallel_degree) {
-            FetchRawData();
-            batch_files.clear();
-        }
-        batch_files.emplace_back(file);
-    }
-    if (batch_files.size() > 0) {
-        FetchRawData();
-    }
-
-    AssertInfo(field_datas.size() == remote_files.size(),
-               "inconsistent file num and raw data num!");
-    return field_datas;
+    tracer::AutoSpan span("CacheRawDataToMemory");
+    span.SetAttribute("files", static_cast<int64_t>(remote_files.size()));
+    auto window =
+        static_cast<int64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    int64_t bytes = 0;
+    GetObjectData(rcm_.get(),
+                  remote_files,
+                  window,
+                  [&](size_t, FieldDataPtr data) {
+                      bytes += data->Size();
+                      consume(std::move(data));
+                  });
+    span.SetAttribute("bytes", bytes);
 }
 
 std::optional<bool>
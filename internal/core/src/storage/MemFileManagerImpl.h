@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -57,9 +58,22 @@ class MemFileManagerImpl : public FileManagerImpl {
     std::map<std::string, FieldDataPtr>
     LoadIndexToMemory(const std::vector<std::string>& remote_files);
 
+    // hand the files to consume by their names in the order of remote_files
+    // as they are downloaded, at most a memory limit of them in flight
+    void
+    LoadIndexToMemory(
+        const std::vector<std::string>& remote_files,
+        const std::function<void(const std::string&, FieldDataPtr)>& consume);
+
     std::vector<FieldDataPtr>
     CacheRawDataToMemory(std::vector<std::string> remote_files);
 
+    // hand the binlogs to consume in the order of their log ids as they are
+    // downloaded, at most a memory limit of them in flight
+    void
+    CacheRawDataToMemory(std::vector<std::string> remote_files,
+                         const std::function<void(FieldDataPtr)>& consume);
+
     bool
     AddFile(const BinarySet& binary_set);
 
@@ -16,12 +16,17 @@
 
 #include "storage/MinioChunkManager.h"
 
+#include <cstring>
 #include <fstream>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
 #include <aws/core/auth/STSCredentialsProvider.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -29,10 +34,12 @@
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 #include "storage/AliyunSTSClient.h"
 #include "storage/AliyunCredentialsProvider.h"
 #include "storage/prometheus_client.h"
+#include "storage/ThreadPools.h"
 #include "common/EasyAssert.h"
 #include "log/Log.h"
 #include "signal.h"
@@ -218,6 +225,44 @@ MinioChunkManager::BuildS3Client(
     }
 }
 
+std::shared_ptr<Aws::S3::S3Client>
+MinioChunkManager::GetSharedClient(
+    const std::string& kind,
+    const StorageConfig& storage_config,
+    const std::function<std::shared_ptr<Aws::S3::S3Client>()>& build) {
+    // never destroyed, a client destroyed at exit may outlive the sdk
+    static auto& clients =
+        *new std::unordered_map<std::string,
+                                std::shared_ptr<Aws::S3::S3Client>>();
+    static std::mutex clients_mutex;
+    // the fields the clients are built from, the bucket and the root path
+    // are per request
+    auto key = fmt::format("{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+                           kind,
+                           storage_config.address,
+                           storage_config.region,
+                           storage_config.access_key_id,
+                           storage_config.access_key_value,
+                           storage_config.iam_endpoint,
+                           storage_config.useSSL,
+                           storage_config.useIAM,
+                           storage_config.useVirtualHost,
+                           storage_config.requestTimeoutMs,
+                           storage_config.read_concurrency);
+    std::lock_guard lck(clients_mutex);
+    auto& client = clients[key];
+    if (client == nullptr) {
+        client = build();
+        if (clients.size() == 1) {
+            // the pooled clients outlive the chunk managers, keep the sdk
+            // initialized for them
+            std::scoped_lock lock{client_mutex_};
+            init_count_++;
+        }
+    }
+    return client;
+}
+
 void
 MinioChunkManager::PreCheck(const StorageConfig& config) {
     LOG_SEGCORE_INFO_ << "start to precheck chunk manager with configuration:"
@@ -303,6 +348,9 @@ MinioChunkManager::BuildGoogleCloudClient(
 MinioChunkManager::MinioChunkManager(const StorageConfig& storage_config)
     : default_bucket_name_(storage_config.bucket_name) {
     remote_root_path_ = storage_config.root_path;
+    read_part_size_ = storage_config.read_part_size;
+    read_concurrency_ = storage_config.read_concurrency;
+    read_hedge_percentile_ = storage_config.read_hedge_percentile;
     RemoteStorageType storageType;
     if (storage_config.address.find("google") != std::string::npos) {
         storageType = RemoteStorageType::GOOGLE_CLOUD;
@@ -336,13 +384,24 @@ MinioChunkManager::MinioChunkManager(const StorageConfig& storage_config)
         config.region = ConvertToAwsString(storage_config.region);
     }
 
-    if (storageType == RemoteStorageType::S3) {
-        BuildS3Client(storage_config, config);
-    } else if (storageType == RemoteStorageType::ALIYUN_CLOUD) {
-        BuildAliyunCloudClient(storage_config, config);
-    } else if (storageType == RemoteStorageType::GOOGLE_CLOUD) {
-        BuildGoogleCloudClient(storage_config, config);
-    }
+    // every ranged request of a parallel read holds a connection, keep the
+    // pool large enough that they don't wait for each other
+    config.maxConnections =
+        std::max<unsigned>(config.maxConnections,
+                           storage_config.read_concurrency);
+    read_limit_ = AdaptiveConcurrencyLimit::ForEndpoint(
+        storage_config.address, config.maxConnections);
+
+    client_ = GetSharedClient("minio", storage_config, [&]() {
+        if (storageType == RemoteStorageType::S3) {
+            BuildS3Client(storage_config, config);
+        } else if (storageType == RemoteStorageType::ALIYUN_CLOUD) {
+            BuildAliyunCloudClient(storage_config, config);
+        } else if (storageType == RemoteStorageType::GOOGLE_CLOUD) {
+            BuildGoogleCloudClient(storage_config, config);
+        }
+        return client_;
+    });
 
     PreCheck(storage_config);
 
@@ -354,6 +413,10 @@ MinioChunkManager::MinioChunkManager(const StorageConfig& storage_config)
 }
 
 MinioChunkManager::~MinioChunkManager() {
+    {
+        std::unique_lock lck(pending_gets_mutex_);
+        pending_gets_cv_.wait(lck, [this]() { return pending_gets_ == 0; });
+    }
     client_.reset();
     ShutdownSDKAPI();
 }
@@ -380,9 +443,21 @@ MinioChunkManager::ListWithPrefix(const std::string& filepath) {
 
 uint64_t
 MinioChunkManager::Read(const std::string& filepath, void* buf, uint64_t size) {
+    if (read_concurrency_ > 1 && size > read_part_size_) {
+        return GetObjectBufferParallel(
+            default_bucket_name_, filepath, buf, size);
+    }
     return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+uint64_t
+MinioChunkManager::Read(const std::string& filepath,
+                        uint64_t offset,
+                        void* buf,
+                        uint64_t size) {
+    return GetObjectBuffer(default_bucket_name_, filepath, offset, buf, size);
+}
+
 void
 MinioChunkManager::Write(const std::string& filepath,
                          void* buf,
@@ -390,6 +465,109 @@ MinioChunkManager::Write(const std::string& filepath,
     PutObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+/**
+ * @brief MinioChunkWriter buffers at most one part in memory, the parts are
+ * uploaded once filled, and a file smaller than one part is uploaded with a
+ * single PutObject on Close
+ */
+class MinioChunkWriter : public ChunkWriter {
+ public:
+    MinioChunkWriter(MinioChunkManager* chunk_manager,
+                     std::string bucket_name,
+                     std::string object_name,
+                     uint64_t part_size)
+        : chunk_manager_(chunk_manager),
+          bucket_name_(std::move(bucket_name)),
+          object_name_(std::move(object_name)),
+          part_size_(part_size) {
+    }
+
+    ~MinioChunkWriter() override {
+        if (!closed_ && !upload_id_.empty()) {
+            try {
+                chunk_manager_->AbortMultipartUpload(
+                    bucket_name_, object_name_, upload_id_);
+            } catch (std::exception& e) {
+                LOG_SEGCORE_WARNING_ << "failed to abort multipart upload of "
+                                     << object_name_ << ", err: " << e.what();
+            }
+        }
+    }
+
+    void
+    Write(const void* buf, uint64_t len) override {
+        AssertInfo(!closed_, "write to closed writer of " + object_name_);
+        auto data = static_cast<const uint8_t*>(buf);
+        while (len > 0) {
+            // upload full parts from the caller's buffer without copying
+            if (buffer_.empty() && len >= part_size_) {
+                UploadPart(data, part_size_);
+                data += part_size_;
+                len -= part_size_;
+                continue;
+            }
+            auto n = std::min(len, part_size_ - buffer_.size());
+            buffer_.insert(buffer_.end(), data, data + n);
+            data += n;
+            len -= n;
+            if (buffer_.size() == part_size_) {
+                UploadPart(buffer_.data(), buffer_.size());
+                buffer_.clear();
+            }
+        }
+    }
+
+    void
+    Close() override {
+        AssertInfo(!closed_, "writer of " + object_name_ + " closed twice");
+        if (upload_id_.empty()) {
+            chunk_manager_->PutObjectBuffer(
+                bucket_name_, object_name_, buffer_.data(), buffer_.size());
+        } else {
+            if (!buffer_.empty()) {
+                UploadPart(buffer_.data(), buffer_.size());
+            }
+            chunk_manager_->CompleteMultipartUpload(
+                bucket_name_, object_name_, upload_id_, etags_);
+        }
+        closed_ = true;
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+    }
+
+ private:
+    void
+    UploadPart(const uint8_t* data, uint64_t size) {
+        if (upload_id_.empty()) {
+            upload_id_ = chunk_manager_->CreateMultipartUpload(bucket_name_,
+                                                               object_name_);
+        }
+        // part numbers start from 1
+        etags_.emplace_back(chunk_manager_->UploadPart(bucket_name_,
+                                                       object_name_,
+                                                       upload_id_,
+                                                       etags_.size() + 1,
+                                                       data,
+                                                       size));
+    }
+
+ private:
+    MinioChunkManager* chunk_manager_;
+    std::string bucket_name_;
+    std::string object_name_;
+    uint64_t part_size_;
+    std::vector<uint8_t> buffer_;
+    std::string upload_id_;
+    std::vector<std::string> etags_;
+    bool closed_ = false;
+};
+
+ChunkWriterPtr
+MinioChunkManager::OpenWriter(const std::string& filepath) {
+    return std::make_unique<MinioChunkWriter>(
+        this, default_bucket_name_, filepath, write_part_size_);
+}
+
 bool
 MinioChunkManager::BucketExists(const std::string& bucket_name) {
     Aws::S3::Model::HeadBucketRequest request;
@@ -560,11 +738,13 @@ MinioChunkManager::PutObjectBuffer(const std::string& bucket_name,
     request.SetBucket(bucket_name.c_str());
     request.SetKey(object_name.c_str());
 
+    // wrap the buffer as the request body instead of copying it
+    Aws::Utils::Stream::PreallocatedStreamBuf stream_buf(
+        reinterpret_cast<unsigned char*>(buf), size);
     const std::shared_ptr<Aws::IOStream> input_data =
-        Aws::MakeShared<Aws::StringStream>("");
-
-    input_data->write(reinterpret_cast<char*>(buf), size);
+        Aws::MakeShared<Aws::IOStream>("PutObjectBuffer", &stream_buf);
     request.SetBody(input_data);
+    request.SetContentLength(size);
 
     auto start = std::chrono::system_clock::now();
     auto outcome = client_->PutObject(request);
@@ -626,14 +806,49 @@ class AwsResponseStream : public Aws::IOStream {
     AwsStreambuf aws_streambuf;
 };
 
+// the bytes of the body of a get into a buffer of size bytes
+static uint64_t
+ReceivedSize(const Aws::S3::Model::GetObjectResult& result, uint64_t size) {
+    auto length = result.GetContentLength();
+    return length < 0 ? size : std::min<uint64_t>(length, size);
+}
+
+uint64_t
+MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
+                                   const std::string& object_name,
+                                   void* buf,
+                                   uint64_t size) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    return GetObjectBuffer(request, buf, size);
+}
+
 uint64_t
 MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                    const std::string& object_name,
+                                   uint64_t offset,
                                    void* buf,
                                    uint64_t size) {
+    if (size == 0) {
+        return 0;
+    }
     Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(bucket_name.c_str());
     request.SetKey(object_name.c_str());
+    request.SetRange(
+        fmt::format("bytes={}-{}", offset, offset + size - 1).c_str());
+    return GetObjectBuffer(request, buf, size);
+}
+
+uint64_t
+MinioChunkManager::GetObjectBuffer(
+    Aws::S3::Model::GetObjectRequest& request, void* buf, uint64_t size) {
+    if (auto delay = HedgeDelay(size); delay.has_value()) {
+        return GetObjectBufferHedged(request, buf, size, *delay);
+    }
+    const auto& bucket_name = request.GetBucket();
+    const auto& object_name = request.GetKey();
 
     request.SetResponseStreamFactory([buf, size]() {
     // For macOs, pubsetbuf interface not implemented
@@ -653,21 +868,400 @@ MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
         std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start)
             .count());
-    internal_storage_kv_size_get.Observe(size);
 
     if (!outcome.IsSuccess()) {
         internal_storage_op_count_get_fail.Increment();
         const auto& err = outcome.GetError();
         ThrowS3Error("GetObjectBuffer",
                      err,
-                     "params, bucket={}, object={}",
+                     "params, bucket={}, object={}, range={}",
                      bucket_name,
-                     object_name);
+                     object_name,
+                     request.GetRange());
     }
     internal_storage_op_count_get_suc.Increment();
+    // a range past the end of the object transfers fewer bytes than asked
+    auto received = ReceivedSize(outcome.GetResult(), size);
+    internal_storage_kv_size_get.Observe(received);
+    return received;
+}
+
+std::optional<std::chrono::milliseconds>
+MinioChunkManager::HedgeDelay(uint64_t size) const {
+    if (read_hedge_percentile_ <= 0 || size > STORAGE_READ_HEDGE_MAX_BYTES) {
+        return std::nullopt;
+    }
+    auto latency = HistogramPercentile(internal_storage_request_latency_get,
+                                       read_hedge_percentile_,
+                                       STORAGE_READ_HEDGE_MIN_SAMPLES);
+    if (!latency.has_value()) {
+        return std::nullopt;
+    }
+    return std::chrono::milliseconds(static_cast<int64_t>(*latency));
+}
+
+namespace {
+
+// shared by the attempts of a hedged get and the caller. The first attempt
+// writes into the caller's buffer, the hedge into its own, and an attempt
+// stops writing once the caller has returned, so a late loser touches only
+// this state.
+struct HedgedGet {
+    HedgedGet(char* buf, uint64_t size) : size(size), targets{buf, nullptr} {
+    }
+
+    const uint64_t size;
+    std::mutex mutex;
+    std::condition_variable cv;
+    char* targets[2];
+    std::vector<char> hedge_buf;
+    int started = 0;
+    int failed = 0;
+    // the bytes transferred by the winner
+    uint64_t received = 0;
+    // the attempt that succeeded first, -1 until then
+    std::atomic<int> winner{-1};
+    std::optional<Aws::S3::S3Error> error;
+};
+
+class HedgedGetStreambuf : public std::streambuf {
+ public:
+    HedgedGetStreambuf(std::shared_ptr<HedgedGet> get, int attempt)
+        : get_(std::move(get)), attempt_(attempt) {
+    }
+
+ protected:
+    std::streamsize
+    xsputn(const char* s, std::streamsize n) override {
+        std::lock_guard lck(get_->mutex);
+        auto len = std::min<uint64_t>(n, get_->size - written_);
+        if (get_->targets[attempt_] != nullptr) {
+            std::memcpy(get_->targets[attempt_] + written_, s, len);
+        }
+        written_ += len;
+        return n;
+    }
+
+    int_type
+    overflow(int_type ch) override {
+        if (ch != traits_type::eof()) {
+            auto c = traits_type::to_char_type(ch);
+            xsputn(&c, 1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+ private:
+    std::shared_ptr<HedgedGet> get_;
+    const int attempt_;
+    uint64_t written_ = 0;
+};
+
+class HedgedGetStream : public Aws::IOStream {
+ public:
+    HedgedGetStream(std::shared_ptr<HedgedGet> get, int attempt)
+        : Aws::IOStream(&streambuf_), streambuf_(std::move(get), attempt) {
+    }
+
+ private:
+    HedgedGetStreambuf streambuf_;
+};
+
+}  // namespace
+
+uint64_t
+MinioChunkManager::GetObjectBufferHedged(
+    const Aws::S3::Model::GetObjectRequest& request,
+    void* buf,
+    uint64_t size,
+    std::chrono::milliseconds delay) {
+    auto get = std::make_shared<HedgedGet>(static_cast<char*>(buf), size);
+
+    // called with get->mutex held
+    auto start_attempt = [&](int attempt) {
+        if (attempt == 1) {
+            get->hedge_buf.resize(size);
+            get->targets[1] = get->hedge_buf.data();
+        }
+        get->started++;
+        auto attempt_request = request;
+        attempt_request.SetResponseStreamFactory([get, attempt]() {
+            return Aws::New<HedgedGetStream>("HedgedGetStream", get, attempt);
+        });
+        // the loser stops downloading once the other attempt has won
+        attempt_request.SetContinueRequestHandler(
+            [get](const Aws::Http::HttpRequest*) {
+                return get->winner.load() < 0;
+            });
+        {
+            std::lock_guard lck(pending_gets_mutex_);
+            pending_gets_++;
+        }
+        read_limit_->OnStart();
+        auto start = std::chrono::system_clock::now();
+        client_->GetObjectAsync(
+            attempt_request,
+            [this, get, attempt, start, delay](
+                const Aws::S3::S3Client*,
+                const Aws::S3::Model::GetObjectRequest&,
+                auto&& outcome,
+                const std::shared_ptr<const Aws::Client::AsyncCallerContext>&) {
+                auto latency = std::chrono::duration_cast<
+                    std::chrono::milliseconds>(
+                    std::chrono::system_clock::now() - start);
+                {
+                    std::lock_guard lck(get->mutex);
+                    int no_winner = -1;
+                    if (!outcome.IsSuccess()) {
+                        // the cancelled loser isn't counted as a failure
+                        if (get->winner.load() < 0) {
+                            internal_storage_op_count_get_fail.Increment();
+                            if (!get->error.has_value()) {
+                                get->error = outcome.GetError();
+                            }
+                        }
+                        get->failed++;
+                    } else if (get->winner.compare_exchange_strong(no_winner,
+                                                                   attempt)) {
+                        get->received =
+                            ReceivedSize(outcome.GetResult(), get->size);
+                        internal_storage_request_latency_get.Observe(
+                            latency.count());
+                        internal_storage_kv_size_get.Observe(get->received);
+                        internal_storage_op_count_get_suc.Increment();
+                    }
+                    get->cv.notify_all();
+                }
+                read_limit_->OnFinish(outcome.IsSuccess() && latency <= delay);
+                std::lock_guard lck(pending_gets_mutex_);
+                pending_gets_--;
+                pending_gets_cv_.notify_all();
+            });
+    };
+
+    std::unique_lock lck(get->mutex);
+    auto decided = [&get]() {
+        return get->winner.load() >= 0 || get->failed == get->started;
+    };
+    start_attempt(0);
+    // hedging an overloaded endpoint would only add to the load
+    if (!get->cv.wait_for(lck, delay, decided) && read_limit_->HasCapacity()) {
+        internal_storage_op_count_get_hedged.Increment();
+        start_attempt(1);
+    }
+    get->cv.wait(lck, decided);
+    // the caller's buffer must not be written once this returns
+    get->targets[0] = nullptr;
+
+    auto winner = get->winner.load();
+    if (winner < 0) {
+        ThrowS3Error("GetObjectBuffer",
+                     *get->error,
+                     "params, bucket={}, object={}, range={}",
+                     request.GetBucket(),
+                     request.GetKey(),
+                     request.GetRange());
+    }
+    if (winner == 1) {
+        std::memcpy(buf, get->hedge_buf.data(), get->received);
+    }
+    return get->received;
+}
+
+uint64_t
+MinioChunkManager::GetObjectBufferParallel(const std::string& bucket_name,
+                                           const std::string& object_name,
+                                           void* buf,
+                                           uint64_t size) {
+    // shared with the pool tasks, a task that starts after all parts have
+    // been claimed returns without touching anything else
+    struct ParallelReadState {
+        std::string bucket_name;
+        std::string object_name;
+        char* buf;
+        uint64_t size;
+        uint64_t part_size;
+        std::atomic<int64_t> next_part{0};
+        int64_t num_parts;
+        int64_t finished_parts = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<ParallelReadState>();
+    state->bucket_name = bucket_name;
+    state->object_name = object_name;
+    state->buf = static_cast<char*>(buf);
+    state->size = size;
+    state->part_size = read_part_size_;
+    state->num_parts = (size + state->part_size - 1) / state->part_size;
+
+    auto task = [this, state]() {
+        while (true) {
+            auto part = state->next_part.fetch_add(1);
+            if (part >= state->num_parts) {
+                return;
+            }
+            auto offset = part * state->part_size;
+            auto len = std::min(state->part_size, state->size - offset);
+            std::exception_ptr error;
+            try {
+                auto received = GetObjectBuffer(state->bucket_name,
+                                                state->object_name,
+                                                offset,
+                                                state->buf + offset,
+                                                len);
+                AssertInfo(received == len,
+                           "read {} bytes of part {} of object {}, expected {}",
+                           received,
+                           part,
+                           state->object_name,
+                           len);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lck(state->mutex);
+            if (error != nullptr && state->error == nullptr) {
+                state->error = error;
+            }
+            if (++state->finished_parts == state->num_parts) {
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    // the caller downloads parts as well, so the read still makes progress
+    // if the pool is busy with other tasks
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::LOW);
+    auto helpers =
+        std::min({read_concurrency_, state->num_parts, read_limit_->Limit()}) -
+        1;
+    for (int64_t i = 0; i < helpers; i++) {
+        pool.Submit(task);
+    }
+    task();
+
+    std::unique_lock lck(state->mutex);
+    state->cv.wait(
+        lck, [&state]() { return state->finished_parts == state->num_parts; });
+    if (state->error != nullptr) {
+        std::rethrow_exception(state->error);
+    }
     return size;
 }
 
+std::string
+MinioChunkManager::CreateMultipartUpload(const std::string& bucket_name,
+                                         const std::string& object_name) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+
+    auto outcome = client_->CreateMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        internal_storage_op_count_put_fail.Increment();
+        const auto& err = outcome.GetError();
+        ThrowS3Error("CreateMultipartUpload",
+                     err,
+                     "params, bucket={}, object={}",
+                     bucket_name,
+                     object_name);
+    }
+    return outcome.GetResult().GetUploadId();
+}
+
+std::string
+MinioChunkManager::UploadPart(const std::string& bucket_name,
+                              const std::string& object_name,
+                              const std::string& upload_id,
+                              int part_number,
+                              const void* buf,
+                              uint64_t size) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    request.SetUploadId(upload_id.c_str());
+    request.SetPartNumber(part_number);
+
+    Aws::Utils::Stream::PreallocatedStreamBuf stream_buf(
+        reinterpret_cast<unsigned char*>(const_cast<void*>(buf)), size);
+    const std::shared_ptr<Aws::IOStream> input_data =
+        Aws::MakeShared<Aws::IOStream>("UploadPart", &stream_buf);
+    request.SetBody(input_data);
+    request.SetContentLength(size);
+
+    auto start = std::chrono::system_clock::now();
+    auto outcome = client_->UploadPart(request);
+    internal_storage_request_latency_put.Observe(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start)
+            .count());
+    internal_storage_kv_size_put.Observe(size);
+
+    if (!outcome.IsSuccess()) {
+        internal_storage_op_count_put_fail.Increment();
+        const auto& err = outcome.GetError();
+        ThrowS3Error("UploadPart",
+                     err,
+                     "params, bucket={}, object={}, part={}",
+                     bucket_name,
+                     object_name,
+                     part_number);
+    }
+    internal_storage_op_count_put_suc.Increment();
+    return outcome.GetResult().GetETag();
+}
+
+void
+MinioChunkManager::CompleteMultipartUpload(
+    const std::string& bucket_name,
+    const std::string& object_name,
+    const std::string& upload_id,
+    const std::vector<std::string>& etags) {
+    Aws::S3::Model::CompletedMultipartUpload completed_upload;
+    for (int i = 0; i < etags.size(); i++) {
+        completed_upload.AddParts(Aws::S3::Model::CompletedPart()
+                                      .WithETag(etags[i].c_str())
+                                      .WithPartNumber(i + 1));
+    }
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    request.SetUploadId(upload_id.c_str());
+    request.SetMultipartUpload(completed_upload);
+
+    auto outcome = client_->CompleteMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        internal_storage_op_count_put_fail.Increment();
+        const auto& err = outcome.GetError();
+        ThrowS3Error("CompleteMultipartUpload",
+                     err,
+                     "params, bucket={}, object={}",
+                     bucket_name,
+                     object_name);
+    }
+}
+
+void
+MinioChunkManager::AbortMultipartUpload(const std::string& bucket_name,
+                                        const std::string& object_name,
+                                        const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    request.SetUploadId(upload_id.c_str());
+
+    auto outcome = client_->AbortMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        const auto& err = outcome.GetError();
+        ThrowS3Error("AbortMultipartUpload",
+                     err,
+                     "params, bucket={}, object={}",
+                     bucket_name,
+                     object_name);
+    }
+}
+
 std::vector<std::string>
 MinioChunkManager::ListObjects(const std::string& bucket_name,
                                const std::string& prefix) {
@@ -16,9 +16,15 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <aws/core/Aws.h>
@@ -30,6 +36,7 @@
 #include <aws/core/http/standard/StandardHttpRequest.h>
 #include <aws/core/utils/logging/FormattedLogSystem.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/GetObjectRequest.h>
 #include <fmt/core.h>
 #include <google/cloud/credentials.h>
 #include <google/cloud/internal/oauth2_credentials.h>
@@ -41,6 +48,7 @@
 #include "common/EasyAssert.h"
 #include "common/Exception.h"
 #include "storage/ChunkManager.h"
+#include "storage/ReadHedging.h"
 #include "storage/Types.h"
 
 namespace milvus::storage {
@@ -113,10 +121,7 @@ class MinioChunkManager : public ChunkManager {
     Read(const std::string& filepath,
          uint64_t offset,
          void* buf,
-         uint64_t len) {
-        throw SegcoreError(NotImplemented,
-                           GetName() + "Read with offset not implement");
-    }
+         uint64_t len);
 
     virtual void
     Write(const std::string& filepath,
@@ -133,6 +138,10 @@ class MinioChunkManager : public ChunkManager {
     virtual void
     Write(const std::string& filepath, void* buf, uint64_t len);
 
+    // files larger than write_part_size are uploaded with multipart upload
+    virtual ChunkWriterPtr
+    OpenWriter(const std::string& filepath);
+
     virtual std::vector<std::string>
     ListWithPrefix(const std::string& filepath = "");
 
@@ -191,6 +200,34 @@ class MinioChunkManager : public ChunkManager {
                     const std::string& object_name,
                     void* buf,
                     uint64_t size);
+    // get the object bytes in range [offset, offset + size)
+    uint64_t
+    GetObjectBuffer(const std::string& bucket_name,
+                    const std::string& object_name,
+                    uint64_t offset,
+                    void* buf,
+                    uint64_t size);
+
+    std::string
+    CreateMultipartUpload(const std::string& bucket_name,
+                          const std::string& object_name);
+    // return the etag of the uploaded part
+    std::string
+    UploadPart(const std::string& bucket_name,
+               const std::string& object_name,
+               const std::string& upload_id,
+               int part_number,
+               const void* buf,
+               uint64_t size);
+    void
+    CompleteMultipartUpload(const std::string& bucket_name,
+                            const std::string& object_name,
+                            const std::string& upload_id,
+                            const std::vector<std::string>& etags);
+    void
+    AbortMultipartUpload(const std::string& bucket_name,
+                         const std::string& object_name,
+                         const std::string& upload_id);
 
     std::vector<std::string>
     ListObjects(const std::string& bucket_name, const std::string& prefix = "");
@@ -202,6 +239,15 @@ class MinioChunkManager : public ChunkManager {
                bool useIAM,
                const std::string& log_level);
 
+    // the client shared by the chunk managers of the kind built from the
+    // same storage config, so they share its connections and credentials,
+    // built by build on the first call
+    static std::shared_ptr<Aws::S3::S3Client>
+    GetSharedClient(
+        const std::string& kind,
+        const StorageConfig& storage_config,
+        const std::function<std::shared_ptr<Aws::S3::S3Client>()>& build);
+
     // Precheck whether client is configure ready or not.
     void
     PreCheck(const StorageConfig& storage_config);
@@ -223,12 +269,51 @@ class MinioChunkManager : public ChunkManager {
     BuildAccessKeyClient(const StorageConfig& storage_config,
                          const Aws::Client::ClientConfiguration& config);
 
+    uint64_t
+    GetObjectBuffer(Aws::S3::Model::GetObjectRequest& request,
+                    void* buf,
+                    uint64_t size);
+
+    // the time after which a get of size bytes is hedged, none if hedging is
+    // disabled, the get is too large or too few gets have been observed
+    std::optional<std::chrono::milliseconds>
+    HedgeDelay(uint64_t size) const;
+
+    // issue the get, and a duplicate of it if the first hasn't returned
+    // within delay, the bytes of the one that succeeds first are returned
+    uint64_t
+    GetObjectBufferHedged(const Aws::S3::Model::GetObjectRequest& request,
+                          void* buf,
+                          uint64_t size,
+                          std::chrono::milliseconds delay);
+
+    // split the object into ranges of read_part_size_ and download them in
+    // parallel straight into buf
+    uint64_t
+    GetObjectBufferParallel(const std::string& bucket_name,
+                            const std::string& object_name,
+                            void* buf,
+                            uint64_t size);
+
     Aws::SDKOptions sdk_options_;
     static std::atomic<size_t> init_count_;
     static std::mutex client_mutex_;
     std::shared_ptr<Aws::S3::S3Client> client_;
     std::string default_bucket_name_;
     std::string remote_root_path_;
+    int64_t read_part_size_ = DEFAULT_STORAGE_READ_PART_SIZE;
+    int64_t read_concurrency_ = DEFAULT_STORAGE_READ_CONCURRENCY;
+    int64_t write_part_size_ = DEFAULT_STORAGE_WRITE_PART_SIZE;
+    double read_hedge_percentile_ = DEFAULT_STORAGE_READ_HEDGE_PERCENTILE;
+    // bounds the parallel ranges of a read and the hedges of the endpoint
+    std::shared_ptr<AdaptiveConcurrencyLimit> read_limit_ =
+        std::make_shared<AdaptiveConcurrencyLimit>(
+            DEFAULT_STORAGE_READ_CONCURRENCY);
+    // the hedged gets still running on the sdk executor, which uses the
+    // client, so the destructor waits for them
+    std::mutex pending_gets_mutex_;
+    std::condition_variable pending_gets_cv_;
+    int64_t pending_gets_ = 0;
 };
 
 class AwsChunkManager : public MinioChunkManager {
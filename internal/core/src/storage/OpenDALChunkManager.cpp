@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <string>
 
@@ -23,6 +24,7 @@
 #include "common/EasyAssert.h"
 #include "storage/Util.h"
 #include "storage/OpenDALChunkManager.h"
+#include "storage/prometheus_client.h"
 
 namespace milvus::storage {
 
@@ -31,6 +33,13 @@ ToString(opendal_bytes* bs) {
     return {reinterpret_cast<const char*>(bs->data), bs->len};
 }
 
+static int64_t
+ElapsedMs(std::chrono::system_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now() - start)
+        .count();
+}
+
 #define THROWOPENDALERROR(err, msg)                                            \
     do {                                                                       \
         auto exception = SegcoreError(                                         \
@@ -105,10 +114,14 @@ OpenDALChunkManager::~OpenDALChunkManager() {
 
 uint64_t
 OpenDALChunkManager::Size(const std::string& filepath) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_stat(op_ptr_, filepath.c_str());
+    internal_storage_request_latency_stat.Observe(ElapsedMs(start));
     if (ret.error != nullptr) {
+        internal_storage_op_count_stat_fail.Increment();
         THROWOPENDALERROR(ret.error, "GetObjectSize");
     }
+    internal_storage_op_count_stat_suc.Increment();
     auto size = opendal_metadata_content_length(ret.meta);
     opendal_metadata_free(ret.meta);
     return size;
@@ -116,31 +129,42 @@ OpenDALChunkManager::Size(const std::string& filepath) {
 
 bool
 OpenDALChunkManager::Exist(const std::string& filepath) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_is_exist(op_ptr_, filepath.c_str());
+    internal_storage_request_latency_stat.Observe(ElapsedMs(start));
     if (ret.error != nullptr) {
+        internal_storage_op_count_stat_fail.Increment();
         THROWOPENDALERROR(ret.error, "ObjectExists");
     }
+    internal_storage_op_count_stat_suc.Increment();
     return ret.is_exist;
 }
 
 void
 OpenDALChunkManager::Remove(const std::string& filepath) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_delete(op_ptr_, filepath.c_str());
+    internal_storage_request_latency_remove.Observe(ElapsedMs(start));
     if (ret != nullptr) {
+        internal_storage_op_count_remove_fail.Increment();
         THROWOPENDALERROR(ret, "RemoveObject");
     }
+    internal_storage_op_count_remove_suc.Increment();
 }
 
 std::vector<std::string>
 OpenDALChunkManager::ListWithPrefix(const std::string& filepath) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_list(op_ptr_, filepath.c_str());
     if (ret.error != nullptr) {
+        internal_storage_op_count_list_fail.Increment();
         THROWOPENDALERROR(ret.error, "ListObjects");
     }
     auto lister = OpendalLister(ret.lister);
     std::vector<std::string> objects;
     opendal_result_lister_next result = opendal_lister_next(lister.Get());
     if (result.error != nullptr) {
+        internal_storage_op_count_list_fail.Increment();
         THROWOPENDALERROR(result.error, "ListObjects");
     }
     auto entry = result.entry;
@@ -150,10 +174,13 @@ OpenDALChunkManager::ListWithPrefix(const std::string& filepath) {
         opendal_entry_free(entry);
         result = opendal_lister_next(lister.Get());
         if (result.error != nullptr) {
+            internal_storage_op_count_list_fail.Increment();
             THROWOPENDALERROR(result.error, "ListObjects");
         }
         entry = result.entry;
     }
+    internal_storage_request_latency_list.Observe(ElapsedMs(start));
+    internal_storage_op_count_list_suc.Increment();
     return objects;
 }
 
@@ -161,20 +188,24 @@ uint64_t
 OpenDALChunkManager::Read(const std::string& filepath,
                           void* buf,
                           uint64_t size) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_reader(op_ptr_, filepath.c_str());
     if (ret.error != nullptr) {
+        internal_storage_op_count_get_fail.Increment();
         THROWOPENDALERROR(ret.error, "GetObjectBuffer");
     }
     auto reader = OpendalReader(ret.reader);
-    uint64_t buf_size = 16 * 1024;
+    // never read past the end of the caller's buffer, the reader returns as
+    // much as it has buffered up to the requested length
     uint64_t buf_index = 0;
-    while (true) {
+    while (buf_index < size) {
         auto read_ret =
             opendal_reader_read(reader.Get(),
                                 reinterpret_cast<uint8_t*>(buf) + buf_index,
-                                buf_size);
+                                size - buf_index);
         buf_index += read_ret.size;
         if (read_ret.error != nullptr) {
+            internal_storage_op_count_get_fail.Increment();
             THROWOPENDALERROR(read_ret.error, "GetObjectBuffer");
         }
         if (read_ret.size == 0) {
@@ -182,6 +213,7 @@ OpenDALChunkManager::Read(const std::string& filepath,
         }
     }
     if (buf_index != size) {
+        internal_storage_op_count_get_fail.Increment();
         throw SegcoreError(
             S3Error,
             fmt::format(
@@ -189,6 +221,9 @@ OpenDALChunkManager::Read(const std::string& filepath,
                 size,
                 buf_index));
     }
+    internal_storage_request_latency_get.Observe(ElapsedMs(start));
+    internal_storage_op_count_get_suc.Increment();
+    internal_storage_kv_size_get.Observe(size);
     return buf_index;
 }
 
@@ -196,11 +231,16 @@ void
 OpenDALChunkManager::Write(const std::string& filepath,
                            void* buf,
                            uint64_t size) {
+    auto start = std::chrono::system_clock::now();
     auto ret = opendal_operator_write(
         op_ptr_, filepath.c_str(), {reinterpret_cast<uint8_t*>(buf), size});
+    internal_storage_request_latency_put.Observe(ElapsedMs(start));
     if (ret != nullptr) {
+        internal_storage_op_count_put_fail.Increment();
         THROWOPENDALERROR(ret, "Write");
     }
+    internal_storage_op_count_put_suc.Increment();
+    internal_storage_kv_size_put.Observe(size);
 }
 
 }  // namespace milvus::storage
@@ -15,19 +15,196 @@
 // limitations under the License.
 
 #include "storage/PayloadReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
 #include "common/EasyAssert.h"
+#include "common/FieldMeta.h"
+#include "storage/RawPayload.h"
+#include "storage/ThreadPools.h"
 #include "storage/Util.h"
 #include "parquet/column_reader.h"
 #include "arrow/io/api.h"
 #include "arrow/status.h"
 #include "parquet/arrow/reader.h"
+#include "parquet/statistics.h"
 
 namespace milvus::storage {
 
+namespace {
+
+constexpr int64_t kReadBatchSize = 64 * 1024;
+
+// the row groups of a payload decoded at the same time at most
+constexpr int kMaxDecodeParallelism = 8;
+
+// max_def_level is 1 since the payload columns are nullable in the schema
+template <typename ParquetType>
+void
+ReadPlainColumn(parquet::ColumnReader* column_reader,
+                int64_t num_rows,
+                void* dst_data) {
+    using T = typename ParquetType::c_type;
+    auto reader =
+        static_cast<parquet::TypedColumnReader<ParquetType>*>(column_reader);
+    auto dst = static_cast<T*>(dst_data);
+    std::vector<int16_t> def_levels(std::min(kReadBatchSize, num_rows));
+    int64_t total_values_read = 0;
+    while (total_values_read < num_rows && reader->HasNext()) {
+        int64_t values_read = 0;
+        auto levels_read = reader->ReadBatch(
+            std::min(kReadBatchSize, num_rows - total_values_read),
+            def_levels.data(),
+            nullptr,
+            dst + total_values_read,
+            &values_read);
+        AssertInfo(levels_read == values_read,
+                   "null values in payload are not supported");
+        total_values_read += values_read;
+    }
+    AssertInfo(total_values_read == num_rows,
+               "read {} values from payload, expected {}",
+               total_values_read,
+               num_rows);
+}
+
+void
+ReadFixedLenByteArrayColumn(parquet::ColumnReader* column_reader,
+                            int64_t num_rows,
+                            int type_length,
+                            void* dst_data) {
+    auto reader = static_cast<parquet::FixedLenByteArrayReader*>(column_reader);
+    auto dst = static_cast<uint8_t*>(dst_data);
+    auto batch_size = std::min(kReadBatchSize, num_rows);
+    std::vector<parquet::FixedLenByteArray> values(batch_size);
+    std::vector<int16_t> def_levels(batch_size);
+    int64_t total_values_read = 0;
+    while (total_values_read < num_rows && reader->HasNext()) {
+        int64_t values_read = 0;
+        auto levels_read = reader->ReadBatch(
+            std::min(batch_size, num_rows - total_values_read),
+            def_levels.data(),
+            nullptr,
+            values.data(),
+            &values_read);
+        AssertInfo(levels_read == values_read,
+                   "null values in payload are not supported");
+        // values point into the decoded page, copy them to the destination
+        for (int64_t i = 0; i < values_read; i++) {
+            std::memcpy(dst, values[i].ptr, type_length);
+            dst += type_length;
+        }
+        total_values_read += values_read;
+    }
+    AssertInfo(total_values_read == num_rows,
+               "read {} values from payload, expected {}",
+               total_values_read,
+               num_rows);
+}
+
+// decode the row groups in parallel on the high priority pool, which the
+// downloads of the binlogs run on, then rethrow the first error of them.
+// The caller decodes the row groups as well, so it makes progress even if
+// the pool is busy, e.g. with the other decodes waiting
+void
+DecodeRowGroups(int num_row_groups,
+                std::function<void(int)> decode_row_group) {
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    pool.RunClaimed(num_row_groups,
+                    kMaxDecodeParallelism,
+                    [decode_row_group = std::move(decode_row_group)](
+                        int64_t i) { decode_row_group(i); });
+}
+
+// the statistics of the payload of a numeric type, nullopt if a row group
+// has some values but not the min and max of them, e.g. the payloads
+// written without the statistics, or with NaN only
+std::optional<PayloadStatistics>
+ReadPayloadStatistics(const parquet::FileMetaData& file_meta,
+                      DataType data_type,
+                      int64_t column_index) {
+    if (!datatype_is_integer(data_type) && !datatype_is_floating(data_type)) {
+        return std::nullopt;
+    }
+    PayloadStatistics statistics;
+    for (int i = 0; i < file_meta.num_row_groups(); i++) {
+        auto row_group = file_meta.RowGroup(i);
+        auto column_chunk = row_group->ColumnChunk(column_index);
+        auto stats = column_chunk->statistics();
+        if (!column_chunk->is_stats_set() || stats == nullptr ||
+            !stats->HasNullCount()) {
+            return std::nullopt;
+        }
+        PayloadStatistics row_group_statistics;
+        row_group_statistics.num_rows = row_group->num_rows();
+        row_group_statistics.null_count = stats->null_count();
+        if (!stats->HasMinMax()) {
+            if (row_group_statistics.null_count <
+                row_group_statistics.num_rows) {
+                return std::nullopt;
+            }
+            statistics.Merge(row_group_statistics);
+            continue;
+        }
+        // int8 and int16 are stored as int32 in parquet
+        switch (stats->physical_type()) {
+            case parquet::Type::INT32: {
+                auto& typed =
+                    static_cast<const parquet::Int32Statistics&>(*stats);
+                row_group_statistics.min = int64_t(typed.min());
+                row_group_statistics.max = int64_t(typed.max());
+                break;
+            }
+            case parquet::Type::INT64: {
+                auto& typed =
+                    static_cast<const parquet::Int64Statistics&>(*stats);
+                row_group_statistics.min = int64_t(typed.min());
+                row_group_statistics.max = int64_t(typed.max());
+                break;
+            }
+            case parquet::Type::FLOAT: {
+                auto& typed =
+                    static_cast<const parquet::FloatStatistics&>(*stats);
+                row_group_statistics.min = double(typed.min());
+                row_group_statistics.max = double(typed.max());
+                break;
+            }
+            case parquet::Type::DOUBLE: {
+                auto& typed =
+                    static_cast<const parquet::DoubleStatistics&>(*stats);
+                row_group_statistics.min = typed.min();
+                row_group_statistics.max = typed.max();
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+        statistics.Merge(row_group_statistics);
+    }
+    return statistics;
+}
+
+}  // namespace
+
 PayloadReader::PayloadReader(const uint8_t* data,
                              int length,
                              DataType data_type)
     : column_type_(data_type) {
+    if (IsRawPayload(data, length)) {
+        // the values are copied as they are, nothing to decode
+        auto view = ParseRawPayload(data, length);
+        AssertInfo(view.data_type == data_type,
+                   "raw payload of data type {}, expected {}",
+                   view.data_type,
+                   data_type);
+        dim_ = view.dim;
+        field_data_ = CreateFieldData(column_type_, dim_, view.num_rows);
+        field_data_->FillFieldData(view.data, view.num_rows);
+        return;
+    }
     auto input = std::make_shared<arrow::io::BufferReader>(data, length);
     init(input);
 }
@@ -36,10 +213,11 @@ void
 PayloadReader::init(std::shared_ptr<arrow::io::BufferReader> input) {
     arrow::MemoryPool* pool = arrow::default_memory_pool();
 
-    // Configure general Parquet reader settings
+    // Configure general Parquet reader settings, the payload is already in
+    // memory, so the column chunks are sliced from it instead of being
+    // copied through a buffered stream
     auto reader_properties = parquet::ReaderProperties(pool);
-    reader_properties.set_buffer_size(4096 * 4);
-    reader_properties.enable_buffered_stream();
+    reader_properties.disable_buffered_stream();
 
     // Configure Arrow-specific Parquet reader settings
     auto arrow_reader_props = parquet::ArrowReaderProperties();
@@ -68,12 +246,19 @@ PayloadReader::init(std::shared_ptr<arrow::io::BufferReader> input) {
                      file_meta->schema()->Column(column_index), column_type_)
                : 1;
     auto total_num_rows = file_meta->num_rows();
+    statistics_ =
+        ReadPayloadStatistics(*file_meta, column_type_, column_index);
+
+    field_data_ = CreateFieldData(column_type_, dim_, total_num_rows);
+    if (ReadFixedWidthColumn(arrow_reader->parquet_reader(), column_index)) {
+        AssertInfo(field_data_->IsFull(), "field data hasn't been filled done");
+        return;
+    }
 
     std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
     st = arrow_reader->GetRecordBatchReader(&rb_reader);
     AssertInfo(st.ok(), "get record batch reader");
 
-    field_data_ = CreateFieldData(column_type_, dim_, total_num_rows);
     for (arrow::Result<std::shared_ptr<arrow::RecordBatch>> maybe_batch :
          *rb_reader) {
         AssertInfo(maybe_batch.ok(), "get batch record success");
@@ -84,4 +269,84 @@ PayloadReader::init(std::shared_ptr<arrow::io::BufferReader> input) {
     // LOG_SEGCORE_INFO_ << "Peak arrow memory pool size " << pool->max_memory();
 }
 
+bool
+PayloadReader::ReadFixedWidthColumn(parquet::ParquetFileReader* reader,
+                                    int64_t column_index) {
+    // int8 and int16 are stored as int32 in parquet and bool is bit packed,
+    // they still go through arrow arrays
+    switch (column_type_) {
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+        case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_BINARY:
+        case DataType::VECTOR_FLOAT16:
+            break;
+        default:
+            return false;
+    }
+
+    auto file_meta = reader->metadata();
+    auto type_length = file_meta->schema()->Column(column_index)->type_length();
+    int64_t row_bytes = type_length;
+    switch (column_type_) {
+        case DataType::INT32:
+        case DataType::FLOAT:
+            row_bytes = 4;
+            break;
+        case DataType::INT64:
+        case DataType::DOUBLE:
+            row_bytes = 8;
+            break;
+        default:
+            break;
+    }
+
+    // each row group is decoded into its own slice of the field data, which
+    // is located by the rows of the row groups before it
+    auto num_row_groups = file_meta->num_row_groups();
+    std::vector<int64_t> row_offsets(num_row_groups + 1, 0);
+    for (int i = 0; i < num_row_groups; i++) {
+        row_offsets[i + 1] =
+            row_offsets[i] + file_meta->RowGroup(i)->num_rows();
+    }
+    auto total_rows = row_offsets.back();
+    auto dst = static_cast<uint8_t*>(
+        field_data_->PrepareFillFieldData(total_rows));
+
+    DecodeRowGroups(num_row_groups, [&](int i) {
+        auto row_group = reader->RowGroup(i);
+        auto num_rows = row_offsets[i + 1] - row_offsets[i];
+        auto column_reader = row_group->Column(column_index);
+        auto row_group_dst = dst + row_offsets[i] * row_bytes;
+        switch (column_type_) {
+            case DataType::INT32:
+                ReadPlainColumn<parquet::Int32Type>(
+                    column_reader.get(), num_rows, row_group_dst);
+                break;
+            case DataType::INT64:
+                ReadPlainColumn<parquet::Int64Type>(
+                    column_reader.get(), num_rows, row_group_dst);
+                break;
+            case DataType::FLOAT:
+                ReadPlainColumn<parquet::FloatType>(
+                    column_reader.get(), num_rows, row_group_dst);
+                break;
+            case DataType::DOUBLE:
+                ReadPlainColumn<parquet::DoubleType>(
+                    column_reader.get(), num_rows, row_group_dst);
+                break;
+            default:
+                ReadFixedLenByteArrayColumn(column_reader.get(),
+                                            num_rows,
+                                            type_length,
+                                            row_group_dst);
+                break;
+        }
+    });
+    field_data_->CommitFillFieldData(total_rows);
+    return true;
+}
+
 }  // namespace milvus::storage
@@ -17,9 +17,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <parquet/arrow/reader.h>
 
 #include "common/FieldData.h"
+#include "storage/PayloadStatistics.h"
 #include "storage/PayloadStream.h"
 
 namespace milvus::storage {
@@ -38,10 +40,25 @@ class PayloadReader {
         return field_data_;
     }
 
+    // the statistics of the numeric payloads, from the metadata of the row
+    // groups, nullopt if the payload has none of them
+    const std::optional<PayloadStatistics>&
+    get_statistics() const {
+        return statistics_;
+    }
+
+ private:
+    // decode the values of fixed width columns into field_data_ in place,
+    // return false if the column type has to be decoded through arrow
+    bool
+    ReadFixedWidthColumn(parquet::ParquetFileReader* reader,
+                         int64_t column_index);
+
  private:
     DataType column_type_;
     int dim_;
     FieldDataPtr field_data_;
+    std::optional<PayloadStatistics> statistics_;
 };
 
 }  // namespace milvus::storage
@@ -0,0 +1,53 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <variant>
+
+namespace milvus::storage {
+
+// The statistics of the values of numeric payloads, merged from the
+// statistics of the row groups written by PayloadWriter, so the loads know
+// the range of the values without scanning them. The integers are widened to
+// int64 and the floating points to double, NaN isn't counted in the range.
+struct PayloadStatistics {
+    using Value = std::variant<int64_t, double>;
+
+    int64_t num_rows = 0;
+    int64_t null_count = 0;
+    // none if all the values are null
+    std::optional<Value> min;
+    std::optional<Value> max;
+
+    // the statistics of the payloads concatenated, of the same data type
+    void
+    Merge(const PayloadStatistics& other) {
+        num_rows += other.num_rows;
+        null_count += other.null_count;
+        if (other.min.has_value()) {
+            min = min.has_value() ? std::min(*min, *other.min) : other.min;
+        }
+        if (other.max.has_value()) {
+            max = max.has_value() ? std::max(*max, *other.max) : other.max;
+        }
+    }
+};
+
+}  // namespace milvus::storage
@@ -15,12 +15,105 @@
 // limitations under the License.
 
 #include "storage/PayloadWriter.h"
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+#include "arrow/util/compression.h"
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
+#include "storage/RawPayload.h"
 #include "storage/Util.h"
 
 namespace milvus::storage {
 
+namespace {
+
+std::shared_mutex encoding_policies_mutex;
+std::map<DataType, PayloadEncodingPolicy> encoding_policies;
+
+// the parquet encodings of the values of the data type, see
+// CreateArrowSchema for the parquet types of them
+bool
+IsEncodingSupported(DataType data_type, parquet::Encoding::type encoding) {
+    switch (encoding) {
+        case parquet::Encoding::PLAIN:
+            return true;
+        case parquet::Encoding::DELTA_BINARY_PACKED:
+            return datatype_is_integer(data_type);
+        case parquet::Encoding::BYTE_STREAM_SPLIT:
+            return datatype_is_floating(data_type);
+        case parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        case parquet::Encoding::DELTA_BYTE_ARRAY:
+            return datatype_is_variable(data_type);
+        default:
+            return false;
+    }
+}
+
+std::shared_ptr<parquet::WriterProperties>
+CreateWriterProperties(DataType data_type) {
+    auto policy = GetPayloadEncodingPolicy(data_type);
+    parquet::WriterProperties::Builder builder;
+    builder.compression(policy.compression);
+    if (arrow::util::Codec::SupportsCompressionLevel(policy.compression)) {
+        builder.compression_level(policy.compression_level);
+    }
+    builder.encoding(policy.encoding);
+    if (policy.enable_dictionary) {
+        builder.enable_dictionary();
+    } else {
+        builder.disable_dictionary();
+    }
+    if (policy.enable_statistics) {
+        builder.enable_statistics();
+    } else {
+        builder.disable_statistics();
+    }
+    return builder.build();
+}
+
+}  // namespace
+
+PayloadEncodingPolicy
+GetPayloadEncodingPolicy(DataType data_type) {
+    {
+        std::shared_lock lck(encoding_policies_mutex);
+        auto it = encoding_policies.find(data_type);
+        if (it != encoding_policies.end()) {
+            return it->second;
+        }
+    }
+    PayloadEncodingPolicy policy;
+    if (datatype_is_vector(data_type)) {
+        policy.compression = arrow::Compression::UNCOMPRESSED;
+        policy.enable_dictionary = false;
+        policy.enable_statistics = false;
+    }
+    return policy;
+}
+
+void
+SetPayloadEncodingPolicy(DataType data_type,
+                         const PayloadEncodingPolicy& policy) {
+    AssertInfo(arrow::util::Codec::IsAvailable(policy.compression),
+               "compression {} is not available",
+               arrow::util::Codec::GetCodecAsString(policy.compression));
+    AssertInfo(IsEncodingSupported(data_type, policy.encoding),
+               "encoding {} is not supported by data type {}",
+               parquet::EncodingToString(policy.encoding),
+               data_type);
+    AssertInfo(policy.row_group_rows > 0,
+               "invalid rows of row group: {}",
+               policy.row_group_rows);
+    AssertInfo(!policy.raw_layout || datatype_is_vector(data_type),
+               "raw layout of data type {} is not supported",
+               data_type);
+    std::unique_lock lck(encoding_policies_mutex);
+    encoding_policies[data_type] = policy;
+}
+
 // create payload writer for numeric data type
 PayloadWriter::PayloadWriter(const DataType column_type)
     : column_type_(column_type) {
@@ -43,6 +136,7 @@ PayloadWriter::init_dimension(int dim) {
     }
 
     dimension_ = dim;
+    raw_layout_ = GetPayloadEncodingPolicy(column_type_).raw_layout;
     builder_ = CreateArrowBuilder(column_type_, dim);
     schema_ = CreateArrowSchema(column_type_, dim);
 }
@@ -65,7 +159,7 @@ PayloadWriter::add_one_binary_payload(const uint8_t* data, int length) {
 
 void
 PayloadWriter::add_payload(const Payload& raw_data) {
-    AssertInfo(output_ == nullptr, "payload writer has been finished");
+    AssertInfo(!has_finished(), "payload writer has been finished");
     AssertInfo(column_type_ == raw_data.data_type, "mismatch data type");
     AssertInfo(builder_ != nullptr, "empty arrow builder");
     if (milvus::datatype_is_vector(column_type_)) {
@@ -73,13 +167,28 @@ PayloadWriter::add_payload(const Payload& raw_data) {
         AssertInfo(dimension_ == raw_data.dimension, "inconsistent dimension");
     }
 
-    AddPayloadToArrowBuilder(builder_, raw_data);
+    if (raw_layout_) {
+        auto size = raw_data.rows * datatype_sizeof(column_type_, *dimension_);
+        raw_values_.insert(
+            raw_values_.end(), raw_data.raw_data, raw_data.raw_data + size);
+    } else {
+        AddPayloadToArrowBuilder(builder_, raw_data);
+    }
     rows_.fetch_add(raw_data.rows);
 }
 
 void
-PayloadWriter::finish() {
-    AssertInfo(output_ == nullptr, "payload writer has been finished");
+PayloadWriter::finish(int64_t payload_offset) {
+    AssertInfo(!has_finished(), "payload writer has been finished");
+    if (raw_layout_) {
+        raw_payload_ = SerializeRawPayload(column_type_,
+                                           raw_values_.data(),
+                                           rows_,
+                                           *dimension_,
+                                           payload_offset);
+        raw_values_ = std::vector<uint8_t>();
+        return;
+    }
     std::shared_ptr<arrow::Array> array;
     auto ast = builder_->Finish(&array);
     AssertInfo(ast.ok(), ast.ToString());
@@ -87,24 +196,25 @@ PayloadWriter::finish() {
     auto table = arrow::Table::Make(schema_, {array});
     output_ = std::make_shared<storage::PayloadOutputStream>();
     auto mem_pool = arrow::default_memory_pool();
-    ast = parquet::arrow::WriteTable(*table,
-                                     mem_pool,
-                                     output_,
-                                     1024 * 1024 * 1024,
-                                     parquet::WriterProperties::Builder()
-                                         .compression(arrow::Compression::ZSTD)
-                                         ->compression_level(3)
-                                         ->build());
+    ast = parquet::arrow::WriteTable(
+        *table,
+        mem_pool,
+        output_,
+        GetPayloadEncodingPolicy(column_type_).row_group_rows,
+        CreateWriterProperties(column_type_));
     AssertInfo(ast.ok(), ast.ToString());
 }
 
 bool
 PayloadWriter::has_finished() {
-    return output_ != nullptr;
+    return output_ != nullptr || raw_payload_.has_value();
 }
 
 const std::vector<uint8_t>&
 PayloadWriter::get_payload_buffer() const {
+    if (raw_payload_.has_value()) {
+        return *raw_payload_;
+    }
     AssertInfo(output_ != nullptr, "payload writer has not been finished");
     return output_->Buffer();
 }
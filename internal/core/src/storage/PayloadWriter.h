@@ -17,12 +17,52 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "storage/PayloadStream.h"
 #include <parquet/arrow/writer.h>
 
 namespace milvus::storage {
+
+// the rows of a row group of the payloads, the row groups are decoded in
+// parallel and their statistics bound the values of each of them
+constexpr int64_t DEFAULT_PAYLOAD_ROW_GROUP_ROWS = 64 * 1024;
+
+// How the column of the binlogs of a data type is compressed and encoded.
+// Parquet records both in the metadata of the column chunks, so the readers
+// decode the binlogs of any policy without being configured.
+struct PayloadEncodingPolicy {
+    arrow::Compression::type compression = arrow::Compression::ZSTD;
+    // ignored by the codecs without levels
+    int compression_level = 3;
+    // the encoding of the values, or the fallback one of the pages beyond
+    // the dictionary if it's enabled, e.g. DELTA_BINARY_PACKED for the
+    // integers and BYTE_STREAM_SPLIT for the floating points
+    parquet::Encoding::type encoding = parquet::Encoding::PLAIN;
+    bool enable_dictionary = true;
+    // write the min, max and null count of every row group, see
+    // PayloadStatistics.h
+    bool enable_statistics = true;
+    int64_t row_group_rows = DEFAULT_PAYLOAD_ROW_GROUP_ROWS;
+    // write the vectors in the raw layout instead of parquet, see
+    // RawPayload.h, the other fields are ignored then
+    bool raw_layout = false;
+};
+
+// the policy of the data type, ZSTD with the dictionary and the statistics
+// by default, but uncompressed and without the dictionary for the vectors,
+// which are hardly compressed while costing the CPU of both the flushes and
+// the loads, nor the statistics, as their min and max bound nothing
+PayloadEncodingPolicy
+GetPayloadEncodingPolicy(DataType data_type);
+
+// set the policy of the binlogs of the data type written from now on, the
+// encoding must be supported by the parquet type of the data type
+void
+SetPayloadEncodingPolicy(DataType data_type,
+                         const PayloadEncodingPolicy& policy);
+
 class PayloadWriter {
  public:
     explicit PayloadWriter(const DataType column_type);
@@ -38,8 +78,10 @@ class PayloadWriter {
     void
     add_one_binary_payload(const uint8_t* data, int length);
 
+    // payload_offset is the offset of the payload in the binlog, which the
+    // values of the raw layout are aligned by
     void
-    finish();
+    finish(int64_t payload_offset = 0);
 
     bool
     has_finished();
@@ -63,5 +105,9 @@ class PayloadWriter {
     std::shared_ptr<PayloadOutputStream> output_;
     std::atomic<int> rows_ = 0;
     std::optional<int> dimension_;  // binary vector, float vector
+    // the values and the payload of the raw layout
+    bool raw_layout_ = false;
+    std::vector<uint8_t> raw_values_;
+    std::optional<std::vector<uint8_t>> raw_payload_;
 };
 }  // namespace milvus::storage
@@ -0,0 +1,112 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/RawPayload.h"
+
+#include <boost/crc.hpp>
+#include <cstring>
+
+#include "common/EasyAssert.h"
+#include "common/FieldMeta.h"
+
+namespace milvus::storage {
+
+namespace {
+
+uint32_t
+Checksum(const uint8_t* data, uint64_t size) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+}  // namespace
+
+bool
+IsRawPayload(const uint8_t* payload, int64_t length) {
+    return length >= static_cast<int64_t>(sizeof(RawPayloadHeader)) &&
+           std::memcmp(payload, RAW_PAYLOAD_MAGIC, sizeof(RAW_PAYLOAD_MAGIC)) ==
+               0;
+}
+
+std::vector<uint8_t>
+SerializeRawPayload(DataType data_type,
+                    const uint8_t* data,
+                    int64_t num_rows,
+                    int64_t dim,
+                    int64_t payload_offset) {
+    AssertInfo(datatype_is_vector(data_type),
+               "raw payload of data type {} is not supported",
+               data_type);
+    RawPayloadHeader header{};
+    std::memcpy(header.magic, RAW_PAYLOAD_MAGIC, sizeof(RAW_PAYLOAD_MAGIC));
+    header.version = RAW_PAYLOAD_VERSION;
+    header.data_type = static_cast<int32_t>(data_type);
+    header.num_rows = num_rows;
+    header.dim = dim;
+    auto data_start = payload_offset + sizeof(RawPayloadHeader);
+    auto padding = (RAW_PAYLOAD_ALIGNMENT -
+                    data_start % RAW_PAYLOAD_ALIGNMENT) %
+                   RAW_PAYLOAD_ALIGNMENT;
+    header.data_offset = sizeof(RawPayloadHeader) + padding;
+    header.data_size = num_rows * datatype_sizeof(data_type, dim);
+    header.checksum = Checksum(data, header.data_size);
+
+    std::vector<uint8_t> payload(header.data_offset + header.data_size, 0);
+    std::memcpy(payload.data(), &header, sizeof(header));
+    std::memcpy(payload.data() + header.data_offset, data, header.data_size);
+    return payload;
+}
+
+RawPayloadView
+ParseRawPayload(const uint8_t* payload,
+                int64_t length,
+                bool verify_checksum) {
+    AssertInfo(IsRawPayload(payload, length), "not a raw payload");
+    RawPayloadHeader header;
+    std::memcpy(&header, payload, sizeof(header));
+    AssertInfo(header.version == RAW_PAYLOAD_VERSION,
+               "unsupported raw payload version {}",
+               header.version);
+    auto data_type = static_cast<DataType>(header.data_type);
+    AssertInfo(datatype_is_vector(data_type),
+               "raw payload of data type {} is not supported",
+               data_type);
+    AssertInfo(header.data_size ==
+                   header.num_rows * datatype_sizeof(data_type, header.dim),
+               "raw payload of {} rows of dim {} has {} bytes",
+               header.num_rows,
+               header.dim,
+               header.data_size);
+    AssertInfo(header.data_offset + header.data_size <=
+                   static_cast<uint64_t>(length),
+               "raw payload of {} bytes is truncated to {} bytes",
+               header.data_offset + header.data_size,
+               length);
+
+    RawPayloadView view{data_type,
+                        header.num_rows,
+                        header.dim,
+                        payload + header.data_offset,
+                        header.data_size};
+    if (verify_checksum) {
+        AssertInfo(Checksum(view.data, view.data_size) == header.checksum,
+                   "checksum mismatch of raw payload");
+    }
+    return view;
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,83 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::storage {
+
+// The raw layout of the payloads of the fixed width vectors, an alternative
+// to parquet for the binlogs whose values are read as they are:
+//
+// -----------------------------------------------------------
+// | RawPayloadHeader | padding | values of num_rows * row_size |
+// -----------------------------------------------------------
+//
+// The values start at data_offset from the payload, padded so that they're
+// aligned to RAW_PAYLOAD_ALIGNMENT in the binlog file, thus a column can
+// read or map them from the downloaded binlog without decoding. The
+// checksum is the CRC32 of the values. Only the readers of segcore know the
+// layout, keep it off for the binlogs read by the other components.
+constexpr char RAW_PAYLOAD_MAGIC[8] = {'M', 'V', 'R', 'A', 'W', 'V', 'E', 'C'};
+constexpr int32_t RAW_PAYLOAD_VERSION = 1;
+constexpr int64_t RAW_PAYLOAD_ALIGNMENT = 64;
+
+struct RawPayloadHeader {
+    char magic[8];
+    int32_t version;
+    int32_t data_type;
+    int64_t num_rows;
+    int64_t dim;
+    // from the start of the payload
+    uint64_t data_offset;
+    uint64_t data_size;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+static_assert(sizeof(RawPayloadHeader) == 56,
+              "the raw payload header must have no implicit padding");
+
+// the values of a raw payload, pointing into the payload parsed
+struct RawPayloadView {
+    DataType data_type;
+    int64_t num_rows;
+    int64_t dim;
+    const uint8_t* data;
+    uint64_t data_size;
+};
+
+bool
+IsRawPayload(const uint8_t* payload, int64_t length);
+
+// the raw payload of the values, which is at payload_offset of the binlog
+std::vector<uint8_t>
+SerializeRawPayload(DataType data_type,
+                    const uint8_t* data,
+                    int64_t num_rows,
+                    int64_t dim,
+                    int64_t payload_offset);
+
+// parse the raw payload, and verify the checksum of the values if asked
+RawPayloadView
+ParseRawPayload(const uint8_t* payload,
+                int64_t length,
+                bool verify_checksum = true);
+
+}  // namespace milvus::storage
@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/ReadHedging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace milvus::storage {
+
+std::optional<double>
+HistogramPercentile(const prometheus::Histogram& histogram,
+                    double percentile,
+                    int64_t min_samples) {
+    auto metric = histogram.Collect().histogram;
+    if (metric.sample_count == 0 ||
+        metric.sample_count < static_cast<uint64_t>(min_samples)) {
+        return std::nullopt;
+    }
+    auto rank = std::ceil(percentile * metric.sample_count);
+    for (const auto& bucket : metric.bucket) {
+        if (bucket.cumulative_count >= rank) {
+            if (std::isinf(bucket.upper_bound)) {
+                return std::nullopt;
+            }
+            return bucket.upper_bound;
+        }
+    }
+    return std::nullopt;
+}
+
+AdaptiveConcurrencyLimit::AdaptiveConcurrencyLimit(int64_t max_limit)
+    : max_limit_(std::max<int64_t>(max_limit, 1)),
+      limit_(max_limit_),
+      since_decrease_(max_limit_) {
+}
+
+std::shared_ptr<AdaptiveConcurrencyLimit>
+AdaptiveConcurrencyLimit::ForEndpoint(const std::string& endpoint,
+                                      int64_t max_limit) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string,
+                              std::shared_ptr<AdaptiveConcurrencyLimit>>
+        limits;
+    std::lock_guard lck(mutex);
+    auto& limit = limits[endpoint];
+    if (limit == nullptr) {
+        limit = std::make_shared<AdaptiveConcurrencyLimit>(max_limit);
+    }
+    return limit;
+}
+
+int64_t
+AdaptiveConcurrencyLimit::Limit() const {
+    std::lock_guard lck(mutex_);
+    return limit_;
+}
+
+bool
+AdaptiveConcurrencyLimit::HasCapacity() const {
+    std::lock_guard lck(mutex_);
+    return inflight_ < limit_;
+}
+
+void
+AdaptiveConcurrencyLimit::OnStart() {
+    std::lock_guard lck(mutex_);
+    inflight_++;
+}
+
+void
+AdaptiveConcurrencyLimit::OnFinish(bool in_time) {
+    std::lock_guard lck(mutex_);
+    inflight_--;
+    since_decrease_++;
+    if (!in_time) {
+        in_time_ = 0;
+        if (since_decrease_ >= limit_) {
+            limit_ = std::max<int64_t>(limit_ / 2, 1);
+            since_decrease_ = 0;
+        }
+        return;
+    }
+    if (++in_time_ >= limit_) {
+        limit_ = std::min(limit_ + 1, max_limit_);
+        in_time_ = 0;
+    }
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <prometheus/histogram.h>
+
+namespace milvus::storage {
+
+// The upper bound of the bucket of the histogram the percentile (0, 1] of
+// the observed values falls in, none if the histogram has observed fewer
+// than min_samples values or the percentile falls beyond the largest bound.
+std::optional<double>
+HistogramPercentile(const prometheus::Histogram& histogram,
+                    double percentile,
+                    int64_t min_samples);
+
+// An additive increase, multiplicative decrease limit of the concurrent
+// requests to an endpoint. Every limit requests completed in time raise the
+// limit by one, a slow or failed request halves it, at most once per limit
+// requests so a burst of slow requests doesn't collapse it.
+class AdaptiveConcurrencyLimit {
+ public:
+    explicit AdaptiveConcurrencyLimit(int64_t max_limit);
+
+    // the limit shared by the chunk managers of the endpoint, created with
+    // the max limit of the first one
+    static std::shared_ptr<AdaptiveConcurrencyLimit>
+    ForEndpoint(const std::string& endpoint, int64_t max_limit);
+
+    int64_t
+    Limit() const;
+
+    // whether one more request fits in the limit
+    bool
+    HasCapacity() const;
+
+    void
+    OnStart();
+
+    void
+    OnFinish(bool in_time);
+
+ private:
+    mutable std::mutex mutex_;
+    const int64_t max_limit_;
+    int64_t limit_;
+    int64_t inflight_ = 0;
+    // the requests completed in time since the last increase
+    int64_t in_time_ = 0;
+    // the requests completed since the last decrease
+    int64_t since_decrease_;
+};
+
+}  // namespace milvus::storage
@@ -19,6 +19,7 @@
 #include <memory>
 #include <shared_mutex>
 
+#include "storage/DiskCacheChunkManager.h"
 #include "storage/Util.h"
 #include "opendal.h"
 
@@ -47,6 +48,24 @@ class RemoteChunkManagerSingleton {
         }
     }
 
+    // wrap the remote chunk manager with a disk cache of the files read
+    void
+    EnableDiskCache(const std::string& cache_path, int64_t capacity_bytes) {
+        AssertInfo(rcm_ != nullptr, "remote chunk manager is not initialized");
+        if (std::dynamic_pointer_cast<DiskCacheChunkManager>(rcm_) ==
+            nullptr) {
+            rcm_ = std::make_shared<DiskCacheChunkManager>(
+                rcm_, cache_path, capacity_bytes);
+        }
+    }
+
+    // replace the remote chunk manager, e.g. by an emulation of the remote
+    // storage in the benchmarks
+    void
+    SetRemoteChunkManager(ChunkManagerPtr rcm) {
+        rcm_ = std::move(rcm);
+    }
+
     void
     Release() {
     }
@@ -0,0 +1,230 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/SearchMetrics.h"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "storage/prometheus_client.h"
+
+namespace milvus::storage {
+
+namespace {
+
+const char*
+SearchStageLabel(SearchStage stage) {
+    switch (stage) {
+        case SearchStage::Filter:
+            return "filter";
+        case SearchStage::TimestampFilter:
+            return "timestamp_filter";
+        case SearchStage::MaskWithDelete:
+            return "mask_with_delete";
+        case SearchStage::VectorSearch:
+            return "vector_search";
+        case SearchStage::Reduce:
+            return "reduce";
+        case SearchStage::BulkSubscript:
+            return "bulk_subscript";
+    }
+    return "unknown";
+}
+
+// the observations of a histogram not flushed yet
+struct LocalHistogram {
+    prometheus::Histogram* histogram = nullptr;
+    std::vector<double> bucket_increments;
+    double sum = 0;
+    bool dirty = false;
+};
+
+class LocalSearchStageHistograms {
+ public:
+    ~LocalSearchStageHistograms() {
+        Flush();
+    }
+
+    void
+    Observe(SearchStage stage,
+            const std::string& segment_type,
+            const std::string& index_type,
+            int64_t latency_us) {
+        auto& local = Get(stage, segment_type, index_type);
+        // the bucket of a value is the first one not below it, as the
+        // histogram does for the observations one by one
+        auto& boundaries = searchLatencyBuckets;
+        auto bucket = std::lower_bound(boundaries.begin(),
+                                       boundaries.end(),
+                                       static_cast<double>(latency_us)) -
+                      boundaries.begin();
+        local.bucket_increments[bucket] += 1;
+        local.sum += latency_us;
+        local.dirty = true;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_flush_ >= FLUSH_INTERVAL) {
+            Flush();
+            last_flush_ = now;
+        }
+    }
+
+    void
+    Flush() {
+        for (auto& [key, local] : histograms_) {
+            if (!local.dirty) {
+                continue;
+            }
+            local.histogram->ObserveMultiple(local.bucket_increments,
+                                             local.sum);
+            std::fill(local.bucket_increments.begin(),
+                      local.bucket_increments.end(),
+                      0);
+            local.sum = 0;
+            local.dirty = false;
+        }
+    }
+
+ private:
+    LocalHistogram&
+    Get(SearchStage stage,
+        const std::string& segment_type,
+        const std::string& index_type) {
+        auto key = std::make_tuple(stage, segment_type, index_type);
+        auto it = histograms_.find(key);
+        if (it != histograms_.end()) {
+            return it->second;
+        }
+        // the family locks to add the histogram, only once per thread
+        LocalHistogram local;
+        local.histogram = &internal_core_search_latency_family.Add(
+            {{"search_stage", SearchStageLabel(stage)},
+             {"segment_type", segment_type},
+             {"index_type", index_type}},
+            searchLatencyBuckets);
+        local.bucket_increments.assign(searchLatencyBuckets.size() + 1, 0);
+        return histograms_.emplace(key, std::move(local)).first->second;
+    }
+
+ private:
+    using Key = std::tuple<SearchStage, std::string, std::string>;
+    std::map<Key, LocalHistogram> histograms_;
+    std::chrono::steady_clock::time_point last_flush_ =
+        std::chrono::steady_clock::now();
+};
+
+LocalSearchStageHistograms&
+GetLocalHistograms() {
+    thread_local LocalSearchStageHistograms histograms;
+    return histograms;
+}
+
+struct PageFaultCounters {
+    prometheus::Counter* major;
+    prometheus::Counter* minor;
+};
+
+const PageFaultCounters&
+GetPageFaultCounters(SegmentType segment_type) {
+    static const auto counters = [] {
+        auto& family = internal_core_search_page_fault_count_family;
+        std::array<PageFaultCounters, SegmentType::Indexing + 1> counters{};
+        for (size_t i = 0; i < counters.size(); ++i) {
+            auto label = SegmentTypeLabel(SegmentType(i));
+            counters[i].major =
+                &family.Add({{"fault_type", "major"}, {"segment_type", label}});
+            counters[i].minor =
+                &family.Add({{"fault_type", "minor"}, {"segment_type", label}});
+        }
+        return counters;
+    }();
+    return counters.at(segment_type);
+}
+
+#ifdef __linux__
+bool
+GetThreadPageFaults(int64_t& major_faults, int64_t& minor_faults) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+        return false;
+    }
+    major_faults = usage.ru_majflt;
+    minor_faults = usage.ru_minflt;
+    return true;
+}
+#endif
+
+}  // namespace
+
+std::string
+SegmentTypeLabel(SegmentType segment_type) {
+    switch (segment_type) {
+        case SegmentType::Growing:
+            return "growing";
+        case SegmentType::Sealed:
+            return "sealed";
+        case SegmentType::Indexing:
+            return "indexing";
+        default:
+            return "invalid";
+    }
+}
+
+std::string
+IndexTypeLabel(const std::string& index_type) {
+    return index_type.empty() ? "none" : index_type;
+}
+
+void
+ObserveSearchStage(SearchStage stage,
+                   const std::string& segment_type,
+                   const std::string& index_type,
+                   int64_t latency_us) {
+    GetLocalHistograms().Observe(stage, segment_type, index_type, latency_us);
+}
+
+void
+FlushSearchStageHistograms() {
+    GetLocalHistograms().Flush();
+}
+
+PageFaultCounter::PageFaultCounter(SegmentType segment_type)
+    : segment_type_(segment_type) {
+#ifdef __linux__
+    valid_ = GetThreadPageFaults(major_faults_, minor_faults_);
+#endif
+}
+
+PageFaultCounter::~PageFaultCounter() {
+#ifdef __linux__
+    int64_t major_faults = 0;
+    int64_t minor_faults = 0;
+    if (!valid_ || !GetThreadPageFaults(major_faults, minor_faults)) {
+        return;
+    }
+    auto& counters = GetPageFaultCounters(segment_type_);
+    if (major_faults > major_faults_) {
+        counters.major->Increment(major_faults - major_faults_);
+    }
+    if (minor_faults > minor_faults_) {
+        counters.minor->Increment(minor_faults - minor_faults_);
+    }
+#endif
+}
+
+}  // namespace milvus::storage
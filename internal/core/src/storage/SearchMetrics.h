@@ -0,0 +1,108 @@
+// Copyright (C) 2019-2023 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "common/type_c.h"
+
+namespace milvus::storage {
+
+enum class SearchStage {
+    Filter = 0,
+    TimestampFilter,
+    MaskWithDelete,
+    VectorSearch,
+    Reduce,
+    BulkSubscript,
+};
+
+// the label of the segment type, or of the index type which is empty if the
+// field is searched by brute force
+std::string
+SegmentTypeLabel(SegmentType segment_type);
+
+std::string
+IndexTypeLabel(const std::string& index_type);
+
+// Observe the latency(us) of the stage into the internal_core_search_latency
+// histogram labelled by the stage, the segment type and the index type.
+//
+// The observations are aggregated into the buckets of the thread, and flushed
+// into the histogram at most once per FLUSH_INTERVAL, or once the thread
+// exits, so the searches take no lock shared by the threads. The buckets of a
+// thread idle since are flushed by its next observation.
+void
+ObserveSearchStage(SearchStage stage,
+                   const std::string& segment_type,
+                   const std::string& index_type,
+                   int64_t latency_us);
+
+// flush the buckets of the thread into the histograms now
+void
+FlushSearchStageHistograms();
+
+constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};
+
+// Observe the latency of the stage from the construction to the destruction
+class SearchStageTimer {
+ public:
+    SearchStageTimer(SearchStage stage,
+                     std::string segment_type,
+                     std::string index_type)
+        : stage_(stage),
+          segment_type_(std::move(segment_type)),
+          index_type_(std::move(index_type)),
+          start_(std::chrono::steady_clock::now()) {
+    }
+
+    SearchStageTimer(const SearchStageTimer&) = delete;
+    SearchStageTimer&
+    operator=(const SearchStageTimer&) = delete;
+
+    ~SearchStageTimer() {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_);
+        ObserveSearchStage(stage_, segment_type_, index_type_, latency.count());
+    }
+
+ private:
+    SearchStage stage_;
+    std::string segment_type_;
+    std::string index_type_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Count the page faults of the thread from the construction to the
+// destruction into internal_core_search_page_fault_count, like the ones of
+// the mmapped columns and indexes read by a search. Counted on linux only.
+class PageFaultCounter {
+ public:
+    explicit PageFaultCounter(SegmentType segment_type);
+
+    PageFaultCounter(const PageFaultCounter&) = delete;
+    PageFaultCounter&
+    operator=(const PageFaultCounter&) = delete;
+
+    ~PageFaultCounter();
+
+ private:
+    SegmentType segment_type_;
+    bool valid_ = false;
+    int64_t major_faults_ = 0;
+    int64_t minor_faults_ = 0;
+};
+
+}  // namespace milvus::storage
@@ -0,0 +1,224 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/SharedMmapStore.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <random>
+
+#include "common/EasyAssert.h"
+#include "fmt/core.h"
+#include "log/Log.h"
+
+namespace milvus::storage {
+
+namespace {
+
+constexpr std::string_view REF_SUFFIX = ".ref";
+constexpr std::string_view TMP_INFIX = ".tmp.";
+
+uint64_t
+Fnv1a(const void* data, size_t size, uint64_t hash) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+    return hash;
+}
+
+int
+FlockRetry(int fd, int operation) {
+    int ret;
+    do {
+        ret = flock(fd, operation);
+    } while (ret != 0 && errno == EINTR);
+    return ret;
+}
+
+// whether the locked fd is of the ref file still linked at the path, the
+// last holder may have removed it before the fd is locked
+bool
+IsLinked(int fd, const std::filesystem::path& ref_path) {
+    struct stat locked, linked;
+    return fstat(fd, &locked) == 0 && stat(ref_path.c_str(), &linked) == 0 &&
+           locked.st_dev == linked.st_dev && locked.st_ino == linked.st_ino;
+}
+
+// open and lock the ref file, nullopt if it's locked by the others with
+// LOCK_NB
+std::optional<int>
+LockRef(const std::filesystem::path& ref_path, int operation) {
+    while (true) {
+        auto fd = open(ref_path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        AssertInfo(fd != -1,
+                   "failed to open shared mmap ref file {}: {}",
+                   ref_path.c_str(),
+                   strerror(errno));
+        if (FlockRetry(fd, operation) != 0) {
+            auto err = errno;
+            close(fd);
+            AssertInfo(err == EWOULDBLOCK,
+                       "failed to lock shared mmap ref file {}: {}",
+                       ref_path.c_str(),
+                       strerror(err));
+            return std::nullopt;
+        }
+        if (IsLinked(fd, ref_path)) {
+            return fd;
+        }
+        close(fd);
+    }
+}
+
+std::filesystem::path
+RefPath(const std::filesystem::path& path) {
+    return path.string() + std::string(REF_SUFFIX);
+}
+
+}  // namespace
+
+std::mutex SharedMmapStore::instance_mutex_;
+std::shared_ptr<SharedMmapStore> SharedMmapStore::instance_ = nullptr;
+
+SharedMmapStore::SharedMmapStore(std::filesystem::path dir)
+    : dir_(std::move(dir)) {
+    std::filesystem::create_directories(dir_);
+    RemoveUnheld();
+    LOG_SEGCORE_INFO_ << "Init shared mmap store at " << dir_.string();
+}
+
+void
+SharedMmapStore::Init(const std::string& dir) {
+    std::lock_guard lck(instance_mutex_);
+    if (instance_ == nullptr) {
+        instance_ = std::make_shared<SharedMmapStore>(
+            std::filesystem::path(dir) / "shared");
+    }
+}
+
+std::shared_ptr<SharedMmapStore>
+SharedMmapStore::Get() {
+    std::lock_guard lck(instance_mutex_);
+    return instance_;
+}
+
+std::string
+SharedMmapStore::Key(std::string_view kind,
+                     std::vector<std::string> files,
+                     std::string_view params) {
+    std::sort(files.begin(), files.end());
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto& file : files) {
+        hash = Fnv1a(file.data(), file.size(), hash);
+        // a separator so that the files can't be split differently
+        hash = Fnv1a("", 1, hash);
+    }
+    hash = Fnv1a(params.data(), params.size(), hash);
+    return fmt::format("{}-{:016x}", kind, hash);
+}
+
+SharedMmapStore::Lease::~Lease() {
+    // the last holder takes the exclusive lock, a process opening the ref
+    // file meanwhile finds it removed once locked and creates another one
+    if (FlockRetry(ref_fd_, LOCK_EX | LOCK_NB) == 0) {
+        unlink(path_.c_str());
+        unlink(ref_path_.c_str());
+    }
+    close(ref_fd_);
+}
+
+SharedMmapStore::LeasePtr
+SharedMmapStore::Acquire(const std::string& key, const Writer& write) {
+    auto path = dir_ / key;
+    auto ref_path = RefPath(path);
+    auto lease =
+        std::make_shared<Lease>(path, ref_path, *LockRef(ref_path, LOCK_SH));
+    if (std::filesystem::exists(path)) {
+        return lease;
+    }
+
+    static thread_local std::mt19937_64 rng{std::random_device{}()};
+    auto tmp_path =
+        dir_ / fmt::format("{}{}{:016x}", key, TMP_INFIX, uint64_t(rng()));
+    try {
+        write(tmp_path.string());
+    } catch (...) {
+        unlink(tmp_path.c_str());
+        throw;
+    }
+    // keep the first one published if written concurrently
+    auto ok = link(tmp_path.c_str(), path.c_str());
+    auto err = errno;
+    unlink(tmp_path.c_str());
+    AssertInfo(ok == 0 || err == EEXIST,
+               "failed to publish shared mmap file {}: {}",
+               path.c_str(),
+               strerror(err));
+    return lease;
+}
+
+void
+SharedMmapStore::RemoveUnheld() {
+    // the temporary files of each key
+    std::map<std::string, std::vector<std::filesystem::path>> keys;
+    for (auto& entry : std::filesystem::directory_iterator(dir_)) {
+        auto name = entry.path().filename().string();
+        auto tmp_pos = name.find(TMP_INFIX);
+        if (tmp_pos != std::string::npos) {
+            keys[name.substr(0, tmp_pos)].push_back(entry.path());
+        } else if (name.size() > REF_SUFFIX.size() &&
+                   name.compare(name.size() - REF_SUFFIX.size(),
+                                REF_SUFFIX.size(),
+                                REF_SUFFIX) == 0) {
+            keys[name.substr(0, name.size() - REF_SUFFIX.size())];
+        } else {
+            keys[name];
+        }
+    }
+
+    int64_t removed = 0;
+    for (auto& [key, tmp_paths] : keys) {
+        auto path = dir_ / key;
+        auto ref_path = RefPath(path);
+        // the writers hold the shared lock as well, so the temporary files
+        // of a key exclusively locked are left by the exited processes
+        auto fd = LockRef(ref_path, LOCK_EX | LOCK_NB);
+        if (!fd.has_value()) {
+            continue;
+        }
+        for (auto& tmp_path : tmp_paths) {
+            unlink(tmp_path.c_str());
+        }
+        unlink(path.c_str());
+        unlink(ref_path.c_str());
+        close(*fd);
+        ++removed;
+    }
+    if (removed > 0) {
+        LOG_SEGCORE_INFO_ << "removed " << removed
+                          << " unreferenced files of shared mmap store "
+                          << dir_.string();
+    }
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,138 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/File.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief SharedMmapStore keeps the files to mmap under a directory shared by
+ * the processes of a host, so the replicas of a segment loaded by several
+ * processes map the same file and share its pages, written once by the first
+ * one to load it. The files are named by the keys of their content, built
+ * from the remote objects they are written from, which are never modified
+ * once uploaded.
+ *
+ * Every holder of a file keeps a shared flock on the ref file of its key, the
+ * last one to release it on the host removes both. A file is written to a
+ * temporary file and published by linking it under its key, so a published
+ * file is always complete. The files left by the processes exited without
+ * releasing them are removed once the store is opened again.
+ */
+class SharedMmapStore {
+ public:
+    explicit SharedMmapStore(std::filesystem::path dir);
+
+    SharedMmapStore(const SharedMmapStore&) = delete;
+    SharedMmapStore&
+    operator=(const SharedMmapStore&) = delete;
+
+    // share the files under {dir}/shared, dir is the mmap directory of the
+    // node, the same for the processes to share the files
+    static void
+    Init(const std::string& dir);
+
+    // the store of the process, nullptr if not initialized
+    static std::shared_ptr<SharedMmapStore>
+    Get();
+
+    // the key of the content written from the remote files, params
+    // distinguish the different contents written from the same files
+    static std::string
+    Key(std::string_view kind,
+        std::vector<std::string> files,
+        std::string_view params = "");
+
+    // a reference to a published file, the file is removed once the last
+    // reference on the host is released
+    class Lease {
+     public:
+        Lease(std::filesystem::path path,
+              std::filesystem::path ref_path,
+              int ref_fd)
+            : path_(std::move(path)),
+              ref_path_(std::move(ref_path)),
+              ref_fd_(ref_fd) {
+        }
+
+        Lease(const Lease&) = delete;
+        Lease&
+        operator=(const Lease&) = delete;
+
+        ~Lease();
+
+        const std::filesystem::path&
+        Path() const {
+            return path_;
+        }
+
+        // open the file read-only, to be mapped with PROT_READ
+        File
+        Open() const {
+            return File::Open(path_.string(), O_RDONLY);
+        }
+
+        size_t
+        Size() const {
+            return std::filesystem::file_size(path_);
+        }
+
+     private:
+        std::filesystem::path path_;
+        std::filesystem::path ref_path_;
+        int ref_fd_;
+    };
+    using LeasePtr = std::shared_ptr<const Lease>;
+
+    // write the file at the given path
+    using Writer = std::function<void(const std::string& path)>;
+
+    // the lease to the file of the key, written by write if it's not
+    // published yet. The processes loading the same key concurrently may
+    // both write it, only the first one published is kept.
+    LeasePtr
+    Acquire(const std::string& key, const Writer& write);
+
+    const std::filesystem::path&
+    Dir() const {
+        return dir_;
+    }
+
+ private:
+    // remove the files of the keys held by no process
+    void
+    RemoveUnheld();
+
+ private:
+    const std::filesystem::path dir_;
+
+    static std::mutex instance_mutex_;
+    static std::shared_ptr<SharedMmapStore> instance_;
+};
+
+using SharedMmapStorePtr = std::shared_ptr<SharedMmapStore>;
+
+}  // namespace milvus::storage
@@ -14,18 +14,62 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #include "ThreadPool.h"
 
+#include <condition_variable>
+#include <exception>
+
+#include "common/Numa.h"
+#include "storage/prometheus_client.h"
+
 namespace milvus {
 
+namespace {
+// the pool and the queue owned by the current worker thread
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_queue = 0;
+thread_local std::chrono::steady_clock::duration current_task_wait_time{0};
+}  // namespace
+
+void
+ThreadPool::InitQueues() {
+    size_t queue_num = std::max(min_threads_size_, 1);
+    size_t node_num = 1;
+    if (options_.numa_aware) {
+        node_num =
+            std::min(NumaTopology::GetInstance().GetNodeNum(), queue_num);
+    }
+    node_queues_.resize(node_num);
+    for (size_t i = 0; i < queue_num; i++) {
+        auto queue = std::make_unique<WorkQueue>();
+        queue->node = i % node_num;
+        node_queues_[queue->node].push_back(i);
+        queues_.emplace_back(std::move(queue));
+    }
+    for (size_t i = 0; i < queue_num; i++) {
+        auto& queue = *queues_[i];
+        auto& same_node = node_queues_[queue.node];
+        auto pos = std::find(same_node.begin(), same_node.end(), i) -
+                   same_node.begin();
+        for (size_t j = 0; j < same_node.size(); j++) {
+            queue.steal_order.push_back(
+                same_node[(pos + j) % same_node.size()]);
+        }
+        for (size_t j = 1; j < queue_num; j++) {
+            auto other = (i + j) % queue_num;
+            if (queues_[other]->node != queue.node) {
+                queue.steal_order.push_back(other);
+            }
+        }
+    }
+}
+
 void
 ThreadPool::Init() {
     std::lock_guard<std::mutex> lock(mutex_);
     for (int i = 0; i < min_threads_size_; i++) {
-        std::thread t(&ThreadPool::Worker, this);
-        assert(threads_.find(t.get_id()) == threads_.end());
-        threads_[t.get_id()] = std::move(t);
-        current_threads_size_++;
+        AddThread();
     }
 }
 
@@ -62,38 +106,268 @@ ThreadPool::FinishThreads() {
 }
 
 void
-ThreadPool::Worker() {
-    std::function<void()> func;
-    bool dequeue;
-    while (!shutdown_) {
+ThreadPool::AddThread() {
+    auto queue_index = next_worker_queue_++ % queues_.size();
+    std::thread t(&ThreadPool::Worker, this, queue_index);
+    assert(threads_.find(t.get_id()) == threads_.end());
+    threads_[t.get_id()] = std::move(t);
+    current_threads_size_++;
+}
+
+void
+ThreadPool::Enqueue(Task task) {
+    // the tasks submitted by a worker are likely to be waited by it, keep
+    // them on its own queue
+    size_t queue_index;
+    if (current_pool == this) {
+        queue_index = current_queue;
+    } else if (node_queues_.size() > 1) {
+        auto& node_queues =
+            node_queues_[NumaTopology::GetInstance().GetCurrentNode() %
+                         node_queues_.size()];
+        queue_index =
+            node_queues[next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                        node_queues.size()];
+    } else {
+        queue_index = next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                      queues_.size();
+    }
+    {
+        auto& queue = *queues_[queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(
+            QueuedTask{std::move(task), std::chrono::steady_clock::now()});
+    }
+    pending_tasks_.fetch_add(1);
+    if (options_.queue_depth != nullptr) {
+        options_.queue_depth->Increment();
+    }
+
+    // a worker increases idle_threads_size_ before checking pending_tasks_,
+    // so either it sees the task or it's notified here
+    if (idle_threads_size_.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_lock_.notify_one();
+    } else if (current_threads_size_ < max_threads_size_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Dynamic increase thread number
+        if (!shutdown_ && current_threads_size_ < max_threads_size_) {
+            AddThread();
+        }
+    }
+}
+
+bool
+ThreadPool::PopTask(size_t queue_index, Task& task) {
+    // run the tasks in the submitting order, the callers usually wait on the
+    // futures in order
+    for (auto index : queues_[queue_index]->steal_order) {
+        auto& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            auto& queued = queue.tasks.front();
+            task = std::move(queued.task);
+            auto now = std::chrono::steady_clock::now();
+            current_task_wait_time = now - queued.enqueue_time;
+            UpdateRecentWaitTime(now);
+            queue.tasks.pop_front();
+            pending_tasks_.fetch_sub(1);
+            if (options_.queue_depth != nullptr) {
+                options_.queue_depth->Decrement();
+            }
+            if (options_.wait_latency != nullptr) {
+                options_.wait_latency->Observe(
+                    std::chrono::duration<double, std::milli>(
+                        current_task_wait_time)
+                        .count());
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadPool::UpdateRecentWaitTime(std::chrono::steady_clock::time_point now) {
+    auto wait_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                       current_task_wait_time)
+                       .count();
+    auto recent = recent_wait_us_.load(std::memory_order_relaxed);
+    // the weight of a task is 1/8
+    recent_wait_us_.store(recent + (wait_us - recent) / 8,
+                          std::memory_order_relaxed);
+    last_taken_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             now.time_since_epoch())
+                             .count(),
+                         std::memory_order_relaxed);
+}
+
+std::chrono::microseconds
+ThreadPool::RecentWaitTime() const {
+    auto last_taken = std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds(
+                last_taken_ns_.load(std::memory_order_relaxed))));
+    if (pending_tasks_.load() == 0 &&
+        std::chrono::steady_clock::now() - last_taken > RECENT_WAIT_WINDOW) {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(
+        recent_wait_us_.load(std::memory_order_relaxed));
+}
+
+std::chrono::steady_clock::duration
+ThreadPool::CurrentTaskWaitTime() {
+    return current_pool != nullptr ? current_task_wait_time
+                                   : std::chrono::steady_clock::duration{0};
+}
+
+bool
+ThreadPool::HigherPriorityQueued() const {
+    for (auto pool : options_.higher_priority_pools) {
+        if (pool->GetQueuedTaskNum() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+ThreadPool::ShouldYield() const {
+    return running_tasks_.load() >= options_.contended_running_limit &&
+           HigherPriorityQueued();
+}
+
+bool
+ThreadPool::AcquireRunningSlot() {
+    auto running = running_tasks_.load();
+    while (true) {
+        if (running >= options_.contended_running_limit &&
+            HigherPriorityQueued()) {
+            return false;
+        }
+        if (running_tasks_.compare_exchange_weak(running, running + 1)) {
+            return true;
+        }
+    }
+}
+
+void
+ThreadPool::Worker(size_t queue_index) {
+    current_pool = this;
+    current_queue = queue_index;
+    if (node_queues_.size() > 1) {
+        auto node = queues_[queue_index]->node;
+        if (!BindCurrentThreadToCpus(
+                NumaTopology::GetInstance().GetNodeCpus(node))) {
+            LOG_SEGCORE_WARNING_ << "failed to bind worker of " << name_
+                                 << " to numa node " << node;
+        }
+    }
+    while (true) {
+        Task task;
+        if (AcquireRunningSlot()) {
+            auto popped = PopTask(queue_index, task);
+            if (popped) {
+                task();
+            }
+            running_tasks_--;
+            if (popped) {
+                continue;
+            }
+        }
+
         std::unique_lock<std::mutex> lock(mutex_);
         idle_threads_size_++;
-        auto is_timeout = !condition_lock_.wait_for(
-            lock, std::chrono::seconds(WAIT_SECONDS), [this]() {
-                return shutdown_ || !work_queue_.empty();
+        // the higher priority pools aren't notified to wake the yielding
+        // workers, recheck them periodically
+        auto yielding = ShouldYield();
+        std::chrono::milliseconds timeout =
+            yielding ? YIELD_INTERVAL : std::chrono::seconds(WAIT_SECONDS);
+        auto is_timeout =
+            !condition_lock_.wait_for(lock, timeout, [this]() {
+                return shutdown_ ||
+                       (pending_tasks_.load() > 0 && !ShouldYield());
             });
         idle_threads_size_--;
-        if (work_queue_.empty()) {
-            // Dynamic reduce thread number
-            if (shutdown_) {
+        if (pending_tasks_.load() > 0) {
+            continue;
+        }
+        // Dynamic reduce thread number, the queued tasks are drained before
+        // shutting down
+        if (shutdown_) {
+            current_threads_size_--;
+            return;
+        }
+        if (is_timeout && !yielding) {
+            FinishThreads();
+            if (current_threads_size_ > min_threads_size_) {
+                need_finish_threads_.enqueue(std::this_thread::get_id());
                 current_threads_size_--;
                 return;
             }
-            if (is_timeout) {
-                FinishThreads();
-                if (current_threads_size_ > min_threads_size_) {
-                    need_finish_threads_.enqueue(std::this_thread::get_id());
-                    current_threads_size_--;
-                    return;
-                }
-                continue;
-            }
         }
-        dequeue = work_queue_.dequeue(func);
-        lock.unlock();
-        if (dequeue) {
-            func();
+    }
+}
+namespace {
+
+struct ClaimedTasks {
+    ClaimedTasks(int64_t num_tasks, std::function<void(int64_t)> task)
+        : num_tasks(num_tasks), task(std::move(task)) {
+    }
+
+    const int64_t num_tasks;
+    const std::function<void(int64_t)> task;
+    std::atomic<int64_t> next_task{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int64_t finished_tasks = 0;
+    std::exception_ptr error;
+};
+
+void
+RunClaimedTasks(const std::shared_ptr<ClaimedTasks>& tasks) {
+    int64_t i;
+    while ((i = tasks->next_task.fetch_add(1)) < tasks->num_tasks) {
+        std::exception_ptr error;
+        try {
+            tasks->task(i);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        std::lock_guard lck(tasks->mutex);
+        if (error != nullptr && tasks->error == nullptr) {
+            tasks->error = error;
         }
+        if (++tasks->finished_tasks == tasks->num_tasks) {
+            tasks->cv.notify_all();
+        }
+    }
+}
+
+}  // namespace
+
+void
+ThreadPool::RunClaimed(int64_t num_tasks,
+                       int64_t parallelism,
+                       std::function<void(int64_t)> task) {
+    if (num_tasks <= 0) {
+        return;
+    }
+    auto tasks = std::make_shared<ClaimedTasks>(num_tasks, std::move(task));
+    auto num_helpers = std::min(num_tasks, parallelism) - 1;
+    for (int64_t i = 0; i < num_helpers; i++) {
+        Submit([tasks] { RunClaimedTasks(tasks); });
+    }
+    RunClaimedTasks(tasks);
+
+    std::unique_lock lck(tasks->mutex);
+    tasks->cv.wait(
+        lck, [&] { return tasks->finished_tasks == tasks->num_tasks; });
+    if (tasks->error != nullptr) {
+        std::rethrow_exception(tasks->error);
     }
 }
+
 };  // namespace milvus
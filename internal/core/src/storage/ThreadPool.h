@@ -16,25 +16,187 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <future>
 #include <mutex>
 #include <memory>
-#include <queue>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "SafeQueue.h"
 #include "common/Common.h"
+#include "common/Tracer.h"
 #include "log/Log.h"
+#include "storage/LoadContext.h"
+
+namespace prometheus {
+class Gauge;
+class Histogram;
+}  // namespace prometheus
 
 namespace milvus {
 
+// Task is a move-only type-erased callable, which stores small callables such
+// as a std::packaged_task inline, so that queueing one doesn't allocate
+class Task {
+ public:
+    Task() = default;
+
+    template <typename F,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<F>, Task>>>
+    explicit Task(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (sizeof(Fn) <= INLINE_SIZE &&
+                      alignof(Fn) <= alignof(std::max_align_t) &&
+                      std::is_nothrow_move_constructible_v<Fn>) {
+            new (storage_) Fn(std::forward<F>(f));
+            ops_ = &InlineOps<Fn>::ops;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+            ops_ = &HeapOps<Fn>::ops;
+        }
+    }
+
+    Task(Task&& other) noexcept {
+        MoveFrom(other);
+    }
+
+    Task&
+    operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task&
+    operator=(const Task&) = delete;
+
+    ~Task() {
+        Reset();
+    }
+
+    void
+    operator()() {
+        ops_->invoke(storage_);
+    }
+
+    explicit operator bool() const {
+        return ops_ != nullptr;
+    }
+
+ private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*move)(void* dst, void* src);
+        void (*destroy)(void*);
+    };
+
+    template <typename Fn>
+    struct InlineOps {
+        static void
+        Invoke(void* p) {
+            (*static_cast<Fn*>(p))();
+        }
+        static void
+        Move(void* dst, void* src) {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void
+        Destroy(void* p) {
+            static_cast<Fn*>(p)->~Fn();
+        }
+        static constexpr Ops ops{Invoke, Move, Destroy};
+    };
+
+    template <typename Fn>
+    struct HeapOps {
+        static void
+        Invoke(void* p) {
+            (**static_cast<Fn**>(p))();
+        }
+        static void
+        Move(void* dst, void* src) {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+        }
+        static void
+        Destroy(void* p) {
+            delete *static_cast<Fn**>(p);
+        }
+        static constexpr Ops ops{Invoke, Move, Destroy};
+    };
+
+    void
+    MoveFrom(Task& other) {
+        ops_ = other.ops_;
+        if (ops_ != nullptr) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    void
+    Reset() {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    static constexpr size_t INLINE_SIZE = 48;
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_ = nullptr;
+};
+
+class ThreadPool;
+
+struct ThreadPoolOptions {
+    // let the pools of higher priority go first: while any of them has queued
+    // tasks, the workers stop taking new tasks once contended_running_limit
+    // tasks are running
+    std::vector<const ThreadPool*> higher_priority_pools;
+    int contended_running_limit = 1;
+    // report the queued tasks and how long they wait before running
+    prometheus::Gauge* queue_depth = nullptr;
+    prometheus::Histogram* wait_latency = nullptr;
+    // spread the workers over the NUMA nodes and pin them to the cpus of
+    // their nodes, the tasks submitted from a node go to the workers of it
+    bool numa_aware = false;
+};
+
+/**
+ * @brief ThreadPool runs the submitted tasks in a work stealing manner: every
+ * worker owns one of the task queues, the tasks submitted by a worker go to
+ * its own queue and the other ones are spread over the queues, a worker runs
+ * the tasks of its own queue first and steals from the others once it's empty.
+ * Workers are added on demand up to the max worker num, since most tasks
+ * block on IO, and the idle ones above the min worker num exit after
+ * WAIT_SECONDS.
+ */
 class ThreadPool {
  public:
-    explicit ThreadPool(const int thread_core_coefficient, std::string name)
-        : shutdown_(false), name_(std::move(name)) {
+    explicit ThreadPool(const int thread_core_coefficient,
+                        std::string name,
+                        ThreadPoolOptions options = {})
+        : shutdown_(false),
+          name_(std::move(name)),
+          options_(std::move(options)) {
+        options_.contended_running_limit =
+            std::max(options_.contended_running_limit, 1);
         idle_threads_size_ = 0;
         current_threads_size_ = 0;
         min_threads_size_ = CPU_NUM;
@@ -46,6 +208,12 @@ class ThreadPool {
         if (max_threads_size_ > 256) {
             max_threads_size_ = 256;
         }
+        if (CPU_CONCURRENCY > 0) {
+            max_threads_size_ = static_cast<int>(
+                std::min<int64_t>(max_threads_size_, CPU_CONCURRENCY));
+            min_threads_size_ = std::min(min_threads_size_, max_threads_size_);
+        }
+        InitQueues();
         LOG_SEGCORE_INFO_ << "Init thread pool:" << name_
                           << " with min worker num:" << min_threads_size_
                           << " and max worker num:" << max_threads_size_;
@@ -80,80 +248,138 @@ class ThreadPool {
         return max_threads_size_;
     }
 
+    int64_t
+    GetQueuedTaskNum() const {
+        return pending_tasks_.load();
+    }
+
+    // how long the task running on the calling thread waited in the queue, 0
+    // if the thread is not a worker of a pool
+    static std::chrono::steady_clock::duration
+    CurrentTaskWaitTime();
+
+    // the moving average of the waits of the recent tasks in the queue, 0 if
+    // none is queued and none has been taken for RECENT_WAIT_WINDOW
+    std::chrono::microseconds
+    RecentWaitTime() const;
+
     template <typename F, typename... Args>
     auto
-    // Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))>;
     Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))> {
-        std::function<decltype(f(args...))()> func =
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-        auto task_ptr =
-            std::make_shared<std::packaged_task<decltype(f(args...))()>>(func);
+        using ResultType = decltype(f(args...));
+        // the packaged task holds the callable and the arguments in its
+        // shared state, which is the only allocation of the submission. The
+        // task runs under the current span and the load context of the
+        // submitting thread
+        std::packaged_task<ResultType()> task(
+            [f = std::forward<F>(f),
+             args = std::make_tuple(std::forward<Args>(args)...),
+             span = tracer::GetRootSpan(),
+             load_context = storage::GetLoadContext()]() mutable {
+                tracer::ScopedRootSpan scoped_span(std::move(span));
+                storage::ScopedLoadContext scoped_load_context(
+                    std::move(load_context));
+                return std::apply(f, args);
+            });
+        auto future = task.get_future();
+        Enqueue(Task(std::move(task)));
+        return future;
+    }
 
-        std::function<void()> wrap_func = [task_ptr]() { (*task_ptr)(); };
+    // run task(0), ..., task(num_tasks - 1) on the calling thread and on at
+    // most parallelism - 1 helpers submitted to the pool, each of them
+    // claims the next task until none is left, then rethrow the first error
+    // of the tasks. The caller waits only for the tasks claimed to finish,
+    // never for a helper to be scheduled, so it makes progress even if all
+    // the workers are busy, e.g. with the other callers waiting. The helpers
+    // may outlive the call, they don't run the task once all are claimed
+    void
+    RunClaimed(int64_t num_tasks,
+               int64_t parallelism,
+               std::function<void(int64_t)> task);
 
-        work_queue_.enqueue(wrap_func);
+    void
+    Worker(size_t queue_index);
 
-        std::lock_guard<std::mutex> lock(mutex_);
+    void
+    FinishThreads();
 
-        if (idle_threads_size_ > 0) {
-            condition_lock_.notify_one();
-        } else if (current_threads_size_ < max_threads_size_) {
-            // Dynamic increase thread number
-            std::thread t(&ThreadPool::Worker, this);
-            assert(threads_.find(t.get_id()) == threads_.end());
-            threads_[t.get_id()] = std::move(t);
-            current_threads_size_++;
-        }
+ private:
+    struct QueuedTask {
+        Task task;
+        std::chrono::steady_clock::time_point enqueue_time;
+    };
 
-        return task_ptr->get_future();
-    }
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;
+        size_t node = 0;
+        // the queues to pop from, this one goes first, then the ones of the
+        // same node
+        std::vector<size_t> steal_order;
+    };
 
     void
-    Worker();
+    InitQueues();
 
     void
-    FinishThreads();
+    Enqueue(Task task);
+
+    // fold the wait of the task just taken into the recent wait time
+    void
+    UpdateRecentWaitTime(std::chrono::steady_clock::time_point now);
+
+    // pop a task from the queue of the worker, or steal one from the others
+    bool
+    PopTask(size_t queue_index, Task& task);
+
+    bool
+    HigherPriorityQueued() const;
+
+    // the preemption point between tasks, see ThreadPoolOptions
+    bool
+    ShouldYield() const;
+
+    // count the task about to run, fails if the worker should yield
+    bool
+    AcquireRunningSlot();
+
+    // must be called with mutex_ held
+    void
+    AddThread();
 
  public:
     int min_threads_size_;
-    int idle_threads_size_;
-    int current_threads_size_;
+    // read without mutex_ to skip locking when no worker is waiting
+    std::atomic<int> idle_threads_size_;
+    // modified with mutex_ held
+    std::atomic<int> current_threads_size_;
     int max_threads_size_;
-    bool shutdown_;
+    std::atomic<bool> shutdown_;
     static constexpr size_t WAIT_SECONDS = 2;
-    SafeQueue<std::function<void()>> work_queue_;
     std::unordered_map<std::thread::id, std::thread> threads_;
     SafeQueue<std::thread::id> need_finish_threads_;
     std::mutex mutex_;
     std::condition_variable condition_lock_;
     std::string name_;
-};
 
-class Worker {
  private:
-    int id_;
-    ThreadPool* pool_;
-
- public:
-    Worker(ThreadPool* pool, const int id) : pool_(pool), id_(id) {
-    }
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    // the queues of each NUMA node, only one node if not numa aware
+    std::vector<std::vector<size_t>> node_queues_;
+    // the number of queued tasks, the workers wait only when it's 0
+    std::atomic<int64_t> pending_tasks_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<int> running_tasks_{0};
+    // updated as the tasks are taken, racy but only an estimate
+    std::atomic<int64_t> recent_wait_us_{0};
+    std::atomic<int64_t> last_taken_ns_{0};
+    // guarded by mutex_
+    size_t next_worker_queue_ = 0;
 
-    void
-    operator()() {
-        std::function<void()> func;
-        bool dequeue;
-        while (!pool_->shutdown_) {
-            std::unique_lock<std::mutex> lock(pool_->mutex_);
-            if (pool_->work_queue_.empty()) {
-                pool_->condition_lock_.wait(lock);
-            }
-            dequeue = pool_->work_queue_.dequeue(func);
-            lock.unlock();
-            if (dequeue) {
-                func();
-            }
-        }
-    }
+    ThreadPoolOptions options_;
+    static constexpr auto YIELD_INTERVAL = std::chrono::milliseconds(1);
+    static constexpr auto RECENT_WAIT_WINDOW = std::chrono::seconds(1);
 };
 
 }  // namespace milvus
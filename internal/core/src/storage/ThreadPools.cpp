@@ -15,12 +15,16 @@
 
 #include "ThreadPools.h"
 
+#include "storage/prometheus_client.h"
+
 namespace milvus {
 
 std::map<ThreadPoolPriority, std::unique_ptr<ThreadPool>>
     ThreadPools::thread_pool_map;
 std::map<ThreadPoolPriority, int64_t> ThreadPools::coefficient_map;
 std::map<ThreadPoolPriority, std::string> ThreadPools::name_map;
+std::map<ThreadPoolPriority, int> ThreadPools::contended_divisor_map = {
+    {MIDDLE, 2}, {LOW, 4}};
 std::shared_mutex ThreadPools::mutex_;
 ThreadPools ThreadPools::threadPools;
 bool ThreadPools::has_setup_coefficients = false;
@@ -39,20 +43,56 @@ ThreadPools::ShutDown() {
 ThreadPool&
 ThreadPools::GetThreadPool(milvus::ThreadPoolPriority priority) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    auto iter = thread_pool_map.find(priority);
     if (!ThreadPools::has_setup_coefficients) {
         ThreadPools::SetUpCoefficients();
         ThreadPools::has_setup_coefficients = true;
     }
+    return GetOrCreateThreadPool(priority);
+}
+
+ThreadPool&
+ThreadPools::GetOrCreateThreadPool(milvus::ThreadPoolPriority priority) {
+    auto iter = thread_pool_map.find(priority);
     if (iter != thread_pool_map.end()) {
         return *(iter->second);
-    } else {
-        int64_t coefficient = coefficient_map[priority];
-        std::string name = name_map[priority];
-        auto result = thread_pool_map.emplace(
-            priority, std::make_unique<ThreadPool>(coefficient, name));
-        return *(result.first->second);
     }
+
+    // the pools of lower priority yield to the higher ones, create them first
+    ThreadPoolOptions options;
+    options.numa_aware = THREAD_POOL_NUMA_AWARE;
+    for (int p = HIGH; p < priority; p++) {
+        options.higher_priority_pools.push_back(
+            &GetOrCreateThreadPool(static_cast<ThreadPoolPriority>(p)));
+    }
+    if (!options.higher_priority_pools.empty()) {
+        options.contended_running_limit =
+            CPU_NUM / contended_divisor_map[priority];
+    }
+    switch (priority) {
+        case HIGH:
+            options.queue_depth = &storage::internal_thread_pool_queue_depth_high;
+            options.wait_latency =
+                &storage::internal_thread_pool_wait_latency_high;
+            break;
+        case MIDDLE:
+            options.queue_depth =
+                &storage::internal_thread_pool_queue_depth_middle;
+            options.wait_latency =
+                &storage::internal_thread_pool_wait_latency_middle;
+            break;
+        default:
+            options.queue_depth = &storage::internal_thread_pool_queue_depth_low;
+            options.wait_latency =
+                &storage::internal_thread_pool_wait_latency_low;
+            break;
+    }
+
+    int64_t coefficient = coefficient_map[priority];
+    std::string name = name_map[priority];
+    auto pool =
+        std::make_unique<ThreadPool>(coefficient, name, std::move(options));
+    auto result = thread_pool_map.emplace(priority, std::move(pool));
+    return *(result.first->second);
 }
 
 }  // namespace milvus
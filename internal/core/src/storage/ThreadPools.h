@@ -54,12 +54,18 @@ class ThreadPools {
                           << MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT
                           << ", low:" << LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
     }
+    // must be called with mutex_ held
+    static ThreadPool&
+    GetOrCreateThreadPool(ThreadPoolPriority priority);
     void
     ShutDown();
     static std::map<ThreadPoolPriority, std::unique_ptr<ThreadPool>>
         thread_pool_map;
     static std::map<ThreadPoolPriority, int64_t> coefficient_map;
     static std::map<ThreadPoolPriority, std::string> name_map;
+    // while the higher priority pools have queued tasks, the pool of a lower
+    // priority runs at most CPU_NUM / divisor tasks
+    static std::map<ThreadPoolPriority, int> contended_divisor_map;
     static std::shared_mutex mutex_;
     static ThreadPools threadPools;
     static bool has_setup_coefficients;
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "common/Consts.h"
 #include "common/Types.h"
 
 namespace milvus::storage {
@@ -84,6 +85,12 @@ struct IndexMeta {
     int64_t dim;
 };
 
+// a contiguous byte range of a file
+struct ByteRange {
+    uint64_t offset;
+    uint64_t size;
+};
+
 struct StorageConfig {
     std::string address = "localhost:9000";
     std::string bucket_name = "a-bucket";
@@ -99,6 +106,11 @@ struct StorageConfig {
     bool useIAM = false;
     bool useVirtualHost = false;
     int64_t requestTimeoutMs = 3000;
+    // objects larger than read_part_size are downloaded with up to
+    // read_concurrency parallel ranged requests
+    int64_t read_part_size = DEFAULT_STORAGE_READ_PART_SIZE;
+    int64_t read_concurrency = DEFAULT_STORAGE_READ_CONCURRENCY;
+    double read_hedge_percentile = DEFAULT_STORAGE_READ_HEDGE_PERCENTILE;
 
     std::string
     ToString() const {
@@ -110,7 +122,10 @@ struct StorageConfig {
            << ", region=" << region << ", useSSL=" << std::boolalpha << useSSL
            << ", useIAM=" << std::boolalpha << useIAM
            << ", useVirtualHost=" << std::boolalpha << useVirtualHost
-           << ", requestTimeoutMs=" << requestTimeoutMs << "]";
+           << ", requestTimeoutMs=" << requestTimeoutMs
+           << ", read_part_size=" << read_part_size
+           << ", read_concurrency=" << read_concurrency
+           << ", read_hedge_percentile=" << read_hedge_percentile << "]";
 
         return ss.str();
     }
@@ -15,6 +15,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 
 #include "arrow/array/builder_binary.h"
@@ -32,6 +34,7 @@
 #include "storage/ChunkManager.h"
 #include "storage/DiskFileManagerImpl.h"
 #include "storage/InsertData.h"
+#include "storage/LoadContext.h"
 #include "storage/LocalChunkManager.h"
 #include "storage/MemFileManagerImpl.h"
 #include "storage/MinioChunkManager.h"
@@ -407,14 +410,148 @@ GetSegmentRawDataPathPrefix(ChunkManagerPtr cm, int64_t segment_id) {
            std::to_string(segment_id);
 }
 
+namespace {
+
+// read the file of the size into a buffer by read and decode it, within the
+// budget of the loads, reporting the bytes to the load context of the thread
+template <typename Read>
+std::unique_ptr<DataCodec>
+ReadAndDecodeRemoteFile(int64_t file_size,
+                        Read read,
+                        RemoteFileStats* stats = nullptr) {
+    auto context = GetLoadContext();
+    if (context != nullptr) {
+        context->CheckCanceled();
+    }
+    LoadBudgetGuard budget(file_size, context.get());
+
+    auto start = std::chrono::steady_clock::now();
+    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[file_size]);
+    read(buf.get());
+    auto downloaded = std::chrono::steady_clock::now();
+    if (context != nullptr) {
+        context->AddDownloadedBytes(file_size);
+        // free the buffer rather than decode it
+        context->CheckCanceled();
+    }
+
+    auto codec = DeserializeFileData(buf, file_size);
+    if (context != nullptr && codec->GetFieldData() != nullptr) {
+        context->AddDecodedBytes(codec->GetFieldData()->Size());
+    }
+    if (stats != nullptr) {
+        stats->bytes = file_size;
+        stats->download_time =
+            std::chrono::duration_cast<std::chrono::microseconds>(downloaded -
+                                                                  start);
+        stats->decode_time =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - downloaded);
+    }
+    return codec;
+}
+
+}  // namespace
+
 std::unique_ptr<DataCodec>
 DownloadAndDecodeRemoteFile(ChunkManager* chunk_manager,
                             const std::string& file) {
     auto fileSize = chunk_manager->Size(file);
-    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
-    chunk_manager->Read(file, buf.get(), fileSize);
+    return ReadAndDecodeRemoteFile(fileSize, [&](uint8_t* buf) {
+        chunk_manager->Read(file, buf, fileSize);
+    });
+}
+
+std::unique_ptr<DataCodec>
+DownloadAndDecodeRemoteFileWithStats(ChunkManager* chunk_manager,
+                                     const std::string& file,
+                                     RemoteFileStats* stats) {
+    auto fileSize = chunk_manager->Size(file);
+    return ReadAndDecodeRemoteFile(
+        fileSize,
+        [&](uint8_t* buf) { chunk_manager->Read(file, buf, fileSize); },
+        stats);
+}
+
+std::vector<ByteRange>
+CoalesceByteRanges(std::vector<ByteRange> ranges, uint64_t max_gap) {
+    std::sort(ranges.begin(),
+              ranges.end(),
+              [](const ByteRange& lhs, const ByteRange& rhs) {
+                  return lhs.offset < rhs.offset;
+              });
+
+    std::vector<ByteRange> merged;
+    for (const auto& range : ranges) {
+        if (range.size == 0) {
+            continue;
+        }
+        if (!merged.empty()) {
+            auto& last = merged.back();
+            auto last_end = last.offset + last.size;
+            if (range.offset <= last_end + max_gap) {
+                last.size =
+                    std::max(last_end, range.offset + range.size) - last.offset;
+                continue;
+            }
+        }
+        merged.push_back(range);
+    }
+    return merged;
+}
 
-    return DeserializeFileData(buf, fileSize);
+void
+ReadByteRanges(ChunkManager* chunk_manager,
+               const std::string& file,
+               const std::vector<ByteRange>& ranges,
+               uint8_t* buf,
+               uint64_t max_gap) {
+    auto merged = CoalesceByteRanges(ranges, max_gap);
+    std::vector<std::unique_ptr<uint8_t[]>> merged_bufs;
+    merged_bufs.reserve(merged.size());
+    for (const auto& range : merged) {
+        merged_bufs.emplace_back(new uint8_t[range.size]);
+        auto read_size = chunk_manager->Read(
+            file, range.offset, merged_bufs.back().get(), range.size);
+        AssertInfo(read_size == range.size,
+                   fmt::format("failed to read range [{}, {}) of file {}, "
+                               "only {} bytes read",
+                               range.offset,
+                               range.offset + range.size,
+                               file,
+                               read_size));
+    }
+
+    // scatter the merged requests back into the requested ranges
+    for (const auto& range : ranges) {
+        if (range.size == 0) {
+            continue;
+        }
+        auto iter = std::upper_bound(
+            merged.begin(),
+            merged.end(),
+            range.offset,
+            [](uint64_t offset, const ByteRange& merged_range) {
+                return offset < merged_range.offset;
+            });
+        AssertInfo(iter != merged.begin(), "byte range not found");
+        auto idx = std::distance(merged.begin(), iter) - 1;
+        auto src = merged_bufs[idx].get() + (range.offset - merged[idx].offset);
+        std::memcpy(buf, src, range.size);
+        buf += range.size;
+    }
+}
+
+std::unique_ptr<arrow::RecordBatchReader>
+ReadSpaceColumns(const milvus_storage::Space& space,
+                 const std::set<std::string>& columns) {
+    AssertInfo(!columns.empty(), "no columns to read from space");
+    // the space reads all the columns if none is given
+    milvus_storage::ReadOptions options;
+    options.columns = columns;
+    auto reader = space.Read(options);
+    AssertInfo(reader != nullptr, "failed to create reader of space");
+    return reader;
 }
 
 std::unique_ptr<DataCodec>
@@ -424,13 +561,12 @@ DownloadAndDecodeRemoteFileV2(std::shared_ptr<milvus_storage::Space> space,
     if (!fileSize.ok()) {
         PanicInfo(FileReadFailed, fileSize.status().ToString());
     }
-    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize.value()]);
-    auto status = space->ReadBlob(file, buf.get());
-    if (!status.ok()) {
-        PanicInfo(FileReadFailed, status.ToString());
-    }
-
-    return DeserializeFileData(buf, fileSize.value());
+    return ReadAndDecodeRemoteFile(fileSize.value(), [&](uint8_t* buf) {
+        auto status = space->ReadBlob(file, buf);
+        if (!status.ok()) {
+            PanicInfo(FileReadFailed, status.ToString());
+        }
+    });
 }
 
 std::pair<std::string, size_t>
@@ -445,10 +581,13 @@ EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
     auto indexData = std::make_shared<IndexData>(field_data);
     indexData->set_index_meta(index_meta);
     indexData->SetFieldDataMeta(field_meta);
-    auto serialized_index_data = indexData->serialize_to_remote_file();
-    auto serialized_index_size = serialized_index_data.size();
-    chunk_manager->Write(
-        object_key, serialized_index_data.data(), serialized_index_size);
+    // the encoded parts are streamed to the writer as they are produced, so
+    // no copy of the whole file is assembled, and the large slices are
+    // uploaded in parts instead of a single put request
+    auto writer = chunk_manager->OpenWriter(object_key);
+    auto serialized_index_size = indexData->serialize_to_remote_file(
+        [&](const uint8_t* data, size_t size) { writer->Write(data, size); });
+    writer->Close();
     return std::make_pair(std::move(object_key), serialized_index_size);
 }
 
@@ -485,10 +624,11 @@ EncodeAndUploadFieldSlice(ChunkManager* chunk_manager,
     field_data->FillFieldData(buf, element_count);
     auto insertData = std::make_shared<InsertData>(field_data);
     insertData->SetFieldDataMeta(field_data_meta);
-    auto serialized_index_data = insertData->serialize_to_remote_file();
-    auto serialized_index_size = serialized_index_data.size();
-    chunk_manager->Write(
-        object_key, serialized_index_data.data(), serialized_index_size);
+    // streamed to the writer as EncodeAndUploadIndexSlice does
+    auto writer = chunk_manager->OpenWriter(object_key);
+    auto serialized_index_size = insertData->serialize_to_remote_file(
+        [&](const uint8_t* data, size_t size) { writer->Write(data, size); });
+    writer->Close();
     return std::make_pair(std::move(object_key), serialized_index_size);
 }
 
@@ -511,6 +651,43 @@ GetObjectData(ChunkManager* remote_chunk_manager,
     return datas;
 }
 
+void
+GetObjectData(ChunkManager* remote_chunk_manager,
+              const std::vector<std::string>& remote_files,
+              int64_t window,
+              const std::function<void(size_t, FieldDataPtr)>& consume) {
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+    auto in_flight = static_cast<size_t>(std::max<int64_t>(window, 1));
+    std::vector<std::future<std::unique_ptr<DataCodec>>> futures;
+    futures.reserve(remote_files.size());
+    auto submit = [&](size_t i) {
+        futures.emplace_back(pool.Submit(DownloadAndDecodeRemoteFile,
+                                         remote_chunk_manager,
+                                         remote_files[i]));
+    };
+    try {
+        for (size_t i = 0; i < remote_files.size() && i < in_flight; ++i) {
+            submit(i);
+        }
+        for (size_t i = 0; i < remote_files.size(); ++i) {
+            auto res = futures[i].get();
+            if (i + in_flight < remote_files.size()) {
+                submit(i + in_flight);
+            }
+            consume(i, res->GetFieldData());
+        }
+    } catch (...) {
+        // the tasks reference the files, wait for them before unwinding
+        for (auto& future : futures) {
+            if (future.valid()) {
+                future.wait();
+            }
+        }
+        throw;
+    }
+    ReleaseArrowUnused();
+}
+
 std::vector<FieldDataPtr>
 GetObjectData(std::shared_ptr<milvus_storage::Space> space,
               const std::vector<std::string>& remote_files) {
@@ -739,6 +916,22 @@ CollectFieldDataChannel(FieldDataChannelPtr& channel) {
     return result;
 }
 
+FieldDataPtr
+MergeFieldDataChannel(FieldDataChannelPtr& channel,
+                      const DataType& type,
+                      int64_t total_num_rows) {
+    auto merged_data = CreateFieldData(type, 1, total_num_rows);
+    FieldDataPtr field_data;
+    while (channel->pop(field_data)) {
+        merged_data->FillFieldData(field_data->Data(), field_data->Length());
+    }
+    AssertInfo(merged_data->IsFull(),
+               "merged {} rows from channel, expected {}",
+               merged_data->Length(),
+               total_num_rows);
+    return merged_data;
+}
+
 FieldDataPtr
 MergeFieldData(std::vector<FieldDataPtr>& data_array) {
     if (data_array.size() == 0) {
@@ -754,8 +947,10 @@ MergeFieldData(std::vector<FieldDataPtr>& data_array) {
         total_length += data->Length();
     }
 
-    auto merged_data = storage::CreateFieldData(data_array[0]->get_data_type());
-    merged_data->Reserve(total_length);
+    // allocated once with the rows and the dim of the field datas
+    auto merged_data = storage::CreateFieldData(data_array[0]->get_data_type(),
+                                                data_array[0]->get_dim(),
+                                                total_length);
     for (const auto& data : data_array) {
         merged_data->FillFieldData(data->Data(), data->Length());
     }
@@ -16,16 +16,20 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "common/Consts.h"
 #include "common/FieldData.h"
 #include "common/LoadInfo.h"
 #include "knowhere/comp/index_param.h"
 #include "parquet/schema.h"
 #include "storage/PayloadStream.h"
 #include "storage/FileManager.h"
+#include "storage/LoadMetrics.h"
 #include "storage/BinlogReader.h"
 #include "storage/ChunkManager.h"
 #include "storage/DataCodec.h"
@@ -88,6 +92,34 @@ std::unique_ptr<DataCodec>
 DownloadAndDecodeRemoteFile(ChunkManager* chunk_manager,
                             const std::string& file);
 
+// same as DownloadAndDecodeRemoteFile, and fill the bytes downloaded and the
+// time taken by the download and the decode into stats
+std::unique_ptr<DataCodec>
+DownloadAndDecodeRemoteFileWithStats(ChunkManager* chunk_manager,
+                                     const std::string& file,
+                                     RemoteFileStats* stats);
+
+// merge the sorted byte ranges whose gap is not larger than max_gap
+std::vector<ByteRange>
+CoalesceByteRanges(std::vector<ByteRange> ranges, uint64_t max_gap);
+
+// read the byte ranges of file into buf, the ranges are laid out in buf
+// consecutively in the given order. Nearby ranges are merged into one read
+// request, so only the bytes between them are transferred in addition.
+void
+ReadByteRanges(ChunkManager* chunk_manager,
+               const std::string& file,
+               const std::vector<ByteRange>& ranges,
+               uint8_t* buf,
+               uint64_t max_gap = DEFAULT_RANGE_READ_MERGE_GAP);
+
+// the record batches of the columns of the space, the other columns of the
+// fragments are neither downloaded nor decoded, which saves most of the
+// loads of the wide schemas
+std::unique_ptr<arrow::RecordBatchReader>
+ReadSpaceColumns(const milvus_storage::Space& space,
+                 const std::set<std::string>& columns);
+
 std::unique_ptr<DataCodec>
 DownloadAndDecodeRemoteFileV2(std::shared_ptr<milvus_storage::Space> space,
                               const std::string& file);
@@ -123,6 +155,19 @@ std::vector<FieldDataPtr>
 GetObjectData(std::shared_ptr<milvus_storage::Space> space,
               const std::vector<std::string>& remote_files);
 
+// download and decode the files with at most window of them in flight, and
+// hand each to consume in the order of the files as soon as it arrives, so
+// the consuming overlaps with the downloading of the next files
+void
+GetObjectData(ChunkManager* remote_chunk_manager,
+              const std::vector<std::string>& remote_files,
+              int64_t window,
+              const std::function<void(size_t, FieldDataPtr)>& consume);
+
+// the MADV_* advices by the names of the read ahead policies: normal,
+// random, sequential, willneed and dontneed
+extern std::map<std::string, int> ReadAheadPolicy_Map;
+
 std::map<std::string, int64_t>
 PutIndexData(ChunkManager* remote_chunk_manager,
              const std::vector<const uint8_t*>& data_slices,
@@ -164,6 +209,13 @@ GetByteSizeOfFieldDatas(const std::vector<FieldDataPtr>& field_datas);
 std::vector<FieldDataPtr>
 CollectFieldDataChannel(FieldDataChannelPtr& channel);
 
+// merge the fixed width field datas popped from the channel into one field
+// data of total_num_rows rows, each batch is released once it's merged
+FieldDataPtr
+MergeFieldDataChannel(FieldDataChannelPtr& channel,
+                      const DataType& type,
+                      int64_t total_num_rows);
+
 FieldDataPtr
 MergeFieldData(std::vector<FieldDataPtr>& data_array);
 
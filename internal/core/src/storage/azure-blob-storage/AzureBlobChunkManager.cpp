@@ -63,8 +63,14 @@ AzureBlobChunkManager::AzureBlobChunkManager(
     const std::string& access_key_value,
     const std::string& address,
     int64_t requestTimeoutMs,
-    bool useIAM) {
+    bool useIAM,
+    int64_t readPartSize,
+    int64_t writePartSize,
+    int32_t concurrency) {
     requestTimeoutMs_ = requestTimeoutMs;
+    readPartSize_ = readPartSize;
+    writePartSize_ = writePartSize;
+    concurrency_ = concurrency;
     if (useIAM) {
         Azure::Identity::WorkloadIdentityCredentialOptions options;
         auto workloadIdentityCredential =
@@ -215,19 +221,23 @@ AzureBlobChunkManager::PutObjectBuffer(const std::string& bucket_name,
                                        const std::string& object_name,
                                        void* buf,
                                        uint64_t size) {
-    std::vector<unsigned char> str(static_cast<char*>(buf),
-                                   static_cast<char*>(buf) + size);
     Azure::Core::Context context;
     if (requestTimeoutMs_ > 0) {
         context =
             context.WithDeadline(std::chrono::system_clock::now() +
                                  std::chrono::milliseconds(requestTimeoutMs_));
     }
+    // blobs larger than a part are staged as blocks in parallel and then
+    // committed, straight from the caller's buffer
+    Azure::Storage::Blobs::UploadBlockBlobFromOptions uploadOptions;
+    uploadOptions.TransferOptions.SingleUploadThreshold = writePartSize_;
+    uploadOptions.TransferOptions.ChunkSize = writePartSize_;
+    uploadOptions.TransferOptions.Concurrency = concurrency_;
     client_->GetBlobContainerClient(bucket_name)
         .GetBlockBlobClient(object_name)
-        .UploadFrom(str.data(),
-                    str.size(),
-                    Azure::Storage::Blobs::UploadBlockBlobFromOptions(),
+        .UploadFrom(static_cast<const uint8_t*>(buf),
+                    size,
+                    uploadOptions,
                     context);
     return true;
 }
@@ -237,10 +247,27 @@ AzureBlobChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                        const std::string& object_name,
                                        void* buf,
                                        uint64_t size) {
-    Azure::Storage::Blobs::DownloadBlobOptions downloadOptions;
+    return GetObjectBuffer(bucket_name, object_name, 0, buf, size);
+}
+
+uint64_t
+AzureBlobChunkManager::GetObjectBuffer(const std::string& bucket_name,
+                                       const std::string& object_name,
+                                       uint64_t offset,
+                                       void* buf,
+                                       uint64_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    // a range larger than a part is downloaded by parallel ranged requests,
+    // each into its slice of the caller's buffer
+    Azure::Storage::Blobs::DownloadBlobToOptions downloadOptions;
     downloadOptions.Range = Azure::Core::Http::HttpRange();
-    downloadOptions.Range.Value().Offset = 0;
+    downloadOptions.Range.Value().Offset = offset;
     downloadOptions.Range.Value().Length = size;
+    downloadOptions.TransferOptions.InitialChunkSize = readPartSize_;
+    downloadOptions.TransferOptions.ChunkSize = readPartSize_;
+    downloadOptions.TransferOptions.Concurrency = concurrency_;
     Azure::Core::Context context;
     if (requestTimeoutMs_ > 0) {
         context =
@@ -249,16 +276,13 @@ AzureBlobChunkManager::GetObjectBuffer(const std::string& bucket_name,
     }
     auto downloadResponse = client_->GetBlobContainerClient(bucket_name)
                                 .GetBlockBlobClient(object_name)
-                                .Download(downloadOptions, context);
-    auto bodyStream = downloadResponse.Value.BodyStream.get();
-    uint64_t totalBytesRead = 0;
-    uint64_t bytesRead = 0;
-    do {
-        bytesRead = bodyStream->Read(
-            static_cast<uint8_t*>(buf) + totalBytesRead, size - totalBytesRead);
-        totalBytesRead += bytesRead;
-    } while (bytesRead != 0 && totalBytesRead < size);
-    return totalBytesRead;
+                                .DownloadTo(static_cast<uint8_t*>(buf),
+                                            size,
+                                            downloadOptions,
+                                            context);
+    auto& contentRange = downloadResponse.Value.ContentRange;
+    return contentRange.Length.HasValue() ? contentRange.Length.Value()
+                                          : size;
 }
 
 std::vector<std::string>
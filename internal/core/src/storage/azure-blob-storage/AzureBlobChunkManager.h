@@ -38,7 +38,10 @@ class AzureBlobChunkManager {
                                    const std::string& access_key_value,
                                    const std::string& address,
                                    int64_t requestTimeoutMs = 0,
-                                   bool useIAM = false);
+                                   bool useIAM = false,
+                                   int64_t readPartSize = 16 << 20,
+                                   int64_t writePartSize = 8 << 20,
+                                   int32_t concurrency = 8);
 
     AzureBlobChunkManager(const AzureBlobChunkManager&);
     AzureBlobChunkManager&
@@ -74,6 +77,12 @@ class AzureBlobChunkManager {
                     const std::string& object_name,
                     void* buf,
                     uint64_t size);
+    uint64_t
+    GetObjectBuffer(const std::string& bucket_name,
+                    const std::string& object_name,
+                    uint64_t offset,
+                    void* buf,
+                    uint64_t size);
     std::vector<std::string>
     ListObjects(const std::string& bucket_name,
                 const std::string& prefix = nullptr);
@@ -81,6 +90,11 @@ class AzureBlobChunkManager {
  private:
     std::shared_ptr<Azure::Storage::Blobs::BlobServiceClient> client_;
     int64_t requestTimeoutMs_;
+    // blobs larger than a part are transferred in parts of these sizes with
+    // up to concurrency_ requests at once
+    int64_t readPartSize_;
+    int64_t writePartSize_;
+    int32_t concurrency_;
 };
 
 }  // namespace azure
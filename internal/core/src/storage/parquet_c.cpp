@@ -14,8 +14,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <map>
 #include <mutex>
+#include <string>
 
+#include "arrow/util/compression.h"
 #include "common/EasyAssert.h"
 #include "common/FieldData.h"
 #include "storage/parquet_c.h"
@@ -219,6 +222,57 @@ ReleasePayloadWriter(CPayloadWriter handler) {
     }
 }
 
+extern "C" CStatus
+SetPayloadEncoding(int columnType,
+                   const char* compression,
+                   int compressionLevel,
+                   const char* encoding,
+                   bool enableDictionary) {
+    try {
+        static const std::map<std::string, parquet::Encoding::type>
+            encodings = {
+                {"plain", parquet::Encoding::PLAIN},
+                {"delta_binary_packed", parquet::Encoding::DELTA_BINARY_PACKED},
+                {"delta_length_byte_array",
+                 parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY},
+                {"delta_byte_array", parquet::Encoding::DELTA_BYTE_ARRAY},
+                {"byte_stream_split", parquet::Encoding::BYTE_STREAM_SPLIT},
+            };
+        auto compression_type =
+            arrow::util::Codec::GetCompressionType(compression);
+        AssertInfo(compression_type.ok(),
+                   "unknown compression {}: {}",
+                   compression,
+                   compression_type.status().ToString());
+        auto it = encodings.find(encoding);
+        AssertInfo(it != encodings.end(), "unknown encoding {}", encoding);
+
+        auto data_type = static_cast<milvus::DataType>(columnType);
+        auto policy = milvus::storage::GetPayloadEncodingPolicy(data_type);
+        policy.compression = compression_type.ValueOrDie();
+        policy.compression_level = compressionLevel;
+        policy.encoding = it->second;
+        policy.enable_dictionary = enableDictionary;
+        milvus::storage::SetPayloadEncodingPolicy(data_type, policy);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+extern "C" CStatus
+SetPayloadRawLayout(int columnType, bool enable) {
+    try {
+        auto data_type = static_cast<milvus::DataType>(columnType);
+        auto policy = milvus::storage::GetPayloadEncodingPolicy(data_type);
+        policy.raw_layout = enable;
+        milvus::storage::SetPayloadEncodingPolicy(data_type, policy);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 extern "C" CStatus
 NewPayloadReader(int columnType,
                  uint8_t* buffer,
@@ -76,6 +76,22 @@ GetPayloadLengthFromWriter(CPayloadWriter payloadWriter);
 void
 ReleasePayloadWriter(CPayloadWriter handler);
 
+// set how the binlogs of the column type written from now on are compressed,
+// by the arrow names like "zstd", "lz4" and "uncompressed", and encoded, by
+// the parquet names like "plain", "delta_binary_packed" and
+// "byte_stream_split"
+CStatus
+SetPayloadEncoding(int columnType,
+                   const char* compression,
+                   int compressionLevel,
+                   const char* encoding,
+                   bool enableDictionary);
+
+// write the binlogs of the vector column type from now on in the raw layout,
+// which segcore reads without decoding, see storage/RawPayload.h
+CStatus
+SetPayloadRawLayout(int columnType, bool enable);
+
 //============= payload reader ======================
 typedef void* CPayloadReader;
 CStatus
@@ -31,6 +31,15 @@ const prometheus::Histogram::BucketBoundaries buckets = {1,
                                                          32768,
                                                          65536};
 
+// 1us to 16s
+const prometheus::Histogram::BucketBoundaries searchLatencyBuckets = [] {
+    prometheus::Histogram::BucketBoundaries boundaries;
+    for (double boundary = 1; boundary <= 16 * 1024 * 1024; boundary *= 2) {
+        boundaries.push_back(boundary);
+    }
+    return boundaries;
+}();
+
 const std::unique_ptr<PrometheusClient> prometheusClient =
     std::make_unique<PrometheusClient>();
 
@@ -48,6 +57,8 @@ std::map<std::string, std::string> getSucMap = {
     {"persistent_data_op_type", "get"}, {"status", "success"}};
 std::map<std::string, std::string> getFailMap = {
     {"persistent_data_op_type", "get"}};
+std::map<std::string, std::string> getHedgedMap = {
+    {"persistent_data_op_type", "get"}, {"status", "hedged"}};
 std::map<std::string, std::string> putMap = {
     {"persistent_data_op_type", "put"}};
 std::map<std::string, std::string> putSucMap = {
@@ -72,6 +83,53 @@ std::map<std::string, std::string> removeSucMap = {
     {"persistent_data_op_type", "remove"}, {"status", "success"}};
 std::map<std::string, std::string> removeFailMap = {
     {"persistent_data_op_type", "remove"}, {"status", "fail"}};
+std::map<std::string, std::string> chunkCacheHitMap = {
+    {"chunk_cache_op_type", "hit"}};
+std::map<std::string, std::string> chunkCacheMissMap = {
+    {"chunk_cache_op_type", "miss"}};
+std::map<std::string, std::string> chunkCacheEvictMap = {
+    {"chunk_cache_op_type", "evict"}};
+std::map<std::string, std::string> chunkCacheResidentMap = {
+    {"chunk_cache_size_type", "resident"}};
+std::map<std::string, std::string> anonMapHugeMap = {
+    {"anon_map_page_type", "huge"}};
+std::map<std::string, std::string> anonMapNormalMap = {
+    {"anon_map_page_type", "normal"}};
+std::map<std::string, std::string> anonMapFallbackMap = {
+    {"anon_map_page_type", "hugetlb"}};
+std::map<std::string, std::string> segmentMemoryFieldDataMap = {
+    {"segment_memory_component", "field_data"}};
+std::map<std::string, std::string> segmentMemoryIndexMap = {
+    {"segment_memory_component", "index"}};
+std::map<std::string, std::string> segmentMemoryPkIndexMap = {
+    {"segment_memory_component", "pk_index"}};
+std::map<std::string, std::string> segmentMemoryTimestampsMap = {
+    {"segment_memory_component", "timestamps"}};
+std::map<std::string, std::string> segmentMemoryDeletedRecordMap = {
+    {"segment_memory_component", "deleted_record"}};
+std::map<std::string, std::string> diskCacheHitMap = {
+    {"disk_cache_op_type", "hit"}};
+std::map<std::string, std::string> diskCacheMissMap = {
+    {"disk_cache_op_type", "miss"}};
+std::map<std::string, std::string> diskCacheEvictMap = {
+    {"disk_cache_op_type", "evict"}};
+std::map<std::string, std::string> diskCacheCachedMap = {
+    {"disk_cache_size_type", "cached"}};
+std::map<std::string, std::string> vectorSearchIndexMap = {
+    {"vector_search_path", "index"}};
+std::map<std::string, std::string> vectorSearchBruteForceMap = {
+    {"vector_search_path", "brute_force"}};
+std::map<std::string, std::string> threadPoolHighMap = {
+    {"priority", "high"}};
+std::map<std::string, std::string> threadPoolMiddleMap = {
+    {"priority", "middle"}};
+std::map<std::string, std::string> threadPoolLowMap = {{"priority", "low"}};
+std::map<std::string, std::string> diskSearchQueuedMap = {
+    {"disk_search_state", "queued"}};
+std::map<std::string, std::string> diskSearchWaitMap = {
+    {"disk_search_stage", "wait"}};
+std::map<std::string, std::string> diskSearchReadMap = {
+    {"disk_search_stage", "read"}};
 
 DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(internal_storage_kv_size,
                                    "[cpp]kv size stats")
@@ -107,6 +165,9 @@ DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_get_suc,
 DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_get_fail,
                           internal_storage_op_count,
                           getFailMap)
+DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_get_hedged,
+                          internal_storage_op_count,
+                          getHedgedMap)
 DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_put_suc,
                           internal_storage_op_count,
                           putSucMap)
@@ -131,4 +192,135 @@ DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_remove_suc,
 DEFINE_PROMETHEUS_COUNTER(internal_storage_op_count_remove_fail,
                           internal_storage_op_count,
                           removeFailMap)
+
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_chunk_cache_op_count,
+                                 "[cpp]count of chunk cache operation")
+DEFINE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_hit,
+                          internal_chunk_cache_op_count,
+                          chunkCacheHitMap)
+DEFINE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_miss,
+                          internal_chunk_cache_op_count,
+                          chunkCacheMissMap)
+DEFINE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_evict,
+                          internal_chunk_cache_op_count,
+                          chunkCacheEvictMap)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_chunk_cache_size,
+                               "[cpp]bytes of columns mmapped by chunk cache")
+DEFINE_PROMETHEUS_GAUGE(internal_chunk_cache_size_resident,
+                        internal_chunk_cache_size,
+                        chunkCacheResidentMap)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_anon_map_size,
+    "[cpp]bytes of the anonymous maps of the columns by page type")
+DEFINE_PROMETHEUS_GAUGE(internal_anon_map_size_huge,
+                        internal_anon_map_size,
+                        anonMapHugeMap)
+DEFINE_PROMETHEUS_GAUGE(internal_anon_map_size_normal,
+                        internal_anon_map_size,
+                        anonMapNormalMap)
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_anon_map_huge_page_fallback_count,
+    "[cpp]count of the hugetlb maps falling back to transparent huge pages")
+DEFINE_PROMETHEUS_COUNTER(internal_anon_map_huge_page_fallback,
+                          internal_anon_map_huge_page_fallback_count,
+                          anonMapFallbackMap)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_segment_memory_usage,
+    "[cpp]bytes of memory held by the loaded segments by component")
+DEFINE_PROMETHEUS_GAUGE(internal_segment_memory_usage_field_data,
+                        internal_segment_memory_usage,
+                        segmentMemoryFieldDataMap)
+DEFINE_PROMETHEUS_GAUGE(internal_segment_memory_usage_index,
+                        internal_segment_memory_usage,
+                        segmentMemoryIndexMap)
+DEFINE_PROMETHEUS_GAUGE(internal_segment_memory_usage_pk_index,
+                        internal_segment_memory_usage,
+                        segmentMemoryPkIndexMap)
+DEFINE_PROMETHEUS_GAUGE(internal_segment_memory_usage_timestamps,
+                        internal_segment_memory_usage,
+                        segmentMemoryTimestampsMap)
+DEFINE_PROMETHEUS_GAUGE(internal_segment_memory_usage_deleted_record,
+                        internal_segment_memory_usage,
+                        segmentMemoryDeletedRecordMap)
+
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_disk_cache_op_count,
+                                 "[cpp]count of remote file disk cache operation")
+DEFINE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_hit,
+                          internal_disk_cache_op_count,
+                          diskCacheHitMap)
+DEFINE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_miss,
+                          internal_disk_cache_op_count,
+                          diskCacheMissMap)
+DEFINE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_evict,
+                          internal_disk_cache_op_count,
+                          diskCacheEvictMap)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_disk_cache_size,
+                               "[cpp]bytes of remote files cached on disk")
+DEFINE_PROMETHEUS_GAUGE(internal_disk_cache_size_cached,
+                        internal_disk_cache_size,
+                        diskCacheCachedMap)
+
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_sealed_vector_search_count,
+    "[cpp]count of vector searches on indexed sealed segments by path")
+DEFINE_PROMETHEUS_COUNTER(internal_sealed_vector_search_count_index,
+                          internal_sealed_vector_search_count,
+                          vectorSearchIndexMap)
+DEFINE_PROMETHEUS_COUNTER(internal_sealed_vector_search_count_brute_force,
+                          internal_sealed_vector_search_count,
+                          vectorSearchBruteForceMap)
+
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_thread_pool_queue_depth,
+                               "[cpp]number of tasks queued in thread pool")
+DEFINE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_high,
+                        internal_thread_pool_queue_depth,
+                        threadPoolHighMap)
+DEFINE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_middle,
+                        internal_thread_pool_queue_depth,
+                        threadPoolMiddleMap)
+DEFINE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_low,
+                        internal_thread_pool_queue_depth,
+                        threadPoolLowMap)
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_thread_pool_wait_latency,
+    "[cpp]latency(ms) of tasks waiting in thread pool before running")
+DEFINE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_high,
+                            internal_thread_pool_wait_latency,
+                            threadPoolHighMap)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_middle,
+                            internal_thread_pool_wait_latency,
+                            threadPoolMiddleMap)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_low,
+                            internal_thread_pool_wait_latency,
+                            threadPoolLowMap)
+
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_disk_search_queue_depth,
+    "[cpp]number of searches on disk indexes waiting for admission")
+DEFINE_PROMETHEUS_GAUGE(internal_disk_search_queue_depth_queued,
+                        internal_disk_search_queue_depth,
+                        diskSearchQueuedMap)
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_disk_search_latency,
+    "[cpp]latency(ms) of searches on disk indexes by stage")
+DEFINE_PROMETHEUS_HISTOGRAM(internal_disk_search_latency_wait,
+                            internal_disk_search_latency,
+                            diskSearchWaitMap)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_disk_search_latency_read,
+                            internal_disk_search_latency,
+                            diskSearchReadMap)
+
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_core_search_latency,
+    "[cpp]latency(us) of the stages of the searches on the segments")
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_search_page_fault_count,
+    "[cpp]count of the page faults of the searches on the segments")
+
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_core_load_latency,
+    "[cpp]latency(us) of the stages of the loads of the binlogs by field")
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_load_bytes,
+    "[cpp]bytes of the binlogs downloaded by the loads by field")
 }  // namespace milvus::storage
@@ -53,6 +53,8 @@ class PrometheusClient {
 /*****************************************************************************/
 // prometheus metrics
 extern const prometheus::Histogram::BucketBoundaries buckets;
+// of the latencies(us) of the search stages
+extern const prometheus::Histogram::BucketBoundaries searchLatencyBuckets;
 extern const std::unique_ptr<PrometheusClient> prometheusClient;
 
 #define DEFINE_PROMETHEUS_GAUGE_FAMILY(name, desc)                \
@@ -104,6 +106,7 @@ DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_request_latency_remove);
 DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_op_count);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_get_suc);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_get_fail);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_get_hedged);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_put_suc);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_put_fail);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_stat_suc);
@@ -112,4 +115,60 @@ DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_list_suc);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_list_fail);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_remove_suc);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_op_count_remove_fail);
+
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_chunk_cache_op_count);
+DECLARE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_chunk_cache_op_count_evict);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_chunk_cache_size);
+DECLARE_PROMETHEUS_GAUGE(internal_chunk_cache_size_resident);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_anon_map_size);
+DECLARE_PROMETHEUS_GAUGE(internal_anon_map_size_huge);
+DECLARE_PROMETHEUS_GAUGE(internal_anon_map_size_normal);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_anon_map_huge_page_fallback_count);
+DECLARE_PROMETHEUS_COUNTER(internal_anon_map_huge_page_fallback);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_segment_memory_usage);
+DECLARE_PROMETHEUS_GAUGE(internal_segment_memory_usage_field_data);
+DECLARE_PROMETHEUS_GAUGE(internal_segment_memory_usage_index);
+DECLARE_PROMETHEUS_GAUGE(internal_segment_memory_usage_pk_index);
+DECLARE_PROMETHEUS_GAUGE(internal_segment_memory_usage_timestamps);
+DECLARE_PROMETHEUS_GAUGE(internal_segment_memory_usage_deleted_record);
+
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_disk_cache_op_count);
+DECLARE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_disk_cache_op_count_evict);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_disk_cache_size);
+DECLARE_PROMETHEUS_GAUGE(internal_disk_cache_size_cached);
+
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_sealed_vector_search_count);
+DECLARE_PROMETHEUS_COUNTER(internal_sealed_vector_search_count_index);
+DECLARE_PROMETHEUS_COUNTER(internal_sealed_vector_search_count_brute_force);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_thread_pool_queue_depth);
+DECLARE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_high);
+DECLARE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_middle);
+DECLARE_PROMETHEUS_GAUGE(internal_thread_pool_queue_depth_low);
+
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_thread_pool_wait_latency);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_high);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_middle);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_thread_pool_wait_latency_low);
+
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_disk_search_queue_depth);
+DECLARE_PROMETHEUS_GAUGE(internal_disk_search_queue_depth_queued);
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_disk_search_latency);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_disk_search_latency_wait);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_disk_search_latency_read);
+
+// labelled on the fly, see SearchMetrics.h
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_core_search_latency_family);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_search_page_fault_count_family);
+// labelled on the fly, see LoadMetrics.h
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_core_load_latency_family);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_load_bytes_family);
 }  // namespace milvus::storage
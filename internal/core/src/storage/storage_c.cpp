@@ -19,6 +19,7 @@
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "storage/LocalChunkManagerSingleton.h"
 #include "storage/ChunkCacheSingleton.h"
+#include "storage/SharedMmapStore.h"
 
 CStatus
 GetLocalUsedSize(const char* c_dir, int64_t* size) {
@@ -75,6 +76,12 @@ InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config) {
         storage_config.useVirtualHost = c_storage_config.useVirtualHost;
         storage_config.region = c_storage_config.region;
         storage_config.requestTimeoutMs = c_storage_config.requestTimeoutMs;
+        if (c_storage_config.readPartSize > 0) {
+            storage_config.read_part_size = c_storage_config.readPartSize;
+        }
+        if (c_storage_config.readConcurrency > 0) {
+            storage_config.read_concurrency = c_storage_config.readConcurrency;
+        }
         milvus::storage::RemoteChunkManagerSingleton::GetInstance().Init(
             storage_config);
 
@@ -85,10 +92,33 @@ InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config) {
 }
 
 CStatus
-InitChunkCacheSingleton(const char* c_dir_path, const char* read_ahead_policy) {
+InitChunkCacheSingleton(const char* c_dir_path,
+                        const char* read_ahead_policy,
+                        int64_t capacity_bytes) {
     try {
         milvus::storage::ChunkCacheSingleton::GetInstance().Init(
-            c_dir_path, read_ahead_policy);
+            c_dir_path, read_ahead_policy, capacity_bytes);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitRemoteDiskCache(const char* c_dir_path, int64_t capacity_bytes) {
+    try {
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+            .EnableDiskCache(c_dir_path, capacity_bytes);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitSharedMmapStore(const char* c_mmap_dir_path) {
+    try {
+        milvus::storage::SharedMmapStore::Init(c_mmap_dir_path);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
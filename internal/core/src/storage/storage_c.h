@@ -31,7 +31,17 @@ CStatus
 InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config);
 
 CStatus
-InitChunkCacheSingleton(const char* c_dir_path, const char* read_ahead_policy);
+InitChunkCacheSingleton(const char* c_dir_path,
+                        const char* read_ahead_policy,
+                        int64_t capacity_bytes);
+
+CStatus
+InitRemoteDiskCache(const char* c_dir_path, int64_t capacity_bytes);
+
+// share the mmapped files of the sealed segments with the other processes
+// of the host configured with the same mmap dir
+CStatus
+InitSharedMmapStore(const char* c_mmap_dir_path);
 
 void
 CleanRemoteChunkManagerSingleton();
@@ -13,7 +13,7 @@ struct ConstPtrWrapper {
 };
 
 using Block = unsigned long;
-using Allocator = std::allocator<Block>;
+using Allocator = boost::alignment::aligned_allocator<Block, 64>;
 
 }    // namespace
 
@@ -25,14 +25,14 @@ template<>
 void
 from_block_range<PtrWrapper, Block, Allocator>(PtrWrapper result,
                                               PtrWrapper resultB,
-                                              dynamic_bitset<>& bitset) {
+                                              dynamic_bitset<Block, Allocator>& bitset) {
     (void)resultB;
     result.ptr_ = reinterpret_cast<char*>(bitset.m_bits.data());
 }
 
 template<>
 void
-to_block_range<Block, Allocator, ConstPtrWrapper>(const dynamic_bitset<>& bitset,
+to_block_range<Block, Allocator, ConstPtrWrapper>(const dynamic_bitset<Block, Allocator>& bitset,
                                                   ConstPtrWrapper result) {
     result.ptr_ = reinterpret_cast<const char*>(bitset.m_bits.data());
 }
@@ -42,7 +42,7 @@ to_block_range<Block, Allocator, ConstPtrWrapper>(const dynamic_bitset<>& bitset
 namespace boost_ext {
 
 char*
-get_data(boost::dynamic_bitset<>& bitset) {
+get_data(boost::dynamic_bitset<Block, Allocator>& bitset) {
     char* ptr = nullptr;
     PtrWrapper wrapper{ptr};
     boost::from_block_range(wrapper, wrapper, bitset);
@@ -51,7 +51,7 @@ get_data(boost::dynamic_bitset<>& bitset) {
 }
 
 const char*
-get_data(const boost::dynamic_bitset<>& bitset) {
+get_data(const boost::dynamic_bitset<Block, Allocator>& bitset) {
     const char* ptr = nullptr;
     ConstPtrWrapper wrapper{ptr};
     boost::to_block_range(bitset, wrapper);
@@ -1,6 +1,11 @@
+#include <boost/align/aligned_allocator.hpp>
 #include <boost/dynamic_bitset.hpp>
 
 namespace boost_ext {
-const char* get_data(const boost::dynamic_bitset<>& bitset);
-char* get_data(boost::dynamic_bitset<>& bitset);
+using aligned_bitset =
+    boost::dynamic_bitset<unsigned long,
+                          boost::alignment::aligned_allocator<unsigned long, 64>>;
+
+const char* get_data(const aligned_bitset& bitset);
+char* get_data(aligned_bitset& bitset);
 }    // namespace boost_ext
@@ -0,0 +1,535 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// The benchmarks of the exec expressions, one per kernel, data type,
+// selectivity and segment, named
+//
+//     Expr/<kernel>/<field>/<segment>/sel:<percent of the rows passed>
+//
+// which is stable, so the results of two builds can be compared benchmark by
+// benchmark, see scripts/run_cpp_expr_bench.sh. Each reports rows/s as
+// items_per_second, the bytes/s of the columns read, and the selectivity
+// measured on the data.
+
+#include <algorithm>
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "common/Common.h"
+#include "exec/Task.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "query/generated/ExecPlanNodeVisitor.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/SegmentSealed.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t N = 1024 * 1024;
+
+// the percentages of the rows passing the filters
+const std::vector<int> selectivities = {1, 50, 99};
+
+const auto expr_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->AddDebugField("int8", DataType::INT8);
+    schema->AddDebugField("int32", DataType::INT32);
+    schema->AddDebugField("int32_b", DataType::INT32);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    schema->AddDebugField("double_b", DataType::DOUBLE);
+    schema->AddDebugField("varchar", DataType::VARCHAR);
+    schema->AddDebugField("json", DataType::JSON);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}();
+
+FieldId
+Field(const std::string& name) {
+    return (*expr_schema)[FieldName(name)].get_id();
+}
+
+DataType
+FieldType(const std::string& name) {
+    return (*expr_schema)[FieldName(name)].get_data_type();
+}
+
+// the data and the segments are built only if a benchmark filtered in reads
+// them
+const GeneratedData&
+Dataset() {
+    static const auto dataset = DataGen(expr_schema, N);
+    return dataset;
+}
+
+template <typename T>
+void
+LoadSortIndex(SegmentSealed& segment, const std::string& name) {
+    auto data = Dataset().get_col<T>(Field(name));
+    LoadIndexInfo info;
+    info.field_id = Field(name).get();
+    info.field_type = FieldType(name);
+    info.enable_mmap = false;
+    info.index_params["index_type"] = "sort";
+    info.index = GenScalarIndexing<T>(N, data.data());
+    segment.LoadIndex(info);
+}
+
+const SegmentInternalInterface*
+SealedSegment() {
+    static const auto segment = [] {
+        auto segment = CreateSealedSegment(expr_schema);
+        SealedLoadFieldData(Dataset(), *segment);
+        return segment;
+    }();
+    return segment.get();
+}
+
+const SegmentInternalInterface*
+SealedIndexSegment() {
+    static const auto segment = [] {
+        auto segment = CreateSealedSegment(expr_schema);
+        SealedLoadFieldData(Dataset(), *segment);
+        LoadSortIndex<int32_t>(*segment, "int32");
+        LoadSortIndex<int64_t>(*segment, "int64");
+        LoadSortIndex<double>(*segment, "double");
+        LoadSortIndex<std::string>(*segment, "varchar");
+        return segment;
+    }();
+    return segment.get();
+}
+
+// the same rows with the json path of the filters extracted
+const SegmentInternalInterface*
+JsonKeySegment() {
+    static const auto segment = [] {
+        auto segment = CreateSealedSegment(expr_schema);
+        segment->AddJsonKeyColumn(Field("json"), "/int", DataType::INT64);
+        SealedLoadFieldData(Dataset(), *segment);
+        return segment;
+    }();
+    return segment.get();
+}
+
+const SegmentInternalInterface*
+GrowingSegment() {
+    static const auto segment = [] {
+        auto& dataset = Dataset();
+        auto segment = CreateGrowingSegment(expr_schema, empty_index_meta);
+        segment->PreInsert(N);
+        segment->Insert(0,
+                        N,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+        return segment;
+    }();
+    return segment.get();
+}
+
+using SegmentGetter = const SegmentInternalInterface* (*)();
+
+struct SegmentCase {
+    std::string name;
+    SegmentGetter get;
+};
+
+// the int32, int64, double and varchar of the sealed_index segment are
+// indexed by sort
+const std::vector<SegmentCase> segment_cases = {
+    {"sealed", SealedSegment},
+    {"sealed_index", SealedIndexSegment},
+    {"growing", GrowingSegment},
+};
+
+// the average bytes of a row of the field
+int64_t
+RowBytes(const std::string& name) {
+    auto data_type = FieldType(name);
+    if (data_type == DataType::VARCHAR || data_type == DataType::JSON) {
+        auto data = Dataset().get_col<std::string>(Field(name));
+        int64_t bytes = 0;
+        for (auto& value : data) {
+            bytes += value.size();
+        }
+        return bytes / N;
+    }
+    return datatype_sizeof(data_type);
+}
+
+// the value the given percentage of the rows of the field are less than
+template <typename T>
+T
+Quantile(const std::string& name, int percent) {
+    auto data = Dataset().get_col<T>(Field(name));
+    std::vector<T> sorted(data.begin(), data.end());
+    auto pos = std::min<int64_t>(N * percent / 100, N - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + pos, sorted.end());
+    return sorted[pos];
+}
+
+template <typename T>
+proto::plan::GenericValue
+Value(T value) {
+    proto::plan::GenericValue val;
+    if constexpr (std::is_same_v<T, bool>) {
+        val.set_bool_val(value);
+    } else if constexpr (std::is_integral_v<T>) {
+        val.set_int64_val(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        val.set_float_val(value);
+    } else {
+        val.set_string_val(value);
+    }
+    return val;
+}
+
+// the value of the field the percentage of the rows are less than
+proto::plan::GenericValue
+QuantileValue(const std::string& name, int percent) {
+    switch (FieldType(name)) {
+        case DataType::INT8:
+            return Value<int64_t>(Quantile<int8_t>(name, percent));
+        case DataType::INT32:
+            return Value<int64_t>(Quantile<int32_t>(name, percent));
+        case DataType::INT64:
+            return Value<int64_t>(Quantile<int64_t>(name, percent));
+        case DataType::DOUBLE:
+            return Value(Quantile<double>(name, percent));
+        case DataType::VARCHAR:
+            return Value(Quantile<std::string>(name, percent));
+        default:
+            PanicInfo(DataTypeInvalid, "no quantile of field {}", name);
+    }
+}
+
+expr::ColumnInfo
+Column(const std::string& name, std::vector<std::string> nested_path = {}) {
+    return expr::ColumnInfo(Field(name), FieldType(name), nested_path);
+}
+
+expr::TypedExprPtr
+LessThan(const std::string& name, int percent) {
+    return std::make_shared<expr::UnaryRangeFilterExpr>(
+        Column(name),
+        proto::plan::OpType::LessThan,
+        QuantileValue(name, percent));
+}
+
+// the int of the json is in [0, 2^31)
+expr::TypedExprPtr
+JsonLessThan(int percent) {
+    return std::make_shared<expr::UnaryRangeFilterExpr>(
+        Column("json", {"int"}),
+        proto::plan::OpType::LessThan,
+        Value<int64_t>((int64_t(1) << 31) / 100 * percent));
+}
+
+// [1 - percent / 2, 1 + percent / 2] of the rows
+expr::TypedExprPtr
+Between(const std::string& name, int percent) {
+    return std::make_shared<expr::BinaryRangeFilterExpr>(
+        Column(name),
+        QuantileValue(name, 50 - percent / 2),
+        QuantileValue(name, 50 + (percent + 1) / 2),
+        true,
+        false);
+}
+
+// the rows of the values in the term are the percentage of the rows, at
+// least 1
+expr::TypedExprPtr
+Term(int percent) {
+    std::vector<proto::plan::GenericValue> values;
+    // the int64 of a row is its offset
+    for (int64_t i = 0; i < std::max<int64_t>(N * percent / 100, 1); ++i) {
+        values.push_back(Value<int64_t>(i));
+    }
+    return std::make_shared<expr::TermFilterExpr>(Column("int64"), values);
+}
+
+// (int64 + 7) < value
+expr::TypedExprPtr
+ArithLessThan(proto::plan::ArithOpType arith_op, int percent) {
+    auto value = QuantileValue("int64", percent);
+    value.set_int64_val(value.int64_val() + 7);
+    return std::make_shared<expr::BinaryArithOpEvalRangeExpr>(
+        Column("int64"),
+        proto::plan::OpType::LessThan,
+        arith_op,
+        value,
+        Value<int64_t>(7));
+}
+
+expr::TypedExprPtr
+Compare(const std::string& left, const std::string& right) {
+    return std::make_shared<expr::CompareExpr>(Field(left),
+                                               Field(right),
+                                               FieldType(left),
+                                               FieldType(right),
+                                               proto::plan::OpType::LessThan);
+}
+
+// the array of the json of every row is [1, 2, 3]
+expr::TypedExprPtr
+JsonContains(proto::plan::JSONContainsExpr_JSONOp op,
+             const std::vector<int64_t>& values) {
+    std::vector<proto::plan::GenericValue> vals;
+    for (auto value : values) {
+        vals.push_back(Value(value));
+    }
+    return std::make_shared<expr::JsonContainsExpr>(
+        Column("json", {"array"}), op, true, vals);
+}
+
+expr::TypedExprPtr
+Exists(const std::string& key) {
+    return std::make_shared<expr::ExistsExpr>(Column("json", {key}));
+}
+
+// the ratio of the rows passing the filter
+double
+Selectivity(const SegmentInternalInterface* segment,
+            const expr::TypedExprPtr& expr) {
+    auto plan_node =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    ExecPlanNodeVisitor visitor(*segment, MAX_TIMESTAMP);
+    BitsetType result;
+    visitor.ExecuteExprNode(plan_node, segment, result);
+    return result.empty() ? 0 : double(result.count()) / result.size();
+}
+
+// the exprs read the data for their values, so are built only by the
+// benchmarks filtered in
+using ExprMaker = std::function<expr::TypedExprPtr()>;
+
+void
+Filter(benchmark::State& state,
+       SegmentGetter get_segment,
+       const ExprMaker& make_expr,
+       const std::vector<std::string>& fields_read) {
+    auto segment = get_segment();
+    auto expr = make_expr();
+    int64_t row_bytes = 0;
+    for (auto& name : fields_read) {
+        row_bytes += RowBytes(name);
+    }
+    auto plan_node =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    auto plan = plan::PlanFragment(plan_node);
+    for (auto _ : state) {
+        auto query_context = std::make_shared<milvus::exec::QueryContext>(
+            "query id", segment, MAX_TIMESTAMP);
+        auto task =
+            milvus::exec::Task::Create("task_expr", plan, 0, query_context);
+        for (;;) {
+            auto result = task->Next();
+            if (!result) {
+                break;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    auto num_rows = segment->get_row_count();
+    state.SetItemsProcessed(state.iterations() * num_rows);
+    state.SetBytesProcessed(state.iterations() * num_rows * row_bytes);
+    state.counters["selectivity"] = Selectivity(segment, expr);
+}
+
+void
+Register(const std::string& name,
+         const SegmentCase& segment_case,
+         ExprMaker make_expr,
+         std::vector<std::string> fields_read) {
+    benchmark::RegisterBenchmark(("Expr/" + name + "/" + segment_case.name)
+                                     .c_str(),
+                                 Filter,
+                                 segment_case.get,
+                                 std::move(make_expr),
+                                 std::move(fields_read));
+}
+
+bool
+RegisterExprBenchmarks() {
+    using expr::LogicalBinaryExpr;
+    using expr::LogicalUnaryExpr;
+    using proto::plan::ArithOpType;
+    for (auto& segment_case : segment_cases) {
+        for (auto percent : selectivities) {
+            auto sel = "/sel:" + std::to_string(percent);
+            for (std::string name :
+                 {"int8", "int32", "int64", "double", "varchar"}) {
+                Register(
+                    "unary/" + name + sel,
+                    segment_case,
+                    [=] { return LessThan(name, percent); },
+                    {name});
+            }
+            for (std::string name : {"int32", "int64", "double"}) {
+                Register(
+                    "binary_range/" + name + sel,
+                    segment_case,
+                    [=] { return Between(name, percent); },
+                    {name});
+            }
+            Register(
+                "arith_add/int64" + sel,
+                segment_case,
+                [=] { return ArithLessThan(ArithOpType::Add, percent); },
+                {"int64"});
+            Register(
+                "unary/json" + sel,
+                segment_case,
+                [=] { return JsonLessThan(percent); },
+                {"json"});
+            Register(
+                "logical_and/int64_int32" + sel,
+                segment_case,
+                [=] {
+                    return std::make_shared<LogicalBinaryExpr>(
+                        LogicalBinaryExpr::OpType::And,
+                        LessThan("int64", percent),
+                        LessThan("int32", 50));
+                },
+                {"int64", "int32"});
+            Register(
+                "logical_or/int64_int32" + sel,
+                segment_case,
+                [=] {
+                    return std::make_shared<LogicalBinaryExpr>(
+                        LogicalBinaryExpr::OpType::Or,
+                        LessThan("int64", percent),
+                        LessThan("int32", 50));
+                },
+                {"int64", "int32"});
+            Register(
+                "logical_not/int64" + sel,
+                segment_case,
+                [=] {
+                    return std::make_shared<LogicalUnaryExpr>(
+                        LogicalUnaryExpr::OpType::LogicalNot,
+                        LessThan("int64", 100 - percent));
+                },
+                {"int64"});
+        }
+        // a term of a single value, and of the values of 1% of the rows
+        for (auto percent : {0, 1}) {
+            Register(
+                "term/int64/sel:" + std::to_string(percent),
+                segment_case,
+                [=] { return Term(percent); },
+                {"int64"});
+        }
+        Register(
+            "arith_mod/int64/sel:50",
+            segment_case,
+            [] {
+                return std::make_shared<expr::BinaryArithOpEvalRangeExpr>(
+                    Column("int64"),
+                    proto::plan::OpType::Equal,
+                    ArithOpType::Mod,
+                    Value<int64_t>(0),
+                    Value<int64_t>(2));
+            },
+            {"int64"});
+        // the columns compared are independent
+        Register(
+            "compare/int32_int32/sel:50",
+            segment_case,
+            [] { return Compare("int32", "int32_b"); },
+            {"int32", "int32_b"});
+        Register(
+            "compare/double_double/sel:50",
+            segment_case,
+            [] { return Compare("double", "double_b"); },
+            {"double", "double_b"});
+        // the int32 is in [0, 2N), the int64 in [0, N)
+        Register(
+            "compare/int64_int32/sel:75",
+            segment_case,
+            [] { return Compare("int64", "int32"); },
+            {"int64", "int32"});
+        Register(
+            "json_contains_any/json/sel:100",
+            segment_case,
+            [] {
+                return JsonContains(
+                    proto::plan::JSONContainsExpr_JSONOp_ContainsAny, {1, 4});
+            },
+            {"json"});
+        Register(
+            "json_contains_all/json/sel:0",
+            segment_case,
+            [] {
+                return JsonContains(
+                    proto::plan::JSONContainsExpr_JSONOp_ContainsAll, {1, 4});
+            },
+            {"json"});
+        Register(
+            "exists/json/sel:100",
+            segment_case,
+            [] { return Exists("int"); },
+            {"json"});
+        Register(
+            "exists/json/sel:0",
+            segment_case,
+            [] { return Exists("missing"); },
+            {"json"});
+    }
+    return true;
+}
+
+const bool expr_benchmarks_registered = RegisterExprBenchmarks();
+
+}  // namespace
+
+// state.range(0) is the working set size in KiB, 0 for the fixed batch size
+static void
+Filter_Sealed(benchmark::State& state,
+              SegmentGetter get_segment,
+              ExprMaker make_expr) {
+    auto prev_working_set_size = EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = state.range(0) * 1024;
+    Filter(state, get_segment, make_expr, {});
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = prev_working_set_size;
+}
+
+BENCHMARK_CAPTURE(Filter_Sealed, int8, SealedSegment, [] {
+    return LessThan("int8", 50);
+})
+    ->Arg(0)
+    ->Arg(64)
+    ->Arg(256);
+BENCHMARK_CAPTURE(Filter_Sealed, int64, SealedSegment, [] {
+    return LessThan("int64", 50);
+})
+    ->Arg(0)
+    ->Arg(64)
+    ->Arg(256);
+BENCHMARK_CAPTURE(Filter_Sealed, json, SealedSegment, [] {
+    return JsonLessThan(50);
+})
+    ->Arg(0)
+    ->Arg(64)
+    ->Arg(256);
+BENCHMARK_CAPTURE(Filter_Sealed, json_key_column, JsonKeySegment, [] {
+    return JsonLessThan(50);
+})
+    ->Arg(256);
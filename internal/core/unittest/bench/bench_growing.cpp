@@ -0,0 +1,305 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// The stress benchmarks of a growing segment inserted, deleted, searched and
+// retrieved by concurrent threads, named
+//
+//     Growing/insert/threads:<inserting threads>
+//     Growing/mixed/threads:<threads of each of the four calls>
+//
+// Every iteration runs the threads on a new segment for a fixed time, and
+// reports the rows inserted and deleted per second, and the p50 and p99
+// latencies of the searches and the retrieves, so the contention among the
+// writers and the readers shows as the threads scale.
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "common/Consts.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "query/PlanImpl.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t dim = 128;
+// the rows of the segment before the threads start
+constexpr int64_t base_rows = 64 * 1024;
+constexpr int64_t insert_batch_rows = 1000;
+constexpr int64_t delete_batch_rows = 100;
+constexpr int64_t retrieve_pks = 10;
+constexpr auto run_time = std::chrono::seconds(2);
+
+const auto growing_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    schema->AddDebugField("float", DataType::FLOAT);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}();
+
+FieldId
+Field(const std::string& name) {
+    return (*growing_schema)[FieldName(name)].get_id();
+}
+
+const auto search_plan = [] {
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: 10
+                                  round_decimal: -1
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 10}"
+                                >
+                                placeholder_tag: "$0"
+        >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    return CreateSearchPlanByExpr(
+        *growing_schema, plan_str.data(), plan_str.size());
+}();
+
+const auto ph_group = [] {
+    auto ph_group_raw = CreatePlaceholderGroup(10, dim, 1024);
+    return ParsePlaceholderGroup(search_plan.get(),
+                                 ph_group_raw.SerializeAsString());
+}();
+
+std::unique_ptr<RetrievePlan>
+PkRetrievePlan(const std::vector<int64_t>& pks) {
+    std::vector<proto::plan::GenericValue> values;
+    for (auto pk : pks) {
+        proto::plan::GenericValue value;
+        value.set_int64_val(pk);
+        values.push_back(value);
+    }
+    auto term_expr = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(
+            Field("int64"), DataType::INT64, std::vector<std::string>()),
+        values);
+    auto plan = std::make_unique<RetrievePlan>(*growing_schema);
+    plan->plan_node_ = std::make_unique<RetrievePlanNode>();
+    plan->plan_node_->filter_plannode_ =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, term_expr);
+    plan->field_ids_ = {Field("int64"), Field("float")};
+    return plan;
+}
+
+// the rows of the batch inserted by an inserting thread, whose pks and row
+// ids are rewritten to the offsets of the rows for each insert
+class InsertBatch {
+ public:
+    explicit InsertBatch(uint64_t seed)
+        : dataset_(DataGen(growing_schema, insert_batch_rows, seed)),
+          row_ids_(insert_batch_rows),
+          timestamps_(insert_batch_rows) {
+        for (auto& field_data : *dataset_.raw_->mutable_fields_data()) {
+            if (field_data.field_id() == Field("int64").get()) {
+                pks_ = field_data.mutable_scalars()
+                           ->mutable_long_data()
+                           ->mutable_data();
+            }
+        }
+    }
+
+    void
+    InsertInto(SegmentGrowing& segment) {
+        auto offset = segment.PreInsert(insert_batch_rows);
+        for (int64_t i = 0; i < insert_batch_rows; ++i) {
+            row_ids_[i] = offset + i;
+            pks_->Set(i, offset + i);
+            // the timestamps are in the order of the offsets
+            timestamps_[i] = offset + i + 1;
+        }
+        segment.Insert(offset,
+                       insert_batch_rows,
+                       row_ids_.data(),
+                       timestamps_.data(),
+                       dataset_.raw_);
+    }
+
+ private:
+    GeneratedData dataset_;
+    google::protobuf::RepeatedField<int64_t>* pks_ = nullptr;
+    std::vector<int64_t> row_ids_;
+    std::vector<Timestamp> timestamps_;
+};
+
+std::chrono::steady_clock::duration
+Percentile(std::vector<std::chrono::steady_clock::duration>& latencies,
+           double percent) {
+    if (latencies.empty()) {
+        return {};
+    }
+    auto nth = latencies.begin() +
+               static_cast<int64_t>((latencies.size() - 1) * percent / 100);
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+}
+
+// the latencies of a kind of calls of all the threads
+class Latencies {
+ public:
+    void
+    Merge(const std::vector<std::chrono::steady_clock::duration>& latencies) {
+        std::lock_guard lck(mutex_);
+        latencies_.insert(latencies_.end(), latencies.begin(), latencies.end());
+    }
+
+    void
+    Report(benchmark::State& state, const std::string& name) {
+        auto ms = [](std::chrono::steady_clock::duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        state.counters[name + "_p50_ms"] = ms(Percentile(latencies_, 50));
+        state.counters[name + "_p99_ms"] = ms(Percentile(latencies_, 99));
+        state.counters[name + "_per_s"] =
+            benchmark::Counter(latencies_.size(), benchmark::Counter::kIsRate);
+    }
+
+ private:
+    std::mutex mutex_;
+    std::vector<std::chrono::steady_clock::duration> latencies_;
+};
+
+// run the call until stop, the latencies of the calls are merged at the end
+template <typename Call>
+std::thread
+RunUntil(const std::atomic<bool>& stop, Latencies* latencies, Call call) {
+    return std::thread([&stop, latencies, call]() mutable {
+        std::vector<std::chrono::steady_clock::duration> thread_latencies;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto start = std::chrono::steady_clock::now();
+            call();
+            thread_latencies.push_back(std::chrono::steady_clock::now() -
+                                       start);
+        }
+        if (latencies != nullptr) {
+            latencies->Merge(thread_latencies);
+        }
+    });
+}
+
+void
+GrowingStress(benchmark::State& state, bool mixed) {
+    auto num_threads = state.range(0);
+    std::atomic<int64_t> inserted_rows{0};
+    std::atomic<int64_t> deleted_rows{0};
+    Latencies search_latencies, retrieve_latencies;
+    for (auto _ : state) {
+        auto segment = CreateGrowingSegment(growing_schema, empty_index_meta);
+        for (int64_t rows = 0; rows < base_rows; rows += insert_batch_rows) {
+            InsertBatch(rows).InsertInto(*segment);
+        }
+        // the rows inserted by the threads are counted from here
+        auto inserted_base = segment->get_row_count();
+
+        std::atomic<bool> stop{false};
+        std::atomic<Timestamp> delete_ts{Timestamp(1) << 40};
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t t = 0; t < num_threads; ++t) {
+            auto batch = std::make_shared<InsertBatch>(42 + t);
+            threads.push_back(RunUntil(stop, nullptr, [&, batch] {
+                batch->InsertInto(*segment);
+            }));
+            if (!mixed) {
+                continue;
+            }
+            auto delete_engine =
+                std::make_shared<std::default_random_engine>(t);
+            threads.push_back(RunUntil(stop, nullptr, [&, delete_engine] {
+                std::uniform_int_distribution<int64_t> pk_distr(
+                    0, segment->get_row_count() - 1);
+                std::vector<int64_t> pks(delete_batch_rows);
+                for (auto& pk : pks) {
+                    pk = pk_distr(*delete_engine);
+                }
+                auto ids = GenPKs(pks.begin(), pks.end());
+                auto tss = GenTss(delete_batch_rows,
+                                  delete_ts.fetch_add(delete_batch_rows));
+                segment->Delete(0, delete_batch_rows, ids.get(), tss.data());
+                deleted_rows += delete_batch_rows;
+            }));
+            threads.push_back(RunUntil(stop, &search_latencies, [&] {
+                benchmark::DoNotOptimize(
+                    segment->Search(search_plan.get(), ph_group.get()));
+            }));
+            auto retrieve_engine =
+                std::make_shared<std::default_random_engine>(num_threads + t);
+            threads.push_back(RunUntil(
+                stop, &retrieve_latencies, [&, retrieve_engine] {
+                    std::uniform_int_distribution<int64_t> pk_distr(
+                        0, segment->get_row_count() - 1);
+                    std::vector<int64_t> pks(retrieve_pks);
+                    for (auto& pk : pks) {
+                        pk = pk_distr(*retrieve_engine);
+                    }
+                    auto plan = PkRetrievePlan(pks);
+                    benchmark::DoNotOptimize(segment->Retrieve(
+                        plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE));
+                }));
+        }
+        std::this_thread::sleep_for(run_time);
+        stop.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        state.SetIterationTime(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                          start)
+                .count());
+        inserted_rows += segment->get_row_count() - inserted_base;
+    }
+
+    auto rate = benchmark::Counter::kIsRate;
+    state.counters["insert_rows_per_s"] =
+        benchmark::Counter(inserted_rows.load(), rate);
+    if (mixed) {
+        state.counters["delete_rows_per_s"] =
+            benchmark::Counter(deleted_rows.load(), rate);
+        search_latencies.Report(state, "search");
+        retrieve_latencies.Report(state, "retrieve");
+    }
+}
+
+void
+ThreadCounts(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("threads");
+    for (int64_t threads = 1; threads <= 16; threads *= 2) {
+        bench->Arg(threads);
+    }
+    bench->Iterations(3)->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+const auto insert_bench =
+    benchmark::RegisterBenchmark("Growing/insert", GrowingStress, false)
+        ->Apply(ThreadCounts);
+const auto mixed_bench =
+    benchmark::RegisterBenchmark("Growing/mixed", GrowingStress, true)
+        ->Apply(ThreadCounts);
+
+}  // namespace
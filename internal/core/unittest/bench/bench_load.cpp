@@ -0,0 +1,751 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// The benchmarks of loading the segments from the binlogs and the index files,
+// named
+//
+//     Load/field_data/<schema>/<heap|mmap>/<local|remote>
+//     Load/index/<index type>/<heap|mmap>/<local|remote>
+//     Load/chunk_cache/<schema>/<local|remote>
+//
+// The files are written once by the codecs of the storage into a local
+// directory, and served by the LocalChunkManager, or by an emulation of the
+// remote storage which adds the latency of each request and shares a fixed
+// bandwidth among the requests in flight. Each reports the load time, rows/s
+// as items_per_second, the bytes/s of the files read, the peak RSS grown by a
+// load and the cores busy on average during the loads.
+//
+// The settings of the process are read from the environment:
+//
+//     LOAD_BENCH_ROWS                     rows of a segment, 200000
+//     LOAD_BENCH_BINLOGS                  binlogs of a field, 8
+//     LOAD_BENCH_REMOTE_LATENCY_MS        latency of a remote request, 10
+//     LOAD_BENCH_REMOTE_BANDWIDTH_MBPS    remote bandwidth in MB/s, 200
+//     LOAD_BENCH_HIGH_POOL_COEFFICIENT    threads per core of the pools,
+//     LOAD_BENCH_MIDDLE_POOL_COEFFICIENT  the defaults of segcore if unset
+//     LOAD_BENCH_LOW_POOL_COEFFICIENT
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/Common.h"
+#include "common/Consts.h"
+#include "index/IndexFactory.h"
+#include "segcore/SegmentSealed.h"
+#include "segcore/Types.h"
+#include "segcore/Utils.h"
+#include "storage/ChunkCache.h"
+#include "storage/InsertData.h"
+#include "storage/LocalChunkManager.h"
+#include "storage/RemoteChunkManagerSingleton.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+const std::string bench_dir = "/tmp/milvus_load_bench";
+const std::string objects_dir = bench_dir + "/objects";
+const std::string mmap_dir = bench_dir + "/mmap";
+constexpr int64_t dim = 128;
+
+int64_t
+EnvOr(const char* name, int64_t default_value) {
+    auto value = std::getenv(name);
+    return value == nullptr ? default_value : std::stoll(value);
+}
+
+const int64_t num_rows = EnvOr("LOAD_BENCH_ROWS", 200000);
+const int64_t num_binlogs = EnvOr("LOAD_BENCH_BINLOGS", 8);
+
+// The emulation of the object storage, which stores the objects by their keys
+// in a local directory through the LocalChunkManager. Each request waits for
+// the latency, then for its bytes to go through the bandwidth shared by all the
+// requests, as a request to MinIO over a saturated link does. 0 means no
+// latency or an unlimited bandwidth.
+class RemoteEmulator : public storage::ChunkManager {
+ public:
+    RemoteEmulator(std::string dir,
+                   std::chrono::microseconds latency,
+                   int64_t bytes_per_second)
+        : dir_(std::move(dir)),
+          local_(dir_),
+          latency_(latency),
+          bytes_per_second_(bytes_per_second) {
+    }
+
+    bool
+    Exist(const std::string& filepath) override {
+        Request(0);
+        return local_.Exist(LocalPath(filepath));
+    }
+
+    uint64_t
+    Size(const std::string& filepath) override {
+        Request(0);
+        return local_.Size(LocalPath(filepath));
+    }
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override {
+        auto size = local_.Read(LocalPath(filepath), buf, len);
+        Request(size);
+        return size;
+    }
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override {
+        Request(len);
+        local_.Write(LocalPath(filepath), buf, len);
+    }
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override {
+        auto size = local_.Read(LocalPath(filepath), offset, buf, len);
+        Request(size);
+        return size;
+    }
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override {
+        Request(len);
+        local_.Write(LocalPath(filepath), offset, buf, len);
+    }
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override {
+        Request(0);
+        std::vector<std::string> keys;
+        auto prefix = LocalPath(filepath);
+        auto dir = std::filesystem::path(prefix).parent_path();
+        if (!std::filesystem::exists(dir)) {
+            return keys;
+        }
+        for (auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+            auto path = entry.path().string();
+            if (entry.is_regular_file() && path.rfind(prefix, 0) == 0) {
+                keys.push_back(path.substr(dir_.size() + 1));
+            }
+        }
+        return keys;
+    }
+
+    void
+    Remove(const std::string& filepath) override {
+        Request(0);
+        local_.Remove(LocalPath(filepath));
+    }
+
+    std::string
+    GetName() const override {
+        return "RemoteEmulator";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return "files";
+    }
+
+    int64_t
+    Requests() const {
+        return requests_.load();
+    }
+
+    int64_t
+    Bytes() const {
+        return bytes_.load();
+    }
+
+ private:
+    std::string
+    LocalPath(const std::string& key) const {
+        return dir_ + "/" + key;
+    }
+
+    void
+    Request(uint64_t bytes) {
+        requests_++;
+        bytes_ += bytes;
+        auto done = std::chrono::steady_clock::now() + latency_;
+        if (bytes > 0 && bytes_per_second_ > 0) {
+            auto transfer =
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(double(bytes) /
+                                                  bytes_per_second_));
+            std::lock_guard lck(mutex_);
+            link_free_ = std::max(done, link_free_) + transfer;
+            done = link_free_;
+        }
+        std::this_thread::sleep_until(done);
+    }
+
+ private:
+    const std::string dir_;
+    storage::LocalChunkManager local_;
+    const std::chrono::microseconds latency_;
+    const int64_t bytes_per_second_;
+
+    std::mutex mutex_;
+    // the time the bandwidth is used up to by the requests in flight
+    std::chrono::steady_clock::time_point link_free_;
+
+    std::atomic<int64_t> requests_{0};
+    std::atomic<int64_t> bytes_{0};
+};
+
+using RemoteEmulatorPtr = std::shared_ptr<RemoteEmulator>;
+
+// the thread pools are set up once for the process, before their first use
+void
+SetUp() {
+    static const bool done = [] {
+        auto high = EnvOr("LOAD_BENCH_HIGH_POOL_COEFFICIENT", 0);
+        auto middle = EnvOr("LOAD_BENCH_MIDDLE_POOL_COEFFICIENT", 0);
+        auto low = EnvOr("LOAD_BENCH_LOW_POOL_COEFFICIENT", 0);
+        if (high > 0) {
+            SetHighPriorityThreadCoreCoefficient(high);
+        }
+        if (middle > 0) {
+            SetMiddlePriorityThreadCoreCoefficient(middle);
+        }
+        if (low > 0) {
+            SetLowPriorityThreadCoreCoefficient(low);
+        }
+        std::filesystem::remove_all(bench_dir);
+        return true;
+    }();
+    (void)done;
+}
+
+// the manager writing the files, which are then read through Storage()
+const RemoteEmulatorPtr&
+Writer() {
+    static const auto writer = std::make_shared<RemoteEmulator>(
+        objects_dir, std::chrono::microseconds(0), 0);
+    return writer;
+}
+
+RemoteEmulatorPtr
+Storage(bool remote) {
+    if (!remote) {
+        return std::make_shared<RemoteEmulator>(
+            objects_dir, std::chrono::microseconds(0), 0);
+    }
+    return std::make_shared<RemoteEmulator>(
+        objects_dir,
+        std::chrono::milliseconds(EnvOr("LOAD_BENCH_REMOTE_LATENCY_MS", 10)),
+        EnvOr("LOAD_BENCH_REMOTE_BANDWIDTH_MBPS", 200) * 1024 * 1024);
+}
+
+SchemaPtr
+ScalarSchema() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("bool", DataType::BOOL);
+    schema->AddDebugField("int8", DataType::INT8);
+    schema->AddDebugField("int32", DataType::INT32);
+    schema->AddDebugField("float", DataType::FLOAT);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}
+
+SchemaPtr
+VectorSchema() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "vector", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}
+
+SchemaPtr
+VarLenSchema() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("varchar", DataType::VARCHAR);
+    schema->AddDebugField("json", DataType::JSON);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}
+
+const std::map<std::string, std::function<SchemaPtr()>> schemas = {
+    {"scalar", ScalarSchema},
+    {"vector", VectorSchema},
+    {"varlen", VarLenSchema},
+};
+
+struct Binlogs {
+    SchemaPtr schema;
+    LoadFieldDataInfo load_info;
+    // the binlogs of the fields of the schema, without the system fields
+    std::vector<std::string> field_files;
+    int64_t bytes = 0;
+};
+
+// the binlogs of a segment of the schema, written once by the insert codec,
+// each field split into num_binlogs files
+const Binlogs&
+SegmentBinlogs(const std::string& schema_name) {
+    static std::mutex mutex;
+    static std::map<std::string, Binlogs> binlogs;
+    std::lock_guard lck(mutex);
+    auto iter = binlogs.find(schema_name);
+    if (iter != binlogs.end()) {
+        return iter->second;
+    }
+
+    Binlogs result;
+    result.schema = schemas.at(schema_name)();
+    auto rows_per_binlog = (num_rows + num_binlogs - 1) / num_binlogs;
+    auto Save = [&](int64_t field_id,
+                    const FieldDataPtr& field_data,
+                    int64_t rows,
+                    int64_t binlog) {
+        auto insert_data = std::make_shared<storage::InsertData>(field_data);
+        insert_data->SetFieldDataMeta(
+            storage::FieldDataMeta{1, 2, 3, field_id});
+        auto serialized = insert_data->serialize_to_remote_file();
+        auto file = fmt::format("{}/insert_log/{}/{}/{}",
+                                Writer()->GetRootPath(),
+                                schema_name,
+                                field_id,
+                                binlog);
+        Writer()->Write(file, serialized.data(), serialized.size());
+        result.bytes += serialized.size();
+
+        auto& info = result.load_info.field_infos[field_id];
+        info.field_id = field_id;
+        info.row_count = std::max<int64_t>(info.row_count, 0) + rows;
+        info.entries_nums.push_back(rows);
+        info.insert_files.push_back(file);
+        if (field_id >= START_USER_FIELDID) {
+            result.field_files.push_back(file);
+        }
+    };
+
+    for (int64_t binlog = 0; binlog * rows_per_binlog < num_rows; ++binlog) {
+        auto offset = binlog * rows_per_binlog;
+        auto rows = std::min(rows_per_binlog, num_rows - offset);
+        auto dataset = DataGen(result.schema, rows, 42 + binlog, offset);
+
+        std::vector<int64_t> row_ids(rows);
+        std::iota(row_ids.begin(), row_ids.end(), offset);
+        auto row_id_data =
+            std::make_shared<FieldData<int64_t>>(DataType::INT64);
+        row_id_data->FillFieldData(row_ids.data(), rows);
+        Save(RowFieldID.get(), row_id_data, rows, binlog);
+
+        auto timestamp_data =
+            std::make_shared<FieldData<int64_t>>(DataType::INT64);
+        timestamp_data->FillFieldData(dataset.timestamps_.data(), rows);
+        Save(TimestampFieldID.get(), timestamp_data, rows, binlog);
+
+        for (auto& data : dataset.raw_->fields_data()) {
+            auto& field_meta = (*result.schema)[FieldId(data.field_id())];
+            Save(data.field_id(),
+                 CreateFieldDataFromDataArray(rows, &data, field_meta),
+                 rows,
+                 binlog);
+        }
+    }
+    return binlogs.emplace(schema_name, std::move(result)).first->second;
+}
+
+int64_t
+ResidentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+std::chrono::microseconds
+ProcessCpuTime() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec +
+                                     usage.ru_stime.tv_usec);
+}
+
+// samples the RSS and the cpu time of the process during a load, the peak RSS
+// is sampled every millisecond, so the spikes shorter than that may be missed
+class LoadMeter {
+ public:
+    LoadMeter()
+        : base_rss_(ResidentBytes()),
+          peak_rss_(base_rss_),
+          start_(std::chrono::steady_clock::now()),
+          start_cpu_(ProcessCpuTime()) {
+        sampler_ = std::thread([this] {
+            while (!stop_.load()) {
+                auto rss = ResidentBytes();
+                if (rss > peak_rss_.load()) {
+                    peak_rss_.store(rss);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    ~LoadMeter() {
+        Stop();
+    }
+
+    void
+    Stop() {
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        wall_ = std::chrono::steady_clock::now() - start_;
+        cpu_ = ProcessCpuTime() - start_cpu_;
+        stop_.store(true);
+        sampler_.join();
+        peak_rss_.store(std::max(peak_rss_.load(), ResidentBytes()));
+    }
+
+    // the RSS grown by the load at its peak
+    int64_t
+    PeakRssGrowth() const {
+        return peak_rss_.load() - base_rss_;
+    }
+
+    std::chrono::steady_clock::duration
+    WallTime() const {
+        return wall_;
+    }
+
+    std::chrono::microseconds
+    CpuTime() const {
+        return cpu_;
+    }
+
+ private:
+    const int64_t base_rss_;
+    std::atomic<int64_t> peak_rss_;
+    const std::chrono::steady_clock::time_point start_;
+    const std::chrono::microseconds start_cpu_;
+    std::atomic<bool> stop_{false};
+    bool stopped_ = false;
+    std::thread sampler_;
+    std::chrono::steady_clock::duration wall_{};
+    std::chrono::microseconds cpu_{};
+};
+
+// accumulates the meters of the iterations into the counters of the benchmark
+struct LoadCounters {
+    int64_t peak_rss_growth = 0;
+    std::chrono::steady_clock::duration wall{};
+    std::chrono::microseconds cpu{};
+
+    void
+    Add(const LoadMeter& meter) {
+        peak_rss_growth = std::max(peak_rss_growth, meter.PeakRssGrowth());
+        wall += meter.WallTime();
+        cpu += meter.CpuTime();
+    }
+
+    void
+    Report(benchmark::State& state,
+           const RemoteEmulator& storage,
+           int64_t rows,
+           int64_t bytes) const {
+        state.SetItemsProcessed(state.iterations() * rows);
+        state.SetBytesProcessed(state.iterations() * bytes);
+        state.counters["peak_rss_growth_mb"] =
+            double(peak_rss_growth) / 1024 / 1024;
+        state.counters["cpu_cores"] =
+            wall.count() == 0
+                ? 0
+                : std::chrono::duration<double>(cpu).count() /
+                      std::chrono::duration<double>(wall).count();
+        state.counters["requests"] = benchmark::Counter(
+            storage.Requests(), benchmark::Counter::kAvgIterations);
+    }
+};
+
+void
+LoadFieldDataBench(benchmark::State& state,
+                   std::string schema_name,
+                   bool mmap,
+                   bool remote) {
+    SetUp();
+    auto& binlogs = SegmentBinlogs(schema_name);
+    auto storage = Storage(remote);
+    storage::RemoteChunkManagerSingleton::GetInstance().SetRemoteChunkManager(
+        storage);
+
+    auto load_info = binlogs.load_info;
+    if (mmap) {
+        load_info.mmap_dir_path = mmap_dir;
+        for (auto& [_, info] : load_info.field_infos) {
+            info.enable_mmap = true;
+        }
+    }
+
+    LoadCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateSealedSegment(binlogs.schema);
+        state.ResumeTiming();
+
+        LoadMeter meter;
+        segment->LoadFieldData(load_info);
+        meter.Stop();
+        counters.Add(meter);
+
+        state.PauseTiming();
+        segment.reset();
+        std::filesystem::remove_all(mmap_dir);
+        state.ResumeTiming();
+    }
+    counters.Report(state, *storage, num_rows, binlogs.bytes);
+}
+
+struct IndexFiles {
+    std::vector<std::string> files;
+    int64_t bytes = 0;
+};
+
+index::CreateIndexInfo
+VectorIndexInfo(const std::string& index_type) {
+    index::CreateIndexInfo create_index_info;
+    create_index_info.index_type = index_type;
+    create_index_info.metric_type = knowhere::metric::L2;
+    create_index_info.field_type = DataType::VECTOR_FLOAT;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+    return create_index_info;
+}
+
+storage::FileManagerContext
+VectorIndexContext(const storage::ChunkManagerPtr& cm) {
+    auto field_id = (*VectorSchema())[FieldName("vector")].get_id().get();
+    return storage::FileManagerContext(
+        storage::FieldDataMeta{1, 2, 3, field_id},
+        storage::IndexMeta{3, field_id, 1000, 1},
+        cm);
+}
+
+// the files of the index built on the vectors of a segment, built and
+// uploaded once
+const IndexFiles&
+VectorIndexFiles(const std::string& index_type) {
+    static std::mutex mutex;
+    static std::map<std::string, IndexFiles> index_files;
+    std::lock_guard lck(mutex);
+    auto iter = index_files.find(index_type);
+    if (iter != index_files.end()) {
+        return iter->second;
+    }
+
+    auto schema = VectorSchema();
+    auto dataset = DataGen(schema, num_rows);
+    auto vectors =
+        dataset.get_col<float>((*schema)[FieldName("vector")].get_id());
+    auto index = index::IndexFactory::GetInstance().CreateIndex(
+        VectorIndexInfo(index_type), VectorIndexContext(Writer()));
+    auto build_conf =
+        knowhere::Json{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                       {knowhere::meta::DIM, std::to_string(dim)}};
+    if (index_type == knowhere::IndexEnum::INDEX_HNSW) {
+        build_conf[knowhere::indexparam::HNSW_M] = "16";
+        build_conf[knowhere::indexparam::EFCONSTRUCTION] = "200";
+    } else {
+        build_conf[knowhere::indexparam::NLIST] = "128";
+    }
+    index->BuildWithDataset(
+        knowhere::GenDataSet(num_rows, dim, vectors.data()), build_conf);
+
+    IndexFiles result;
+    auto binary_set = index->Upload();
+    for (auto& [file, binary] : binary_set.binary_map_) {
+        result.files.push_back(file);
+        result.bytes += binary->size;
+    }
+    return index_files.emplace(index_type, std::move(result)).first->second;
+}
+
+void
+LoadIndexBench(benchmark::State& state,
+               std::string index_type,
+               bool mmap,
+               bool remote) {
+    SetUp();
+    auto& index_files = VectorIndexFiles(index_type);
+    auto storage = Storage(remote);
+    auto schema = VectorSchema();
+    auto field_id = (*schema)[FieldName("vector")].get_id();
+
+    Config config{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                  {knowhere::meta::DIM, std::to_string(dim)},
+                  {"index_files", index_files.files}};
+    if (mmap) {
+        config["mmap_filepath"] = mmap_dir + "/index";
+    }
+
+    LoadCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateSealedSegment(schema);
+        state.ResumeTiming();
+
+        LoadMeter meter;
+        auto index = index::IndexFactory::GetInstance().CreateIndex(
+            VectorIndexInfo(index_type), VectorIndexContext(storage));
+        if (mmap && !index->IsMmapSupported()) {
+            state.SkipWithError("the index does not support mmap");
+            break;
+        }
+        index->Load(config);
+        LoadIndexInfo load_info;
+        load_info.field_id = field_id.get();
+        load_info.field_type = DataType::VECTOR_FLOAT;
+        load_info.enable_mmap = mmap;
+        load_info.mmap_dir_path = mmap_dir;
+        load_info.index_params["index_type"] = index_type;
+        load_info.index_params["metric_type"] = knowhere::metric::L2;
+        load_info.index = std::move(index);
+        segment->LoadIndex(load_info);
+        meter.Stop();
+        counters.Add(meter);
+
+        state.PauseTiming();
+        segment.reset();
+        std::filesystem::remove_all(mmap_dir);
+        state.ResumeTiming();
+    }
+    counters.Report(state, *storage, num_rows, index_files.bytes);
+}
+
+// downloads and mmaps all the binlogs of the fields through a chunk cache, as
+// the lazy loads of the columns do
+void
+ChunkCacheBench(benchmark::State& state, std::string schema_name, bool remote) {
+    SetUp();
+    auto& binlogs = SegmentBinlogs(schema_name);
+    auto storage = Storage(remote);
+
+    LoadCounters counters;
+    for (auto _ : state) {
+        storage::ChunkCache cache(mmap_dir, "willneed", storage);
+        LoadMeter meter;
+        for (auto& file : binlogs.field_files) {
+            cache.PrefetchAsync(file);
+        }
+        for (auto& file : binlogs.field_files) {
+            benchmark::DoNotOptimize(cache.Read(file));
+        }
+        meter.Stop();
+        counters.Add(meter);
+
+        state.PauseTiming();
+        for (auto& file : binlogs.field_files) {
+            cache.Remove(file);
+        }
+        std::filesystem::remove_all(mmap_dir);
+        state.ResumeTiming();
+    }
+    counters.Report(state, *storage, num_rows, binlogs.bytes);
+}
+
+const char*
+MmapName(bool mmap) {
+    return mmap ? "mmap" : "heap";
+}
+
+const char*
+StorageName(bool remote) {
+    return remote ? "remote" : "local";
+}
+
+bool
+RegisterLoadBenchmarks() {
+    for (auto& [schema_name, _] : schemas) {
+        for (auto mmap : {false, true}) {
+            for (auto remote : {false, true}) {
+                benchmark::RegisterBenchmark(
+                    fmt::format("Load/field_data/{}/{}/{}",
+                                schema_name,
+                                MmapName(mmap),
+                                StorageName(remote))
+                        .c_str(),
+                    LoadFieldDataBench,
+                    schema_name,
+                    mmap,
+                    remote)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+        }
+        for (auto remote : {false, true}) {
+            benchmark::RegisterBenchmark(
+                fmt::format("Load/chunk_cache/{}/{}",
+                            schema_name,
+                            StorageName(remote))
+                    .c_str(),
+                ChunkCacheBench,
+                schema_name,
+                remote)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        }
+    }
+    for (std::string index_type : {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT,
+                                   knowhere::IndexEnum::INDEX_HNSW}) {
+        for (auto mmap : {false, true}) {
+            for (auto remote : {false, true}) {
+                benchmark::RegisterBenchmark(
+                    fmt::format("Load/index/{}/{}/{}",
+                                index_type,
+                                MmapName(mmap),
+                                StorageName(remote))
+                        .c_str(),
+                    LoadIndexBench,
+                    index_type,
+                    mmap,
+                    remote)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+            }
+        }
+    }
+    return true;
+}
+
+const bool load_benchmarks_registered = RegisterLoadBenchmarks();
+
+}  // namespace
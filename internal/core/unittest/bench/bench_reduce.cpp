@@ -0,0 +1,249 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// The benchmarks of reducing the search results of the segments and
+// marshaling them into the result blobs, as ReduceSearchResultsAndFillData
+// does, named
+//
+//     Reduce/segments:<n>/nq:<n>/topk:<n>/fields:<output fields>
+//
+// The search results are synthesized on sealed segments, each with the topK
+// results of every nq. Each reports the time of the reduce and the marshal
+// per iteration, the results reduced per second as items_per_second, and the
+// allocations and the bytes allocated by the operator new per iteration.
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include "query/PlanImpl.h"
+#include "segcore/Reduce.h"
+#include "segcore/SegmentSealed.h"
+#include "test_utils/DataGen.h"
+
+namespace {
+
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> allocated_bytes{0};
+
+}  // namespace
+
+// count the allocations of the process, the aligned ones are not counted
+void*
+operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t rows_per_segment = 4096;
+
+const auto reduce_schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->AddDebugField("float", DataType::FLOAT);
+    schema->AddDebugField("varchar", DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}();
+
+FieldId
+Field(const std::string& name) {
+    return (*reduce_schema)[FieldName(name)].get_id();
+}
+
+// the first count segments, built only as many as the benchmarks filtered in
+// need
+const std::vector<SegmentSealedUPtr>&
+Segments(int64_t count) {
+    static std::vector<SegmentSealedUPtr> segments;
+    while (static_cast<int64_t>(segments.size()) < count) {
+        auto segment_id = static_cast<int64_t>(segments.size());
+        auto dataset =
+            DataGen(reduce_schema, rows_per_segment, 42 + segment_id);
+        auto segment = CreateSealedSegment(reduce_schema, nullptr, segment_id);
+        SealedLoadFieldData(dataset, *segment);
+        segments.push_back(std::move(segment));
+    }
+    return segments;
+}
+
+// the plan outputting the first num_fields of the float, varchar and vector
+// fields
+std::unique_ptr<Plan>
+ReducePlan(int64_t num_fields) {
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: 10
+                                  round_decimal: -1
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 10}"
+                                >
+                                placeholder_tag: "$0"
+        >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan = CreateSearchPlanByExpr(
+        *reduce_schema, plan_str.data(), plan_str.size());
+    std::vector<FieldId> fields = {
+        Field("float"), Field("varchar"), Field("fakevec")};
+    plan->target_entries_.assign(fields.begin(), fields.begin() + num_fields);
+    return plan;
+}
+
+// the results of a search of the segment, topk distinct offsets for every nq
+// in the order of their distances
+std::unique_ptr<SearchResult>
+SynthesizeSearchResult(SegmentSealed* segment,
+                       int64_t nq,
+                       int64_t topk,
+                       std::default_random_engine& engine) {
+    auto result = std::make_unique<SearchResult>();
+    result->total_nq_ = nq;
+    result->unity_topK_ = topk;
+    result->segment_ = segment;
+    result->seg_offsets_.resize(nq * topk);
+    result->distances_.resize(nq * topk);
+    std::uniform_int_distribution<int64_t> offset_distr(0,
+                                                        rows_per_segment - 1);
+    std::uniform_real_distribution<float> distance_distr(0, 1);
+    for (int64_t i = 0; i < nq; ++i) {
+        // an odd stride visits every row once in topk <= rows_per_segment
+        // steps, as rows_per_segment is a power of 2
+        auto start = offset_distr(engine);
+        auto stride = offset_distr(engine) | 1;
+        auto distance = distance_distr(engine) * topk;
+        for (int64_t j = 0; j < topk; ++j) {
+            result->seg_offsets_[i * topk + j] =
+                (start + j * stride) % rows_per_segment;
+            distance -= distance_distr(engine);
+            result->distances_[i * topk + j] = distance;
+        }
+    }
+    return result;
+}
+
+void
+ReduceBench(benchmark::State& state) {
+    auto num_segments = state.range(0);
+    auto nq = state.range(1);
+    auto topk = state.range(2);
+    auto plan = ReducePlan(state.range(3));
+    auto& segments = Segments(num_segments);
+    std::default_random_engine engine(42);
+
+    std::chrono::steady_clock::duration reduce_time{}, marshal_time{};
+    int64_t blob_bytes = 0;
+    int64_t iteration_allocations = 0;
+    int64_t iteration_allocated_bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::unique_ptr<SearchResult>> results;
+        std::vector<SearchResult*> result_ptrs;
+        for (int64_t i = 0; i < num_segments; ++i) {
+            results.push_back(SynthesizeSearchResult(
+                segments[i].get(), nq, topk, engine));
+            result_ptrs.push_back(results.back().get());
+        }
+        std::vector<int64_t> slice_nqs = {nq};
+        std::vector<int64_t> slice_topks = {topk};
+        auto allocations_before = allocations.load();
+        auto allocated_bytes_before = allocated_bytes.load();
+        state.ResumeTiming();
+
+        auto start = std::chrono::steady_clock::now();
+        ReduceHelper reduce_helper(result_ptrs,
+                                   plan.get(),
+                                   slice_nqs.data(),
+                                   slice_topks.data(),
+                                   slice_nqs.size());
+        reduce_helper.Reduce();
+        auto reduced = std::chrono::steady_clock::now();
+        reduce_helper.Marshal();
+        std::unique_ptr<SearchResultDataBlobs> blobs(
+            static_cast<SearchResultDataBlobs*>(
+                reduce_helper.GetSearchResultDataBlobs()));
+        auto marshaled = std::chrono::steady_clock::now();
+
+        state.PauseTiming();
+        reduce_time += reduced - start;
+        marshal_time += marshaled - reduced;
+        iteration_allocations += allocations.load() - allocations_before;
+        iteration_allocated_bytes +=
+            allocated_bytes.load() - allocated_bytes_before;
+        for (auto& blob : blobs->blobs) {
+            blob_bytes += blob.size();
+        }
+        blobs.reset();
+        results.clear();
+        state.ResumeTiming();
+    }
+
+    auto avg = benchmark::Counter::kAvgIterations;
+    auto us = [](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    state.SetItemsProcessed(state.iterations() * num_segments * nq * topk);
+    state.counters["reduce_us"] = benchmark::Counter(us(reduce_time), avg);
+    state.counters["marshal_us"] = benchmark::Counter(us(marshal_time), avg);
+    state.counters["allocs"] = benchmark::Counter(iteration_allocations, avg);
+    state.counters["alloc_bytes"] =
+        benchmark::Counter(iteration_allocated_bytes, avg);
+    state.counters["blob_bytes"] = benchmark::Counter(blob_bytes, avg);
+}
+
+// the nq and topK of the searches seen in practice, from a single query of
+// a large topK to a batch of many queries of a small topK
+void
+ReduceArgs(benchmark::internal::Benchmark* bench) {
+    const std::vector<std::pair<int64_t, int64_t>> nq_topks = {
+        {1, 10}, {1, 1000}, {10, 10}, {10, 100}, {100, 10}, {100, 100},
+        {1000, 10}};
+    for (int64_t num_segments : {1, 8, 32, 128}) {
+        for (auto [nq, topk] : nq_topks) {
+            for (int64_t fields : {0, 1, 3}) {
+                bench->Args({num_segments, nq, topk, fields});
+            }
+        }
+    }
+}
+
+const auto reduce_bench = benchmark::RegisterBenchmark("Reduce", ReduceBench)
+                              ->ArgNames({"segments", "nq", "topk", "fields"})
+                              ->Apply(ReduceArgs)
+                              ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
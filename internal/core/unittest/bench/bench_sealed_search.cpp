@@ -0,0 +1,543 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// The benchmarks of searching the sealed segments by the vector indexes,
+// named
+//
+//     SealedSearch/<dataset>/<index type>/<search param>:<value>/sel:<percent>
+//
+// The rows passing the filter are the percentage of the segment. Each
+// reports the QPS as items_per_second, the p50 and p99 latencies of a batch
+// of nq queries, and the recall of the topK against the brute force search
+// of the same segment without the index.
+//
+// The synthetic dataset is always searched, SIFT and GloVe are searched if
+// the directories of their fvecs files are given in the environment:
+//
+//     SEARCH_BENCH_SIFT_DIR    sift_base.fvecs and sift_query.fvecs, L2
+//     SEARCH_BENCH_GLOVE_DIR   glove_base.fvecs and glove_query.fvecs, COSINE
+//     SEARCH_BENCH_ROWS        rows of a dataset, 100000 synthetic and all of
+//                              the files by default
+//     SEARCH_BENCH_NQ          queries of a batch, 100
+//     SEARCH_BENCH_TOPK        topK of a query, 10
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "common/Consts.h"
+#include "index/IndexFactory.h"
+#include "index/Meta.h"
+#include "segcore/SegmentSealed.h"
+#include "segcore/Types.h"
+#include "storage/LocalChunkManagerSingleton.h"
+#include "storage/Util.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+int64_t
+EnvOr(const char* name, int64_t default_value) {
+    auto value = std::getenv(name);
+    return value == nullptr ? default_value : std::stoll(value);
+}
+
+const int64_t topk = EnvOr("SEARCH_BENCH_TOPK", 10);
+const std::vector<int> selectivities = {100, 10, 1};
+
+struct Dataset {
+    SchemaPtr schema;
+    std::string metric_type;
+    int64_t dim = 0;
+    int64_t rows = 0;
+    std::vector<float> base;
+    int64_t nq = 0;
+    std::vector<float> queries;
+};
+
+// the vectors of the fvecs file, each is its dim as an int32 followed by the
+// floats, at most max_rows of them if max_rows is positive
+std::vector<float>
+ReadFvecs(const std::string& path, int64_t max_rows, int64_t& dim) {
+    std::ifstream file(path, std::ios::binary);
+    AssertInfo(file.good(), "failed to open {}", path);
+    std::vector<float> vectors;
+    int32_t row_dim = 0;
+    for (int64_t rows = 0; max_rows <= 0 || rows < max_rows; ++rows) {
+        if (!file.read(reinterpret_cast<char*>(&row_dim), sizeof(row_dim))) {
+            break;
+        }
+        AssertInfo(rows == 0 || row_dim == dim,
+                   "inconsistent dim {} of {}",
+                   row_dim,
+                   path);
+        dim = row_dim;
+        auto offset = vectors.size();
+        vectors.resize(offset + dim);
+        file.read(reinterpret_cast<char*>(vectors.data() + offset),
+                  dim * sizeof(float));
+    }
+    return vectors;
+}
+
+void
+SetUpSchema(Dataset& dataset) {
+    auto schema = std::make_shared<Schema>();
+    // the field ids are 100 and 101, as the search plans expect
+    schema->AddDebugField(
+        "vector", DataType::VECTOR_FLOAT, dataset.dim, dataset.metric_type);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    dataset.schema = schema;
+    dataset.rows = dataset.base.size() / dataset.dim;
+    dataset.nq = std::min<int64_t>(EnvOr("SEARCH_BENCH_NQ", 100),
+                                   dataset.queries.size() / dataset.dim);
+    dataset.queries.resize(dataset.nq * dataset.dim);
+}
+
+Dataset
+SyntheticDataset() {
+    Dataset dataset;
+    dataset.metric_type = knowhere::metric::L2;
+    dataset.dim = 128;
+    auto rows = EnvOr("SEARCH_BENCH_ROWS", 100000);
+    auto nq = EnvOr("SEARCH_BENCH_NQ", 100);
+    std::default_random_engine engine(42);
+    std::normal_distribution<float> distr(0, 1);
+    dataset.base.resize(rows * dataset.dim);
+    for (auto& x : dataset.base) {
+        x = distr(engine);
+    }
+    dataset.queries.resize(nq * dataset.dim);
+    for (auto& x : dataset.queries) {
+        x = distr(engine);
+    }
+    SetUpSchema(dataset);
+    return dataset;
+}
+
+Dataset
+FvecsDataset(const std::string& dir,
+             const std::string& name,
+             const std::string& metric_type) {
+    Dataset dataset;
+    dataset.metric_type = metric_type;
+    auto max_rows = EnvOr("SEARCH_BENCH_ROWS", 0);
+    dataset.base = ReadFvecs(dir + "/" + name + "_base.fvecs", max_rows,
+                             dataset.dim);
+    int64_t query_dim = 0;
+    dataset.queries = ReadFvecs(dir + "/" + name + "_query.fvecs",
+                                EnvOr("SEARCH_BENCH_NQ", 100),
+                                query_dim);
+    AssertInfo(query_dim == dataset.dim,
+               "dim {} of the queries of {} is not dim {}",
+               query_dim,
+               name,
+               dataset.dim);
+    SetUpSchema(dataset);
+    return dataset;
+}
+
+// the datasets available, loaded only if the benchmarks filtered in search
+// them
+std::map<std::string, std::function<Dataset()>>
+DatasetLoaders() {
+    std::map<std::string, std::function<Dataset()>> loaders;
+    loaders["synthetic"] = SyntheticDataset;
+    if (auto dir = std::getenv("SEARCH_BENCH_SIFT_DIR")) {
+        loaders["sift"] = [dir = std::string(dir)] {
+            return FvecsDataset(dir, "sift", knowhere::metric::L2);
+        };
+    }
+    if (auto dir = std::getenv("SEARCH_BENCH_GLOVE_DIR")) {
+        loaders["glove"] = [dir = std::string(dir)] {
+            return FvecsDataset(dir, "glove", knowhere::metric::COSINE);
+        };
+    }
+    return loaders;
+}
+
+const Dataset&
+GetDataset(const std::string& name) {
+    static std::map<std::string, Dataset> datasets;
+    auto iter = datasets.find(name);
+    if (iter == datasets.end()) {
+        iter = datasets.emplace(name, DatasetLoaders().at(name)()).first;
+    }
+    return iter->second;
+}
+
+void
+LoadColumn(SegmentSealed& segment,
+           FieldId field_id,
+           const FieldDataPtr& field_data,
+           int64_t rows) {
+    auto info = FieldDataInfo(
+        field_id.get(), rows, std::vector<FieldDataPtr>{field_data});
+    segment.LoadFieldData(field_id, info);
+}
+
+// the pk of a row is its offset, so the filter pk < percent * rows / 100
+// passes the percentage of the rows
+void
+LoadScalarColumns(SegmentSealed& segment, const Dataset& dataset) {
+    std::vector<int64_t> offsets(dataset.rows);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    for (auto field_id : {RowFieldID,
+                          TimestampFieldID,
+                          (*dataset.schema)[FieldName("int64")].get_id()}) {
+        auto field_data =
+            std::make_shared<FieldData<int64_t>>(DataType::INT64);
+        field_data->FillFieldData(offsets.data(), dataset.rows);
+        LoadColumn(segment, field_id, field_data, dataset.rows);
+    }
+}
+
+// the segment searched by brute force for the ground truth
+const SegmentSealed&
+RawSegment(const std::string& dataset_name) {
+    static std::map<std::string, SegmentSealedUPtr> segments;
+    auto iter = segments.find(dataset_name);
+    if (iter != segments.end()) {
+        return *iter->second;
+    }
+    auto& dataset = GetDataset(dataset_name);
+    auto segment = CreateSealedSegment(dataset.schema);
+    LoadScalarColumns(*segment, dataset);
+    auto field_data = std::make_shared<FieldData<FloatVector>>(
+        dataset.dim, DataType::VECTOR_FLOAT);
+    field_data->FillFieldData(dataset.base.data(), dataset.rows);
+    LoadColumn(*segment,
+               (*dataset.schema)[FieldName("vector")].get_id(),
+               field_data,
+               dataset.rows);
+    return *segments.emplace(dataset_name, std::move(segment))
+                .first->second;
+}
+
+Config
+BuildConfig(const Dataset& dataset, const std::string& index_type) {
+    Config config{{knowhere::meta::METRIC_TYPE, dataset.metric_type},
+                  {knowhere::meta::DIM, std::to_string(dataset.dim)}};
+    auto nlist = std::clamp<int64_t>(
+        4 * std::sqrt(double(dataset.rows)), 16, 4096);
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT ||
+        index_type == knowhere::IndexEnum::INDEX_FAISS_IVFSQ8) {
+        config[knowhere::indexparam::NLIST] = std::to_string(nlist);
+    } else if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFPQ) {
+        // the largest m dividing the dim into sub vectors of at least 4
+        auto m = std::max<int64_t>(dataset.dim / 4, 1);
+        while (dataset.dim % m != 0) {
+            --m;
+        }
+        config[knowhere::indexparam::NLIST] = std::to_string(nlist);
+        config[knowhere::indexparam::M] = std::to_string(m);
+        config[knowhere::indexparam::NBITS] = "8";
+    } else if (index_type == knowhere::IndexEnum::INDEX_HNSW) {
+        config[knowhere::indexparam::HNSW_M] = "16";
+        config[knowhere::indexparam::EFCONSTRUCTION] = "200";
+    } else if (index_type == knowhere::IndexEnum::INDEX_DISKANN) {
+        config[index::DISK_ANN_MAX_DEGREE] = "48";
+        config[index::DISK_ANN_SEARCH_LIST_SIZE] = "128";
+        config[index::DISK_ANN_PQ_CODE_BUDGET] =
+            std::to_string(dataset.rows * dataset.dim * 4 / 32.0 / 1e9);
+        config[index::DISK_ANN_BUILD_DRAM_BUDGET] = "32";
+        config[index::DISK_ANN_BUILD_THREAD_NUM] = "8";
+    }
+    return config;
+}
+
+index::IndexBasePtr
+BuildIndex(const Dataset& dataset, const std::string& index_type) {
+    index::CreateIndexInfo create_index_info;
+    create_index_info.index_type = index_type;
+    create_index_info.metric_type = dataset.metric_type;
+    create_index_info.field_type = DataType::VECTOR_FLOAT;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+    auto database =
+        knowhere::GenDataSet(dataset.rows, dataset.dim, dataset.base.data());
+    if (index_type != knowhere::IndexEnum::INDEX_DISKANN) {
+        auto index = index::IndexFactory::GetInstance().CreateIndex(
+            create_index_info, storage::FileManagerContext());
+        index->BuildWithDataset(database, BuildConfig(dataset, index_type));
+        return index;
+    }
+
+    // the disk index is only searchable once uploaded and loaded
+    static const auto chunk_manager = [] {
+        storage::LocalChunkManagerSingleton::GetInstance().Init(
+            "/tmp/milvus_search_bench/local");
+        storage::StorageConfig storage_config;
+        storage_config.storage_type = "local";
+        storage_config.root_path = "/tmp/milvus_search_bench/remote";
+        return storage::CreateChunkManager(storage_config);
+    }();
+    auto field_id = (*dataset.schema)[FieldName("vector")].get_id().get();
+    storage::FileManagerContext file_manager_context(
+        storage::FieldDataMeta{1, 2, 3, field_id},
+        storage::IndexMeta{3, field_id, 1000, 1},
+        chunk_manager);
+    auto index = index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+    index->BuildWithDataset(database, BuildConfig(dataset, index_type));
+    auto binary_set = index->Upload();
+    index = index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+    std::vector<std::string> index_files;
+    for (auto& [file, _] : binary_set.binary_map_) {
+        index_files.push_back(file);
+    }
+    index->Load(Config{{knowhere::meta::METRIC_TYPE, dataset.metric_type},
+                       {knowhere::meta::DIM, std::to_string(dataset.dim)},
+                       {index::DISK_ANN_LOAD_THREAD_NUM, "8"},
+                       {index::DISK_ANN_SEARCH_CACHE_BUDGET, "0"},
+                       {"index_files", index_files}});
+    return index;
+}
+
+// the segment with the index of the type, only one is kept at a time as the
+// benchmarks of an index type run one after another
+const SegmentSealed&
+IndexSegment(const std::string& dataset_name, const std::string& index_type) {
+    static std::string key;
+    static SegmentSealedUPtr segment;
+    if (segment != nullptr && key == dataset_name + "/" + index_type) {
+        return *segment;
+    }
+    segment.reset();
+    auto& dataset = GetDataset(dataset_name);
+    segment = CreateSealedSegment(dataset.schema);
+    LoadScalarColumns(*segment, dataset);
+    LoadIndexInfo info;
+    info.field_id = (*dataset.schema)[FieldName("vector")].get_id().get();
+    info.field_type = DataType::VECTOR_FLOAT;
+    info.enable_mmap = false;
+    info.index_params["index_type"] = index_type;
+    info.index_params["metric_type"] = dataset.metric_type;
+    info.index = BuildIndex(dataset, index_type);
+    segment->LoadIndex(info);
+    key = dataset_name + "/" + index_type;
+    return *segment;
+}
+
+std::unique_ptr<Plan>
+SearchPlan(const Dataset& dataset, const Config& search_params, int percent) {
+    std::string predicates;
+    if (percent < 100) {
+        predicates = fmt::format(R"(predicates: <
+                                      unary_range_expr: <
+                                        column_info: <
+                                          field_id: 101
+                                          data_type: Int64
+                                        >
+                                        op: LessThan
+                                        value: <
+                                          int64_val: {}
+                                        >
+                                      >
+                                    >)",
+                                 dataset.rows * percent / 100);
+    }
+    auto params = search_params.dump();
+    std::string escaped_params;
+    for (auto c : params) {
+        if (c == '"') {
+            escaped_params += '\\';
+        }
+        escaped_params += c;
+    }
+    auto raw_plan = fmt::format(R"(vector_anns: <
+                                    field_id: 100
+                                    {}
+                                    query_info: <
+                                      topk: {}
+                                      round_decimal: -1
+                                      metric_type: "{}"
+                                      search_params: "{}"
+                                    >
+                                    placeholder_tag: "$0"
+                                  >)",
+                                predicates,
+                                topk,
+                                dataset.metric_type,
+                                escaped_params);
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan.c_str());
+    return CreateSearchPlanByExpr(
+        *dataset.schema, plan_str.data(), plan_str.size());
+}
+
+std::unique_ptr<PlaceholderGroup>
+Queries(const Dataset& dataset, const Plan* plan) {
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(
+        dataset.nq, dataset.dim, dataset.queries.data());
+    return ParsePlaceholderGroup(plan, ph_group_raw.SerializeAsString());
+}
+
+// the offsets of the exact topK of the queries by brute force
+const std::vector<int64_t>&
+GroundTruth(const std::string& dataset_name, int percent) {
+    static std::map<std::pair<std::string, int>, std::vector<int64_t>>
+        ground_truths;
+    auto key = std::make_pair(dataset_name, percent);
+    auto iter = ground_truths.find(key);
+    if (iter != ground_truths.end()) {
+        return iter->second;
+    }
+    auto& dataset = GetDataset(dataset_name);
+    auto plan = SearchPlan(dataset, Config::object(), percent);
+    auto ph_group = Queries(dataset, plan.get());
+    auto result = RawSegment(dataset_name).Search(plan.get(), ph_group.get());
+    return ground_truths.emplace(key, std::move(result->seg_offsets_))
+        .first->second;
+}
+
+double
+Recall(const std::vector<int64_t>& ground_truth,
+       const std::vector<int64_t>& offsets,
+       int64_t nq) {
+    int64_t hits = 0, total = 0;
+    for (int64_t i = 0; i < nq; ++i) {
+        std::unordered_set<int64_t> expected;
+        for (int64_t j = i * topk; j < (i + 1) * topk; ++j) {
+            if (ground_truth[j] != INVALID_SEG_OFFSET) {
+                expected.insert(ground_truth[j]);
+            }
+        }
+        total += expected.size();
+        for (int64_t j = i * topk; j < (i + 1) * topk; ++j) {
+            hits += expected.count(offsets[j]);
+        }
+    }
+    return total == 0 ? 1 : double(hits) / total;
+}
+
+void
+SealedSearch(benchmark::State& state,
+             const std::string& dataset_name,
+             const std::string& index_type,
+             const Config& search_params,
+             int percent) {
+    auto& dataset = GetDataset(dataset_name);
+    auto& ground_truth = GroundTruth(dataset_name, percent);
+    auto& segment = IndexSegment(dataset_name, index_type);
+    auto plan = SearchPlan(dataset, search_params, percent);
+    auto ph_group = Queries(dataset, plan.get());
+
+    std::vector<double> latencies_ms;
+    std::unique_ptr<SearchResult> result;
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        result = segment.Search(plan.get(), ph_group.get());
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+    }
+
+    auto Percentile = [&](double nth_percent) {
+        auto nth = latencies_ms.begin() +
+                   static_cast<int64_t>((latencies_ms.size() - 1) *
+                                        nth_percent / 100);
+        std::nth_element(latencies_ms.begin(), nth, latencies_ms.end());
+        return *nth;
+    };
+    state.SetItemsProcessed(state.iterations() * dataset.nq);
+    state.counters["p50_ms"] = Percentile(50);
+    state.counters["p99_ms"] = Percentile(99);
+    state.counters["recall"] =
+        Recall(ground_truth, result->seg_offsets_, dataset.nq);
+}
+
+struct IndexCase {
+    std::string index_type;
+    // the search param tuned and its values, none for the exhaustive ones
+    std::string param;
+    std::vector<int64_t> values;
+};
+
+std::vector<IndexCase>
+IndexCases() {
+    std::vector<IndexCase> cases = {
+        {knowhere::IndexEnum::INDEX_FAISS_IDMAP, "", {0}},
+        {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT,
+         knowhere::indexparam::NPROBE,
+         {8, 32, 128}},
+        {knowhere::IndexEnum::INDEX_FAISS_IVFSQ8,
+         knowhere::indexparam::NPROBE,
+         {8, 32, 128}},
+        {knowhere::IndexEnum::INDEX_FAISS_IVFPQ,
+         knowhere::indexparam::NPROBE,
+         {8, 32, 128}},
+        {knowhere::IndexEnum::INDEX_HNSW,
+         knowhere::indexparam::EF,
+         {16, 64, 256}},
+    };
+#ifdef BUILD_DISK_ANN
+    cases.push_back({knowhere::IndexEnum::INDEX_DISKANN,
+                     index::DISK_ANN_QUERY_LIST,
+                     {16, 64, 256}});
+#endif
+    return cases;
+}
+
+bool
+RegisterSealedSearchBenchmarks() {
+    for (auto& [dataset_name, _] : DatasetLoaders()) {
+        for (auto& index_case : IndexCases()) {
+            for (auto value : index_case.values) {
+                Config search_params = Config::object();
+                auto param_name = std::string("default");
+                if (!index_case.param.empty()) {
+                    // the ef and the search list may not be less than topK
+                    value = std::max(value, topk);
+                    search_params[index_case.param] = value;
+                    param_name = fmt::format("{}:{}", index_case.param, value);
+                }
+                for (auto percent : selectivities) {
+                    benchmark::RegisterBenchmark(
+                        fmt::format("SealedSearch/{}/{}/{}/sel:{}",
+                                    dataset_name,
+                                    index_case.index_type,
+                                    param_name,
+                                    percent)
+                            .c_str(),
+                        SealedSearch,
+                        dataset_name,
+                        index_case.index_type,
+                        search_params,
+                        percent)
+                        ->Unit(benchmark::kMillisecond)
+                        ->UseRealTime();
+                }
+            }
+        }
+    }
+    return true;
+}
+
+const bool sealed_search_benchmarks_registered =
+    RegisterSealedSearchBenchmarks();
+
+}  // namespace
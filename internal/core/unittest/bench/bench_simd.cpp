@@ -0,0 +1,158 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "simd/hook.h"
+#include "simd/ref.h"
+
+using namespace milvus::simd;
+
+// the values of the compares are in [0, 100), state.range(0) is the number
+// of them
+template <typename T>
+static std::vector<T>
+CompareData(int64_t size, unsigned seed = 42) {
+    std::default_random_engine e(seed);
+    std::uniform_int_distribution<int> dist(0, 99);
+    std::vector<T> data(size);
+    for (auto& x : data) {
+        x = T(dist(e));
+    }
+    return data;
+}
+
+// the kernel picked by the hook, against the reference loop
+template <typename T>
+static void
+CompareVal_Hook(benchmark::State& state) {
+    auto data = CompareData<T>(state.range(0));
+    std::vector<uint8_t> res(data.size());
+    auto kernel = compare_val_func<T>();
+    for (auto _ : state) {
+        kernel(data.data(),
+               data.size(),
+               T(50),
+               CompareOp::LT,
+               reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+template <typename T>
+static void
+CompareVal_Ref(benchmark::State& state) {
+    auto data = CompareData<T>(state.range(0));
+    std::vector<uint8_t> res(data.size());
+    for (auto _ : state) {
+        CompareValRef<T>(data.data(),
+                         data.size(),
+                         T(50),
+                         CompareOp::LT,
+                         reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+template <typename T>
+static void
+CompareRange_Hook(benchmark::State& state) {
+    auto data = CompareData<T>(state.range(0));
+    std::vector<uint8_t> res(data.size());
+    auto kernel = compare_range_func<T>();
+    for (auto _ : state) {
+        kernel(data.data(),
+               data.size(),
+               T(20),
+               T(80),
+               true,
+               false,
+               reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+template <typename T>
+static void
+CompareRange_Ref(benchmark::State& state) {
+    auto data = CompareData<T>(state.range(0));
+    std::vector<uint8_t> res(data.size());
+    for (auto _ : state) {
+        CompareRangeRef<T>(data.data(),
+                           data.size(),
+                           T(20),
+                           T(80),
+                           true,
+                           false,
+                           reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+template <typename T>
+static void
+CompareColumn_Hook(benchmark::State& state) {
+    auto left = CompareData<T>(state.range(0));
+    auto right = CompareData<T>(state.range(0), 7);
+    std::vector<uint8_t> res(left.size());
+    auto kernel = compare_column_func<T>();
+    for (auto _ : state) {
+        kernel(left.data(),
+               right.data(),
+               left.size(),
+               CompareOp::LT,
+               reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * left.size());
+}
+
+template <typename T>
+static void
+CompareColumn_Ref(benchmark::State& state) {
+    auto left = CompareData<T>(state.range(0));
+    auto right = CompareData<T>(state.range(0), 7);
+    std::vector<uint8_t> res(left.size());
+    for (auto _ : state) {
+        CompareColumnRef<T>(left.data(),
+                            right.data(),
+                            left.size(),
+                            CompareOp::LT,
+                            reinterpret_cast<bool*>(res.data()));
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetItemsProcessed(state.iterations() * left.size());
+}
+
+#define BENCHMARK_COMPARE_KERNELS(T)                                   \
+    BENCHMARK_TEMPLATE(CompareVal_Hook, T)->Arg(8192)->Arg(1 << 20);   \
+    BENCHMARK_TEMPLATE(CompareVal_Ref, T)->Arg(8192)->Arg(1 << 20);    \
+    BENCHMARK_TEMPLATE(CompareRange_Hook, T)->Arg(8192)->Arg(1 << 20); \
+    BENCHMARK_TEMPLATE(CompareRange_Ref, T)->Arg(8192)->Arg(1 << 20);  \
+    BENCHMARK_TEMPLATE(CompareColumn_Hook, T)                          \
+        ->Arg(8192)                                                    \
+        ->Arg(1 << 20);                                                \
+    BENCHMARK_TEMPLATE(CompareColumn_Ref, T)->Arg(8192)->Arg(1 << 20)
+
+BENCHMARK_COMPARE_KERNELS(int8_t);
+BENCHMARK_COMPARE_KERNELS(int16_t);
+BENCHMARK_COMPARE_KERNELS(int32_t);
+BENCHMARK_COMPARE_KERNELS(int64_t);
+BENCHMARK_COMPARE_KERNELS(float);
+BENCHMARK_COMPARE_KERNELS(double);
@@ -95,8 +95,10 @@ TEST_F(AzureChunkManagerTest, BasicFunctions) {
     uint8_t readdata[20] = {0};
     try {
         chunk_manager_->Read(path, 0, readdata, sizeof(readdata));
+        EXPECT_TRUE(false);
     } catch (SegcoreError& e) {
-        EXPECT_TRUE(string(e.what()).find("Read") != string::npos);
+        EXPECT_TRUE(string(e.what()).find("GetObjectBuffer") !=
+                    string::npos);
     }
     try {
         chunk_manager_->Write(path, 0, readdata, sizeof(readdata));
@@ -210,6 +212,12 @@ TEST_F(AzureChunkManagerTest, ReadPositive) {
     EXPECT_EQ(readdata[1], 0x32);
     EXPECT_EQ(readdata[2], 0x45);
 
+    size = chunk_manager_->Read(path, 2, readdata, 3);
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(readdata[0], 0x45);
+    EXPECT_EQ(readdata[1], 0x34);
+    EXPECT_EQ(readdata[2], 0x23);
+
     uint8_t dataWithNULL[] = {0x17, 0x32, 0x00, 0x34, 0x23};
     chunk_manager_->Write(path, dataWithNULL, sizeof(dataWithNULL));
     exist = chunk_manager_->Exist(path);
@@ -10,8 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <random>
 
+#include "common/Consts.h"
 #include "common/Utils.h"
 
 #include "query/SearchBruteForce.h"
@@ -145,6 +147,272 @@ class TestFloatSearchBruteForce : public ::testing::Test {
     }
 };
 
+TEST_F(TestFloatSearchBruteForce, Float16ByBlocks) {
+    // more rows than a block of the float16 search
+    int nb = 5000, nq = 10, topk = 5, dim = 128;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(nb);
+    auto bitset_view = BitsetView(*bitset);
+
+    auto base = GenFloatVecs(dim, nb, "L2");
+    auto query = GenFloatVecs(dim, nq, "L2", 43);
+    std::vector<float16> fp16_base(base.begin(), base.end());
+    std::vector<float16> fp16_query(query.begin(), query.end());
+    // the reference is computed from the values rounded to float16
+    std::vector<float> rounded_base(fp16_base.begin(), fp16_base.end());
+    std::vector<float> rounded_query(fp16_query.begin(), fp16_query.end());
+
+    dataset::SearchDataset dataset{"L2", nq, topk, -1, dim, fp16_query.data()};
+    auto result = BruteForceSearch(dataset,
+                                   fp16_base.data(),
+                                   nb,
+                                   knowhere::Json(),
+                                   bitset_view,
+                                   DataType::VECTOR_FLOAT16);
+    for (int i = 0; i < nq; i++) {
+        auto ref = Ref(rounded_base.data(),
+                       rounded_query.data() + i * dim,
+                       nb,
+                       dim,
+                       topk,
+                       "L2");
+        auto ans = result.get_seg_offsets() + i * topk;
+        ASSERT_TRUE(AssertMatch(ref, ans));
+    }
+}
+
+TEST_F(TestFloatSearchBruteForce, Float16Metrics) {
+    // the dim isn't a multiple of the simd width, and a third of the rows
+    // are filtered out
+    int nb = 1000, nq = 10, topk = 10, dim = 100;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(nb);
+    for (int i = 0; i < nb; i += 3) {
+        bitset->set(i);
+    }
+    auto bitset_view = BitsetView(*bitset);
+
+    auto base = GenFloatVecs(dim, nb, "L2");
+    auto query = GenFloatVecs(dim, nq, "L2", 43);
+    std::vector<float16> fp16_base(base.begin(), base.end());
+    std::vector<float16> fp16_query(query.begin(), query.end());
+    std::vector<float> rounded_base(fp16_base.begin(), fp16_base.end());
+    std::vector<float> rounded_query(fp16_query.begin(), fp16_query.end());
+
+    for (std::string metric : {"L2", "IP", "COSINE"}) {
+        dataset::SearchDataset dataset{
+            metric, nq, topk, -1, dim, fp16_query.data()};
+        auto result = BruteForceSearch(dataset,
+                                       fp16_base.data(),
+                                       nb,
+                                       knowhere::Json(),
+                                       bitset_view,
+                                       DataType::VECTOR_FLOAT16);
+        for (int q = 0; q < nq; q++) {
+            auto xq = rounded_query.data() + q * dim;
+            std::vector<std::tuple<float, int>> ref;
+            for (int i = 0; i < nb; i++) {
+                if (bitset->test(i)) {
+                    continue;
+                }
+                auto xb = rounded_base.data() + i * dim;
+                float distance = metric == "L2" ? L2(xb, xq, dim)
+                                                : IP(xb, xq, dim);
+                if (metric == "COSINE") {
+                    distance /= std::sqrt(IP(xb, xb, dim) * IP(xq, xq, dim));
+                }
+                // nearest first
+                ref.emplace_back(metric == "L2" ? distance : -distance, i);
+            }
+            std::sort(ref.begin(), ref.end());
+            for (int k = 0; k < topk; k++) {
+                auto [key, offset] = ref[k];
+                auto distance = metric == "L2" ? key : -key;
+                auto idx = q * topk + k;
+                ASSERT_EQ(result.get_seg_offsets()[idx], offset) << metric;
+                ASSERT_NEAR(result.get_distances()[idx],
+                            distance,
+                            1e-3 * std::max(1.0f, std::abs(distance)));
+            }
+        }
+    }
+}
+
+TEST_F(TestFloatSearchBruteForce, RangeSearchByBlocks) {
+    // more rows than a block of the range search, every row within the
+    // radius, so the results must be the top-K of the whole chunk
+    int nb = 20000, nq = 5, topk = 10, dim = 16;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(nb);
+    for (int i = 0; i < nb; i += 5) {
+        bitset->set(i);
+    }
+    auto bitset_view = BitsetView(*bitset);
+
+    auto base = GenFloatVecs(dim, nb, "L2");
+    auto query = GenFloatVecs(dim, nq, "L2", 43);
+    dataset::SearchDataset dataset{"L2", nq, topk, -1, dim, query.data()};
+    knowhere::Json conf = {{RADIUS, std::numeric_limits<float>::max()}};
+    auto result = BruteForceSearch(dataset,
+                                   base.data(),
+                                   nb,
+                                   conf,
+                                   bitset_view,
+                                   DataType::VECTOR_FLOAT);
+    for (int q = 0; q < nq; q++) {
+        std::vector<std::tuple<float, int>> ref;
+        for (int i = 0; i < nb; i++) {
+            if (!bitset->test(i)) {
+                ref.emplace_back(
+                    L2(base.data() + i * dim, query.data() + q * dim, dim), i);
+            }
+        }
+        std::sort(ref.begin(), ref.end());
+        for (int k = 0; k < topk; k++) {
+            auto idx = q * topk + k;
+            ASSERT_EQ(result.get_seg_offsets()[idx], std::get<1>(ref[k]));
+            ASSERT_NEAR(result.get_distances()[idx],
+                        std::get<0>(ref[k]),
+                        1e-3 * std::max(1.0f, std::get<0>(ref[k])));
+        }
+    }
+}
+
+TEST_F(TestFloatSearchBruteForce, CosineByInvNorms) {
+    // the dim isn't a multiple of the simd width, and a third of the rows
+    // are filtered out
+    int nb = 1000, nq = 10, topk = 10, dim = 100;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(nb);
+    for (int i = 0; i < nb; i += 3) {
+        bitset->set(i);
+    }
+    auto bitset_view = BitsetView(*bitset);
+
+    auto base = GenFloatVecs(dim, nb, "COSINE");
+    auto query = GenFloatVecs(dim, nq, "COSINE", 43);
+    std::vector<float> inv_norms(nb);
+    for (int i = 0; i < nb; i++) {
+        auto xb = base.data() + i * dim;
+        inv_norms[i] = 1 / std::sqrt(IP(xb, xb, dim));
+    }
+
+    dataset::SearchDataset dataset{"COSINE", nq, topk, -1, dim, query.data()};
+    auto expected = BruteForceSearch(dataset,
+                                     base.data(),
+                                     nb,
+                                     knowhere::Json(),
+                                     bitset_view,
+                                     DataType::VECTOR_FLOAT);
+    auto result = BruteForceSearch(dataset,
+                                   base.data(),
+                                   nb,
+                                   knowhere::Json(),
+                                   bitset_view,
+                                   DataType::VECTOR_FLOAT,
+                                   inv_norms.data());
+    for (int i = 0; i < nq * topk; i++) {
+        ASSERT_EQ(result.get_seg_offsets()[i], expected.get_seg_offsets()[i]);
+        ASSERT_NEAR(
+            result.get_distances()[i], expected.get_distances()[i], 1e-4);
+    }
+}
+
+TEST(TestBinarySearchBruteForce, Metrics) {
+    // a specialized dim and a generic one, a third of the rows filtered out
+    for (int dim : {512, 136}) {
+        int nb = 1000, nq = 10, topk = 10;
+        auto bytes = dim / 8;
+        auto bitset = std::make_shared<BitsetType>();
+        bitset->resize(nb);
+        for (int i = 0; i < nb; i += 3) {
+            bitset->set(i);
+        }
+        auto bitset_view = BitsetView(*bitset);
+
+        auto schema = std::make_shared<Schema>();
+        auto bvec = schema->AddDebugField(
+            "bvec", DataType::VECTOR_BINARY, dim, knowhere::metric::HAMMING);
+        auto base = DataGen(schema, nb, 42).get_col<uint8_t>(bvec);
+        auto query = DataGen(schema, nq, 43).get_col<uint8_t>(bvec);
+
+        for (std::string metric : {"HAMMING", "JACCARD"}) {
+            dataset::SearchDataset dataset{
+                metric, nq, topk, -1, dim, query.data()};
+            auto result = BruteForceSearch(dataset,
+                                           base.data(),
+                                           nb,
+                                           knowhere::Json(),
+                                           bitset_view,
+                                           DataType::VECTOR_BINARY);
+            for (int q = 0; q < nq; q++) {
+                auto xq = query.data() + q * bytes;
+                std::vector<std::tuple<float, int>> ref;
+                for (int i = 0; i < nb; i++) {
+                    if (bitset->test(i)) {
+                        continue;
+                    }
+                    auto xb = base.data() + i * bytes;
+                    int xor_count = 0, and_count = 0, or_count = 0;
+                    for (int b = 0; b < bytes; b++) {
+                        xor_count += __builtin_popcount(xq[b] ^ xb[b]);
+                        and_count += __builtin_popcount(xq[b] & xb[b]);
+                        or_count += __builtin_popcount(xq[b] | xb[b]);
+                    }
+                    ref.emplace_back(
+                        metric == "HAMMING"
+                            ? float(xor_count)
+                            : 1 - float(and_count) / float(or_count),
+                        i);
+                }
+                std::sort(ref.begin(), ref.end());
+                for (int k = 0; k < topk; k++) {
+                    auto idx = q * topk + k;
+                    ASSERT_EQ(result.get_seg_offsets()[idx],
+                              std::get<1>(ref[k]))
+                        << metric;
+                    ASSERT_NEAR(
+                        result.get_distances()[idx], std::get<0>(ref[k]), 1e-5);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TestFloatSearchBruteForce, RangeSearchTiesByBlocks) {
+    // the rows are all the same, the ties are ordered by id as within a
+    // single block, the lower ids first for L2 and the higher ones for IP
+    int nb = 20000, nq = 2, topk = 10, dim = 16;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(nb);
+    auto bitset_view = BitsetView(*bitset);
+
+    std::vector<float> base(nb * dim, 1.0f);
+    std::vector<float> query(nq * dim, 1.0f);
+    for (auto metric_type : {"L2", "IP"}) {
+        dataset::SearchDataset dataset{
+            metric_type, nq, topk, -1, dim, query.data()};
+        knowhere::Json conf = {
+            {RADIUS,
+             std::string(metric_type) == "L2"
+                 ? std::numeric_limits<float>::max()
+                 : -1.0f}};
+        auto result = BruteForceSearch(dataset,
+                                       base.data(),
+                                       nb,
+                                       conf,
+                                       bitset_view,
+                                       DataType::VECTOR_FLOAT);
+        for (int q = 0; q < nq; q++) {
+            for (int k = 0; k < topk; k++) {
+                auto expected = std::string(metric_type) == "L2" ? k
+                                                                 : nb - 1 - k;
+                ASSERT_EQ(result.get_seg_offsets()[q * topk + k], expected);
+            }
+        }
+    }
+}
+
 TEST_F(TestFloatSearchBruteForce, L2) {
     Run(100, 10, 5, 128, "L2");
     Run(100, 10, 5, 128, "l2");
@@ -96,6 +96,7 @@ class BinlogIndexTest : public ::testing::TestWithParam<Param> {
         auto& config = SegcoreConfig::default_config();
         config.set_chunk_rows(1024);
         config.set_enable_interim_segment_index(true);
+        config.set_async_interim_index_build(false);
         std::map<FieldId, FieldIndexMeta> filedMap = {
             {vec_field_id, fieldIndexMeta}};
         IndexMetaPtr metaPtr =
@@ -312,4 +313,41 @@ TEST_P(BinlogIndexTest, LoadBinlogWithoutIndexMeta) {
     EXPECT_FALSE(segment->HasIndex(vec_field_id));
     EXPECT_EQ(segment->get_row_count(), data_n);
     EXPECT_TRUE(segment->HasFieldData(vec_field_id));
-}
\ No newline at end of file
+}
+TEST_P(BinlogIndexTest, AsyncBuild) {
+    IndexMetaPtr collection_index_meta =
+        GetCollectionIndexMeta(knowhere::IndexEnum::INDEX_FAISS_IVFFLAT);
+    auto& segcore_config = milvus::segcore::SegcoreConfig::default_config();
+    segcore_config.set_async_interim_index_build(true);
+
+    segment = CreateSealedSegment(schema, collection_index_meta);
+    LoadOtherFields();
+    auto field_data_info = FieldDataInfo{
+        vec_field_id.get(), data_n, std::vector<FieldDataPtr>{vec_field_data}};
+    segment->LoadFieldData(vec_field_id, field_data_info);
+    // the raw vectors are served until the index is built
+    EXPECT_TRUE(segment->HasFieldData(vec_field_id) ||
+                segment->HasIndex(vec_field_id));
+
+    auto sealed = dynamic_cast<SegmentSealedImpl*>(segment.get());
+    sealed->WaitBinlogIndexBuilds();
+    EXPECT_TRUE(segment->HasIndex(vec_field_id));
+    EXPECT_FALSE(segment->HasFieldData(vec_field_id));
+    EXPECT_EQ(segment->get_row_count(), data_n);
+
+    // the index built after the field is dropped is discarded
+    segment = CreateSealedSegment(schema, collection_index_meta);
+    LoadOtherFields();
+    segment->LoadFieldData(vec_field_id, field_data_info);
+    segment->DropFieldData(vec_field_id);
+    sealed = dynamic_cast<SegmentSealedImpl*>(segment.get());
+    sealed->WaitBinlogIndexBuilds();
+    EXPECT_FALSE(segment->HasFieldData(vec_field_id));
+
+    // the destructor cancels the queued builds and waits for the running one
+    segment = CreateSealedSegment(schema, collection_index_meta);
+    LoadOtherFields();
+    segment->LoadFieldData(vec_field_id, field_data_info);
+    segment.reset();
+    segcore_config.set_async_interim_index_build(false);
+}
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <pb/schema.pb.h>
 #include <index/BoolIndex.h>
+#include <index/ScalarIndexSort.h>
 #include "test_utils/indexbuilder_test_utils.h"
 #include "test_utils/AssertUtils.h"
 
@@ -207,3 +208,56 @@ TEST_F(BoolIndexTest, Codec) {
         }
     }
 }
+
+TEST_F(BoolIndexTest, RangeAndReverseLookup) {
+    // not a multiple of the block bits
+    size_t num_rows = 130;
+    std::unique_ptr<bool[]> values(new bool[num_rows]);
+    for (size_t i = 0; i < num_rows; i++) {
+        values[i] = i % 3 == 0;
+    }
+    auto index = milvus::index::CreateBoolIndex();
+    index->Build(num_rows, values.get());
+    ASSERT_EQ(num_rows, index->Count());
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), values[i]);
+    }
+
+    auto less = index->Range(true, milvus::OpType::LessThan);
+    auto greater_equal = index->Range(false, milvus::OpType::GreaterEqual);
+    auto greater = index->Range(true, milvus::OpType::GreaterThan);
+    auto both = index->Range(false, true, true, true);
+    auto only_true = index->Range(false, false, true, true);
+    for (size_t i = 0; i < num_rows; i++) {
+        ASSERT_EQ(less[i], !values[i]);
+        ASSERT_TRUE(greater_equal[i]);
+        ASSERT_FALSE(greater[i]);
+        ASSERT_TRUE(both[i]);
+        ASSERT_EQ(only_true[i], values[i]);
+    }
+
+    bool terms[] = {true, false};
+    auto in_both = index->In(2, terms);
+    auto not_in_both = index->NotIn(2, terms);
+    ASSERT_EQ(in_both.size(), num_rows);
+    ASSERT_FALSE(BitSetNone(in_both));
+    ASSERT_TRUE(BitSetNone(not_in_both));
+}
+
+TEST_F(BoolIndexTest, LoadSortIndex) {
+    // the bool fields were indexed by the sort index before
+    auto sort_index = milvus::index::CreateScalarIndexSort<bool>();
+    sort_index->Build(half.data_size(), half.data().data());
+
+    auto index = milvus::index::CreateBoolIndex();
+    index->Load(sort_index->Serialize(nullptr));
+    ASSERT_EQ(n, index->Count());
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), (i % 2) == 0);
+    }
+    auto true_test = std::make_unique<bool>(true);
+    auto bitset = index->In(1, true_test.get());
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(bitset[i], (i % 2) == 0);
+    }
+}
@@ -15,13 +15,17 @@
 #include <array>
 #include <boost/format.hpp>
 #include <chrono>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
+#include "arrow/c/bridge.h"
 #include "boost/container/vector.hpp"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/LoadInfo.h"
 #include "common/Types.h"
@@ -32,7 +36,11 @@
 #include "query/ExprImpl.h"
 #include "segcore/Collection.h"
 #include "segcore/Reduce.h"
+#include "segcore/SlowCallRecorder.h"
+#include "segcore/metrics_c.h"
 #include "segcore/reduce_c.h"
+#include "segcore/load_task_c.h"
+#include "segcore/segcore_init_c.h"
 #include "segcore/segment_c.h"
 #include "test_utils/DataGen.h"
 #include "test_utils/PbHelper.h"
@@ -548,6 +556,37 @@ TEST(CApiTest, MultiDeleteGrowingSegment) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, ExistPkSealedSegment) {
+    auto collection = NewCollection(get_default_schema_config());
+    CSegmentInterface segment;
+    auto status = NewSegment(collection, Sealed, -1, &segment);
+    ASSERT_EQ(status.error_code, Success);
+    auto col = (milvus::segcore::Collection*)collection;
+
+    // pks = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}
+    int N = 10;
+    auto dataset = DataGen(col->get_schema(), N);
+    auto segment_interface = reinterpret_cast<SegmentInterface*>(segment);
+    auto sealed_segment = dynamic_cast<SegmentSealed*>(segment_interface);
+    SealedLoadFieldData(dataset, *sealed_segment);
+
+    std::vector<int64_t> pks = {1, 100000, 9, -1, 10};
+    auto ids = std::make_unique<IdArray>();
+    ids->mutable_int_id()->mutable_data()->Add(pks.begin(), pks.end());
+    auto ids_data = serialize(ids.get());
+    bool results[5];
+    auto res = ExistPk(segment, ids_data.data(), ids_data.size(), results);
+    ASSERT_EQ(res.error_code, Success);
+    EXPECT_TRUE(results[0]);
+    EXPECT_FALSE(results[1]);
+    EXPECT_TRUE(results[2]);
+    EXPECT_FALSE(results[3]);
+    EXPECT_FALSE(results[4]);
+
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, MultiDeleteSealedSegment) {
     auto collection = NewCollection(get_default_schema_config());
     CSegmentInterface segment;
@@ -1090,6 +1129,292 @@ TEST(CApiTest, SearchTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, AsyncSearchTest) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    CSegmentInterface segment;
+    auto status = NewSegment(c_collection, Growing, -1, &segment);
+    ASSERT_EQ(status.error_code, Success);
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 10000;
+    auto dataset = DataGen(col->get_schema(), N);
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment,
+                          offset,
+                          N,
+                          dataset.row_ids_.data(),
+                          dataset.timestamps_.data(),
+                          insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(milvus::proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(100);
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(10);
+    query_info->set_round_decimal(3);
+    query_info->set_metric_type("L2");
+    query_info->set_search_params(R"({"nprobe": 10})");
+    auto plan_str = plan_node.SerializeAsString();
+
+    auto blob = generate_query_data(10);
+    void* plan = nullptr;
+    status = CreateSearchPlanByExpr(
+        c_collection, plan_str.data(), plan_str.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto done = [](void* arg) {
+        static_cast<std::promise<void>*>(arg)->set_value();
+    };
+    std::promise<void> searched, canceled;
+    CAsyncTask search_task, canceled_task;
+    status = AsyncSearch(
+        segment, plan, placeholderGroup, {}, done, &searched, &search_task);
+    ASSERT_EQ(status.error_code, Success);
+    status = AsyncSearch(
+        segment, plan, placeholderGroup, {}, done, &canceled, &canceled_task);
+    ASSERT_EQ(status.error_code, Success);
+    CancelAsyncTask(canceled_task);
+
+    searched.get_future().wait();
+    CSearchResult search_result = nullptr;
+    status = GetAsyncSearchResult(search_task, &search_result);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_NE(search_result, nullptr);
+    auto result = static_cast<milvus::SearchResult*>(search_result);
+    ASSERT_EQ(result->total_nq_, 10);
+    DeleteAsyncTask(search_task);
+    DeleteSearchResult(search_result);
+
+    // canceled before or after it started
+    canceled.get_future().wait();
+    CSearchResult canceled_result = nullptr;
+    status = GetAsyncSearchResult(canceled_task, &canceled_result);
+    if (status.error_code == Success) {
+        ASSERT_NE(canceled_result, nullptr);
+        DeleteSearchResult(canceled_result);
+    } else {
+        ASSERT_EQ(status.error_code, milvus::Canceled);
+        ASSERT_EQ(canceled_result, nullptr);
+        free((char*)status.error_msg);
+    }
+    DeleteAsyncTask(canceled_task);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, CancellationTokenTest) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    CSegmentInterface segment;
+    auto status = NewSegment(c_collection, Growing, -1, &segment);
+    ASSERT_EQ(status.error_code, Success);
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 10000;
+    auto dataset = DataGen(col->get_schema(), N);
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment,
+                          offset,
+                          N,
+                          dataset.row_ids_.data(),
+                          dataset.timestamps_.data(),
+                          insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(milvus::proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(100);
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(10);
+    query_info->set_round_decimal(3);
+    query_info->set_metric_type("L2");
+    query_info->set_search_params(R"({"nprobe": 10})");
+    auto plan_str = plan_node.SerializeAsString();
+
+    auto blob = generate_query_data(10);
+    void* plan = nullptr;
+    status = CreateSearchPlanByExpr(
+        c_collection, plan_str.data(), plan_str.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    // not canceled and no timeout
+    auto token = NewCancellationToken(0);
+    SetSearchPlanCancellationToken(plan, token);
+    CSearchResult search_result;
+    status = Search(segment, plan, placeholderGroup, {}, &search_result);
+    ASSERT_EQ(status.error_code, Success);
+    DeleteSearchResult(search_result);
+
+    CancelQuery(token);
+    DeleteCancellationToken(token);
+    status = Search(segment, plan, placeholderGroup, {}, &search_result);
+    ASSERT_EQ(status.error_code, milvus::Canceled);
+    free((char*)status.error_msg);
+
+    // expired
+    token = NewCancellationToken(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    SetSearchPlanCancellationToken(plan, token);
+    status = Search(segment, plan, placeholderGroup, {}, &search_result);
+    ASSERT_EQ(status.error_code, milvus::Canceled);
+    free((char*)status.error_msg);
+
+    std::vector<proto::plan::GenericValue> retrieve_pks(1);
+    retrieve_pks[0].set_int64_val(1);
+    auto retrieve_plan =
+        std::make_unique<query::RetrievePlan>(*col->get_schema());
+    auto term_expr = std::make_shared<milvus::expr::TermFilterExpr>(
+        milvus::expr::ColumnInfo(
+            FieldId(101), DataType::INT64, std::vector<std::string>()),
+        retrieve_pks);
+    retrieve_plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    retrieve_plan->plan_node_->filter_plannode_ =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, term_expr);
+    retrieve_plan->field_ids_ = {FieldId(100), FieldId(101)};
+    SetRetrievePlanCancellationToken(retrieve_plan.get(), token);
+    DeleteCancellationToken(token);
+    CRetrieveResult retrieve_result;
+    status = CRetrieve(segment,
+                       retrieve_plan.get(),
+                       {},
+                       dataset.timestamps_[N - 1] + 10,
+                       &retrieve_result);
+    ASSERT_EQ(status.error_code, milvus::Canceled);
+    free((char*)status.error_msg);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, SlowCallRecorder) {
+    using milvus::segcore::SlowCallRecorder;
+    auto& recorder = SlowCallRecorder::GetInstance();
+    recorder.Clear();
+    SegcoreSetSlowCallThresholdMs(1);
+
+    auto c_collection = NewCollection(get_default_schema_config());
+    CSegmentInterface segment;
+    auto status = NewSegment(c_collection, Growing, -1, &segment);
+    ASSERT_EQ(status.error_code, Success);
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 1000;
+    auto dataset = DataGen(col->get_schema(), N);
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment,
+                          offset,
+                          N,
+                          dataset.row_ids_.data(),
+                          dataset.timestamps_.data(),
+                          insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: 10
+                                  round_decimal: 3
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 10}"
+                                >
+                                placeholder_tag: "$0"
+     >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    void* plan = nullptr;
+    status = CreateSearchPlanByExpr(
+        c_collection, plan_str.data(), plan_str.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    auto blob = generate_query_data(10);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    // a search taking longer than the threshold is recorded with its stages,
+    // which are profiled only for the recorder
+    auto search_plan = (milvus::query::Plan*)plan;
+    auto search_segment = (milvus::segcore::SegmentInterface*)segment;
+    auto result = search_segment->Search(
+        search_plan, (milvus::query::PlaceholderGroup*)placeholderGroup);
+    ASSERT_NE(result->profile_, nullptr);
+    auto start = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    milvus::segcore::RecordIfSlowSearch(
+        *search_segment, *search_plan, *result, start);
+    ASSERT_EQ(result->profile_, nullptr);
+
+    auto calls = recorder.Snapshot();
+    ASSERT_EQ(calls.size(), 1);
+    ASSERT_EQ(calls[0].call_, "Search");
+    ASSERT_GE(calls[0].latency_us_, 1000000);
+    auto detail = nlohmann::json::parse(calls[0].detail_);
+    ASSERT_EQ(detail["plan"]["node_type"], "FloatVectorANNS");
+    ASSERT_EQ(detail["nq"], 10);
+    ASSERT_EQ(detail["segment"]["row_count"], N);
+    ASSERT_EQ(detail["segment"]["segment_type"], "growing");
+    ASSERT_FALSE(detail["stages"].empty());
+
+    // a fast one is not
+    milvus::segcore::RecordIfSlowSearch(*search_segment,
+                                        *search_plan,
+                                        *result,
+                                        std::chrono::steady_clock::now());
+    ASSERT_EQ(recorder.Snapshot().size(), 1);
+
+    // the ring keeps the latest calls, the oldest first
+    for (size_t i = 0; i < SlowCallRecorder::CAPACITY + 3; ++i) {
+        recorder.Record("Retrieve", i, 1000, "{}");
+    }
+    calls = recorder.Snapshot();
+    ASSERT_EQ(calls.size(), SlowCallRecorder::CAPACITY);
+    ASSERT_EQ(calls.front().segment_id_, 3);
+    ASSERT_EQ(calls.back().segment_id_,
+              static_cast<int64_t>(SlowCallRecorder::CAPACITY + 2));
+    for (size_t i = 1; i < calls.size(); ++i) {
+        ASSERT_EQ(calls[i].seq_, calls[i - 1].seq_ + 1);
+    }
+
+    auto json = GetSegcoreSlowCalls();
+    auto slow_calls = nlohmann::json::parse(json);
+    free(json);
+    ASSERT_EQ(slow_calls.size(), SlowCallRecorder::CAPACITY);
+    ASSERT_EQ(slow_calls[0]["call"], "Retrieve");
+
+    SegcoreSetSlowCallThresholdMs(0);
+    recorder.Clear();
+    ASSERT_TRUE(recorder.Snapshot().empty());
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, SearchTestWithExpr) {
     auto c_collection = NewCollection(get_default_schema_config());
     CSegmentInterface segment;
@@ -1207,6 +1532,100 @@ TEST(CApiTest, RetrieveTestWithExpr) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, RetrieveArrowTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    CSegmentInterface segment;
+    auto status = NewSegment(collection, Growing, -1, &segment);
+    ASSERT_EQ(status.error_code, Success);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment,
+                          offset,
+                          N,
+                          dataset.row_ids_.data(),
+                          dataset.timestamps_.data(),
+                          insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // create retrieve plan "age in [0, 1]"
+    std::vector<proto::plan::GenericValue> values;
+    for (auto v : {1, 0}) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        values.push_back(val);
+    }
+    auto term_expr = std::make_shared<milvus::expr::TermFilterExpr>(
+        milvus::expr::ColumnInfo(
+            FieldId(101), DataType::INT64, std::vector<std::string>()),
+        values);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->filter_plannode_ =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, term_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    auto max_ts = dataset.timestamps_[N - 1] + 10;
+    CRetrieveResult retrieve_result;
+    auto res = CRetrieve(segment, plan.get(), {}, max_ts, &retrieve_result);
+    ASSERT_EQ(res.error_code, Success);
+    proto::segcore::RetrieveResults expected;
+    ASSERT_TRUE(expected.ParseFromArray(retrieve_result.proto_blob,
+                                        retrieve_result.proto_size));
+    ASSERT_GT(expected.offset_size(), 0);
+
+    struct ArrowArray array;
+    struct ArrowSchema arrow_schema;
+    res = RetrieveArrow(segment,
+                        plan.get(),
+                        {},
+                        max_ts,
+                        &array,
+                        &arrow_schema,
+                        DEFAULT_MAX_OUTPUT_SIZE);
+    ASSERT_EQ(res.error_code, Success);
+    auto batch = arrow::ImportRecordBatch(&array, &arrow_schema);
+    ASSERT_TRUE(batch.ok());
+    auto record_batch = batch.ValueOrDie();
+    ASSERT_EQ(record_batch->num_rows(), expected.offset_size());
+    ASSERT_EQ(record_batch->num_columns(), 3);
+
+    auto vectors = std::static_pointer_cast<arrow::FixedSizeBinaryArray>(
+        record_batch->GetColumnByName("100"));
+    auto ages = std::static_pointer_cast<arrow::Int64Array>(
+        record_batch->GetColumnByName("101"));
+    auto offsets = std::static_pointer_cast<arrow::Int64Array>(
+        record_batch->GetColumnByName("offset"));
+    ASSERT_NE(vectors, nullptr);
+    ASSERT_NE(ages, nullptr);
+    ASSERT_NE(offsets, nullptr);
+    auto& expected_vectors =
+        expected.fields_data(0).vectors().float_vector().data();
+    auto& expected_ages = expected.fields_data(1).scalars().long_data().data();
+    ASSERT_EQ(vectors->byte_width(), DIM * sizeof(float));
+    for (int64_t i = 0; i < record_batch->num_rows(); i++) {
+        ASSERT_EQ(offsets->Value(i), expected.offset(i));
+        ASSERT_EQ(ages->Value(i), expected_ages[i]);
+        ASSERT_EQ(memcmp(vectors->GetValue(i),
+                         expected_vectors.data() + i * DIM,
+                         DIM * sizeof(float)),
+                  0);
+    }
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, GetMemoryUsageInBytesTest) {
     auto collection = NewCollection(get_default_schema_config());
     CSegmentInterface segment;
@@ -1688,6 +2107,16 @@ testReduceSearchWithExpr(int N, int topK, int num_queries) {
         for (auto real_topk : search_result_data.topks()) {
             ASSERT_LE(real_topk, slice_topKs[i]);
         }
+
+        // the duplicated pks of a nq are removed
+        auto& ids = search_result_data.ids().int_id().data();
+        int64_t begin = 0;
+        for (auto real_topk : search_result_data.topks()) {
+            std::unordered_set<int64_t> pks(ids.begin() + begin,
+                                            ids.begin() + begin + real_topk);
+            ASSERT_EQ(pks.size(), static_cast<size_t>(real_topk));
+            begin += real_topk;
+        }
     }
 
     DeleteSearchResultDataBlobs(cSearchResultData);
@@ -1708,6 +2137,333 @@ TEST(CApiTest, ReduceSearchWithExpr) {
     testReduceSearchWithExpr(10000, 10, 10);
 }
 
+TEST(CApiTest, ReduceSearchResultsOneByOne) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    int N = 1000;
+    int num_queries = 10;
+    int topK = 10;
+
+    // the pks of the segments are duplicated
+    std::vector<CSegmentInterface> segments(2);
+    for (int i = 0; i < segments.size(); i++) {
+        auto status = NewSegment(collection, Growing, i, &segments[i]);
+        ASSERT_EQ(status.error_code, Success);
+        auto dataset = DataGen(schema, N, 42 + i);
+        int64_t offset;
+        PreInsert(segments[i], N, &offset);
+        auto insert_data = serialize(dataset.raw_);
+        status = Insert(segments[i],
+                        offset,
+                        N,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        insert_data.data(),
+                        insert_data.size());
+        ASSERT_EQ(status.error_code, Success);
+    }
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+    void* plan = nullptr;
+    auto binary_plan =
+        translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(
+        collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto slice_nqs = std::vector<int64_t>{num_queries / 2, num_queries / 2};
+    auto slice_topKs = std::vector<int64_t>{topK / 2, topK};
+    auto search = [&]() {
+        std::vector<CSearchResult> results(segments.size());
+        for (int i = 0; i < segments.size(); i++) {
+            auto status = Search(
+                segments[i], plan, placeholderGroup, {}, &results[i]);
+            EXPECT_EQ(status.error_code, Success);
+        }
+        return results;
+    };
+
+    // reduce the results at once, and one by one in the reversed order
+    auto results = search();
+    CSearchResultDataBlobs blobs;
+    status = ReduceSearchResultsAndFillData(&blobs,
+                                            plan,
+                                            results.data(),
+                                            results.size(),
+                                            slice_nqs.data(),
+                                            slice_topKs.data(),
+                                            slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+
+    auto added_results = search();
+    CSearchResultReducer reducer;
+    status = NewSearchResultReducer(&reducer,
+                                    plan,
+                                    slice_nqs.data(),
+                                    slice_topKs.data(),
+                                    slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+    for (int i = added_results.size() - 1; i >= 0; i--) {
+        status = ReducerAddSearchResult(reducer, added_results[i]);
+        ASSERT_EQ(status.error_code, Success);
+    }
+    CSearchResultDataBlobs added_blobs;
+    status = ReducerFillData(&added_blobs, reducer);
+    ASSERT_EQ(status.error_code, Success);
+
+    for (int i = 0; i < slice_nqs.size(); i++) {
+        CProto ref;
+        CProto res;
+        ASSERT_EQ(GetSearchResultDataBlob(&ref, blobs, i).error_code, Success);
+        ASSERT_EQ(GetSearchResultDataBlob(&res, added_blobs, i).error_code,
+                  Success);
+        milvus::proto::schema::SearchResultData ref_data;
+        milvus::proto::schema::SearchResultData res_data;
+        ASSERT_TRUE(ref_data.ParseFromArray(ref.proto_blob, ref.proto_size));
+        ASSERT_TRUE(res_data.ParseFromArray(res.proto_blob, res.proto_size));
+        ASSERT_GT(ref_data.scores_size(), 0);
+        ASSERT_EQ(res_data.DebugString(), ref_data.DebugString());
+    }
+
+    DeleteSearchResultReducer(reducer);
+    DeleteSearchResultDataBlobs(blobs);
+    DeleteSearchResultDataBlobs(added_blobs);
+    for (int i = 0; i < segments.size(); i++) {
+        DeleteSearchResult(results[i]);
+        DeleteSearchResult(added_results[i]);
+        DeleteSegment(segments[i]);
+    }
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+}
+
+TEST(CApiTest, ReduceSearchFillsPickedResultsOnly) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    int N = 1000;
+    int num_queries = 10;
+    int topK = 10;
+
+    // the segments hold the same rows, so the results of one of them are
+    // all dropped as duplicates
+    std::vector<CSegmentInterface> segments(2);
+    for (int i = 0; i < segments.size(); i++) {
+        auto status = NewSegment(collection, Growing, i, &segments[i]);
+        ASSERT_EQ(status.error_code, Success);
+        auto dataset = DataGen(schema, N, 42);
+        int64_t offset;
+        PreInsert(segments[i], N, &offset);
+        auto insert_data = serialize(dataset.raw_);
+        status = Insert(segments[i],
+                        offset,
+                        N,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        insert_data.data(),
+                        insert_data.size());
+        ASSERT_EQ(status.error_code, Success);
+    }
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+    void* plan = nullptr;
+    auto binary_plan =
+        translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(
+        collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    std::vector<CSearchResult> results(segments.size());
+    for (int i = 0; i < segments.size(); i++) {
+        status =
+            Search(segments[i], plan, placeholderGroup, {}, &results[i]);
+        ASSERT_EQ(status.error_code, Success);
+    }
+    auto slice_nqs = std::vector<int64_t>{num_queries};
+    auto slice_topKs = std::vector<int64_t>{topK};
+    CSearchResultDataBlobs blobs;
+    status = ReduceSearchResultsAndFillData(&blobs,
+                                            plan,
+                                            results.data(),
+                                            results.size(),
+                                            slice_nqs.data(),
+                                            slice_topKs.data(),
+                                            slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+
+    int64_t picked = 0;
+    for (auto result : results) {
+        auto search_result = (milvus::SearchResult*)result;
+        auto size = search_result->seg_offsets_.size();
+        picked += size;
+        ASSERT_EQ(search_result->distances_.size(), size);
+        if (size == 0) {
+            ASSERT_TRUE(search_result->output_fields_data_.empty());
+        } else {
+            for (auto& [field_id, field_data] :
+                 search_result->output_fields_data_) {
+                ASSERT_EQ(field_data->vectors().float_vector().data_size(),
+                          size * DIM);
+            }
+        }
+    }
+    ASSERT_EQ(picked, num_queries * topK);
+
+    DeleteSearchResultDataBlobs(blobs);
+    for (int i = 0; i < segments.size(); i++) {
+        DeleteSearchResult(results[i]);
+        DeleteSegment(segments[i]);
+    }
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+}
+
+TEST(CApiTest, SearchSegmentsAndReduce) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    int N = 1000;
+    int num_queries = 10;
+    int topK = 10;
+
+    std::vector<CSegmentInterface> segments(3);
+    for (int i = 0; i < segments.size(); i++) {
+        auto status = NewSegment(collection, Growing, i, &segments[i]);
+        ASSERT_EQ(status.error_code, Success);
+        auto dataset = DataGen(schema, N, 42 + i);
+        int64_t offset;
+        PreInsert(segments[i], N, &offset);
+        auto insert_data = serialize(dataset.raw_);
+        status = Insert(segments[i],
+                        offset,
+                        N,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        insert_data.data(),
+                        insert_data.size());
+        ASSERT_EQ(status.error_code, Success);
+    }
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+    void* plan = nullptr;
+    auto binary_plan =
+        translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(
+        collection, binary_plan.data(), binary_plan.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+    auto slice_nqs = std::vector<int64_t>{num_queries / 2, num_queries / 2};
+    auto slice_topKs = std::vector<int64_t>{topK / 2, topK};
+
+    // the same blobs as searching the segments one by one
+    std::vector<CSearchResult> results(segments.size());
+    for (int i = 0; i < segments.size(); i++) {
+        status =
+            Search(segments[i], plan, placeholderGroup, {}, &results[i]);
+        ASSERT_EQ(status.error_code, Success);
+    }
+    CSearchResultDataBlobs expected_blobs;
+    status = ReduceSearchResultsAndFillData(&expected_blobs,
+                                            plan,
+                                            results.data(),
+                                            results.size(),
+                                            slice_nqs.data(),
+                                            slice_topKs.data(),
+                                            slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+
+    CSearchResultDataBlobs blobs;
+    status = SearchSegmentsAndReduce(&blobs,
+                                     segments.data(),
+                                     segments.size(),
+                                     plan,
+                                     placeholderGroup,
+                                     {},
+                                     slice_nqs.data(),
+                                     slice_topKs.data(),
+                                     slice_nqs.size());
+    ASSERT_EQ(status.error_code, Success);
+
+    for (int i = 0; i < slice_nqs.size(); ++i) {
+        CProto expected;
+        status = GetSearchResultDataBlob(&expected, expected_blobs, i);
+        ASSERT_EQ(status.error_code, Success);
+        CProto actual;
+        status = GetSearchResultDataBlob(&actual, blobs, i);
+        ASSERT_EQ(status.error_code, Success);
+        milvus::proto::schema::SearchResultData expected_data;
+        ASSERT_TRUE(expected_data.ParseFromArray(expected.proto_blob,
+                                                 expected.proto_size));
+        milvus::proto::schema::SearchResultData data;
+        ASSERT_TRUE(data.ParseFromArray(actual.proto_blob, actual.proto_size));
+        ASSERT_EQ(data.num_queries(), num_queries / 2);
+        ASSERT_EQ(data.ids().int_id().data_size(),
+                  num_queries / 2 * slice_topKs[i]);
+        ASSERT_EQ(data.SerializeAsString(), expected_data.SerializeAsString());
+    }
+
+    DeleteSearchResultDataBlobs(expected_blobs);
+    DeleteSearchResultDataBlobs(blobs);
+    for (int i = 0; i < segments.size(); i++) {
+        DeleteSearchResult(results[i]);
+        DeleteSegment(segments[i]);
+    }
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+}
+
+TEST(CApiTest, ReduceSearchWithManyQueries) {
+    // the nqs are reduced by parallel tasks
+    SetCpuNum(4);
+    testReduceSearchWithExpr(10000, 10, 1000);
+    SetCpuNum(DEFAULT_CPU_NUM);
+}
+
 TEST(CApiTest, LoadIndexInfo) {
     // generator index
     constexpr auto TOPK = 10;
@@ -3981,6 +4737,117 @@ TEST(CApiTest, GrowingSegment_Load_Field_Data) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, AsyncLoadFieldData) {
+    auto schema = std::make_shared<Schema>();
+    schema->AddField(FieldName("RowID"), FieldId(0), DataType::INT64);
+    schema->AddField(FieldName("Timestamp"), FieldId(1), DataType::INT64);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    auto vec_fid = schema->AddDebugField(
+        "vector_float", DataType::VECTOR_FLOAT, DIM, "L2");
+    schema->set_primary_field_id(str_fid);
+
+    auto segment = CreateGrowingSegment(schema, empty_index_meta).release();
+
+    int N = ROW_COUNT;
+    auto raw_data = DataGen(schema, N);
+
+    auto storage_config = get_default_local_storage_config();
+    auto cm = storage::CreateChunkManager(storage_config);
+    auto load_info =
+        PrepareInsertBinlog(1,
+                            2,
+                            3,
+                            storage_config.root_path + "/" + "test_async_load",
+                            raw_data,
+                            cm);
+
+    auto done = [](void* arg) {
+        static_cast<std::promise<void>*>(arg)->set_value();
+    };
+    std::promise<void> loaded;
+    CLoadTask task;
+    auto status = AsyncLoadFieldData(segment, &load_info, done, &loaded, &task);
+    ASSERT_EQ(status.error_code, Success);
+    loaded.get_future().wait();
+    status = GetLoadTaskStatus(task);
+    ASSERT_EQ(status.error_code, Success);
+    int64_t downloaded_bytes = 0, decoded_bytes = 0;
+    GetLoadTaskProgress(task, &downloaded_bytes, &decoded_bytes);
+    ASSERT_GT(downloaded_bytes, 0);
+    ASSERT_GT(decoded_bytes, 0);
+    DeleteLoadTask(task);
+    ASSERT_EQ(segment->get_real_count(), ROW_COUNT);
+
+    // canceled before it started, or while downloading
+    auto canceled_segment =
+        CreateGrowingSegment(schema, empty_index_meta).release();
+    std::promise<void> canceled;
+    status = AsyncLoadFieldData(
+        canceled_segment, &load_info, done, &canceled, &task);
+    ASSERT_EQ(status.error_code, Success);
+    CancelLoadTask(task);
+    canceled.get_future().wait();
+    status = GetLoadTaskStatus(task);
+    if (status.error_code != Success) {
+        ASSERT_EQ(status.error_code, milvus::Canceled);
+        free((char*)status.error_msg);
+    }
+    DeleteLoadTask(task);
+
+    DeleteSegment(canceled_segment);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, LoadSegment) {
+    auto schema = std::make_shared<Schema>();
+    schema->AddField(FieldName("RowID"), FieldId(0), DataType::INT64);
+    schema->AddField(FieldName("Timestamp"), FieldId(1), DataType::INT64);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    auto vec_fid = schema->AddDebugField(
+        "vector_float", DataType::VECTOR_FLOAT, DIM, "L2");
+    schema->set_primary_field_id(str_fid);
+
+    int N = ROW_COUNT;
+    auto raw_data = DataGen(schema, N);
+    auto storage_config = get_default_local_storage_config();
+    auto cm = storage::CreateChunkManager(storage_config);
+    auto load_info = PrepareInsertBinlog(
+        1, 2, 3, storage_config.root_path + "/test_load_segment", raw_data, cm);
+
+    // a load info per field, the pk one among the others
+    std::vector<LoadFieldDataInfo> field_infos;
+    for (auto& [field_id, field_info] : load_info.field_infos) {
+        LoadFieldDataInfo info;
+        info.field_infos.emplace(field_id, field_info);
+        info.mmap_dir_path = load_info.mmap_dir_path;
+        field_infos.push_back(std::move(info));
+    }
+    std::vector<CLoadFieldDataInfo> c_field_infos;
+    for (auto& info : field_infos) {
+        c_field_infos.push_back(&info);
+    }
+
+    auto segment = CreateSealedSegment(schema).release();
+    auto status = LoadSegment(
+        segment, c_field_infos.data(), c_field_infos.size(), nullptr, 0);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(segment->get_real_count(), N);
+    ASSERT_TRUE(segment->HasFieldData(str_fid));
+    ASSERT_TRUE(segment->HasFieldData(vec_fid));
+
+    // the first failure is returned once the others are done
+    auto missing = field_infos.back();
+    missing.field_infos.begin()->second.insert_files = {"missing_binlog"};
+    CLoadFieldDataInfo c_missing = &missing;
+    auto failed_segment = CreateSealedSegment(schema).release();
+    status = LoadSegment(failed_segment, &c_missing, 1, nullptr, 0);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+
+    DeleteSegment(failed_segment);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, RetriveScalarFieldFromSealedSegmentWithIndex) {
     auto schema = std::make_shared<Schema>();
     auto i8_fid = schema->AddDebugField("age8", DataType::INT8);
@@ -25,6 +25,7 @@
 #include "test_utils/storage_test_utils.h"
 #include "storage/ChunkCache.h"
 #include "storage/LocalChunkManagerSingleton.h"
+#include "storage/PayloadWriter.h"
 
 #define DEFAULT_READ_AHEAD_POLICY "willneed"
 
@@ -90,6 +91,97 @@ TEST(ChunkCacheTest, Read) {
     Assert(!exist);
 }
 
+TEST(ChunkCacheTest, ReadRows) {
+    auto N = 10000;
+    auto dim = 128;
+    auto metric_type = knowhere::metric::L2;
+
+    auto mmap_dir = "/tmp/test_chunk_cache/mmap";
+    auto local_storage_path = "/tmp/test_chunk_cache/local";
+    auto raw_file_name =
+        std::string("chunk_cache_test/insert_log/1/101/1000001");
+    auto parquet_file_name =
+        std::string("chunk_cache_test/insert_log/1/101/1000002");
+
+    milvus::storage::LocalChunkManagerSingleton::GetInstance().Init(
+        local_storage_path);
+
+    auto schema = std::make_shared<milvus::Schema>();
+    auto fake_id = schema->AddDebugField(
+        "fakevec", milvus::DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", milvus::DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto dataset = milvus::segcore::DataGen(schema, N);
+
+    auto field_data_meta =
+        milvus::storage::FieldDataMeta{1, 2, 3, fake_id.get()};
+    auto field_meta = milvus::FieldMeta(milvus::FieldName("facevec"),
+                                        fake_id,
+                                        milvus::DataType::VECTOR_FLOAT,
+                                        dim,
+                                        metric_type);
+
+    auto lcm = milvus::storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    auto data = dataset.get_col<float>(fake_id);
+    auto data_slices = std::vector<const uint8_t*>{(uint8_t*)data.data()};
+    auto slice_sizes = std::vector<int64_t>{static_cast<int64_t>(N)};
+    PutFieldData(lcm.get(),
+                 data_slices,
+                 slice_sizes,
+                 std::vector<std::string>{parquet_file_name},
+                 field_data_meta,
+                 field_meta);
+    auto default_policy = milvus::storage::GetPayloadEncodingPolicy(
+        milvus::DataType::VECTOR_FLOAT);
+    auto raw_policy = default_policy;
+    raw_policy.raw_layout = true;
+    milvus::storage::SetPayloadEncodingPolicy(milvus::DataType::VECTOR_FLOAT,
+                                              raw_policy);
+    PutFieldData(lcm.get(),
+                 data_slices,
+                 slice_sizes,
+                 std::vector<std::string>{raw_file_name},
+                 field_data_meta,
+                 field_meta);
+    milvus::storage::SetPayloadEncodingPolicy(milvus::DataType::VECTOR_FLOAT,
+                                              default_policy);
+
+    auto cc = std::make_shared<milvus::storage::ChunkCache>(
+        mmap_dir, DEFAULT_READ_AHEAD_POLICY, lcm);
+    std::vector<int64_t> offsets = {5, 2, N - 1, 5};
+    auto row_size = static_cast<int64_t>(dim * sizeof(float));
+    auto check_rows = [&](const std::vector<uint8_t>& buf) {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            ASSERT_EQ(0,
+                      memcmp(buf.data() + i * row_size,
+                             data.data() + offsets[i] * dim,
+                             row_size));
+        }
+    };
+
+    // only the rows of the raw binlog are read, it's not cached
+    std::vector<uint8_t> buf(offsets.size() * row_size);
+    ASSERT_TRUE(cc->ReadRows(raw_file_name, offsets, row_size, buf.data()));
+    check_rows(buf);
+    ASSERT_EQ(cc->ResidentBytes(), 0);
+
+    // the parquet binlog has to be read whole, then its rows are cached
+    ASSERT_FALSE(
+        cc->ReadRows(parquet_file_name, offsets, row_size, buf.data()));
+    cc->Read(parquet_file_name);
+    std::fill(buf.begin(), buf.end(), 0);
+    ASSERT_TRUE(
+        cc->ReadRows(parquet_file_name, offsets, row_size, buf.data()));
+    check_rows(buf);
+
+    cc->Remove(parquet_file_name);
+    lcm->Remove(raw_file_name);
+    lcm->Remove(parquet_file_name);
+    std::filesystem::remove_all(mmap_dir);
+}
+
 TEST(ChunkCacheTest, TestMultithreads) {
     auto N = 1000;
     auto dim = 128;
@@ -163,3 +255,140 @@ TEST(ChunkCacheTest, TestMultithreads) {
     exist = std::filesystem::exists(mmap_dir);
     Assert(!exist);
 }
+
+TEST(ChunkCacheTest, EvictByCapacity) {
+    auto N = 1000;
+    auto dim = 128;
+    auto metric_type = knowhere::metric::L2;
+    int64_t column_bytes = dim * N * 4;
+
+    auto mmap_dir = "/tmp/test_chunk_cache/mmap";
+    auto local_storage_path = "/tmp/test_chunk_cache/local";
+    auto file_names = std::vector<std::string>{
+        "chunk_cache_test/insert_log/3/101/1000000",
+        "chunk_cache_test/insert_log/3/101/1000001",
+        "chunk_cache_test/insert_log/3/101/1000002"};
+
+    milvus::storage::LocalChunkManagerSingleton::GetInstance().Init(
+        local_storage_path);
+
+    auto schema = std::make_shared<milvus::Schema>();
+    auto fake_id = schema->AddDebugField(
+        "fakevec", milvus::DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", milvus::DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto dataset = milvus::segcore::DataGen(schema, N);
+
+    auto field_data_meta =
+        milvus::storage::FieldDataMeta{1, 2, 3, fake_id.get()};
+    auto field_meta = milvus::FieldMeta(milvus::FieldName("facevec"),
+                                        fake_id,
+                                        milvus::DataType::VECTOR_FLOAT,
+                                        dim,
+                                        metric_type);
+
+    auto lcm = milvus::storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    auto data = dataset.get_col<float>(fake_id);
+    for (const auto& file_name : file_names) {
+        auto data_slices = std::vector<const uint8_t*>{(uint8_t*)data.data()};
+        auto slice_sizes = std::vector<int64_t>{static_cast<int64_t>(N)};
+        auto slice_names = std::vector<std::string>{file_name};
+        PutFieldData(lcm.get(),
+                     data_slices,
+                     slice_sizes,
+                     slice_names,
+                     field_data_meta,
+                     field_meta);
+    }
+
+    // room for two columns only
+    auto cc = std::make_shared<milvus::storage::ChunkCache>(
+        mmap_dir, DEFAULT_READ_AHEAD_POLICY, lcm, column_bytes * 2);
+    {
+        // keep the first column pinned
+        auto pinned = cc->Read(file_names[0]);
+        cc->Read(file_names[1]);
+        cc->Read(file_names[2]);
+        // file 1 is evicted as the least recently used unpinned column
+        ASSERT_EQ(cc->ResidentBytes(), column_bytes * 2);
+
+        auto actual = (float*)pinned->Data();
+        for (auto i = 0; i < N; i++) {
+            ASSERT_EQ(data[i], actual[i]);
+        }
+    }
+
+    // file 0 is unpinned now and becomes the eviction victim
+    cc->Read(file_names[1]);
+    ASSERT_EQ(cc->ResidentBytes(), column_bytes * 2);
+
+    for (const auto& file_name : file_names) {
+        cc->Remove(file_name);
+        lcm->Remove(file_name);
+    }
+    ASSERT_EQ(cc->ResidentBytes(), 0);
+    std::filesystem::remove_all(mmap_dir);
+}
+
+TEST(ChunkCacheTest, PrefetchAsync) {
+    auto N = 1000;
+    auto dim = 128;
+    auto metric_type = knowhere::metric::L2;
+
+    auto mmap_dir = "/tmp/test_chunk_cache/mmap";
+    auto local_storage_path = "/tmp/test_chunk_cache/local";
+    auto file_name = std::string("chunk_cache_test/insert_log/4/101/1000000");
+
+    milvus::storage::LocalChunkManagerSingleton::GetInstance().Init(
+        local_storage_path);
+
+    auto schema = std::make_shared<milvus::Schema>();
+    auto fake_id = schema->AddDebugField(
+        "fakevec", milvus::DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", milvus::DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto dataset = milvus::segcore::DataGen(schema, N);
+
+    auto field_data_meta =
+        milvus::storage::FieldDataMeta{1, 2, 3, fake_id.get()};
+    auto field_meta = milvus::FieldMeta(milvus::FieldName("facevec"),
+                                        fake_id,
+                                        milvus::DataType::VECTOR_FLOAT,
+                                        dim,
+                                        metric_type);
+
+    auto lcm = milvus::storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    auto data = dataset.get_col<float>(fake_id);
+    auto data_slices = std::vector<const uint8_t*>{(uint8_t*)data.data()};
+    auto slice_sizes = std::vector<int64_t>{static_cast<int64_t>(N)};
+    auto slice_names = std::vector<std::string>{file_name};
+    PutFieldData(lcm.get(),
+                 data_slices,
+                 slice_sizes,
+                 slice_names,
+                 field_data_meta,
+                 field_meta);
+
+    auto cc = std::make_shared<milvus::storage::ChunkCache>(
+        mmap_dir, DEFAULT_READ_AHEAD_POLICY, lcm);
+    cc->PrefetchAsync(file_name);
+
+    // the read either hits the prefetched column or waits on the same load
+    auto column = cc->Read(file_name);
+    ASSERT_EQ(column->ByteSize(), dim * N * 4);
+    ASSERT_EQ(cc->ResidentBytes(), dim * N * 4);
+    ASSERT_EQ(cc->Read(file_name).get(), column.get());
+
+    auto actual = (float*)column->Data();
+    for (auto i = 0; i < N; i++) {
+        ASSERT_EQ(data[i], actual[i]);
+    }
+
+    cc->Remove(file_name);
+    lcm->Remove(file_name);
+    std::filesystem::remove_all(mmap_dir);
+}
@@ -10,7 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 #include <segcore/ConcurrentVector.h>
+#include "common/BitsetView.h"
+#include "common/QueryProfile.h"
 #include "common/Types.h"
 #include "common/Span.h"
 #include "common/VectorTrait.h"
@@ -29,3 +32,65 @@ TEST(Common, Span) {
     ASSERT_EQ(r2.row_count(), 10);
     ASSERT_EQ(r2.element_sizeof(), 16 * sizeof(float));
 }
+
+TEST(Common, BitsetAligned) {
+    using namespace milvus;
+
+    BitsetType bitset;
+    bitset.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        bitset.push_back(i % 3 == 0);
+        auto data = boost_ext::get_data(bitset);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0);
+    }
+    bitset.resize(100000);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(boost_ext::get_data(bitset)) % 64, 0);
+    ASSERT_EQ(bitset.count(), 334);
+
+    BitsetView view(bitset);
+    ASSERT_EQ(view.size(), 100000);
+    ASSERT_TRUE(view.test(999));
+    ASSERT_FALSE(view.test(998));
+}
+
+TEST(Common, QueryProfile) {
+    using namespace milvus;
+
+    QueryProfile profile;
+    {
+        ProfileTimer timer(&profile, "filter");
+        timer.stage().input_rows_ = 100;
+        timer.stage().output_rows_ = 10;
+    }
+    {
+        ProfileTimer timer(&profile, "search");
+        timer.stage().path_ = "brute_force";
+    }
+    {
+        ProfileTimer timer(&profile, "filter");
+        timer.stage().path_ = "parallel_2";
+        timer.stage().input_rows_ = 50;
+        timer.stage().output_rows_ = 5;
+        timer.stage().bytes_ = 200;
+    }
+    // nothing is recorded without a profile
+    ProfileTimer(nullptr, "filter").stage().input_rows_ = 1;
+
+    auto stages = profile.Stages();
+    ASSERT_EQ(stages.size(), 2);
+    ASSERT_EQ(stages[0].name_, "filter");
+    ASSERT_EQ(stages[0].path_, "parallel_2");
+    ASSERT_EQ(stages[0].input_rows_, 150);
+    ASSERT_EQ(stages[0].output_rows_, 15);
+    ASSERT_EQ(stages[0].batches_, 2);
+    ASSERT_EQ(stages[0].bytes_, 200);
+    ASSERT_EQ(stages[1].name_, "search");
+    ASSERT_EQ(stages[1].path_, "brute_force");
+    ASSERT_EQ(stages[1].batches_, 1);
+
+    auto json = nlohmann::json::parse(profile.ToJson());
+    ASSERT_EQ(json.size(), 2);
+    ASSERT_EQ(json[0]["name"], "filter");
+    ASSERT_EQ(json[0]["input_rows"], 150);
+    ASSERT_EQ(json[1]["path"], "brute_force");
+}
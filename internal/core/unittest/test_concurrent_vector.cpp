@@ -10,6 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <numeric>
 #include <random>
 #include <string>
 #include <thread>
@@ -94,6 +97,35 @@ TEST(ConcurrentVector, TestMultithreads) {
     }
 }
 
+TEST(ConcurrentVector, TestThreadSafeVectorReadWhileAppend) {
+    ThreadSafeVector<std::vector<int64_t>> vec;
+    constexpr int64_t total = 10000;
+    std::atomic<bool> finished = false;
+    std::thread reader([&]() {
+        while (!finished) {
+            auto size = vec.size();
+            for (int64_t i = 0; i < size; ++i) {
+                ASSERT_EQ(vec[i].size(), 4);
+            }
+        }
+    });
+    vec.emplace_to_at_least(1, 4);
+    auto& first = vec[0];
+    for (int64_t i = 2; i <= total; ++i) {
+        vec.emplace_to_at_least(i, 4);
+    }
+    finished = true;
+    reader.join();
+
+    ASSERT_EQ(vec.size(), total);
+    // the elements are never moved by appending
+    ASSERT_EQ(&first, &vec[0]);
+    vec.clear();
+    ASSERT_EQ(vec.size(), 0);
+    vec.emplace_to_at_least(3, 2);
+    ASSERT_EQ(vec[2].size(), 2);
+}
+
 TEST(ConcurrentVector, TestAckSingle) {
     std::vector<std::tuple<int64_t, int64_t, int64_t>> raw_data;
     std::default_random_engine e(42);
@@ -112,3 +144,133 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, TestAckMultithreads) {
+    AckResponder ack;
+    std::atomic<int64_t> reserved = 0;
+    int num_threads = 8;
+    int N = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            std::default_random_engine e(t);
+            for (int i = 0; i < N; ++i) {
+                auto size = int64_t(e() % 16 + 1);
+                auto begin = reserved.fetch_add(size);
+                if (e() % 4 == 0) {
+                    std::this_thread::yield();
+                }
+                ack.AddSegment(begin, begin + size);
+                EXPECT_LE(ack.GetAck(), reserved.load());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(ack.GetAck(), reserved.load());
+}
+
+TEST(ConcurrentVector, TestChunkArena) {
+    auto arena = std::make_shared<ChunkArena>();
+    // the small chunks are carved from the slabs
+    ConcurrentVector<int64_t> small(1024, arena);
+    std::vector<int64_t> data(10000);
+    std::iota(data.begin(), data.end(), 0);
+    small.set_data_raw(0, data.data(), data.size());
+    int64_t slab_size = ChunkArena::SLAB_SIZE;
+    ASSERT_EQ(arena->ByteSize(), slab_size);
+    for (int64_t i = 0; i < static_cast<int64_t>(data.size()); ++i) {
+        ASSERT_EQ(small[i], i);
+    }
+    for (int64_t i = 0; i < small.num_chunk(); ++i) {
+        auto ptr = reinterpret_cast<uintptr_t>(small.get_chunk_data(i));
+        ASSERT_EQ(ptr % ChunkArena::ALIGNMENT, 0);
+    }
+
+    // the large chunks get maps of their own, which are unmapped on clear
+    auto dim = 256;
+    ConcurrentVector<milvus::FloatVector> large(dim, 1024, arena);
+    std::vector<float> vectors(2048 * dim, 1.0f);
+    large.set_data_raw(0, vectors.data(), 2048);
+    ASSERT_EQ(large.num_chunk(), 2);
+    ASSERT_EQ(large.get_element(2047)[dim - 1], 1.0f);
+    int64_t chunk_size = 1024 * dim * sizeof(float);
+    ASSERT_EQ(arena->ByteSize(), slab_size + 2 * chunk_size);
+    large.clear();
+    ASSERT_EQ(arena->ByteSize(), slab_size);
+
+    // the bytes of the strings are packed into the blocks in the arena
+    ConcurrentVector<std::string> strings(16, arena);
+    std::vector<std::string> values(100, std::string(100, 'a'));
+    strings.set_data_raw(0, values.data(), values.size());
+    ASSERT_EQ(strings[99], values[99]);
+}
+
+TEST(ConcurrentVector, TestSpillChunk) {
+    auto arena = std::make_shared<ChunkArena>();
+    auto dim = 256;
+    ConcurrentVector<milvus::FloatVector> vectors(dim, 1024, arena);
+    std::vector<float> data(2048 * dim);
+    std::iota(data.begin(), data.end(), 0.0f);
+    vectors.set_data_raw(0, data.data(), 2048);
+    int64_t chunk_size = 1024 * dim * sizeof(float);
+    ASSERT_EQ(arena->ResidentByteSize(), 2 * chunk_size);
+
+    auto dir = std::filesystem::temp_directory_path() / "test_spill_chunk";
+    std::filesystem::create_directories(dir);
+    auto filepath = (dir / "0").string();
+    auto chunk = vectors.get_chunk_data(0);
+    ASSERT_EQ(vectors.spill_chunk(0, filepath), chunk_size);
+    // the spilled chunk stays at the same address with the same data
+    ASSERT_EQ(vectors.get_chunk_data(0), chunk);
+    ASSERT_FALSE(std::filesystem::exists(filepath));
+    ASSERT_EQ(arena->ByteSize(), 2 * chunk_size);
+    ASSERT_EQ(arena->ResidentByteSize(), chunk_size);
+    for (int64_t i = 0; i < 1024; ++i) {
+        ASSERT_EQ(vectors.get_element(i)[0], float(i * dim));
+    }
+    // a chunk is spilled only once
+    ASSERT_EQ(vectors.spill_chunk(0, filepath), 0);
+
+    // the chunks in the slabs are not spilled
+    ConcurrentVector<int64_t> small(16, arena);
+    std::vector<int64_t> values(16, 1);
+    small.set_data_raw(0, values.data(), values.size());
+    ASSERT_EQ(small.spill_chunk(0, filepath), 0);
+
+    vectors.clear();
+    ASSERT_EQ(arena->ResidentByteSize(),
+              static_cast<int64_t>(ChunkArena::SLAB_SIZE));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ConcurrentVector, TestVariableLength) {
+    ConcurrentVector<std::string> strings(16);
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(std::string(i, 'a' + i % 26));
+    }
+    strings.set_data_raw(0, values.data(), 40);
+    strings.set_data_raw(40, values.data() + 40, 60);
+    ASSERT_EQ(strings.num_chunk(), 7);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(strings[i], values[i]);
+    }
+    // the strings set together are packed in order
+    for (int i = 1; i < 40; ++i) {
+        ASSERT_EQ(strings[i - 1].data() + strings[i - 1].size(),
+                  strings[i].data());
+    }
+
+    ConcurrentVector<milvus::Json> jsons(16);
+    std::vector<milvus::Json> json_values;
+    for (int i = 0; i < 20; ++i) {
+        json_values.emplace_back(simdjson::padded_string(
+            fmt::format("{{\"key\": {}}}", i)));
+    }
+    jsons.set_data_raw(0, json_values.data(), json_values.size());
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(jsons[i].at<int64_t>("/key").value(), i);
+    }
+}
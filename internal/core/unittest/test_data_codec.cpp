@@ -15,10 +15,13 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <numeric>
 
 #include "storage/DataCodec.h"
+#include "storage/Event.h"
 #include "storage/InsertData.h"
 #include "storage/IndexData.h"
+#include "storage/PayloadWriter.h"
 #include "storage/Util.h"
 #include "common/Consts.h"
 #include "common/Json.h"
@@ -190,6 +193,44 @@ TEST(storage, InsertDataString) {
     ASSERT_EQ(data, new_data);
 }
 
+TEST(storage, InsertDataJson) {
+    std::vector<std::string> data = {
+        R"({"a": 1})", R"({"a": 2, "b": "x"})", "[]", R"({"a": [3]})"};
+    auto field_data = milvus::storage::CreateFieldData(storage::DataType::JSON);
+    {
+        // the rows are copied into the field data
+        std::vector<Json> jsons;
+        for (auto& value : data) {
+            jsons.emplace_back(simdjson::padded_string(value));
+        }
+        field_data->FillFieldData(jsons.data(), jsons.size());
+    }
+
+    storage::InsertData insert_data(field_data);
+    storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+    insert_data.SetFieldDataMeta(field_data_meta);
+    insert_data.SetTimestamps(0, 100);
+
+    auto serialized_bytes = insert_data.Serialize(storage::StorageType::Remote);
+    std::shared_ptr<uint8_t[]> serialized_data_ptr(serialized_bytes.data(),
+                                                   [&](uint8_t*) {});
+    auto new_insert_data = storage::DeserializeFileData(
+        serialized_data_ptr, serialized_bytes.size());
+    auto new_payload = new_insert_data->GetFieldData();
+    ASSERT_EQ(new_payload->get_data_type(), storage::DataType::JSON);
+    ASSERT_EQ(new_payload->get_num_rows(), data.size());
+    for (int i = 0; i < data.size(); ++i) {
+        auto json = static_cast<const Json*>(new_payload->RawValue(i));
+        ASSERT_EQ(json->data(), data[i]);
+        ASSERT_EQ(new_payload->Size(i), data[i].size());
+    }
+    // the rows are parsed in place, the padding is at the end of the block
+    auto last = static_cast<const Json*>(new_payload->RawValue(3));
+    ASSERT_EQ(last->array_at("/a").value().size(), 1);
+    auto first = static_cast<const Json*>(new_payload->RawValue(0));
+    ASSERT_EQ(first->at<int64_t>("/a").value(), 1);
+}
+
 TEST(storage, InsertDataFloat) {
     FixedVector<float> data = {1, 2, 3, 4, 5};
     auto field_data =
@@ -274,6 +315,67 @@ TEST(storage, InsertDataFloatVector) {
     ASSERT_EQ(data, new_data);
 }
 
+TEST(storage, InsertDataFloatVectorRawLayout) {
+    auto default_policy =
+        storage::GetPayloadEncodingPolicy(storage::DataType::VECTOR_FLOAT);
+    auto raw_policy = default_policy;
+    raw_policy.raw_layout = true;
+    storage::SetPayloadEncodingPolicy(storage::DataType::VECTOR_FLOAT,
+                                      raw_policy);
+
+    std::vector<float> data = {1, 2, 3, 4, 5, 6, 7, 8};
+    int DIM = 2;
+    auto field_data =
+        milvus::storage::CreateFieldData(storage::DataType::VECTOR_FLOAT, DIM);
+    field_data->FillFieldData(data.data(), data.size() / DIM);
+    storage::InsertData insert_data(field_data);
+    storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+    insert_data.SetFieldDataMeta(field_data_meta);
+    insert_data.SetTimestamps(0, 100);
+    auto serialized_bytes = insert_data.Serialize(storage::StorageType::Remote);
+    storage::SetPayloadEncodingPolicy(storage::DataType::VECTOR_FLOAT,
+                                      default_policy);
+    std::shared_ptr<uint8_t[]> serialized_data_ptr(serialized_bytes.data(),
+                                                   [&](uint8_t*) {});
+
+    // the values are found in place, aligned in the binlog
+    auto raw = storage::FindRawInsertPayload(serialized_data_ptr,
+                                             serialized_bytes.size());
+    ASSERT_TRUE(raw.has_value());
+    ASSERT_EQ(raw->num_rows, data.size() / DIM);
+    ASSERT_EQ(raw->dim, DIM);
+    ASSERT_EQ((raw->data - serialized_bytes.data()) %
+                  storage::RAW_PAYLOAD_ALIGNMENT,
+              0);
+    ASSERT_EQ(memcmp(raw->data, data.data(), data.size() * sizeof(float)), 0);
+
+    auto new_insert_data = storage::DeserializeFileData(
+        serialized_data_ptr, serialized_bytes.size());
+    ASSERT_EQ(new_insert_data->GetTimeRage(),
+              std::make_pair(Timestamp(0), Timestamp(100)));
+    auto new_payload = new_insert_data->GetFieldData();
+    ASSERT_EQ(new_payload->get_data_type(), storage::DataType::VECTOR_FLOAT);
+    ASSERT_EQ(new_payload->get_num_rows(), data.size() / DIM);
+    ASSERT_EQ(memcmp(new_payload->Data(),
+                     data.data(),
+                     data.size() * sizeof(float)),
+              0);
+
+    // a corrupted value fails the checksum
+    serialized_bytes.back() ^= 1;
+    ASSERT_ANY_THROW(storage::DeserializeFileData(serialized_data_ptr,
+                                                  serialized_bytes.size()));
+
+    // the parquet payloads are not raw
+    auto parquet_bytes =
+        storage::InsertData(field_data).Serialize(storage::StorageType::Remote);
+    std::shared_ptr<uint8_t[]> parquet_data_ptr(parquet_bytes.data(),
+                                                [&](uint8_t*) {});
+    ASSERT_FALSE(
+        storage::FindRawInsertPayload(parquet_data_ptr, parquet_bytes.size())
+            .has_value());
+}
+
 TEST(storage, InsertDataBinaryVector) {
     std::vector<uint8_t> data = {1, 2, 3, 4, 5, 6, 7, 8};
     int DIM = 16;
@@ -360,6 +462,83 @@ TEST(storage, IndexData) {
     ASSERT_EQ(data, new_data);
 }
 
+TEST(storage, IndexDataSerializedInParts) {
+    std::vector<uint8_t> data(1 << 16);
+    std::iota(data.begin(), data.end(), 0);
+    auto field_data = milvus::storage::CreateFieldData(storage::DataType::INT8);
+    field_data->FillFieldData(data.data(), data.size());
+
+    storage::IndexData index_data(field_data);
+    storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+    index_data.SetFieldDataMeta(field_data_meta);
+    index_data.SetTimestamps(0, 100);
+    storage::IndexMeta index_meta{102, 103, 104, 1};
+    index_data.set_index_meta(index_meta);
+
+    // the parts streamed make up the same file as the one serialized whole
+    std::vector<uint8_t> streamed_bytes;
+    int num_parts = 0;
+    auto size = index_data.serialize_to_remote_file(
+        [&](const uint8_t* part, size_t part_size) {
+            streamed_bytes.insert(streamed_bytes.end(), part, part + part_size);
+            num_parts++;
+        });
+    ASSERT_GT(num_parts, 1);
+    ASSERT_EQ(size, streamed_bytes.size());
+    auto serialized_bytes = index_data.Serialize(storage::StorageType::Remote);
+    ASSERT_EQ(streamed_bytes, serialized_bytes);
+
+    std::shared_ptr<uint8_t[]> serialized_data_ptr(streamed_bytes.data(),
+                                                   [&](uint8_t*) {});
+    auto new_index_data = storage::DeserializeFileData(serialized_data_ptr,
+                                                       streamed_bytes.size());
+    auto new_field_data = new_index_data->GetFieldData();
+    ASSERT_EQ(new_field_data->Size(), data.size());
+    std::vector<uint8_t> new_data(data.size());
+    memcpy(new_data.data(), new_field_data->Data(), new_field_data->Size());
+    ASSERT_EQ(data, new_data);
+}
+
+TEST(storage, PayloadChecksum) {
+    std::vector<int64_t> data = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto field_data =
+        milvus::storage::CreateFieldData(storage::DataType::INT64);
+    field_data->FillFieldData(data.data(), data.size());
+    storage::InsertData insert_data(field_data);
+    storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+    insert_data.SetFieldDataMeta(field_data_meta);
+    insert_data.SetTimestamps(0, 100);
+
+    auto serialized_bytes = insert_data.Serialize(storage::StorageType::Remote);
+    std::shared_ptr<uint8_t[]> serialized_data_ptr(serialized_bytes.data(),
+                                                   [&](uint8_t*) {});
+    auto reader = std::make_shared<storage::BinlogReader>(
+        serialized_data_ptr, serialized_bytes.size());
+    ASSERT_EQ(storage::ReadMediumType(reader), storage::StorageType::Remote);
+    storage::DescriptorEvent descriptor_event(reader);
+    auto& extras = descriptor_event.event_data.extras;
+    ASSERT_EQ(extras[PAYLOAD_CRC32C_KEY].size(), 8);
+    auto [event_bytes, event_size] = reader->Remaining();
+    storage::VerifyPayloadChecksum(
+        descriptor_event.event_data, event_bytes, event_size);
+
+    // a flipped bit of the event is found before the payload is decoded
+    auto flipped = event_bytes - serialized_bytes.data() + event_size / 2;
+    serialized_bytes[flipped] ^= 1;
+    try {
+        storage::DeserializeFileData(serialized_data_ptr,
+                                     serialized_bytes.size());
+        FAIL() << "the corrupted binlog is deserialized";
+    } catch (SegcoreError& e) {
+        ASSERT_EQ(e.get_error_code(), ErrorCode::DataFormatBroken);
+    }
+
+    // the binlogs written without the checksum are not checked
+    extras.erase(PAYLOAD_CRC32C_KEY);
+    storage::VerifyPayloadChecksum(
+        descriptor_event.event_data, event_bytes, event_size);
+}
+
 TEST(storage, InsertDataStringArray) {
     milvus::proto::schema::ScalarField field_string_data;
     field_string_data.mutable_string_data()->add_data("test_array1");
@@ -396,3 +575,37 @@ TEST(storage, InsertDataStringArray) {
         ASSERT_TRUE(data[i].operator==(new_data[i]));
     }
 }
+
+TEST(storage, MergeFieldData) {
+    int64_t dim = 4;
+    std::vector<milvus::FieldDataPtr> field_datas;
+    std::vector<float> expected;
+    for (int64_t i = 0; i < 3; ++i) {
+        std::vector<float> data(dim * (i + 1));
+        std::iota(data.begin(), data.end(), expected.size());
+        expected.insert(expected.end(), data.begin(), data.end());
+        auto field_data = milvus::storage::CreateFieldData(
+            storage::DataType::VECTOR_FLOAT, dim, i + 1);
+        field_data->FillFieldData(data.data(), i + 1);
+        field_datas.push_back(field_data);
+    }
+    auto merged = milvus::storage::MergeFieldData(field_datas);
+    ASSERT_EQ(merged->get_dim(), dim);
+    ASSERT_EQ(merged->get_num_rows(), 6);
+    ASSERT_TRUE(merged->IsFull());
+    auto merged_data = static_cast<const float*>(merged->Data());
+    ASSERT_EQ(std::vector<float>(merged_data, merged_data + expected.size()),
+              expected);
+
+    // filled batch by batch without the rows known
+    auto field_data =
+        milvus::storage::CreateFieldData(storage::DataType::INT64);
+    for (int64_t i = 0; i < 100; ++i) {
+        field_data->FillFieldData(&i, 1);
+    }
+    ASSERT_EQ(field_data->get_num_rows(), 100);
+    ASSERT_TRUE(field_data->IsFull());
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(*static_cast<const int64_t*>(field_data->RawValue(i)), i);
+    }
+}
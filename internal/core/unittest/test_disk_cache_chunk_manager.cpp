@@ -0,0 +1,123 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "storage/DiskCacheChunkManager.h"
+#include "storage/LocalChunkManagerSingleton.h"
+
+using namespace milvus;
+using namespace milvus::storage;
+
+class DiskCacheChunkManagerTest : public testing::Test {
+ public:
+    void
+    SetUp() override {
+        lcm_ = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+        remote_dir_ = lcm_->GetRootPath() + "/disk-cache-test-remote";
+        cache_dir_ = lcm_->GetRootPath() + "/disk-cache-test-cache";
+        lcm_->RemoveDir(remote_dir_);
+        lcm_->RemoveDir(cache_dir_);
+    }
+
+    void
+    TearDown() override {
+        lcm_->RemoveDir(remote_dir_);
+        lcm_->RemoveDir(cache_dir_);
+    }
+
+    std::string
+    WriteRemoteFile(const std::string& name, std::vector<uint8_t>& data) {
+        auto file = remote_dir_ + "/" + name;
+        lcm_->CreateFile(file);
+        lcm_->Write(file, data.data(), data.size());
+        return file;
+    }
+
+ protected:
+    LocalChunkManagerSPtr lcm_;
+    std::string remote_dir_;
+    std::string cache_dir_;
+};
+
+TEST_F(DiskCacheChunkManagerTest, ReadThrough) {
+    std::vector<uint8_t> data(100);
+    for (int i = 0; i < data.size(); i++) {
+        data[i] = i;
+    }
+    auto file = WriteRemoteFile("file", data);
+
+    auto cm = std::make_shared<DiskCacheChunkManager>(lcm_, cache_dir_, 1024);
+    std::vector<uint8_t> buf(data.size());
+    EXPECT_EQ(cm->Read(file, buf.data(), buf.size()), data.size());
+    EXPECT_EQ(buf, data);
+    EXPECT_EQ(cm->CachedBytes(), data.size());
+
+    // served from the cache after the remote file is removed
+    lcm_->Remove(file);
+    std::fill(buf.begin(), buf.end(), 0);
+    EXPECT_TRUE(cm->Exist(file));
+    EXPECT_EQ(cm->Size(file), data.size());
+    EXPECT_EQ(cm->Read(file, buf.data(), buf.size()), data.size());
+    EXPECT_EQ(buf, data);
+    uint8_t range[10];
+    EXPECT_EQ(cm->Read(file, 95, range, sizeof(range)), 5);
+    EXPECT_EQ(range[0], 95);
+
+    // the cached files are recovered after restart
+    cm.reset();
+    cm = std::make_shared<DiskCacheChunkManager>(lcm_, cache_dir_, 1024);
+    EXPECT_EQ(cm->CachedBytes(), data.size());
+    std::fill(buf.begin(), buf.end(), 0);
+    EXPECT_EQ(cm->Read(file, buf.data(), buf.size()), data.size());
+    EXPECT_EQ(buf, data);
+
+    cm->Remove(file);
+    EXPECT_EQ(cm->CachedBytes(), 0);
+    EXPECT_FALSE(cm->Exist(file));
+}
+
+TEST_F(DiskCacheChunkManagerTest, EvictByCapacity) {
+    std::vector<uint8_t> data(100, 1);
+    std::vector<std::string> files;
+    for (int i = 0; i < 3; i++) {
+        files.emplace_back(WriteRemoteFile(std::to_string(i), data));
+    }
+
+    auto cm = std::make_shared<DiskCacheChunkManager>(lcm_, cache_dir_, 250);
+    std::vector<uint8_t> buf(data.size());
+    cm->Read(files[0], buf.data(), buf.size());
+    cm->Read(files[1], buf.data(), buf.size());
+    // touch the first file so that the second one is the least recently used
+    cm->Read(files[0], buf.data(), buf.size());
+    cm->Read(files[2], buf.data(), buf.size());
+    EXPECT_EQ(cm->CachedBytes(), 200);
+
+    for (auto& file : files) {
+        lcm_->Remove(file);
+    }
+    EXPECT_TRUE(cm->Exist(files[0]));
+    EXPECT_FALSE(cm->Exist(files[1]));
+    EXPECT_TRUE(cm->Exist(files[2]));
+
+    // restart with a smaller capacity
+    cm.reset();
+    cm = std::make_shared<DiskCacheChunkManager>(lcm_, cache_dir_, 150);
+    EXPECT_EQ(cm->CachedBytes(), 100);
+}
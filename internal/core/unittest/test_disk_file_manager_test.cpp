@@ -11,6 +11,7 @@
 
 #include <chrono>
 #include <gtest/gtest.h>
+#include <map>
 #include <string>
 #include <vector>
 #include <unistd.h>
@@ -98,6 +99,111 @@ TEST_F(DiskAnnFileManagerTest, AddFilePositiveParallel) {
     }
 }
 
+TEST_F(DiskAnnFileManagerTest, CacheIndexToDiskManyFiles) {
+    auto lcm = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    std::string index_dir = "/tmp/diskann/index_files/1001/";
+    // a file of many slices besides one of a single short slice
+    std::vector<std::pair<std::string, uint64_t>> files = {
+        {index_dir + "index", (3 * milvus::FILE_SLICE_SIZE) + 100},
+        {index_dir + "pq_pivots", 100}};
+    std::map<std::string, std::vector<uint8_t>> datas;
+    for (auto& [file, size] : files) {
+        auto& data = datas[file.substr(index_dir.size())];
+        data.resize(size);
+        for (uint64_t i = 0; i < size; ++i) {
+            data[i] = (i * 7 + size) % 251;
+        }
+        lcm->CreateFile(file);
+        lcm->Write(file, data.data(), size);
+    }
+
+    FieldDataMeta filed_data_meta = {1, 2, 3, 100};
+    IndexMeta index_meta = {3, 100, 1001, 1, "index"};
+    auto diskAnnFileManager = std::make_shared<DiskFileManagerImpl>(
+        storage::FileManagerContext(filed_data_meta, index_meta, cm_));
+    for (auto& [file, size] : files) {
+        EXPECT_TRUE(diskAnnFileManager->AddFile(file));
+        lcm->Remove(file);
+    }
+
+    std::vector<std::string> remote_files;
+    for (auto& file2size : diskAnnFileManager->GetRemotePathsToFileSize()) {
+        remote_files.emplace_back(file2size.first);
+    }
+    auto loader = std::make_shared<DiskFileManagerImpl>(
+        storage::FileManagerContext(filed_data_meta, index_meta, cm_));
+    loader->CacheIndexToDisk(remote_files);
+
+    auto local_files = loader->GetLocalFilePaths();
+    ASSERT_EQ(local_files.size(), files.size());
+    for (auto& file : local_files) {
+        auto& data = datas.at(file.substr(file.find_last_of('/') + 1));
+        auto file_size = lcm->Size(file);
+        ASSERT_EQ(file_size, data.size());
+        std::vector<uint8_t> buf(file_size);
+        lcm->Read(file, buf.data(), file_size);
+        EXPECT_EQ(buf, data);
+    }
+
+    for (auto& file : remote_files) {
+        cm_->Remove(file);
+    }
+}
+
+TEST_F(DiskAnnFileManagerTest, GetObjectDataInOrder) {
+    FieldDataMeta field_data_meta = {1, 2, 3, 100};
+    IndexMeta index_meta = {3, 100, 1001, 1, "index"};
+
+    int64_t num_slices = 10;
+    int64_t slice_size = 1024;
+    std::vector<std::vector<uint8_t>> slices;
+    std::vector<const uint8_t*> data_slices;
+    std::vector<int64_t> slice_sizes;
+    std::vector<std::string> slice_names;
+    for (int64_t i = 0; i < num_slices; ++i) {
+        slices.emplace_back(slice_size + i, static_cast<uint8_t>(i));
+        data_slices.push_back(slices.back().data());
+        slice_sizes.push_back(slices.back().size());
+        slice_names.push_back(GenSlicedFileName("index", i));
+    }
+    auto remote_paths_to_size = PutIndexData(cm_.get(),
+                                             data_slices,
+                                             slice_sizes,
+                                             slice_names,
+                                             field_data_meta,
+                                             index_meta);
+    std::vector<std::string> remote_files;
+    for (auto& name : slice_names) {
+        for (auto& [path, _] : remote_paths_to_size) {
+            if (path.substr(path.find_last_of('/') + 1) == name) {
+                remote_files.push_back(path);
+            }
+        }
+    }
+    ASSERT_EQ(remote_files.size(), num_slices);
+
+    // the files are consumed in order whatever the window
+    for (int64_t window : {1, 3, 100}) {
+        size_t next = 0;
+        GetObjectData(cm_.get(),
+                      remote_files,
+                      window,
+                      [&](size_t i, FieldDataPtr data) {
+                          ASSERT_EQ(i, next++);
+                          ASSERT_EQ(data->Size(), slice_size + i);
+                          auto bytes =
+                              static_cast<const uint8_t*>(data->Data());
+                          ASSERT_EQ(bytes[0], i);
+                          ASSERT_EQ(bytes[data->Size() - 1], i);
+                      });
+        ASSERT_EQ(next, num_slices);
+    }
+
+    for (auto& file : remote_files) {
+        cm_->Remove(file);
+    }
+}
+
 int
 test_worker(string s) {
     std::cout << s << std::endl;
@@ -183,3 +289,59 @@ TEST_F(DiskAnnFileManagerTest, TestThreadPoolException) {
         EXPECT_EQ(std::string(e.what()), "run time error");
     }
 }
+
+TEST_F(DiskAnnFileManagerTest, TestThreadPoolYieldToHigherPriority) {
+    auto high_pool = std::make_shared<milvus::ThreadPool>(1, "test_high");
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::vector<std::future<void>> high_futures;
+    for (size_t i = 0; i < high_pool->GetMaxThreadNum() * 2; i++) {
+        high_futures.push_back(
+            high_pool->Submit([released]() { released.wait(); }));
+    }
+    while (high_pool->GetQueuedTaskNum() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    milvus::ThreadPoolOptions options;
+    options.higher_priority_pools = {high_pool.get()};
+    options.contended_running_limit = 1;
+    auto low_pool =
+        std::make_shared<milvus::ThreadPool>(10, "test_low", options);
+    std::atomic<int> running = 0;
+    std::atomic<int> max_running = 0;
+    std::vector<std::future<void>> low_futures;
+    for (int i = 0; i < 20; i++) {
+        low_futures.push_back(low_pool->Submit([&]() {
+            auto now = ++running;
+            auto max = max_running.load();
+            while (now > max && !max_running.compare_exchange_weak(max, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            running--;
+        }));
+    }
+    for (auto& future : low_futures) {
+        future.get();
+    }
+    EXPECT_EQ(max_running.load(), 1);
+
+    release.set_value();
+    for (auto& future : high_futures) {
+        future.get();
+    }
+}
+
+TEST_F(DiskAnnFileManagerTest, TestThreadPoolNumaAware) {
+    milvus::ThreadPoolOptions options;
+    options.numa_aware = true;
+    auto thread_pool =
+        std::make_shared<milvus::ThreadPool>(10, "test_numa", options);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; i++) {
+        futures.push_back(thread_pool->Submit(compute, i));
+    }
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(futures[i].get(), i + 10);
+    }
+}
@@ -11,9 +11,13 @@
 
 #include <boost/format.hpp>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <regex>
+#include <utility>
 #include <vector>
 #include <chrono>
 
@@ -31,6 +35,8 @@
 #include "exec/QueryContext.h"
 #include "expr/ITypeExpr.h"
 #include "exec/expression/Expr.h"
+#include "exec/expression/ExprRewriter.h"
+#include "exec/expression/TermExpr.h"
 
 using namespace milvus;
 using namespace milvus::exec;
@@ -191,6 +197,390 @@ TEST_F(TaskTest, LogicalExpr) {
     EXPECT_EQ(num_rows, num_rows_);
 }
 
+static std::vector<bool>
+ExecuteFilter(const SegmentSealedSPtr& segment,
+              const expr::TypedExprPtr& filter,
+              std::optional<std::pair<int64_t, int64_t>> row_range =
+                  std::nullopt) {
+    std::vector<milvus::plan::PlanNodePtr> sources;
+    auto filter_node = std::make_shared<milvus::plan::FilterBitsNode>(
+        "plannode id 1", filter, sources);
+    auto plan = plan::PlanFragment(filter_node);
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        "test1", segment.get(), MAX_TIMESTAMP);
+    if (row_range.has_value()) {
+        query_context->set_row_range(row_range->first, row_range->second);
+    }
+    auto task = Task::Create("task_filter", plan, 0, query_context);
+    std::vector<bool> res;
+    for (;;) {
+        auto result = task->Next();
+        if (!result) {
+            break;
+        }
+        auto vec = std::dynamic_pointer_cast<ColumnVector>(result->child(0));
+        auto data = static_cast<bool*>(vec->GetRawData());
+        res.insert(res.end(), data, data + vec->size());
+    }
+    return res;
+}
+
+TEST_F(TaskTest, SelectiveConjunctExpr) {
+    ::milvus::proto::plan::GenericValue int64_val;
+    int64_val.set_int64_val(20000);
+    auto selective = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["int64"], DataType::INT64),
+        proto::plan::OpType::LessThan,
+        int64_val);
+    ::milvus::proto::plan::GenericValue int32_val;
+    int32_val.set_int64_val(num_rows_);
+    auto dense = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["int32"], DataType::INT32),
+        proto::plan::OpType::LessThan,
+        int32_val);
+    ::milvus::proto::plan::GenericValue str_val;
+    str_val.set_string_val("5");
+    auto str = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["string2"], DataType::VARCHAR),
+        proto::plan::OpType::GreaterThan,
+        str_val);
+
+    auto selective_res = ExecuteFilter(segment_, selective);
+    auto dense_res = ExecuteFilter(segment_, dense);
+    auto str_res = ExecuteFilter(segment_, str);
+    ASSERT_EQ(selective_res.size(), num_rows_);
+    ASSERT_EQ(dense_res.size(), num_rows_);
+    ASSERT_EQ(str_res.size(), num_rows_);
+
+    // the later children only evaluate the rows passing the former ones
+    auto and_expr = std::make_shared<milvus::expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And,
+        std::make_shared<milvus::expr::LogicalBinaryExpr>(
+            expr::LogicalBinaryExpr::OpType::And, selective, str),
+        dense);
+    auto and_res = ExecuteFilter(segment_, and_expr);
+    ASSERT_EQ(and_res.size(), num_rows_);
+    for (int64_t i = 0; i < num_rows_; ++i) {
+        ASSERT_EQ(and_res[i], selective_res[i] && str_res[i] && dense_res[i]);
+    }
+
+    // the later children only evaluate the rows failing the former ones
+    auto not_selective = std::make_shared<milvus::expr::LogicalUnaryExpr>(
+        expr::LogicalUnaryExpr::OpType::LogicalNot, selective);
+    auto or_expr = std::make_shared<milvus::expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::Or,
+        std::make_shared<milvus::expr::LogicalBinaryExpr>(
+            expr::LogicalBinaryExpr::OpType::Or, not_selective, str),
+        dense);
+    auto or_res = ExecuteFilter(segment_, or_expr);
+    ASSERT_EQ(or_res.size(), num_rows_);
+    for (int64_t i = 0; i < num_rows_; ++i) {
+        ASSERT_EQ(or_res[i], !selective_res[i] || str_res[i] || dense_res[i]);
+    }
+}
+
+TEST_F(TaskTest, RowRangeExpr) {
+    ::milvus::proto::plan::GenericValue int64_val;
+    int64_val.set_int64_val(num_rows_ / 2);
+    auto int_expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["int64"], DataType::INT64),
+        proto::plan::OpType::LessThan,
+        int64_val);
+    ::milvus::proto::plan::GenericValue str_val;
+    str_val.set_string_val("5");
+    auto str_expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(field_map_["string2"], DataType::VARCHAR),
+        proto::plan::OpType::GreaterThan,
+        str_val);
+    auto and_expr = std::make_shared<milvus::expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, int_expr, str_expr);
+
+    auto expected = ExecuteFilter(segment_, and_expr);
+    ASSERT_EQ(expected.size(), num_rows_);
+    // the ranges don't have to be aligned to the batches
+    std::vector<int64_t> bounds = {0, 1000, 300000, 300001, num_rows_};
+    std::vector<bool> res;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        auto part = ExecuteFilter(
+            segment_, and_expr, std::make_pair(bounds[i], bounds[i + 1]));
+        ASSERT_EQ(part.size(), bounds[i + 1] - bounds[i]);
+        res.insert(res.end(), part.begin(), part.end());
+    }
+    ASSERT_EQ(res, expected);
+}
+
+TEST_F(TaskTest, RewrittenExpr) {
+    using LogicalOp = expr::LogicalBinaryExpr::OpType;
+    auto unary = [&](const std::string& field,
+                     DataType data_type,
+                     proto::plan::OpType op,
+                     int64_t value) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(field_map_[field], data_type), op, val);
+    };
+    auto lower = unary(
+        "int64", DataType::INT64, proto::plan::OpType::GreaterThan, -1000);
+    auto upper =
+        unary("int64", DataType::INT64, proto::plan::OpType::LessEqual, 1000);
+    auto other =
+        unary("int32", DataType::INT32, proto::plan::OpType::LessThan, 50);
+    auto lower_res = ExecuteFilter(segment_, lower);
+    auto upper_res = ExecuteFilter(segment_, upper);
+    auto other_res = ExecuteFilter(segment_, other);
+
+    // a merged range
+    auto range = std::make_shared<expr::LogicalBinaryExpr>(
+        LogicalOp::And, lower, upper);
+    auto range_res = ExecuteFilter(segment_, range);
+    // a not pushed down
+    auto not_expr = std::make_shared<expr::LogicalUnaryExpr>(
+        expr::LogicalUnaryExpr::OpType::LogicalNot,
+        std::make_shared<expr::LogicalBinaryExpr>(
+            LogicalOp::Or, lower, other));
+    auto not_res = ExecuteFilter(segment_, not_expr);
+    // a factored input
+    auto factored = std::make_shared<expr::LogicalBinaryExpr>(
+        LogicalOp::Or,
+        std::make_shared<expr::LogicalBinaryExpr>(
+            LogicalOp::And, other, lower),
+        std::make_shared<expr::LogicalBinaryExpr>(
+            LogicalOp::And, upper, other));
+    auto factored_res = ExecuteFilter(segment_, factored);
+    ASSERT_EQ(range_res.size(), num_rows_);
+    ASSERT_EQ(not_res.size(), num_rows_);
+    ASSERT_EQ(factored_res.size(), num_rows_);
+    for (int64_t i = 0; i < num_rows_; ++i) {
+        ASSERT_EQ(range_res[i], lower_res[i] && upper_res[i]);
+        ASSERT_EQ(not_res[i], !(lower_res[i] || other_res[i]));
+        ASSERT_EQ(factored_res[i],
+                  (other_res[i] && lower_res[i]) ||
+                      (upper_res[i] && other_res[i]));
+    }
+}
+
+TEST(ExprRewriter, Rewrite) {
+    using namespace milvus::exec;
+    using LogicalOp = expr::LogicalBinaryExpr::OpType;
+    using proto::plan::OpType;
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto int_fid = schema->AddDebugField("int", DataType::INT32);
+    auto float_fid = schema->AddDebugField("float", DataType::FLOAT);
+    auto unary = [](FieldId field_id,
+                    DataType data_type,
+                    OpType op,
+                    int64_t value) -> expr::TypedExprPtr {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(field_id, data_type), op, val);
+    };
+    auto logical = [](LogicalOp op,
+                      const expr::TypedExprPtr& left,
+                      const expr::TypedExprPtr& right) -> expr::TypedExprPtr {
+        return std::make_shared<expr::LogicalBinaryExpr>(op, left, right);
+    };
+    auto not_of = [](const expr::TypedExprPtr& child) -> expr::TypedExprPtr {
+        return std::make_shared<expr::LogicalUnaryExpr>(
+            expr::LogicalUnaryExpr::OpType::LogicalNot, child);
+    };
+    auto a = unary(int_fid, DataType::INT32, OpType::GreaterThan, 1);
+    auto b = unary(int_fid, DataType::INT32, OpType::LessThan, 10);
+    auto c = unary(pk_fid, DataType::INT64, OpType::Equal, 7);
+    auto f = unary(float_fid, DataType::FLOAT, OpType::GreaterThan, 1);
+
+    // the bounds are merged, the looser ones dropped
+    auto loose = unary(int_fid, DataType::INT32, OpType::GreaterEqual, 1);
+    auto range = RewriteExpr(
+        logical(LogicalOp::And, logical(LogicalOp::And, loose, b), a),
+        *schema);
+    auto binary =
+        std::dynamic_pointer_cast<const expr::BinaryRangeFilterExpr>(range);
+    ASSERT_NE(binary, nullptr);
+    ASSERT_EQ(binary->lower_val_.int64_val(), 1);
+    ASSERT_EQ(binary->upper_val_.int64_val(), 10);
+    ASSERT_FALSE(binary->lower_inclusive_);
+    ASSERT_FALSE(binary->upper_inclusive_);
+    // but not the overflowed ones
+    auto overflowed =
+        unary(int_fid, DataType::INT32, OpType::LessThan, 1LL << 40);
+    ASSERT_TRUE(std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(
+        RewriteExpr(logical(LogicalOp::And, a, overflowed), *schema)));
+
+    // the duplicates and the always true inputs are dropped
+    auto always_true = std::make_shared<expr::AlwaysTrueExpr>();
+    ASSERT_EQ(RewriteExpr(logical(LogicalOp::And,
+                                  logical(LogicalOp::And, c, always_true),
+                                  c),
+                          *schema),
+              c);
+    ASSERT_EQ(RewriteExpr(logical(LogicalOp::Or, c, always_true), *schema),
+              always_true);
+
+    // not is pushed down to the ranges, but the float ones
+    ASSERT_EQ(RewriteExpr(not_of(not_of(f)), *schema), f);
+    auto negated = RewriteExpr(not_of(logical(LogicalOp::And, a, c)), *schema);
+    auto negated_or =
+        std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(negated);
+    ASSERT_NE(negated_or, nullptr);
+    ASSERT_EQ(negated_or->op_type_, LogicalOp::Or);
+    auto negated_a =
+        std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+            negated_or->inputs()[0]);
+    ASSERT_EQ(negated_a->op_type_, OpType::LessEqual);
+    auto negated_c =
+        std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+            negated_or->inputs()[1]);
+    ASSERT_EQ(negated_c->op_type_, OpType::NotEqual);
+    ASSERT_TRUE(std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(
+        RewriteExpr(not_of(f), *schema)));
+
+    // the inputs shared by the branches are factored out
+    auto factored = RewriteExpr(
+        logical(LogicalOp::Or,
+                logical(LogicalOp::And, c, f),
+                logical(LogicalOp::And, a, c)),
+        *schema);
+    auto factored_and =
+        std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(factored);
+    ASSERT_NE(factored_and, nullptr);
+    ASSERT_EQ(factored_and->op_type_, LogicalOp::And);
+    ASSERT_EQ(factored_and->inputs()[0], c);
+    ASSERT_EQ(RewriteExpr(logical(LogicalOp::Or,
+                                  c,
+                                  logical(LogicalOp::And, c, f)),
+                          *schema),
+              c);
+
+    // an in of a single value is an equality, but on the pk
+    std::vector<proto::plan::GenericValue> vals(1);
+    vals[0].set_int64_val(3);
+    auto in = RewriteExpr(
+        std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(int_fid, DataType::INT32), vals),
+        *schema);
+    auto equal =
+        std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(in);
+    ASSERT_NE(equal, nullptr);
+    ASSERT_EQ(equal->op_type_, OpType::Equal);
+    auto pk_in = RewriteExpr(
+        std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(pk_fid, DataType::INT64), vals),
+        *schema);
+    ASSERT_TRUE(std::dynamic_pointer_cast<const expr::TermFilterExpr>(pk_in));
+}
+
+TEST(VectorPool, Reuse) {
+    using namespace milvus::exec;
+    VectorPool pool;
+    auto vec = pool.Get(DataType::BOOL, 100);
+    auto data = static_cast<bool*>(vec->GetRawData());
+    std::fill(data, data + 100, true);
+
+    // the vector is still held by the consumer
+    auto other = pool.Get(DataType::BOOL, 100);
+    ASSERT_NE(other.get(), vec.get());
+    ASSERT_EQ(pool.size(), 2);
+
+    // it's reused zeroed once released, only by the same type and size
+    auto raw = vec.get();
+    vec.reset();
+    ASSERT_NE(pool.Get(DataType::BOOL, 50).get(), raw);
+    ASSERT_NE(pool.Get(DataType::INT64, 100).get(), raw);
+    auto reused = pool.Get(DataType::BOOL, 100);
+    ASSERT_EQ(reused.get(), raw);
+    data = static_cast<bool*>(reused->GetRawData());
+    ASSERT_TRUE(std::none_of(data, data + 100, [](bool b) { return b; }));
+    ASSERT_EQ(pool.size(), 4);
+}
+
+TEST(TermSet, Kinds) {
+    using namespace milvus::exec;
+    // a flat array, a sorted array and a hash table
+    for (int64_t n : {5, 100, 3000}) {
+        std::vector<int64_t> values;
+        for (int64_t i = 0; i < n; ++i) {
+            values.push_back(i * 7 - 100);
+        }
+        // the duplicates are dropped
+        values.push_back(-100);
+        TermSet<int64_t> term_set(values);
+        ASSERT_FALSE(term_set.Empty());
+
+        std::vector<int64_t> src;
+        for (int64_t i = -200; i < n * 7; ++i) {
+            src.push_back(i);
+        }
+        std::unique_ptr<bool[]> res(new bool[src.size()]);
+        term_set.Contains(src.data(), src.size(), res.get());
+        for (size_t i = 0; i < src.size(); ++i) {
+            auto x = src[i] + 100;
+            bool expected = x >= 0 && x % 7 == 0 && x / 7 < n;
+            ASSERT_EQ(res[i], expected) << n << ", " << src[i];
+            ASSERT_EQ(term_set.Contains(src[i]), expected);
+        }
+    }
+
+    for (int64_t n : {3, 50, 1000}) {
+        std::vector<std::string> values;
+        for (int64_t i = 0; i < n; ++i) {
+            values.push_back("term_" + std::to_string(i * 2));
+        }
+        TermSet<std::string_view> term_set(values);
+        for (int64_t i = 0; i < n * 2; ++i) {
+            auto str = "term_" + std::to_string(i);
+            ASSERT_EQ(term_set.Contains(str), i % 2 == 0) << n << ", " << str;
+        }
+        ASSERT_FALSE(term_set.Contains(""));
+    }
+
+    // NaN matches nothing, and -0.0 matches 0.0
+    std::vector<double> values = {std::nan(""), -0.0};
+    for (int i = 1; i <= 1000; ++i) {
+        values.push_back(i * 0.5);
+    }
+    TermSet<double> term_set(values);
+    ASSERT_TRUE(term_set.Contains(0.0));
+    ASSERT_TRUE(term_set.Contains(-0.0));
+    ASSERT_TRUE(term_set.Contains(250.5));
+    ASSERT_FALSE(term_set.Contains(250.25));
+    ASSERT_FALSE(term_set.Contains(std::nan("")));
+
+    ASSERT_TRUE(TermSet<int8_t>({}).Empty());
+}
+
+TEST(ITypeExpr, Prepared) {
+    using namespace milvus;
+    std::vector<proto::plan::GenericValue> vals(3);
+    for (int i = 0; i < 3; ++i) {
+        vals[i].set_int64_val(i);
+    }
+    auto expr = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(FieldId(101), DataType::INT64), vals);
+
+    // built once and shared by every segment compiling the expr
+    int builds = 0;
+    auto build = [&]() {
+        ++builds;
+        return std::vector<int64_t>{0, 1, 2};
+    };
+    auto first = expr->GetPrepared<std::vector<int64_t>>(build);
+    auto second = expr->GetPrepared<std::vector<int64_t>>(build);
+    ASSERT_EQ(builds, 1);
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(*first, std::vector<int64_t>({0, 1, 2}));
+
+    // the prepared states of different types don't collide
+    auto term_set = expr->GetPrepared<exec::TermSet<int64_t>>(
+        [&]() { return exec::TermSet<int64_t>(*first); });
+    ASSERT_TRUE(term_set->Contains(int64_t(1)));
+    ASSERT_FALSE(term_set->Contains(int64_t(3)));
+    ASSERT_EQ(builds, 1);
+}
+
 TEST(CompileInputs, and) {
     using namespace milvus;
     using namespace milvus::query;
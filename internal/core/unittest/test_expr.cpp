@@ -13,6 +13,8 @@
 #include <gtest/gtest.h>
 #include <cstdint>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <regex>
 #include <vector>
 #include <chrono>
@@ -1314,6 +1316,61 @@ TEST(Expr, TestCompareWithScalarIndex) {
     }
 }
 
+// the indexed fields of the sealed segment keep their raw data, so they are
+// compared a chunk at a time
+TEST(Expr, TestCompareWithScalarIndexAndRawData) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto left_fid = schema->AddDebugField("left", DataType::INT64);
+    auto right_fid = schema->AddDebugField("right", DataType::INT64);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+
+    auto seg = CreateSealedSegment(schema);
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    SealedLoadFieldData(raw_data, *seg);
+
+    auto left_col = raw_data.get_col<int64_t>(left_fid);
+    auto right_col = raw_data.get_col<int64_t>(right_fid);
+    auto left_index = milvus::index::CreateScalarIndexSort<int64_t>();
+    left_index->Build(N, left_col.data());
+    segcore::LoadIndexInfo load_index_info;
+    load_index_info.field_id = left_fid.get();
+    load_index_info.field_type = DataType::INT64;
+    load_index_info.index = std::move(left_index);
+    seg->LoadIndex(load_index_info);
+
+    std::vector<std::tuple<OpType, std::function<bool(int64_t, int64_t)>>>
+        testcases = {
+            {OpType::LessThan, [](int64_t a, int64_t b) { return a < b; }},
+            {OpType::LessEqual, [](int64_t a, int64_t b) { return a <= b; }},
+            {OpType::GreaterThan, [](int64_t a, int64_t b) { return a > b; }},
+            {OpType::GreaterEqual,
+             [](int64_t a, int64_t b) { return a >= b; }},
+            {OpType::Equal, [](int64_t a, int64_t b) { return a == b; }},
+            {OpType::NotEqual, [](int64_t a, int64_t b) { return a != b; }},
+        };
+    query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+    for (auto [op, ref_func] : testcases) {
+        auto expr = std::make_shared<expr::CompareExpr>(
+            left_fid, right_fid, DataType::INT64, DataType::INT64, op);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg.get(), final);
+        EXPECT_EQ(final.size(), N);
+        for (int i = 0; i < N; ++i) {
+            ASSERT_EQ(final[i], ref_func(left_col[i], right_col[i]))
+                << op << "@" << i;
+        }
+    }
+}
+
 TEST(Expr, TestCompareExpr) {
     using namespace milvus;
     using namespace milvus::query;
@@ -1769,6 +1826,8 @@ TEST(Expr, TestSealedSegmentGetBatchSize) {
 
     std::vector<int64_t> test_batch_size = {
         8192, 10240, 20480, 30720, 40960, 102400, 204800, 307200};
+    // the batch size isn't adapted to the width of the fields
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = 0;
     for (const auto& batch_size : test_batch_size) {
         EXEC_EVAL_EXPR_BATCH_SIZE = batch_size;
         auto plan = plan::PlanFragment(plan_node);
@@ -1793,6 +1852,8 @@ TEST(Expr, TestSealedSegmentGetBatchSize) {
             }
         }
     }
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = DEFAULT_EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+    EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
 }
 
 TEST(Expr, TestGrowingSegmentGetBatchSize) {
@@ -1827,7 +1888,8 @@ TEST(Expr, TestGrowingSegmentGetBatchSize) {
 
     std::vector<int64_t> test_batch_size = {
         8192, 10240, 20480, 30720, 40960, 102400, 204800, 307200};
-
+    // the batch size isn't adapted to the width of the fields
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = 0;
     for (const auto& batch_size : test_batch_size) {
         EXEC_EVAL_EXPR_BATCH_SIZE = batch_size;
         auto plan = plan::PlanFragment(plan_node);
@@ -1852,6 +1914,96 @@ TEST(Expr, TestGrowingSegmentGetBatchSize) {
             }
         }
     }
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = DEFAULT_EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+    EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
+}
+
+TEST(Expr, TestAdaptiveBatchSize) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto int8_fid = schema->AddDebugField("int8", DataType::INT8);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto i64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto seg = CreateGrowingSegment(schema, empty_index_meta);
+    int N = 100000;
+    auto raw_data = DataGen(schema, N);
+    seg->PreInsert(N);
+    seg->Insert(0,
+                N,
+                raw_data.row_ids_.data(),
+                raw_data.timestamps_.data(),
+                raw_data.raw_);
+    auto size_per_chunk = seg->size_per_chunk();
+    // the batch size is adapted only if the working set is configured
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = 256 * 1024;
+
+    proto::plan::GenericValue val;
+    val.set_int64_val(10);
+    auto int8_expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(int8_fid, DataType::INT8),
+        proto::plan::OpType::GreaterThan,
+        val);
+    auto json_expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(json_fid, DataType::JSON, {"int"}),
+        proto::plan::OpType::GreaterThan,
+        val);
+    auto and_expr = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, int8_expr, json_expr);
+
+    auto get_batch_size = [&](const expr::TypedExprPtr& expr) {
+        auto plan = plan::PlanFragment(
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr));
+        auto query_context = std::make_shared<milvus::exec::QueryContext>(
+            "query id", seg.get(), MAX_TIMESTAMP);
+        auto task =
+            milvus::exec::Task::Create("task_expr", plan, 0, query_context);
+        std::vector<int64_t> batch_sizes;
+        int64_t total = 0;
+        for (;;) {
+            auto result = task->Next();
+            if (!result) {
+                break;
+            }
+            batch_sizes.push_back(result->childrens()[0]->size());
+            total += batch_sizes.back();
+        }
+        EXPECT_EQ(total, N);
+        // all the batches but the last one are of the same size, which
+        // never makes a batch straddle the chunks
+        for (size_t i = 0; i + 1 < batch_sizes.size(); ++i) {
+            EXPECT_EQ(batch_sizes[i], batch_sizes[0]);
+        }
+        EXPECT_EQ(size_per_chunk % batch_sizes[0], 0);
+        return batch_sizes[0];
+    };
+
+    auto int8_batch_size = get_batch_size(int8_expr);
+    auto json_batch_size = get_batch_size(json_expr);
+    auto and_batch_size = get_batch_size(and_expr);
+    EXPECT_GT(int8_batch_size, json_batch_size);
+    EXPECT_LE(and_batch_size, json_batch_size);
+    EXPECT_LE(int8_batch_size, DEFAULT_EXEC_EVAL_EXPR_MAX_BATCH_SIZE);
+    EXPECT_GE(and_batch_size, DEFAULT_EXEC_EVAL_EXPR_MIN_BATCH_SIZE / 2);
+
+    // the configured batch size is kept
+    auto query_config = std::make_shared<milvus::exec::QueryConfig>(
+        std::unordered_map<std::string, std::string>{
+            {milvus::exec::QueryConfig::kExprEvalBatchSize, "1000"}});
+    auto plan = plan::PlanFragment(
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, int8_expr));
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        "query id", seg.get(), MAX_TIMESTAMP, query_config);
+    auto task = milvus::exec::Task::Create("task_expr", plan, 0, query_context);
+    auto result = task->Next();
+    EXEC_EVAL_EXPR_WORKING_SET_SIZE = DEFAULT_EXEC_EVAL_EXPR_WORKING_SET_SIZE;
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->childrens()[0]->size(), 1000);
 }
 
 TEST(Expr, TestUnaryBenchTest) {
@@ -2831,6 +2983,136 @@ TEST(Expr, TestBinaryArithOpEvalRange) {
              >)",
              [](int64_t v) { return (v + 500) != 2500; },
              DataType::INT64},
+            // the results which are out of the range of the column type
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 101
+                    data_type: Int8
+                  >
+                  arith_op: Add
+                  right_operand: <
+                    int64_val: 1000
+                  >
+                  op: Equal
+                  value: <
+                    int64_val: 10
+                  >
+             >)",
+             [](int8_t v) { return (v + 1000) == 10; },
+             DataType::INT8},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 101
+                    data_type: Int8
+                  >
+                  arith_op: Sub
+                  right_operand: <
+                    int64_val: -1000
+                  >
+                  op: NotEqual
+                  value: <
+                    int64_val: 1010
+                  >
+             >)",
+             [](int8_t v) { return (v + 1000) != 1010; },
+             DataType::INT8},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 102
+                    data_type: Int16
+                  >
+                  arith_op: Mul
+                  right_operand: <
+                    int64_val: 3
+                  >
+                  op: Equal
+                  value: <
+                    int64_val: 1000
+                  >
+             >)",
+             [](int16_t v) { return (v * 3) == 1000; },
+             DataType::INT16},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 102
+                    data_type: Int16
+                  >
+                  arith_op: Mul
+                  right_operand: <
+                    int64_val: -1
+                  >
+                  op: Equal
+                  value: <
+                    int64_val: 100
+                  >
+             >)",
+             [](int16_t v) { return v == -100; },
+             DataType::INT16},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 103
+                    data_type: Int32
+                  >
+                  arith_op: Div
+                  right_operand: <
+                    int64_val: -1
+                  >
+                  op: NotEqual
+                  value: <
+                    int64_val: 200
+                  >
+             >)",
+             [](int32_t v) { return v != -200; },
+             DataType::INT32},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 103
+                    data_type: Int32
+                  >
+                  arith_op: Div
+                  right_operand: <
+                    int64_val: 7
+                  >
+                  op: Equal
+                  value: <
+                    int64_val: -3
+                  >
+             >)",
+             [](int32_t v) { return (v / 7) == -3; },
+             DataType::INT32},
+            // a zero divisor matches no row
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 103
+                    data_type: Int32
+                  >
+                  arith_op: Mod
+                  right_operand: <
+                    int64_val: 0
+                  >
+                  op: NotEqual
+                  value: <
+                    int64_val: 1
+                  >
+             >)",
+             [](int32_t v) { return true; },
+             DataType::INT32},
+            {R"(binary_arith_op_eval_range_expr: <
+                  column_info: <
+                    field_id: 104
+                    data_type: Int64
+                  >
+                  arith_op: Div
+                  right_operand: <
+                    int64_val: 0
+                  >
+                  op: Equal
+                  value: <
+                    int64_val: 0
+                  >
+             >)",
+             [](int64_t v) { return false; },
+             DataType::INT64},
         };
 
     // std::string dsl_string_tmp = R"({
@@ -4065,6 +4347,1178 @@ TEST(Expr, TestExistsWithJSON) {
     }
 }
 
+TEST(Expr, TestJsonKeyColumn) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    // spans a few blocks of the zone maps, with the values of all kinds
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != json_fid.get()) {
+            continue;
+        }
+        auto json_data = field_data.mutable_scalars()->mutable_json_data();
+        for (int i = 0; i < N; ++i) {
+            std::string row;
+            switch (i % 7) {
+                case 0:
+                    row = fmt::format(
+                        R"({{"a": {}, "b": "s{}", "c": true}})", i, i);
+                    break;
+                case 1:
+                    row = fmt::format(
+                        R"({{"a": {}.5, "b": 10, "c": false}})", i);
+                    break;
+                case 2:
+                    row = R"({"a": "x"})";
+                    break;
+                case 3:
+                    row = "{}";
+                    break;
+                case 4:
+                    row = R"({"a": 100000000000000000000, "c": null})";
+                    break;
+                case 5:
+                    row = fmt::format(R"({{"a": -{}, "b": "t"}})", i);
+                    break;
+                default:
+                    row = R"({"a": [1, 2], "b": "s"})";
+                    break;
+            }
+            json_data->set_data(i, row);
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    // the columns configured before and after the json field is loaded
+    auto keyed_seg = CreateSealedSegment(schema);
+    keyed_seg->AddJsonKeyColumn(json_fid, "/a", DataType::INT64);
+    SealedLoadFieldData(raw_data, *keyed_seg);
+    keyed_seg->AddJsonKeyColumn(json_fid, "/b", DataType::VARCHAR);
+    keyed_seg->AddJsonKeyColumn(json_fid, "/c", DataType::BOOL);
+    auto mmap_seg = CreateSealedSegment(schema);
+    mmap_seg->AddJsonKeyColumn(json_fid, "/a", DataType::DOUBLE);
+    mmap_seg->AddJsonKeyColumn(json_fid, "/b", DataType::VARCHAR);
+    SealedLoadFieldData(raw_data, *mmap_seg, {}, true);
+    ASSERT_NE(keyed_seg->GetJsonKeyColumn(json_fid, "/a"), nullptr);
+    ASSERT_NE(keyed_seg->GetJsonKeyColumn(json_fid, "/c"), nullptr);
+    ASSERT_NE(mmap_seg->GetJsonKeyColumn(json_fid, "/b"), nullptr);
+
+    auto unary = [&](const std::string& key,
+                     proto::plan::OpType op,
+                     const proto::plan::GenericValue& val) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {key}), op, val);
+    };
+    auto int64_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto float_val = [](double v) {
+        proto::plan::GenericValue val;
+        val.set_float_val(v);
+        return val;
+    };
+    auto string_val = [](const std::string& v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto bool_val = [](bool v) {
+        proto::plan::GenericValue val;
+        val.set_bool_val(v);
+        return val;
+    };
+
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary("a", proto::plan::GreaterThan, int64_val(5000)),
+        unary("a", proto::plan::LessEqual, int64_val(100)),
+        unary("a", proto::plan::Equal, int64_val(7)),
+        unary("a", proto::plan::NotEqual, int64_val(7)),
+        unary("a", proto::plan::LessThan, int64_val(-20000)),
+        unary("a", proto::plan::GreaterEqual, float_val(2.5)),
+        unary("a", proto::plan::GreaterThan, float_val(1e19)),
+        unary("a", proto::plan::Equal, float_val(8.5)),
+        unary("a", proto::plan::NotEqual, float_val(8.5)),
+        unary("b", proto::plan::Equal, string_val("s7")),
+        unary("b", proto::plan::PrefixMatch, string_val("s1")),
+        unary("b", proto::plan::NotEqual, string_val("s")),
+        unary("b", proto::plan::GreaterThan, string_val("s5")),
+        unary("c", proto::plan::Equal, bool_val(true)),
+        unary("c", proto::plan::NotEqual, bool_val(false)),
+        std::make_shared<expr::ExistsExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {"a"})),
+        std::make_shared<expr::ExistsExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {"c"})),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(keyed_seg.get(), expr), ref) << expr->ToString();
+        EXPECT_EQ(execute(mmap_seg.get(), expr), ref) << expr->ToString();
+    }
+
+    // the extracted columns are dropped with the field
+    keyed_seg->DropFieldData(json_fid);
+    EXPECT_EQ(keyed_seg->GetJsonKeyColumn(json_fid, "/a"), nullptr);
+}
+
+TEST(Expr, TestJsonKeyColumnSkipBlocks) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    // a block of numbers only, one of missing keys and strings only, one of
+    // a single number, and one of numbers and missing keys
+    constexpr auto block_rows = JsonKeyColumn::BLOCK_ROWS;
+    int N = block_rows * 4;
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != json_fid.get()) {
+            continue;
+        }
+        auto json_data = field_data.mutable_scalars()->mutable_json_data();
+        for (int i = 0; i < N; ++i) {
+            std::string row;
+            switch (i / block_rows) {
+                case 0:
+                    row = fmt::format(R"({{"a": {}}})", i);
+                    break;
+                case 1:
+                    row = i % 2 == 0 ? "{}" : R"({"a": "x"})";
+                    break;
+                case 2:
+                    row = R"({"a": 7})";
+                    break;
+                default:
+                    row = i % 3 == 0 ? "{}" : fmt::format(R"({{"a": {}}})", i);
+                    break;
+            }
+            json_data->set_data(i, row);
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto keyed_seg = CreateSealedSegment(schema);
+    keyed_seg->AddJsonKeyColumn(json_fid, "/a", DataType::INT64);
+    SealedLoadFieldData(raw_data, *keyed_seg);
+    ASSERT_NE(keyed_seg->GetJsonKeyColumn(json_fid, "/a"), nullptr);
+
+    auto unary = [&](proto::plan::OpType op,
+                     const proto::plan::GenericValue& val) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {"a"}), op, val);
+    };
+    auto int64_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto float_val = [](double v) {
+        proto::plan::GenericValue val;
+        val.set_float_val(v);
+        return val;
+    };
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary(proto::plan::NotEqual, int64_val(7)),
+        unary(proto::plan::NotEqual, float_val(7)),
+        unary(proto::plan::NotEqual, int64_val(-1)),
+        unary(proto::plan::Equal, int64_val(7)),
+        unary(proto::plan::GreaterThan, int64_val(3 * block_rows)),
+        unary(proto::plan::LessThan, float_val(0)),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(keyed_seg.get(), expr), ref) << expr->ToString();
+    }
+    // the missing keys and the strings match NotEqual
+    auto ref = execute(keyed_seg.get(), exprs[0]);
+    for (int i = block_rows; i < 2 * block_rows; ++i) {
+        ASSERT_TRUE(ref[i]);
+    }
+}
+
+TEST(Expr, TestJsonBinaryEncoding) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    std::string text =
+        R"({"b": [1, 2.5, "x", {"c": null}], "a~/": "q\"\n", "a": 1, )"
+        R"("a": 2, "u": 18446744073709551615, "d": 1.0, "t": true})";
+    simdjson::padded_string padded(text);
+    std::string binary;
+    ASSERT_TRUE(BinaryJson::Encode(padded.data(), padded.size(), binary));
+    auto root = binary.data();
+    // the first of the duplicate keys is found
+    ASSERT_EQ(BinaryJson::Get<int64_t>(BinaryJson::Find(root, "/a")).value(),
+              1);
+    ASSERT_EQ(BinaryJson::Get<std::string_view>(
+                  BinaryJson::Find(root, "/a~0~1"))
+                  .value(),
+              "q\"\n");
+    ASSERT_EQ(BinaryJson::kind(BinaryJson::Find(root, "/b/3/c")),
+              BinaryJson::Null);
+    ASSERT_EQ(BinaryJson::Find(root, "/b/4"), nullptr);
+    ASSERT_EQ(BinaryJson::Find(root, "/b/01"), nullptr);
+    ASSERT_EQ(BinaryJson::Find(root, "/t/x"), nullptr);
+    ASSERT_EQ(BinaryJson::Get<double>(BinaryJson::Find(root, "/b/0")).value(),
+              1.0);
+    ASSERT_TRUE(
+        BinaryJson::Get<int64_t>(BinaryJson::Find(root, "/d")).error());
+    ASSERT_TRUE(
+        BinaryJson::Get<int64_t>(BinaryJson::Find(root, "/u")).error());
+    ASSERT_TRUE(
+        BinaryJson::Get<bool>(BinaryJson::Find(root, "/t")).value());
+    // the text is reconstructed with the keys in order
+    auto reconstructed = BinaryJson::ToString(root);
+    ASSERT_EQ(reconstructed,
+              R"({"a":1,"a":2,"a~/":"q\"\n","b":[1,2.5,"x",{"c":null}],)"
+              R"("d":1.0,"t":true,"u":18446744073709551615})");
+    simdjson::padded_string invalid(std::string("{\"a\": "));
+    ASSERT_FALSE(BinaryJson::Encode(invalid.data(), invalid.size(), binary));
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != json_fid.get()) {
+            continue;
+        }
+        auto json_data = field_data.mutable_scalars()->mutable_json_data();
+        for (int i = 0; i < N; ++i) {
+            std::string row;
+            switch (i % 5) {
+                case 0:
+                    row = fmt::format(
+                        R"({{"a": {}, "b": "s{}", "n": {{"x": [{}, 7]}}}})",
+                        i,
+                        i,
+                        i % 3);
+                    break;
+                case 1:
+                    row = fmt::format(
+                        R"({{"a": {}.5, "b": true, "n": {{"x": ["s", 1]}}}})",
+                        i);
+                    break;
+                case 2:
+                    row = R"({"a": 100000000000000000000, "n": null})";
+                    break;
+                case 3:
+                    row = R"({"a": "x", "a": 3, "n": {"x": [2, 1, 0]}})";
+                    break;
+                default:
+                    row = R"([1, {"a": 2}])";
+                    break;
+            }
+            json_data->set_data(i, row);
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto& config = SegcoreConfig::default_config();
+    config.set_json_binary_encoding(true);
+    auto binary_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *binary_seg);
+    config.set_json_binary_encoding(false);
+    auto json_views = binary_seg->chunk_data<Json>(json_fid, 0);
+    ASSERT_NE(json_views.data()[0].binary(), nullptr);
+
+    auto generic_val = [](auto v) {
+        proto::plan::GenericValue val;
+        if constexpr (std::is_same_v<decltype(v), int64_t>) {
+            val.set_int64_val(v);
+        } else if constexpr (std::is_same_v<decltype(v), double>) {
+            val.set_float_val(v);
+        } else if constexpr (std::is_same_v<decltype(v), bool>) {
+            val.set_bool_val(v);
+        } else {
+            val.set_string_val(v);
+        }
+        return val;
+    };
+    auto column = [&](std::vector<std::string> path) {
+        return expr::ColumnInfo(json_fid, DataType::JSON, path);
+    };
+    auto unary = [&](std::vector<std::string> path,
+                     proto::plan::OpType op,
+                     auto v) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            column(path), op, generic_val(v));
+    };
+    auto contains = [&](std::vector<std::string> path,
+                        proto::plan::JSONContainsExpr_JSONOp op,
+                        std::vector<int64_t> values) {
+        std::vector<proto::plan::GenericValue> vals;
+        for (auto v : values) {
+            vals.push_back(generic_val(v));
+        }
+        return std::make_shared<expr::JsonContainsExpr>(
+            column(path), op, true, vals);
+    };
+    auto any = proto::plan::JSONContainsExpr_JSONOp_ContainsAny;
+    auto all = proto::plan::JSONContainsExpr_JSONOp_ContainsAll;
+
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary({"a"}, proto::plan::GreaterThan, int64_t(500)),
+        unary({"a"}, proto::plan::Equal, int64_t(3)),
+        unary({"a"}, proto::plan::NotEqual, int64_t(3)),
+        unary({"a"}, proto::plan::GreaterEqual, 100.5),
+        unary({"a"}, proto::plan::GreaterThan, 1e19),
+        unary({"b"}, proto::plan::PrefixMatch, std::string("s1")),
+        unary({"b"}, proto::plan::Equal, true),
+        unary({"0"}, proto::plan::Equal, int64_t(1)),
+        unary({"1", "a"}, proto::plan::Equal, int64_t(2)),
+        std::make_shared<expr::ExistsExpr>(column({"n"})),
+        std::make_shared<expr::ExistsExpr>(column({"n", "x"})),
+        std::make_shared<expr::ExistsExpr>(column({"1"})),
+        contains({"n", "x"}, any, {1, 2}),
+        contains({"n", "x"}, any, {8}),
+        contains({"n", "x"}, all, {0, 7}),
+        contains({"n", "x"}, all, {}),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(binary_seg.get(), expr), ref) << expr->ToString();
+    }
+}
+
+TEST(Expr, TestStringDictionary) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto str_fid = schema->AddDebugField("category", DataType::VARCHAR);
+    auto unique_fid = schema->AddDebugField("unique", DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != str_fid.get()) {
+            continue;
+        }
+        auto str_data = field_data.mutable_scalars()->mutable_string_data();
+        for (int i = 0; i < N; ++i) {
+            auto str = i % 11 == 0 ? "" : fmt::format("c{}", i % 37);
+            str_data->set_data(i, str);
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto& config = SegcoreConfig::default_config();
+    config.set_dict_encode_ratio(0.01);
+    auto dict_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *dict_seg);
+    auto mmap_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *mmap_seg, {}, true);
+    config.set_dict_encode_ratio(0);
+
+    ASSERT_EQ(plain_seg->GetStringDictionary(str_fid), nullptr);
+    auto dict = dict_seg->GetStringDictionary(str_fid);
+    ASSERT_NE(dict, nullptr);
+    ASSERT_EQ(dict->values.size(), 38);
+    ASSERT_TRUE(std::is_sorted(dict->values.begin(), dict->values.end()));
+    // too many distinct strings, and the mapped fields aren't encoded
+    ASSERT_EQ(dict_seg->GetStringDictionary(unique_fid), nullptr);
+    ASSERT_EQ(mmap_seg->GetStringDictionary(str_fid), nullptr);
+
+    auto string_val = [](const std::string& v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto unary = [&](proto::plan::OpType op, const std::string& v) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(str_fid, DataType::VARCHAR), op, string_val(v));
+    };
+    auto term = [&](const std::vector<std::string>& values) {
+        std::vector<proto::plan::GenericValue> vals;
+        for (auto& v : values) {
+            vals.push_back(string_val(v));
+        }
+        return std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(str_fid, DataType::VARCHAR), vals);
+    };
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary(proto::plan::Equal, "c7"),
+        unary(proto::plan::Equal, "c70"),
+        unary(proto::plan::Equal, ""),
+        unary(proto::plan::NotEqual, "c7"),
+        unary(proto::plan::NotEqual, "missing"),
+        unary(proto::plan::GreaterThan, "c3"),
+        unary(proto::plan::GreaterEqual, "c3"),
+        unary(proto::plan::LessThan, "c25"),
+        unary(proto::plan::LessEqual, "c2"),
+        unary(proto::plan::LessThan, ""),
+        unary(proto::plan::GreaterThan, "d"),
+        unary(proto::plan::PrefixMatch, "c1"),
+        unary(proto::plan::PrefixMatch, "c"),
+        unary(proto::plan::PrefixMatch, "x"),
+        unary(proto::plan::PostfixMatch, "3"),
+        unary(proto::plan::Match, "c%1"),
+        unary(proto::plan::Match, "%3%"),
+        unary(proto::plan::Match, "c_"),
+        term({"c1", "c36", "", "missing"}),
+        term({"missing"}),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(dict_seg.get(), expr), ref) << expr->ToString();
+        EXPECT_EQ(execute(mmap_seg.get(), expr), ref) << expr->ToString();
+    }
+
+    // the rows are decoded on retrieve, the mapped rows are read by the
+    // offsets mapped beside them
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto ref = plain_seg->bulk_subscript(str_fid, offsets.data(), N);
+    auto res = dict_seg->bulk_subscript(str_fid, offsets.data(), N);
+    auto mmap_res = mmap_seg->bulk_subscript(unique_fid, offsets.data(), N);
+    auto& ref_data = ref->scalars().string_data().data();
+    auto& res_data = res->scalars().string_data().data();
+    auto& mmap_data = mmap_res->scalars().string_data().data();
+    auto unique_data = raw_data.get_col<std::string>(unique_fid);
+    ASSERT_EQ(res_data.size(), N);
+    ASSERT_EQ(mmap_data.size(), N);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(res_data[i], ref_data[i]);
+        ASSERT_EQ(mmap_data[i], unique_data[i]);
+    }
+}
+
+TEST(Expr, TestPackedColumn) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto i8_fid = schema->AddDebugField("age8", DataType::INT8);
+    auto i16_fid = schema->AddDebugField("age16", DataType::INT16);
+    auto i32_fid = schema->AddDebugField("age32", DataType::INT32);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto wide_fid = schema->AddDebugField("wide", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+    std::mt19937_64 rng(42);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        auto fid = FieldId(field_data.field_id());
+        auto scalars = field_data.mutable_scalars();
+        for (int i = 0; i < N; ++i) {
+            if (fid == i8_fid) {
+                scalars->mutable_int_data()->set_data(i, i % 4 - 2);
+            } else if (fid == i16_fid) {
+                // constant runs
+                scalars->mutable_int_data()->set_data(i, i / 2048 * 7);
+            } else if (fid == i32_fid) {
+                scalars->mutable_int_data()->set_data(i, rng() % 1000);
+            } else if (fid == i64_fid) {
+                // sorted with small steps
+                scalars->mutable_long_data()->set_data(
+                    i, (int64_t(1) << 40) + i * 3 + rng() % 3);
+            } else if (fid == wide_fid) {
+                scalars->mutable_long_data()->set_data(i, rng());
+            }
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto& config = SegcoreConfig::default_config();
+    config.set_pack_ratio(0.5);
+    auto packed_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *packed_seg);
+    config.set_pack_ratio(0);
+
+    std::vector<FieldId> packed_fids = {i8_fid, i16_fid, i32_fid, i64_fid};
+    for (auto fid : packed_fids) {
+        ASSERT_EQ(plain_seg->GetPackedColumn(fid), nullptr);
+        ASSERT_NE(packed_seg->GetPackedColumn(fid), nullptr);
+    }
+    // the primary key isn't packed, and the random rows take no less space
+    ASSERT_EQ(packed_seg->GetPackedColumn(pk_fid), nullptr);
+    ASSERT_EQ(packed_seg->GetPackedColumn(wide_fid), nullptr);
+
+    auto int64_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto data_type = [&](FieldId fid) {
+        return schema->operator[](fid).get_data_type();
+    };
+    auto unary = [&](FieldId fid, proto::plan::OpType op, int64_t v) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(fid, data_type(fid)), op, int64_val(v));
+    };
+    auto term = [&](FieldId fid, const std::vector<int64_t>& values) {
+        std::vector<proto::plan::GenericValue> vals;
+        for (auto v : values) {
+            vals.push_back(int64_val(v));
+        }
+        return std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(fid, data_type(fid)), vals);
+    };
+    auto binary = [&](FieldId fid, int64_t lower, int64_t upper) {
+        return std::make_shared<expr::BinaryRangeFilterExpr>(
+            expr::ColumnInfo(fid, data_type(fid)),
+            int64_val(lower),
+            int64_val(upper),
+            true,
+            false);
+    };
+    auto base = int64_t(1) << 40;
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary(i8_fid, proto::plan::Equal, -1),
+        unary(i8_fid, proto::plan::LessThan, 0),
+        unary(i16_fid, proto::plan::GreaterEqual, 14),
+        unary(i16_fid, proto::plan::NotEqual, 0),
+        unary(i32_fid, proto::plan::LessEqual, 500),
+        unary(i64_fid, proto::plan::GreaterThan, base + 15000),
+        term(i8_fid, {-2, 1, 5}),
+        term(i16_fid, {7, 28}),
+        term(i32_fid, {0, 1, 999}),
+        binary(i32_fid, 100, 200),
+        binary(i64_fid, base + 3000, base + 9000),
+        // the packed columns compared with each other and with a plain one
+        std::make_shared<expr::CompareExpr>(i16_fid,
+                                            i32_fid,
+                                            DataType::INT16,
+                                            DataType::INT32,
+                                            proto::plan::LessThan),
+        std::make_shared<expr::CompareExpr>(i8_fid,
+                                            wide_fid,
+                                            DataType::INT8,
+                                            DataType::INT64,
+                                            proto::plan::NotEqual),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(packed_seg.get(), expr), ref) << expr->ToString();
+    }
+    // the filters decode a batch of rows at a time, the columns are kept
+    // packed
+    for (auto fid : packed_fids) {
+        auto packed = packed_seg->GetPackedColumn(fid);
+        EXPECT_EQ(packed->MemoryByteSize(), packed->PackedByteSize());
+    }
+
+    // the rows are unpacked on retrieve
+    std::vector<int64_t> offsets;
+    for (int i = N - 1; i >= 0; i -= 3) {
+        offsets.push_back(i);
+    }
+    auto count = static_cast<int64_t>(offsets.size());
+    for (auto fid : packed_fids) {
+        auto ref = plain_seg->bulk_subscript(fid, offsets.data(), count);
+        auto res = packed_seg->bulk_subscript(fid, offsets.data(), count);
+        ASSERT_EQ(res->scalars().DebugString(), ref->scalars().DebugString());
+    }
+}
+
+TEST(Expr, TestJsonInvertedIndex) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    std::vector<std::string> rows;
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != json_fid.get()) {
+            continue;
+        }
+        auto json_data = field_data.mutable_scalars()->mutable_json_data();
+        for (int i = 0; i < N; ++i) {
+            std::string row;
+            switch (i % 8) {
+                case 0:
+                    row = fmt::format(
+                        R"({{"a": {}, "b": "s{}", "c": true}})", i % 10, i);
+                    break;
+                case 1:
+                    row = fmt::format(R"({{"a": {}.0, "b": 7, "c": false}})",
+                                      i % 10);
+                    break;
+                case 2:
+                    row = R"({"a": 2.5, "b": ["s1", "s2"], "arr": [1, 2.0]})";
+                    break;
+                case 3:
+                    row = R"({"a": 3, "a": 4, "x/y": "z", "arr": [3, true]})";
+                    break;
+                case 4:
+                    row = R"({"a": 100000000000000000000, "c": null})";
+                    break;
+                case 5:
+                    row = R"({"a": -0.0, "arr": [[1], {"d": 1}, "s1"]})";
+                    break;
+                case 6:
+                    row = R"({"a": {"d": 1}, "arr": [1, 2, 3]})";
+                    break;
+                default:
+                    row = "{}";
+                    break;
+            }
+            json_data->set_data(i, row);
+            rows.push_back(row);
+        }
+    }
+
+    std::vector<Json> jsons;
+    for (auto& row : rows) {
+        jsons.emplace_back(simdjson::padded_string(row));
+    }
+    index::JsonInvertedIndex built;
+    built.Build(jsons.size(), jsons.data());
+    auto binary_set = built.Serialize({});
+    auto json_index = std::make_unique<index::JsonInvertedIndex>();
+    json_index->Load(binary_set);
+    ASSERT_EQ(json_index->Count(), N);
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto indexed_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *indexed_seg);
+    LoadIndexInfo load_info;
+    load_info.field_id = json_fid.get();
+    load_info.index = std::move(json_index);
+    indexed_seg->LoadIndex(load_info);
+    ASSERT_NE(indexed_seg->GetJsonIndex(json_fid), nullptr);
+
+    auto generic_val = [](auto v) {
+        proto::plan::GenericValue val;
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            val.set_bool_val(v);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            val.set_int64_val(v);
+        } else if constexpr (std::is_same_v<T, double>) {
+            val.set_float_val(v);
+        } else {
+            val.set_string_val(v);
+        }
+        return val;
+    };
+    auto unary = [&](const std::string& key, proto::plan::OpType op, auto v) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {key}),
+            op,
+            generic_val(v));
+    };
+    auto term = [&](const std::string& key, auto... vs) {
+        std::vector<proto::plan::GenericValue> vals{generic_val(vs)...};
+        return std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {key}), vals);
+    };
+    auto contains = [&](const std::string& key,
+                        proto::plan::JSONContainsExpr_JSONOp op,
+                        auto... vs) {
+        std::vector<proto::plan::GenericValue> vals{generic_val(vs)...};
+        return std::make_shared<expr::JsonContainsExpr>(
+            expr::ColumnInfo(json_fid, DataType::JSON, {key}), op, true, vals);
+    };
+    auto any = proto::plan::JSONContainsExpr_JSONOp_ContainsAny;
+    auto all = proto::plan::JSONContainsExpr_JSONOp_ContainsAll;
+
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary("a", proto::plan::Equal, int64_t(3)),
+        unary("a", proto::plan::Equal, int64_t(0)),
+        unary("a", proto::plan::NotEqual, int64_t(3)),
+        unary("a", proto::plan::Equal, 2.5),
+        unary("a", proto::plan::Equal, 4.0),
+        unary("a", proto::plan::Equal, -0.0),
+        unary("a", proto::plan::Equal, 1e20),
+        unary("b", proto::plan::Equal, std::string("s8")),
+        unary("b", proto::plan::NotEqual, std::string("s8")),
+        unary("b", proto::plan::Equal, int64_t(7)),
+        unary("c", proto::plan::Equal, true),
+        unary("c", proto::plan::NotEqual, false),
+        unary("x/y", proto::plan::Equal, std::string("z")),
+        unary("arr", proto::plan::Equal, int64_t(1)),
+        term("a", int64_t(1), int64_t(3), int64_t(5)),
+        term("a", 2.5, 6.0),
+        term("b", std::string("s1"), std::string("s16")),
+        term("c", false),
+        contains("arr", any, int64_t(1), int64_t(3)),
+        contains("arr", any, 2.0),
+        contains("arr", any, true),
+        contains("arr", any, std::string("s1")),
+        contains("b", any, std::string("s2")),
+        contains("arr", all, int64_t(1), int64_t(2)),
+        contains("arr", all, 1.0, 2.0, 3.0),
+        contains("b", all, std::string("s1"), std::string("s2")),
+    };
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(indexed_seg.get(), expr), ref) << expr->ToString();
+    }
+
+    indexed_seg->DropIndex(json_fid);
+    EXPECT_EQ(indexed_seg->GetJsonIndex(json_fid), nullptr);
+}
+
+TEST(Expr, TestArrayInvertedIndex) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto int_array_fid =
+        schema->AddDebugField("int_array", DataType::ARRAY, DataType::INT32);
+    auto long_array_fid =
+        schema->AddDebugField("long_array", DataType::ARRAY, DataType::INT64);
+    auto bool_array_fid =
+        schema->AddDebugField("bool_array", DataType::ARRAY, DataType::BOOL);
+    auto float_array_fid =
+        schema->AddDebugField("float_array", DataType::ARRAY, DataType::FLOAT);
+    auto string_array_fid = schema->AddDebugField(
+        "string_array", DataType::ARRAY, DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = 1000;
+    auto raw_data = DataGen(schema, N, 42, 0, 1, 3);
+    std::vector<FieldId> array_fids = {int_array_fid,
+                                       long_array_fid,
+                                       bool_array_fid,
+                                       float_array_fid,
+                                       string_array_fid};
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    auto indexed_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *indexed_seg);
+    std::unordered_map<FieldId, std::vector<Array>> arrays;
+    for (auto fid : array_fids) {
+        auto col = raw_data.get_col<ScalarArray>(fid);
+        auto& rows = arrays[fid];
+        for (auto& row : col) {
+            rows.emplace_back(row);
+        }
+        index::ArrayInvertedIndex built;
+        built.Build(rows.size(), rows.data());
+        auto binary_set = built.Serialize({});
+        auto array_index = std::make_unique<index::ArrayInvertedIndex>();
+        array_index->Load(binary_set);
+        ASSERT_EQ(array_index->Count(), N);
+
+        LoadIndexInfo load_info;
+        load_info.field_id = fid.get();
+        load_info.index = std::move(array_index);
+        indexed_seg->LoadIndex(load_info);
+        ASSERT_NE(indexed_seg->GetArrayIndex(fid), nullptr);
+    }
+
+    auto generic_val = [](auto v) {
+        proto::plan::GenericValue val;
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            val.set_bool_val(v);
+        } else if constexpr (std::is_integral_v<T>) {
+            val.set_int64_val(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            val.set_float_val(v);
+        } else {
+            val.set_string_val(v);
+        }
+        return val;
+    };
+    // the values of the elements of the first rows, so that the filters
+    // match some of the rows
+    auto element = [&](FieldId fid, auto v, int row, int pos) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            return generic_val(
+                std::string(arrays[fid][row].get_data<std::string_view>(pos)));
+        } else {
+            return generic_val(arrays[fid][row].get_data<T>(pos));
+        }
+    };
+    auto contains = [&](FieldId fid,
+                        proto::plan::JSONContainsExpr_JSONOp op,
+                        std::vector<proto::plan::GenericValue> vals) {
+        return std::make_shared<expr::JsonContainsExpr>(
+            expr::ColumnInfo(fid, DataType::ARRAY), op, true, vals);
+    };
+    auto any = proto::plan::JSONContainsExpr_JSONOp_ContainsAny;
+    auto all = proto::plan::JSONContainsExpr_JSONOp_ContainsAll;
+
+    std::vector<expr::TypedExprPtr> exprs;
+    for (auto op : {any, all}) {
+        exprs.push_back(contains(int_array_fid,
+                                 op,
+                                 {element(int_array_fid, int64_t(0), 0, 0),
+                                  element(int_array_fid, int64_t(0), 0, 1)}));
+        exprs.push_back(contains(long_array_fid,
+                                 op,
+                                 {element(long_array_fid, int64_t(0), 1, 2),
+                                  element(long_array_fid, int64_t(0), 2, 0),
+                                  generic_val(int64_t(-1))}));
+        exprs.push_back(contains(bool_array_fid, op, {generic_val(true)}));
+        exprs.push_back(contains(
+            bool_array_fid, op, {generic_val(true), generic_val(false)}));
+        exprs.push_back(contains(float_array_fid,
+                                 op,
+                                 {element(float_array_fid, double(0), 0, 0),
+                                  element(float_array_fid, double(0), 3, 1)}));
+        exprs.push_back(
+            contains(string_array_fid,
+                     op,
+                     {element(string_array_fid, std::string(), 0, 0),
+                      element(string_array_fid, std::string(), 0, 2)}));
+        // the index doesn't serve a double on an int array, the rows are
+        // scanned
+        exprs.push_back(contains(
+            long_array_fid, op, {element(long_array_fid, double(0), 0, 0)}));
+    }
+
+    auto execute = [&](const SegmentSealed* seg,
+                       const expr::TypedExprPtr& expr) {
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg, final);
+        return final;
+    };
+    for (auto& expr : exprs) {
+        auto ref = execute(plain_seg.get(), expr);
+        EXPECT_EQ(ref.size(), N);
+        EXPECT_EQ(execute(indexed_seg.get(), expr), ref) << expr->ToString();
+    }
+
+    for (auto fid : array_fids) {
+        indexed_seg->DropIndex(fid);
+        EXPECT_EQ(indexed_seg->GetArrayIndex(fid), nullptr);
+    }
+}
+
+TEST(Expr, TestSkipIndexZoneMaps) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    // the int64 fields are generated as the offsets, like a time ordered field
+    auto ts_fid = schema->AddDebugField("ts", DataType::INT64);
+    auto double_fid = schema->AddDebugField("double", DataType::DOUBLE);
+    schema->set_primary_field_id(i64_fid);
+
+    constexpr auto block_rows = SkipIndex::BLOCK_ROWS;
+    int N = block_rows * 3 + 100;
+    auto raw_data = DataGen(schema, N);
+    std::vector<double> doubles(N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != double_fid.get()) {
+            continue;
+        }
+        auto data = field_data.mutable_scalars()->mutable_double_data();
+        for (int i = 0; i < N; ++i) {
+            // the second block holds NaN
+            doubles[i] = (i / block_rows == 1 && i % 7 == 0) ? NAN : i;
+            data->set_data(i, doubles[i]);
+        }
+    }
+    auto seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *seg);
+
+    auto& skip_index = seg->GetSkipIndex();
+    ASSERT_EQ(skip_index.NumBlocks(ts_fid, 0), 4);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<int64_t>(
+                  ts_fid, 0, 0, proto::plan::GreaterThan, 5000),
+              BlockMatch::None);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<int64_t>(
+                  ts_fid, 0, 0, proto::plan::LessThan, 5000),
+              BlockMatch::All);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<int64_t>(
+                  ts_fid, 0, 1, proto::plan::LessThan, 5000),
+              BlockMatch::Some);
+    EXPECT_EQ(skip_index.BinaryRangeBlockMatch<int64_t>(
+                  ts_fid, 0, 2, int64_t(0), int64_t(N), true, false),
+              BlockMatch::All);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<double>(
+                  double_fid, 0, 0, proto::plan::GreaterEqual, 0.0),
+              BlockMatch::All);
+    // NaN is never greater or equal
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<double>(
+                  double_fid, 0, 1, proto::plan::GreaterEqual, 0.0),
+              BlockMatch::Some);
+
+    auto generic_val = [](auto v) {
+        proto::plan::GenericValue val;
+        if constexpr (std::is_same_v<decltype(v), int64_t>) {
+            val.set_int64_val(v);
+        } else {
+            val.set_float_val(v);
+        }
+        return val;
+    };
+    auto unary = [&](FieldId fid, proto::plan::OpType op, auto v) {
+        auto data_type = fid == ts_fid ? DataType::INT64 : DataType::DOUBLE;
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(fid, data_type), op, generic_val(v));
+    };
+    auto binary = [&](FieldId fid, auto lower, auto upper) {
+        auto data_type = fid == ts_fid ? DataType::INT64 : DataType::DOUBLE;
+        return std::make_shared<expr::BinaryRangeFilterExpr>(
+            expr::ColumnInfo(fid, data_type),
+            generic_val(lower),
+            generic_val(upper),
+            true,
+            false);
+    };
+    std::vector<std::pair<expr::TypedExprPtr, std::function<bool(int)>>>
+        testcases = {
+            {unary(ts_fid, proto::plan::GreaterThan, int64_t(5000)),
+             [](int i) { return i > 5000; }},
+            {unary(ts_fid, proto::plan::LessEqual, int64_t(block_rows)),
+             [](int i) { return i <= block_rows; }},
+            {unary(ts_fid, proto::plan::Equal, int64_t(9000)),
+             [](int i) { return i == 9000; }},
+            {unary(ts_fid, proto::plan::NotEqual, int64_t(9000)),
+             [](int i) { return i != 9000; }},
+            {binary(ts_fid, int64_t(100), int64_t(block_rows * 3)),
+             [=](int i) { return i >= 100 && i < block_rows * 3; }},
+            {unary(double_fid, proto::plan::GreaterEqual, 0.0),
+             [&](int i) { return doubles[i] >= 0; }},
+            {unary(double_fid, proto::plan::NotEqual, 0.0),
+             [&](int i) { return doubles[i] != 0; }},
+            {binary(double_fid, 0.0, double(N)),
+             [&](int i) { return doubles[i] >= 0 && doubles[i] < N; }},
+        };
+
+    query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+    for (auto& [expr, check] : testcases) {
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg.get(), final);
+        ASSERT_EQ(final.size(), N);
+        for (int i = 0; i < N; ++i) {
+            ASSERT_EQ(final[i], check(i)) << expr->ToString() << " @" << i;
+        }
+    }
+}
+
+TEST(Expr, TestSkipIndexDistinctValues) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    // the partition keys of the segment, few distinct values per chunk
+    auto key_fid = schema->AddDebugField("key", DataType::INT64);
+    auto str_key_fid = schema->AddDebugField("str_key", DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = SkipIndex::BLOCK_ROWS * 2 + 100;
+    auto raw_data = DataGen(schema, N);
+    std::vector<int64_t> keys(N);
+    std::vector<std::string> str_keys(N);
+    for (int i = 0; i < N; ++i) {
+        keys[i] = 10 + i % 3;
+        str_keys[i] = i % 2 == 0 ? "a" : "b";
+    }
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() == key_fid.get()) {
+            auto data = field_data.mutable_scalars()->mutable_long_data();
+            for (int i = 0; i < N; ++i) {
+                data->set_data(i, keys[i]);
+            }
+        } else if (field_data.field_id() == str_key_fid.get()) {
+            auto data = field_data.mutable_scalars()->mutable_string_data();
+            for (int i = 0; i < N; ++i) {
+                data->set_data(i, str_keys[i]);
+            }
+        }
+    }
+    auto seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *seg);
+
+    auto& skip_index = seg->GetSkipIndex();
+    std::vector<int64_t> all_keys = {10, 11, 12, 13};
+    std::vector<int64_t> some_keys = {11};
+    std::vector<int64_t> no_keys = {9, 13};
+    EXPECT_EQ(skip_index.TermBlockMatch<int64_t>(key_fid, 0, 0, all_keys),
+              BlockMatch::All);
+    EXPECT_EQ(skip_index.TermBlockMatch<int64_t>(key_fid, 0, 1, some_keys),
+              BlockMatch::Some);
+    EXPECT_EQ(skip_index.TermBlockMatch<int64_t>(key_fid, 0, 2, no_keys),
+              BlockMatch::None);
+    EXPECT_TRUE(skip_index.CanSkipTerm<int64_t>(key_fid, 0, no_keys));
+    EXPECT_FALSE(skip_index.CanSkipTerm<int64_t>(key_fid, 0, some_keys));
+    // the pks are of high cardinality
+    EXPECT_EQ(skip_index.TermBlockMatch<int64_t>(i64_fid, 0, 0, all_keys),
+              BlockMatch::Some);
+    std::vector<std::string> str_values = {"a", "b"};
+    EXPECT_EQ(skip_index.TermBlockMatch<std::string_view>(
+                  str_key_fid, 0, 0, str_values),
+              BlockMatch::All);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<std::string_view>(
+                  str_key_fid, 0, 0, proto::plan::NotEqual, "c"),
+              BlockMatch::All);
+    EXPECT_EQ(skip_index.UnaryRangeBlockMatch<std::string_view>(
+                  str_key_fid, 0, 0, proto::plan::Equal, "a"),
+              BlockMatch::Some);
+
+    auto int_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto str_val = [](const std::string& v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto term = [&](FieldId fid,
+                    DataType data_type,
+                    std::vector<proto::plan::GenericValue> values) {
+        return std::make_shared<expr::TermFilterExpr>(
+            expr::ColumnInfo(fid, data_type), values);
+    };
+    std::vector<std::pair<expr::TypedExprPtr, std::function<bool(int)>>>
+        testcases = {
+            {term(key_fid,
+                  DataType::INT64,
+                  {int_val(10), int_val(11), int_val(12)}),
+             [](int i) { return true; }},
+            {term(key_fid, DataType::INT64, {int_val(10), int_val(12)}),
+             [&](int i) { return keys[i] != 11; }},
+            {term(key_fid, DataType::INT64, {int_val(13)}),
+             [](int i) { return false; }},
+            {term(str_key_fid, DataType::VARCHAR, {str_val("a"), str_val("b")}),
+             [](int i) { return true; }},
+            {term(str_key_fid, DataType::VARCHAR, {str_val("b")}),
+             [&](int i) { return str_keys[i] == "b"; }},
+            {std::make_shared<expr::UnaryRangeFilterExpr>(
+                 expr::ColumnInfo(key_fid, DataType::INT64),
+                 proto::plan::NotEqual,
+                 int_val(13)),
+             [](int i) { return true; }},
+        };
+
+    query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+    for (auto& [expr, check] : testcases) {
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan, seg.get(), final);
+        ASSERT_EQ(final.size(), N);
+        for (int i = 0; i < N; ++i) {
+            ASSERT_EQ(final[i], check(i)) << expr->ToString() << " @" << i;
+        }
+    }
+}
+
 template <typename T>
 struct Testcase {
     std::vector<T> term;
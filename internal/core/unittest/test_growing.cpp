@@ -11,8 +11,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
 #include "common/Types.h"
 #include "knowhere/comp/index_param.h"
+#include "query/Plan.h"
+#include "segcore/SearchCoalescer.h"
+#include "segcore/SearchIterator.h"
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "pb/schema.pb.h"
@@ -236,3 +244,394 @@ TEST(Growing, FillData) {
                   num_inserted);
     }
 }
+
+TEST(Growing, SkipIndex) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("int32", DataType::INT32);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    schema->set_primary_field_id(pk);
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(100);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta, -1, config);
+
+    // pk is the offset of the row, int32 is 1000 + pk and string is "s{pk}"
+    int64_t N = 250;
+    auto dataset = DataGen(schema, N);
+    for (auto& field_data : *dataset.raw_->mutable_fields_data()) {
+        if (field_data.field_id() == i32_fid.get()) {
+            auto data = field_data.mutable_scalars()->mutable_int_data();
+            for (int i = 0; i < N; ++i) {
+                data->set_data(i, 1000 + i);
+            }
+        } else if (field_data.field_id() == str_fid.get()) {
+            auto data = field_data.mutable_scalars()->mutable_string_data();
+            for (int i = 0; i < N; ++i) {
+                data->set_data(i, "s" + std::to_string(i));
+            }
+        }
+    }
+    auto offset = segment->PreInsert(N);
+    segment->Insert(offset,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    auto& skip_index = segment->GetSkipIndex();
+    ASSERT_TRUE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk, 0, OpType::Equal, 120));
+    ASSERT_FALSE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk, 1, OpType::Equal, 120));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<int32_t>(
+        i32_fid, 1, OpType::LessThan, 1100));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<std::string>(
+        str_fid, 0, OpType::Equal, "s150"));
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<std::string>(
+        str_fid, 1, OpType::Equal, "s150"));
+    ASSERT_TRUE(skip_index.CanSkipTerm<int64_t>(
+        pk, 0, std::vector<int64_t>{-1, 100, 150}));
+    ASSERT_FALSE(skip_index.CanSkipTerm<int64_t>(
+        pk, 1, std::vector<int64_t>{-1, 100, 150}));
+    ASSERT_TRUE(skip_index.CanSkipCompare<int64_t, int32_t>(
+        pk, i32_fid, 0, OpType::GreaterEqual));
+    ASSERT_FALSE(skip_index.CanSkipCompare<int64_t, int32_t>(
+        pk, i32_fid, 0, OpType::LessThan));
+    // the chunk filling is never skipped
+    ASSERT_FALSE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk, 2, OpType::Equal, 500));
+
+    // the second insert fills the last chunk, whose pks are [200, 250) and
+    // [0, 50)
+    auto more = DataGen(schema, 100);
+    offset = segment->PreInsert(100);
+    segment->Insert(offset,
+                    100,
+                    more.row_ids_.data(),
+                    more.timestamps_.data(),
+                    more.raw_);
+    ASSERT_TRUE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk, 2, OpType::Equal, 500));
+    ASSERT_FALSE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk, 2, OpType::Equal, 10));
+}
+
+TEST(Growing, InsertArrow) {
+    auto schema = std::make_shared<Schema>();
+    auto int64_field = schema->AddDebugField("int64", DataType::INT64);
+    auto varchar_field = schema->AddDebugField("varchar", DataType::VARCHAR);
+    auto json_field = schema->AddDebugField("json", DataType::JSON);
+    int64_t dim = 16;
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    schema->set_primary_field_id(int64_field);
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta, 1, config);
+
+    int64_t num_rows = 3000;
+    arrow::Int64Builder int64_builder;
+    arrow::StringBuilder varchar_builder;
+    arrow::BinaryBuilder json_builder;
+    arrow::FixedSizeBinaryBuilder vec_builder(
+        arrow::fixed_size_binary(dim * sizeof(float)));
+    std::vector<float> vector(dim);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        ASSERT_TRUE(int64_builder.Append(i).ok());
+        ASSERT_TRUE(varchar_builder.Append(std::to_string(i)).ok());
+        ASSERT_TRUE(
+            json_builder.Append(fmt::format("{{\"key\": {}}}", i)).ok());
+        std::fill(vector.begin(), vector.end(), float(i));
+        ASSERT_TRUE(vec_builder
+                        .Append(reinterpret_cast<const uint8_t*>(
+                            vector.data()))
+                        .ok());
+    }
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    auto add_column = [&](FieldId field_id, arrow::ArrayBuilder& builder) {
+        std::shared_ptr<arrow::Array> array;
+        ASSERT_TRUE(builder.Finish(&array).ok());
+        fields.push_back(
+            arrow::field(std::to_string(field_id.get()), array->type()));
+        arrays.push_back(array);
+    };
+    add_column(int64_field, int64_builder);
+    add_column(varchar_field, varchar_builder);
+    add_column(json_field, json_builder);
+    add_column(vec, vec_builder);
+    auto batch =
+        arrow::RecordBatch::Make(arrow::schema(fields), num_rows, arrays);
+
+    std::vector<int64_t> row_ids(num_rows);
+    std::iota(row_ids.begin(), row_ids.end(), 0);
+    std::vector<Timestamp> timestamps(num_rows, 1);
+    auto offset = segment->PreInsert(num_rows);
+    segment->Insert(
+        offset, num_rows, row_ids.data(), timestamps.data(), *batch);
+    ASSERT_EQ(segment->get_row_count(), num_rows);
+
+    std::vector<int64_t> offsets(num_rows);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto int64_result =
+        segment->bulk_subscript(int64_field, offsets.data(), num_rows);
+    auto varchar_result =
+        segment->bulk_subscript(varchar_field, offsets.data(), num_rows);
+    auto json_result =
+        segment->bulk_subscript(json_field, offsets.data(), num_rows);
+    auto vec_result = segment->bulk_subscript(vec, offsets.data(), num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(int64_result->scalars().long_data().data(i), i);
+        ASSERT_EQ(varchar_result->scalars().string_data().data(i),
+                  std::to_string(i));
+        ASSERT_EQ(json_result->scalars().json_data().data(i),
+                  fmt::format("{{\"key\": {}}}", i));
+        ASSERT_EQ(vec_result->vectors().float_vector().data(i * dim + dim - 1),
+                  float(i));
+    }
+    ASSERT_TRUE(segment->Contain(PkType(int64_t(num_rows - 1))));
+}
+
+TEST(Growing, SearchIterator) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    segment->PreInsert(N);
+    segment->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    auto make_plan = [&](int64_t topk) {
+        auto raw_plan = fmt::format(R"(vector_anns: <
+                                    field_id: 100
+                                    predicates: <
+                                      unary_range_expr: <
+                                        column_info: <
+                                          field_id: 101
+                                          data_type: Int64
+                                        >
+                                        op: GreaterEqual
+                                        value: <
+                                          int64_val: 100
+                                        >
+                                      >
+                                    >
+                                    query_info: <
+                                      topk: {}
+                                      round_decimal: -1
+                                      metric_type: "L2"
+                                      search_params: "{{\"nprobe\": 10}}"
+                                    >
+                                    placeholder_tag: "$0"
+        >)",
+                                    topk);
+        auto plan_str = translate_text_plan_to_binary_plan(raw_plan.c_str());
+        return query::CreateSearchPlanByExpr(
+            *schema, plan_str.data(), plan_str.size());
+    };
+    auto ph_group_raw = CreatePlaceholderGroup(1, dim, 1024);
+    auto full_plan = make_plan(100);
+    auto ph_group = query::ParsePlaceholderGroup(
+        full_plan.get(), ph_group_raw.SerializeAsString());
+    auto full = segment->Search(full_plan.get(), ph_group.get());
+
+    auto plan = make_plan(10);
+    auto& segment_internal = dynamic_cast<SegmentInternalInterface&>(*segment);
+    SearchIterator iterator(segment_internal, *plan, *ph_group);
+    ASSERT_EQ(iterator.remaining(), N - 100);
+    std::vector<int64_t> offsets;
+    for (int i = 0; i < 4; ++i) {
+        auto batch = iterator.Next(25);
+        ASSERT_EQ(batch->seg_offsets_.size(), 25);
+        offsets.insert(offsets.end(),
+                       batch->seg_offsets_.begin(),
+                       batch->seg_offsets_.end());
+    }
+    ASSERT_EQ(offsets, full->seg_offsets_);
+    ASSERT_EQ(iterator.remaining(), N - 200);
+
+    // the rows are exhausted
+    auto rest = iterator.Next(N);
+    auto num_valid = std::count_if(rest->seg_offsets_.begin(),
+                                   rest->seg_offsets_.end(),
+                                   [](int64_t offset) {
+                                       return offset != INVALID_SEG_OFFSET;
+                                   });
+    ASSERT_EQ(num_valid, N - 200);
+    ASSERT_EQ(iterator.remaining(), 0);
+
+    auto& manager = SearchIteratorManager::GetInstance();
+    auto id = manager.Add(
+        std::make_unique<SearchIterator>(segment_internal, *plan, *ph_group),
+        1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(manager.Get(id), nullptr);
+    id = manager.Add(
+        std::make_unique<SearchIterator>(segment_internal, *plan, *ph_group),
+        0);
+    ASSERT_NE(manager.Get(id), nullptr);
+    manager.Remove(id);
+    ASSERT_EQ(manager.Get(id), nullptr);
+}
+
+TEST(Growing, CoalesceSearches) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    segment->PreInsert(N);
+    segment->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    const char* raw_plan = R"(vector_anns: <
+                                    field_id: 100
+                                    predicates: <
+                                      unary_range_expr: <
+                                        column_info: <
+                                          field_id: 101
+                                          data_type: Int64
+                                        >
+                                        op: GreaterEqual
+                                        value: <
+                                          int64_val: 100
+                                        >
+                                      >
+                                    >
+                                    query_info: <
+                                      topk: 10
+                                      round_decimal: -1
+                                      metric_type: "L2"
+                                      search_params: "{\"nprobe\": 10}"
+                                    >
+                                    placeholder_tag: "$0"
+        >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    constexpr int num_searches = 4;
+    std::vector<std::unique_ptr<query::Plan>> plans;
+    std::vector<std::unique_ptr<query::PlaceholderGroup>> ph_groups;
+    std::vector<std::unique_ptr<SearchResult>> expected;
+    for (int i = 0; i < num_searches; ++i) {
+        plans.push_back(query::CreateSearchPlanByExpr(
+            *schema, plan_str.data(), plan_str.size()));
+        auto ph_group_raw = CreatePlaceholderGroup(1, dim, 1024 + i);
+        ph_groups.push_back(query::ParsePlaceholderGroup(
+            plans.back().get(), ph_group_raw.SerializeAsString()));
+        expected.push_back(
+            segment->Search(plans.back().get(), ph_groups.back().get()));
+    }
+
+    // the batch is searched once it has all the queries
+    auto& coalescer = SearchCoalescer::GetInstance();
+    coalescer.SetWindow(std::chrono::seconds(1), num_searches);
+    auto coalesced_count = coalescer.coalesced_count();
+    std::vector<std::unique_ptr<SearchResult>> results(num_searches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_searches; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = coalescer.Search(
+                *segment, plans[i].get(), ph_groups[i].get());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindow(std::chrono::microseconds(0), 0);
+
+    ASSERT_EQ(coalescer.coalesced_count() - coalesced_count,
+              num_searches - 1);
+    for (int i = 0; i < num_searches; ++i) {
+        ASSERT_EQ(results[i]->total_nq_, 1);
+        ASSERT_EQ(results[i]->unity_topK_, expected[i]->unity_topK_);
+        ASSERT_EQ(results[i]->seg_offsets_, expected[i]->seg_offsets_);
+        ASSERT_EQ(results[i]->distances_, expected[i]->distances_);
+    }
+}
+
+TEST(Growing, CoalesceAdaptiveSearches) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    segment->PreInsert(N);
+    segment->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    const char* raw_plan = R"(vector_anns: <
+                                    field_id: 100
+                                    query_info: <
+                                      topk: 10
+                                      round_decimal: -1
+                                      metric_type: "L2"
+                                      search_params: "{\"nprobe\": 10, \"adaptive_search\": {\"nprobe\": 2}}"
+                                    >
+                                    placeholder_tag: "$0"
+        >)";
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    constexpr int num_searches = 4;
+    std::vector<std::unique_ptr<query::Plan>> plans;
+    std::vector<std::unique_ptr<query::PlaceholderGroup>> ph_groups;
+    for (int i = 0; i < num_searches; ++i) {
+        plans.push_back(query::CreateSearchPlanByExpr(
+            *schema, plan_str.data(), plan_str.size()));
+        auto ph_group_raw = CreatePlaceholderGroup(1, dim, 1024 + i);
+        ph_groups.push_back(query::ParsePlaceholderGroup(
+            plans.back().get(), ph_group_raw.SerializeAsString()));
+    }
+
+    // the searches on the segment took far over the target recently, the
+    // effort adapted for the batch is reported by all of its searches
+    auto& config = SegcoreConfig::default_config();
+    config.set_adaptive_search_latency_target_ms(1);
+    segment->full_effort_search_latency().Observe(1000 * 1000);
+    auto& coalescer = SearchCoalescer::GetInstance();
+    coalescer.SetWindow(std::chrono::seconds(1), num_searches);
+    auto coalesced_count = coalescer.coalesced_count();
+    std::vector<std::unique_ptr<SearchResult>> results(num_searches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_searches; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = coalescer.Search(
+                *segment, plans[i].get(), ph_groups[i].get());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindow(std::chrono::microseconds(0), 0);
+    config.set_adaptive_search_latency_target_ms(0);
+
+    ASSERT_EQ(coalescer.coalesced_count() - coalesced_count,
+              num_searches - 1);
+    std::map<std::string, int64_t> adapted = {{"nprobe", 2}};
+    for (int i = 0; i < num_searches; ++i) {
+        ASSERT_EQ(results[i]->total_nq_, 1);
+        ASSERT_EQ(results[i]->adapted_search_params_, adapted);
+    }
+}
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <set>
 
 #include "pb/plan.pb.h"
 #include "segcore/SegmentGrowing.h"
@@ -125,6 +126,163 @@ TEST(GrowingIndex, Correctness) {
     }
 }
 
+TEST(GrowingIndex, Quantized) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+
+    std::map<std::string, std::string> index_params = {
+        {"index_type", "IVF_FLAT"}, {"metric_type", "L2"}, {"nlist", "128"}};
+    std::map<std::string, std::string> type_params = {{"dim", "128"}};
+    FieldIndexMeta fieldIndexMeta(
+        vec, std::move(index_params), std::move(type_params));
+    auto& config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    config.set_enable_interim_segment_index(true);
+    config.set_interim_index_quantization("SQ8");
+    std::map<FieldId, FieldIndexMeta> filedMap = {{vec, fieldIndexMeta}};
+    IndexMetaPtr metaPtr =
+        std::make_shared<CollectionIndexMeta>(226985, std::move(filedMap));
+    auto segment = CreateGrowingSegment(schema, metaPtr);
+    auto segmentImplPtr = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(milvus::proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(vec.get());
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(5);
+    query_info->set_round_decimal(-1);
+    query_info->set_metric_type("l2");
+    query_info->set_search_params(R"({"nprobe": 128})");
+    auto plan_str = plan_node.SerializeAsString();
+    auto plan = milvus::query::CreateSearchPlanByExpr(
+        *schema, plan_str.data(), plan_str.size());
+
+    int64_t per_batch = 10000;
+    int64_t n_batch = 3;
+    int64_t top_k = 5;
+    for (int64_t i = 0; i < n_batch; i++) {
+        auto dataset = DataGen(schema, per_batch, 42 + i);
+        auto offset = segment->PreInsert(per_batch);
+        segment->Insert(offset,
+                        per_batch,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+        auto filed_data = segmentImplPtr->get_insert_record()
+                              .get_field_data<milvus::FloatVector>(vec);
+
+        // the quantized index doesn't hold the raw data, the chunks are kept
+        auto inserted = (i + 1) * per_batch;
+        EXPECT_EQ(filed_data->num_chunk(),
+                  upper_div(inserted, filed_data->get_size_per_chunk()));
+        EXPECT_TRUE(segment->HasRawData(vec.get()));
+
+        // the distances are reranked by the raw vectors, so the inserted
+        // vectors hit themselves exactly
+        auto num_queries = 5;
+        auto vectors = dataset.get_col<float>(vec);
+        auto ph_group_raw =
+            CreatePlaceholderGroupFromBlob(num_queries, 128, vectors.data());
+        auto ph_group =
+            ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        auto sr = segment->Search(plan.get(), ph_group.get());
+        ASSERT_EQ(sr->total_nq_, num_queries);
+        ASSERT_EQ(sr->unity_topK_, top_k);
+        for (int q = 0; q < num_queries; q++) {
+            EXPECT_EQ(sr->seg_offsets_[q * top_k], offset + q);
+            EXPECT_FLOAT_EQ(sr->distances_[q * top_k], 0);
+            for (int k = 1; k < top_k; k++) {
+                EXPECT_LE(sr->distances_[q * top_k + k - 1],
+                          sr->distances_[q * top_k + k]);
+            }
+        }
+    }
+    config.set_interim_index_quantization("");
+}
+
+TEST(GrowingIndex, QuantizedUnalignedCursor) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+
+    std::map<std::string, std::string> index_params = {
+        {"index_type", "IVF_FLAT"}, {"metric_type", "L2"}, {"nlist", "128"}};
+    std::map<std::string, std::string> type_params = {{"dim", "128"}};
+    FieldIndexMeta fieldIndexMeta(
+        vec, std::move(index_params), std::move(type_params));
+    auto& config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    config.set_enable_interim_segment_index(true);
+    config.set_interim_index_quantization("SQ8");
+    std::map<FieldId, FieldIndexMeta> filedMap = {{vec, fieldIndexMeta}};
+    IndexMetaPtr metaPtr =
+        std::make_shared<CollectionIndexMeta>(226985, std::move(filedMap));
+    auto segment = CreateGrowingSegment(schema, metaPtr);
+    auto segmentImplPtr = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(milvus::proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(vec.get());
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(5);
+    query_info->set_round_decimal(-1);
+    query_info->set_metric_type("l2");
+    query_info->set_search_params(R"({"nprobe": 128})");
+    auto plan_str = plan_node.SerializeAsString();
+    auto plan = milvus::query::CreateSearchPlanByExpr(
+        *schema, plan_str.data(), plan_str.size());
+
+    // the first batch passes the build threshold, the batches leave the
+    // cursor of the index off a multiple of 8, the rows past the last
+    // multiple of 8 are brute forced
+    std::vector<int64_t> batches = {30003, 6};
+    int64_t top_k = 5;
+    int64_t num_queries = 3;
+    for (size_t i = 0; i < batches.size(); i++) {
+        auto per_batch = batches[i];
+        auto dataset = DataGen(schema, per_batch, 42 + i);
+        auto offset = segment->PreInsert(per_batch);
+        segment->Insert(offset,
+                        per_batch,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+        auto& field_indexing =
+            segmentImplPtr->get_indexing_record().get_vec_field_indexing(vec);
+        ASSERT_EQ(field_indexing.get_index_cursor(), offset + per_batch);
+        ASSERT_NE(field_indexing.get_index_cursor() % 8, 0);
+
+        // the last rows inserted hit themselves
+        auto vectors = dataset.get_col<float>(vec);
+        auto first = per_batch - num_queries;
+        auto ph_group_raw = CreatePlaceholderGroupFromBlob(
+            num_queries, 128, vectors.data() + first * 128);
+        auto ph_group =
+            ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        auto sr = segment->Search(plan.get(), ph_group.get());
+        ASSERT_EQ(sr->total_nq_, num_queries);
+        for (int q = 0; q < num_queries; q++) {
+            EXPECT_EQ(sr->seg_offsets_[q * top_k], offset + first + q);
+            EXPECT_FLOAT_EQ(sr->distances_[q * top_k], 0);
+            // no row is returned twice by the index and the brute force
+            std::set<int64_t> offsets(
+                sr->seg_offsets_.begin() + q * top_k,
+                sr->seg_offsets_.begin() + (q + 1) * top_k);
+            EXPECT_EQ(offsets.size(), top_k);
+        }
+    }
+    config.set_interim_index_quantization("");
+}
+
 TEST(GrowingIndex, MissIndexMeta) {
     auto schema = std::make_shared<Schema>();
     auto pk = schema->AddDebugField("pk", DataType::INT64);
@@ -139,6 +297,67 @@ TEST(GrowingIndex, MissIndexMeta) {
     auto segment = CreateGrowingSegment(schema, nullptr);
 }
 
+TEST(GrowingIndex, KeepIndexedChunks) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+
+    std::map<std::string, std::string> index_params = {
+        {"index_type", "IVF_FLAT"}, {"metric_type", "L2"}, {"nlist", "128"}};
+    std::map<std::string, std::string> type_params = {{"dim", "128"}};
+    FieldIndexMeta fieldIndexMeta(
+        vec, std::move(index_params), std::move(type_params));
+    auto& config = SegcoreConfig::default_config();
+    config.set_chunk_rows(1024);
+    config.set_enable_interim_segment_index(true);
+    config.set_drop_interim_indexed_chunks(false);
+    std::map<FieldId, FieldIndexMeta> filedMap = {{vec, fieldIndexMeta}};
+    IndexMetaPtr metaPtr =
+        std::make_shared<CollectionIndexMeta>(100000, std::move(filedMap));
+    auto segment_growing = CreateGrowingSegment(schema, metaPtr);
+    // latched by the segment created
+    config.set_drop_interim_indexed_chunks(true);
+    auto segment = dynamic_cast<SegmentGrowingImpl*>(segment_growing.get());
+
+    int64_t per_batch = 5000;
+    int64_t n_batch = 4;
+    int64_t dim = 128;
+    std::vector<float> vectors;
+    for (int64_t i = 0; i < n_batch; i++) {
+        auto dataset = DataGen(schema, per_batch, 42 + i);
+        auto fakevec = dataset.get_col<float>(vec);
+        vectors.insert(vectors.end(), fakevec.begin(), fakevec.end());
+        auto offset = segment->PreInsert(per_batch);
+        segment->Insert(offset,
+                        per_batch,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+    }
+    auto& indexing_record = segment->get_indexing_record();
+    ASSERT_TRUE(indexing_record.SyncDataWithIndex(vec));
+    ASSERT_FALSE(indexing_record.RawDataHeldByIndex(vec));
+    auto field_data =
+        segment->get_insert_record().get_field_data<milvus::FloatVector>(vec);
+    auto num_inserted = per_batch * n_batch;
+    EXPECT_EQ(field_data->num_chunk(),
+              upper_div(num_inserted, field_data->get_size_per_chunk()));
+
+    // the vectors are served by the chunks
+    auto ids_ds = GenRandomIds(num_inserted);
+    auto result = segment->bulk_subscript(vec, ids_ds->GetIds(), num_inserted);
+    auto& vector = result->vectors().float_vector().data();
+    ASSERT_EQ(vector.size(), num_inserted * dim);
+    for (int64_t i = 0; i < num_inserted; ++i) {
+        auto id = ids_ds->GetIds()[i];
+        for (int64_t j = 0; j < dim; ++j) {
+            ASSERT_EQ(vector[i * dim + j], vectors[id * dim + j]);
+        }
+    }
+}
+
 using Param = const char*;
 
 class GrowingIndexGetVectorTest : public ::testing::TestWithParam<Param> {
@@ -16,7 +16,9 @@
 
 #include "indexbuilder/index_c.h"
 #include "test_utils/indexbuilder_test_utils.h"
+#include "test_utils/storage_test_utils.h"
 #include "indexbuilder/ScalarIndexCreator.h"
+#include "index/ScalarIndexSort.h"
 #include "common/type_c.h"
 
 constexpr int NB = 10;
@@ -318,3 +320,91 @@ TEST(CStringIndexTest, All) {
     delete[] (char*)(str_ds->GetTensor());
 }
 #endif
+
+TEST(CreateIndexes, Int64) {
+    auto storage_config = get_default_local_storage_config();
+    auto chunk_manager = milvus::storage::CreateChunkManager(storage_config);
+    CStorageConfig c_storage_config{};
+    c_storage_config.root_path = storage_config.root_path.c_str();
+    c_storage_config.storage_type = storage_config.storage_type.c_str();
+
+    indexcgo::IndexParams index_params;
+    auto index_type = index_params.add_params();
+    index_type->set_key("index_type");
+    index_type->set_value(milvus::index::ASCENDING_SORT);
+    std::string index_params_str;
+    ASSERT_TRUE(index_params.SerializeToString(&index_params_str));
+
+    // an index per segment of the same field
+    constexpr int64_t num_indexes = 3;
+    auto field_meta =
+        milvus::FieldMeta(milvus::FieldName("int64"),
+                          milvus::FieldId(100),
+                          milvus::DataType::INT64);
+    std::vector<std::string> insert_files;
+    std::vector<CBuildIndexInfo> infos;
+    for (int64_t i = 0; i < num_indexes; ++i) {
+        milvus::storage::FieldDataMeta field_data_meta{1, 2, 3 + i, 100};
+        auto arr = GenArr<int64_t>(NB * (i + 1));
+        auto file = std::string(TestRemotePath) + "/create_indexes/" +
+                    std::to_string(i);
+        PutFieldData(chunk_manager.get(),
+                     {reinterpret_cast<const uint8_t*>(arr.data())},
+                     {static_cast<int64_t>(arr.size())},
+                     {file},
+                     field_data_meta,
+                     field_meta);
+        insert_files.push_back(file);
+
+        CBuildIndexInfo info;
+        auto status = NewBuildIndexInfo(&info, c_storage_config);
+        ASSERT_EQ(milvus::Success, status.error_code);
+        infos.push_back(info);
+        status = AppendFieldMetaInfo(info, 1, 2, 3 + i, 100, Int64);
+        ASSERT_EQ(milvus::Success, status.error_code);
+        status = AppendIndexMetaInfo(info, 1000, 2000 + i, 1);
+        ASSERT_EQ(milvus::Success, status.error_code);
+        status = AppendInsertFilePath(info, file.c_str());
+        ASSERT_EQ(milvus::Success, status.error_code);
+        if (i < num_indexes - 1) {
+            status = AppendBuildIndexParam(
+                info,
+                reinterpret_cast<const uint8_t*>(index_params_str.data()),
+                index_params_str.size());
+            ASSERT_EQ(milvus::Success, status.error_code);
+        }
+    }
+
+    // the indexes built at the same time are in the order of the infos
+    std::vector<CIndex> indexes(num_indexes - 1, nullptr);
+    auto status =
+        CreateIndexes(indexes.data(), infos.data(), num_indexes - 1);
+    ASSERT_EQ(milvus::Success, status.error_code);
+    for (int64_t i = 0; i < num_indexes - 1; ++i) {
+        auto creator =
+            static_cast<milvus::indexbuilder::IndexCreatorBase*>(indexes[i]);
+        ASSERT_NE(creator, nullptr);
+        auto index = milvus::index::CreateScalarIndexSort<int64_t>();
+        index->Load(creator->Serialize());
+        ASSERT_EQ(index->Count(), NB * (i + 1));
+        status = DeleteIndex(indexes[i]);
+        ASSERT_EQ(milvus::Success, status.error_code);
+    }
+
+    // none of the indexes is returned once any of them fails, the last info
+    // has no index type
+    indexes.assign(num_indexes, nullptr);
+    status = CreateIndexes(indexes.data(), infos.data(), num_indexes);
+    ASSERT_NE(milvus::Success, status.error_code);
+    free(const_cast<char*>(status.error_msg));
+    for (auto index : indexes) {
+        ASSERT_EQ(index, nullptr);
+    }
+
+    for (auto info : infos) {
+        DeleteBuildIndexInfo(info);
+    }
+    for (auto& file : insert_files) {
+        chunk_manager->Remove(file);
+    }
+}
@@ -15,8 +15,10 @@
 #include <tuple>
 
 #include "common/Types.h"
+#include "indexbuilder/BuildResource.h"
 #include "indexbuilder/IndexFactory.h"
 #include "indexbuilder/VecIndexCreator.h"
+#include "index/Meta.h"
 #include "common/QueryResult.h"
 #include "test_utils/indexbuilder_test_utils.h"
 #include "test_utils/storage_test_utils.h"
@@ -182,3 +184,49 @@ TEST_P(IndexWrapperTest, BuildAndQuery) {
         EXPECT_EQ(result->seg_offsets_[0], query_offset);
     }
 }
+
+TEST(IndexWrapper, EstimateBuildResource) {
+    using milvus::indexbuilder::EstimateBuildResource;
+    int64_t num_rows = 100000;
+    int64_t dim = 128;
+    auto raw_size = num_rows * dim * int64_t(sizeof(float));
+
+    Config ivf_config = {
+        {"index_type", knowhere::IndexEnum::INDEX_FAISS_IVFFLAT},
+        {knowhere::indexparam::NLIST, "1024"}};
+    auto ivf = EstimateBuildResource(
+        DataType::VECTOR_FLOAT, ivf_config, num_rows, dim);
+    // the index holds the rows and is serialized into a copy, the rows are
+    // staged to disk
+    EXPECT_GE(ivf.memory_size, 2 * raw_size);
+    EXPECT_EQ(ivf.disk_size, raw_size);
+    auto ivf_double = EstimateBuildResource(
+        DataType::VECTOR_FLOAT, ivf_config, 2 * num_rows, dim);
+    EXPECT_GT(ivf_double.memory_size, ivf.memory_size);
+
+    Config sq8_config = {
+        {"index_type", knowhere::IndexEnum::INDEX_FAISS_IVFSQ8},
+        {knowhere::indexparam::NLIST, "1024"}};
+    auto sq8 = EstimateBuildResource(
+        DataType::VECTOR_FLOAT, sq8_config, num_rows, dim);
+    EXPECT_LT(sq8.memory_size, ivf.memory_size);
+
+    Config diskann_config = {
+        {"index_type", knowhere::IndexEnum::INDEX_DISKANN},
+        {milvus::index::DISK_ANN_MAX_DEGREE, "56"},
+        {milvus::index::DISK_ANN_PQ_CODE_BUDGET, "0.001"}};
+    auto diskann = EstimateBuildResource(
+        DataType::VECTOR_FLOAT, diskann_config, num_rows, dim);
+    EXPECT_GT(diskann.disk_size, 2 * raw_size);
+    EXPECT_GT(diskann.memory_size, raw_size);
+
+    Config sort_config = {{"index_type", milvus::index::ASCENDING_SORT}};
+    auto sort =
+        EstimateBuildResource(DataType::INT64, sort_config, num_rows, 0);
+    EXPECT_GT(sort.memory_size, num_rows * int64_t(sizeof(int64_t)));
+    EXPECT_EQ(sort.disk_size, 0);
+
+    Config trie_config = {{"index_type", milvus::index::MARISA_TRIE}};
+    EXPECT_ANY_THROW(
+        EstimateBuildResource(DataType::VARCHAR, trie_config, num_rows, 0));
+}
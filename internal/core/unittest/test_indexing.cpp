@@ -16,13 +16,17 @@
 #include <boost/filesystem/operations.hpp>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "arrow/type.h"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/Types.h"
+#include "index/DiskSearchScheduler.h"
 #include "index/Index.h"
 #include "knowhere/comp/index_param.h"
 #include "nlohmann/json.hpp"
@@ -31,6 +35,7 @@
 #include "index/IndexFactory.h"
 #include "common/QueryResult.h"
 #include "segcore/Types.h"
+#include "storage/LocalChunkManagerSingleton.h"
 #include "storage/options.h"
 #include "test_utils/indexbuilder_test_utils.h"
 #include "test_utils/storage_test_utils.h"
@@ -504,6 +509,144 @@ TEST_P(IndexTest, Mmap) {
     vec_index->Query(xq_dataset, search_info, nullptr);
 }
 
+TEST_P(IndexTest, StagedLoad) {
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.index_type = index_type;
+    create_index_info.metric_type = metric_type;
+    create_index_info.field_type = vec_field_data_type;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+    index::IndexBasePtr index;
+
+    milvus::storage::FieldDataMeta field_data_meta{1, 2, 3, 100};
+    milvus::storage::IndexMeta index_meta{3, 100, 1000, 1};
+    auto chunk_manager = milvus::storage::CreateChunkManager(storage_config_);
+    milvus::storage::FileManagerContext file_manager_context(
+        field_data_meta, index_meta, chunk_manager);
+    index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+
+    ASSERT_NO_THROW(index->BuildWithDataset(xb_dataset, build_conf));
+    auto binary_set = index->Upload();
+    index.reset();
+
+    auto new_index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+    if (!new_index->IsMmapSupported()) {
+        return;
+    }
+    auto vec_index = dynamic_cast<milvus::index::VectorIndex*>(new_index.get());
+
+    std::vector<std::string> index_files;
+    for (auto& binary : binary_set.binary_map_) {
+        index_files.emplace_back(binary.first);
+    }
+    // the index is read into memory through the staged file, which is
+    // removed once loaded
+    auto filepath = "stage/test_index_stage_" + index_type;
+    load_conf = generate_load_conf(index_type, metric_type, 0);
+    load_conf["index_files"] = index_files;
+    load_conf[kLoadFilepath] = filepath;
+    vec_index->Load(load_conf);
+    EXPECT_FALSE(boost::filesystem::exists(filepath));
+    EXPECT_EQ(vec_index->Count(), NB);
+    EXPECT_EQ(vec_index->GetDim(), DIM);
+
+    milvus::SearchInfo search_info;
+    search_info.topk_ = K;
+    search_info.metric_type_ = metric_type;
+    search_info.search_params_ = search_conf;
+    auto result = vec_index->Query(xq_dataset, search_info, nullptr);
+    EXPECT_EQ(result->total_nq_, NQ);
+    EXPECT_EQ(result->unity_topK_, K);
+    EXPECT_EQ(result->distances_.size(), NQ * K);
+    EXPECT_EQ(result->seg_offsets_.size(), NQ * K);
+    if (!is_binary) {
+        EXPECT_EQ(result->seg_offsets_[0], query_offset);
+    }
+}
+
+TEST_P(IndexTest, BuildFromInsertFiles) {
+    if (is_binary || index_type == knowhere::IndexEnum::INDEX_DISKANN) {
+        return;
+    }
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.index_type = index_type;
+    create_index_info.metric_type = metric_type;
+    create_index_info.field_type = vec_field_data_type;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+
+    milvus::storage::FieldDataMeta field_data_meta{1, 2, 3, 100};
+    milvus::storage::IndexMeta index_meta{3, 100, 1000, 1};
+    auto chunk_manager = milvus::storage::CreateChunkManager(storage_config_);
+    milvus::storage::FileManagerContext file_manager_context(
+        field_data_meta, index_meta, chunk_manager);
+
+    // the rows are split into two binlogs, streamed into the build in order
+    // of their log ids
+    auto field_meta = milvus::FieldMeta(milvus::FieldName("fakevec"),
+                                        milvus::FieldId(100),
+                                        vec_field_data_type,
+                                        DIM,
+                                        metric_type);
+    auto half = NB / 2;
+    auto prefix = "/tmp/build_from_insert_files/" + index_type + "/";
+    std::vector<std::string> insert_files = {prefix + "2", prefix + "1"};
+    PutFieldData(chunk_manager.get(),
+                 {reinterpret_cast<const uint8_t*>(xb_data.data() + half * DIM),
+                  reinterpret_cast<const uint8_t*>(xb_data.data())},
+                 {NB - half, half},
+                 insert_files,
+                 field_data_meta,
+                 field_meta);
+
+    // the build input is staged in a local file or copied on the heap
+    auto local_chunk_manager =
+        milvus::storage::LocalChunkManagerSingleton::GetInstance()
+            .GetChunkManager();
+    auto staged_path = milvus::storage::GenFieldRawDataPathPrefix(
+                           local_chunk_manager, 3, 100) +
+                       "raw_data_1000";
+    auto stage = milvus::STAGE_VECTOR_BUILD_INPUT;
+    for (auto stage_build_input : {false, true}) {
+        milvus::STAGE_VECTOR_BUILD_INPUT = stage_build_input;
+        auto index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+            create_index_info, file_manager_context);
+        auto conf = build_conf;
+        conf["insert_files"] = insert_files;
+        ASSERT_NO_THROW(index->Build(conf));
+        auto vec_index =
+            dynamic_cast<milvus::index::VectorIndex*>(index.get());
+        EXPECT_EQ(vec_index->Count(), NB);
+        EXPECT_EQ(vec_index->GetDim(), DIM);
+        EXPECT_FALSE(boost::filesystem::exists(staged_path));
+
+        milvus::SearchInfo search_info;
+        search_info.topk_ = K;
+        search_info.metric_type_ = metric_type;
+        search_info.search_params_ = search_conf;
+        auto result = vec_index->Query(xq_dataset, search_info, nullptr);
+        EXPECT_EQ(result->seg_offsets_[0], query_offset);
+    }
+
+    // the staged file is removed once a download fails
+    {
+        auto index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+            create_index_info, file_manager_context);
+        auto conf = build_conf;
+        conf["insert_files"] =
+            std::vector<std::string>{insert_files[0], prefix + "missing"};
+        ASSERT_ANY_THROW(index->Build(conf));
+        EXPECT_FALSE(boost::filesystem::exists(staged_path));
+    }
+    milvus::STAGE_VECTOR_BUILD_INPUT = stage;
+
+    for (auto& file : insert_files) {
+        chunk_manager->Remove(file);
+    }
+}
+
 TEST_P(IndexTest, GetVector) {
     milvus::index::CreateIndexInfo create_index_info;
     create_index_info.index_type = index_type;
@@ -914,3 +1057,45 @@ TEST_P(IndexTestV2, BuildAndQuery) {
     search_info.search_params_ = range_search_conf;
     vec_index->Query(xq_dataset, search_info, nullptr);
 }
+
+TEST(Indexing, DiskSearchScheduler) {
+    using Permit = milvus::index::DiskSearchScheduler::Permit;
+    auto& scheduler = milvus::index::DiskSearchScheduler::GetInstance();
+    scheduler.SetCapacity(2, 1);
+    EXPECT_EQ(scheduler.BatchSize(5), 1);
+
+    std::mutex mutex;
+    std::vector<int64_t> admitted;
+    std::vector<std::thread> threads;
+    {
+        auto first = std::make_unique<Permit>(scheduler.Acquire(1, 1));
+        auto second = scheduler.Acquire(1, 1);
+        EXPECT_EQ(scheduler.InFlight(), 2);
+
+        // two searches of segment 1 queued before one of segment 2
+        for (int64_t segment_id : {1, 1, 2}) {
+            auto depth = scheduler.QueueDepth();
+            threads.emplace_back([&, segment_id] {
+                auto permit = scheduler.Acquire(segment_id, 1);
+                std::lock_guard<std::mutex> lock(mutex);
+                admitted.push_back(segment_id);
+            });
+            while (scheduler.QueueDepth() == depth) {
+                std::this_thread::yield();
+            }
+        }
+        EXPECT_EQ(scheduler.QueueDepth(), 3);
+
+        // one slot is freed, the segments are admitted in turn
+        first.reset();
+        while (scheduler.QueueDepth() > 0 || scheduler.InFlight() > 1) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(admitted, (std::vector<int64_t>{1, 2, 1}));
+    EXPECT_EQ(scheduler.InFlight(), 0);
+    scheduler.SetCapacity(0, 0);
+}
@@ -10,10 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <exception>
+#include <thread>
 
 #include "config/ConfigKnowhere.h"
 #include "gtest/gtest-death-test.h"
+#include "arrow/util/thread_pool.h"
+#include "common/Common.h"
+#include "storage/ThreadPool.h"
 #include "segcore/segcore_init_c.h"
 #include "test_utils/DataGen.h"
 
@@ -37,3 +42,29 @@ TEST(Init, KnowhereThreadPoolInit) {
 #endif
     milvus::config::KnowhereInitSearchThreadPool(8);
 }
+
+TEST(Init, CpuConcurrency) {
+    using namespace milvus::segcore;
+    auto cpu_num = milvus::CPU_NUM;
+    auto cpu_concurrency = milvus::CPU_CONCURRENCY;
+    auto arrow_capacity = arrow::GetCpuThreadPoolCapacity();
+    SegcoreSetCpuConcurrency(4);
+    ASSERT_EQ(milvus::CPU_NUM, 4);
+    ASSERT_EQ(milvus::CPU_CONCURRENCY, 4);
+    ASSERT_EQ(arrow::GetCpuThreadPoolCapacity(), 4);
+    {
+        // the pools created afterwards are bounded by the concurrency
+        milvus::ThreadPool pool(16, "test_cpu_concurrency");
+        ASSERT_EQ(pool.GetMaxThreadNum(), 4);
+    }
+    ASSERT_ANY_THROW(SegcoreSetCpuConcurrency(0));
+
+    // restore the globals and the pools of knowhere and arrow, which are
+    // sized by the cores by default
+    milvus::SetCpuNum(cpu_num);
+    milvus::SetCpuConcurrency(cpu_concurrency);
+    auto num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    milvus::config::KnowhereInitBuildThreadPool(num_threads);
+    milvus::config::KnowhereInitSearchThreadPool(num_threads);
+    ASSERT_TRUE(arrow::SetCpuThreadPoolCapacity(arrow_capacity).ok());
+}
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "storage/LocalChunkManagerSingleton.h"
+#include "storage/Util.h"
 
 using namespace std;
 using namespace milvus;
@@ -218,6 +219,67 @@ TEST_F(LocalChunkManagerTest, ReadOffset) {
     EXPECT_EQ(exist, false);
 }
 
+TEST_F(LocalChunkManagerTest, ReadByteRanges) {
+    auto lcm = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    string test_dir = lcm->GetRootPath() + "/local-test-dir";
+
+    string file = test_dir + "/test-read-byte-ranges";
+    lcm->CreateFile(file);
+    std::vector<uint8_t> data(256);
+    for (int i = 0; i < data.size(); i++) {
+        data[i] = i;
+    }
+    lcm->Write(file, data.data(), data.size());
+
+    // unordered and overlapping ranges
+    std::vector<ByteRange> ranges{{200, 8}, {0, 4}, {2, 4}, {16, 8}, {100, 0}};
+    auto merged = CoalesceByteRanges(ranges, 10);
+    EXPECT_EQ(merged.size(), 2);
+    EXPECT_EQ(merged[0].offset, 0);
+    EXPECT_EQ(merged[0].size, 24);
+    EXPECT_EQ(merged[1].offset, 200);
+    EXPECT_EQ(merged[1].size, 8);
+    EXPECT_EQ(CoalesceByteRanges(ranges, 0).size(), 3);
+
+    uint8_t read_data[24];
+    ReadByteRanges(lcm.get(), file, ranges, read_data, 10);
+    int pos = 0;
+    for (const auto& range : ranges) {
+        for (int i = 0; i < range.size; i++) {
+            EXPECT_EQ(read_data[pos++], data[range.offset + i]);
+        }
+    }
+
+    lcm->RemoveDir(test_dir);
+    auto exist = lcm->DirExist(test_dir);
+    EXPECT_EQ(exist, false);
+}
+
+TEST_F(LocalChunkManagerTest, OpenWriter) {
+    auto lcm = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    string test_dir = lcm->GetRootPath() + "/local-test-dir";
+
+    string file = test_dir + "/test-open-writer";
+    lcm->CreateFile(file);
+    uint8_t data[] = {0x17, 0x32, 0x00, 0x34, 0x23, 0x23, 0x87, 0x98};
+    auto writer = lcm->OpenWriter(file);
+    writer->Write(data, 3);
+    writer->Write(data + 3, sizeof(data) - 3);
+    writer->Close();
+    EXPECT_EQ(lcm->Size(file), sizeof(data));
+
+    uint8_t read_data[20];
+    auto size = lcm->Read(file, read_data, 20);
+    EXPECT_EQ(size, sizeof(data));
+    for (int i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(read_data[i], data[i]);
+    }
+
+    lcm->RemoveDir(test_dir);
+    auto exist = lcm->DirExist(test_dir);
+    EXPECT_EQ(exist, false);
+}
+
 TEST_F(LocalChunkManagerTest, GetSizeOfDir) {
     auto lcm = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
     auto test_dir = lcm->GetRootPath() + "/local-test-dir";
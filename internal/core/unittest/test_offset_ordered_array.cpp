@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <random>
+#include "common/Common.h"
 #include "segcore/InsertRecord.h"
 
 using namespace milvus;
@@ -103,5 +104,148 @@ TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_first) {
     ASSERT_EQ(0, offsets.size());
 }
 
-REGISTER_TYPED_TEST_CASE_P(TypedOffsetOrderedArrayTest, find_first);
+TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_batch) {
+    // insert the duplicated pks across the blocks of the search layout
+    int num = 1000;
+    auto data = this->random_generate(num / 4);
+    for (int i = 0; i < num; i++) {
+        this->insert(data[i % data.size()]);
+    }
+    this->seal();
+
+    std::vector<PkType> pks;
+    for (const auto& x : data) {
+        pks.emplace_back(x);
+    }
+    for (const auto& x : this->random_generate(100)) {
+        pks.emplace_back(x);
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> expected;
+    for (int64_t i = 0; i < pks.size(); i++) {
+        auto offsets = this->map_.find(pks[i]);
+        auto count = std::count(this->data_.begin(),
+                                this->data_.end(),
+                                std::get<TypeParam>(pks[i]));
+        ASSERT_EQ(offsets.size(), count);
+        ASSERT_EQ(this->map_.contain(pks[i]), count > 0);
+        for (auto offset : offsets) {
+            expected.emplace_back(i, offset);
+        }
+    }
+    ASSERT_EQ(this->map_.find_batch(pks), expected);
+}
+
+TYPED_TEST_P(TypedOffsetOrderedArrayTest, contain_batch) {
+    // the batch is large enough to be probed by the parallel ranges
+    int num = 50000;
+    auto data = this->random_generate(num);
+    for (int i = 0; i < num; i++) {
+        this->map_.insert(data[i], i);
+    }
+    std::vector<PkType> pks;
+    for (int i = 0; i < num; i += 2) {
+        pks.emplace_back(data[i]);
+    }
+    for (const auto& x : this->random_generate(num)) {
+        pks.emplace_back(x);
+    }
+    this->seal();
+
+    auto cpu_num = CPU_NUM;
+    CPU_NUM = 4;
+    auto contained = this->map_.contain_batch(pks);
+    auto found = this->map_.find_batch(pks);
+    CPU_NUM = cpu_num;
+
+    ASSERT_EQ(contained.size(), pks.size());
+    std::vector<std::pair<int64_t, int64_t>> expected;
+    for (int64_t i = 0; i < pks.size(); i++) {
+        ASSERT_EQ(contained[i], this->map_.contain(pks[i]));
+        for (auto offset : this->map_.find(pks[i])) {
+            expected.emplace_back(i, offset);
+        }
+    }
+    ASSERT_EQ(found, expected);
+}
+
+TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_first_selective) {
+    int num = 10000;
+    auto data = this->random_generate(num);
+    for (const auto& x : data) {
+        this->insert(x);
+    }
+    this->seal();
+
+    // the rows kept are few, they are found by the bitset
+    BitsetType sparse(num);
+    std::vector<std::pair<TypeParam, int64_t>> kept;
+    for (int i = 0; i < num; i += 97) {
+        sparse.set(i);
+        kept.emplace_back(data[i], i);
+    }
+    std::sort(kept.begin(), kept.end());
+    for (bool false_filtered_out : {true, false}) {
+        auto bitset = false_filtered_out ? sparse : ~sparse;
+        auto offsets = this->map_.find_first(5, bitset, false_filtered_out);
+        ASSERT_EQ(offsets.size(), 5);
+        for (int i = 0; i < 5; i++) {
+            ASSERT_EQ(offsets[i], kept[i].second);
+        }
+        offsets =
+            this->map_.find_first(Unlimited, bitset, false_filtered_out);
+        ASSERT_EQ(offsets.size(), kept.size());
+        for (int i = 0; i < kept.size(); i++) {
+            ASSERT_EQ(offsets[i], kept[i].second);
+        }
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(TypedOffsetOrderedArrayTest,
+                           find_first,
+                           find_batch,
+                           contain_batch,
+                           find_first_selective);
 INSTANTIATE_TYPED_TEST_CASE_P(Prefix, TypedOffsetOrderedArrayTest, TypeOfPks);
+
+TEST(OffsetOrderedColumn, ReferencePks) {
+    FieldMeta field_meta(
+        FieldName("pk"), FieldId(100), DataType::VARCHAR, 64);
+    std::vector<std::string> pks{"c", "a", "b", "a", "d", "b"};
+    auto column = std::make_shared<VariableColumn<std::string>>(pks.size(),
+                                                                field_meta);
+    for (auto& pk : pks) {
+        column->Append(pk.data(), pk.size());
+    }
+    column->Seal();
+
+    OffsetOrderedColumn map(column);
+    map.seal();
+    ASSERT_EQ(map.sorted_offsets(), (std::vector<int64_t>{1, 3, 2, 5, 0, 4}));
+    ASSERT_EQ(map.find(std::string("a")), (std::vector<int64_t>{1, 3}));
+    ASSERT_EQ(map.find(std::string("d")), (std::vector<int64_t>{4}));
+    ASSERT_TRUE(map.find(std::string("e")).empty());
+    ASSERT_TRUE(map.contain(std::string("b")));
+    ASSERT_FALSE(map.contain(std::string("0")));
+    ASSERT_ANY_THROW(map.insert(std::string("e"), 6));
+
+    std::vector<PkType> batch{
+        std::string("b"), std::string("x"), std::string("c")};
+    using Pairs = std::vector<std::pair<int64_t, int64_t>>;
+    ASSERT_EQ(map.find_batch(batch), (Pairs{{0, 2}, {0, 5}, {2, 0}}));
+
+    // the kept rows in the pk order, by walking the pks or by the ranks
+    BitsetType bitset(pks.size());
+    bitset[0] = true;
+    bitset[3] = true;
+    ASSERT_EQ(map.find_first(2, bitset, false),
+              (std::vector<int64_t>{1, 2}));
+    ASSERT_EQ(map.find_first(Unlimited, bitset, true),
+              (std::vector<int64_t>{3, 0}));
+
+    // the order given is kept if it's sorted
+    std::vector<int64_t> order{1, 3, 2, 5, 0, 4};
+    OffsetOrderedColumn ordered(column, order.data());
+    ordered.seal();
+    ASSERT_EQ(ordered.sorted_offsets(), order);
+}
@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <random>
+#include <thread>
 #include "segcore/InsertRecord.h"
 
 using namespace milvus;
@@ -52,7 +53,7 @@ class TypedOffsetOrderedMapTest : public testing::Test {
  protected:
     int64_t offset_ = 0;
     std::vector<T> data_;
-    milvus::segcore::OffsetOrderedMap<T> map_;
+    milvus::segcore::OffsetShardedMap<T> map_;
     std::default_random_engine er;
 };
 
@@ -94,7 +95,88 @@ TYPED_TEST_P(TypedOffsetOrderedMapTest, find_first) {
     ASSERT_EQ(0, offsets.size());
     offsets = this->map_.find_first(NoLimit, none, true);
     ASSERT_EQ(0, offsets.size());
+
+    // the pks inserted after find_first are merged in order.
+    auto more_data = this->random_generate(num);
+    for (const auto& x : more_data) {
+        this->insert(x);
+    }
+    data.insert(data.end(), more_data.begin(), more_data.end());
+    BitsetType all_more(num * 2);
+    all_more.set();
+    offsets = this->map_.find_first(Unlimited, all_more, true);
+    ASSERT_EQ(num * 2, offsets.size());
+    for (int i = 1; i < offsets.size(); i++) {
+        ASSERT_TRUE(data[offsets[i - 1]] <= data[offsets[i]]);
+    }
+}
+
+TYPED_TEST_P(TypedOffsetOrderedMapTest, concurrent_insert) {
+    int num_threads = 4;
+    int num_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < num_per_thread; i++) {
+                int64_t offset = t * num_per_thread + i;
+                if constexpr (std::is_same_v<std::string, TypeParam>) {
+                    this->map_.insert(std::to_string(offset % 100), offset);
+                } else {
+                    this->map_.insert(offset % 100, offset);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int64_t pk = 0; pk < 100; pk++) {
+        PkType target;
+        if constexpr (std::is_same_v<std::string, TypeParam>) {
+            target = std::to_string(pk);
+        } else {
+            target = pk;
+        }
+        ASSERT_TRUE(this->map_.contain(target));
+        ASSERT_EQ(this->map_.find(target).size(), num_threads * 10);
+    }
+    BitsetType all(num_threads * num_per_thread);
+    all.set();
+    auto offsets = this->map_.find_first(Unlimited, all, true);
+    ASSERT_EQ(offsets.size(), num_threads * num_per_thread);
+}
+
+TYPED_TEST_P(TypedOffsetOrderedMapTest, insert_sorted) {
+    // some pks inserted one by one, the others at once, like inserting all
+    // of them one by one
+    int num = 1000;
+    auto data = this->random_generate(num);
+    data.insert(data.end(), data.begin(), data.begin() + 100);
+    OffsetShardedMap<TypeParam> expected;
+    std::vector<std::pair<TypeParam, int64_t>> entries;
+    for (int64_t offset = 0; offset < data.size(); ++offset) {
+        expected.insert(data[offset], offset);
+        if (offset < num / 2) {
+            this->map_.insert(data[offset], offset);
+        } else {
+            entries.emplace_back(data[offset], offset);
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    this->map_.insert_sorted(std::move(entries));
+
+    for (auto& pk : data) {
+        ASSERT_EQ(this->map_.find(pk), expected.find(pk));
+    }
+    BitsetType all(data.size());
+    all.set();
+    ASSERT_EQ(this->map_.find_first(Unlimited, all, true),
+              expected.find_first(Unlimited, all, true));
 }
 
-REGISTER_TYPED_TEST_CASE_P(TypedOffsetOrderedMapTest, find_first);
+REGISTER_TYPED_TEST_CASE_P(TypedOffsetOrderedMapTest,
+                           find_first,
+                           concurrent_insert,
+                           insert_sorted);
 INSTANTIATE_TYPED_TEST_CASE_P(Prefix, TypedOffsetOrderedMapTest, TypeOfPks);
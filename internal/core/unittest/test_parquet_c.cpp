@@ -15,12 +15,17 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "storage/parquet_c.h"
 #include "storage/PayloadReader.h"
 #include "storage/PayloadWriter.h"
+#include "storage/Util.h"
 
 namespace wrapper = milvus::storage;
 using ErrorCode = milvus::ErrorCode;
@@ -424,3 +429,181 @@ TEST(storage, int8_2) {
     ASSERT_EQ(bool_array->Value(2), -100);
     ASSERT_EQ(bool_array->Value(3), 100);
 }
+
+// a payload written in row groups of row_group_rows, without the policy of
+// the writer
+static std::vector<uint8_t>
+WriteRowGroups(const milvus::storage::Payload& payload,
+               int64_t row_group_rows) {
+    auto builder =
+        payload.dimension.has_value()
+            ? wrapper::CreateArrowBuilder(payload.data_type,
+                                          payload.dimension.value())
+            : wrapper::CreateArrowBuilder(payload.data_type);
+    wrapper::AddPayloadToArrowBuilder(builder, payload);
+    std::shared_ptr<arrow::Array> array;
+    auto ast = builder->Finish(&array);
+    EXPECT_TRUE(ast.ok());
+    auto schema =
+        payload.dimension.has_value()
+            ? wrapper::CreateArrowSchema(payload.data_type,
+                                         payload.dimension.value())
+            : wrapper::CreateArrowSchema(payload.data_type);
+    auto table = arrow::Table::Make(schema, {array});
+    auto output = std::make_shared<wrapper::PayloadOutputStream>();
+    ast = parquet::arrow::WriteTable(
+        *table, arrow::default_memory_pool(), output, row_group_rows);
+    EXPECT_TRUE(ast.ok());
+    return output->Buffer();
+}
+
+TEST(storage, row_groups_decoded_in_parallel) {
+    int64_t rows = 10000;
+    int dim = 16;
+    std::vector<float> vectors(rows * dim);
+    std::vector<int64_t> pks(rows);
+    for (int64_t i = 0; i < rows; i++) {
+        pks[i] = i * 3;
+        for (int j = 0; j < dim; j++) {
+            vectors[i * dim + j] = i + j * 0.5;
+        }
+    }
+
+    // the last row group is shorter than the others
+    auto buffer = WriteRowGroups(
+        {milvus::DataType::VECTOR_FLOAT,
+         reinterpret_cast<const uint8_t*>(vectors.data()),
+         rows,
+         dim},
+        999);
+    wrapper::PayloadReader vector_reader(
+        buffer.data(), buffer.size(), milvus::DataType::VECTOR_FLOAT);
+    auto field_data = vector_reader.get_field_data();
+    ASSERT_EQ(field_data->get_num_rows(), rows);
+    ASSERT_EQ(field_data->Size(), rows * dim * int64_t(sizeof(float)));
+    ASSERT_EQ(std::memcmp(field_data->Data(),
+                          vectors.data(),
+                          vectors.size() * sizeof(float)),
+              0);
+
+    buffer = WriteRowGroups({milvus::DataType::INT64,
+                             reinterpret_cast<const uint8_t*>(pks.data()),
+                             rows,
+                             std::nullopt},
+                            999);
+    wrapper::PayloadReader pk_reader(
+        buffer.data(), buffer.size(), milvus::DataType::INT64);
+    field_data = pk_reader.get_field_data();
+    ASSERT_EQ(field_data->get_num_rows(), rows);
+    ASSERT_EQ(
+        std::memcmp(field_data->Data(), pks.data(), rows * sizeof(int64_t)), 0);
+}
+
+TEST(storage, payload_encoding_policy) {
+    auto float_buffer = [] {
+        float data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+        auto payload = NewPayloadWriter(int(milvus::DataType::FLOAT));
+        auto st = AddFloatToPayload(payload, data, 8);
+        EXPECT_EQ(st.error_code, ErrorCode::Success);
+        st = FinishPayloadWriter(payload);
+        EXPECT_EQ(st.error_code, ErrorCode::Success);
+        auto cb = GetPayloadBufferFromWriter(payload);
+        std::vector<uint8_t> buffer(cb.data, cb.data + cb.length);
+        ReleasePayloadWriter(payload);
+        return buffer;
+    };
+    auto column_chunk = [](const std::vector<uint8_t>& buffer) {
+        auto input = std::make_shared<arrow::io::BufferReader>(
+            buffer.data(), buffer.size());
+        auto reader = parquet::ParquetFileReader::Open(input);
+        return reader->metadata()->RowGroup(0)->ColumnChunk(0);
+    };
+
+    auto st = SetPayloadEncoding(int(milvus::DataType::FLOAT),
+                                 "uncompressed",
+                                 0,
+                                 "byte_stream_split",
+                                 false);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    auto buffer = float_buffer();
+    auto chunk = column_chunk(buffer);
+    ASSERT_EQ(chunk->compression(), arrow::Compression::UNCOMPRESSED);
+    auto encodings = chunk->encodings();
+    ASSERT_NE(std::find(encodings.begin(),
+                        encodings.end(),
+                        parquet::Encoding::BYTE_STREAM_SPLIT),
+              encodings.end());
+    wrapper::PayloadReader reader(
+        buffer.data(), buffer.size(), milvus::DataType::FLOAT);
+    auto values = static_cast<const float*>(reader.get_field_data()->Data());
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(values[i], i + 1);
+    }
+
+    // the encodings of the other parquet types are rejected
+    st = SetPayloadEncoding(
+        int(milvus::DataType::FLOAT), "zstd", 3, "delta_binary_packed", true);
+    ASSERT_NE(st.error_code, ErrorCode::Success);
+    st = SetPayloadEncoding(
+        int(milvus::DataType::FLOAT), "unknown", 3, "plain", true);
+    ASSERT_NE(st.error_code, ErrorCode::Success);
+
+    st = SetPayloadEncoding(
+        int(milvus::DataType::FLOAT), "zstd", 3, "plain", true);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ASSERT_EQ(column_chunk(float_buffer())->compression(),
+              arrow::Compression::ZSTD);
+    ASSERT_EQ(wrapper::GetPayloadEncodingPolicy(milvus::DataType::VECTOR_FLOAT)
+                  .compression,
+              arrow::Compression::UNCOMPRESSED);
+}
+
+TEST(storage, payload_row_group_statistics) {
+    auto policy = wrapper::GetPayloadEncodingPolicy(milvus::DataType::INT64);
+    auto row_group_policy = policy;
+    row_group_policy.row_group_rows = 1000;
+    wrapper::SetPayloadEncodingPolicy(milvus::DataType::INT64,
+                                      row_group_policy);
+
+    int64_t rows = 2500;
+    std::vector<int64_t> pks(rows);
+    for (int64_t i = 0; i < rows; i++) {
+        pks[i] = (i * 37) % rows - 100;
+    }
+    wrapper::PayloadWriter writer(milvus::DataType::INT64);
+    writer.add_payload({milvus::DataType::INT64,
+                        reinterpret_cast<const uint8_t*>(pks.data()),
+                        rows,
+                        std::nullopt});
+    writer.finish();
+    auto buffer = writer.get_payload_buffer();
+    wrapper::SetPayloadEncodingPolicy(milvus::DataType::INT64, policy);
+
+    auto input =
+        std::make_shared<arrow::io::BufferReader>(buffer.data(), buffer.size());
+    auto file_reader = parquet::ParquetFileReader::Open(input);
+    ASSERT_EQ(file_reader->metadata()->num_row_groups(), 3);
+
+    wrapper::PayloadReader reader(
+        buffer.data(), buffer.size(), milvus::DataType::INT64);
+    auto& statistics = reader.get_statistics();
+    ASSERT_TRUE(statistics.has_value());
+    ASSERT_EQ(statistics->num_rows, rows);
+    ASSERT_EQ(statistics->null_count, 0);
+    ASSERT_EQ(std::get<int64_t>(*statistics->min), -100);
+    ASSERT_EQ(std::get<int64_t>(*statistics->max), rows - 101);
+
+    // NaN isn't counted in the range of the floats
+    std::vector<float> floats = {2.5, std::nanf(""), -1.5, 4};
+    buffer = WriteRowGroups({milvus::DataType::FLOAT,
+                             reinterpret_cast<const uint8_t*>(floats.data()),
+                             int64_t(floats.size()),
+                             std::nullopt},
+                            2);
+    wrapper::PayloadReader float_reader(
+        buffer.data(), buffer.size(), milvus::DataType::FLOAT);
+    auto& float_statistics = float_reader.get_statistics();
+    ASSERT_TRUE(float_statistics.has_value());
+    ASSERT_EQ(std::get<double>(*float_statistics->min), -1.5);
+    ASSERT_EQ(std::get<double>(*float_statistics->max), 4);
+}
@@ -10,12 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <boost/format.hpp>
 #include <memory>
 #include <regex>
 #include <vector>
 #include <chrono>
 
+#include "query/PlanCache.h"
 #include "query/PlanProto.h"
+#include "test_utils/DataGen.h"
 
 TEST(PlanProto, NotSetUnsupported) {
     using namespace milvus;
@@ -30,3 +33,108 @@ TEST(PlanProto, NotSetUnsupported) {
     ProtoParser parser(*schema);
     ASSERT_ANY_THROW(parser.ParseExpr(expr_pb));
 }
+
+TEST(PlanProto, PlanCache) {
+    using namespace milvus;
+    using namespace milvus::query;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto search_plan = [&](int64_t topk) {
+        auto raw_plan = boost::format(R"(vector_anns: <
+                                            field_id: %1%
+                                            predicates: <
+                                              unary_range_expr: <
+                                                column_info: <
+                                                  field_id: %2%
+                                                  data_type: Int64
+                                                >
+                                                op: GreaterEqual
+                                                value: <
+                                                  int64_val: 4200
+                                                >
+                                              >
+                                            >
+                                            query_info: <
+                                              topk: %3%
+                                              round_decimal: -1
+                                              search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0"
+                                          >
+                                          output_field_ids: %2%)") %
+                        vec_fid.get() % i64_fid.get() % topk;
+        return translate_text_plan_to_binary_plan(raw_plan.str().data());
+    };
+    auto retrieve_plan = translate_text_plan_to_binary_plan(
+        (boost::format(R"(query: <
+                            predicates: <
+                              unary_range_expr: <
+                                column_info: <
+                                  field_id: %1%
+                                  data_type: Int64
+                                >
+                                op: LessThan
+                                value: <
+                                  int64_val: 10
+                                >
+                              >
+                            >
+                            limit: 5
+                          >
+                          output_field_ids: %1%)") %
+         i64_fid.get())
+            .str()
+            .data());
+
+    PlanCache cache(*schema, 1);
+    auto blob = search_plan(10);
+    auto plan = cache.CreateSearchPlan(blob.data(), blob.size());
+    auto cached = cache.CreateSearchPlan(blob.data(), blob.size());
+    ASSERT_EQ(cache.hit_count(), 1);
+    ASSERT_NE(plan.get(), cached.get());
+    ASSERT_NE(dynamic_cast<FloatVectorANNS*>(cached->plan_node_.get()),
+              nullptr);
+    ASSERT_EQ(plan->plan_node_->filter_plannode_.value(),
+              cached->plan_node_->filter_plannode_.value());
+    ASSERT_EQ(cached->plan_node_->search_info_.topk_, 10);
+    ASSERT_EQ(cached->tag2field_.at("$0"), vec_fid);
+    ASSERT_EQ(cached->target_entries_, std::vector<FieldId>{i64_fid});
+    ASSERT_TRUE(cached->extra_info_opt_.has_value());
+
+    // the copies are modified apart
+    cached->plan_node_->search_info_.metric_type_ = knowhere::metric::IP;
+    ASSERT_EQ(plan->plan_node_->search_info_.metric_type_, "");
+    ASSERT_EQ(cache.CreateSearchPlan(blob.data(), blob.size())
+                  ->plan_node_->search_info_.metric_type_,
+              "");
+    ASSERT_EQ(cache.hit_count(), 2);
+
+    // the least recently used plan is evicted
+    auto other_blob = search_plan(5);
+    auto other = cache.CreateSearchPlan(other_blob.data(), other_blob.size());
+    ASSERT_EQ(other->plan_node_->search_info_.topk_, 5);
+    cache.CreateSearchPlan(blob.data(), blob.size());
+    ASSERT_EQ(cache.hit_count(), 2);
+
+    // the retrieve plans are cached apart from the search plans
+    auto retrieve =
+        cache.CreateRetrievePlan(retrieve_plan.data(), retrieve_plan.size());
+    auto cached_retrieve =
+        cache.CreateRetrievePlan(retrieve_plan.data(), retrieve_plan.size());
+    ASSERT_EQ(cache.hit_count(), 3);
+    ASSERT_EQ(retrieve->plan_node_->filter_plannode_.value(),
+              cached_retrieve->plan_node_->filter_plannode_.value());
+    ASSERT_EQ(cached_retrieve->plan_node_->limit_, 5);
+    ASSERT_FALSE(cached_retrieve->plan_node_->is_count_);
+    ASSERT_EQ(cached_retrieve->field_ids_, std::vector<FieldId>{i64_fid});
+
+    // nothing is cached without capacity
+    PlanCache disabled(*schema, 0);
+    disabled.CreateSearchPlan(blob.data(), blob.size());
+    disabled.CreateSearchPlan(blob.data(), blob.size());
+    ASSERT_EQ(disabled.hit_count(), 0);
+}
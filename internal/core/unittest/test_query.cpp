@@ -18,6 +18,8 @@
 #include "query/generated/ExecPlanNodeVisitor.h"
 #include "query/generated/ExprVisitor.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
+#include "segcore/AdaptiveSearch.h"
+#include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentSealed.h"
 #include "test_utils/AssertUtils.h"
 #include "test_utils/DataGen.h"
@@ -301,6 +303,177 @@ TEST(Query, ExecWithPredicate) {
     ASSERT_EQ(json.dump(2), ref.dump(2));
 }
 
+TEST(Query, ExecWithProfile) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->AddDebugField("age", DataType::FLOAT);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    const char* raw_plan = R"(vector_anns: <
+                                    field_id: 100
+                                    predicates: <
+                                      binary_range_expr: <
+                                        column_info: <
+                                          field_id: 101
+                                          data_type: Float
+                                        >
+                                        lower_inclusive: true,
+                                        upper_inclusive: false,
+                                        lower_value: <
+                                          float_val: -1
+                                        >
+                                        upper_value: <
+                                          float_val: 1
+                                        >
+                                      >
+                                    >
+                                    query_info: <
+                                      topk: 5
+                                      round_decimal: 3
+                                      metric_type: "L2"
+                                      search_params: "{\"nprobe\": 10, \"profile\": true}"
+                                    >
+                                    placeholder_tag: "$0"
+     >)";
+    int64_t N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+    segment->PreInsert(N);
+    segment->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    ASSERT_TRUE(plan->plan_node_->search_info_.profile_);
+    ASSERT_FALSE(plan->plan_node_->search_info_.search_params_.contains(
+        milvus::SEARCH_PROFILE));
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    auto sr = segment->Search(plan.get(), ph_group.get());
+    ASSERT_NE(sr->profile_, nullptr);
+    std::map<std::string, milvus::ProfileStage> stages;
+    for (auto& stage : sr->profile_->Stages()) {
+        stages[stage.name_] = stage;
+    }
+    ASSERT_EQ(stages.count("filter"), 1);
+    ASSERT_EQ(stages["filter"].input_rows_, N);
+    ASSERT_EQ(stages.count("mask_timestamps"), 1);
+    ASSERT_EQ(stages.count("mask_delete"), 1);
+    ASSERT_EQ(stages.count("search"), 1);
+    ASSERT_EQ(stages["search"].path_, "brute_force");
+    ASSERT_EQ(stages["search"].input_rows_, stages["filter"].output_rows_);
+    ASSERT_EQ(stages["search"].output_rows_, num_queries * 5);
+    // the expressions are recorded by the names of their own
+    auto num_exprs = std::count_if(
+        stages.begin(), stages.end(), [](const auto& stage) {
+            return stage.first.find('#') != std::string::npos;
+        });
+    ASSERT_GE(num_exprs, 1);
+
+    // not collected unless asked for
+    plan->plan_node_->search_info_.profile_ = false;
+    auto sr_no_profile = segment->Search(plan.get(), ph_group.get());
+    ASSERT_EQ(sr_no_profile->profile_, nullptr);
+}
+
+TEST(Query, AdaptiveSearchEffort) {
+    using namespace milvus::segcore;
+    // no target, in time, or over the target by the wait alone
+    ASSERT_EQ(EffortShare(0, 0, 1000), 1);
+    ASSERT_EQ(EffortShare(1000, 0, 0), 1);
+    ASSERT_EQ(EffortShare(1000, 200, 800), 1);
+    ASSERT_EQ(EffortShare(1000, 1000, 800), 0);
+    ASSERT_DOUBLE_EQ(EffortShare(1000, 200, 1600), 0.5);
+
+    milvus::SearchInfo info;
+    info.topk_ = 10;
+    info.search_params_ = {{"nprobe", 64}, {"ef", 100}, {"radius", 0.5}};
+    info.adaptive_bounds_ = {{"nprobe", 8}, {"ef", 4}, {"radius", 1}};
+    std::map<std::string, int64_t> adapted;
+    auto effort = ScaleSearchEffort(info, 0.05, adapted);
+    // not below the bound nor topk for ef, the float param is kept
+    ASSERT_EQ(info.search_params_["nprobe"], 8);
+    ASSERT_EQ(info.search_params_["ef"], 10);
+    ASSERT_EQ(info.search_params_["radius"], 0.5);
+    std::map<std::string, int64_t> expected = {{"nprobe", 8}, {"ef", 10}};
+    ASSERT_EQ(adapted, expected);
+    ASSERT_DOUBLE_EQ(effort, 0.125);
+
+    // already at the bound
+    milvus::SearchInfo at_bound;
+    at_bound.search_params_ = {{"nprobe", 8}};
+    at_bound.adaptive_bounds_ = {{"nprobe", 8}};
+    adapted.clear();
+    ASSERT_EQ(ScaleSearchEffort(at_bound, 0.5, adapted), 1);
+    ASSERT_TRUE(adapted.empty());
+}
+
+TEST(Query, ExecWithAdaptiveSearch) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    const char* raw_plan = R"(vector_anns: <
+                                    field_id: 100
+                                    query_info: <
+                                      topk: 5
+                                      round_decimal: 3
+                                      metric_type: "L2"
+                                      search_params: "{\"nprobe\": 10, \"adaptive_search\": {\"nprobe\": 2}}"
+                                    >
+                                    placeholder_tag: "$0"
+     >)";
+    int64_t N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+    segment->PreInsert(N);
+    segment->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    auto& search_info = plan->plan_node_->search_info_;
+    std::map<std::string, int64_t> bounds = {{"nprobe", 2}};
+    ASSERT_EQ(search_info.adaptive_bounds_, bounds);
+    ASSERT_FALSE(search_info.search_params_.contains(milvus::ADAPTIVE_SEARCH));
+    auto ph_group_raw = CreatePlaceholderGroup(5, 16, 1024);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    // no latency target
+    auto sr = segment->Search(plan.get(), ph_group.get());
+    ASSERT_TRUE(sr->adapted_search_params_.empty());
+
+    // the searches on the segment took far over the target recently
+    auto& config = SegcoreConfig::default_config();
+    config.set_adaptive_search_latency_target_ms(1);
+    segment->full_effort_search_latency().Observe(1000 * 1000);
+    sr = segment->Search(plan.get(), ph_group.get());
+    config.set_adaptive_search_latency_target_ms(0);
+    ASSERT_EQ(sr->adapted_search_params_, bounds);
+    // the plan keeps the requested effort
+    ASSERT_EQ(search_info.search_params_["nprobe"], 10);
+    ASSERT_EQ(sr->total_nq_, 5);
+    ASSERT_EQ(sr->unity_topK_, 5);
+}
+
 TEST(Query, ExecTerm) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -172,3 +172,37 @@ TEST_P(RangeSearchSortTest, CheckRangeSearchSort) {
     delete[] p_id;
     delete[] p_dist;
 }
+
+TEST(RangeSearchSort, TiesAndShortResults) {
+    // the ties are ordered by id, a query with fewer results than topk is
+    // padded with invalid results
+    auto ids = new int64_t[5]{5, 3, 9, 4, 7};
+    auto distances = new float[5]{1, 1, 0.5, 1, 2};
+    auto lims = new size_t[3]{0, 4, 5};
+    auto dataset = genResultDataset(2, ids, distances, lims);
+    int64_t topk = 3;
+
+    auto l2 = milvus::ReGenRangeSearchResult(
+        dataset, topk, 2, knowhere::metric::L2);
+    auto l2_ids = milvus::GetDatasetIDs(l2);
+    auto l2_dist = milvus::GetDatasetDistance(l2);
+    std::vector<int64_t> expected_ids = {9, 3, 4, 7, -1, -1};
+    std::vector<float> expected_dist = {0.5,
+                                        1,
+                                        1,
+                                        2,
+                                        std::numeric_limits<float>::max(),
+                                        std::numeric_limits<float>::max()};
+    for (int64_t i = 0; i < 2 * topk; i++) {
+        EXPECT_EQ(l2_ids[i], expected_ids[i]);
+        EXPECT_EQ(l2_dist[i], expected_dist[i]);
+    }
+
+    auto ip = milvus::ReGenRangeSearchResult(
+        dataset, topk, 2, knowhere::metric::IP);
+    auto ip_ids = milvus::GetDatasetIDs(ip);
+    expected_ids = {5, 4, 3, 7, -1, -1};
+    for (int64_t i = 0; i < 2 * topk; i++) {
+        EXPECT_EQ(ip_ids[i], expected_ids[i]);
+    }
+}
@@ -12,10 +12,13 @@
 #include <gtest/gtest.h>
 #include <queue>
 #include <random>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "knowhere/comp/index_param.h"
 #include "query/SubSearchResult.h"
+#include "segcore/PkSet.h"
 
 using namespace milvus;
 using namespace milvus::query;
@@ -133,3 +136,91 @@ TEST(Reduce, SubSearchResult) {
     TestSubSearchResultMerge<queue_type_ip>(knowhere::metric::IP, 4, 16, 1);
     TestSubSearchResultMerge<queue_type_ip>(knowhere::metric::IP, 4, 16, 10);
 }
+
+TEST(Reduce, SubSearchResultDropOffsets) {
+    int64_t num_queries = 2;
+    int64_t topk = 4;
+    SubSearchResult result(num_queries, topk, knowhere::metric::L2, -1);
+    result.mutable_seg_offsets() = {3, 12, 5, 20, 15, 10, 30, -1};
+    result.mutable_distances() = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+
+    result.drop_offsets_from(10);
+    std::vector<int64_t> expected_offsets = {3, 5, -1, -1, -1, -1, -1, -1};
+    ASSERT_EQ(result.mutable_seg_offsets(), expected_offsets);
+    auto invalid_distance = SubSearchResult::init_value(knowhere::metric::L2);
+    std::vector<float> expected_distances = {0.1,
+                                             0.3,
+                                             invalid_distance,
+                                             invalid_distance,
+                                             invalid_distance,
+                                             invalid_distance,
+                                             invalid_distance,
+                                             invalid_distance};
+    ASSERT_EQ(result.mutable_distances(), expected_distances);
+}
+
+TEST(Reduce, SubSearchResultMergeTiesAndInvalid) {
+    int64_t num_queries = 2;
+    int64_t topk = 4;
+    SubSearchResult left(num_queries, topk, knowhere::metric::L2, -1);
+    left.mutable_seg_offsets() = {1, 2, -1, -1, 5, 6, 7, 8};
+    left.mutable_distances() = {0.1, 0.3, 0, 0, 0.1, 0.2, 0.3, 0.4};
+    SubSearchResult right(num_queries, topk, knowhere::metric::L2, -1);
+    right.mutable_seg_offsets() = {11, 12, 13, -1, 15, 16, 17, 18};
+    right.mutable_distances() = {0.1, 0.2, 0.5, 0, 0.05, 0.2, 0.2, 0.5};
+
+    // the left wins the ties, and the invalid results go last
+    left.merge(right);
+    std::vector<int64_t> expected_offsets = {1, 11, 12, 2, 15, 5, 6, 16};
+    ASSERT_EQ(left.mutable_seg_offsets(), expected_offsets);
+    std::vector<float> expected_distances = {
+        0.1, 0.1, 0.2, 0.3, 0.05, 0.1, 0.2, 0.2};
+    ASSERT_EQ(left.mutable_distances(), expected_distances);
+}
+
+TEST(Reduce, SubSearchResultReuseBuffers) {
+    int64_t num_queries = 16;
+    int64_t topk = 10;
+    const int64_t* offsets = nullptr;
+    {
+        SubSearchResult result(num_queries, topk, knowhere::metric::IP, -1);
+        result.get_seg_offsets()[0] = 42;
+        offsets = result.get_ids();
+    }
+
+    // the buffers of the destroyed result are refilled for the next one
+    SubSearchResult result(num_queries, topk, knowhere::metric::IP, -1);
+    ASSERT_EQ(result.get_ids(), offsets);
+    ASSERT_EQ(result.mutable_seg_offsets(),
+              std::vector<int64_t>(num_queries * topk, INVALID_SEG_OFFSET));
+    ASSERT_EQ(result.mutable_distances(),
+              std::vector<float>(num_queries * topk,
+                                 SubSearchResult::init_value(
+                                     knowhere::metric::IP)));
+}
+
+TEST(Reduce, PkSet) {
+    // more pks than the initial capacity, so the table grows, and the set is
+    // reused after clear() like for every nq
+    segcore::PkSet int64_set(DataType::INT64);
+    std::uniform_int_distribution<int64_t> pk_dist(-500, 500);
+    for (int round = 0; round < 3; ++round) {
+        int64_set.clear();
+        std::set<int64_t> expected;
+        for (int i = 0; i < 2000; ++i) {
+            auto pk = pk_dist(e);
+            ASSERT_EQ(int64_set.contains(pk), expected.count(pk) > 0);
+            ASSERT_EQ(int64_set.insert(pk), expected.insert(pk).second);
+            ASSERT_TRUE(int64_set.contains(pk));
+        }
+    }
+    int64_set.clear();
+    ASSERT_FALSE(int64_set.contains(PkType(int64_t(0))));
+
+    segcore::PkSet string_set(DataType::VARCHAR);
+    ASSERT_TRUE(string_set.insert(PkType(std::string("a"))));
+    ASSERT_FALSE(string_set.insert(PkType(std::string("a"))));
+    ASSERT_TRUE(string_set.contains(PkType(std::string("a"))));
+    string_set.clear();
+    ASSERT_FALSE(string_set.contains(PkType(std::string("a"))));
+}
@@ -10,6 +10,10 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <set>
 
 #include "common/Types.h"
 #include "knowhere/comp/index_param.h"
@@ -543,3 +547,390 @@ TEST(Retrieve, Delete) {
         ASSERT_EQ(field2_data.data_size(), DIM * size);
     }
 }
+
+TEST(Retrieve, Count) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto DIM = 16;
+    auto fid_vec = schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto i64_col = dataset.get_col<int64_t>(fid_64);
+
+    int64_t upper = 300;
+    auto count = [&](Timestamp timestamp, bool filtered) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->is_count_ = true;
+        if (filtered) {
+            proto::plan::GenericValue val;
+            val.set_int64_val(upper);
+            auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+                milvus::expr::ColumnInfo(
+                    fid_64, DataType::INT64, std::vector<std::string>()),
+                OpType::LessThan,
+                val);
+            plan->plan_node_->filter_plannode_ =
+                std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID,
+                                                       expr);
+        }
+        auto results = RetrieveUsingDefaultOutputSize(
+            segment.get(), plan.get(), timestamp);
+        return results->fields_data(0).scalars().long_data().data(0);
+    };
+    auto expected = [&](Timestamp timestamp,
+                        bool filtered,
+                        const std::set<int64_t>& deleted) {
+        int64_t cnt = 0;
+        for (int64_t i = 0; i < N; ++i) {
+            if (dataset.timestamps_[i] <= timestamp &&
+                (!filtered || i64_col[i] < upper) &&
+                deleted.count(i64_col[i]) == 0) {
+                ++cnt;
+            }
+        }
+        return cnt;
+    };
+
+    // all the rows are visible and none is deleted
+    ASSERT_EQ(count(MAX_TIMESTAMP, false), N);
+    ASSERT_EQ(count(MAX_TIMESTAMP, true), expected(MAX_TIMESTAMP, true, {}));
+
+    // some rows are inserted after the timestamp
+    Timestamp partial = dataset.timestamps_[N / 2];
+    ASSERT_EQ(count(partial, false), expected(partial, false, {}));
+    ASSERT_EQ(count(partial, true), expected(partial, true, {}));
+
+    std::vector<idx_t> pks{i64_col[0], i64_col[1], i64_col[N - 1]};
+    auto ids = std::make_unique<IdArray>();
+    ids->mutable_int_id()->mutable_data()->Add(pks.begin(), pks.end());
+    std::vector<Timestamp> timestamps(pks.size(), N);
+    segment->Delete(segment->get_deleted_count(),
+                    pks.size(),
+                    ids.get(),
+                    timestamps.data());
+    std::set<int64_t> deleted(pks.begin(), pks.end());
+    ASSERT_EQ(count(MAX_TIMESTAMP, false),
+              expected(MAX_TIMESTAMP, false, deleted));
+    ASSERT_EQ(count(MAX_TIMESTAMP, true),
+              expected(MAX_TIMESTAMP, true, deleted));
+}
+
+TEST(Retrieve, Aggregate) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto fid_32 = schema->AddDebugField("i32", DataType::INT32);
+    auto fid_double = schema->AddDebugField("double", DataType::DOUBLE);
+    auto DIM = 16;
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto i64_col = dataset.get_col<int64_t>(fid_64);
+    auto i32_col = dataset.get_col<int32_t>(fid_32);
+    auto double_col = dataset.get_col<double>(fid_double);
+
+    using query::AggregateOp;
+    auto aggregate = [&](std::optional<int64_t> upper) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        for (auto op : {AggregateOp::Min,
+                        AggregateOp::Max,
+                        AggregateOp::Sum,
+                        AggregateOp::Avg}) {
+            plan->plan_node_->aggregates_.push_back(
+                {op, fid_32, DataType::INT32});
+            plan->plan_node_->aggregates_.push_back(
+                {op, fid_double, DataType::DOUBLE});
+        }
+        if (upper.has_value()) {
+            proto::plan::GenericValue val;
+            val.set_int64_val(upper.value());
+            auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+                milvus::expr::ColumnInfo(
+                    fid_64, DataType::INT64, std::vector<std::string>()),
+                OpType::LessThan,
+                val);
+            plan->plan_node_->filter_plannode_ =
+                std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID,
+                                                       expr);
+        }
+        return RetrieveUsingDefaultOutputSize(
+            segment.get(), plan.get(), MAX_TIMESTAMP);
+    };
+
+    for (auto upper : {std::optional<int64_t>(),
+                       std::optional<int64_t>(9000),
+                       std::optional<int64_t>(-1)}) {
+        int64_t num_rows = 0;
+        int32_t i32_min = std::numeric_limits<int32_t>::max();
+        int32_t i32_max = std::numeric_limits<int32_t>::lowest();
+        int64_t i32_sum = 0;
+        double double_min = std::numeric_limits<double>::infinity();
+        double double_max = -std::numeric_limits<double>::infinity();
+        double double_sum = 0;
+        for (int64_t i = 0; i < N; ++i) {
+            if (upper.has_value() && i64_col[i] >= upper.value()) {
+                continue;
+            }
+            ++num_rows;
+            i32_min = std::min(i32_min, i32_col[i]);
+            i32_max = std::max(i32_max, i32_col[i]);
+            i32_sum += i32_col[i];
+            double_min = std::min(double_min, double_col[i]);
+            double_max = std::max(double_max, double_col[i]);
+            double_sum += double_col[i];
+        }
+
+        auto results = aggregate(upper);
+        ASSERT_EQ(results->fields_data_size(), 9);
+        auto& count = results->fields_data(8).scalars().long_data();
+        ASSERT_EQ(count.data(0), num_rows);
+        auto& i32_mins = results->fields_data(0).scalars().int_data();
+        auto& double_mins = results->fields_data(1).scalars().double_data();
+        auto& i32_maxs = results->fields_data(2).scalars().int_data();
+        auto& double_maxs = results->fields_data(3).scalars().double_data();
+        if (num_rows == 0) {
+            ASSERT_EQ(i32_mins.data_size(), 0);
+            ASSERT_EQ(double_mins.data_size(), 0);
+            ASSERT_EQ(i32_maxs.data_size(), 0);
+            ASSERT_EQ(double_maxs.data_size(), 0);
+        } else {
+            ASSERT_EQ(i32_mins.data(0), i32_min);
+            ASSERT_EQ(double_mins.data(0), double_min);
+            ASSERT_EQ(i32_maxs.data(0), i32_max);
+            ASSERT_EQ(double_maxs.data(0), double_max);
+        }
+        for (auto i : {4, 6}) {
+            auto& field = results->fields_data(i);
+            ASSERT_EQ(field.field_id(), fid_32.get());
+            ASSERT_EQ(field.scalars().long_data().data(0), i32_sum);
+        }
+        for (auto i : {5, 7}) {
+            auto& field = results->fields_data(i);
+            ASSERT_EQ(field.field_id(), fid_double.get());
+            ASSERT_NEAR(field.scalars().double_data().data(0),
+                        double_sum,
+                        1e-6 * std::max(1.0, std::abs(double_sum)));
+        }
+    }
+}
+
+TEST(Retrieve, AggregatePackedColumn) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto fid_32 = schema->AddDebugField("i32", DataType::INT32);
+    auto DIM = 16;
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    for (auto& field_data : *dataset.raw_->mutable_fields_data()) {
+        if (FieldId(field_data.field_id()) == fid_32) {
+            auto values = field_data.mutable_scalars()->mutable_int_data();
+            for (int64_t i = 0; i < N; ++i) {
+                values->set_data(i, i % 100 - 50);
+            }
+        }
+    }
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *plain_seg);
+    auto& config = SegcoreConfig::default_config();
+    config.set_pack_ratio(0.5);
+    auto packed_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *packed_seg);
+    config.set_pack_ratio(0);
+    auto packed = packed_seg->GetPackedColumn(fid_32);
+    ASSERT_NE(packed, nullptr);
+
+    using query::AggregateOp;
+    auto aggregate = [&](SegmentSealed* segment, int64_t upper) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        for (auto op : {AggregateOp::Min,
+                        AggregateOp::Max,
+                        AggregateOp::Sum,
+                        AggregateOp::Avg}) {
+            plan->plan_node_->aggregates_.push_back(
+                {op, fid_32, DataType::INT32});
+        }
+        proto::plan::GenericValue val;
+        val.set_int64_val(upper);
+        auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(
+                fid_64, DataType::INT64, std::vector<std::string>()),
+            OpType::LessThan,
+            val);
+        plan->plan_node_->filter_plannode_ =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        return RetrieveUsingDefaultOutputSize(
+            segment, plan.get(), MAX_TIMESTAMP);
+    };
+
+    for (auto upper : {N, int64_t(9000), int64_t(-1)}) {
+        auto ref = aggregate(plain_seg.get(), upper);
+        auto res = aggregate(packed_seg.get(), upper);
+        ASSERT_EQ(res->fields_data_size(), ref->fields_data_size());
+        for (int i = 0; i < ref->fields_data_size(); ++i) {
+            ASSERT_EQ(res->fields_data(i).DebugString(),
+                      ref->fields_data(i).DebugString());
+        }
+    }
+    // the rows are decoded a block at a time, the column is kept packed
+    ASSERT_EQ(packed->MemoryByteSize(), packed->PackedByteSize());
+}
+
+TEST(Retrieve, OrderBy) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto fid_32 = schema->AddDebugField("i32", DataType::INT32);
+    auto fid_double = schema->AddDebugField("double", DataType::DOUBLE);
+    auto DIM = 16;
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 10000;
+    int64_t upper = 9000;
+    int64_t limit = 10;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto i32_col = dataset.get_col<int32_t>(fid_32);
+    auto double_col = dataset.get_col<double>(fid_double);
+
+    auto retrieve = [&](FieldId field_id, DataType data_type, bool desc) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->limit_ = limit;
+        plan->plan_node_->order_by_ =
+            query::OrderByInfo{field_id, data_type, desc};
+        proto::plan::GenericValue val;
+        val.set_int64_val(upper);
+        auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(
+                fid_64, DataType::INT64, std::vector<std::string>()),
+            OpType::LessThan,
+            val);
+        plan->plan_node_->filter_plannode_ =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        plan->field_ids_ = {field_id};
+        return RetrieveUsingDefaultOutputSize(
+            segment.get(), plan.get(), MAX_TIMESTAMP);
+    };
+    auto expected = [&](auto col, bool desc) {
+        std::vector<typename decltype(col)::value_type> values(
+            col.begin(), col.begin() + upper);
+        std::sort(values.begin(), values.end());
+        if (desc) {
+            std::reverse(values.begin(), values.end());
+        }
+        values.resize(limit);
+        return values;
+    };
+
+    auto check = [&]() {
+        for (auto desc : {false, true}) {
+            auto results = retrieve(fid_32, DataType::INT32, desc);
+            auto& i32_data = results->fields_data(0).scalars().int_data();
+            ASSERT_EQ(i32_data.data_size(), limit);
+            auto i32_expected = expected(i32_col, desc);
+            for (int64_t i = 0; i < limit; ++i) {
+                ASSERT_EQ(i32_data.data(i), i32_expected[i]);
+            }
+
+            results = retrieve(fid_double, DataType::DOUBLE, desc);
+            auto& double_data =
+                results->fields_data(0).scalars().double_data();
+            ASSERT_EQ(double_data.data_size(), limit);
+            auto double_expected = expected(double_col, desc);
+            for (int64_t i = 0; i < limit; ++i) {
+                ASSERT_EQ(double_data.data(i), double_expected[i]);
+            }
+        }
+    };
+    check();
+
+    // the rows are then found by walking the sorted index
+    LoadIndexInfo load_info;
+    load_info.field_id = fid_32.get();
+    load_info.field_type = DataType::INT32;
+    load_info.index_params["index_type"] = "sort";
+    load_info.index = GenScalarIndexing<int32_t>(N, i32_col.data());
+    segment->LoadIndex(load_info);
+    check();
+}
+
+TEST(Retrieve, OrderByPackedColumn) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    auto fid_32 = schema->AddDebugField("i32", DataType::INT32);
+    auto DIM = 16;
+    schema->AddDebugField(
+        "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 10000;
+    int64_t upper = 9000;
+    int64_t limit = 10;
+    auto dataset = DataGen(schema, N);
+    for (auto& field_data : *dataset.raw_->mutable_fields_data()) {
+        if (FieldId(field_data.field_id()) == fid_32) {
+            auto values = field_data.mutable_scalars()->mutable_int_data();
+            for (int64_t i = 0; i < N; ++i) {
+                values->set_data(i, (i * 37) % 1000);
+            }
+        }
+    }
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *plain_seg);
+    auto& config = SegcoreConfig::default_config();
+    config.set_pack_ratio(0.5);
+    auto packed_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *packed_seg);
+    config.set_pack_ratio(0);
+    auto packed = packed_seg->GetPackedColumn(fid_32);
+    ASSERT_NE(packed, nullptr);
+
+    auto retrieve = [&](SegmentSealed* segment, bool desc) {
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->limit_ = limit;
+        plan->plan_node_->order_by_ =
+            query::OrderByInfo{fid_32, DataType::INT32, desc};
+        proto::plan::GenericValue val;
+        val.set_int64_val(upper);
+        auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(
+                fid_64, DataType::INT64, std::vector<std::string>()),
+            OpType::LessThan,
+            val);
+        plan->plan_node_->filter_plannode_ =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        plan->field_ids_ = {fid_32};
+        return RetrieveUsingDefaultOutputSize(
+            segment, plan.get(), MAX_TIMESTAMP);
+    };
+
+    for (auto desc : {false, true}) {
+        auto ref = retrieve(plain_seg.get(), desc);
+        auto res = retrieve(packed_seg.get(), desc);
+        ASSERT_EQ(res->fields_data(0).scalars().int_data().data_size(),
+                  limit);
+        ASSERT_EQ(res->fields_data(0).DebugString(),
+                  ref->fields_data(0).DebugString());
+    }
+    // the sort keys are decoded a block at a time, the column is kept packed
+    ASSERT_EQ(packed->MemoryByteSize(), packed->PackedByteSize());
+}
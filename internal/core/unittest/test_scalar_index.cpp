@@ -15,6 +15,8 @@
 
 #include "gtest/gtest-typed-test.h"
 #include "index/IndexFactory.h"
+#include "index/BitmapIndex.h"
+#include "index/ScalarIndexSort.h"
 #include "common/CDataType.h"
 #include "knowhere/comp/index_param.h"
 #include "test_utils/indexbuilder_test_utils.h"
@@ -394,3 +396,130 @@ TYPED_TEST_P(TypedScalarIndexTestV2, Base) {
 REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexTestV2, Base);
 
 INSTANTIATE_TYPED_TEST_CASE_P(ArithmeticCheck, TypedScalarIndexTestV2, ScalarT);
+
+TEST(ScalarIndexSort, Mmap) {
+    using milvus::index::ScalarIndexSort;
+    std::vector<int64_t> data(1000);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] = (i * 37) % 101;
+    }
+    ScalarIndexSort<int64_t> index;
+    index.Build(data.size(), data.data());
+    auto values = index.GetValues();
+    auto offsets = index.GetOffsets();
+    for (int i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(values[i], data[offsets[i]]);
+        if (i > 0) {
+            ASSERT_LE(values[i - 1], values[i]);
+        }
+    }
+
+    auto filepath = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path() / "sort_index";
+    auto binary_set = index.Serialize(nullptr);
+    ScalarIndexSort<int64_t> mmap_index;
+    ASSERT_TRUE(mmap_index.IsMmapSupported());
+    mmap_index.Load(binary_set, {{kMmapFilepath, filepath.string()}});
+    ASSERT_TRUE(mmap_index.IsMmap());
+    ASSERT_FALSE(boost::filesystem::exists(filepath));
+    boost::filesystem::remove_all(filepath.parent_path());
+
+    ASSERT_EQ(mmap_index.Count(), data.size());
+    std::vector<int64_t> terms{3, 50, 200};
+    auto in = mmap_index.In(terms.size(), terms.data());
+    auto range = mmap_index.Range(10, true, 20, false);
+    for (int i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(mmap_index.Reverse_Lookup(i), data[i]);
+        ASSERT_EQ(in[i], data[i] == 3 || data[i] == 50);
+        ASSERT_EQ(range[i], data[i] >= 10 && data[i] < 20);
+    }
+}
+
+TEST(ScalarIndexSort, LoadStructures) {
+    using milvus::index::IndexStructure;
+    // the binary serialized as the structures of the values and offsets
+    std::vector<IndexStructure<int32_t>> structures{{1, 2}, {4, 0}, {7, 1}};
+    auto size = structures.size() * sizeof(IndexStructure<int32_t>);
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[size]);
+    memcpy(index_data.get(), structures.data(), size);
+    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
+    auto length = structures.size();
+    memcpy(index_length.get(), &length, sizeof(size_t));
+    milvus::BinarySet binary_set;
+    binary_set.Append("index_data", index_data, size);
+    binary_set.Append("index_length", index_length, sizeof(size_t));
+
+    milvus::index::ScalarIndexSort<int32_t> index;
+    index.Load(binary_set);
+    ASSERT_EQ(index.Count(), 3);
+    ASSERT_EQ(index.Reverse_Lookup(0), 4);
+    ASSERT_EQ(index.Reverse_Lookup(1), 7);
+    ASSERT_EQ(index.Reverse_Lookup(2), 1);
+    auto bitset = index.Range(4, milvus::OpType::GreaterEqual);
+    ASSERT_EQ(bitset, milvus::TargetBitmap({true, true, false}));
+}
+
+TEST(BitmapIndex, LowCardinality) {
+    using milvus::index::BitmapIndex;
+    // 0 is held by most rows, 1 and 2 by few rows and NaN by a single row
+    std::vector<double> data(1000, 0);
+    for (int i = 0; i < data.size(); i += 100) {
+        data[i] = 1;
+        data[i + 1] = 2;
+    }
+    data[7] = NAN;
+
+    auto check = [&](BitmapIndex<double>& index) {
+        ASSERT_EQ(index.Count(), data.size());
+        ASSERT_EQ(index.Cardinality(), 3);
+
+        std::vector<double> values{2, NAN, 0, 3};
+        auto in = index.In(values.size(), values.data());
+        auto not_in = index.NotIn(values.size(), values.data());
+        auto lt = index.Range(1, milvus::OpType::LessThan);
+        auto range = index.Range(1, true, 2, false);
+        for (int i = 0; i < data.size(); ++i) {
+            ASSERT_EQ(in[i], data[i] == 2 || data[i] == 0);
+            ASSERT_EQ(not_in[i], !in[i]);
+            ASSERT_EQ(lt[i], data[i] < 1);
+            ASSERT_EQ(range[i], data[i] == 1);
+            if (std::isnan(data[i])) {
+                ASSERT_TRUE(std::isnan(index.Reverse_Lookup(i)));
+            } else {
+                ASSERT_EQ(index.Reverse_Lookup(i), data[i]);
+            }
+        }
+        ASSERT_EQ(Count(index.Range(NAN, milvus::OpType::GreaterEqual)), 0);
+    };
+
+    BitmapIndex<double> index;
+    index.Build(data.size(), data.data());
+    check(index);
+
+    auto binary_set = index.Serialize(nullptr);
+    BitmapIndex<double> copy_index;
+    copy_index.Load(binary_set);
+    check(copy_index);
+}
+
+TEST(BitmapIndex, PrefixMatch) {
+    std::vector<std::string> data{"ab", "abc", "b", "ab", "", "abd", "a"};
+    milvus::index::BitmapIndex<std::string> index;
+    index.Build(data.size(), data.data());
+    ASSERT_EQ(index.Cardinality(), 6);
+
+    auto binary_set = index.Serialize(nullptr);
+    milvus::index::BitmapIndex<std::string> copy_index;
+    copy_index.Load(binary_set);
+    for (auto prefix : {"", "a", "ab", "abc", "abcd", "b", "c"}) {
+        auto ds = std::make_shared<knowhere::DataSet>();
+        ds->Set<milvus::OpType>(milvus::index::OPERATOR_TYPE,
+                                milvus::OpType::PrefixMatch);
+        ds->Set<std::string>(milvus::index::PREFIX_VALUE, std::string(prefix));
+        auto bitset = copy_index.Query(ds);
+        ASSERT_EQ(bitset.size(), data.size());
+        for (int i = 0; i < data.size(); ++i) {
+            ASSERT_EQ(bitset[i], data[i].rfind(prefix, 0) == 0);
+        }
+    }
+}
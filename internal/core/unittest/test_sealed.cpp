@@ -11,17 +11,40 @@
 
 #include <gtest/gtest.h>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <arrow/api.h>
+#include <parquet/arrow/writer.h>
 
 #include "common/Types.h"
+#include "segcore/BulkImport.h"
+#include "segcore/Compaction.h"
+#include "segcore/LoadMemoryManager.h"
+#include "segcore/SegmentHandoff.h"
 #include "segcore/SegmentSealedImpl.h"
+#include "segcore/SegmentSnapshot.h"
+#include "segcore/Utils.h"
 #include "test_utils/DataGen.h"
 #include "test_utils/storage_test_utils.h"
 #include "index/IndexFactory.h"
+#include "plan/PlanNode.h"
+#include "query/FilterCache.h"
+#include "query/PlanImpl.h"
+#include "query/generated/ExecPlanNodeVisitor.h"
+#include "storage/PayloadStream.h"
 #include "storage/Util.h"
 #include "knowhere/version.h"
 #include "storage/ChunkCacheSingleton.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "storage/MinioChunkManager.h"
+#include "storage/LoadMetrics.h"
+#include "storage/LocalChunkManager.h"
+#include "storage/SearchMetrics.h"
+#include "storage/prometheus_client.h"
 #include "test_utils/indexbuilder_test_utils.h"
 
 using namespace milvus;
@@ -251,6 +274,389 @@ TEST(Sealed, with_predicate) {
     }
 }
 
+TEST(Sealed, BruteForceWithSelectiveFilter) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    const char* raw_plan = R"(vector_anns: <
+                                field_id: 100
+                                predicates: <
+                                  binary_range_expr: <
+                                    column_info: <
+                                      field_id: 101
+                                      data_type: Int64
+                                    >
+                                    lower_inclusive: true,
+                                    upper_inclusive: false,
+                                    lower_value: <
+                                      int64_val: 4200
+                                    >
+                                    upper_value: <
+                                      int64_val: 4205
+                                    >
+                                  >
+                                >
+                                query_info: <
+                                  topk: 5
+                                  round_decimal: 6
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 10}"
+                                >
+                                placeholder_tag: "$0"
+     >)";
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto query_ptr = vec_col.data() + BIAS * dim;
+
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.field_type = DataType::VECTOR_FLOAT;
+    create_index_info.metric_type = knowhere::metric::L2;
+    create_index_info.index_type = knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+    create_index_info.index_engine_version =
+        knowhere::Version::GetCurrentVersion().VersionNumber();
+    auto indexing = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, milvus::storage::FileManagerContext());
+    auto build_conf =
+        knowhere::Json{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                       {knowhere::meta::DIM, std::to_string(dim)},
+                       {knowhere::indexparam::NLIST, "100"}};
+    auto database = knowhere::GenDataSet(N, dim, vec_col.data());
+    indexing->BuildWithDataset(database, build_conf);
+
+    LoadIndexInfo load_info;
+    load_info.field_id = fake_id.get();
+    load_info.index = std::move(indexing);
+    load_info.index_params["metric_type"] = "L2";
+
+    // keep the raw vectors, so that the selective filter falls back to
+    // brute force
+    auto sealed_segment = SealedCreator(schema, dataset);
+    sealed_segment->LoadIndex(load_info);
+
+    auto plan_str = translate_text_plan_to_binary_plan(raw_plan);
+    auto plan =
+        CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+    auto num_queries = 5;
+    auto ph_group_raw =
+        CreatePlaceholderGroupFromBlob(num_queries, 16, query_ptr);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    // the searches of the stages labelled by the index type of the field
+    auto stage_count = [](const std::string& stage) {
+        milvus::storage::FlushSearchStageHistograms();
+        auto& histogram =
+            milvus::storage::internal_core_search_latency_family.Add(
+                {{"search_stage", stage},
+                 {"segment_type", "sealed"},
+                 {"index_type", knowhere::IndexEnum::INDEX_FAISS_IVFFLAT}},
+                milvus::storage::searchLatencyBuckets);
+        return histogram.Collect().histogram.sample_count;
+    };
+    auto filter_count = stage_count("filter");
+    auto vector_search_count = stage_count("vector_search");
+    auto brute_force_count =
+        milvus::storage::internal_sealed_vector_search_count_brute_force
+            .Value();
+    auto sr = sealed_segment->Search(plan.get(), ph_group.get());
+    ASSERT_EQ(milvus::storage::internal_sealed_vector_search_count_brute_force
+                  .Value(),
+              brute_force_count + 1);
+    ASSERT_EQ(stage_count("filter"), filter_count + 1);
+    ASSERT_EQ(stage_count("vector_search"), vector_search_count + 1);
+    for (int i = 0; i < num_queries; ++i) {
+        auto offset = i * topK;
+        ASSERT_EQ(sr->seg_offsets_[offset], BIAS + i);
+        ASSERT_EQ(sr->distances_[offset], 0.0);
+        for (int j = 0; j < topK; ++j) {
+            ASSERT_GE(sr->seg_offsets_[offset + j], BIAS);
+            ASSERT_LT(sr->seg_offsets_[offset + j], BIAS + 5);
+        }
+    }
+}
+
+TEST(Sealed, IterativeFilter) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto fmt = boost::format(R"(vector_anns: <
+                                field_id: 100
+                                predicates: <
+                                  %1%
+                                >
+                                query_info: <
+                                  topk: 5
+                                  round_decimal: 6
+                                  metric_type: "L2"
+                                  search_params: "%2%"
+                                >
+                                placeholder_tag: "$0"
+     >)");
+    // drops a single row, and drops all but a few rows
+    std::vector<std::string> predicates = {
+        R"(unary_range_expr: <
+             column_info: <
+               field_id: 101
+               data_type: Int64
+             >
+             op: NotEqual
+             value: <
+               int64_val: 4201
+             >
+           >)",
+        R"(binary_range_expr: <
+             column_info: <
+               field_id: 101
+               data_type: Int64
+             >
+             lower_inclusive: true,
+             upper_inclusive: false,
+             lower_value: <
+               int64_val: 4200
+             >
+             upper_value: <
+               int64_val: 4205
+             >
+           >)"};
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto query_ptr = vec_col.data() + BIAS * dim;
+    auto sealed_segment = SealedCreator(schema, dataset);
+    auto num_queries = 5;
+
+    auto search = [&](const std::string& predicate,
+                      const std::string& search_params) {
+        auto raw_plan = (boost::format(fmt) % predicate % search_params).str();
+        auto plan_str = translate_text_plan_to_binary_plan(raw_plan.data());
+        auto plan =
+            CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+        auto ph_group_raw =
+            CreatePlaceholderGroupFromBlob(num_queries, 16, query_ptr);
+        auto ph_group = ParsePlaceholderGroup(
+            plan.get(), ph_group_raw.SerializeAsString());
+        return sealed_segment->Search(plan.get(), ph_group.get());
+    };
+
+    for (const auto& predicate : predicates) {
+        auto expected = search(predicate, R"({\"nprobe\": 10})");
+        auto sr = search(predicate, R"({\"iterative_filter\": true})");
+        ASSERT_EQ(sr->total_nq_, num_queries);
+        ASSERT_EQ(sr->unity_topK_, topK);
+        ASSERT_EQ(sr->seg_offsets_, expected->seg_offsets_);
+        ASSERT_EQ(sr->distances_, expected->distances_);
+    }
+}
+
+TEST(Sealed, GroupBy) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    auto i8_fid = schema->AddDebugField("category", DataType::INT8);
+    schema->set_primary_field_id(i64_fid);
+    auto fmt = boost::format(R"(vector_anns: <
+                                field_id: 100
+                                query_info: <
+                                  topk: %1%
+                                  round_decimal: 6
+                                  metric_type: "L2"
+                                  search_params: "{\"nprobe\": 10}"
+                                  group_by_field_id: %2%
+                                >
+                                placeholder_tag: "$0"
+     >)");
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto categories = dataset.get_col<int32_t>(i8_fid);
+    auto query_ptr = vec_col.data() + BIAS * dim;
+    auto sealed_segment = SealedCreator(schema, dataset);
+    auto num_queries = 5;
+
+    auto search = [&](int64_t topk, int64_t group_by_field_id) {
+        auto raw_plan = (boost::format(fmt) % topk % group_by_field_id).str();
+        auto plan_str = translate_text_plan_to_binary_plan(raw_plan.data());
+        auto plan =
+            CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+        auto ph_group_raw =
+            CreatePlaceholderGroupFromBlob(num_queries, 16, query_ptr);
+        auto ph_group = ParsePlaceholderGroup(
+            plan.get(), ph_group_raw.SerializeAsString());
+        return sealed_segment->Search(plan.get(), ph_group.get());
+    };
+
+    // the best result of every group, in the order of the plain search
+    auto candidate_topk = 1000;
+    auto plain = search(candidate_topk, 0);
+    ASSERT_TRUE(plain->group_by_values_.empty());
+    auto sr = search(topK, i8_fid.get());
+    ASSERT_EQ(sr->total_nq_, num_queries);
+    ASSERT_EQ(sr->unity_topK_, topK);
+    ASSERT_EQ(sr->group_by_values_.size(), num_queries * topK);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::vector<int64_t> expected;
+        std::set<int8_t> groups;
+        for (int64_t i = 0;
+             i < candidate_topk && static_cast<int>(expected.size()) < topK;
+             ++i) {
+            auto offset = plain->seg_offsets_[q * candidate_topk + i];
+            if (groups.insert(categories[offset]).second) {
+                expected.push_back(offset);
+            }
+        }
+        ASSERT_EQ(expected.size(), static_cast<size_t>(topK));
+        for (int64_t i = 0; i < topK; ++i) {
+            auto offset = sr->seg_offsets_[q * topK + i];
+            ASSERT_EQ(offset, expected[i]);
+            auto value = sr->group_by_values_[q * topK + i];
+            ASSERT_EQ(std::get<int8_t>(value),
+                      static_cast<int8_t>(categories[offset]));
+        }
+    }
+
+    // the vector fields can't be grouped by
+    ASSERT_ANY_THROW(search(topK, fake_id.get()));
+}
+
+TEST(Sealed, HybridSearch) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 16;
+    auto topK = 5;
+    auto fake_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto fake_id2 = schema->AddDebugField(
+        "fakevec2", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto query_info = R"(query_info: <
+                           topk: 10
+                           round_decimal: -1
+                           metric_type: "L2"
+                           search_params: "{\"nprobe\": 10}"
+                         >)";
+    auto single_fmt = boost::format(R"(vector_anns: <
+                                       field_id: %1%
+                                       %2%
+                                       placeholder_tag: "$0"
+                                     >)");
+    auto hybrid_fmt = boost::format(R"(vector_anns: <
+                                       field_id: 100
+                                       query_info: <
+                                         topk: 5
+                                         round_decimal: -1
+                                         metric_type: "L2"
+                                         search_params: "{\"nprobe\": 10}"
+                                       >
+                                       placeholder_tag: "$0"
+                                       sub_anns: <
+                                         field_id: 101
+                                         %1%
+                                         placeholder_tag: "$1"
+                                       >
+                                       fusion_info: <
+                                         %2%
+                                       >
+                                     >)");
+
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(fake_id);
+    auto vec_col2 = dataset.get_col<float>(fake_id2);
+    auto sealed_segment = SealedCreator(schema, dataset);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(
+        num_queries, dim, vec_col.data() + BIAS * dim);
+    auto sub_ph_group_raw = CreatePlaceholderGroupFromBlob(
+        num_queries, dim, vec_col2.data() + BIAS * dim);
+
+    auto search = [&](const std::string& raw_plan,
+                      const proto::common::PlaceholderGroup& raw_group) {
+        auto plan_str = translate_text_plan_to_binary_plan(raw_plan.data());
+        auto plan =
+            CreateSearchPlanByExpr(*schema, plan_str.data(), plan_str.size());
+        auto ph_group =
+            ParsePlaceholderGroup(plan.get(), raw_group.SerializeAsString());
+        auto sr = sealed_segment->Search(plan.get(), ph_group.get());
+        return std::make_pair(std::move(sr), IsPositivelyRelated(plan.get()));
+    };
+    auto [result, positive] =
+        search((boost::format(single_fmt) % 100 % query_info).str(),
+               ph_group_raw);
+    ASSERT_FALSE(positive);
+    auto sub_result =
+        search((boost::format(single_fmt) % 101 % query_info).str(),
+               sub_ph_group_raw)
+            .first;
+    std::vector<const SearchResult*> results{result.get(), sub_result.get()};
+
+    auto hybrid_ph_group_raw = ph_group_raw;
+    auto sub_placeholder = hybrid_ph_group_raw.add_placeholders();
+    *sub_placeholder = sub_ph_group_raw.placeholders(0);
+    sub_placeholder->set_tag("$1");
+
+    // the fused scores of the rows of the search of topk 5 and the sub
+    // search of topk 10
+    std::vector<int64_t> topks{topK, 10};
+    auto check = [&](const std::string& fusion_info, auto row_score) {
+        auto [sr, hybrid_positive] =
+            search((boost::format(hybrid_fmt) % query_info % fusion_info).str(),
+                   hybrid_ph_group_raw);
+        ASSERT_TRUE(hybrid_positive);
+        ASSERT_EQ(sr->unity_topK_, topK);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            std::map<int64_t, float> scores;
+            for (size_t i = 0; i < results.size(); ++i) {
+                for (int64_t rank = 0; rank < topks[i]; ++rank) {
+                    auto pos = q * 10 + rank;
+                    scores[results[i]->seg_offsets_[pos]] +=
+                        row_score(i, rank, results[i]->distances_[pos]);
+                }
+            }
+            std::vector<std::pair<float, int64_t>> expected;
+            for (auto& [offset, score] : scores) {
+                expected.emplace_back(-score, offset);
+            }
+            std::sort(expected.begin(), expected.end());
+            for (int64_t i = 0; i < topK; ++i) {
+                ASSERT_EQ(sr->seg_offsets_[q * topK + i], expected[i].second);
+                ASSERT_NEAR(
+                    sr->distances_[q * topK + i], -expected[i].first, 1e-6);
+            }
+        }
+    };
+    check("fusion_type: RRF rrf_k: 20", [](size_t, int64_t rank, float) {
+        return 1.0f / (20 + rank + 1);
+    });
+    check("fusion_type: WeightedSum weights: 0.8 weights: 0.2",
+          [](size_t i, int64_t, float distance) {
+              auto weight = i == 0 ? 0.8f : 0.2f;
+              return weight * (1.0f - 2.0f * std::atan(distance) /
+                                           static_cast<float>(M_PI));
+          });
+
+    // a weight for every search
+    ASSERT_ANY_THROW(
+        search((boost::format(hybrid_fmt) % query_info %
+                "fusion_type: WeightedSum weights: 0.8")
+                   .str(),
+               hybrid_ph_group_raw));
+}
+
 TEST(Sealed, with_predicate_filter_all) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -734,6 +1140,115 @@ TEST(Sealed, LoadScalarIndex) {
     std::cout << json.dump(1);
 }
 
+TEST(Sealed, MemoryUsage) {
+    auto dim = 16;
+    int64_t N = ROW_COUNT;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    schema->AddDebugField("str", DataType::VARCHAR);
+    schema->set_primary_field_id(counter_id);
+    auto dataset = DataGen(schema, N);
+    auto segment = SealedCreator(schema, dataset);
+    int64_t value_size = sizeof(int64_t);
+
+    auto usage = segment->GetMemoryUsage();
+    ASSERT_GT(usage.field_data, 0);
+    ASSERT_EQ(usage.index, 0);
+    ASSERT_GT(usage.pk_index, 0);
+    ASSERT_GE(usage.timestamps, N * value_size);
+    ASSERT_EQ(usage.deleted_record, 0);
+    ASSERT_EQ(segment->GetMemoryUsageInBytes(), usage.Total());
+
+    LoadIndexInfo counter_index;
+    counter_index.field_id = counter_id.get();
+    counter_index.field_type = DataType::INT64;
+    counter_index.index_params["index_type"] = "sort";
+    auto counter_data = dataset.get_col<int64_t>(counter_id);
+    counter_index.index = GenScalarIndexing<int64_t>(N, counter_data.data());
+    segment->LoadIndex(counter_index);
+    usage = segment->GetMemoryUsage();
+    ASSERT_GE(usage.index, N * value_size);
+
+    auto half = N / 2;
+    auto del_pks = GenPKs(counter_data.begin(), counter_data.begin() + half);
+    auto del_tss = GenTss(half, N);
+    auto status = segment->Delete(0, half, del_pks.get(), del_tss.data());
+    ASSERT_TRUE(status.ok());
+    usage = segment->GetMemoryUsage();
+    ASSERT_GE(usage.deleted_record, half * 2 * value_size);
+
+    auto reported = segment->ReportMemoryUsage();
+    ASSERT_EQ(reported.Total(), usage.Total());
+}
+
+TEST(Sealed, LoadMemoryManager) {
+    auto& manager = LoadMemoryManager::GetInstance();
+    manager.SetLimit(1000, std::chrono::milliseconds(0));
+    auto expect_exceeded = [&](int64_t bytes) {
+        try {
+            auto reservation = manager.Reserve(bytes);
+            FAIL();
+        } catch (SegcoreError& e) {
+            ASSERT_EQ(e.get_error_code(), MemoryBudgetExceeded);
+        }
+    };
+    expect_exceeded(2000);
+    {
+        auto reservation = manager.Reserve(600);
+        ASSERT_EQ(manager.ReservedBytes(), 600);
+        expect_exceeded(600);
+    }
+    ASSERT_EQ(manager.ReservedBytes(), 0);
+
+    // the usage counts until released
+    int owner;
+    manager.SetUsage(&owner, 300);
+    manager.SetUsage(&owner, 500);
+    ASSERT_EQ(manager.UsedBytes(), 500);
+    expect_exceeded(600);
+    manager.ReleaseUsage(&owner);
+    ASSERT_EQ(manager.UsedBytes(), 0);
+
+    // wait for the reservations to be released
+    manager.SetLimit(1000, std::chrono::seconds(10));
+    std::thread holder;
+    {
+        auto reservation = manager.Reserve(600);
+        holder = std::thread([&manager] {
+            auto waiting = manager.Reserve(600);
+            ASSERT_EQ(manager.ReservedBytes(), 600);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    holder.join();
+    ASSERT_EQ(manager.ReservedBytes(), 0);
+    manager.SetLimit(0, std::chrono::milliseconds(0));
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto str_id = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->set_primary_field_id(counter_id);
+    auto segment = CreateSealedSegment(schema);
+    LoadFieldDataInfo load_info;
+    for (auto field_id : {vec_id, counter_id, str_id, RowFieldID}) {
+        FieldBinlogInfo info;
+        info.field_id = field_id.get();
+        info.row_count = 100;
+        load_info.field_infos[field_id.get()] = info;
+    }
+    auto str_size = std::min<int64_t>((*schema)[str_id].get_sizeof(), 64);
+    ASSERT_EQ(EstimateLoadFieldDataBytes(*segment, load_info),
+              100 * (64 + 2 * 8 + str_size));
+    // the mmapped fields are not counted
+    load_info.field_infos[vec_id.get()].enable_mmap = true;
+    ASSERT_EQ(EstimateLoadFieldDataBytes(*segment, load_info),
+              100 * (2 * 8 + str_size));
+}
+
 TEST(Sealed, Delete) {
     auto dim = 16;
     auto topK = 5;
@@ -1161,6 +1676,59 @@ TEST(Sealed, GetVector) {
     }
 }
 
+TEST(Sealed, GetVectorFromMappedField) {
+    auto dim = 16;
+    auto N = ROW_COUNT;
+    auto metric_type = knowhere::metric::L2;
+    auto index_type = knowhere::IndexEnum::INDEX_FAISS_IVFPQ;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(counter_id);
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(fakevec_id);
+    auto conf = generate_build_conf(index_type, metric_type);
+    auto ds = knowhere::GenDataSet(N, dim, fakevec.data());
+
+    for (bool with_mmap : {false, true}) {
+        auto indexing = std::make_unique<index::VectorMemIndex<float>>(
+            index_type,
+            metric_type,
+            knowhere::Version::GetCurrentVersion().VersionNumber());
+        indexing->BuildWithDataset(ds, conf);
+        ASSERT_FALSE(indexing->HasRawData());
+
+        auto segment_sealed = CreateSealedSegment(schema);
+        SealedLoadFieldData(dataset, *segment_sealed, {}, with_mmap);
+        LoadIndexInfo vec_info;
+        vec_info.field_id = fakevec_id.get();
+        vec_info.index = std::move(indexing);
+        vec_info.index_params["metric_type"] = knowhere::metric::L2;
+        segment_sealed->LoadIndex(vec_info);
+
+        // only the mapped raw vectors are kept besides the index
+        auto segment = dynamic_cast<SegmentSealedImpl*>(segment_sealed.get());
+        ASSERT_EQ(segment->HasRawData(fakevec_id.get()), with_mmap);
+        ASSERT_EQ(segment->HasFieldData(fakevec_id), with_mmap);
+        if (!with_mmap) {
+            continue;
+        }
+
+        auto ids_ds = GenRandomIds(N);
+        auto result = segment->get_vector(fakevec_id, ids_ds->GetIds(), N);
+        auto vector = result->vectors().float_vector().data();
+        ASSERT_EQ(vector.size(), fakevec.size());
+        for (size_t i = 0; i < N; ++i) {
+            auto id = ids_ds->GetIds()[i];
+            for (size_t j = 0; j < dim; ++j) {
+                ASSERT_EQ(vector[i * dim + j], fakevec[id * dim + j]);
+            }
+        }
+    }
+}
+
 TEST(Sealed, GetVectorFromChunkCache) {
     // skip test due to mem leak from AWS::InitSDK
     return;
@@ -1272,6 +1840,146 @@ TEST(Sealed, GetVectorFromChunkCache) {
     Assert(!exist);
 }
 
+TEST(Sealed, LoadFieldDatasFromRemoteMetrics) {
+    auto root_path = std::string("/tmp/test_load_field_datas_metrics");
+    auto& rcm_singleton =
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance();
+    auto old_rcm = rcm_singleton.GetRemoteChunkManager();
+    auto rcm = std::make_shared<milvus::storage::LocalChunkManager>(root_path);
+    rcm_singleton.SetRemoteChunkManager(rcm);
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_id = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_id);
+    auto N = ROW_COUNT;
+    auto dataset = DataGen(schema, N);
+    auto pks = dataset.get_col<int64_t>(pk_id);
+    auto field_data_meta = milvus::storage::FieldDataMeta{1, 2, 3, pk_id.get()};
+    auto field_meta = milvus::FieldMeta(
+        milvus::FieldName("pk"), pk_id, milvus::DataType::INT64);
+    std::vector<std::string> files = {root_path + "/insert_log/1/101/2",
+                                      root_path + "/insert_log/1/101/1"};
+    PutFieldData(rcm.get(),
+                 {reinterpret_cast<uint8_t*>(pks.data()),
+                  reinterpret_cast<uint8_t*>(pks.data() + N / 2)},
+                 {N / 2, N - N / 2},
+                 {files[1], files[0]},
+                 field_data_meta,
+                 field_meta);
+
+    auto field_label = std::to_string(pk_id.get());
+    auto stage_count = [&](const std::string& stage) {
+        auto& histogram =
+            milvus::storage::internal_core_load_latency_family.Add(
+                {{"load_stage", stage}, {"field_id", field_label}},
+                milvus::storage::searchLatencyBuckets);
+        return histogram.Collect().histogram.sample_count;
+    };
+    auto& bytes_counter = milvus::storage::internal_core_load_bytes_family.Add(
+        {{"field_id", field_label}});
+    auto download_count = stage_count("download");
+    auto decode_count = stage_count("decode");
+    auto push_wait_count = stage_count("push_wait");
+    auto bytes = bytes_counter.Value();
+
+    auto channel = std::make_shared<FieldDataChannel>();
+    std::optional<milvus::storage::PayloadStatistics> statistics;
+    LoadFieldDatasFromRemote(files, channel, pk_id.get(), &statistics);
+    auto field_datas = milvus::storage::CollectFieldDataChannel(channel);
+    ASSERT_EQ(field_datas.size(), 2);
+    ASSERT_EQ(field_datas[0]->get_num_rows(), N / 2);
+
+    // the statistics of the two binlogs are merged
+    ASSERT_TRUE(statistics.has_value());
+    ASSERT_EQ(statistics->num_rows, N);
+    ASSERT_EQ(statistics->null_count, 0);
+    auto [min_pk, max_pk] = std::minmax_element(pks.begin(), pks.end());
+    ASSERT_EQ(std::get<int64_t>(*statistics->min), *min_pk);
+    ASSERT_EQ(std::get<int64_t>(*statistics->max), *max_pk);
+
+    ASSERT_EQ(stage_count("download"), download_count + 2);
+    ASSERT_EQ(stage_count("decode"), decode_count + 2);
+    ASSERT_EQ(stage_count("push_wait"), push_wait_count + 2);
+    ASSERT_EQ(bytes_counter.Value(),
+              bytes + rcm->Size(files[0]) + rcm->Size(files[1]));
+
+    rcm_singleton.SetRemoteChunkManager(old_rcm);
+    std::filesystem::remove_all(root_path);
+}
+
+TEST(Sealed, LazyLoadField) {
+    auto root_path = std::string("/tmp/test_lazy_load_field");
+    auto& rcm_singleton =
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance();
+    auto old_rcm = rcm_singleton.GetRemoteChunkManager();
+    auto rcm = std::make_shared<milvus::storage::LocalChunkManager>(root_path);
+    rcm_singleton.SetRemoteChunkManager(rcm);
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_id = schema->AddDebugField("pk", DataType::INT64);
+    auto lazy_id = schema->AddDebugField("lazy", DataType::INT64);
+    schema->set_primary_field_id(pk_id);
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment, {lazy_id.get()});
+
+    auto lazy_values = dataset.get_col<int64_t>(lazy_id);
+    auto field_data_meta =
+        milvus::storage::FieldDataMeta{1, 2, 3, lazy_id.get()};
+    auto field_meta = milvus::FieldMeta(
+        milvus::FieldName("lazy"), lazy_id, milvus::DataType::INT64);
+    std::vector<std::string> files = {root_path + "/insert_log/1/102/1",
+                                      root_path + "/insert_log/1/102/2"};
+    PutFieldData(rcm.get(),
+                 {reinterpret_cast<uint8_t*>(lazy_values.data()),
+                  reinterpret_cast<uint8_t*>(lazy_values.data() + N / 2)},
+                 {N / 2, N - N / 2},
+                 files,
+                 field_data_meta,
+                 field_meta);
+    LoadFieldDataInfo load_info;
+    auto& info = load_info.field_infos[lazy_id.get()];
+    info.field_id = lazy_id.get();
+    info.row_count = N;
+    info.entries_nums = {N / 2, N - N / 2};
+    info.insert_files = files;
+    info.lazy_load = true;
+    segment->AddFieldDataInfoForSealed(load_info);
+    // the lazy field is skipped by the load
+    segment->LoadFieldData(load_info);
+    ASSERT_FALSE(segment->HasFieldData(lazy_id));
+
+    // the field is loaded by the first retrieve outputting it, the
+    // concurrent ones wait on the same load
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->filter_plannode_ = std::make_shared<plan::FilterBitsNode>(
+        DEFAULT_PLANNODE_ID, std::make_shared<expr::AlwaysTrueExpr>());
+    plan->field_ids_ = {pk_id, lazy_id};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] {
+            auto results = segment->Retrieve(
+                plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE);
+            ASSERT_EQ(results->fields_data_size(), 2);
+            auto& lazy_data = results->fields_data(1).scalars().long_data();
+            ASSERT_EQ(lazy_data.data_size(), N);
+            for (int64_t j = 0; j < N; j++) {
+                ASSERT_EQ(lazy_data.data(j),
+                          lazy_values[results->offset(j)]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(segment->HasFieldData(lazy_id));
+
+    rcm_singleton.SetRemoteChunkManager(old_rcm);
+    std::filesystem::remove_all(root_path);
+}
+
 TEST(Sealed, LoadArrayFieldData) {
     auto dim = 16;
     auto topK = 5;
@@ -1526,6 +2234,108 @@ TEST(Sealed, SkipIndexSkipBinaryRange) {
         skip_index.CanSkipBinaryRange<int64_t>(pk_fid, 0, 10, 12, true, true));
 }
 
+TEST(Sealed, FieldStats) {
+    // 100000 rows of 1000 distinct values, 0 taking half of the rows
+    int64_t N = 100000;
+    std::vector<int64_t> values(N);
+    for (int64_t i = 0; i < N; ++i) {
+        values[i] = i % 2 == 0 ? 0 : i % 1000;
+    }
+    auto stats = FieldStats::Build<int64_t>(
+        N, 0, [&](int64_t i) { return values[i]; });
+    ASSERT_EQ(stats.num_rows, N);
+    ASSERT_NEAR(stats.DistinctCount(), 500, 25);
+    ASSERT_NEAR(stats.EqualSelectivity(int64_t(0)), 0.5, 0.05);
+    ASSERT_NEAR(stats.EqualSelectivity(int64_t(1)), 1.0 / 500, 0.001);
+    ASSERT_EQ(stats.EqualSelectivity(int64_t(1000)), 0);
+    ASSERT_EQ(stats.EqualSelectivity(int64_t(-1)), 0);
+    ASSERT_NEAR(
+        stats.RangeSelectivity(int64_t(1), true, int64_t(500), false),
+        0.25,
+        0.05);
+    ASSERT_NEAR(
+        stats.RangeSelectivity(std::nullopt, false, int64_t(0), true),
+        0.5,
+        0.05);
+    ASSERT_EQ(stats.RangeSelectivity(std::nullopt, false, std::nullopt, false),
+              1);
+    // a number compared to a string can't be estimated
+    ASSERT_EQ(stats.EqualSelectivity(std::string("0")), 1);
+
+    auto serialized = stats.Serialize();
+    auto restored =
+        FieldStats::Deserialize(serialized.data(), serialized.size());
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->bounds, stats.bounds);
+    ASSERT_EQ(restored->DistinctCount(), stats.DistinctCount());
+    ASSERT_FALSE(FieldStats::Deserialize(serialized.data(),
+                                         serialized.size() - 1)
+                     .has_value());
+
+    // the stats of the loaded fields, the strings as well
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakeVec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    auto double_fid = schema->AddDebugField("double", DataType::DOUBLE);
+    schema->set_primary_field_id(pk_fid);
+    auto dataset = DataGen(schema, 1000);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto& skip_index = segment->GetSkipIndex();
+    for (auto field_id : {pk_fid, str_fid, double_fid}) {
+        auto field_stats = skip_index.GetFieldStats(field_id);
+        ASSERT_NE(field_stats, nullptr);
+        ASSERT_EQ(field_stats->num_rows, 1000);
+        ASSERT_GT(field_stats->DistinctCount(), 0);
+    }
+    auto strs = dataset.get_col<std::string>(str_fid);
+    auto str_stats = skip_index.GetFieldStats(str_fid);
+    auto min = *std::min_element(strs.begin(), strs.end());
+    auto max = *std::max_element(strs.begin(), strs.end());
+    ASSERT_GT(str_stats->EqualSelectivity(strs[0]), 0);
+    ASSERT_EQ(str_stats->EqualSelectivity(max + "~"), 0);
+    ASSERT_EQ(str_stats->RangeSelectivity(min, true, max, true), 1);
+    ASSERT_EQ(str_stats->RangeSelectivity(std::nullopt, false, min, false),
+              0);
+}
+
+TEST(Sealed, SkipIndexFromStatistics) {
+    auto schema = std::make_shared<Schema>();
+    auto float_fid = schema->AddDebugField("float", DataType::FLOAT);
+    auto segment = CreateSealedSegment(schema);
+
+    // the range of the statistics is taken as it is, without scanning
+    std::vector<float> floats = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    milvus::storage::PayloadStatistics statistics;
+    statistics.num_rows = floats.size();
+    statistics.min = 0.5;
+    statistics.max = 20.0;
+    segment->LoadPrimitiveSkipIndex(float_fid,
+                                    0,
+                                    DataType::FLOAT,
+                                    floats.data(),
+                                    floats.size(),
+                                    &statistics);
+    auto& skip_index = segment->GetSkipIndex();
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 0, OpType::GreaterThan, 15));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 0, OpType::GreaterThan, 20));
+
+    // the statistics of other rows are ignored
+    statistics.num_rows = floats.size() + 1;
+    segment->LoadPrimitiveSkipIndex(float_fid,
+                                    1,
+                                    DataType::FLOAT,
+                                    floats.data(),
+                                    floats.size(),
+                                    &statistics);
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 1, OpType::GreaterThan, 15));
+}
+
 TEST(Sealed, SkipIndexSkipStringRange) {
     auto schema = std::make_shared<Schema>();
     auto dim = 128;
@@ -1581,6 +2391,83 @@ TEST(Sealed, SkipIndexSkipStringRange) {
         string_fid, 0, 1, 2, false, true));
 }
 
+TEST(Sealed, SkipIndexBloomAndNgramFilter) {
+    auto schema = std::make_shared<Schema>();
+    auto dim = 128;
+    auto metrics_type = "L2";
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto float_fid = schema->AddDebugField("float_field", DataType::FLOAT);
+    auto string_fid = schema->AddDebugField("string_field", DataType::VARCHAR);
+    auto fake_vec_fid = schema->AddDebugField(
+        "fakeVec", DataType::VECTOR_FLOAT, dim, metrics_type);
+    size_t N = 5;
+    auto segment = CreateSealedSegment(schema);
+    auto& skip_index = segment->GetSkipIndex();
+
+    // the values missed are between min and max, only the bloom filter
+    // rules them out
+    std::vector<int64_t> pks = {10, 20, 30, 40, 50};
+    auto pk_field_data = storage::CreateFieldData(DataType::INT64, 1, N);
+    pk_field_data->FillFieldData(pks.data(), N);
+    segment->LoadPrimitiveSkipIndex(
+        pk_fid, 0, DataType::INT64, pk_field_data->Data(), N);
+    ASSERT_TRUE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk_fid, 0, OpType::Equal, 35));
+    ASSERT_FALSE(
+        skip_index.CanSkipUnaryRange<int64_t>(pk_fid, 0, OpType::Equal, 40));
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<int64_t>(
+        pk_fid, 0, OpType::NotEqual, 35));
+    ASSERT_TRUE(skip_index.CanSkipTerm<int64_t>(
+        pk_fid, 0, std::vector<int64_t>{15, 35, 45}));
+    ASSERT_FALSE(skip_index.CanSkipTerm<int64_t>(
+        pk_fid, 0, std::vector<int64_t>{15, 50}));
+    // the filters of a field of another type aren't probed
+    ASSERT_FALSE(
+        skip_index.CanSkipUnaryRange<double>(pk_fid, 0, OpType::Equal, 35));
+
+    std::vector<float> floats = {-1.5, -0.0, 2.5, 3.5, NAN};
+    auto float_field_data = storage::CreateFieldData(DataType::FLOAT, 1, N);
+    float_field_data->FillFieldData(floats.data(), N);
+    segment->LoadPrimitiveSkipIndex(
+        float_fid, 0, DataType::FLOAT, float_field_data->Data(), N);
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 0, OpType::Equal, 0.0));
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 0, OpType::Equal, 2.5));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<float>(
+        float_fid, 0, OpType::Equal, 0.5));
+
+    std::vector<std::string> strings = {
+        "apple", "banana", "cherry", "grape", "melon"};
+    auto string_field_data = storage::CreateFieldData(DataType::VARCHAR, 1, N);
+    string_field_data->FillFieldData(strings.data(), N);
+    auto string_field_data_info = FieldDataInfo{
+        string_fid.get(), N, std::vector<FieldDataPtr>{string_field_data}};
+    segment->LoadFieldData(string_fid, string_field_data_info);
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::Equal, "coconut"));
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::Equal, "grape"));
+    ASSERT_TRUE(skip_index.CanSkipTerm<std::string_view>(
+        string_fid, 0, std::vector<std::string>{"coconut", "kiwi"}));
+    ASSERT_FALSE(skip_index.CanSkipTerm<std::string_view>(
+        string_fid, 0, std::vector<std::string>{"kiwi", "melon"}));
+
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PrefixMatch, "bana"));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PrefixMatch, "banjo"));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PrefixMatch, "kiw"));
+    // the patterns shorter than a trigram can't be ruled out
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PrefixMatch, "ki"));
+    ASSERT_FALSE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PostfixMatch, "rape"));
+    ASSERT_TRUE(skip_index.CanSkipUnaryRange<std::string>(
+        string_fid, 0, OpType::PostfixMatch, "lime"));
+}
+
 TEST(Sealed, QueryAllFields) {
     auto schema = std::make_shared<Schema>();
     auto metric_type = knowhere::metric::L2;
@@ -1703,3 +2590,438 @@ TEST(Sealed, QueryAllFields) {
     EXPECT_EQ(float_array_result->scalars().array_data().data_size(),
               dataset_size);
 }
+
+TEST(Sealed, SegmentSnapshot) {
+    auto dir = std::string("/tmp/test_segment_snapshot");
+    SegmentSnapshot snapshot(dir, 1);
+    snapshot.Remove();
+    auto fingerprint = SegmentSnapshot::Fingerprint({"b", "a"}, 3);
+    ASSERT_EQ(fingerprint, SegmentSnapshot::Fingerprint({"a", "b"}, 3));
+    ASSERT_NE(fingerprint, SegmentSnapshot::Fingerprint({"a", "b"}, 4));
+
+    ASSERT_EQ(snapshot.LoadPkOrder(fingerprint), nullptr);
+    std::vector<int64_t> order = {2, 0, 1};
+    snapshot.SavePkOrder(fingerprint, order);
+    auto file = snapshot.LoadPkOrder(fingerprint);
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(file->size(), order.size() * sizeof(int64_t));
+    ASSERT_EQ(memcmp(file->data(), order.data(), file->size()), 0);
+    // the snapshot of other binlogs is stale
+    ASSERT_EQ(snapshot.LoadPkOrder(fingerprint + 1), nullptr);
+    snapshot.Remove();
+    ASSERT_EQ(snapshot.LoadPkOrder(fingerprint), nullptr);
+
+    // the segments reloaded restore the pk index from the snapshot
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    fingerprint = SegmentSnapshot::Fingerprint({"pk_binlog"}, N);
+    auto pks = dataset.get_col<int64_t>(pk_fid);
+    IdArray id_array;
+    for (auto pk : pks) {
+        id_array.mutable_int_id()->add_data(pk);
+    }
+
+    auto& config = SegcoreConfig::default_config();
+    config.set_snapshot_dir(dir);
+    auto load = [&]() {
+        auto segment = CreateSealedSegment(schema, nullptr, 1);
+        SealedLoadFieldData(dataset, *segment, {pk_fid.get()});
+        FieldDataInfo info;
+        info.field_id = pk_fid.get();
+        info.row_count = N;
+        info.snapshot_fingerprint = fingerprint;
+        for (auto& field_data : dataset.raw_->fields_data()) {
+            if (field_data.field_id() == pk_fid.get()) {
+                info.channel->push(CreateFieldDataFromDataArray(
+                    N, &field_data, schema->operator[](pk_fid)));
+            }
+        }
+        info.channel->close();
+        segment->LoadFieldData(pk_fid, info);
+        auto [ids, seg_offsets] = segment->search_ids(id_array, MAX_TIMESTAMP);
+        std::vector<int64_t> offsets;
+        for (auto offset : seg_offsets) {
+            offsets.push_back(offset.get());
+        }
+        return offsets;
+    };
+    auto offsets = load();
+    ASSERT_EQ(offsets.size(), N);
+    ASSERT_NE(snapshot.LoadPkOrder(fingerprint), nullptr);
+    ASSERT_EQ(load(), offsets);
+    // the order which isn't of the rows is rebuilt
+    snapshot.SavePkOrder(fingerprint, {0});
+    ASSERT_EQ(load(), offsets);
+    ASSERT_EQ(snapshot.LoadPkOrder(fingerprint)->size(), N * sizeof(int64_t));
+
+    config.set_snapshot_dir("");
+    snapshot.Remove();
+}
+
+TEST(Sealed, HandoffGrowingSegment) {
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto array_fid =
+        schema->AddDebugField("array", DataType::ARRAY, DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+
+    // the rows span several chunks, the last one partially filled
+    auto& config = SegcoreConfig::default_config();
+    auto chunk_rows = config.get_chunk_rows();
+    config.set_chunk_rows(1000);
+    int64_t N = 2500;
+    auto dataset = DataGen(schema, N);
+    auto growing = CreateGrowingSegment(schema, empty_index_meta, 7, config);
+    growing->PreInsert(N);
+    growing->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+    auto pks = dataset.get_col<int64_t>(pk_fid);
+    std::vector<int64_t> deleted_pks(pks.begin(), pks.begin() + 10);
+    auto deleted_ids = GenPKs(deleted_pks);
+    auto deleted_tss = GenTss(deleted_pks.size(), N);
+    growing->Delete(
+        0, deleted_pks.size(), deleted_ids.get(), deleted_tss.data());
+    config.set_chunk_rows(chunk_rows);
+
+    auto growing_impl = dynamic_cast<SegmentGrowingImpl*>(growing.get());
+    auto sealed = HandoffGrowingSegment(*growing_impl, schema, nullptr);
+    auto sealed_impl = dynamic_cast<SegmentSealedImpl*>(sealed.get());
+    ASSERT_EQ(sealed->get_segment_id(), 7);
+    ASSERT_EQ(sealed->get_row_count(), N);
+    ASSERT_EQ(sealed->get_deleted_count(), deleted_pks.size());
+    ASSERT_EQ(sealed->get_real_count(), N - deleted_pks.size());
+
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    for (auto field_id : {vec_fid, pk_fid, str_fid, json_fid, array_fid}) {
+        ASSERT_TRUE(sealed->HasFieldData(field_id));
+        auto expected =
+            growing_impl->bulk_subscript(field_id, offsets.data(), N);
+        auto handed_off =
+            sealed_impl->bulk_subscript(field_id, offsets.data(), N);
+        ASSERT_EQ(handed_off->SerializeAsString(),
+                  expected->SerializeAsString());
+    }
+    // the pk index is built
+    IdArray id_array;
+    id_array.mutable_int_id()->add_data(pks[N - 1]);
+    auto [ids, seg_offsets] = sealed->search_ids(id_array, MAX_TIMESTAMP);
+    ASSERT_EQ(seg_offsets.size(), 1);
+    ASSERT_EQ(seg_offsets[0].get(), N - 1);
+}
+
+TEST(Sealed, CompactSegments) {
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    schema->set_primary_field_id(pk_fid);
+
+    auto root = std::string("/tmp/test_compact_segments");
+    auto cm = std::make_shared<milvus::storage::LocalChunkManager>(root);
+    // the pks of the second segment overlap the ones of the first
+    std::vector<GeneratedData> datasets;
+    datasets.push_back(DataGen(schema, 1000, 42));
+    datasets.push_back(DataGen(schema, 500, 43, 0, 2));
+    std::vector<CompactionSegment> segments;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        auto prefix = root + "/insert_log/" + std::to_string(i);
+        auto load_info = PrepareInsertBinlog(1, 2, i, prefix, datasets[i], cm);
+        CompactionSegment segment;
+        for (auto& [field_id, field_info] : load_info.field_infos) {
+            segment.field_binlogs[FieldId(field_id)] = field_info.insert_files;
+        }
+        segments.push_back(std::move(segment));
+    }
+    segments[0].deleted.resize(1000);
+    for (size_t i = 0; i < 1000; i += 3) {
+        segments[0].deleted[i] = true;
+    }
+
+    CompactionInfo info;
+    info.field_data_meta = {1, 2, 4, 0};
+    info.output_prefix = root + "/compacted";
+    info.max_rows_per_binlog = 400;
+    info.pk_field_id = pk_fid;
+    auto result = CompactSegments(cm.get(), segments, info);
+
+    // the expected rows sorted by (pk, segment, offset)
+    std::vector<std::tuple<int64_t, size_t, int64_t>> expected;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        auto pks = datasets[i].get_col<int64_t>(pk_fid);
+        for (int64_t offset = 0; offset < int64_t(pks.size()); ++offset) {
+            if (segments[i].deleted.empty() || !segments[i].deleted[offset]) {
+                expected.emplace_back(pks[offset], i, offset);
+            }
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    int64_t num_rows = expected.size();
+    ASSERT_EQ(result.num_rows, num_rows);
+    ASSERT_EQ(std::accumulate(
+                  result.binlog_rows.begin(), result.binlog_rows.end(), 0L),
+              num_rows);
+    ASSERT_EQ(result.binlog_rows.size(), (num_rows + 399) / 400);
+
+    auto read_field = [&](FieldId field_id) {
+        auto& binlogs = result.field_binlogs.at(field_id);
+        EXPECT_EQ(binlogs.size(), result.binlog_rows.size());
+        return milvus::storage::GetObjectData(cm.get(), binlogs);
+    };
+    int64_t row = 0;
+    for (auto& chunk : read_field(pk_fid)) {
+        for (size_t j = 0; j < chunk->Length(); ++j, ++row) {
+            ASSERT_EQ(*static_cast<const int64_t*>(chunk->RawValue(j)),
+                      std::get<0>(expected[row]));
+        }
+    }
+    ASSERT_EQ(row, num_rows);
+    std::vector<std::vector<std::string>> strs;
+    std::vector<std::vector<float>> vecs;
+    for (auto& dataset : datasets) {
+        strs.push_back(dataset.get_col<std::string>(str_fid));
+        vecs.push_back(dataset.get_col<float>(vec_fid));
+    }
+    row = 0;
+    for (auto& chunk : read_field(str_fid)) {
+        for (size_t j = 0; j < chunk->Length(); ++j, ++row) {
+            auto [pk, segment, offset] = expected[row];
+            ASSERT_EQ(*static_cast<const std::string*>(chunk->RawValue(j)),
+                      strs[segment][offset]);
+        }
+    }
+    ASSERT_EQ(row, num_rows);
+    row = 0;
+    for (auto& chunk : read_field(vec_fid)) {
+        auto data = static_cast<const float*>(chunk->Data());
+        for (size_t j = 0; j < chunk->Length(); ++j, ++row) {
+            auto [pk, segment, offset] = expected[row];
+            ASSERT_TRUE(std::equal(data + j * 16,
+                                   data + (j + 1) * 16,
+                                   vecs[segment].data() + offset * 16));
+        }
+    }
+    ASSERT_EQ(row, num_rows);
+    // the row ids are copied as any other field
+    ASSERT_EQ(result.field_binlogs.count(RowFieldID), 1);
+    cm->RemoveDir(root);
+}
+
+TEST(Sealed, ImportParquet) {
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 4, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto str_fid = schema->AddDebugField("string", DataType::VARCHAR);
+    schema->set_primary_field_id(pk_fid);
+
+    // the vectors are lists of floats, the row groups span the segments
+    int64_t N = 1000;
+    arrow::Int64Builder pk_builder;
+    arrow::ListBuilder vec_builder(arrow::default_memory_pool(),
+                                   std::make_shared<arrow::FloatBuilder>());
+    auto& element_builder =
+        static_cast<arrow::FloatBuilder&>(*vec_builder.value_builder());
+    arrow::StringBuilder str_builder;
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_TRUE(pk_builder.Append(N - i).ok());
+        ASSERT_TRUE(vec_builder.Append().ok());
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_TRUE(element_builder.Append(i * 4 + j).ok());
+        }
+        ASSERT_TRUE(str_builder.Append(std::to_string(i)).ok());
+    }
+    std::shared_ptr<arrow::Array> pks, vecs, strs;
+    ASSERT_TRUE(pk_builder.Finish(&pks).ok());
+    ASSERT_TRUE(vec_builder.Finish(&vecs).ok());
+    ASSERT_TRUE(str_builder.Finish(&strs).ok());
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("string", arrow::utf8()),
+                       arrow::field("int64", arrow::int64()),
+                       arrow::field("fakevec", arrow::list(arrow::float32()))}),
+        {strs, pks, vecs});
+    auto os = std::make_shared<milvus::storage::PayloadOutputStream>();
+    ASSERT_TRUE(parquet::arrow::WriteTable(
+                    *table, arrow::default_memory_pool(), os, 300)
+                    .ok());
+
+    auto root = std::string("/tmp/test_import_parquet");
+    auto cm = std::make_shared<milvus::storage::LocalChunkManager>(root);
+    auto source = root + "/source.parquet";
+    auto buffer = os->Buffer();
+    cm->Write(source, buffer.data(), buffer.size());
+
+    ImportInfo info;
+    info.field_data_meta = {1, 2, 10, 0};
+    info.output_prefix = root + "/imported";
+    info.max_rows_per_segment = 400;
+    info.row_id_begin = 5000;
+    info.timestamp = 77;
+    auto segments = ImportParquet(cm.get(), source, *schema, info);
+    ASSERT_EQ(segments.size(), 3);
+
+    int64_t row = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        auto& segment = segments[i];
+        ASSERT_EQ(segment.segment_id, int64_t(10 + i));
+        ASSERT_EQ(segment.num_rows, i < 2 ? 400 : 200);
+        ASSERT_EQ(segment.field_binlogs.size(), 5);
+        auto read_field = [&](FieldId field_id) {
+            auto datas = milvus::storage::GetObjectData(
+                cm.get(), segment.field_binlogs.at(field_id));
+            EXPECT_EQ(datas.size(), 1);
+            EXPECT_EQ(datas[0]->Length(), segment.num_rows);
+            return datas[0];
+        };
+        auto row_ids = read_field(RowFieldID);
+        auto timestamps = read_field(TimestampFieldID);
+        auto pk_data = read_field(pk_fid);
+        auto vec_data = read_field(vec_fid);
+        auto str_data = read_field(str_fid);
+        auto vec_values = static_cast<const float*>(vec_data->Data());
+        for (int64_t j = 0; j < segment.num_rows; ++j, ++row) {
+            ASSERT_EQ(*static_cast<const int64_t*>(row_ids->RawValue(j)),
+                      5000 + row);
+            ASSERT_EQ(*static_cast<const int64_t*>(timestamps->RawValue(j)),
+                      77);
+            ASSERT_EQ(*static_cast<const int64_t*>(pk_data->RawValue(j)),
+                      N - row);
+            for (int k = 0; k < 4; ++k) {
+                ASSERT_EQ(vec_values[j * 4 + k], row * 4 + k);
+            }
+            ASSERT_EQ(*static_cast<const std::string*>(str_data->RawValue(j)),
+                      std::to_string(row));
+        }
+    }
+    ASSERT_EQ(row, N);
+
+    // a column of another type than the field's is rejected up front
+    auto mismatched = std::make_shared<Schema>();
+    mismatched->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 4, knowhere::metric::L2);
+    mismatched->set_primary_field_id(
+        mismatched->AddDebugField("int64", DataType::INT64));
+    mismatched->AddDebugField("string", DataType::JSON);
+    info.output_prefix = root + "/mismatched";
+    ASSERT_ANY_THROW(ImportParquet(cm.get(), source, *mismatched, info));
+    ASSERT_FALSE(cm->DirExist(info.output_prefix));
+    cm->RemoveDir(root);
+}
+
+TEST(Sealed, FilterCache) {
+    // a bitset of the empty, the full and the mixed blocks, the last one
+    // partially used
+    BitsetType bitset(64 * 10 + 17);
+    for (size_t i = 64 * 3; i < 64 * 6; ++i) {
+        bitset[i] = true;
+    }
+    bitset[64 * 7 + 5] = true;
+    for (size_t i = 64 * 10; i < bitset.size(); ++i) {
+        bitset[i] = true;
+    }
+    auto words = query::FilterCache::Compress(bitset);
+    // the runs of the empty, the full and the empty blocks, the mixed block
+    // and its word, the run of the empty blocks and the full last block
+    ASSERT_EQ(words.size(), 7);
+    BitsetType decompressed;
+    query::FilterCache::Decompress(words, bitset.size(), decompressed);
+    ASSERT_EQ(decompressed, bitset);
+
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+
+    auto& cache = query::FilterCache::GetInstance();
+    cache.SetCapacity(1 << 20);
+    proto::plan::GenericValue val;
+    val.set_int64_val(N / 2);
+    auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(pk_fid, DataType::INT64), proto::plan::LessThan, val);
+    auto plan =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    auto hits = cache.hit_count();
+    query::ExecPlanNodeVisitor visitor(*segment, MAX_TIMESTAMP);
+    BitsetType evaluated;
+    visitor.ExecuteExprNode(plan, segment.get(), evaluated);
+    ASSERT_EQ(cache.hit_count(), hits);
+    ASSERT_GT(cache.size_bytes(), 0);
+
+    // the deletes don't invalidate the cached filter, they're masked after
+    auto pks = dataset.get_col<int64_t>(pk_fid);
+    std::vector<int64_t> deleted_pks(pks.begin(), pks.begin() + 10);
+    auto deleted_ids = GenPKs(deleted_pks);
+    auto deleted_tss = GenTss(deleted_pks.size(), N);
+    segment->Delete(
+        0, deleted_pks.size(), deleted_ids.get(), deleted_tss.data());
+    BitsetType cached;
+    visitor.ExecuteExprNode(plan, segment.get(), cached);
+    ASSERT_EQ(cache.hit_count(), hits + 1);
+    ASSERT_EQ(cached, evaluated);
+    ASSERT_EQ(cached.count(), N / 2);
+
+    // the entries of a released segment are dropped
+    segment.reset();
+    ASSERT_EQ(cache.size_bytes(), 0);
+    cache.SetCapacity(0);
+}
+
+TEST(Sealed, ArrayColumnViews) {
+    auto schema = std::make_shared<Schema>();
+    auto vec = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto int64_field = schema->AddDebugField("int64", DataType::INT64);
+    auto long_array_field =
+        schema->AddDebugField("long_array", DataType::ARRAY, DataType::INT64);
+    auto string_array_field = schema->AddDebugField(
+        "string_array", DataType::ARRAY, DataType::VARCHAR);
+    schema->set_primary_field_id(int64_field);
+
+    int64_t N = 1000;
+    auto dataset = DataGen(schema, N);
+    auto long_array_values = dataset.get_col<ScalarArray>(long_array_field);
+    auto string_array_values = dataset.get_col<ScalarArray>(string_array_field);
+
+    // the views of the rows point into the offsets of the elements of the
+    // column, kept in memory or mapped from the file
+    for (auto mmap : {false, true}) {
+        auto segment = CreateSealedSegment(schema);
+        SealedLoadFieldData(dataset, *segment, {}, mmap);
+        auto long_views = segment->chunk_data<ArrayView>(long_array_field, 0);
+        auto string_views =
+            segment->chunk_data<ArrayView>(string_array_field, 0);
+        ASSERT_EQ(long_views.row_count(), N);
+        ASSERT_EQ(string_views.row_count(), N);
+        for (int64_t i = 0; i < N; ++i) {
+            auto& longs = long_array_values[i].long_data().data();
+            ASSERT_EQ(long_views[i].length(), longs.size());
+            for (int j = 0; j < longs.size(); ++j) {
+                ASSERT_EQ(long_views[i].get_data<int64_t>(j), longs[j]);
+            }
+            auto& strings = string_array_values[i].string_data().data();
+            ASSERT_EQ(string_views[i].length(), strings.size());
+            for (int j = 0; j < strings.size(); ++j) {
+                ASSERT_EQ(string_views[i].get_data<std::string_view>(j),
+                          strings[j]);
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "storage/SharedMmapStore.h"
+
+using namespace milvus;
+using namespace milvus::storage;
+
+class SharedMmapStoreTest : public testing::Test {
+ public:
+    void
+    SetUp() override {
+        dir_ = "/tmp/test_shared_mmap_store";
+        std::filesystem::remove_all(dir_);
+    }
+
+    void
+    TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    static SharedMmapStore::Writer
+    WriteContent(const std::string& content, int* num_writes) {
+        return [content, num_writes](const std::string& path) {
+            std::ofstream out(path, std::ios::binary);
+            out << content;
+            ++*num_writes;
+        };
+    }
+
+    static std::string
+    ReadContent(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    int64_t
+    NumFiles() const {
+        return std::distance(std::filesystem::directory_iterator(dir_),
+                             std::filesystem::directory_iterator());
+    }
+
+ protected:
+    std::filesystem::path dir_;
+};
+
+TEST_F(SharedMmapStoreTest, Key) {
+    auto key = SharedMmapStore::Key("field", {"a/1", "a/2"}, "8");
+    ASSERT_EQ(key, SharedMmapStore::Key("field", {"a/2", "a/1"}, "8"));
+    ASSERT_NE(key, SharedMmapStore::Key("field", {"a/1", "a/2"}, "4"));
+    ASSERT_NE(key, SharedMmapStore::Key("field", {"a/1a/2"}, "8"));
+    ASSERT_NE(key, SharedMmapStore::Key("index", {"a/1", "a/2"}, "8"));
+    ASSERT_EQ(key.rfind("field-", 0), 0);
+}
+
+TEST_F(SharedMmapStoreTest, WrittenOnce) {
+    SharedMmapStore store(dir_);
+    auto key = SharedMmapStore::Key("chunk", {"insert_log/1/2/3"});
+    int num_writes = 0;
+    auto lease = store.Acquire(key, WriteContent("abc", &num_writes));
+    ASSERT_EQ(num_writes, 1);
+    ASSERT_EQ(ReadContent(lease->Path()), "abc");
+    ASSERT_EQ(lease->Size(), 3);
+
+    // another process is another store of the same dir
+    SharedMmapStore other(dir_);
+    auto other_lease = other.Acquire(key, WriteContent("abc", &num_writes));
+    ASSERT_EQ(num_writes, 1);
+    ASSERT_EQ(other_lease->Path(), lease->Path());
+
+    // removed with the last lease
+    lease.reset();
+    ASSERT_TRUE(std::filesystem::exists(other_lease->Path()));
+    auto path = other_lease->Path();
+    other_lease.reset();
+    ASSERT_FALSE(std::filesystem::exists(path));
+    ASSERT_EQ(NumFiles(), 0);
+
+    lease = store.Acquire(key, WriteContent("abc", &num_writes));
+    ASSERT_EQ(num_writes, 2);
+}
+
+TEST_F(SharedMmapStoreTest, WriteFailure) {
+    SharedMmapStore store(dir_);
+    auto key = SharedMmapStore::Key("chunk", {"insert_log/1/2/3"});
+    ASSERT_ANY_THROW(store.Acquire(key, [](const std::string& path) {
+        std::ofstream out(path, std::ios::binary);
+        out << "partial";
+        throw std::runtime_error("failed to download");
+    }));
+    ASSERT_EQ(NumFiles(), 0);
+
+    int num_writes = 0;
+    auto lease = store.Acquire(key, WriteContent("abc", &num_writes));
+    ASSERT_EQ(num_writes, 1);
+    ASSERT_EQ(ReadContent(lease->Path()), "abc");
+}
+
+TEST_F(SharedMmapStoreTest, RemoveUnheld) {
+    auto held_key = SharedMmapStore::Key("chunk", {"held"});
+    auto left_key = SharedMmapStore::Key("chunk", {"left"});
+    int num_writes = 0;
+    auto store = std::make_unique<SharedMmapStore>(dir_);
+    auto lease = store->Acquire(held_key, WriteContent("abc", &num_writes));
+    // the files of an exited process, its ref file unlocked
+    std::ofstream(dir_ / left_key) << "abc";
+    std::ofstream(dir_ / (left_key + ".ref"));
+    std::ofstream(dir_ / (left_key + ".tmp.0123456789abcdef")) << "ab";
+
+    SharedMmapStore reopened(dir_);
+    ASSERT_TRUE(std::filesystem::exists(lease->Path()));
+    ASSERT_FALSE(std::filesystem::exists(dir_ / left_key));
+    // the held file and its ref file
+    ASSERT_EQ(NumFiles(), 2);
+}
@@ -13,11 +13,14 @@
 
 #include <boost/format.hpp>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <utility>
 #include <boost/container/vector.hpp>
 
 using namespace std;
@@ -984,11 +987,349 @@ TEST(LogicalBool, performance) {
     }
 }
 
+TEST(GreaterThanTimestamp, function) {
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<uint64_t> dist(0, 1000);
+    for (int64_t size : {0, 1, 63, 64, 65, 200, 8192}) {
+        std::vector<uint64_t> src(size);
+        for (auto& ts : src) {
+            ts = dist(e);
+        }
+        auto num_blocks = (size + 63) / 64;
+        for (uint64_t val : {uint64_t(0), uint64_t(500), UINT64_MAX}) {
+            std::vector<BitsetBlockType> ref(num_blocks);
+            GreaterThanTimestampRef(src.data(), size, val, ref.data());
+            for (int64_t i = 0; i < size; ++i) {
+                EXPECT_EQ(bool((ref[i / 64] >> (i % 64)) & 1), src[i] > val);
+            }
+            if (cpu_support_avx2()) {
+                std::vector<BitsetBlockType> res(num_blocks);
+                GreaterThanTimestampAVX2(src.data(), size, val, res.data());
+                EXPECT_EQ(res, ref);
+            }
+            if (cpu_support_avx512()) {
+                std::vector<BitsetBlockType> res(num_blocks);
+                GreaterThanTimestampAVX512(src.data(), size, val, res.data());
+                EXPECT_EQ(res, ref);
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+TestCompareKernels() {
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<int> dist(-10, 10);
+    for (size_t size : {0, 1, 15, 16, 17, 63, 64, 65, 1000}) {
+        std::vector<T> src(size);
+        for (auto& x : src) {
+            x = T(dist(e));
+        }
+        if (size > 3) {
+            src[1] = std::numeric_limits<T>::lowest();
+            src[2] = std::numeric_limits<T>::max();
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            // the NaNs are false but for NE
+            for (size_t i = 7; i < size; i += 13) {
+                src[i] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+        std::vector<uint8_t> ref(size), res(size);
+        for (auto op : {CompareOp::EQ,
+                        CompareOp::NE,
+                        CompareOp::GT,
+                        CompareOp::GE,
+                        CompareOp::LT,
+                        CompareOp::LE}) {
+            auto ref_data = reinterpret_cast<bool*>(ref.data());
+            auto res_data = reinterpret_cast<bool*>(res.data());
+            CompareValRef<T>(src.data(), size, T(5), op, ref_data);
+            for (size_t i = 0; i < size; ++i) {
+                auto x = src[i];
+                bool expected = op == CompareOp::EQ   ? x == T(5)
+                                : op == CompareOp::NE ? x != T(5)
+                                : op == CompareOp::GT ? x > T(5)
+                                : op == CompareOp::GE ? x >= T(5)
+                                : op == CompareOp::LT ? x < T(5)
+                                                      : x <= T(5);
+                EXPECT_EQ(ref_data[i], expected);
+            }
+            if (cpu_support_avx2()) {
+                CompareValAVX2<T>(src.data(), size, T(5), op, res_data);
+                EXPECT_EQ(res, ref);
+            }
+            if (cpu_support_avx512()) {
+                CompareValAVX512<T>(src.data(), size, T(5), op, res_data);
+                EXPECT_EQ(res, ref);
+            }
+        }
+        // the other column shares the limits and the NaNs at the positions
+        // of the values, so they are compared with themselves too
+        std::vector<T> other(src.rbegin(), src.rend());
+        for (size_t i = 0; i < size; i += 3) {
+            other[i] = src[i];
+        }
+        for (auto op : {CompareOp::EQ,
+                        CompareOp::NE,
+                        CompareOp::GT,
+                        CompareOp::GE,
+                        CompareOp::LT,
+                        CompareOp::LE}) {
+            auto ref_data = reinterpret_cast<bool*>(ref.data());
+            auto res_data = reinterpret_cast<bool*>(res.data());
+            CompareColumnRef<T>(src.data(), other.data(), size, op, ref_data);
+            for (size_t i = 0; i < size; ++i) {
+                auto x = src[i];
+                auto y = other[i];
+                bool expected = op == CompareOp::EQ   ? x == y
+                                : op == CompareOp::NE ? x != y
+                                : op == CompareOp::GT ? x > y
+                                : op == CompareOp::GE ? x >= y
+                                : op == CompareOp::LT ? x < y
+                                                      : x <= y;
+                EXPECT_EQ(ref_data[i], expected);
+            }
+            if (cpu_support_avx2()) {
+                CompareColumnAVX2<T>(
+                    src.data(), other.data(), size, op, res_data);
+                EXPECT_EQ(res, ref);
+            }
+            if (cpu_support_avx512()) {
+                CompareColumnAVX512<T>(
+                    src.data(), other.data(), size, op, res_data);
+                EXPECT_EQ(res, ref);
+            }
+        }
+        // the bounds at the limits of the integers make empty ranges when
+        // exclusive
+        std::vector<std::pair<T, T>> bounds{{T(3), T(7)},
+                                            {T(7), T(3)},
+                                            {T(5), T(5)},
+                                            {T(-8), T(2)},
+                                            {std::numeric_limits<T>::lowest(),
+                                             std::numeric_limits<T>::max()}};
+        for (auto [lower, upper] : bounds) {
+            for (auto [lower_inclusive, upper_inclusive] :
+                 {std::pair{true, true},
+                  std::pair{true, false},
+                  std::pair{false, true},
+                  std::pair{false, false}}) {
+                auto ref_data = reinterpret_cast<bool*>(ref.data());
+                auto res_data = reinterpret_cast<bool*>(res.data());
+                CompareRangeRef<T>(src.data(),
+                                   size,
+                                   lower,
+                                   upper,
+                                   lower_inclusive,
+                                   upper_inclusive,
+                                   ref_data);
+                for (size_t i = 0; i < size; ++i) {
+                    auto x = src[i];
+                    bool expected =
+                        (lower_inclusive ? lower <= x : lower < x) &&
+                        (upper_inclusive ? x <= upper : x < upper);
+                    EXPECT_EQ(ref_data[i], expected);
+                }
+                if (cpu_support_avx2()) {
+                    CompareRangeAVX2<T>(src.data(),
+                                        size,
+                                        lower,
+                                        upper,
+                                        lower_inclusive,
+                                        upper_inclusive,
+                                        res_data);
+                    EXPECT_EQ(res, ref);
+                }
+                if (cpu_support_avx512()) {
+                    CompareRangeAVX512<T>(src.data(),
+                                          size,
+                                          lower,
+                                          upper,
+                                          lower_inclusive,
+                                          upper_inclusive,
+                                          res_data);
+                    EXPECT_EQ(res, ref);
+                }
+            }
+        }
+    }
+}
+
+TEST(CompareKernels, function) {
+    TestCompareKernels<int8_t>();
+    TestCompareKernels<int16_t>();
+    TestCompareKernels<int32_t>();
+    TestCompareKernels<int64_t>();
+    TestCompareKernels<float>();
+    TestCompareKernels<double>();
+}
+
+TEST(Float16Distance, function) {
+    EXPECT_EQ(Float16ToFloatRef(0x3c00), 1.0f);
+    EXPECT_EQ(Float16ToFloatRef(0xc000), -2.0f);
+    EXPECT_EQ(Float16ToFloatRef(0x0000), 0.0f);
+    EXPECT_EQ(Float16ToFloatRef(0x0001), std::ldexp(1.0f, -24));
+    EXPECT_EQ(Float16ToFloatRef(0x7c00),
+              std::numeric_limits<float>::infinity());
+
+    std::default_random_engine e(42);
+    // the values of magnitudes in [2^-5, 2^6)
+    std::uniform_int_distribution<uint16_t> sign(0, 1);
+    std::uniform_int_distribution<uint16_t> exponent(10, 20);
+    std::uniform_int_distribution<uint16_t> mantissa(0, 0x3ff);
+    for (size_t dim : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 128, 1000}) {
+        std::vector<uint16_t> x(dim), y(dim);
+        for (size_t i = 0; i < dim; ++i) {
+            x[i] = sign(e) << 15 | exponent(e) << 10 | mantissa(e);
+            y[i] = sign(e) << 15 | exponent(e) << 10 | mantissa(e);
+        }
+        auto l2 = L2SqrFloat16Ref(x.data(), y.data(), dim);
+        auto ip = InnerProductFloat16Ref(x.data(), y.data(), dim);
+        // the rounding errors of the sums are bounded by the norms
+        auto eps = 1e-5 * (1 + InnerProductFloat16Ref(x.data(), x.data(), dim) +
+                           InnerProductFloat16Ref(y.data(), y.data(), dim));
+        if (cpu_support_avx2() && cpu_support_f16c()) {
+            EXPECT_NEAR(L2SqrFloat16AVX2(x.data(), y.data(), dim), l2, eps);
+            EXPECT_NEAR(
+                InnerProductFloat16AVX2(x.data(), y.data(), dim), ip, eps);
+        }
+        if (cpu_support_avx512()) {
+            EXPECT_NEAR(L2SqrFloat16AVX512(x.data(), y.data(), dim), l2, eps);
+            EXPECT_NEAR(
+                InnerProductFloat16AVX512(x.data(), y.data(), dim), ip, eps);
+        }
+    }
+}
+
+TEST(FloatDistance, function) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> value(-1, 1);
+    for (size_t dim : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 128, 1000}) {
+        std::vector<float> x(dim), y(dim);
+        for (size_t i = 0; i < dim; ++i) {
+            x[i] = value(e);
+            y[i] = value(e);
+        }
+        auto ip = InnerProductFloatRef(x.data(), y.data(), dim);
+        auto eps = 1e-5 * (1 + InnerProductFloatRef(x.data(), x.data(), dim) +
+                           InnerProductFloatRef(y.data(), y.data(), dim));
+        if (cpu_support_avx2()) {
+            EXPECT_NEAR(
+                InnerProductFloatAVX2(x.data(), y.data(), dim), ip, eps);
+        }
+        if (cpu_support_avx512()) {
+            EXPECT_NEAR(
+                InnerProductFloatAVX512(x.data(), y.data(), dim), ip, eps);
+        }
+    }
+
+    // the kernels unrolled for the specialized dims
+    EXPECT_EQ(InnerProductFloatOfDimAVX2(100), nullptr);
+    EXPECT_EQ(InnerProductFloatOfDimAVX512(100), nullptr);
+    for (auto dim : SPECIALIZED_DIMS) {
+        std::vector<float> x(dim), y(dim);
+        for (size_t i = 0; i < dim; ++i) {
+            x[i] = value(e);
+            y[i] = value(e);
+        }
+        auto ip = InnerProductFloatRef(x.data(), y.data(), dim);
+        auto eps = 1e-5 * (1 + InnerProductFloatRef(x.data(), x.data(), dim) +
+                           InnerProductFloatRef(y.data(), y.data(), dim));
+        EXPECT_NEAR(inner_product_float_of(dim)(x.data(), y.data(), dim),
+                    ip,
+                    eps);
+        if (cpu_support_avx2()) {
+            auto kernel = InnerProductFloatOfDimAVX2(dim);
+            ASSERT_NE(kernel, nullptr);
+            EXPECT_NEAR(kernel(x.data(), y.data(), dim), ip, eps);
+        }
+        if (cpu_support_avx512()) {
+            auto kernel = InnerProductFloatOfDimAVX512(dim);
+            ASSERT_NE(kernel, nullptr);
+            EXPECT_NEAR(kernel(x.data(), y.data(), dim), ip, eps);
+        }
+    }
+}
+
+TEST(BinaryDistance, function) {
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<size_t> dims = {0, 8, 56, 64, 136, 248, 264, 1000};
+    dims.insert(dims.end(),
+                SPECIALIZED_BINARY_DIMS.begin(),
+                SPECIALIZED_BINARY_DIMS.end());
+    for (auto dim : dims) {
+        auto bytes = dim / 8;
+        std::vector<uint8_t> x(bytes), y(bytes);
+        for (size_t i = 0; i < bytes; ++i) {
+            x[i] = byte(e);
+            y[i] = byte(e);
+        }
+        auto hamming = HammingBinaryRef(x.data(), y.data(), bytes);
+        auto jaccard = JaccardBinaryRef(x.data(), y.data(), bytes);
+        EXPECT_EQ(hamming_binary_of(dim)(x.data(), y.data(), bytes), hamming);
+        EXPECT_FLOAT_EQ(jaccard_binary_of(dim)(x.data(), y.data(), bytes),
+                        jaccard);
+        if (cpu_support_avx2()) {
+            EXPECT_EQ(HammingBinaryAVX2(x.data(), y.data(), bytes), hamming);
+            EXPECT_FLOAT_EQ(JaccardBinaryAVX2(x.data(), y.data(), bytes),
+                            jaccard);
+            if (auto kernel = HammingBinaryOfDimAVX2(dim)) {
+                EXPECT_EQ(kernel(x.data(), y.data(), bytes), hamming);
+            }
+            if (auto kernel = JaccardBinaryOfDimAVX2(dim)) {
+                EXPECT_FLOAT_EQ(kernel(x.data(), y.data(), bytes), jaccard);
+            }
+        }
+        if (cpu_support_avx512_vpopcntdq()) {
+            EXPECT_EQ(HammingBinaryAVX512(x.data(), y.data(), bytes), hamming);
+            EXPECT_FLOAT_EQ(JaccardBinaryAVX512(x.data(), y.data(), bytes),
+                            jaccard);
+            if (auto kernel = HammingBinaryOfDimAVX512(dim)) {
+                EXPECT_EQ(kernel(x.data(), y.data(), bytes), hamming);
+            }
+            if (auto kernel = JaccardBinaryOfDimAVX512(dim)) {
+                EXPECT_FLOAT_EQ(kernel(x.data(), y.data(), bytes), jaccard);
+            }
+        }
+    }
+}
+
+TEST(Crc32c, function) {
+    const std::string check = "123456789";
+    EXPECT_EQ(Crc32cRef(0, check.data(), check.size()), 0xe3069283);
+    EXPECT_EQ(Crc32cRef(0, nullptr, 0), 0u);
+
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> data(1024);
+    for (auto& b : data) {
+        b = byte(e);
+    }
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t size : {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000}) {
+            auto crc = Crc32cRef(0, data.data() + offset, size);
+            // continued from the checksum of the bytes before
+            EXPECT_EQ(Crc32cRef(Crc32cRef(0, data.data(), offset),
+                                data.data() + offset,
+                                size),
+                      Crc32cRef(0, data.data(), offset + size));
+            if (cpu_support_sse4_2()) {
+                EXPECT_EQ(Crc32cSSE4(0, data.data() + offset, size), crc);
+            }
+        }
+    }
+}
+
 #endif
 
 #if defined(__ARM_NEON)
+#include "simd/hook.h"
 #include "simd/ref.h"
 #include "simd/neon.h"
+#include "simd/sve.h"
 using namespace milvus::simd;
 
 #include <arm_neon.h>
@@ -1214,6 +1555,211 @@ TEST(AllBooleanNeon, performance) {
     }
 }
 
+TEST(GreaterThanTimestampNeon, function) {
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<uint64_t> dist(0, 1000);
+    for (int64_t size : {0, 1, 63, 64, 65, 200, 8192}) {
+        std::vector<uint64_t> src(size);
+        for (auto& ts : src) {
+            ts = dist(e);
+        }
+        auto num_blocks = (size + 63) / 64;
+        for (uint64_t val : {uint64_t(0), uint64_t(500), UINT64_MAX}) {
+            std::vector<BitsetBlockType> ref(num_blocks);
+            std::vector<BitsetBlockType> res(num_blocks);
+            GreaterThanTimestampRef(src.data(), size, val, ref.data());
+            GreaterThanTimestampNEON(src.data(), size, val, res.data());
+            EXPECT_EQ(res, ref);
+        }
+    }
+}
+
+template <typename T>
+void
+TestCompareKernelsNeon() {
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<int> dist(0, 10);
+    for (size_t size : {0, 1, 15, 16, 17, 63, 64, 65, 1000}) {
+        std::vector<T> src(size);
+        for (auto& x : src) {
+            x = T(dist(e));
+        }
+        std::vector<uint8_t> ref(size), res(size);
+        auto ref_data = reinterpret_cast<bool*>(ref.data());
+        auto res_data = reinterpret_cast<bool*>(res.data());
+        for (auto op : {CompareOp::EQ,
+                        CompareOp::NE,
+                        CompareOp::GT,
+                        CompareOp::GE,
+                        CompareOp::LT,
+                        CompareOp::LE}) {
+            CompareValRef<T>(src.data(), size, T(5), op, ref_data);
+            CompareValNEON<T>(src.data(), size, T(5), op, res_data);
+            EXPECT_EQ(res, ref);
+        }
+        CompareRangeRef<T>(src.data(), size, T(3), T(7), true, false, ref_data);
+        CompareRangeNEON<T>(
+            src.data(), size, T(3), T(7), true, false, res_data);
+        EXPECT_EQ(res, ref);
+    }
+}
+
+TEST(CompareKernelsNeon, function) {
+    TestCompareKernelsNeon<int8_t>();
+    TestCompareKernelsNeon<int16_t>();
+    TestCompareKernelsNeon<int32_t>();
+    TestCompareKernelsNeon<int64_t>();
+    TestCompareKernelsNeon<float>();
+    TestCompareKernelsNeon<double>();
+}
+
+TEST(SVE, function) {
+    if (!cpu_support_sve()) {
+        PRINT_SKPI_TEST
+        return;
+    }
+    std::default_random_engine e(42);
+    for (int64_t size : {0, 1, 15, 16, 17, 64, 100, 8192}) {
+        FixedVector<bool> left(size), right(size);
+        for (int64_t i = 0; i < size; ++i) {
+            left[i] = e() % 2;
+            right[i] = e() % 2;
+        }
+        EXPECT_EQ(AllFalseSVE(left.data(), size),
+                  AllFalseRef(left.data(), size));
+        EXPECT_EQ(AllTrueSVE(left.data(), size),
+                  AllTrueRef(left.data(), size));
+
+        auto ref = left;
+        auto res = left;
+        InvertBoolRef(ref.data(), size);
+        InvertBoolSVE(res.data(), size);
+        EXPECT_EQ(res, ref);
+        AndBoolRef(ref.data(), right.data(), size);
+        AndBoolSVE(res.data(), right.data(), size);
+        EXPECT_EQ(res, ref);
+        OrBoolRef(ref.data(), left.data(), size);
+        OrBoolSVE(res.data(), left.data(), size);
+        EXPECT_EQ(res, ref);
+
+        for (int64_t i = 0; i + 64 <= size; i += 64) {
+            EXPECT_EQ(GetBitsetBlockSVE(left.data() + i),
+                      GetBitsetBlockRef(left.data() + i));
+        }
+
+        std::vector<int32_t> src(size);
+        for (auto& x : src) {
+            x = e() % 100;
+        }
+        for (int32_t val : {0, 42, 100}) {
+            EXPECT_EQ(FindTermSVE(src.data(), src.size(), val),
+                      FindTermRef(src.data(), src.size(), val));
+        }
+        std::vector<double> dsrc(src.begin(), src.end());
+        for (double val : {0.0, 42.0, 100.0}) {
+            EXPECT_EQ(FindTermSVE(dsrc.data(), dsrc.size(), val),
+                      FindTermRef(dsrc.data(), dsrc.size(), val));
+        }
+
+        std::vector<uint8_t> cmp_ref(size), cmp_res(size);
+        auto cmp_ref_data = reinterpret_cast<bool*>(cmp_ref.data());
+        auto cmp_res_data = reinterpret_cast<bool*>(cmp_res.data());
+        CompareValRef(src.data(), size, 42, CompareOp::LT, cmp_ref_data);
+        CompareValSVE(src.data(), size, 42, CompareOp::LT, cmp_res_data);
+        EXPECT_EQ(cmp_res, cmp_ref);
+        CompareRangeRef(src.data(), size, 10, 90, true, false, cmp_ref_data);
+        CompareRangeSVE(src.data(), size, 10, 90, true, false, cmp_res_data);
+        EXPECT_EQ(cmp_res, cmp_ref);
+    }
+}
+
+TEST(SVE, performance) {
+    if (!cpu_support_sve()) {
+        PRINT_SKPI_TEST
+        return;
+    }
+    FixedVector<bool> left, right;
+    for (int i = 0; i < 8192; ++i) {
+        left.push_back(i % 2 == 0);
+        right.push_back(i % 3 == 0);
+    }
+    auto elapsed = [](auto&& func) {
+        auto start = std::chrono::system_clock::now();
+        for (int j = 0; j < 100; ++j) {
+            func();
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now() - start)
+                   .count();
+    };
+    std::cout << "and bool NEON: " << elapsed([&] {
+        AndBoolNEON(left.data(), right.data(), left.size());
+    }) << std::endl;
+    std::cout << "and bool SVE: " << elapsed([&] {
+        AndBoolSVE(left.data(), right.data(), left.size());
+    }) << std::endl;
+    std::cout << "all false NEON: "
+              << elapsed([&] { AllFalseNEON(right.data(), right.size()); })
+              << std::endl;
+    std::cout << "all false SVE: "
+              << elapsed([&] { AllFalseSVE(right.data(), right.size()); })
+              << std::endl;
+    std::vector<int32_t> src(8192, 1);
+    FixedVector<bool> res(8192);
+    std::cout << "compare NEON: " << elapsed([&] {
+        CompareValNEON(src.data(), src.size(), 1, CompareOp::EQ, res.data());
+    }) << std::endl;
+    std::cout << "compare SVE: " << elapsed([&] {
+        CompareValSVE(src.data(), src.size(), 1, CompareOp::EQ, res.data());
+    }) << std::endl;
+}
+
+TEST(Float16DistanceNeon, function) {
+    std::default_random_engine e(42);
+    // the values of magnitudes in [2^-5, 2^6)
+    std::uniform_int_distribution<uint16_t> sign(0, 1);
+    std::uniform_int_distribution<uint16_t> exponent(10, 20);
+    std::uniform_int_distribution<uint16_t> mantissa(0, 0x3ff);
+    for (size_t dim : {0, 1, 7, 8, 9, 16, 17, 100, 128, 1000}) {
+        std::vector<uint16_t> x(dim), y(dim);
+        for (size_t i = 0; i < dim; ++i) {
+            x[i] = sign(e) << 15 | exponent(e) << 10 | mantissa(e);
+            y[i] = sign(e) << 15 | exponent(e) << 10 | mantissa(e);
+        }
+        // the rounding errors of the sums are bounded by the norms
+        auto eps = 1e-5 * (1 + InnerProductFloat16Ref(x.data(), x.data(), dim) +
+                           InnerProductFloat16Ref(y.data(), y.data(), dim));
+        EXPECT_NEAR(L2SqrFloat16NEON(x.data(), y.data(), dim),
+                    L2SqrFloat16Ref(x.data(), y.data(), dim),
+                    eps);
+        EXPECT_NEAR(InnerProductFloat16NEON(x.data(), y.data(), dim),
+                    InnerProductFloat16Ref(x.data(), y.data(), dim),
+                    eps);
+    }
+}
+
+TEST(Crc32cNeon, function) {
+    if (!cpu_support_crc32()) {
+        PRINT_SKPI_TEST
+        return;
+    }
+    const std::string check = "123456789";
+    EXPECT_EQ(Crc32cNEON(0, check.data(), check.size()), 0xe3069283);
+
+    std::default_random_engine e(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> data(1024);
+    for (auto& b : data) {
+        b = byte(e);
+    }
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t size : {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000}) {
+            EXPECT_EQ(Crc32cNEON(0, data.data() + offset, size),
+                      Crc32cRef(0, data.data() + offset, size));
+        }
+    }
+}
+
 #endif
 
 int
@@ -11,12 +11,20 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include "common/EasyAssert.h"
 #include "storage/prometheus_client.h"
+#include "storage/ReadHedging.h"
+#include "storage/LoadContext.h"
+#include "storage/ThreadPool.h"
 #include "storage/LocalChunkManagerSingleton.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "storage/storage_c.h"
@@ -150,3 +158,155 @@ TEST_F(StorageTest, GetStorageMetrics) {
             0, strncmp(currentLine, familyName.c_str(), familyName.length()));
     }
 }
+
+TEST(ReadHedging, HistogramPercentile) {
+    prometheus::Histogram histogram({1, 2, 4, 8});
+    EXPECT_FALSE(HistogramPercentile(histogram, 0.95, 1).has_value());
+
+    // 90 of 1ms, 8 of 3ms and 2 of 100ms
+    for (int i = 0; i < 90; i++) {
+        histogram.Observe(1);
+    }
+    for (int i = 0; i < 8; i++) {
+        histogram.Observe(3);
+    }
+    histogram.Observe(100);
+    histogram.Observe(100);
+    EXPECT_FALSE(HistogramPercentile(histogram, 0.95, 101).has_value());
+    EXPECT_EQ(HistogramPercentile(histogram, 0.5, 100), 1);
+    EXPECT_EQ(HistogramPercentile(histogram, 0.8, 100), 1);
+    EXPECT_EQ(HistogramPercentile(histogram, 0.95, 100), 4);
+    EXPECT_EQ(HistogramPercentile(histogram, 0.97, 100), 4);
+    // beyond the largest bound
+    EXPECT_FALSE(HistogramPercentile(histogram, 0.99, 100).has_value());
+}
+
+TEST(ReadHedging, AdaptiveConcurrencyLimit) {
+    AdaptiveConcurrencyLimit limit(8);
+    EXPECT_EQ(limit.Limit(), 8);
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(limit.HasCapacity());
+        limit.OnStart();
+    }
+    EXPECT_FALSE(limit.HasCapacity());
+
+    // a burst of slow requests halves the limit once per limit requests
+    for (int i = 0; i < 4; i++) {
+        limit.OnFinish(false);
+    }
+    EXPECT_EQ(limit.Limit(), 4);
+    limit.OnFinish(false);
+    EXPECT_EQ(limit.Limit(), 2);
+
+    // every limit requests in time raise it by one, up to the max
+    for (int i = 0; i < 100; i++) {
+        limit.OnStart();
+        limit.OnFinish(true);
+    }
+    EXPECT_EQ(limit.Limit(), 8);
+
+    EXPECT_EQ(AdaptiveConcurrencyLimit::ForEndpoint("a:9000", 4),
+              AdaptiveConcurrencyLimit::ForEndpoint("a:9000", 16));
+    EXPECT_EQ(AdaptiveConcurrencyLimit::ForEndpoint("a:9000", 16)->Limit(), 4);
+    EXPECT_NE(AdaptiveConcurrencyLimit::ForEndpoint("a:9000", 4),
+              AdaptiveConcurrencyLimit::ForEndpoint("b:9000", 4));
+}
+
+TEST(LoadContext, ThreadPool) {
+    EXPECT_EQ(GetLoadContext(), nullptr);
+    auto context = std::make_shared<LoadContext>();
+    ThreadPool pool(1, "test_load_context");
+    ThreadPool nested_pool(1, "test_load_context_nested");
+    {
+        ScopedLoadContext scoped(context);
+        // the tasks submitted by the tasks run under the context too
+        auto future = pool.Submit([&nested_pool] {
+            return nested_pool.Submit([] { return GetLoadContext(); }).get();
+        });
+        EXPECT_EQ(future.get(), context);
+    }
+    EXPECT_EQ(GetLoadContext(), nullptr);
+    EXPECT_EQ(pool.Submit([] { return GetLoadContext(); }).get(), nullptr);
+
+    context->AddDownloadedBytes(10);
+    context->AddDecodedBytes(20);
+    EXPECT_EQ(context->DownloadedBytes(), 10);
+    EXPECT_EQ(context->DecodedBytes(), 20);
+    context->CheckCanceled();
+    context->Cancel();
+    try {
+        context->CheckCanceled();
+        FAIL();
+    } catch (milvus::SegcoreError& e) {
+        EXPECT_EQ(e.get_error_code(), milvus::Canceled);
+    }
+}
+
+TEST(ThreadPool, RunClaimed) {
+    ThreadPool pool(1, "test_run_claimed");
+    // the tasks running on all the workers wait for the nested tasks, which
+    // are run by the waiting callers if no worker is left
+    std::atomic<int64_t> count{0};
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 4 * CPU_NUM; i++) {
+        futures.push_back(pool.Submit([&] {
+            pool.RunClaimed(8, 8, [&](int64_t) {
+                pool.RunClaimed(4, 4, [&](int64_t) { count++; });
+            });
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    EXPECT_EQ(count.load(), 4 * CPU_NUM * 8 * 4);
+
+    // the first error is rethrown once all the tasks are done
+    std::atomic<int64_t> done{0};
+    EXPECT_THROW(pool.RunClaimed(16,
+                                 4,
+                                 [&](int64_t i) {
+                                     done++;
+                                     if (i % 5 == 0) {
+                                         throw std::runtime_error("error");
+                                     }
+                                 }),
+                 std::runtime_error);
+    EXPECT_EQ(done.load(), 16);
+}
+
+TEST(LoadContext, LoadBudget) {
+    auto& budget = LoadBudget::GetInstance();
+    budget.SetLimits(100, 0);
+    {
+        // a file larger than the budget is let through alone
+        LoadBudgetGuard large(200, nullptr);
+        EXPECT_EQ(budget.InflightBytes(), 200);
+
+        auto context = std::make_shared<LoadContext>();
+        std::atomic<bool> acquired{false};
+        std::thread waiter([&] {
+            try {
+                LoadBudgetGuard guard(50, context.get());
+                acquired = true;
+            } catch (milvus::SegcoreError& e) {
+                EXPECT_EQ(e.get_error_code(), milvus::Canceled);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(acquired.load());
+        context->Cancel();
+        waiter.join();
+        EXPECT_FALSE(acquired.load());
+    }
+    EXPECT_EQ(budget.InflightBytes(), 0);
+
+    // 1000 bytes per second, the second acquire waits for the first
+    budget.SetLimits(0, 1000);
+    auto start = std::chrono::steady_clock::now();
+    { LoadBudgetGuard first(50, nullptr); }
+    { LoadBudgetGuard second(50, nullptr); }
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(40));
+    budget.SetLimits(0, 0);
+}
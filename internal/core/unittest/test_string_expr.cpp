@@ -22,6 +22,7 @@
 #include "test_utils/DataGen.h"
 #include "query/PlanProto.h"
 #include "query/Utils.h"
+#include "common/LikePattern.h"
 #include "query/SearchBruteForce.h"
 
 using namespace milvus;
@@ -514,6 +515,19 @@ TEST(StringExpr, UnaryRange) {
             {proto::plan::OpType::PrefixMatch,
              "a",
              [](std::string& val) { return PrefixMatch(val, "a"); }},
+            {proto::plan::OpType::PostfixMatch,
+             "12",
+             [](std::string& val) { return PostfixMatch(val, "12"); }},
+            {proto::plan::OpType::Match,
+             "%12%3%",
+             [](std::string& val) {
+                 return std::regex_match(val, std::regex(".*12.*3.*"));
+             }},
+            {proto::plan::OpType::Match,
+             "1_2%",
+             [](std::string& val) {
+                 return std::regex_match(val, std::regex("1.2.*"));
+             }},
         };
 
     auto seg = CreateGrowingSegment(schema, empty_index_meta);
@@ -555,6 +569,46 @@ TEST(StringExpr, UnaryRange) {
     }
 }
 
+TEST(StringExpr, LikePattern) {
+    struct Case {
+        std::string pattern;
+        std::vector<std::string> matched;
+        std::vector<std::string> unmatched;
+    };
+    std::vector<Case> cases{
+        {"abc", {"abc"}, {"ab", "abcd", "xabc"}},
+        {"", {""}, {"a"}},
+        {"%", {"", "a", "abc"}, {}},
+        {"ab%", {"ab", "abc"}, {"a", "ba"}},
+        {"%ab", {"ab", "cab"}, {"abc", "b"}},
+        {"a%a", {"aa", "aba"}, {"a", "ab"}},
+        {"%b%d%", {"bd", "abcde", "bbdd"}, {"db", "abc"}},
+        {"a%%b", {"ab", "axb"}, {"a"}},
+        {"a_c", {"abc", "a%c", "a\nc"}, {"ac", "abbc"}},
+        {"_%_", {"ab", "abc"}, {"a", ""}},
+        {"%ü_", {"üx", "aüü"}, {"ü"}},
+        {"a\\%b", {"a%b"}, {"axb", "a%xb"}},
+        {"a\\_%", {"a_", "a_b"}, {"ab"}},
+        {"a.*", {"a.*"}, {"ab"}},
+        {"50\\%", {"50%"}, {"500"}},
+    };
+    for (auto& c : cases) {
+        LikePattern pattern(c.pattern);
+        for (auto& str : c.matched) {
+            EXPECT_TRUE(pattern.Match(str)) << c.pattern << " " << str;
+        }
+        for (auto& str : c.unmatched) {
+            EXPECT_FALSE(pattern.Match(str)) << c.pattern << " " << str;
+        }
+    }
+    EXPECT_EQ(LikePattern("ab%c_d").prefix(), "ab");
+    EXPECT_EQ(LikePattern("ab%c_d").literals(),
+              std::vector<std::string>({"ab", "c", "d"}));
+    auto postfix = LikePattern::Postfix("%_");
+    EXPECT_TRUE(postfix.Match("a%_"));
+    EXPECT_FALSE(postfix.Match("ab"));
+}
+
 TEST(StringExpr, BinaryRange) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -20,6 +20,7 @@
 #include "index/StringIndexMarisa.h"
 
 #include "index/IndexFactory.h"
+#include "index/StringIndexSort.h"
 #include "test_utils/indexbuilder_test_utils.h"
 #include "test_utils/AssertUtils.h"
 #include <boost/filesystem.hpp>
@@ -272,6 +273,103 @@ TEST_F(StringIndexMarisaTest, Codec) {
     }
 }
 
+TEST_F(StringIndexMarisaTest, RangeAndPrefixOfSortedStrings) {
+    std::vector<std::string> strings{
+        "b", "ab", "abc", "a", "ba", "bb", "", "abd", "ab", "c", "b"};
+    auto n = strings.size();
+    milvus::index::StringIndexMarisa index;
+    index.Build(n, strings.data());
+
+    auto less = index.Range("ab", milvus::OpType::LessThan);
+    auto less_equal = index.Range("ab", milvus::OpType::LessEqual);
+    auto greater = index.Range("b", milvus::OpType::GreaterThan);
+    auto greater_equal = index.Range("b", milvus::OpType::GreaterEqual);
+    auto between = index.Range("ab", false, "b", true);
+    auto prefix = index.PrefixMatch("ab");
+    auto empty_prefix = index.PrefixMatch("");
+    for (size_t i = 0; i < n; ++i) {
+        const auto& str = strings[i];
+        ASSERT_EQ(less[i], str < "ab");
+        ASSERT_EQ(less_equal[i], str <= "ab");
+        ASSERT_EQ(greater[i], str > "b");
+        ASSERT_EQ(greater_equal[i], str >= "b");
+        ASSERT_EQ(between[i], str > "ab" && str <= "b");
+        ASSERT_EQ(prefix[i], str.rfind("ab", 0) == 0);
+        ASSERT_TRUE(empty_prefix[i]);
+    }
+}
+
+TEST_F(StringIndexMarisaTest, PatternMatch) {
+    std::vector<std::string> strings{
+        "b", "ab", "abc", "a", "ba", "bcb", "", "abd", "ab", "cab", "b"};
+    auto n = strings.size();
+    milvus::index::StringIndexMarisa index;
+    index.Build(n, strings.data());
+    auto sort_index = milvus::index::CreateStringIndexSort();
+    sort_index->Build(n, strings.data());
+
+    auto query = [&](auto& index, milvus::OpType op, const std::string& v) {
+        auto dataset = std::make_shared<milvus::Dataset>();
+        dataset->Set(milvus::index::OPERATOR_TYPE, op);
+        dataset->Set(milvus::index::MATCH_VALUE, v);
+        return index.Query(dataset);
+    };
+    std::vector<std::pair<milvus::OpType, std::string>> cases{
+        {milvus::OpType::PostfixMatch, "b"},
+        {milvus::OpType::PostfixMatch, ""},
+        {milvus::OpType::Match, "a%"},
+        {milvus::OpType::Match, "%b%"},
+        {milvus::OpType::Match, "a_"},
+        {milvus::OpType::Match, "_"},
+        {milvus::OpType::Match, "x%"},
+    };
+    for (auto& [op, v] : cases) {
+        auto pattern = op == milvus::OpType::PostfixMatch
+                           ? milvus::LikePattern::Postfix(v)
+                           : milvus::LikePattern(v);
+        auto bitset = query(index, op, v);
+        auto sort_bitset = query(*sort_index, op, v);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(bitset[i], pattern.Match(strings[i])) << v << i;
+            ASSERT_EQ(sort_bitset[i], pattern.Match(strings[i])) << v << i;
+        }
+    }
+}
+
+TEST_F(StringIndexMarisaTest, Mmap) {
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(i % 10);
+    }
+    milvus::index::StringIndexMarisa index;
+    index.Build(nb, strings.data());
+
+    auto filepath = boost::filesystem::temp_directory_path() /
+                    boost::filesystem::unique_path() / "marisa_index";
+    auto binary_set = index.Serialize(nullptr);
+    milvus::index::StringIndexMarisa mmap_index;
+    ASSERT_TRUE(mmap_index.IsMmapSupported());
+    mmap_index.Load(binary_set,
+                    {{milvus::index::kMmapFilepath, filepath.string()}});
+    ASSERT_TRUE(mmap_index.IsMmap());
+    ASSERT_FALSE(boost::filesystem::exists(filepath));
+    boost::filesystem::remove_all(filepath.parent_path());
+
+    ASSERT_EQ(mmap_index.Count(), nb);
+    std::vector<std::string> terms{"3", "7", "10"};
+    auto in = mmap_index.In(terms.size(), terms.data());
+    auto not_in = mmap_index.NotIn(terms.size(), terms.data());
+    auto range = mmap_index.Range("2", true, "5", false);
+    auto prefix = mmap_index.PrefixMatch("9");
+    for (int i = 0; i < nb; ++i) {
+        ASSERT_EQ(mmap_index.Reverse_Lookup(i), strings[i]);
+        ASSERT_EQ(in[i], i % 10 == 3 || i % 10 == 7);
+        ASSERT_EQ(not_in[i], !in[i]);
+        ASSERT_EQ(range[i], i % 10 >= 2 && i % 10 < 5);
+        ASSERT_EQ(prefix[i], i % 10 == 9);
+    }
+}
+
 TEST_F(StringIndexMarisaTest, BaseIndexCodec) {
     milvus::index::IndexBasePtr index =
         milvus::index::CreateStringIndexMarisa();
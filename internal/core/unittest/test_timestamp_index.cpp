@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 
 #include "segcore/TimestampIndex.h"
@@ -66,3 +67,34 @@ TEST(TimestampIndex, Naive) {
     ASSERT_EQ(range.first, 8);
     ASSERT_EQ(range.second, 8);
 }
+
+TEST(TimestampIndex, GenerateBitsetByZones) {
+    // the timestamps are mostly ascending, with the sorted runs shuffled
+    // like the rows of a compacted segment
+    int64_t N = 10 * TimestampIndex::ZONE_SIZE + 37;
+    std::default_random_engine e(42);
+    std::vector<Timestamp> timestamps(N);
+    for (int64_t i = 0; i < N; ++i) {
+        timestamps[i] = i < N / 2 ? i : N / 2 + e() % (N / 2);
+    }
+    auto slices = GenerateFakeSlices(timestamps.data(), N, 100);
+    TimestampIndex index;
+    index.set_length_meta(slices);
+    index.build_with(timestamps.data(), N);
+
+    for (Timestamp query_ts : {Timestamp(N / 4),
+                               Timestamp(N / 2 + 10),
+                               Timestamp(N / 2 + N / 4),
+                               Timestamp(N - 2)}) {
+        auto range = index.get_active_range(query_ts);
+        if (range.first == range.second) {
+            continue;
+        }
+        auto bitset =
+            index.GenerateBitset(query_ts, range, timestamps.data(), N);
+        ASSERT_EQ(bitset.size(), N);
+        for (int64_t i = 0; i < N; ++i) {
+            ASSERT_EQ(bitset[i], timestamps[i] > query_ts) << i;
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <random>
+#include <thread>
 
 #include "common/Tracer.h"
 #include "common/EasyAssert.h"
@@ -71,3 +72,61 @@ TEST(Tracer, Span) {
     delete[] ctx->traceID;
     delete[] ctx->spanID;
 }
+
+TEST(Tracer, AutoSpan) {
+    auto config = std::make_shared<TraceConfig>();
+    config->exporter = "stdout";
+    config->nodeID = 1;
+    initTelementry(config.get());
+
+    auto empty_ctx = TraceContext{nullptr, nullptr, 0};
+    Assert(!ToSpanContext(&empty_ctx).IsValid());
+
+    uint8_t trace_id[16] = {0x01,
+                            0x23,
+                            0x45,
+                            0x67,
+                            0x89,
+                            0xab,
+                            0xcd,
+                            0xef,
+                            0xfe,
+                            0xdc,
+                            0xba,
+                            0x98,
+                            0x76,
+                            0x54,
+                            0x32,
+                            0x10};
+    uint8_t span_id[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+    auto ctx = TraceContext{trace_id, span_id, 1};
+    auto span_ctx = ToSpanContext(&ctx);
+    Assert(span_ctx.IsValid());
+    Assert(span_ctx.IsRemote());
+
+    auto previous = GetRootSpan();
+    {
+        AutoSpan outer("outer", span_ctx);
+        Assert(outer.GetSpan()->GetContext().trace_id() ==
+               span_ctx.trace_id());
+        Assert(GetRootSpan() == outer.GetSpan());
+        {
+            AutoSpan inner("inner");
+            inner.SetAttribute("files", static_cast<int64_t>(1));
+            Assert(inner.GetSpan()->GetContext().trace_id() ==
+                   span_ctx.trace_id());
+            Assert(GetRootSpan() == inner.GetSpan());
+        }
+        Assert(GetRootSpan() == outer.GetSpan());
+
+        // the tasks run under the span of the submitting thread
+        auto root = GetRootSpan();
+        std::thread([root, &span_ctx] {
+            ScopedRootSpan scoped(root);
+            AutoSpan task("task");
+            Assert(task.GetSpan()->GetContext().trace_id() ==
+                   span_ctx.trace_id());
+        }).join();
+    }
+    Assert(GetRootSpan() == previous);
+}
@@ -11,15 +11,20 @@
 
 #include <gtest/gtest.h>
 #include <string.h>
+#include <numeric>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Utils.h"
 #include "common/Exception.h"
+#include "mmap/Column.h"
+#include "mmap/Utils.h"
 #include "query/Utils.h"
+#include "segcore/Utils.h"
 #include "test_utils/DataGen.h"
 
 TEST(Util, StringMatch) {
@@ -110,6 +115,84 @@ TEST(Util, GetDeleteBitmap) {
     ASSERT_EQ(res_bitmap->bitmap_ptr->count(), 0);
 }
 
+TEST(Util, GetDeleteBitmapAtDifferentTimestamps) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto N = 10;
+
+    InsertRecord insert_record(*schema, N);
+    DeletedRecord delete_record;
+
+    // insert pks = {0 ... N - 1}, timestamps = {1 ... N}
+    std::vector<int64_t> age_data(N);
+    std::vector<Timestamp> tss(N);
+    for (int i = 0; i < N; ++i) {
+        age_data[i] = i;
+        tss[i] = i + 1;
+        insert_record.insert_pk(int64_t(i), i);
+    }
+    auto insert_offset = insert_record.reserved.fetch_add(N);
+    insert_record.timestamps_.set_data_raw(insert_offset, tss.data(), N);
+    auto field_data = insert_record.get_field_data_base(i64_fid);
+    field_data->set_data_raw(insert_offset, age_data.data(), N);
+    insert_record.ack_responder_.AddSegment(insert_offset, insert_offset + N);
+
+    // delete pk i at ts = 100 + i
+    int num_deletes = 8;
+    std::vector<PkType> delete_pks;
+    std::vector<Timestamp> delete_ts;
+    for (int i = 0; i < num_deletes; ++i) {
+        delete_pks.emplace_back(int64_t(i));
+        delete_ts.push_back(100 + i);
+    }
+    delete_record.push(delete_pks, delete_ts.data());
+
+    // the queries go back and forth in time, more than the snapshots kept
+    std::vector<int> query_order = {7, 3, 5, 0, 6, 1, 7, 2, 4, 3};
+    for (auto i : query_order) {
+        Timestamp query_timestamp = 100 + i;
+        auto del_barrier = get_barrier(delete_record, query_timestamp);
+        auto res_bitmap = get_deleted_bitmap(
+            del_barrier, N, delete_record, insert_record, query_timestamp);
+        ASSERT_EQ(res_bitmap->bitmap_ptr->size(), N);
+        ASSERT_EQ(res_bitmap->bitmap_ptr->count(), i + 1);
+        for (int j = 0; j < N; ++j) {
+            ASSERT_EQ(res_bitmap->bitmap_ptr->test(j), j <= i);
+        }
+    }
+}
+
+TEST(Util, DeletedRecordPushUnsorted) {
+    using namespace milvus;
+    using namespace milvus::segcore;
+
+    DeletedRecord delete_record;
+    std::vector<PkType> pks = {int64_t(3), int64_t(1), int64_t(2)};
+    std::vector<Timestamp> tss = {30, 10, 20};
+    delete_record.push(pks, tss.data());
+    ASSERT_EQ(delete_record.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(delete_record.timestamps()[i], (i + 1) * 10);
+        ASSERT_EQ(std::get<int64_t>(delete_record.pks()[i]), i + 1);
+    }
+    ASSERT_EQ(get_barrier(delete_record, 25), 2);
+
+    // the records not newer than the applied ones are dropped
+    pks = {int64_t(5), int64_t(4)};
+    tss = {50, 30};
+    delete_record.push(pks, tss.data());
+    ASSERT_EQ(delete_record.size(), 4);
+    ASSERT_EQ(delete_record.timestamps()[3], 50);
+    ASSERT_EQ(std::get<int64_t>(delete_record.pks()[3]), 5);
+}
+
 TEST(Util, OutOfRange) {
     using milvus::query::out_of_range;
 
@@ -190,3 +273,63 @@ TEST(Util, read_from_fd) {
             tmp_file.fd, read_buf.get(), data_size * max_loop, INT_MAX),
         milvus::SegcoreError);
 }
+
+TEST(Util, MapAnonHugePage) {
+    using milvus::HugePageMode;
+    auto mode = milvus::HUGE_PAGE_MODE;
+    for (auto huge_page_mode : {HugePageMode::Disabled,
+                                HugePageMode::Transparent,
+                                HugePageMode::HugeTLB}) {
+        milvus::HUGE_PAGE_MODE = huge_page_mode;
+        // the small maps are always backed by the normal pages
+        ASSERT_EQ(milvus::AnonMapSize(4096), size_t(4096));
+        size_t size = milvus::HUGE_PAGE_SIZE + 4096;
+        auto data = milvus::MapAnon(size);
+        if (huge_page_mode == HugePageMode::Disabled) {
+            ASSERT_EQ(milvus::AnonMapSize(size), size);
+        } else {
+            ASSERT_EQ(milvus::AnonMapSize(size), 2 * milvus::HUGE_PAGE_SIZE);
+            ASSERT_EQ(
+                reinterpret_cast<uintptr_t>(data) % milvus::HUGE_PAGE_SIZE, 0u);
+        }
+        memset(data, 1, size);
+        ASSERT_EQ(data[size - 1], 1);
+        ASSERT_EQ(milvus::UnmapAnon(data, size), 0);
+    }
+    milvus::HUGE_PAGE_MODE = mode;
+}
+
+TEST(Util, MappedColumnMlock) {
+    auto filepath = std::string("/tmp/") +
+                    boost::uuids::to_string(boost::uuids::random_generator()());
+    std::vector<int64_t> values(1024);
+    std::iota(values.begin(), values.end(), 0);
+    auto file = milvus::File::Open(filepath, O_CREAT | O_TRUNC | O_RDWR);
+    auto size = values.size() * sizeof(int64_t);
+    ASSERT_EQ(file.Write(values.data(), size), ssize_t(size));
+    milvus::FieldMeta field_meta(milvus::FieldName("int64"),
+                                 milvus::FieldId(100),
+                                 milvus::DataType::INT64);
+
+    auto& budget = milvus::MlockBudget::GetInstance();
+    {
+        milvus::Column column(file, size, field_meta);
+        column.Advise(milvus::MmapAdviceFromName("random"));
+        // nothing is locked over the budget
+        ASSERT_FALSE(column.Lock());
+        budget.SetCapacity(size);
+        ASSERT_TRUE(column.Lock());
+        ASSERT_TRUE(column.IsLocked());
+        ASSERT_EQ(budget.LockedBytes(), size);
+        // the budget left is too small for another column
+        milvus::Column other(file, size, field_meta);
+        ASSERT_FALSE(other.Lock());
+        ASSERT_EQ(reinterpret_cast<const int64_t*>(column.Data())[1023], 1023);
+    }
+    // released once the column is unmapped
+    ASSERT_EQ(budget.LockedBytes(), size_t(0));
+    budget.SetCapacity(0);
+    ASSERT_ANY_THROW(milvus::MmapAdviceFromName("hot"));
+    file.Close();
+    unlink(filepath.c_str());
+}
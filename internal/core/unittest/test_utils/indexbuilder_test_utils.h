@@ -384,6 +384,7 @@ GenBoolParams() {
     ret.emplace_back(
         ScalarTestParams(MapParams(), {{"index_type", "inverted_index"}}));
     ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "flat"}}));
+    ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "BITMAP"}}));
     return ret;
 }
 
@@ -391,6 +392,7 @@ std::vector<ScalarTestParams>
 GenStringParams() {
     std::vector<ScalarTestParams> ret;
     ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "marisa"}}));
+    ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "BITMAP"}}));
     return ret;
 }
 
@@ -411,6 +413,7 @@ GenParams() {
     ret.emplace_back(
         ScalarTestParams(MapParams(), {{"index_type", "inverted_index"}}));
     ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "flat"}}));
+    ret.emplace_back(ScalarTestParams(MapParams(), {{"index_type", "BITMAP"}}));
     return ret;
 }
 
@@ -442,13 +445,13 @@ GenDsFromPB(const google::protobuf::Message& msg) {
 template <typename T>
 inline std::vector<std::string>
 GetIndexTypes() {
-    return std::vector<std::string>{"inverted_index"};
+    return std::vector<std::string>{"inverted_index", "BITMAP"};
 }
 
 template <>
 inline std::vector<std::string>
 GetIndexTypes<std::string>() {
-    return std::vector<std::string>{"marisa"};
+    return std::vector<std::string>{"marisa", "BITMAP"};
 }
 
 }  // namespace
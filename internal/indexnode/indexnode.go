@@ -172,6 +172,7 @@ func (i *IndexNode) initSegcore() {
 	C.InitMiddlePriorityThreadCoreCoefficient(cMiddlePriorityThreadCoreCoefficient)
 	cLowPriorityThreadCoreCoefficient := C.int64_t(paramtable.Get().CommonCfg.LowPriorityThreadCoreCoefficient.GetAsInt64())
 	C.InitLowPriorityThreadCoreCoefficient(cLowPriorityThreadCoreCoefficient)
+	C.InitThreadPoolNumaAware(C.bool(paramtable.Get().CommonCfg.ThreadPoolNumaAware.GetAsBool()))
 
 	cCPUNum := C.int(hardware.GetCPUNum())
 	C.InitCpuNum(cCPUNum)
@@ -179,6 +180,13 @@ func (i *IndexNode) initSegcore() {
 	cKnowhereThreadPoolSize := C.uint32_t(hardware.GetCPUNum() * paramtable.DefaultKnowhereThreadPoolNumRatioInBuild)
 	C.SegcoreSetKnowhereBuildThreadPoolNum(cKnowhereThreadPoolSize)
 
+	// bound the cpu pools of the process, after they are sized by the cores
+	if cpuConcurrency := paramtable.Get().CommonCfg.CPUConcurrency.GetAsInt64(); cpuConcurrency > 0 {
+		C.SegcoreSetCpuConcurrency(C.uint32_t(cpuConcurrency))
+	}
+
+	C.InitStageVectorBuildInput(C.bool(Params.IndexNodeCfg.StageVectorBuildInput.GetAsBool()))
+
 	localDataRootPath := filepath.Join(Params.LocalStorageCfg.Path.GetValue(), typeutil.IndexNodeRole)
 	initcore.InitLocalChunkManager(localDataRootPath)
 }
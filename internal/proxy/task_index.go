@@ -159,6 +159,11 @@ func (cit *createIndexTask) parseIndexParams() error {
 			if exist && !validateArithmeticIndexType(specifyIndexType) {
 				return merr.WrapErrParameterInvalid(DefaultArithmeticIndexType, specifyIndexType, "index type not match")
 			}
+		} else if typeutil.IsBoolType(cit.fieldSchema.DataType) {
+			// only the bitmap index is built on bool field
+			if specifyIndexType != indexparamcheck.IndexBitmap {
+				return merr.WrapErrParameterInvalid(indexparamcheck.IndexBitmap, specifyIndexType, "index type not match")
+			}
 		} else {
 			return merr.WrapErrParameterInvalid("supported field",
 				fmt.Sprintf("create index on %s field", cit.fieldSchema.DataType.String()),
@@ -180,6 +180,15 @@ func TestValidateFieldName(t *testing.T) {
 	}
 }
 
+func TestValidateScalarIndexType(t *testing.T) {
+	assert.True(t, validateArithmeticIndexType(DefaultArithmeticIndexType))
+	assert.True(t, validateArithmeticIndexType("BITMAP"))
+	assert.False(t, validateArithmeticIndexType("HNSW"))
+	assert.True(t, validateStringIndexType(DefaultStringIndexType))
+	assert.True(t, validateStringIndexType("BITMAP"))
+	assert.False(t, validateStringIndexType("STL_SORT"))
+}
+
 func TestValidateDimension(t *testing.T) {
 	fieldSchema := &schemapb.FieldSchema{
 		DataType: schemapb.DataType_FloatVector,
@@ -0,0 +1,84 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package segments
+
+/*
+#cgo pkg-config: milvus_segcore
+
+#include <stdlib.h>
+#include "segcore/load_task_c.h"
+
+extern void loadTaskDone(void* arg);
+*/
+import "C"
+
+import (
+	"runtime/cgo"
+	"time"
+	"unsafe"
+
+	"go.uber.org/zap"
+
+	"github.com/milvus-io/milvus/pkg/log"
+)
+
+// the interval of logging the progress of an async load
+const loadTaskProgressInterval = 10 * time.Second
+
+// loadTaskDone is called by segcore once an async load is done, with the
+// handle of the channel to close
+//
+//export loadTaskDone
+func loadTaskDone(arg unsafe.Pointer) {
+	done := (*(*cgo.Handle)(arg)).Value().(chan struct{})
+	close(done)
+}
+
+// asyncLoadFieldData loads the field data by an async load of segcore, which
+// runs within the load budget of segcore, and logs its progress until done
+func asyncLoadFieldData(log *log.MLogger, segment C.CSegmentInterface, info C.CLoadFieldDataInfo) C.CStatus {
+	done := make(chan struct{})
+	handle := cgo.NewHandle(done)
+	defer handle.Delete()
+	// the handle is passed in the memory of C, as the pointers to the memory
+	// of Go must not be kept by C
+	arg := C.malloc(C.size_t(unsafe.Sizeof(handle)))
+	defer C.free(arg)
+	*(*cgo.Handle)(arg) = handle
+
+	var task C.CLoadTask
+	status := C.AsyncLoadFieldData(segment, info, C.CAsyncTaskCallback(C.loadTaskDone), arg, &task)
+	if status.error_code != 0 {
+		return status
+	}
+	defer C.DeleteLoadTask(task)
+
+	ticker := time.NewTicker(loadTaskProgressInterval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-done:
+			return C.GetLoadTaskStatus(task)
+		case <-ticker.C:
+			var downloaded, decoded C.int64_t
+			C.GetLoadTaskProgress(task, &downloaded, &decoded)
+			log.Info("loading field data",
+				zap.Int64("downloadedBytes", int64(downloaded)),
+				zap.Int64("decodedBytes", int64(decoded)))
+		}
+	}
+}
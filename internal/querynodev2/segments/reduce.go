@@ -106,6 +106,57 @@ func ReduceSearchResultsAndFillData(plan *SearchPlan, searchResults []*SearchRes
 	return cSearchResultDataBlobs, nil
 }
 
+// SearchResultReducer merges the search results of the segments as they
+// arrive, the results must be kept until the reducer is deleted
+type SearchResultReducer struct {
+	cReducer C.CSearchResultReducer
+}
+
+func NewSearchResultReducer(plan *SearchPlan, sliceNQs []int64, sliceTopKs []int64) (*SearchResultReducer, error) {
+	if plan.cSearchPlan == nil {
+		return nil, fmt.Errorf("nil search plan")
+	}
+
+	if len(sliceNQs) == 0 {
+		return nil, fmt.Errorf("empty slice nqs is not allowed")
+	}
+
+	if len(sliceNQs) != len(sliceTopKs) {
+		return nil, fmt.Errorf("unaligned sliceNQs(len=%d) and sliceTopKs(len=%d)", len(sliceNQs), len(sliceTopKs))
+	}
+
+	var cReducer C.CSearchResultReducer
+	status := C.NewSearchResultReducer(&cReducer, plan.cSearchPlan, (*C.int64_t)(&sliceNQs[0]),
+		(*C.int64_t)(&sliceTopKs[0]), C.int64_t(len(sliceNQs)))
+	if err := HandleCStatus(&status, "NewSearchResultReducer failed"); err != nil {
+		return nil, err
+	}
+	return &SearchResultReducer{cReducer: cReducer}, nil
+}
+
+// Add merges the search result of a segment, it's safe to be called concurrently
+func (r *SearchResultReducer) Add(searchResult *SearchResult) error {
+	if searchResult == nil {
+		return fmt.Errorf("nil searchResult detected when adding search result")
+	}
+	status := C.ReducerAddSearchResult(r.cReducer, searchResult.cSearchResult)
+	return HandleCStatus(&status, "ReducerAddSearchResult failed")
+}
+
+// FillData reduces the added search results like ReduceSearchResultsAndFillData
+func (r *SearchResultReducer) FillData() (searchResultDataBlobs, error) {
+	var cSearchResultDataBlobs searchResultDataBlobs
+	status := C.ReducerFillData(&cSearchResultDataBlobs, r.cReducer)
+	if err := HandleCStatus(&status, "ReducerFillData failed"); err != nil {
+		return nil, err
+	}
+	return cSearchResultDataBlobs, nil
+}
+
+func (r *SearchResultReducer) Delete() {
+	C.DeleteSearchResultReducer(r.cReducer)
+}
+
 func GetSearchResultDataBlob(cSearchResultDataBlobs searchResultDataBlobs, blobIndex int) ([]byte, error) {
 	var blob C.CProto
 	status := C.GetSearchResultDataBlob(&blob, cSearchResultDataBlobs, C.int32_t(blobIndex))
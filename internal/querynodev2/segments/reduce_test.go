@@ -188,6 +188,15 @@ func (suite *ReduceSuite) TestReduceInvalid() {
 	searchResults = append(searchResults, nil)
 	_, err = ReduceSearchResultsAndFillData(searchReq.plan, searchResults, 1, []int64{10}, []int64{10})
 	suite.Error(err)
+
+	_, err = NewSearchResultReducer(plan, []int64{10}, []int64{10})
+	suite.Error(err)
+	_, err = NewSearchResultReducer(searchReq.plan, []int64{10}, nil)
+	suite.Error(err)
+	reducer, err := NewSearchResultReducer(searchReq.plan, []int64{10}, []int64{10})
+	suite.NoError(err)
+	defer reducer.Delete()
+	suite.Error(reducer.Add(nil))
 }
 
 func TestReduce(t *testing.T) {
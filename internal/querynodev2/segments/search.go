@@ -26,6 +26,7 @@ import (
 	"github.com/milvus-io/milvus-proto/go-api/v2/commonpb"
 	"github.com/milvus-io/milvus/pkg/log"
 	"github.com/milvus-io/milvus/pkg/metrics"
+	"github.com/milvus-io/milvus/pkg/util/merr"
 	"github.com/milvus-io/milvus/pkg/util/paramtable"
 	"github.com/milvus-io/milvus/pkg/util/timerecord"
 )
@@ -107,6 +108,31 @@ func SearchHistorical(ctx context.Context, manager *Manager, searchReq *SearchRe
 	return searchResults, segments, err
 }
 
+// SearchHistoricalAndReduce searches the historical segments as SearchHistorical does, but in
+// parallel in segcore, and reduces their results in the same cgo call, see SearchSegmentsAndReduce.
+// The blobs are nil if there is no segment to search
+func SearchHistoricalAndReduce(ctx context.Context, manager *Manager, searchReq *SearchRequest, collID int64, partIDs []int64, segIDs []int64,
+	sliceNQs []int64, sliceTopKs []int64,
+) (searchResultDataBlobs, []Segment, error) {
+	segments, err := validateOnHistorical(ctx, manager, collID, partIDs, segIDs)
+	if err != nil {
+		return nil, nil, err
+	}
+	if len(segments) == 0 {
+		return nil, segments, nil
+	}
+	localSegments := make([]*LocalSegment, 0, len(segments))
+	for _, segment := range segments {
+		localSegment, ok := segment.(*LocalSegment)
+		if !ok {
+			return nil, segments, merr.WrapErrServiceInternal(fmt.Sprintf("segment %d is not a local segment", segment.ID()))
+		}
+		localSegments = append(localSegments, localSegment)
+	}
+	blobs, err := SearchSegmentsAndReduce(ctx, localSegments, searchReq, sliceNQs, sliceTopKs)
+	return blobs, segments, err
+}
+
 // searchStreaming will search all the target segments in streaming
 // if partIDs is empty, it means all the partitions of the loaded collection or all the partitions loaded.
 func SearchStreaming(ctx context.Context, manager *Manager, searchReq *SearchRequest, collID int64, partIDs []int64, segIDs []int64) ([]*SearchResult, []Segment, error) {
@@ -31,6 +31,8 @@ import (
 	"sync"
 	"unsafe"
 
+	"github.com/apache/arrow/go/v12/arrow"
+	"github.com/apache/arrow/go/v12/arrow/cdata"
 	"github.com/cockroachdb/errors"
 	"github.com/golang/protobuf/proto"
 	"go.opentelemetry.io/otel/trace"
@@ -390,6 +392,64 @@ func (s *LocalSegment) Search(ctx context.Context, searchReq *SearchRequest) (*S
 	return &searchResult, nil
 }
 
+// SearchSegmentsAndReduce searches the segments with the same request and
+// reduces the results in one cgo call, the segments are searched in parallel
+// in segcore
+func SearchSegmentsAndReduce(ctx context.Context, segments []*LocalSegment, searchReq *SearchRequest,
+	sliceNQs []int64, sliceTopKs []int64,
+) (searchResultDataBlobs, error) {
+	if len(segments) == 0 {
+		return nil, fmt.Errorf("no segment to search")
+	}
+	if len(sliceNQs) == 0 {
+		return nil, fmt.Errorf("empty slice nqs is not allowed")
+	}
+	if len(sliceNQs) != len(sliceTopKs) {
+		return nil, fmt.Errorf("unaligned sliceNQs(len=%d) and sliceTopKs(len=%d)", len(sliceNQs), len(sliceTopKs))
+	}
+
+	cSegments := make([]C.CSegmentInterface, 0, len(segments))
+	for _, s := range segments {
+		s.ptrLock.RLock()
+		defer s.ptrLock.RUnlock()
+		if s.ptr == nil {
+			return nil, merr.WrapErrSegmentNotLoaded(s.segmentID, "segment released")
+		}
+		cSegments = append(cSegments, s.ptr)
+	}
+
+	span := trace.SpanFromContext(ctx)
+	traceID := span.SpanContext().TraceID()
+	spanID := span.SpanContext().SpanID()
+	traceCtx := C.CTraceContext{
+		traceID: (*C.uint8_t)(unsafe.Pointer(&traceID[0])),
+		spanID:  (*C.uint8_t)(unsafe.Pointer(&spanID[0])),
+		flag:    C.uchar(span.SpanContext().TraceFlags()),
+	}
+
+	var blobs searchResultDataBlobs
+	var status C.CStatus
+	GetSQPool().Submit(func() (any, error) {
+		tr := timerecord.NewTimeRecorder("cgoSearchSegments")
+		status = C.SearchSegmentsAndReduce(&blobs,
+			&cSegments[0],
+			C.int64_t(len(cSegments)),
+			searchReq.plan.cSearchPlan,
+			searchReq.cPlaceholderGroup,
+			traceCtx,
+			(*C.int64_t)(&sliceNQs[0]),
+			(*C.int64_t)(&sliceTopKs[0]),
+			C.int64_t(len(sliceNQs)),
+		)
+		metrics.QueryNodeSQSegmentLatencyInCore.WithLabelValues(fmt.Sprint(paramtable.GetNodeID()), metrics.SearchLabel).Observe(float64(tr.ElapseSpan().Milliseconds()))
+		return nil, nil
+	}).Await()
+	if err := HandleCStatus(&status, "SearchSegmentsAndReduce failed"); err != nil {
+		return nil, err
+	}
+	return blobs, nil
+}
+
 func (s *LocalSegment) Retrieve(ctx context.Context, plan *RetrievePlan) (*segcorepb.RetrieveResults, error) {
 	s.ptrLock.RLock()
 	defer s.ptrLock.RUnlock()
@@ -453,6 +513,53 @@ func (s *LocalSegment) Retrieve(ctx context.Context, plan *RetrievePlan) (*segco
 	return result, nil
 }
 
+// RetrieveArrow retrieves the rows like Retrieve, but gets them as an arrow record
+// instead of decoding a RetrieveResults, the columns are named by the field ids,
+// and the offsets of the rows are the trailing "offset" column.
+// The caller must release the record.
+func (s *LocalSegment) RetrieveArrow(ctx context.Context, plan *RetrievePlan) (arrow.Record, error) {
+	s.ptrLock.RLock()
+	defer s.ptrLock.RUnlock()
+
+	if s.ptr == nil {
+		return nil, merr.WrapErrSegmentNotLoaded(s.segmentID, "segment released")
+	}
+
+	span := trace.SpanFromContext(ctx)
+
+	traceID := span.SpanContext().TraceID()
+	spanID := span.SpanContext().SpanID()
+	traceCtx := C.CTraceContext{
+		traceID: (*C.uint8_t)(unsafe.Pointer(&traceID[0])),
+		spanID:  (*C.uint8_t)(unsafe.Pointer(&spanID[0])),
+		flag:    C.uchar(span.SpanContext().TraceFlags()),
+	}
+
+	maxLimitSize := paramtable.Get().QuotaConfig.MaxOutputSize.GetAsInt64()
+	var array cdata.CArrowArray
+	var schema cdata.CArrowSchema
+	var status C.CStatus
+	GetSQPool().Submit(func() (any, error) {
+		tr := timerecord.NewTimeRecorder("cgoRetrieveArrow")
+		status = C.RetrieveArrow(s.ptr,
+			plan.cRetrievePlan,
+			traceCtx,
+			C.uint64_t(plan.Timestamp),
+			(*C.struct_ArrowArray)(unsafe.Pointer(&array)),
+			(*C.struct_ArrowSchema)(unsafe.Pointer(&schema)),
+			C.int64_t(maxLimitSize))
+		metrics.QueryNodeSQSegmentLatencyInCore.WithLabelValues(fmt.Sprint(paramtable.GetNodeID()),
+			metrics.QueryLabel).Observe(float64(tr.ElapseSpan().Milliseconds()))
+		return nil, nil
+	}).Await()
+
+	if err := HandleCStatus(&status, "RetrieveArrow failed"); err != nil {
+		return nil, err
+	}
+	// the imported record takes over the buffers of the array
+	return cdata.ImportCRecordBatch(&array, &schema)
+}
+
 func (s *LocalSegment) GetFieldDataPath(index *IndexedFieldInfo, offset int64) (dataPath string, offsetInBinlog int64) {
 	offsetInBinlog = offset
 	for _, binlog := range index.FieldBinlog.Binlogs {
@@ -714,12 +821,7 @@ func (s *LocalSegment) LoadFieldData(fieldID int64, rowCount int64, field *datap
 	loadFieldDataInfo.appendMMapDirPath(paramtable.Get().QueryNodeCfg.MmapDirPath.GetValue())
 	loadFieldDataInfo.enableMmap(fieldID, mmapEnabled)
 
-	var status C.CStatus
-	GetLoadPool().Submit(func() (any, error) {
-		log.Info("submitted loadFieldData task to dy pool")
-		status = C.LoadFieldData(s.ptr, loadFieldDataInfo.cLoadFieldDataInfo)
-		return nil, nil
-	}).Await()
+	status := asyncLoadFieldData(log, s.ptr, loadFieldDataInfo.cLoadFieldDataInfo)
 	if err := HandleCStatus(&status, "LoadFieldData failed"); err != nil {
 		return err
 	}
@@ -779,6 +881,20 @@ func (s *LocalSegment) AddFieldDataInfo(rowCount int64, fields []*datapb.FieldBi
 	return nil
 }
 
+// PrefetchChunkCache fetches the raw data of the indexed vector field to the
+// chunk cache in the background, for the searches outputting the field
+func (s *LocalSegment) PrefetchChunkCache(fieldID int64) error {
+	s.ptrLock.RLock()
+	defer s.ptrLock.RUnlock()
+
+	if s.ptr == nil {
+		return merr.WrapErrSegmentNotLoaded(s.segmentID, "segment released")
+	}
+
+	status := C.PrefetchChunkCache(s.ptr, C.int64_t(fieldID))
+	return HandleCStatus(&status, "PrefetchChunkCache failed")
+}
+
 func (s *LocalSegment) LoadDeltaData(deltaData *storage.DeleteData) error {
 	pks, tss := deltaData.Pks, deltaData.Tss
 	rowNum := deltaData.RowCount
@@ -591,6 +591,19 @@ func (loader *segmentLoader) loadSegment(ctx context.Context,
 		if err := segment.AddFieldDataInfo(loadInfo.GetNumOfRows(), loadInfo.GetBinlogPaths()); err != nil {
 			return err
 		}
+		if paramtable.Get().QueryNodeCfg.PrefetchVectorRawData.GetAsBool() {
+			for fieldID := range indexedFieldInfos {
+				field, err := schemaHelper.GetFieldFromID(fieldID)
+				if err != nil {
+					return err
+				}
+				if typeutil.IsVectorType(field.GetDataType()) && !segment.HasRawData(fieldID) {
+					if err := segment.PrefetchChunkCache(fieldID); err != nil {
+						return err
+					}
+				}
+			}
+		}
 		// https://github.com/milvus-io/milvus/23654
 		// legacy entry num = 0
 		if err := loader.patchEntryNumber(ctx, segment, loadInfo); err != nil {
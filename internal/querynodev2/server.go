@@ -201,6 +201,42 @@ func (node *QueryNode) InitSegcore() error {
 	nprobe := C.int64_t(paramtable.Get().QueryNodeCfg.InterimIndexNProbe.GetAsInt64())
 	C.SegcoreSetNprobe(nprobe)
 
+	cQuantization := C.CString(paramtable.Get().QueryNodeCfg.InterimIndexQuantization.GetValue())
+	C.SegcoreSetInterimIndexQuantization(cQuantization)
+	C.free(unsafe.Pointer(cQuantization))
+
+	refineRatio := C.float(paramtable.Get().QueryNodeCfg.InterimIndexRefineRatio.GetAsFloat())
+	C.SegcoreSetRefineRatio(refineRatio)
+
+	bruteForceSelectivity := C.float(paramtable.Get().QueryNodeCfg.BruteForceSelectivity.GetAsFloat())
+	C.SegcoreSetBruteForceSelectivity(bruteForceSelectivity)
+
+	dictEncodeRatio := C.float(paramtable.Get().QueryNodeCfg.DictEncodeRatio.GetAsFloat())
+	C.SegcoreSetDictEncodeRatio(dictEncodeRatio)
+
+	packRatio := C.float(paramtable.Get().QueryNodeCfg.PackRatio.GetAsFloat())
+	C.SegcoreSetPackRatio(packRatio)
+
+	planCacheSize := C.int64_t(paramtable.Get().QueryNodeCfg.PlanCacheSize.GetAsInt64())
+	C.SegcoreSetPlanCacheSize(planCacheSize)
+
+	stageIndexLoad := C.bool(paramtable.Get().QueryNodeCfg.StageIndexLoad.GetAsBool())
+	C.SegcoreSetStageIndexLoad(stageIndexLoad)
+
+	enableChunkArena := C.bool(paramtable.Get().QueryNodeCfg.EnableChunkArena.GetAsBool())
+	C.SegcoreSetEnableChunkArena(enableChunkArena)
+
+	chunkArenaHugePage := C.bool(paramtable.Get().QueryNodeCfg.ChunkArenaHugePage.GetAsBool())
+	C.SegcoreSetChunkArenaHugePage(chunkArenaHugePage)
+
+	loadFileMemoryBudget := C.int64_t(paramtable.Get().QueryNodeCfg.LoadFileMemoryBudget.GetAsInt64())
+	loadBandwidthBudget := C.int64_t(paramtable.Get().QueryNodeCfg.LoadBandwidthBudget.GetAsInt64())
+	C.SegcoreSetLoadBudget(loadFileMemoryBudget, loadBandwidthBudget)
+
+	loadMemoryLimit := C.int64_t(paramtable.Get().QueryNodeCfg.LoadMemoryLimit.GetAsInt64())
+	loadMemoryWaitTimeoutMs := C.int64_t(paramtable.Get().QueryNodeCfg.LoadMemoryWaitTimeoutMs.GetAsInt64())
+	C.SegcoreSetLoadMemoryLimit(loadMemoryLimit, loadMemoryWaitTimeoutMs)
+
 	// override segcore SIMD type
 	cSimdType := C.CString(paramtable.Get().CommonCfg.SimdType.GetValue())
 	C.SegcoreSetSimdType(cSimdType)
@@ -217,12 +253,20 @@ func (node *QueryNode) InitSegcore() error {
 	C.InitMiddlePriorityThreadCoreCoefficient(cMiddlePriorityThreadCoreCoefficient)
 	cLowPriorityThreadCoreCoefficient := C.int64_t(paramtable.Get().CommonCfg.LowPriorityThreadCoreCoefficient.GetAsInt64())
 	C.InitLowPriorityThreadCoreCoefficient(cLowPriorityThreadCoreCoefficient)
+	C.InitThreadPoolNumaAware(C.bool(paramtable.Get().CommonCfg.ThreadPoolNumaAware.GetAsBool()))
 
 	cCPUNum := C.int(hardware.GetCPUNum())
 	C.InitCpuNum(cCPUNum)
 
+	// bound the cpu pools of the process, after they are sized by the cores
+	if cpuConcurrency := paramtable.Get().CommonCfg.CPUConcurrency.GetAsInt64(); cpuConcurrency > 0 {
+		C.SegcoreSetCpuConcurrency(C.uint32_t(cpuConcurrency))
+	}
+
 	cExprBatchSize := C.int64_t(paramtable.Get().QueryNodeCfg.ExprEvalBatchSize.GetAsInt64())
 	C.InitDefaultExprEvalBatchSize(cExprBatchSize)
+	cExprWorkingSetSize := C.int64_t(paramtable.Get().QueryNodeCfg.ExprEvalWorkingSetSize.GetAsInt64())
+	C.InitExprEvalWorkingSetSize(cExprWorkingSetSize)
 
 	localDataRootPath := filepath.Join(paramtable.Get().LocalStorageCfg.Path.GetValue(), typeutil.QueryNodeRole)
 	initcore.InitLocalChunkManager(localDataRootPath)
@@ -232,17 +276,28 @@ func (node *QueryNode) InitSegcore() error {
 		return err
 	}
 
+	diskCacheCapacity := paramtable.Get().QueryNodeCfg.DiskCacheCapacity.GetAsInt64()
+	if diskCacheCapacity > 0 {
+		diskCachePath := path.Join(localDataRootPath, "remote_cache")
+		err = initcore.InitRemoteDiskCache(diskCachePath, diskCacheCapacity)
+		if err != nil {
+			return err
+		}
+		log.Info("InitRemoteDiskCache done", zap.String("dir", diskCachePath), zap.Int64("capacity", diskCacheCapacity))
+	}
+
 	mmapDirPath := paramtable.Get().QueryNodeCfg.MmapDirPath.GetValue()
 	if len(mmapDirPath) == 0 {
 		mmapDirPath = paramtable.Get().LocalStorageCfg.Path.GetValue()
 	}
 	chunkCachePath := path.Join(mmapDirPath, "chunk_cache")
 	policy := paramtable.Get().QueryNodeCfg.ReadAheadPolicy.GetValue()
-	err = initcore.InitChunkCache(chunkCachePath, policy)
+	capacity := paramtable.Get().QueryNodeCfg.ChunkCacheCapacity.GetAsInt64()
+	err = initcore.InitChunkCache(chunkCachePath, policy, capacity)
 	if err != nil {
 		return err
 	}
-	log.Info("InitChunkCache done", zap.String("dir", chunkCachePath), zap.String("policy", policy))
+	log.Info("InitChunkCache done", zap.String("dir", chunkCachePath), zap.String("policy", policy), zap.Int64("capacity", capacity))
 
 	initcore.InitTraceConfig(paramtable.Get())
 	return nil
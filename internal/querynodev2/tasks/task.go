@@ -124,6 +124,11 @@ func (t *SearchTask) Execute() error {
 	}
 	defer searchReq.Delete()
 
+	if req.GetScope() == querypb.DataScope_Historical &&
+		paramtable.Get().QueryNodeCfg.SearchSegmentsInOneCall.GetAsBool() {
+		return t.searchHistoricalInOneCall(searchReq, tr)
+	}
+
 	var (
 		results          []*segments.SearchResult
 		searchedSegments []segments.Segment
@@ -154,29 +159,7 @@ func (t *SearchTask) Execute() error {
 	defer segments.DeleteSearchResults(results)
 
 	if len(results) == 0 {
-		for i := range t.originNqs {
-			var task *SearchTask
-			if i == 0 {
-				task = t
-			} else {
-				task = t.others[i-1]
-			}
-
-			task.result = &internalpb.SearchResults{
-				Base: &commonpb.MsgBase{
-					SourceID: paramtable.GetNodeID(),
-				},
-				Status:         merr.Success(),
-				MetricType:     req.GetReq().GetMetricType(),
-				NumQueries:     t.originNqs[i],
-				TopK:           t.originTopks[i],
-				SlicedOffset:   1,
-				SlicedNumCount: 1,
-				CostAggregation: &internalpb.CostAggregation{
-					ServiceTime: tr.ElapseSpan().Milliseconds(),
-				},
-			}
-		}
+		t.setResults(nil, tr)
 		return nil
 	}
 
@@ -198,12 +181,64 @@ func (t *SearchTask) Execute() error {
 		metrics.SearchLabel,
 		metrics.ReduceSegments).
 		Observe(float64(tr.RecordSpan().Milliseconds()))
+	sliceBlobs := make([][]byte, len(t.originNqs))
+	for i := range t.originNqs {
+		blob, err := segments.GetSearchResultDataBlob(blobs, i)
+		if err != nil {
+			return err
+		}
+		// Note: blob is unsafe because get from C
+		sliceBlobs[i] = make([]byte, len(blob))
+		copy(sliceBlobs[i], blob)
+	}
+	t.setResults(sliceBlobs, tr)
+	return nil
+}
+
+// searchHistoricalInOneCall searches the historical segments and reduces their results in the same
+// cgo call, see segments.SearchHistoricalAndReduce
+func (t *SearchTask) searchHistoricalInOneCall(searchReq *segments.SearchRequest, tr *timerecord.TimeRecorder) error {
+	req := t.req
+	blobs, searchedSegments, err := segments.SearchHistoricalAndReduce(
+		t.ctx,
+		t.segmentManager,
+		searchReq,
+		req.GetReq().GetCollectionID(),
+		nil,
+		req.GetSegmentIDs(),
+		t.originNqs,
+		t.originTopks,
+	)
+	defer t.segmentManager.Segment.Unpin(searchedSegments)
+	if err != nil {
+		log.Ctx(t.ctx).Warn("failed to search and reduce segments", zap.Error(err))
+		return err
+	}
+	if len(searchedSegments) == 0 {
+		t.setResults(nil, tr)
+		return nil
+	}
+	defer segments.DeleteSearchResultDataBlobs(blobs)
+
+	sliceBlobs := make([][]byte, len(t.originNqs))
 	for i := range t.originNqs {
 		blob, err := segments.GetSearchResultDataBlob(blobs, i)
 		if err != nil {
 			return err
 		}
+		// Note: blob is unsafe because get from C
+		sliceBlobs[i] = make([]byte, len(blob))
+		copy(sliceBlobs[i], blob)
+	}
+	t.setResults(sliceBlobs, tr)
+	return nil
+}
 
+// setResults sets the results of the task and of the ones merged into it, from the blob of each of
+// them, or empty results if sliceBlobs is nil
+func (t *SearchTask) setResults(sliceBlobs [][]byte, tr *timerecord.TimeRecorder) {
+	req := t.req
+	for i := range t.originNqs {
 		var task *SearchTask
 		if i == 0 {
 			task = t
@@ -211,10 +246,10 @@ func (t *SearchTask) Execute() error {
 			task = t.others[i-1]
 		}
 
-		// Note: blob is unsafe because get from C
-		bs := make([]byte, len(blob))
-		copy(bs, blob)
-
+		var blob []byte
+		if sliceBlobs != nil {
+			blob = sliceBlobs[i]
+		}
 		task.result = &internalpb.SearchResults{
 			Base: &commonpb.MsgBase{
 				SourceID: paramtable.GetNodeID(),
@@ -223,7 +258,7 @@ func (t *SearchTask) Execute() error {
 			MetricType:     req.GetReq().GetMetricType(),
 			NumQueries:     t.originNqs[i],
 			TopK:           t.originTopks[i],
-			SlicedBlob:     bs,
+			SlicedBlob:     blob,
 			SlicedOffset:   1,
 			SlicedNumCount: 1,
 			CostAggregation: &internalpb.CostAggregation{
@@ -231,8 +266,6 @@ func (t *SearchTask) Execute() error {
 			},
 		}
 	}
-
-	return nil
 }
 
 func (t *SearchTask) Merge(other *SearchTask) bool {
@@ -181,3 +181,14 @@ func (bi *BuildIndexInfo) AppendIndexEngineVersion(indexEngineVersion int32) err
 	status := C.AppendIndexEngineVersionToBuildInfo(bi.cBuildIndexInfo, cIndexEngineVersion)
 	return HandleCStatus(&status, "AppendIndexEngineVersion failed")
 }
+
+// EstimateBuildResource estimates the peak memory and local disk in bytes of
+// building the index of the build info on numRows rows.
+func (bi *BuildIndexInfo) EstimateBuildResource(numRows int64) (uint64, uint64, error) {
+	var resource C.CIndexBuildResource
+	status := C.EstimateIndexBuildResource(bi.cBuildIndexInfo, C.int64_t(numRows), &resource)
+	if err := HandleCStatus(&status, "EstimateBuildResource failed"); err != nil {
+		return 0, 0, err
+	}
+	return uint64(resource.memory_size), uint64(resource.disk_size), nil
+}
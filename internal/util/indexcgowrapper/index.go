@@ -108,6 +108,32 @@ func CreateIndex(ctx context.Context, buildIndexInfo *BuildIndexInfo) (CodecInde
 	return index, nil
 }
 
+// CreateIndexes builds the indexes of several build infos at the same time,
+// the indexes are in the order of the infos.
+func CreateIndexes(ctx context.Context, buildIndexInfos []*BuildIndexInfo) ([]CodecIndex, error) {
+	if len(buildIndexInfos) == 0 {
+		return nil, nil
+	}
+	cBuildIndexInfos := make([]C.CBuildIndexInfo, len(buildIndexInfos))
+	for i, buildIndexInfo := range buildIndexInfos {
+		cBuildIndexInfos[i] = buildIndexInfo.cBuildIndexInfo
+	}
+	indexPtrs := make([]C.CIndex, len(buildIndexInfos))
+	status := C.CreateIndexes(&indexPtrs[0], &cBuildIndexInfos[0], C.int64_t(len(buildIndexInfos)))
+	if err := HandleCStatus(&status, "failed to create indexes"); err != nil {
+		return nil, err
+	}
+
+	indexes := make([]CodecIndex, 0, len(indexPtrs))
+	for _, indexPtr := range indexPtrs {
+		indexes = append(indexes, &CgoIndex{
+			indexPtr: indexPtr,
+			close:    false,
+		})
+	}
+	return indexes, nil
+}
+
 func CreateIndexV2(ctx context.Context, buildIndexInfo *BuildIndexInfo) (CodecIndex, error) {
 	var indexPtr C.CIndex
 	status := C.CreateIndexV2(&indexPtr, buildIndexInfo.cBuildIndexInfo)
@@ -91,21 +91,30 @@ func InitRemoteChunkManager(params *paramtable.ComponentParam) error {
 		region:           cRegion,
 		useVirtualHost:   C.bool(params.MinioCfg.UseVirtualHost.GetAsBool()),
 		requestTimeoutMs: C.int64_t(params.MinioCfg.RequestTimeoutMs.GetAsInt64()),
+		readPartSize:     C.int64_t(params.MinioCfg.ReadPartSize.GetAsInt64()),
+		readConcurrency:  C.int64_t(params.MinioCfg.ReadConcurrency.GetAsInt64()),
 	}
 
 	status := C.InitRemoteChunkManagerSingleton(storageConfig)
 	return HandleCStatus(&status, "InitRemoteChunkManagerSingleton failed")
 }
 
-func InitChunkCache(mmapDirPath string, readAheadPolicy string) error {
+func InitChunkCache(mmapDirPath string, readAheadPolicy string, capacityBytes int64) error {
 	cMmapDirPath := C.CString(mmapDirPath)
 	defer C.free(unsafe.Pointer(cMmapDirPath))
 	cReadAheadPolicy := C.CString(readAheadPolicy)
 	defer C.free(unsafe.Pointer(cReadAheadPolicy))
-	status := C.InitChunkCacheSingleton(cMmapDirPath, cReadAheadPolicy)
+	status := C.InitChunkCacheSingleton(cMmapDirPath, cReadAheadPolicy, C.int64_t(capacityBytes))
 	return HandleCStatus(&status, "InitChunkCacheSingleton failed")
 }
 
+func InitRemoteDiskCache(cacheDirPath string, capacityBytes int64) error {
+	cCacheDirPath := C.CString(cacheDirPath)
+	defer C.free(unsafe.Pointer(cCacheDirPath))
+	status := C.InitRemoteDiskCache(cCacheDirPath, C.int64_t(capacityBytes))
+	return HandleCStatus(&status, "InitRemoteDiskCache failed")
+}
+
 func CleanRemoteChunkManager() {
 	C.CleanRemoteChunkManagerSingleton()
 }
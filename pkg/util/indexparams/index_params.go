@@ -43,6 +43,8 @@ const (
 	SearchCacheBudgetKey = "search_cache_budget_gb"
 	NumLoadThreadKey     = "num_load_thread"
 	BeamWidthKey         = "beamwidth"
+	WarmUpKey            = "warm_up"
+	UseBFSCacheKey       = "use_bfs_cache"
 
 	MaxLoadThread = 64
 	MaxBeamWidth  = 16
@@ -277,6 +279,10 @@ func SetDiskIndexLoadParams(params *paramtable.ComponentParam, indexParams map[s
 	}
 	indexParams[BeamWidthKey] = strconv.Itoa(beamWidth)
 
+	// the warm up reads within the search cache budget above
+	indexParams[WarmUpKey] = strconv.FormatBool(params.CommonCfg.DiskIndexWarmUp.GetAsBool())
+	indexParams[UseBFSCacheKey] = strconv.FormatBool(params.CommonCfg.DiskIndexUseBFSCache.GetAsBool())
+
 	return nil
 }
 
@@ -193,6 +193,16 @@ func TestDiskIndexParams(t *testing.T) {
 		}
 		assert.Equal(t, strconv.Itoa(expectedBeamWidth), beamWidth)
 
+		assert.Equal(t, "false", indexParams[WarmUpKey])
+		assert.Equal(t, "false", indexParams[UseBFSCacheKey])
+
+		params.Save(params.CommonCfg.DiskIndexWarmUp.Key, "true")
+		params.Save(params.CommonCfg.DiskIndexUseBFSCache.Key, "true")
+		err = SetDiskIndexLoadParams(&params, indexParams, 100)
+		assert.NoError(t, err)
+		assert.Equal(t, "true", indexParams[WarmUpKey])
+		assert.Equal(t, "true", indexParams[UseBFSCacheKey])
+
 		params.Save(params.CommonCfg.SearchCacheBudgetGBRatio.Key, "w1")
 		err = SetDiskIndexLoadParams(&params, indexParams, 100)
 		assert.Error(t, err)
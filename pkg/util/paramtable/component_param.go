@@ -184,6 +184,8 @@ type commonConfig struct {
 	HighPriorityThreadCoreCoefficient   ParamItem `refreshable:"false"`
 	MiddlePriorityThreadCoreCoefficient ParamItem `refreshable:"false"`
 	LowPriorityThreadCoreCoefficient    ParamItem `refreshable:"false"`
+	ThreadPoolNumaAware                 ParamItem `refreshable:"false"`
+	CPUConcurrency                      ParamItem `refreshable:"false"`
 	MaxDegree                           ParamItem `refreshable:"true"`
 	SearchListSize                      ParamItem `refreshable:"true"`
 	PQCodeBudgetGBRatio                 ParamItem `refreshable:"true"`
@@ -191,6 +193,8 @@ type commonConfig struct {
 	SearchCacheBudgetGBRatio            ParamItem `refreshable:"true"`
 	LoadNumThreadRatio                  ParamItem `refreshable:"true"`
 	BeamWidthRatio                      ParamItem `refreshable:"true"`
+	DiskIndexWarmUp                     ParamItem `refreshable:"true"`
+	DiskIndexUseBFSCache                ParamItem `refreshable:"true"`
 	GracefulTime                        ParamItem `refreshable:"true"`
 	GracefulStopTimeout                 ParamItem `refreshable:"true"`
 
@@ -470,6 +474,24 @@ This configuration is only used by querynode and indexnode, it selects CPU instr
 	}
 	p.BeamWidthRatio.Init(base.mgr)
 
+	p.DiskIndexWarmUp = ParamItem{
+		Key:          "common.DiskIndex.WarmUp",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "whether to run sample queries on a loaded disk index before serving it, so the first queries don't read cold pages",
+		Export:       true,
+	}
+	p.DiskIndexWarmUp.Init(base.mgr)
+
+	p.DiskIndexUseBFSCache = ParamItem{
+		Key:          "common.DiskIndex.UseBFSCache",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "whether to fill the search cache of a loaded disk index with the nodes nearest to the medoid in BFS order, instead of those most visited by sample queries",
+		Export:       true,
+	}
+	p.DiskIndexUseBFSCache.Init(base.mgr)
+
 	p.GracefulTime = ParamItem{
 		Key:          "common.gracefulTime",
 		Version:      "2.0.0",
@@ -527,6 +549,26 @@ This configuration is only used by querynode and indexnode, it selects CPU instr
 	}
 	p.LowPriorityThreadCoreCoefficient.Init(base.mgr)
 
+	p.ThreadPoolNumaAware = ParamItem{
+		Key:          "common.threadPoolNumaAware",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc: "Whether to spread the workers of the thread pools over the NUMA nodes " +
+			"and pin them to the cores of their nodes",
+		Export: true,
+	}
+	p.ThreadPoolNumaAware.Init(base.mgr)
+
+	p.CPUConcurrency = ParamItem{
+		Key:          "common.cpuConcurrency",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc: "Bound the knowhere build and search pools, the arrow cpu pool and the workers " +
+			"of each thread pool of segcore by this many threads, 0 sizes each of them by the cores",
+		Export: true,
+	}
+	p.CPUConcurrency.Init(base.mgr)
+
 	p.AuthorizationEnabled = ParamItem{
 		Key:          "common.security.authorizationEnabled",
 		Version:      "2.0.0",
@@ -1670,6 +1712,21 @@ type queryNodeConfig struct {
 	InterimIndexNlist         ParamItem `refreshable:"false"`
 	InterimIndexNProbe        ParamItem `refreshable:"false"`
 	InterimIndexMemExpandRate ParamItem `refreshable:"false"`
+	InterimIndexQuantization  ParamItem `refreshable:"false"`
+	InterimIndexRefineRatio   ParamItem `refreshable:"false"`
+	BruteForceSelectivity     ParamItem `refreshable:"false"`
+	DictEncodeRatio           ParamItem `refreshable:"false"`
+	PackRatio                 ParamItem `refreshable:"false"`
+	PlanCacheSize             ParamItem `refreshable:"false"`
+	StageIndexLoad            ParamItem `refreshable:"false"`
+	EnableChunkArena          ParamItem `refreshable:"false"`
+	ChunkArenaHugePage        ParamItem `refreshable:"false"`
+	SearchSegmentsInOneCall   ParamItem `refreshable:"true"`
+	LoadFileMemoryBudget      ParamItem `refreshable:"false"`
+	LoadBandwidthBudget       ParamItem `refreshable:"false"`
+	LoadMemoryLimit           ParamItem `refreshable:"false"`
+	LoadMemoryWaitTimeoutMs   ParamItem `refreshable:"false"`
+	PrefetchVectorRawData     ParamItem `refreshable:"false"`
 
 	// memory limit
 	LoadMemoryUsageFactor               ParamItem `refreshable:"true"`
@@ -1686,7 +1743,9 @@ type queryNodeConfig struct {
 	MmapDirPath      ParamItem `refreshable:"false"`
 
 	// chunk cache
-	ReadAheadPolicy ParamItem `refreshable:"false"`
+	ReadAheadPolicy    ParamItem `refreshable:"false"`
+	ChunkCacheCapacity ParamItem `refreshable:"false"`
+	DiskCacheCapacity  ParamItem `refreshable:"false"`
 
 	GroupEnabled         ParamItem `refreshable:"true"`
 	MaxReceiveChanSize   ParamItem `refreshable:"false"`
@@ -1720,7 +1779,8 @@ type queryNodeConfig struct {
 
 	EnableWorkerSQCostMetrics ParamItem `refreshable:"true"`
 
-	ExprEvalBatchSize ParamItem `refreshable:"false"`
+	ExprEvalBatchSize      ParamItem `refreshable:"false"`
+	ExprEvalWorkingSetSize ParamItem `refreshable:"false"`
 }
 
 func (p *queryNodeConfig) init(base *BaseTable) {
@@ -1838,6 +1898,141 @@ func (p *queryNodeConfig) init(base *BaseTable) {
 	}
 	p.InterimIndexNProbe.Init(base.mgr)
 
+	p.InterimIndexQuantization = ParamItem{
+		Key:          "queryNode.segcore.interimIndex.quantization",
+		Version:      "2.3.4",
+		DefaultValue: "",
+		Doc:          "quantize the interim index of growing segment, options: SQ8, FP16, leave it empty to keep the float vectors",
+		Export:       true,
+	}
+	p.InterimIndexQuantization.Init(base.mgr)
+
+	p.InterimIndexRefineRatio = ParamItem{
+		Key:          "queryNode.segcore.interimIndex.refineRatio",
+		Version:      "2.3.4",
+		DefaultValue: "2",
+		Doc:          "the quantized interim index searches topk * refineRatio candidates, which are reranked by the raw vectors",
+		Export:       true,
+	}
+	p.InterimIndexRefineRatio.Init(base.mgr)
+
+	p.BruteForceSelectivity = ParamItem{
+		Key:          "queryNode.segcore.bruteForceSelectivity",
+		Version:      "2.3.4",
+		DefaultValue: "0.01",
+		Doc:          "search an indexed sealed segment by brute force if the ratio of rows passing the filter is not greater than this, only when its raw vectors are loaded",
+		Export:       true,
+	}
+	p.BruteForceSelectivity.Init(base.mgr)
+
+	p.DictEncodeRatio = ParamItem{
+		Key:          "queryNode.segcore.dictEncodeRatio",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "dictionary encode a string field of a sealed segment loaded in memory if there are at most this ratio of distinct strings per row, 0 disables the encoding",
+		Export:       true,
+	}
+	p.DictEncodeRatio.Init(base.mgr)
+
+	p.PackRatio = ParamItem{
+		Key:          "queryNode.segcore.packRatio",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "bit pack an integer field of a sealed segment loaded in memory if the packed rows take at most this ratio of the raw rows, 0 disables the packing",
+		Export:       true,
+	}
+	p.PackRatio.Init(base.mgr)
+
+	p.PlanCacheSize = ParamItem{
+		Key:          "queryNode.segcore.planCacheSize",
+		Version:      "2.3.4",
+		DefaultValue: "128",
+		Doc:          "the number of parsed search plans and of retrieve plans kept by each collection for the requests sending the same plans, 0 disables the caching",
+		Export:       true,
+	}
+	p.PlanCacheSize.Init(base.mgr)
+
+	p.StageIndexLoad = ParamItem{
+		Key:          "queryNode.segcore.stageIndexLoad",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "load an in memory vector index through a file staged in queryNode.mmapDirPath instead of assembling its slices in memory, which lowers the peak memory of the load",
+		Export:       true,
+	}
+	p.StageIndexLoad.Init(base.mgr)
+
+	p.EnableChunkArena = ParamItem{
+		Key:          "queryNode.segcore.enableChunkArena",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "allocate the chunks of a growing segment from an arena of the segment, which is released in bulk once the segment is released, the small chunks are freed only with the arena",
+		Export:       true,
+	}
+	p.EnableChunkArena.Init(base.mgr)
+
+	p.ChunkArenaHugePage = ParamItem{
+		Key:          "queryNode.segcore.chunkArenaHugePage",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "back the chunk arenas of the growing segments by transparent huge pages, only when enableChunkArena is true",
+		Export:       true,
+	}
+	p.ChunkArenaHugePage.Init(base.mgr)
+
+	p.SearchSegmentsInOneCall = ParamItem{
+		Key:          "queryNode.segcore.searchSegmentsInOneCall",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "search the sealed segments of a request in parallel in segcore and reduce their results in the same cgo call, instead of one cgo call per segment and one for the reduce",
+		Export:       true,
+	}
+	p.SearchSegmentsInOneCall.Init(base.mgr)
+
+	p.LoadFileMemoryBudget = ParamItem{
+		Key:          "queryNode.segcore.loadFileMemoryBudget",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "the max bytes of the files downloaded but not yet decoded by all the field data loads, 0 means unlimited",
+		Export:       true,
+	}
+	p.LoadFileMemoryBudget.Init(base.mgr)
+
+	p.LoadBandwidthBudget = ParamItem{
+		Key:          "queryNode.segcore.loadBandwidthBudget",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "the max bytes per second downloaded by all the field data loads, 0 means unlimited",
+		Export:       true,
+	}
+	p.LoadBandwidthBudget.Init(base.mgr)
+
+	p.LoadMemoryLimit = ParamItem{
+		Key:          "queryNode.segcore.loadMemoryLimit",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "the max bytes of the segments and indexes loaded in segcore, a load reserves its estimated bytes before allocating them, 0 means unlimited",
+		Export:       true,
+	}
+	p.LoadMemoryLimit.Init(base.mgr)
+
+	p.LoadMemoryWaitTimeoutMs = ParamItem{
+		Key:          "queryNode.segcore.loadMemoryWaitTimeoutMs",
+		Version:      "2.3.4",
+		DefaultValue: "30000",
+		Doc:          "the milliseconds a load waits for loadMemoryLimit before it fails, 0 means failing at once",
+		Export:       true,
+	}
+	p.LoadMemoryWaitTimeoutMs.Init(base.mgr)
+
+	p.PrefetchVectorRawData = ParamItem{
+		Key:          "queryNode.segcore.prefetchVectorRawData",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "fetch the binlogs of the indexed vector fields without raw data to the chunk cache in the background once a segment is loaded, for the searches outputting them",
+		Export:       true,
+	}
+	p.PrefetchVectorRawData.Init(base.mgr)
+
 	p.LoadMemoryUsageFactor = ParamItem{
 		Key:          "queryNode.loadMemoryUsageFactor",
 		Version:      "2.0.0",
@@ -1893,6 +2088,22 @@ func (p *queryNodeConfig) init(base *BaseTable) {
 	}
 	p.ReadAheadPolicy.Init(base.mgr)
 
+	p.ChunkCacheCapacity = ParamItem{
+		Key:          "queryNode.cache.capacity",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "The max bytes of data files mmapped by chunk cache, cold files are evicted when exceeded, 0 means unlimited",
+	}
+	p.ChunkCacheCapacity.Init(base.mgr)
+
+	p.DiskCacheCapacity = ParamItem{
+		Key:          "queryNode.cache.diskCapacity",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "The max bytes of remote data files cached on local disk and reused across restarts, 0 means disabled",
+	}
+	p.DiskCacheCapacity.Init(base.mgr)
+
 	p.GroupEnabled = ParamItem{
 		Key:          "queryNode.grouping.enabled",
 		Version:      "2.0.0",
@@ -2117,6 +2328,15 @@ Max read concurrency must greater than or equal to 1, and less than or equal to
 	}
 
 	p.ExprEvalBatchSize.Init(base.mgr)
+
+	p.ExprEvalWorkingSetSize = ParamItem{
+		Key:          "queryNode.segcore.exprEvalWorkingSetSize",
+		Version:      "2.3.4",
+		DefaultValue: "0",
+		Doc:          "choose the expr eval batch size from the width of the fields read, so that a batch of them fits in this many bytes, 0 keeps exprEvalBatchSize",
+		Export:       true,
+	}
+	p.ExprEvalWorkingSetSize.Init(base.mgr)
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -2893,6 +3113,8 @@ type indexNodeConfig struct {
 	MaxDiskUsagePercentage ParamItem `refreshable:"true"`
 
 	GracefulStopTimeout ParamItem `refreshable:"false"`
+
+	StageVectorBuildInput ParamItem `refreshable:"false"`
 }
 
 func (p *indexNodeConfig) init(base *BaseTable) {
@@ -2950,6 +3172,15 @@ func (p *indexNodeConfig) init(base *BaseTable) {
 		Export:       true,
 	}
 	p.GracefulStopTimeout.Init(base.mgr)
+
+	p.StageVectorBuildInput = ParamItem{
+		Key:          "indexNode.stageVectorBuildInput",
+		Version:      "2.3.4",
+		DefaultValue: "false",
+		Doc:          "build the in memory vector indexes from a local file of their binlogs mapped read only, instead of a copy of the binlogs on the heap, which lowers the peak memory of the build",
+		Export:       true,
+	}
+	p.StageVectorBuildInput.Init(base.mgr)
 }
 
 type integrationTestConfig struct {
@@ -108,6 +108,14 @@ func TestComponentParam(t *testing.T) {
 
 		params.Save("common.preCreatedTopic.timeticker", "timeticker")
 		assert.Equal(t, []string{"timeticker"}, Params.TimeTicker.GetAsStrings())
+
+		assert.Equal(t, false, Params.ThreadPoolNumaAware.GetAsBool())
+		params.Save("common.threadPoolNumaAware", "true")
+		assert.Equal(t, true, Params.ThreadPoolNumaAware.GetAsBool())
+
+		assert.Equal(t, int64(0), Params.CPUConcurrency.GetAsInt64())
+		params.Save("common.cpuConcurrency", "16")
+		assert.Equal(t, int64(16), Params.CPUConcurrency.GetAsInt64())
 	})
 
 	t.Run("test rootCoordConfig", func(t *testing.T) {
@@ -306,6 +314,23 @@ func TestComponentParam(t *testing.T) {
 		nprobe := Params.InterimIndexNProbe.GetAsInt64()
 		assert.Equal(t, int64(16), nprobe)
 
+		assert.Equal(t, "", Params.InterimIndexQuantization.GetValue())
+		assert.Equal(t, 2.0, Params.InterimIndexRefineRatio.GetAsFloat())
+		assert.Equal(t, 0.01, Params.BruteForceSelectivity.GetAsFloat())
+		assert.Equal(t, 0.0, Params.DictEncodeRatio.GetAsFloat())
+		assert.Equal(t, 0.0, Params.PackRatio.GetAsFloat())
+		assert.Equal(t, int64(128), Params.PlanCacheSize.GetAsInt64())
+		assert.Equal(t, false, Params.StageIndexLoad.GetAsBool())
+		assert.Equal(t, false, Params.EnableChunkArena.GetAsBool())
+		assert.Equal(t, false, Params.ChunkArenaHugePage.GetAsBool())
+		assert.Equal(t, false, Params.SearchSegmentsInOneCall.GetAsBool())
+		assert.Equal(t, int64(0), Params.LoadFileMemoryBudget.GetAsInt64())
+		assert.Equal(t, int64(0), Params.LoadBandwidthBudget.GetAsInt64())
+		assert.Equal(t, int64(0), Params.LoadMemoryLimit.GetAsInt64())
+		assert.Equal(t, int64(30000), Params.LoadMemoryWaitTimeoutMs.GetAsInt64())
+		assert.Equal(t, false, Params.PrefetchVectorRawData.GetAsBool())
+		assert.Equal(t, int64(0), Params.ExprEvalWorkingSetSize.GetAsInt64())
+
 		assert.Equal(t, true, Params.GroupEnabled.GetAsBool())
 		assert.Equal(t, int32(10240), Params.MaxReceiveChanSize.GetAsInt32())
 		assert.Equal(t, int32(10240), Params.MaxUnsolvedQueueSize.GetAsInt32())
@@ -314,6 +339,8 @@ func TestComponentParam(t *testing.T) {
 
 		// chunk cache
 		assert.Equal(t, "willneed", Params.ReadAheadPolicy.GetValue())
+		assert.Equal(t, int64(0), Params.ChunkCacheCapacity.GetAsInt64())
+		assert.Equal(t, int64(0), Params.DiskCacheCapacity.GetAsInt64())
 
 		// test small indexNlist/NProbe default
 		params.Remove("queryNode.segcore.smallIndex.nlist")
@@ -410,6 +437,7 @@ func TestComponentParam(t *testing.T) {
 		Params := &params.IndexNodeCfg
 		params.Save(Params.GracefulStopTimeout.Key, "50")
 		assert.Equal(t, Params.GracefulStopTimeout.GetAsInt64(), int64(50))
+		assert.Equal(t, false, Params.StageVectorBuildInput.GetAsBool())
 	})
 
 	t.Run("channel config priority", func(t *testing.T) {
@@ -956,6 +956,8 @@ type MinioConfig struct {
 	Region           ParamItem `refreshable:"false"`
 	UseVirtualHost   ParamItem `refreshable:"false"`
 	RequestTimeoutMs ParamItem `refreshable:"false"`
+	ReadPartSize     ParamItem `refreshable:"false"`
+	ReadConcurrency  ParamItem `refreshable:"false"`
 }
 
 func (p *MinioConfig) Init(base *BaseTable) {
@@ -1115,4 +1117,22 @@ Leave it empty if you want to use AWS default endpoint`,
 		Export:       true,
 	}
 	p.RequestTimeoutMs.Init(base.mgr)
+
+	p.ReadPartSize = ParamItem{
+		Key:          "minio.readPartSize",
+		Version:      "2.3.4",
+		DefaultValue: "16777216",
+		Doc:          "size in bytes of the ranges that large objects are split into to download in parallel",
+		Export:       true,
+	}
+	p.ReadPartSize.Init(base.mgr)
+
+	p.ReadConcurrency = ParamItem{
+		Key:          "minio.readConcurrency",
+		Version:      "2.3.4",
+		DefaultValue: "8",
+		Doc:          "max number of ranges of one object downloaded in parallel, 1 disables the parallel download",
+		Export:       true,
+	}
+	p.ReadConcurrency.Init(base.mgr)
 }
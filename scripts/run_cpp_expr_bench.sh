@@ -0,0 +1,122 @@
+#!/usr/bin/env bash
+
+# Licensed to the LF AI & Data foundation under one
+# or more contributor license agreements. See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership. The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License. You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Run the benchmarks of the exec expressions, and if a baseline is given,
+# fail if any of them is slower than the baseline by more than the tolerance.
+#
+# usage: run_cpp_expr_bench.sh [-o output.json] [-b baseline.json]
+#                              [-t tolerance percent, 10 by default]
+#                              [-f benchmark filter regex]
+
+set -e
+
+SOURCE="${BASH_SOURCE[0]}"
+while [ -h "$SOURCE" ]; do # resolve $SOURCE until the file is no longer a symlink
+  DIR="$( cd -P "$( dirname "$SOURCE" )" && pwd )"
+  SOURCE="$(readlink "$SOURCE")"
+  [[ $SOURCE != /* ]] && SOURCE="$DIR/$SOURCE" # if $SOURCE was a relative symlink, we need to resolve it relative to the path where the symlink file was located
+done
+SCRIPTS_DIR="$( cd -P "$( dirname "$SOURCE" )" && pwd )"
+
+MILVUS_CORE_DIR="${SCRIPTS_DIR}/../internal/core"
+CORE_INSTALL_PREFIX="${MILVUS_CORE_DIR}/output"
+EXPR_BENCH="${CORE_INSTALL_PREFIX}/unittest/expr_bench"
+
+OUTPUT="expr_bench.json"
+BASELINE=""
+TOLERANCE=10
+FILTER="Expr/"
+
+while getopts "o:b:t:f:h" arg; do
+  case $arg in
+    o)
+      OUTPUT=$OPTARG
+      ;;
+    b)
+      BASELINE=$OPTARG
+      ;;
+    t)
+      TOLERANCE=$OPTARG
+      ;;
+    f)
+      FILTER=$OPTARG
+      ;;
+    h)
+      sed -n '19,24p' "$0"
+      exit 0
+      ;;
+    *)
+      exit 1
+      ;;
+  esac
+done
+
+if [ ! -f "${EXPR_BENCH}" ]; then
+  echo "${EXPR_BENCH} does not exist!"
+  exit 1
+fi
+
+# currently core will install target lib to "internal/core/output/lib"
+if [ -d "${CORE_INSTALL_PREFIX}/lib" ]; then
+    export LD_LIBRARY_PATH=$LD_LIBRARY_PATH:${CORE_INSTALL_PREFIX}/lib
+fi
+
+# the medians of the repetitions are compared, they are less noisy
+"${EXPR_BENCH}" --benchmark_filter="${FILTER}" \
+  --benchmark_repetitions=5 \
+  --benchmark_report_aggregates_only=true \
+  --benchmark_out="${OUTPUT}" \
+  --benchmark_out_format=json
+
+if [ -z "${BASELINE}" ]; then
+  exit 0
+fi
+
+python3 - "${BASELINE}" "${OUTPUT}" "${TOLERANCE}" <<'EOF'
+import json
+import sys
+
+
+def medians(path):
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    return {
+        b["run_name"]: b["items_per_second"]
+        for b in benchmarks
+        if b.get("aggregate_name") == "median" and "items_per_second" in b
+    }
+
+
+baseline, current = medians(sys.argv[1]), medians(sys.argv[2])
+tolerance = float(sys.argv[3])
+regressions = []
+for name, rows_per_second in sorted(current.items()):
+    if name not in baseline:
+        print("new benchmark {}".format(name))
+        continue
+    change = (rows_per_second / baseline[name] - 1) * 100
+    print("{:+7.1f}% {}".format(change, name))
+    if change < -tolerance:
+        regressions.append(name)
+if regressions:
+    print("{} benchmarks are slower than the baseline by more than {}%:"
+          .format(len(regressions), tolerance))
+    for name in regressions:
+        print("  " + name)
+    sys.exit(1)
+EOF